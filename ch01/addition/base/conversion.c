@@ -2,42 +2,194 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <limits.h>
+#include <time.h>
 
-// Converts an integer to a string in the given base (2–36)
-void int_to_base_str(int value, int base, char *output, size_t output_size) {
-    const char *digits = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-    char buf[64];
-    int i = 0;
+static const char digits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+// "00" to "99", so base 10 takes one division for two digits
+static const char digit_pairs[201] =
+    "00010203040506070809" "10111213141516171819" "20212223242526272829"
+    "30313233343536373839" "40414243444546474849" "50515253545556575859"
+    "60616263646566676869" "70717273747576777879" "80818283848586878889"
+    "90919293949596979899";
+
+// Bits per digit of a power-of-two base, 0 for any other
+static int base_shift(int base) {
+    return (base & (base - 1)) ? 0 : __builtin_ctz((unsigned)base);
+}
+
+// Digits of u in base, before any are written
+static int digit_count(unsigned u, int base) {
+    int shift = base_shift(base);
+    if (shift) {
+        int bits = 32 - __builtin_clz(u | 1);
+        return (bits + shift - 1) / shift;
+    }
+    if (base == 10) {
+        static const unsigned powers[] = {
+            10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+        };
+        int n = 1;
+        while (n < 10 && u >= powers[n - 1]) n++;
+        return n;
+    }
+    int n = 1;
+    for (unsigned limit = (unsigned)base; u >= limit; n++) {
+        if (limit > UINT_MAX / (unsigned)base) return n + 1;
+        limit *= (unsigned)base;
+    }
+    return n;
+}
 
+// Converts an integer to a string in the given base (2–36), and returns
+// its length. The digits are counted first and then written from the end
+// back, in place; "Invalid base", or "" if output is too small, gives 0.
+// The magnitude is taken as unsigned, so INT_MIN has one too
+size_t int_to_base_str(int value, int base, char *output, size_t output_size) {
     if (base < 2 || base > 36) {
         snprintf(output, output_size, "Invalid base");
-        return;
+        return 0;
     }
 
-    int is_negative = 0;
-    if (value < 0) {
-        is_negative = 1;
-        value = -value;
+    unsigned u = value < 0 ? 0u - (unsigned)value : (unsigned)value;
+    size_t len = (size_t)digit_count(u, base) + (value < 0);
+    if (len >= output_size) {
+        if (output_size) output[0] = '\0';
+        return 0;
     }
 
-    do {
-        buf[i++] = digits[value % base];
-        value /= base;
-    } while (value > 0);
+    char *p = output + len;
+    *p = '\0';
+    int shift = base_shift(base);
+    if (shift) {
+        unsigned mask = (unsigned)base - 1;
+        do {
+            *--p = digits[u & mask];
+            u >>= shift;
+        } while (u);
+    } else if (base == 10) {
+        while (u >= 100) {
+            unsigned pair = (u % 100) * 2;
+            u /= 100;
+            *--p = digit_pairs[pair + 1];
+            *--p = digit_pairs[pair];
+        }
+        if (u >= 10) {
+            *--p = digit_pairs[u * 2 + 1];
+            *--p = digit_pairs[u * 2];
+        } else {
+            *--p = (char)('0' + u);
+        }
+    } else {
+        do {
+            *--p = digits[u % (unsigned)base];
+            u /= (unsigned)base;
+        } while (u);
+    }
+    if (value < 0) *--p = '-';
+    return len;
+}
 
-    if (is_negative) buf[i++] = '-';
+// count values into output, each followed by sep, and returns the length;
+// it stops short, at the last whole value, when output is full
+size_t ints_to_base_str(const int *values, size_t count, int base, char sep,
+                        char *output, size_t output_size) {
+    size_t used = 0;
+    if (output_size) output[0] = '\0';
+    for (size_t i = 0; i < count; i++) {
+        size_t n = int_to_base_str(values[i], base, output + used, output_size - used);
+        if (n == 0 || used + n + 1 >= output_size) {
+            output[used] = '\0';
+            break;
+        }
+        used += n;
+        output[used++] = sep;
+        output[used] = '\0';
+    }
+    return used;
+}
 
+// The old way: a division a digit, reversed, then reversed back
+static void int_to_base_str_divide(int value, int base, char *output) {
+    char buf[64];
+    int i = 0;
+    unsigned u = value < 0 ? 0u - (unsigned)value : (unsigned)value;
+    do {
+        buf[i++] = digits[u % (unsigned)base];
+        u /= (unsigned)base;
+    } while (u > 0);
+    if (value < 0) buf[i++] = '-';
     buf[i] = '\0';
-
-    // Reverse the string
     int len = strlen(buf);
-    for (int j = 0; j < len; ++j) {
-        output[j] = buf[len - j - 1];
-    }
+    for (int j = 0; j < len; ++j) output[j] = buf[len - j - 1];
     output[len] = '\0';
 }
 
-int main() {
+// conversion bench: every value through both, checked against each
+// other and printf, then timed
+static int bench(void) {
+    enum { COUNT = 1 << 20 };
+    static int values[COUNT];
+    unsigned seed = 1;
+    for (int i = 0; i < COUNT; i++) {
+        seed = seed * 1103515245u + 12345u;
+        values[i] = (int)(seed ^ (seed >> 15)) >> (i % 31);
+    }
+    values[0] = INT_MIN;
+    values[1] = INT_MAX;
+    values[2] = 0;
+
+    char a[64], b[64], c[64];
+    for (int base = 2; base <= 36; base++) {
+        for (int i = 0; i < COUNT; i += 97) {
+            int_to_base_str(values[i], base, a, sizeof(a));
+            int_to_base_str_divide(values[i], base, b);
+            if (strcmp(a, b) != 0) {
+                printf("Mismatch in base %d for %d: %s %s\n", base, values[i], a, b);
+                return 1;
+            }
+        }
+    }
+    for (int i = 0; i < COUNT; i++) {
+        int_to_base_str(values[i], 10, a, sizeof(a));
+        snprintf(c, sizeof(c), "%d", values[i]);
+        if (strcmp(a, c) != 0) {
+            printf("Mismatch with printf for %d: %s\n", values[i], a);
+            return 1;
+        }
+    }
+
+    static const int bases[] = { 2, 10, 16, 36 };
+    unsigned long sum = 0;
+    for (size_t k = 0; k < sizeof(bases) / sizeof(bases[0]); k++) {
+        int base = bases[k];
+        clock_t start = clock();
+        for (int i = 0; i < COUNT; i++) {
+            int_to_base_str_divide(values[i], base, a);
+            sum += (unsigned char)a[0];
+        }
+        double slow = (double)(clock() - start) / CLOCKS_PER_SEC;
+        start = clock();
+        for (int i = 0; i < COUNT; i++) {
+            sum += int_to_base_str(values[i], base, a, sizeof(a));
+        }
+        double fast = (double)(clock() - start) / CLOCKS_PER_SEC;
+        printf("base %2d: %.1f ns a value divided, %.1f ns in place\n",
+               base, slow * 1e9 / COUNT, fast * 1e9 / COUNT);
+    }
+
+    static char list[COUNT * 12];
+    clock_t start = clock();
+    size_t len = ints_to_base_str(values, COUNT, 10, ' ', list, sizeof(list));
+    double batch = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("batch: %d values, %zu bytes, %.1f ns a value\n", COUNT, len, batch * 1e9 / COUNT);
+    return sum == 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) return bench();
+
     int in_base, out_base;
     char number_str[64];
     char result_str[64];
@@ -1,22 +1,117 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bcd.h"
 
 // Convert a decimal number to BCD
 void decimalToBCD(int decimal) {
-    int digit;
     printf("BCD representation of %d: ", decimal);
-    // Each digit from left to right
-    while (decimal > 0) {
-        digit = decimal % 10; // Get rightmost digit
-        // Print 4-bit BCD for the digit (padded to 4 bits)
-        printf("%04d ", digit); // %04d ensures 4-bit output (e.g., 0001 for 1)
-        decimal /= 10; // Remove processed digit
+    uint64_t bcd = bcd_encode64((uint64_t)(decimal < 0 ? -(int64_t)decimal : decimal));
+    // Each digit from left to right, leading zeros skipped
+    int top = 15;
+    while (top > 0 && ((bcd >> (4 * top)) & 0xF) == 0) top--;
+    for (int d = top; d >= 0; d--) {
+        unsigned digit = (bcd >> (4 * d)) & 0xF;
+        for (int bit = 3; bit >= 0; bit--) putchar('0' + ((digit >> bit) & 1));
+        putchar(' ');
     }
     printf("\n");
 }
 
-int main() {
+// The slow way, a division and a shift a digit
+static uint64_t encode_loop(uint64_t u) {
+    uint64_t bcd = 0;
+    for (int shift = 0; u && shift < 64; shift += 4) {
+        bcd |= (u % 10) << shift;
+        u /= 10;
+    }
+    return bcd;
+}
+
+static uint64_t decode_loop(uint64_t bcd) {
+    uint64_t result = 0, multiplier = 1;
+    for (; bcd; bcd >>= 4) {
+        result += (bcd & 0xF) * multiplier;
+        multiplier *= 10;
+    }
+    return result;
+}
+
+static uint64_t next(uint64_t *seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 7;
+    *seed ^= *seed << 17;
+    return *seed;
+}
+
+// bcd check: the SWAR routines against the loops, and their times
+static int check(void) {
+    uint64_t seed = 88172645463325252ull;
+    for (int i = 0; i < 1000000; i++) {
+        uint64_t u = next(&seed) % 10000000000000000ull;
+        uint32_t v = (uint32_t)(u % 100000000u);
+        uint64_t w = next(&seed) % 10000000000000000ull;
+        uint32_t x = (uint32_t)(w % 100000000u);
+        if (bcd_encode64(u) != encode_loop(u) || bcd_encode32(v) != encode_loop(v) ||
+            bcd_decode64(encode_loop(u)) != u || bcd_decode32(bcd_encode32(v)) != v) {
+            printf("Conversion wrong for %llu\n", (unsigned long long)u);
+            return 1;
+        }
+        int carry, borrow;
+        uint32_t s = bcd_add32(bcd_encode32(v), bcd_encode32(x), &carry);
+        uint32_t d = bcd_sub32(bcd_encode32(v), bcd_encode32(x), &borrow);
+        if (bcd_decode32(s) != (v + x) % 100000000u || carry != (v + x >= 100000000u) ||
+            bcd_decode32(d) != (v + 100000000u - x) % 100000000u || borrow != (v < x) ||
+            !bcd_valid32(s) || !bcd_valid32(d)) {
+            printf("32-bit arithmetic wrong for %u and %u\n", v, x);
+            return 1;
+        }
+        const uint64_t ten16 = 10000000000000000ull;
+        uint64_t s64 = bcd_add64(bcd_encode64(u), bcd_encode64(w), &carry);
+        uint64_t d64 = bcd_sub64(bcd_encode64(u), bcd_encode64(w), &borrow);
+        if (bcd_decode64(s64) != (u + w) % ten16 || carry != (u + w >= ten16) ||
+            bcd_decode64(d64) != (u + ten16 - w) % ten16 || borrow != (u < w)) {
+            printf("64-bit arithmetic wrong for %llu and %llu\n",
+                   (unsigned long long)u, (unsigned long long)w);
+            return 1;
+        }
+    }
+    if (bcd_valid32(0x1234567A) || bcd_valid32(0xA0000000) || !bcd_valid32(0x99999999)) {
+        printf("Validation wrong\n");
+        return 1;
+    }
+    printf("Conversions and arithmetic agree with the loops\n");
+
+    enum { COUNT = 1 << 20 };
+    uint64_t *in = malloc(COUNT * sizeof(uint64_t));
+    uint64_t *out = malloc(COUNT * sizeof(uint64_t));
+    if (!in || !out) return 1;
+    for (int i = 0; i < COUNT; i++) in[i] = next(&seed) % 10000000000000000ull;
+    uint64_t sum = 0;
+
+    clock_t start = clock();
+    for (int i = 0; i < COUNT; i++) out[i] = encode_loop(in[i]);
+    for (int i = 0; i < COUNT; i++) sum += decode_loop(out[i]);
+    double loops = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    bcd_encode_array64(in, out, COUNT);
+    bcd_decode_array64(out, in, COUNT);
+    for (int i = 0; i < COUNT; i++) sum -= in[i];
+    double swar = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("%d 16-digit values there and back: loops %.1f ns, SWAR %.1f ns a value%s\n",
+           COUNT, loops * 1e9 / COUNT, swar * 1e9 / COUNT, sum ? " (mismatch!)" : "");
+    free(in);
+    free(out);
+    return sum != 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "check") == 0) return check();
+
     int number = 123;
     decimalToBCD(number);
     return 0;
 }
-
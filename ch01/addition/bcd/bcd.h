@@ -0,0 +1,137 @@
+#ifndef BCD_H
+#define BCD_H
+
+// Packed BCD, a decimal digit per nibble, the most significant at the
+// top: 8 digits in a uint32_t, 16 in a uint64_t. Nothing here divides
+// per digit or branches on one. Each routine works on every digit of a
+// word at once (SWAR, SIMD within a register): a conversion splits the
+// word into lanes and halves them, 10000s, then 100s, then 10s, with
+// multiplications by reciprocals; an addition adds in binary and takes
+// the 6 back out of each digit that did not carry.
+
+#include <stdint.h>
+#include <stddef.h>
+
+// --- decode: BCD to binary ---
+
+// Nibble pairs to bytes of 0..99, byte pairs to 16-bit lanes of up to
+// 9999, and the two lanes together
+static inline uint32_t bcd_decode32(uint32_t bcd) {
+    uint32_t x = (bcd & 0x0F0F0F0Fu) + 10 * ((bcd >> 4) & 0x0F0F0F0Fu);
+    x = (x & 0x00FF00FFu) + 100 * ((x >> 8) & 0x00FF00FFu);
+    return (x & 0xFFFFu) + 10000 * (x >> 16);
+}
+
+static inline uint64_t bcd_decode64(uint64_t bcd) {
+    uint64_t x = (bcd & 0x0F0F0F0F0F0F0F0Full) + 10 * ((bcd >> 4) & 0x0F0F0F0F0F0F0F0Full);
+    x = (x & 0x00FF00FF00FF00FFull) + 100 * ((x >> 8) & 0x00FF00FF00FF00FFull);
+    x = (x & 0x0000FFFF0000FFFFull) + 10000 * ((x >> 16) & 0x0000FFFF0000FFFFull);
+    return (x & 0xFFFFFFFFull) + 100000000ull * (x >> 32);
+}
+
+// --- encode: binary to BCD ---
+
+// The digits of u < 10^8 as 8 bytes of 0..9, the most significant in the
+// top byte. Two 32-bit lanes of up to 9999 are split into four 16-bit
+// ones of up to 99: v / 100 is (v * 5243) >> 19 for v < 43699, and a
+// lane's product fits in its 32 bits, so one shift does both lanes; the
+// bits the upper lane shifts down fall above the lower lane's quotient
+// and the mask takes them off. Then the same with v / 10 = (v * 103) >> 10
+// for v < 179
+static inline uint64_t bcd_spread8(uint32_t u) {
+    uint64_t x = ((uint64_t)(u / 10000) << 32) | (u % 10000);
+    uint64_t q = ((x * 5243) >> 19) & 0x0000007F0000007Full;
+    x = ((x - 100 * q) | (q << 16));
+    q = ((x * 103) >> 10) & 0x000F000F000F000Full;
+    return (x - 10 * q) | (q << 8);
+}
+
+// 8 bytes of digits to 8 nibbles
+static inline uint32_t bcd_pack8(uint64_t x) {
+    x = (x | (x >> 4)) & 0x00FF00FF00FF00FFull;
+    x = (x | (x >> 8)) & 0x0000FFFF0000FFFFull;
+    return (uint32_t)(x | (x >> 16));
+}
+
+// The last 8 digits of u
+static inline uint32_t bcd_encode32(uint32_t u) {
+    return bcd_pack8(bcd_spread8(u % 100000000u));
+}
+
+// The last 16 digits of u
+static inline uint64_t bcd_encode64(uint64_t u) {
+    u %= 10000000000000000ull;
+    return ((uint64_t)bcd_encode32((uint32_t)(u / 100000000u)) << 32) |
+           bcd_encode32((uint32_t)(u % 100000000u));
+}
+
+// --- arithmetic ---
+
+// a + b of valid BCD: 6 added to every digit makes a decimal carry a
+// binary one; the carries into each nibble are the bits where the sum
+// differs from the carry-less a ^ b, and every digit that took none
+// gives its 6 back. *carry, if wanted, is the carry out of the top digit
+static inline uint32_t bcd_add32(uint32_t a, uint32_t b, int *carry) {
+    uint32_t t1 = a + 0x66666666u;
+    uint32_t t2 = t1 + b;
+    uint32_t out = t2 < t1;
+    uint32_t into = t2 ^ t1 ^ b;
+    uint32_t none = ((~into & 0x11111110u) >> 4) | ((out ^ 1) << 28);
+    if (carry) *carry = (int)out;
+    return t2 - (none << 2) - (none << 1);
+}
+
+static inline uint64_t bcd_add64(uint64_t a, uint64_t b, int *carry) {
+    uint64_t t1 = a + 0x6666666666666666ull;
+    uint64_t t2 = t1 + b;
+    uint64_t out = t2 < t1;
+    uint64_t into = t2 ^ t1 ^ b;
+    uint64_t none = ((~into & 0x1111111111111110ull) >> 4) | ((out ^ 1) << 60);
+    if (carry) *carry = (int)out;
+    return t2 - (none << 2) - (none << 1);
+}
+
+// a - b as a plus the ten's complement of b; below zero it wraps to
+// 10^8 - (b - a), and *borrow is 1
+static inline uint32_t bcd_sub32(uint32_t a, uint32_t b, int *borrow) {
+    int c1, c2;
+    uint32_t r = bcd_add32(a, 0x99999999u - b, &c1);
+    r = bcd_add32(r, 1, &c2);
+    if (borrow) *borrow = !(c1 | c2);
+    return r;
+}
+
+static inline uint64_t bcd_sub64(uint64_t a, uint64_t b, int *borrow) {
+    int c1, c2;
+    uint64_t r = bcd_add64(a, 0x9999999999999999ull - b, &c1);
+    r = bcd_add64(r, 1, &c2);
+    if (borrow) *borrow = !(c1 | c2);
+    return r;
+}
+
+// True if every nibble is a digit: adding 6 carries out of just those
+// that are 10 to 15
+static inline int bcd_valid32(uint32_t bcd) {
+    uint32_t t = bcd + 0x66666666u;
+    return bcd <= 0x99999999u && ((t ^ bcd ^ 0x66666666u) & 0x11111110u) == 0;
+}
+
+// --- arrays ---
+
+static inline void bcd_encode_array32(const uint32_t *in, uint32_t *out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = bcd_encode32(in[i]);
+}
+
+static inline void bcd_decode_array32(const uint32_t *in, uint32_t *out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = bcd_decode32(in[i]);
+}
+
+static inline void bcd_encode_array64(const uint64_t *in, uint64_t *out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = bcd_encode64(in[i]);
+}
+
+static inline void bcd_decode_array64(const uint64_t *in, uint64_t *out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = bcd_decode64(in[i]);
+}
+
+#endif // BCD_H
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdint.h>
+#include "bcd.h"
 
 // Convert an 8-bit BCD number (two digits) to decimal
 int bcd_to_decimal(uint8_t bcd) {
@@ -8,24 +9,22 @@ int bcd_to_decimal(uint8_t bcd) {
     return high * 10 + low;
 }
 
-// Convert a multi-byte BCD number to decimal
+// Convert a multi-byte BCD number to decimal, all 8 digits at once
 long bcd_to_decimal32(uint32_t bcd) {
-    long result = 0;
-    long multiplier = 1;
-
-    while (bcd > 0) {
-        int digit = bcd & 0xF;     // lowest nibble
-        result += digit * multiplier;
-        multiplier *= 10;
-        bcd >>= 4;                 // shift to next nibble
-    }
-
-    return result;
+    return (long)bcd_decode32(bcd);
 }
 
 int main(void) {
     uint32_t bcd = 0x0123;  // BCD = 123
     long decimal = bcd_to_decimal32(bcd);
     printf("BCD 0x%4X -> Decimal %ld\n", bcd, decimal);
+
+    // A counter kept in BCD is shown without converting it
+    int carry, borrow;
+    uint32_t sum = bcd_add32(0x0123, 0x0989, &carry);
+    uint32_t difference = bcd_sub32(0x0100, 0x0001, &borrow);
+    printf("BCD 0x0123 + 0x0989 = 0x%04X, carry %d\n", sum, carry);
+    printf("BCD 0x0100 - 0x0001 = 0x%04X, borrow %d\n", difference, borrow);
+    printf("Decimal 20250101 -> BCD 0x%08X\n", bcd_encode32(20250101));
     return 0;
 }
@@ -3,26 +3,169 @@
 #include <string.h>
 #include <assert.h>
 #include <ctype.h>
+#include <time.h>
 
-#define MAX_DIGITS 1000
+#include "bigint.h"
 
+// gcc -O2 big.c bigint.c -o big && ./big
+
+// A decimal number is an integer and a scale: 123.45 is 12345 with the
+// decimal point 2 digits from the right. The integer is a BigInt, limbs
+// of nine digits, so there is no fixed limit on the number of digits
 typedef struct {
-    char digits[MAX_DIGITS];
+    BigInt mag;       // Magnitude, all digits with the decimal point removed
     int decimal_pos;  // Position of decimal point from right (0 = integer)
     int sign;         // 1 for positive, -1 for negative
-    int len;          // Total number of digits
+    int from_arena;   // made inside a bd_arena_begin() scope
 } BigDecimal;
 
+static void* bd_malloc(size_t size) {
+    void* p = malloc(size);
+    if (!p) {
+        fprintf(stderr, "big: out of memory\n");
+        exit(1);
+    }
+    return p;
+}
+
+// ===== Arena =====
+// An expression such as a * b + c makes temporaries that all die
+// together. Between bd_arena_begin() and bd_arena_end() every bd_new()
+// takes the number and its limbs from a bump region instead of malloc,
+// and bd_arena_end() gives it all back at once by moving the top down.
+// Scopes nest; blocks stay for the next scope until bd_arena_release().
+// bd_keep() copies a result that has to outlive its scope to the heap
+
+#define ARENA_BLOCK (64 * 1024)
+#define ARENA_ALIGN 8    // enough for limbs and for a BigDecimal
+#define ARENA_DEPTH 32
+
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t size, used;
+    uint64_t data[];
+} ArenaBlock;
+
+typedef struct {
+    ArenaBlock* block;
+    size_t used;
+} ArenaMark;
+
+static struct {
+    ArenaBlock* first;
+    ArenaBlock* current;     // allocation goes on from here
+    ArenaMark marks[ARENA_DEPTH];
+    int depth;
+} arena;
+
+static void* arena_alloc(size_t size) {
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    ArenaBlock* b = arena.current;
+    while (b && b->used + size > b->size) {
+        // next block, if it is big enough; a smaller one is skipped
+        b = b->next;
+        if (b) b->used = 0;
+    }
+    if (!b) {
+        size_t bs = size > ARENA_BLOCK ? size : ARENA_BLOCK;
+        b = bd_malloc(sizeof(ArenaBlock) + bs);
+        b->size = bs;
+        b->used = 0;
+        b->next = NULL;
+        if (arena.current) {
+            b->next = arena.current->next;
+            arena.current->next = b;
+        } else {
+            arena.first = b;
+        }
+    }
+    arena.current = b;
+    void* p = (unsigned char*)b->data + b->used;
+    b->used += size;
+    return p;
+}
+
+// The last allocation grows where it is, the rest move
+static void* arena_grow(void* ctx, void* p, size_t old_size, size_t new_size) {
+    (void)ctx;
+    ArenaBlock* b = arena.current;
+    size_t old_r = (old_size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    size_t new_r = (new_size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    if (p && b && (unsigned char*)p + old_r == (unsigned char*)b->data + b->used && b->used - old_r + new_r <= b->size) {
+        b->used = b->used - old_r + new_r;
+        return p;
+    }
+    void* q = arena_alloc(new_size);
+    if (p) memcpy(q, p, old_size);
+    return q;
+}
+
+static void arena_release(void* ctx, void* p) {
+    (void)ctx;
+    (void)p;                 // all at once, in bd_arena_end()
+}
+
+static const BiAllocator arena_allocator = { arena_grow, arena_release, NULL };
+
+void bd_arena_begin(void) {
+    if (arena.depth == ARENA_DEPTH) {
+        fprintf(stderr, "big: arena scopes nested too deep\n");
+        exit(1);
+    }
+    ArenaBlock* b = arena.current;
+    arena.marks[arena.depth++] = (ArenaMark){ b, b ? b->used : 0 };
+}
+
+void bd_arena_end(void) {
+    if (arena.depth == 0) {
+        fprintf(stderr, "big: bd_arena_end() without bd_arena_begin()\n");
+        exit(1);
+    }
+    ArenaMark m = arena.marks[--arena.depth];
+    arena.current = m.block ? m.block : arena.first;
+    if (arena.current) arena.current->used = m.used;
+}
+
+// Frees the blocks; only outside every scope
+void bd_arena_release(void) {
+    if (arena.depth > 0) return;
+    while (arena.first) {
+        ArenaBlock* next = arena.first->next;
+        free(arena.first);
+        arena.first = next;
+    }
+    arena.current = NULL;
+}
+
+static BigDecimal* bd_make(int in_arena) {
+    BigDecimal* bd = in_arena ? arena_alloc(sizeof(BigDecimal)) : bd_malloc(sizeof(BigDecimal));
+    bi_init_with(&bd->mag, in_arena ? &arena_allocator : NULL);
+    bd->decimal_pos = 0;
+    bd->sign = 1;
+    bd->from_arena = in_arena;
+    return bd;
+}
+
+BigDecimal* bd_new(void) {
+    return bd_make(arena.depth > 0);
+}
+
+// Numbers from the arena go with their scope
+void bd_free(BigDecimal* bd) {
+    if (!bd || bd->from_arena) return;
+    bi_free(&bd->mag);
+    free(bd);
+}
+
+// Zero has no sign
+static void bd_normalize(BigDecimal* bd) {
+    if (bd->mag.len == 0) bd->sign = 1;
+}
+
 // Init a BigDecimal from a string
 BigDecimal* bd_from_string(const char* str) {
-    BigDecimal* bd = malloc(sizeof(BigDecimal));
-    memset(bd->digits, '0', MAX_DIGITS);
-    bd->sign = 1;
-    bd->decimal_pos = 0;
-    bd->len = 0;
-    
-    int i = 0, j = 0;
-    int decimal_found = 0;
+    BigDecimal* bd = bd_new();
+    int i = 0;
     
     // Handle sign
     if (str[0] == '-') {
@@ -32,122 +175,210 @@ BigDecimal* bd_from_string(const char* str) {
         i = 1;
     }
     
-    // Find decimal point position
-    int str_len = strlen(str);
-    for (int k = i; k < str_len; k++) {
-        if (str[k] == '.') {
-            decimal_found = 1;
-            bd->decimal_pos = str_len - k - 1;
-            break;
-        }
+    // Count the digits after the point; bi_set_digits() skips the point
+    size_t str_len = strlen(str);
+    const char* point = strchr(str + i, '.');
+    if (point) {
+        for (const char* p = point + 1; *p; p++) bd->decimal_pos += isdigit((unsigned char)*p) != 0;
     }
     
-    // Copy digits (reverse order for easier arithmetic)
-    for (int k = str_len - 1; k >= i; k--) {
-        if (str[k] == '.') continue;
-        if (isdigit(str[k])) {
-            bd->digits[j++] = str[k];
-            bd->len++;
-        }
+    bi_set_digits(&bd->mag, str + i, str_len - i);
+    bd_normalize(bd);
+    return bd;
+}
+
+// How a BigDecimal is written: sign, zeros to have at least one digit
+// before the point (5 with 2 decimals is 0.05), then the magnitude,
+// with the point between the integer digits and the decimals
+typedef struct {
+    int negative;
+    size_t zeros;     // leading zeros
+    size_t digits;    // of the magnitude
+    size_t point;     // digits before the point, zeros included
+    size_t length;    // characters in all
+} BdLayout;
+
+static BdLayout bd_layout(const BigDecimal* bd) {
+    BdLayout l;
+    size_t dp = (size_t)bd->decimal_pos;
+    l.negative = bd->sign == -1 && bd->mag.len > 0;
+    l.digits = bi_digits(&bd->mag);
+    l.zeros = l.digits > dp ? 0 : dp + 1 - l.digits;
+    l.point = l.zeros + l.digits - dp;
+    l.length = l.negative + l.zeros + l.digits + (dp > 0);
+    return l;
+}
+
+// Digits [from, to) of zeros and magnitude together
+static size_t bd_write_digits(FILE* f, const BigDecimal* bd, const BdLayout* l, size_t from, size_t to) {
+    size_t written = 0;
+    for (; from < to && from < l->zeros; from++) written += fputc('0', f) != EOF;
+    if (from < to) written += bi_write_digits(f, &bd->mag, from - l->zeros, to - l->zeros);
+    return written;
+}
+
+// Into the caller's buffer, returning the length of the number; when
+// size is not more than that only an empty string is written
+size_t bd_to_buffer(const BigDecimal* bd, char* buf, size_t size) {
+    BdLayout l = bd_layout(bd);
+    if (size <= l.length) {
+        if (size > 0) buf[0] = '\0';
+        return l.length;
     }
     
-    return bd;
+    char* p = buf;
+    if (l.negative) *p++ = '-';
+    memset(p, '0', l.zeros);
+    bi_to_buffer(&bd->mag, p + l.zeros, size - (size_t)(p + l.zeros - buf));
+    if (bd->decimal_pos > 0) {
+        // open a gap for the point, moving the decimals and the '\0'
+        memmove(p + l.point + 1, p + l.point, (size_t)bd->decimal_pos + 1);
+        p[l.point] = '.';
+    }
+    return l.length;
+}
+
+// Streamed in chunks, with no string of the whole number
+size_t bd_write(FILE* f, const BigDecimal* bd) {
+    BdLayout l = bd_layout(bd);
+    size_t written = 0;
+    if (l.negative) written += fputc('-', f) != EOF;
+    written += bd_write_digits(f, bd, &l, 0, l.point);
+    if (bd->decimal_pos > 0) {
+        written += fputc('.', f) != EOF;
+        written += bd_write_digits(f, bd, &l, l.point, l.zeros + l.digits);
+    }
+    return written;
 }
 
 // Convert BigDecimal to string
 char* bd_to_string(BigDecimal* bd) {
-    char* result = malloc(MAX_DIGITS + 10);
-    int pos = 0;
-    
-    if (bd->sign == -1 && bd->len > 0) {
-        result[pos++] = '-';
+    size_t n = bd_layout(bd).length;
+    char* result = malloc(n + 1);
+    if (result) bd_to_buffer(bd, result, n + 1);
+    return result;
+}
+
+// Magnitudes of a and b brought to the same scale, the larger of the two
+static int bd_align(const BigDecimal* a, const BigDecimal* b, BigInt* ma, BigInt* mb) {
+    int scale = a->decimal_pos > b->decimal_pos ? a->decimal_pos : b->decimal_pos;
+    bi_mul_pow10(ma, &a->mag, scale - a->decimal_pos);
+    bi_mul_pow10(mb, &b->mag, scale - b->decimal_pos);
+    return scale;
+}
+
+// In place: acc += x. With equal signs the magnitudes add, else the
+// smaller is taken from the larger and the result has the larger's sign.
+// acc takes the larger scale where it is; only an x with fewer decimals
+// needs a scaled copy
+void bd_add_to(BigDecimal* acc, const BigDecimal* x) {
+    if (acc->decimal_pos < x->decimal_pos) {
+        bi_mul_pow10(&acc->mag, &acc->mag, x->decimal_pos - acc->decimal_pos);
+        acc->decimal_pos = x->decimal_pos;
     }
-    
-    if (bd->len == 0) {
-        strcpy(result, "0");
-        return result;
+    BigInt scaled;
+    bi_init_with(&scaled, acc->mag.alloc);
+    const BigInt* mx = &x->mag;
+    if (x->decimal_pos < acc->decimal_pos) {
+        bi_mul_pow10(&scaled, &x->mag, acc->decimal_pos - x->decimal_pos);
+        mx = &scaled;
     }
     
-    // Integer part
-    int int_digits = bd->len - bd->decimal_pos;
-    if (int_digits <= 0) {
-        result[pos++] = '0';
+    if (acc->sign == x->sign) {
+        bi_add(&acc->mag, &acc->mag, mx);
+    } else if (bi_compare(&acc->mag, mx) >= 0) {
+        bi_sub(&acc->mag, &acc->mag, mx);
     } else {
-        for (int i = bd->len - 1; i >= bd->decimal_pos; i--) {
-            result[pos++] = bd->digits[i];
-        }
+        bi_sub(&acc->mag, mx, &acc->mag);
+        acc->sign = x->sign;
     }
-    
-    // Decimal part
-    if (bd->decimal_pos > 0) {
-        result[pos++] = '.';
-        for (int i = bd->decimal_pos - 1; i >= 0; i--) {
-            result[pos++] = bd->digits[i];
-        }
+    bi_free(&scaled);
+    bd_normalize(acc);
+}
+
+// In place: acc *= x, the scales add
+void bd_multiply_to(BigDecimal* acc, const BigDecimal* x) {
+    bi_mul(&acc->mag, &acc->mag, &x->mag);
+    acc->decimal_pos += x->decimal_pos;
+    acc->sign *= x->sign;
+    bd_normalize(acc);
+}
+
+// In place: acc *= multiplier
+void bd_multiply_int_to(BigDecimal* acc, int multiplier) {
+    if (multiplier < 0) acc->sign = -acc->sign;
+    bi_mul_u32(&acc->mag, &acc->mag, multiplier < 0 ? 0u - (unsigned)multiplier : (unsigned)multiplier);
+    bd_normalize(acc);
+}
+
+// r = a, into r's own limbs
+void bd_set(BigDecimal* r, const BigDecimal* a) {
+    bi_copy(&r->mag, &a->mag);
+    r->decimal_pos = a->decimal_pos;
+    r->sign = a->sign;
+}
+
+// The _into variants write the result into r, which may be an operand.
+// A loop that keeps its r allocates nothing once r is big enough
+
+// r = a + b
+void bd_add_into(BigDecimal* r, const BigDecimal* a, const BigDecimal* b) {
+    if (r == b) {
+        bd_add_to(r, a);
+    } else {
+        bd_set(r, a);
+        bd_add_to(r, b);
     }
-    
-    result[pos] = '\0';
+}
+
+// r = a * b; Karatsuba once both are long
+void bd_multiply_into(BigDecimal* r, const BigDecimal* a, const BigDecimal* b) {
+    int scale = a->decimal_pos + b->decimal_pos, sign = a->sign * b->sign;
+    bi_mul(&r->mag, &a->mag, &b->mag);
+    r->decimal_pos = scale;
+    r->sign = sign;
+    bd_normalize(r);
+}
+
+// r = a * multiplier
+void bd_multiply_int_into(BigDecimal* r, const BigDecimal* a, int multiplier) {
+    bd_set(r, a);
+    bd_multiply_int_to(r, multiplier);
+}
+
+BigDecimal* bd_copy(const BigDecimal* a) {
+    BigDecimal* result = bd_new();
+    bd_set(result, a);
     return result;
 }
 
+// A number from the arena copied to the heap, to outlive its scope;
+// one from the heap is returned as it is
+BigDecimal* bd_keep(BigDecimal* x) {
+    if (!x->from_arena) return x;
+    BigDecimal* kept = bd_make(0);
+    bd_set(kept, x);
+    return kept;
+}
+
 // Add two BigDecimals
 BigDecimal* bd_add(BigDecimal* a, BigDecimal* b) {
-    BigDecimal* result = malloc(sizeof(BigDecimal));
-    memset(result->digits, '0', MAX_DIGITS);
-    
-    // Align decimal places
-    int max_decimal = (a->decimal_pos > b->decimal_pos) ? a->decimal_pos : b->decimal_pos;
-    result->decimal_pos = max_decimal;
-    
-    // Handle signs
-    if (a->sign == b->sign) {
-        result->sign = a->sign;
-        int carry = 0;
-        int max_len = (a->len > b->len) ? a->len : b->len;
-        max_len = (max_len > max_decimal) ? max_len : max_decimal;
-        
-        for (int i = 0; i < max_len || carry; i++) {
-            int digit_a = (i < a->len) ? (a->digits[i] - '0') : 0;
-            int digit_b = (i < b->len) ? (b->digits[i] - '0') : 0;
-            
-            int sum = digit_a + digit_b + carry;
-            result->digits[i] = (sum % 10) + '0';
-            carry = sum / 10;
-            result->len = i + 1;
-        }
-    } else {
-        // For subtraction, we'll implement a simple version
-        // This is a simplified implementation
-        // - full version would handle all cases
-        result->sign = 1;
-        result->len = 1;
-        result->digits[0] = '0';
-    }
-    
+    BigDecimal* result = bd_new();
+    bd_add_into(result, a, b);
+    return result;
+}
+
+// Multiply two BigDecimals
+BigDecimal* bd_multiply(BigDecimal* a, BigDecimal* b) {
+    BigDecimal* result = bd_new();
+    bd_multiply_into(result, a, b);
     return result;
 }
 
 // Multiply BigDecimal by integer
 BigDecimal* bd_multiply_int(BigDecimal* a, int multiplier) {
-    BigDecimal* result = malloc(sizeof(BigDecimal));
-    memset(result->digits, '0', MAX_DIGITS);
-    
-    result->decimal_pos = a->decimal_pos;
-    result->sign = (multiplier < 0) ? -a->sign : a->sign;
-    multiplier = abs(multiplier);
-    
-    int carry = 0;
-    result->len = 0;
-    
-    for (int i = 0; i < a->len || carry; i++) {
-        int digit = (i < a->len) ? (a->digits[i] - '0') : 0;
-        int product = digit * multiplier + carry;
-        
-        result->digits[i] = (product % 10) + '0';
-        carry = product / 10;
-        result->len = i + 1;
-    }
-    
+    BigDecimal* result = bd_new();
+    bd_multiply_int_into(result, a, multiplier);
     return result;
 }
 
@@ -157,28 +388,14 @@ int bd_compare(BigDecimal* a, BigDecimal* b) {
         return (a->sign > b->sign) ? 1 : -1;
     }
     
-    // Align for comparison
-    int max_decimal = (a->decimal_pos > b->decimal_pos) ? a->decimal_pos : b->decimal_pos;
-    int a_int_digits = a->len - a->decimal_pos;
-    int b_int_digits = b->len - b->decimal_pos;
-    
-    if (a_int_digits != b_int_digits) {
-        int cmp = (a_int_digits > b_int_digits) ? 1 : -1;
-        return (a->sign == 1) ? cmp : -cmp;
-    }
-    
-    // Compare digit by digit from most significant
-    for (int i = (a->len > b->len ? a->len : b->len) - 1; i >= 0; i--) {
-        char digit_a = (i < a->len) ? a->digits[i] : '0';
-        char digit_b = (i < b->len) ? b->digits[i] : '0';
-        
-        if (digit_a != digit_b) {
-            int cmp = (digit_a > digit_b) ? 1 : -1;
-            return (a->sign == 1) ? cmp : -cmp;
-        }
-    }
-    
-    return 0;
+    BigInt ma, mb;
+    bi_init(&ma);
+    bi_init(&mb);
+    bd_align(a, b, &ma, &mb);
+    int cmp = bi_compare(&ma, &mb);
+    bi_free(&ma);
+    bi_free(&mb);
+    return (a->sign == 1) ? cmp : -cmp;
 }
 
 void test_string_arithmetic() {
@@ -191,10 +408,9 @@ void test_string_arithmetic() {
     char* result_str = bd_to_string(result);
     
     printf("Test 1: 123.45 + 67.89 = %s\n", result_str);
-    // Note: This simplified implementation may not handle all decimal arithmetic correctly
-    // A full implementation would need more sophisticated decimal alignment
+    assert(strcmp(result_str, "191.34") == 0);
     
-    free(a); free(b); free(result); free(result_str);
+    bd_free(a); bd_free(b); bd_free(result); free(result_str);
     
     // Test 2: Multiplication
     a = bd_from_string("12.34");
@@ -202,8 +418,9 @@ void test_string_arithmetic() {
     result_str = bd_to_string(result);
     
     printf("Test 2: 12.34 * 5 = %s\n", result_str);
+    assert(strcmp(result_str, "61.70") == 0);
     
-    free(a); free(result); free(result_str);
+    bd_free(a); bd_free(result); free(result_str);
     
     // Test 3: Large number handling
     a = bd_from_string("999999999999999999.123456789");
@@ -211,8 +428,9 @@ void test_string_arithmetic() {
     result_str = bd_to_string(result);
     
     printf("Test 3: Large number * 2 = %s\n", result_str);
+    assert(strcmp(result_str, "1999999999999999998.246913578") == 0);
     
-    free(a); free(result); free(result_str);
+    bd_free(a); bd_free(result); free(result_str);
     
     // Test 4: Comparison
     a = bd_from_string("123.45");
@@ -222,7 +440,7 @@ void test_string_arithmetic() {
     printf("Test 4: Compare 123.45 vs 123.44 = %d (should be 1)\n", cmp);
     assert(cmp == 1);
     
-    free(a); free(b);
+    bd_free(a); bd_free(b);
     
     // Test 5: Zero handling
     a = bd_from_string("0.00");
@@ -230,8 +448,9 @@ void test_string_arithmetic() {
     cmp = bd_compare(a, b);
     
     printf("Test 5: Compare 0.00 vs 0 = %d (should be 0)\n", cmp);
+    assert(cmp == 0);
     
-    free(a); free(b);
+    bd_free(a); bd_free(b);
     
     // Test 6: String conversion accuracy
     a = bd_from_string("1234.5678");
@@ -239,11 +458,156 @@ void test_string_arithmetic() {
     printf("Test 6: String round-trip: %s\n", result_str);
     assert(strcmp(result_str, "1234.5678") == 0);
     
-    free(a); free(result_str);
+    bd_free(a); free(result_str);
+    
+    // Test 7: Subtraction through a negative operand
+    a = bd_from_string("10.5");
+    b = bd_from_string("-12.25");
+    result = bd_add(a, b);
+    result_str = bd_to_string(result);
+    printf("Test 7: 10.5 + -12.25 = %s\n", result_str);
+    assert(strcmp(result_str, "-1.75") == 0);
+    
+    bd_free(a); bd_free(b); bd_free(result); free(result_str);
+    
+    // Test 8: Full multiplication, (10^1000 - 1)^2 = 99..9800..01
+    char* nines = malloc(1001);
+    memset(nines, '9', 1000);
+    nines[1000] = '\0';
+    a = bd_from_string(nines);
+    result = bd_multiply(a, a);
+    result_str = bd_to_string(result);
+    int square_ok = strlen(result_str) == 2000 && result_str[998] == '9' &&
+                    result_str[999] == '8' && result_str[1000] == '0' && result_str[1998] == '0' &&
+                    result_str[1999] == '1';
+    printf("Test 8: (10^1000 - 1)^2 has the digits 9..98 0..01: %s\n", square_ok ? "yes" : "no");
+    assert(square_ok);
+    
+    bd_free(a); bd_free(result); free(result_str); free(nines);
+    
+    // Test 9: Small decimals, a caller's buffer and a stream
+    a = bd_from_string("-0.0050");
+    char buf[16];
+    size_t len = bd_to_buffer(a, buf, sizeof(buf));
+    printf("Test 9: -0.0050 in a buffer: %s (%zu characters), streamed: ", buf, len);
+    assert(strcmp(buf, "-0.0050") == 0 && len == 7);
+    assert(bd_to_buffer(a, buf, 7) == 7 && buf[0] == '\0');
+    assert(bd_write(stdout, a) == 7);
+    printf("\n");
+    
+    bd_free(a);
+    
+    // Test 10: Temporaries in an arena scope, the result kept
+    BigDecimal* kept;
+    bd_arena_begin();
+    a = bd_from_string("1.5");
+    b = bd_from_string("-0.25");
+    result = bd_add(bd_multiply(a, a), bd_multiply_int(b, 3));
+    kept = bd_keep(result);
+    bd_arena_end();
+    result_str = bd_to_string(kept);
+    printf("Test 10: 1.5 * 1.5 + -0.25 * 3 in an arena = %s\n", result_str);
+    assert(strcmp(result_str, "1.50") == 0 && !kept->from_arena);
+    
+    bd_free(kept); free(result_str);
     
     printf("\nAll basic tests passed!\n");
 }
 
+// n! accumulated in place, then squared with the full multiplication
+void benchmark_factorial(int n) {
+    clock_t start = clock();
+    BigDecimal* f = bd_from_string("1");
+    for (int i = 2; i <= n; i++) bd_multiply_int_to(f, i);
+    double t_fact = (double)(clock() - start) / CLOCKS_PER_SEC;
+    
+    start = clock();
+    BigDecimal* square = bd_multiply(f, f);
+    double t_square = (double)(clock() - start) / CLOCKS_PER_SEC;
+    
+    printf("%d! has %zu digits (%.3f s), its square %zu digits (%.3f s)\n",
+           n, bi_digits(&f->mag), t_fact, bi_digits(&square->mag), t_square);
+    bd_free(f);
+    bd_free(square);
+}
+
+// Squaring 20000! three times gives over 600000 digits to print
+void benchmark_output(void) {
+    BigDecimal* x = bd_from_string("1");
+    for (int i = 2; i <= 20000; i++) bd_multiply_int_to(x, i);
+    for (int i = 0; i < 3; i++) bd_multiply_to(x, x);
+    x->decimal_pos = 100;
+    
+    clock_t start = clock();
+    char* s = bd_to_string(x);
+    double t_string = (double)(clock() - start) / CLOCKS_PER_SEC;
+    
+    FILE* f = tmpfile();
+    start = clock();
+    size_t written = f ? bd_write(f, x) : 0;
+    double t_write = (double)(clock() - start) / CLOCKS_PER_SEC;
+    
+    start = clock();
+    BigDecimal* back = bd_from_string(s);
+    double t_parse = (double)(clock() - start) / CLOCKS_PER_SEC;
+    
+    printf("%zu characters: bd_to_string %.3f s, bd_write %.3f s (%zu written), "
+           "bd_from_string %.3f s, round trip %s\n", strlen(s), t_string, t_write, written,
+           t_parse, bd_compare(x, back) == 0 ? "exact" : "WRONG");
+    if (f) fclose(f);
+    free(s);
+    bd_free(back);
+    bd_free(x);
+}
+
+// sum += a * b + c, the temporaries made three ways: malloc and free
+// each time, from an arena scope per step, and into reused numbers
+void benchmark_temporaries(int n) {
+    BigDecimal* a = bd_from_string("12345678901234567890.123456789");
+    BigDecimal* b = bd_from_string("-98765432109876543210.98765");
+    BigDecimal* c = bd_from_string("31415926535897932384626.4338327950");
+    BigDecimal* sums[3];
+    double t[3];
+    
+    clock_t start = clock();
+    sums[0] = bd_from_string("0");
+    for (int i = 0; i < n; i++) {
+        BigDecimal* p = bd_multiply(a, b);
+        BigDecimal* s = bd_add(p, c);
+        bd_add_to(sums[0], s);
+        bd_free(p);
+        bd_free(s);
+    }
+    t[0] = (double)(clock() - start) / CLOCKS_PER_SEC;
+    
+    start = clock();
+    sums[1] = bd_from_string("0");
+    for (int i = 0; i < n; i++) {
+        bd_arena_begin();
+        bd_add_to(sums[1], bd_add(bd_multiply(a, b), c));
+        bd_arena_end();
+    }
+    t[1] = (double)(clock() - start) / CLOCKS_PER_SEC;
+    
+    start = clock();
+    sums[2] = bd_from_string("0");
+    BigDecimal* s = bd_new();
+    for (int i = 0; i < n; i++) {
+        bd_multiply_into(s, a, b);
+        bd_add_into(s, s, c);
+        bd_add_to(sums[2], s);
+    }
+    t[2] = (double)(clock() - start) / CLOCKS_PER_SEC;
+    bd_free(s);
+    
+    int same = bd_compare(sums[0], sums[1]) == 0 && bd_compare(sums[0], sums[2]) == 0;
+    printf("%d steps of sum += a * b + c: malloc %.3f s, arena %.3f s, into %.3f s, sums %s\n",
+           n, t[0], t[1], t[2], same ? "equal" : "DIFFERENT");
+    for (int i = 0; i < 3; i++) bd_free(sums[i]);
+    bd_free(a); bd_free(b); bd_free(c);
+    bd_arena_release();
+}
+
 int main() {
     test_string_arithmetic();
     
@@ -267,10 +631,21 @@ int main() {
     char* product_str = bd_to_string(product);
     printf("Number 1 * 3: %s\n", product_str);
     
+    BigDecimal* full = bd_multiply(num1, num2);
+    char* full_str = bd_to_string(full);
+    printf("Number 1 * Number 2: %s\n", full_str);
+    
     // Cleanup
-    free(num1); free(num2); free(sum); free(product);
-    free(str1); free(str2); free(sum_str); free(product_str);
+    bd_free(num1); bd_free(num2); bd_free(sum); bd_free(product); bd_free(full);
+    free(str1); free(str2); free(sum_str); free(product_str); free(full_str);
+    
+    printf("\nFactorials:\n");
+    benchmark_factorial(1000);
+    benchmark_factorial(20000);
+    benchmark_output();
+    
+    printf("\nTemporaries:\n");
+    benchmark_temporaries(200000);
     
     return 0;
 }
-
@@ -0,0 +1,410 @@
+// bigint.c - arbitrary size non-negative integers, see bigint.h
+// compile with the program using it: gcc -std=c99 -O2 prog.c bigint.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bigint.h"
+
+// Below this many limbs schoolbook multiplication beats Karatsuba
+#ifndef KARATSUBA_CUTOFF
+#define KARATSUBA_CUTOFF 64
+#endif
+
+static void *bi_alloc(size_t limbs) {
+    void *p = malloc(limbs ? limbs * sizeof(uint32_t) : 1);
+    if (!p) {
+        fprintf(stderr, "bigint: out of memory\n");
+        exit(1);
+    }
+    return p;
+}
+
+static void bi_reserve(BigInt *x, int limbs) {
+    if (limbs <= x->cap) return;
+    int cap = x->cap ? x->cap : 4;
+    while (cap < limbs) cap *= 2;
+    uint32_t *p = x->alloc
+        ? x->alloc->grow(x->alloc->ctx, x->limb, (size_t)x->cap * sizeof(uint32_t),
+                         (size_t)cap * sizeof(uint32_t))
+        : realloc(x->limb, (size_t)cap * sizeof(uint32_t));
+    if (!p) {
+        fprintf(stderr, "bigint: out of memory\n");
+        exit(1);
+    }
+    x->limb = p;
+    x->cap = cap;
+}
+
+static void bi_normalize(BigInt *x) {
+    while (x->len > 0 && x->limb[x->len - 1] == 0) x->len--;
+}
+
+void bi_init(BigInt *x) {
+    bi_init_with(x, NULL);
+}
+
+void bi_init_with(BigInt *x, const BiAllocator *alloc) {
+    x->limb = NULL;
+    x->len = 0;
+    x->cap = 0;
+    x->alloc = alloc;
+}
+
+void bi_free(BigInt *x) {
+    if (x->alloc) {
+        if (x->limb) x->alloc->release(x->alloc->ctx, x->limb);
+    } else {
+        free(x->limb);
+    }
+    bi_init_with(x, x->alloc);
+}
+
+void bi_set_u64(BigInt *x, uint64_t v) {
+    bi_reserve(x, 3);
+    x->len = 0;
+    while (v) {
+        x->limb[x->len++] = (uint32_t)(v % BIGINT_BASE);
+        v /= BIGINT_BASE;
+    }
+}
+
+void bi_copy(BigInt *r, const BigInt *a) {
+    if (r == a) return;
+    bi_reserve(r, a->len);
+    if (a->len) memcpy(r->limb, a->limb, (size_t)a->len * sizeof(uint32_t));
+    r->len = a->len;
+}
+
+void bi_swap(BigInt *a, BigInt *b) {
+    BigInt t = *a;
+    *a = *b;
+    *b = t;
+}
+
+int bi_compare(const BigInt *a, const BigInt *b) {
+    if (a->len != b->len) return a->len > b->len ? 1 : -1;
+    for (int i = a->len - 1; i >= 0; i--) {
+        if (a->limb[i] != b->limb[i]) return a->limb[i] > b->limb[i] ? 1 : -1;
+    }
+    return 0;
+}
+
+void bi_add(BigInt *r, const BigInt *a, const BigInt *b) {
+    int an = a->len, bn = b->len;
+    int n = an > bn ? an : bn;
+    bi_reserve(r, n + 1);   // may move a or b when r is one of them
+    uint32_t carry = 0;
+    for (int i = 0; i < n; i++) {
+        uint32_t s = carry;
+        if (i < an) s += a->limb[i];
+        if (i < bn) s += b->limb[i];
+        carry = s >= BIGINT_BASE;
+        r->limb[i] = carry ? s - BIGINT_BASE : s;
+    }
+    r->limb[n] = carry;
+    r->len = n + 1;
+    bi_normalize(r);
+}
+
+void bi_sub(BigInt *r, const BigInt *a, const BigInt *b) {
+    int an = a->len, bn = b->len;
+    bi_reserve(r, an);
+    uint32_t borrow = 0;
+    for (int i = 0; i < an; i++) {
+        int64_t d = (int64_t)a->limb[i] - borrow - (i < bn ? b->limb[i] : 0);
+        borrow = d < 0;
+        r->limb[i] = (uint32_t)(borrow ? d + BIGINT_BASE : d);
+    }
+    r->len = an;
+    bi_normalize(r);
+}
+
+// ===== Limb arithmetic =====
+// On plain arrays of a given length, high zero limbs allowed
+
+// r[0..rn) += a[0..an) with an <= rn; returns the carry out of r
+static uint32_t limbs_add(uint32_t *r, int rn, const uint32_t *a, int an) {
+    uint32_t carry = 0;
+    int i = 0;
+    for (; i < an; i++) {
+        uint32_t s = r[i] + a[i] + carry;
+        carry = s >= BIGINT_BASE;
+        r[i] = carry ? s - BIGINT_BASE : s;
+    }
+    for (; carry && i < rn; i++) {
+        carry = ++r[i] == BIGINT_BASE;
+        if (carry) r[i] = 0;
+    }
+    return carry;
+}
+
+// r[0..rn) -= a[0..an) with an <= rn and r >= a
+static void limbs_sub(uint32_t *r, int rn, const uint32_t *a, int an) {
+    uint32_t borrow = 0;
+    int i = 0;
+    for (; i < an; i++) {
+        int64_t d = (int64_t)r[i] - a[i] - borrow;
+        borrow = d < 0;
+        r[i] = (uint32_t)(borrow ? d + BIGINT_BASE : d);
+    }
+    for (; borrow && i < rn; i++) {
+        borrow = r[i] == 0;
+        r[i] = borrow ? BIGINT_BASE - 1 : r[i] - 1;
+    }
+}
+
+// Limb products are below 10^18, so 18 of them and a limb still fit in
+// 64 bits: columns add up products that way and carry only every
+// SCHOOL_ROWS rows, which keeps the division out of the inner loop
+#define SCHOOL_ROWS 18
+
+static void columns_carry(uint64_t *col, int from, int to) {
+    uint64_t carry = 0;
+    for (int k = from; k < to; k++) {
+        uint64_t t = col[k] + carry;
+        col[k] = t % BIGINT_BASE;
+        carry = t / BIGINT_BASE;
+    }
+    col[to] += carry;
+}
+
+// r[0..an+bn) = a * b the schoolbook way
+static void limbs_mul_school(uint32_t *r, const uint32_t *a, int an, const uint32_t *b, int bn) {
+    int rn = an + bn;
+    uint64_t small[2 * KARATSUBA_CUTOFF];
+    uint64_t *col = (size_t)rn <= sizeof(small) / sizeof(small[0]) ? small
+                  : bi_alloc((size_t)rn * 2);   // two limbs of room per column
+    memset(col, 0, (size_t)rn * sizeof(uint64_t));
+    for (int i = 0; i < an; i++) {
+        uint64_t ai = a[i];
+        uint64_t *c = col + i;
+        for (int j = 0; j < bn; j++) c[j] += ai * b[j];
+        if ((i + 1) % SCHOOL_ROWS == 0) columns_carry(col, i + 1 - SCHOOL_ROWS, i + bn);
+    }
+    columns_carry(col, 0, rn - 1);
+    for (int k = 0; k < rn; k++) r[k] = (uint32_t)col[k];
+    if (col != small) free(col);
+}
+
+// r[0..an+bn) = a * b. Karatsuba splits both at h limbs,
+// a = a1 B^h + a0 and b = b1 B^h + b0, and needs three products:
+// a*b = z2 B^2h + (z1 - z2 - z0) B^h + z0 with z0 = a0 b0, z2 = a1 b1
+// and z1 = (a0 + a1)(b0 + b1)
+static void limbs_mul(uint32_t *r, const uint32_t *a, int an, const uint32_t *b, int bn) {
+    if (an < bn) {
+        const uint32_t *t = a; a = b; b = t;
+        int tn = an; an = bn; bn = tn;
+    }
+    if (bn < KARATSUBA_CUTOFF) {
+        limbs_mul_school(r, a, an, b, bn);
+        return;
+    }
+
+    if (2 * bn <= an) {
+        // Lopsided: multiply b by slices of a as long as b itself
+        uint32_t *t = bi_alloc((size_t)2 * bn);
+        memset(r, 0, (size_t)(an + bn) * sizeof(uint32_t));
+        for (int i = 0; i < an; i += bn) {
+            int n = an - i < bn ? an - i : bn;
+            limbs_mul(t, a + i, n, b, bn);
+            limbs_add(r + i, an + bn - i, t, n + bn);
+        }
+        free(t);
+        return;
+    }
+
+    int h = (an + 1) / 2;           // bn >= h, as bn > an / 2
+    int a1n = an - h, b1n = bn - h;
+    int rn = an + bn;
+    uint32_t *sa = bi_alloc((size_t)4 * h + 4);
+    uint32_t *sb = sa + h + 1;
+    uint32_t *z1 = sb + h + 1;
+
+    memcpy(sa, a, (size_t)h * sizeof(uint32_t));
+    sa[h] = limbs_add(sa, h, a + h, a1n);
+    memcpy(sb, b, (size_t)h * sizeof(uint32_t));
+    sb[h] = limbs_add(sb, h, b + h, b1n);
+
+    limbs_mul(r, a, h, b, h);                       // z0 in r[0..2h)
+    if (b1n > 0) {
+        limbs_mul(r + 2 * h, a + h, a1n, b + h, b1n);  // z2 in r[2h..)
+    } else {
+        memset(r + 2 * h, 0, (size_t)(rn - 2 * h) * sizeof(uint32_t));
+    }
+    limbs_mul(z1, sa, h + 1, sb, h + 1);
+    limbs_sub(z1, 2 * h + 2, r, 2 * h);
+    limbs_sub(z1, 2 * h + 2, r + 2 * h, rn - 2 * h);
+
+    // z1 fits in what is left of r, its limbs beyond that are zero
+    int z1n = 2 * h + 2;
+    if (z1n > rn - h) z1n = rn - h;
+    limbs_add(r + h, rn - h, z1, z1n);
+    free(sa);
+}
+
+// Into r's own limbs when it is not an operand, so a loop reusing r
+// does not allocate once it is big enough
+void bi_mul(BigInt *r, const BigInt *a, const BigInt *b) {
+    if (a->len == 0 || b->len == 0) {
+        r->len = 0;
+        return;
+    }
+    int n = a->len + b->len;
+    if (r != a && r != b) {
+        bi_reserve(r, n);
+        limbs_mul(r->limb, a->limb, a->len, b->limb, b->len);
+    } else {
+        // the product needs the operands until it is done
+        BigInt t;
+        bi_init_with(&t, r->alloc);
+        bi_reserve(&t, n);
+        limbs_mul(t.limb, a->limb, a->len, b->limb, b->len);
+        bi_free(r);
+        *r = t;
+    }
+    r->len = n;
+    bi_normalize(r);
+}
+
+void bi_mul_u32(BigInt *r, const BigInt *a, uint32_t m) {
+    int n = a->len;
+    bi_reserve(r, n + 2);
+    uint64_t carry = 0;
+    for (int i = 0; i < n; i++) {
+        uint64_t t = (uint64_t)a->limb[i] * m + carry;
+        r->limb[i] = (uint32_t)(t % BIGINT_BASE);
+        carry = t / BIGINT_BASE;
+    }
+    r->len = n;
+    while (carry) {
+        r->limb[r->len++] = (uint32_t)(carry % BIGINT_BASE);
+        carry /= BIGINT_BASE;
+    }
+    bi_normalize(r);
+}
+
+// Times 10^k: whole limbs move up, the rest is a small multiply
+void bi_mul_pow10(BigInt *r, const BigInt *a, int k) {
+    static const uint32_t pow10[BIGINT_BASE_DIGITS] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+    };
+    bi_copy(r, a);
+    if (r->len == 0 || k <= 0) return;
+    int shift = k / BIGINT_BASE_DIGITS;
+    if (shift) {
+        bi_reserve(r, r->len + shift);
+        memmove(r->limb + shift, r->limb, (size_t)r->len * sizeof(uint32_t));
+        memset(r->limb, 0, (size_t)shift * sizeof(uint32_t));
+        r->len += shift;
+    }
+    if (k % BIGINT_BASE_DIGITS) bi_mul_u32(r, r, pow10[k % BIGINT_BASE_DIGITS]);
+}
+
+// ===== Conversion =====
+
+// Decimal digits are the limbs written out, nine each but the top one,
+// so conversion either way is linear and needs no division of bignums
+
+// The characters of digits that are '0'..'9', in order; others, like a
+// decimal point, are skipped. Limbs fill from the end of the string
+void bi_set_digits(BigInt *x, const char *digits, size_t n) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) count += digits[i] >= '0' && digits[i] <= '9';
+    bi_reserve(x, (int)((count + BIGINT_BASE_DIGITS - 1) / BIGINT_BASE_DIGITS));
+    x->len = 0;
+    uint32_t limb = 0, scale = 1;
+    for (size_t i = n; i-- > 0;) {
+        if (digits[i] < '0' || digits[i] > '9') continue;
+        limb += (uint32_t)(digits[i] - '0') * scale;
+        scale *= 10;
+        if (scale == BIGINT_BASE) {
+            x->limb[x->len++] = limb;
+            limb = 0;
+            scale = 1;
+        }
+    }
+    if (scale > 1) x->limb[x->len++] = limb;
+    bi_normalize(x);
+}
+
+// Digits [from, to) of a, 0 being the most significant, into out
+static void put_digits(const BigInt *a, size_t from, size_t to, char *out) {
+    if (a->len == 0) {
+        if (from < to) *out = '0';
+        return;
+    }
+    size_t top = bi_digits(a) - (size_t)(a->len - 1) * BIGINT_BASE_DIGITS;
+    size_t i = from;
+    while (i < to) {
+        // the limb holding digit i, and where i is in it
+        int k;
+        size_t width, at;
+        if (i < top) {
+            k = a->len - 1;
+            width = top;
+            at = i;
+        } else {
+            k = a->len - 2 - (int)((i - top) / BIGINT_BASE_DIGITS);
+            width = BIGINT_BASE_DIGITS;
+            at = (i - top) % BIGINT_BASE_DIGITS;
+        }
+        char digit[BIGINT_BASE_DIGITS];
+        uint32_t v = a->limb[k];
+        for (size_t d = width; d-- > 0; v /= 10) digit[d] = (char)('0' + v % 10);
+        size_t n = width - at < to - i ? width - at : to - i;
+        memcpy(out, digit + at, n);
+        out += n;
+        i += n;
+    }
+}
+
+size_t bi_to_buffer(const BigInt *a, char *buf, size_t size) {
+    size_t n = bi_digits(a);
+    if (size > n) {
+        put_digits(a, 0, n, buf);
+        buf[n] = '\0';
+    } else if (size > 0) {
+        buf[0] = '\0';
+    }
+    return n;
+}
+
+size_t bi_write_digits(FILE *f, const BigInt *a, size_t from, size_t to) {
+    char chunk[BIGINT_WRITE_CHUNK];
+    size_t written = 0;
+    while (from < to) {
+        size_t n = to - from < sizeof(chunk) ? to - from : sizeof(chunk);
+        put_digits(a, from, from + n, chunk);
+        written += fwrite(chunk, 1, n, f);
+        from += n;
+    }
+    return written;
+}
+
+size_t bi_write(FILE *f, const BigInt *a) {
+    return bi_write_digits(f, a, 0, bi_digits(a));
+}
+
+bool bi_to_u64(const BigInt *a, uint64_t *v) {
+    uint64_t x = 0;
+    for (int i = a->len - 1; i >= 0; i--) {
+        if (x > (UINT64_MAX - a->limb[i]) / BIGINT_BASE) return false;
+        x = x * BIGINT_BASE + a->limb[i];
+    }
+    if (v) *v = x;
+    return true;
+}
+
+size_t bi_digits(const BigInt *a) {
+    if (a->len == 0) return 1;
+    size_t digits = (size_t)(a->len - 1) * BIGINT_BASE_DIGITS;
+    for (uint32_t top = a->limb[a->len - 1]; top; top /= 10) digits++;
+    return digits;
+}
+
+char *bi_to_string(const BigInt *a) {
+    size_t n = bi_digits(a);
+    char *s = malloc(n + 1);
+    if (s) bi_to_buffer(a, s, n + 1);
+    return s;
+}
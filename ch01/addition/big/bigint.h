@@ -0,0 +1,59 @@
+// bigint.h - arbitrary size non-negative integers
+// Limbs in base 10^9, least significant first: big enough that a
+// multiply is few limb products, and printing needs no division
+#ifndef BIGINT_H
+#define BIGINT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define BIGINT_BASE 1000000000u
+#define BIGINT_BASE_DIGITS 9
+#define BIGINT_WRITE_CHUNK 4096   // bytes per fwrite in bi_write
+
+// Where limbs come from, when not malloc: grow is realloc with the old
+// size given, release is free
+typedef struct {
+    void *(*grow)(void *ctx, void *p, size_t old_size, size_t new_size);
+    void (*release)(void *ctx, void *p);
+    void *ctx;
+} BiAllocator;
+
+typedef struct {
+    uint32_t *limb;   // limb[0] is the lowest
+    int len;          // limbs in use, no leading zero limbs (0 has len 0)
+    int cap;          // limbs allocated
+    const BiAllocator *alloc;   // NULL: malloc and free
+} BigInt;
+
+void bi_init(BigInt *x);
+void bi_init_with(BigInt *x, const BiAllocator *alloc);
+void bi_free(BigInt *x);
+void bi_set_u64(BigInt *x, uint64_t v);
+void bi_copy(BigInt *r, const BigInt *a);
+void bi_swap(BigInt *a, BigInt *b);
+
+// Every result may be one of the operands
+int bi_compare(const BigInt *a, const BigInt *b);
+void bi_add(BigInt *r, const BigInt *a, const BigInt *b);
+void bi_sub(BigInt *r, const BigInt *a, const BigInt *b);   // needs a >= b
+void bi_mul(BigInt *r, const BigInt *a, const BigInt *b);
+void bi_mul_u32(BigInt *r, const BigInt *a, uint32_t m);
+void bi_mul_pow10(BigInt *r, const BigInt *a, int k);       // a * 10^k
+
+void bi_set_digits(BigInt *x, const char *digits, size_t n); // skips non-digits
+bool bi_to_u64(const BigInt *a, uint64_t *v);   // false if it does not fit
+size_t bi_digits(const BigInt *a);              // decimal digits, 1 for 0
+char *bi_to_string(const BigInt *a);            // malloc'd, caller frees
+
+// Into the caller's buffer, returning the digit count; when size is not
+// more than that only an empty string is written
+size_t bi_to_buffer(const BigInt *a, char *buf, size_t size);
+// Straight to a stream in chunks, no string of the whole number;
+// bi_write_digits() writes digits [from, to), 0 the most significant
+size_t bi_write(FILE *f, const BigInt *a);
+size_t bi_write_digits(FILE *f, const BigInt *a, size_t from, size_t to);
+
+#endif // BIGINT_H
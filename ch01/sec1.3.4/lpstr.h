@@ -0,0 +1,250 @@
+#ifndef LPSTR_H
+#define LPSTR_H
+
+// Length-prefixed strings, the grown-up LengthPrefixedString of
+// representation.c. The length is a field, so asking for it costs
+// nothing, and the bytes need no terminator to end them, though one is
+// kept after them anyway so lpstr_chars() can go to printf() and the rest
+// of the C library.
+//
+// A string of up to LPSTR_SMALL bytes lives in the struct itself, the
+// bytes after it zero, so making one takes no malloc() and two of them
+// are equal when their two halves are. A longer string has its bytes
+// on the heap and keeps its hash next to the pointer:
+//
+//   small  | length | chars ....... \0 0 0 |     16 bytes
+//   large  | length | hash | chars -> heap |
+//
+// Comparing and searching go a word of 8 bytes at a time (SWAR, SIMD
+// within a register), and a table interns strings to small ids, so that
+// names are compared once, when they are read, and from then on by id.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LPSTR_SMALL 11
+
+typedef union {
+    struct { uint32_t length; char chars[LPSTR_SMALL + 1]; } small;
+    struct { uint32_t length; uint32_t hash; char *chars; } large;
+} lpstr;
+
+// --- words ---
+
+#define LPSTR_ONES 0x0101010101010101ull
+#define LPSTR_HIGHS 0x8080808080808080ull
+
+static inline uint64_t lpstr_load(const char *p) {
+    uint64_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+// The last n < 8 bytes, zero above them
+static inline uint64_t lpstr_load_tail(const char *p, size_t n) {
+    uint64_t w = 0;
+    memcpy(&w, p, n);
+    return w;
+}
+
+// High bit set in each byte of w that is zero. Bytes above the first
+// zero one may be marked too, so only the lowest mark is to be trusted
+static inline uint64_t lpstr_zero_bytes(uint64_t w) {
+    return (w - LPSTR_ONES) & ~w & LPSTR_HIGHS;
+}
+
+// Offset of the lowest marked byte; the words are read little-endian
+static inline size_t lpstr_first_mark(uint64_t marks) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return (size_t)__builtin_ctzll(marks) / 8;
+#else
+    return (size_t)__builtin_clzll(marks) / 8;
+#endif
+}
+
+// FNV-1a
+static inline uint32_t lpstr_hash_bytes(const char *p, size_t n) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; i++) h = (h ^ (uint8_t)p[i]) * 16777619u;
+    return h;
+}
+
+static inline bool lpstr_equal_bytes(const char *a, const char *b, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        if (lpstr_load(a + i) != lpstr_load(b + i)) return false;
+    }
+    return lpstr_load_tail(a + i, n - i) == lpstr_load_tail(b + i, n - i);
+}
+
+// --- strings ---
+
+static inline size_t lpstr_length(const lpstr *s) {
+    return s->small.length;
+}
+
+static inline bool lpstr_is_small(const lpstr *s) {
+    return s->small.length <= LPSTR_SMALL;
+}
+
+static inline const char *lpstr_chars(const lpstr *s) {
+    return lpstr_is_small(s) ? s->small.chars : s->large.chars;
+}
+
+// Copy n bytes into s; false if the heap had no room for them
+static inline bool lpstr_init(lpstr *s, const char *chars, size_t n) {
+    memset(s, 0, sizeof(*s));
+    if (n > UINT32_MAX) return false;
+    if (n <= LPSTR_SMALL) {
+        memcpy(s->small.chars, chars, n);
+    } else {
+        char *heap = malloc(n + 1);
+        if (!heap) return false;
+        memcpy(heap, chars, n);
+        heap[n] = '\0';
+        s->large.chars = heap;
+        s->large.hash = lpstr_hash_bytes(chars, n);
+    }
+    s->small.length = (uint32_t)n;
+    return true;
+}
+
+static inline bool lpstr_from(lpstr *s, const char *cstr) {
+    return lpstr_init(s, cstr, strlen(cstr));
+}
+
+static inline void lpstr_free(lpstr *s) {
+    if (!lpstr_is_small(s)) free(s->large.chars);
+    memset(s, 0, sizeof(*s));
+}
+
+static inline uint32_t lpstr_hash(const lpstr *s) {
+    return lpstr_is_small(s) ? lpstr_hash_bytes(s->small.chars, s->small.length) : s->large.hash;
+}
+
+// Different lengths, or for long strings different hashes, settle it
+// before a byte is read; two small strings are two word compares
+static inline bool lpstr_equal(const lpstr *a, const lpstr *b) {
+    if (a->small.length != b->small.length) return false;
+    if (lpstr_is_small(a)) {
+        return lpstr_load(a->small.chars) == lpstr_load(b->small.chars) &&
+               lpstr_load_tail(a->small.chars + 8, 4) == lpstr_load_tail(b->small.chars + 8, 4);
+    }
+    return a->large.hash == b->large.hash &&
+           lpstr_equal_bytes(a->large.chars, b->large.chars, a->large.length);
+}
+
+static inline bool lpstr_equal_chars(const lpstr *s, const char *chars, size_t n) {
+    return lpstr_length(s) == n && lpstr_equal_bytes(lpstr_chars(s), chars, n);
+}
+
+// Index of the first c in s at or after from, or -1. A word at a time: c
+// in every byte, xor, and the zero bytes are where s had c
+static inline long lpstr_find_byte(const lpstr *s, char c, size_t from) {
+    const char *p = lpstr_chars(s);
+    size_t n = lpstr_length(s);
+    uint64_t pattern = LPSTR_ONES * (uint8_t)c;
+    size_t i = from;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t marks = lpstr_zero_bytes(lpstr_load(p + i) ^ pattern);
+        if (marks) return (long)(i + lpstr_first_mark(marks));
+    }
+    for (; i < n; i++) {
+        if (p[i] == c) return (long)i;
+    }
+    return -1;
+}
+
+// Index of the first needle[0..n) in s, or -1: the first byte found as
+// above, the rest compared a word at a time
+static inline long lpstr_find(const lpstr *s, const char *needle, size_t n) {
+    size_t length = lpstr_length(s);
+    if (n == 0) return 0;
+    if (n > length) return -1;
+    const char *p = lpstr_chars(s);
+    for (long at = lpstr_find_byte(s, needle[0], 0); at >= 0 && (size_t)at <= length - n;
+         at = lpstr_find_byte(s, needle[0], (size_t)at + 1)) {
+        if (lpstr_equal_bytes(p + at + 1, needle + 1, n - 1)) return at;
+    }
+    return -1;
+}
+
+// --- interning ---
+
+// Each string once, by id from 0 up. Open addressing with linear probing
+// in twice as many slots as there is room for ids; a slot holds id + 1, 0 if
+// empty, and the hashes are kept by id so a probe reads a string only
+// when the hash matches
+typedef struct {
+    lpstr *strings;
+    uint32_t *hashes;
+    size_t count, capacity;     // ids
+    uint32_t *slots;
+    size_t slot_count;
+} lpstr_table;
+
+static inline void lpstr_table_free(lpstr_table *t) {
+    for (size_t i = 0; i < t->count; i++) lpstr_free(&t->strings[i]);
+    free(t->strings);
+    free(t->hashes);
+    free(t->slots);
+    memset(t, 0, sizeof(*t));
+}
+
+static inline const lpstr *lpstr_table_get(const lpstr_table *t, uint32_t id) {
+    return id < t->count ? &t->strings[id] : NULL;
+}
+
+static inline bool lpstr_table_grow(lpstr_table *t) {
+    size_t capacity = t->capacity ? 2 * t->capacity : 16;
+    lpstr *strings = realloc(t->strings, capacity * sizeof(*strings));
+    if (!strings) return false;
+    t->strings = strings;
+    uint32_t *hashes = realloc(t->hashes, capacity * sizeof(*hashes));
+    if (!hashes) return false;
+    t->hashes = hashes;
+
+    size_t slot_count = capacity * 2;
+    uint32_t *slots = calloc(slot_count, sizeof(*slots));
+    if (!slots) return false;
+    t->capacity = capacity;
+    for (size_t id = 0; id < t->count; id++) {
+        size_t slot = t->hashes[id] & (slot_count - 1);
+        while (slots[slot]) slot = (slot + 1) & (slot_count - 1);
+        slots[slot] = (uint32_t)id + 1;
+    }
+    free(t->slots);
+    t->slots = slots;
+    t->slot_count = slot_count;
+    return true;
+}
+
+// Id of chars[0..n), added if it is new; -1 if there was no memory for it
+static inline long lpstr_intern(lpstr_table *t, const char *chars, size_t n) {
+    uint32_t hash = lpstr_hash_bytes(chars, n);
+    if (t->slot_count) {
+        size_t slot = hash & (t->slot_count - 1);
+        for (; t->slots[slot]; slot = (slot + 1) & (t->slot_count - 1)) {
+            uint32_t id = t->slots[slot] - 1;
+            if (t->hashes[id] == hash && lpstr_equal_chars(&t->strings[id], chars, n)) return id;
+        }
+    }
+    if (t->count == t->capacity && !lpstr_table_grow(t)) return -1;
+
+    uint32_t id = (uint32_t)t->count;
+    if (!lpstr_init(&t->strings[id], chars, n)) return -1;
+    t->hashes[id] = hash;
+    t->count++;
+    size_t slot = hash & (t->slot_count - 1);
+    while (t->slots[slot]) slot = (slot + 1) & (t->slot_count - 1);
+    t->slots[slot] = id + 1;
+    return id;
+}
+
+static inline long lpstr_intern_cstr(lpstr_table *t, const char *cstr) {
+    return lpstr_intern(t, cstr, strlen(cstr));
+}
+
+#endif // LPSTR_H
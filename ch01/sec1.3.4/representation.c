@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <time.h>
+#include "lpstr.h"
 
 /* null terminalted strings vs length-prefixed strings in C */
 
@@ -166,6 +168,73 @@ void demonstrate_advantages() {
     printf("    some binary formats, embedded systems\n");
 }
 
+
+// lpstr.h, the same idea made into a library
+
+void demonstrate_lpstr() {
+    printf("\n-- lpstr --\n\n");
+
+    lpstr small, large, other;
+    lpstr_from(&small, "Hello");
+    lpstr_from(&large, "Hello, length-prefixed world");
+    lpstr_from(&other, "Hello, length-prefixed world");
+
+    printf("sizeof(lpstr) = %zu, up to %d bytes held inline\n", sizeof(lpstr), LPSTR_SMALL);
+    printf("\"%s\": length %zu, %s\n", lpstr_chars(&small), lpstr_length(&small),
+           lpstr_is_small(&small) ? "inline" : "on the heap");
+    printf("\"%s\": length %zu, %s\n", lpstr_chars(&large), lpstr_length(&large),
+           lpstr_is_small(&large) ? "inline" : "on the heap");
+    printf("equal to a copy: %s, to \"Hello\": %s\n",
+           lpstr_equal(&large, &other) ? "yes" : "no", lpstr_equal(&large, &small) ? "yes" : "no");
+    printf("',' at %ld, \"prefixed\" at %ld, \"suffixed\" at %ld\n",
+           lpstr_find_byte(&large, ',', 0), lpstr_find(&large, "prefixed", 8),
+           lpstr_find(&large, "suffixed", 8));
+
+    lpstr_table names = { 0 };
+    const char *words[] = { "car", "cdr", "cons", "car", "lambda", "cons" };
+    printf("interned:");
+    for (size_t i = 0; i < sizeof(words) / sizeof(words[0]); i++) {
+        printf(" %s=%ld", words[i], lpstr_intern_cstr(&names, words[i]));
+    }
+    printf(", %zu names\n", names.count);
+
+    // The same lookups by strcmp() and by interned id
+    enum { NAMES = 200, LOOKUPS = 2000000 };
+    char keys[NAMES][24];
+    long ids[NAMES];
+    for (int i = 0; i < NAMES; i++) {
+        snprintf(keys[i], sizeof(keys[i]), "identifier-%d", i);
+        ids[i] = lpstr_intern_cstr(&names, keys[i]);
+    }
+    unsigned seed = 1, found = 0;
+    clock_t start = clock();
+    for (int n = 0; n < LOOKUPS; n++) {
+        seed = seed * 1103515245u + 12345u;
+        const char *key = keys[(seed >> 16) % NAMES];
+        for (int i = 0; i < NAMES; i++) {
+            if (strcmp(keys[i], key) == 0) { found += i; break; }
+        }
+    }
+    double by_name = (double)(clock() - start) / CLOCKS_PER_SEC;
+    seed = 1;
+    start = clock();
+    for (int n = 0; n < LOOKUPS; n++) {
+        seed = seed * 1103515245u + 12345u;
+        long key = ids[(seed >> 16) % NAMES];
+        for (int i = 0; i < NAMES; i++) {
+            if (ids[i] == key) { found -= i; break; }
+        }
+    }
+    double by_id = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("%d lookups among %d names: strcmp %.3f s, interned ids %.3f s%s\n",
+           LOOKUPS, NAMES, by_name, by_id, found ? " (mismatch!)" : "");
+
+    lpstr_table_free(&names);
+    lpstr_free(&small);
+    lpstr_free(&large);
+    lpstr_free(&other);
+}
+
 int main() {
     printf("C stringstorage methods\n");
     printf("-----------------------\n");
@@ -173,6 +242,7 @@ int main() {
     demonstrate_memory_layout();
     demonstrate_operations();
     demonstrate_advantages();
+    demonstrate_lpstr();
     
     return 0;
 }
@@ -1,56 +1,217 @@
 #include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
 
+// gcc -O2 frac.c -o frac && ./frac
+
+// Numerator and denominator are 64-bit, the denominator kept positive
+// and the fraction in lowest terms. A result that does not fit, or a
+// division by zero, is the undefined fraction 0/0
 typedef struct {
-    int numerator;
-    int denominator;
+    int64_t numerator;
+    int64_t denominator;
 } Fraction;
 
-int gcd(int a, int b) {
-    while (b != 0) {
-        int temp = b;
-        b = a % b;
-        a = temp;
+static const Fraction undefined = {0, 0};
+
+// Intermediate products are twice as wide where the compiler has a
+// 128-bit integer; the overflow checks below work for either width
+#ifdef __SIZEOF_INT128__
+typedef __int128 wide_t;
+typedef unsigned __int128 uwide_t;
+#else
+typedef int64_t wide_t;
+typedef uint64_t uwide_t;
+#endif
+
+static int ctz64(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static int ctz_wide(uwide_t x) {
+    uint64_t low = (uint64_t)x;
+    return low ? ctz64(low) : 64 + ctz64((uint64_t)(x >> 32 >> 32));
+}
+
+// Stein's binary GCD: the common factors of two are counted once, then
+// odd numbers are only subtracted and shifted, with no division
+uint64_t gcd_u64(uint64_t a, uint64_t b) {
+    if (a == 0) return b;
+    if (b == 0) return a;
+    int shift = ctz64(a | b);
+    a >>= ctz64(a);
+    do {
+        b >>= ctz64(b);
+        if (a > b) {
+            uint64_t t = a;
+            a = b;
+            b = t;
+        }
+        b -= a;
+    } while (b != 0);
+    return a << shift;
+}
+
+static uwide_t gcd_wide(uwide_t a, uwide_t b) {
+    if (a == 0) return b;
+    if (b == 0) return a;
+    int shift = ctz_wide(a | b);
+    a >>= ctz_wide(a);
+    do {
+        b >>= ctz_wide(b);
+        if (a > b) {
+            uwide_t t = a;
+            a = b;
+            b = t;
+        }
+        b -= a;
+    } while (b != 0);
+    return a << shift;
+}
+
+static uint64_t magnitude(int64_t x) {
+    return x < 0 ? 0u - (uint64_t)x : (uint64_t)x;
+}
+
+static uwide_t wide_magnitude(wide_t x) {
+    return x < 0 ? 0u - (uwide_t)x : (uwide_t)x;
+}
+
+int64_t gcd(int64_t a, int64_t b) {
+    return (int64_t)gcd_u64(magnitude(a), magnitude(b));
+}
+
+// n/d from wide parts: sign into the numerator, lowest terms, and range
+static Fraction make(wide_t n, wide_t d) {
+    if (d == 0) return undefined;
+    if (d < 0) {
+        n = -n;
+        d = -d;
+    }
+    uwide_t g = gcd_wide(wide_magnitude(n), (uwide_t)d);
+    if (g > 1) {
+        n /= (wide_t)g;
+        d /= (wide_t)g;
     }
-    return a;
+    if (n < INT64_MIN || n > INT64_MAX || d > INT64_MAX) return undefined;
+    return (Fraction){(int64_t)n, (int64_t)d};
 }
 
 Fraction simplify(Fraction frac) {
-    int common = gcd(frac.numerator, frac.denominator);
-    frac.numerator /= common;
-    frac.denominator /= common;
-    return frac;
+    return make(frac.numerator, frac.denominator);
 }
 
+static bool is_undefined(Fraction f) {
+    return f.denominator == 0;
+}
+
+// a/b + c/d over the least common denominator: with g = gcd(b, d) the
+// cross products are a (d/g) and c (b/g), and only a factor of g can
+// still divide the sum, so the last gcd is of the sum and g
 Fraction add(Fraction f1, Fraction f2) {
-    Fraction result;
-    result.numerator = f1.numerator * f2.denominator + f1.denominator * f2.numerator;
-    result.denominator = f1.denominator * f2.denominator;
-    return simplify(result);
+    if (is_undefined(f1) || is_undefined(f2)) return undefined;
+    int64_t g = gcd(f1.denominator, f2.denominator);
+    wide_t b = f1.denominator / g, d = f2.denominator / g;
+    wide_t x, y, n, den;
+    if (__builtin_mul_overflow((wide_t)f1.numerator, d, &x) ||
+        __builtin_mul_overflow((wide_t)f2.numerator, b, &y) ||
+        __builtin_add_overflow(x, y, &n)) return undefined;
+    if (n == 0) return (Fraction){0, 1};
+    wide_t g2 = (wide_t)gcd_wide(wide_magnitude(n), (uwide_t)g);
+    n /= g2;
+    if (__builtin_mul_overflow(b, (wide_t)(f2.denominator / g2), &den) ||
+        n < INT64_MIN || n > INT64_MAX || den > INT64_MAX) return undefined;
+    return (Fraction){(int64_t)n, (int64_t)den};
 }
 
 Fraction subtract(Fraction f1, Fraction f2) {
-    Fraction result;
-    result.numerator = f1.numerator * f2.denominator - f1.denominator * f2.numerator;
-    result.denominator = f1.denominator * f2.denominator;
-    return simplify(result);
+    if (f2.numerator == INT64_MIN) return add(f1, make(-(wide_t)f2.numerator, f2.denominator));
+    return add(f1, (Fraction){-f2.numerator, f2.denominator});
 }
 
+// Cancelled across before multiplying, a/b * c/d = (a/g1)(c/g2) over
+// (b/g2)(d/g1), so the products are as small as they can be and the
+// result is already in lowest terms
 Fraction multiply(Fraction f1, Fraction f2) {
-    Fraction result;
-    result.numerator = f1.numerator * f2.numerator;
-    result.denominator = f1.denominator * f2.denominator;
-    return simplify(result);
+    if (is_undefined(f1) || is_undefined(f2)) return undefined;
+    int64_t g1 = gcd(f1.numerator, f2.denominator), g2 = gcd(f2.numerator, f1.denominator);
+    wide_t n, d;
+    if (__builtin_mul_overflow((wide_t)(f1.numerator / g1), (wide_t)(f2.numerator / g2), &n) ||
+        __builtin_mul_overflow((wide_t)(f1.denominator / g2), (wide_t)(f2.denominator / g1), &d))
+        return undefined;
+    if (n == 0) return (Fraction){0, 1};
+    if (n < INT64_MIN || n > INT64_MAX || d > INT64_MAX) return undefined;
+    return (Fraction){(int64_t)n, (int64_t)d};
 }
 
 Fraction divide(Fraction f1, Fraction f2) {
-    Fraction result;
-    result.numerator = f1.numerator * f2.denominator;
-    result.denominator = f1.denominator * f2.numerator;
-    return simplify(result);
+    if (is_undefined(f2) || f2.numerator == 0) return undefined;
+    Fraction inverse = f2.numerator < 0 ? make(-(wide_t)f2.denominator, -(wide_t)f2.numerator)
+                                        : (Fraction){f2.denominator, f2.numerator};
+    return multiply(f1, inverse);
+}
+
+// The sum of n fractions with the normalising left to the end. The
+// running denominator is the lcm of those so far, so each step needs
+// only the gcd of two denominators; the numerator grows unreduced, and
+// is cancelled against the denominator once, at the end
+Fraction fraction_sum(const Fraction *f, int n) {
+    wide_t num = 0, den = 1;
+    for (int i = 0; i < n; i++) {
+        if (is_undefined(f[i])) return undefined;
+        wide_t d = f[i].denominator;
+        wide_t g = (wide_t)gcd_wide((uwide_t)den, wide_magnitude(d));
+        wide_t scale = d / g, x, y;
+        if (__builtin_mul_overflow(num, scale, &num) ||
+            __builtin_mul_overflow((wide_t)f[i].numerator, den / g, &x) ||
+            __builtin_add_overflow(num, x, &y) ||
+            __builtin_mul_overflow(den, scale, &den)) return undefined;
+        num = y;
+    }
+    return make(num, den);
 }
 
 void print_fraction(Fraction f) {
-    printf("%d/%d\n", f.numerator, f.denominator);
+    if (is_undefined(f)) {
+        printf("undefined\n");
+        return;
+    }
+    printf("%lld/%lld\n", (long long)f.numerator, (long long)f.denominator);
+}
+
+// The harmonic numbers H(n) = 1/1 + 1/2 + .. + 1/n, summed with add()
+// one term at a time and with fraction_sum() at once
+static void benchmark_harmonic(int n, int rounds) {
+    Fraction terms[64];
+    for (int i = 0; i < n; i++) terms[i] = (Fraction){1, i + 1};
+
+    clock_t start = clock();
+    Fraction h = {0, 1};
+    for (int r = 0; r < rounds; r++) {
+        h = (Fraction){0, 1};
+        for (int i = 0; i < n; i++) h = add(h, terms[i]);
+    }
+    double t_add = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    Fraction s = {0, 1};
+    for (int r = 0; r < rounds; r++) s = fraction_sum(terms, n);
+    double t_sum = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("H(%d) = ", n);
+    print_fraction(s);
+    printf("  %d rounds: add %.3f s, fraction_sum %.3f s, %s\n", rounds, t_add, t_sum,
+           h.numerator == s.numerator && h.denominator == s.denominator ? "same" : "DIFFERENT");
 }
 
 int main() {
@@ -69,5 +230,21 @@ int main() {
     printf("Division: ");
     print_fraction(divide(f1, f2));   // output: 2/3
 
+    // Cross products past 64 bits that cancel back into range
+    Fraction big1 = {3000000000LL, 7000000001LL};
+    Fraction big2 = {7000000001LL, 9000000000LL};
+    printf("Large product: ");
+    print_fraction(multiply(big1, big2));   // output: 1/3
+
+    printf("Division by zero: ");
+    print_fraction(divide(f1, (Fraction){0, 1}));   // output: undefined
+
+    // the last harmonic number with a 64-bit numerator
+    benchmark_harmonic(46, 20000);
+    Fraction terms[47];
+    for (int i = 0; i < 47; i++) terms[i] = (Fraction){1, i + 1};
+    printf("H(47): ");
+    print_fraction(fraction_sum(terms, 47));    // output: undefined
+
     return 0;
 }
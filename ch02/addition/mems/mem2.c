@@ -2,10 +2,44 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include "memstats.h"
 
 // --- allocator ---
 #define MEMORY_POOL_SIZE 1024 * 2
-uint8_t memory_pool[MEMORY_POOL_SIZE];
+_Alignas(16) uint8_t memory_pool[MEMORY_POOL_SIZE];
+
+#ifdef SEGFIT
+#include "segfit.h"
+
+void memory_init() {
+    segfit_init(memory_pool, MEMORY_POOL_SIZE);
+    printf("Memory initialized: %zu bytes available\n", segfit.free_bytes - SEGFIT_OVERHEAD);
+}
+
+void* mem_malloc(size_t size) {
+    MEMSTATS_BEGIN();
+    void* ptr = segfit_malloc(size);
+    if (ptr != NULL) {
+        printf("Allocated %zu bytes at address %p\n", size, ptr);
+    } else {
+        printf("Memory allocation failed for %zu bytes\n", size);
+    }
+    return MEMSTATS_ALLOC(ptr, size, ptr ? segfit_usable(ptr) : 0);
+}
+
+void mem_free(void* ptr) {
+    if (ptr == NULL) return;
+    MEMSTATS_BEGIN();
+    segfit_free(ptr);
+    printf("Freed block at address %p\n", ptr);
+    MEMSTATS_FREE(ptr);
+}
+
+void free_space(size_t* free_bytes, size_t* largest) {
+    *free_bytes = segfit.free_bytes;
+    *largest = segfit_largest_free();
+}
+#else
 
 typedef struct BlockHeader {
     size_t size;
@@ -51,32 +85,70 @@ void merge_free_blocks() {
     }
 }
 
+// keep headers aligned, now that strings of any length are allocated
+size_t round_size(size_t size) {
+    return (size + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+}
+
 // allocator function (malloc equivalent)
 void* mem_malloc(size_t size) {
+    MEMSTATS_BEGIN();
+    size_t rounded = round_size(size);
     BlockHeader* current = free_list;
     while (current != NULL) {
-        if (current->is_free && current->size >= size) {
-            if (current->size > size + sizeof(BlockHeader)) {
-                split_block(current, size);  // split block if it's large enough
+        if (current->is_free && current->size >= rounded) {
+            if (current->size > rounded + sizeof(BlockHeader)) {
+                split_block(current, rounded);  // split block if it's large enough
             }
             current->is_free = 0;
             printf("Allocated %zu bytes at address %p\n", size, (void*)((uint8_t*)current + sizeof(BlockHeader)));
-            return (void*)((uint8_t*)current + sizeof(BlockHeader));
+            return MEMSTATS_ALLOC((void*)((uint8_t*)current + sizeof(BlockHeader)), size, current->size);
         }
         current = current->next;
     }
     printf("Memory allocation failed for %zu bytes\n", size);
-    return NULL;
+    return MEMSTATS_ALLOC(NULL, size, 0);
 }
 
 void mem_free(void* ptr) {
     if (ptr == NULL) return;
+    MEMSTATS_BEGIN();
     BlockHeader* block = (BlockHeader*)((uint8_t*)ptr - sizeof(BlockHeader));
     block->is_free = 1;
     printf("Freed block at address %p\n", ptr);
     merge_free_blocks();
+    MEMSTATS_FREE(ptr);
 }
 
+void free_space(size_t* free_bytes, size_t* largest) {
+    *free_bytes = *largest = 0;
+    for (BlockHeader* b = (BlockHeader*)memory_pool; b != NULL; b = b->next) {
+        if (!b->is_free) continue;
+        *free_bytes += b->size;
+        if (b->size > *largest) *largest = b->size;
+    }
+}
+#endif /* SEGFIT */
+
+#ifdef MEMSTATS
+void memory_dump() {
+    size_t free_bytes, largest;
+    free_space(&free_bytes, &largest);
+    memstats_dump("mem2", free_bytes, largest);
+}
+
+int replay(const char* path) {
+    memory_init();
+    memstats_reset();
+    if (memstats_replay(path, mem_malloc, mem_free, NULL) < 0) {
+        printf("Cannot read %s\n", path);
+        return 1;
+    }
+    memory_dump();
+    return 0;
+}
+#endif
+
 // --- machine & objects ---
 
 // object types
@@ -86,126 +158,160 @@ typedef struct {
     ObjectType type;
 } Object;
 
+// only strings too long for a slot live in the heap, header and
+// characters in one block
 typedef struct {
     Object base;
-    int value;
-} IntObject;
+    size_t length;
+    char value[];
+} StringObject;
 
-typedef struct {
-    Object base;
-    float value;
-} FloatObject;
+// A slot holds small values in itself: ints, floats and strings of up to
+// SLOT_INLINE - 1 characters. Reading them needs no pointer to follow and
+// storing them no allocation; four slots fit in a 64 byte cache line
+#define SLOT_INLINE 14
 
-typedef struct {
-    Object base;
-    char* value;
-} StringObject;
+typedef enum { EMPTY_SLOT, INT_SLOT, FLOAT_SLOT, STRING_SLOT, OBJECT_SLOT } SlotTag;
+
+typedef union {
+    uint8_t tag;    // first in every variant
+    struct { uint8_t tag; int value; } i;
+    struct { uint8_t tag; float value; } f;
+    struct { uint8_t tag; uint8_t length; char chars[SLOT_INLINE]; } str;
+    struct { uint8_t tag; Object* object; } obj;
+} Slot;
 
 // --- machine ---
 typedef struct Machine {
-    void** array;
+    Slot* array;
     size_t size;
 } Machine;
 
 void machine_init(Machine* vm, size_t initial_size) {
-    vm->array = (void**)mem_malloc(initial_size * sizeof(void*));
+    vm->array = (Slot*)mem_malloc(initial_size * sizeof(Slot));
     if (vm->array == NULL) {
         printf("Memory allocation failed for VM array!\n");
         exit(1);
     }
     vm->size = initial_size;
-    for (size_t i = 0; i < initial_size; i++) {
-        vm->array[i] = NULL;
+    memset(vm->array, 0, initial_size * sizeof(Slot));  // all EMPTY_SLOT
+}
+
+// grow the array to at least min_size slots, doubling so that n appends
+// cost O(n) copying in total instead of O(n^2)
+int machine_grow(Machine* vm, size_t min_size) {
+    size_t new_size = vm->size ? vm->size : 1;
+    while (new_size < min_size) {
+        new_size *= 2;
+    }
+
+    Slot* array = (Slot*)mem_malloc(new_size * sizeof(Slot));
+    if (array == NULL) {
+        printf("Memory allocation failed growing VM array to %zu slots!\n", new_size);
+        return 0;
     }
+    memcpy(array, vm->array, vm->size * sizeof(Slot));
+    memset(array + vm->size, 0, (new_size - vm->size) * sizeof(Slot));
+    printf("VM array grown from %zu to %zu slots, %zu bytes copied\n",
+        vm->size, new_size, vm->size * sizeof(Slot));
+    mem_free(vm->array);
+    vm->array = array;
+    vm->size = new_size;
+    return 1;
+}
+
+void machine_delete(Machine* vm, size_t index) {
+    if (index >= vm->size) return;
+    if (vm->array[index].tag == OBJECT_SLOT) {
+        mem_free(vm->array[index].obj.object);
+    }
+    vm->array[index].tag = EMPTY_SLOT;
 }
 
 void machine_add(Machine* vm, size_t index, ObjectType type, void* value) {
-    if (index >= vm->size) {
-        printf("Index out of bounds: %zu\n", index);
+    if (index >= vm->size && !machine_grow(vm, index + 1)) {
         return;
     }
+    machine_delete(vm, index);
+    Slot* slot = &vm->array[index];
 
     if (type == INT_OBJECT) {
-        IntObject* obj = (IntObject*)mem_malloc(sizeof(IntObject));
-        if (obj == NULL) {
-            printf("Memory allocation failed for IntObject!\n");
-            return;
-        }
-        obj->base.type = INT_OBJECT;
-        obj->value = *(int*)value;
-        vm->array[index] = obj;
+        slot->i.tag = INT_SLOT;
+        slot->i.value = *(int*)value;
 
     } else if (type == FLOAT_OBJECT) {
-        FloatObject* obj = (FloatObject*)mem_malloc(sizeof(FloatObject));
-        if (obj == NULL) {
-            printf("Memory allocation failed for FloatObject!\n");
-            return;
-        }
-        obj->base.type = FLOAT_OBJECT;
-        obj->value = *(float*)value;
-        vm->array[index] = obj;
+        slot->f.tag = FLOAT_SLOT;
+        slot->f.value = *(float*)value;
 
     } else if (type == STRING_OBJECT) {
-        StringObject* obj = (StringObject*)mem_malloc(sizeof(StringObject));
+        size_t length = strlen((char*)value);
+        if (length < SLOT_INLINE) {
+            slot->str.tag = STRING_SLOT;
+            slot->str.length = (uint8_t)length;
+            memcpy(slot->str.chars, value, length + 1);
+            return;
+        }
+        StringObject* obj = (StringObject*)mem_malloc(sizeof(StringObject) + length + 1);
         if (obj == NULL) {
             printf("Memory allocation failed for StringObject!\n");
             return;
         }
         obj->base.type = STRING_OBJECT;
-        obj->value = strdup((char*)value);
-        if (obj->value == NULL) {
-            printf("Memory allocation failed for string copy!\n");
-            mem_free(obj);
-            return;
-        }
-        vm->array[index] = obj;
+        obj->length = length;
+        memcpy(obj->value, value, length + 1);
+        slot->obj.tag = OBJECT_SLOT;
+        slot->obj.object = &obj->base;
     }
 }
 
 void machine_display(Machine* vm) {
-    printf("Array contents (object references):\n");
+    printf("Array contents (inline values and object references):\n");
     for (size_t i = 0; i < vm->size; i++) {
-        Object* obj = (Object*)vm->array[i];
-        if (obj == NULL) {
-            printf("[%zu]: NULL\n", i);
-        } else {
-            switch (obj->type) {
-                case INT_OBJECT: {
-                    IntObject* int_obj = (IntObject*)obj;
-                    printf("[%zu]: INT = %d\n", i, int_obj->value);
-                    break;
-                }
-                case FLOAT_OBJECT: {
-                    FloatObject* float_obj = (FloatObject*)obj;
-                    printf("[%zu]: FLOAT = %f\n", i, float_obj->value);
-                    break;
-                }
-                case STRING_OBJECT: {
-                    StringObject* str_obj = (StringObject*)obj;
-                    printf("[%zu]: STRING = %s\n", i, str_obj->value);
-                    break;
-                }
-                default:
+        Slot* slot = &vm->array[i];
+        switch (slot->tag) {
+            case EMPTY_SLOT:
+                printf("[%zu]: NULL\n", i);
+                break;
+            case INT_SLOT:
+                printf("[%zu]: INT = %d\n", i, slot->i.value);
+                break;
+            case FLOAT_SLOT:
+                printf("[%zu]: FLOAT = %f\n", i, slot->f.value);
+                break;
+            case STRING_SLOT:
+                printf("[%zu]: STRING = %s (inline)\n", i, slot->str.chars);
+                break;
+            case OBJECT_SLOT: {
+                Object* obj = slot->obj.object;
+                if (obj->type == STRING_OBJECT) {
+                    printf("[%zu]: STRING = %s\n", i, ((StringObject*)obj)->value);
+                } else {
                     printf("[%zu]: UNKNOWN OBJECT\n", i);
+                }
+                break;
             }
+            default:
+                printf("[%zu]: UNKNOWN SLOT\n", i);
         }
     }
 }
 
-void machine_delete(Machine* vm, size_t index) {
-    if (index >= vm->size || vm->array[index] == NULL) return;
-
-    Object* obj = (Object*)vm->array[index];
-    if (obj->type == STRING_OBJECT) {
-        StringObject* str_obj = (StringObject*)obj;
-        free(str_obj->value);  // free duplicated string!
-    }
-    mem_free(obj);
-    vm->array[index] = NULL;
-}
-
 // sample
-int main() {
+int main(int argc, char* argv[]) {
+#ifdef MEMSTATS
+    if (argc > 2 && strcmp(argv[1], "replay") == 0) {
+        return replay(argv[2]);
+    }
+    if (argc > 2 && strcmp(argv[1], "trace") == 0) {
+        if (memstats_trace_file(argv[2]) < 0) {
+            printf("Cannot write %s\n", argv[2]);
+            return 1;
+        }
+    }
+#else
+    (void)argc;
+    (void)argv;
+#endif
     memory_init();
     Machine vm;
     machine_init(&vm, 5);
@@ -228,6 +334,16 @@ int main() {
     char str_val2[] = "Hi, to you!";
     machine_add(&vm, 3, STRING_OBJECT, str_val2);
 
+    // too long for a slot: a heap block
+    char str_val3[] = "A string that does not fit in a slot";
+    machine_add(&vm, 4, STRING_OBJECT, str_val3);
+
+    machine_display(&vm);
+
+    // past the end: the array grows (doubles) to make room
+    int int_val2 = 7;
+    machine_add(&vm, 7, INT_OBJECT, &int_val2);
+
     machine_display(&vm);
 
     // clean
@@ -236,5 +352,11 @@ int main() {
     }
     mem_free(vm.array);
 
+#ifdef SEGFIT
+    segfit_report();
+#endif
+#ifdef MEMSTATS
+    memory_dump();
+#endif
     return 0;
 }
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include "memstats.h"
 
 // --- memory allocator ---
 
@@ -10,6 +11,47 @@
 
 uint8_t memory_pool[MEMORY_POOL_SIZE];
 
+#ifdef SEGFIT
+#include "segfit.h"
+
+void memory_init() {
+    memset(memory_pool, 0, MEMORY_POOL_SIZE);
+    segfit_init(memory_pool, MEMORY_POOL_SIZE);
+}
+
+void* mem_malloc(size_t size) {
+    MEMSTATS_BEGIN();
+    void* ptr = segfit_malloc(size);
+    return MEMSTATS_ALLOC(ptr, size, ptr ? segfit_usable(ptr) : 0);
+}
+
+void mem_free(void* ptr) {
+    if (!ptr) return;
+    MEMSTATS_BEGIN();
+    segfit_free(ptr);
+    MEMSTATS_FREE(ptr);
+}
+
+void free_all() {
+    segfit_free_all();
+    MEMSTATS_FREE_ALL();
+    printf("All blocks freed.\n");
+}
+
+void free_space(size_t* free_bytes, size_t* largest) {
+    *free_bytes = segfit.free_bytes;
+    *largest = segfit_largest_free();
+}
+
+// free neighbours are merged as soon as a block is freed
+void defragment() {
+}
+
+void print_memory() {
+    segfit_print();
+}
+#else
+
 typedef struct BlockHeader {
     size_t size;
     int is_free;
@@ -48,6 +90,7 @@ BlockHeader* find_free_block(size_t size) {
 
 // allocator (malloc equivalent)
 void* mem_malloc(size_t size) {
+    MEMSTATS_BEGIN();
     size += sizeof(BlockHeader);  // total size with header
     BlockHeader* block = find_free_block(size);
 
@@ -69,16 +112,18 @@ void* mem_malloc(size_t size) {
                 }
             }
         }
-        return (uint8_t*)block + sizeof(BlockHeader);
+        return MEMSTATS_ALLOC((uint8_t*)block + sizeof(BlockHeader), size - sizeof(BlockHeader), block->size);
     }
-    return NULL;
+    return MEMSTATS_ALLOC(NULL, size - sizeof(BlockHeader), 0);
 }
 
 // free
 void mem_free(void* ptr) {
     if (!ptr) return;
+    MEMSTATS_BEGIN();
     BlockHeader* block = (BlockHeader*)((uint8_t*)ptr - sizeof(BlockHeader));
     block->is_free = 1;
+    MEMSTATS_FREE(ptr);
 }
 
 // free at last!
@@ -88,9 +133,20 @@ void free_all() {
         current->is_free = 1;
         current = (BlockHeader*)((uint8_t*)current + sizeof(BlockHeader) + current->size);
     }
+    MEMSTATS_FREE_ALL();
     printf("All blocks freed.\n");
 }
 
+void free_space(size_t* free_bytes, size_t* largest) {
+    *free_bytes = *largest = 0;
+    for (int i = 0; i < MAX_BLOCKS; i++) {
+        BlockHeader* block = block_table[i].block;
+        if (!block_table[i].in_use || !block->is_free) continue;
+        *free_bytes += block->size;
+        if (block->size > *largest) *largest = block->size;
+    }
+}
+
 void defragment() {
     uint8_t* compact_ptr = memory_pool;
     int table_index = 0;
@@ -138,9 +194,42 @@ void print_memory() {
     }
     printf("\n");
 }
+#endif /* SEGFIT */
 
+#ifdef MEMSTATS
+void memory_dump() {
+    size_t free_bytes, largest;
+    free_space(&free_bytes, &largest);
+    memstats_dump("mem3", free_bytes, largest);
+}
 
-int main() {
+int replay(const char* path) {
+    memory_init();
+    memstats_reset();
+    if (memstats_replay(path, mem_malloc, mem_free, NULL) < 0) {
+        printf("Cannot read %s\n", path);
+        return 1;
+    }
+    memory_dump();
+    return 0;
+}
+#endif
+
+int main(int argc, char* argv[]) {
+#ifdef MEMSTATS
+    if (argc > 2 && strcmp(argv[1], "replay") == 0) {
+        return replay(argv[2]);
+    }
+    if (argc > 2 && strcmp(argv[1], "trace") == 0) {
+        if (memstats_trace_file(argv[2]) < 0) {
+            printf("Cannot write %s\n", argv[2]);
+            return 1;
+        }
+    }
+#else
+    (void)argc;
+    (void)argv;
+#endif
     memory_init();
     print_memory();
 
@@ -208,5 +297,11 @@ int main() {
     free_all();
     print_memory();
     
+#ifdef SEGFIT
+    segfit_report();
+#endif
+#ifdef MEMSTATS
+    memory_dump();
+#endif
     return 0;
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include "memstats.h"
 
 #define MEMORY_POOL_SIZE 1024 // max memory
 #define BLOCK_SIZE 64
@@ -35,6 +36,7 @@ void memory_pool_init() {
 
 // allocate memory from pool
 void* pool_malloc() {
+    MEMSTATS_BEGIN();
     BlockHeader* current = free_list;
 
     // find first free block
@@ -45,10 +47,11 @@ void* pool_malloc() {
     if (current != NULL) {
         current->is_free = 0;  // mark block as allocated
         current->ref_count = 1;  // init. ref. count to 1
-        return (void*)((uint8_t*)current + sizeof(BlockHeader));  // return block address (after header)
+        void* ptr = (uint8_t*)current + sizeof(BlockHeader);  // block address (after header)
+        return MEMSTATS_ALLOC(ptr, BLOCK_SIZE - sizeof(BlockHeader), BLOCK_SIZE - sizeof(BlockHeader));
     }
 
-    return NULL;  // no free blocks
+    return MEMSTATS_ALLOC(NULL, BLOCK_SIZE - sizeof(BlockHeader), 0);  // no free blocks
 }
 
 // increment ref. count of block
@@ -63,13 +66,17 @@ void pool_retain(void* ptr) {
 void pool_release(void* ptr) {
     if (ptr == NULL) return;
 
+    MEMSTATS_BEGIN();
     BlockHeader* block = (BlockHeader*)((uint8_t*)ptr - sizeof(BlockHeader));
     block->ref_count--;
 
     if (block->ref_count == 0) {
         block->is_free = 1;  // free block, if ref. count is 0
+        MEMSTATS_FREE(ptr);
         printf("Block at address %p is now freed\n", ptr);
+        return;
     }
+    MEMSTATS_SKIP();  // still referenced, nothing freed
 }
 
 // Object structures
@@ -106,7 +113,40 @@ Computer* create_computer(const char* brand, int year) {
 }
 
 
-int main() {
+#ifdef MEMSTATS
+// every block is as good as another, so no external fragmentation
+void* replay_malloc(size_t size) {
+    return size <= BLOCK_SIZE - sizeof(BlockHeader) ? pool_malloc() : NULL;
+}
+
+int replay(const char* path) {
+    memory_pool_init();
+    memstats_reset();
+    if (memstats_replay(path, replay_malloc, pool_release, NULL) < 0) {
+        printf("Cannot read %s\n", path);
+        return 1;
+    }
+    memstats_dump("memo", 0, 0);
+    return 0;
+}
+#endif
+
+
+int main(int argc, char* argv[]) {
+#ifdef MEMSTATS
+    if (argc > 2 && strcmp(argv[1], "replay") == 0) {
+        return replay(argv[2]);
+    }
+    if (argc > 2 && strcmp(argv[1], "trace") == 0) {
+        if (memstats_trace_file(argv[2]) < 0) {
+            printf("Cannot write %s\n", argv[2]);
+            return 1;
+        }
+    }
+#else
+    (void)argc;
+    (void)argv;
+#endif
     memory_pool_init();
 
     // create
@@ -134,5 +174,8 @@ int main() {
     pool_release(bob); // decrement ref. count (not freed yet)
     pool_release(bob); // now Bob is freed
 
+#ifdef MEMSTATS
+    memstats_dump("memo", 0, 0);
+#endif
     return 0;
 }
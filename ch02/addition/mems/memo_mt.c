@@ -0,0 +1,193 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+// multi-threaded version of memo.c: every thread keeps a small magazine
+// of free blocks and only goes to the shared depot, under its lock, to
+// refill or return half a magazine at a time
+
+#define BLOCK_SIZE 64
+#define BLOCK_COUNT 4096
+#define MAGAZINE_SIZE 32
+#define BATCH (MAGAZINE_SIZE / 2)
+
+typedef struct BlockHeader {
+    atomic_int ref_count;  // ref. count, shared between threads
+    struct BlockHeader* next;  // next block in the depot
+} BlockHeader;
+
+_Alignas(16) uint8_t memory_pool[BLOCK_COUNT * BLOCK_SIZE];
+
+// shared depot of free blocks
+typedef struct {
+    pthread_mutex_t lock;
+    BlockHeader* free_list;
+    int free_count;
+    long lock_count;  // times the lock was taken
+} Depot;
+
+Depot depot = { PTHREAD_MUTEX_INITIALIZER, NULL, 0, 0 };
+
+// per thread cache
+typedef struct {
+    BlockHeader* rounds[MAGAZINE_SIZE];
+    int count;
+} Magazine;
+
+_Thread_local Magazine magazine;
+
+void memory_pool_init() {
+    depot.free_list = NULL;
+    for (int i = BLOCK_COUNT - 1; i >= 0; --i) {
+        BlockHeader* block = (BlockHeader*)(memory_pool + i * BLOCK_SIZE);
+        atomic_init(&block->ref_count, 0);
+        block->next = depot.free_list;
+        depot.free_list = block;
+    }
+    depot.free_count = BLOCK_COUNT;
+}
+
+// move up to BATCH blocks from the depot into this thread's magazine
+int magazine_refill() {
+    pthread_mutex_lock(&depot.lock);
+    depot.lock_count++;
+    while (magazine.count < BATCH && depot.free_list != NULL) {
+        BlockHeader* block = depot.free_list;
+        depot.free_list = block->next;
+        depot.free_count--;
+        magazine.rounds[magazine.count++] = block;
+    }
+    pthread_mutex_unlock(&depot.lock);
+    return magazine.count;
+}
+
+// hand blocks back to the depot until only keep are left
+void magazine_return(int keep) {
+    pthread_mutex_lock(&depot.lock);
+    depot.lock_count++;
+    while (magazine.count > keep) {
+        BlockHeader* block = magazine.rounds[--magazine.count];
+        block->next = depot.free_list;
+        depot.free_list = block;
+        depot.free_count++;
+    }
+    pthread_mutex_unlock(&depot.lock);
+}
+
+// a thread that stops allocating hands its cached blocks back
+void pool_thread_flush() {
+    if (magazine.count > 0) {
+        magazine_return(0);
+    }
+}
+
+// allocate memory from pool
+void* pool_malloc() {
+    if (magazine.count == 0 && magazine_refill() == 0) {
+        return NULL;  // no free blocks
+    }
+    BlockHeader* block = magazine.rounds[--magazine.count];
+    atomic_store_explicit(&block->ref_count, 1, memory_order_relaxed);  // init. ref. count to 1
+    return (void*)((uint8_t*)block + sizeof(BlockHeader));  // return block address (after header)
+}
+
+// free into this thread's magazine, whichever thread allocated the block
+void pool_free_block(BlockHeader* block) {
+    if (magazine.count == MAGAZINE_SIZE) {
+        magazine_return(BATCH);
+    }
+    magazine.rounds[magazine.count++] = block;
+}
+
+// increment ref. count of block
+void pool_retain(void* ptr) {
+    if (ptr == NULL) return;
+
+    BlockHeader* block = (BlockHeader*)((uint8_t*)ptr - sizeof(BlockHeader));
+    atomic_fetch_add_explicit(&block->ref_count, 1, memory_order_relaxed);
+}
+
+// decrement ref. count of block, free if count reaches zero
+void pool_release(void* ptr) {
+    if (ptr == NULL) return;
+
+    BlockHeader* block = (BlockHeader*)((uint8_t*)ptr - sizeof(BlockHeader));
+    // acq_rel: all writes to the object happen before whoever frees it
+    if (atomic_fetch_sub_explicit(&block->ref_count, 1, memory_order_acq_rel) == 1) {
+        pool_free_block(block);
+    }
+}
+
+// Object structure
+typedef struct {
+    char name[32];  // Person's name
+    int age;        // Person's age
+} Person;
+
+Person* create_person(const char* name, int age) {
+    Person* person = (Person*)pool_malloc();
+    if (person != NULL) {
+        strncpy(person->name, name, sizeof(person->name) - 1);
+        person->name[sizeof(person->name) - 1] = '\0';
+        person->age = age;
+    }
+    return person;
+}
+
+
+// workers allocate and free their own objects, and all of them keep
+// retaining and releasing one shared object
+#define NUM_THREADS 4
+#define ITERATIONS 200000
+#define LOCAL_OBJECTS 8
+
+Person* shared;
+
+void* worker(void* arg) {
+    int id = (int)(intptr_t)arg;
+    Person* local[LOCAL_OBJECTS];
+
+    for (int i = 0; i < ITERATIONS / LOCAL_OBJECTS; i++) {
+        for (int k = 0; k < LOCAL_OBJECTS; k++) {
+            local[k] = create_person("worker", id);
+            pool_retain(shared);
+        }
+        for (int k = 0; k < LOCAL_OBJECTS; k++) {
+            pool_release(local[k]);
+            pool_release(shared);
+        }
+    }
+
+    pool_thread_flush();
+    return NULL;
+}
+
+int main() {
+    memory_pool_init();
+
+    shared = create_person("Alice", 30);
+
+    pthread_t threads[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; i++) {
+        pthread_create(&threads[i], NULL, worker, (void*)(intptr_t)i);
+    }
+    for (int i = 0; i < NUM_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    BlockHeader* block = (BlockHeader*)((uint8_t*)shared - sizeof(BlockHeader));
+    long allocations = (long)NUM_THREADS * (ITERATIONS / LOCAL_OBJECTS) * LOCAL_OBJECTS;
+    printf("%d threads, %ld allocations, %ld depot locks\n",
+        NUM_THREADS, allocations, depot.lock_count);
+    printf("Shared object %s still has ref. count %d\n",
+        shared->name, atomic_load(&block->ref_count));
+
+    pool_release(shared);
+    pool_thread_flush();
+    printf("Free blocks in depot: %d of %d\n", depot.free_count, BLOCK_COUNT);
+
+    return (depot.free_count == BLOCK_COUNT) ? 0 : 1;
+}
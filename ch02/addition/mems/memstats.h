@@ -0,0 +1,394 @@
+#ifndef MEMSTATS_H
+#define MEMSTATS_H
+
+// Allocator statistics shared by pool.c, memo.c, mem2.c, mem3.c and
+// ../../sec2.4/mem/mem.c. Build with -DMEMSTATS to compile them in;
+// without it the hooks below cost nothing.
+//
+// An allocator brackets its public calls with the hooks:
+//
+//   void* mem_malloc(size_t size) {
+//       MEMSTATS_BEGIN();
+//       ...
+//       return MEMSTATS_ALLOC(ptr, size, granted);   // NULL counts as failed
+//   }
+//
+// where granted is what the block can really hold. Every return after
+// MEMSTATS_BEGIN() must go through a hook, or MEMSTATS_SKIP() when the
+// call turns out to be no allocation or free at all. Calls made from inside an
+// instrumented call, like the malloc and free done by a moving realloc,
+// are not counted again.
+//
+// Live blocks are kept in an open-addressed table with their requested
+// and granted sizes, so a free needs only the pointer. Sizes fall into
+// power-of-two classes, latencies into power-of-two buckets of ns.
+//
+// The same layer records traces, one line per call:
+//
+//   a <id> <size>            allocation, id is the pointer returned, in hex
+//   f <id>                   free
+//   r <id> <new id> <size>   realloc
+//
+// and memstats_replay() feeds a trace through any allocator, so every
+// allocator can be measured under the same load.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef MEMSTATS
+
+#define MEMSTATS_CLASSES 12         // class k up to 8 << k bytes, the last one larger
+#define MEMSTATS_BUCKETS 16         // bucket b up to 2^b ns, the last one slower
+#define MEMSTATS_MAX_LIVE 4096      // power of two
+
+enum { MEMSTATS_MALLOC, MEMSTATS_FREE, MEMSTATS_REALLOC, MEMSTATS_OPS };
+
+typedef struct {
+    uintptr_t key;                  // 0 for an empty slot
+    void* ptr;
+    size_t size;
+    size_t granted;
+} MemstatsSlot;
+
+typedef struct {
+    MemstatsSlot slots[MEMSTATS_MAX_LIVE];
+    int count;
+} MemstatsTable;
+
+typedef struct {
+    unsigned long allocs[MEMSTATS_CLASSES];
+    unsigned long frees[MEMSTATS_CLASSES];
+    long live[MEMSTATS_CLASSES];
+    long peak[MEMSTATS_CLASSES];
+    long live_blocks;
+    long peak_blocks;
+    size_t live_requested;
+    size_t live_granted;
+    size_t peak_granted;
+    unsigned long failures;
+    unsigned long untracked;        // live table full, or a free of an unknown block
+    unsigned long calls[MEMSTATS_OPS];
+    unsigned long latency[MEMSTATS_OPS][MEMSTATS_BUCKETS];
+    double total_ns[MEMSTATS_OPS];
+    MemstatsTable blocks;
+    FILE* trace;
+    int depth;
+} Memstats;
+
+static Memstats memstats;
+
+// --- table ---
+
+static inline unsigned ms_hash(uintptr_t key) {
+    uint32_t k = (uint32_t)(key >> 3) ^ (uint32_t)((uint64_t)key >> 32);
+    return (k * 2654435761u >> 20) & (MEMSTATS_MAX_LIVE - 1);
+}
+
+static inline MemstatsSlot* ms_find(MemstatsTable* t, uintptr_t key) {
+    for (unsigned i = ms_hash(key); t->slots[i].key != 0; i = (i + 1) & (MEMSTATS_MAX_LIVE - 1)) {
+        if (t->slots[i].key == key) return &t->slots[i];
+    }
+    return NULL;
+}
+
+// NULL when three quarters are taken, so a probe always ends
+static inline MemstatsSlot* ms_insert(MemstatsTable* t, uintptr_t key) {
+    if (t->count >= MEMSTATS_MAX_LIVE / 4 * 3) return NULL;
+    unsigned i = ms_hash(key);
+    while (t->slots[i].key != 0 && t->slots[i].key != key) i = (i + 1) & (MEMSTATS_MAX_LIVE - 1);
+    if (t->slots[i].key == 0) t->count++;
+    t->slots[i].key = key;
+    return &t->slots[i];
+}
+
+// no tombstones: the slots after the gap that would be lost move back
+static inline void ms_remove(MemstatsTable* t, MemstatsSlot* slot) {
+    unsigned i = (unsigned)(slot - t->slots), j = i;
+    t->count--;
+    for (;;) {
+        t->slots[i].key = 0;
+        unsigned k;
+        do {
+            j = (j + 1) & (MEMSTATS_MAX_LIVE - 1);
+            if (t->slots[j].key == 0) return;
+            k = ms_hash(t->slots[j].key);
+        } while (i <= j ? (i < k && k <= j) : (i < k || k <= j));
+        t->slots[i] = t->slots[j];
+        i = j;
+    }
+}
+
+// --- recording ---
+
+static inline uint64_t ms_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static inline int ms_class(size_t size) {
+    int k = size <= 8 ? 0 : 64 - __builtin_clzll((unsigned long long)(size - 1)) - 3;
+    return (k < MEMSTATS_CLASSES) ? k : MEMSTATS_CLASSES - 1;
+}
+
+static inline uint64_t memstats_begin(void) {
+    memstats.depth++;
+    return ms_now();
+}
+
+// 1 for the outermost call, the one that is counted
+static inline int ms_end(int op, uint64_t t0) {
+    if (--memstats.depth > 0) return 0;
+    uint64_t ns = ms_now() - t0;
+    int b = ns == 0 ? 0 : 64 - __builtin_clzll(ns);
+    memstats.calls[op]++;
+    memstats.latency[op][b < MEMSTATS_BUCKETS ? b : MEMSTATS_BUCKETS - 1]++;
+    memstats.total_ns[op] += (double)ns;
+    return 1;
+}
+
+static inline void ms_live(void* ptr, size_t size, size_t granted) {
+    MemstatsSlot* slot = ms_insert(&memstats.blocks, (uintptr_t)ptr);
+    if (slot == NULL) {
+        memstats.untracked++;
+        return;
+    }
+    slot->size = size;
+    slot->granted = granted;
+    int k = ms_class(size);
+    memstats.allocs[k]++;
+    if (++memstats.live[k] > memstats.peak[k]) memstats.peak[k] = memstats.live[k];
+    if (++memstats.live_blocks > memstats.peak_blocks) memstats.peak_blocks = memstats.live_blocks;
+    memstats.live_requested += size;
+    memstats.live_granted += granted;
+    if (memstats.live_granted > memstats.peak_granted) memstats.peak_granted = memstats.live_granted;
+}
+
+static inline void ms_dead(void* ptr) {
+    MemstatsSlot* slot = ms_find(&memstats.blocks, (uintptr_t)ptr);
+    if (slot == NULL) {
+        memstats.untracked++;
+        return;
+    }
+    int k = ms_class(slot->size);
+    memstats.frees[k]++;
+    memstats.live[k]--;
+    memstats.live_blocks--;
+    memstats.live_requested -= slot->size;
+    memstats.live_granted -= slot->granted;
+    ms_remove(&memstats.blocks, slot);
+}
+
+static inline unsigned long long ms_id(void* ptr) {
+    return (unsigned long long)(uintptr_t)ptr;
+}
+
+static inline void* memstats_alloc(void* ptr, size_t size, size_t granted, uint64_t t0) {
+    if (!ms_end(MEMSTATS_MALLOC, t0)) return ptr;
+    if (ptr == NULL) {
+        memstats.failures++;
+        return NULL;
+    }
+    ms_live(ptr, size, granted);
+    if (memstats.trace) fprintf(memstats.trace, "a %llx %zu\n", ms_id(ptr), size);
+    return ptr;
+}
+
+static inline void memstats_free(void* ptr, uint64_t t0) {
+    if (!ms_end(MEMSTATS_FREE, t0)) return;
+    ms_dead(ptr);
+    if (memstats.trace) fprintf(memstats.trace, "f %llx\n", ms_id(ptr));
+}
+
+// a failed realloc leaves the old block as it was
+static inline void* memstats_realloc(void* old, void* ptr, size_t size, size_t granted, uint64_t t0) {
+    if (!ms_end(MEMSTATS_REALLOC, t0)) return ptr;
+    if (ptr == NULL) {
+        memstats.failures++;
+        return NULL;
+    }
+    if (old != NULL) ms_dead(old);
+    ms_live(ptr, size, granted);
+    if (memstats.trace) fprintf(memstats.trace, "r %llx %llx %zu\n", ms_id(old), ms_id(ptr), size);
+    return ptr;
+}
+
+// every block is free again at once
+static inline void memstats_free_all(void) {
+    for (int i = 0; i < MEMSTATS_MAX_LIVE; i++) {
+        MemstatsSlot* slot = &memstats.blocks.slots[i];
+        if (slot->key == 0) continue;
+        int k = ms_class(slot->size);
+        memstats.frees[k]++;
+        memstats.live[k]--;
+        if (memstats.trace) fprintf(memstats.trace, "f %llx\n", (unsigned long long)slot->key);
+    }
+    memset(&memstats.blocks, 0, sizeof(memstats.blocks));
+    memstats.live_blocks = 0;
+    memstats.live_requested = 0;
+    memstats.live_granted = 0;
+}
+
+#define MEMSTATS_BEGIN() uint64_t memstats_t0 = memstats_begin()
+#define MEMSTATS_ALLOC(ptr, size, granted) memstats_alloc((ptr), (size), (granted), memstats_t0)
+#define MEMSTATS_FREE(ptr) memstats_free((ptr), memstats_t0)
+#define MEMSTATS_REALLOC(old, ptr, size, granted) memstats_realloc((old), (ptr), (size), (granted), memstats_t0)
+#define MEMSTATS_FREE_ALL() memstats_free_all()
+#define MEMSTATS_SKIP() ((void)memstats.depth--)    // the call does not count after all
+
+// --- API ---
+
+static inline void memstats_reset(void) {
+    FILE* trace = memstats.trace;
+    memset(&memstats, 0, sizeof(memstats));
+    memstats.trace = trace;
+}
+
+// record every counted call to out, NULL to stop
+static inline void memstats_trace(FILE* out) {
+    memstats.trace = out;
+}
+
+static inline void memstats_trace_close(void) {
+    if (memstats.trace != NULL) fclose(memstats.trace);
+    memstats.trace = NULL;
+}
+
+// record to a new file at path, closed at exit; -1 if it cannot be made
+static inline int memstats_trace_file(const char* path) {
+    FILE* out = fopen(path, "w");
+    if (out == NULL) return -1;
+    memstats_trace(out);
+    atexit(memstats_trace_close);
+    return 0;
+}
+
+// free_bytes and largest_free from the allocator give the external
+// fragmentation; pass 0 where every free block is as good as another
+static inline void memstats_dump(const char* name, size_t free_bytes, size_t largest_free) {
+    static const char* names[MEMSTATS_OPS] = { "malloc", "free", "realloc" };
+
+    printf("Allocator statistics (%s):\n", name);
+    printf("  %-12s %10s %10s %10s %10s\n", "size", "allocs", "frees", "live", "peak");
+    for (int k = 0; k < MEMSTATS_CLASSES; k++) {
+        if (memstats.allocs[k] == 0) continue;
+        char size[16];
+        if (k < MEMSTATS_CLASSES - 1) snprintf(size, sizeof(size), "<= %d", 8 << k);
+        else snprintf(size, sizeof(size), "> %d", 8 << (k - 1));
+        printf("  %-12s %10lu %10lu %10ld %10ld\n", size, memstats.allocs[k], memstats.frees[k],
+               memstats.live[k], memstats.peak[k]);
+    }
+    printf("  live %ld blocks, peak %ld; %zu bytes asked for, %zu granted, peak %zu\n",
+           memstats.live_blocks, memstats.peak_blocks, memstats.live_requested,
+           memstats.live_granted, memstats.peak_granted);
+    if (memstats.live_granted > 0) {
+        printf("  internal fragmentation %.1f%%\n",
+               100.0 * (1.0 - (double)memstats.live_requested / memstats.live_granted));
+    }
+    if (free_bytes > 0) {
+        printf("  external fragmentation %.1f%% (%zu bytes free, largest %zu)\n",
+               100.0 * (1.0 - (double)largest_free / free_bytes), free_bytes, largest_free);
+    }
+    printf("  failed allocations %lu", memstats.failures);
+    if (memstats.untracked > 0) printf(", untracked %lu", memstats.untracked);
+    printf("\n");
+
+    // bucket b holds calls from 2^(b-1) up to 2^b ns
+    for (int op = 0; op < MEMSTATS_OPS; op++) {
+        if (memstats.calls[op] == 0) continue;
+        printf("  %-8s %8lu calls, mean %7.1f ns:", names[op], memstats.calls[op],
+               memstats.total_ns[op] / memstats.calls[op]);
+        for (int b = 0; b < MEMSTATS_BUCKETS; b++) {
+            if (memstats.latency[op][b] == 0) continue;
+            if (b == MEMSTATS_BUCKETS - 1) printf(" >%d:%lu", 1 << (b - 1), memstats.latency[op][b]);
+            else printf(" <%d:%lu", 1 << b, memstats.latency[op][b]);
+        }
+        printf("\n");
+    }
+}
+
+// Feed a trace through an allocator. Without a realloc it is done as
+// malloc, copy and free. The ids of the trace are mapped to the blocks
+// this allocator hands out; calls on blocks it refused are skipped.
+// -1 if the file cannot be read, else the number of calls made
+static inline long memstats_replay(const char* path, void* (*alloc)(size_t),
+                                   void (*release)(void*), void* (*resize)(void*, size_t)) {
+    FILE* in = fopen(path, "r");
+    if (in == NULL) return -1;
+    static MemstatsTable ids;
+    memset(&ids, 0, sizeof(ids));
+
+    long calls = 0, refused = 0;
+    char op;
+    unsigned long long id, new_id;
+    size_t size;
+    while (fscanf(in, " %c", &op) == 1) {
+        MemstatsSlot* slot;
+        if (op == 'a' && fscanf(in, "%llx %zu", &id, &size) == 2) {
+            void* ptr = alloc(size);
+            calls++;
+            if (ptr == NULL) { refused++; continue; }
+            if ((slot = ms_insert(&ids, (uintptr_t)id)) != NULL) {
+                slot->ptr = ptr;
+                slot->size = size;
+            }
+        } else if (op == 'f' && fscanf(in, "%llx", &id) == 1) {
+            if ((slot = ms_find(&ids, (uintptr_t)id)) == NULL) continue;
+            release(slot->ptr);
+            calls++;
+            ms_remove(&ids, slot);
+        } else if (op == 'r' && fscanf(in, "%llx %llx %zu", &id, &new_id, &size) == 3) {
+            void* old = NULL;
+            size_t old_size = 0;
+            if (id != 0) {
+                if ((slot = ms_find(&ids, (uintptr_t)id)) == NULL) continue;
+                old = slot->ptr;
+                old_size = slot->size;
+                ms_remove(&ids, slot);
+            }
+            void* ptr;
+            if (resize != NULL) {
+                ptr = resize(old, size);
+            } else {
+                ptr = alloc(size);
+                if (ptr != NULL && old != NULL) {
+                    memcpy(ptr, old, old_size < size ? old_size : size);
+                    release(old);
+                }
+            }
+            calls++;
+            if (ptr == NULL) {
+                refused++;
+                ptr = old;      // still there
+                size = old_size;
+                if (ptr == NULL) continue;
+            }
+            if ((slot = ms_insert(&ids, (uintptr_t)new_id)) != NULL) {
+                slot->ptr = ptr;
+                slot->size = size;
+            }
+        } else {
+            int c;
+            while ((c = fgetc(in)) != EOF && c != '\n') {}   // not a call
+        }
+    }
+    fclose(in);
+    printf("Replayed %s: %ld calls, %ld refused, %d blocks left\n", path, calls, refused, ids.count);
+    return calls;
+}
+
+#else
+
+#define MEMSTATS_BEGIN()
+#define MEMSTATS_ALLOC(ptr, size, granted) (ptr)
+#define MEMSTATS_FREE(ptr) ((void)0)
+#define MEMSTATS_REALLOC(old, ptr, size, granted) (ptr)
+#define MEMSTATS_FREE_ALL() ((void)0)
+#define MEMSTATS_SKIP() ((void)0)
+
+#endif /* MEMSTATS */
+
+#endif
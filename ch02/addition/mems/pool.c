@@ -2,61 +2,94 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include <time.h>
+#include "memstats.h"
 
-// memory pool with fixed block size
-#define MEMORY_POOL_SIZE 1024
-#define BLOCK_SIZE 32
-#define BLOCK_COUNT (MEMORY_POOL_SIZE / BLOCK_SIZE)
+// memory pool with fixed size classes, one slab of blocks per class
+#define NUM_CLASSES 4
+#define SLAB_SIZE 16384
+#define BLOCK_SIZE 32       // what pool_malloc() hands out
 
-uint8_t memory_pool[MEMORY_POOL_SIZE];
+static const size_t class_size[NUM_CLASSES] = { 16, 32, 64, 128 };
 
-typedef struct BlockHeader {
-    int is_free;
-    struct BlockHeader* next;
-} BlockHeader;
+_Alignas(16) uint8_t memory_pool[NUM_CLASSES * SLAB_SIZE];
+
+// a free block holds the link to the next free block in its own bytes,
+// so there is no header and allocated blocks can be used in full
+typedef struct FreeBlock {
+    struct FreeBlock* next;
+} FreeBlock;
 
-BlockHeader* free_list = NULL;
+typedef struct Slab {
+    uint8_t* memory;
+    size_t block_size;
+    FreeBlock* free_list;
+    int free_count;
+} Slab;
+
+Slab slabs[NUM_CLASSES];
 
 void memory_pool_init() {
-    free_list = (BlockHeader*)memory_pool;
-
-    // free list with all blocks
-    BlockHeader* current = free_list;
-    for (int i = 0; i < BLOCK_COUNT; ++i) {
-        current->is_free = 1;  // blocks are free at start
-        if (i == BLOCK_COUNT - 1) {
-            current->next = NULL;  // no next block for last one
-        } else {
-            current->next = (BlockHeader*)((uint8_t*)current + BLOCK_SIZE);
+    for (int c = 0; c < NUM_CLASSES; ++c) {
+        Slab* slab = &slabs[c];
+        slab->memory = memory_pool + c * SLAB_SIZE;
+        slab->block_size = class_size[c];
+        slab->free_list = NULL;
+        slab->free_count = 0;
+
+        // push from the back so blocks come out in address order
+        int count = SLAB_SIZE / slab->block_size;
+        for (int i = count - 1; i >= 0; --i) {
+            FreeBlock* block = (FreeBlock*)(slab->memory + i * slab->block_size);
+            block->next = slab->free_list;
+            slab->free_list = block;
+            slab->free_count++;
         }
-        current = current->next;
     }
 }
 
-// allocate memory from the pool (returns a block of BLOCK_SIZE bytes)
-void* pool_malloc() {
-    BlockHeader* current = free_list;
-
-    // find first free block
-    while (current != NULL && !current->is_free) {
-        current = current->next;
+// smallest class that fits, or -1
+int size_class(size_t size) {
+    for (int c = 0; c < NUM_CLASSES; ++c) {
+        if (size <= class_size[c]) return c;
     }
+    return -1;
+}
 
-    if (current != NULL) {
-        current->is_free = 0;  // mark block as allocated
-        return (void*)((uint8_t*)current + sizeof(BlockHeader));  // return block address (after the header)
-    }
+// allocate a block of at least size bytes: pop the head of its free list
+void* pool_malloc_size(size_t size) {
+    MEMSTATS_BEGIN();
+    int c = size_class(size);
+    if (c < 0) return MEMSTATS_ALLOC(NULL, size, 0);  // larger than the largest class
+
+    Slab* slab = &slabs[c];
+    FreeBlock* block = slab->free_list;
+    if (block == NULL) return MEMSTATS_ALLOC(NULL, size, 0);  // no free blocks available
+
+    slab->free_list = block->next;
+    slab->free_count--;
+    return MEMSTATS_ALLOC(block, size, class_size[c]);
+}
 
-    return NULL;  // no free blocks available
+// allocate memory from the pool (returns a block of BLOCK_SIZE bytes)
+void* pool_malloc() {
+    return pool_malloc_size(BLOCK_SIZE);
 }
 
-// free block (add back to pool)
+// free block: the slab follows from the address, push it on that free list
 void pool_free(void* ptr) {
     if (ptr == NULL) return;
 
-    // BlockHeader from pointer
-    BlockHeader* block = (BlockHeader*)((uint8_t*)ptr - sizeof(BlockHeader));
-    block->is_free = 1;
+    uint8_t* p = (uint8_t*)ptr;
+    if (p < memory_pool || p >= memory_pool + sizeof(memory_pool)) return;  // not ours
+
+    MEMSTATS_BEGIN();
+    Slab* slab = &slabs[(p - memory_pool) / SLAB_SIZE];
+    FreeBlock* block = (FreeBlock*)p;
+    block->next = slab->free_list;
+    slab->free_list = block;
+    slab->free_count++;
+    MEMSTATS_FREE(ptr);
 }
 
 // Machine struct to track allocations
@@ -96,8 +129,134 @@ int machine_load(void* addr, int offset) {
     return value;
 }
 
+// the earlier pool, kept for comparison: pool_malloc() scanned the list
+// from the head for a block marked free, and pool_free() only set the flag
+uint8_t legacy_pool[SLAB_SIZE];
+
+typedef struct BlockHeader {
+    int is_free;
+    struct BlockHeader* next;
+} BlockHeader;
+
+BlockHeader* legacy_list = NULL;
+
+void legacy_init() {
+    legacy_list = (BlockHeader*)legacy_pool;
+    BlockHeader* current = legacy_list;
+    for (int i = 0; i < SLAB_SIZE / BLOCK_SIZE; ++i) {
+        current->is_free = 1;
+        current->next = (i == SLAB_SIZE / BLOCK_SIZE - 1) ? NULL
+            : (BlockHeader*)((uint8_t*)current + BLOCK_SIZE);
+        current = current->next;
+    }
+}
+
+void* legacy_malloc() {
+    BlockHeader* current = legacy_list;
+    while (current != NULL && !current->is_free) {
+        current = current->next;
+    }
+    if (current == NULL) return NULL;
+    current->is_free = 0;
+    return (void*)((uint8_t*)current + sizeof(BlockHeader));
+}
+
+void legacy_free(void* ptr) {
+    if (ptr == NULL) return;
+    ((BlockHeader*)((uint8_t*)ptr - sizeof(BlockHeader)))->is_free = 1;
+}
+
+
+// micro-benchmark: free list vs the scanning pool vs system malloc
+#define BENCH_BLOCKS (SLAB_SIZE / BLOCK_SIZE)
+#define BENCH_ROUNDS 2000
+
+void* sys_malloc() { return malloc(BLOCK_SIZE - sizeof(BlockHeader)); }
+
+typedef struct Allocator {
+    const char* name;
+    void (*init)(void);
+    void* (*alloc)(void);
+    void (*release)(void*);
+} Allocator;
+
+void no_init() {}
+
+// fill the pool, then keep it almost full: free a random block, allocate one
+double bench(Allocator* a, int churn) {
+    static void* held[BENCH_BLOCKS];
+    a->init();
+    srand(1);
+    long ops = 0;
+    clock_t t = clock();
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < BENCH_BLOCKS; i++, ops++) {
+            held[i] = a->alloc();
+        }
+        for (int k = 0; k < churn; k++, ops += 2) {
+            int i = rand() % BENCH_BLOCKS;
+            a->release(held[i]);
+            held[i] = a->alloc();
+        }
+        for (int i = BENCH_BLOCKS - 1; i >= 0; i--, ops++) {
+            a->release(held[i]);
+        }
+    }
+
+    t = clock() - t;
+    return (double)t / CLOCKS_PER_SEC * 1e9 / ops;
+}
+
+int benchmark() {
+    Allocator allocators[] = {
+        { "free list", memory_pool_init, pool_malloc, pool_free },
+        { "scanning pool", legacy_init, legacy_malloc, legacy_free },
+        { "malloc", no_init, sys_malloc, free },
+    };
+
+    printf("%d blocks of %d bytes, %d rounds\n", BENCH_BLOCKS, BLOCK_SIZE, BENCH_ROUNDS);
+    printf("%-15s %15s %15s\n", "allocator", "fill (ns/op)", "churn (ns/op)");
+    for (int i = 0; i < 3; i++) {
+        double fill = bench(&allocators[i], 0);
+        double churn = bench(&allocators[i], BENCH_BLOCKS);
+        printf("%-15s %15.1f %15.1f\n", allocators[i].name, fill, churn);
+    }
+    return 0;
+}
+
+
+#ifdef MEMSTATS
+// every block of a class is as good as another, so no external fragmentation
+int replay(const char* path) {
+    memory_pool_init();
+    memstats_reset();
+    if (memstats_replay(path, pool_malloc_size, pool_free, NULL) < 0) {
+        printf("Cannot read %s\n", path);
+        return 1;
+    }
+    memstats_dump("pool", 0, 0);
+    return 0;
+}
+#endif
+
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        return benchmark();
+    }
+#ifdef MEMSTATS
+    if (argc > 2 && strcmp(argv[1], "replay") == 0) {
+        return replay(argv[2]);
+    }
+    if (argc > 2 && strcmp(argv[1], "trace") == 0) {
+        if (memstats_trace_file(argv[2]) < 0) {
+            printf("Cannot write %s\n", argv[2]);
+            return 1;
+        }
+    }
+#endif
 
-int main() {
     memory_pool_init();
 
     Machine machine;
@@ -121,5 +280,16 @@ int main() {
     // 4: free the allocated block
     machine_free(&machine, block);
 
+    // 5: other sizes come from the slab of the smallest class that fits
+    void* small = pool_malloc_size(12);
+    void* large = pool_malloc_size(100);
+    printf("12 bytes from the %zu byte class, 100 bytes from the %zu byte class\n",
+        class_size[size_class(12)], class_size[size_class(100)]);
+    pool_free(small);
+    pool_free(large);
+
+#ifdef MEMSTATS
+    memstats_dump("pool", 0, 0);
+#endif
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,312 @@
+#ifndef SEGFIT_H
+#define SEGFIT_H
+
+// Segregated-fit allocator with boundary tags, working inside a pool the
+// including program owns. Compile mem.c, mem2.c or mem3.c with -DSEGFIT
+// to put their mem_malloc/mem_free/mem_realloc on top of it.
+//
+// Every block starts with a header and ends with a footer, both holding
+// the block size with the low bit set when it is allocated:
+//
+//   | size|a | payload ...                                  | size|a |
+//
+// A free block keeps its links to the other free blocks of its bin in
+// the payload. Bin k holds sizes from 2^(k+5) to 2^(k+6) - 1, the last bin
+// everything larger. Since the footer of the block before and the header
+// of the block after are right next to a block, free() merges with free
+// neighbours in constant time, and no pass over the whole heap is needed.
+// A one word allocated block at each end means the first and last block
+// need no special cases.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#define SEGFIT_ALIGN 16
+#define SEGFIT_WORD sizeof(size_t)
+#define SEGFIT_OVERHEAD (2 * SEGFIT_WORD)
+#define SEGFIT_MIN_BLOCK 32
+#define SEGFIT_BINS 20
+
+typedef struct SegfitNode {
+    struct SegfitNode* next;
+    struct SegfitNode* prev;
+} SegfitNode;
+
+enum { SEGFIT_MALLOC, SEGFIT_FREE, SEGFIT_REALLOC, SEGFIT_OPS };
+
+typedef struct {
+    uint8_t* pool;
+    size_t pool_size;
+    uint8_t* start;         // first block
+    uint8_t* end;           // end marker
+    SegfitNode* bins[SEGFIT_BINS];
+    uint32_t nonempty;      // bit k set when bin k has blocks
+
+    size_t free_bytes;
+    size_t free_blocks;
+    size_t peak_used;
+    size_t in_place;        // reallocs that did not move
+    size_t failures;
+    unsigned long calls[SEGFIT_OPS];
+    double total_ns[SEGFIT_OPS];
+    double max_ns[SEGFIT_OPS];
+} Segfit;
+
+static Segfit segfit;
+
+// --- tags ---
+
+static inline size_t sf_size(uint8_t* b) { return *(size_t*)b & ~(size_t)(SEGFIT_ALIGN - 1); }
+static inline int sf_used(uint8_t* b) { return (int)(*(size_t*)b & 1); }
+static inline uint8_t* sf_next(uint8_t* b) { return b + sf_size(b); }
+static inline uint8_t* sf_prev_footer(uint8_t* b) { return b - SEGFIT_WORD; }
+static inline void* sf_payload(uint8_t* b) { return b + SEGFIT_WORD; }
+static inline uint8_t* sf_block(void* ptr) { return (uint8_t*)ptr - SEGFIT_WORD; }
+
+static inline void sf_tag(uint8_t* b, size_t size, int used) {
+    *(size_t*)b = size | (size_t)used;
+    *(size_t*)(b + size - SEGFIT_WORD) = size | (size_t)used;
+}
+
+// --- bins ---
+
+static inline int sf_bin(size_t size) {
+    int k = 63 - __builtin_clzll((unsigned long long)size) - 5;
+    if (k < 0) return 0;
+    return (k < SEGFIT_BINS) ? k : SEGFIT_BINS - 1;
+}
+
+static inline void sf_insert(uint8_t* b) {
+    int k = sf_bin(sf_size(b));
+    SegfitNode* node = (SegfitNode*)sf_payload(b);
+    node->prev = NULL;
+    node->next = segfit.bins[k];
+    if (node->next) node->next->prev = node;
+    segfit.bins[k] = node;
+    segfit.nonempty |= 1u << k;
+    segfit.free_bytes += sf_size(b);
+    segfit.free_blocks++;
+}
+
+static inline void sf_unlink(uint8_t* b) {
+    int k = sf_bin(sf_size(b));
+    SegfitNode* node = (SegfitNode*)sf_payload(b);
+    if (node->prev) node->prev->next = node->next;
+    else segfit.bins[k] = node->next;
+    if (node->next) node->next->prev = node->prev;
+    if (segfit.bins[k] == NULL) segfit.nonempty &= ~(1u << k);
+    segfit.free_bytes -= sf_size(b);
+    segfit.free_blocks--;
+}
+
+// first fit inside the bin of the size, else any block of a larger bin
+static inline uint8_t* sf_find(size_t size) {
+    int k = sf_bin(size);
+    for (SegfitNode* n = segfit.bins[k]; n != NULL; n = n->next) {
+        if (sf_size(sf_block(n)) >= size) return sf_block(n);
+    }
+    uint32_t larger = segfit.nonempty & ~((2u << k) - 1);
+    if (larger == 0) return NULL;
+    return sf_block(segfit.bins[__builtin_ctz(larger)]);
+}
+
+// --- blocks ---
+
+static inline size_t sf_adjust(size_t size) {
+    size_t total = (size + SEGFIT_OVERHEAD + SEGFIT_ALIGN - 1) & ~(size_t)(SEGFIT_ALIGN - 1);
+    return (total < SEGFIT_MIN_BLOCK) ? SEGFIT_MIN_BLOCK : total;
+}
+
+// free block b: merge with free neighbours, then put it in its bin
+static inline void sf_release(uint8_t* b) {
+    size_t size = sf_size(b);
+    uint8_t* next = b + size;
+    if (!sf_used(next)) {
+        sf_unlink(next);
+        size += sf_size(next);
+    }
+    uint8_t* footer = sf_prev_footer(b);
+    if (!sf_used(footer)) {
+        b -= *(size_t*)footer & ~(size_t)(SEGFIT_ALIGN - 1);
+        sf_unlink(b);
+        size += sf_size(b);
+    }
+    sf_tag(b, size, 0);
+    sf_insert(b);
+}
+
+// make allocated block b exactly size bytes if the rest can be a block
+static inline void sf_trim(uint8_t* b, size_t size) {
+    size_t have = sf_size(b);
+    if (have - size >= SEGFIT_MIN_BLOCK) {
+        sf_tag(b, size, 1);
+        sf_tag(b + size, have - size, 1);
+        sf_release(b + size);
+    }
+}
+
+static inline size_t sf_used_bytes(void) {
+    return (size_t)(segfit.end - segfit.start) - segfit.free_bytes;
+}
+
+static inline void* sf_alloc(size_t size) {
+    size_t asize = sf_adjust(size);
+    uint8_t* b = sf_find(asize);
+    if (b == NULL) {
+        segfit.failures++;
+        return NULL;
+    }
+    sf_unlink(b);
+    sf_tag(b, sf_size(b), 1);
+    sf_trim(b, asize);
+    if (sf_used_bytes() > segfit.peak_used) segfit.peak_used = sf_used_bytes();
+    return sf_payload(b);
+}
+
+static inline void* sf_realloc(void* ptr, size_t size) {
+    if (ptr == NULL) return sf_alloc(size);
+    uint8_t* b = sf_block(ptr);
+    size_t asize = sf_adjust(size);
+    size_t have = sf_size(b);
+
+    if (asize <= have) {            // shrink in place
+        sf_trim(b, asize);
+        segfit.in_place++;
+        return ptr;
+    }
+    uint8_t* next = b + have;       // grow into a free neighbour
+    if (!sf_used(next) && have + sf_size(next) >= asize) {
+        sf_unlink(next);
+        sf_tag(b, have + sf_size(next), 1);
+        sf_trim(b, asize);
+        segfit.in_place++;
+        if (sf_used_bytes() > segfit.peak_used) segfit.peak_used = sf_used_bytes();
+        return ptr;
+    }
+    void* moved = sf_alloc(size);
+    if (moved != NULL) {
+        memcpy(moved, ptr, have - SEGFIT_OVERHEAD);
+        sf_release(b);
+    }
+    return moved;
+}
+
+// --- timing ---
+
+static inline double sf_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static inline void sf_record(int op, double t0) {
+    double ns = sf_now() - t0;
+    segfit.calls[op]++;
+    segfit.total_ns[op] += ns;
+    if (ns > segfit.max_ns[op]) segfit.max_ns[op] = ns;
+}
+
+// --- API ---
+
+static inline void segfit_init(uint8_t* pool, size_t pool_size) {
+    memset(&segfit, 0, sizeof(segfit));
+    segfit.pool = pool;
+    segfit.pool_size = pool_size;
+
+    // the first header sits one word below an aligned payload
+    uintptr_t first = ((uintptr_t)pool + 2 * SEGFIT_WORD + SEGFIT_ALIGN - 1) & ~(uintptr_t)(SEGFIT_ALIGN - 1);
+    first -= SEGFIT_WORD;
+    uintptr_t length = ((uintptr_t)pool + pool_size - SEGFIT_WORD - first) & ~(uintptr_t)(SEGFIT_ALIGN - 1);
+
+    segfit.start = (uint8_t*)first;
+    segfit.end = segfit.start + length;
+    *(size_t*)(segfit.start - SEGFIT_WORD) = 1;    // footer of "the block before": allocated
+    *(size_t*)segfit.end = 1;                      // header of "the block after": allocated
+    if (segfit.end - segfit.start >= SEGFIT_MIN_BLOCK) {
+        sf_tag(segfit.start, (size_t)(segfit.end - segfit.start), 0);
+        sf_insert(segfit.start);
+    }
+}
+
+static inline void* segfit_malloc(size_t size) {
+    double t0 = sf_now();
+    void* ptr = sf_alloc(size);
+    sf_record(SEGFIT_MALLOC, t0);
+    return ptr;
+}
+
+static inline void segfit_free(void* ptr) {
+    if (ptr == NULL) return;
+    double t0 = sf_now();
+    sf_release(sf_block(ptr));
+    sf_record(SEGFIT_FREE, t0);
+}
+
+static inline void* segfit_realloc(void* ptr, size_t size) {
+    double t0 = sf_now();
+    void* moved = sf_realloc(ptr, size);
+    sf_record(SEGFIT_REALLOC, t0);
+    return moved;
+}
+
+// everything is free again; the statistics are kept
+static inline void segfit_free_all(void) {
+    Segfit kept = segfit;
+    segfit_init(kept.pool, kept.pool_size);
+    memcpy(segfit.calls, kept.calls, sizeof(kept.calls));
+    memcpy(segfit.total_ns, kept.total_ns, sizeof(kept.total_ns));
+    memcpy(segfit.max_ns, kept.max_ns, sizeof(kept.max_ns));
+    segfit.peak_used = kept.peak_used;
+    segfit.in_place = kept.in_place;
+    segfit.failures = kept.failures;
+}
+
+// payload bytes that fit in the block behind ptr
+static inline size_t segfit_usable(void* ptr) {
+    return sf_size(sf_block(ptr)) - SEGFIT_OVERHEAD;
+}
+
+// walks the heap, for showing it only; allocation never does this
+static inline void segfit_print(void) {
+    printf("Memory Pool Status:\n");
+    for (uint8_t* b = segfit.start; b < segfit.end; b = sf_next(b)) {
+        printf("  Block at %p - Size: %zu bytes, %s\n",
+               sf_payload(b), sf_size(b) - SEGFIT_OVERHEAD, sf_used(b) ? "Occupied" : "Free");
+    }
+    printf("\n");
+}
+
+// the largest free block is in the highest bin that has any
+static inline size_t segfit_largest_free(void) {
+    size_t largest = 0;
+    if (segfit.nonempty) {
+        int k = 31 - __builtin_clz(segfit.nonempty);
+        for (SegfitNode* n = segfit.bins[k]; n != NULL; n = n->next) {
+            if (sf_size(sf_block(n)) > largest) largest = sf_size(sf_block(n));
+        }
+    }
+    return largest;
+}
+
+static inline void segfit_report(void) {
+    static const char* names[SEGFIT_OPS] = { "malloc", "free", "realloc" };
+
+    size_t largest = segfit_largest_free();
+    double fragmentation = segfit.free_bytes ? 100.0 * (1.0 - (double)largest / segfit.free_bytes) : 0.0;
+
+    printf("Allocator statistics (segregated fit):\n");
+    printf("  heap %zu bytes, in use %zu, peak %zu\n",
+           (size_t)(segfit.end - segfit.start), sf_used_bytes(), segfit.peak_used);
+    printf("  free %zu bytes in %zu blocks, largest %zu, fragmentation %.1f%%\n",
+           segfit.free_bytes, segfit.free_blocks, largest, fragmentation);
+    printf("  failed allocations %zu, reallocs in place %zu\n", segfit.failures, segfit.in_place);
+    for (int op = 0; op < SEGFIT_OPS; op++) {
+        if (segfit.calls[op] == 0) continue;
+        printf("  %-8s %6lu calls, mean %7.1f ns, max %7.1f ns\n", names[op], segfit.calls[op],
+               segfit.total_ns[op] / segfit.calls[op], segfit.max_ns[op]);
+    }
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 // def types for fields
 typedef enum {
@@ -18,11 +19,26 @@ typedef struct {
     } value;
 } Field;
 
-// def the object structure
+// one slot of field storage: 4 bytes, as the type in the shape says
+typedef union {
+    int int_value;
+    float float_value;
+} Slot;
+
+// def the shape (hidden class): the names and types of the fields, in
+// slot order. Objects made with the same layout share one shape.
+typedef struct Shape {
+    int field_count;
+    char **names;
+    FieldType *types;
+    struct Shape *next;     // all shapes, newest first
+} Shape;
+
+// def the object structure: a shape and the values, densely
 typedef struct {
     char *name;
-    Field *fields;
-    int field_count;
+    Shape *shape;
+    Slot slots[];
 } Object;
 
 // Define VM instructions
@@ -35,11 +51,14 @@ typedef enum {
     HALT
 } Instruction;
 
-// def VM instr.
+// def VM instr. The field is named; where it is depends on the shape,
+// so each instruction caches the slot it found for the last shape.
 typedef struct {
     Instruction instruction;
-    int field_index;
+    const char *field;
     float operand;
+    Shape *cached_shape;    // inline cache
+    int cached_slot;
 } VMInstruction;
 
 // def VM struct
@@ -47,60 +66,133 @@ typedef struct {
     VMInstruction *method;  // array of VM instructions (method)
     int method_length;      // number of instructions in the method
     int pc;                 // program counter
+    long cache_misses;      // field lookups that missed the inline cache
 } VirtualMachine;
 
 // fwd. decl.
 void print_fields(const Object *obj);
 void run_vm(VirtualMachine *vm, Object *obj);
+void run_vm_batch(VirtualMachine *vm, Object **objs, int n);
 Object *create_object(const char *name, Field *fields, int field_count);
 void free_object(Object *obj);
 
+Shape *shapes = NULL;
+
+// the shape of this layout, made on first use
+Shape *shape_of(Field *fields, int field_count) {
+    for (Shape *s = shapes; s; s = s->next) {
+        if (s->field_count != field_count)
+            continue;
+        int i = 0;
+        while (i < field_count && s->types[i] == fields[i].type
+               && strcmp(s->names[i], fields[i].name) == 0)
+            i++;
+        if (i == field_count)
+            return s;
+    }
+    Shape *s = malloc(sizeof(Shape));
+    s->field_count = field_count;
+    s->names = malloc(field_count * sizeof(char *));
+    s->types = malloc(field_count * sizeof(FieldType));
+    for (int i = 0; i < field_count; i++) {
+        s->names[i] = strdup(fields[i].name);
+        s->types[i] = fields[i].type;
+    }
+    s->next = shapes;
+    shapes = s;
+    return s;
+}
+
+// slot of the named field, or -1
+int shape_lookup(const Shape *s, const char *name) {
+    for (int i = 0; i < s->field_count; i++)
+        if (strcmp(s->names[i], name) == 0)
+            return i;
+    return -1;
+}
+
+void free_shapes(void) {
+    while (shapes) {
+        Shape *next = shapes->next;
+        for (int i = 0; i < shapes->field_count; i++)
+            free(shapes->names[i]);
+        free(shapes->names);
+        free(shapes->types);
+        free(shapes);
+        shapes = next;
+    }
+}
+
 void print_fields(const Object *obj) {
+    const Shape *s = obj->shape;
     printf("Object: %s\n", obj->name);
-    for (int i = 0; i < obj->field_count; i++) {
-        if (obj->fields[i].type == TYPE_FLOAT) {
-            printf("%s (float): %.2f\n", obj->fields[i].name, obj->fields[i].value.float_value);
+    for (int i = 0; i < s->field_count; i++) {
+        if (s->types[i] == TYPE_FLOAT) {
+            printf("%s (float): %.2f\n", s->names[i], obj->slots[i].float_value);
         } else {
-            printf("%s (int): %d\n", obj->fields[i].name, obj->fields[i].value.int_value);
+            printf("%s (int): %d\n", s->names[i], obj->slots[i].int_value);
         }
     }
 }
 
+// monomorphic inline cache: one compare when the shape is the one seen
+// last, a lookup by name otherwise. -1 if obj has no such field.
+int field_slot(VirtualMachine *vm, VMInstruction *instr, const Object *obj) {
+    if (instr->cached_shape != obj->shape) {
+        vm->cache_misses++;
+        int slot = shape_lookup(obj->shape, instr->field);
+        if (slot < 0) {
+            printf("No field %s in %s\n", instr->field, obj->name);
+            return -1;
+        }
+        instr->cached_shape = obj->shape;
+        instr->cached_slot = slot;
+    }
+    return instr->cached_slot;
+}
+
 void run_vm(VirtualMachine *vm, Object *obj) {
     while (vm->pc < vm->method_length) {
         VMInstruction *instr = &vm->method[vm->pc];
-        Field *field = &obj->fields[instr->field_index];
+        if (instr->instruction == PRINT) {
+            print_fields(obj);
+            vm->pc++;
+            continue;
+        }
+        if (instr->instruction == HALT)
+            return;
+
+        int slot = field_slot(vm, instr, obj);
+        if (slot < 0)
+            return;
+        Slot *field = &obj->slots[slot];
+        int is_float = obj->shape->types[slot] == TYPE_FLOAT;
 
         switch (instr->instruction) {
-            case PRINT:
-                print_fields(obj);
-                break;
             case ADD:
-                if (field->type == TYPE_FLOAT)
-                    field->value.float_value += instr->operand;
+                if (is_float)
+                    field->float_value += instr->operand;
                 else
-                    field->value.int_value += (int)instr->operand;
+                    field->int_value += (int)instr->operand;
                 break;
             case SUB:
-                if (field->type == TYPE_FLOAT)
-                    field->value.float_value -= instr->operand;
+                if (is_float)
+                    field->float_value -= instr->operand;
                 else
-                    field->value.int_value -= (int)instr->operand;
+                    field->int_value -= (int)instr->operand;
                 break;
             case MUL:
-                if (field->type == TYPE_FLOAT)
-                    field->value.float_value *= instr->operand;
+                if (is_float)
+                    field->float_value *= instr->operand;
                 else
-                    field->value.int_value *= (int)instr->operand;
+                    field->int_value *= (int)instr->operand;
                 break;
             case DIV:
-                if (field->type == TYPE_FLOAT)
-                    field->value.float_value /= instr->operand;
+                if (is_float)
+                    field->float_value /= instr->operand;
                 else
-                    field->value.int_value /= (int)instr->operand;
+                    field->int_value /= (int)instr->operand;
                 break;
-            case HALT:
-                return;
             default:
                 printf("Unknown instruction\n");
                 return;
@@ -110,19 +202,73 @@ void run_vm(VirtualMachine *vm, Object *obj) {
     }
 }
 
+// The method over all of objs, one instruction at a time: each is
+// decoded once per run of objects with the same shape, and then applied
+// to that field of every object in the run in one loop. A PRINT prints
+// every object of the run. Same results as run_vm() on each object in
+// turn, except for the order of what PRINT shows.
+void run_vm_batch(VirtualMachine *vm, Object **objs, int n) {
+    int start = 0;
+    while (start < n) {
+        int end = start + 1;
+        while (end < n && objs[end]->shape == objs[start]->shape)
+            end++;
+
+        for (vm->pc = 0; vm->pc < vm->method_length; vm->pc++) {
+            VMInstruction *instr = &vm->method[vm->pc];
+            if (instr->instruction == HALT)
+                break;
+            if (instr->instruction == PRINT) {
+                for (int i = start; i < end; i++)
+                    print_fields(objs[i]);
+                continue;
+            }
+
+            int slot = field_slot(vm, instr, objs[start]);
+            if (slot < 0)
+                return;
+            int is_float = objs[start]->shape->types[slot] == TYPE_FLOAT;
+            float x = instr->operand;
+
+            #define COLUMN(op) \
+                if (is_float) \
+                    for (int i = start; i < end; i++) \
+                        objs[i]->slots[slot].float_value op x; \
+                else \
+                    for (int i = start; i < end; i++) \
+                        objs[i]->slots[slot].int_value op (int)x;
+
+            switch (instr->instruction) {
+                case ADD: COLUMN(+=); break;
+                case SUB: COLUMN(-=); break;
+                case MUL: COLUMN(*=); break;
+                case DIV: COLUMN(/=); break;
+                default:
+                    printf("Unknown instruction\n");
+                    return;
+            }
+            #undef COLUMN
+        }
+        start = end;
+    }
+}
+
 // object with fields
 Object *create_object(const char *name, Field *fields, int field_count) {
-    Object *obj = malloc(sizeof(Object));
+    Object *obj = malloc(sizeof(Object) + field_count * sizeof(Slot));
     obj->name = strdup(name);
-    obj->fields = malloc(field_count * sizeof(Field));
-    memcpy(obj->fields, fields, field_count * sizeof(Field));
-    obj->field_count = field_count;
+    obj->shape = shape_of(fields, field_count);
+    for (int i = 0; i < field_count; i++) {
+        if (fields[i].type == TYPE_FLOAT)
+            obj->slots[i].float_value = fields[i].value.float_value;
+        else
+            obj->slots[i].int_value = fields[i].value.int_value;
+    }
     return obj;
 }
 
 // clean up
 void free_object(Object *obj) {
-    free(obj->fields);
     free(obj->name);
     free(obj);
 }
@@ -143,19 +289,58 @@ int main() {
 
     // Dynamically create a method (instructions) that adds to the first field
     VMInstruction method[4];
-    method[0] = (VMInstruction){PRINT, 0, 0};     // Print the first field
-    method[1] = (VMInstruction){ADD, 0, 5.0f};    // Add 5 to the first field
-    method[2] = (VMInstruction){PRINT, 0, 0};     // Print the updated field
-    method[3] = (VMInstruction){HALT, 0, 0};      // Halt the VM
+    method[0] = (VMInstruction){PRINT, NULL, 0};        // Print the fields
+    method[1] = (VMInstruction){ADD, "field1", 5.0f};   // Add 5 to the first field
+    method[2] = (VMInstruction){PRINT, NULL, 0};        // Print the updated field
+    method[3] = (VMInstruction){HALT, NULL, 0};         // Halt the VM
 
     // Create and run the virtual machine with the method
-    VirtualMachine vm = {method, 4, 0};  // 4 instructions
+    VirtualMachine vm = {method, 4, 0, 0};  // 4 instructions
     printf("\nRunning VM method:\n");
     run_vm(&vm, obj);
 
     // Clean up
     free_object(obj);
 
+    // The same method over many objects of one shape: after the first
+    // object every field access hits the inline cache. Objects with the
+    // fields in the other order have another shape, and miss once each
+    // time the shape changes.
+    int count = 1000000;
+    Field swapped[2] = { fields[1], fields[0] };
+    Object **objs = malloc(count * sizeof(Object *));
+    for (int i = 0; i < count; i++)
+        objs[i] = create_object("Many", i < count / 2 ? fields : swapped, 2);
+
+    VMInstruction update[3];
+    update[0] = (VMInstruction){ADD, "field1", 5.0f};
+    update[1] = (VMInstruction){MUL, "field2", 3.0f};
+    update[2] = (VMInstruction){HALT, NULL, 0};
+    VirtualMachine many = {update, 3, 0, 0};
+    clock_t t = clock();
+    for (int i = 0; i < count; i++) {
+        many.pc = 0;
+        run_vm(&many, objs[i]);
+    }
+    double one_by_one = (double)(clock() - t) / CLOCKS_PER_SEC;
+    printf("\nRan a method over %d objects, %ld inline cache misses\n",
+           count, many.cache_misses);
+    print_fields(objs[count - 1]);
+
+    // and again with the method decoded once per batch
+    many.cache_misses = 0;
+    t = clock();
+    run_vm_batch(&many, objs, count);
+    double batched = (double)(clock() - t) / CLOCKS_PER_SEC;
+    printf("\nBatched, %ld inline cache misses\n", many.cache_misses);
+    print_fields(objs[count - 1]);
+    printf("%.3f s one object at a time, %.3f s batched\n", one_by_one, batched);
+
+    for (int i = 0; i < count; i++)
+        free_object(objs[i]);
+    free(objs);
+    free_shapes();
+
     return 0;
 }
 
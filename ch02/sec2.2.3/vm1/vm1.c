@@ -1,5 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include "vm1.h"
 
 
@@ -17,6 +19,7 @@ VM* newVM(int* code, int pc) {
     vm->code = code;
     vm->pc = pc;
     vm->sp = -1;
+    vm->input = 0;
 
     return vm;
 }
@@ -81,6 +84,10 @@ void run(VM* vm){
                 printf("%d\n", v);
                 break;
 
+            case IN:
+                push(vm, vm->input);
+                break;
+
             default:
                 break;
         }
@@ -88,6 +95,88 @@ void run(VM* vm){
     } while (TRUE);
 }
 
+
+// The same program over count inputs, out[i] being what it leaves on top
+// of the stack for in[i]. Each stack slot holds LANES values, one per
+// input, so an opcode is dispatched once for LANES inputs and the
+// compiler turns the lane arithmetic into vector instructions where the
+// CPU has them (GCC and Clang vector extensions). The inputs left over
+// go through run() one at a time.
+typedef int lanes __attribute__((vector_size(LANES * sizeof(int))));
+
+static void run_batch(int* code, lanes* stack, const int* in, int* out) {
+    int pc = 0, sp = -1;
+    lanes x;
+    memcpy(&x, in, sizeof(x));
+
+    do {
+        int opcode = code[pc++];
+        switch (opcode) {
+
+            case HALT:
+                if (sp >= 0)
+                    memcpy(out, &stack[sp], sizeof(lanes));
+                else
+                    memset(out, 0, sizeof(lanes));
+                return;
+
+            case SET:
+                stack[++sp] = (lanes){0} + code[pc++];
+                break;
+
+            case ADD:
+                stack[sp - 1] += stack[sp];
+                sp--;
+                break;
+
+            case SUB:
+                stack[sp - 1] -= stack[sp];
+                sp--;
+                break;
+
+            case MUL:
+                stack[sp - 1] *= stack[sp];
+                sp--;
+                break;
+
+            case PRINT:
+                for (int i = 0; i < LANES; i++)
+                    printf("%d\n", stack[sp][i]);
+                sp--;
+                break;
+
+            case IN:
+                stack[++sp] = x;
+                break;
+
+            default:
+                break;
+        }
+
+    } while (TRUE);
+}
+
+void run_lanes(int* code, const int* in, int* out, int count) {
+    static lanes stack[STACK_SIZE];
+    int i = 0;
+    for (; i + LANES <= count; i += LANES)
+        run_batch(code, stack, in + i, out + i);
+
+    if (i == count)
+        return;
+    VM* vm = newVM(code, 0);
+    if (vm == NULL)
+        return;
+    for (; i < count; i++) {
+        vm->pc = 0;
+        vm->sp = -1;
+        vm->input = in[i];
+        run(vm);
+        out[i] = vm->sp >= 0 ? vm->stack[vm->sp] : 0;
+    }
+    freeVM(vm);
+}
+
 int program[] = {
     SET, 33,
     SET, 44,
@@ -96,11 +185,61 @@ int program[] = {
     HALT
 };
 
+// x * x - 3 * x + 7 for every input x
+int expression[] = {
+    IN,
+    IN,
+    MUL,
+    SET, 3,
+    IN,
+    MUL,
+    SUB,
+    SET, 7,
+    ADD,
+    HALT
+};
+
+#define INPUTS 1000003      // not a multiple of LANES, for the tail
+
+void lanes_demo() {
+    int* in = (int*) malloc(sizeof(int) * INPUTS);
+    int* out = (int*) malloc(sizeof(int) * INPUTS);
+    int* want = (int*) malloc(sizeof(int) * INPUTS);
+    VM* vm = newVM(expression, 0);
+    if (in == NULL || out == NULL || want == NULL || vm == NULL)
+        return;
+    for (int i = 0; i < INPUTS; i++)
+        in[i] = i % 1000 - 500;
+
+    clock_t t = clock();
+    for (int i = 0; i < INPUTS; i++) {
+        vm->pc = 0;
+        vm->sp = -1;
+        vm->input = in[i];
+        run(vm);
+        want[i] = vm->stack[vm->sp];
+    }
+    t = clock() - t;
+    printf("one at a time: %f seconds\n", ((double) t) / CLOCKS_PER_SEC);
+
+    t = clock();
+    run_lanes(expression, in, out, INPUTS);
+    t = clock() - t;
+    printf("%d lanes:       %f seconds\n", LANES, ((double) t) / CLOCKS_PER_SEC);
+
+    printf("%s\n", memcmp(want, out, sizeof(int) * INPUTS) == 0 ? "same results" : "results differ");
+    freeVM(vm);
+    free(want);
+    free(out);
+    free(in);
+}
+
 int main() {
     VM* vm = newVM(program, 0);
     if (vm != NULL) {
         run(vm);
         freeVM(vm);
     }
+    lanes_demo();
     return 0;
 };
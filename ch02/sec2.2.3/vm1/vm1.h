@@ -5,6 +5,9 @@
 #define TRUE 1
 #define FALSE 0
 
+// run_lanes() takes this many inputs through the program at once
+#define LANES 8
+
 
 typedef struct {
     int* code;
@@ -12,6 +15,7 @@ typedef struct {
     int pc;
     int sp;
     int fp;
+    int input;      // what IN pushes
 } VM;
 
 enum {
@@ -21,9 +25,11 @@ enum {
     SUB,
     MUL,
     SET,
-    PRINT
+    PRINT,
+    IN
 };
 
 VM* newVM(int* code, int pc);
 void freeVM(VM* vm);
 void run(VM* vm);
+void run_lanes(int* code, const int* in, int* out, int count);
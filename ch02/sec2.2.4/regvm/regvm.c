@@ -2,109 +2,138 @@
 #include <stdlib.h>
 #include <string.h>
 
-#define MAX_PROGRAM_SIZE 100
-#define MAX_REGISTERS 4
-
-typedef struct {
-    int pc;
-    int registers[MAX_REGISTERS]; // A, B, C, D
-    int flags[2]; // Z, N
-    char *memory[MAX_PROGRAM_SIZE];
-} REGVM;
+#include "regvm.h"
 
 // fwd decl
 void init_vm(REGVM *vm);
-void load_program(REGVM *vm, char *program[], int size);
-void fetch(REGVM *vm, char **instruction);
-int decode_and_execute(REGVM *vm, char *instruction);
+int load_program(REGVM *vm, char *program[], int size);
+int decode(char *instruction, RInstr *out);
 void update_flags(REGVM *vm, int value);
 void run(REGVM *vm);
-int get_value(REGVM *vm, char *arg);
+int load_binary(REGVM *vm, const char *path);
 
 
 void init_vm(REGVM *vm) {
     vm->pc = 0;
     memset(vm->registers, 0, sizeof(vm->registers));
     memset(vm->flags, 0, sizeof(vm->flags));
-    memset(vm->memory, 0, sizeof(vm->memory));
+    vm->code = NULL;
+    vm->code_size = 0;
 }
 
-void load_program(REGVM *vm, char *program[], int size) {
-    for (int i = 0; i < size; i++) {
-        vm->memory[i] = program[i];
+// One-time assembler: every text instruction becomes one RInstr, so the
+// instruction numbers used by JMP and JZ stay the same.
+int load_program(REGVM *vm, char *program[], int size) {
+    if (size > MAX_PROGRAM_SIZE) {
+        fprintf(stderr, "Program too long: %d instructions\n", size);
+        return 0;
     }
-}
 
-void fetch(REGVM *vm, char **instruction) {
-    if (vm->pc < MAX_PROGRAM_SIZE && vm->memory[vm->pc] != NULL) {
-        *instruction = vm->memory[vm->pc];
-        vm->pc++;
-    } else {
-        *instruction = NULL;
+    RInstr *code = malloc(sizeof(RInstr) * (size > 0 ? size : 1));
+    if (!code)
+        return 0;
+
+    for (int i = 0; i < size; i++) {
+        if (!decode(program[i], &code[i])) {
+            fprintf(stderr, "at instruction %d: %s\n", i, program[i]);
+            free(code);
+            return 0;
+        }
     }
+
+    free(vm->code);
+    vm->code = code;
+    vm->code_size = size;
+    vm->pc = 0;
+    return 1;
 }
 
-int get_value(REGVM *vm, char *arg) {
-    if (arg[0] >= 'A' && arg[0] <= 'D') {
-        return vm->registers[arg[0] - 'A'];
-    } else {
-        return atoi(arg);
-    }
+int is_register(const char *arg) {
+    return arg[0] >= 'A' && arg[0] <= 'D' && arg[1] == '\0';
 }
 
-int decode_and_execute(REGVM *vm, char *instruction) {
-    if (!instruction)
+int decode(char *instruction, RInstr *out) {
+    char opcode[8] = "", arg1[16] = "", arg2[16] = "";
+    if (!instruction
+            || sscanf(instruction, "%7s %15s %15s", opcode, arg1, arg2) < 1) {
+        fprintf(stderr, "Empty instruction\n");
         return 0;
+    }
 
-    char opcode[4];
-    char arg1[2];
-    char arg2[10];
-    // careful ..
-    sscanf(instruction, "%s %s %s", opcode, arg1, arg2);
-
-    int val1, val2;
+    memset(out, 0, sizeof(*out));
+    int binop = -1;
 
     if (strcmp(opcode, "MOV") == 0) {
-        val1 = (arg1[0] - 'A');
-        vm->registers[val1] = get_value(vm, arg2);
-
+        binop = R_MOV;
     } else if (strcmp(opcode, "ADD") == 0) {
-        val1 = (arg1[0] - 'A');
-        vm->registers[val1] += get_value(vm, arg2);
-        update_flags(vm, vm->registers[val1]);
-
+        binop = R_ADD;
     } else if (strcmp(opcode, "SUB") == 0) {
-        val1 = (arg1[0] - 'A');
-        vm->registers[val1] -= get_value(vm, arg2);
-        update_flags(vm, vm->registers[val1]);
-
+        binop = R_SUB;
     } else if (strcmp(opcode, "MUL") == 0) {
-        val1 = (arg1[0] - 'A');
-        vm->registers[val1] *= get_value(vm, arg2);
-        update_flags(vm, vm->registers[val1]);
+        binop = R_MUL;
 
     } else if (strcmp(opcode, "CMP") == 0) {
-        val1 = get_value(vm, arg1);
-        val2 = get_value(vm, arg2);
-        vm->flags[0] = (val1 == val2) ? 1 : 0;
-
-    } else if (strcmp(opcode, "JMP") == 0) {
-        vm->pc = atoi(arg1);
+        if (!arg1[0] || !arg2[0]) {
+            fprintf(stderr, "CMP needs two arguments\n");
+            return 0;
+        }
+        // equality is symmetric, keep a register first if there is one
+        char *x = is_register(arg1) ? arg1 : arg2;
+        char *y = (x == arg1) ? arg2 : arg1;
+        if (!is_register(x)) {
+            out->op = R_SETZ;
+            out->imm = (atoi(x) == atoi(y)) ? 1 : 0;
+        } else if (is_register(y)) {
+            out->op = R_CMP;
+            out->rs = x[0] - 'A';
+            out->rt = y[0] - 'A';
+        } else {
+            out->op = R_CMPI;
+            out->rs = x[0] - 'A';
+            out->imm = atoi(y);
+        }
 
-    } else if (strcmp(opcode, "JZ") == 0) {
-        if (vm->flags[0]) {
-            vm->pc = atoi(arg1);
+    } else if (strcmp(opcode, "JMP") == 0 || strcmp(opcode, "JZ") == 0) {
+        if (!arg1[0]) {
+            fprintf(stderr, "%s needs a target\n", opcode);
+            return 0;
         }
+        out->op = (opcode[1] == 'M') ? R_JMP : R_JZ;
+        out->imm = atoi(arg1);
 
     } else if (strcmp(opcode, "PRINT") == 0) {
-        val1 = (arg1[0] - 'A');
-        printf("Register %c: %d\n", arg1[0], vm->registers[val1]);
+        if (!is_register(arg1)) {
+            fprintf(stderr, "PRINT needs a register\n");
+            return 0;
+        }
+        out->op = R_SHOW;
+        out->rs = arg1[0] - 'A';
 
     } else {
         fprintf(stderr, "Unknown opcode: %s\n", opcode);
         return 0;
     }
 
+    // MOV, ADD, SUB, MUL: register destination, register or immediate value
+    if (binop >= 0) {
+        if (!is_register(arg1) || !arg2[0]) {
+            fprintf(stderr, "%s needs a register and a value\n", opcode);
+            return 0;
+        }
+        out->rd = arg1[0] - 'A';
+        out->rs = out->rd;
+        if (is_register(arg2)) {
+            out->op = binop;
+            if (binop == R_MOV)
+                out->rs = arg2[0] - 'A';
+            else
+                out->rt = arg2[0] - 'A';
+        } else {
+            out->op = binop + 1;    // immediate form
+            out->imm = atoi(arg2);
+        }
+    }
+
     return 1;
 }
 
@@ -113,20 +142,109 @@ void update_flags(REGVM *vm, int value) {
     vm->flags[1] = (value < 0) ? 1 : 0;   // Negative
 }
 
+int load_binary(REGVM *vm, const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return 0;
+    }
+
+    char magic[4];
+    int32_t count, entry;
+    if (fread(magic, 1, 4, file) != 4 || memcmp(magic, RVM_MAGIC, 4) != 0
+            || fread(&count, sizeof(count), 1, file) != 1
+            || fread(&entry, sizeof(entry), 1, file) != 1
+            || count <= 0 || entry < 0 || entry >= count) {
+        fprintf(stderr, "Not a register program: %s\n", path);
+        fclose(file);
+        return 0;
+    }
+
+    RInstr *code = malloc(sizeof(RInstr) * count);
+    if (!code || fread(code, sizeof(RInstr), count, file) != (size_t) count) {
+        fprintf(stderr, "Truncated register program: %s\n", path);
+        free(code);
+        fclose(file);
+        return 0;
+    }
+    fclose(file);
+
+    for (int i = 0; i < count; i++) {
+        if (code[i].op >= R_NUM_OPS || code[i].rd >= MAX_REGISTERS
+                || code[i].rs >= MAX_REGISTERS || code[i].rt >= MAX_REGISTERS) {
+            fprintf(stderr, "Bad instruction %d in %s\n", i, path);
+            free(code);
+            return 0;
+        }
+    }
+
+    free(vm->code);
+    vm->code = code;
+    vm->code_size = count;
+    vm->pc = entry;
+    return 1;
+}
+
+// executes the decoded program only: one switch per instruction, no parsing
 void run(REGVM *vm) {
-    char *instruction;
-    while (1) {
-        fetch(vm, &instruction);
-        if (!instruction || !decode_and_execute(vm, instruction)) {
-            break;
+    const RInstr *code = vm->code;
+    int *r = vm->registers;
+
+    while (vm->pc >= 0 && vm->pc < vm->code_size) {
+        const RInstr *in = &code[vm->pc++];
+
+        switch (in->op) {
+            case R_HALT:  return;
+            case R_MOV:   r[in->rd] = r[in->rs]; break;
+            case R_MOVI:  r[in->rd] = in->imm; break;
+            case R_ADD:   r[in->rd] = r[in->rs] + r[in->rt]; update_flags(vm, r[in->rd]); break;
+            case R_ADDI:  r[in->rd] = r[in->rs] + in->imm; update_flags(vm, r[in->rd]); break;
+            case R_SUB:   r[in->rd] = r[in->rs] - r[in->rt]; update_flags(vm, r[in->rd]); break;
+            case R_SUBI:  r[in->rd] = r[in->rs] - in->imm; update_flags(vm, r[in->rd]); break;
+            case R_MUL:   r[in->rd] = r[in->rs] * r[in->rt]; update_flags(vm, r[in->rd]); break;
+            case R_MULI:  r[in->rd] = r[in->rs] * in->imm; update_flags(vm, r[in->rd]); break;
+            case R_MOD:   r[in->rd] = r[in->rs] % r[in->rt]; break;
+            case R_MODI:  r[in->rd] = r[in->rs] % in->imm; break;
+            case R_AND:   r[in->rd] = r[in->rs] & r[in->rt]; break;
+            case R_ANDI:  r[in->rd] = r[in->rs] & in->imm; break;
+            case R_OR:    r[in->rd] = r[in->rs] | r[in->rt]; break;
+            case R_ORI:   r[in->rd] = r[in->rs] | in->imm; break;
+            case R_LSH:   r[in->rd] = r[in->rs] << r[in->rt]; break;
+            case R_LSHI:  r[in->rd] = r[in->rs] << in->imm; break;
+            case R_RSH:   r[in->rd] = r[in->rs] >> r[in->rt]; break;
+            case R_RSHI:  r[in->rd] = r[in->rs] >> in->imm; break;
+            case R_EQ:    r[in->rd] = (r[in->rs] == r[in->rt]) ? 1 : 0; break;
+            case R_EQI:   r[in->rd] = (r[in->rs] == in->imm) ? 1 : 0; break;
+            case R_CMP:   vm->flags[0] = (r[in->rs] == r[in->rt]) ? 1 : 0; break;
+            case R_CMPI:  vm->flags[0] = (r[in->rs] == in->imm) ? 1 : 0; break;
+            case R_JMP:   vm->pc = in->imm; break;
+            case R_JZ:    if (vm->flags[0]) vm->pc = in->imm; break;
+            case R_JRZ:   if (r[in->rs] == 0) vm->pc = in->imm; break;
+            case R_JRNZ:  if (r[in->rs] != 0) vm->pc = in->imm; break;
+            case R_PRINT: printf("%d\n", r[in->rs]); break;
+            case R_PRNT:  printf("%d", r[in->rs]); break;
+            case R_SETZ:  vm->flags[0] = in->imm; break;
+            case R_SHOW:  printf("Register %c: %d\n", 'A' + in->rs, r[in->rs]); break;
+            default:
+                fprintf(stderr, "Unknown opcode: %d\n", in->op);
+                return;
         }
     }
 }
 
-int main() {
+int main(int argc, char *argv[]) {
     REGVM vm;
     init_vm(&vm);
 
+    // ./regvm prog.r runs a binary program from stack2reg
+    if (argc > 1) {
+        if (!load_binary(&vm, argv[1]))
+            return 1;
+        run(&vm);
+        free(vm.code);
+        return 0;
+    }
+
     char *factorial[] = {
         "MOV A 1",
         "MOV B 5",
@@ -138,8 +256,10 @@ int main() {
         "PRINT A"
     };
 
-    load_program(&vm, factorial, sizeof(factorial) / sizeof(factorial[0]));
+    if (!load_program(&vm, factorial, sizeof(factorial) / sizeof(factorial[0])))
+        return 1;
     run(&vm);
+    free(vm.code);
 
     return 0;
 }
@@ -0,0 +1,55 @@
+#ifndef REGVM_H
+#define REGVM_H
+
+#include <stdint.h>
+
+#define MAX_PROGRAM_SIZE 100
+#define MAX_REGISTERS 64    // A, B, C, D are the first four
+
+// Binary register code, as assembled by load_program() or written by
+// stack2reg, and run by run().
+// The second operand of a two operand instruction is either register rt
+// or, in the ..I form, the immediate imm. Jump targets are in imm.
+typedef enum {
+    R_HALT,
+    R_MOV,  R_MOVI,     // rd = rs | imm
+    R_ADD,  R_ADDI,     // rd = rs + rt | imm, sets flags
+    R_SUB,  R_SUBI,     // rd = rs - rt | imm, sets flags
+    R_MUL,  R_MULI,     // rd = rs * rt | imm, sets flags
+    R_MOD,  R_MODI,
+    R_AND,  R_ANDI,
+    R_OR,   R_ORI,
+    R_LSH,  R_LSHI,
+    R_RSH,  R_RSHI,
+    R_EQ,   R_EQI,      // rd = (rs == rt | imm)
+    R_CMP,  R_CMPI,     // Z = (rs == rt | imm)
+    R_JMP,              // pc = imm
+    R_JZ,               // if Z: pc = imm
+    R_JRZ,  R_JRNZ,     // if rs == 0 (!= 0): pc = imm
+    R_PRINT,            // print rs and a newline
+    R_PRNT,             // print rs
+    R_SETZ,             // Z = imm, CMP of two constants
+    R_SHOW,             // print rs as "Register A: ..."
+    R_NUM_OPS
+} ROpcode;
+
+typedef struct {
+    uint8_t op;
+    uint8_t rd;
+    uint8_t rs;
+    uint8_t rt;
+    int32_t imm;
+} RInstr;
+
+// file: magic, instruction count and entry, then the instructions
+#define RVM_MAGIC "RVM1"
+
+typedef struct {
+    int pc;
+    int registers[MAX_REGISTERS];
+    int flags[2]; // Z, N
+    RInstr *code;   // decoded program
+    int code_size;
+} REGVM;
+
+#endif
@@ -0,0 +1,351 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "regvm.h"
+#include "../../sec2.4/vm3/vm3.h"
+
+// Translate vm3 stack bytecode (the comma separated .b files written by
+// vm3/asm.py) into binary register code for regvm.
+//
+// At top level vm3 has fp = 0, so LD i and LOAD i both read stack[i]. The
+// stack depth at every instruction is known statically, so stack slot i
+// simply becomes register i. Values pushed by SET, LD and DUP are not
+// copied at once: the slot remembers the register (or constant) it came
+// from, and the instruction that consumes it reads that directly. Slots
+// are only written back to their own register when the register they
+// refer to is overwritten, and at jumps and jump targets where all slots
+// must be in place. CALL and RET are not translated.
+//
+// usage: stack2reg input.b output.r
+
+#define MAX_CODE 32768
+
+typedef struct {
+    int is_const;
+    int value;      // register holding the slot, or the constant
+} Slot;
+
+int* code;
+int code_len;
+int start;
+
+RInstr* out;
+int out_len;
+int out_cap;
+
+Slot slots[MAX_REGISTERS];
+int depth;
+
+void fail(const char* message, int addr) {
+    fprintf(stderr, "stack2reg: %s at %d\n", message, addr);
+    exit(1);
+}
+
+int arity(int opcode) {
+    switch (opcode) {
+        case CALL: case JP: case JPNZ: case JPZ:
+        case LD: case LOAD: case SET: case ST: case STORE:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// change in stack depth, or a large negative value if not translated
+int effect(int opcode) {
+    switch (opcode) {
+        case SET: case SETZ: case LD: case LOAD: case DUP:
+            return 1;
+        case INC: case DEC: case EQZ: case JP: case HALT:
+            return 0;
+        case ADD: case SUB: case MUL: case MOD: case AND: case OR:
+        case LSH: case RSH: case EQ:
+        case ST: case STORE: case DROP: case PRINT: case PRNT:
+        case JPZ: case JPNZ:
+            return -1;
+        default:
+            return -1000;
+    }
+}
+
+void emit(int op, int rd, int rs, int rt, int imm) {
+    if (out_len >= out_cap) {
+        out_cap = out_cap ? out_cap * 2 : 256;
+        out = realloc(out, sizeof(RInstr) * out_cap);
+        if (out == NULL)
+            fail("out of memory", 0);
+    }
+    RInstr* in = &out[out_len++];
+    in->op = op;
+    in->rd = rd;
+    in->rs = rs;
+    in->rt = rt;
+    in->imm = imm;
+}
+
+void materialize(int s);
+
+// register r is about to be written: slots above it still reading it get
+// their own copy first (a slot only ever refers to a register below it)
+void clobber(int r, int except) {
+    for (int t = depth - 1; t > r; t--)
+        if (t != except && !slots[t].is_const && slots[t].value == r)
+            materialize(t);
+}
+
+void materialize(int s) {
+    if (!slots[s].is_const && slots[s].value == s)
+        return;
+    clobber(s, -1);
+    if (slots[s].is_const)
+        emit(R_MOVI, s, 0, 0, slots[s].value);
+    else
+        emit(R_MOV, s, slots[s].value, 0, 0);
+    slots[s].is_const = 0;
+    slots[s].value = s;
+}
+
+void materialize_all(void) {
+    for (int s = depth - 1; s >= 0; s--)
+        materialize(s);
+}
+
+// register holding slot s, loading a constant into place if needed
+int reg(int s) {
+    if (slots[s].is_const)
+        materialize(s);
+    return slots[s].value;
+}
+
+void push_slot(int is_const, int value, int addr) {
+    if (depth >= MAX_REGISTERS)
+        fail("stack deeper than the register file", addr);
+    slots[depth].is_const = is_const;
+    slots[depth].value = value;
+    depth++;
+}
+
+void binary(int op) {
+    int x = depth - 2, y = depth - 1;
+    int rs = reg(x);
+    if (slots[y].is_const)
+        emit(op + 1, x, rs, 0, slots[y].value);   // immediate form
+    else
+        emit(op, x, rs, slots[y].value, 0);
+    slots[x].is_const = 0;
+    slots[x].value = x;
+    depth--;
+}
+
+void unary(int op, int imm) {
+    int t = depth - 1;
+    emit(op, t, reg(t), 0, imm);
+    slots[t].is_const = 0;
+    slots[t].value = t;
+}
+
+// LD i and LOAD i: the new slot refers to wherever slot i lives
+void load(int i, int addr) {
+    if (i < 0 || i >= MAX_REGISTERS)
+        fail("local out of range", addr);
+    if (i < depth)
+        push_slot(slots[i].is_const, slots[i].value, addr);
+    else {
+        push_slot(0, depth, addr);
+        emit(R_MOV, depth - 1, i, 0, 0);
+    }
+}
+
+// ST i and STORE i
+void store(int i, int addr) {
+    if (i < 0 || i >= MAX_REGISTERS)
+        fail("local out of range", addr);
+    int top = depth - 1;
+    if (!slots[top].is_const && slots[top].value == i) {
+        depth--;    // value is already there
+        return;
+    }
+    clobber(i, top);
+    Slot v = slots[top];
+    depth--;
+    if (v.is_const)
+        emit(R_MOVI, i, 0, 0, v.value);
+    else
+        emit(R_MOV, i, v.value, 0, 0);
+    if (i < depth) {
+        slots[i].is_const = 0;
+        slots[i].value = i;
+    }
+}
+
+void read_program(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "stack2reg: cannot open %s\n", path);
+        exit(1);
+    }
+    code = malloc(sizeof(int) * MAX_CODE);
+    if (code == NULL)
+        fail("out of memory", 0);
+
+    int value, first = 1;
+    while (fscanf(file, "%d", &value) == 1) {
+        if (first) {
+            start = value;
+            first = 0;
+        } else if (code_len < MAX_CODE) {
+            code[code_len++] = value;
+        }
+        fscanf(file, " ,");
+    }
+    fclose(file);
+    if (first)
+        fail("empty program", 0);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: stack2reg input.b output.r\n");
+        return 2;
+    }
+    read_program(argv[1]);
+
+    // pass 1: static stack depth at every reachable instruction
+    int* level = malloc(sizeof(int) * (code_len + 1));
+    char* target = calloc(code_len + 1, 1);
+    int* work = malloc(sizeof(int) * (code_len + 1));
+    int* index = malloc(sizeof(int) * (code_len + 1));
+    if (!level || !target || !work || !index)
+        fail("out of memory", 0);
+    for (int a = 0; a <= code_len; a++)
+        level[a] = -1;
+
+    int nwork = 0;
+    if (start < 0 || start >= code_len)
+        fail("start outside program", start);
+    level[start] = 0;
+    work[nwork++] = start;
+    while (nwork > 0) {
+        int a = work[--nwork];
+        int opcode = code[a];
+        if (opcode == CALL || opcode == RET)
+            fail("CALL and RET are not translated", a);
+        int d = level[a] + effect(opcode);
+        if (d < 0)
+            fail(effect(opcode) < -1 ? "unsupported opcode" : "stack underflow", a);
+        if (d > MAX_REGISTERS)
+            fail("stack deeper than the register file", a);
+        int next = a + 1 + arity(opcode);
+        if (next > code_len)
+            fail("operand past end of program", a);
+
+        int succ[2], n = 0;
+        if (opcode == JP || opcode == JPZ || opcode == JPNZ) {
+            int t = code[a + 1];
+            if (t < 0 || t >= code_len)
+                fail("jump outside program", a);
+            target[t] = 1;
+            succ[n++] = t;
+        }
+        if (opcode != JP && opcode != HALT) {
+            if (next >= code_len)
+                fail("falls off the end of the program", a);
+            succ[n++] = next;
+        }
+        for (int i = 0; i < n; i++) {
+            if (level[succ[i]] < 0) {
+                level[succ[i]] = d;
+                work[nwork++] = succ[i];
+            } else if (level[succ[i]] != d) {
+                fail("stack depth differs where paths join", succ[i]);
+            }
+        }
+    }
+
+    // pass 2: emit register code in address order
+    int stack_count = 0;
+    for (int a = 0; a < code_len; a++) {
+        if (level[a] < 0)
+            continue;
+        stack_count++;
+        index[a] = out_len;
+        depth = level[a];
+        if (target[a])
+            for (int s = 0; s < depth; s++)
+                slots[s] = (Slot) { 0, s };
+
+        int opcode = code[a];
+        int operand = arity(opcode) ? code[a + 1] : 0;
+        switch (opcode) {
+            case HALT:  emit(R_HALT, 0, 0, 0, 0); break;
+            case SET:   push_slot(1, operand, a); break;
+            case SETZ:  push_slot(1, 0, a); break;
+            case LD:
+            case LOAD:  load(operand, a); break;
+            case ST:
+            case STORE: store(operand, a); break;
+            case DUP:
+                push_slot(slots[depth - 1].is_const, slots[depth - 1].value, a);
+                break;
+            case DROP:  depth--; break;
+            case ADD:   binary(R_ADD); break;
+            case SUB:   binary(R_SUB); break;
+            case MUL:   binary(R_MUL); break;
+            case MOD:   binary(R_MOD); break;
+            case AND:   binary(R_AND); break;
+            case OR:    binary(R_OR); break;
+            case LSH:   binary(R_LSH); break;
+            case RSH:   binary(R_RSH); break;
+            case EQ:    binary(R_EQ); break;
+            case INC:   unary(R_ADDI, 1); break;
+            case DEC:   unary(R_SUBI, 1); break;
+            case EQZ:   unary(R_EQI, 0); break;
+            case PRINT:
+            case PRNT:
+                emit(opcode == PRINT ? R_PRINT : R_PRNT, 0, reg(depth - 1), 0, 0);
+                depth--;
+                break;
+            case JP:
+                materialize_all();
+                emit(R_JMP, 0, 0, 0, operand);
+                break;
+            case JPZ:
+            case JPNZ:
+                materialize_all();
+                emit(opcode == JPZ ? R_JRZ : R_JRNZ, 0, depth - 1, 0, operand);
+                depth--;
+                break;
+        }
+
+        // falling into a jump target: put every slot in its register
+        int next = a + 1 + arity(opcode);
+        if (next < code_len && target[next] && level[next] >= 0
+                && opcode != JP && opcode != HALT) {
+            materialize_all();
+        }
+    }
+
+    // jump targets from vm3 addresses to register code indices
+    for (int i = 0; i < out_len; i++) {
+        int op = out[i].op;
+        if (op == R_JMP || op == R_JRZ || op == R_JRNZ)
+            out[i].imm = index[out[i].imm];
+    }
+
+    FILE* file = fopen(argv[2], "wb");
+    if (file == NULL) {
+        fprintf(stderr, "stack2reg: cannot write %s\n", argv[2]);
+        return 1;
+    }
+    int32_t count = out_len, entry = index[start];
+    fwrite(RVM_MAGIC, 1, 4, file);
+    fwrite(&count, sizeof(count), 1, file);
+    fwrite(&entry, sizeof(entry), 1, file);
+    fwrite(out, sizeof(RInstr), out_len, file);
+    fclose(file);
+
+    printf("%d stack instructions -> %d register instructions\n",
+        stack_count, out_len);
+    return 0;
+}
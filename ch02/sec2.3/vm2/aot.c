@@ -0,0 +1,52 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "vm2.h"
+
+// Made by vm2c from count.vm2
+extern const int count_datasize;
+extern int count_code[];
+void count(int* vars);
+
+// Made by vm2c from over.vm2
+extern const int over_datasize;
+extern int over_code[];
+void over(int* vars);
+
+// The same programs interpreted and translated
+int main() {
+	clock_t t;
+
+	// the stack words should print the same both ways
+	VM* vm = newVM(over_code, 0, over_datasize);
+	if (vm == NULL)
+		return 1;
+	printf("interpreted:\n");
+	run(vm);
+	freeVM(vm);
+	int* vars = (int*) malloc(sizeof(int) * over_datasize);
+	if (vars == NULL)
+		return 1;
+	printf("translated:\n");
+	over(vars);
+	free(vars);
+
+	vm = newVM(count_code, 0, count_datasize);
+	if (vm == NULL)
+		return 1;
+	t = clock();
+	run(vm);
+	t = clock() - t;
+	printf("interpreted: %f seconds\n", ((double) t) / CLOCKS_PER_SEC);
+	freeVM(vm);
+
+	vars = (int*) malloc(sizeof(int) * count_datasize);
+	if (vars == NULL)
+		return 1;
+	t = clock();
+	count(vars);
+	t = clock() - t;
+	printf("translated: %f seconds\n", ((double) t) / CLOCKS_PER_SEC);
+	free(vars);
+	return 0;
+}
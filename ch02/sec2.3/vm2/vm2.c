@@ -36,6 +36,11 @@ void freeVM(VM* vm){
     }
 }
 
+// PRINT, for run() and for code translated by vm2c
+void printValue(int v) {
+    printf("%d\n", v);
+}
+
 int pop(VM* vm) {
     int sp = (vm->sp)--;
     return vm->stack[sp];
@@ -198,7 +203,7 @@ void run(VM* vm) {
 
             case PRINT:
                 v = pop(vm);
-                printf("%d\n", v);
+                printValue(v);
                 break;
 
             default:
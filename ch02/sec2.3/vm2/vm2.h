@@ -45,3 +45,4 @@ enum {
 VM* newVM(int* code, int pc, int datasize);
 void freeVM(VM* vm);
 void run(VM* vm);
+void printValue(int v);
@@ -0,0 +1,307 @@
+// vm2c: translates a vm2 program into C ahead of time.
+//
+// The program is read as text, one opcode name or number per word, with
+// '//' comments. Out comes a C file with the bytecode, for the
+// interpreter, and a function that does what run() would do with it:
+// each instruction becomes a statement, each jump target a label and
+// each jump a goto, so the basic blocks are left to the C compiler.
+//
+// Where the stack depth at every instruction is known, which it is when
+// every path to an instruction arrives with the same depth, the stack
+// slots become locals s0, s1, ... and the compiler keeps them in
+// registers. Otherwise the function works on a stack array, as run()
+// does, still without the switch.
+//
+//   ./vm2c fib.vm2 fib > fib_aot.c
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "vm2.h"
+
+#define MAX_CODE 4096
+
+typedef struct {
+    const char* name;
+    int operand;        // 1 when an address or value follows
+    int needs;          // values it takes off the stack
+    int leaves;         // values it leaves in their place
+} Op;
+
+static const Op ops[] = {
+    [ADD]    = {"ADD",    0, 2, 1},
+    [DEC]    = {"DEC",    0, 1, 1},
+    [EQ]     = {"EQ",     0, 2, 1},
+    [EQZ]    = {"EQZ",    0, 1, 1},
+    [HALT]   = {"HALT",   0, 0, 0},
+    [INC]    = {"INC",    0, 1, 1},
+    [JP]     = {"JP",     1, 0, 0},
+    [JPNZ]   = {"JPNZ",   1, 1, 0},
+    [JPZ]    = {"JPZ",    1, 1, 0},
+    [LOAD]   = {"LOAD",   1, 0, 1},
+    [LT]     = {"LT",     0, 2, 1},
+    [MUL]    = {"MUL",    0, 2, 1},
+    [NOP]    = {"NOP",    0, 0, 0},
+    [PRINT]  = {"PRINT",  0, 1, 0},
+    [SET]    = {"SET",    1, 0, 1},
+    [SETZ]   = {"SETZ",   0, 0, 1},
+    [STORE]  = {"STORE",  1, 1, 0},
+    [SUB]    = {"SUB",    0, 2, 1},
+    [DROP]   = {"DROP",   0, 1, 0},
+    [DUP]    = {"DUP",    0, 1, 2},
+    [OVER]   = {"OVER",   0, 2, 3},
+    [ROT]    = {"ROT",    0, 3, 3},
+    [SWAP]   = {"SWAP",   0, 2, 2},
+    [TWODUP] = {"TWODUP", 0, 2, 4}
+};
+#define NOPS ((int) (sizeof(ops) / sizeof(ops[0])))
+
+// run() skips an opcode it does not know
+static const Op unknown = {"?", 0, 0, 0};
+
+static int code[MAX_CODE];
+static int length = 0;
+static int line[MAX_CODE];          // source line of each word
+
+static char start[MAX_CODE];        // an instruction begins here
+static char target[MAX_CODE];       // a jump that is run lands here
+static int depth[MAX_CODE];         // stack depth on arrival, -1 unreached
+static int known = TRUE;            // the depth is the same on every path
+static int maxdepth = 0;
+static int datasize = 0;
+
+static const Op* op(int pc) {
+    int c = code[pc];
+    return (c >= 0 && c < NOPS && ops[c].name != NULL) ? &ops[c] : &unknown;
+}
+
+static int isjump(int c) {
+    return c == JP || c == JPZ || c == JPNZ;
+}
+
+static void fail(int pc, const char* message) {
+    if (pc >= 0)
+        fprintf(stderr, "vm2c: line %d, at %d: %s\n", line[pc], pc, message);
+    else
+        fprintf(stderr, "vm2c: %s\n", message);
+    exit(1);
+}
+
+// Reading
+
+static void readProgram(FILE* in) {
+    char word[64];
+    int n = 1, c = fgetc(in);
+    while (c != EOF) {
+        if (c == '\n') n++;
+        if (isspace(c)) {
+            c = fgetc(in);
+            continue;
+        }
+        if (c == '/') {
+            while (c != EOF && c != '\n') c = fgetc(in);
+            continue;
+        }
+        int w = 0;
+        while (c != EOF && !isspace(c) && w < (int) sizeof(word) - 1) {
+            word[w++] = (char) c;
+            c = fgetc(in);
+        }
+        word[w] = '\0';
+        if (length == MAX_CODE) fail(-1, "program too long");
+        line[length] = n;
+
+        char* end;
+        long v = strtol(word, &end, 10);
+        if (*end == '\0') {
+            code[length++] = (int) v;
+            continue;
+        }
+        int i;
+        for (i = 0; i < NOPS; i++)
+            if (ops[i].name != NULL && strcmp(ops[i].name, word) == 0) break;
+        if (i == NOPS) {
+            fprintf(stderr, "vm2c: line %d: unknown word '%s'\n", n, word);
+            exit(1);
+        }
+        code[length++] = i;
+    }
+}
+
+// Analysis
+
+static void analyse(void) {
+    int pc = 0;
+    while (pc < length) {
+        start[pc] = TRUE;
+        depth[pc] = -1;
+        if (op(pc)->operand && pc + 1 == length) fail(pc, "operand missing");
+        pc += 1 + op(pc)->operand;
+    }
+    for (pc = 0; pc < length; pc += 1 + op(pc)->operand) {
+        int c = code[pc];
+        if (isjump(c)) {
+            int to = code[pc + 1];
+            if (to < 0 || to >= length || !start[to]) fail(pc, "jump to no instruction");
+        }
+        if ((c == LOAD || c == STORE) && code[pc + 1] < 0) fail(pc, "negative address");
+        if ((c == LOAD || c == STORE) && code[pc + 1] >= datasize) datasize = code[pc + 1] + 1;
+    }
+
+    // Follow every path from 0, noting the depth each one arrives with
+    int work[MAX_CODE], nwork = 0, underflow = -1;
+    if (length == 0) fail(-1, "empty program");
+    depth[0] = 0;
+    work[nwork++] = 0;
+    while (nwork > 0) {
+        pc = work[--nwork];
+        const Op* o = op(pc);
+        int d = depth[pc];
+        if (d < o->needs && underflow < 0) underflow = pc;
+        int after = d - o->needs + o->leaves;
+        if (after < 0) after = 0;       // an underflow, reported below if it counts
+        if (after > STACK_SIZE) fail(pc, "stack overflow");
+        if (after > maxdepth) maxdepth = after;
+
+        int next[2], nnext = 0;
+        if (code[pc] != HALT && code[pc] != JP) next[nnext++] = pc + 1 + o->operand;
+        if (isjump(code[pc])) {
+            next[nnext++] = code[pc + 1];
+            target[code[pc + 1]] = TRUE;
+        }
+        for (int i = 0; i < nnext; i++) {
+            int to = next[i];
+            if (to >= length) fail(pc, "runs off the end of the program");
+            if (depth[to] < 0) {
+                depth[to] = after;
+                work[nwork++] = to;
+            } else if (depth[to] != after) {
+                known = FALSE;
+            }
+        }
+    }
+    // with the depth unknown, underflow is the program's own business
+    if (known && underflow >= 0) fail(underflow, "stack underflow");
+}
+
+// Writing
+
+// The value k places below the top as the instruction finds the stack;
+// k = -1 is the free slot above it
+static const char* slot(int pc, int k) {
+    static char buffer[8][32];
+    static int next = 0;
+    char* s = buffer[next++ % 8];
+    if (known)
+        snprintf(s, 32, "s%d", depth[pc] - 1 - k);
+    else if (k == 0)
+        snprintf(s, 32, "stack[sp]");
+    else
+        snprintf(s, 32, "stack[sp %c %d]", k > 0 ? '-' : '+', k > 0 ? k : -k);
+    return s;
+}
+
+static void instruction(FILE* out, int pc) {
+    int c = code[pc], v = op(pc)->operand ? code[pc + 1] : 0;
+    const char *x0 = slot(pc, 0), *x1 = slot(pc, 1), *x2 = slot(pc, 2), *up = slot(pc, -1);
+    char s[160];
+
+    switch (c) {
+        case SET:    snprintf(s, sizeof s, "%s = %d;", up, v); break;
+        case SETZ:   snprintf(s, sizeof s, "%s = 0;", up); break;
+        case ADD:    snprintf(s, sizeof s, "%s = %s + %s;", x1, x1, x0); break;
+        case SUB:    snprintf(s, sizeof s, "%s = %s - %s;", x1, x1, x0); break;
+        case MUL:    snprintf(s, sizeof s, "%s = %s * %s;", x1, x1, x0); break;
+        case LT:     snprintf(s, sizeof s, "%s = %s < %s;", x1, x1, x0); break;
+        case EQ:     snprintf(s, sizeof s, "%s = %s == %s;", x1, x1, x0); break;
+        case INC:    snprintf(s, sizeof s, "%s = %s + 1;", x0, x0); break;
+        case DEC:    snprintf(s, sizeof s, "%s = %s - 1;", x0, x0); break;
+        case EQZ:    snprintf(s, sizeof s, "%s = %s == 0;", x0, x0); break;
+        case LOAD:   snprintf(s, sizeof s, "%s = vars[%d];", up, v); break;
+        case STORE:  snprintf(s, sizeof s, "vars[%d] = %s;", v, x0); break;
+        case DUP:    snprintf(s, sizeof s, "%s = %s;", up, x0); break;
+        case OVER:   snprintf(s, sizeof s, "t = %s; %s = t; %s = %s; %s = t;", x0, up, x0, x1, x1); break;
+        case TWODUP: snprintf(s, sizeof s, "%s = %s; %s = %s;", up, x1, slot(pc, -2), x0); break;
+        case SWAP:   snprintf(s, sizeof s, "t = %s; %s = %s; %s = t;", x0, x0, x1, x1); break;
+        case ROT:    snprintf(s, sizeof s, "t = %s; %s = %s; %s = %s; %s = t;", x2, x2, x1, x1, x0, x0); break;
+        case PRINT:  snprintf(s, sizeof s, "printValue(%s);", x0); break;
+        case HALT:   snprintf(s, sizeof s, "return;"); break;
+        case JP:     snprintf(s, sizeof s, "goto L%d;", v); break;
+        case JPNZ:
+        case JPZ:
+            // the condition is taken off the stack whichever way it goes
+            snprintf(s, sizeof s, "if (%s %s 0) goto L%d;",
+                known ? x0 : "stack[sp--]", c == JPZ ? "==" : "!=", v);
+            break;
+        default:     snprintf(s, sizeof s, ";"); break;
+    }
+
+    const Op* o = op(pc);
+    int net = o->leaves - o->needs;
+    if (!known && net != 0 && !isjump(c)) {
+        size_t n = strlen(s);
+        if (net == 1) snprintf(s + n, sizeof s - n, " sp++;");
+        else if (net == -1) snprintf(s + n, sizeof s - n, " sp--;");
+        else snprintf(s + n, sizeof s - n, " sp += %d;", net);
+    }
+
+    if (target[pc]) fprintf(out, "L%d:\n", pc);
+    char word[32];
+    if (o->operand) snprintf(word, sizeof word, "%s %d", o->name, v);
+    else snprintf(word, sizeof word, "%s", o == &unknown ? "NOP" : o->name);
+    fprintf(out, "    %-40s // %d: %s\n", s, pc, word);
+}
+
+static void writeC(FILE* out, const char* source, const char* name) {
+    int t = FALSE;
+    for (int pc = 0; pc < length; pc += 1 + op(pc)->operand)
+        if (depth[pc] >= 0 && (code[pc] == SWAP || code[pc] == ROT || code[pc] == OVER)) t = TRUE;
+
+    fprintf(out, "// Translated from %s by vm2c\n\n", source);
+    fprintf(out, "#include \"vm2.h\"\n\n");
+    fprintf(out, "const int %s_datasize = %d;\n\n", name, datasize > 0 ? datasize : 1);
+
+    fprintf(out, "int %s_code[] = {", name);
+    for (int pc = 0; pc < length; pc++)
+        fprintf(out, "%s%d%s", pc % 12 == 0 ? "\n    " : " ", code[pc], pc < length - 1 ? "," : "");
+    fprintf(out, "\n};\n\n");
+
+    fprintf(out, "void %s(int* vars) {\n", name);
+    if (known) {
+        for (int i = 0; i < maxdepth; i++)
+            fprintf(out, "%s s%d%s", i == 0 ? "    int" : ",", i, i == maxdepth - 1 ? ";\n" : "");
+    } else {
+        fprintf(out, "    int stack[STACK_SIZE];\n");
+        fprintf(out, "    int sp = -1;\n");
+    }
+    if (t) fprintf(out, "    int t;\n");
+    fprintf(out, "\n");
+
+    for (int pc = 0; pc < length; pc += 1 + op(pc)->operand)
+        if (depth[pc] >= 0) instruction(out, pc);
+    fprintf(out, "}\n");
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "usage: vm2c program.vm2 [name] > program.c\n");
+        return 1;
+    }
+    const char* name = argc == 3 ? argv[2] : "program";
+    if (!isalpha((unsigned char) name[0]) && name[0] != '_') fail(-1, "name is not a C identifier");
+    for (const char* p = name; *p; p++)
+        if (!isalnum((unsigned char) *p) && *p != '_') fail(-1, "name is not a C identifier");
+
+    FILE* in = fopen(argv[1], "r");
+    if (in == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+    readProgram(in);
+    fclose(in);
+
+    analyse();
+    writeC(stdout, argv[1], name);
+    return 0;
+}
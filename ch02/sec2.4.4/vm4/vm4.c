@@ -1,8 +1,10 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 
 #define STACK_SIZE 100
-#define LOCALS_SIZE 10
+#define MAX_FRAMES 65536
+#define ARENA_SIZE 1024
 #define TRUE 1
 #define FALSE 0
 
@@ -24,23 +26,30 @@ typedef enum {
     SUB
 } Opcode;
 
+// A frame lives in the arena as locals[nlocals] followed by its stack.
+// Only the top frame ever pushes, so its stack simply grows into the
+// free end of the arena, and a call places the next frame right after it.
 typedef struct {
-    int stack[STACK_SIZE];
-    int locals[LOCALS_SIZE];
-    int sp;
+    int base;           // arena offset of locals[0]
+    int nlocals;
+    int sp;             // top of stack, relative to base + nlocals
     int returnValue;
     int returnAddress;
 } Frame;
 
 typedef struct FrameStack {
-    Frame* frames[STACK_SIZE];
+    Frame* frames;      // growable array of frame headers
+    int capacity;
     int fp;
+    int* arena;         // growable, frames are addressed by offset
+    int size;
 } FrameStack;
 
 typedef struct VM {
     int* code;
     int pc;
     int code_length;
+    int* nlocals;       // cached local count per function address, -1 unknown
     FrameStack fstack;
     int debug;
 } VM;
@@ -61,29 +70,120 @@ int next(VM* vm) {
     return vm->code[vm->pc++];
 }
 
+int operands(int opcode) {
+    switch (opcode) {
+        case CALL: return 2;
+        case JZ: case LD: case PUSH: case ST: return 1;
+        default: return 0;
+    }
+}
+
+// Number of locals a function uses: one more than the highest LD/ST
+// index reachable from addr before it returns. Computed once per address.
+int localCount(VM* vm, int addr) {
+    if (addr < 0 || addr >= vm->code_length) {
+        error(vm, "Call to address out of bounds");
+    }
+    if (vm->nlocals[addr] >= 0) {
+        return vm->nlocals[addr];
+    }
+
+    char* seen = (char*) calloc(vm->code_length, 1);
+    int* work = (int*) malloc(sizeof(int) * vm->code_length);
+    if (seen == NULL || work == NULL) {
+        free(seen);
+        free(work);
+        error(vm, "Out of memory");
+    }
+
+    int n = 0, nwork = 0;
+    work[nwork++] = addr;
+    while (nwork > 0) {
+        int pc = work[--nwork];
+        while (pc >= 0 && pc < vm->code_length && !seen[pc]) {
+            seen[pc] = 1;
+            int opcode = vm->code[pc];
+            int argc = operands(opcode);
+            if (pc + argc >= vm->code_length)
+                break;
+            if ((opcode == LD || opcode == ST) && vm->code[pc + 1] + 1 > n)
+                n = vm->code[pc + 1] + 1;
+            if (opcode == JZ && nwork < vm->code_length)
+                work[nwork++] = vm->code[pc + 1];
+            if (opcode == RET || opcode == HALT)
+                break;
+            pc += 1 + argc;
+        }
+    }
+
+    free(seen);
+    free(work);
+    vm->nlocals[addr] = n;
+    return n;
+}
+
 void initFrameStack(FrameStack* fstack) {
+    fstack->frames = NULL;
+    fstack->capacity = 0;
     fstack->fp = -1;
+    fstack->arena = (int*) malloc(sizeof(int) * ARENA_SIZE);
+    fstack->size = (fstack->arena != NULL) ? ARENA_SIZE : 0;
+}
+
+// first free arena offset above the top frame
+int arenaTop(FrameStack* fstack) {
+    if (fstack->fp < 0)
+        return 0;
+    Frame* top = &fstack->frames[fstack->fp];
+    return top->base + top->nlocals + top->sp + 1;
 }
 
-int pushFrame(VM* vm) {
-    if (vm->fstack.fp >= STACK_SIZE - 1) {
+void reserve(VM* vm, int need) {
+    FrameStack* fs = &vm->fstack;
+    if (need <= fs->size)
+        return;
+    int size = fs->size > 0 ? fs->size : ARENA_SIZE;
+    while (size < need)
+        size *= 2;
+    int* arena = (int*) realloc(fs->arena, sizeof(int) * size);
+    if (arena == NULL) {
+        error(vm, "Out of memory");
+    }
+    fs->arena = arena;
+    fs->size = size;
+}
+
+int pushFrame(VM* vm, int nlocals) {
+    FrameStack* fs = &vm->fstack;
+    if (fs->fp >= MAX_FRAMES - 1) {
         error(vm, "Frame stack overflow");
     }
-    Frame* frame = (Frame*) malloc(sizeof(Frame));
+    if (fs->fp + 1 >= fs->capacity) {
+        int capacity = fs->capacity > 0 ? fs->capacity * 2 : 64;
+        Frame* frames = (Frame*) realloc(fs->frames, sizeof(Frame) * capacity);
+        if (frames == NULL) {
+            error(vm, "Out of memory");
+        }
+        fs->frames = frames;
+        fs->capacity = capacity;
+    }
+
+    int base = arenaTop(fs);
+    reserve(vm, base + nlocals + STACK_SIZE);
+    Frame* frame = &fs->frames[++(fs->fp)];
+    frame->base = base;
+    frame->nlocals = nlocals;
     frame->sp = -1;
     frame->returnValue = 0;
     frame->returnAddress = 0;
-    vm->fstack.frames[++(vm->fstack.fp)] = frame;
-    return vm->fstack.fp;
+    return fs->fp;
 }
 
 int popFrame(VM* vm) {
     if (vm->fstack.fp < 0) {
         error(vm, "Frame stack underflow");
     }
-    Frame* currentFrame = vm->fstack.frames[vm->fstack.fp];
-    vm->pc = currentFrame->returnAddress;
-    free(currentFrame);
+    vm->pc = vm->fstack.frames[vm->fstack.fp].returnAddress;
     vm->fstack.fp--;
     return vm->fstack.fp + 1;
 }
@@ -94,47 +194,70 @@ Frame* getFrame(VM* vm, int frameIndex) {
         error(vm, message);
         return NULL;
     }
-    return vm->fstack.frames[frameIndex];
+    return &vm->fstack.frames[frameIndex];
+}
+
+int* frameLocals(VM* vm, Frame* frame) {
+    return vm->fstack.arena + frame->base;
+}
+
+int* frameStack(VM* vm, Frame* frame) {
+    return vm->fstack.arena + frame->base + frame->nlocals;
 }
 
 void push(VM* vm, int value) {
-    Frame* frame = vm->fstack.frames[vm->fstack.fp];
+    Frame* frame = &vm->fstack.frames[vm->fstack.fp];
     if (frame->sp >= STACK_SIZE - 1) {
         error(vm, "Stack overflow in frame");
     }
-    frame->stack[++(frame->sp)] = value;
+    frameStack(vm, frame)[++(frame->sp)] = value;
 }
 
 int pop(VM* vm) {
-    Frame* frame = vm->fstack.frames[vm->fstack.fp];
+    Frame* frame = &vm->fstack.frames[vm->fstack.fp];
     if (frame->sp < 0) {
         error(vm, "Stack underflow in frame");
     }
-    return frame->stack[(frame->sp)--];
+    return frameStack(vm, frame)[(frame->sp)--];
 }
 
 void store(VM* vm, int index) {
+    Frame* frame = &vm->fstack.frames[vm->fstack.fp];
+    if (index < 0 || index >= frame->nlocals) {
+        error(vm, "Local index out of range");
+    }
     int value = pop(vm);
-    vm->fstack.frames[vm->fstack.fp]->locals[index] = value;
+    frameLocals(vm, frame)[index] = value;
 }
 
 void load(VM* vm, int index) {
-    int value = vm->fstack.frames[vm->fstack.fp]->locals[index];
-    push(vm, value);
+    Frame* frame = &vm->fstack.frames[vm->fstack.fp];
+    if (index < 0 || index >= frame->nlocals) {
+        error(vm, "Local index out of range");
+    }
+    push(vm, frameLocals(vm, frame)[index]);
 }
 
 void transferStackToLocals(VM* vm, int num) {
-    Frame* currentFrame = vm->fstack.frames[vm->fstack.fp];
-    Frame* prevFrame = vm->fstack.frames[vm->fstack.fp - 1];
+    Frame* currentFrame = &vm->fstack.frames[vm->fstack.fp];
+    Frame* prevFrame = &vm->fstack.frames[vm->fstack.fp - 1];
+    int* locals = frameLocals(vm, currentFrame);
+    int* stack = frameStack(vm, prevFrame);
+    if (prevFrame->sp + 1 < num) {
+        error(vm, "Stack underflow in frame");
+    }
     for (int i = 0; i < num; ++i) {
-        currentFrame->locals[i] = prevFrame->stack[prevFrame->sp--];
+        locals[i] = stack[prevFrame->sp--];
     }
 }
 
 void transferStackToReturnValue(VM* vm) {
-    Frame* srcFrame = vm->fstack.frames[vm->fstack.fp];
-    Frame* destFrame = vm->fstack.frames[vm->fstack.fp - 1];
-    int value = srcFrame->stack[srcFrame->sp--];
+    Frame* srcFrame = &vm->fstack.frames[vm->fstack.fp];
+    Frame* destFrame = &vm->fstack.frames[vm->fstack.fp - 1];
+    if (srcFrame->sp < 0) {
+        error(vm, "Stack underflow in frame");
+    }
+    int value = frameStack(vm, srcFrame)[srcFrame->sp--];
     destFrame->returnValue = value;
 }
 
@@ -146,7 +269,20 @@ VM* newVM(int* code, int code_length) {
     vm->code = code;
     vm->pc = 0;
     vm->code_length = code_length;
+    vm->nlocals = (int*) malloc(sizeof(int) * (code_length > 0 ? code_length : 1));
+    if (vm->nlocals == NULL) {
+        free(vm);
+        return NULL;
+    }
+    for (int i = 0; i < code_length; i++) {
+        vm->nlocals[i] = -1;
+    }
     initFrameStack(&(vm->fstack));
+    if (vm->fstack.arena == NULL) {
+        free(vm->nlocals);
+        free(vm);
+        return NULL;
+    }
     return vm;
 }
 
@@ -154,6 +290,9 @@ void freeVM(VM* vm) {
     while (vm->fstack.fp >= 0) {
         popFrame(vm);
     }
+    free(vm->fstack.frames);
+    free(vm->fstack.arena);
+    free(vm->nlocals);
     free(vm);
 }
 
@@ -168,7 +307,8 @@ void run(VM* vm) {
             case CALL:
                 num = next(vm);
                 addr = next(vm);
-                int frm = pushFrame(vm);
+                int locals = localCount(vm, addr);
+                int frm = pushFrame(vm, (num > locals) ? num : locals);
                 fr = getFrame(vm, frm);
                 fr->returnAddress = vm->pc;
                 if (num > 0) {
@@ -181,7 +321,7 @@ void run(VM* vm) {
                 if (vm->fstack.fp > 0) {
                     transferStackToReturnValue(vm);
                 }
-                fr = vm->fstack.frames[vm->fstack.fp];
+                fr = &vm->fstack.frames[vm->fstack.fp];
                 vm->pc = fr->returnAddress;
                 popFrame(vm);
                 break;
@@ -203,7 +343,7 @@ void run(VM* vm) {
                 break;
 
             case CRET:
-                push(vm, vm->fstack.frames[vm->fstack.fp]->returnValue);
+                push(vm, vm->fstack.frames[vm->fstack.fp].returnValue);
                 break;
 
             case PRINT:
@@ -240,6 +380,269 @@ void run(VM* vm) {
     }
 }
 
+// Checks a program once, before it runs, for everything run() checks on
+// every instruction. Starting at address 0 and at every CALL target with an
+// empty stack, it follows each path and computes the stack depth of the frame
+// at every instruction. A program is accepted when:
+//   - every opcode is known, and its operands lie within the code,
+//   - no path falls off the end, and every CALL and JZ target is in bounds,
+//   - an instruction has the same depth on all paths that reach it,
+//   - no operation pops more than is on the stack, or pushes it past
+//     STACK_SIZE, and a CALL has its arguments on the caller's stack,
+//   - LD/ST indices are not negative (a frame has at least localCount()
+//     locals, and that count is taken over the very paths checked here),
+//   - RET is only reached inside a function, with a value to return.
+// What is left is the depth of calls and the growth of the arena, which
+// can't be known before running, so pushFrame() still checks those.
+// On failure the reason is in message.
+int verify(VM* vm) {
+    int n = vm->code_length;
+    int* depth = (int*) malloc(sizeof(int) * (n > 0 ? n : 1));
+    char* seen = (char*) calloc(n > 0 ? n : 1, 1);  // 1: from main, 2: from a function
+    int* work = (int*) malloc(sizeof(int) * 2 * (n > 0 ? n : 1));
+    if (depth == NULL || seen == NULL || work == NULL) {
+        free(depth);
+        free(seen);
+        free(work);
+        error(vm, "Out of memory");
+    }
+    for (int i = 0; i < n; i++) {
+        depth[i] = -1;
+    }
+
+    int ok = TRUE, nwork = 0;
+    if (n == 0) {
+        snprintf(message, sizeof(message), "Empty program");
+        ok = FALSE;
+    } else {
+        depth[0] = 0;
+        seen[0] = 1;
+        work[nwork++] = 0;
+    }
+
+    while (ok && nwork > 0) {
+        int item = work[--nwork];
+        int pc = item >> 1, inFunction = item & 1;
+        int d = depth[pc];
+        int opcode = vm->code[pc];
+        int argc = operands(opcode);
+        int need = 0, after = d, end = FALSE;
+        int to[2], nto = 0;
+
+        if (pc + argc >= n) {
+            snprintf(message, sizeof(message), "Operand past end of code at %d", pc);
+            ok = FALSE;
+            break;
+        }
+        switch (opcode) {
+            case PUSH: case CRET:
+                after = d + 1;
+                break;
+            case LD: case ST:
+                if (vm->code[pc + 1] < 0) {
+                    snprintf(message, sizeof(message), "Negative local index at %d", pc);
+                    ok = FALSE;
+                }
+                need = (opcode == ST) ? 1 : 0;
+                after = (opcode == ST) ? d - 1 : d + 1;
+                break;
+            case POP: case PRINT:
+                need = 1;
+                after = d - 1;
+                break;
+            case ADD: case SUB: case MUL:
+                need = 2;
+                after = d - 1;
+                break;
+            case JZ:
+                need = 1;
+                after = d - 1;
+                to[nto++] = vm->code[pc + 1];
+                break;
+            case CALL:
+                need = vm->code[pc + 1];
+                if (need < 0) {
+                    snprintf(message, sizeof(message), "Negative argument count at %d", pc);
+                    ok = FALSE;
+                }
+                after = d - need;
+                int addr = vm->code[pc + 2];
+                if (ok && (addr < 0 || addr >= n)) {
+                    snprintf(message, sizeof(message), "Call to address out of bounds at %d", pc);
+                    ok = FALSE;
+                } else if (ok && !(seen[addr] & 2)) {
+                    if (depth[addr] > 0) {
+                        snprintf(message, sizeof(message), "Inconsistent stack depth at %d", addr);
+                        ok = FALSE;
+                    }
+                    depth[addr] = 0;
+                    seen[addr] |= 2;
+                    work[nwork++] = addr << 1 | 1;
+                }
+                break;
+            case RET:
+                if (!inFunction) {
+                    snprintf(message, sizeof(message), "RET outside a function at %d", pc);
+                    ok = FALSE;
+                }
+                need = 1;
+                end = TRUE;
+                break;
+            case HALT:
+                end = TRUE;
+                break;
+            default:
+                snprintf(message, sizeof(message), "Unknown opcode %d at %d", opcode, pc);
+                ok = FALSE;
+                break;
+        }
+        if (!ok)
+            break;
+        if (d < need) {
+            snprintf(message, sizeof(message), "Stack underflow at %d", pc);
+            ok = FALSE;
+            break;
+        }
+        if (after > STACK_SIZE) {
+            snprintf(message, sizeof(message), "Stack overflow at %d", pc);
+            ok = FALSE;
+            break;
+        }
+        if (!end)
+            to[nto++] = pc + 1 + argc;
+
+        for (int i = 0; ok && i < nto; i++) {
+            int t = to[i];
+            if (t < 0 || t >= n) {
+                snprintf(message, sizeof(message), (t == pc + 1 + argc)
+                    ? "Falls off the end of code at %d" : "Jump target out of bounds at %d", pc);
+                ok = FALSE;
+            } else if (depth[t] >= 0 && depth[t] != after) {
+                snprintf(message, sizeof(message), "Inconsistent stack depth at %d", t);
+                ok = FALSE;
+            } else if (!(seen[t] & (1 << inFunction))) {
+                depth[t] = after;
+                seen[t] |= 1 << inFunction;
+                work[nwork++] = t << 1 | inFunction;
+            }
+        }
+    }
+
+    free(depth);
+    free(seen);
+    free(work);
+    return ok;
+}
+
+// run() without the checks, for programs verify() has accepted. The pc,
+// the top frame's locals and stack, and its stack pointer are kept in
+// locals, and written back to the frame only where a call needs them.
+void runVerified(VM* vm) {
+    int* code = vm->code;
+    int pc = vm->pc;
+    FrameStack* fs = &vm->fstack;
+    Frame* frame = &fs->frames[fs->fp];
+    int* locals = frameLocals(vm, frame);
+    int* stack = frameStack(vm, frame);
+    int sp = frame->sp;
+    int num, addr;
+
+    while (TRUE) {
+        switch (code[pc++]) {
+
+            case CALL:
+                num = code[pc++];
+                addr = code[pc++];
+                frame->sp = sp - num;   // arguments leave the caller's stack
+                int n = localCount(vm, addr);
+                pushFrame(vm, (num > n) ? num : n);
+                frame = &fs->frames[fs->fp];
+                frame->returnAddress = pc;
+                stack = frameStack(vm, &fs->frames[fs->fp - 1]);
+                locals = frameLocals(vm, frame);
+                for (int i = 0; i < num; ++i) {
+                    locals[i] = stack[sp--];
+                }
+                stack = frameStack(vm, frame);
+                sp = -1;
+                pc = addr;
+                break;
+
+            case RET:
+                pc = frame->returnAddress;
+                frame = &fs->frames[--(fs->fp)];
+                frame->returnValue = stack[sp];
+                locals = frameLocals(vm, frame);
+                stack = frameStack(vm, frame);
+                sp = frame->sp;
+                break;
+
+            case PUSH:
+                stack[++sp] = code[pc++];
+                break;
+
+            case POP:
+                sp--;
+                break;
+
+            case LD:
+                stack[++sp] = locals[code[pc++]];
+                break;
+
+            case ST:
+                locals[code[pc++]] = stack[sp--];
+                break;
+
+            case CRET:
+                stack[++sp] = frame->returnValue;
+                break;
+
+            case PRINT:
+                printf("PRINT: %d\n", stack[sp--]);
+                break;
+
+            case ADD:
+                sp--;
+                stack[sp] += stack[sp + 1];
+                break;
+
+            case SUB:
+                sp--;
+                stack[sp] -= stack[sp + 1];
+                break;
+
+            case MUL:
+                sp--;
+                stack[sp] *= stack[sp + 1];
+                break;
+
+            case JZ:
+                num = stack[sp--];
+                addr = code[pc++];
+                if (num <= 0)
+                    pc = addr;
+                break;
+
+            case HALT:
+                frame->sp = sp;
+                vm->pc = pc;
+                return;
+        }
+    }
+}
+
+// Runs a program from address 0, through runVerified() if verify()
+// accepts it and through run() otherwise.
+void execute(VM* vm) {
+    pushFrame(vm, localCount(vm, 0));
+    if (verify(vm)) {
+        runVerified(vm);
+    } else {
+        printf("Not verified: %s\n", message);
+        run(vm);
+    }
+}
+
 int main() {
 
     int code[] = {
@@ -274,9 +677,48 @@ int main() {
     int code_size = sizeof(code) / sizeof(code[0]);
 
     VM* vm = newVM(code, code_size);
+    if (vm == NULL) {
+        printf("Error: Out of memory\n");
+        return EXIT_FAILURE;
+    }
     vm->debug = 0;
-    pushFrame(vm);
-    run(vm);
+    execute(vm);
     freeVM(vm);
+
+    // The same loop through both interpreters
+    int loop[] = {
+        PUSH, 10000000,         // n = 10000000
+        ST, 0,
+        LD, 0,                  // while (n > 0)
+        JZ, 19,
+        LD, 0,                  //     n = n - 1
+        PUSH, 1,
+        SUB,
+        ST, 0,
+        PUSH, 0,
+        JZ, 4,
+        LD, 0,                  // Address 19
+        PRINT,
+        HALT
+    };
+    int loop_size = sizeof(loop) / sizeof(loop[0]);
+
+    for (int verified = FALSE; verified <= TRUE; verified++) {
+        vm = newVM(loop, loop_size);
+        if (vm == NULL) {
+            printf("Error: Out of memory\n");
+            return EXIT_FAILURE;
+        }
+        pushFrame(vm, localCount(vm, 0));
+        clock_t start = clock();
+        if (verified && verify(vm)) {
+            runVerified(vm);
+        } else {
+            run(vm);
+        }
+        printf("%s: %.3f s\n", verified ? "verified" : "checked",
+            (double)(clock() - start) / CLOCKS_PER_SEC);
+        freeVM(vm);
+    }
     return 0;
 }
@@ -2,12 +2,46 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include "../../addition/mems/memstats.h"
 
 // allocator
 
 #define MEMORY_POOL_SIZE 1024
 uint8_t memory_pool[MEMORY_POOL_SIZE];
 
+#ifdef SEGFIT
+#include "../../addition/mems/segfit.h"
+
+void memory_init() {
+    segfit_init(memory_pool, MEMORY_POOL_SIZE);
+}
+
+void* mem_malloc(size_t size) {
+    MEMSTATS_BEGIN();
+    void* ptr = segfit_malloc(size);
+    return MEMSTATS_ALLOC(ptr, size, ptr ? segfit_usable(ptr) : 0);
+}
+
+void mem_free(void* ptr) {
+    if (ptr == NULL)
+        return;
+    MEMSTATS_BEGIN();
+    segfit_free(ptr);
+    MEMSTATS_FREE(ptr);
+}
+
+void* mem_realloc(void* ptr, size_t new_size) {
+    MEMSTATS_BEGIN();
+    void* moved = segfit_realloc(ptr, new_size);
+    return MEMSTATS_REALLOC(ptr, moved, new_size, moved ? segfit_usable(moved) : 0);
+}
+
+void free_space(size_t* free_bytes, size_t* largest) {
+    *free_bytes = segfit.free_bytes;
+    *largest = segfit_largest_free();
+}
+#else
+
 typedef struct BlockHeader {
     size_t size;
     int is_free;
@@ -37,43 +71,103 @@ void merge_free_blocks() {
     }
 }
 
+// keep headers aligned
+size_t round_size(size_t size) {
+    return (size + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+}
+
+// cut block down to size, the rest becomes a free block right after it
+void split_block(BlockHeader* block, size_t size) {
+    if (block->size < size + sizeof(BlockHeader) + sizeof(size_t))
+        return;  // rest too small to be a block
+    BlockHeader* rest = (BlockHeader*)((uint8_t*)block + sizeof(BlockHeader) + size);
+    rest->size = block->size - size - sizeof(BlockHeader);
+    rest->is_free = 1;
+    rest->next = block->next;
+    block->size = size;
+    block->next = rest;
+}
+
 // allocator (malloc equivalent)
 void* mem_malloc(size_t size) {
+    MEMSTATS_BEGIN();
+    size_t rounded = round_size(size);
     BlockHeader* current = free_list;
     while (current != NULL) {
-        if (current->is_free && current->size >= size) {
+        if (current->is_free && current->size >= rounded) {
+            split_block(current, rounded);
             current->is_free = 0;
-            return (void*)((uint8_t*)current + sizeof(BlockHeader));
+            return MEMSTATS_ALLOC((void*)((uint8_t*)current + sizeof(BlockHeader)), size, current->size);
         }
         current = current->next;
     }
-    return NULL;
+    return MEMSTATS_ALLOC(NULL, size, 0);
 }
 
 void mem_free(void* ptr) {
     if (ptr == NULL)
         return;
+    MEMSTATS_BEGIN();
     BlockHeader* block = (BlockHeader*)((uint8_t*)ptr - sizeof(BlockHeader));
     block->is_free = 1;
     merge_free_blocks();
+    MEMSTATS_FREE(ptr);
 }
 
+void free_space(size_t* free_bytes, size_t* largest) {
+    *free_bytes = *largest = 0;
+    for (BlockHeader* b = (BlockHeader*)memory_pool; b != NULL; b = b->next) {
+        if (!b->is_free)
+            continue;
+        *free_bytes += b->size;
+        if (b->size > *largest)
+            *largest = b->size;
+    }
+}
+
+// what mem_realloc had to copy, and how often it could stay put
+size_t realloc_calls = 0;
+size_t realloc_moves = 0;
+size_t realloc_copied = 0;
+int realloc_in_place = 1;  // 0: always allocate and copy, for comparison
+
 // alloc memory for existing block (realloc equivalent)
 void* mem_realloc(void* ptr, size_t new_size) {
+    MEMSTATS_BEGIN();
     if (ptr == NULL)
-        return mem_malloc(new_size);
-    
+        return MEMSTATS_REALLOC(NULL, mem_malloc(new_size), new_size, new_size);
+    realloc_calls++;
+    new_size = round_size(new_size);
+
     BlockHeader* old_block = (BlockHeader*)((uint8_t*)ptr - sizeof(BlockHeader));
-    if (old_block->size >= new_size)
-        return ptr;  // if the block is already large enough
+    if (realloc_in_place) {
+        // blocks are listed in address order, so next is the neighbour
+        BlockHeader* next = old_block->next;
+        if (old_block->size < new_size && next != NULL && next->is_free
+                && old_block->size + sizeof(BlockHeader) + next->size >= new_size) {
+            old_block->size += sizeof(BlockHeader) + next->size;
+            old_block->next = next->next;
+        }
+        if (old_block->size >= new_size) {
+            split_block(old_block, new_size);  // shrink, or give back what growing took too much
+            merge_free_blocks();
+            return MEMSTATS_REALLOC(ptr, ptr, new_size, old_block->size);
+        }
+    } else if (old_block->size >= new_size) {
+        return MEMSTATS_REALLOC(ptr, ptr, new_size, old_block->size);  // if the block is already large enough
+    }
 
     void* new_ptr = mem_malloc(new_size);
     if (new_ptr != NULL) {
         memcpy(new_ptr, ptr, old_block->size);
+        realloc_moves++;
+        realloc_copied += old_block->size;
         mem_free(ptr);
     }
-    return new_ptr;
+    return MEMSTATS_REALLOC(ptr, new_ptr, new_size,
+        new_ptr ? ((BlockHeader*)((uint8_t*)new_ptr - sizeof(BlockHeader)))->size : 0);
 }
+#endif /* SEGFIT */
 
 // machine
 
@@ -121,9 +215,74 @@ int machine_load(void* addr, int offset) {
     return value;
 }
 
+#ifndef SEGFIT
+// append-heavy workload: two arrays that grow one int at a time, in turn,
+// either by one element per realloc or by doubling their capacity
+void append_benchmark(const char* name, int in_place, int geometric) {
+    memory_init();
+    realloc_calls = realloc_moves = realloc_copied = 0;
+    realloc_in_place = in_place;
+
+    int* arrays[2] = { NULL, NULL };
+    size_t capacity[2] = { 0, 0 };
+    int n = 0;
+    for (; n < 40; n++) {
+        for (int a = 0; a < 2; a++) {
+            if ((size_t)n + 1 > capacity[a]) {
+                size_t cap = geometric ? (capacity[a] ? capacity[a] * 2 : 4) : (size_t)n + 1;
+                int* grown = (int*)mem_realloc(arrays[a], cap * sizeof(int));
+                if (grown == NULL) goto full;
+                arrays[a] = grown;
+                capacity[a] = cap;
+            }
+            arrays[a][n] = n;
+        }
+    }
+full:
+    printf("  %-22s %3d ints each, %3zu reallocs, %3zu moved, %6zu bytes copied\n",
+        name, n, realloc_calls, realloc_moves, realloc_copied);
+    mem_free(arrays[0]);
+    mem_free(arrays[1]);
+    realloc_in_place = 1;
+}
+#endif
+
+#ifdef MEMSTATS
+void memory_dump() {
+    size_t free_bytes, largest;
+    free_space(&free_bytes, &largest);
+    memstats_dump("mem", free_bytes, largest);
+}
+
+int replay(const char* path) {
+    memory_init();
+    memstats_reset();
+    if (memstats_replay(path, mem_malloc, mem_free, mem_realloc) < 0) {
+        printf("Cannot read %s\n", path);
+        return 1;
+    }
+    memory_dump();
+    return 0;
+}
+#endif
+
 // sample
 
-int main() {
+int main(int argc, char* argv[]) {
+#ifdef MEMSTATS
+    if (argc > 2 && strcmp(argv[1], "replay") == 0) {
+        return replay(argv[2]);
+    }
+    if (argc > 2 && strcmp(argv[1], "trace") == 0) {
+        if (memstats_trace_file(argv[2]) < 0) {
+            printf("Cannot write %s\n", argv[2]);
+            return 1;
+        }
+    }
+#else
+    (void)argc;
+    (void)argv;
+#endif
     memory_init();
     Machine machine;
     machine_init(&machine);
@@ -160,5 +319,16 @@ int main() {
     // 8: free block
     machine_free(&machine, block);
 
+#ifdef SEGFIT
+    segfit_report();
+#else
+    printf("\nAppending to two arrays in turn:\n");
+    append_benchmark("copy always", 0, 0);
+    append_benchmark("grow in place", 1, 0);
+    append_benchmark("in place + doubling", 1, 1);
+#endif
+#ifdef MEMSTATS
+    memory_dump();
+#endif
     return 0;
 }
@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "vm3.h"
+#ifdef VM3_JIT
+#include "jit.h"
+#endif
+#ifdef VM3_PACKED
+#include "pack.h"
+#endif
+
+// Benchmark of the vm3 dispatch loop. Build with `make bench`, which links
+// this file against vm3.c five times: with the portable switch, with
+// -DVM3_THREADED, -DVM3_TOS and -DVM3_JIT, and with -DVM3_PACKED and
+// pack.c, which runs the code packed into bytes. All builds use -DVM3_STATS
+// to count instructions, which in the JIT build are only those interpreted.
+// Every sample runs twice, as assembled and after the fuse() pass.
+
+/*
+START:
+    SET 30
+    CALL :FIB
+    PRINT
+    DROP
+    HALT
+FIB:            # argument at fp-2
+    LD -2
+    SET 1
+    RSH
+    EQZ
+    JPZ :REC
+    LD -2       # fib(0) = 0, fib(1) = 1
+    RET
+REC:
+    LD -2
+    DEC
+    CALL :FIB
+    ST 1        # fib(n-1) replaces its argument
+    LD -2
+    SET 2
+    SUB
+    CALL :FIB
+    ST 2        # fib(n-2) replaces its argument
+    ADD
+    RET
+*/
+int fibonacci[] = {
+    SET, 30, CALL, 7, PRINT, DROP, HALT,
+    LD, -2, SET, 1, RSH, EQZ, JPZ, 18, LD, -2, RET,
+    LD, -2, DEC, CALL, 7, ST, 1, LD, -2, SET, 2, SUB, CALL, 7, ST, 2, ADD, RET
+};
+
+/*
+START:
+    SET 0       # sum at 0
+    SET 0       # i at 1
+LOOP:
+    LD 0
+    LD 1
+    SET 7
+    AND
+    ADD
+    ST 0        # sum = sum + (i & 7)
+    LD 1
+    INC
+    DUP
+    ST 1
+    SET -5000000
+    ADD
+    JPNZ :LOOP  # until i = 5000000
+    LD 0
+    PRINT
+    HALT
+*/
+int loop[] = {
+    SET, 0, SET, 0,
+    LD, 0, LD, 1, SET, 7, AND, ADD, ST, 0,
+    LD, 1, INC, DUP, ST, 1, SET, -5000000, ADD, JPNZ, 4,
+    LD, 0, PRINT, HALT
+};
+
+typedef struct {
+    const char* name;
+    int* code;
+    int len;
+    int start;
+} Sample;
+
+void bench(Sample* sample, int fused) {
+    int* code = (int*) malloc(sizeof(int) * sample->len);
+    if (code == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    for (int i = 0; i < sample->len; i++)
+        code[i] = sample->code[i];
+    if (fused)
+        fuse(code, sample->len, sample->start);
+
+#ifdef VM3_PACKED
+    Packed packed;
+    if (pack(code, sample->len, sample->start, &packed) < 0)
+        exit(1);
+    VM* vm = newVM(NULL, packed.start);
+    const char* dispatch = "packed";
+#else
+    VM* vm = newVM(code, sample->start);
+    const char* dispatch = VM3_DISPATCH;
+#endif
+    if (vm == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+
+    clock_t t = clock();
+#ifdef VM3_PACKED
+    run_packed(vm, packed.code);
+#else
+    run(vm);
+#endif
+    t = clock() - t;
+
+    double duration = ((double) t) / CLOCKS_PER_SEC;
+    printf("%-10s %-9s %-6s %12lu instr %9.4f s", sample->name, dispatch,
+        fused ? "fused" : "plain", vm->steps, duration);
+#ifdef VM3_JIT
+    printf("\n");
+    print_jit_stats(vm);
+#else
+    if (duration > 0.0)
+        printf(" %8.2f Minstr/s", vm->steps / duration / 1e6);
+    printf("\n");
+#endif
+#ifdef VM3_PACKED
+    printf("%-10s %d bytes packed, %d as ints\n", "", packed.len,
+        (int) (sizeof(int) * sample->len));
+    free_packed(&packed);
+#endif
+    freeVM(vm);
+    free(code);
+}
+
+int main(void) {
+    Sample samples[] = {
+        { "fibonacci", fibonacci, sizeof(fibonacci) / sizeof(int), 0 },
+        { "loop", loop, sizeof(loop) / sizeof(int), 0 }
+    };
+    int n = sizeof(samples) / sizeof(samples[0]);
+
+    for (int i = 0; i < n; i++) {
+        bench(&samples[i], FALSE);
+        bench(&samples[i], TRUE);
+    }
+    print_fusion_stats();
+
+    return 0;
+}
@@ -0,0 +1,696 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "jit.h"
+
+// JIT_THUMB on a host picks the ARMv6-M templates, whose code then only
+// a simulator standing in for JIT_CALL can run
+#if defined(JIT_THUMB) || (defined(__arm__) && defined(__thumb__))
+#undef JIT_THUMB
+#define JIT_THUMB 1
+#elif defined(__x86_64__)
+#define JIT_X64 1
+#include <sys/mman.h>
+#endif
+
+#if !defined(JIT_X64) && !defined(JIT_THUMB)
+
+// no templates for this machine: everything is interpreted
+
+Jit* jit_new(void) {
+    return NULL;
+}
+
+void jit_free(Jit* jit) {
+    (void) jit;
+}
+
+void jit_loop(VM* vm, int end) {
+    (void) vm;
+    (void) end;
+}
+
+void jit_resume(VM* vm) {
+    (void) vm;
+}
+
+void print_jit_stats(VM* vm) {
+    (void) vm;
+    printf("jit: none for this machine\n");
+}
+
+#else
+
+// Native code is called as
+//
+//     pc = native(stack, &sp, fp, entry)
+//
+// where native is the prologue at the start of the buffer, which loads
+// the registers and jumps to entry, the code of one instruction. An exit
+// writes sp back and returns the address of the instruction the
+// interpreter is to go on with; fp cannot change, as CALL and RET exit.
+typedef int (*Native)(int* stack, int* sp, int fp, const void* entry);
+
+typedef struct {
+    int start, end;             // the addresses compiled, [start, end)
+    int* entry;                 // offset in the buffer by address, -1 between
+} Loop;
+
+typedef struct {
+    int pc;                     // an address jumped back to
+    int count;                  // how often, -1 when it could not be compiled
+    Loop* loop;
+} Slot;
+
+// A jump whose offset is patched once the loop is laid out; one for an
+// exit goes to the exit for pc even when pc is inside the loop
+typedef struct {
+    int at;
+    int pc;
+    int exit;
+} Fixup;
+
+enum { ALWAYS, IF_ZERO, IF_NONZERO, IF_FULL };
+
+struct Jit {
+    unsigned char* code;
+    int used;
+    int full;                   // the buffer ran out, the loop is dropped
+    int exit;                   // offset of the shared exit
+    Slot slots[JIT_SLOTS];
+    Loop loops[JIT_LOOPS];
+    int nloops;
+    Fixup* fixups;              // while compiling
+    int nfixups;
+    unsigned long entries;
+};
+
+// as arity() in vm3.c, plus the opcode
+static int length(int opcode) {
+    switch (opcode) {
+        case CALL: case JP: case JPNZ: case JPZ:
+        case LD: case LOAD: case SET: case ST: case STORE:
+            return 2;
+        case LD_INC: case SET_ADD: case DUP_JPZ: case EQZ_JPNZ:
+            return 3;
+        default:
+            return 1;
+    }
+}
+
+static void emit8(Jit* jit, int b) {
+    if (jit->used >= JIT_CODE_SIZE) {
+        jit->full = TRUE;
+        return;
+    }
+    jit->code[jit->used++] = (unsigned char) b;
+}
+
+static void emit16(Jit* jit, int h) {
+    emit8(jit, h & 0xff);
+    emit8(jit, (h >> 8) & 0xff);
+}
+
+static void emit32(Jit* jit, int w) {
+    emit16(jit, w & 0xffff);
+    emit16(jit, ((unsigned) w >> 16) & 0xffff);
+}
+
+static void put16(Jit* jit, int at, int h) {
+    if (at + 2 > jit->used)
+        return;
+    jit->code[at] = (unsigned char) (h & 0xff);
+    jit->code[at + 1] = (unsigned char) ((h >> 8) & 0xff);
+}
+
+static void fixup(Jit* jit, int at, int pc, int exit) {
+    Fixup* f = &jit->fixups[jit->nfixups++];
+    f->at = at;
+    f->pc = pc;
+    f->exit = exit;
+}
+
+// Operands the templates take as they are; others are left to the
+// interpreter, whose business a wild address is
+static int local_ok(int x) {
+    return x >= -STACK_SIZE && x <= STACK_SIZE;
+}
+
+static int global_ok(int a) {
+    return a >= 0 && a < STACK_SIZE;
+}
+
+#if defined(JIT_X64)
+
+// x86-64, System V: rdi = stack, rsi = sp (an index), r9 = fp, r8 = &sp;
+// the top of the stack is [rdi + rsi*4], eax, ecx and edx are scratch
+
+static void emit(Jit* jit, const unsigned char* bytes, int n) {
+    for (int i = 0; i < n; i++)
+        emit8(jit, bytes[i]);
+}
+
+static void put32(Jit* jit, int at, int w) {
+    put16(jit, at, w & 0xffff);
+    put16(jit, at + 2, ((unsigned) w >> 16) & 0xffff);
+}
+
+#define T(...) do { \
+    static const unsigned char t[] = { __VA_ARGS__ }; \
+    emit(jit, t, sizeof(t)); \
+} while (0)
+
+#define TOP 0x04, 0xb7                      // modrm and sib of [rdi + rsi*4]
+#define INC_SP 0x48, 0xff, 0xc6             // inc rsi
+#define DEC_SP 0x48, 0xff, 0xce             // dec rsi
+#define LOAD_TOP 0x8b, TOP                  // mov eax, [top]
+#define STORE_TOP 0x89, TOP                 // mov [top], eax
+
+static void native_start(Jit* jit) {
+    T(0x49, 0x89, 0xf0,                     // mov r8, rsi
+      0x49, 0x63, 0x30,                     // movsxd rsi, [r8]
+      0x4c, 0x63, 0xca,                     // movsxd r9, edx
+      0xff, 0xe1);                          // jmp rcx
+    jit->exit = jit->used;
+    T(0x41, 0x89, 0x30,                     // mov [r8], esi
+      0xc3);                                // ret
+}
+
+static void native_jump(Jit* jit, int cond, int pc, int exit) {
+    switch (cond) {
+        case ALWAYS:     T(0xe9); break;                // jmp
+        case IF_ZERO:    T(0x0f, 0x84); break;          // jz
+        case IF_NONZERO: T(0x0f, 0x85); break;          // jnz
+        case IF_FULL:    T(0x0f, 0x8d); break;          // jge
+    }
+    fixup(jit, jit->used, pc, exit);
+    emit32(jit, 0);
+}
+
+static void native_patch(Jit* jit, Fixup* f, int target) {
+    put32(jit, f->at, target - (f->at + 4));
+}
+
+static void native_exit(Jit* jit, int pc) {
+    T(0xb8);                                // mov eax, pc
+    emit32(jit, pc);
+    T(0xe9);                                // jmp exit
+    emit32(jit, jit->exit - (jit->used + 4));
+}
+
+// a push that would overflow leaves the push to the interpreter
+static void check(Jit* jit, int pc) {
+    T(0x48, 0x81, 0xfe);                    // cmp rsi, STACK_SIZE - 1
+    emit32(jit, STACK_SIZE - 1);
+    native_jump(jit, IF_FULL, pc, TRUE);
+}
+
+static int native_instruction(Jit* jit, int* code, int pc) {
+    int v = length(code[pc]) > 1 ? code[pc + 1] : 0;
+
+    switch (code[pc]) {
+        case SET:
+            check(jit, pc);
+            T(INC_SP, 0xc7, TOP);           // mov dword [top], v
+            emit32(jit, v);
+            return TRUE;
+        case SETZ:
+            check(jit, pc);
+            T(INC_SP, 0xc7, TOP, 0, 0, 0, 0);
+            return TRUE;
+        case ADD:  T(LOAD_TOP, DEC_SP, 0x01, TOP); return TRUE;     // add [top], eax
+        case SUB:  T(LOAD_TOP, DEC_SP, 0x29, TOP); return TRUE;     // sub [top], eax
+        case AND:  T(LOAD_TOP, DEC_SP, 0x21, TOP); return TRUE;     // and [top], eax
+        case OR:   T(LOAD_TOP, DEC_SP, 0x09, TOP); return TRUE;     // or [top], eax
+        case MUL:
+            T(0x8b, 0x44, 0xb7, 0xfc,       // mov eax, [top - 4]
+              0x0f, 0xaf, TOP,              // imul eax, [top]
+              DEC_SP, STORE_TOP);
+            return TRUE;
+        case MOD:
+            T(0x8b, 0x0c, 0xb7,             // mov ecx, [top]
+              0x8b, 0x44, 0xb7, 0xfc,       // mov eax, [top - 4]
+              0x99,                         // cdq
+              0xf7, 0xf9,                   // idiv ecx
+              DEC_SP, 0x89, 0x14, 0xb7);    // mov [top], edx
+            return TRUE;
+        case LSH:  T(0x8b, 0x0c, 0xb7, DEC_SP, 0xd3, 0x24, 0xb7); return TRUE;  // shl [top], cl
+        case RSH:  T(0x8b, 0x0c, 0xb7, DEC_SP, 0xd3, 0x3c, 0xb7); return TRUE;  // sar [top], cl
+        case INC:  T(0xff, TOP); return TRUE;                       // inc dword [top]
+        case DEC:  T(0xff, 0x0c, 0xb7); return TRUE;                // dec dword [top]
+        case EQ:
+            T(LOAD_TOP, DEC_SP, 0x39, TOP,  // cmp [top], eax
+              0x0f, 0x94, 0xc0,             // sete al
+              0x0f, 0xb6, 0xc0,             // movzx eax, al
+              STORE_TOP);
+            return TRUE;
+        case EQZ:
+            T(0x83, 0x3c, 0xb7, 0x00,       // cmp dword [top], 0
+              0x0f, 0x94, 0xc0, 0x0f, 0xb6, 0xc0, STORE_TOP);
+            return TRUE;
+        case DUP:
+            check(jit, pc);
+            T(LOAD_TOP, INC_SP, STORE_TOP);
+            return TRUE;
+        case DROP: T(DEC_SP); return TRUE;
+        case LD:
+        case LD_INC:
+            if (!local_ok(v))
+                return FALSE;
+            check(jit, pc);
+            T(0x42, 0x8b, 0x84, 0x8f);      // mov eax, [rdi + r9*4 + 4v]
+            emit32(jit, 4 * v);
+            if (code[pc] == LD_INC)
+                T(0xff, 0xc0);              // inc eax
+            T(INC_SP, STORE_TOP);
+            return TRUE;
+        case ST:
+            if (!local_ok(v))
+                return FALSE;
+            T(LOAD_TOP, DEC_SP, 0x42, 0x89, 0x84, 0x8f);    // mov [rdi + r9*4 + 4v], eax
+            emit32(jit, 4 * v);
+            return TRUE;
+        case LOAD:
+            if (!global_ok(v))
+                return FALSE;
+            check(jit, pc);
+            T(0x8b, 0x87);                  // mov eax, [rdi + 4v]
+            emit32(jit, 4 * v);
+            T(INC_SP, STORE_TOP);
+            return TRUE;
+        case STORE:
+            if (!global_ok(v))
+                return FALSE;
+            T(LOAD_TOP, DEC_SP, 0x89, 0x87);                // mov [rdi + 4v], eax
+            emit32(jit, 4 * v);
+            return TRUE;
+        case SET_ADD:
+            T(0x81, TOP);                   // add dword [top], v
+            emit32(jit, v);
+            return TRUE;
+        case JP:
+            native_jump(jit, ALWAYS, v, FALSE);
+            return TRUE;
+        case JPZ:
+        case JPNZ:
+            T(LOAD_TOP, DEC_SP, 0x85, 0xc0);                // test eax, eax
+            native_jump(jit, code[pc] == JPZ ? IF_ZERO : IF_NONZERO, v, FALSE);
+            return TRUE;
+        case DUP_JPZ:
+            T(0x83, 0x3c, 0xb7, 0x00);      // cmp dword [top], 0
+            native_jump(jit, IF_ZERO, v, FALSE);
+            return TRUE;
+        case EQZ_JPNZ:
+            T(LOAD_TOP, DEC_SP, 0x85, 0xc0);
+            native_jump(jit, IF_ZERO, v, FALSE);
+            return TRUE;
+        default:
+            return FALSE;
+    }
+}
+
+static void writable(Jit* jit, int on) {
+    mprotect(jit->code, JIT_CODE_SIZE, on ? PROT_READ | PROT_WRITE : PROT_READ | PROT_EXEC);
+}
+
+static int native_call(Jit* jit, int* stack, int* sp, int fp, int offset) {
+    return ((Native) (void*) jit->code)(stack, sp, fp, jit->code + offset);
+}
+
+#elif defined(JIT_THUMB)
+
+// ARMv6-M, Thumb: r0 = stack, r1 = &stack[sp], r2 = &stack[fp],
+// r4 = &sp, r7 = &stack[STACK_SIZE - 1]; r3 and r5 are scratch. No
+// divide instruction, so MOD exits
+
+#define LDR_R3_TOP 0x680b                   // ldr r3, [r1]
+#define LDR_R5_TOP 0x680d                   // ldr r5, [r1]
+#define STR_R3_TOP 0x600b                   // str r3, [r1]
+#define STR_R5_TOP 0x600d                   // str r5, [r1]
+#define UP 0x3104                           // adds r1, #4
+#define DOWN 0x3904                         // subs r1, #4
+
+#define H(...) do { \
+    static const unsigned short h[] = { __VA_ARGS__ }; \
+    for (unsigned i = 0; i < sizeof(h) / sizeof(h[0]); i++) \
+        emit16(jit, h[i]); \
+} while (0)
+
+// reg = value, from a literal placed in the code past a branch when it
+// takes more than a movs
+static void load_constant(Jit* jit, int reg, int value) {
+    if (value >= 0 && value <= 255) {
+        emit16(jit, 0x2000 | reg << 8 | value);                 // movs reg, #value
+    } else if (value < 0 && value >= -255) {
+        emit16(jit, 0x2000 | reg << 8 | -value);
+        emit16(jit, 0x4240 | reg << 3 | reg);                   // rsbs reg, reg, #0
+    } else {
+        int at = jit->used;
+        int word = (at + 4 + 3) & ~3;
+        emit16(jit, 0x4800 | reg << 8 | (word - ((at + 4) & ~3)) / 4);    // ldr reg, [pc, #...]
+        emit16(jit, 0xe000 | (((word + 4) - (at + 2 + 4)) / 2));    // b past the word
+        if (word != at + 4)
+            emit16(jit, 0xbf00);                                // nop
+        emit32(jit, value);
+    }
+}
+
+static void put_bl(Jit* jit, int at, int target) {
+    int offset = target - (at + 4);
+    int s = offset < 0;
+    int i1 = (offset >> 23) & 1, i2 = (offset >> 22) & 1;
+    int j1 = !i1 ^ s, j2 = !i2 ^ s;
+    put16(jit, at, 0xf000 | s << 10 | ((offset >> 12) & 0x3ff));
+    put16(jit, at + 2, 0xd000 | j1 << 13 | j2 << 11 | ((offset >> 1) & 0x7ff));
+}
+
+static void native_start(Jit* jit) {
+    H(0xb5f0,                               // push {r4-r7, lr}
+      0x460c,                               // mov r4, r1
+      0x6809,                               // ldr r1, [r1]
+      0x0089,                               // lsls r1, r1, #2
+      0x1841,                               // adds r1, r0, r1
+      0x0092,                               // lsls r2, r2, #2
+      0x1882);                              // adds r2, r0, r2
+    load_constant(jit, 7, 4 * (STACK_SIZE - 1));
+    H(0x19c7,                               // adds r7, r0, r7
+      0x4718);                              // bx r3
+    jit->exit = jit->used;
+    H(0x1a09,                               // subs r1, r1, r0
+      0x1089,                               // asrs r1, r1, #2
+      0x6021,                               // str r1, [r4]
+      0x0018,                               // movs r0, r3
+      0xbdf0);                              // pop {r4-r7, pc}
+}
+
+// A conditional branch reaches 256 bytes, so it goes round a bl, which
+// reaches anywhere; lr is on the stack already
+static void native_jump(Jit* jit, int cond, int pc, int exit) {
+    switch (cond) {
+        case IF_ZERO:    emit16(jit, 0xd101); break;    // bne past the bl
+        case IF_NONZERO: emit16(jit, 0xd001); break;    // beq
+        case IF_FULL:    emit16(jit, 0xd301); break;    // bcc
+    }
+    fixup(jit, jit->used, pc, exit);
+    emit32(jit, 0);
+}
+
+static void native_patch(Jit* jit, Fixup* f, int target) {
+    put_bl(jit, f->at, target);
+}
+
+static void native_exit(Jit* jit, int pc) {
+    load_constant(jit, 3, pc);
+    int at = jit->used;
+    emit32(jit, 0);
+    put_bl(jit, at, jit->exit);
+}
+
+static void check(Jit* jit, int pc) {
+    emit16(jit, 0x42b9);                    // cmp r1, r7
+    native_jump(jit, IF_FULL, pc, TRUE);
+}
+
+static void binary(Jit* jit, int op) {
+    H(LDR_R3_TOP, DOWN, LDR_R5_TOP);
+    emit16(jit, op);
+    emit16(jit, STR_R5_TOP);
+}
+
+static int native_instruction(Jit* jit, int* code, int pc) {
+    int v = length(code[pc]) > 1 ? code[pc + 1] : 0;
+
+    switch (code[pc]) {
+        case SET:
+        case SETZ:
+            check(jit, pc);
+            load_constant(jit, 3, code[pc] == SET ? v : 0);
+            H(UP, STR_R3_TOP);
+            return TRUE;
+        case ADD:  binary(jit, 0x18ed); return TRUE;    // adds r5, r5, r3
+        case SUB:  binary(jit, 0x1aed); return TRUE;    // subs r5, r5, r3
+        case MUL:  binary(jit, 0x435d); return TRUE;    // muls r5, r3, r5
+        case AND:  binary(jit, 0x401d); return TRUE;    // ands r5, r3
+        case OR:   binary(jit, 0x431d); return TRUE;    // orrs r5, r3
+        case LSH:  binary(jit, 0x409d); return TRUE;    // lsls r5, r3
+        case RSH:  binary(jit, 0x411d); return TRUE;    // asrs r5, r3
+        case INC:  H(LDR_R3_TOP, 0x3301, STR_R3_TOP); return TRUE;     // adds r3, #1
+        case DEC:  H(LDR_R3_TOP, 0x3b01, STR_R3_TOP); return TRUE;     // subs r3, #1
+        case EQ:
+            H(LDR_R3_TOP, DOWN, LDR_R5_TOP,
+              0x1aed,                       // subs r5, r5, r3
+              0x426b,                       // rsbs r3, r5, #0, carry when r5 is 0
+              0x416b,                       // adcs r3, r5, so r3 = carry
+              STR_R3_TOP);
+            return TRUE;
+        case EQZ:
+            H(LDR_R5_TOP, 0x426b, 0x416b, STR_R3_TOP);
+            return TRUE;
+        case DUP:
+            check(jit, pc);
+            H(LDR_R3_TOP, UP, STR_R3_TOP);
+            return TRUE;
+        case DROP: H(DOWN); return TRUE;
+        case LD:
+        case LD_INC:
+            if (!local_ok(v))
+                return FALSE;
+            check(jit, pc);
+            load_constant(jit, 5, 4 * v);
+            H(0x5953);                      // ldr r3, [r2, r5]
+            if (code[pc] == LD_INC)
+                H(0x3301);
+            H(UP, STR_R3_TOP);
+            return TRUE;
+        case ST:
+            if (!local_ok(v))
+                return FALSE;
+            H(LDR_R3_TOP, DOWN);
+            load_constant(jit, 5, 4 * v);
+            H(0x5153);                      // str r3, [r2, r5]
+            return TRUE;
+        case LOAD:
+            if (!global_ok(v))
+                return FALSE;
+            check(jit, pc);
+            load_constant(jit, 5, 4 * v);
+            H(0x5943, UP, STR_R3_TOP);      // ldr r3, [r0, r5]
+            return TRUE;
+        case STORE:
+            if (!global_ok(v))
+                return FALSE;
+            H(LDR_R3_TOP, DOWN);
+            load_constant(jit, 5, 4 * v);
+            H(0x5143);                      // str r3, [r0, r5]
+            return TRUE;
+        case SET_ADD:
+            load_constant(jit, 5, v);
+            H(LDR_R3_TOP, 0x195b, STR_R3_TOP);     // adds r3, r3, r5
+            return TRUE;
+        case JP:
+            native_jump(jit, ALWAYS, v, FALSE);
+            return TRUE;
+        case JPZ:
+        case JPNZ:
+            H(LDR_R3_TOP, DOWN, 0x2b00);    // cmp r3, #0
+            native_jump(jit, code[pc] == JPZ ? IF_ZERO : IF_NONZERO, v, FALSE);
+            return TRUE;
+        case DUP_JPZ:
+            H(LDR_R3_TOP, 0x2b00);
+            native_jump(jit, IF_ZERO, v, FALSE);
+            return TRUE;
+        case EQZ_JPNZ:
+            H(LDR_R3_TOP, DOWN, 0x2b00);
+            native_jump(jit, IF_ZERO, v, FALSE);
+            return TRUE;
+        default:
+            return FALSE;
+    }
+}
+
+static void writable(Jit* jit, int on) {
+    (void) jit;
+#if defined(__arm__)
+    if (!on)
+        __asm__ volatile ("dsb\n\tisb" ::: "memory");
+#else
+    (void) on;
+#endif
+}
+
+static int native_call(Jit* jit, int* stack, int* sp, int fp, int offset) {
+    Native native = (Native) (void*) ((uintptr_t) jit->code | 1);
+    return native(stack, sp, fp, (const void*) ((uintptr_t) (jit->code + offset) | 1));
+}
+
+#endif
+
+#ifndef JIT_CALL
+#define JIT_CALL native_call
+#endif
+
+Jit* jit_new(void) {
+    Jit* jit = (Jit*) calloc(1, sizeof(Jit));
+    if (jit == NULL)
+        return NULL;
+#if defined(JIT_X64)
+    void* code = mmap(NULL, JIT_CODE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    jit->code = (code == MAP_FAILED) ? NULL : (unsigned char*) code;
+#else
+    jit->code = (unsigned char*) malloc(JIT_CODE_SIZE);
+#endif
+    if (jit->code == NULL) {
+        free(jit);
+        return NULL;
+    }
+    native_start(jit);
+    writable(jit, FALSE);
+    return jit;
+}
+
+void jit_free(Jit* jit) {
+    if (jit == NULL)
+        return;
+    for (int i = 0; i < jit->nloops; i++)
+        free(jit->loops[i].entry);
+#if defined(JIT_X64)
+    munmap(jit->code, JIT_CODE_SIZE);
+#else
+    free(jit->code);
+#endif
+    free(jit);
+}
+
+// The exit for pc, once per loop; stubs[] holds pc and offset pairs
+static int stub(Jit* jit, int* stubs, int* nstubs, int pc) {
+    for (int i = 0; i < *nstubs; i++)
+        if (stubs[2 * i] == pc)
+            return stubs[2 * i + 1];
+    stubs[2 * *nstubs] = pc;
+    stubs[2 * *nstubs + 1] = jit->used;
+    (*nstubs)++;
+    native_exit(jit, pc);
+    return stubs[2 * *nstubs - 1];
+}
+
+// The instructions from start up to the one ending at or after end
+static Loop* compile(Jit* jit, int* code, int start, int end) {
+    if (jit->nloops == JIT_LOOPS)
+        return NULL;
+
+    int size = end - start + 2;             // the last may overhang by 2
+    int* entry = (int*) malloc(sizeof(int) * size);
+    jit->fixups = (Fixup*) malloc(sizeof(Fixup) * size);
+    int* stubs = (int*) malloc(sizeof(int) * 2 * (size + 1));
+    if (entry == NULL || jit->fixups == NULL || stubs == NULL) {
+        free(entry);
+        free(jit->fixups);
+        free(stubs);
+        return NULL;
+    }
+    for (int i = 0; i < size; i++)
+        entry[i] = -1;
+
+    writable(jit, TRUE);
+    int used = jit->used;
+    jit->full = FALSE;
+    jit->nfixups = 0;
+
+    int pc = start;
+    while (pc < end) {
+        entry[pc - start] = jit->used;
+        if (!native_instruction(jit, code, pc))
+            native_exit(jit, pc);
+        pc += length(code[pc]);
+    }
+    native_exit(jit, pc);                   // falling out of the loop
+    end = pc;
+
+    int nstubs = 0;
+    for (int i = 0; i < jit->nfixups; i++) {
+        Fixup* f = &jit->fixups[i];
+        int target;
+        if (!f->exit && f->pc >= start && f->pc < end && entry[f->pc - start] >= 0)
+            target = entry[f->pc - start];
+        else
+            target = stub(jit, stubs, &nstubs, f->pc);
+        native_patch(jit, f, target);
+    }
+
+    free(jit->fixups);
+    free(stubs);
+    jit->fixups = NULL;
+    if (jit->full) {
+        jit->used = used;
+        writable(jit, FALSE);
+        free(entry);
+        return NULL;
+    }
+    writable(jit, FALSE);
+
+    Loop* loop = &jit->loops[jit->nloops++];
+    loop->start = start;
+    loop->end = end;
+    loop->entry = entry;
+    return loop;
+}
+
+static void enter(Jit* jit, VM* vm, int offset) {
+    jit->entries++;
+    vm->pc = JIT_CALL(jit, vm->stack, &vm->sp, vm->fp, offset);
+}
+
+void jit_loop(VM* vm, int end) {
+    Jit* jit = vm->jit;
+    if (jit == NULL)
+        return;
+
+    int start = vm->pc;
+    Slot* slot = &jit->slots[(unsigned) start % JIT_SLOTS];
+    if (slot->pc != start) {
+        slot->pc = start;
+        slot->count = 0;
+        slot->loop = NULL;
+        for (int i = 0; i < jit->nloops; i++)
+            if (jit->loops[i].start == start)
+                slot->loop = &jit->loops[i];
+    }
+    if (slot->loop == NULL) {
+        if (slot->count < 0 || ++slot->count < JIT_HOT)
+            return;
+        slot->loop = compile(jit, vm->code, start, end);
+        if (slot->loop == NULL) {
+            slot->count = -1;
+            return;
+        }
+    }
+    enter(jit, vm, slot->loop->entry[0]);
+}
+
+void jit_resume(VM* vm) {
+    Jit* jit = vm->jit;
+    if (jit == NULL)
+        return;
+
+    int pc = vm->pc;
+    for (int i = 0; i < jit->nloops; i++) {
+        Loop* loop = &jit->loops[i];
+        if (pc >= loop->start && pc < loop->end && loop->entry[pc - loop->start] >= 0) {
+            enter(jit, vm, loop->entry[pc - loop->start]);
+            return;
+        }
+    }
+}
+
+void print_jit_stats(VM* vm) {
+    Jit* jit = vm->jit;
+    if (jit == NULL) {
+        printf("jit: none for this machine\n");
+        return;
+    }
+    printf("jit: %d loops, %d bytes of code, %lu entries\n",
+        jit->nloops, jit->used, jit->entries);
+}
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef JIT_H
+#define JIT_H
+
+#include "vm3.h"
+
+// A template JIT for the hot loops of vm3, built with -DVM3_JIT.
+//
+// run() (the switch) counts the jumps back to each address. When one
+// address has been jumped back to JIT_HOT times, the code from there to
+// the jump is compiled: each instruction is a template of machine code,
+// copied into an executable buffer with its operands and jump offsets
+// patched in. Jumps inside the loop stay in native code; CALL, RET,
+// PRINT, PRNT, HALT and anything not known leave it, at that
+// instruction, for the interpreter to carry out. A print or a return
+// that lands back inside a compiled loop goes on in native code.
+//
+// Templates exist for x86-64 (the buffer is mmap'ed) and for ARMv6-M,
+// the Pico's Cortex-M0+ (the buffer is in RAM, which runs code). On
+// anything else everything is interpreted.
+
+#ifndef JIT_HOT
+#define JIT_HOT 64              // jumps back before a loop is compiled
+#endif
+
+#ifndef JIT_CODE_SIZE
+#if defined(__arm__)
+#define JIT_CODE_SIZE (8 * 1024)
+#else
+#define JIT_CODE_SIZE (256 * 1024)
+#endif
+#endif
+
+#define JIT_SLOTS 64            // jump counters, by address
+#define JIT_LOOPS 32            // compiled loops
+
+typedef struct Jit Jit;
+
+Jit* jit_new(void);
+void jit_free(Jit* jit);
+
+// After a jump back to vm->pc from `end`, the end of the jump: counts,
+// compiles, and runs native code if there is any. On return the VM is
+// at the instruction native code stopped at
+void jit_loop(VM* vm, int end);
+
+// After an instruction that native code left for: goes back in if
+// vm->pc is inside a compiled loop
+void jit_resume(VM* vm);
+
+void print_jit_stats(VM* vm);
+
+#endif // JIT_H
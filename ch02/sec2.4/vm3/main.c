@@ -4,6 +4,7 @@
 #include <time.h>
 
 #include "vm3.h"
+#include "pack.h"
 
 //int DATA = 8192;
 int MAXPROGLEN = 32768;
@@ -38,6 +39,19 @@ void exec(int* code, int start) {
 	}
 }
 
+void exec_packed(int* code, int len, int start) {
+	Packed packed;
+	if (pack(code, len, start, &packed) < 0)
+		return;
+	printf("packed %d bytes, %d as ints\n", packed.len, (int) (len * sizeof(int)));
+	VM* vm = newVM(NULL, packed.start);
+	if (vm != NULL) {
+		run_packed(vm, packed.code);
+		freeVM(vm);
+	}
+	free_packed(&packed);
+}
+
 int main(int argc, char *argv[]) {
 	printf("loading ..\n");
 
@@ -73,15 +87,32 @@ int main(int argc, char *argv[]) {
 	while (j < i);
 	printf("code length = %d \n", i);
 
+	// optional superinstruction pass: ./main file.b -f,
+	// and packed code: ./main file.b -p (or both)
+	int fused = FALSE, packed = FALSE;
+	for (int k = 2; k < argc; k++) {
+		if (strcmp(argv[k], "-f") == 0)
+			fused = TRUE;
+		else if (strcmp(argv[k], "-p") == 0)
+			packed = TRUE;
+	}
+	if (fused)
+		fuse(program, i, start);
+
 	printf("running ..\n");
 	printf("- - - - - - - - - - - -\n");
 	clock_t t;
 	t = clock();
-	exec(program, start);
+	if (packed)
+		exec_packed(program, i, start);
+	else
+		exec(program, start);
 	t = clock() - t;
 	printf("- - - - - - - - - - - -\n");
 	double duration = ((double) t) / CLOCKS_PER_SEC;
 	printf("duration %f seconds\n", duration);
+	if (fused)
+		print_fusion_stats();
 	printf("done running.\n");
 
 	return 0;
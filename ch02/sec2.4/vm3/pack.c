@@ -0,0 +1,255 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "pack.h"
+
+#ifdef VM3_STATS
+#define STEP(vm) ((vm)->steps++)
+#else
+#define STEP(vm) ((void) 0)
+#endif
+
+// as arity() in vm3.c, plus the opcode
+static int slots(int opcode) {
+    switch (opcode) {
+        case CALL: case JP: case JPNZ: case JPZ:
+        case LD: case LOAD: case SET: case ST: case STORE:
+            return 2;
+        case LD_INC: case SET_ADD: case DUP_JPZ: case EQZ_JPNZ:
+            return 3;
+        default:
+            return 1;
+    }
+}
+
+static int is_jump(int opcode) {
+    return opcode == CALL || opcode == JP || opcode == JPNZ || opcode == JPZ
+        || opcode == DUP_JPZ || opcode == EQZ_JPNZ;
+}
+
+static int width_of(int v) {
+    if (v >= -128 && v <= 127)
+        return PACK_W8;
+    if (v >= -32768 && v <= 32767)
+        return PACK_W16;
+    return PACK_W32;
+}
+
+// The width of a plain operand is known from its value, but that of a
+// jump depends on the offset of its target, which depends on the widths
+// before it. Jumps start at one byte and are widened until nothing
+// changes; a width never shrinks, so this ends.
+int pack(int* code, int len, int start, Packed* packed) {
+    int* offset = (int*) malloc(sizeof(int) * (len + 1));
+    char* width = (char*) calloc(len + 1, 1);
+    if (offset == NULL || width == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+
+    for (int a = 0; a < len; a += slots(code[a])) {
+        int opcode = code[a];
+        if (opcode < ADD || opcode >= NUM_OPCODES || a + slots(opcode) > len) {
+            fprintf(stderr, "Cannot pack opcode %d at %d\n", opcode, a);
+            goto fail;
+        }
+        if (slots(opcode) > 1 && !is_jump(opcode))
+            width[a] = width_of(code[a + 1]);
+    }
+
+    int size, changed;
+    do {
+        for (int a = 0; a <= len; a++)
+            offset[a] = -1;
+        size = 0;
+        for (int a = 0; a < len; a += slots(code[a])) {
+            offset[a] = size;
+            size += 1 + ((slots(code[a]) > 1) ? 1 << width[a] : 0);
+        }
+
+        changed = FALSE;
+        for (int a = 0; a < len; a += slots(code[a])) {
+            if (!is_jump(code[a]))
+                continue;
+            int target = code[a + 1];
+            if (target < 0 || target >= len || offset[target] < 0) {
+                fprintf(stderr, "Jump to %d at %d is not to an instruction\n", target, a);
+                goto fail;
+            }
+            int w = width_of(offset[target]);
+            if (w > width[a]) {
+                width[a] = w;
+                changed = TRUE;
+            }
+        }
+    } while (changed);
+
+    if (start < 0 || start >= len || offset[start] < 0) {
+        fprintf(stderr, "Start %d is not an instruction\n", start);
+        goto fail;
+    }
+
+    unsigned char* bytes = (unsigned char*) malloc(size > 0 ? size : 1);
+    if (bytes == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    int at = 0;
+    for (int a = 0; a < len; a += slots(code[a])) {
+        int opcode = code[a];
+        bytes[at++] = (unsigned char) (opcode | width[a] << 6);
+        if (slots(opcode) == 1)
+            continue;
+        uint32_t v = (uint32_t) (is_jump(opcode) ? offset[code[a + 1]] : code[a + 1]);
+        for (int i = 0; i < 1 << width[a]; i++)
+            bytes[at++] = (unsigned char) (v >> (8 * i));
+    }
+
+    packed->code = bytes;
+    packed->len = size;
+    packed->start = offset[start];
+    free(offset);
+    free(width);
+    return 0;
+
+fail:
+    free(offset);
+    free(width);
+    return -1;
+}
+
+void free_packed(Packed* packed) {
+    free(packed->code);
+    packed->code = NULL;
+    packed->len = 0;
+}
+
+static inline int operand(const unsigned char* code, int* pc, int width) {
+    const unsigned char* p = code + *pc;
+    *pc += 1 << width;
+    switch (width) {
+        case PACK_W8:
+            return (signed char) p[0];
+        case PACK_W16:
+            return (int16_t) (p[0] | p[1] << 8);
+        default:
+            return (int32_t) ((uint32_t) p[0] | (uint32_t) p[1] << 8
+                | (uint32_t) p[2] << 16 | (uint32_t) p[3] << 24);
+    }
+}
+
+void run_packed(VM* vm, const unsigned char* code) {
+    int* stack = vm->stack;
+    int pc = vm->pc;
+    int sp = vm->sp;
+    int fp = vm->fp;
+    int a, b, v, w, addr, rval;
+
+    #define PUSH(x) do { \
+        if (sp + 1 >= STACK_SIZE) { \
+            fprintf(stderr, "Stack overflow\n"); \
+            exit(1); \
+        } \
+        stack[++sp] = (x); \
+    } while (0)
+    #define POP() (stack[sp--])
+    #define OPERAND() operand(code, &pc, w)
+
+    do {
+        int byte = code[pc++];
+        int opcode = PACK_OPCODE(byte);
+        w = PACK_WIDTH(byte);
+        STEP(vm);
+
+        switch (opcode) {
+            case HALT:
+                vm->halted = TRUE;
+                vm->pc = pc;
+                vm->sp = sp;
+                vm->fp = fp;
+                return;
+
+            case SET:     v = OPERAND(); PUSH(v); break;
+            case SETZ:    PUSH(0); break;
+            case ADD:     b = POP(); a = POP(); PUSH(a + b); break;
+            case SUB:     b = POP(); a = POP(); PUSH(a - b); break;
+            case MUL:     b = POP(); a = POP(); PUSH(a * b); break;
+            case MOD:     b = POP(); a = POP(); PUSH(a % b); break;
+            case INC:     a = POP(); PUSH(a + 1); break;
+            case DEC:     a = POP(); PUSH(a - 1); break;
+            case AND:     b = POP(); a = POP(); PUSH(a & b); break;
+            case OR:      b = POP(); a = POP(); PUSH(a | b); break;
+            case LSH:     b = POP(); a = POP(); PUSH(a << b); break;
+            case RSH:     b = POP(); a = POP(); PUSH(a >> b); break;
+            case EQ:      b = POP(); a = POP(); PUSH((a == b) ? TRUE : FALSE); break;
+            case EQZ:     a = POP(); PUSH((a == 0) ? TRUE : FALSE); break;
+
+            case CALL:
+                addr = OPERAND();        // byte offset to jump to
+                PUSH(fp);                // save current frame pointer
+                PUSH(pc);                // save return address
+                fp = sp;                 // set new frame pointer
+                pc = addr;               // jump to function address
+                break;
+
+            case RET:
+                rval = POP();            // get return value
+                sp = fp;                 // restore stack pointer
+                pc = POP();              // get return address
+                fp = POP();              // restore previous frame pointer
+                PUSH(rval);              // push return value onto stack
+                break;
+
+            case LD:      v = stack[fp + OPERAND()]; PUSH(v); break;
+            case ST:      v = POP(); stack[fp + OPERAND()] = v; break;
+            case LOAD:    v = stack[OPERAND()]; PUSH(v); break;
+            case STORE:   v = POP(); stack[OPERAND()] = v; break;
+            case JP:      pc = OPERAND(); break;
+
+            case JPNZ:
+                addr = OPERAND();
+                v = POP();
+                if (v != 0)
+                    pc = addr;
+                break;
+
+            case JPZ:
+                addr = OPERAND();
+                v = POP();
+                if (v == 0)
+                    pc = addr;
+                break;
+
+            case DUP:     a = stack[sp]; PUSH(a); break;
+            case DROP:    sp--; break;
+            case PRINT:   v = POP(); printf("%d\n", v); break;
+            case PRNT:    v = POP(); printf("%d", v); break;
+
+            // superinstructions, packed without their pad slot
+            case LD_INC:  v = stack[fp + OPERAND()]; PUSH(v + 1); break;
+            case SET_ADD: v = OPERAND(); stack[sp] += v; break;
+
+            case DUP_JPZ:
+                addr = OPERAND();
+                if (stack[sp] == 0)
+                    pc = addr;
+                break;
+
+            case EQZ_JPNZ:
+                addr = OPERAND();
+                v = POP();
+                if (v == 0)
+                    pc = addr;
+                break;
+
+            default:
+                fprintf(stderr, "Unknown opcode %d at PC %d\n", opcode, pc - 1);
+                exit(1);
+        }
+    } while (1);
+
+    #undef PUSH
+    #undef POP
+    #undef OPERAND
+}
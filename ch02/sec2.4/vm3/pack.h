@@ -0,0 +1,35 @@
+#ifndef PACK_H
+#define PACK_H
+
+#include "vm3.h"
+
+// Packed vm3 code: the same instructions in bytes instead of ints.
+//
+// An instruction is one byte, the opcode in the low 6 bits and the width
+// of its operand in the top 2: PACK_W8, PACK_W16 or PACK_W32 for one, two
+// or four bytes, little-endian and signed. Jump and call operands are
+// byte offsets into the packed code. A superinstruction's pad slot is
+// left out, so every instruction is 1, 2, 3 or 5 bytes against 4 or 8
+// (12 fused) as ints.
+
+#define PACK_OPCODE(b) ((b) & 0x3f)
+#define PACK_WIDTH(b)  ((b) >> 6)
+
+enum { PACK_W8, PACK_W16, PACK_W32 };
+
+typedef struct {
+    unsigned char* code;
+    int len;                // bytes
+    int start;              // byte offset of the start address
+} Packed;
+
+// Packs code[0..len) starting at start. Returns 0, or -1 with a message
+// on stderr if a jump or call goes somewhere not an instruction
+int pack(int* code, int len, int start, Packed* packed);
+void free_packed(Packed* packed);
+
+// run() for packed code: vm->pc is the byte offset to start at, and on
+// HALT that of the byte after it; vm->code is not used
+void run_packed(VM* vm, const unsigned char* code);
+
+#endif // PACK_H
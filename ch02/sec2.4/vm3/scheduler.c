@@ -0,0 +1,202 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#include "scheduler.h"
+
+#ifndef VM3_SLICE
+#error "scheduler.c needs vm3.c built with -DVM3_SLICE"
+#endif
+
+typedef struct Task {
+    VM* vm;
+    int id;
+    struct Task* next;
+} Task;
+
+typedef struct {
+    pthread_mutex_t lock;
+    Task* head;             // taken by the owner and by thieves
+    Task* tail;             // where the owner parks
+} Queue;
+
+typedef struct {
+    Sched* sched;
+    int index;
+    pthread_t thread;
+    unsigned int seed;      // for picking whom to steal from
+    unsigned long slices;
+    unsigned long steals;
+    unsigned long instructions;
+} Worker;
+
+struct Sched {
+    int nthreads;
+    long quantum;
+    SchedDone done;
+    void* arg;
+    Queue* queues;          // one per worker
+    Worker* workers;
+    atomic_int live;        // programs not yet halted
+    atomic_int ids;
+    atomic_uint next;       // queue for the next spawn, round robin
+};
+
+static void put(Queue* q, Task* t) {
+    t->next = NULL;
+    pthread_mutex_lock(&q->lock);
+    if (q->tail != NULL)
+        q->tail->next = t;
+    else
+        q->head = t;
+    q->tail = t;
+    pthread_mutex_unlock(&q->lock);
+}
+
+static Task* take(Queue* q) {
+    pthread_mutex_lock(&q->lock);
+    Task* t = q->head;
+    if (t != NULL) {
+        q->head = t->next;
+        if (q->head == NULL)
+            q->tail = NULL;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return t;
+}
+
+// the front of another worker's queue, which has waited longest there
+static Task* steal(Sched* s, Worker* w) {
+    int n = s->nthreads;
+    int first = (int) (rand_r(&w->seed) % n);
+    for (int k = 0; k < n; k++) {
+        int victim = (first + k) % n;
+        if (victim == w->index)
+            continue;
+        Task* t = take(&s->queues[victim]);
+        if (t != NULL) {
+            w->steals++;
+            return t;
+        }
+    }
+    return NULL;
+}
+
+static void* work(void* arg) {
+    Worker* w = (Worker*) arg;
+    Sched* s = w->sched;
+    Queue* own = &s->queues[w->index];
+
+    while (atomic_load(&s->live) > 0) {
+        Task* t = take(own);
+        if (t == NULL)
+            t = steal(s, w);
+        if (t == NULL) {
+            sched_yield();
+            continue;
+        }
+
+        VM* vm = t->vm;
+        vm->budget = s->quantum;
+        run(vm);
+        w->slices++;
+        w->instructions += (vm->budget < 0) ? s->quantum : s->quantum - vm->budget;
+
+        if (!vm->halted) {
+            put(own, t);
+            continue;
+        }
+        if (s->done != NULL)
+            s->done(t->id, vm, s->arg);
+        freeVM(vm);
+        free(t);
+        atomic_fetch_sub(&s->live, 1);
+    }
+    return NULL;
+}
+
+Sched* sched_new(int nthreads, long quantum, SchedDone done, void* arg) {
+    if (nthreads <= 0) {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = (n > 0) ? (int) n : 1;
+    }
+    Sched* s = (Sched*) malloc(sizeof(Sched));
+    if (s == NULL)
+        return NULL;
+    s->queues = (Queue*) calloc(nthreads, sizeof(Queue));
+    s->workers = (Worker*) calloc(nthreads, sizeof(Worker));
+    if (s->queues == NULL || s->workers == NULL) {
+        free(s->queues);
+        free(s->workers);
+        free(s);
+        return NULL;
+    }
+    s->nthreads = nthreads;
+    s->quantum = (quantum > 0) ? quantum : 1;
+    s->done = done;
+    s->arg = arg;
+    atomic_init(&s->live, 0);
+    atomic_init(&s->ids, 0);
+    atomic_init(&s->next, 0);
+    for (int i = 0; i < nthreads; i++) {
+        pthread_mutex_init(&s->queues[i].lock, NULL);
+        s->workers[i].sched = s;
+        s->workers[i].index = i;
+        s->workers[i].seed = 2654435761u * (i + 1);
+    }
+    return s;
+}
+
+void sched_free(Sched* s) {
+    if (s == NULL)
+        return;
+    for (int i = 0; i < s->nthreads; i++) {
+        Task* t;
+        while ((t = take(&s->queues[i])) != NULL) {
+            freeVM(t->vm);
+            free(t);
+        }
+        pthread_mutex_destroy(&s->queues[i].lock);
+    }
+    free(s->queues);
+    free(s->workers);
+    free(s);
+}
+
+int sched_spawn(Sched* s, int* code, int pc) {
+    Task* t = (Task*) malloc(sizeof(Task));
+    if (t == NULL)
+        return -1;
+    t->vm = newVMSized(code, pc, SCHED_STACK);
+    if (t->vm == NULL) {
+        free(t);
+        return -1;
+    }
+    t->id = atomic_fetch_add(&s->ids, 1);
+    atomic_fetch_add(&s->live, 1);
+    put(&s->queues[atomic_fetch_add(&s->next, 1) % s->nthreads], t);
+    return t->id;
+}
+
+void sched_run(Sched* s) {
+    for (int i = 1; i < s->nthreads; i++) {
+        if (pthread_create(&s->workers[i].thread, NULL, work, &s->workers[i]) != 0) {
+            fprintf(stderr, "Cannot start worker %d\n", i);
+            exit(1);
+        }
+    }
+    work(&s->workers[0]);   // the calling thread is worker 0
+    for (int i = 1; i < s->nthreads; i++)
+        pthread_join(s->workers[i].thread, NULL);
+}
+
+void print_sched_stats(Sched* s) {
+    printf("worker       slices     steals   instructions\n");
+    for (int i = 0; i < s->nthreads; i++) {
+        Worker* w = &s->workers[i];
+        printf("%6d %12lu %10lu %14lu\n", i, w->slices, w->steals, w->instructions);
+    }
+}
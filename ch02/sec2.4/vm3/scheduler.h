@@ -0,0 +1,40 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "vm3.h"
+
+// Many vm3 programs at once, on a pool of threads. Built with -DVM3_SLICE
+// and -pthread.
+//
+// Every program is a VM of its own with a small stack (SCHED_STACK cells,
+// grown as it needs). A worker thread takes a VM off its ready queue,
+// runs it for a quantum of instructions and, unless it halted, parks it
+// at the back of the queue again. Queues are first in, first out, so
+// every VM gets its turn. A worker whose queue is empty steals from the
+// front of another's.
+
+#ifndef SCHED_STACK
+#define SCHED_STACK 16
+#endif
+
+typedef struct Sched Sched;
+
+// called by the worker that ran the program to its HALT, before the VM
+// is freed; there may be several such calls at the same time
+typedef void (*SchedDone)(int id, VM* vm, void* arg);
+
+// nthreads 0 is one per processor
+Sched* sched_new(int nthreads, long quantum, SchedDone done, void* arg);
+void sched_free(Sched* sched);
+
+// Adds a program starting at pc; returns its id, counted from 0, or -1.
+// code is shared, not copied. May also be called from a SchedDone, to
+// add programs while sched_run() is going on
+int sched_spawn(Sched* sched, int* code, int pc);
+
+// Runs until every program has halted
+void sched_run(Sched* sched);
+
+void print_sched_stats(Sched* sched);
+
+#endif // SCHEDULER_H
@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "scheduler.h"
+
+// Many small programs on the scheduler: ./tasks [count] [threads] [quantum]
+// Every tenth program sums 1..50000, the others 1..500, so a short one
+// that halts long after the long ones started shows how fair the queues
+// are. Build with `make tasks`.
+
+/*
+START:
+    SET 0       # sum at 0
+    SET n       # i at 1
+LOOP:
+    LD 0
+    LD 1
+    ADD
+    ST 0        # sum = sum + i
+    LD 1
+    DEC
+    DUP
+    ST 1        # i = i - 1
+    JPNZ :LOOP  # until i = 0
+    LD 0
+    HALT
+*/
+#define SUM(n) { \
+    SET, 0, SET, n, \
+    LD, 0, LD, 1, ADD, ST, 0, LD, 1, DEC, DUP, ST, 1, JPNZ, 4, \
+    LD, 0, HALT }
+
+int sum_short[] = SUM(500);
+int sum_long[] = SUM(50000);
+
+typedef struct {
+    int count;
+    double* finished;       // seconds from the start, by id
+    int* result;
+    struct timespec start;
+} Run;
+
+static double since(struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+// every id is done once, by one worker, so no locking is needed
+static void done(int id, VM* vm, void* arg) {
+    Run* r = (Run*) arg;
+    r->finished[id] = since(&r->start);
+    r->result[id] = (vm->sp >= 0) ? vm->stack[vm->sp] : 0;
+}
+
+static int is_long(int id) {
+    return id % 10 == 0;
+}
+
+int main(int argc, char* argv[]) {
+    int count = (argc > 1) ? atoi(argv[1]) : 10000;
+    int threads = (argc > 2) ? atoi(argv[2]) : 0;
+    long quantum = (argc > 3) ? atol(argv[3]) : 1000;
+    if (count < 1)
+        count = 1;
+
+    Run r;
+    r.count = count;
+    r.finished = (double*) calloc(count, sizeof(double));
+    r.result = (int*) calloc(count, sizeof(int));
+    Sched* s = sched_new(threads, quantum, done, &r);
+    if (r.finished == NULL || r.result == NULL || s == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (sched_spawn(s, is_long(i) ? sum_long : sum_short, 0) < 0) {
+            fprintf(stderr, "Out of memory\n");
+            return 1;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &r.start);
+    sched_run(s);
+    double duration = since(&r.start);
+
+    int wrong = 0;
+    double last_short = 0.0, last_long = 0.0;
+    for (int i = 0; i < count; i++) {
+        long n = is_long(i) ? 50000 : 500;
+        if (r.result[i] != (int) (n * (n + 1) / 2))
+            wrong++;
+        if (is_long(i) && r.finished[i] > last_long)
+            last_long = r.finished[i];
+        if (!is_long(i) && r.finished[i] > last_short)
+            last_short = r.finished[i];
+    }
+
+    print_sched_stats(s);
+    unsigned long instructions = 0;
+    for (int i = 0; i < count; i++) {
+        long n = is_long(i) ? 50000 : 500;
+        instructions += 4 + 9 * n;
+    }
+    printf("%d programs, quantum %ld: %.3f s, %.1f Minstr/s, %d wrong\n",
+        count, quantum, duration, instructions / duration / 1e6, wrong);
+    printf("last short program done at %.3f s, last long at %.3f s\n",
+        last_short, last_long);
+
+    sched_free(s);
+    free(r.finished);
+    free(r.result);
+    return wrong != 0;
+}
@@ -3,25 +3,76 @@
 
 #include "vm3.h"
 
+#ifdef VM3_STATS
+#define STEP(vm) ((vm)->steps++)
+#else
+#define STEP(vm) ((void) 0)
+#endif
+
+#ifdef VM3_SLICE
+#define SLICE(vm) if ((vm)->budget-- <= 0) return
+#else
+#define SLICE(vm) ((void) 0)
+#endif
+
+#ifdef VM3_JIT
+#include "jit.h"
+
+// a jump back may run a compiled loop, and a print or a return that
+// native code left for may land back in one
+#define JUMP(vm, addr) do { \
+    int end_ = (vm)->pc; \
+    (vm)->pc = (addr); \
+    if ((vm)->pc < end_) \
+        jit_loop(vm, end_); \
+} while (0)
+#define RESUME(vm) jit_resume(vm)
+#else
+#define JUMP(vm, addr) ((vm)->pc = (addr))
+#define RESUME(vm) ((void) 0)
+#endif
+
 VM* newVM(int* code, int pc) {
+    return newVMSized(code, pc, STACK_SIZE);
+}
+
+// a VM with a stack of size cells to begin with, for many small VMs
+VM* newVMSized(int* code, int pc, int size) {
     VM* vm = (VM*) malloc(sizeof(VM));
     if (vm == NULL)
         return NULL;
-    vm->stack = (int*) malloc(sizeof(int) * STACK_SIZE);
+    if (size < 1 || size > STACK_SIZE)
+        size = STACK_SIZE;
+    // one cell below the bottom, where -DVM3_TOS spills a cached top that
+    // isn't there when the stack is empty
+    vm->stack = (int*) malloc(sizeof(int) * (size + 1));
     if (vm->stack == NULL)
         return NULL;
+    vm->stack++;
+    vm->size = size;
+    vm->budget = 0;
+    vm->halted = FALSE;
 
     vm->code = code;
     vm->pc = pc;
     vm->sp = -1;
     vm->fp = 0;
+    vm->steps = 0;
+#ifdef VM3_JIT
+    vm->jit = jit_new();
+#else
+    vm->jit = NULL;
+#endif
 
     return vm;
 }
 
 void freeVM(VM* vm) {
     if (vm != NULL) {
-        free(vm->stack);
+#ifdef VM3_JIT
+        jit_free(vm->jit);
+#endif
+        free(vm->stack - 1);
         free(vm);
     }
 }
@@ -30,14 +81,33 @@ int pop(VM* vm) {
     return vm->stack[(vm->sp)--];
 }
 
-void push(VM* vm, int v) {
-    if (vm->sp + 1 >= STACK_SIZE) {
+// makes stack[addr] one of the cells, doubling the stack up to STACK_SIZE
+static void grow(VM* vm, int addr) {
+    if (addr >= STACK_SIZE) {
         fprintf(stderr, "Stack overflow\n");
         exit(1);
     }
+    int size = vm->size;
+    while (size <= addr)
+        size *= 2;
+    if (size > STACK_SIZE)
+        size = STACK_SIZE;
+    int* stack = (int*) realloc(vm->stack - 1, sizeof(int) * (size + 1));
+    if (stack == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    vm->stack = stack + 1;
+    vm->size = size;
+}
+
+void push(VM* vm, int v) {
+    if (vm->sp + 1 >= vm->size)
+        grow(vm, vm->sp + 1);
     vm->stack[++(vm->sp)] = v;
 }
 
+
 int nextcode(VM* vm) {
     return vm->code[(vm->pc)++];
 }
@@ -55,17 +125,530 @@ void print_vm_state(VM* vm) {
     print_stack(vm);
 }
 
+static int arity(int opcode) {
+    switch (opcode) {
+        case CALL: case JP: case JPNZ: case JPZ:
+        case LD: case LOAD: case SET: case ST: case STORE:
+            return 1;
+        case LD_INC: case SET_ADD: case DUP_JPZ: case EQZ_JPNZ:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+static int is_branch(int opcode) {
+    return opcode == CALL || opcode == JP || opcode == JPNZ || opcode == JPZ
+        || opcode == DUP_JPZ || opcode == EQZ_JPNZ;
+}
+
+FusionRule fusion_rules[] = {
+    { LD,  INC,  LD_INC,   "LD x; INC",  0 },
+    { SET, ADD,  SET_ADD,  "SET n; ADD", 0 },
+    { DUP, JPZ,  DUP_JPZ,  "DUP; JPZ",   0 },
+    { EQZ, JPNZ, EQZ_JPNZ, "EQZ; JPNZ",  0 },
+    { 0, 0, 0, NULL, 0 }
+};
+
+// Peephole pass over code[0..len) rewriting pairs in fusion_rules into
+// superinstructions in place. Addresses do not move, and a pair is left
+// alone if anything can jump or return to its second instruction.
+int fuse(int* code, int len, int start) {
+    char* target = (char*) calloc(len + 1, 1);
+    if (target == NULL)
+        return 0;
+
+    if (start >= 0 && start < len)
+        target[start] = 1;
+    for (int a = 0; a < len; a += 1 + arity(code[a])) {
+        int opcode = code[a];
+        if (is_branch(opcode) && a + 1 < len
+                && code[a + 1] >= 0 && code[a + 1] < len)
+            target[code[a + 1]] = 1;
+        if (opcode == CALL && a + 2 < len)
+            target[a + 2] = 1;  // return address
+    }
+
+    int count = 0;
+    int a = 0;
+    while (a < len) {
+        int b = a + 1 + arity(code[a]);
+        if (b >= len)
+            break;
+        int end = b + 1 + arity(code[b]);
+
+        FusionRule* rule = NULL;
+        for (FusionRule* r = fusion_rules; r->name != NULL; r++) {
+            if (r->first == code[a] && r->second == code[b]) {
+                rule = r;
+                break;
+            }
+        }
+
+        if (rule == NULL || target[b] || end > len) {
+            a = b;
+            continue;
+        }
+
+        // [A, a-operands, B, b-operands] -> [AB, a-operands, b-operands, pad]
+        code[a] = rule->fused;
+        for (int i = b; i < end - 1; i++)
+            code[i] = code[i + 1];
+        code[end - 1] = NOP;
+        rule->fired++;
+        count++;
+        a = end;
+    }
+
+    free(target);
+    return count;
+}
+
+void print_fusion_stats(void) {
+    printf("fusion        fired\n");
+    for (FusionRule* r = fusion_rules; r->name != NULL; r++)
+        printf("%-12s %6lu\n", r->name, r->fired);
+}
+
+#if defined(VM3_THREADED) && defined(__GNUC__) && !defined(VM3_JIT)
+
+// Direct-threaded dispatch: the bytecode is translated once into a table
+// of cells holding either the address of a handler label or an inline
+// operand. Jump and call operands are resolved to cell pointers, so each
+// handler ends by jumping straight to the next one.
+
+typedef union Cell {
+    void* label;
+    union Cell* target;
+    int operand;
+} Cell;
+
+// the VM does not know the length of its code, so only what is reachable
+// from the start address (following branches and calls) gets translated
+static Cell* translate(VM* vm, void** labels, void* unknown) {
+    int* code = vm->code;
+    int cap = 256, len = 0;
+    char* seen = (char*) calloc(cap, 1);
+    int* work = (int*) malloc(sizeof(int) * cap);
+    int nwork = 0;
+    if (seen == NULL || work == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+
+    work[nwork++] = vm->pc;
+    while (nwork > 0) {
+        int a = work[--nwork];
+        while (a >= 0) {
+            if (a + 2 >= cap) {
+                int ncap = cap;
+                while (a + 2 >= ncap)
+                    ncap *= 2;
+                seen = (char*) realloc(seen, ncap);
+                work = (int*) realloc(work, sizeof(int) * ncap);
+                if (seen == NULL || work == NULL) {
+                    fprintf(stderr, "Out of memory\n");
+                    exit(1);
+                }
+                for (int i = cap; i < ncap; i++)
+                    seen[i] = 0;
+                cap = ncap;
+            }
+            if (seen[a])
+                break;
+            seen[a] = 1;
+
+            int opcode = code[a];
+            if (opcode < ADD || opcode >= NUM_OPCODES) {
+                if (a + 1 > len) len = a + 1;
+                break;  // reported by the unknown handler if ever reached
+            }
+            int next = a + 1 + arity(opcode);
+            if (next > len)
+                len = next;
+            if (is_branch(opcode) && code[a + 1] >= 0 && nwork < cap)
+                work[nwork++] = code[a + 1];
+            if (opcode == HALT || opcode == RET || opcode == JP)
+                break;
+            a = next;
+        }
+    }
+
+    Cell* table = (Cell*) malloc(sizeof(Cell) * (len + 1));
+    if (table == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    for (int a = 0; a <= len; a++)
+        table[a].label = unknown;
+    for (int a = 0; a < len; a++) {
+        if (!seen[a])
+            continue;
+        int opcode = code[a];
+        if (opcode < ADD || opcode >= NUM_OPCODES)
+            continue;
+        table[a].label = labels[opcode];
+        if (is_branch(opcode))
+            table[a + 1].target = table + code[a + 1];
+        else if (arity(opcode) > 0)
+            table[a + 1].operand = code[a + 1];
+    }
+
+    free(seen);
+    free(work);
+    return table;
+}
+
+void run(VM* vm) {
+    // LT and NOP have no case in the switch either, so they stay unknown
+    static void* labels[] = {
+        [ADD] = &&op_ADD,   [AND] = &&op_AND,     [CALL] = &&op_CALL,
+        [DEC] = &&op_DEC,   [DROP] = &&op_DROP,   [DUP] = &&op_DUP,
+        [EQ] = &&op_EQ,     [EQZ] = &&op_EQZ,     [HALT] = &&op_HALT,
+        [INC] = &&op_INC,   [JP] = &&op_JP,       [JPNZ] = &&op_JPNZ,
+        [JPZ] = &&op_JPZ,   [LD] = &&op_LD,       [LOAD] = &&op_LOAD,
+        [LSH] = &&op_LSH,   [LT] = &&op_unknown,  [MOD] = &&op_MOD,
+        [MUL] = &&op_MUL,   [NOP] = &&op_unknown,  [OR] = &&op_OR,
+        [PRINT] = &&op_PRINT, [PRNT] = &&op_PRNT, [RET] = &&op_RET,
+        [RSH] = &&op_RSH,   [SET] = &&op_SET,     [SETZ] = &&op_SETZ,
+        [ST] = &&op_ST,     [STORE] = &&op_STORE, [SUB] = &&op_SUB,
+        [LD_INC] = &&op_LD_INC,     [SET_ADD] = &&op_SET_ADD,
+        [DUP_JPZ] = &&op_DUP_JPZ,   [EQZ_JPNZ] = &&op_EQZ_JPNZ
+    };
+
+    Cell* table = translate(vm, (void**) labels, &&op_unknown);
+    Cell* ip = table + vm->pc;
+    int* stack = vm->stack;
+    int sp = vm->sp;
+    int fp = vm->fp;
+    int a, b, v, rval;
+
+    // registers are kept in locals and written back on HALT
+    #define PUSH(x) do { \
+        if (sp + 1 >= STACK_SIZE) { \
+            fprintf(stderr, "Stack overflow\n"); \
+            exit(1); \
+        } \
+        stack[++sp] = (x); \
+    } while (0)
+    #define POP() (stack[sp--])
+    #define NEXT do { STEP(vm); goto *(ip++)->label; } while (0)
+
+    NEXT;
+
+    op_HALT:
+        vm->halted = TRUE;
+        vm->pc = (int) (ip - table);
+        vm->sp = sp;
+        vm->fp = fp;
+        free(table);
+        return;
+
+    op_SET:   PUSH((ip++)->operand); NEXT;
+    op_SETZ:  PUSH(0); NEXT;
+    op_ADD:   b = POP(); a = POP(); PUSH(a + b); NEXT;
+    op_SUB:   b = POP(); a = POP(); PUSH(a - b); NEXT;
+    op_MUL:   b = POP(); a = POP(); PUSH(a * b); NEXT;
+    op_MOD:   b = POP(); a = POP(); PUSH(a % b); NEXT;
+    op_INC:   a = POP(); PUSH(a + 1); NEXT;
+    op_DEC:   a = POP(); PUSH(a - 1); NEXT;
+
+    op_CALL: {
+        Cell* target = (ip++)->target;
+        PUSH(fp);                       // save current frame pointer
+        PUSH((int) (ip - table));       // save return address
+        fp = sp;                        // set new frame pointer
+        ip = target;                    // jump to function address
+        NEXT;
+    }
+
+    op_RET:
+        rval = POP();                   // get return value
+        sp = fp;                        // restore stack pointer
+        ip = table + POP();             // get return address
+        fp = POP();                     // restore previous frame pointer
+        PUSH(rval);                     // push return value onto stack
+        NEXT;
+
+    op_LD:    v = stack[fp + (ip++)->operand]; PUSH(v); NEXT;
+    op_ST:    v = POP(); stack[fp + (ip++)->operand] = v; NEXT;
+    op_AND:   b = POP(); a = POP(); PUSH(a & b); NEXT;
+    op_OR:    b = POP(); a = POP(); PUSH(a | b); NEXT;
+    op_LSH:   b = POP(); a = POP(); PUSH(a << b); NEXT;
+    op_RSH:   b = POP(); a = POP(); PUSH(a >> b); NEXT;
+    op_EQ:    b = POP(); a = POP(); PUSH((a == b) ? TRUE : FALSE); NEXT;
+    op_EQZ:   a = POP(); PUSH((a == 0) ? TRUE : FALSE); NEXT;
+    op_JP:    ip = ip->target; NEXT;
+
+    op_JPNZ:
+        v = POP();
+        ip = (v != 0) ? ip->target : ip + 1;
+        NEXT;
+
+    op_JPZ:
+        v = POP();
+        ip = (v == 0) ? ip->target : ip + 1;
+        NEXT;
+
+    op_LOAD:  v = stack[(ip++)->operand]; PUSH(v); NEXT;
+    op_STORE: v = POP(); stack[(ip++)->operand] = v; NEXT;
+    op_DUP:   a = stack[sp]; PUSH(a); NEXT;
+    op_DROP:  sp--; NEXT;
+    op_PRINT: v = POP(); printf("%d\n", v); NEXT;
+    op_PRNT:  v = POP(); printf("%d", v); NEXT;
+
+    // superinstructions, the pad cell is skipped when falling through
+    op_LD_INC:
+        v = stack[fp + (ip++)->operand];
+        PUSH(v + 1);
+        ip++;
+        NEXT;
+
+    op_SET_ADD:
+        v = (ip++)->operand;
+        stack[sp] += v;
+        ip++;
+        NEXT;
+
+    op_DUP_JPZ:
+        ip = (stack[sp] == 0) ? ip->target : ip + 2;
+        NEXT;
+
+    op_EQZ_JPNZ:
+        v = POP();
+        ip = (v == 0) ? ip->target : ip + 2;
+        NEXT;
+
+    op_unknown: {
+        int pc = (int) (ip - 1 - table);
+        fprintf(stderr, "Unknown opcode %d at PC %d\n", vm->code[pc], pc);
+        exit(1);
+    }
+
+    #undef PUSH
+    #undef POP
+    #undef NEXT
+}
+
+#elif defined(VM3_TOS) && !defined(VM3_JIT)
+
+// Top of stack in a register: the switch of run() below, with pc, sp, fp
+// and the top of the stack kept in locals. The top is not in vm->stack,
+// only the cells under it are, so a binary operation loads one operand
+// and stores nothing. LD, LOAD and RET, which read the stack by address,
+// spill the top first, and ST and STORE reload it after writing. Everything
+// is written back on HALT.
+
+void run(VM* vm) {
+    int* code = vm->code;
+    int* stack = vm->stack;
+    int pc = vm->pc;
+    int sp = vm->sp;
+    int fp = vm->fp;
+    int tos = (sp >= 0) ? stack[sp] : 0;
+    int a, v, addr, rval;
+
+    // the old top goes to memory, at stack[-1] if the stack was empty
+    #define PUSH(x) do { \
+        if (sp + 1 >= STACK_SIZE) { \
+            fprintf(stderr, "Stack overflow\n"); \
+            exit(1); \
+        } \
+        stack[sp++] = tos; \
+        tos = (x); \
+    } while (0)
+    #define POP_TOS() (tos = stack[--sp])
+    #define BINARY(op) do { a = stack[--sp]; tos = a op tos; } while (0)
+
+    do {
+        int opcode = code[pc++];
+        STEP(vm);
+
+        switch (opcode) {
+            case HALT:
+                vm->halted = TRUE;
+                stack[sp] = tos;
+                vm->pc = pc;
+                vm->sp = sp;
+                vm->fp = fp;
+                return;
+
+            case SET:
+                v = code[pc++];
+                PUSH(v);
+                break;
+
+            case SETZ:
+                PUSH(0);
+                break;
+
+            case ADD: BINARY(+); break;
+            case SUB: BINARY(-); break;
+            case MUL: BINARY(*); break;
+            case MOD: BINARY(%); break;
+            case AND: BINARY(&); break;
+            case OR:  BINARY(|); break;
+            case LSH: BINARY(<<); break;
+            case RSH: BINARY(>>); break;
+
+            case EQ:
+                a = stack[--sp];
+                tos = (a == tos) ? TRUE : FALSE;
+                break;
+
+            case EQZ:
+                tos = (tos == 0) ? TRUE : FALSE;
+                break;
+
+            case INC:
+                tos++;
+                break;
+
+            case DEC:
+                tos--;
+                break;
+
+            case CALL:
+                addr = code[pc++];
+                PUSH(fp);                // save current frame pointer
+                PUSH(pc);                // save return address
+                fp = sp;                 // set new frame pointer
+                pc = addr;               // jump to function address
+                break;
+
+            case RET:
+                rval = tos;              // get return value
+                stack[sp] = tos;         // in case it was the return address
+                pc = stack[fp];          // get return address
+                sp = fp - 1;
+                fp = stack[fp - 1];      // restore previous frame pointer
+                tos = rval;              // return value replaces it
+                break;
+
+            case LD:
+                addr = code[pc++];       // get local variable index
+                stack[sp] = tos;
+                v = stack[fp + addr];
+                PUSH(v);
+                break;
+
+            case ST:
+                addr = code[pc++];       // get local variable index
+                v = tos;
+                sp--;
+                stack[fp + addr] = v;
+                tos = stack[sp];         // in case it was the new top
+                break;
+
+            case JP:
+                pc = code[pc];
+                break;
+
+            case JPNZ:
+                v = tos;
+                POP_TOS();
+                pc = (v != 0) ? code[pc] : pc + 1;
+                break;
+
+            case JPZ:
+                v = tos;
+                POP_TOS();
+                pc = (v == 0) ? code[pc] : pc + 1;
+                break;
+
+            case LOAD:
+                addr = code[pc++];       // global address
+                stack[sp] = tos;
+                v = stack[addr];
+                PUSH(v);
+                break;
+
+            case STORE:
+                addr = code[pc++];       // global address
+                v = tos;
+                sp--;
+                stack[addr] = v;
+                tos = stack[sp];
+                break;
+
+            case DUP:
+                PUSH(tos);
+                break;
+
+            case DROP:
+                POP_TOS();
+                break;
+
+            case PRINT:
+                v = tos;
+                POP_TOS();
+                printf("%d\n", v);
+                break;
+
+            case PRNT:
+                v = tos;
+                POP_TOS();
+                printf("%d", v);
+                break;
+
+            // superinstructions, the pad slot is skipped when falling through
+            case LD_INC:
+                addr = code[pc++];
+                stack[sp] = tos;
+                v = stack[fp + addr];
+                PUSH(v + 1);
+                pc++;
+                break;
+
+            case SET_ADD:
+                tos += code[pc++];
+                pc++;
+                break;
+
+            case DUP_JPZ:
+                pc = (tos == 0) ? code[pc] : pc + 2;
+                break;
+
+            case EQZ_JPNZ:
+                v = tos;
+                POP_TOS();
+                pc = (v == 0) ? code[pc] : pc + 2;
+                break;
+
+            default:
+                fprintf(stderr, "Unknown opcode %d at PC %d\n", opcode, pc - 1);
+                exit(1);
+        }
+    } while (1);
+
+    #undef PUSH
+    #undef POP_TOS
+    #undef BINARY
+}
+
+#else
+
+// a cell addressed by LD, ST, LOAD or STORE
+static int* cell(VM* vm, int addr) {
+    if (addr >= vm->size)
+        grow(vm, addr);
+    return &vm->stack[addr];
+}
+
 void run(VM* vm) {
     int a, b, v, addr, rval;
 
     do {
         // DEBUG print_vm_state(vm);
 
+        SLICE(vm);
         int opcode = nextcode(vm);
+        STEP(vm);
         // DEBUG printf("Executing opcode %d\n", opcode);
 
         switch (opcode) {
             case HALT:
+                vm->halted = TRUE;
                 return;
 
             case SET:
@@ -99,6 +682,7 @@ void run(VM* vm) {
                 b = pop(vm);
                 a = pop(vm);
                 push(vm, a % b);
+                RESUME(vm);
                 break;
 
             case INC:
@@ -125,18 +709,19 @@ void run(VM* vm) {
                 vm->pc = pop(vm);        // get return address
                 vm->fp = pop(vm);        // restore previous frame pointer
                 push(vm, rval);          // push return value onto stack
+                RESUME(vm);
                 break;
 
             case LD:
                 addr = nextcode(vm);     // get local variable index
-                v = vm->stack[vm->fp + addr];
+                v = *cell(vm, vm->fp + addr);
                 push(vm, v);
                 break;
 
             case ST:
                 v = pop(vm);
                 addr = nextcode(vm);     // get local variable index
-                vm->stack[vm->fp + addr] = v;
+                *cell(vm, vm->fp + addr) = v;
                 break;
 
             case AND:
@@ -175,14 +760,15 @@ void run(VM* vm) {
                 break;
 
             case JP:
-                vm->pc = nextcode(vm);
+                addr = nextcode(vm);
+                JUMP(vm, addr);
                 break;
 
             case JPNZ:
                 addr = nextcode(vm);
                 v = pop(vm);
                 if (v != 0) {
-                    vm->pc = addr;
+                    JUMP(vm, addr);
                 }
                 break;
 
@@ -190,20 +776,20 @@ void run(VM* vm) {
                 addr = nextcode(vm);
                 v = pop(vm);
                 if (v == 0) {
-                    vm->pc = addr;
+                    JUMP(vm, addr);
                 }
                 break;
 
             case LOAD:
                 addr = nextcode(vm);  // global address
-                v = vm->stack[addr];  // load from global
+                v = *cell(vm, addr);  // load from global
                 push(vm, v);
                 break;
 
             case STORE:
                 v = pop(vm);          // pop value from stack
                 addr = nextcode(vm);  // global address
-                vm->stack[addr] = v;  // store in global
+                *cell(vm, addr) = v;  // store in global
                 break;
 
             case DUP:
@@ -219,11 +805,47 @@ void run(VM* vm) {
             case PRINT:
                 v = pop(vm);
                 printf("%d\n", v);
+                RESUME(vm);
                 break;
 
             case PRNT:
                 v = pop(vm);
                 printf("%d", v);
+                RESUME(vm);
+                break;
+
+            // superinstructions, the pad slot is skipped when falling through
+            case LD_INC:
+                addr = nextcode(vm);
+                v = *cell(vm, vm->fp + addr);
+                push(vm, v + 1);
+                vm->pc++;
+                break;
+
+            case SET_ADD:
+                v = nextcode(vm);
+                a = pop(vm);
+                push(vm, a + v);
+                vm->pc++;
+                break;
+
+            case DUP_JPZ:
+                addr = nextcode(vm);
+                if (vm->stack[vm->sp] == 0) {
+                    JUMP(vm, addr);
+                } else {
+                    vm->pc++;
+                }
+                break;
+
+            case EQZ_JPNZ:
+                addr = nextcode(vm);
+                v = pop(vm);
+                if (v == 0) {
+                    JUMP(vm, addr);
+                } else {
+                    vm->pc++;
+                }
                 break;
 
             default:
@@ -236,3 +858,5 @@ void run(VM* vm) {
 
     } while (1);
 }
+
+#endif
@@ -1,3 +1,6 @@
+#ifndef VM3_H
+#define VM3_H
+
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -11,6 +14,11 @@ typedef struct {
     int pc;
     int sp;
     int fp;
+    unsigned long steps;    // dispatched instructions, counted with -DVM3_STATS
+    struct Jit* jit;        // compiled loops, with -DVM3_JIT
+    int size;               // cells in stack, grown up to STACK_SIZE by the switch
+    long budget;            // instructions left in a slice, with -DVM3_SLICE
+    int halted;             // set by HALT
 } VM;
 
 enum {      // arity
@@ -46,6 +54,52 @@ enum {      // arity
     SUB     // 0
 };
 
+// superinstructions written by fuse(), not by the assembler; each keeps
+// the length of the pair it replaces: operands of both, then one pad slot
+enum {
+    LD_INC = SUB + 1,   // LD x; INC
+    SET_ADD,            // SET n; ADD
+    DUP_JPZ,            // DUP; JPZ a
+    EQZ_JPNZ,           // EQZ; JPNZ a
+    NUM_OPCODES
+};
+
+typedef struct {
+    int first;              // opcode of first instruction
+    int second;             // opcode of second instruction
+    int fused;              // superinstruction replacing the pair
+    const char* name;
+    unsigned long fired;    // number of pairs rewritten
+} FusionRule;
+
+extern FusionRule fusion_rules[];
+
+// build with -DVM3_THREADED (gcc/clang) for direct-threaded dispatch,
+// the plain switch in run() is the portable fallback; -DVM3_TOS is the
+// switch with the top of the stack in a register, -DVM3_JIT keeps the
+// switch and compiles its hot loops (jit.h)
+#if defined(VM3_JIT)
+#define VM3_DISPATCH "jit"
+#elif defined(VM3_THREADED) && defined(__GNUC__)
+#define VM3_DISPATCH "threaded"
+#elif defined(VM3_TOS)
+#define VM3_DISPATCH "tos"
+#else
+#define VM3_DISPATCH "switch"
+#endif
+
+// -DVM3_SLICE makes run() return after vm->budget instructions, to be
+// called again to go on (scheduler.h); only the switch does that, and only
+// the switch grows a stack smaller than STACK_SIZE
+#if defined(VM3_SLICE) && (defined(VM3_THREADED) || defined(VM3_TOS) || defined(VM3_JIT))
+#error "VM3_SLICE needs the plain switch"
+#endif
+
 VM* newVM(int* code, int pc);
+VM* newVMSized(int* code, int pc, int size);
 void freeVM(VM* vm);
 void run(VM* vm);
+int fuse(int* code, int len, int start);
+void print_fusion_stats(void);
+
+#endif // VM3_H
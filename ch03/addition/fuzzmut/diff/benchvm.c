@@ -0,0 +1,344 @@
+/*
+ * benchvm.c
+ *   gcc -std=gnu11 -O2 -fwrapv -o benchvm benchvm.c core.c core_vm1.c \
+ *       core_vm2.c core_vm3.c core_vm3t.c core_vm4.c core_sap.c \
+ *       ../../sap/sap_vm.c ../../sap/sap_vm_debug_support.c \
+ *       ../../sap/sap_vm_image.c ../../sap/sap_vm_trace.c
+ *
+ *   ./benchvm [-f table|csv|json] [-n samples] [-w warmup] [-m ms]
+ *             [-b baseline.csv] [-t percent]
+ *
+ * The same fixed programs on every core diffvm has, timed the same way:
+ * a few warmup batches that are thrown away, then samples, each a batch
+ * of runs long enough to time (-m, 5 ms by default), reported as the
+ * median time of a run and the median absolute deviation around it.
+ * Every core's result is held against the model as well, so a fast
+ * wrong core is not a win.
+ *
+ * The output of -f csv can be given back with -b: each median is then
+ * compared with the one in the file, and more than -t percent slower
+ * (10 by default) counts as a regression, and the exit status is 1.
+ *
+ * The programs are in diffvm's subset, straight line and forward skips,
+ * so what they measure is mostly dispatch. The cores include the VMs'
+ * own run loops, so a change to one shows here.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "diffvm.h"
+
+typedef struct {
+    const char* name;
+    core_lower_fn lower;
+    core_exec_fn exec;
+    unsigned unfit;         // facts the core has other semantics for
+} core_t;
+
+static core_t cores[] = {
+    { "vm1",          vm1_lower,  vm1_exec,        0            },
+    { "vm2",          vm2_lower,  vm2_exec,        0            },
+    { "vm3",          vm3_lower,  vm3_exec,        0            },
+    { "vm3 fused",    vm3_lower,  vm3_exec_fused,  0            },
+    { "vm3t",         vm3t_lower, vm3t_exec,       0            },
+    { "vm3t fused",   vm3t_lower, vm3t_exec_fused, 0            },
+    { "vm4",          vm4_lower,  vm4_exec,        FACT_NEGSKIP },
+    { "sap step",     sap_lower,  sap_exec_step,   FACT_WIDE    },
+    { "sap cached",   sap_lower,  sap_exec_cached, FACT_WIDE    },
+    { "sap fast",     sap_lower,  sap_exec_fast,   FACT_WIDE    },
+};
+#define CORES ((int) (sizeof(cores) / sizeof(cores[0])))
+
+// Workloads
+
+typedef struct {
+    const char* name;
+    ir_t p[IR_MAX];
+    int n;
+} workload_t;
+
+static void op(workload_t* w, ir_op_t o, int arg) {
+    w->p[w->n].op = o;
+    w->p[w->n].arg = arg;
+    w->n++;
+}
+
+// 0 + 1 + ... + 60
+static void sum(workload_t* w) {
+    op(w, IR_PUSH, 0);
+    for (int i = 1; i <= 60; i++) {
+        op(w, IR_PUSH, i);
+        op(w, IR_ADD, 0);
+    }
+}
+
+// x * 3 - 2 from 1, which stays 1
+static void arith(workload_t* w) {
+    op(w, IR_PUSH, 1);
+    for (int i = 0; i < 30; i++) {
+        op(w, IR_PUSH, 3);
+        op(w, IR_MUL, 0);
+        op(w, IR_PUSH, 2);
+        op(w, IR_SUB, 0);
+    }
+}
+
+// DUP and DROP around INC and DEC
+static void stack(workload_t* w) {
+    op(w, IR_PUSH, 1);
+    for (int i = 0; i < 15; i++) {
+        op(w, IR_DUP, 0);
+        op(w, IR_INC, 0);
+        op(w, IR_DROP, 0);
+        op(w, IR_INC, 0);
+        op(w, IR_DUP, 0);
+        op(w, IR_DEC, 0);
+        op(w, IR_DROP, 0);
+        op(w, IR_DEC, 0);
+    }
+}
+
+// a skip taken and one not, on a positive count
+static void branch(workload_t* w) {
+    op(w, IR_PUSH, 1);
+    for (int i = 0; i < 15; i++) {
+        op(w, IR_DUP, 0);
+        op(w, IR_SKIPZ, 0);
+        op(w, IR_INC, 0);
+        op(w, IR_END, 0);
+        op(w, IR_DUP, 0);
+        op(w, IR_SKIPNZ, 0);
+        op(w, IR_DEC, 0);
+        op(w, IR_END, 0);
+    }
+}
+
+static void (*builders[])(workload_t*) = { sum, arith, stack, branch };
+static const char* workload_names[] = { "sum", "arith", "stack", "branch" };
+#define WORKLOADS ((int) (sizeof(builders) / sizeof(builders[0])))
+
+// Timing
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void clear(core_result_t* r) {
+    r->failed = false;
+    r->message[0] = '\0';
+    r->nout = 0;
+    r->depth = 0;
+}
+
+// seconds for k runs
+static double batch(int c, int* code, int len, long k, core_result_t* r) {
+    double t0 = now();
+    for (long i = 0; i < k; i++) {
+        clear(r);
+        cores[c].exec(code, len, r);
+    }
+    return now() - t0;
+}
+
+static int by_value(const void* a, const void* b) {
+    double x = *(const double*) a, y = *(const double*) b;
+    return (x > y) - (x < y);
+}
+
+static double median(double* v, int n) {
+    qsort(v, n, sizeof(double), by_value);
+    return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+static bool same(const core_result_t* want, const core_result_t* got) {
+    return !got->failed && got->nout == want->nout
+        && memcmp(got->out, want->out, sizeof(int) * (want->nout < CORE_OUT ? want->nout : CORE_OUT)) == 0
+        && got->depth == want->depth
+        && memcmp(got->stack, want->stack, sizeof(int) * want->depth) == 0;
+}
+
+// Results, and the baseline they are held against
+
+typedef struct {
+    int workload, core;
+    double median_ns, mad_ns;   // per run
+    long runs;                  // in a sample
+    int ops;                    // IR instructions in the program
+    bool wrong;
+    double baseline_ns;         // 0 when not in the baseline
+} result_t;
+
+static result_t results[WORKLOADS * CORES];
+static int nresults = 0;
+
+// lines of "workload,core,median_ns,..." as -f csv writes them
+static void read_baseline(const char* filename) {
+    FILE* f = fopen(filename, "r");
+    if (f == NULL) {
+        fprintf(stderr, "Cannot open baseline %s\n", filename);
+        exit(2);
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        char* workload = strtok(line, ",");
+        char* core = strtok(NULL, ",");
+        char* ns = strtok(NULL, ",");
+        if (workload == NULL || core == NULL || ns == NULL)
+            continue;
+        for (int i = 0; i < nresults; i++) {
+            result_t* r = &results[i];
+            if (strcmp(workload_names[r->workload], workload) == 0
+                    && strcmp(cores[r->core].name, core) == 0)
+                r->baseline_ns = atof(ns);
+        }
+    }
+    fclose(f);
+}
+
+static bool regressed(const result_t* r, double tolerance) {
+    return r->baseline_ns > 0 && r->median_ns > r->baseline_ns * (1 + tolerance / 100);
+}
+
+static void print_table(bool baseline, double tolerance) {
+    printf("%-8s %-12s %10s %8s %8s %10s", "program", "core", "ns/run", "mad", "ns/op", "runs");
+    if (baseline)
+        printf(" %10s", "baseline");
+    printf("\n");
+    for (int i = 0; i < nresults; i++) {
+        result_t* r = &results[i];
+        printf("%-8s %-12s %10.1f %8.1f %8.2f %10ld", workload_names[r->workload],
+               cores[r->core].name, r->median_ns, r->mad_ns, r->median_ns / r->ops, r->runs);
+        if (baseline && r->baseline_ns > 0)
+            printf(" %9.0f%%%s", 100 * (r->median_ns / r->baseline_ns - 1),
+                   regressed(r, tolerance) ? " slower" : "");
+        printf("%s\n", r->wrong ? "  WRONG" : "");
+    }
+}
+
+static void print_csv(void) {
+    printf("workload,core,median_ns,mad_ns,ns_per_op,runs_per_sample,correct,baseline_ns\n");
+    for (int i = 0; i < nresults; i++) {
+        result_t* r = &results[i];
+        printf("%s,%s,%.2f,%.2f,%.3f,%ld,%d,%.2f\n", workload_names[r->workload],
+               cores[r->core].name, r->median_ns, r->mad_ns, r->median_ns / r->ops,
+               r->runs, !r->wrong, r->baseline_ns);
+    }
+}
+
+static void print_json(double tolerance) {
+    printf("[\n");
+    for (int i = 0; i < nresults; i++) {
+        result_t* r = &results[i];
+        printf("  {\"workload\": \"%s\", \"core\": \"%s\", \"median_ns\": %.2f, "
+               "\"mad_ns\": %.2f, \"ns_per_op\": %.3f, \"runs_per_sample\": %ld, "
+               "\"correct\": %s", workload_names[r->workload], cores[r->core].name,
+               r->median_ns, r->mad_ns, r->median_ns / r->ops, r->runs,
+               r->wrong ? "false" : "true");
+        if (r->baseline_ns > 0)
+            printf(", \"baseline_ns\": %.2f, \"regressed\": %s", r->baseline_ns,
+                   regressed(r, tolerance) ? "true" : "false");
+        printf("}%s\n", i + 1 < nresults ? "," : "");
+    }
+    printf("]\n");
+}
+
+int main(int argc, char** argv) {
+    const char* format = "table";
+    const char* baseline = NULL;
+    int samples = 15, warmup = 3;
+    double min_time = 0.005, tolerance = 10;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "f:n:w:m:b:t:")) != -1) {
+        switch (opt) {
+            case 'f': format = optarg; break;
+            case 'n': samples = atoi(optarg); break;
+            case 'w': warmup = atoi(optarg); break;
+            case 'm': min_time = atof(optarg) / 1000; break;
+            case 'b': baseline = optarg; break;
+            case 't': tolerance = atof(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-f table|csv|json] [-n samples] [-w warmup] "
+                        "[-m ms] [-b baseline.csv] [-t percent]\n", argv[0]);
+                return 2;
+        }
+    }
+    if (samples < 1)
+        samples = 1;
+    if (strcmp(format, "table") != 0 && strcmp(format, "csv") != 0
+            && strcmp(format, "json") != 0) {
+        fprintf(stderr, "Unknown format %s\n", format);
+        return 2;
+    }
+
+    double* t = malloc(sizeof(double) * samples);
+    double* dev = malloc(sizeof(double) * samples);
+    if (t == NULL || dev == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 2;
+    }
+
+    for (int w = 0; w < WORKLOADS; w++) {
+        workload_t work = { workload_names[w], {{ 0 }}, 0 };
+        builders[w](&work);
+        core_result_t want, got;
+        if (!ir_valid(work.p, work.n)) {
+            fprintf(stderr, "Program %s is not valid\n", work.name);
+            return 2;
+        }
+        unsigned facts = ir_model(work.p, work.n, &want);
+
+        for (int c = 0; c < CORES; c++) {
+            static int code[CORE_CODE];
+            if (facts & cores[c].unfit)
+                continue;
+            int len = cores[c].lower(work.p, work.n, code, CORE_CODE);
+            if (len < 0)
+                continue;
+
+            // double the batch until it is long enough to time
+            long k = 1;
+            while (batch(c, code, len, k, &got) < min_time && k < (1L << 30))
+                k *= 2;
+            for (int i = 0; i < warmup; i++)
+                batch(c, code, len, k, &got);
+            for (int i = 0; i < samples; i++)
+                t[i] = batch(c, code, len, k, &got) / k * 1e9;
+
+            result_t* r = &results[nresults++];
+            r->workload = w;
+            r->core = c;
+            r->median_ns = median(t, samples);
+            for (int i = 0; i < samples; i++)
+                dev[i] = t[i] > r->median_ns ? t[i] - r->median_ns : r->median_ns - t[i];
+            r->mad_ns = median(dev, samples);
+            r->runs = k;
+            r->ops = work.n;
+            r->wrong = !same(&want, &got);
+            r->baseline_ns = 0;
+        }
+    }
+    free(t);
+    free(dev);
+
+    if (baseline)
+        read_baseline(baseline);
+    if (strcmp(format, "csv") == 0)
+        print_csv();
+    else if (strcmp(format, "json") == 0)
+        print_json(tolerance);
+    else
+        print_table(baseline != NULL, tolerance);
+
+    int failed = 0;
+    for (int i = 0; i < nresults; i++)
+        if (results[i].wrong || regressed(&results[i], tolerance))
+            failed = 1;
+    return failed;
+}
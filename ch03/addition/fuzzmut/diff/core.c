@@ -0,0 +1,147 @@
+// The parts of the harness the cores and the programs share, for
+// diffvm and benchvm
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <string.h>
+#include "diffvm.h"
+
+// Capture, for the cores
+
+core_result_t* core_current = NULL;
+jmp_buf core_escape;
+
+int core_printf(const char* format, ...) {
+    core_result_t* r = core_current;
+    va_list args;
+    va_start(args, format);
+    if (strcmp(format, "%d\n") == 0 || strcmp(format, "PRINT: %d\n") == 0) {
+        int v = va_arg(args, int);
+        if (r->nout < CORE_OUT)
+            r->out[r->nout] = v;
+        r->nout++;
+    } else {
+        // anything else a VM prints is it giving up
+        r->failed = true;
+        vsnprintf(r->message, sizeof(r->message), format, args);
+        r->message[strcspn(r->message, "\n")] = '\0';
+    }
+    va_end(args);
+    return 0;
+}
+
+void core_exit(int status) {
+    core_current->failed = true;
+    if (core_current->message[0] == '\0')
+        snprintf(core_current->message, sizeof(core_current->message), "exit(%d)", status);
+    longjmp(core_escape, 1);
+}
+
+void core_take_stack(core_result_t* r, const int* stack, int count) {
+    if (count < 0 || count > IR_DEPTH) {
+        r->failed = true;
+        snprintf(r->message, sizeof(r->message), "stack depth %d", count);
+        count = 0;
+    }
+    memcpy(r->stack, stack, sizeof(int) * count);
+    r->depth = count;
+}
+
+// Programs
+
+// Checks the depth at each instruction and that blocks balance, which
+// is what every lowering takes for granted
+bool ir_valid(const ir_t* p, int n) {
+    int open[IR_MAX], nopen = 0;
+    int d = 0;
+    for (int i = 0; i < n; i++) {
+        switch (p[i].op) {
+            case IR_PUSH:
+                if (p[i].arg < -IR_IMM - 1 || p[i].arg > IR_IMM) return false;
+                d++;
+                break;
+            case IR_DUP:
+                if (d < 1) return false;
+                d++;
+                break;
+            case IR_ADD: case IR_SUB: case IR_MUL: case IR_EQ:
+                if (d < 2) return false;
+                d--;
+                break;
+            case IR_INC: case IR_DEC: case IR_EQZ:
+                if (d < 1) return false;
+                break;
+            case IR_DROP: case IR_PRINT:
+                if (d < 1) return false;
+                d--;
+                break;
+            case IR_SKIPZ: case IR_SKIPNZ:
+                if (d < 1) return false;
+                open[nopen++] = --d;
+                break;
+            case IR_END:
+                if (nopen == 0 || open[--nopen] != d) return false;
+                break;
+            default:
+                return false;
+        }
+        if (d > IR_DEPTH) return false;
+    }
+    return nopen == 0;
+}
+
+// What the program should do: 32-bit wrapping arithmetic, as the VMs
+// built with -fwrapv
+unsigned ir_model(const ir_t* p, int n, core_result_t* r) {
+    uint32_t s[IR_DEPTH];
+    int end[IR_MAX], open[IR_MAX], nopen = 0;
+    unsigned facts = 0;
+    int d = 0;
+
+    for (int i = 0; i < n; i++) {
+        if (p[i].op == IR_SKIPZ || p[i].op == IR_SKIPNZ)
+            open[nopen++] = i;
+        else if (p[i].op == IR_END)
+            end[open[--nopen]] = i;
+    }
+
+    memset(r, 0, sizeof(*r));
+    for (int i = 0; i < n; i++) {
+        uint32_t a, b;
+        switch (p[i].op) {
+            case IR_PUSH:  s[d++] = (uint32_t) p[i].arg; break;
+            case IR_ADD:   b = s[--d]; a = s[d - 1]; s[d - 1] = a + b; break;
+            case IR_SUB:   b = s[--d]; a = s[d - 1]; s[d - 1] = a - b; break;
+            case IR_MUL:   b = s[--d]; a = s[d - 1]; s[d - 1] = a * b; break;
+            case IR_INC:   s[d - 1]++; break;
+            case IR_DEC:   s[d - 1]--; break;
+            case IR_DUP:   s[d] = s[d - 1]; d++; break;
+            case IR_DROP:  d--; break;
+            case IR_EQ:    b = s[--d]; s[d - 1] = s[d - 1] == b; break;
+            case IR_EQZ:   s[d - 1] = s[d - 1] == 0; break;
+            case IR_PRINT:
+                if (r->nout < CORE_OUT)
+                    r->out[r->nout] = (int) s[d - 1];
+                r->nout++;
+                d--;
+                break;
+            case IR_SKIPZ:
+            case IR_SKIPNZ:
+                a = s[--d];
+                if ((int32_t) a < 0)
+                    facts |= FACT_NEGSKIP;
+                if ((a == 0) == (p[i].op == IR_SKIPZ))
+                    i = end[i];
+                break;
+            default:
+                break;
+        }
+        if (d > 0 && (int32_t) s[d - 1] != (int16_t) s[d - 1])
+            facts |= FACT_WIDE;
+    }
+    for (int i = 0; i < d; i++)
+        r->stack[i] = (int) s[i];
+    r->depth = d;
+    return facts;
+}
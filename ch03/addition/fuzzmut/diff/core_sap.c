@@ -0,0 +1,168 @@
+// The SAP VM (ch03/addition/sap): an accumulator machine with 16-bit
+// words, so the stack is compiled away. Each depth is a memory cell; the
+// depth at every point is known when lowering. PRINT appends to an
+// output buffer through a pointer cell.
+//
+// Run three ways: a vm_step() at a time, through the translation cache
+// (which any breakpoint selects), and the fast path of vm_run_quiet()
+#include <stdio.h>
+#include <string.h>
+#include "diffvm.h"
+#include "../../sap/sap_vm.h"
+#include "../../sap/sap_vm_config.h"
+
+#define SAP_SLOTS 0x300         // stack cells
+#define SAP_OUTP  (SAP_SLOTS + IR_DEPTH)
+#define SAP_OUT   (SAP_OUTP + 1)
+#define SAP_CYCLES 100000
+
+// the stack depth at HALT, known once the program is lowered
+static int end_depth = 0;
+
+#define I(op, mode, v) (vm_encode_instruction((op), (mode), (uint16_t) ((v) & OPERAND_MASK)))
+#define EMIT(op, mode, v) do { int w = I(op, mode, v); code[len++] = w; } while (0)
+#define SLOT(d) (SAP_SLOTS + (d))
+
+int sap_lower(const ir_t* p, int n, int* code, int cap) {
+    int open[IR_MAX], nopen = 0;
+    int len = 0, d = 0;
+    if (cap > SAP_SLOTS)
+        cap = SAP_SLOTS;
+    for (int i = 0; i < n; i++) {
+        if (len + 7 > cap)
+            return -1;
+        switch (p[i].op) {
+            case IR_PUSH:
+                EMIT(OP_LDA, ADDR_IMMEDIATE, p[i].arg);
+                EMIT(OP_STA, ADDR_DIRECT, SLOT(d));
+                d++;
+                break;
+            case IR_ADD:
+            case IR_SUB:
+            case IR_MUL:
+                EMIT(OP_LDA, ADDR_DIRECT, SLOT(d - 2));
+                EMIT(p[i].op == IR_ADD ? OP_ADD : p[i].op == IR_SUB ? OP_SUB : OP_MUL,
+                     ADDR_DIRECT, SLOT(d - 1));
+                EMIT(OP_STA, ADDR_DIRECT, SLOT(d - 2));
+                d--;
+                break;
+            case IR_INC:
+            case IR_DEC:
+                EMIT(OP_LDA, ADDR_DIRECT, SLOT(d - 1));
+                EMIT(p[i].op == IR_INC ? OP_ADD : OP_SUB, ADDR_IMMEDIATE, 1);
+                EMIT(OP_STA, ADDR_DIRECT, SLOT(d - 1));
+                break;
+            case IR_DUP:
+                EMIT(OP_LDA, ADDR_DIRECT, SLOT(d - 1));
+                EMIT(OP_STA, ADDR_DIRECT, SLOT(d));
+                d++;
+                break;
+            case IR_DROP:
+                d--;
+                break;
+            case IR_EQ:
+            case IR_EQZ:
+                // acc = (a == b) as 1 or 0, then stored over the operands
+                if (p[i].op == IR_EQ) {
+                    EMIT(OP_LDA, ADDR_DIRECT, SLOT(d - 2));
+                    EMIT(OP_CMP, ADDR_DIRECT, SLOT(d - 1));
+                    d--;
+                } else {
+                    EMIT(OP_LDA, ADDR_DIRECT, SLOT(d - 1));
+                }
+                EMIT(OP_JNZ, ADDR_DIRECT, len + 3);
+                EMIT(OP_LDA, ADDR_IMMEDIATE, 1);
+                EMIT(OP_JMP, ADDR_DIRECT, len + 2);
+                EMIT(OP_LDA, ADDR_IMMEDIATE, 0);
+                EMIT(OP_STA, ADDR_DIRECT, SLOT(d - 1));
+                break;
+            case IR_PRINT:
+                EMIT(OP_LDA, ADDR_DIRECT, SLOT(d - 1));
+                EMIT(OP_STA, ADDR_INDIRECT, SAP_OUTP);
+                EMIT(OP_LDA, ADDR_DIRECT, SAP_OUTP);
+                EMIT(OP_ADD, ADDR_IMMEDIATE, 1);
+                EMIT(OP_STA, ADDR_DIRECT, SAP_OUTP);
+                d--;
+                break;
+            case IR_SKIPZ:
+            case IR_SKIPNZ:
+                EMIT(OP_LDA, ADDR_DIRECT, SLOT(d - 1));
+                open[nopen++] = len;
+                EMIT(p[i].op == IR_SKIPZ ? OP_JZ : OP_JNZ, ADDR_DIRECT, 0);
+                d--;
+                break;
+            case IR_END: {
+                int at = open[--nopen];
+                code[at] = I(code[at] >> OPCODE_SHIFT, ADDR_DIRECT, len);
+                break;
+            }
+            default:
+                return -1;
+        }
+    }
+    if (len + 1 > cap)
+        return -1;
+    EMIT(OP_RTS, ADDR_IMMEDIATE, 1);    // RTS with an exit code halts
+    end_depth = d;
+    return len;
+}
+
+static void load(sap_vm_t* vm, bool* ready, const int* code, int len) {
+    if (!*ready) {
+        vm_init(vm);
+        vm->debug_enabled = false;
+        *ready = true;
+    }
+    vm_reset(vm);
+    for (int i = 0; i < len; i++)
+        vm->memory[i] = (int16_t) code[i];
+    vm->memory[SAP_OUTP] = SAP_OUT;
+}
+
+static void collect(sap_vm_t* vm, result_t result, core_result_t* r) {
+    if (result != RESULT_HALT) {
+        r->failed = true;
+        snprintf(r->message, sizeof(r->message), "%.90s",
+                 result == RESULT_ERROR ? vm->last_error : "did not halt");
+    }
+    int nout = vm->memory[SAP_OUTP] - SAP_OUT;
+    if (nout < 0 || nout > CORE_OUT) {
+        r->failed = true;
+        snprintf(r->message, sizeof(r->message), "output pointer %d", vm->memory[SAP_OUTP]);
+        nout = 0;
+    }
+    for (int i = 0; i < nout; i++)
+        r->out[i] = vm->memory[SAP_OUT + i];
+    r->nout = nout;
+    int stack[IR_DEPTH];
+    for (int i = 0; i < end_depth; i++)
+        stack[i] = vm->memory[SLOT(i)];
+    core_take_stack(r, stack, end_depth);
+}
+
+void sap_exec_step(int* code, int len, core_result_t* r) {
+    static sap_vm_t vm;
+    static bool ready = false;
+    load(&vm, &ready, code, len);
+    vm.state = VM_RUNNING;
+    result_t result = RESULT_OK;
+    for (int i = 0; i < SAP_CYCLES && result == RESULT_OK; i++)
+        result = vm_step(&vm);
+    collect(&vm, result, r);
+}
+
+void sap_exec_cached(int* code, int len, core_result_t* r) {
+    static sap_vm_t vm;
+    static bool ready = false;
+    load(&vm, &ready, code, len);
+    if (vm.breakpoint_count == 0)
+        vm_add_breakpoint(&vm, STACK_TOP);  // never reached
+    collect(&vm, vm_run_quiet(&vm, SAP_CYCLES), r);
+}
+
+void sap_exec_fast(int* code, int len, core_result_t* r) {
+    static sap_vm_t vm;
+    static bool ready = false;
+    load(&vm, &ready, code, len);
+    collect(&vm, vm_run_quiet(&vm, SAP_CYCLES), r);
+}
@@ -0,0 +1,53 @@
+// vm1 (ch02/sec2.2.3): SET, ADD, SUB, MUL and PRINT, no jumps
+#include <stdio.h>
+#include <stdlib.h>
+#include "diffvm.h"
+
+#define printf core_printf
+#define exit core_exit
+#define newVM vm1_newVM
+#define freeVM vm1_freeVM
+#define pop vm1_pop
+#define push vm1_push
+#define nextcode vm1_nextcode
+#define run vm1_run
+#define program vm1_program
+#define main vm1_main
+#include "../../../../ch02/sec2.2.3/vm1/vm1.c"
+
+int vm1_lower(const ir_t* p, int n, int* code, int cap) {
+    int len = 0;
+    for (int i = 0; i < n; i++) {
+        if (len + 3 > cap)
+            return -1;
+        switch (p[i].op) {
+            case IR_PUSH:  code[len++] = SET; code[len++] = p[i].arg; break;
+            case IR_ADD:   code[len++] = ADD; break;
+            case IR_SUB:   code[len++] = SUB; break;
+            case IR_MUL:   code[len++] = MUL; break;
+            case IR_INC:   code[len++] = SET; code[len++] = 1; code[len++] = ADD; break;
+            case IR_DEC:   code[len++] = SET; code[len++] = 1; code[len++] = SUB; break;
+            case IR_PRINT: code[len++] = PRINT; break;
+            default:
+                return -1;
+        }
+    }
+    if (len + 1 > cap)
+        return -1;
+    code[len++] = HALT;
+    return len;
+}
+
+void vm1_exec(int* code, int len, core_result_t* r) {
+    static VM* vm = NULL;
+    (void) len;
+    if (vm == NULL)
+        vm = newVM(code, 0);
+    vm->code = code;
+    vm->pc = 0;
+    vm->sp = -1;
+    core_current = r;
+    if (setjmp(core_escape) == 0)
+        run(vm);
+    core_take_stack(r, vm->stack, vm->sp + 1);
+}
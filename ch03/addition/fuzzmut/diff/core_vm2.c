@@ -0,0 +1,59 @@
+// vm2 (ch02/sec2.3): adds jumps, comparisons and the Forth stack words
+#include <stdio.h>
+#include <stdlib.h>
+#include "diffvm.h"
+
+#define printf core_printf
+#define exit core_exit
+#define newVM vm2_newVM
+#define freeVM vm2_freeVM
+#define pop vm2_pop
+#define push vm2_push
+#define nextcode vm2_nextcode
+#define run vm2_run
+#include "../../../../ch02/sec2.3/vm2/vm2.c"
+
+int vm2_lower(const ir_t* p, int n, int* code, int cap) {
+    int open[IR_MAX], nopen = 0;    // jump operands waiting for their END
+    int len = 0;
+    for (int i = 0; i < n; i++) {
+        if (len + 2 > cap)
+            return -1;
+        switch (p[i].op) {
+            case IR_PUSH:   code[len++] = SET; code[len++] = p[i].arg; break;
+            case IR_ADD:    code[len++] = ADD; break;
+            case IR_SUB:    code[len++] = SUB; break;
+            case IR_MUL:    code[len++] = MUL; break;
+            case IR_INC:    code[len++] = INC; break;
+            case IR_DEC:    code[len++] = DEC; break;
+            case IR_DUP:    code[len++] = DUP; break;
+            case IR_DROP:   code[len++] = DROP; break;
+            case IR_EQ:     code[len++] = EQ; break;
+            case IR_EQZ:    code[len++] = EQZ; break;
+            case IR_PRINT:  code[len++] = PRINT; break;
+            case IR_SKIPZ:  code[len++] = JPZ; open[nopen++] = len++; break;
+            case IR_SKIPNZ: code[len++] = JPNZ; open[nopen++] = len++; break;
+            case IR_END:    code[open[--nopen]] = len; break;
+            default:
+                return -1;
+        }
+    }
+    if (len + 1 > cap)
+        return -1;
+    code[len++] = HALT;
+    return len;
+}
+
+void vm2_exec(int* code, int len, core_result_t* r) {
+    static VM* vm = NULL;
+    (void) len;
+    if (vm == NULL)
+        vm = newVM(code, 0, 1);
+    vm->code = code;
+    vm->pc = 0;
+    vm->sp = -1;
+    core_current = r;
+    if (setjmp(core_escape) == 0)
+        run(vm);
+    core_take_stack(r, vm->stack, vm->sp + 1);
+}
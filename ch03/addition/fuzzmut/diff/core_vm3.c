@@ -0,0 +1,81 @@
+// vm3 (ch02/sec2.4), as its switch, or direct threaded when this is
+// included by core_vm3t.c; both with and without fuse()
+#include <stdio.h>
+#include <stdlib.h>
+#include "diffvm.h"
+
+#ifdef VM3_THREADED
+#define CORE(name) vm3t_##name
+#else
+#define CORE(name) vm3_##name
+#endif
+
+#define printf core_printf
+#define fprintf(stream, ...) core_printf(__VA_ARGS__)
+#define exit core_exit
+#define newVM CORE(newVM)
+#define newVMSized CORE(newVMSized)
+#define freeVM CORE(freeVM)
+#define pop CORE(pop)
+#define push CORE(push)
+#define nextcode CORE(nextcode)
+#define print_stack CORE(print_stack)
+#define print_vm_state CORE(print_vm_state)
+#define fusion_rules CORE(fusion_rules)
+#define fuse CORE(fuse)
+#define print_fusion_stats CORE(print_fusion_stats)
+#define run CORE(run)
+#include "../../../../ch02/sec2.4/vm3/vm3.c"
+
+// LT and NOP are unknown to vm3, so neither is used
+int CORE(lower)(const ir_t* p, int n, int* code, int cap) {
+    int open[IR_MAX], nopen = 0;
+    int len = 0;
+    for (int i = 0; i < n; i++) {
+        if (len + 2 > cap)
+            return -1;
+        switch (p[i].op) {
+            case IR_PUSH:   code[len++] = SET; code[len++] = p[i].arg; break;
+            case IR_ADD:    code[len++] = ADD; break;
+            case IR_SUB:    code[len++] = SUB; break;
+            case IR_MUL:    code[len++] = MUL; break;
+            case IR_INC:    code[len++] = INC; break;
+            case IR_DEC:    code[len++] = DEC; break;
+            case IR_DUP:    code[len++] = DUP; break;
+            case IR_DROP:   code[len++] = DROP; break;
+            case IR_EQ:     code[len++] = EQ; break;
+            case IR_EQZ:    code[len++] = EQZ; break;
+            case IR_PRINT:  code[len++] = PRINT; break;
+            case IR_SKIPZ:  code[len++] = JPZ; open[nopen++] = len++; break;
+            case IR_SKIPNZ: code[len++] = JPNZ; open[nopen++] = len++; break;
+            case IR_END:    code[open[--nopen]] = len; break;
+            default:
+                return -1;
+        }
+    }
+    if (len + 1 > cap)
+        return -1;
+    code[len++] = HALT;
+    return len;
+}
+
+static VM* vm = NULL;
+
+void CORE(exec)(int* code, int len, core_result_t* r) {
+    (void) len;
+    if (vm == NULL)
+        vm = newVM(code, 0);
+    vm->code = code;
+    vm->pc = 0;
+    vm->sp = -1;
+    vm->fp = 0;
+    core_current = r;
+    if (setjmp(core_escape) == 0)
+        run(vm);
+    core_take_stack(r, vm->stack, vm->sp + 1);
+}
+
+void CORE(exec_fused)(int* code, int len, core_result_t* r) {
+    fuse(code, len, 0);
+    CORE(exec)(code, len, r);
+}
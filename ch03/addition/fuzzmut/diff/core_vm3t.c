@@ -0,0 +1,3 @@
+// vm3 with direct-threaded dispatch
+#define VM3_THREADED
+#include "core_vm3.c"
@@ -0,0 +1,96 @@
+// vm4 (ch02/sec2.4.4): frames with locals, and JZ, which jumps on <= 0
+#include <stdio.h>
+#include <stdlib.h>
+#include "diffvm.h"
+
+#define printf core_printf
+#define exit core_exit
+#define message vm4_message
+#define error vm4_error
+#define next vm4_next
+#define operands vm4_operands
+#define localCount vm4_localCount
+#define initFrameStack vm4_initFrameStack
+#define arenaTop vm4_arenaTop
+#define reserve vm4_reserve
+#define pushFrame vm4_pushFrame
+#define popFrame vm4_popFrame
+#define getFrame vm4_getFrame
+#define frameLocals vm4_frameLocals
+#define frameStack vm4_frameStack
+#define push vm4_push
+#define pop vm4_pop
+#define store vm4_store
+#define load vm4_load
+#define transferStackToLocals vm4_transferStackToLocals
+#define transferStackToReturnValue vm4_transferStackToReturnValue
+#define newVM vm4_newVM
+#define freeVM vm4_freeVM
+#define run vm4_run
+#define main vm4_main
+#include "../../../../ch02/sec2.4.4/vm4/vm4.c"
+
+// JZ stands in for both skips, which is exact only for conditions that
+// are not negative: the harness runs vm4 on no other programs. DUP goes
+// through local 0 of the main frame
+int vm4_lower(const ir_t* p, int n, int* code, int cap) {
+    int open[IR_MAX], nopen = 0;
+    int len = 0;
+    for (int i = 0; i < n; i++) {
+        if (len + 5 > cap)
+            return -1;
+        switch (p[i].op) {
+            case IR_PUSH:  code[len++] = PUSH; code[len++] = p[i].arg; break;
+            case IR_ADD:   code[len++] = ADD; break;
+            case IR_SUB:   code[len++] = SUB; break;
+            case IR_MUL:   code[len++] = MUL; break;
+            case IR_INC:   code[len++] = PUSH; code[len++] = 1; code[len++] = ADD; break;
+            case IR_DEC:   code[len++] = PUSH; code[len++] = 1; code[len++] = SUB; break;
+            case IR_DUP:
+                code[len++] = ST; code[len++] = 0;
+                code[len++] = LD; code[len++] = 0;
+                code[len++] = LD; code[len++] = 0;
+                break;
+            case IR_DROP:  code[len++] = POP; break;
+            case IR_PRINT: code[len++] = PRINT; break;
+            case IR_SKIPZ: code[len++] = JZ; open[nopen++] = len++; break;
+            case IR_SKIPNZ:
+                // zero falls into the block, anything else jumps past it
+                code[len++] = JZ; code[len] = len + 5; len++;
+                code[len++] = PUSH; code[len++] = 0;
+                code[len++] = JZ; open[nopen++] = len++;
+                break;
+            case IR_END:   code[open[--nopen]] = len; break;
+            default:
+                return -1;
+        }
+    }
+    if (len + 1 > cap)
+        return -1;
+    code[len++] = HALT;
+    return len;
+}
+
+void vm4_exec(int* code, int len, core_result_t* r) {
+    // error() frees the VM before it exits, so after that it is gone
+    VM* volatile vm = newVM(code, len);
+    if (vm == NULL) {
+        r->failed = true;
+        return;
+    }
+    vm->debug = 0;
+    core_current = r;
+    if (setjmp(core_escape) == 0) {
+        pushFrame(vm, localCount(vm, 0));
+        run(vm);
+    } else {
+        return;
+    }
+    FrameStack* fs = &vm->fstack;
+    if (fs->fp >= 0) {
+        Frame* top = &fs->frames[fs->fp];
+        core_take_stack(r, frameStack(vm, top), top->sp + 1);
+    }
+    if (setjmp(core_escape) == 0)
+        freeVM(vm);
+}
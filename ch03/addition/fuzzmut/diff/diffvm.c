@@ -0,0 +1,358 @@
+/*
+ * diffvm.c
+ *   gcc -std=gnu11 -O2 -fwrapv -o diffvm diffvm.c core.c core_vm1.c core_vm2.c \
+ *       core_vm3.c core_vm3t.c core_vm4.c core_sap.c \
+ *       ../../sap/sap_vm.c ../../sap/sap_vm_debug_support.c \
+ *       ../../sap/sap_vm_image.c ../../sap/sap_vm_trace.c
+ *   -fsanitize=address,undefined
+ *
+ *   ./diffvm [programs] [seed]
+ *
+ * Differential fuzzing of the stack VMs in ch02 and the SAP VM: random
+ * programs in the subset they share go through every core that can
+ * express them, in this process, and each result is held against a
+ * model. A core that prints something else, leaves another stack, or
+ * fails, has its program cut down to the smallest that still does so.
+ *
+ * -fwrapv because the VMs compute in plain int, and overflow is part of
+ * what the programs do.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "diffvm.h"
+
+typedef struct {
+    const char* name;
+    core_lower_fn lower;
+    core_exec_fn exec;
+    unsigned unfit;         // facts the core has other semantics for
+    unsigned long runs;
+    unsigned long diverged;
+} core_t;
+
+static core_t cores[] = {
+    { "vm1",          vm1_lower,  vm1_exec,        0,            0, 0 },
+    { "vm2",          vm2_lower,  vm2_exec,        0,            0, 0 },
+    { "vm3",          vm3_lower,  vm3_exec,        0,            0, 0 },
+    { "vm3 fused",    vm3_lower,  vm3_exec_fused,  0,            0, 0 },
+    { "vm3t",         vm3t_lower, vm3t_exec,       0,            0, 0 },
+    { "vm3t fused",   vm3t_lower, vm3t_exec_fused, 0,            0, 0 },
+    { "vm4",          vm4_lower,  vm4_exec,        FACT_NEGSKIP, 0, 0 },
+    { "sap step",     sap_lower,  sap_exec_step,   FACT_WIDE,    0, 0 },
+    { "sap cached",   sap_lower,  sap_exec_cached, FACT_WIDE,    0, 0 },
+    { "sap fast",     sap_lower,  sap_exec_fast,   FACT_WIDE,    0, 0 },
+};
+#define CORES ((int) (sizeof(cores) / sizeof(cores[0])))
+
+static const char* ir_names[IR_COUNT] = {
+    "PUSH", "ADD", "SUB", "MUL", "INC", "DEC", "DUP", "DROP",
+    "EQ", "EQZ", "PRINT", "SKIPZ", "SKIPNZ", "END"
+};
+
+#define DIFF_OUTPUT 1
+#define DIFF_STACK  2
+#define DIFF_FAILED 4
+
+static int differs(const core_result_t* want, const core_result_t* got) {
+    if (got->failed)
+        return DIFF_FAILED;
+    int n = want->nout < CORE_OUT ? want->nout : CORE_OUT;
+    if (got->nout != want->nout || memcmp(got->out, want->out, sizeof(int) * n) != 0)
+        return DIFF_OUTPUT;
+    if (got->depth != want->depth
+            || memcmp(got->stack, want->stack, sizeof(int) * want->depth) != 0)
+        return DIFF_STACK;
+    return 0;
+}
+
+// Runs program p on core c against w, the model's result; -1 when the
+// core does not take the program
+static int check(int c, const ir_t* p, int n, unsigned facts,
+                 const core_result_t* w, core_result_t* got) {
+    static int code[CORE_CODE];
+    if (facts & cores[c].unfit)
+        return -1;
+    int len = cores[c].lower(p, n, code, CORE_CODE);
+    if (len < 0)
+        return -1;
+    memset(got, 0, sizeof(*got));
+    cores[c].exec(code, len, got);
+    return differs(w, got);
+}
+
+// Cut a divergent program down while core c still diverges the same way
+static bool still(int c, int kind, const ir_t* p, int n) {
+    core_result_t w, got;
+    if (!ir_valid(p, n))
+        return false;
+    unsigned facts = ir_model(p, n, &w);
+    return check(c, p, n, facts, &w, &got) == kind;
+}
+
+static int matching_end(const ir_t* p, int n, int i) {
+    for (int nest = 0; i < n; i++) {
+        if (p[i].op == IR_SKIPZ || p[i].op == IR_SKIPNZ)
+            nest++;
+        else if (p[i].op == IR_END && --nest == 0)
+            return i;
+    }
+    return -1;
+}
+
+static int minimise(int c, int kind, ir_t* p, int n) {
+    ir_t t[IR_MAX];
+    bool shrunk = true;
+    while (shrunk) {
+        shrunk = false;
+
+        // whole runs of instructions, halving
+        for (int chunk = n / 2; chunk >= 1; chunk /= 2) {
+            for (int i = 0; i + chunk <= n; ) {
+                memcpy(t, p, sizeof(ir_t) * i);
+                memcpy(t + i, p + i + chunk, sizeof(ir_t) * (n - i - chunk));
+                if (still(c, kind, t, n - chunk)) {
+                    n -= chunk;
+                    memcpy(p, t, sizeof(ir_t) * n);
+                    shrunk = true;
+                } else {
+                    i++;
+                }
+            }
+        }
+
+        // a block's body kept, its skip dropped
+        for (int i = 0; i < n; i++) {
+            if (p[i].op != IR_SKIPZ && p[i].op != IR_SKIPNZ)
+                continue;
+            int e = matching_end(p, n, i);
+            memcpy(t, p, sizeof(ir_t) * n);
+            t[i].op = IR_DROP;
+            memmove(t + e, t + e + 1, sizeof(ir_t) * (n - e - 1));
+            if (still(c, kind, t, n - 1)) {
+                n--;
+                memcpy(p, t, sizeof(ir_t) * n);
+                shrunk = true;
+            }
+        }
+
+        // smaller constants
+        for (int i = 0; i < n; i++) {
+            if (p[i].op != IR_PUSH || p[i].arg == 0)
+                continue;
+            int tries[] = { 0, 1, p[i].arg / 2 };
+            for (int k = 0; k < 3; k++) {
+                int old = p[i].arg;
+                if (tries[k] == old || (tries[k] == 1 && old == -1))
+                    continue;
+                p[i].arg = tries[k];
+                if (still(c, kind, p, n)) {
+                    shrunk = true;
+                    break;
+                }
+                p[i].arg = old;
+            }
+        }
+    }
+    return n;
+}
+
+// Generation
+
+typedef struct {
+    uint64_t s;
+} Rng;
+
+static uint64_t rng_next(Rng* r) {
+    r->s ^= r->s >> 12;
+    r->s ^= r->s << 25;
+    r->s ^= r->s >> 27;
+    return r->s * 0x2545F4914F6CDD1DULL;
+}
+
+static int rnd(Rng* r, int n) {
+    return (int) ((rng_next(r) >> 33) % (uint64_t) n);
+}
+
+#define GEN_DEPTH 12        // deepest a generated program goes
+#define GEN_BODY  64        // no new instructions after this many
+#define GEN_NEST  3
+
+// Features come in levels so that the cores with fewer instructions
+// still get programs they can run:
+// 0 arithmetic and PRINT, 1 DUP and DROP, 2 blocks, 3 comparisons
+typedef struct {
+    Rng* rng;
+    int level;
+    ir_t* p;
+    int n;
+} Gen;
+
+static void emit(Gen* g, ir_op_t op, int arg) {
+    g->p[g->n].op = op;
+    g->p[g->n].arg = arg;
+    g->n++;
+}
+
+static int gen_value(Gen* g) {
+    static const int edges[] = { 0, 1, -1, IR_IMM, -IR_IMM - 1, 2, 255, -256 };
+    switch (rnd(g->rng, 10)) {
+        case 0: case 1:
+            return edges[rnd(g->rng, 8)];
+        case 2: case 3: case 4:
+            return rnd(g->rng, 2 * IR_IMM + 2) - IR_IMM - 1;
+        default:
+            return rnd(g->rng, 10);
+    }
+}
+
+// Instructions from depth d, ending at the same depth
+static void gen_block(Gen* g, int d, int nest) {
+    int start = d;
+    int steps = 1 + rnd(g->rng, 16);
+    while (steps-- > 0 && g->n < GEN_BODY) {
+        int pick = rnd(g->rng, 100);
+        if (d == 0 || (pick < 30 && d < GEN_DEPTH)) {
+            emit(g, IR_PUSH, gen_value(g));
+            d++;
+        } else if (pick < 55 && d >= 2) {
+            static const ir_op_t bin[] = { IR_ADD, IR_SUB, IR_MUL, IR_EQ };
+            emit(g, bin[rnd(g->rng, g->level >= 3 ? 4 : 3)], 0);
+            d--;
+        } else if (pick < 65) {
+            static const ir_op_t un[] = { IR_INC, IR_DEC, IR_EQZ };
+            emit(g, un[rnd(g->rng, g->level >= 3 ? 3 : 2)], 0);
+        } else if (pick < 75) {
+            emit(g, IR_PRINT, 0);
+            d--;
+        } else if (pick < 85 && g->level >= 1) {
+            if (rnd(g->rng, 2) && d < GEN_DEPTH) {
+                emit(g, IR_DUP, 0);
+                d++;
+            } else {
+                emit(g, IR_DROP, 0);
+                d--;
+            }
+        } else if (g->level >= 2 && nest < GEN_NEST) {
+            // a condition of 0 or 1 half the time, so both ways are taken
+            if (rnd(g->rng, 2) && d < GEN_DEPTH) {
+                emit(g, IR_PUSH, rnd(g->rng, 2));
+                d++;
+            }
+            emit(g, rnd(g->rng, 2) ? IR_SKIPZ : IR_SKIPNZ, 0);
+            gen_block(g, d - 1, nest + 1);
+            emit(g, IR_END, 0);
+            d--;
+        }
+    }
+    while (d > start) {
+        emit(g, g->level >= 1 && rnd(g->rng, 2) ? IR_DROP : IR_PRINT, 0);
+        d--;
+    }
+    while (d < start) {
+        emit(g, IR_PUSH, gen_value(g));
+        d++;
+    }
+}
+
+static int generate(Rng* rng, ir_t* p) {
+    Gen g = { rng, rnd(rng, 4), p, 0 };
+    int d = rnd(rng, 4);
+    for (int i = 0; i < d; i++)
+        emit(&g, IR_PUSH, gen_value(&g));
+    gen_block(&g, d, 0);
+    return g.n;
+}
+
+// Reports
+
+static void print_program(const ir_t* p, int n) {
+    for (int i = 0; i < n; i++) {
+        printf(" %s", ir_names[p[i].op]);
+        if (p[i].op == IR_PUSH)
+            printf(" %d", p[i].arg);
+    }
+    printf("\n");
+}
+
+static void print_result(const char* name, const core_result_t* r) {
+    printf("  %-10s out:", name);
+    for (int i = 0; i < r->nout && i < CORE_OUT; i++)
+        printf(" %d", r->out[i]);
+    printf("  stack:");
+    for (int i = 0; i < r->depth; i++)
+        printf(" %d", r->stack[i]);
+    if (r->failed)
+        printf("  failed: %s", r->message);
+    printf("\n");
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char** argv) {
+    unsigned long programs = argc > 1 ? strtoul(argv[1], NULL, 10) : 200000;
+    uint64_t seed = argc > 2 ? strtoull(argv[2], NULL, 10) : (uint64_t) time(NULL);
+    Rng rng = { seed * 2 + 1 };
+    bool reported[CORES][DIFF_FAILED + 1] = {{ false }};
+    int distinct = 0;
+
+    printf("Differential fuzzing of %d cores, %lu programs, seed %llu\n",
+           CORES, programs, (unsigned long long) seed);
+
+    double t0 = now();
+    for (unsigned long k = 0; k < programs; k++) {
+        ir_t p[IR_MAX];
+        core_result_t w, got;
+        int n = generate(&rng, p);
+        unsigned facts = ir_model(p, n, &w);
+
+        for (int c = 0; c < CORES; c++) {
+            int kind = check(c, p, n, facts, &w, &got);
+            if (kind < 0)
+                continue;
+            cores[c].runs++;
+            if (kind == 0)
+                continue;
+            cores[c].diverged++;
+            if (reported[c][kind])
+                continue;
+            reported[c][kind] = true;
+            distinct++;
+
+            ir_t m[IR_MAX];
+            memcpy(m, p, sizeof(ir_t) * n);
+            int mn = minimise(c, kind, m, n);
+            facts = ir_model(m, mn, &w);
+            check(c, m, mn, facts, &w, &got);
+            printf("\n%s diverges (%s), program of %d cut to %d:\n  ", cores[c].name,
+                   kind == DIFF_OUTPUT ? "output" : kind == DIFF_STACK ? "stack" : "failed",
+                   n, mn);
+            print_program(m, mn);
+            print_result("model", &w);
+            print_result(cores[c].name, &got);
+
+            // the rest of the cores on the original again
+            facts = ir_model(p, n, &w);
+        }
+    }
+    double elapsed = now() - t0;
+
+    unsigned long runs = 0;
+    printf("\n%-12s %10s %10s\n", "core", "runs", "diverged");
+    for (int c = 0; c < CORES; c++) {
+        printf("%-12s %10lu %10lu\n", cores[c].name, cores[c].runs, cores[c].diverged);
+        runs += cores[c].runs;
+    }
+    printf("%lu programs, %lu runs in %.2fs: %.0fk programs/s, %.0fk runs/s\n",
+           programs, runs, elapsed, programs / elapsed / 1000, runs / elapsed / 1000);
+    printf("%d distinct divergences\n", distinct);
+    return distinct > 0;
+}
@@ -0,0 +1,90 @@
+#ifndef DIFFVM_H
+#define DIFFVM_H
+
+#include <stdbool.h>
+#include <setjmp.h>
+
+// Programs are generated in a small stack language, the subset the VMs
+// share, and each core lowers them into its own bytecode. Blocks only
+// jump forward and leave the stack as deep as they found it, so every
+// program ends, and the depth at each point is known before it runs.
+typedef enum {
+    IR_PUSH,        // arg
+    IR_ADD,
+    IR_SUB,
+    IR_MUL,
+    IR_INC,
+    IR_DEC,
+    IR_DUP,
+    IR_DROP,
+    IR_EQ,
+    IR_EQZ,
+    IR_PRINT,
+    IR_SKIPZ,       // pop, and skip to the matching END if zero
+    IR_SKIPNZ,      // pop, and skip to the matching END if not zero
+    IR_END,
+    IR_COUNT
+} ir_op_t;
+
+typedef struct {
+    ir_op_t op;
+    int arg;
+} ir_t;
+
+#define IR_MAX 128          // instructions in a program
+#define IR_DEPTH 48         // stack depth, under every VM's stack size
+#define IR_IMM 511          // PUSH arguments, the SAP immediate range
+
+#define CORE_OUT 128
+#define CORE_CODE 1024
+
+// What a run leaves: the values printed, and the stack at HALT
+typedef struct {
+    bool failed;            // stopped with an error instead of halting
+    char message[96];
+    int out[CORE_OUT];
+    int nout;
+    int stack[IR_DEPTH];
+    int depth;
+} core_result_t;
+
+// A core lowers a program into its VM's code, -1 when it has no way to
+// say it, and runs that
+typedef int (*core_lower_fn)(const ir_t* p, int n, int* code, int cap);
+typedef void (*core_exec_fn)(int* code, int len, core_result_t* r);
+
+// The VMs print with printf and give up with exit(); the cores send
+// both here instead, so a run stays in the process
+extern core_result_t* core_current;
+extern jmp_buf core_escape;
+int core_printf(const char* format, ...);
+void core_exit(int status) __attribute__((noreturn));
+void core_take_stack(core_result_t* r, const int* stack, int count);
+
+// What a program does, besides its result, that a core may not follow
+#define FACT_WIDE    1      // a value outside 16 bits
+#define FACT_NEGSKIP 2      // a skip on a negative condition
+
+// ir_valid checks the depth at each instruction and that blocks balance;
+// ir_model runs a valid program as it should go, and returns its facts
+bool ir_valid(const ir_t* p, int n);
+unsigned ir_model(const ir_t* p, int n, core_result_t* r);
+
+int vm1_lower(const ir_t* p, int n, int* code, int cap);
+void vm1_exec(int* code, int len, core_result_t* r);
+int vm2_lower(const ir_t* p, int n, int* code, int cap);
+void vm2_exec(int* code, int len, core_result_t* r);
+int vm3_lower(const ir_t* p, int n, int* code, int cap);
+void vm3_exec(int* code, int len, core_result_t* r);
+void vm3_exec_fused(int* code, int len, core_result_t* r);
+int vm3t_lower(const ir_t* p, int n, int* code, int cap);
+void vm3t_exec(int* code, int len, core_result_t* r);
+void vm3t_exec_fused(int* code, int len, core_result_t* r);
+int vm4_lower(const ir_t* p, int n, int* code, int cap);
+void vm4_exec(int* code, int len, core_result_t* r);
+int sap_lower(const ir_t* p, int n, int* code, int cap);
+void sap_exec_step(int* code, int len, core_result_t* r);
+void sap_exec_cached(int* code, int len, core_result_t* r);
+void sap_exec_fast(int* code, int len, core_result_t* r);
+
+#endif // DIFFVM_H
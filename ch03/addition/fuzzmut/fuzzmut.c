@@ -1,14 +1,29 @@
 /*
  * fuzzmut.c
- *   gcc -std=c11 -O2 fuzzmut.c -o vm_test
+ *   gcc -std=c11 -O2 -pthread fuzzmut.c -o vm_test
  *   -fsanitize=address,undefined
+ *
+ *   ./vm_test              fuzz and mutation tests as below
+ *   ./vm_test cov [execs]  coverage-guided fuzzing, against blind fuzzing
+ *   ./vm_test par [workers] [seconds]
+ *                          the same, guided, in parallel threads
+ *   ./vm_test min [-j threads] hex...
+ *                          cut a failing program down to what fails
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #include <time.h>
+#include <signal.h>
+#include <setjmp.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <pthread.h>
 
 /* Opcodes */
 enum {
@@ -41,6 +56,20 @@ enum {
 #define PROGRAM_MAX 1024
 #define PRINT_BUF_MAX 64
 #define STEP_LIMIT 10000
+#define WORKERS_MAX 64
+
+/* Edge coverage: each instruction run counts the edge from the one
+ * before, (prev_pc, prev_op) -> (pc, op), hashed into a map of hit
+ * counts, as AFL does. The edges a run touched are listed as well, so
+ * that neither clearing nor reading the map costs more than the run */
+#define COV_MAP_BITS 16
+#define COV_MAP_SIZE (1u << COV_MAP_BITS)
+
+typedef struct {
+    uint8_t hits[COV_MAP_SIZE];
+    uint16_t touched[STEP_LIMIT];   /* edges with hits, in first-hit order */
+    int count;
+} CovTrace;
 
 typedef struct {
     int32_t stack[STACK_MAX];
@@ -49,15 +78,21 @@ typedef struct {
     size_t prog_len;
     int outputs[PRINT_BUF_MAX];
     int out_count;
+    CovTrace *cov;          /* or NULL: not traced */
 } VM;
 
 void vm_init(VM *vm) {
     vm->sp = 0;
     vm->prog_len = 0;
     vm->out_count = 0;
+    vm->cov = NULL;
     memset(vm->program, 0, PROGRAM_MAX);
 }
 
+static inline uint32_t cov_location(size_t pc, uint8_t op) {
+    return ((uint32_t)pc << 8 | op) * 2654435761u >> (32 - COV_MAP_BITS);
+}
+
 int vm_push(VM *vm, int32_t v) {
     if (vm->sp >= STACK_MAX) return VM_ERR_STACK_OVERFLOW;
     vm->stack[vm->sp++] = v;
@@ -84,9 +119,20 @@ static int32_t read_i32(const uint8_t *prog, size_t len, size_t pc) {
 int vm_run(VM *vm) {
     size_t pc = 0;
     int steps = 0;
+    uint32_t prev = 0;
     while (pc < vm->prog_len) {
         if (++steps > STEP_LIMIT) return VM_ERR_TIMEOUT;
-        uint8_t op = vm->program[pc++];
+        uint8_t op = vm->program[pc];
+        if (vm->cov) {
+            /* shifted, so that A -> B and B -> A are different edges */
+            uint32_t cur = cov_location(pc, op);
+            uint32_t edge = cur ^ prev;
+            uint8_t *hits = &vm->cov->hits[edge];
+            if (*hits == 0) vm->cov->touched[vm->cov->count++] = (uint16_t)edge;
+            if (*hits < 255) (*hits)++;
+            prev = cur >> 1;
+        }
+        pc++;
         int32_t a, b;
         int rc;
         switch (op) {
@@ -167,8 +213,22 @@ int vm_run(VM *vm) {
     return VM_ERR_PC_OOB;
 }
 
-/* helpers for random generation */
-static int rnd_int(int a, int b) { return a + rand() % (b - a + 1); }
+/* helpers for random generation: xorshift64*, one state to each user,
+ * as rand() is one state shared by every thread */
+typedef struct { uint64_t s; } Rng;
+
+static uint32_t rng_next(Rng *r) {
+    r->s ^= r->s >> 12;
+    r->s ^= r->s << 25;
+    r->s ^= r->s >> 27;
+    return (uint32_t)((r->s * 2685821657736338717ull) >> 32);
+}
+
+static void rng_seed(Rng *r, uint64_t seed) {
+    r->s = seed ? seed : 0x9E3779B97F4A7C15ull;
+}
+
+static int rnd_int(Rng *r, int a, int b) { return a + (int)(rng_next(r) % (uint32_t)(b - a + 1)); }
 
 void vm_emit_push(VM *vm, int32_t val) {
     if (vm->prog_len + 5 > PROGRAM_MAX) return;
@@ -179,16 +239,16 @@ void vm_emit_push(VM *vm, int32_t val) {
     vm->program[vm->prog_len++] = (uint8_t)((val >> 24) & 0xFF);
 }
 
-void vm_random_program(VM *vm, size_t max_len) {
+void vm_random_program(VM *vm, size_t max_len, Rng *r) {
     vm->prog_len = 0;
-    size_t len = rnd_int(1, (int)max_len);
+    size_t len = rnd_int(r, 1, (int)max_len);
     while (vm->prog_len < len) {
-        int choice = rnd_int(0, 9);
+        int choice = rnd_int(r, 0, 9);
         if (choice == 0 && vm->prog_len + 5 <= len) {
-            vm_emit_push(vm, rnd_int(-100,100));
+            vm_emit_push(vm, rnd_int(r, -100,100));
         } else {
             uint8_t ops[] = {OP_ADD,OP_SUB,OP_MUL,OP_DIV,OP_DUP,OP_POP,OP_PRINT,OP_HALT,0xAA,0xBB};
-            vm->program[vm->prog_len++] = ops[rand() % (sizeof(ops)/1)];
+            vm->program[vm->prog_len++] = ops[rng_next(r) % (sizeof(ops)/1)];
         }
     }
     /* ensure HALT exists somewhere */
@@ -196,28 +256,26 @@ void vm_random_program(VM *vm, size_t max_len) {
 }
 
 /* mutate a program in-place (simple mutations) */
-void mutate_program(const VM *src, VM *dst) {
-    memcpy(dst->program, src->program, src->prog_len);
-    dst->prog_len = src->prog_len;
-    int op = rand() % 4;
+static void mutate_once(VM *dst, Rng *r) {
+    int op = rng_next(r) % 4;
     if (op == 0 && dst->prog_len > 0) {
         /* flip a random byte */
-        size_t i = rand() % dst->prog_len;
-        dst->program[i] ^= (uint8_t)(1 << (rand() % 8));
+        size_t i = rng_next(r) % dst->prog_len;
+        dst->program[i] ^= (uint8_t)(1 << (rng_next(r) % 8));
     } else if (op == 1) {
         /* replace a byte with a random opcode */
-        size_t i = rand() % dst->prog_len;
+        size_t i = rng_next(r) % dst->prog_len;
         uint8_t random_ops[] = {OP_PUSH, OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_DUP, OP_POP, OP_PRINT, OP_JZ, OP_JNZ, OP_HALT, 0xAB, 0xCD};
-        dst->program[i] = random_ops[rand() % (sizeof(random_ops)/1)];
+        dst->program[i] = random_ops[rng_next(r) % (sizeof(random_ops)/1)];
     } else if (op == 2 && dst->prog_len + 1 < PROGRAM_MAX) {
         /* insert a random byte */
-        size_t i = rand() % (dst->prog_len + 1);
+        size_t i = rng_next(r) % (dst->prog_len + 1);
         memmove(dst->program + i + 1, dst->program + i, dst->prog_len - i);
-        dst->program[i] = (uint8_t)(rand() & 0xFF);
+        dst->program[i] = (uint8_t)(rng_next(r) & 0xFF);
         dst->prog_len++;
     } else if (op == 3 && dst->prog_len > 1) {
         /* delete a byte */
-        size_t i = rand() % dst->prog_len;
+        size_t i = rng_next(r) % dst->prog_len;
         memmove(dst->program + i, dst->program + i + 1, dst->prog_len - i - 1);
         dst->prog_len--;
     }
@@ -225,6 +283,12 @@ void mutate_program(const VM *src, VM *dst) {
     if (dst->prog_len < PROGRAM_MAX) dst->program[dst->prog_len-1] = OP_HALT;
 }
 
+void mutate_program(const VM *src, VM *dst, Rng *r) {
+    memcpy(dst->program, src->program, src->prog_len);
+    dst->prog_len = src->prog_len;
+    mutate_once(dst, r);
+}
+
 /* Run a program and produce a textual summary (return code + outputs) */
 void run_and_report(const VM *prog, int *out_rc, int *out_count, int *outputs) {
     VM vm;
@@ -237,6 +301,789 @@ void run_and_report(const VM *prog, int *out_rc, int *out_count, int *outputs) {
     for (int i=0;i<vm.out_count && i<PRINT_BUF_MAX;i++) outputs[i] = vm.outputs[i];
 }
 
+/* --- Coverage-guided fuzzing ---
+ * A corpus keeps the programs that reached coverage no program before
+ * had: a new edge, or an edge taken a new number of times (counts in
+ * buckets 1, 2, 3, 4-7, 8-15, 16-31, 32-127, 128+, so that loops count
+ * by how much they loop). Each round picks an entry by its energy and
+ * runs that many mutants of it; entries that found more, are short, and
+ * have been fuzzed less get more */
+
+#define CORPUS_MAX 4096
+#define HAVOC_STACK 8           /* mutations stacked in one mutant, at most */
+#define ENERGY_MAX 64
+
+typedef struct {
+    uint8_t program[PROGRAM_MAX];
+    size_t prog_len;
+    int new_edges;              /* edges it was the first to reach */
+    int rc;
+    unsigned rounds;            /* times picked */
+} CorpusEntry;
+
+/* One fuzzer's state, a worker's in parallel mode. Its VM is loaded in
+ * place and reset between runs, not set up again for each */
+typedef struct {
+    CorpusEntry entries[CORPUS_MAX];
+    int count;
+    uint8_t virgin[COV_MAP_SIZE];   /* buckets seen, per edge */
+    int edges;                      /* edges seen at all */
+    CovTrace trace;
+    VM vm;
+    Rng rng;
+    unsigned long execs;
+    unsigned long rc_counts[VM_ERR_TIMEOUT + 1];
+
+    int id;
+    unsigned shared_seen;           /* next entry to import from the others */
+    atomic_ulong execs_seen;        /* execs, for the reporting thread */
+} Fuzzer;
+
+static uint8_t cov_bucket(uint8_t hits) {
+    if (hits <= 3) return hits == 0 ? 0 : (uint8_t)(1u << (hits - 1));
+    if (hits <= 7) return 1u << 3;
+    if (hits <= 15) return 1u << 4;
+    if (hits <= 31) return 1u << 5;
+    if (hits <= 127) return 1u << 6;
+    return 1u << 7;
+}
+
+/* Merges this run's trace into what has been seen, and clears it; the
+ * number of edges new to it, or -1 if only their counts are, or 0 if
+ * nothing is */
+static int cov_merge(Fuzzer *f) {
+    CovTrace *t = &f->trace;
+    int new_edges = 0, new_counts = 0;
+    for (int k = 0; k < t->count; k++) {
+        uint16_t i = t->touched[k];
+        uint8_t b = cov_bucket(t->hits[i]);
+        t->hits[i] = 0;
+        if (b & ~f->virgin[i]) {
+            if (!f->virgin[i]) new_edges++;
+            else new_counts = 1;
+            f->virgin[i] |= b;
+        }
+    }
+    t->count = 0;
+    f->edges += new_edges;
+    return new_edges ? new_edges : -new_counts;
+}
+
+/* The program being run, for the report if the VM itself crashes; the
+ * signal is delivered to the thread that ran it. A minimiser thread
+ * sets an escape instead, for the signal to return to */
+static _Thread_local const VM *current_input = NULL;
+static _Thread_local sigjmp_buf *crash_escape = NULL;
+
+static void report_crash(int sig) {
+    if (crash_escape) siglongjmp(*crash_escape, sig);
+    fprintf(stderr, "\nSignal %d in the VM; input (hex): ", sig);
+    if (current_input) {
+        for (size_t i = 0; i < current_input->prog_len; i++) fprintf(stderr, "%02X ", current_input->program[i]);
+    }
+    fprintf(stderr, "\n");
+    _Exit(1);
+}
+
+/* With sigaction, as signal() in strict C11 resets the handler after
+ * the first signal, and a minimiser catches one after the other */
+static void catch_crashes(void) {
+    struct sigaction sa;
+    memset(&sa, 0, sizeof sa);
+    sa.sa_handler = report_crash;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGFPE, &sa, NULL);
+    sigaction(SIGSEGV, &sa, NULL);
+}
+
+static void fuzzer_init(Fuzzer *f, int id, uint64_t seed) {
+    memset(f, 0, sizeof *f);
+    vm_init(&f->vm);
+    f->vm.cov = &f->trace;      /* left clear by each cov_merge */
+    rng_seed(&f->rng, seed);
+    f->id = id;
+    atomic_init(&f->execs_seen, 0);
+}
+
+static void load_program(Fuzzer *f, const uint8_t *program, size_t len) {
+    memcpy(f->vm.program, program, len);
+    f->vm.prog_len = len;
+}
+
+/* Runs what is loaded in f->vm, which vm_run leaves as it was */
+static int run_traced(Fuzzer *f) {
+    f->vm.sp = 0;
+    f->vm.out_count = 0;
+    current_input = &f->vm;
+    int rc = vm_run(&f->vm);
+    current_input = NULL;
+    f->execs++;
+    f->rc_counts[rc]++;
+    return rc;
+}
+
+static void corpus_add(Fuzzer *f, int new_edges, int rc) {
+    if (f->count == CORPUS_MAX) return;
+    CorpusEntry *e = &f->entries[f->count++];
+    memcpy(e->program, f->vm.program, f->vm.prog_len);
+    e->prog_len = f->vm.prog_len;
+    e->new_edges = new_edges > 0 ? new_edges : 0;
+    e->rc = rc;
+    e->rounds = 0;
+}
+
+static int energy(const CorpusEntry *e) {
+    int en = 4 + 4 * e->new_edges;
+    if (e->prog_len > 128) en /= 2;
+    en >>= e->rounds < 8 ? e->rounds / 2 : 4;
+    if (en < 1) en = 1;
+    return en > ENERGY_MAX ? ENERGY_MAX : en;
+}
+
+/* Picks by energy: the better of two entries drawn at random */
+static CorpusEntry *corpus_pick(Fuzzer *f) {
+    CorpusEntry *a = &f->entries[rng_next(&f->rng) % f->count];
+    CorpusEntry *b = &f->entries[rng_next(&f->rng) % f->count];
+    return energy(a) >= energy(b) ? a : b;
+}
+
+/* Several mutations stacked, or a splice with another entry first; into
+ * the fuzzer's VM */
+static void havoc(Fuzzer *f, const CorpusEntry *e) {
+    VM *m = &f->vm;
+    Rng *r = &f->rng;
+    load_program(f, e->program, e->prog_len);
+    if (f->count > 1 && rng_next(r) % 8 == 0) {
+        const CorpusEntry *o = &f->entries[rng_next(r) % f->count];
+        size_t cut = rng_next(r) % m->prog_len;
+        size_t from = rng_next(r) % o->prog_len;
+        size_t n = o->prog_len - from;
+        if (cut + n > PROGRAM_MAX) n = PROGRAM_MAX - cut;
+        memcpy(m->program + cut, o->program + from, n);
+        m->prog_len = cut + n;
+    }
+    int stack = 1 + rng_next(r) % HAVOC_STACK;
+    for (int i = 0; i < stack; i++) mutate_once(m, r);
+}
+
+static void fuzz_seed(Fuzzer *f, const VM *seed) {
+    load_program(f, seed->program, seed->prog_len);
+    int rc = run_traced(f);
+    corpus_add(f, cov_merge(f), rc);
+}
+
+/* One entry's worth of mutants; the found callback, if any, is told of
+ * those that reached new edges */
+static void fuzz_round(Fuzzer *f, unsigned long max_execs,
+                       void (*found_edges)(Fuzzer *f, int rc)) {
+    CorpusEntry *e = corpus_pick(f);
+    int n = energy(e);
+    e->rounds++;
+    for (int i = 0; i < n && f->execs < max_execs; i++) {
+        havoc(f, e);
+        int rc = run_traced(f);
+        int found = cov_merge(f);
+        if (!found) continue;
+        corpus_add(f, found, rc);
+        if (found > 0 && found_edges) found_edges(f, rc);
+    }
+}
+
+static void fuzz_coverage(Fuzzer *f, const VM *seed, unsigned long max_execs) {
+    fuzz_seed(f, seed);
+    while (f->execs < max_execs) fuzz_round(f, max_execs, NULL);
+}
+
+/* The same number of blind runs, traced but not kept, to compare */
+static void fuzz_blind(Fuzzer *f, unsigned long max_execs) {
+    while (f->execs < max_execs) {
+        vm_random_program(&f->vm, 64, &f->rng);
+        run_traced(f);
+        cov_merge(f);
+    }
+}
+
+static void print_fuzzer(const char *name, const Fuzzer *f) {
+    printf("%-12s execs=%lu edges=%d corpus=%d  rc:", name, f->execs, f->edges, f->count);
+    for (int rc = 0; rc <= VM_ERR_TIMEOUT; rc++) printf(" %d=%lu", rc, f->rc_counts[rc]);
+    printf("\n");
+}
+
+static void print_best(const Fuzzer *f) {
+    /* the corpus entry that went furthest from the seed */
+    const CorpusEntry *best = &f->entries[0];
+    for (int i = 1; i < f->count; i++) {
+        if (f->entries[i].new_edges > best->new_edges) best = &f->entries[i];
+    }
+    printf("Entry with most new edges (%d, rc=%d):", best->new_edges, best->rc);
+    for (size_t i = 0; i < best->prog_len; i++) printf(" %02X", best->program[i]);
+    printf("\n");
+}
+
+static int coverage_main(const VM *seed, unsigned long execs) {
+    static Fuzzer guided, blind;
+    catch_crashes();
+    fuzzer_init(&guided, 0, (uint64_t)time(NULL));
+    fuzzer_init(&blind, 1, (uint64_t)time(NULL) * 31 + 7);
+
+    clock_t t0 = clock();
+    fuzz_coverage(&guided, seed, execs);
+    clock_t t1 = clock();
+    fuzz_blind(&blind, execs);
+    clock_t t2 = clock();
+
+    printf("Coverage-guided against blind fuzzing, %lu runs each\n", execs);
+    print_fuzzer("guided", &guided);
+    print_fuzzer("blind", &blind);
+    printf("Time: guided %.2fs, blind %.2fs\n",
+           (double)(t1 - t0) / CLOCKS_PER_SEC, (double)(t2 - t1) / CLOCKS_PER_SEC);
+    print_best(&guided);
+    return 0;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* --- Minimising ---
+ * A failing program cut down to what still fails the same way, ddmin
+ * style: split into n chunks, try it without each, keep the first that
+ * still fails and go on with one chunk fewer, or else with twice as
+ * many, until the chunks are single units, and then pairs of them, as a
+ * PUSH and the POP of it go only together. The units are instructions,
+ * a PUSH with its four bytes and a jump with its offset, then bytes.
+ * After that the operands are made simpler, PUSH 0, 1, -1 or half, and
+ * jumps shorter, and all of it again until nothing changes.
+ *
+ * Each step's candidates are one batch, looked up in a cache of
+ * outcomes by program hash first, since the same program comes again as
+ * the chunks get smaller. Those not in it are run by a pool of threads,
+ * each with its own VM. The first candidate in the batch that fails
+ * wins, whichever thread ran it, so the result is the same for any
+ * number of threads. A signal from the VM is an outcome too, caught by
+ * the thread that raised it */
+
+#define VM_SIGNAL (VM_ERR_TIMEOUT + 1)  /* not a result code: the VM raised one */
+#define MIN_CACHE_BITS 16
+
+typedef struct {
+    uint8_t program[PROGRAM_MAX];
+    size_t prog_len;
+    uint64_t hash;
+    int outcome;                    /* rc, VM_SIGNAL, or -1 not known yet */
+} Candidate;
+
+typedef struct Minimiser Minimiser;
+
+typedef struct {
+    Minimiser *m;
+    VM vm;
+} MinWorker;
+
+struct Minimiser {
+    Candidate *batch;
+    int *todo;                      /* candidates not in the cache */
+    int todo_count;
+    atomic_int next;
+    int threads;                    /* the caller is one of them */
+    pthread_t tids[WORKERS_MAX];
+    MinWorker *workers;
+    pthread_barrier_t start, done;
+    bool quit;
+
+    uint64_t cache_keys[1u << MIN_CACHE_BITS];  /* 0 empty */
+    int8_t cache_outcomes[1u << MIN_CACHE_BITS];
+    unsigned cache_used;
+    unsigned long runs, hits;
+};
+
+/* FNV-1a, 0 kept for an empty slot */
+static uint64_t program_hash(const uint8_t *p, size_t len) {
+    uint64_t h = 14695981039346656037ull ^ len;
+    for (size_t i = 0; i < len; i++) h = (h ^ p[i]) * 1099511628211ull;
+    return h ? h : 1;
+}
+
+static int cache_find(const Minimiser *m, uint64_t hash) {
+    size_t mask = (1u << MIN_CACHE_BITS) - 1;
+    for (size_t i = hash & mask; m->cache_keys[i]; i = (i + 1) & mask) {
+        if (m->cache_keys[i] == hash) return m->cache_outcomes[i];
+    }
+    return -1;
+}
+
+/* Kept to half full; after that outcomes are only run again */
+static void cache_store(Minimiser *m, uint64_t hash, int outcome) {
+    size_t mask = (1u << MIN_CACHE_BITS) - 1;
+    if (m->cache_used >= (1u << MIN_CACHE_BITS) / 2) return;
+    size_t i = hash & mask;
+    while (m->cache_keys[i] && m->cache_keys[i] != hash) i = (i + 1) & mask;
+    if (!m->cache_keys[i]) m->cache_used++;
+    m->cache_keys[i] = hash;
+    m->cache_outcomes[i] = (int8_t)outcome;
+}
+
+static int run_outcome(VM *vm, const Candidate *c) {
+    memcpy(vm->program, c->program, c->prog_len);
+    vm->prog_len = c->prog_len;
+    vm->sp = 0;
+    vm->out_count = 0;
+    sigjmp_buf escape;
+    if (sigsetjmp(escape, 1)) {
+        crash_escape = NULL;
+        return VM_SIGNAL;
+    }
+    crash_escape = &escape;
+    int rc = vm_run(vm);
+    crash_escape = NULL;
+    return rc;
+}
+
+/* The candidates not yet run, shared out one at a time */
+static void run_todo(Minimiser *m, VM *vm) {
+    int i;
+    while ((i = atomic_fetch_add_explicit(&m->next, 1, memory_order_relaxed)) < m->todo_count) {
+        Candidate *c = &m->batch[m->todo[i]];
+        c->outcome = run_outcome(vm, c);
+    }
+}
+
+static void *min_worker(void *arg) {
+    MinWorker *w = arg;
+    Minimiser *m = w->m;
+    for (;;) {
+        pthread_barrier_wait(&m->start);
+        if (m->quit) break;
+        run_todo(m, &w->vm);
+        pthread_barrier_wait(&m->done);
+    }
+    return NULL;
+}
+
+static Minimiser *minimiser_new(int threads) {
+    if (threads < 1) threads = 1;
+    if (threads > WORKERS_MAX) threads = WORKERS_MAX;
+    Minimiser *m = calloc(1, sizeof *m);
+    if (!m) return NULL;
+    m->batch = malloc(sizeof(Candidate) * (PROGRAM_MAX + 1));
+    m->todo = malloc(sizeof(int) * (PROGRAM_MAX + 1));
+    m->workers = malloc(sizeof(MinWorker) * (size_t)threads);
+    if (!m->batch || !m->todo || !m->workers) {
+        free(m->batch); free(m->todo); free(m->workers); free(m);
+        return NULL;
+    }
+    m->threads = threads;
+    for (int t = 0; t < threads; t++) {
+        m->workers[t].m = m;
+        vm_init(&m->workers[t].vm);
+    }
+    if (threads > 1) {
+        pthread_barrier_init(&m->start, NULL, (unsigned)threads);
+        pthread_barrier_init(&m->done, NULL, (unsigned)threads);
+        for (int t = 1; t < threads; t++) pthread_create(&m->tids[t], NULL, min_worker, &m->workers[t]);
+    }
+    return m;
+}
+
+static void minimiser_free(Minimiser *m) {
+    if (m->threads > 1) {
+        m->quit = true;
+        pthread_barrier_wait(&m->start);
+        for (int t = 1; t < m->threads; t++) pthread_join(m->tids[t], NULL);
+        pthread_barrier_destroy(&m->start);
+        pthread_barrier_destroy(&m->done);
+    }
+    free(m->batch);
+    free(m->todo);
+    free(m->workers);
+    free(m);
+}
+
+/* Outcomes of batch[0..count), from the cache or run */
+static void evaluate(Minimiser *m, int count) {
+    m->todo_count = 0;
+    for (int i = 0; i < count; i++) {
+        Candidate *c = &m->batch[i];
+        c->hash = program_hash(c->program, c->prog_len);
+        c->outcome = cache_find(m, c->hash);
+        if (c->outcome < 0) m->todo[m->todo_count++] = i;
+        else m->hits++;
+    }
+    atomic_store_explicit(&m->next, 0, memory_order_relaxed);
+    if (m->threads > 1 && m->todo_count > 1) {
+        pthread_barrier_wait(&m->start);
+        run_todo(m, &m->workers[0].vm);
+        pthread_barrier_wait(&m->done);
+    } else {
+        run_todo(m, &m->workers[0].vm);
+    }
+    m->runs += (unsigned long)m->todo_count;
+    for (int i = 0; i < m->todo_count; i++) {
+        Candidate *c = &m->batch[m->todo[i]];
+        cache_store(m, c->hash, c->outcome);
+    }
+}
+
+static int first_failing(const Minimiser *m, int count, int target) {
+    for (int i = 0; i < count; i++) {
+        if (m->batch[i].outcome == target) return i;
+    }
+    return -1;
+}
+
+/* Where each unit starts, starts[count] the end: instructions with their
+ * operands, as far as the program has them, or single bytes */
+static size_t split_units(const Candidate *p, bool bytes, size_t *starts) {
+    size_t count = 0;
+    for (size_t pc = 0; pc < p->prog_len; count++) {
+        starts[count] = pc;
+        uint8_t op = p->program[pc++];
+        if (bytes) continue;
+        if (op == OP_PUSH) pc += 4;
+        else if (op == OP_JZ || op == OP_JNZ) pc += 1;
+        if (pc > p->prog_len) pc = p->prog_len;
+    }
+    starts[count] = p->prog_len;
+    return count;
+}
+
+static void cut(Candidate *k, const Candidate *cur, size_t from, size_t to) {
+    memcpy(k->program, cur->program, from);
+    memcpy(k->program + from, cur->program + to, cur->prog_len - to);
+    k->prog_len = cur->prog_len - (to - from);
+}
+
+/* ddmin by complements, over units; true if anything went */
+static bool ddmin_pass(Minimiser *m, Candidate *cur, int target, bool bytes) {
+    static size_t starts[PROGRAM_MAX + 1];
+    bool progress = false;
+    size_t units = split_units(cur, bytes, starts);
+    size_t n = 2;
+    while (units > 0) {
+        if (n > units) n = units;
+        for (size_t c = 0; c < n; c++) {
+            cut(&m->batch[c], cur, starts[c * units / n], starts[(c + 1) * units / n]);
+        }
+        evaluate(m, (int)n);
+        int win = first_failing(m, (int)n, target);
+        if (win < 0 && n == units && units > 2) {
+            for (size_t c = 0; c + 1 < units; c++) cut(&m->batch[c], cur, starts[c], starts[c + 2]);
+            evaluate(m, (int)units - 1);
+            win = first_failing(m, (int)units - 1, target);
+        }
+        if (win >= 0) {
+            memcpy(cur->program, m->batch[win].program, m->batch[win].prog_len);
+            cur->prog_len = m->batch[win].prog_len;
+            units = split_units(cur, bytes, starts);
+            n = n > 2 ? n - 1 : 2;
+            progress = true;
+        } else if (n == units) {
+            break;
+        } else {
+            n = n * 2 < units ? n * 2 : units;
+        }
+    }
+    return progress;
+}
+
+static void put_i32(uint8_t *p, int32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)((uint32_t)v >> (8 * i));
+}
+
+/* Every simpler operand at once; the first that still fails is kept,
+ * and the rest tried again from it. True if any was */
+static bool simplify_pass(Minimiser *m, Candidate *cur, int target) {
+    bool progress = false;
+    for (;;) {
+        int count = 0;
+        for (size_t pc = 0; pc < cur->prog_len && count + 6 <= PROGRAM_MAX; ) {
+            uint8_t op = cur->program[pc++];
+            int32_t tries[5];
+            int n = 0;
+            size_t at = pc;
+            if (op == OP_PUSH && pc + 4 <= cur->prog_len) {
+                int32_t v = read_i32(cur->program, cur->prog_len, pc);
+                const int32_t simpler[] = { 0, 1, -1, v / 2 };
+                for (int i = 0; i < 4; i++) {
+                    int32_t s = simpler[i];
+                    /* only what is smaller in magnitude, or the same but positive */
+                    if ((s < 0 ? -(int64_t)s : s) < (v < 0 ? -(int64_t)v : v) || (s == -v && v < 0))
+                        tries[n++] = s;
+                }
+                pc += 4;
+            } else if ((op == OP_JZ || op == OP_JNZ) && pc < cur->prog_len) {
+                uint8_t off = cur->program[pc];
+                if (off > 0) tries[n++] = 0;
+                if (off > 1) tries[n++] = off / 2;
+                pc += 1;
+            }
+            for (int i = 0; i < n; i++) {
+                Candidate *k = &m->batch[count++];
+                memcpy(k->program, cur->program, cur->prog_len);
+                k->prog_len = cur->prog_len;
+                if (op == OP_PUSH) put_i32(k->program + at, tries[i]);
+                else k->program[at] = (uint8_t)tries[i];
+            }
+        }
+        if (count == 0) return progress;
+        evaluate(m, count);
+        int win = first_failing(m, count, target);
+        if (win < 0) return progress;
+        memcpy(cur->program, m->batch[win].program, cur->prog_len);
+        progress = true;
+    }
+}
+
+/* p cut down for as long as it ends as it did; its outcome, which is
+ * VM_OK when there was nothing to cut down */
+static int minimise(Minimiser *m, Candidate *p) {
+    Candidate *first = &m->batch[0];
+    *first = *p;
+    evaluate(m, 1);
+    int target = first->outcome;
+    if (target == VM_OK) return VM_OK;
+    bool progress;
+    do {
+        progress = ddmin_pass(m, p, target, false);
+        progress |= ddmin_pass(m, p, target, true);
+        progress |= simplify_pass(m, p, target);
+    } while (progress);
+    return target;
+}
+
+static void print_bytes(const uint8_t *p, size_t len) {
+    for (size_t i = 0; i < len; i++) printf(" %02X", p[i]);
+    printf("\n");
+}
+
+static const char *outcome_name(int outcome) {
+    static const char *const names[] = {
+        "ok", "stack underflow", "stack overflow", "division by zero",
+        "invalid opcode", "pc out of bounds", "timeout", "signal"
+    };
+    return outcome >= 0 && outcome <= VM_SIGNAL ? names[outcome] : "?";
+}
+
+/* Minimises and prints the result, with what it took */
+static void minimise_report(Minimiser *m, const uint8_t *program, size_t len) {
+    static Candidate p;
+    memcpy(p.program, program, len);
+    p.prog_len = len;
+    unsigned long runs = m->runs, hits = m->hits;
+    double t0 = now_seconds();
+    int outcome = minimise(m, &p);
+    double t1 = now_seconds();
+    if (outcome == VM_OK) {
+        printf("  runs without failing, nothing to minimise\n");
+        return;
+    }
+    printf("  %s, %zu bytes cut to %zu in %.3fs (%lu runs, %lu from the cache):",
+           outcome_name(outcome), len, p.prog_len, t1 - t0, m->runs - runs, m->hits - hits);
+    print_bytes(p.program, p.prog_len);
+}
+
+static int parse_hex(int argc, char **argv, uint8_t *out, size_t *len) {
+    *len = 0;
+    for (int i = 0; i < argc; i++) {
+        for (const char *s = argv[i]; *s; ) {
+            unsigned byte;
+            int used;
+            if (*s == ' ' || *s == ',') { s++; continue; }
+            if (sscanf(s, "%2x%n", &byte, &used) != 1) return 0;
+            if (*len == PROGRAM_MAX) return 0;
+            out[(*len)++] = (uint8_t)byte;
+            s += used;
+        }
+    }
+    return 1;
+}
+
+static int minimise_main(int argc, char **argv) {
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int i = 0;
+    if (i + 1 < argc && strcmp(argv[i], "-j") == 0) {
+        threads = atoi(argv[i + 1]);
+        i += 2;
+    }
+    static uint8_t program[PROGRAM_MAX];
+    size_t len;
+    if (i == argc || !parse_hex(argc - i, argv + i, program, &len)) {
+        fprintf(stderr, "usage: vm_test min [-j threads] hex...\n");
+        return 2;
+    }
+    catch_crashes();
+    Minimiser *m = minimiser_new(threads);
+    if (!m) return 1;
+    printf("Minimising %zu bytes, %d threads:", len, m->threads);
+    print_bytes(program, len);
+    minimise_report(m, program, len);
+    minimiser_free(m);
+    return 0;
+}
+
+/* --- Parallel fuzzing ---
+ * Each worker thread is a Fuzzer of its own: VM, trace, corpus, RNG,
+ * and coverage seen, so that the runs share nothing and scale with the
+ * cores. What they do share goes through two lock-free structures:
+ *
+ * - A log of the inputs that reached edges new to the worker that ran
+ *   them. A writer takes a slot with an atomic add, fills it, and
+ *   releases it with its ready flag; each worker reads the log from
+ *   where it was, runs what the others found, and keeps what is new to
+ *   it too. The log only grows, so nothing is ever freed under a reader.
+ * - The first input to end in each VM result code, claimed with a
+ *   compare-and-swap, as the crash report of that kind. */
+
+#define SHARED_MAX 16384
+
+typedef struct {
+    uint8_t program[PROGRAM_MAX];
+    size_t prog_len;
+    int from;                       /* worker that found it */
+    atomic_bool ready;
+} SharedEntry;
+
+static SharedEntry shared[SHARED_MAX];
+static atomic_uint shared_reserved;
+
+typedef struct {
+    uint8_t program[PROGRAM_MAX];
+    size_t prog_len;
+    int from;
+    atomic_int state;               /* 0 free, 1 being written, 2 done */
+} CrashEntry;
+
+static CrashEntry crashes[VM_ERR_TIMEOUT + 1];
+static atomic_bool stop_workers;
+static const VM *par_seed;
+
+static void share_found(Fuzzer *f, int rc) {
+    (void)rc;
+    unsigned i = atomic_fetch_add_explicit(&shared_reserved, 1, memory_order_relaxed);
+    if (i >= SHARED_MAX) return;
+    SharedEntry *e = &shared[i];
+    memcpy(e->program, f->vm.program, f->vm.prog_len);
+    e->prog_len = f->vm.prog_len;
+    e->from = f->id;
+    atomic_store_explicit(&e->ready, true, memory_order_release);
+}
+
+static void note_crash(Fuzzer *f, int rc) {
+    if (rc == VM_OK) return;
+    CrashEntry *c = &crashes[rc];
+    int expected = 0;
+    if (atomic_load_explicit(&c->state, memory_order_relaxed) != 0) return;
+    if (!atomic_compare_exchange_strong(&c->state, &expected, 1)) return;
+    memcpy(c->program, f->vm.program, f->vm.prog_len);
+    c->prog_len = f->vm.prog_len;
+    c->from = f->id;
+    atomic_store_explicit(&c->state, 2, memory_order_release);
+}
+
+/* Runs the others' finds, in the order they were logged; one not yet
+ * ready stops the import until the next round */
+static void import_shared(Fuzzer *f) {
+    unsigned end = atomic_load_explicit(&shared_reserved, memory_order_relaxed);
+    if (end > SHARED_MAX) end = SHARED_MAX;
+    while (f->shared_seen < end) {
+        SharedEntry *e = &shared[f->shared_seen];
+        if (!atomic_load_explicit(&e->ready, memory_order_acquire)) break;
+        f->shared_seen++;
+        if (e->from == f->id) continue;
+        load_program(f, e->program, e->prog_len);
+        int rc = run_traced(f);
+        int found = cov_merge(f);
+        if (found) corpus_add(f, found, rc);
+    }
+}
+
+static void share_and_note(Fuzzer *f, int rc) {
+    share_found(f, rc);
+    note_crash(f, rc);
+}
+
+static void *fuzz_worker(void *arg) {
+    Fuzzer *f = arg;
+    fuzz_seed(f, par_seed);
+    while (!atomic_load_explicit(&stop_workers, memory_order_relaxed)) {
+        import_shared(f);
+        fuzz_round(f, ~0ul, share_and_note);
+        atomic_store_explicit(&f->execs_seen, f->execs, memory_order_relaxed);
+    }
+    return NULL;
+}
+
+static int parallel_main(const VM *seed, int workers, int seconds) {
+    if (workers < 1) workers = 1;
+    if (workers > WORKERS_MAX) workers = WORKERS_MAX;
+    catch_crashes();
+
+    Fuzzer *f = malloc(sizeof(Fuzzer) * (size_t)workers);
+    pthread_t threads[WORKERS_MAX];
+    if (!f) return 1;
+    par_seed = seed;
+    uint64_t base = (uint64_t)time(NULL);
+    for (int w = 0; w < workers; w++) {
+        fuzzer_init(&f[w], w, base * 0x9E3779B97F4A7C15ull + (uint64_t)w * 0xBF58476D1CE4E5B9ull);
+    }
+    for (int w = 0; w < workers; w++) {
+        pthread_create(&threads[w], NULL, fuzz_worker, &f[w]);
+    }
+
+    printf("Parallel coverage-guided fuzzing: %d workers, %d s\n", workers, seconds);
+    unsigned long last[WORKERS_MAX] = {0};
+    double t_start = now_seconds(), t_last = t_start;
+    for (int t = 0; t < seconds; t++) {
+        struct timespec second = { 1, 0 };
+        nanosleep(&second, NULL);
+        double t_now = now_seconds();
+        unsigned long total = 0;
+        printf("%3ds execs/s:", t + 1);
+        for (int w = 0; w < workers; w++) {
+            unsigned long e = atomic_load_explicit(&f[w].execs_seen, memory_order_relaxed);
+            printf(" %.0fk", (e - last[w]) / (t_now - t_last) / 1000);
+            total += e - last[w];
+            last[w] = e;
+        }
+        printf("  total %.0fk\n", total / (t_now - t_last) / 1000);
+        t_last = t_now;
+    }
+    atomic_store(&stop_workers, true);
+    for (int w = 0; w < workers; w++) pthread_join(threads[w], NULL);
+    double elapsed = now_seconds() - t_start;
+
+    /* coverage of all the workers together */
+    static uint8_t all[COV_MAP_SIZE];
+    unsigned long execs = 0;
+    int edges = 0;
+    for (int w = 0; w < workers; w++) {
+        execs += f[w].execs;
+        for (size_t i = 0; i < COV_MAP_SIZE; i++) all[i] |= f[w].virgin[i];
+    }
+    for (size_t i = 0; i < COV_MAP_SIZE; i++) edges += all[i] != 0;
+    unsigned logged = atomic_load(&shared_reserved);
+
+    printf("Total: execs=%lu (%.0fk/s) edges=%d shared=%u\n",
+           execs, execs / elapsed / 1000, edges, logged < SHARED_MAX ? logged : SHARED_MAX);
+    for (int w = 0; w < workers; w++) {
+        char name[32];
+        snprintf(name, sizeof name, "w%d %.0fk/s", w, f[w].execs / elapsed / 1000);
+        print_fuzzer(name, &f[w]);
+    }
+    Minimiser *m = minimiser_new(workers);
+    for (int rc = 1; rc <= VM_ERR_TIMEOUT; rc++) {
+        if (atomic_load(&crashes[rc].state) != 2) continue;
+        printf("First rc=%d (worker %d):", rc, crashes[rc].from);
+        print_bytes(crashes[rc].program, crashes[rc].prog_len);
+        if (m) minimise_report(m, crashes[rc].program, crashes[rc].prog_len);
+    }
+    if (m) minimiser_free(m);
+    free(f);
+    return 0;
+}
+
 /* simple pretty print of program bytes */
 void print_program_hex(const VM *p) {
     for (size_t i=0;i<p->prog_len;i++) {
@@ -245,8 +1092,9 @@ void print_program_hex(const VM *p) {
     printf("\n");
 }
 
-int main(void) {
-    srand((unsigned)time(NULL));
+int main(int argc, char **argv) {
+    Rng rng;
+    rng_seed(&rng, (uint64_t)time(NULL));
 
     printf("Tiny VM fuzz + mutation test (C)\n");
 
@@ -261,6 +1109,19 @@ int main(void) {
     seed.program[seed.prog_len++] = OP_PRINT;
     seed.program[seed.prog_len++] = OP_HALT;
 
+    if (argc > 1 && strcmp(argv[1], "cov") == 0) {
+        unsigned long execs = argc > 2 ? strtoul(argv[2], NULL, 10) : 1000000;
+        return coverage_main(&seed, execs);
+    }
+    if (argc > 1 && strcmp(argv[1], "par") == 0) {
+        int workers = argc > 2 ? atoi(argv[2]) : 4;
+        int seconds = argc > 3 ? atoi(argv[3]) : 10;
+        return parallel_main(&seed, workers, seconds);
+    }
+    if (argc > 1 && strcmp(argv[1], "min") == 0) {
+        return minimise_main(argc - 2, argv + 2);
+    }
+
     printf("Seed program (hex): ");
     print_program_hex(&seed);
 
@@ -276,7 +1137,7 @@ int main(void) {
     for (int i=0;i<MUTATIONS;i++) {
         VM m;
         vm_init(&m);
-        mutate_program(&seed, &m);
+        mutate_program(&seed, &m, &rng);
         int rc; int oc; int out[PRINT_BUF_MAX];
         run_and_report(&m, &rc, &oc, out);
         /* We consider the mutation 'interesting' if rc != seed_rc or outputs differ */
@@ -297,7 +1158,7 @@ int main(void) {
     for (int i=0;i<RUNS;i++) {
         VM p;
         vm_init(&p);
-        vm_random_program(&p, 64);
+        vm_random_program(&p, 64, &rng);
         int rc; int oc; int out[PRINT_BUF_MAX];
         run_and_report(&p, &rc, &oc, out);
         if (rc == VM_OK) ok++;
@@ -9,33 +9,54 @@
 void vm_init(sap_vm_t *vm) {
     memset(vm, 0, sizeof(sap_vm_t));
     vm->cpu.sp = STACK_TOP;
+    vm->cpu.flag_result = FLAGS_CLEAR;
     vm->state = VM_STOPPED;
     vm->debug_enabled = true;
     vm->trace_enabled = false;
 }
 
-void vm_reset(sap_vm_t *vm) {
+// everything vm_reset() does but clear memory
+void vm_reset_cpu(sap_vm_t *vm) {
     vm->cpu.accumulator = 0;
     vm->cpu.pc = PROGRAM_START;
     vm->cpu.sp = STACK_TOP;
     vm->cpu.x_reg = 0;
     vm->cpu.ir = 0;
-    memset(&vm->cpu.flags, 0, sizeof(cpu_flags_t));
-    memset(vm->memory, 0, sizeof(int16_t) * MEMORY_SIZE);
+    vm->cpu.flag_result = FLAGS_CLEAR;
     vm->state = VM_STOPPED;
     vm->cycle_count = 0;
     vm->last_pc = 0;
     vm->last_error[0] = '\0';
     vm->error_address = 0;
+    if (vm->trace_ring) {
+        vm->trace_ring->count = 0;  // a trace starts with the run
+    }
+    vm_flush_cache(vm);
+}
+
+void vm_reset(sap_vm_t *vm) {
+    vm_reset_cpu(vm);
+    memset(vm->memory, 0, sizeof(int16_t) * MEMORY_SIZE);
     if (vm->debug_enabled) {
         printf("VM reset to initial state, memory cleared\n");
     }
 }
 
 void vm_destroy(sap_vm_t *vm) {
+    vm_trace_stop(vm);
     vm_init(vm);
 }
 
+cpu_flags_t vm_flags(const sap_vm_t *vm) {
+    int32_t result = vm->cpu.flag_result;
+    cpu_flags_t flags;
+    flags.zero = (result == 0);
+    flags.negative = (result < 0);
+    flags.carry = (result > 32767 || result < -32768);
+    flags.overflow = flags.carry;
+    return flags;
+}
+
 bool vm_is_valid_address(uint16_t address) {
     return address < MEMORY_SIZE;
 }
@@ -52,10 +73,20 @@ result_t vm_write_memory(sap_vm_t *vm, uint16_t address, int16_t value) {
     if (!vm_is_valid_address(address)) {
         return vm_set_error(vm, "Invalid write to address 0x%04X", address);
     }
+    if (vm->tcache[address].block_len != 0) {
+        vm_flush_cache(vm);     // self-modifying code
+    }
     vm->memory[address] = value;
     return RESULT_OK;
 }
 
+void vm_flush_cache(sap_vm_t *vm) {
+    if (vm->tcache_used) {
+        memset(vm->tcache, 0, sizeof(vm->tcache));
+        vm->tcache_used = false;
+    }
+}
+
 result_t vm_set_error(sap_vm_t *vm, const char *format, ...) {
     va_list args;
     va_start(args, format);
@@ -69,11 +100,9 @@ result_t vm_set_error(sap_vm_t *vm, const char *format, ...) {
     return RESULT_ERROR;
 }
 
+// the flags themselves come from vm_flags(), when someone asks
 static void update_flags(sap_vm_t *vm, int32_t result) {
-    vm->cpu.flags.zero = (result == 0);
-    vm->cpu.flags.negative = (result < 0);
-    vm->cpu.flags.carry = (result > 32767 || result < -32768);
-    vm->cpu.flags.overflow = vm->cpu.flags.carry;
+    vm->cpu.flag_result = result;
 }
 
 static result_t resolve_operand(sap_vm_t *vm, addressing_mode_t mode, 
@@ -116,6 +145,17 @@ static result_t resolve_operand(sap_vm_t *vm, addressing_mode_t mode,
     return (vm->state == VM_ERROR) ? RESULT_ERROR : RESULT_OK;
 }
 
+// value_ref is set by the cached path for operands resolved at decode
+static inline result_t fetch_operand(sap_vm_t *vm, addressing_mode_t mode,
+                                     uint16_t operand, const int16_t *value_ref,
+                                     int16_t *value) {
+    if (value_ref) {
+        *value = *value_ref;
+        return RESULT_OK;
+    }
+    return resolve_operand(vm, mode, operand, value);
+}
+
 static result_t store_operand(sap_vm_t *vm, addressing_mode_t mode, 
                             uint16_t operand, int16_t value) {
     uint16_t addr;
@@ -152,38 +192,8 @@ static result_t store_operand(sap_vm_t *vm, addressing_mode_t mode,
     }
 }
 
-result_t vm_step(sap_vm_t *vm) {
-    if (vm->state == VM_HALTED || vm->state == VM_ERROR) {
-        return vm->state == VM_HALTED ? RESULT_HALT : RESULT_ERROR;
-    }
-    
-    if (vm_check_breakpoint(vm, vm->cpu.pc)) {
-        vm->state = VM_BREAKPOINT;
-        return RESULT_BREAKPOINT;
-    }
-    
-    vm->last_pc = vm->cpu.pc;
-    
-    if (!vm_is_valid_address(vm->cpu.pc)) {
-        return vm_set_error(vm, "PC out of bounds: 0x%04X", vm->cpu.pc);
-    }
-    
-    vm->cpu.ir = vm->memory[vm->cpu.pc++];
-    vm->cycle_count++;
-    
-    opcode_t opcode;
-    addressing_mode_t mode;
-    uint16_t operand;
-    vm_decode_instruction(vm->cpu.ir, &opcode, &mode, &operand);
-    
-    if (vm->trace_enabled) {
-        printf("PC:%04X IR:%04X %s ", vm->last_pc, vm->cpu.ir, opcode_to_string(opcode));
-        if (opcode != OP_NOP && opcode != OP_RTS) {
-            printf("%s%d", addressing_mode_to_string(mode), operand);
-        }
-        printf(" ACC:%d X:%d SP:%04X\n", vm->cpu.accumulator, vm->cpu.x_reg, vm->cpu.sp);
-    }
-    
+static result_t execute(sap_vm_t *vm, opcode_t opcode, addressing_mode_t mode,
+                        uint16_t operand, const int16_t *value_ref) {
     int16_t operand_value;
     int32_t result;
     
@@ -192,7 +202,7 @@ result_t vm_step(sap_vm_t *vm) {
             break;
             
         case OP_LDA:
-            if (resolve_operand(vm, mode, operand, &operand_value) != RESULT_OK) {
+            if (fetch_operand(vm, mode, operand, value_ref, &operand_value) != RESULT_OK) {
                 return RESULT_ERROR;
             }
             vm->cpu.accumulator = operand_value;
@@ -206,7 +216,7 @@ result_t vm_step(sap_vm_t *vm) {
             break;
             
         case OP_ADD:
-            if (resolve_operand(vm, mode, operand, &operand_value) != RESULT_OK) {
+            if (fetch_operand(vm, mode, operand, value_ref, &operand_value) != RESULT_OK) {
                 return RESULT_ERROR;
             }
             result = (int32_t)vm->cpu.accumulator + operand_value;
@@ -215,7 +225,7 @@ result_t vm_step(sap_vm_t *vm) {
             break;
             
         case OP_SUB:
-            if (resolve_operand(vm, mode, operand, &operand_value) != RESULT_OK) {
+            if (fetch_operand(vm, mode, operand, value_ref, &operand_value) != RESULT_OK) {
                 return RESULT_ERROR;
             }
             result = (int32_t)vm->cpu.accumulator - operand_value;
@@ -224,7 +234,7 @@ result_t vm_step(sap_vm_t *vm) {
             break;
             
         case OP_MUL:
-            if (resolve_operand(vm, mode, operand, &operand_value) != RESULT_OK) {
+            if (fetch_operand(vm, mode, operand, value_ref, &operand_value) != RESULT_OK) {
                 return RESULT_ERROR;
             }
             result = (int32_t)vm->cpu.accumulator * operand_value;
@@ -233,7 +243,7 @@ result_t vm_step(sap_vm_t *vm) {
             break;
             
         case OP_DIV:
-            if (resolve_operand(vm, mode, operand, &operand_value) != RESULT_OK) {
+            if (fetch_operand(vm, mode, operand, value_ref, &operand_value) != RESULT_OK) {
                 return RESULT_ERROR;
             }
             if (operand_value == 0) {
@@ -245,7 +255,7 @@ result_t vm_step(sap_vm_t *vm) {
             break;
             
         case OP_AND:
-            if (resolve_operand(vm, mode, operand, &operand_value) != RESULT_OK) {
+            if (fetch_operand(vm, mode, operand, value_ref, &operand_value) != RESULT_OK) {
                 return RESULT_ERROR;
             }
             vm->cpu.accumulator &= operand_value;
@@ -253,7 +263,7 @@ result_t vm_step(sap_vm_t *vm) {
             break;
             
         case OP_OR:
-            if (resolve_operand(vm, mode, operand, &operand_value) != RESULT_OK) {
+            if (fetch_operand(vm, mode, operand, value_ref, &operand_value) != RESULT_OK) {
                 return RESULT_ERROR;
             }
             vm->cpu.accumulator |= operand_value;
@@ -261,7 +271,7 @@ result_t vm_step(sap_vm_t *vm) {
             break;
             
         case OP_XOR:
-            if (resolve_operand(vm, mode, operand, &operand_value) != RESULT_OK) {
+            if (fetch_operand(vm, mode, operand, value_ref, &operand_value) != RESULT_OK) {
                 return RESULT_ERROR;
             }
             vm->cpu.accumulator ^= operand_value;
@@ -269,7 +279,7 @@ result_t vm_step(sap_vm_t *vm) {
             break;
             
         case OP_CMP:
-            if (resolve_operand(vm, mode, operand, &operand_value) != RESULT_OK) {
+            if (fetch_operand(vm, mode, operand, value_ref, &operand_value) != RESULT_OK) {
                 return RESULT_ERROR;
             }
             result = (int32_t)vm->cpu.accumulator - operand_value;
@@ -284,7 +294,7 @@ result_t vm_step(sap_vm_t *vm) {
             break;
             
         case OP_JZ:
-            if (vm->cpu.flags.zero) {
+            if (vm->cpu.flag_result == 0) {
                 if (!vm_is_valid_address(operand)) {
                     return vm_set_error(vm, "Invalid jump address 0x%04X", operand);
                 }
@@ -293,7 +303,7 @@ result_t vm_step(sap_vm_t *vm) {
             break;
             
         case OP_JNZ:
-            if (!vm->cpu.flags.zero) {
+            if (vm->cpu.flag_result != 0) {
                 if (!vm_is_valid_address(operand)) {
                     return vm_set_error(vm, "Invalid jump address 0x%04X", operand);
                 }
@@ -308,6 +318,9 @@ result_t vm_step(sap_vm_t *vm) {
             if (vm->cpu.sp == 0) {
                 return vm_set_error(vm, "Stack overflow");
             }
+            if (vm->tcache[vm->cpu.sp].block_len != 0) {
+                vm_flush_cache(vm);
+            }
             vm->memory[vm->cpu.sp] = vm->cpu.pc;
             vm->cpu.sp--;
             vm->cpu.pc = operand;
@@ -340,24 +353,387 @@ result_t vm_step(sap_vm_t *vm) {
     return RESULT_OK;
 }
 
-result_t vm_run(sap_vm_t *vm, uint64_t max_cycles) {
-    if (vm->debug_enabled) {
-        printf("Starting run at PC=0x%04X, state=%s\n", vm->cpu.pc, vm_state_to_string(vm->state));
+// A few stores per instruction, so a trace can stay on for long runs
+static inline void trace_record(sap_vm_t *vm, uint16_t pc, uint16_t ir) {
+    sap_trace_t *t = vm->trace_ring;
+    sap_trace_record_t *r = &t->records[t->count++ & t->mask];
+    r->cycle = vm->cycle_count;
+    r->pc = pc;
+    r->ir = ir;
+    r->accumulator = vm->cpu.accumulator;
+    cpu_flags_t flags = vm_flags(vm);
+    r->flags = (uint8_t)((flags.zero ? SAP_TRACE_ZERO : 0) |
+                         (flags.negative ? SAP_TRACE_NEGATIVE : 0) |
+                         (flags.carry ? SAP_TRACE_CARRY : 0) |
+                         (flags.overflow ? SAP_TRACE_OVERFLOW : 0));
+}
+
+result_t vm_step(sap_vm_t *vm) {
+    if (vm->state == VM_HALTED || vm->state == VM_ERROR) {
+        return vm->state == VM_HALTED ? RESULT_HALT : RESULT_ERROR;
     }
     
-    vm->state = VM_RUNNING;
-    result_t result = RESULT_OK;
+    if (vm_check_breakpoint(vm, vm->cpu.pc)) {
+        vm->state = VM_BREAKPOINT;
+        return RESULT_BREAKPOINT;
+    }
+    
+    vm->last_pc = vm->cpu.pc;
+    
+    if (!vm_is_valid_address(vm->cpu.pc)) {
+        return vm_set_error(vm, "PC out of bounds: 0x%04X", vm->cpu.pc);
+    }
     
-    for (uint64_t i = 0; i < max_cycles && result == RESULT_OK; i++) {
-        result = vm_step(vm);
-        if (result == RESULT_BREAKPOINT) {
-            printf("Breakpoint hit at PC=0x%04X\n", vm->last_pc);
+    vm->cpu.ir = vm->memory[vm->cpu.pc++];
+    vm->cycle_count++;
+    
+    opcode_t opcode;
+    addressing_mode_t mode;
+    uint16_t operand;
+    vm_decode_instruction(vm->cpu.ir, &opcode, &mode, &operand);
+    
+    if (vm->trace_ring) {
+        trace_record(vm, vm->last_pc, vm->cpu.ir);
+    }
+    if (vm->trace_enabled) {
+        printf("PC:%04X IR:%04X %s ", vm->last_pc, vm->cpu.ir, opcode_to_string(opcode));
+        if (opcode != OP_NOP && opcode != OP_RTS) {
+            printf("%s%d", addressing_mode_to_string(mode), operand);
+        }
+        printf(" ACC:%d X:%d SP:%04X\n", vm->cpu.accumulator, vm->cpu.x_reg, vm->cpu.sp);
+    }
+    
+    return execute(vm, opcode, mode, operand, NULL);
+}
+
+// conditional or not, so a block also ends before a breakpoint that may
+// not stop
+static bool has_breakpoint(const sap_vm_t *vm, uint16_t address) {
+    return vm->breakpoint_map[address >> 5] & (1u << (address & 31));
+}
+
+static bool ends_block(opcode_t opcode) {
+    return opcode == OP_JMP || opcode == OP_JZ || opcode == OP_JNZ ||
+           opcode == OP_JSR || opcode == OP_RTS;
+}
+
+// Decode the basic block starting at pc into the cache. A block ends after
+// a jump, call or return, and before the next address with a breakpoint,
+// so breakpoints only ever need checking at block entry.
+static decoded_instruction_t *decode_block(sap_vm_t *vm, uint16_t pc) {
+    uint16_t len = 0;
+    uint16_t addr = pc;
+
+    while (addr < MEMORY_SIZE && len < MAX_BLOCK_LENGTH) {
+        if (len > 0 && has_breakpoint(vm, addr)) {
+            break;
+        }
+        decoded_instruction_t *d = &vm->tcache[addr];
+        opcode_t opcode;
+        addressing_mode_t mode;
+        uint16_t operand;
+        d->ir = (uint16_t)vm->memory[addr];
+        vm_decode_instruction(d->ir, &opcode, &mode, &operand);
+        d->opcode = (uint8_t)opcode;
+        d->mode = (uint8_t)mode;
+        d->operand = operand;
+        d->immediate = (int16_t)((operand & 0x200) ? (operand | 0xFC00) : operand);
+        addr++;
+        len++;
+        if (ends_block(opcode)) {
             break;
         }
     }
+
+    for (uint16_t i = 0; i < len; i++) {
+        vm->tcache[pc + i].block_len = len - i;
+    }
+    vm->tcache_used = true;
+    return &vm->tcache[pc];
+}
+
+// Run from the translation cache: a block is executed without
+// re-decoding, with operands that need no memory indirection read directly.
+static result_t run_cached(sap_vm_t *vm, uint64_t max_cycles) {
+    result_t result = RESULT_OK;
+    uint64_t i = 0;
+
+    while (i < max_cycles && result == RESULT_OK) {
+        uint16_t pc = vm->cpu.pc;
+
+        if (vm_check_breakpoint(vm, pc)) {
+            vm->state = VM_BREAKPOINT;
+            result = RESULT_BREAKPOINT;
+            break;
+        }
+        if (!vm_is_valid_address(pc)) {
+            vm->last_pc = pc;
+            result = vm_set_error(vm, "PC out of bounds: 0x%04X", pc);
+            break;
+        }
+
+        decoded_instruction_t *d = &vm->tcache[pc];
+        if (d->block_len == 0) {
+            d = decode_block(vm, pc);
+        }
+
+        uint64_t n = d->block_len;
+        if (n > max_cycles - i) {
+            n = max_cycles - i;
+        }
+
+        for (uint64_t k = 0; k < n && result == RESULT_OK; k++, d++) {
+            vm->last_pc = vm->cpu.pc;
+            vm->cpu.ir = d->ir;
+            vm->cpu.pc++;
+            vm->cycle_count++;
+            i++;
+            if (vm->trace_ring) {
+                trace_record(vm, vm->last_pc, d->ir);
+            }
+
+            const int16_t *value_ref = NULL;
+            if (d->mode == ADDR_IMMEDIATE) {
+                value_ref = &d->immediate;
+            } else if (d->mode == ADDR_DIRECT && d->operand < MEMORY_SIZE) {
+                value_ref = &vm->memory[d->operand];
+            }
+
+            result = execute(vm, (opcode_t)d->opcode, (addressing_mode_t)d->mode,
+                             d->operand, value_ref);
+            if (d->block_len == 0) {
+                break;  // the block was overwritten while it ran
+            }
+        }
+    }
+
+    return result;
+}
+
+static bool any_breakpoints(const sap_vm_t *vm) {
+    for (int i = 0; i < vm->breakpoint_count; i++) {
+        if (vm->breakpoints[i].enabled) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Production run loop, used when there are no breakpoints and neither
+// debug output nor either kind of tracing: the CPU registers live in locals and are only
+// written back to the VM when the loop exits. Results, including error
+// messages, are the same as for vm_step().
+static result_t run_fast(sap_vm_t *vm, uint64_t max_cycles) {
+    int16_t *mem = vm->memory;
+    uint16_t pc = vm->cpu.pc;
+    uint16_t sp = vm->cpu.sp;
+    uint16_t x = vm->cpu.x_reg;
+    uint16_t ir = vm->cpu.ir;
+    uint16_t last_pc = vm->last_pc;
+    int16_t acc = vm->cpu.accumulator;
+    int32_t flag_result = vm->cpu.flag_result;
+    uint64_t cycles = vm->cycle_count;
+    result_t result = RESULT_OK;
+    int32_t r;
+
+#define SYNC() do { \
+        vm->cpu.pc = pc; vm->cpu.sp = sp; vm->cpu.x_reg = x; vm->cpu.ir = ir; \
+        vm->cpu.accumulator = acc; vm->cpu.flag_result = flag_result; \
+        vm->last_pc = last_pc; vm->cycle_count = cycles; \
+    } while (0)
+#define FAIL(...) do { SYNC(); result = vm_set_error(vm, __VA_ARGS__); goto done; } while (0)
+#define FLAGS(v) (flag_result = (v))
+
+    for (uint64_t i = 0; i < max_cycles; i++) {
+        last_pc = pc;
+        if (pc >= MEMORY_SIZE) {
+            FAIL("PC out of bounds: 0x%04X", pc);
+        }
+        ir = (uint16_t)mem[pc++];
+        cycles++;
+
+        opcode_t opcode = (opcode_t)((ir & OPCODE_MASK) >> OPCODE_SHIFT);
+        addressing_mode_t mode = (addressing_mode_t)((ir & ADDR_MODE_MASK) >> ADDR_MODE_SHIFT);
+        uint16_t operand = ir & OPERAND_MASK;
+        uint16_t addr = operand;
+        int16_t v = 0;
+
+        // operand value for everything but the store, jumps and RTS
+        if (opcode != OP_NOP && opcode != OP_STA && opcode < OP_JMP) {
+            switch (mode) {
+                case ADDR_IMMEDIATE:
+                    v = (int16_t)((operand & 0x200) ? (operand | 0xFC00) : operand);
+                    break;
+                case ADDR_DIRECT:
+                    if (operand >= MEMORY_SIZE) FAIL("Invalid direct address 0x%04X", operand);
+                    v = mem[operand];
+                    break;
+                case ADDR_INDIRECT:
+                    if (operand >= MEMORY_SIZE) FAIL("Invalid indirect address 0x%04X", operand);
+                    addr = (uint16_t)mem[operand];
+                    if (addr >= MEMORY_SIZE) FAIL("Invalid indirect target address 0x%04X", addr);
+                    v = mem[addr];
+                    break;
+                case ADDR_INDEXED:
+                    addr = operand + x;
+                    if (addr >= MEMORY_SIZE) FAIL("Invalid indexed address 0x%04X", addr);
+                    v = mem[addr];
+                    break;
+            }
+        }
+
+        switch (opcode) {
+            case OP_NOP:
+                break;
+            case OP_LDA:
+                acc = v;
+                FLAGS(acc);
+                break;
+            case OP_STA:
+                switch (mode) {
+                    case ADDR_IMMEDIATE:
+                        FAIL("Cannot store to immediate value");
+                    case ADDR_DIRECT:
+                        if (operand >= MEMORY_SIZE) FAIL("Invalid direct store address 0x%04X", operand);
+                        break;
+                    case ADDR_INDIRECT:
+                        if (operand >= MEMORY_SIZE) FAIL("Invalid indirect store address 0x%04X", operand);
+                        addr = (uint16_t)mem[operand];
+                        if (addr >= MEMORY_SIZE) FAIL("Invalid indirect target store address 0x%04X", addr);
+                        break;
+                    case ADDR_INDEXED:
+                        addr = operand + x;
+                        if (addr >= MEMORY_SIZE) FAIL("Invalid indexed store address 0x%04X", addr);
+                        break;
+                }
+                mem[addr] = acc;
+                break;
+            case OP_ADD:
+                r = (int32_t)acc + v;
+                acc = (int16_t)r;
+                FLAGS(r);
+                break;
+            case OP_SUB:
+                r = (int32_t)acc - v;
+                acc = (int16_t)r;
+                FLAGS(r);
+                break;
+            case OP_MUL:
+                r = (int32_t)acc * v;
+                acc = (int16_t)r;
+                FLAGS(r);
+                break;
+            case OP_DIV:
+                if (v == 0) FAIL("Division by zero");
+                r = (int32_t)acc / v;
+                acc = (int16_t)r;
+                FLAGS(r);
+                break;
+            case OP_AND:
+                acc &= v;
+                FLAGS(acc);
+                break;
+            case OP_OR:
+                acc |= v;
+                FLAGS(acc);
+                break;
+            case OP_XOR:
+                acc ^= v;
+                FLAGS(acc);
+                break;
+            case OP_CMP:
+                r = (int32_t)acc - v;
+                FLAGS(r);
+                break;
+            case OP_JMP:
+                if (operand >= MEMORY_SIZE) FAIL("Invalid jump address 0x%04X", operand);
+                pc = operand;
+                break;
+            case OP_JZ:
+                if (flag_result == 0) {
+                    if (operand >= MEMORY_SIZE) FAIL("Invalid jump address 0x%04X", operand);
+                    pc = operand;
+                }
+                break;
+            case OP_JNZ:
+                if (flag_result != 0) {
+                    if (operand >= MEMORY_SIZE) FAIL("Invalid jump address 0x%04X", operand);
+                    pc = operand;
+                }
+                break;
+            case OP_JSR:
+                if (operand >= MEMORY_SIZE) FAIL("Invalid subroutine address 0x%04X", operand);
+                if (sp == 0) FAIL("Stack overflow");
+                mem[sp] = (int16_t)pc;
+                sp--;
+                pc = operand;
+                break;
+            case OP_RTS:
+                if (operand == 0) {
+                    if (sp >= STACK_TOP) FAIL("Stack underflow");
+                    sp++;
+                    pc = (uint16_t)mem[sp];
+                } else {
+                    SYNC();
+                    vm->state = VM_HALTED;
+                    return RESULT_HALT;
+                }
+                break;
+            default:
+                FAIL("Invalid opcode 0x%X", opcode);
+        }
+    }
+
+    SYNC();
+done:
+    return result;
+
+#undef SYNC
+#undef FAIL
+#undef FLAGS
+}
+
+// vm_run() without any output of its own, for callers running many VMs
+result_t vm_run_quiet(sap_vm_t *vm, uint64_t max_cycles) {
+    vm->state = VM_RUNNING;
+    result_t result = RESULT_OK;
     
+    if (vm->trace_enabled) {
+        // tracing prints every instruction, so it goes step by step
+        for (uint64_t i = 0; i < max_cycles && result == RESULT_OK; i++) {
+            result = vm_step(vm);
+        }
+    } else if (!vm->debug_enabled && !any_breakpoints(vm) && !vm->trace_ring) {
+        vm_flush_cache(vm);
+        result = run_fast(vm, max_cycles);
+    } else {
+        // memory may have been written directly since the last run
+        vm_flush_cache(vm);
+        result = run_cached(vm, max_cycles);
+    }
+
     if (vm->state == VM_RUNNING && result == RESULT_OK) {
         vm->state = VM_STOPPED;
+    }
+    if (vm->trace_ring && vm->trace_ring->dump_file[0] &&
+        (result == RESULT_HALT || result == RESULT_ERROR)) {
+        vm_trace_dump(vm, vm->trace_ring->dump_file);
+    }
+    return result;
+}
+
+result_t vm_run(sap_vm_t *vm, uint64_t max_cycles) {
+    if (vm->debug_enabled) {
+        printf("Starting run at PC=0x%04X, state=%s\n", vm->cpu.pc, vm_state_to_string(vm->state));
+    }
+    
+    result_t result = vm_run_quiet(vm, max_cycles);
+
+    if (result == RESULT_BREAKPOINT) {
+        printf("Breakpoint hit at PC=0x%04X\n", vm->last_pc);
+    }
+    
+    if (vm->state == VM_STOPPED && result == RESULT_OK) {
         printf("Execution stopped after %llu cycles (limit reached)\n", max_cycles);
     }
     
@@ -432,14 +808,14 @@ static void print_formatted_value(FILE *out, const char *label, int value, bool
 }
 
 void vm_print_state(sap_vm_t *vm) {
+    cpu_flags_t flags = vm_flags(vm);
     printf("VM State: %s | Cycles: %llu\n", vm_state_to_string(vm->state), vm->cycle_count);
     print_formatted_address(stdout, "PC", vm->cpu.pc);
     print_formatted_value(stdout, "ACC", vm->cpu.accumulator, true);
     print_formatted_value(stdout, "X", vm->cpu.x_reg, true);
     print_formatted_address(stdout, "SP", vm->cpu.sp);
     printf("Flags    : Z:%d N:%d C:%d O:%d\n", 
-           vm->cpu.flags.zero, vm->cpu.flags.negative, 
-           vm->cpu.flags.carry, vm->cpu.flags.overflow);
+           flags.zero, flags.negative, flags.carry, flags.overflow);
     if (vm->state == VM_ERROR) {
         printf("Last Error: %s\n", vm->last_error);
     }
@@ -459,6 +835,20 @@ void vm_print_memory(sap_vm_t *vm, uint16_t start, uint16_t end) {
     printf("\n");
 }
 
+// Mnemonic and operand, e.g. "LDA #42", as in the disassembly
+void vm_format_instruction(uint16_t instruction, char *buf, size_t size) {
+    opcode_t opcode;
+    addressing_mode_t mode;
+    uint16_t operand;
+    vm_decode_instruction(instruction, &opcode, &mode, &operand);
+    if (opcode != OP_NOP && opcode != OP_RTS) {
+        snprintf(buf, size, "%s %s%d", opcode_to_string(opcode),
+                 addressing_mode_to_string(mode), operand);
+    } else {
+        snprintf(buf, size, "%s", opcode_to_string(opcode));
+    }
+}
+
 void vm_print_disassembly(sap_vm_t *vm, uint16_t start, uint16_t count) {
     printf("Disassembly from 0x%04X:\n", start);
     for (uint16_t i = 0; i < count && (start + i) < MEMORY_SIZE; i++) {
@@ -466,15 +856,9 @@ void vm_print_disassembly(sap_vm_t *vm, uint16_t start, uint16_t count) {
         uint16_t instruction = vm->memory[addr];
         if (instruction == 0) continue;
         
-        opcode_t opcode;
-        addressing_mode_t mode;
-        uint16_t operand;
-        vm_decode_instruction(instruction, &opcode, &mode, &operand);
-        
-        printf("0x%04X: %04X  %s", addr, instruction, opcode_to_string(opcode));
-        if (opcode != OP_NOP && opcode != OP_RTS) {
-            printf(" %s%d", addressing_mode_to_string(mode), operand);
-        }
+        char text[32];
+        vm_format_instruction(instruction, text, sizeof(text));
+        printf("0x%04X: %04X  %s", addr, instruction, text);
         if (addr == vm->cpu.pc) {
             printf(" <-- PC");
         }
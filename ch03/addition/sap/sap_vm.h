@@ -1,6 +1,7 @@
 #ifndef SAP_VM_H
 #define SAP_VM_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -34,22 +35,70 @@ typedef struct {
     bool overflow;
 } cpu_flags_t;
 
+// The flags are not kept, but the 32-bit result that last set them: each
+// op that sets flags sets all four from its result alone, the same way.
+// They are worked out only when read, by vm_flags(); JZ and JNZ just
+// compare the result with zero. FLAGS_CLEAR is a result that sets none.
+#define FLAGS_CLEAR 1
+
 typedef struct {
     uint16_t pc;
     uint16_t sp;
     int16_t accumulator;
     uint16_t x_reg;
     uint16_t ir;
-    cpu_flags_t flags;
+    int32_t flag_result;
 } cpu_t;
 
+// A breakpoint stops only when its condition holds. The condition is
+// compiled once, when it is set, into postfix code (see
+// vm_set_breakpoint_condition()); code_len 0 means no condition.
+#define BP_CODE_SIZE 128
+
 typedef struct {
     uint16_t address;
     bool enabled;
     uint32_t hit_count;
     char condition[64];
+    uint8_t code[BP_CODE_SIZE];
+    uint8_t code_len;
 } breakpoint_t;
 
+// Translation cache entry: an instruction decoded once, keyed by its
+// address. block_len counts the instructions from here to the end of its
+// basic block, 0 means the address has not been decoded.
+typedef struct {
+    uint16_t ir;
+    uint16_t operand;
+    int16_t immediate;      // sign extended operand for ADDR_IMMEDIATE
+    uint8_t opcode;
+    uint8_t mode;
+    uint16_t block_len;
+} decoded_instruction_t;
+
+// Binary instruction trace (sap_vm_trace.c): a ring of the last records,
+// one per instruction, taken before it executes
+#define SAP_TRACE_ZERO 1
+#define SAP_TRACE_NEGATIVE 2
+#define SAP_TRACE_CARRY 4
+#define SAP_TRACE_OVERFLOW 8
+
+typedef struct {
+    uint64_t cycle;
+    uint16_t pc;
+    uint16_t ir;
+    int16_t accumulator;
+    uint8_t flags;          // SAP_TRACE_ZERO | SAP_TRACE_NEGATIVE | ...
+    uint8_t unused;
+} sap_trace_record_t;
+
+typedef struct {
+    sap_trace_record_t *records;
+    uint32_t mask;          // records - 1, the size is a power of two
+    uint64_t count;         // records ever written
+    char dump_file[256];    // written on halt or error, empty for none
+} sap_trace_t;
+
 typedef struct {
     cpu_t cpu;
     int16_t memory[1024];
@@ -62,12 +111,18 @@ typedef struct {
     uint16_t error_address;
     breakpoint_t breakpoints[32];
     int breakpoint_count;
+    uint32_t breakpoint_map[1024 / 32];     // a bit per address with a breakpoint
+    decoded_instruction_t tcache[1024];
+    bool tcache_used;
+    sap_trace_t *trace_ring;            // NULL unless vm_trace_start()
 } sap_vm_t;
 
 // Core VM functions
 void vm_init(sap_vm_t *vm);
 void vm_reset(sap_vm_t *vm);
+void vm_reset_cpu(sap_vm_t *vm);
 void vm_destroy(sap_vm_t *vm);
+cpu_flags_t vm_flags(const sap_vm_t *vm);
 bool vm_is_valid_address(uint16_t address);
 int16_t vm_read_memory(sap_vm_t *vm, uint16_t address);
 result_t vm_write_memory(sap_vm_t *vm, uint16_t address, int16_t value);
@@ -75,6 +130,8 @@ result_t vm_set_error(sap_vm_t *vm, const char *format, ...);
 result_t vm_step(sap_vm_t *vm);
 result_t vm_run(sap_vm_t *vm, uint64_t max_cycles);
 result_t vm_run_until_halt(sap_vm_t *vm);
+void vm_flush_cache(sap_vm_t *vm);
+result_t vm_run_quiet(sap_vm_t *vm, uint64_t max_cycles);
 uint16_t vm_encode_instruction(opcode_t opcode, addressing_mode_t mode, uint16_t operand);
 void vm_decode_instruction(uint16_t instruction, opcode_t *opcode, 
                          addressing_mode_t *mode, uint16_t *operand);
@@ -84,10 +141,95 @@ const char *vm_state_to_string(vm_state_t state);
 void vm_print_state(sap_vm_t *vm);
 void vm_print_memory(sap_vm_t *vm, uint16_t start, uint16_t end);
 void vm_print_disassembly(sap_vm_t *vm, uint16_t start, uint16_t count);
+void vm_format_instruction(uint16_t instruction, char *buf, size_t size);
+
+// Batch execution of independent VMs across a pool of worker threads
+typedef struct {
+    size_t halted;
+    size_t errors;
+    size_t stopped;         // cycle limit or breakpoint
+    uint64_t total_cycles;
+    int threads;            // workers actually used
+} batch_summary_t;
+
+batch_summary_t vm_run_batch(sap_vm_t *vms, size_t n, uint64_t max_cycles, int threads);
+
+// Binary program images (sap_vm_image.c). A file is a 16-byte header
+// (magic "SAPI", version, entry point, base address, word count, symbol
+// count), the words to load at base and the symbols, all little-endian.
+// Opening an image maps the file and decodes it once into a full memory
+// template; loading it into a VM is then one copy into vm->memory.
+#define SAP_IMAGE_MAGIC "SAPI"
+#define SAP_IMAGE_VERSION 1
+#define SAP_SYMBOL_NAME 16
+
+typedef struct {
+    char name[SAP_SYMBOL_NAME];     // NUL padded, not always terminated
+    uint16_t address;
+} sap_symbol_t;
+
+typedef struct sap_image {
+    int16_t memory[1024];           // the words at base, zero elsewhere
+    uint16_t entry;
+    uint16_t base;
+    uint16_t length;                // words in the file
+    int symbol_count;
+    sap_symbol_t *symbols;
+} sap_image_t;
+
+// Images shared between VMs (and threads) by file name
+typedef struct sap_image_cache sap_image_cache_t;
+
+result_t vm_save_image(sap_vm_t *vm, const char *filename, uint16_t start_addr,
+                       uint16_t end_addr, uint16_t entry,
+                       const sap_symbol_t *symbols, int symbol_count);
+sap_image_t *vm_image_open(sap_vm_t *vm, const char *filename);
+void vm_image_close(sap_image_t *image);
+result_t vm_image_load(sap_vm_t *vm, const sap_image_t *image);
+int vm_image_symbol(const sap_image_t *image, const char *name);
+sap_image_cache_t *vm_image_cache_new(void);
+void vm_image_cache_free(sap_image_cache_t *cache);
+const sap_image_t *vm_image_cache_get(sap_image_cache_t *cache, sap_vm_t *vm,
+                                      const char *filename);
+result_t vm_load_image(sap_vm_t *vm, sap_image_cache_t *cache, const char *filename);
+
+// Assembler (sap_vm_asm.c): SAP assembly, a statement a line, into an
+// image with its labels as symbols, in one pass. A sap_asm_t takes the
+// lines one at a time, so a source is never needed whole; errors carry
+// the line number and go through vm. A sap_asm_cache_t keeps images by
+// a hash of their source text, shared between threads, and
+// vm_assemble_batch() fills one from many sources on a pool of threads.
+typedef struct sap_asm sap_asm_t;
+typedef struct sap_asm_cache sap_asm_cache_t;
+
+sap_asm_t *vm_asm_new(sap_vm_t *vm);
+result_t vm_asm_line(sap_asm_t *a, const char *line);
+result_t vm_asm_finish(sap_asm_t *a, sap_image_t **image);
+void vm_asm_free(sap_asm_t *a);
+result_t vm_assemble(sap_vm_t *vm, const char *source, sap_image_t **image);
+result_t vm_assemble_file(sap_vm_t *vm, const char *filename, sap_image_t **image);
+sap_asm_cache_t *vm_asm_cache_new(void);
+void vm_asm_cache_free(sap_asm_cache_t *cache);
+const sap_image_t *vm_asm_cache_get(sap_asm_cache_t *cache, sap_vm_t *vm, const char *source);
+void vm_asm_cache_stats(sap_asm_cache_t *cache, size_t *hits, size_t *misses);
+size_t vm_assemble_batch(sap_asm_cache_t *cache, const char *const *sources, size_t n,
+                         const sap_image_t **images, int threads);
+
+// Binary trace files are an 8-byte header (magic "SAPT", version, 0)
+// and a 32-bit record count, then the records oldest first, 16 bytes
+// each, all little-endian
+#define SAP_TRACE_MAGIC "SAPT"
+#define SAP_TRACE_VERSION 1
+
+result_t vm_trace_start(sap_vm_t *vm, uint32_t records, const char *dump_file);
+void vm_trace_stop(sap_vm_t *vm);
+result_t vm_trace_dump(sap_vm_t *vm, const char *filename);
+long vm_trace_read(const char *filename, sap_trace_record_t **records);
 
 // Debug support functions
 result_t vm_add_breakpoint(sap_vm_t *vm, uint16_t address);
 result_t vm_remove_breakpoint(sap_vm_t *vm, uint16_t address);
+result_t vm_set_breakpoint_condition(sap_vm_t *vm, uint16_t address, const char *condition);
 void vm_list_breakpoints(sap_vm_t *vm);
 bool vm_check_breakpoint(sap_vm_t *vm, uint16_t address);
 result_t vm_load_program(sap_vm_t *vm, const char *filename);
@@ -0,0 +1,767 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "sap_vm.h"
+#include "sap_vm_config.h"
+
+// Source is a statement a line, assembled as the lines come in:
+//
+//   [label:] [mnemonic [operand] | .org expr | .word expr, ... | .entry expr] [; comment]
+//
+// Operands are written as the disassembler prints them: #expr immediate,
+// expr direct, @expr indirect, ,Xexpr (or expr,X) indexed. An expr is a
+// number (decimal or 0x hex), a label, or a label plus or minus numbers.
+// RTS alone returns, HLT [code] is RTS #code and halts (code 1 if left out).
+//
+// Labels resolve in the one pass: a use whose label is not yet defined
+// goes on that label's list of fixups, and the list is patched when the
+// label turns up. What is still on a list at the end is an error.
+
+typedef enum {
+    FIX_IMMEDIATE,      // the operand field of an instruction, -512..511
+    FIX_ADDRESS,        // the operand field, an address
+    FIX_WORD,           // a whole word from .word
+    FIX_ENTRY           // the entry point from .entry
+} fixup_kind_t;
+
+typedef struct {
+    uint16_t at;
+    uint8_t kind;
+    int32_t offset;     // added to the label
+    int line;
+    int next;           // next fixup of the same label, -1 at the end
+} fixup_t;
+
+typedef struct {
+    char name[SAP_SYMBOL_NAME + 1];
+    uint32_t hash;
+    int32_t value;
+    bool defined;
+    int fixups;         // first waiting fixup, -1 for none
+    int line;           // of the first use or the definition
+} asm_symbol_t;
+
+struct sap_asm {
+    sap_vm_t *vm;                   // for errors
+    sap_image_t *image;
+    uint32_t written[MEMORY_SIZE / 32];
+    uint16_t at;                    // next word goes here
+    int lowest, highest;            // written, -1 before the first word
+    int line;
+    asm_symbol_t *symbols;
+    int symbol_count, symbol_capacity;
+    fixup_t *fixups;
+    int fixup_count, fixup_capacity;
+    bool failed;
+};
+
+typedef struct {
+    int symbol;         // -1 for a plain number
+    int32_t value;      // the number, or the offset from the label
+} asm_expr_t;
+
+static const char *const mnemonics[16] = {
+    "NOP", "LDA", "STA", "ADD", "SUB", "MUL", "DIV", "AND",
+    "OR", "XOR", "CMP", "JMP", "JZ", "JNZ", "JSR", "RTS"
+};
+
+static uint32_t hash_name(const char *name, size_t n) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; i++) {
+        h = (h ^ (unsigned char)name[i]) * 16777619u;
+    }
+    return h;
+}
+
+static result_t asm_error(sap_asm_t *a, const char *what, const char *detail) {
+    a->failed = true;
+    return vm_set_error(a->vm, "Line %d: %s%s%s", a->line, what,
+                        detail ? ": " : "", detail ? detail : "");
+}
+
+sap_asm_t *vm_asm_new(sap_vm_t *vm) {
+    sap_asm_t *a = calloc(1, sizeof(sap_asm_t));
+    sap_image_t *image = calloc(1, sizeof(sap_image_t));
+    if (!a || !image) {
+        free(a);
+        free(image);
+        vm_set_error(vm, "Out of memory");
+        return NULL;
+    }
+    a->vm = vm;
+    a->image = image;
+    a->at = PROGRAM_START;
+    a->lowest = a->highest = -1;
+    image->entry = PROGRAM_START;
+    return a;
+}
+
+void vm_asm_free(sap_asm_t *a) {
+    if (a) {
+        vm_image_close(a->image);
+        free(a->symbols);
+        free(a->fixups);
+        free(a);
+    }
+}
+
+// --- symbols and fixups ---
+
+static int find_symbol(sap_asm_t *a, const char *name, size_t n) {
+    uint32_t h = hash_name(name, n);
+    for (int i = 0; i < a->symbol_count; i++) {
+        if (a->symbols[i].hash == h && strncmp(a->symbols[i].name, name, n) == 0 &&
+            a->symbols[i].name[n] == '\0') {
+            return i;
+        }
+    }
+    if (n > SAP_SYMBOL_NAME) {
+        return -2;
+    }
+    if (a->symbol_count == a->symbol_capacity) {
+        int capacity = a->symbol_capacity ? 2 * a->symbol_capacity : 32;
+        asm_symbol_t *grown = realloc(a->symbols, (size_t)capacity * sizeof(asm_symbol_t));
+        if (!grown) {
+            return -3;
+        }
+        a->symbols = grown;
+        a->symbol_capacity = capacity;
+    }
+    asm_symbol_t *s = &a->symbols[a->symbol_count];
+    memset(s, 0, sizeof(*s));
+    memcpy(s->name, name, n);
+    s->hash = h;
+    s->fixups = -1;
+    s->line = a->line;
+    return a->symbol_count++;
+}
+
+static result_t put_word(sap_asm_t *a, uint16_t at, int16_t word) {
+    if (a->written[at / 32] & (1u << (at % 32))) {
+        char where[16];
+        snprintf(where, sizeof(where), "0x%03X", at);
+        return asm_error(a, "Address written twice", where);
+    }
+    a->written[at / 32] |= 1u << (at % 32);
+    a->image->memory[at] = word;
+    if (a->lowest < 0 || at < a->lowest) a->lowest = at;
+    if (at > a->highest) a->highest = at;
+    return RESULT_OK;
+}
+
+// Put a value where a fixup says, checked for its kind
+static result_t patch(sap_asm_t *a, uint16_t at, fixup_kind_t kind, int32_t value) {
+    char number[16];
+    snprintf(number, sizeof(number), "%ld", (long)value);
+    switch (kind) {
+        case FIX_IMMEDIATE:
+            if (value < -512 || value > 511) {
+                return asm_error(a, "Immediate out of range -512..511", number);
+            }
+            break;
+        case FIX_ADDRESS:
+        case FIX_ENTRY:
+            if (value < 0 || value >= MEMORY_SIZE) {
+                return asm_error(a, "Address out of range", number);
+            }
+            break;
+        case FIX_WORD:
+            if (value < -32768 || value > 65535) {
+                return asm_error(a, "Word out of range", number);
+            }
+            a->image->memory[at] = (int16_t)(uint16_t)value;
+            return RESULT_OK;
+    }
+    if (kind == FIX_ENTRY) {
+        a->image->entry = (uint16_t)value;
+    } else {
+        uint16_t word = (uint16_t)a->image->memory[at];
+        a->image->memory[at] = (int16_t)((word & ~OPERAND_MASK) | ((uint16_t)value & OPERAND_MASK));
+    }
+    return RESULT_OK;
+}
+
+// The value of e at at now, or a fixup on its label for later
+static result_t resolve(sap_asm_t *a, const asm_expr_t *e, uint16_t at, fixup_kind_t kind) {
+    if (e->symbol < 0) {
+        return patch(a, at, kind, e->value);
+    }
+    asm_symbol_t *s = &a->symbols[e->symbol];
+    if (s->defined) {
+        return patch(a, at, kind, s->value + e->value);
+    }
+    if (a->fixup_count == a->fixup_capacity) {
+        int capacity = a->fixup_capacity ? 2 * a->fixup_capacity : 64;
+        fixup_t *grown = realloc(a->fixups, (size_t)capacity * sizeof(fixup_t));
+        if (!grown) {
+            return asm_error(a, "Out of memory", NULL);
+        }
+        a->fixups = grown;
+        a->fixup_capacity = capacity;
+    }
+    fixup_t *f = &a->fixups[a->fixup_count];
+    f->at = at;
+    f->kind = (uint8_t)kind;
+    f->offset = e->value;
+    f->line = a->line;
+    f->next = s->fixups;
+    s->fixups = a->fixup_count++;
+    return RESULT_OK;
+}
+
+static result_t define(sap_asm_t *a, const char *name, size_t n) {
+    int i = find_symbol(a, name, n);
+    if (i == -2) {
+        return asm_error(a, "Label longer than 16 characters", NULL);
+    }
+    if (i < 0) {
+        return asm_error(a, "Out of memory", NULL);
+    }
+    asm_symbol_t *s = &a->symbols[i];
+    if (s->defined) {
+        return asm_error(a, "Label defined twice", s->name);
+    }
+    s->defined = true;
+    s->value = a->at;
+    s->line = a->line;
+
+    // everything that waited for it, reported at its own line
+    int line = a->line;
+    for (int f = s->fixups; f >= 0; f = a->fixups[f].next) {
+        a->line = a->fixups[f].line;
+        if (patch(a, a->fixups[f].at, (fixup_kind_t)a->fixups[f].kind,
+                  s->value + a->fixups[f].offset) != RESULT_OK) {
+            return RESULT_ERROR;
+        }
+    }
+    a->line = line;
+    s->fixups = -1;
+    return RESULT_OK;
+}
+
+// --- parsing ---
+
+static const char *skip_space(const char *p) {
+    while (*p == ' ' || *p == '\t') p++;
+    return p;
+}
+
+static bool is_name_start(char c) {
+    return isalpha((unsigned char)c) || c == '_';
+}
+
+static bool is_name_char(char c) {
+    return isalnum((unsigned char)c) || c == '_';
+}
+
+// number, label, or label with numbers added and taken off; at most one
+// label, and not taken off
+static result_t parse_expr(sap_asm_t *a, const char **pp, asm_expr_t *e) {
+    const char *p = skip_space(*pp);
+    e->symbol = -1;
+    e->value = 0;
+    int sign = 1;
+    bool first = true;
+
+    for (;;) {
+        if (*p == '-' && first) {
+            sign = -1;
+            p = skip_space(p + 1);
+        }
+        if (isdigit((unsigned char)*p)) {
+            char *end;
+            bool hex = p[0] == '0' && (p[1] == 'x' || p[1] == 'X');
+            long v = strtol(p, &end, hex ? 16 : 10);
+            if (is_name_char(*end) || v > 65535) {
+                return asm_error(a, "Bad number", NULL);
+            }
+            e->value += sign * (int32_t)v;
+            p = end;
+        } else if (is_name_start(*p)) {
+            const char *start = p;
+            while (is_name_char(*p)) p++;
+            if (e->symbol >= 0 || sign < 0) {
+                return asm_error(a, "Only one label can be added in an expression", NULL);
+            }
+            e->symbol = find_symbol(a, start, (size_t)(p - start));
+            if (e->symbol == -2) {
+                return asm_error(a, "Label longer than 16 characters", NULL);
+            }
+            if (e->symbol < 0) {
+                return asm_error(a, "Out of memory", NULL);
+            }
+        } else {
+            return asm_error(a, "Expected a number or a label", NULL);
+        }
+        p = skip_space(p);
+        if (*p != '+' && *p != '-') {
+            break;
+        }
+        sign = (*p == '-') ? -1 : 1;
+        p = skip_space(p + 1);
+        first = false;
+    }
+    *pp = p;
+    return RESULT_OK;
+}
+
+static result_t expect_end(sap_asm_t *a, const char *p) {
+    p = skip_space(p);
+    if (*p != '\0') {
+        return asm_error(a, "Unexpected text", p);
+    }
+    return RESULT_OK;
+}
+
+static result_t emit(sap_asm_t *a, uint16_t word, uint16_t *at) {
+    if (a->at >= MEMORY_SIZE) {
+        return asm_error(a, "Program does not fit in memory", NULL);
+    }
+    *at = a->at++;
+    return put_word(a, *at, (int16_t)word);
+}
+
+static result_t directive(sap_asm_t *a, const char *name, size_t n, const char *p) {
+    asm_expr_t e;
+    if (n == 4 && strncmp(name, ".org", 4) == 0) {
+        if (parse_expr(a, &p, &e) != RESULT_OK || expect_end(a, p) != RESULT_OK) {
+            return RESULT_ERROR;
+        }
+        if (e.symbol >= 0 && !a->symbols[e.symbol].defined) {
+            return asm_error(a, ".org needs a label defined above it", a->symbols[e.symbol].name);
+        }
+        int32_t value = e.value + (e.symbol >= 0 ? a->symbols[e.symbol].value : 0);
+        if (value < 0 || value >= MEMORY_SIZE) {
+            return asm_error(a, ".org out of memory", NULL);
+        }
+        a->at = (uint16_t)value;
+        return RESULT_OK;
+    }
+    if (n == 5 && strncmp(name, ".word", 5) == 0) {
+        for (;;) {
+            uint16_t at = 0;
+            if (parse_expr(a, &p, &e) != RESULT_OK || emit(a, 0, &at) != RESULT_OK ||
+                resolve(a, &e, at, FIX_WORD) != RESULT_OK) {
+                return RESULT_ERROR;
+            }
+            p = skip_space(p);
+            if (*p != ',') {
+                return expect_end(a, p);
+            }
+            p++;
+        }
+    }
+    if (n == 6 && strncmp(name, ".entry", 6) == 0) {
+        if (parse_expr(a, &p, &e) != RESULT_OK || expect_end(a, p) != RESULT_OK) {
+            return RESULT_ERROR;
+        }
+        return resolve(a, &e, 0, FIX_ENTRY);
+    }
+    return asm_error(a, "Unknown directive", NULL);
+}
+
+static result_t instruction(sap_asm_t *a, const char *name, size_t n, const char *p) {
+    char upper[8];
+    if (n >= sizeof(upper)) {
+        return asm_error(a, "Unknown instruction", NULL);
+    }
+    for (size_t i = 0; i < n; i++) upper[i] = (char)toupper((unsigned char)name[i]);
+    upper[n] = '\0';
+
+    int opcode = -1;
+    for (int op = 0; op < 16; op++) {
+        if (strcmp(upper, mnemonics[op]) == 0) opcode = op;
+    }
+    bool halt = strcmp(upper, "HLT") == 0;
+    if (opcode < 0 && !halt) {
+        return asm_error(a, "Unknown instruction", upper);
+    }
+
+    addressing_mode_t mode = ADDR_DIRECT;
+    asm_expr_t e = { -1, 0 };
+    p = skip_space(p);
+    if (halt || opcode == OP_NOP || opcode == OP_RTS) {
+        // an optional code: HLT defaults to 1; a bare RTS returns
+        mode = ADDR_IMMEDIATE;
+        e.value = halt ? 1 : 0;
+        if (*p == '#') p++;
+        if (*skip_space(p) != '\0' && parse_expr(a, &p, &e) != RESULT_OK) {
+            return RESULT_ERROR;
+        }
+        if (halt && e.symbol < 0 && e.value == 0) {
+            return asm_error(a, "HLT 0 would return: the code must not be 0", NULL);
+        }
+        if (halt) opcode = OP_RTS;
+    } else {
+        if (*p == '#') {
+            mode = ADDR_IMMEDIATE;
+            p++;
+        } else if (*p == '@') {
+            mode = ADDR_INDIRECT;
+            p++;
+        } else if (p[0] == ',' && toupper((unsigned char)p[1]) == 'X') {
+            mode = ADDR_INDEXED;
+            p += 2;
+        } else if (*p == '\0') {
+            return asm_error(a, "Missing operand", upper);
+        }
+        if (parse_expr(a, &p, &e) != RESULT_OK) {
+            return RESULT_ERROR;
+        }
+        p = skip_space(p);
+        if (mode == ADDR_DIRECT && p[0] == ',' && toupper((unsigned char)p[1]) == 'X') {
+            mode = ADDR_INDEXED;
+            p += 2;
+        }
+        if (mode == ADDR_IMMEDIATE && (opcode == OP_STA || opcode >= OP_JMP)) {
+            return asm_error(a, "No immediate operand for", upper);
+        }
+    }
+    if (expect_end(a, p) != RESULT_OK) {
+        return RESULT_ERROR;
+    }
+
+    uint16_t at = 0;
+    if (emit(a, vm_encode_instruction((opcode_t)opcode, mode, 0), &at) != RESULT_OK) {
+        return RESULT_ERROR;
+    }
+    return resolve(a, &e, at, mode == ADDR_IMMEDIATE ? FIX_IMMEDIATE : FIX_ADDRESS);
+}
+
+result_t vm_asm_line(sap_asm_t *a, const char *text) {
+    if (a->failed) {
+        return RESULT_ERROR;
+    }
+    a->line++;
+
+    char buf[MAX_INPUT_SIZE];
+    size_t len = strcspn(text, ";\r\n");
+    if (len >= sizeof(buf)) {
+        return asm_error(a, "Line too long", NULL);
+    }
+    memcpy(buf, text, len);
+    buf[len] = '\0';
+
+    const char *p = skip_space(buf);
+    const char *name = p;
+    if (*p == '.') p++;
+    while (is_name_char(*p)) p++;
+    size_t n = (size_t)(p - name);
+
+    if (*p == ':' && n > 0 && is_name_start(*name)) {
+        if (define(a, name, n) != RESULT_OK) {
+            return RESULT_ERROR;
+        }
+        p = skip_space(p + 1);
+        name = p;
+        if (*p == '.') p++;
+        while (is_name_char(*p)) p++;
+        n = (size_t)(p - name);
+    }
+    if (n == 0) {
+        return expect_end(a, p);
+    }
+    if (name[0] == '.') {
+        return directive(a, name, n, p);
+    }
+    return instruction(a, name, n, p);
+}
+
+result_t vm_asm_finish(sap_asm_t *a, sap_image_t **image) {
+    *image = NULL;
+    if (a->failed) {
+        vm_asm_free(a);
+        return RESULT_ERROR;
+    }
+    for (int i = 0; i < a->symbol_count; i++) {
+        if (!a->symbols[i].defined) {
+            a->line = a->symbols[i].line;
+            asm_error(a, "Undefined label", a->symbols[i].name);
+            vm_asm_free(a);
+            return RESULT_ERROR;
+        }
+    }
+
+    sap_image_t *out = a->image;
+    out->symbols = calloc(a->symbol_count > 0 ? (size_t)a->symbol_count : 1, sizeof(sap_symbol_t));
+    if (!out->symbols) {
+        sap_vm_t *vm = a->vm;
+        vm_asm_free(a);
+        return vm_set_error(vm, "Out of memory");
+    }
+    for (int i = 0; i < a->symbol_count; i++) {
+        memcpy(out->symbols[i].name, a->symbols[i].name, SAP_SYMBOL_NAME);
+        out->symbols[i].address = (uint16_t)a->symbols[i].value;
+    }
+    out->symbol_count = a->symbol_count;
+    if (a->lowest >= 0) {
+        out->base = (uint16_t)a->lowest;
+        out->length = (uint16_t)(a->highest - a->lowest + 1);
+    }
+    *image = out;
+    a->image = NULL;
+    vm_asm_free(a);
+    return RESULT_OK;
+}
+
+result_t vm_assemble(sap_vm_t *vm, const char *source, sap_image_t **image) {
+    *image = NULL;
+    sap_asm_t *a = vm_asm_new(vm);
+    if (!a) {
+        return RESULT_ERROR;
+    }
+    for (const char *line = source; *line; ) {
+        size_t len = strcspn(line, "\n");
+        char buf[MAX_INPUT_SIZE];
+        if (len >= sizeof(buf)) {
+            a->line++;
+            asm_error(a, "Line too long", NULL);
+            break;
+        }
+        memcpy(buf, line, len);
+        buf[len] = '\0';
+        if (vm_asm_line(a, buf) != RESULT_OK) {
+            break;
+        }
+        line += len + (line[len] == '\n');
+    }
+    return vm_asm_finish(a, image);
+}
+
+// A line at a time from the file, never all of it in memory
+result_t vm_assemble_file(sap_vm_t *vm, const char *filename, sap_image_t **image) {
+    *image = NULL;
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        return vm_set_error(vm, "Cannot open file: %s", filename);
+    }
+    sap_asm_t *a = vm_asm_new(vm);
+    if (!a) {
+        fclose(file);
+        return RESULT_ERROR;
+    }
+    char buf[MAX_INPUT_SIZE];
+    while (fgets(buf, sizeof(buf), file)) {
+        if (!strchr(buf, '\n') && !feof(file)) {
+            a->line++;
+            asm_error(a, "Line too long", NULL);
+            break;
+        }
+        if (vm_asm_line(a, buf) != RESULT_OK) {
+            break;
+        }
+    }
+    fclose(file);
+    return vm_asm_finish(a, image);
+}
+
+// --- the cache ---
+
+// Images by the content of their source: FNV-1a over the text picks the
+// bucket, and the source kept with the image settles it. Assembly runs
+// outside the lock, so threads assemble different sources at once; two
+// threads on the same new source may both assemble it, and the first to
+// get back in wins
+#define ASM_CACHE_BUCKETS 4096
+
+typedef struct asm_entry {
+    uint64_t hash;
+    char *source;
+    sap_image_t *image;
+    struct asm_entry *next;
+} asm_entry_t;
+
+struct sap_asm_cache {
+    pthread_mutex_t lock;
+    asm_entry_t *buckets[ASM_CACHE_BUCKETS];
+    size_t hits;
+    size_t misses;
+};
+
+static uint64_t hash_source(const char *source) {
+    uint64_t h = 14695981039346656037ull;
+    for (const unsigned char *p = (const unsigned char *)source; *p; p++) {
+        h = (h ^ *p) * 1099511628211ull;
+    }
+    return h;
+}
+
+static const sap_image_t *cache_find(sap_asm_cache_t *cache, uint64_t hash, const char *source) {
+    for (asm_entry_t *e = cache->buckets[hash % ASM_CACHE_BUCKETS]; e; e = e->next) {
+        if (e->hash == hash && strcmp(e->source, source) == 0) {
+            return e->image;
+        }
+    }
+    return NULL;
+}
+
+sap_asm_cache_t *vm_asm_cache_new(void) {
+    sap_asm_cache_t *cache = calloc(1, sizeof(sap_asm_cache_t));
+    if (cache) {
+        pthread_mutex_init(&cache->lock, NULL);
+    }
+    return cache;
+}
+
+void vm_asm_cache_free(sap_asm_cache_t *cache) {
+    if (!cache) {
+        return;
+    }
+    for (size_t b = 0; b < ASM_CACHE_BUCKETS; b++) {
+        asm_entry_t *e = cache->buckets[b];
+        while (e) {
+            asm_entry_t *next = e->next;
+            vm_image_close(e->image);
+            free(e->source);
+            free(e);
+            e = next;
+        }
+    }
+    pthread_mutex_destroy(&cache->lock);
+    free(cache);
+}
+
+void vm_asm_cache_stats(sap_asm_cache_t *cache, size_t *hits, size_t *misses) {
+    pthread_mutex_lock(&cache->lock);
+    *hits = cache->hits;
+    *misses = cache->misses;
+    pthread_mutex_unlock(&cache->lock);
+}
+
+const sap_image_t *vm_asm_cache_get(sap_asm_cache_t *cache, sap_vm_t *vm, const char *source) {
+    uint64_t hash = hash_source(source);
+    pthread_mutex_lock(&cache->lock);
+    const sap_image_t *found = cache_find(cache, hash, source);
+    if (found) {
+        cache->hits++;
+    } else {
+        cache->misses++;
+    }
+    pthread_mutex_unlock(&cache->lock);
+    if (found) {
+        return found;
+    }
+
+    sap_image_t *image;
+    if (vm_assemble(vm, source, &image) != RESULT_OK) {
+        return NULL;
+    }
+    asm_entry_t *e = calloc(1, sizeof(asm_entry_t));
+    char *copy = e ? malloc(strlen(source) + 1) : NULL;
+    if (!copy) {
+        free(e);
+        vm_image_close(image);
+        vm_set_error(vm, "Out of memory");
+        return NULL;
+    }
+    strcpy(copy, source);
+
+    pthread_mutex_lock(&cache->lock);
+    found = cache_find(cache, hash, source);
+    if (!found) {
+        size_t b = hash % ASM_CACHE_BUCKETS;
+        e->hash = hash;
+        e->source = copy;
+        e->image = image;
+        e->next = cache->buckets[b];
+        cache->buckets[b] = e;
+        found = image;
+        e = NULL;
+    }
+    pthread_mutex_unlock(&cache->lock);
+    if (e) {
+        free(copy);
+        free(e);
+        vm_image_close(image);
+    }
+    return found;
+}
+
+// --- many sources on many threads ---
+
+// Sources are handed out in runs of ASM_BATCH_RUN from a shared counter;
+// each worker has a VM of its own for the errors
+#define ASM_BATCH_RUN 16
+
+typedef struct {
+    pthread_mutex_t lock;
+    size_t next;
+    size_t n;
+    const char *const *sources;
+    const sap_image_t **images;
+    sap_asm_cache_t *cache;
+    size_t failures;
+} asm_batch_t;
+
+static void *asm_worker(void *arg) {
+    asm_batch_t *batch = arg;
+    sap_vm_t *vm = malloc(sizeof(sap_vm_t));
+    size_t failures = 0;
+    if (vm) {
+        vm_init(vm);
+        vm->debug_enabled = false;
+    }
+    for (;;) {
+        pthread_mutex_lock(&batch->lock);
+        size_t start = batch->next;
+        size_t end = start + ASM_BATCH_RUN < batch->n ? start + ASM_BATCH_RUN : batch->n;
+        batch->next = end;
+        pthread_mutex_unlock(&batch->lock);
+        if (start >= end) {
+            break;
+        }
+        for (size_t i = start; i < end; i++) {
+            batch->images[i] = vm ? vm_asm_cache_get(batch->cache, vm, batch->sources[i]) : NULL;
+            failures += batch->images[i] == NULL;
+        }
+    }
+    free(vm);
+    pthread_mutex_lock(&batch->lock);
+    batch->failures += failures;
+    pthread_mutex_unlock(&batch->lock);
+    return NULL;
+}
+
+static int default_threads(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+}
+
+size_t vm_assemble_batch(sap_asm_cache_t *cache, const char *const *sources, size_t n,
+                         const sap_image_t **images, int threads) {
+    asm_batch_t batch;
+    memset(&batch, 0, sizeof(batch));
+    pthread_mutex_init(&batch.lock, NULL);
+    batch.n = n;
+    batch.sources = sources;
+    batch.images = images;
+    batch.cache = cache;
+
+    if (threads <= 0) {
+        threads = default_threads();
+    }
+    if ((size_t)threads > (n + ASM_BATCH_RUN - 1) / ASM_BATCH_RUN) {
+        threads = (int)((n + ASM_BATCH_RUN - 1) / ASM_BATCH_RUN);
+    }
+    pthread_t *ids = threads > 1 ? calloc((size_t)threads, sizeof(pthread_t)) : NULL;
+
+    int started = 0;
+    for (int t = 1; ids && t < threads; t++) {
+        if (pthread_create(&ids[t], NULL, asm_worker, &batch) != 0) {
+            break;  // the runs left go to the workers that did start
+        }
+        started = t;
+    }
+    asm_worker(&batch);
+    for (int t = 1; t <= started; t++) {
+        pthread_join(ids[t], NULL);
+    }
+    free(ids);
+    pthread_mutex_destroy(&batch.lock);
+    return batch.failures;
+}
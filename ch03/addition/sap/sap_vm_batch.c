@@ -0,0 +1,181 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "sap_vm.h"
+#include "sap_vm_config.h"
+
+// Every worker owns a deque of VM indices [head, tail). The owner takes
+// VMs from the head; a worker whose deque is empty steals the back half
+// of another worker's deque. Programs differ a lot in length, so static
+// partitioning alone would leave workers idle.
+
+typedef struct {
+    pthread_mutex_t lock;
+    size_t head;
+    size_t tail;
+} batch_deque_t;
+
+typedef struct batch_worker {
+    struct batch_pool *pool;
+    int id;
+    batch_summary_t summary;
+} batch_worker_t;
+
+typedef struct batch_pool {
+    sap_vm_t *vms;
+    uint64_t max_cycles;
+    int threads;
+    batch_deque_t *deques;
+} batch_pool_t;
+
+static bool take_own(batch_deque_t *dq, size_t *index) {
+    bool found = false;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->head < dq->tail) {
+        *index = dq->head++;
+        found = true;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return found;
+}
+
+// move the back half of a victim's deque into our own (empty) deque
+static bool steal(batch_pool_t *pool, int thief) {
+    for (int k = 1; k < pool->threads; k++) {
+        batch_deque_t *victim = &pool->deques[(thief + k) % pool->threads];
+        size_t lo = 0, hi = 0;
+
+        pthread_mutex_lock(&victim->lock);
+        size_t left = victim->tail - victim->head;
+        if (left > 0) {
+            size_t take = (left + 1) / 2;
+            hi = victim->tail;
+            lo = hi - take;
+            victim->tail = lo;
+        }
+        pthread_mutex_unlock(&victim->lock);
+
+        if (hi > lo) {
+            batch_deque_t *own = &pool->deques[thief];
+            pthread_mutex_lock(&own->lock);
+            own->head = lo;
+            own->tail = hi;
+            pthread_mutex_unlock(&own->lock);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void run_one(batch_pool_t *pool, size_t index, batch_summary_t *summary) {
+    sap_vm_t *vm = &pool->vms[index];
+    uint64_t before = vm->cycle_count;
+    result_t result = vm_run_quiet(vm, pool->max_cycles);
+
+    summary->total_cycles += vm->cycle_count - before;
+    if (result == RESULT_HALT) {
+        summary->halted++;
+    } else if (result == RESULT_ERROR) {
+        summary->errors++;
+    } else {
+        summary->stopped++;
+    }
+}
+
+static void *worker_main(void *arg) {
+    batch_worker_t *worker = arg;
+    batch_pool_t *pool = worker->pool;
+    size_t index;
+
+    for (;;) {
+        while (take_own(&pool->deques[worker->id], &index)) {
+            run_one(pool, index, &worker->summary);
+        }
+        if (!steal(pool, worker->id)) {
+            break;  // nothing left anywhere, no new work is ever added
+        }
+    }
+    return NULL;
+}
+
+static int default_threads(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+}
+
+batch_summary_t vm_run_batch(sap_vm_t *vms, size_t n, uint64_t max_cycles, int threads) {
+    batch_summary_t total;
+    memset(&total, 0, sizeof(total));
+
+    if (threads <= 0) {
+        threads = default_threads();
+    }
+    if ((size_t)threads > n) {
+        threads = (n > 0) ? (int)n : 1;
+    }
+    total.threads = threads;
+
+    batch_pool_t pool;
+    pool.vms = vms;
+    pool.max_cycles = max_cycles;
+    pool.threads = threads;
+
+    if (threads == 1) {
+        for (size_t i = 0; i < n; i++) {
+            run_one(&pool, i, &total);
+        }
+        return total;
+    }
+
+    pool.deques = calloc((size_t)threads, sizeof(batch_deque_t));
+    batch_worker_t *workers = calloc((size_t)threads, sizeof(batch_worker_t));
+    pthread_t *ids = calloc((size_t)threads, sizeof(pthread_t));
+    if (!pool.deques || !workers || !ids) {
+        free(pool.deques);
+        free(workers);
+        free(ids);
+        total.threads = 1;
+        for (size_t i = 0; i < n; i++) {
+            run_one(&pool, i, &total);
+        }
+        return total;
+    }
+
+    // start from an even split, stealing evens out the rest
+    for (int t = 0; t < threads; t++) {
+        pthread_mutex_init(&pool.deques[t].lock, NULL);
+        pool.deques[t].head = n * (size_t)t / (size_t)threads;
+        pool.deques[t].tail = n * (size_t)(t + 1) / (size_t)threads;
+        workers[t].pool = &pool;
+        workers[t].id = t;
+    }
+
+    int started = 0;
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&ids[t], NULL, worker_main, &workers[t]) != 0) {
+            break;  // the remaining deques get stolen by running workers
+        }
+        started = t;
+    }
+    worker_main(&workers[0]);
+    for (int t = 1; t <= started; t++) {
+        pthread_join(ids[t], NULL);
+    }
+
+    for (int t = 0; t < threads; t++) {
+        total.halted += workers[t].summary.halted;
+        total.errors += workers[t].summary.errors;
+        total.stopped += workers[t].summary.stopped;
+        total.total_cycles += workers[t].summary.total_cycles;
+        pthread_mutex_destroy(&pool.deques[t].lock);
+    }
+
+    free(pool.deques);
+    free(workers);
+    free(ids);
+    return total;
+}
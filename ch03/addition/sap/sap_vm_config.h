@@ -10,6 +10,7 @@
 #define MAX_ARGS_SIZE 224
 #define DATA_MEMORY_START 0x100
 #define SUBROUTINE_START 0x10
+#define MAX_BLOCK_LENGTH 64
 
 #endif // SAP_VM_CONFIG_H
 
@@ -27,6 +27,7 @@ static void cmd_memory(sap_vm_t *vm, const char *args);
 static void cmd_disasm(sap_vm_t *vm, const char *args);
 static void cmd_breakpoint(sap_vm_t *vm, const char *args);
 static void cmd_trace(sap_vm_t *vm, const char *args);
+static void cmd_asm(sap_vm_t *vm, const char *args);
 
 static const command_t commands[] = {
     {"help", "h", cmd_help, "Show this help"},
@@ -37,9 +38,10 @@ static const command_t commands[] = {
     {"reset", NULL, cmd_reset, "Reset VM to initial state"},
     {"memory", "mem", cmd_memory, "Show memory contents [start] [end]"},
     {"disasm", "dis", cmd_disasm, "Disassemble instructions [start] [count]"},
-    {"breakpoint", "bp", cmd_breakpoint, "Manage breakpoints [add|del|list] [addr]"},
+    {"breakpoint", "bp", cmd_breakpoint, "Manage breakpoints [add|del|list] [addr] [condition]"},
     {"load", "l", cmd_load_sample, "Load sample program <program>"},
-    {"trace", "t", cmd_trace, "Enable/disable instruction tracing [on|off]"},
+    {"asm", "a", cmd_asm, "Assemble and load a source file <file>"},
+    {"trace", "t", cmd_trace, "Instruction tracing [on|off|ring <file> [n]|dump <file>]"},
     {NULL, NULL, NULL, NULL}
 };
 
@@ -243,9 +245,10 @@ static void cmd_breakpoint(sap_vm_t *vm, const char *args) {
         return;
     }
     char action[32], addr_str[32];
-    int parsed = sscanf(args, "%31s %31s", action, addr_str);
+    int rest = 0;
+    int parsed = sscanf(args, "%31s %31s %n", action, addr_str, &rest);
     if (parsed < 1) {
-        printf("Usage: breakpoint [add|del|list] [address]\n");
+        printf("Usage: breakpoint [add|del|list] [address] [condition]\n");
         return;
     }
     for (char *p = action; *p; p++) {
@@ -260,9 +263,19 @@ static void cmd_breakpoint(sap_vm_t *vm, const char *args) {
             return;
         }
         uint16_t addr = parse_address(addr_str);
-        if (vm_add_breakpoint(vm, addr) == RESULT_OK) {
-            printf("Breakpoint added at 0x%04X\n", addr);
+        if (vm_add_breakpoint(vm, addr) != RESULT_OK) {
+            return;
+        }
+        // the rest of the line, if any, is the condition: bp add 0x10 if ACC == 5
+        const char *condition = (parsed == 2 && rest > 0) ? args + rest : "";
+        if (strncmp(condition, "if ", 3) == 0) {
+            condition += 3;
+        }
+        if (vm_set_breakpoint_condition(vm, addr, condition) != RESULT_OK) {
+            vm_remove_breakpoint(vm, addr);
+            return;
         }
+        printf("Breakpoint added at 0x%04X\n", addr);
     }
     else if (strcmp(action, "del") == 0 || strcmp(action, "delete") == 0 || 
              strcmp(action, "remove") == 0 || strcmp(action, "d") == 0) {
@@ -286,11 +299,33 @@ static void cmd_trace(sap_vm_t *vm, const char *args) {
         printf("Instruction tracing is %s\n", vm->trace_enabled ? "ON" : "OFF");
         return;
     }
-    char setting[32];
-    sscanf(args, "%31s", setting);
+    char setting[32], file[MAX_ARGS_SIZE], size_str[32];
+    int parsed = sscanf(args, "%31s %223s %31s", setting, file, size_str);
     for (char *p = setting; *p; p++) {
         *p = tolower(*p);
     }
+    // binary ring of the last n instructions, written to file on halt or error
+    if (strcmp(setting, "ring") == 0) {
+        if (parsed < 2) {
+            printf("Usage: trace ring <file> [records]\n");
+            return;
+        }
+        int records = (parsed >= 3) ? parse_number(size_str) : 4096;
+        vm_trace_start(vm, records > 0 ? (uint32_t)records : 0, file);
+        return;
+    }
+    if (strcmp(setting, "dump") == 0) {
+        if (parsed < 2) {
+            printf("Usage: trace dump <file>\n");
+            return;
+        }
+        if (!vm->trace_ring) {
+            printf("No trace ring, start one with 'trace ring <file>'\n");
+            return;
+        }
+        vm_trace_dump(vm, file);
+        return;
+    }
     if (strcmp(setting, "on") == 0 || strcmp(setting, "1") == 0 || 
         strcmp(setting, "true") == 0 || strcmp(setting, "yes") == 0) {
         vm->trace_enabled = true;
@@ -299,10 +334,27 @@ static void cmd_trace(sap_vm_t *vm, const char *args) {
     else if (strcmp(setting, "off") == 0 || strcmp(setting, "0") == 0 || 
              strcmp(setting, "false") == 0 || strcmp(setting, "no") == 0) {
         vm->trace_enabled = false;
+        vm_trace_stop(vm);
         printf("Instruction tracing disabled.\n");
     }
     else {
-        printf("Usage: trace [on|off]\n");
+        printf("Usage: trace [on|off|ring <file> [records]|dump <file>]\n");
     }
 }
 
+
+static void cmd_asm(sap_vm_t *vm, const char *args) {
+    if (!args || strlen(args) == 0) {
+        printf("Usage: asm <file>\n");
+        return;
+    }
+    sap_image_t *image;
+    if (vm_assemble_file(vm, args, &image) != RESULT_OK) {
+        return;     // the error has been printed
+    }
+    vm_image_load(vm, image);
+    printf("Assembled %u words at 0x%04X, %d labels, entry 0x%04X.\n",
+           image->length, image->base, image->symbol_count, image->entry);
+    printf("Use 'disasm' to see the code, 'run' to execute.\n");
+    vm_image_close(image);
+}
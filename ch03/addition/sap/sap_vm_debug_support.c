@@ -1,8 +1,233 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include "sap_vm.h"
 #include "sap_vm_config.h"
 
+#define MAP_BIT(address) (1u << ((address) & 31))
+
+// Breakpoint conditions, e.g. "ACC == 5 && [0x100] > X". Operands are
+// numbers, the registers ACC (or A), X, SP and PC, the flags Z, N, C and
+// V, and [expr] for the memory cell at expr; operators are ( ) ! - + ==
+// != < <= > >= && ||, with the C precedences. A condition is compiled
+// once into postfix code below, which vm_check_breakpoint() runs on each
+// hit with a small value stack.
+enum {
+    COND_NUM,       // followed by a 32-bit little-endian constant
+    COND_ACC, COND_X, COND_SP, COND_PC,
+    COND_ZERO, COND_NEGATIVE, COND_CARRY, COND_OVERFLOW,
+    COND_MEMORY, COND_NOT, COND_NEG,
+    COND_ADD, COND_SUB, COND_EQ, COND_NE, COND_LT, COND_LE, COND_GT, COND_GE,
+    COND_AND, COND_OR
+};
+
+typedef struct {
+    const char *p;
+    uint8_t *code;
+    int len;
+    const char *error;      // first error, NULL if none
+} cond_parser_t;
+
+static void emit(cond_parser_t *cp, int op) {
+    if (cp->len >= BP_CODE_SIZE) {
+        cp->error = "condition too long";
+        return;
+    }
+    cp->code[cp->len++] = (uint8_t)op;
+}
+
+static void skip_space(cond_parser_t *cp) {
+    while (isspace((unsigned char)*cp->p)) {
+        cp->p++;
+    }
+}
+
+// Consumes tok if it comes next
+static bool accept(cond_parser_t *cp, const char *tok) {
+    skip_space(cp);
+    size_t n = strlen(tok);
+    if (strncmp(cp->p, tok, n) != 0) {
+        return false;
+    }
+    cp->p += n;
+    return true;
+}
+
+static void parse_or(cond_parser_t *cp);
+
+static void parse_primary(cond_parser_t *cp) {
+    skip_space(cp);
+    if (accept(cp, "(")) {
+        parse_or(cp);
+        if (!accept(cp, ")")) {
+            cp->error = "missing )";
+        }
+    } else if (accept(cp, "[")) {
+        parse_or(cp);
+        if (!accept(cp, "]")) {
+            cp->error = "missing ]";
+        }
+        emit(cp, COND_MEMORY);
+    } else if (isdigit((unsigned char)*cp->p)) {
+        char *end;
+        long v = strtol(cp->p, &end, 0);
+        if (v > 65535) {
+            cp->error = "number out of range";
+        }
+        cp->p = end;
+        emit(cp, COND_NUM);
+        for (int i = 0; i < 4; i++) {
+            emit(cp, (int)(((uint32_t)v >> (8 * i)) & 0xFF));
+        }
+    } else if (isalpha((unsigned char)*cp->p)) {
+        static const struct { const char *name; int op; } names[] = {
+            {"ACC", COND_ACC}, {"A", COND_ACC}, {"X", COND_X}, {"SP", COND_SP},
+            {"PC", COND_PC}, {"Z", COND_ZERO}, {"N", COND_NEGATIVE},
+            {"C", COND_CARRY}, {"V", COND_OVERFLOW}
+        };
+        char word[8];
+        size_t n = 0;
+        while (isalnum((unsigned char)*cp->p)) {
+            if (n < sizeof(word) - 1) {
+                word[n++] = (char)toupper((unsigned char)*cp->p);
+            }
+            cp->p++;
+        }
+        word[n] = '\0';
+        for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+            if (strcmp(word, names[i].name) == 0) {
+                emit(cp, names[i].op);
+                return;
+            }
+        }
+        cp->error = "unknown name";
+    } else {
+        cp->error = "value expected";
+    }
+}
+
+static void parse_unary(cond_parser_t *cp) {
+    if (accept(cp, "!")) {
+        parse_unary(cp);
+        emit(cp, COND_NOT);
+    } else if (accept(cp, "-")) {
+        parse_unary(cp);
+        emit(cp, COND_NEG);
+    } else {
+        parse_primary(cp);
+    }
+}
+
+static void parse_sum(cond_parser_t *cp) {
+    parse_unary(cp);
+    while (!cp->error) {
+        if (accept(cp, "+")) {
+            parse_unary(cp);
+            emit(cp, COND_ADD);
+        } else if (accept(cp, "-")) {
+            parse_unary(cp);
+            emit(cp, COND_SUB);
+        } else {
+            break;
+        }
+    }
+}
+
+static void parse_compare(cond_parser_t *cp) {
+    // longest operators first, so "<=" is not taken for "<"
+    static const struct { const char *tok; int op; } ops[] = {
+        {"==", COND_EQ}, {"!=", COND_NE}, {"<=", COND_LE}, {">=", COND_GE},
+        {"<", COND_LT}, {">", COND_GT}
+    };
+    parse_sum(cp);
+    for (size_t i = 0; i < sizeof(ops) / sizeof(ops[0]) && !cp->error; i++) {
+        if (accept(cp, ops[i].tok)) {
+            parse_sum(cp);
+            emit(cp, ops[i].op);
+            break;
+        }
+    }
+}
+
+static void parse_and(cond_parser_t *cp) {
+    parse_compare(cp);
+    while (!cp->error && accept(cp, "&&")) {
+        parse_compare(cp);
+        emit(cp, COND_AND);
+    }
+}
+
+static void parse_or(cond_parser_t *cp) {
+    parse_and(cp);
+    while (!cp->error && accept(cp, "||")) {
+        parse_and(cp);
+        emit(cp, COND_OR);
+    }
+}
+
+// Every value pushed takes at least one character of the condition, so
+// the stack never holds more than sizeof(condition) values. Nothing can
+// fail here: the code was checked when compiled, and a memory cell
+// outside memory reads as 0.
+static bool eval_condition(const sap_vm_t *vm, const breakpoint_t *bp) {
+    int32_t stack[sizeof(bp->condition)];
+    int sp = 0;
+    for (int pc = 0; pc < bp->code_len; pc++) {
+        int32_t a, b;
+        switch (bp->code[pc]) {
+            case COND_NUM:
+                stack[sp++] = (int32_t)((uint32_t)bp->code[pc + 1] |
+                                        (uint32_t)bp->code[pc + 2] << 8 |
+                                        (uint32_t)bp->code[pc + 3] << 16 |
+                                        (uint32_t)bp->code[pc + 4] << 24);
+                pc += 4;
+                break;
+            case COND_ACC:      stack[sp++] = vm->cpu.accumulator; break;
+            case COND_X:        stack[sp++] = vm->cpu.x_reg; break;
+            case COND_SP:       stack[sp++] = vm->cpu.sp; break;
+            case COND_PC:       stack[sp++] = vm->cpu.pc; break;
+            case COND_ZERO:     stack[sp++] = vm_flags(vm).zero; break;
+            case COND_NEGATIVE: stack[sp++] = vm_flags(vm).negative; break;
+            case COND_CARRY:    stack[sp++] = vm_flags(vm).carry; break;
+            case COND_OVERFLOW: stack[sp++] = vm_flags(vm).overflow; break;
+            case COND_MEMORY:
+                a = stack[sp - 1];
+                stack[sp - 1] = (a >= 0 && a < MEMORY_SIZE) ? vm->memory[a] : 0;
+                break;
+            case COND_NOT:      stack[sp - 1] = !stack[sp - 1]; break;
+            case COND_NEG:      stack[sp - 1] = -stack[sp - 1]; break;
+            default:
+                b = stack[--sp];
+                a = stack[sp - 1];
+                switch (bp->code[pc]) {
+                    case COND_ADD: a = a + b; break;
+                    case COND_SUB: a = a - b; break;
+                    case COND_EQ:  a = a == b; break;
+                    case COND_NE:  a = a != b; break;
+                    case COND_LT:  a = a < b; break;
+                    case COND_LE:  a = a <= b; break;
+                    case COND_GT:  a = a > b; break;
+                    case COND_GE:  a = a >= b; break;
+                    case COND_AND: a = a && b; break;
+                    default:       a = a || b; break;
+                }
+                stack[sp - 1] = a;
+                break;
+        }
+    }
+    return stack[0] != 0;
+}
+
+static breakpoint_t *find_breakpoint(sap_vm_t *vm, uint16_t address) {
+    for (int i = 0; i < vm->breakpoint_count; i++) {
+        if (vm->breakpoints[i].address == address && vm->breakpoints[i].enabled) {
+            return &vm->breakpoints[i];
+        }
+    }
+    return NULL;
+}
+
 result_t vm_add_breakpoint(sap_vm_t *vm, uint16_t address) {
     if (!vm_is_valid_address(address)) {
         return vm_set_error(vm, "Invalid breakpoint address 0x%04X", address);
@@ -29,6 +254,8 @@ result_t vm_add_breakpoint(sap_vm_t *vm, uint16_t address) {
     vm->breakpoints[slot].enabled = true;
     vm->breakpoints[slot].hit_count = 0;
     vm->breakpoints[slot].condition[0] = '\0';
+    vm->breakpoints[slot].code_len = 0;
+    vm->breakpoint_map[address >> 5] |= MAP_BIT(address);
     if (vm->debug_enabled) {
         printf("Breakpoint added at 0x%04X (slot %d)\n", address, slot);
     }
@@ -39,6 +266,7 @@ result_t vm_remove_breakpoint(sap_vm_t *vm, uint16_t address) {
     for (int i = 0; i < vm->breakpoint_count; i++) {
         if (vm->breakpoints[i].address == address && vm->breakpoints[i].enabled) {
             vm->breakpoints[i].enabled = false;
+            vm->breakpoint_map[address >> 5] &= ~MAP_BIT(address);
             if (vm->debug_enabled) {
                 printf("Breakpoint removed from 0x%04X\n", address);
             }
@@ -48,14 +276,61 @@ result_t vm_remove_breakpoint(sap_vm_t *vm, uint16_t address) {
     return vm_set_error(vm, "No breakpoint found at 0x%04X", address);
 }
 
+// An empty or NULL condition makes the breakpoint unconditional again
+result_t vm_set_breakpoint_condition(sap_vm_t *vm, uint16_t address, const char *condition) {
+    breakpoint_t *bp = find_breakpoint(vm, address);
+    if (!bp) {
+        return vm_set_error(vm, "No breakpoint found at 0x%04X", address);
+    }
+    if (!condition) {
+        condition = "";
+    }
+    if (strlen(condition) >= sizeof(bp->condition)) {
+        return vm_set_error(vm, "Condition longer than %d characters",
+                            (int)sizeof(bp->condition) - 1);
+    }
+    uint8_t code[BP_CODE_SIZE];
+    cond_parser_t cp = {condition, code, 0, NULL};
+    skip_space(&cp);
+    if (*cp.p) {
+        parse_or(&cp);
+        skip_space(&cp);
+        if (!cp.error && *cp.p) {
+            cp.error = "unexpected text";
+        }
+        if (cp.error) {
+            // a typo in a condition leaves the program runnable
+            vm_state_t state = vm->state;
+            vm_set_error(vm, "Bad condition, %s at \"%s\"", cp.error, cp.p);
+            vm->state = state;
+            return RESULT_ERROR;
+        }
+    }
+    strcpy(bp->condition, condition);
+    memcpy(bp->code, code, (size_t)cp.len);
+    bp->code_len = (uint8_t)cp.len;
+    if (vm->debug_enabled) {
+        if (cp.len > 0) {
+            printf("Breakpoint at 0x%04X stops if %s\n", address, condition);
+        } else {
+            printf("Breakpoint at 0x%04X is unconditional\n", address);
+        }
+    }
+    return RESULT_OK;
+}
+
 void vm_list_breakpoints(sap_vm_t *vm) {
     printf("Active breakpoints:\n");
     bool found_any = false;
     for (int i = 0; i < vm->breakpoint_count; i++) {
         if (vm->breakpoints[i].enabled) {
-            printf("  0x%04X (hits: %d)\n", 
-                   vm->breakpoints[i].address, 
+            printf("  0x%04X (hits: %d)",
+                   vm->breakpoints[i].address,
                    vm->breakpoints[i].hit_count);
+            if (vm->breakpoints[i].code_len > 0) {
+                printf(" if %s", vm->breakpoints[i].condition);
+            }
+            printf("\n");
             found_any = true;
         }
     }
@@ -65,14 +340,19 @@ void vm_list_breakpoints(sap_vm_t *vm) {
     printf("\n");
 }
 
+// Addresses without a breakpoint, almost all of them, cost one bit test.
+// hit_count counts the stops, not the times a condition was false.
 bool vm_check_breakpoint(sap_vm_t *vm, uint16_t address) {
-    for (int i = 0; i < vm->breakpoint_count; i++) {
-        if (vm->breakpoints[i].address == address && vm->breakpoints[i].enabled) {
-            vm->breakpoints[i].hit_count++;
-            return true;
-        }
+    if (!vm_is_valid_address(address) ||
+        !(vm->breakpoint_map[address >> 5] & MAP_BIT(address))) {
+        return false;
     }
-    return false;
+    breakpoint_t *bp = find_breakpoint(vm, address);
+    if (!bp || (bp->code_len > 0 && !eval_condition(vm, bp))) {
+        return false;
+    }
+    bp->hit_count++;
+    return true;
 }
 
 result_t vm_load_program(sap_vm_t *vm, const char *filename) {
@@ -83,6 +363,12 @@ result_t vm_load_program(sap_vm_t *vm, const char *filename) {
     if (!file) {
         return vm_set_error(vm, "Cannot open file: %s", filename);
     }
+    char magic[4];
+    if (fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+        memcmp(magic, SAP_IMAGE_MAGIC, sizeof(magic)) == 0) {
+        fclose(file);
+        return vm_load_image(vm, NULL, filename);
+    }
     fseek(file, 0, SEEK_END);
     long file_size = ftell(file);
     fseek(file, 0, SEEK_SET);
@@ -90,6 +376,7 @@ result_t vm_load_program(sap_vm_t *vm, const char *filename) {
         fclose(file);
         return vm_set_error(vm, "Invalid file size: %ld bytes", file_size);
     }
+    vm_reset(vm);
     size_t words_read = fread(vm->memory, sizeof(int16_t), file_size / sizeof(int16_t), file);
     if (ferror(file)) {
         fclose(file);
@@ -99,7 +386,6 @@ result_t vm_load_program(sap_vm_t *vm, const char *filename) {
     if (vm->debug_enabled) {
         printf("Loaded %zu words from %s\n", words_read, filename);
     }
-    vm_reset(vm);
     return RESULT_OK;
 }
 
@@ -148,11 +434,12 @@ void vm_dump_state(sap_vm_t *vm, const char *filename) {
     fprintf(file, "ACC: %d (0x%04X)\n", vm->cpu.accumulator, (uint16_t)vm->cpu.accumulator);
     fprintf(file, "X: %d (0x%04X)\n", vm->cpu.x_reg, vm->cpu.x_reg);
     fprintf(file, "IR: 0x%04X\n", vm->cpu.ir);
+    cpu_flags_t flags = vm_flags(vm);
     fprintf(file, "\nFlags:\n");
-    fprintf(file, "Zero: %d\n", vm->cpu.flags.zero);
-    fprintf(file, "Negative: %d\n", vm->cpu.flags.negative);
-    fprintf(file, "Carry: %d\n", vm->cpu.flags.carry);
-    fprintf(file, "Overflow: %d\n", vm->cpu.flags.overflow);
+    fprintf(file, "Zero: %d\n", flags.zero);
+    fprintf(file, "Negative: %d\n", flags.negative);
+    fprintf(file, "Carry: %d\n", flags.carry);
+    fprintf(file, "Overflow: %d\n", flags.overflow);
     fprintf(file, "\nMemory (non-zero locations):\n");
     for (uint16_t addr = 0; addr < MEMORY_SIZE; addr++) {
         if (vm->memory[addr] != 0) {
@@ -164,9 +451,13 @@ void vm_dump_state(sap_vm_t *vm, const char *filename) {
     bool has_breakpoints = false;
     for (int i = 0; i < vm->breakpoint_count; i++) {
         if (vm->breakpoints[i].enabled) {
-            fprintf(file, "0x%04X (hits: %d)\n", 
-                   vm->breakpoints[i].address, 
+            fprintf(file, "0x%04X (hits: %d)",
+                   vm->breakpoints[i].address,
                    vm->breakpoints[i].hit_count);
+            if (vm->breakpoints[i].code_len > 0) {
+                fprintf(file, " if %s", vm->breakpoints[i].condition);
+            }
+            fprintf(file, "\n");
             has_breakpoints = true;
         }
     }
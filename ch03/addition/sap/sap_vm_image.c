@@ -0,0 +1,293 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "sap_vm.h"
+#include "sap_vm_config.h"
+
+// File layout, little-endian:
+//   0  char     magic[4]      "SAPI"
+//   4  uint16   version       SAP_IMAGE_VERSION
+//   6  uint16   entry         PC to start at
+//   8  uint16   base          address of the first word
+//  10  uint16   length        words that follow the header
+//  12  uint16   symbol_count
+//  14  uint16   reserved      0
+//  16  int16    words[length]
+//      symbols[symbol_count], each char name[16], uint16 address, uint16 0
+#define HEADER_SIZE 16
+#define SYMBOL_SIZE (SAP_SYMBOL_NAME + 4)
+
+static uint16_t get16(const unsigned char *p) {
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static void put16(unsigned char *p, uint16_t v) {
+    p[0] = (unsigned char)(v & 0xFF);
+    p[1] = (unsigned char)(v >> 8);
+}
+
+result_t vm_save_image(sap_vm_t *vm, const char *filename, uint16_t start_addr,
+                       uint16_t end_addr, uint16_t entry,
+                       const sap_symbol_t *symbols, int symbol_count) {
+    if (!filename || !filename[0]) {
+        return vm_set_error(vm, "No filename specified");
+    }
+    if (!vm_is_valid_address(start_addr) || !vm_is_valid_address(end_addr) ||
+        !vm_is_valid_address(entry)) {
+        return vm_set_error(vm, "Invalid address range");
+    }
+    if (start_addr > end_addr) {
+        return vm_set_error(vm, "Start address must be <= end address");
+    }
+    if (symbol_count < 0 || symbol_count > MEMORY_SIZE) {
+        return vm_set_error(vm, "Invalid symbol count %d", symbol_count);
+    }
+
+    uint16_t length = (uint16_t)(end_addr - start_addr + 1);
+    size_t size = HEADER_SIZE + 2 * (size_t)length + SYMBOL_SIZE * (size_t)symbol_count;
+    unsigned char *buf = calloc(1, size);
+    if (!buf) {
+        return vm_set_error(vm, "Out of memory");
+    }
+    memcpy(buf, SAP_IMAGE_MAGIC, 4);
+    put16(buf + 4, SAP_IMAGE_VERSION);
+    put16(buf + 6, entry);
+    put16(buf + 8, start_addr);
+    put16(buf + 10, length);
+    put16(buf + 12, (uint16_t)symbol_count);
+    unsigned char *p = buf + HEADER_SIZE;
+    for (uint16_t i = 0; i < length; i++, p += 2) {
+        put16(p, (uint16_t)vm->memory[start_addr + i]);
+    }
+    for (int i = 0; i < symbol_count; i++, p += SYMBOL_SIZE) {
+        strncpy((char *)p, symbols[i].name, SAP_SYMBOL_NAME);
+        put16(p + SAP_SYMBOL_NAME, symbols[i].address);
+    }
+
+    FILE *file = fopen(filename, "wb");
+    if (!file) {
+        free(buf);
+        return vm_set_error(vm, "Cannot create file: %s", filename);
+    }
+    size_t written = fwrite(buf, 1, size, file);
+    int closed = fclose(file);
+    free(buf);
+    if (written != size || closed != 0) {
+        return vm_set_error(vm, "Error writing to file");
+    }
+    if (vm->debug_enabled) {
+        printf("Saved image of %u words, entry 0x%04X, to %s\n", length, entry, filename);
+    }
+    return RESULT_OK;
+}
+
+// Checks the header and decodes the mapped file into a new image
+static sap_image_t *decode(sap_vm_t *vm, const unsigned char *p, size_t size,
+                           const char *filename) {
+    if (size < HEADER_SIZE || memcmp(p, SAP_IMAGE_MAGIC, 4) != 0) {
+        vm_set_error(vm, "Not a program image: %s", filename);
+        return NULL;
+    }
+    if (get16(p + 4) != SAP_IMAGE_VERSION) {
+        vm_set_error(vm, "Image version %u not supported: %s", get16(p + 4), filename);
+        return NULL;
+    }
+    uint16_t entry = get16(p + 6), base = get16(p + 8), length = get16(p + 10);
+    int symbol_count = get16(p + 12);
+    if (!vm_is_valid_address(entry) || (size_t)base + length > MEMORY_SIZE) {
+        vm_set_error(vm, "Image does not fit in memory: %s", filename);
+        return NULL;
+    }
+    if (size != HEADER_SIZE + 2 * (size_t)length + SYMBOL_SIZE * (size_t)symbol_count) {
+        vm_set_error(vm, "Image truncated or too long: %s", filename);
+        return NULL;
+    }
+
+    sap_image_t *image = calloc(1, sizeof(sap_image_t));
+    sap_symbol_t *symbols = calloc(symbol_count > 0 ? (size_t)symbol_count : 1,
+                                   sizeof(sap_symbol_t));
+    if (!image || !symbols) {
+        free(image);
+        free(symbols);
+        vm_set_error(vm, "Out of memory");
+        return NULL;
+    }
+    const unsigned char *q = p + HEADER_SIZE;
+    for (uint16_t i = 0; i < length; i++, q += 2) {
+        image->memory[base + i] = (int16_t)get16(q);
+    }
+    for (int i = 0; i < symbol_count; i++, q += SYMBOL_SIZE) {
+        memcpy(symbols[i].name, q, SAP_SYMBOL_NAME);
+        symbols[i].address = get16(q + SAP_SYMBOL_NAME);
+    }
+    image->entry = entry;
+    image->base = base;
+    image->length = length;
+    image->symbol_count = symbol_count;
+    image->symbols = symbols;
+    return image;
+}
+
+// Errors are reported through vm, which is otherwise left alone
+sap_image_t *vm_image_open(sap_vm_t *vm, const char *filename) {
+    if (!filename || !filename[0]) {
+        vm_set_error(vm, "No filename specified");
+        return NULL;
+    }
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        vm_set_error(vm, "Cannot open file: %s", filename);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        vm_set_error(vm, "Invalid file size: %s", filename);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        vm_set_error(vm, "Cannot map file: %s", filename);
+        return NULL;
+    }
+    sap_image_t *image = decode(vm, map, size, filename);
+    munmap(map, size);
+    return image;
+}
+
+void vm_image_close(sap_image_t *image) {
+    if (image) {
+        free(image->symbols);
+        free(image);
+    }
+}
+
+// vm_reset() without the memset: the whole memory comes from the image
+result_t vm_image_load(sap_vm_t *vm, const sap_image_t *image) {
+    vm_reset_cpu(vm);
+    memcpy(vm->memory, image->memory, sizeof(vm->memory));
+    vm->cpu.pc = image->entry;
+    return RESULT_OK;
+}
+
+int vm_image_symbol(const sap_image_t *image, const char *name) {
+    for (int i = 0; i < image->symbol_count; i++) {
+        if (strncmp(image->symbols[i].name, name, SAP_SYMBOL_NAME) == 0) {
+            return image->symbols[i].address;
+        }
+    }
+    return -1;
+}
+
+// A list of images by file name, each decoded on first use and kept until
+// the cache is freed. A file changed on disk (size or mtime) is decoded
+// again; the old image stays valid for VMs already using it.
+typedef struct cache_entry {
+    char *filename;
+    off_t size;
+    time_t mtime;
+    sap_image_t *image;
+    struct cache_entry *next;
+} cache_entry_t;
+
+struct sap_image_cache {
+    pthread_mutex_t lock;
+    cache_entry_t *entries;
+};
+
+sap_image_cache_t *vm_image_cache_new(void) {
+    sap_image_cache_t *cache = calloc(1, sizeof(sap_image_cache_t));
+    if (cache) {
+        pthread_mutex_init(&cache->lock, NULL);
+    }
+    return cache;
+}
+
+void vm_image_cache_free(sap_image_cache_t *cache) {
+    if (!cache) {
+        return;
+    }
+    cache_entry_t *e = cache->entries;
+    while (e) {
+        cache_entry_t *next = e->next;
+        vm_image_close(e->image);
+        free(e->filename);
+        free(e);
+        e = next;
+    }
+    pthread_mutex_destroy(&cache->lock);
+    free(cache);
+}
+
+const sap_image_t *vm_image_cache_get(sap_image_cache_t *cache, sap_vm_t *vm,
+                                      const char *filename) {
+    if (!filename || !filename[0]) {
+        vm_set_error(vm, "No filename specified");
+        return NULL;
+    }
+    struct stat st;
+    if (stat(filename, &st) != 0) {
+        vm_set_error(vm, "Cannot open file: %s", filename);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+    for (cache_entry_t *e = cache->entries; e; e = e->next) {
+        if (strcmp(e->filename, filename) == 0 &&
+            e->size == st.st_size && e->mtime == st.st_mtime) {
+            pthread_mutex_unlock(&cache->lock);
+            return e->image;
+        }
+    }
+    // decoded under the lock, so each image is decoded once
+    const sap_image_t *found = NULL;
+    sap_image_t *image = vm_image_open(vm, filename);
+    cache_entry_t *e = image ? calloc(1, sizeof(cache_entry_t)) : NULL;
+    char *name = e ? malloc(strlen(filename) + 1) : NULL;
+    if (name) {
+        strcpy(name, filename);
+        e->filename = name;
+        e->size = st.st_size;
+        e->mtime = st.st_mtime;
+        e->image = image;
+        e->next = cache->entries;
+        cache->entries = e;
+        found = image;
+    } else if (image) {
+        free(e);
+        vm_image_close(image);
+        vm_set_error(vm, "Out of memory");
+    }
+    pthread_mutex_unlock(&cache->lock);
+    return found;
+}
+
+// cache may be NULL, to decode the file for this VM only
+result_t vm_load_image(sap_vm_t *vm, sap_image_cache_t *cache, const char *filename) {
+    const sap_image_t *image;
+    sap_image_t *own = NULL;
+    if (cache) {
+        image = vm_image_cache_get(cache, vm, filename);
+    } else {
+        image = own = vm_image_open(vm, filename);
+    }
+    if (!image) {
+        return RESULT_ERROR;
+    }
+    vm_image_load(vm, image);
+    if (vm->debug_enabled) {
+        printf("Loaded image of %u words from %s, entry 0x%04X\n",
+               image->length, filename, image->entry);
+    }
+    vm_image_close(own);
+    return RESULT_OK;
+}
@@ -1,8 +1,10 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <pthread.h>
 #include "sap_vm.h"
 #include "sap_vm_config.h"
 #include "sap_vm_samples.h"
@@ -41,13 +43,8 @@ void print_sample_programs(void) {
     }
 }
 
-void cmd_load_sample(sap_vm_t *vm, const char *program_name) {
-    if (!program_name || strlen(program_name) == 0) {
-        printf("Available sample programs:\n");
-        print_sample_programs();
-        return;
-    }
-    
+// By name or alias, in any case
+static const sample_program_t *find_sample(const char *program_name) {
     char prog_name[64];
     strncpy(prog_name, program_name, sizeof(prog_name) - 1);
     prog_name[sizeof(prog_name) - 1] = '\0';
@@ -56,22 +53,82 @@ void cmd_load_sample(sap_vm_t *vm, const char *program_name) {
         *p = tolower(*p);
     }
     
-    vm_reset(vm);
-    
     for (const sample_program_t *prog = sample_programs; prog->name; prog++) {
         if (strcmp(prog_name, prog->name) == 0 || (prog->alias && strcmp(prog_name, prog->alias) == 0)) {
-            prog->loader(vm);
-            printf("Loaded '%s' program successfully.\n", prog->name);
-            printf("Use 'disasm' to see the code, 'run' to execute.\n");
-            return;
+            return prog;
         }
     }
+    return NULL;
+}
+
+void cmd_load_sample(sap_vm_t *vm, const char *program_name) {
+    if (!program_name || strlen(program_name) == 0) {
+        printf("Available sample programs:\n");
+        print_sample_programs();
+        return;
+    }
+    
+    vm_reset(vm);
+    
+    const sample_program_t *prog = find_sample(program_name);
+    if (prog) {
+        prog->loader(vm);
+        printf("Loaded '%s' program successfully.\n", prog->name);
+        printf("Use 'disasm' to see the code, 'run' to execute.\n");
+        return;
+    }
     
     printf("Unknown program: %s\n", program_name);
     printf("Available programs:\n");
     print_sample_programs();
 }
 
+// Each loader runs once, into a scratch VM, and its memory becomes the
+// image: the words up to the last one that is not zero
+#define SAMPLE_COUNT (sizeof(sample_programs) / sizeof(sample_programs[0]) - 1)
+
+static pthread_mutex_t sample_lock = PTHREAD_MUTEX_INITIALIZER;
+static sap_image_t *sample_images[SAMPLE_COUNT];
+
+static sap_image_t *build_sample_image(const sample_program_t *prog) {
+    sap_vm_t *vm = malloc(sizeof(sap_vm_t));
+    sap_image_t *image = calloc(1, sizeof(sap_image_t));
+    sap_symbol_t *symbols = calloc(1, sizeof(sap_symbol_t));
+    if (!vm || !image || !symbols) {
+        free(vm);
+        free(image);
+        free(symbols);
+        return NULL;
+    }
+    vm_init(vm);
+    vm->debug_enabled = false;
+    prog->loader(vm);
+    memcpy(image->memory, vm->memory, sizeof(image->memory));
+    int last = MEMORY_SIZE - 1;
+    while (last >= 0 && image->memory[last] == 0) last--;
+    image->entry = PROGRAM_START;
+    image->base = 0;
+    image->length = (uint16_t)(last + 1);
+    image->symbols = symbols;
+    free(vm);
+    return image;
+}
+
+const sap_image_t *sample_image(const char *program_name) {
+    const sample_program_t *prog = program_name ? find_sample(program_name) : NULL;
+    if (!prog) {
+        return NULL;
+    }
+    size_t index = (size_t)(prog - sample_programs);
+    pthread_mutex_lock(&sample_lock);
+    if (!sample_images[index]) {
+        sample_images[index] = build_sample_image(prog);
+    }
+    const sap_image_t *image = sample_images[index];
+    pthread_mutex_unlock(&sample_lock);
+    return image;
+}
+
 // Simple Fibonacci calculation using countdown approach
 static void load_fibonacci_program(sap_vm_t *vm) {
     uint16_t addr = PROGRAM_START;
@@ -7,5 +7,9 @@
 void cmd_load_sample(sap_vm_t *vm, const char *program_name);
 void print_sample_programs(void);
 
+// A sample as an image, built on first use and kept; NULL if there is
+// no such sample. Safe to call from several threads
+const sap_image_t *sample_image(const char *program_name);
+
 #endif // SAP_VM_SAMPLES_H
 
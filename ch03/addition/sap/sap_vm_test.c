@@ -1,5 +1,10 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
+#include <stdlib.h>
 #include <assert.h>
+#include <string.h>
+#include <time.h>
 #include "sap_vm.h"
 #include "sap_vm_config.h"
 #include "sap_vm_samples.h"
@@ -118,7 +123,522 @@ void test_sample_programs(void) {
     printf("  Factorial 5! = %d (expected 120)\n", vm.cpu.accumulator);
 }
 
-int main(void) {
+void test_flags(void) {
+    printf("Testing flags..\n");
+    static sap_vm_t vm;
+    struct { opcode_t op; int16_t a, b; bool z, n, c; } cases[] = {
+        { OP_ADD, 1, -1, true, false, false },
+        { OP_SUB, 1, 2, false, true, false },
+        { OP_MUL, 300, 200, false, false, true },   // 60000 does not fit
+        { OP_CMP, 7, 7, true, false, false },
+        { OP_AND, 5, 2, true, false, false },
+        { OP_XOR, 0, -1, false, true, false },
+    };
+
+    vm_init(&vm);
+    cpu_flags_t f = vm_flags(&vm);
+    assert(!f.zero && !f.negative && !f.carry && !f.overflow);
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        for (int fast = 0; fast <= 1; fast++) {
+            vm_init(&vm);
+            vm.debug_enabled = !fast;
+            vm.memory[0] = vm_encode_instruction(OP_LDA, ADDR_DIRECT, 0x100);
+            vm.memory[1] = vm_encode_instruction(cases[i].op, ADDR_DIRECT, 0x101);
+            vm.memory[2] = vm_encode_instruction(OP_RTS, ADDR_IMMEDIATE, 1);
+            vm.memory[0x100] = cases[i].a;
+            vm.memory[0x101] = cases[i].b;
+            assert(vm_run(&vm, 100) == RESULT_HALT);
+            f = vm_flags(&vm);
+            assert(f.zero == cases[i].z && f.negative == cases[i].n);
+            assert(f.carry == cases[i].c && f.overflow == cases[i].c);
+        }
+    }
+    printf("  Flags are worked out from the last result when read\n");
+}
+
+void test_fast_path(void) {
+    printf("Testing fast run loop..\n");
+    const char *names[] = {"fib", "fact", "sub", "count", "arith", "loop", "memtest"};
+    static sap_vm_t slow, fast;
+
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        // debug output on selects the debug-capable loop, off the fast one
+        vm_init(&slow);
+        cmd_load_sample(&slow, names[i]);
+        result_t r1 = vm_run(&slow, 10000);
+
+        vm_init(&fast);
+        fast.debug_enabled = false;
+        cmd_load_sample(&fast, names[i]);
+        result_t r2 = vm_run(&fast, 10000);
+
+        assert(r1 == r2);
+        assert(slow.state == fast.state);
+        assert(slow.cpu.accumulator == fast.cpu.accumulator);
+        assert(slow.cpu.pc == fast.cpu.pc);
+        assert(slow.cpu.sp == fast.cpu.sp);
+        assert(slow.cpu.flag_result == fast.cpu.flag_result);
+        assert(slow.cycle_count == fast.cycle_count);
+        assert(memcmp(slow.memory, fast.memory, sizeof(slow.memory)) == 0);
+    }
+    printf("  Fast loop matches the debug loop on all samples\n");
+
+    // an error leaves the same state behind
+    vm_init(&fast);
+    fast.debug_enabled = false;
+    fast.memory[0] = vm_encode_instruction(OP_LDA, ADDR_IMMEDIATE, 1);
+    fast.memory[1] = vm_encode_instruction(OP_DIV, ADDR_IMMEDIATE, 0);
+    assert(vm_run(&fast, 100) == RESULT_ERROR);
+    assert(fast.state == VM_ERROR);
+    assert(fast.error_address == 2);
+    assert(fast.cycle_count == 2);
+    printf("  Errors are reported from the fast loop\n");
+}
+
+void test_conditional_breakpoints(void) {
+    printf("Testing conditional breakpoints..\n");
+    static sap_vm_t vm;
+    vm_init(&vm);
+    vm.debug_enabled = false;
+    // ACC counts up forever, storing each value at 0x100
+    vm.memory[0] = vm_encode_instruction(OP_LDA, ADDR_IMMEDIATE, 0);
+    vm.memory[1] = vm_encode_instruction(OP_ADD, ADDR_IMMEDIATE, 1);
+    vm.memory[2] = vm_encode_instruction(OP_STA, ADDR_DIRECT, 0x100);
+    vm.memory[3] = vm_encode_instruction(OP_JMP, ADDR_DIRECT, 1);
+
+    assert(vm_add_breakpoint(&vm, 2) == RESULT_OK);
+    assert(vm_set_breakpoint_condition(&vm, 2, "ACC == 5") == RESULT_OK);
+    assert(vm_run(&vm, 1000) == RESULT_BREAKPOINT);
+    assert(vm.cpu.pc == 2 && vm.cpu.accumulator == 5);
+    assert(vm.breakpoints[0].hit_count == 1);
+    printf("  Stops only when the condition holds\n");
+
+    assert(vm_set_breakpoint_condition(&vm, 2, "[0x100] >= 9 && !N || X > 3") == RESULT_OK);
+    assert(vm_run(&vm, 1000) == RESULT_BREAKPOINT);
+    assert(vm.cpu.accumulator == 10);      // 0x100 still holds 9 here
+    assert(vm_set_breakpoint_condition(&vm, 2, "acc - 20 == -(3 + 2)") == RESULT_OK);
+    assert(vm_run(&vm, 1000) == RESULT_BREAKPOINT);
+    assert(vm.cpu.accumulator == 15);
+    printf("  Memory, flags, registers and arithmetic\n");
+
+    const char *bad[] = {"ACC ==", "ACC = 5", "(ACC", "[1", "Y > 1", "1 2", "99999"};
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        assert(vm_set_breakpoint_condition(&vm, 2, bad[i]) == RESULT_ERROR);
+    }
+    assert(strcmp(vm.breakpoints[0].condition, "acc - 20 == -(3 + 2)") == 0);
+    assert(vm.state != VM_ERROR);
+    printf("  Bad conditions are rejected and leave the old one\n");
+
+    assert(vm_remove_breakpoint(&vm, 2) == RESULT_OK);
+    assert(!vm_check_breakpoint(&vm, 2));
+    vm_reset(&vm);
+    vm.memory[0] = vm_encode_instruction(OP_LDA, ADDR_IMMEDIATE, 0);
+    vm.memory[1] = vm_encode_instruction(OP_ADD, ADDR_IMMEDIATE, 1);
+    vm.memory[2] = vm_encode_instruction(OP_JMP, ADDR_DIRECT, 1);
+    assert(vm_add_breakpoint(&vm, 1) == RESULT_OK);
+    assert(vm_set_breakpoint_condition(&vm, 1, "0") == RESULT_OK);
+    assert(vm_add_breakpoint(&vm, 2) == RESULT_OK);
+    assert(vm_set_breakpoint_condition(&vm, 2, "X == 1 && ACC < 0") == RESULT_OK);
+    clock_t start = clock();
+    assert(vm_run(&vm, 2000000) == RESULT_OK);
+    printf("  2M cycles past two conditional breakpoints in %.2f s\n",
+           (double)(clock() - start) / CLOCKS_PER_SEC);
+}
+
+void test_trace_ring(void) {
+    printf("Testing binary trace..\n");
+    static sap_vm_t vm;
+    vm_init(&vm);
+    vm.debug_enabled = false;
+    cmd_load_sample(&vm, "count");
+    assert(vm_trace_start(&vm, 10, "sap_vm_test.trace") == RESULT_OK);
+    assert(vm.trace_ring->mask == 15);
+    assert(vm_run(&vm, 10000) == RESULT_HALT);
+
+    // the file was written on halt and holds the last 16 instructions
+    sap_trace_record_t *records;
+    long n = vm_trace_read("sap_vm_test.trace", &records);
+    assert(n == 16);
+    assert(records[15].cycle == vm.cycle_count);
+    assert(records[15].pc == vm.last_pc);
+    assert(records[15].ir == (uint16_t)vm.memory[vm.last_pc]);
+    for (long i = 1; i < n; i++) {
+        assert(records[i].cycle == records[i - 1].cycle + 1);
+    }
+    free(records);
+    printf("  Last %ld of %llu instructions written on halt\n", n,
+           (unsigned long long)vm.cycle_count);
+
+    // the ring also keeps the path to an error
+    vm_reset(&vm);
+    vm.memory[0] = vm_encode_instruction(OP_LDA, ADDR_IMMEDIATE, 7);
+    vm.memory[1] = vm_encode_instruction(OP_DIV, ADDR_IMMEDIATE, 0);
+    assert(vm_run(&vm, 100) == RESULT_ERROR);
+    n = vm_trace_read("sap_vm_test.trace", &records);
+    assert(n == 2);
+    assert(records[1].pc == 1 && records[1].accumulator == 7);
+    free(records);
+    printf("  Written on error too\n");
+
+    // the cost of tracing against the debug-capable loop alone
+    vm_reset(&vm);
+    vm.memory[0] = vm_encode_instruction(OP_ADD, ADDR_IMMEDIATE, 1);
+    vm.memory[1] = vm_encode_instruction(OP_JMP, ADDR_DIRECT, 0);
+    vm.debug_enabled = true;
+    clock_t start = clock();
+    vm_run(&vm, 5000000);
+    double traced = (double)(clock() - start) / CLOCKS_PER_SEC;
+    vm_trace_stop(&vm);
+    vm_reset(&vm);
+    vm.memory[0] = vm_encode_instruction(OP_ADD, ADDR_IMMEDIATE, 1);
+    vm.memory[1] = vm_encode_instruction(OP_JMP, ADDR_DIRECT, 0);
+    start = clock();
+    vm_run(&vm, 5000000);
+    double plain = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("  5M instructions: %.2f s untraced, %.2f s traced\n", plain, traced);
+    vm_destroy(&vm);
+    remove("sap_vm_test.trace");
+}
+
+static const char *batch_names[] = {"fib", "fact", "sub", "count", "arith", "loop", "memtest"};
+#define BATCH_SAMPLES (sizeof(batch_names) / sizeof(batch_names[0]))
+
+// each VM a copy of a sample's image, built once for all the tests
+static sap_vm_t *make_batch(size_t n) {
+    static sap_vm_t template;
+    vm_init(&template);
+    template.debug_enabled = false;
+    sap_vm_t *vms = malloc(n * sizeof(sap_vm_t));
+    assert(vms != NULL);
+    for (size_t i = 0; i < n; i++) {
+        const sap_image_t *image = sample_image(batch_names[i % BATCH_SAMPLES]);
+        assert(image != NULL);
+        vms[i] = template;
+        vm_image_load(&vms[i], image);
+    }
+    return vms;
+}
+
+void test_batch(void) {
+    printf("Testing batch execution..\n");
+    const size_t n = 64;
+    sap_vm_t *vms = make_batch(n);
+    sap_vm_t *ref = make_batch(BATCH_SAMPLES);
+    for (size_t i = 0; i < BATCH_SAMPLES; i++) {
+        vm_run_quiet(&ref[i], 10000);
+    }
+
+    batch_summary_t summary = vm_run_batch(vms, n, 10000, 4);
+    assert(summary.halted + summary.errors + summary.stopped == n);
+    uint64_t cycles = 0;
+    for (size_t i = 0; i < n; i++) {
+        const sap_vm_t *r = &ref[i % BATCH_SAMPLES];
+        assert(vms[i].state == r->state);
+        assert(vms[i].cpu.accumulator == r->cpu.accumulator);
+        assert(vms[i].cycle_count == r->cycle_count);
+        cycles += vms[i].cycle_count;
+    }
+    assert(summary.total_cycles == cycles);
+    printf("  %zu VMs on %d threads match single runs (%zu halted)\n",
+           n, summary.threads, summary.halted);
+
+    free(vms);
+    free(ref);
+}
+
+void test_images(void) {
+    printf("Testing program images..\n");
+    const char *path = "sap_vm_test.img";
+    sap_vm_t *ref = make_batch(BATCH_SAMPLES);
+    static sap_vm_t vm;
+    sap_image_cache_t *cache = vm_image_cache_new();
+    assert(cache != NULL);
+
+    for (size_t i = 0; i < BATCH_SAMPLES; i++) {
+        sap_symbol_t symbols[] = {{"start", PROGRAM_START}, {"data", DATA_MEMORY_START}};
+        assert(vm_save_image(&ref[i], path, 0, MEMORY_SIZE - 1, PROGRAM_START,
+                             symbols, 2) == RESULT_OK);
+        vm_init(&vm);
+        vm.debug_enabled = false;
+        assert(vm_load_image(&vm, NULL, path) == RESULT_OK);
+        assert(memcmp(vm.memory, ref[i].memory, sizeof(vm.memory)) == 0);
+
+        // decoded once per file, then shared
+        const sap_image_t *image = vm_image_cache_get(cache, &vm, batch_names[i]);
+        assert(image == NULL && vm.state == VM_ERROR);
+        char name[64];
+        snprintf(name, sizeof(name), "sap_vm_test_%s.img", batch_names[i]);
+        assert(rename(path, name) == 0);
+        image = vm_image_cache_get(cache, &vm, name);
+        assert(image != NULL && image == vm_image_cache_get(cache, &vm, name));
+        assert(vm_image_symbol(image, "data") == DATA_MEMORY_START);
+        assert(vm_image_symbol(image, "nothing") == -1);
+
+        vm_image_load(&vm, image);
+        vm_run_quiet(&ref[i], 10000);
+        vm_run_quiet(&vm, 10000);
+        assert(vm.state == ref[i].state);
+        assert(vm.cpu.accumulator == ref[i].cpu.accumulator);
+        assert(vm.cycle_count == ref[i].cycle_count);
+        assert(memcmp(vm.memory, ref[i].memory, sizeof(vm.memory)) == 0);
+        remove(name);
+    }
+    printf("  Images of all samples load and run as the samples do\n");
+
+    // vm_load_program() tells an image from raw words
+    sap_symbol_t none[1];
+    vm.memory[0] = vm_encode_instruction(OP_LDA, ADDR_IMMEDIATE, 7);
+    vm.memory[1] = vm_encode_instruction(OP_RTS, ADDR_IMMEDIATE, 1);
+    assert(vm_save_image(&vm, path, 0, 1, 0, none, 0) == RESULT_OK);
+    vm_init(&vm);
+    vm.debug_enabled = false;
+    assert(vm_load_program(&vm, path) == RESULT_OK);
+    assert(vm_run_quiet(&vm, 100) == RESULT_HALT && vm.cpu.accumulator == 7);
+
+    // a bad version or a truncated file is rejected
+    FILE *f = fopen(path, "r+b");
+    assert(f != NULL);
+    fseek(f, 4, SEEK_SET);
+    fputc(SAP_IMAGE_VERSION + 1, f);
+    fclose(f);
+    assert(vm_load_image(&vm, NULL, path) == RESULT_ERROR);
+    f = fopen(path, "wb");
+    assert(f != NULL);
+    fwrite(SAP_IMAGE_MAGIC "\1\0\0\0\0\0\5\0", 1, 12, f);
+    fclose(f);
+    assert(vm_load_image(&vm, NULL, path) == RESULT_ERROR);
+    remove(path);
+    printf("  Bad images are rejected\n");
+
+    vm_image_cache_free(cache);
+    free(ref);
+}
+
+// load_counting_demo(), written out
+static const char *count_source =
+    "; count from 1 to limit\n"
+    "loop:   LDA counter\n"
+    "        ADD #1\n"
+    "        STA counter\n"
+    "        SUB limit           ; counter - limit\n"
+    "        JZ done\n"
+    "        JMP loop\n"
+    "done:   LDA counter\n"
+    "        HLT\n"
+    "\n"
+    "        .org 0x100 + 30\n"
+    "limit:  .word 10\n"
+    "counter: .word 0\n";
+
+// A loop that adds k to itself n times, a program per (k, n)
+static void generated_source(char *buf, size_t size, int k, int n) {
+    snprintf(buf, size,
+             "start:  LDA #0\n"
+             "        STA acc\n"
+             "        LDA #%d\n"
+             "        STA left\n"
+             "again:  LDA acc\n"
+             "        ADD #%d\n"
+             "        STA acc\n"
+             "        LDA left\n"
+             "        SUB #1\n"
+             "        STA left\n"
+             "        JNZ again\n"
+             "        LDA acc\n"
+             "        HLT\n"
+             "        .org 0x200\n"
+             "acc:    .word 0\n"
+             "left:   .word 0\n"
+             "        .entry start\n", n, k);
+}
+
+static bool assembles_to_error(sap_vm_t *vm, const char *source, const char *message) {
+    sap_image_t *image;
+    if (vm_assemble(vm, source, &image) != RESULT_ERROR || image != NULL) {
+        return false;
+    }
+    return strstr(vm->last_error, message) != NULL;
+}
+
+void test_assembler(void) {
+    printf("Testing the assembler..\n");
+    static sap_vm_t vm;
+    vm_init(&vm);
+    vm.debug_enabled = false;
+
+    // forward labels patched in the one pass, to the sample word for word
+    sap_image_t *image;
+    assert(vm_assemble(&vm, count_source, &image) == RESULT_OK);
+    const sap_image_t *sample = sample_image("count");
+    assert(sample != NULL);
+    assert(memcmp(image->memory, sample->memory, sizeof(image->memory)) == 0);
+    assert(image->base == 0 && image->length == DATA_MEMORY_START + 32);
+    assert(image->symbol_count == 4);
+    assert(vm_image_symbol(image, "counter") == DATA_MEMORY_START + 31);
+    vm_image_load(&vm, image);
+    assert(vm_run_quiet(&vm, 1000) == RESULT_HALT && vm.cpu.accumulator == 10);
+    vm_image_close(image);
+
+    // operands as the disassembler writes them
+    const char *modes = "LDA #3\nLDA 5\nLDA @5\nLDA ,X5\nlda 5,x\nRTS\nHLT 2\nLDA #-3\n";
+    const char *expect[] = {"LDA #3", "LDA 5", "LDA @5", "LDA ,X5", "LDA ,X5", "RTS", "RTS"};
+    assert(vm_assemble(&vm, modes, &image) == RESULT_OK);
+    for (int i = 0; i < 7; i++) {
+        char text[32];
+        vm_format_instruction((uint16_t)image->memory[i], text, sizeof(text));
+        assert(strcmp(text, expect[i]) == 0);
+    }
+    assert(image->memory[5] == (int16_t)vm_encode_instruction(OP_RTS, ADDR_IMMEDIATE, 0));
+    assert(image->memory[6] == (int16_t)vm_encode_instruction(OP_RTS, ADDR_IMMEDIATE, 2));
+    assert(image->memory[7] == (int16_t)vm_encode_instruction(OP_LDA, ADDR_IMMEDIATE, (uint16_t)-3));
+    vm_image_close(image);
+
+    // errors name their line
+    assert(assembles_to_error(&vm, "JMP nowhere\n", "Line 1: Undefined label: nowhere"));
+    assert(assembles_to_error(&vm, "a: NOP\na: NOP\n", "Line 2: Label defined twice"));
+    assert(assembles_to_error(&vm, "NOP\nFOO 1\n", "Line 2: Unknown instruction"));
+    assert(assembles_to_error(&vm, "JMP far\n.org 1020\nfar: .word 1, 2, 3, 4, 5\n",
+                              "Line 3: Program does not fit"));
+    assert(assembles_to_error(&vm, "ADD #600\n", "Immediate out of range"));
+    assert(assembles_to_error(&vm, "JZ later + 1024\nlater: NOP\n", "Line 1: Address out of range"));
+    assert(assembles_to_error(&vm, "STA #1\n", "No immediate operand"));
+    assert(assembles_to_error(&vm, ".word 1\n.org 0\n.word 2\n", "Line 3: Address written twice"));
+    printf("  Sources assemble to the sample words; errors carry their line\n");
+
+    // streamed from a file a line at a time
+    const char *path = "sap_vm_test.s";
+    FILE *f = fopen(path, "w");
+    assert(f != NULL);
+    fputs(count_source, f);
+    fclose(f);
+    assert(vm_assemble_file(&vm, path, &image) == RESULT_OK);
+    assert(memcmp(image->memory, sample->memory, sizeof(image->memory)) == 0);
+    vm_image_close(image);
+    remove(path);
+
+    // a generated suite: 100 programs, each five times over, on 4 threads
+    enum { DISTINCT = 100, SOURCES = 500 };
+    static char texts[DISTINCT][512];
+    const char *sources[SOURCES];
+    const sap_image_t *images[SOURCES];
+    for (int i = 0; i < DISTINCT; i++) {
+        generated_source(texts[i], sizeof(texts[i]), i % 10 + 1, i / 10 + 1);
+    }
+    for (int i = 0; i < SOURCES; i++) {
+        sources[i] = texts[i % DISTINCT];
+    }
+    sap_asm_cache_t *cache = vm_asm_cache_new();
+    assert(cache != NULL);
+    assert(vm_assemble_batch(cache, sources, SOURCES, images, 4) == 0);
+    size_t hits, misses;
+    vm_asm_cache_stats(cache, &hits, &misses);
+    assert(hits + misses == SOURCES && misses >= DISTINCT);
+    for (int i = 0; i < SOURCES; i++) {
+        assert(images[i] == images[i % DISTINCT]);
+        int k = i % 10 + 1, n = i % DISTINCT / 10 + 1;
+        vm_image_load(&vm, images[i]);
+        assert(vm_run_quiet(&vm, 10000) == RESULT_HALT && vm.cpu.accumulator == k * n);
+    }
+    assert(vm_asm_cache_get(cache, &vm, texts[7]) == images[7]);
+    assert(vm_asm_cache_get(cache, &vm, "JMP nowhere\n") == NULL);
+    vm_asm_cache_free(cache);
+    printf("  %d sources on 4 threads: %zu assembled, %zu from the cache, all run\n",
+           SOURCES, misses, hits);
+}
+
+// sap_vm_test --throughput [vms] [threads]
+static int run_throughput(size_t n, int threads) {
+    printf("SAP VM batch throughput\n");
+    printf("-----------------------\n\n");
+    int counts[2] = {1, threads};
+
+    for (int k = 0; k < 2; k++) {
+        sap_vm_t *vms = make_batch(n);
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        batch_summary_t s = vm_run_batch(vms, n, 100000, counts[k]);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double secs = (double)(t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+        if (secs <= 0) {
+            secs = 1e-9;
+        }
+        printf("%2d thread(s): %zu VMs, %llu cycles in %.3f s  "
+               "(%.0f VMs/s, %.1f Mcycles/s)\n",
+               s.threads, n, (unsigned long long)s.total_cycles, secs,
+               n / secs, s.total_cycles / secs / 1e6);
+        free(vms);
+    }
+
+    // loading: raw words parsed per VM against one cached image
+    sap_vm_t *vms = make_batch(n);
+    vm_save_program(&vms[0], "sap_vm_test.raw", 0, MEMORY_SIZE - 1);
+    vm_save_image(&vms[0], "sap_vm_test.img", 0, MEMORY_SIZE - 1, PROGRAM_START, NULL, 0);
+    sap_image_cache_t *cache = vm_image_cache_new();
+    for (int k = 0; k < 2; k++) {
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (size_t i = 0; i < n; i++) {
+            if (k == 0) {
+                vm_load_program(&vms[i], "sap_vm_test.raw");
+            } else {
+                vm_load_image(&vms[i], cache, "sap_vm_test.img");
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double secs = (double)(t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+        printf("%-12s %zu VMs loaded in %.4f s\n", k == 0 ? "raw file:" : "image cache:", n, secs);
+    }
+    vm_image_cache_free(cache);
+    remove("sap_vm_test.raw");
+    remove("sap_vm_test.img");
+    free(vms);
+
+    // assembling: every program new on one thread and on the pool, then
+    // all of them again from the cache
+    char (*texts)[512] = malloc(n * sizeof(*texts));
+    const char **sources = malloc(n * sizeof(*sources));
+    const sap_image_t **images = malloc(n * sizeof(*images));
+    if (!texts || !sources || !images) {
+        free(texts);
+        free(sources);
+        free(images);
+        return 1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        generated_source(texts[i], sizeof(texts[i]), (int)(i % 500), (int)(i / 500 + 1));
+        sources[i] = texts[i];
+    }
+    for (int k = 0; k < 3; k++) {
+        static sap_asm_cache_t *asm_cache;
+        if (k < 2) {
+            vm_asm_cache_free(asm_cache);
+            asm_cache = vm_asm_cache_new();
+        }
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        size_t failed = vm_assemble_batch(asm_cache, sources, n, images, counts[k == 0 ? 0 : 1]);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double secs = (double)(t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+        const char *names[] = {"assembled, 1 thread:", "assembled, pool:", "from the cache:"};
+        printf("%-22s %zu sources in %.4f s (%zu failed)\n", names[k], n, secs, failed);
+        if (k == 2) {
+            vm_asm_cache_free(asm_cache);
+        }
+    }
+    free(texts);
+    free(sources);
+    free(images);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--throughput") == 0) {
+        size_t n = (argc > 2) ? (size_t)strtoul(argv[2], NULL, 10) : 2000;
+        int threads = (argc > 3) ? atoi(argv[3]) : 0;
+        return run_throughput(n ? n : 1, threads);
+    }
+
     printf("SAP VM Test Suite\n");
     printf("------------------\n\n");
     
@@ -133,6 +653,27 @@ int main(void) {
     
     test_sample_programs();
     printf("\n");
+
+    test_flags();
+    printf("\n");
+    
+    test_fast_path();
+    printf("\n");
+
+    test_conditional_breakpoints();
+    printf("\n");
+
+    test_trace_ring();
+    printf("\n");
+    
+    test_batch();
+    printf("\n");
+
+    test_images();
+    printf("\n");
+
+    test_assembler();
+    printf("\n");
     
     printf("All tests passed! ✓\n");
     printf("You can run the debugger and try the sample programs:\n");
@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sap_vm.h"
+#include "sap_vm_config.h"
+
+// File layout, little-endian:
+//   0  char     magic[4]      "SAPT"
+//   4  uint16   version       SAP_TRACE_VERSION
+//   6  uint16   reserved      0
+//   8  uint32   count         records that follow
+//  12  records[count], oldest first, each
+//        uint64 cycle, uint16 pc, uint16 ir, int16 accumulator,
+//        uint8 flags, uint8 0
+#define HEADER_SIZE 12
+#define RECORD_SIZE 16
+#define MAX_RECORDS (1u << 24)
+
+static void put(unsigned char *p, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        p[i] = (unsigned char)(v >> (8 * i));
+    }
+}
+
+static uint64_t get(const unsigned char *p, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; i++) {
+        v |= (uint64_t)p[i] << (8 * i);
+    }
+    return v;
+}
+
+// records is rounded up to a power of two. A VM with a trace must be
+// given to vm_trace_stop() or vm_destroy() before vm_init() again.
+result_t vm_trace_start(sap_vm_t *vm, uint32_t records, const char *dump_file) {
+    if (records == 0 || records > MAX_RECORDS) {
+        return vm_set_error(vm, "Trace size must be 1 to %u records", MAX_RECORDS);
+    }
+    if (dump_file && strlen(dump_file) >= sizeof(vm->trace_ring->dump_file)) {
+        return vm_set_error(vm, "Trace file name too long");
+    }
+    uint32_t size = 1;
+    while (size < records) {
+        size <<= 1;
+    }
+    vm_trace_stop(vm);
+    sap_trace_t *t = calloc(1, sizeof(sap_trace_t));
+    sap_trace_record_t *r = calloc(size, sizeof(sap_trace_record_t));
+    if (!t || !r) {
+        free(t);
+        free(r);
+        return vm_set_error(vm, "Out of memory");
+    }
+    t->records = r;
+    t->mask = size - 1;
+    if (dump_file) {
+        strcpy(t->dump_file, dump_file);
+    }
+    vm->trace_ring = t;
+    if (vm->debug_enabled) {
+        printf("Tracing the last %u instructions%s%s\n", size,
+               t->dump_file[0] ? " to " : "", t->dump_file);
+    }
+    return RESULT_OK;
+}
+
+void vm_trace_stop(sap_vm_t *vm) {
+    if (vm->trace_ring) {
+        free(vm->trace_ring->records);
+        free(vm->trace_ring);
+        vm->trace_ring = NULL;
+    }
+}
+
+result_t vm_trace_dump(sap_vm_t *vm, const char *filename) {
+    sap_trace_t *t = vm->trace_ring;
+    if (!t) {
+        return vm_set_error(vm, "Tracing is not on");
+    }
+    if (!filename || !filename[0]) {
+        return vm_set_error(vm, "No filename specified");
+    }
+    uint64_t size = (uint64_t)t->mask + 1;
+    uint64_t count = t->count < size ? t->count : size;
+    FILE *file = fopen(filename, "wb");
+    if (!file) {
+        return vm_set_error(vm, "Cannot create file: %s", filename);
+    }
+    unsigned char buf[RECORD_SIZE];
+    memcpy(buf, SAP_TRACE_MAGIC, 4);
+    put(buf + 4, SAP_TRACE_VERSION, 2);
+    put(buf + 6, 0, 2);
+    put(buf + 8, count, 4);
+    bool ok = fwrite(buf, 1, HEADER_SIZE, file) == HEADER_SIZE;
+    for (uint64_t i = t->count - count; i < t->count && ok; i++) {
+        const sap_trace_record_t *r = &t->records[i & t->mask];
+        put(buf, r->cycle, 8);
+        put(buf + 8, r->pc, 2);
+        put(buf + 10, r->ir, 2);
+        put(buf + 12, (uint16_t)r->accumulator, 2);
+        buf[14] = r->flags;
+        buf[15] = 0;
+        ok = fwrite(buf, 1, RECORD_SIZE, file) == RECORD_SIZE;
+    }
+    if (fclose(file) != 0 || !ok) {
+        return vm_set_error(vm, "Error writing to file");
+    }
+    if (vm->debug_enabled) {
+        printf("Trace of %llu instructions written to %s\n",
+               (unsigned long long)count, filename);
+    }
+    return RESULT_OK;
+}
+
+// Returns the number of records read into a malloc()ed array, or -1
+// with a message on stderr
+long vm_trace_read(const char *filename, sap_trace_record_t **records) {
+    FILE *file = fopen(filename, "rb");
+    if (!file) {
+        fprintf(stderr, "Cannot open file: %s\n", filename);
+        return -1;
+    }
+    unsigned char buf[RECORD_SIZE];
+    if (fread(buf, 1, HEADER_SIZE, file) != HEADER_SIZE ||
+        memcmp(buf, SAP_TRACE_MAGIC, 4) != 0 ||
+        get(buf + 4, 2) != SAP_TRACE_VERSION) {
+        fprintf(stderr, "Not a trace file: %s\n", filename);
+        fclose(file);
+        return -1;
+    }
+    uint32_t count = (uint32_t)get(buf + 8, 4);
+    sap_trace_record_t *r = (count <= MAX_RECORDS) ?
+        calloc(count > 0 ? count : 1, sizeof(sap_trace_record_t)) : NULL;
+    if (!r) {
+        fprintf(stderr, "Trace too large: %s\n", filename);
+        fclose(file);
+        return -1;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (fread(buf, 1, RECORD_SIZE, file) != RECORD_SIZE) {
+            fprintf(stderr, "Trace truncated: %s\n", filename);
+            free(r);
+            fclose(file);
+            return -1;
+        }
+        r[i].cycle = get(buf, 8);
+        r[i].pc = (uint16_t)get(buf + 8, 2);
+        r[i].ir = (uint16_t)get(buf + 10, 2);
+        r[i].accumulator = (int16_t)get(buf + 12, 2);
+        r[i].flags = buf[14];
+    }
+    fclose(file);
+    *records = r;
+    return (long)count;
+}
@@ -0,0 +1,37 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "sap_vm.h"
+
+// Offline decoder for binary traces: sap_vm_trace <file> [last]
+// prints the records (or the last ones) as disassembly with the
+// accumulator and flags before each instruction.
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <trace file> [last records]\n", argv[0]);
+        return 1;
+    }
+    sap_trace_record_t *records;
+    long count = vm_trace_read(argv[1], &records);
+    if (count < 0) {
+        return 1;
+    }
+    long first = 0;
+    if (argc > 2) {
+        long last = atol(argv[2]);
+        if (last >= 0 && last < count) {
+            first = count - last;
+        }
+    }
+    printf("%-10s %-6s %-4s  %-14s %6s  Flags\n", "Cycle", "PC", "IR", "Instruction", "ACC");
+    for (long i = first; i < count; i++) {
+        const sap_trace_record_t *r = &records[i];
+        char text[32];
+        vm_format_instruction(r->ir, text, sizeof(text));
+        printf("%-10llu 0x%04X %04X  %-14s %6d  Z:%d N:%d C:%d O:%d\n",
+               (unsigned long long)r->cycle, r->pc, r->ir, text, r->accumulator,
+               (r->flags & SAP_TRACE_ZERO) != 0, (r->flags & SAP_TRACE_NEGATIVE) != 0,
+               (r->flags & SAP_TRACE_CARRY) != 0, (r->flags & SAP_TRACE_OVERFLOW) != 0);
+    }
+    free(records);
+    return 0;
+}
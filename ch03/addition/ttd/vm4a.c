@@ -1,9 +1,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #define STACK_SIZE 100
 #define LOCALS_SIZE 10
+#ifndef CHECKPOINT_INTERVAL
+#define CHECKPOINT_INTERVAL 256
+#endif
+#ifndef MAX_CHECKPOINTS
+#define MAX_CHECKPOINTS 64
+#endif
 #define TRUE 1
 #define FALSE 0
 
@@ -33,22 +40,91 @@ typedef struct {
     int returnAddress;
 } Frame;
 
+// Frames are allocated once per depth and kept when popped, so every
+// cell of the VM stays where it is for the history to point at.
 typedef struct FrameStack {
     Frame* frames[STACK_SIZE];
     int fp;
 } FrameStack;
 
+// The history keeps checkpoints, and replays from them: the VM is
+// deterministic, so running again from a checkpoint comes to the same
+// states, and any earlier step is at most one interval of execution
+// away. Since the last checkpoint, the cells each step changed are also
+// logged, so stepping back within the interval is an undo rather than
+// a replay. When there are MAX_CHECKPOINTS, every other one is dropped
+// and the interval doubles, so the memory stays bounded however long
+// the run.
+
+// One cell written: where, and what it held
+typedef struct {
+    int* at;
+    int old;
+} Write;
+
+// Where a step begins: its pc, and its first write in the log
 typedef struct {
     int pc;
-    int sp;
-    int locals[LOCALS_SIZE];
-    int stack[STACK_SIZE];
-} State;
+    int write;
+} Step;
+
+// Every frame before a step. Those above fp are taken too: undoing back
+// past a RET needs the frame as it was, and it is only written again
+// when another call reuses it
+typedef struct {
+    int step;
+    int pc;
+    int fp;
+    int nframes;
+    Frame* frames;
+} Checkpoint;
+
+// Alongside the history, for questions about the whole run: the steps,
+// in order, that changed each cell, and that began at each pc. Only the
+// first run of a step adds to them, a replay has been indexed already,
+// so a question is a binary search instead of a scan of the steps
+typedef struct {
+    int* steps;
+    int n;
+    int capacity;
+} StepList;
 
+// The steps at which a frame's sp went above any it had before at that
+// depth, and to what, both rising
 typedef struct {
-    State* states;
-    int size;
+    int* steps;
+    int* sps;
+    int n;
     int capacity;
+} SpPeaks;
+
+// A depth's cells, for every frame there has been at that depth
+typedef struct {
+    StepList locals[LOCALS_SIZE];
+    StepList stack[STACK_SIZE];
+    SpPeaks peaks;
+} SlotIndex;
+
+typedef struct {
+    SlotIndex* depths[STACK_SIZE];
+    StepList* pcs;          // per code address
+} HistoryIndex;
+
+typedef struct {
+    Write* writes;          // since step start
+    int nwrites;
+    int wcapacity;
+    Step* steps;            // steps start .. now - 1
+    int nsteps;
+    int scapacity;
+    int start;
+    Checkpoint checkpoints[MAX_CHECKPOINTS];
+    int ncheckpoints;
+    int interval;           // steps between checkpoints
+    int now;                // the VM is before this step
+    int end;                // steps ever run; those before are replays
+    int last;               // the step that halted, -1 before
+    HistoryIndex index;
 } StateHistory;
 
 typedef struct VM {
@@ -57,6 +133,7 @@ typedef struct VM {
     int code_length;
     FrameStack fstack;
     StateHistory history;  // history for time travel debugging
+    char* breakpoints;     // per code address
     int debug;
 } VM;
 
@@ -77,20 +154,105 @@ int next(VM* vm) {
     return vm->code[vm->pc++];
 }
 
+void* grow(VM* vm, void* items, int* capacity, size_t size) {
+    *capacity = (*capacity > 0) ? *capacity * 2 : 64;
+    void* more = realloc(items, size * *capacity);
+    if (more == NULL) {
+        error(vm, "Out of memory");
+    }
+    return more;
+}
+
+void addStep(VM* vm, StepList* list, int step) {
+    if (list->n > 0 && list->steps[list->n - 1] == step) {
+        return;
+    }
+    if (list->n >= list->capacity) {
+        list->steps = grow(vm, list->steps, &list->capacity, sizeof(int));
+    }
+    list->steps[list->n++] = step;
+}
+
+SlotIndex* slotIndex(VM* vm, int depth) {
+    HistoryIndex* x = &vm->history.index;
+    if (x->depths[depth] == NULL) {
+        x->depths[depth] = (SlotIndex*) calloc(1, sizeof(SlotIndex));
+        if (x->depths[depth] == NULL) {
+            error(vm, "Out of memory");
+        }
+    }
+    return x->depths[depth];
+}
+
+// The cell a step changed, put in its list: a write always goes to the
+// frame at fp, or the one below or above it
+void indexWrite(VM* vm, int* at, int value, int step) {
+    for (int d = vm->fstack.fp - 1; d <= vm->fstack.fp + 1; d++) {
+        Frame* f = d >= 0 && d < STACK_SIZE ? vm->fstack.frames[d] : NULL;
+        if (f == NULL || at < (int*) f || at >= (int*) (f + 1)) {
+            continue;
+        }
+        SlotIndex* s = slotIndex(vm, d);
+        if (at >= f->locals && at < f->locals + LOCALS_SIZE) {
+            addStep(vm, &s->locals[at - f->locals], step);
+        } else if (at >= f->stack && at < f->stack + STACK_SIZE) {
+            addStep(vm, &s->stack[at - f->stack], step);
+        } else if (at == &f->sp && (s->peaks.n == 0 || value > s->peaks.sps[s->peaks.n - 1])) {
+            SpPeaks* p = &s->peaks;
+            if (p->n >= p->capacity) {
+                int capacity = p->capacity;
+                p->steps = grow(vm, p->steps, &capacity, sizeof(int));
+                p->sps = grow(vm, p->sps, &p->capacity, sizeof(int));
+            }
+            p->steps[p->n] = step;
+            p->sps[p->n++] = value;
+        }
+        return;
+    }
+}
+
+// Every change to a frame or to fp goes through here
+void record(VM* vm, int* at, int value) {
+    StateHistory* h = &vm->history;
+    if (h->nwrites >= h->wcapacity) {
+        h->writes = grow(vm, h->writes, &h->wcapacity, sizeof(Write));
+    }
+    if (h->now > h->end && *at != value) {
+        indexWrite(vm, at, value, h->now - 1);
+    }
+    h->writes[h->nwrites++] = (Write){ at, *at };
+    *at = value;
+}
+
 void initFrameStack(FrameStack* fstack) {
     fstack->fp = -1;
+    for (int i = 0; i < STACK_SIZE; i++) {
+        fstack->frames[i] = NULL;
+    }
 }
 
+// Locals start at 0, so nothing a frame can read is left over from the
+// last frame at its depth
 int pushFrame(VM* vm) {
     if (vm->fstack.fp >= STACK_SIZE - 1) {
         error(vm, "Frame stack overflow");
     }
-    Frame* frame = (Frame*) malloc(sizeof(Frame));
-    frame->sp = -1;
-    frame->returnValue = 0;
-    frame->returnAddress = 0;
-    vm->fstack.frames[++(vm->fstack.fp)] = frame;
-    return vm->fstack.fp;
+    int fp = vm->fstack.fp + 1;
+    if (vm->fstack.frames[fp] == NULL) {
+        vm->fstack.frames[fp] = (Frame*) calloc(1, sizeof(Frame));
+        if (vm->fstack.frames[fp] == NULL) {
+            error(vm, "Out of memory");
+        }
+    }
+    Frame* frame = vm->fstack.frames[fp];
+    record(vm, &frame->sp, -1);
+    record(vm, &frame->returnValue, 0);
+    record(vm, &frame->returnAddress, 0);
+    for (int i = 0; i < LOCALS_SIZE; i++) {
+        record(vm, &frame->locals[i], 0);
+    }
+    record(vm, &vm->fstack.fp, fp);
+    return fp;
 }
 
 int popFrame(VM* vm) {
@@ -99,8 +261,7 @@ int popFrame(VM* vm) {
     }
     Frame* currentFrame = vm->fstack.frames[vm->fstack.fp];
     vm->pc = currentFrame->returnAddress;
-    free(currentFrame);
-    vm->fstack.fp--;
+    record(vm, &vm->fstack.fp, vm->fstack.fp - 1);
     return vm->fstack.fp + 1;
 }
 
@@ -118,7 +279,8 @@ void push(VM* vm, int value) {
     if (frame->sp >= STACK_SIZE - 1) {
         error(vm, "Stack overflow in frame");
     }
-    frame->stack[++(frame->sp)] = value;
+    record(vm, &frame->stack[frame->sp + 1], value);
+    record(vm, &frame->sp, frame->sp + 1);
 }
 
 int pop(VM* vm) {
@@ -126,12 +288,14 @@ int pop(VM* vm) {
     if (frame->sp < 0) {
         error(vm, "Stack underflow in frame");
     }
-    return frame->stack[(frame->sp)--];
+    int value = frame->stack[frame->sp];
+    record(vm, &frame->sp, frame->sp - 1);
+    return value;
 }
 
 void store(VM* vm, int index) {
     int value = pop(vm);
-    vm->fstack.frames[vm->fstack.fp]->locals[index] = value;
+    record(vm, &vm->fstack.frames[vm->fstack.fp]->locals[index], value);
 }
 
 void load(VM* vm, int index) {
@@ -143,15 +307,17 @@ void transferStackToLocals(VM* vm, int num) {
     Frame* currentFrame = vm->fstack.frames[vm->fstack.fp];
     Frame* prevFrame = vm->fstack.frames[vm->fstack.fp - 1];
     for (int i = 0; i < num; ++i) {
-        currentFrame->locals[i] = prevFrame->stack[prevFrame->sp--];
+        record(vm, &currentFrame->locals[i], prevFrame->stack[prevFrame->sp]);
+        record(vm, &prevFrame->sp, prevFrame->sp - 1);
     }
 }
 
 void transferStackToReturnValue(VM* vm) {
     Frame* srcFrame = vm->fstack.frames[vm->fstack.fp];
     Frame* destFrame = vm->fstack.frames[vm->fstack.fp - 1];
-    int value = srcFrame->stack[srcFrame->sp--];
-    destFrame->returnValue = value;
+    int value = srcFrame->stack[srcFrame->sp];
+    record(vm, &srcFrame->sp, srcFrame->sp - 1);
+    record(vm, &destFrame->returnValue, value);
 }
 
 VM* newVM(int* code, int code_length) {
@@ -164,117 +330,541 @@ VM* newVM(int* code, int code_length) {
     vm->code_length = code_length;
     initFrameStack(&(vm->fstack));
     
+    vm->breakpoints = (char*) calloc(code_length, 1);
+
     // init state history
-    vm->history.size = 0;
-    vm->history.capacity = 10; // init capacity
-    vm->history.states = (State*)malloc(sizeof(State) * vm->history.capacity);
-    
+    memset(&vm->history, 0, sizeof(StateHistory));
+    vm->history.interval = CHECKPOINT_INTERVAL;
+    vm->history.last = -1;
+    vm->history.index.pcs = (StepList*) calloc(code_length, sizeof(StepList));
+
     return vm;
 }
 
 void freeVM(VM* vm) {
-    while (vm->fstack.fp >= 0) {
-        popFrame(vm);
+    for (int i = 0; i < STACK_SIZE; i++) {
+        free(vm->fstack.frames[i]);
+    }
+    for (int i = 0; i < vm->history.ncheckpoints; i++) {
+        free(vm->history.checkpoints[i].frames);
     }
-    free(vm->history.states); // free the state history
+    free(vm->history.steps);
+    free(vm->history.writes);
+    HistoryIndex* x = &vm->history.index;
+    for (int d = 0; d < STACK_SIZE; d++) {
+        if (x->depths[d] == NULL) {
+            continue;
+        }
+        for (int i = 0; i < LOCALS_SIZE; i++) {
+            free(x->depths[d]->locals[i].steps);
+        }
+        for (int i = 0; i < STACK_SIZE; i++) {
+            free(x->depths[d]->stack[i].steps);
+        }
+        free(x->depths[d]->peaks.steps);
+        free(x->depths[d]->peaks.sps);
+        free(x->depths[d]);
+    }
+    for (int i = 0; i < vm->code_length; i++) {
+        free(x->pcs[i].steps);
+    }
+    free(x->pcs);
+    free(vm->breakpoints);
     free(vm);
 }
 
+void saveCheckpoint(VM* vm) {
+    StateHistory* h = &vm->history;
+    Checkpoint* c = &h->checkpoints[h->ncheckpoints++];
+    c->step = h->now;
+    c->pc = vm->pc;
+    c->fp = vm->fstack.fp;
+    c->nframes = 0;
+    while (c->nframes < STACK_SIZE && vm->fstack.frames[c->nframes] != NULL) {
+        c->nframes++;
+    }
+    c->frames = (Frame*) malloc(sizeof(Frame) * c->nframes);
+    if (c->frames == NULL) {
+        error(vm, "Out of memory");
+    }
+    for (int i = 0; i < c->nframes; i++) {
+        c->frames[i] = *vm->fstack.frames[i];
+    }
+}
+
+// Every other checkpoint goes; those left are the multiples of the
+// doubled interval
+void thinCheckpoints(VM* vm) {
+    StateHistory* h = &vm->history;
+    int kept = 0;
+    h->interval *= 2;
+    for (int i = 0; i < h->ncheckpoints; i++) {
+        if (h->checkpoints[i].step % h->interval == 0) {
+            h->checkpoints[kept++] = h->checkpoints[i];
+        } else {
+            free(h->checkpoints[i].frames);
+        }
+    }
+    h->ncheckpoints = kept;
+}
+
+// The last checkpoint at or before a step
+Checkpoint* checkpointBefore(VM* vm, int step) {
+    StateHistory* h = &vm->history;
+    int c = 0;
+    for (int lo = 0, hi = h->ncheckpoints - 1; lo <= hi; ) {
+        int mid = (lo + hi) / 2;
+        if (h->checkpoints[mid].step <= step) {
+            c = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return &h->checkpoints[c];
+}
+
+void restoreCheckpoint(VM* vm, Checkpoint* c) {
+    StateHistory* h = &vm->history;
+    for (int i = 0; i < c->nframes; i++) {
+        *vm->fstack.frames[i] = c->frames[i];
+    }
+    vm->fstack.fp = c->fp;
+    vm->pc = c->pc;
+    h->now = h->start = c->step;
+    h->nsteps = h->nwrites = 0;
+}
+
+// Marks the start of a step. Every interval there is a checkpoint, the
+// first time round, and the log starts again from it
 void saveState(VM* vm) {
-    if (vm->history.size >= vm->history.capacity) {
-        vm->history.capacity *= 2; // double capacity
-        vm->history.states = realloc(vm->history.states, sizeof(State) * vm->history.capacity);
+    StateHistory* h = &vm->history;
+    if (h->now % h->interval == 0) {
+        if (h->ncheckpoints == 0 || h->checkpoints[h->ncheckpoints - 1].step < h->now) {
+            if (h->ncheckpoints == MAX_CHECKPOINTS) {
+                thinCheckpoints(vm);
+            }
+            if (h->now % h->interval == 0) {
+                saveCheckpoint(vm);
+            }
+        }
+        if (h->now % h->interval == 0) {
+            h->start = h->now;
+            h->nsteps = h->nwrites = 0;
+        }
     }
-    
-    State* state = &vm->history.states[vm->history.size++];
-    state->pc = vm->pc;
-    state->sp = vm->fstack.frames[vm->fstack.fp]->sp;
-    memcpy(state->locals, vm->fstack.frames[vm->fstack.fp]->locals, sizeof(int) * LOCALS_SIZE);
-    memcpy(state->stack, vm->fstack.frames[vm->fstack.fp]->stack, sizeof(int) * STACK_SIZE);
+    if (h->nsteps >= h->scapacity) {
+        h->steps = grow(vm, h->steps, &h->scapacity, sizeof(Step));
+    }
+    h->steps[h->nsteps++] = (Step){ vm->pc, h->nwrites };
+    if (h->now >= h->end && vm->pc >= 0 && vm->pc < vm->code_length) {
+        addStep(vm, &h->index.pcs[vm->pc], h->now);
+    }
+    h->now++;
 }
 
-void run(VM* vm) {
+// One instruction; output only the first time it runs, not in a replay
+int execute(VM* vm, int replay) {
     int opcode, addr, num;
     Frame* fr;
 
-    while (TRUE) {
-        saveState(vm); // capture current state
-        opcode = next(vm);
-        switch (opcode) {
-
-            case CALL:
-                num = next(vm);
-                addr = next(vm);
-                int frm = pushFrame(vm);
-                fr = getFrame(vm, frm);
-                fr->returnAddress = vm->pc;
-                if (num > 0) {
-                    transferStackToLocals(vm, num);
-                }
+    opcode = next(vm);
+    switch (opcode) {
+
+        case CALL:
+            num = next(vm);
+            addr = next(vm);
+            int frm = pushFrame(vm);
+            fr = getFrame(vm, frm);
+            record(vm, &fr->returnAddress, vm->pc);
+            if (num > 0) {
+                transferStackToLocals(vm, num);
+            }
+            vm->pc = addr;
+            break;
+
+        case RET:
+            if (vm->fstack.fp > 0) {
+                transferStackToReturnValue(vm);
+            }
+            fr = vm->fstack.frames[vm->fstack.fp];
+            vm->pc = fr->returnAddress;
+            popFrame(vm);
+            break;
+
+        case PUSH:
+            push(vm, next(vm));
+            break;
+
+        case POP:
+            pop(vm);
+            break;
+
+        case LD:
+            load(vm, next(vm));
+            break;
+
+        case ST:
+            store(vm, next(vm));
+            break;
+
+        case CRET:
+            push(vm, vm->fstack.frames[vm->fstack.fp]->returnValue);
+            break;
+
+        case PRINT:
+            num = pop(vm);
+            if (!replay)
+                printf("PRINT: %d\n", num);
+            break;
+
+        case ADD:
+            push(vm, pop(vm) + pop(vm));
+            break;
+
+        case SUB:
+            num = pop(vm);
+            push(vm, pop(vm) - num);
+            break;
+
+        case MUL:
+            push(vm, pop(vm) * pop(vm));
+            break;
+
+        case JZ:
+            num = pop(vm);
+            addr = next(vm);
+            if (num <= 0)
                 vm->pc = addr;
-                break;
-
-            case RET:
-                if (vm->fstack.fp > 0) {
-                    transferStackToReturnValue(vm);
-                }
-                fr = vm->fstack.frames[vm->fstack.fp];
-                vm->pc = fr->returnAddress;
-                popFrame(vm);
-                break;
-
-            case PUSH:
-                push(vm, next(vm));
-                break;
-
-            case POP:
-                pop(vm);
-                break;
-
-            case LD:
-                load(vm, next(vm));
-                break;
-
-            case ST:
-                store(vm, next(vm));
-                break;
-
-            case CRET:
-                push(vm, vm->fstack.frames[vm->fstack.fp]->returnValue);
-                break;
-
-            case PRINT:
-                printf("PRINT: %d\n", pop(vm));
-                break;
-
-            case ADD:
-                push(vm, pop(vm) + pop(vm));
-                break;
-
-            case SUB:
-                num = pop(vm);
-                push(vm, pop(vm) - num);
-                break;
-
-            case MUL:
-                push(vm, pop(vm) * pop(vm));
-                break;
-
-            case JZ:
-                num = pop(vm);
-                addr = next(vm);
-                if (num <= 0)
-                    vm->pc = addr;
-                break;
-
-            case HALT:
-                return;
-
-            default:
+            break;
+
+        case HALT:
+            return FALSE;
+
+        default:
+            if (!replay)
                 printf("Unknown opcode: %d\n", opcode);
-                return;
+            return FALSE;
+    }
+    return TRUE;
+}
+
+// FALSE when the program has ended
+int step(VM* vm) {
+    StateHistory* h = &vm->history;
+    if (h->last >= 0 && h->now > h->last) {
+        return FALSE;
+    }
+    saveState(vm); // capture current state
+    int more = execute(vm, h->now <= h->end);
+    if (h->now > h->end) {
+        h->end = h->now;
+    }
+    if (!more) {
+        h->last = h->now - 1;
+    }
+    return more;
+}
+
+void run(VM* vm) {
+    while (step(vm)) {
+    }
+}
+
+// Puts the VM where it was before step `target` ran, from 0 up to the
+// steps run so far. Within the interval logged, by undoing; otherwise
+// by replaying from the last checkpoint before
+void seek(VM* vm, int target) {
+    StateHistory* h = &vm->history;
+    if (target < 0 || target > h->end) {
+        snprintf(message, sizeof(message), "Invalid step: %d", target);
+        error(vm, message);
+    }
+    if (h->ncheckpoints == 0) {
+        return;
+    }
+    Checkpoint* c = checkpointBefore(vm, target);
+    if (target < h->start || (target > h->now && c->step > h->now)) {
+        restoreCheckpoint(vm, c);
+    }
+    if (target <= h->now) {
+        if (target < h->now) {
+            Step* s = &h->steps[target - h->start];
+            for (int w = h->nwrites - 1; w >= s->write; w--) {
+                *h->writes[w].at = h->writes[w].old;
+            }
+            h->nwrites = s->write;
+            h->nsteps = target - h->start;
+            vm->pc = s->pc;
+            h->now = target;
+        }
+    } else {
+        while (h->now < target && step(vm)) {
+        }
+    }
+}
+
+void stepBack(VM* vm) {
+    if (vm->history.now > 0) {
+        seek(vm, vm->history.now - 1);
+    }
+}
+
+void setBreakpoint(VM* vm, int addr) {
+    if (addr < 0 || addr >= vm->code_length) {
+        error(vm, "Breakpoint out of bounds");
+    }
+    vm->breakpoints[addr] = 1;
+}
+
+// --- questions to the index ---
+
+// The last step in the list before `before`, or -1
+int stepBefore(const StepList* list, int before) {
+    int lo = 0, hi = list->n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (list->steps[mid] < before) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
     }
+    return lo > 0 ? list->steps[lo - 1] : -1;
+}
+
+// The first step in the list at or after `from`, or -1
+int stepFrom(const StepList* list, int from) {
+    int lo = 0, hi = list->n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (list->steps[mid] < from) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < list->n ? list->steps[lo] : -1;
+}
+
+const StepList* localChanges(VM* vm, int depth, int index) {
+    if (depth < 0 || depth >= STACK_SIZE || index < 0 || index >= LOCALS_SIZE) {
+        error(vm, "Invalid local");
+    }
+    SlotIndex* s = vm->history.index.depths[depth];
+    return s ? &s->locals[index] : NULL;
+}
+
+const StepList* stackChanges(VM* vm, int depth, int slot) {
+    if (depth < 0 || depth >= STACK_SIZE || slot < 0 || slot >= STACK_SIZE) {
+        error(vm, "Invalid stack slot");
+    }
+    SlotIndex* s = vm->history.index.depths[depth];
+    return s ? &s->stack[slot] : NULL;
+}
+
+// The last step before `before` that changed local `index` of a frame at
+// `depth`, or -1: a watchpoint run backwards
+int lastLocalChange(VM* vm, int depth, int index, int before) {
+    const StepList* list = localChanges(vm, depth, index);
+    return list ? stepBefore(list, before) : -1;
+}
+
+int nextLocalChange(VM* vm, int depth, int index, int from) {
+    const StepList* list = localChanges(vm, depth, index);
+    return list ? stepFrom(list, from) : -1;
+}
+
+int lastStackChange(VM* vm, int depth, int slot, int before) {
+    const StepList* list = stackChanges(vm, depth, slot);
+    return list ? stepBefore(list, before) : -1;
+}
+
+// The last step before `before` that began at pc, or -1
+int lastAtPc(VM* vm, int pc, int before) {
+    if (pc < 0 || pc >= vm->code_length) {
+        error(vm, "Invalid pc");
+    }
+    return stepBefore(&vm->history.index.pcs[pc], before);
+}
+
+// The first step after which the sp of a frame at `depth` was above n,
+// or -1
+int firstSpAbove(VM* vm, int depth, int n) {
+    if (depth < 0 || depth >= STACK_SIZE) {
+        error(vm, "Invalid depth");
+    }
+    SlotIndex* s = vm->history.index.depths[depth];
+    if (s == NULL) {
+        return -1;
+    }
+    int lo = 0, hi = s->peaks.n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (s->peaks.sps[mid] <= n) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < s->peaks.n ? s->peaks.steps[lo] : -1;
+}
+
+// Back to the last step before this one that begins at a breakpoint:
+// the latest of each breakpoint's last step, from the index, and one
+// seek there. FALSE, and at step 0, if there is none
+int reverseContinue(VM* vm) {
+    StateHistory* h = &vm->history;
+    int found = -1;
+    for (int pc = 0; pc < vm->code_length; pc++) {
+        if (vm->breakpoints[pc]) {
+            int at = lastAtPc(vm, pc, h->now);
+            if (at > found) {
+                found = at;
+            }
+        }
+    }
+    seek(vm, found >= 0 ? found : 0);
+    return found >= 0;
+}
+
+// Whether the frame at depth is there, and its local
+int localAt(VM* vm, int depth, int index, int* value) {
+    if (depth > vm->fstack.fp) {
+        return FALSE;
+    }
+    *value = vm->fstack.frames[depth]->locals[index];
+    return TRUE;
+}
+
+// The step between lo and hi that changed local `index` of the frame at
+// `depth`, found by halving, so as git bisect it takes the local to
+// change once in between. A frame that is not there counts as a value.
+// Leaves the VM before that step; -1 if the local is the same at both
+int bisectLocal(VM* vm, int depth, int index, int lo, int hi) {
+    int v0 = 0, v = 0;
+    if (depth < 0 || depth >= STACK_SIZE || index < 0 || index >= LOCALS_SIZE) {
+        error(vm, "Invalid local");
+    }
+    seek(vm, lo);
+    int live0 = localAt(vm, depth, index, &v0);
+    seek(vm, hi);
+    int live = localAt(vm, depth, index, &v);
+    if (live == live0 && (!live || v == v0)) {
+        return -1;
+    }
+    while (hi - lo > 1) {
+        int mid = lo + (hi - lo) / 2;
+        seek(vm, mid);
+        live = localAt(vm, depth, index, &v);
+        if (live == live0 && (!live || v == v0)) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    seek(vm, lo);
+    return lo;
+}
+
+size_t historyBytes(VM* vm) {
+    StateHistory* h = &vm->history;
+    size_t bytes = sizeof(Write) * h->wcapacity + sizeof(Step) * h->scapacity;
+    for (int i = 0; i < h->ncheckpoints; i++) {
+        bytes += sizeof(Frame) * h->checkpoints[i].nframes;
+    }
+    return bytes;
+}
+
+size_t indexBytes(VM* vm) {
+    HistoryIndex* x = &vm->history.index;
+    size_t bytes = sizeof(StepList) * vm->code_length;
+    for (int i = 0; i < vm->code_length; i++) {
+        bytes += sizeof(int) * x->pcs[i].capacity;
+    }
+    for (int d = 0; d < STACK_SIZE; d++) {
+        SlotIndex* s = x->depths[d];
+        if (s == NULL) {
+            continue;
+        }
+        bytes += sizeof(SlotIndex) + 2 * sizeof(int) * s->peaks.capacity;
+        for (int i = 0; i < LOCALS_SIZE; i++) {
+            bytes += sizeof(int) * s->locals[i].capacity;
+        }
+        for (int i = 0; i < STACK_SIZE; i++) {
+            bytes += sizeof(int) * s->stack[i].capacity;
+        }
+    }
+    return bytes;
+}
+
+void printSnapshot(VM* vm, int step) {
+    Frame* frame = vm->fstack.frames[vm->fstack.fp];
+    printf("Snapshot %d: PC = %d, SP = %d, ReturnValue = %d\n",
+           step, vm->pc, frame->sp, frame->returnValue);
+    printf("Locals: ");
+    for (int j = 0; j < LOCALS_SIZE; j++) {
+        printf("%d ", frame->locals[j]);
+    }
+    printf("\nStack: ");
+    for (int j = 0; j <= frame->sp; j++) {
+        printf("%d ", frame->stack[j]);
+    }
+    printf("\n\n");
+}
+
+// A countdown, to see the history stay bounded over millions of steps
+void longRun(void) {
+    int n = 1000000;
+    int code[] = {
+        PUSH, n,                // counter = n
+        ST, 0,
+        LD, 0,                  // Address 4: while (counter > 0)
+        JZ, 19,
+        LD, 0,                  //     counter = counter - 1
+        PUSH, 1,
+        SUB,
+        ST, 0,
+        PUSH, 0,                //     and back
+        JZ, 4,
+        HALT                    // Address 19
+    };
+    VM* vm = newVM(code, sizeof(code) / sizeof(code[0]));
+    pushFrame(vm);
+    run(vm);
+
+    StateHistory* h = &vm->history;
+    int end = h->end;
+    clock_t t = clock();
+    int seeks = 100;
+    for (int i = 0; i < seeks; i++) {
+        seek(vm, (int) ((long) end * ((i * 37) % seeks) / seeks));
+    }
+    double ms = 1000.0 * (clock() - t) / CLOCKS_PER_SEC / seeks;
+    seek(vm, end / 2);
+    printf("\nCountdown from %d: %d steps, %d checkpoints every %d, %zu bytes;"
+           " a seek takes %.2f ms, counter at step %d is %d\n",
+           n, end, h->ncheckpoints, h->interval, historyBytes(vm), ms,
+           end / 2, vm->fstack.frames[0]->locals[0]);
+
+    // when the counter last changed before a step, and the loop last
+    // went round, from the index rather than by seeking back
+    int queries = 1000000;
+    volatile unsigned sum = 0;
+    t = clock();
+    for (int i = 0; i < queries; i++) {
+        int before = (int) ((long) end * ((i * 7919L) % queries) / queries);
+        sum += lastLocalChange(vm, 0, 0, before) + lastAtPc(vm, 4, before);
+    }
+    double us = 1e6 * (clock() - t) / CLOCKS_PER_SEC / queries / 2;
+    int changed = lastLocalChange(vm, 0, 0, end / 2);
+    seek(vm, changed);
+    int was = vm->fstack.frames[0]->locals[0];
+    seek(vm, changed + 1);
+    printf("Index: %zu bytes; a query takes %.3f us; the counter before step %d"
+           " last changed at step %d, from %d to %d\n",
+           indexBytes(vm), us, end / 2, changed, was, vm->fstack.frames[0]->locals[0]);
+    freeVM(vm);
 }
 
 int main() {
@@ -317,23 +907,50 @@ int main() {
     pushFrame(vm);  // initial frame for main function
     run(vm);
 
-    // Time Travel Debugging: display snapshots of states after execution
+    // Time Travel Debugging: display the state before each step, from
+    // the start again
+    StateHistory* h = &vm->history;
+    int end = h->end;
     printf("\nSnapshots taken during execution:\n");
-    for (int i = 0; i < vm->history.size; i++) {
-        State* state = &vm->history.states[i];
-        printf("Snapshot %d: PC = %d, SP = %d, ReturnValue = %d\n",
-               i, state->pc, state->sp, vm->fstack.frames[vm->fstack.fp]->returnValue);
-        printf("Locals: ");
-        for (int j = 0; j < LOCALS_SIZE; j++) {
-            printf("%d ", state->locals[j]);
-        }
-        printf("\nStack: ");
-        for (int j = 0; j <= state->sp; j++) {
-            printf("%d ", state->stack[j]);
-        }
-        printf("\n\n");
+    for (int i = 0; i < end; i++) {
+        seek(vm, i);
+        printSnapshot(vm, i);
     }
 
+    // back from the end, to each call of factorial
+    seek(vm, end);
+    stepBack(vm);
+    printf("Step back from the end: step %d, PC = %d\n", h->now, vm->pc);
+    setBreakpoint(vm, 8);
+    while (reverseContinue(vm)) {
+        printf("Reverse-continue to PC 8: step %d, n = %d\n",
+               h->now, vm->fstack.frames[vm->fstack.fp]->locals[0]);
+    }
+
+    // which step set n in the deepest call, factorial(1)
+    int deepest = 0, at = 0;
+    for (int i = 0; i < end; i++) {
+        seek(vm, i);
+        if (vm->fstack.fp > deepest) {
+            deepest = vm->fstack.fp;
+            at = i;
+        }
+    }
+    int changed = bisectLocal(vm, deepest, 0, 0, at);
+    printf("Local 0 of frame %d first set by step %d, PC = %d\n", deepest, changed, vm->pc);
+    seek(vm, changed + 1);
+    printSnapshot(vm, changed + 1);
+
+    // the same from the index, with no seeking; and the first step that
+    // left two values on the stack of factorial(5)
+    printf("Index: local 0 of frame %d last changed before step %d at step %d;"
+           " frame 1 first held two values after step %d\n",
+           deepest, at, lastLocalChange(vm, deepest, 0, at), firstSpAbove(vm, 1, 0));
+
+    printf("History: %d steps, %d checkpoints every %d, %zu bytes\n",
+           end, h->ncheckpoints, h->interval, historyBytes(vm));
     freeVM(vm);
+
+    longRun();
     return 0;
 }
@@ -0,0 +1,193 @@
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "bench.h"
+
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+void bench_config_default(bench_config_t *config) {
+    config->samples = 20;
+    config->min_sample = 0.01;
+    config->cpu = -1;
+    config->counters = 0;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double sample(void (*fn)(void *), void *arg, long calls) {
+    double start = now();
+    for (long i = 0; i < calls; i++) {
+        fn(arg);
+    }
+    return now() - start;
+}
+
+static int by_value(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// two-sided 95% quantile of Student's t, by degrees of freedom
+static double t95(int df) {
+    static const double t[] = {
+        0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+        2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093,
+        2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (df < 1) {
+        return 0;
+    }
+    return df <= 30 ? t[df] : 1.96;
+}
+
+#ifdef __linux__
+// One group, led by the cycle counter, so they all count the same time
+static int open_counters(int fds[BENCH_COUNTERS]) {
+    static const unsigned long long events[BENCH_COUNTERS] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+    };
+    for (int i = 0; i < BENCH_COUNTERS; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = events[i];
+        attr.disabled = i == 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds[0], 0);
+        if (fds[i] < 0) {
+            for (int j = 0; j < i; j++) {
+                close(fds[j]);
+            }
+            return -1;
+        }
+    }
+    return 0;
+}
+#endif
+
+bench_result_t bench_run(const bench_config_t *config, const char *name,
+                         void (*fn)(void *), void *arg) {
+    bench_result_t r;
+    memset(&r, 0, sizeof(r));
+    r.name = name;
+    r.samples = config->samples > 1 ? config->samples : 2;
+    for (int i = 0; i < BENCH_COUNTERS; i++) {
+        r.counters[i] = -1;
+    }
+
+#ifdef __linux__
+    if (config->cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(config->cpu, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+            fprintf(stderr, "Cannot pin to CPU %d\n", config->cpu);
+        }
+    }
+#endif
+
+    // double the calls until a sample is long enough; that also warms up
+    long calls = 1;
+    while (sample(fn, arg, calls) < config->min_sample && calls < (1L << 40)) {
+        calls *= 2;
+    }
+    r.calls = calls;
+
+#ifdef __linux__
+    int fds[BENCH_COUNTERS];
+    int counting = config->counters && open_counters(fds) == 0;
+    if (config->counters && !counting) {
+        fprintf(stderr, "No perf counters for %s\n", name);
+    }
+    if (counting) {
+        ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+
+    double *t = malloc(sizeof(double) * r.samples);
+    if (!t) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    for (int i = 0; i < r.samples; i++) {
+        t[i] = sample(fn, arg, calls) / calls;
+    }
+
+#ifdef __linux__
+    if (counting) {
+        ioctl(fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        unsigned long long values[1 + BENCH_COUNTERS];
+        if (read(fds[0], values, sizeof(values)) == (ssize_t)sizeof(values)) {
+            for (int i = 0; i < BENCH_COUNTERS; i++) {
+                r.counters[i] = (double)values[1 + i] / ((double)calls * r.samples);
+            }
+        }
+        for (int i = 0; i < BENCH_COUNTERS; i++) {
+            close(fds[i]);
+        }
+    }
+#endif
+
+    double sum = 0, sq = 0;
+    for (int i = 0; i < r.samples; i++) {
+        sum += t[i];
+    }
+    r.mean = sum / r.samples;
+    for (int i = 0; i < r.samples; i++) {
+        sq += (t[i] - r.mean) * (t[i] - r.mean);
+    }
+    r.ci95 = t95(r.samples - 1) * sqrt(sq / (r.samples - 1)) / sqrt(r.samples);
+    qsort(t, r.samples, sizeof(double), by_value);
+    r.median = r.samples % 2 ? t[r.samples / 2]
+                             : (t[r.samples / 2 - 1] + t[r.samples / 2]) / 2;
+    r.fastest = t[0];
+    free(t);
+    return r;
+}
+
+// times in the unit that suits them
+static void print_time(double s) {
+    if (s >= 1e-3) {
+        printf("%8.3f ms", s * 1e3);
+    } else if (s >= 1e-6) {
+        printf("%8.3f us", s * 1e6);
+    } else {
+        printf("%8.3f ns", s * 1e9);
+    }
+}
+
+void bench_print(const bench_result_t *r) {
+    printf("%-16s", r->name);
+    print_time(r->mean);
+    printf(" +- %4.1f%%  median", r->mean > 0 ? 100 * r->ci95 / r->mean : 0.0);
+    print_time(r->median);
+    printf("  fastest");
+    print_time(r->fastest);
+    printf("  (%d x %ld calls)\n", r->samples, r->calls);
+    if (r->counters[0] >= 0) {
+        printf("%16s %.0f cycles, %.0f instructions (IPC %.2f), "
+               "%.0f cache misses, %.0f branch misses per call\n", "",
+               r->counters[0], r->counters[1],
+               r->counters[0] > 0 ? r->counters[1] / r->counters[0] : 0.0,
+               r->counters[2], r->counters[3]);
+    }
+}
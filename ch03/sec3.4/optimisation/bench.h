@@ -0,0 +1,48 @@
+/*
+ * A small benchmark harness
+ *
+ * bench_run() calibrates how many calls make a sample long enough to
+ * time, then takes several samples and reports the time per call as a
+ * mean with a 95% confidence interval, the median, and the fastest.
+ * Optionally it pins the process to one CPU first, and counts cycles,
+ * instructions, cache misses and branch misses with Linux perf events.
+ *
+ * The function under test should hand its results to bench_escape() or
+ * bench_do_not_optimize(), so that the compiler cannot drop the work as
+ * dead code.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+// The value is needed, as far as the compiler knows
+#define bench_do_not_optimize(x) __asm__ volatile("" : : "r,m"(x) : "memory")
+
+// Memory p points to may be read or written, as far as the compiler knows
+static inline void bench_escape(void *p) {
+    __asm__ volatile("" : : "g"(p) : "memory");
+}
+
+typedef struct {
+    int samples;            // after calibration, default 20
+    double min_sample;      // seconds a sample should take, default 0.01
+    int cpu;                // CPU to pin to, -1 for none
+    int counters;           // read perf events too
+} bench_config_t;
+
+#define BENCH_COUNTERS 4    // cycles, instructions, cache misses, branch misses
+
+typedef struct {
+    const char *name;
+    long calls;             // in each sample
+    int samples;
+    double mean, ci95, median, fastest;     // seconds per call
+    double counters[BENCH_COUNTERS];        // per call, < 0 when not read
+} bench_result_t;
+
+void bench_config_default(bench_config_t *config);
+bench_result_t bench_run(const bench_config_t *config, const char *name,
+                         void (*fn)(void *), void *arg);
+void bench_print(const bench_result_t *result);
+
+#endif // BENCH_H
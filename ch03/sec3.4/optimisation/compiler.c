@@ -2,12 +2,16 @@
  * Compiler Optimisation Examples
  * 
  * Compile with different optimisation levels:
- * gcc -O0 compiler_opt.c -o prog_O0  (No optimisation)
- * gcc -O1 compiler_opt.c -o prog_O1  (Basic optimisation)
- * gcc -O2 compiler_opt.c -o prog_O2  (Recommended level)
- * gcc -O3 compiler_opt.c -o prog_O3  (Aggressive optimisation)
- * gcc -Os compiler_opt.c -o prog_Os  (Optimise for size)
- * gcc -Ofast compiler_opt.c -o prog_Ofast (Fastest, may break standards)
+ * gcc -O0 compiler.c bench.c simd.c -lm -o prog_O0  (No optimisation)
+ * gcc -O1 compiler.c bench.c simd.c -lm -o prog_O1  (Basic optimisation)
+ * gcc -O2 compiler.c bench.c simd.c -lm -o prog_O2  (Recommended level)
+ * gcc -O3 compiler.c bench.c simd.c -lm -o prog_O3  (Aggressive optimisation)
+ * gcc -Os compiler.c bench.c simd.c -lm -o prog_Os  (Optimise for size)
+ * gcc -Ofast compiler.c bench.c simd.c -lm -o prog_Ofast (Fastest, may break standards)
+ *
+ * ./prog_O2 [-p cpu] [-e]
+ *   -p  pin to one CPU while timing
+ *   -e  also count cycles, instructions and misses (Linux perf events)
  * 
  * Additional useful flags:
  * -march=native    : Optimise for current CPU architecture
@@ -21,6 +25,9 @@
 #include <stdlib.h>
 #include <time.h>
 #include <string.h>
+#include <unistd.h>
+#include "bench.h"
+#include "simd.h"
 
 // Example 1: Loop optimisation
 void loop_example(int *arr, int size) {
@@ -119,21 +126,60 @@ void simd_friendly_operation(AlignedArray *arr) {
     }
 }
 
-// Benchmark function
-double benchmark(void (*func)(int*, int), int *arr, int size, const char *name) {
-    clock_t start = clock();
-    
-    for (int iter = 0; iter < 1000; iter++) {
-        func(arr, size);
-    }
-    
-    clock_t end = clock();
-    double time_taken = (double)(end - start) / CLOCKS_PER_SEC;
-    printf("%s: %.6f seconds\n", name, time_taken);
-    return time_taken;
+// Benchmarks: each call does the example once, and lets its results
+// escape so none of the work is dead code
+
+typedef struct {
+    int *a, *b;
+    int size;
+    AlignedArray *aligned;
+} BenchData;
+
+void bench_auto_loop(void *arg) {
+    BenchData *d = arg;
+    loop_unroll_example(d->a, d->size);
+    bench_escape(d->a);
+}
+
+void bench_manual_unroll(void *arg) {
+    BenchData *d = arg;
+    loop_unroll_manual(d->a, d->size);
+    bench_escape(d->a);
+}
+
+void bench_restrict(void *arg) {
+    BenchData *d = arg;
+    pointer_aliasing(d->a, d->b, d->size);
+    bench_escape(d->a);
 }
 
-int main() {
+void bench_simd(void *arg) {
+    BenchData *d = arg;
+    simd_friendly_operation(d->aligned);
+    bench_escape(d->aligned);
+}
+
+// the same, through the kernel picked for this CPU
+void bench_simd_kernel(void *arg) {
+    BenchData *d = arg;
+    simd_best()->scale(d->aligned->data, d->aligned->data, 2.0f, 1000);
+    bench_escape(d->aligned);
+}
+
+int main(int argc, char **argv) {
+    bench_config_t config;
+    bench_config_default(&config);
+    int opt;
+    while ((opt = getopt(argc, argv, "p:e")) != -1) {
+        switch (opt) {
+            case 'p': config.cpu = atoi(optarg); break;
+            case 'e': config.counters = 1; break;
+            default:
+                fprintf(stderr, "usage: %s [-p cpu] [-e]\n", argv[0]);
+                return 1;
+        }
+    }
+
     printf("-- Compiler Optimisation Examples --\n\n");
     
     printf("Compile this program with different optimisation levels:\n");
@@ -144,16 +190,30 @@ int main() {
     
     const int size = 1000000;
     int *arr = (int*)malloc(size * sizeof(int));
+    int *src = (int*)malloc(size * sizeof(int));
+    AlignedArray *aligned = malloc(sizeof(AlignedArray));
     
-    // Init array
+    // Init arrays
     for (int i = 0; i < size; i++) {
         arr[i] = i;
+        src[i] = size - i;
+    }
+    for (int i = 0; i < 1000; i++) {
+        aligned->data[i] = 1.0f;
     }
+    BenchData data = { arr, src, size, aligned };
     
-    printf("Running benchmarks (1000 iterations each)..\n\n");
+    printf("Running benchmarks (%d samples each, after calibration)..\n\n", config.samples);
     
-    double time1 = benchmark(loop_unroll_example, arr, size, "Auto loop");
-    double time2 = benchmark(loop_unroll_manual, arr, size, "Manual unroll");
+    bench_result_t results[5];
+    results[0] = bench_run(&config, "Auto loop", bench_auto_loop, &data);
+    results[1] = bench_run(&config, "Manual unroll", bench_manual_unroll, &data);
+    results[2] = bench_run(&config, "restrict", bench_restrict, &data);
+    results[3] = bench_run(&config, "Aligned SIMD", bench_simd, &data);
+    results[4] = bench_run(&config, simd_best()->name, bench_simd_kernel, &data);
+    for (int i = 0; i < 5; i++) {
+        bench_print(&results[i]);
+    }
     
     printf("\nAt -O0: Manual unrolling is faster\n");
     printf("At -O2/-O3: Compiler does it automatically\n\n");
@@ -182,5 +242,7 @@ int main() {
     printf("-fprofile-generate/-fprofile-use: Profile-guided optimisation\n");
     
     free(arr);
+    free(src);
+    free(aligned);
     return 0;
 }
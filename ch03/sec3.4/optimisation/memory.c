@@ -2,46 +2,205 @@
 #include <stdlib.h>
 #include <time.h>
 #include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "bench.h"
 
-#define ROWS 1000
-#define COLS 1000
+// A matrix of rows x cols ints, row after row
+typedef struct {
+    const int *m;
+    int rows, cols;
+} Matrix;
 
 // Row-major traversal (cache-friendly)
-void sum_row_major(int matrix[ROWS][COLS], long long *result) {
+void sum_row_major(const Matrix *a, long long *result) {
     *result = 0;
-    for (int i = 0; i < ROWS; i++) {
-        for (int j = 0; j < COLS; j++) {
-            *result += matrix[i][j];
+    for (int i = 0; i < a->rows; i++) {
+        for (int j = 0; j < a->cols; j++) {
+            *result += a->m[(size_t)i * a->cols + j];
         }
     }
 }
 
 // Column-major traversal (cache-unfriendly)
-void sum_col_major(int matrix[ROWS][COLS], long long *result) {
+void sum_col_major(const Matrix *a, long long *result) {
     *result = 0;
-    for (int j = 0; j < COLS; j++) {
-        for (int i = 0; i < ROWS; i++) {
-            *result += matrix[i][j];
+    for (int j = 0; j < a->cols; j++) {
+        for (int i = 0; i < a->rows; i++) {
+            *result += a->m[(size_t)i * a->cols + j];
         }
     }
 }
 
-// Blocked/tiled traversal (optimised for cache)
-void sum_blocked(int matrix[ROWS][COLS], long long *result) {
+// Blocked/tiled traversal (optimised for cache), block x block at a time
+void sum_blocked(const Matrix *a, int block, long long *result) {
     *result = 0;
-    const int BLOCK_SIZE = 64;
-    
-    for (int ii = 0; ii < ROWS; ii += BLOCK_SIZE) {
-        for (int jj = 0; jj < COLS; jj += BLOCK_SIZE) {
-            for (int i = ii; i < ii + BLOCK_SIZE && i < ROWS; i++) {
-                for (int j = jj; j < jj + BLOCK_SIZE && j < COLS; j++) {
-                    *result += matrix[i][j];
+    for (int ii = 0; ii < a->rows; ii += block) {
+        for (int jj = 0; jj < a->cols; jj += block) {
+            for (int i = ii; i < ii + block && i < a->rows; i++) {
+                for (int j = jj; j < jj + block && j < a->cols; j++) {
+                    *result += a->m[(size_t)i * a->cols + j];
                 }
             }
         }
     }
 }
 
+// Cache sizes in bytes, from sysconf where glibc knows them
+long cache_size(int level) {
+    long size = -1;
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+    switch (level) {
+        case 1: size = sysconf(_SC_LEVEL1_DCACHE_SIZE); break;
+        case 2: size = sysconf(_SC_LEVEL2_CACHE_SIZE); break;
+        case 3: size = sysconf(_SC_LEVEL3_CACHE_SIZE); break;
+    }
+#endif
+    if (size <= 0) {
+        static const long guess[] = { 0, 32 << 10, 256 << 10, 8 << 20 };
+        size = guess[level];
+    }
+    return size;
+}
+
+double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// The block size that is fastest here, found on first use: powers of two
+// whose tile fits in L2, each timed three times on a matrix of twice the
+// last-level cache (at most 64 MB), keeping the best time of each
+int tuned_block_size(void) {
+    static int best = 0;
+    if (best) {
+        return best;
+    }
+    int n = 256;
+    while ((long)n * n * sizeof(int) < 2 * cache_size(3) && n < 4096) {
+        n *= 2;
+    }
+    int *m = malloc((size_t)n * n * sizeof(int));
+    for (size_t i = 0; i < (size_t)n * n; i++) {
+        m[i] = (int)(i % 100);
+    }
+    Matrix a = { m, n, n };
+    double best_time = 0;
+    for (int block = 8; block <= n && (long)block * block * sizeof(int) <= cache_size(2); block *= 2) {
+        double fastest = 0;
+        for (int k = 0; k < 3; k++) {
+            long long result;
+            double start = now();
+            sum_blocked(&a, block, &result);
+            bench_do_not_optimize(result);
+            double t = now() - start;
+            if (k == 0 || t < fastest) {
+                fastest = t;
+            }
+        }
+        if (best == 0 || fastest < best_time) {
+            best = block;
+            best_time = fastest;
+        }
+    }
+    free(m);
+    return best;
+}
+
+// Cache-oblivious traversal: halve the longer side until the piece is
+// small, so that at some depth each piece fits whatever cache there is
+static long long sum_recursive_part(const Matrix *a, int i0, int j0, int rows, int cols) {
+    if (rows * cols <= 256) {
+        long long s = 0;
+        for (int i = i0; i < i0 + rows; i++) {
+            for (int j = j0; j < j0 + cols; j++) {
+                s += a->m[(size_t)i * a->cols + j];
+            }
+        }
+        return s;
+    }
+    if (rows >= cols) {
+        int half = rows / 2;
+        return sum_recursive_part(a, i0, j0, half, cols)
+             + sum_recursive_part(a, i0 + half, j0, rows - half, cols);
+    }
+    int half = cols / 2;
+    return sum_recursive_part(a, i0, j0, rows, half)
+         + sum_recursive_part(a, i0, j0 + half, rows, cols - half);
+}
+
+void sum_recursive(const Matrix *a, long long *result) {
+    *result = sum_recursive_part(a, 0, 0, a->rows, a->cols);
+}
+
+// Row bands, one per thread, each summed row-major
+#define MAX_THREADS 16
+
+typedef struct {
+    const Matrix *a;
+    int first, last;    // rows [first, last)
+    long long sum;
+} Band;
+
+static void *sum_band(void *arg) {
+    Band *b = arg;
+    long long s = 0;
+    for (int i = b->first; i < b->last; i++) {
+        for (int j = 0; j < b->a->cols; j++) {
+            s += b->a->m[(size_t)i * b->a->cols + j];
+        }
+    }
+    b->sum = s;
+    return NULL;
+}
+
+int thread_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n < 1 ? 1 : n > MAX_THREADS ? MAX_THREADS : (int)n;
+}
+
+void sum_threaded(const Matrix *a, long long *result) {
+    int threads = thread_count();
+    pthread_t tid[MAX_THREADS];
+    Band bands[MAX_THREADS];
+    for (int t = 0; t < threads; t++) {
+        bands[t].a = a;
+        bands[t].first = (int)((long)a->rows * t / threads);
+        bands[t].last = (int)((long)a->rows * (t + 1) / threads);
+        pthread_create(&tid[t], NULL, sum_band, &bands[t]);
+    }
+    *result = 0;
+    for (int t = 0; t < threads; t++) {
+        pthread_join(tid[t], NULL);
+        *result += bands[t].sum;
+    }
+}
+
+typedef struct {
+    const Matrix *a;
+    int variant;
+    int block;
+    long long result;
+} Run;
+
+enum { ROW_MAJOR, COL_MAJOR, BLOCKED, RECURSIVE, THREADED, VARIANTS };
+static const char *variant_names[VARIANTS] = {
+    "row-major", "column-major", "blocked", "recursive", "threaded"
+};
+
+static void run_variant(void *arg) {
+    Run *r = arg;
+    switch (r->variant) {
+        case ROW_MAJOR: sum_row_major(r->a, &r->result); break;
+        case COL_MAJOR: sum_col_major(r->a, &r->result); break;
+        case BLOCKED:   sum_blocked(r->a, r->block, &r->result); break;
+        case RECURSIVE: sum_recursive(r->a, &r->result); break;
+        case THREADED:  sum_threaded(r->a, &r->result); break;
+    }
+    bench_do_not_optimize(r->result);
+}
+
 // Memory alignment example
 typedef struct {
     char a;      // 1 byte
@@ -56,40 +215,45 @@ typedef struct {
 } AlignedStruct;    // Typically 8 bytes - better memory usage
 
 int main() {
-    int (*matrix)[COLS] = malloc(sizeof(int[ROWS][COLS]));
-    
-    // Initialize matrix
-    for (int i = 0; i < ROWS; i++) {
-        for (int j = 0; j < COLS; j++) {
-            matrix[i][j] = (i + j) % 100;
-        }
-    }
-
-    long long result;
-    clock_t start, end;
-
     printf("-- Memory Access Pattern Optimisation --\n\n");
+    printf("Caches: L1 %ld KB, L2 %ld KB, L3 %ld KB; %d threads\n",
+           cache_size(1) >> 10, cache_size(2) >> 10, cache_size(3) >> 10, thread_count());
+    int block = tuned_block_size();
+    printf("Tuned block size: %d x %d\n\n", block, block);
+
+    bench_config_t config;
+    bench_config_default(&config);
+    config.samples = 5;
 
-    // Row-major (cache-friendly)
-    start = clock();
-    sum_row_major(matrix, &result);
-    end = clock();
-    printf("Row-major (cache-friendly): %lld\n", result);
-    printf("Time: %.6f seconds\n\n", (double)(end - start) / CLOCKS_PER_SEC);
-
-    // Column-major (cache-unfriendly)
-    start = clock();
-    sum_col_major(matrix, &result);
-    end = clock();
-    printf("Column-major (cache-unfriendly): %lld\n", result);
-    printf("Time: %.6f seconds\n\n", (double)(end - start) / CLOCKS_PER_SEC);
-
-    // Blocked (optimised)
-    start = clock();
-    sum_blocked(matrix, &result);
-    end = clock();
-    printf("Blocked/tiled (optimised): %lld\n", result);
-    printf("Time: %.6f seconds\n\n", (double)(end - start) / CLOCKS_PER_SEC);
+    // from fitting in L1 to far beyond the last-level cache
+    static const int sizes[] = { 64, 256, 1024, 4096 };
+    printf("%6s %8s  %-13s %12s %8s\n", "n", "size", "traversal", "median", "vs rows");
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+        int n = sizes[k];
+        int *m = malloc((size_t)n * n * sizeof(int));
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                m[(size_t)i * n + j] = (i + j) % 100;
+            }
+        }
+        Matrix a = { m, n, n };
+        double row_time = 0;
+        long long expected = 0;
+        for (int v = 0; v < VARIANTS; v++) {
+            Run r = { &a, v, block, 0 };
+            bench_result_t b = bench_run(&config, variant_names[v], run_variant, &r);
+            if (v == ROW_MAJOR) {
+                row_time = b.median;
+                expected = r.result;
+            }
+            printf("%6d %6ld KB  %-13s %9.3f ms %7.2fx%s\n", n,
+                   (long)((size_t)n * n * sizeof(int) >> 10), variant_names[v],
+                   b.median * 1e3, row_time / b.median,
+                   r.result == expected ? "" : "  WRONG SUM");
+        }
+        printf("\n");
+        free(m);
+    }
 
     printf("Memory alignment impact:\n");
     printf("UnalignedStruct size: %zu bytes\n", sizeof(UnalignedStruct));
@@ -97,6 +261,5 @@ int main() {
     printf("Memory saved per struct: %zu bytes\n", 
            sizeof(UnalignedStruct) - sizeof(AlignedStruct));
 
-    free(matrix);
     return 0;
 }
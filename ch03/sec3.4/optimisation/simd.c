@@ -0,0 +1,379 @@
+#include "simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86 1
+#endif
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#define HAVE_NEON 1
+#endif
+
+static bool always(void) {
+    return true;
+}
+
+// Plain C: the reference the others are tested against, and their tails
+
+static void add_scalar(float *dst, const float *a, const float *b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = a[i] + b[i];
+    }
+}
+
+static void scale_scalar(float *dst, const float *a, float k, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = a[i] * k;
+    }
+}
+
+static void fma_scalar(float *dst, const float *a, const float *b, const float *c, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = a[i] * b[i] + c[i];
+    }
+}
+
+static float sum_scalar(const float *a, size_t n) {
+    float s = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        s += a[i];
+    }
+    return s;
+}
+
+static void minmax_scalar(const float *a, size_t n, float *min, float *max) {
+    float lo = a[0], hi = a[0];
+    for (size_t i = 1; i < n; i++) {
+        lo = a[i] < lo ? a[i] : lo;
+        hi = a[i] > hi ? a[i] : hi;
+    }
+    *min = lo;
+    *max = hi;
+}
+
+static void pack565_scalar(uint16_t *dst, const uint8_t *rgb, size_t n) {
+    for (size_t i = 0; i < n; i++, rgb += 3) {
+        dst[i] = (uint16_t)(((rgb[0] & 0xF8) << 8) | ((rgb[1] & 0xFC) << 3) | (rgb[2] >> 3));
+    }
+}
+
+static void unpack565_scalar(uint8_t *rgb, const uint16_t *src, size_t n) {
+    for (size_t i = 0; i < n; i++, rgb += 3) {
+        unsigned r = (src[i] >> 11) & 0x1F, g = (src[i] >> 5) & 0x3F, b = src[i] & 0x1F;
+        rgb[0] = (uint8_t)(r << 3 | r >> 2);
+        rgb[1] = (uint8_t)(g << 2 | g >> 4);
+        rgb[2] = (uint8_t)(b << 3 | b >> 2);
+    }
+}
+
+#ifdef HAVE_X86
+
+// SSE2 is in every x86-64. It has no byte shuffle, so RGB565 stays
+// scalar here.
+
+static void add_sse2(float *dst, const float *a, const float *b, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    add_scalar(dst + i, a + i, b + i, n - i);
+}
+
+static void scale_sse2(float *dst, const float *a, float k, size_t n) {
+    const __m128 kk = _mm_set1_ps(k);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(a + i), kk));
+    }
+    scale_scalar(dst + i, a + i, k, n - i);
+}
+
+// a multiply and an add, rounded twice as in plain C
+static void fma_sse2(float *dst, const float *a, const float *b, const float *c, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 ab = _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+        _mm_storeu_ps(dst + i, _mm_add_ps(ab, _mm_loadu_ps(c + i)));
+    }
+    fma_scalar(dst + i, a + i, b + i, c + i, n - i);
+}
+
+// four partial sums, so the result is rounded differently from plain C
+static float sum_sse2(const float *a, size_t n) {
+    __m128 s = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s = _mm_add_ps(s, _mm_loadu_ps(a + i));
+    }
+    float part[4];
+    _mm_storeu_ps(part, s);
+    return (part[0] + part[1]) + (part[2] + part[3]) + sum_scalar(a + i, n - i);
+}
+
+static void minmax_sse2(const float *a, size_t n, float *min, float *max) {
+    if (n < 4) {
+        minmax_scalar(a, n, min, max);
+        return;
+    }
+    __m128 lo = _mm_loadu_ps(a), hi = lo;
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(a + i);
+        lo = _mm_min_ps(lo, v);
+        hi = _mm_max_ps(hi, v);
+    }
+    float l[4], h[4];
+    _mm_storeu_ps(l, lo);
+    _mm_storeu_ps(h, hi);
+    minmax_scalar(l, 4, min, max);
+    float unused;
+    minmax_scalar(h, 4, &unused, max);
+    for (; i < n; i++) {
+        *min = a[i] < *min ? a[i] : *min;
+        *max = a[i] > *max ? a[i] : *max;
+    }
+}
+
+// AVX2 and FMA only where the CPU has them: these are built for them one
+// function at a time, and picked at run time
+
+static bool avx2_supported(void) {
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+
+__attribute__((target("avx2,fma")))
+static void add_avx2(float *dst, const float *a, const float *b, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+    add_scalar(dst + i, a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2,fma")))
+static void scale_avx2(float *dst, const float *a, float k, size_t n) {
+    const __m256 kk = _mm256_set1_ps(k);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), kk));
+    }
+    scale_scalar(dst + i, a + i, k, n - i);
+}
+
+// fused, rounded once, so it can differ from plain C in the last bit
+__attribute__((target("avx2,fma")))
+static void fma_avx2(float *dst, const float *a, const float *b, const float *c, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_fmadd_ps(_mm256_loadu_ps(a + i),
+                                                  _mm256_loadu_ps(b + i),
+                                                  _mm256_loadu_ps(c + i)));
+    }
+    fma_scalar(dst + i, a + i, b + i, c + i, n - i);
+}
+
+__attribute__((target("avx2,fma")))
+static float sum_avx2(const float *a, size_t n) {
+    __m256 s = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        s = _mm256_add_ps(s, _mm256_loadu_ps(a + i));
+    }
+    __m128 q = _mm_add_ps(_mm256_castps256_ps128(s), _mm256_extractf128_ps(s, 1));
+    float part[4];
+    _mm_storeu_ps(part, q);
+    return (part[0] + part[1]) + (part[2] + part[3]) + sum_scalar(a + i, n - i);
+}
+
+__attribute__((target("avx2,fma")))
+static void minmax_avx2(const float *a, size_t n, float *min, float *max) {
+    if (n < 8) {
+        minmax_scalar(a, n, min, max);
+        return;
+    }
+    __m256 lo = _mm256_loadu_ps(a), hi = lo;
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(a + i);
+        lo = _mm256_min_ps(lo, v);
+        hi = _mm256_max_ps(hi, v);
+    }
+    float l[8], h[8];
+    _mm256_storeu_ps(l, lo);
+    _mm256_storeu_ps(h, hi);
+    float unused;
+    minmax_scalar(l, 8, min, &unused);
+    minmax_scalar(h, 8, &unused, max);
+    for (; i < n; i++) {
+        *min = a[i] < *min ? a[i] : *min;
+        *max = a[i] > *max ? a[i] : *max;
+    }
+}
+
+// Eight pixels at a time, each spread to a 32-bit lane as r, g, b, 0.
+// The second load reads 4 bytes past the eighth pixel, so the loop stops
+// two pixels short of the end.
+__attribute__((target("avx2,fma")))
+static void pack565_avx2(uint16_t *dst, const uint8_t *rgb, size_t n) {
+    const __m128i spread = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    size_t i = 0;
+    for (; i + 10 <= n; i += 8) {
+        __m128i lo = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(rgb + 3 * i)), spread);
+        __m128i hi = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(rgb + 3 * i + 12)), spread);
+        __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        __m256i r = _mm256_slli_epi32(_mm256_and_si256(v, _mm256_set1_epi32(0xF8)), 8);
+        __m256i g = _mm256_and_si256(_mm256_srli_epi32(v, 5), _mm256_set1_epi32(0x7E0));
+        __m256i b = _mm256_and_si256(_mm256_srli_epi32(v, 19), _mm256_set1_epi32(0x1F));
+        __m256i p = _mm256_or_si256(r, _mm256_or_si256(g, b));
+        // 32 to 16 bits within each half, then the two halves together
+        p = _mm256_permute4x64_epi64(_mm256_packus_epi32(p, p), 0x08);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm256_castsi256_si128(p));
+    }
+    pack565_scalar(dst + i, rgb + 3 * i, n - i);
+}
+
+// The reverse: each half's four pixels squeezed to 12 bytes and stored as
+// 16, the next store writing over the 4 extra
+__attribute__((target("avx2,fma")))
+static void unpack565_avx2(uint8_t *rgb, const uint16_t *src, size_t n) {
+    const __m256i squeeze = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                             0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    size_t i = 0;
+    for (; i + 10 <= n; i += 8) {
+        __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(src + i)));
+        __m256i r = _mm256_and_si256(_mm256_srli_epi32(v, 11), _mm256_set1_epi32(0x1F));
+        __m256i g = _mm256_and_si256(_mm256_srli_epi32(v, 5), _mm256_set1_epi32(0x3F));
+        __m256i b = _mm256_and_si256(v, _mm256_set1_epi32(0x1F));
+        r = _mm256_or_si256(_mm256_slli_epi32(r, 3), _mm256_srli_epi32(r, 2));
+        g = _mm256_or_si256(_mm256_slli_epi32(g, 2), _mm256_srli_epi32(g, 4));
+        b = _mm256_or_si256(_mm256_slli_epi32(b, 3), _mm256_srli_epi32(b, 2));
+        __m256i p = _mm256_or_si256(r, _mm256_or_si256(_mm256_slli_epi32(g, 8),
+                                                        _mm256_slli_epi32(b, 16)));
+        p = _mm256_shuffle_epi8(p, squeeze);
+        _mm_storeu_si128((__m128i *)(rgb + 3 * i), _mm256_castsi256_si128(p));
+        _mm_storeu_si128((__m128i *)(rgb + 3 * i + 12), _mm256_extracti128_si256(p, 1));
+    }
+    unpack565_scalar(rgb + 3 * i, src + i, n - i);
+}
+
+#endif // HAVE_X86
+
+#ifdef HAVE_NEON
+
+// Every AArch64 has NEON, and vld3/vst3 split and join the r, g, b bytes
+
+static void add_neon(float *dst, const float *a, const float *b, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(dst + i, vaddq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+    }
+    add_scalar(dst + i, a + i, b + i, n - i);
+}
+
+static void scale_neon(float *dst, const float *a, float k, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(dst + i, vmulq_n_f32(vld1q_f32(a + i), k));
+    }
+    scale_scalar(dst + i, a + i, k, n - i);
+}
+
+// fused, as on AVX2
+static void fma_neon(float *dst, const float *a, const float *b, const float *c, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(dst + i, vfmaq_f32(vld1q_f32(c + i), vld1q_f32(a + i), vld1q_f32(b + i)));
+    }
+    fma_scalar(dst + i, a + i, b + i, c + i, n - i);
+}
+
+static float sum_neon(const float *a, size_t n) {
+    float32x4_t s = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s = vaddq_f32(s, vld1q_f32(a + i));
+    }
+    return vaddvq_f32(s) + sum_scalar(a + i, n - i);
+}
+
+static void minmax_neon(const float *a, size_t n, float *min, float *max) {
+    if (n < 4) {
+        minmax_scalar(a, n, min, max);
+        return;
+    }
+    float32x4_t lo = vld1q_f32(a), hi = lo;
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t v = vld1q_f32(a + i);
+        lo = vminq_f32(lo, v);
+        hi = vmaxq_f32(hi, v);
+    }
+    *min = vminvq_f32(lo);
+    *max = vmaxvq_f32(hi);
+    for (; i < n; i++) {
+        *min = a[i] < *min ? a[i] : *min;
+        *max = a[i] > *max ? a[i] : *max;
+    }
+}
+
+static void pack565_neon(uint16_t *dst, const uint8_t *rgb, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint8x8x3_t p = vld3_u8(rgb + 3 * i);
+        uint16x8_t r = vshll_n_u8(vand_u8(p.val[0], vdup_n_u8(0xF8)), 8);
+        uint16x8_t g = vshll_n_u8(vand_u8(p.val[1], vdup_n_u8(0xFC)), 3);
+        uint16x8_t b = vmovl_u8(vshr_n_u8(p.val[2], 3));
+        vst1q_u16(dst + i, vorrq_u16(r, vorrq_u16(g, b)));
+    }
+    pack565_scalar(dst + i, rgb + 3 * i, n - i);
+}
+
+static void unpack565_neon(uint8_t *rgb, const uint16_t *src, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t v = vld1q_u16(src + i);
+        uint8x8_t r = vand_u8(vshrn_n_u16(v, 8), vdup_n_u8(0xF8));
+        uint8x8_t g = vand_u8(vshrn_n_u16(v, 3), vdup_n_u8(0xFC));
+        uint8x8_t b = vshl_n_u8(vmovn_u16(v), 3);
+        uint8x8x3_t p;
+        p.val[0] = vorr_u8(r, vshr_n_u8(r, 5));
+        p.val[1] = vorr_u8(g, vshr_n_u8(g, 6));
+        p.val[2] = vorr_u8(b, vshr_n_u8(b, 5));
+        vst3_u8(rgb + 3 * i, p);
+    }
+    unpack565_scalar(rgb + 3 * i, src + i, n - i);
+}
+
+#endif // HAVE_NEON
+
+const simd_kernels_t simd_variants[] = {
+    { "scalar", always, add_scalar, scale_scalar, fma_scalar, sum_scalar, minmax_scalar,
+      pack565_scalar, unpack565_scalar },
+#ifdef HAVE_X86
+    { "sse2", always, add_sse2, scale_sse2, fma_sse2, sum_sse2, minmax_sse2,
+      pack565_scalar, unpack565_scalar },
+    { "avx2", avx2_supported, add_avx2, scale_avx2, fma_avx2, sum_avx2, minmax_avx2,
+      pack565_avx2, unpack565_avx2 },
+#endif
+#ifdef HAVE_NEON
+    { "neon", always, add_neon, scale_neon, fma_neon, sum_neon, minmax_neon,
+      pack565_neon, unpack565_neon },
+#endif
+};
+
+const int simd_variant_count = sizeof(simd_variants) / sizeof(simd_variants[0]);
+
+// the last one supported is the widest
+const simd_kernels_t *simd_best(void) {
+    static const simd_kernels_t *best = NULL;
+    if (!best) {
+        best = &simd_variants[0];
+        for (int i = 1; i < simd_variant_count; i++) {
+            if (simd_variants[i].supported()) {
+                best = &simd_variants[i];
+            }
+        }
+    }
+    return best;
+}
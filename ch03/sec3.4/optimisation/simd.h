@@ -0,0 +1,42 @@
+/*
+ * Small SIMD kernels, picked at run time
+ *
+ * Each variant implements every kernel, for one instruction set: plain
+ * C, SSE2, AVX2 (with FMA) or NEON. simd_best() returns the widest one
+ * the CPU has, checked once; simd_variants lists them all, for tests and
+ * benchmarks that want to compare.
+ *
+ * Arrays need no alignment, and any n works: what is left after the last
+ * whole vector is done one element at a time.
+ */
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    const char *name;
+    bool (*supported)(void);    // on this CPU
+
+    void (*add)(float *dst, const float *a, const float *b, size_t n);     // a + b
+    void (*scale)(float *dst, const float *a, float k, size_t n);          // a * k
+    void (*fma)(float *dst, const float *a, const float *b,
+                const float *c, size_t n);                                 // a * b + c
+    float (*sum)(const float *a, size_t n);
+    void (*minmax)(const float *a, size_t n, float *min, float *max);     // n > 0
+
+    // RGB565 from and to 8-bit r, g, b triples. Unpacking repeats the top
+    // bits into the low ones, so 0x1F is 0xFF again.
+    void (*pack565)(uint16_t *dst, const uint8_t *rgb, size_t n);
+    void (*unpack565)(uint8_t *rgb, const uint16_t *src, size_t n);
+} simd_kernels_t;
+
+extern const simd_kernels_t simd_variants[];
+extern const int simd_variant_count;
+
+const simd_kernels_t *simd_best(void);
+
+#endif // SIMD_H
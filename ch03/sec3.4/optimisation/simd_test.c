@@ -0,0 +1,135 @@
+/*
+ * Every SIMD variant this CPU has, against the scalar one
+ *
+ * gcc -O2 -Wall simd_test.c simd.c -lm -o simd_test && ./simd_test
+ *
+ * Lengths from 0 to 40 and a long one, at offsets that are not vector
+ * aligned, so the tails and the unaligned loads are covered. add, scale,
+ * min/max and RGB565 must be exact. fma may differ from the scalar
+ * a * b + c in the last bit, when it is fused, and sum by the rounding
+ * of the partial sums.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "simd.h"
+
+#define LONG_N 1003
+#define MAX_N (LONG_N + 8)
+
+static unsigned seed = 1;
+
+static unsigned next(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+static float random_float(void) {
+    return ((int)(next() % 20001) - 10000) / 100.0f;
+}
+
+static int failures = 0;
+
+static void fail(const char *variant, const char *kernel, size_t n, size_t i) {
+    if (failures++ < 20) {
+        printf("  %s %s differs at n = %zu, i = %zu\n", variant, kernel, n, i);
+    }
+}
+
+static void check(const simd_kernels_t *v, size_t n, size_t offset) {
+    const simd_kernels_t *s = &simd_variants[0];
+    static float a[MAX_N], b[MAX_N], c[MAX_N], want[MAX_N], got[MAX_N];
+    static uint8_t rgb[3 * MAX_N], rgb_want[3 * MAX_N + 16], rgb_got[3 * MAX_N + 16];
+    static uint16_t px[MAX_N], px_want[MAX_N], px_got[MAX_N];
+    for (size_t i = 0; i < n + offset; i++) {
+        a[i] = random_float();
+        b[i] = random_float();
+        c[i] = random_float();
+        px[i] = (uint16_t)next();
+    }
+    for (size_t i = 0; i < 3 * (n + offset); i++) {
+        rgb[i] = (uint8_t)next();
+    }
+    const float *pa = a + offset, *pb = b + offset, *pc = c + offset;
+
+    s->add(want, pa, pb, n);
+    v->add(got, pa, pb, n);
+    for (size_t i = 0; i < n; i++) {
+        if (want[i] != got[i]) fail(v->name, "add", n, i);
+    }
+
+    s->scale(want, pa, 0.37f, n);
+    v->scale(got, pa, 0.37f, n);
+    for (size_t i = 0; i < n; i++) {
+        if (want[i] != got[i]) fail(v->name, "scale", n, i);
+    }
+
+    // within a rounding of a * b and one of the result
+    s->fma(want, pa, pb, pc, n);
+    v->fma(got, pa, pb, pc, n);
+    for (size_t i = 0; i < n; i++) {
+        float ulp = (fabsf(pa[i] * pb[i]) + fabsf(want[i])) * 1.2e-7f;
+        if (fabsf(want[i] - got[i]) > ulp) fail(v->name, "fma", n, i);
+    }
+
+    // within the rounding of n additions of numbers up to 100
+    float sw = s->sum(pa, n), sg = v->sum(pa, n);
+    if (fabsf(sw - sg) > n * 100.0f * 1.2e-7f) fail(v->name, "sum", n, 0);
+
+    if (n > 0) {
+        float lw, hw, lg, hg;
+        s->minmax(pa, n, &lw, &hw);
+        v->minmax(pa, n, &lg, &hg);
+        if (lw != lg || hw != hg) fail(v->name, "minmax", n, 0);
+    }
+
+    s->pack565(px_want, rgb + 3 * offset, n);
+    v->pack565(px_got, rgb + 3 * offset, n);
+    for (size_t i = 0; i < n; i++) {
+        if (px_want[i] != px_got[i]) fail(v->name, "pack565", n, i);
+    }
+
+    // and nothing written past the end
+    memset(rgb_want, 0xAA, sizeof(rgb_want));
+    memset(rgb_got, 0xAA, sizeof(rgb_got));
+    s->unpack565(rgb_want, px + offset, n);
+    v->unpack565(rgb_got, px + offset, n);
+    for (size_t i = 0; i < 3 * n + 16; i++) {
+        if (rgb_want[i] != rgb_got[i]) fail(v->name, "unpack565", n, i / 3);
+    }
+}
+
+int main(void) {
+    // the round trip loses nothing that RGB565 keeps
+    uint16_t all[65536], back[65536];
+    static uint8_t rgb[3 * 65536];
+    for (int i = 0; i < 65536; i++) {
+        all[i] = (uint16_t)i;
+    }
+    simd_variants[0].unpack565(rgb, all, 65536);
+    simd_variants[0].pack565(back, rgb, 65536);
+    if (memcmp(all, back, sizeof(all)) != 0) {
+        printf("scalar RGB565 round trip fails\n");
+        failures++;
+    }
+
+    printf("Best here: %s\n", simd_best()->name);
+    for (int k = 1; k < simd_variant_count; k++) {
+        const simd_kernels_t *v = &simd_variants[k];
+        if (!v->supported()) {
+            printf("%-8s not on this CPU\n", v->name);
+            continue;
+        }
+        int before = failures;
+        for (size_t offset = 0; offset < 4; offset++) {
+            for (size_t n = 0; n <= 40; n++) {
+                check(v, n, offset);
+            }
+            check(v, LONG_N, offset);
+        }
+        printf("%-8s %s\n", v->name, failures == before ? "ok" : "FAILED");
+    }
+    return failures != 0;
+}
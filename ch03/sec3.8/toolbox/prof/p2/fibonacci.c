@@ -3,6 +3,9 @@
 #include <time.h>
 
 #include "vm2.h"
+#include "profiler.h"
+
+extern Profiler profiler;
 
 int fibonacci_recursive(int n) {
 	if (n == 0)
@@ -259,11 +262,45 @@ void expanded() {
 	}
 }
 
+#ifdef PROFILER_SAMPLING
+// long enough (about 100M opcodes) for the sampling timer to see something
+int countdown_program[] = {
+	SET, 20000000,
+	STORE, 0,
+
+// 4:
+	LOAD, 0,
+	DEC,
+	DUP,
+	STORE, 0,
+	JPNZ, 4,
+	HALT
+};
+
+void countdown() {
+	VM* vm = newVM(countdown_program, 0, 5);
+	if (vm != NULL) {
+        printf("--- countdown ---\n");
+		run(vm);
+        printf("\n\n");
+		freeVM(vm);
+	}
+}
+#endif
+
 // test all
 int main() {
+	HeapSnapshot before, after;
 	native();
+	profiler_heap_snapshot(&profiler, &before);
 	compressed();
 	expanded();
+#ifdef PROFILER_SAMPLING
+	countdown();
+#endif
+	// every VM freed again
+	profiler_heap_snapshot(&profiler, &after);
+	profiler_heap_diff(&profiler, &before, &after);
 	return 0;
 }
 
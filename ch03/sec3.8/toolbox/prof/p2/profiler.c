@@ -1,20 +1,155 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "profiler.h"
 
+#ifdef PROFILER_SAMPLING
+#include <sys/time.h>
+
+// The handler is the only producer and runs on the interpreter's own
+// thread, so a head index with release/acquire is all the locking needed.
+// Samples are consumed after the timer is stopped.
+
+static Profiler *sampled;
+
+static void on_sample(int sig) {
+    (void)sig;
+    Profiler *p = sampled;
+    if (p == NULL)
+        return;
+    unsigned head = atomic_load_explicit(&p->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&p->tail, memory_order_acquire);
+    if (head - tail >= PROFILER_RING_SIZE) {
+        atomic_fetch_add_explicit(&p->dropped, 1, memory_order_relaxed);
+        return;
+    }
+    p->ring[head & (PROFILER_RING_SIZE - 1)] = p->current;
+    atomic_store_explicit(&p->head, head + 1, memory_order_release);
+}
+
+static void set_timer(long usec) {
+    struct itimerval timer;
+    timer.it_interval.tv_sec = usec / 1000000;
+    timer.it_interval.tv_usec = usec % 1000000;
+    timer.it_value = timer.it_interval;
+    setitimer(ITIMER_PROF, &timer, NULL);
+}
+
+static void sampling_start(Profiler *profiler) {
+    atomic_store(&profiler->head, 0);
+    atomic_store(&profiler->tail, 0);
+    atomic_store(&profiler->dropped, 0);
+    memset(profiler->sample_count, 0, sizeof(profiler->sample_count));
+    profiler->samples = 0;
+    profiler->current = 0;
+    sampled = profiler;
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_sample;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGPROF, &action, NULL);
+    set_timer(1000000 / PROFILER_HZ);
+}
+
+static void sampling_stop(Profiler *profiler) {
+    set_timer(0);
+    sampled = NULL;
+
+    unsigned head = atomic_load_explicit(&profiler->head, memory_order_acquire);
+    for (unsigned i = atomic_load(&profiler->tail); i != head; i++) {
+        profiler->sample_count[profiler->ring[i & (PROFILER_RING_SIZE - 1)] & 0xff]++;
+        profiler->samples++;
+    }
+}
+
+static int compare_samples(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// one line per (opcode, pc) in the folded format read by flamegraph.pl
+void profiler_write_folded(Profiler *profiler, FILE *out) {
+    unsigned head = atomic_load(&profiler->head), tail = atomic_load(&profiler->tail);
+    int n = (int)(head - tail);
+    if (n <= 0)
+        return;
+    int *sorted = malloc(sizeof(int) * n);
+    if (sorted == NULL)
+        return;
+    for (int i = 0; i < n; i++)
+        sorted[i] = profiler->ring[(tail + i) & (PROFILER_RING_SIZE - 1)];
+    qsort(sorted, n, sizeof(int), compare_samples);
+
+    for (int i = 0; i < n; ) {
+        int j = i;
+        while (j < n && sorted[j] == sorted[i])
+            j++;
+        fprintf(out, "vm2;op_%d;pc_%d %d\n", sorted[i] & 0xff, sorted[i] >> 8, j - i);
+        i = j;
+    }
+    free(sorted);
+}
+
+// the timer may fire less often than asked, so times are shares of the run
+static void sampling_print(Profiler *profiler, double total_time) {
+    unsigned dropped = atomic_load(&profiler->dropped);
+    printf("\nOpcode Sample Profile (%d samples", profiler->samples);
+    if (dropped > 0)
+        printf(", %u dropped", dropped);
+    printf("):\n");
+    printf("%-10s %-10s %-8s %-15s %-10s\n", "Opcode", "Samples", "%", "Est. time (s)", "Count");
+    printf("------------------------------------------------------------\n");
+
+    for (int i = 0; i < NUM_OPCODES; i++) {
+        if (profiler->opcode_count[i] > 0) {
+            double share = profiler->samples ? (double)profiler->sample_count[i] / profiler->samples : 0.0;
+            printf("%-10d %-10d %-8.1f %-15.6f %-10d\n", i, profiler->sample_count[i], 100.0 * share,
+                share * total_time, profiler->opcode_count[i]);
+        }
+    }
+
+    // every profiled run in this process appends to the same file
+    static int written = 0;
+    FILE *out = fopen(PROFILER_FOLDED_FILE, written ? "a" : "w");
+    if (out != NULL) {
+        profiler_write_folded(profiler, out);
+        fclose(out);
+        written = 1;
+        printf("Folded stacks written to %s\n", PROFILER_FOLDED_FILE);
+    }
+}
+#endif
+
+static unsigned long long heap_now(Profiler *profiler) {
+    unsigned long long opcodes = profiler->time_base;
+    for (int i = 0; i < NUM_OPCODES; i++)
+        opcodes += profiler->opcode_count[i];
+    return opcodes;
+}
+
 void profiler_start(Profiler *profiler) {
     profiler->start = clock();
-    profiler->current_memory = 0;
-    profiler->peak_memory = 0;
+    // the VM is allocated before it runs, so what is live now counts
+    profiler->peak_memory = profiler->current_memory;
     profiler->stack_depth = 0;
     profiler->peak_stack_depth = 0;
+    profiler->time_base = heap_now(profiler);
     for (int i = 0; i < NUM_OPCODES; i++) {
         profiler->opcode_time[i] = 0.0;
         profiler->opcode_count[i] = 0;
     }
+#ifdef PROFILER_SAMPLING
+    sampling_start(profiler);
+#endif
 }
 
 void profiler_stop(Profiler *profiler) {
     profiler->end = clock();
+#ifdef PROFILER_SAMPLING
+    sampling_stop(profiler);
+#endif
 }
 
 void profiler_opcode_start(Profiler *profiler, int opcode) {
@@ -27,19 +162,209 @@ void profiler_opcode_stop(Profiler *profiler, int opcode) {
     profiler->opcode_count[opcode]++;
 }
 
-void profiler_track_allocation(Profiler *profiler, size_t size) {
+static unsigned block_hash(const void *ptr) {
+    unsigned p = (unsigned)((size_t)ptr >> 4);
+    return ((p ^ (p >> 12)) * 2654435761u >> 20) & (HEAP_MAX_BLOCKS - 1);
+}
+
+// Linear probing without tombstones: the blocks after a freed one that
+// would no longer be found are moved back into the gap
+static void block_remove(Profiler *profiler, unsigned i) {
+    unsigned j = i;
+    for (;;) {
+        profiler->blocks[i].ptr = NULL;
+        unsigned k;
+        do {
+            j = (j + 1) & (HEAP_MAX_BLOCKS - 1);
+            if (profiler->blocks[j].ptr == NULL)
+                return;
+            k = block_hash(profiler->blocks[j].ptr);
+        } while (i <= j ? (i < k && k <= j) : (i < k || k <= j));
+        profiler->blocks[i] = profiler->blocks[j];
+        i = j;
+    }
+}
+
+static int heap_site(Profiler *profiler, const char *tag, const void *address) {
+    for (int i = 0; i < profiler->site_count; i++) {
+        HeapSite *site = &profiler->sites[i];
+        if (tag ? site->tag != NULL && strcmp(site->tag, tag) == 0
+                : site->tag == NULL && site->address == address)
+            return i;
+    }
+    if (profiler->site_count == HEAP_MAX_SITES)
+        return HEAP_MAX_SITES - 1;
+    if (profiler->site_count == HEAP_MAX_SITES - 1) {
+        tag = "(other)";
+        address = NULL;
+    }
+    HeapSite *site = &profiler->sites[profiler->site_count];
+    memset(site, 0, sizeof(*site));
+    site->tag = tag;
+    site->address = address;
+    return profiler->site_count++;
+}
+
+static int lifetime_bucket(unsigned long long opcodes) {
+    int b = opcodes == 0 ? 0 : 64 - __builtin_clzll(opcodes);
+    return b < HEAP_LIFETIME_BUCKETS ? b : HEAP_LIFETIME_BUCKETS - 1;
+}
+
+// When the run outgrows the timeline, neighbouring epochs are merged and
+// every epoch becomes twice as long
+static void heap_epoch(Profiler *profiler, unsigned long long now, size_t size) {
+    if (profiler->epoch_opcodes == 0)
+        profiler->epoch_opcodes = HEAP_EPOCH_OPCODES;
+    while (now / profiler->epoch_opcodes >= HEAP_EPOCHS) {
+        for (int i = 0; i < HEAP_EPOCHS / 2; i++)
+            profiler->epoch_bytes[i] = profiler->epoch_bytes[2 * i] + profiler->epoch_bytes[2 * i + 1];
+        memset(profiler->epoch_bytes + HEAP_EPOCHS / 2, 0, sizeof(size_t) * (HEAP_EPOCHS / 2));
+        profiler->epoch_opcodes *= 2;
+    }
+    profiler->epoch_bytes[now / profiler->epoch_opcodes] += size;
+}
+
+void profiler_track_allocation(Profiler *profiler, void *ptr, size_t size, const char *tag) {
+    if (ptr == NULL)
+        return;
+    if (profiler->block_count >= HEAP_MAX_BLOCKS / 4 * 3) {
+        profiler->untracked++;
+        return;
+    }
+    unsigned long long now = heap_now(profiler);
+    int s = heap_site(profiler, tag, __builtin_return_address(0));
+
+    unsigned i = block_hash(ptr);
+    while (profiler->blocks[i].ptr != NULL)
+        i = (i + 1) & (HEAP_MAX_BLOCKS - 1);
+    profiler->blocks[i] = (HeapBlock){ ptr, size, now, s };
+    profiler->block_count++;
+
+    HeapSite *site = &profiler->sites[s];
+    site->allocs++;
+    site->total_bytes += size;
+    site->live_bytes += size;
+    site->live_blocks++;
+    if (site->live_bytes > site->peak_bytes)
+        site->peak_bytes = site->live_bytes;
+    heap_epoch(profiler, now, size);
+
     profiler->current_memory += size;
     if (profiler->current_memory > profiler->peak_memory) {
         profiler->peak_memory = profiler->current_memory;
     }
 }
 
-void profiler_track_deallocation(Profiler *profiler, size_t size) {
-    if (profiler->current_memory >= size) {
-        profiler->current_memory -= size;
+void profiler_track_deallocation(Profiler *profiler, const void *ptr) {
+    if (ptr == NULL)
+        return;
+    unsigned i = block_hash(ptr);
+    while (profiler->blocks[i].ptr != ptr) {
+        if (profiler->blocks[i].ptr == NULL) {
+            profiler->untracked++;
+            return;
+        }
+        i = (i + 1) & (HEAP_MAX_BLOCKS - 1);
+    }
+    HeapBlock *block = &profiler->blocks[i];
+    HeapSite *site = &profiler->sites[block->site];
+    site->frees++;
+    site->live_bytes -= block->size;
+    site->live_blocks--;
+    site->lifetime[lifetime_bucket(heap_now(profiler) - block->born)]++;
+    if (profiler->current_memory >= block->size) {
+        profiler->current_memory -= block->size;
+    }
+    profiler->block_count--;
+    block_remove(profiler, i);
+}
+
+void profiler_heap_snapshot(Profiler *profiler, HeapSnapshot *snapshot) {
+    snapshot->time = heap_now(profiler);
+    snapshot->site_count = profiler->site_count;
+    for (int i = 0; i < profiler->site_count; i++) {
+        const HeapSite *site = &profiler->sites[i];
+        snapshot->sites[i].allocs = site->allocs;
+        snapshot->sites[i].frees = site->frees;
+        snapshot->sites[i].total_bytes = site->total_bytes;
+        snapshot->sites[i].live_bytes = site->live_bytes;
+        snapshot->sites[i].live_blocks = site->live_blocks;
+    }
+}
+
+static const char *site_name(const HeapSite *site, char *buf, size_t size) {
+    if (site->tag != NULL)
+        return site->tag;
+    snprintf(buf, size, "%p", site->address);
+    return buf;
+}
+
+// What each site did between two snapshots, the later one second. A site
+// first seen after the earlier snapshot starts from nothing
+void profiler_heap_diff(Profiler *profiler, const HeapSnapshot *before, const HeapSnapshot *after) {
+    char buf[32];
+    printf("\nHeap diff over %llu opcodes:\n", after->time - before->time);
+    printf("%-20s %-10s %-10s %-12s %-12s %-10s\n", "Site", "Allocs", "Frees", "Bytes",
+        "Live bytes", "Live blocks");
+    printf("------------------------------------------------------------------------------\n");
+    for (int i = 0; i < after->site_count; i++) {
+        unsigned allocs = after->sites[i].allocs, frees = after->sites[i].frees;
+        size_t total = after->sites[i].total_bytes;
+        long live = (long)after->sites[i].live_bytes;
+        int blocks = after->sites[i].live_blocks;
+        if (i < before->site_count) {
+            allocs -= before->sites[i].allocs;
+            frees -= before->sites[i].frees;
+            total -= before->sites[i].total_bytes;
+            live -= (long)before->sites[i].live_bytes;
+            blocks -= before->sites[i].live_blocks;
+        }
+        if (allocs == 0 && frees == 0)
+            continue;
+        printf("%-20s %-10u %-10u %-12zu %+-12ld %+-10d\n", site_name(&profiler->sites[i], buf, sizeof(buf)),
+            allocs, frees, total, live, blocks);
     }
 }
 
+static void heap_print(Profiler *profiler) {
+    char buf[32];
+    printf("\nHeap by site (%d live blocks", profiler->block_count);
+    if (profiler->untracked > 0)
+        printf(", %u untracked", profiler->untracked);
+    printf("):\n");
+    printf("%-20s %-10s %-10s %-12s %-12s %-12s\n", "Site", "Allocs", "Frees", "Bytes",
+        "Live bytes", "Peak live");
+    printf("------------------------------------------------------------------------------\n");
+    for (int i = 0; i < profiler->site_count; i++) {
+        const HeapSite *site = &profiler->sites[i];
+        printf("%-20s %-10u %-10u %-12zu %-12zu %-12zu\n", site_name(site, buf, sizeof(buf)),
+            site->allocs, site->frees, site->total_bytes, site->live_bytes, site->peak_bytes);
+    }
+
+    // bucket b holds lifetimes from 2^(b-1) up to 2^b opcodes
+    printf("\nLifetimes of freed blocks, in opcodes:\n");
+    for (int i = 0; i < profiler->site_count; i++) {
+        const HeapSite *site = &profiler->sites[i];
+        if (site->frees == 0)
+            continue;
+        printf("%-20s", site_name(site, buf, sizeof(buf)));
+        for (int b = 0; b < HEAP_LIFETIME_BUCKETS; b++) {
+            if (site->lifetime[b] > 0)
+                printf(" %llu+:%u", b == 0 ? 0ull : 1ull << (b - 1), site->lifetime[b]);
+        }
+        printf("\n");
+    }
+
+    int last = HEAP_EPOCHS - 1;
+    while (last >= 0 && profiler->epoch_bytes[last] == 0)
+        last--;
+    if (last < 0)
+        return;
+    printf("\nBytes allocated per %llu opcodes:\n", profiler->epoch_opcodes);
+    for (int i = 0; i <= last; i++)
+        printf("%zu%s", profiler->epoch_bytes[i], i == last || i % 16 == 15 ? "\n" : " ");
+}
+
 void profiler_update_stack_depth(Profiler *profiler, int sp) {
     profiler->stack_depth = sp + 1;
     if (profiler->stack_depth > profiler->peak_stack_depth) {
@@ -53,6 +378,9 @@ void profiler_print(Profiler *profiler) {
     printf("Peak memory usage: %zu bytes\n", profiler->peak_memory);
     printf("Peak stack depth: %d\n", profiler->peak_stack_depth);
 
+#ifdef PROFILER_SAMPLING
+    sampling_print(profiler, total_time);
+#else
     printf("\nOpcode Execution Profile:\n");
     printf("%-10s %-15s %-10s\n", "Opcode", "Time (s)", "Count");
     printf("------------------------------------------------\n");
@@ -62,4 +390,6 @@ void profiler_print(Profiler *profiler) {
             printf("%-10d %-15.6f %-10d\n", i, profiler->opcode_time[i], profiler->opcode_count[i]);
         }
     }
-}
\ No newline at end of file
+#endif
+    heap_print(profiler);
+}
@@ -2,9 +2,63 @@
 #define PROFILER_H
 
 #include <time.h>
+#include <signal.h>
 
 #define NUM_OPCODES 256
 
+// Build with -DPROFILER_SAMPLING to replace the clock() calls around every
+// opcode by a timer signal that samples the current opcode and pc.
+#define PROFILER_HZ 10000
+#define PROFILER_RING_SIZE 65536    // power of two
+#define PROFILER_FOLDED_FILE "profile.folded"
+
+#ifdef PROFILER_SAMPLING
+#include <stdio.h>
+#include <stdatomic.h>
+#endif
+
+// Heap blocks are tracked by allocation site, a tag the VM passes, or the
+// caller's return address when the tag is NULL. Time is counted in opcodes
+// run, so lifetimes and rates do not depend on the profiler's own cost.
+// Sites count from the start of the process, across profiled runs.
+#define HEAP_MAX_SITES 32           // the last one takes any further sites
+#define HEAP_MAX_BLOCKS 4096        // live blocks, power of two
+#define HEAP_LIFETIME_BUCKETS 24    // powers of two of opcodes
+#define HEAP_EPOCHS 64              // allocation rate timeline
+#define HEAP_EPOCH_OPCODES 1024     // first width of an epoch, doubled as needed
+
+typedef struct {
+    const char *tag;
+    const void *address;            // when tag is NULL
+    unsigned allocs;
+    unsigned frees;
+    size_t total_bytes;
+    size_t live_bytes;
+    size_t peak_bytes;
+    int live_blocks;
+    unsigned lifetime[HEAP_LIFETIME_BUCKETS];   // freed blocks, by log2 of opcodes
+} HeapSite;
+
+typedef struct {
+    const void *ptr;                // NULL for an empty slot
+    size_t size;
+    unsigned long long born;
+    int site;
+} HeapBlock;
+
+// what profiler_heap_diff() compares
+typedef struct {
+    unsigned long long time;
+    int site_count;
+    struct {
+        unsigned allocs;
+        unsigned frees;
+        size_t total_bytes;
+        size_t live_bytes;
+        int live_blocks;
+    } sites[HEAP_MAX_SITES];
+} HeapSnapshot;
+
 typedef struct {
     clock_t start;
     clock_t end;
@@ -15,15 +69,45 @@ typedef struct {
     size_t peak_memory;
     int stack_depth;
     int peak_stack_depth;
+    HeapSite sites[HEAP_MAX_SITES];
+    int site_count;
+    HeapBlock blocks[HEAP_MAX_BLOCKS];
+    int block_count;                // live and tombstones
+    unsigned untracked;             // frees of unknown blocks, or allocations with no room
+    unsigned long long time_base;   // opcodes run before the last profiler_start()
+    unsigned long long epoch_opcodes;   // 0 until the first allocation
+    size_t epoch_bytes[HEAP_EPOCHS];
+#ifdef PROFILER_SAMPLING
+    volatile sig_atomic_t current;  // pc << 8 | opcode, one word so it never tears
+    atomic_uint head;               // written by the signal handler only
+    atomic_uint tail;
+    atomic_uint dropped;
+    int ring[PROFILER_RING_SIZE];
+    int sample_count[NUM_OPCODES];
+    int samples;
+#endif
 } Profiler;
 
 void profiler_start(Profiler *profiler);
 void profiler_stop(Profiler *profiler);
 void profiler_opcode_start(Profiler *profiler, int opcode);
 void profiler_opcode_stop(Profiler *profiler, int opcode);
-void profiler_track_allocation(Profiler *profiler, size_t size);
-void profiler_track_deallocation(Profiler *profiler, size_t size);
+void profiler_track_allocation(Profiler *profiler, void *ptr, size_t size, const char *site);
+void profiler_track_deallocation(Profiler *profiler, const void *ptr);
+void profiler_heap_snapshot(Profiler *profiler, HeapSnapshot *snapshot);
+void profiler_heap_diff(Profiler *profiler, const HeapSnapshot *before, const HeapSnapshot *after);
 void profiler_update_stack_depth(Profiler *profiler, int sp);
 void profiler_print(Profiler *profiler);
 
-#endif
\ No newline at end of file
+// what the interpreter calls around each opcode
+#ifdef PROFILER_SAMPLING
+void profiler_write_folded(Profiler *profiler, FILE *out);
+#define PROFILE_OPCODE_START(p, opcode, pc) \
+    ((p)->current = ((pc) << 8) | (opcode), (p)->opcode_count[opcode]++)
+#define PROFILE_OPCODE_STOP(p, opcode) ((void)0)
+#else
+#define PROFILE_OPCODE_START(p, opcode, pc) profiler_opcode_start((p), (opcode))
+#define PROFILE_OPCODE_STOP(p, opcode) profiler_opcode_stop((p), (opcode))
+#endif
+
+#endif
@@ -13,19 +13,19 @@ VM* newVM(int* code, int pc, int datasize) {
     if (vm == NULL)
         return NULL;
 
-    profiler_track_allocation(&profiler, sizeof(VM));
+    profiler_track_allocation(&profiler, vm, sizeof(VM), "vm");
 
     vm->stack = (int*) malloc(sizeof(int) * STACK_SIZE);
     if (vm->stack == NULL)
         return NULL;
 
-    profiler_track_allocation(&profiler, sizeof(int) * STACK_SIZE);
+    profiler_track_allocation(&profiler, vm->stack, sizeof(int) * STACK_SIZE, "vm.stack");
 
     vm->vars = (int*) malloc(sizeof(int) * datasize);
     if (vm->vars == NULL)
         return NULL;
 
-    profiler_track_allocation(&profiler, sizeof(int) * datasize);
+    profiler_track_allocation(&profiler, vm->vars, sizeof(int) * datasize, "vm.vars");
 
     vm->code = code;
     vm->pc = pc;
@@ -38,13 +38,13 @@ VM* newVM(int* code, int pc, int datasize) {
 
 void freeVM(VM* vm) {
     if (vm != NULL) {
-        profiler_track_deallocation(&profiler, sizeof(int) * STACK_SIZE);
+        profiler_track_deallocation(&profiler, vm->stack);
         free(vm->stack);
 
-        profiler_track_deallocation(&profiler, sizeof(int) * vm->datasize);
+        profiler_track_deallocation(&profiler, vm->vars);
         free(vm->vars);
 
-        profiler_track_deallocation(&profiler, sizeof(VM));
+        profiler_track_deallocation(&profiler, vm);
         free(vm);
     }
 }
@@ -75,7 +75,7 @@ void run(VM* vm) {
 
 		int opcode = nextcode(vm);
 
-        profiler_opcode_start(&profiler, opcode);
+        PROFILE_OPCODE_START(&profiler, opcode, vm->pc - 1);
 
 		switch (opcode) {
 
@@ -84,7 +84,7 @@ void run(VM* vm) {
 				break;				
 
             case HALT:
-                profiler_opcode_stop(&profiler, opcode);
+                PROFILE_OPCODE_STOP(&profiler, opcode);
                 goto end_run;
 
 			case SET:
@@ -237,7 +237,7 @@ void run(VM* vm) {
 				break;
 		}
 
-        profiler_opcode_stop(&profiler, opcode);
+        PROFILE_OPCODE_STOP(&profiler, opcode);
 
 	} while (TRUE);
 
@@ -1,39 +1,389 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "profiler.h"
 
+static int timer_ready = 0;
+
+static int bucket(uint64_t ns) {
+    if (ns < HIST_SUB)
+        return (int)ns;
+    int e = 63 - __builtin_clzll(ns);            // ns >= 2^e, e >= 3
+    int sub = (int)((ns >> (e - 3)) & (HIST_SUB - 1));
+    return (e - 2) * HIST_SUB + sub;
+}
+
+// middle of a bucket, in ns
+static double bucket_ns(int b) {
+    if (b < HIST_SUB)
+        return b;
+    int e = b / HIST_SUB + 2;
+    int sub = b % HIST_SUB;
+    double width = (double)((uint64_t)1 << (e - 3));
+    return (HIST_SUB + sub) * width + width / 2;
+}
+
 void profiler_start(Profiler *profiler) {
-    profiler->start = clock();
+    if (!timer_ready) {
+        timer_init();
+        timer_ready = 1;
+    }
+    profiler->start = timer_now_ns();
     for (int i = 0; i < NUM_OPCODES; i++) {
         profiler->opcode_time[i] = 0.0;
         profiler->opcode_count[i] = 0;
+        profiler->opcode_min[i] = 0.0;
+        profiler->opcode_max[i] = 0.0;
+        free(profiler->opcode_hist[i]);
+        profiler->opcode_hist[i] = NULL;
     }
+    profiler->prev[0] = profiler->prev[1] = -1;
+    memset(profiler->ngrams, 0, sizeof(profiler->ngrams));
+    profiler->ngram_used = 0;
+    profiler->ngram_dropped = 0;
+    free(profiler->pc_count);
+    free(profiler->pc_opcode);
+    profiler->pc_count = NULL;
+    profiler->pc_opcode = NULL;
+    profiler->pc_size = 0;
+    profiler->loop_count = 0;
 }
 
 void profiler_stop(Profiler *profiler) {
-    profiler->end = clock();
+    profiler->end = timer_now_ns();
 }
 
 void profiler_opcode_start(Profiler *profiler, int opcode) {
-    profiler->opcode_start[opcode] = clock();
+    profiler->opcode_start[opcode] = timer_ticks();
 }
 
 void profiler_opcode_stop(Profiler *profiler, int opcode) {
-    clock_t opcode_end = clock();
-    profiler->opcode_time[opcode] += (double)(opcode_end - profiler->opcode_start[opcode]) / CLOCKS_PER_SEC;
+    ticks_t opcode_end = timer_ticks();
+    double ns = timer_ns(timer_elapsed(profiler->opcode_start[opcode], opcode_end));
+
+    if (profiler->opcode_hist[opcode] == NULL) {
+        profiler->opcode_hist[opcode] = calloc(HIST_BUCKETS, sizeof(uint32_t));
+        profiler->opcode_min[opcode] = ns;
+    }
+    if (profiler->opcode_hist[opcode] != NULL)
+        profiler->opcode_hist[opcode][bucket((uint64_t)ns)]++;
+    if (ns < profiler->opcode_min[opcode])
+        profiler->opcode_min[opcode] = ns;
+    if (ns > profiler->opcode_max[opcode])
+        profiler->opcode_max[opcode] = ns;
+
+    profiler->opcode_time[opcode] += ns / 1e9;
     profiler->opcode_count[opcode]++;
 }
 
+void profiler_set_names(Profiler *profiler, const char *const *names, int count) {
+    profiler->opcode_names = names;
+    profiler->opcode_name_count = count;
+}
+
+static uint32_t ngram_key(int n, int a, int b, int c) {
+    return (uint32_t)n << 24 | (uint32_t)a << 16 | (uint32_t)b << 8 | (uint32_t)c;
+}
+
+// The table is never filled past three quarters, so a probe always ends
+// at an empty slot; once it is that full, new n-grams are only counted
+// as dropped
+static void ngram_count(Profiler *profiler, uint32_t key) {
+    uint32_t i = ((key ^ key >> 15) * 2654435761u >> 16) & (NGRAM_SLOTS - 1);
+    for (;;) {
+        NgramSlot *slot = &profiler->ngrams[i];
+        if (slot->key == key) {
+            slot->count++;
+            return;
+        }
+        if (slot->key == 0) {
+            if (profiler->ngram_used >= NGRAM_SLOTS / 4 * 3) {
+                profiler->ngram_dropped++;
+                return;
+            }
+            slot->key = key;
+            slot->count = 1;
+            profiler->ngram_used++;
+            return;
+        }
+        i = (i + 1) & (NGRAM_SLOTS - 1);
+    }
+}
+
+static void pc_grow(Profiler *profiler, int pc) {
+    int size = profiler->pc_size ? profiler->pc_size : 64;
+    while (size <= pc)
+        size *= 2;
+    uint32_t *count = realloc(profiler->pc_count, size * sizeof(uint32_t));
+    if (count == NULL)
+        return;
+    profiler->pc_count = count;
+    uint8_t *opcode = realloc(profiler->pc_opcode, size);
+    if (opcode == NULL)
+        return;
+    profiler->pc_opcode = opcode;
+    memset(count + profiler->pc_size, 0, (size - profiler->pc_size) * sizeof(uint32_t));
+    memset(opcode + profiler->pc_size, 0, size - profiler->pc_size);
+    profiler->pc_size = size;
+}
+
+void profiler_trace(Profiler *profiler, int pc, int opcode) {
+    if (pc >= profiler->pc_size)
+        pc_grow(profiler, pc);
+    if (pc < profiler->pc_size) {
+        profiler->pc_count[pc]++;
+        profiler->pc_opcode[pc] = (uint8_t)opcode;
+    }
+
+    if (profiler->prev[1] >= 0) {
+        ngram_count(profiler, ngram_key(2, profiler->prev[1], opcode, 0));
+        if (profiler->prev[0] >= 0)
+            ngram_count(profiler, ngram_key(3, profiler->prev[0], profiler->prev[1], opcode));
+    }
+    profiler->prev[0] = profiler->prev[1];
+    profiler->prev[1] = opcode;
+}
+
+// whatever runs next does not follow the jump in the code
+void profiler_branch(Profiler *profiler, int from, int to) {
+    profiler->prev[0] = profiler->prev[1] = -1;
+    if (to > from)
+        return;
+    for (int i = 0; i < profiler->loop_count; i++) {
+        LoopSlot *loop = &profiler->loops[i];
+        if (loop->target == to && loop->from == from) {
+            loop->iterations++;
+            return;
+        }
+    }
+    if (profiler->loop_count < LOOP_SLOTS)
+        profiler->loops[profiler->loop_count++] = (LoopSlot){ to, from, 1 };
+}
+
+static double percentile(Profiler *profiler, int opcode, double p) {
+    const uint32_t *hist = profiler->opcode_hist[opcode];
+    if (hist == NULL)
+        return 0.0;
+    long rank = (long)(p * profiler->opcode_count[opcode]), seen = 0;
+    double ns = profiler->opcode_max[opcode];
+    for (int b = 0; b < HIST_BUCKETS; b++) {
+        seen += hist[b];
+        if (seen > rank) {
+            ns = bucket_ns(b);
+            break;
+        }
+    }
+    // a bucket is wider than what was actually seen
+    if (ns < profiler->opcode_min[opcode])
+        ns = profiler->opcode_min[opcode];
+    if (ns > profiler->opcode_max[opcode])
+        ns = profiler->opcode_max[opcode];
+    return ns;
+}
+
+static int opcode_text(Profiler *profiler, int opcode, char *buf, size_t size) {
+    if (opcode < profiler->opcode_name_count && profiler->opcode_names[opcode] != NULL)
+        return snprintf(buf, size, "%s", profiler->opcode_names[opcode]);
+    return snprintf(buf, size, "%d", opcode);
+}
+
+static void ngram_text(Profiler *profiler, uint32_t key, char *buf, size_t size) {
+    int n = (int)(key >> 24), len = 0;
+    for (int i = 0; i < n && len < (int)size; i++) {
+        int opcode = (key >> (16 - 8 * i)) & 0xFF;
+        if (i > 0)
+            len += snprintf(buf + len, size - len, " ");
+        if (len < (int)size)
+            len += opcode_text(profiler, opcode, buf + len, size - len);
+    }
+}
+
+// dispatches a superinstruction standing for the n-gram would save
+static uint64_t ngram_saved(const NgramSlot *slot) {
+    return (uint64_t)slot->count * ((slot->key >> 24) - 1);
+}
+
+static int by_saved(const void *a, const void *b) {
+    const NgramSlot *x = a, *y = b;
+    uint64_t sx = ngram_saved(x), sy = ngram_saved(y);
+    if (sx != sy)
+        return sx < sy ? 1 : -1;
+    return x->key < y->key ? -1 : x->key > y->key;
+}
+
+typedef struct {
+    int pc;
+    uint32_t count;
+} PcCount;
+
+static int by_count(const void *a, const void *b) {
+    const PcCount *x = a, *y = b;
+    if (x->count != y->count)
+        return x->count < y->count ? 1 : -1;
+    return x->pc - y->pc;
+}
+
+typedef struct {
+    LoopSlot loop;
+    uint64_t executed;              // opcodes run from target to from
+} LoopRank;
+
+static int by_executed(const void *a, const void *b) {
+    const LoopRank *x = a, *y = b;
+    if (x->executed != y->executed)
+        return x->executed < y->executed ? 1 : -1;
+    return x->loop.target - y->loop.target;
+}
+
+static int run_number = 0;
+
+static FILE *open_report(const char *name) {
+#ifdef PICO_ON_DEVICE
+    (void)name;
+    return NULL;
+#else
+    // every profiled run in this process appends to the same file
+    FILE *out = fopen(name, run_number > 1 ? "a" : "w");
+    if (out != NULL)
+        fprintf(out, "# run %d\n", run_number);
+    return out;
+#endif
+}
+
+// Candidate superinstructions, ranked by the dispatches they would save
+static void ngram_print(Profiler *profiler) {
+    NgramSlot *sorted = malloc((profiler->ngram_used + 1) * sizeof(NgramSlot));
+    if (sorted == NULL)
+        return;
+    int n = 0;
+    for (int i = 0; i < NGRAM_SLOTS; i++) {
+        if (profiler->ngrams[i].key != 0)
+            sorted[n++] = profiler->ngrams[i];
+    }
+    qsort(sorted, n, sizeof(NgramSlot), by_saved);
+
+    char text[64];
+    printf("\nSuperinstruction candidates (%d n-grams", n);
+    if (profiler->ngram_dropped > 0)
+        printf(", %u counts dropped", profiler->ngram_dropped);
+    printf("):\n");
+    printf("%-30s %-12s %-12s\n", "Opcodes", "Count", "Saved");
+    printf("------------------------------------------------------------\n");
+    for (int i = 0; i < n && i < NGRAM_TOP; i++) {
+        ngram_text(profiler, sorted[i].key, text, sizeof(text));
+        printf("%-30s %-12u %-12llu\n", text, sorted[i].count,
+            (unsigned long long)ngram_saved(&sorted[i]));
+    }
+
+    FILE *out = open_report(PROFILER_NGRAM_FILE);
+    if (out != NULL) {
+        for (int i = 0; i < n; i++) {
+            ngram_text(profiler, sorted[i].key, text, sizeof(text));
+            fprintf(out, "%llu %u %s\n", (unsigned long long)ngram_saved(&sorted[i]),
+                sorted[i].count, text);
+        }
+        fclose(out);
+        printf("N-grams written to %s\n", PROFILER_NGRAM_FILE);
+    }
+    free(sorted);
+}
+
+static void pc_print(Profiler *profiler) {
+    PcCount *sorted = malloc((profiler->pc_size + 1) * sizeof(PcCount));
+    if (sorted == NULL)
+        return;
+    int n = 0;
+    for (int pc = 0; pc < profiler->pc_size; pc++) {
+        if (profiler->pc_count[pc] > 0)
+            sorted[n++] = (PcCount){ pc, profiler->pc_count[pc] };
+    }
+
+    // in code order for the file
+    char text[32];
+    FILE *out = open_report(PROFILER_PC_FILE);
+    if (out != NULL) {
+        for (int i = 0; i < n; i++) {
+            opcode_text(profiler, profiler->pc_opcode[sorted[i].pc], text, sizeof(text));
+            fprintf(out, "%d %u %s\n", sorted[i].pc, sorted[i].count, text);
+        }
+        fclose(out);
+    }
+
+    qsort(sorted, n, sizeof(PcCount), by_count);
+    printf("\nHottest pcs:\n");
+    printf("%-10s %-12s %-10s\n", "pc", "Count", "Opcode");
+    printf("------------------------------------------------------------\n");
+    for (int i = 0; i < n && i < NGRAM_TOP; i++) {
+        opcode_text(profiler, profiler->pc_opcode[sorted[i].pc], text, sizeof(text));
+        printf("%-10d %-12u %-10s\n", sorted[i].pc, sorted[i].count, text);
+    }
+    if (out != NULL)
+        printf("Per-pc counts written to %s\n", PROFILER_PC_FILE);
+    free(sorted);
+}
+
+// Backward branches, ranked by the opcodes run inside them
+static void loop_print(Profiler *profiler) {
+    LoopRank ranked[LOOP_SLOTS];
+    int n = profiler->loop_count;
+    for (int i = 0; i < n; i++) {
+        LoopSlot loop = profiler->loops[i];
+        uint64_t executed = 0;
+        for (int pc = loop.target; pc <= loop.from && pc < profiler->pc_size; pc++)
+            executed += profiler->pc_count[pc];
+        ranked[i] = (LoopRank){ loop, executed };
+    }
+    qsort(ranked, n, sizeof(LoopRank), by_executed);
+
+    printf("\nHot loops:\n");
+    printf("%-10s %-10s %-12s %-12s\n", "Target", "Branch", "Iterations", "Executed");
+    printf("------------------------------------------------------------\n");
+    for (int i = 0; i < n && i < NGRAM_TOP; i++) {
+        printf("%-10d %-10d %-12u %-12llu\n", ranked[i].loop.target, ranked[i].loop.from,
+            ranked[i].loop.iterations, (unsigned long long)ranked[i].executed);
+    }
+
+    char text[32];
+    FILE *out = open_report(PROFILER_LOOP_FILE);
+    if (out != NULL) {
+        for (int i = 0; i < n; i++) {
+            fprintf(out, "%d %d %u %llu", ranked[i].loop.target, ranked[i].loop.from,
+                ranked[i].loop.iterations, (unsigned long long)ranked[i].executed);
+            for (int pc = ranked[i].loop.target; pc <= ranked[i].loop.from && pc < profiler->pc_size; pc++) {
+                if (profiler->pc_count[pc] > 0) {
+                    opcode_text(profiler, profiler->pc_opcode[pc], text, sizeof(text));
+                    fprintf(out, " %s", text);
+                }
+            }
+            fprintf(out, "\n");
+        }
+        fclose(out);
+        printf("Loops written to %s\n", PROFILER_LOOP_FILE);
+    }
+}
+
 void profiler_print(Profiler *profiler) {
-    double total_time = (double)(profiler->end - profiler->start) / CLOCKS_PER_SEC;
+    double total_time = (double)(profiler->end - profiler->start) / 1e9;
     printf("Total execution time: %.6f seconds\n", total_time);
+    printf("Timer: %s, %.3f ns/tick, overhead %.1f ns (subtracted)\n",
+        timer_name(), timer_ns_per_tick, timer_overhead_ns);
 
     printf("\nOpcode Execution Profile:\n");
-    printf("%-10s %-15s %-10s\n", "Opcode", "Time (s)", "Count");
-    printf("------------------------------------------------\n");
+    printf("%-10s %-15s %-10s %-10s %-10s %-10s\n", "Opcode", "Time (s)", "Count",
+        "Min (ns)", "Mean (ns)", "P99 (ns)");
+    printf("------------------------------------------------------------------------\n");
 
     for (int i = 0; i < NUM_OPCODES; i++) {
         if (profiler->opcode_count[i] > 0) {
-            printf("%-10d %-15.6f %-10d\n", i, profiler->opcode_time[i], profiler->opcode_count[i]);
+            double mean = profiler->opcode_time[i] * 1e9 / profiler->opcode_count[i];
+            printf("%-10d %-15.9f %-10d %-10.1f %-10.1f %-10.1f\n", i, profiler->opcode_time[i],
+                profiler->opcode_count[i], profiler->opcode_min[i], mean,
+                percentile(profiler, i, 0.99));
         }
     }
-}
\ No newline at end of file
+
+    run_number++;
+    ngram_print(profiler);
+    pc_print(profiler);
+    loop_print(profiler);
+}
@@ -1,16 +1,59 @@
 #ifndef PROFILER_H
 #define PROFILER_H
 
-#include <time.h>
+#include <stdint.h>
+#include "timer.h"
 
 #define NUM_OPCODES 256
 
+// Opcode times go into a log-linear histogram, eight buckets per power of
+// two, which puts percentiles within about 6%.
+#define HIST_SUB 8
+#define HIST_BUCKETS (64 * HIST_SUB)
+
+// Runs of two and three opcodes, counted in an open-addressed table keyed
+// n << 24 | a << 16 | b << 8 | c. A taken branch ends a run, since only
+// opcodes that follow each other in the code can be fused into one.
+#define NGRAM_SLOTS 2048            // power of two
+#define NGRAM_TOP 10
+#define LOOP_SLOTS 64
+#define PROFILER_NGRAM_FILE "profile.ngrams"
+#define PROFILER_PC_FILE "profile.pcs"
+#define PROFILER_LOOP_FILE "profile.loops"
+
+typedef struct {
+    uint32_t key;                   // 0 for an empty slot
+    uint32_t count;
+} NgramSlot;
+
+// a backward branch, taken iterations times
 typedef struct {
-    clock_t start;
-    clock_t end;
-    clock_t opcode_start[NUM_OPCODES];
+    int target;
+    int from;
+    uint32_t iterations;
+} LoopSlot;
+
+typedef struct {
+    uint64_t start;
+    uint64_t end;
+    ticks_t opcode_start[NUM_OPCODES];
     double opcode_time[NUM_OPCODES];
     int opcode_count[NUM_OPCODES];
+    double opcode_min[NUM_OPCODES];
+    double opcode_max[NUM_OPCODES];
+    uint32_t *opcode_hist[NUM_OPCODES];   // allocated on first use
+
+    int prev[2];                    // the last two opcodes of this run, -1 for none
+    NgramSlot ngrams[NGRAM_SLOTS];
+    int ngram_used;
+    uint32_t ngram_dropped;         // counts lost to a full table
+    uint32_t *pc_count;             // per pc, grown as pcs turn up
+    uint8_t *pc_opcode;
+    int pc_size;
+    LoopSlot loops[LOOP_SLOTS];
+    int loop_count;
+    const char *const *opcode_names;    // optional, for the reports
+    int opcode_name_count;
 } Profiler;
 
 void profiler_start(Profiler *profiler);
@@ -19,4 +62,10 @@ void profiler_opcode_start(Profiler *profiler, int opcode);
 void profiler_opcode_stop(Profiler *profiler, int opcode);
 void profiler_print(Profiler *profiler);
 
-#endif
\ No newline at end of file
+// the interpreter calls trace for every opcode with its pc, and branch
+// for every jump taken
+void profiler_trace(Profiler *profiler, int pc, int opcode);
+void profiler_branch(Profiler *profiler, int from, int to);
+void profiler_set_names(Profiler *profiler, const char *const *names, int count);
+
+#endif
@@ -0,0 +1,101 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "timer.h"
+
+#if defined(TIMER_SYSTICK)
+#include "pico/time.h"
+#include "hardware/clocks.h"
+#else
+#include <time.h>
+#endif
+
+#define CALIBRATION_ROUNDS 1000
+
+double timer_ns_per_tick = 1.0;
+double timer_overhead_ns = 0.0;
+
+#if !defined(TIMER_SYSTICK)
+static uint64_t clock_ns(clockid_t id) {
+    struct timespec ts;
+    clock_gettime(id, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+#if defined(TIMER_CLOCK_GETTIME)
+#ifdef CLOCK_MONOTONIC_RAW
+#define RAW_CLOCK CLOCK_MONOTONIC_RAW
+#else
+#define RAW_CLOCK CLOCK_MONOTONIC
+#endif
+
+ticks_t timer_ticks(void) {
+    return clock_ns(RAW_CLOCK);
+}
+#endif
+
+uint64_t timer_now_ns(void) {
+#if defined(TIMER_SYSTICK)
+    return time_us_64() * 1000;
+#else
+    return clock_ns(CLOCK_MONOTONIC);
+#endif
+}
+
+ticks_t timer_elapsed(ticks_t start, ticks_t end) {
+#if defined(TIMER_SYSTICK)
+    return (start - end) & 0xffffff;   // counts down and wraps at 24 bits
+#else
+    return end - start;
+#endif
+}
+
+double timer_ns(ticks_t elapsed) {
+    double ns = elapsed * timer_ns_per_tick - timer_overhead_ns;
+    return ns > 0.0 ? ns : 0.0;
+}
+
+const char *timer_name(void) {
+#if defined(TIMER_SYSTICK)
+    return "SysTick";
+#elif defined(TIMER_TSC)
+    return "rdtsc";
+#elif defined(TIMER_CNTVCT)
+    return "cntvct_el0";
+#else
+    return "clock_gettime";
+#endif
+}
+
+void timer_init(void) {
+#if defined(TIMER_SYSTICK)
+    systick_hw->rvr = 0xffffff;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;             // enable, processor clock
+    timer_ns_per_tick = 1e9 / clock_get_hz(clk_sys);
+#elif defined(TIMER_TSC)
+    // the TSC rate is not exposed, so time it against the monotonic clock
+    uint64_t ns0 = clock_ns(CLOCK_MONOTONIC);
+    ticks_t t0 = timer_ticks();
+    while (clock_ns(CLOCK_MONOTONIC) - ns0 < 20000000)
+        ;
+    uint64_t ns1 = clock_ns(CLOCK_MONOTONIC);
+    ticks_t t1 = timer_ticks();
+    timer_ns_per_tick = (double)(ns1 - ns0) / (double)(t1 - t0);
+#elif defined(TIMER_CNTVCT)
+    uint64_t freq;
+    __asm__ volatile("mrs %0, cntfrq_el0" : "=r"(freq));
+    timer_ns_per_tick = 1e9 / (double)freq;
+#endif
+
+    // the least a back-to-back pair of reads ever took
+    ticks_t best = (ticks_t)-1;
+    for (int i = 0; i < CALIBRATION_ROUNDS; i++) {
+        ticks_t a = timer_ticks();
+        ticks_t b = timer_ticks();
+        ticks_t d = timer_elapsed(a, b);
+        if (d < best)
+            best = d;
+    }
+    timer_overhead_ns = best * timer_ns_per_tick;
+}
@@ -0,0 +1,53 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdint.h>
+
+// Timing backend for the profiler. The fastest counter available is read
+// inline around every opcode; timer_init() works out how long a tick is
+// and what one pair of reads costs, so the profiler can report ns.
+//
+//   Pico (PICO_ON_DEVICE)   SysTick, CPU clock, 24 bits counting down
+//   x86-64                  rdtsc
+//   AArch64                 cntvct_el0
+//   otherwise               clock_gettime(CLOCK_MONOTONIC_RAW)
+//
+// -DTIMER_CLOCK forces clock_gettime on any host.
+
+typedef uint64_t ticks_t;
+
+#if defined(PICO_ON_DEVICE)
+#include "hardware/structs/systick.h"
+#define TIMER_SYSTICK
+static inline ticks_t timer_ticks(void) {
+    return systick_hw->cvr;
+}
+#elif defined(__x86_64__) && !defined(TIMER_CLOCK)
+#include <x86intrin.h>
+#define TIMER_TSC
+static inline ticks_t timer_ticks(void) {
+    _mm_lfence();   // keep earlier instructions out of the measurement
+    return __rdtsc();
+}
+#elif defined(__aarch64__) && !defined(TIMER_CLOCK)
+#define TIMER_CNTVCT
+static inline ticks_t timer_ticks(void) {
+    uint64_t t;
+    __asm__ volatile("isb; mrs %0, cntvct_el0" : "=r"(t) :: "memory");
+    return t;
+}
+#else
+#define TIMER_CLOCK_GETTIME
+ticks_t timer_ticks(void);
+#endif
+
+void timer_init(void);
+const char *timer_name(void);
+uint64_t timer_now_ns(void);               // for whole runs, never wraps
+ticks_t timer_elapsed(ticks_t start, ticks_t end);
+double timer_ns(ticks_t elapsed);
+
+extern double timer_ns_per_tick;
+extern double timer_overhead_ns;           // cost of one start/stop pair
+
+#endif
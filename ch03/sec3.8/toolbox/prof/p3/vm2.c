@@ -7,6 +7,15 @@
 
 Profiler profiler;
 
+static const char *const opcode_names[] = {
+	[ADD] = "ADD", [DEC] = "DEC", [EQ] = "EQ", [EQZ] = "EQZ", [HALT] = "HALT",
+	[INC] = "INC", [JP] = "JP", [JPNZ] = "JPNZ", [JPZ] = "JPZ", [LD] = "LD",
+	[LOAD] = "LOAD", [LT] = "LT", [MUL] = "MUL", [NA] = "NA", [NOP] = "NOP",
+	[PRINT] = "PRINT", [SET] = "SET", [SETZ] = "SETZ", [ST] = "ST",
+	[STORE] = "STORE", [SUB] = "SUB", [DROP] = "DROP", [DUP] = "DUP",
+	[OVER] = "OVER", [ROT] = "ROT", [SWAP] = "SWAP", [TWODUP] = "TWODUP"
+};
+
 VM* newVM(int* code, int pc, int datasize) {
 
 	VM* vm = (VM*) malloc(sizeof(VM));
@@ -53,12 +62,15 @@ int nextcode(VM* vm) {
 void run(VM* vm) {
 	int v, addr, offset, a, b, c;
 
+    profiler_set_names(&profiler, opcode_names, sizeof(opcode_names) / sizeof(opcode_names[0]));
     profiler_start(&profiler);
 
 	do {
 
+		int pc = vm->pc;
 		int opcode = nextcode(vm);
 
+        profiler_trace(&profiler, pc, opcode);
         profiler_opcode_start(&profiler, opcode);
 
 		switch (opcode) {
@@ -127,6 +139,7 @@ void run(VM* vm) {
 
 			case JP:
 				vm->pc = nextcode(vm);
+				profiler_branch(&profiler, pc, vm->pc);
 				break;
 
 			case JPNZ:
@@ -134,6 +147,7 @@ void run(VM* vm) {
 				v = pop(vm);
 				if (v != 0) {
 					vm->pc = addr;
+					profiler_branch(&profiler, pc, addr);
 				}
 				break;
 
@@ -142,6 +156,7 @@ void run(VM* vm) {
 				v = pop(vm);
 				if (v == 0) {
 					vm->pc = addr;
+					profiler_branch(&profiler, pc, addr);
 				}
 				break;
 
@@ -16,6 +16,10 @@
 #define DISPLAY_DC_PIN 16
 #define DISPLAY_RESET_PIN 21
 #define DISPLAY_BL_PIN 20
+// The panel's TE (tearing effect) output is not wired on the Display
+// Pack 2.0. Define DISPLAY_TE_PIN to the GPIO it is wired to, and vsync
+// follows the panel; without it vsync is timed from the nominal refresh
+// #define DISPLAY_TE_PIN 22
 
 // Button pins
 #define BUTTON_A_PIN 12
@@ -36,10 +40,79 @@ static volatile bool button_last_state[BUTTON_COUNT] = {false};
 static volatile uint32_t last_button_check = 0;
 static bool buttons_initialized = false;
 
-// DMA buffer for repeated pixel data (for solid fills)
-static uint8_t dma_fill_buffer[512]; // Buffer for repeated color data
 static uint8_t dma_single_pixel[2];  // Single pixel buffer for DMA
 
+// Vertical blank: TE rises as the panel starts its blanking interval,
+// the moment a frame can start going out without tearing
+#define DISPLAY_REFRESH_US 16667            // FRCTRL2 0x0F: 60 Hz
+static volatile uint64_t vblank_last_us = 0;
+static volatile uint32_t vblank_period_us = DISPLAY_REFRESH_US;
+static volatile uint32_t vblank_count = 0;
+
+// Command queue: fills and blits that the DMA interrupt sends one after
+// another, so the functions queueing them return at once. While it is
+// not empty dma_busy stays set, and every blocking write waits for it.
+#define DISPLAY_QUEUE_SIZE 16
+#define GLYPH_BYTES (5 * 8 * 2)
+
+typedef enum {
+    QUEUE_FILL,     // color over the window, DMA reading the one color word
+    QUEUE_BLIT,     // pixels the caller keeps until the queue is done
+    QUEUE_GLYPH,    // pixels in the command itself
+    QUEUE_INDEXED   // 8-bit indices, expanded through the palette by row
+} queue_op_t;
+
+typedef struct {
+    queue_op_t op;
+    uint16_t x0, y0, x1, y1;        // window, inclusive
+    uint16_t color;
+    const uint8_t* data;            // QUEUE_BLIT, QUEUE_GLYPH and QUEUE_INDEXED
+    uint32_t bytes;                 // per transfer
+    uint16_t rows;                  // transfers still to send, one per row
+    uint32_t stride;                // bytes from one row to the next
+    uint8_t glyph[GLYPH_BYTES];
+} queue_cmd_t;
+
+static queue_cmd_t queue[DISPLAY_QUEUE_SIZE];
+static volatile uint8_t queue_head = 0;     // command being sent
+static volatile uint8_t queue_tail = 0;     // next free slot
+static volatile bool queue_running = false;
+static uint32_t queue_pushed = 0;           // commands queued so far
+static volatile uint32_t queue_done = 0;    // ... and sent
+
+// Text: a string is rasterised into one of two line buffers and sent as
+// a single window, while the other buffer takes the next string.
+// Rasterised glyphs are cached by character and colour pair.
+#define TEXT_ROWS 8
+#define TEXT_BUFFER_BYTES (DISPLAY_WIDTH * TEXT_ROWS * 2)
+#define GLYPH_CACHE_SIZE 32
+
+static uint8_t text_buffer[2][TEXT_BUFFER_BYTES];
+static uint32_t text_buffer_seq[2];         // queue_pushed of its command
+static uint8_t text_next = 0;
+
+typedef struct {
+    char c;                         // 0 when the slot is empty
+    uint16_t color, bg_color;
+    uint8_t pixels[GLYPH_BYTES];    // 5 wide, 8 rows, big endian
+} glyph_cache_t;
+
+static glyph_cache_t glyph_cache[GLYPH_CACHE_SIZE];
+
+// Indexed blits: each row of 8-bit indices is expanded through the
+// palette into one of two line buffers. DMA sends one while the
+// interrupt expands the next row into the other.
+static uint16_t display_palette[256];
+static uint16_t indexed_line[2][DISPLAY_WIDTH];
+static uint8_t indexed_next = 0;            // line buffer to expand into
+
+static void indexed_expand(const uint8_t* indices, uint16_t width) {
+    uint16_t* line = indexed_line[indexed_next];
+    for (uint16_t i = 0; i < width; i++) {
+        line[i] = display_palette[indices[i]];
+    }
+}
+
 // Button pin mapping
 static const uint8_t button_pins[BUTTON_COUNT] = {
     BUTTON_A_PIN, BUTTON_B_PIN, BUTTON_X_PIN, BUTTON_Y_PIN
@@ -132,14 +205,154 @@ static inline void spi_wait_idle(void) {
     sleep_us(1);
 }
 
+// Command queue, run from the DMA interrupt
+
+// Send bytes to the display with DC set; waits only for the SPI FIFO
+static void queue_spi_write(bool data, const uint8_t* bytes, size_t len) {
+    gpio_put(DISPLAY_DC_PIN, data);
+    spi_write_blocking(spi0, bytes, len);
+    while (spi_is_busy(spi0)) tight_loop_contents();
+}
+
+static void queue_send(queue_cmd_t* cmd) {
+    dma_channel_config c = dma_channel_get_default_config(dma_channel);
+    channel_config_set_dreq(&c, spi_get_dreq(spi0, true));
+    channel_config_set_write_increment(&c, false);
+    
+    if (cmd->op == QUEUE_FILL) {
+        // The SPI sends 16-bit frames, MSB first, and the DMA reads the
+        // same color word for every pixel: no buffer to fill, and the
+        // whole window is a single transfer
+        spi_set_format(spi0, 16, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+        channel_config_set_read_increment(&c, false);
+        dma_channel_configure(dma_channel, &c, &spi_get_hw(spi0)->dr, &cmd->color, cmd->bytes / 2, true);
+        return;
+    }
+    
+    if (cmd->op == QUEUE_INDEXED) {
+        // Send the row expanded last time, then expand the next one into
+        // the other buffer while this one goes out
+        uint16_t width = cmd->x1 - cmd->x0 + 1;
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+        channel_config_set_read_increment(&c, true);
+        dma_channel_configure(dma_channel, &c, &spi_get_hw(spi0)->dr, indexed_line[indexed_next], width, true);
+        indexed_next ^= 1;
+        cmd->data += cmd->stride;
+        if (--cmd->rows > 0) {
+            indexed_expand(cmd->data, width);
+        }
+        return;
+    }
+    
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    dma_channel_configure(dma_channel, &c, &spi_get_hw(spi0)->dr, cmd->data, cmd->bytes, true);
+    cmd->data += cmd->stride;
+    cmd->rows--;
+}
+
+// Set the window of the command at the head and start sending it
+static void queue_start(void) {
+    queue_cmd_t* cmd = &queue[queue_head];
+    uint8_t caset[4] = {cmd->x0 >> 8, cmd->x0 & 0xFF, cmd->x1 >> 8, cmd->x1 & 0xFF};
+    uint8_t raset[4] = {cmd->y0 >> 8, cmd->y0 & 0xFF, cmd->y1 >> 8, cmd->y1 & 0xFF};
+    const uint8_t cmd_caset = 0x2A, cmd_raset = 0x2B, cmd_ramwr = 0x2C;
+    
+    gpio_put(DISPLAY_CS_PIN, 0);
+    queue_spi_write(false, &cmd_caset, 1);
+    queue_spi_write(true, caset, 4);
+    queue_spi_write(false, &cmd_raset, 1);
+    queue_spi_write(true, raset, 4);
+    queue_spi_write(false, &cmd_ramwr, 1);
+    gpio_put(DISPLAY_DC_PIN, 1);
+    
+    if (cmd->op == QUEUE_GLYPH) {
+        cmd->data = cmd->glyph;
+    } else if (cmd->op == QUEUE_INDEXED) {
+        // Palette colours go out as 16-bit frames, like fills
+        spi_set_format(spi0, 16, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+        indexed_expand(cmd->data, cmd->x1 - cmd->x0 + 1);
+    }
+    queue_send(cmd);
+}
+
+// A transfer ended: send the next row, or start the next command
+static void queue_continue(void) {
+    queue_cmd_t* cmd = &queue[queue_head];
+    if (cmd->op != QUEUE_FILL && cmd->rows > 0) {
+        // The window is still open, RAMWR goes on with the next row
+        queue_send(cmd);
+        return;
+    }
+    
+    // The last bytes are still in the FIFO when DMA ends
+    while (spi_is_busy(spi0)) tight_loop_contents();
+    if (cmd->op == QUEUE_FILL || cmd->op == QUEUE_INDEXED) {
+        spi_set_format(spi0, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+    }
+    gpio_put(DISPLAY_CS_PIN, 1);
+    
+    queue_head = (queue_head + 1) % DISPLAY_QUEUE_SIZE;
+    queue_done++;
+    if (queue_head != queue_tail) {
+        queue_start();
+    } else {
+        queue_running = false;
+        dma_busy = false;
+    }
+}
+
+// Add a command, waiting for a free slot if the queue is full
+static display_error_t queue_push(const queue_cmd_t* cmd) {
+    uint8_t next = (queue_tail + 1) % DISPLAY_QUEUE_SIZE;
+    uint32_t start = get_time_ms();
+    while (next == queue_head) {
+        if (get_time_ms() - start > 1000) return DISPLAY_ERROR_DMA_FAILED;
+        tight_loop_contents();
+    }
+    
+    queue[queue_tail] = *cmd;
+    
+    uint32_t interrupts = save_and_disable_interrupts();
+    queue_tail = next;
+    queue_pushed++;
+    if (!queue_running) {
+        queue_running = true;
+        dma_busy = true;
+        queue_start();
+    }
+    restore_interrupts(interrupts);
+    return DISPLAY_OK;
+}
+
 // DMA interrupt handler with safety checks
 void __isr dma_handler() {
     // Check if this is our channel and clear the interrupt
     if (dma_channel >= 0 && (dma_hw->ints0 & (1u << dma_channel))) {
         dma_hw->ints0 = 1u << dma_channel;
-        dma_busy = false;
+        if (queue_running) {
+            queue_continue();
+        } else {
+            dma_busy = false;
+        }
+    }
+}
+
+#ifdef DISPLAY_TE_PIN
+// TE rising edge: time it, and measure the panel's real refresh period
+static void te_irq_handler(void) {
+    if (gpio_get_irq_event_mask(DISPLAY_TE_PIN) & GPIO_IRQ_EDGE_RISE) {
+        gpio_acknowledge_irq(DISPLAY_TE_PIN, GPIO_IRQ_EDGE_RISE);
+        uint64_t now = time_us_64();
+        if (vblank_count > 0) {
+            vblank_period_us = (uint32_t)(now - vblank_last_us);
+        }
+        vblank_last_us = now;
+        vblank_count++;
     }
 }
+#endif
 
 // Init DMA with error checking
 static display_error_t dma_init(void) {
@@ -177,6 +390,14 @@ static void dma_wait_for_finish(void) {
             dma_channel_abort(dma_channel);
             dma_hw->ints0 = 1u << dma_channel; // Clear pending interrupt to prevent ghost IRQs
         }
+        // Drop whatever was still queued
+        if (queue_running) {
+            queue_running = false;
+            queue_head = queue_tail;
+            queue_done = queue_pushed;
+            spi_set_format(spi0, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+            gpio_put(DISPLAY_CS_PIN, 1);
+        }
         dma_busy = false;
     }
     // Wait for SPI FIFO to drain after DMA completes
@@ -381,7 +602,13 @@ display_error_t display_pack_init(void) {
     display_write_data(0x20);
     
     display_write_command(0xC6); // FRCTRL2
+#ifdef DISPLAY_TE_PIN
+    // A full frame takes 39 ms at 31.25 MHz. Started at TE it does not
+    // tear if it ends within two refreshes, so refresh at 40 Hz
+    display_write_data(0x1E);
+#else
     display_write_data(0x0F);
+#endif
     
     display_write_command(0xD0); // PWCTRL1
     display_write_data(0xA4);
@@ -408,6 +635,16 @@ display_error_t display_pack_init(void) {
     display_write_command(0x29); // DISPON
     sleep_ms(100);
     
+#ifdef DISPLAY_TE_PIN
+    display_write_command(0x35); // TEON
+    display_write_data(0x00);    // V-blank only
+    gpio_init(DISPLAY_TE_PIN);
+    gpio_set_dir(DISPLAY_TE_PIN, GPIO_IN);
+    gpio_add_raw_irq_handler(DISPLAY_TE_PIN, te_irq_handler);
+    gpio_set_irq_enabled(DISPLAY_TE_PIN, GPIO_IRQ_EDGE_RISE, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+#endif
+    
     // Turn on backlight
     gpio_put(DISPLAY_BL_PIN, 1);
     
@@ -433,6 +670,17 @@ display_error_t display_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16
     
     uint32_t pixel_count = (uint32_t)width * (uint32_t)height;
     
+    if (pixel_count > 32 && dma_initialized) {
+        // Large fills go to the queue and run in the background
+        queue_cmd_t cmd = {
+            .op = QUEUE_FILL,
+            .x0 = x, .y0 = y, .x1 = x + width - 1, .y1 = y + height - 1,
+            .color = color,
+            .bytes = pixel_count * 2
+        };
+        return queue_push(&cmd);
+    }
+    
     // Set window with inclusive end coordinates
     display_error_t result = display_set_window(x, y, x + width - 1, y + height - 1);
     if (result != DISPLAY_OK) return result;
@@ -443,45 +691,12 @@ display_error_t display_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16
     gpio_put(DISPLAY_DC_PIN, 1);
     gpio_put(DISPLAY_CS_PIN, 0);
     
-    if (pixel_count > 32 && dma_initialized) {
-        // Use DMA for large fills
-        size_t buffer_pixels = sizeof(dma_fill_buffer) / 2;
-        
-        // Fill the entire buffer with the color
-        for (size_t i = 0; i < buffer_pixels; i++) {
-            dma_fill_buffer[i * 2] = color_bytes[0];
-            dma_fill_buffer[i * 2 + 1] = color_bytes[1];
-        }
-        
-        // Send full buffer chunks
-        uint32_t full_chunks = pixel_count / buffer_pixels;
-        for (uint32_t i = 0; i < full_chunks; i++) {
-            result = dma_spi_write_buffer(dma_fill_buffer, sizeof(dma_fill_buffer));
-            if (result != DISPLAY_OK) break;
-            // Wait for each chunk to complete before starting next
-            dma_wait_for_finish();
-        }
-        
-        // Send remaining pixels
-        if (result == DISPLAY_OK) {
-            uint32_t remaining = pixel_count % buffer_pixels;
-            if (remaining > 0) {
-                result = dma_spi_write_buffer(dma_fill_buffer, remaining * 2);
-                // Wait for final chunk to complete
-                dma_wait_for_finish();
-            }
-        }
-    } else {
-        // Use blocking SPI for small fills
-        for (uint32_t i = 0; i < pixel_count; i++) {
-            spi_write_blocking(spi0, color_bytes, 2);
-        }
-        // Ensure SPI is idle after blocking writes
-        spi_wait_idle();
+    // Use blocking SPI for small fills
+    for (uint32_t i = 0; i < pixel_count; i++) {
+        spi_write_blocking(spi0, color_bytes, 2);
     }
-    
-    // Ensure all data is sent before raising CS
-    dma_wait_for_finish();
+    // Ensure SPI is idle after blocking writes
+    spi_wait_idle();
     gpio_put(DISPLAY_CS_PIN, 1);
     
     return result;
@@ -512,6 +727,191 @@ display_error_t display_blit_full(const uint16_t *pixels) {
     return result;
 }
 
+display_error_t display_blit_full_async(const uint16_t *pixels) {
+    if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
+    if (!pixels) return DISPLAY_ERROR_INVALID_PARAM;
+    if (!dma_initialized) return display_blit_full(pixels);
+    
+    queue_cmd_t cmd = {
+        .op = QUEUE_BLIT,
+        .x0 = 0, .y0 = 0, .x1 = DISPLAY_WIDTH - 1, .y1 = DISPLAY_HEIGHT - 1,
+        .data = (const uint8_t *)pixels,
+        .bytes = DISPLAY_WIDTH * DISPLAY_HEIGHT * 2,
+        .rows = 1
+    };
+    return queue_push(&cmd);
+}
+
+display_error_t display_blit_rect_async(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                                        const uint16_t *pixels, uint16_t stride) {
+    if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
+    if (!pixels || stride < width) return DISPLAY_ERROR_INVALID_PARAM;
+    if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
+    
+    // Clip to the display; the rows keep their stride
+    if (x + width > DISPLAY_WIDTH) width = DISPLAY_WIDTH - x;
+    if (y + height > DISPLAY_HEIGHT) height = DISPLAY_HEIGHT - y;
+    if (width == 0 || height == 0) return DISPLAY_OK;
+    
+    if (!dma_initialized) {
+        display_error_t result = display_set_window(x, y, x + width - 1, y + height - 1);
+        if (result != DISPLAY_OK) return result;
+        gpio_put(DISPLAY_DC_PIN, 1);
+        gpio_put(DISPLAY_CS_PIN, 0);
+        for (uint16_t row = 0; row < height; row++) {
+            spi_write_blocking(spi0, (const uint8_t *)&pixels[(size_t)row * stride], width * 2);
+        }
+        spi_wait_idle();
+        gpio_put(DISPLAY_CS_PIN, 1);
+        return DISPLAY_OK;
+    }
+    
+    // Rows that follow each other in memory are one transfer
+    bool packed = stride == width;
+    queue_cmd_t cmd = {
+        .op = QUEUE_BLIT,
+        .x0 = x, .y0 = y, .x1 = x + width - 1, .y1 = y + height - 1,
+        .data = (const uint8_t *)pixels,
+        .bytes = packed ? (uint32_t)width * height * 2 : (uint32_t)width * 2,
+        .rows = packed ? 1 : height,
+        .stride = (uint32_t)stride * 2
+    };
+    return queue_push(&cmd);
+}
+
+display_error_t display_blit_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                                  const uint16_t *pixels, uint16_t stride) {
+    display_error_t result = display_blit_rect_async(x, y, width, height, pixels, stride);
+    dma_wait_for_finish();
+    return result;
+}
+
+display_error_t display_set_palette(uint8_t first, uint16_t count, const uint16_t *colors) {
+    if (!colors || first + count > 256) return DISPLAY_ERROR_INVALID_PARAM;
+    
+    // An indexed blit still in the queue keeps the colours it was sent with
+    dma_wait_for_finish();
+    memcpy(&display_palette[first], colors, count * sizeof(uint16_t));
+    return DISPLAY_OK;
+}
+
+display_error_t display_blit_indexed_async(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                                           const uint8_t *indices, uint16_t stride) {
+    if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
+    if (!indices || stride < width) return DISPLAY_ERROR_INVALID_PARAM;
+    if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
+    
+    if (x + width > DISPLAY_WIDTH) width = DISPLAY_WIDTH - x;
+    if (y + height > DISPLAY_HEIGHT) height = DISPLAY_HEIGHT - y;
+    if (width == 0 || height == 0) return DISPLAY_OK;
+    
+    if (!dma_initialized) {
+        display_error_t result = display_set_window(x, y, x + width - 1, y + height - 1);
+        if (result != DISPLAY_OK) return result;
+        gpio_put(DISPLAY_DC_PIN, 1);
+        gpio_put(DISPLAY_CS_PIN, 0);
+        for (uint16_t row = 0; row < height; row++) {
+            const uint8_t *src = &indices[(size_t)row * stride];
+            uint8_t *line = (uint8_t *)indexed_line[0];
+            for (uint16_t i = 0; i < width; i++) {
+                uint16_t color = display_palette[src[i]];
+                line[i * 2] = color >> 8;
+                line[i * 2 + 1] = color & 0xFF;
+            }
+            spi_write_blocking(spi0, line, width * 2);
+        }
+        spi_wait_idle();
+        gpio_put(DISPLAY_CS_PIN, 1);
+        return DISPLAY_OK;
+    }
+    
+    queue_cmd_t cmd = {
+        .op = QUEUE_INDEXED,
+        .x0 = x, .y0 = y, .x1 = x + width - 1, .y1 = y + height - 1,
+        .data = indices,
+        .rows = height,
+        .stride = stride
+    };
+    return queue_push(&cmd);
+}
+
+display_error_t display_blit_indexed(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                                     const uint8_t *indices, uint16_t stride) {
+    display_error_t result = display_blit_indexed_async(x, y, width, height, indices, stride);
+    dma_wait_for_finish();
+    return result;
+}
+
+uint64_t display_wait_vblank(void) {
+#ifdef DISPLAY_TE_PIN
+    uint32_t seen = vblank_count;
+    uint64_t start = time_us_64();
+    while (vblank_count == seen) {
+        // No edges: TE is not connected after all, give up after a few frames
+        if (time_us_64() - start > 4 * DISPLAY_REFRESH_US) {
+            vblank_last_us = time_us_64();
+            break;
+        }
+        tight_loop_contents();
+    }
+#else
+    // Next tick of a clock at the nominal refresh, in phase with the last
+    uint64_t now = time_us_64();
+    uint64_t next = vblank_last_us + DISPLAY_REFRESH_US;
+    if (vblank_count == 0 || next < now) {
+        next = now;
+    }
+    while (time_us_64() < next) {
+        tight_loop_contents();
+    }
+    vblank_last_us = next;
+    vblank_count++;
+#endif
+    return vblank_last_us;
+}
+
+uint64_t display_vblank_time_us(void) {
+    return vblank_last_us;
+}
+
+uint32_t display_refresh_period_us(void) {
+    return vblank_period_us;
+}
+
+display_error_t display_present_vsync(const uint16_t *pixels) {
+    if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
+    if (!pixels) return DISPLAY_ERROR_INVALID_PARAM;
+    
+    // Anything still queued would hold the frame back past the blank
+    dma_wait_for_finish();
+    display_wait_vblank();
+    return display_blit_full_async(pixels);
+}
+
+// Rasterised glyph of c in these colours, from the cache if it is there
+static const uint8_t* glyph_pixels(char c, uint16_t color, uint16_t bg_color) {
+    uint32_t slot = ((uint32_t)c * 31u + color * 7u + bg_color) % GLYPH_CACHE_SIZE;
+    glyph_cache_t *entry = &glyph_cache[slot];
+    if (entry->c == c && entry->color == color && entry->bg_color == bg_color) {
+        return entry->pixels;
+    }
+    
+    const uint8_t *char_data = font5x8[c - 32];
+    uint8_t *out = entry->pixels;
+    for (int row = 0; row < 8; row++) {
+        for (int col = 0; col < 5; col++) {
+            uint8_t line = char_data[4 - col]; // Reverse column order
+            uint16_t pixel_color = (line & (1 << row)) ? color : bg_color;
+            *out++ = pixel_color >> 8;
+            *out++ = pixel_color & 0xFF;
+        }
+    }
+    entry->c = c;
+    entry->color = color;
+    entry->bg_color = bg_color;
+    return entry->pixels;
+}
+
 display_error_t display_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg_color) {
     if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
     if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
@@ -520,6 +920,23 @@ display_error_t display_draw_char(uint16_t x, uint16_t y, char c, uint16_t color
     
     const uint8_t *char_data = font5x8[c - 32];
     
+    if (dma_initialized) {
+        // Copy the glyph into the command and queue it as one window
+        int cols = (DISPLAY_WIDTH - x < 5) ? DISPLAY_WIDTH - x : 5;
+        int rows = (DISPLAY_HEIGHT - y < 8) ? DISPLAY_HEIGHT - y : 8;
+        queue_cmd_t cmd = {
+            .op = QUEUE_GLYPH,
+            .x0 = x, .y0 = y, .x1 = x + cols - 1, .y1 = y + rows - 1,
+            .bytes = cols * rows * 2,
+            .rows = 1
+        };
+        const uint8_t *glyph = glyph_pixels(c, color, bg_color);
+        for (int row = 0; row < rows; row++) {
+            memcpy(&cmd.glyph[row * cols * 2], &glyph[row * 10], cols * 2);
+        }
+        return queue_push(&cmd);
+    }
+    
     // Draw character bitmap with bounds checking
     for (int col = 0; col < 5 && (x + col) < DISPLAY_WIDTH; col++) {
         uint8_t line = char_data[4 - col]; // Reverse column order
@@ -537,6 +954,48 @@ display_error_t display_draw_string(uint16_t x, uint16_t y, const char* str, uin
     if (!str) return DISPLAY_ERROR_INVALID_PARAM;
     if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
     
+    if (dma_initialized && *str) {
+        // The whole string as one window: glyphs 5 wide, with a column of
+        // the background colour between them
+        size_t len = strlen(str);
+        uint32_t width = len * 6 - 1;
+        if (width > (uint32_t)(DISPLAY_WIDTH - x)) width = DISPLAY_WIDTH - x;
+        int rows = (DISPLAY_HEIGHT - y < TEXT_ROWS) ? DISPLAY_HEIGHT - y : TEXT_ROWS;
+        
+        // Wait until the command that last used this buffer is sent
+        uint8_t *buf = text_buffer[text_next];
+        uint32_t start = get_time_ms();
+        while ((int32_t)(queue_done - text_buffer_seq[text_next]) < 0) {
+            if (get_time_ms() - start > 1000) return DISPLAY_ERROR_DMA_FAILED;
+            tight_loop_contents();
+        }
+        
+        uint8_t bg[2] = {bg_color >> 8, bg_color & 0xFF};
+        for (uint32_t col = 0; col < width; col += 6) {
+            char c = str[col / 6];
+            if (c < 32 || c > 90) c = 32; // Space for unsupported chars
+            const uint8_t *glyph = glyph_pixels(c, color, bg_color);
+            uint32_t cols = (width - col < 5) ? width - col : 5;
+            for (int row = 0; row < rows; row++) {
+                uint8_t *out = &buf[(row * width + col) * 2];
+                memcpy(out, &glyph[row * 10], cols * 2);
+                if (col + 5 < width) memcpy(out + 10, bg, 2);
+            }
+        }
+        
+        queue_cmd_t cmd = {
+            .op = QUEUE_BLIT,
+            .x0 = x, .y0 = y, .x1 = x + width - 1, .y1 = y + rows - 1,
+            .data = buf,
+            .bytes = width * rows * 2,
+            .rows = 1
+        };
+        display_error_t result = queue_push(&cmd);
+        text_buffer_seq[text_next] = queue_pushed;
+        text_next ^= 1;
+        return result;
+    }
+    
     int offset_x = 0;
     while (*str && (x + offset_x) < DISPLAY_WIDTH) {
         display_error_t result = display_draw_char(x + offset_x, y, *str, color, bg_color);
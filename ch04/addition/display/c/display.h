@@ -46,6 +46,32 @@ display_error_t display_clear(uint16_t color);
 display_error_t display_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color);
 display_error_t display_draw_pixel(uint16_t x, uint16_t y, uint16_t color);
 display_error_t display_blit_full(const uint16_t *pixels);
+// Queue the frame and return; pixels must stay unchanged until
+// display_dma_busy() is false
+display_error_t display_blit_full_async(const uint16_t *pixels);
+// Send a rectangle of pixels: pixels is its top left pixel and stride the
+// pixels from one row to the next, so with &fb[y * DISPLAY_WIDTH + x] and
+// DISPLAY_WIDTH it sends that part of a full framebuffer fb
+display_error_t display_blit_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                                  const uint16_t *pixels, uint16_t stride);
+display_error_t display_blit_rect_async(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                                        const uint16_t *pixels, uint16_t stride);
+// Indexed mode: a framebuffer of 8-bit palette indices, half the memory
+// of RGB565. Rows are expanded through the palette as they are sent.
+// Palette entries are RGB565 like the COLOR_ values; changing them and
+// sending the frame again is enough for palette cycling
+display_error_t display_set_palette(uint8_t first, uint16_t count, const uint16_t *colors);
+display_error_t display_blit_indexed(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                                     const uint8_t *indices, uint16_t stride);
+display_error_t display_blit_indexed_async(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                                           const uint8_t *indices, uint16_t stride);
+// Vsync: wait for the panel's vertical blank (its TE signal when wired,
+// else the nominal 60 Hz), then queue the full frame. Frame loops pace
+// on display_vblank_time_us(), the time of that blank in time_us_64()
+display_error_t display_present_vsync(const uint16_t *pixels);
+uint64_t display_wait_vblank(void);
+uint64_t display_vblank_time_us(void);
+uint32_t display_refresh_period_us(void);
 display_error_t display_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg_color);
 display_error_t display_draw_string(uint16_t x, uint16_t y, const char* str, uint16_t color, uint16_t bg_color);
 display_error_t display_set_backlight(bool on);
@@ -60,6 +86,8 @@ display_error_t button_set_callback(button_t button, button_callback_t callback)
 
 // Utility functions
 bool display_is_initialized(void);
+// Fills, text and async blits are queued and sent by DMA in the
+// background; busy until the queue is empty
 bool display_dma_busy(void);
 void display_wait_for_dma(void);
 void display_cleanup(void);
@@ -11,10 +11,16 @@ static struct {
     uint8_t selected_index;
     menu_state_t state;
     menu_style_t style;
-    bool needs_redraw;
+    bool needs_redraw;          // something changed since the last render
+    bool full_redraw;           // ... and the whole panel must be painted
+    uint8_t dirty_items;        // bit per item whose row must be repainted
+    uint8_t drawn_selected;     // selection the panel shows now
     uint32_t last_button_time;
 } menu_ctx;
 
+#define ITEM_TOP 20             // first item row, below the title bar
+#define ITEM_HEIGHT 18
+
 // Default style configuration
 const menu_style_t default_menu_style = {
     .x = 40,
@@ -43,6 +49,18 @@ static uint32_t get_time_ms(void) {
     return to_ms_since_boot(get_absolute_time());
 }
 
+// Internal: change tracking. A new menu or style repaints the panel;
+// an item change or a move of the selection repaints only its rows
+static void mark_full_redraw(void) {
+    menu_ctx.full_redraw = true;
+    menu_ctx.needs_redraw = true;
+}
+
+static void mark_item_dirty(uint8_t index) {
+    menu_ctx.dirty_items |= (uint8_t)(1u << index);
+    menu_ctx.needs_redraw = true;
+}
+
 // Internal: navigate menu
 static void navigate_up(void) {
     if (menu_ctx.selected_index > 0) {
@@ -64,7 +82,7 @@ static void enter_submenu(menu_t *submenu) {
         menu_ctx.menu_stack[menu_ctx.stack_depth++] = menu_ctx.current_menu;
         menu_ctx.current_menu = submenu;
         menu_ctx.selected_index = 0;
-        menu_ctx.needs_redraw = true;
+        mark_full_redraw();
     }
 }
 
@@ -72,7 +90,7 @@ static void go_back(void) {
     if (menu_ctx.stack_depth > 0) {
         menu_ctx.current_menu = menu_ctx.menu_stack[--menu_ctx.stack_depth];
         menu_ctx.selected_index = 0;
-        menu_ctx.needs_redraw = true;
+        mark_full_redraw();
     } else {
         osd_menu_hide();
     }
@@ -104,7 +122,7 @@ static void activate_item(void) {
                 if (item->data.toggle.callback) {
                     item->data.toggle.callback(*item->data.toggle.value);
                 }
-                menu_ctx.needs_redraw = true;
+                mark_item_dirty(menu_ctx.selected_index);
             }
             break;
             
@@ -133,7 +151,7 @@ static void adjust_value(int direction) {
             if (item->data.value.callback) {
                 item->data.value.callback(*val);
             }
-            menu_ctx.needs_redraw = true;
+            mark_item_dirty(menu_ctx.selected_index);
         }
     }
 }
@@ -186,12 +204,13 @@ void osd_menu_set_root(menu_t *menu) {
     menu_ctx.current_menu = menu;
     menu_ctx.stack_depth = 0;
     menu_ctx.selected_index = 0;
+    mark_full_redraw();
 }
 
 void osd_menu_show(void) {
     if (menu_ctx.state != MENU_STATE_VISIBLE && menu_ctx.current_menu) {
         menu_ctx.state = MENU_STATE_VISIBLE;
-        menu_ctx.needs_redraw = true;
+        mark_full_redraw();
     }
 }
 
@@ -215,7 +234,7 @@ bool osd_menu_is_visible(void) {
 void osd_menu_set_style(const menu_style_t *style) {
     if (style) {
         menu_ctx.style = *style;
-        menu_ctx.needs_redraw = true;
+        mark_full_redraw();
     }
 }
 
@@ -237,20 +256,85 @@ void osd_menu_update(void) {
     }
 }
 
-void osd_menu_render(void) {
-    if (!menu_ctx.current_menu) return;
+// Items below the panel's bottom edge are not drawn
+static bool item_row_visible(uint8_t index) {
+    const menu_style_t *s = &menu_ctx.style;
+    return index == 0 || s->y + ITEM_TOP + (index + 1) * ITEM_HEIGHT <= s->y + s->height;
+}
+
+// Draw one item row. Over a freshly painted panel only the selection
+// needs its background; a row repainted on its own is cleared first.
+static void render_item(uint8_t index, bool clear_row) {
+    menu_style_t *s = &menu_ctx.style;
+    menu_item_t *item = &menu_ctx.current_menu->items[index];
+    bool is_selected = (index == menu_ctx.selected_index);
+    uint16_t item_y = s->y + ITEM_TOP + index * ITEM_HEIGHT;
     
-    // Only redraw if needed
-    if (!menu_ctx.needs_redraw) return;
+    uint16_t bg = is_selected ? s->selected_bg_color : s->bg_color;
+    uint16_t fg = item->enabled ? 
+                 (is_selected ? s->selected_text_color : s->text_color) :
+                 s->disabled_color;
     
-    menu_style_t *s = &menu_ctx.style;
+    // Draw item background if selected
+    if (is_selected || clear_row) {
+        display_fill_rect(s->x + 2, item_y, s->width - 4, ITEM_HEIGHT, bg);
+    }
     
-    if (menu_ctx.state == MENU_STATE_HIDDEN) {
-        // Could restore background here if we saved it
-        menu_ctx.needs_redraw = false;
-        return;
+    // Build item text with value/state indicators
+    char item_text[MENU_ITEM_MAX_LEN + 16];
+    snprintf(item_text, sizeof(item_text), "%s", item->text);
+    
+    // Add indicators based on type
+    switch (item->type) {
+        case MENU_ITEM_SUBMENU:
+            strcat(item_text, " >");
+            break;
+            
+        case MENU_ITEM_TOGGLE:
+            if (item->data.toggle.value) {
+                strcat(item_text, *item->data.toggle.value ? " ON" : " OFF");
+            }
+            break;
+            
+        case MENU_ITEM_VALUE:
+            if (item->data.value.value) {
+                char val_str[12]; // NB: UPPER CASE
+                snprintf(val_str, sizeof(val_str), " %d", *item->data.value.value);
+                strcat(item_text, val_str);
+            }
+            break;
+            
+        case MENU_ITEM_BACK:
+            // Could add back arrow
+            break;
+            
+        default:
+            break;
     }
     
+    // Draw item text
+    display_draw_string(s->x + 6, item_y + 5, item_text, fg, bg);
+}
+
+// Repaint only the rows that changed: dirty items, and the rows the
+// selection left and moved to
+static void render_dirty_items(void) {
+    uint8_t dirty = menu_ctx.dirty_items;
+    if (menu_ctx.drawn_selected != menu_ctx.selected_index) {
+        dirty |= (uint8_t)(1u << menu_ctx.drawn_selected);
+        dirty |= (uint8_t)(1u << menu_ctx.selected_index);
+    }
+    
+    for (uint8_t i = 0; i < menu_ctx.current_menu->item_count; i++) {
+        if ((dirty & (1u << i)) && item_row_visible(i)) {
+            render_item(i, true);
+        }
+    }
+}
+
+static void render_full(void) {
+    menu_style_t *s = &menu_ctx.style;
+    
     // Draw border
     display_fill_rect(s->x - 2, s->y - 2, s->width + 4, s->height + 4, s->border_color);
     
@@ -263,69 +347,37 @@ void osd_menu_render(void) {
                        s->title_text_color, s->title_bg_color);
     
     // Draw menu items
-    uint16_t item_y = s->y + 20;
-    const uint16_t item_height = 18;
-    
-    for (uint8_t i = 0; i < menu_ctx.current_menu->item_count; i++) {
-        menu_item_t *item = &menu_ctx.current_menu->items[i];
-        bool is_selected = (i == menu_ctx.selected_index);
-        
-        uint16_t bg = is_selected ? s->selected_bg_color : s->bg_color;
-        uint16_t fg = item->enabled ? 
-                     (is_selected ? s->selected_text_color : s->text_color) :
-                     s->disabled_color;
-        
-        // Draw item background if selected
-        if (is_selected) {
-            display_fill_rect(s->x + 2, item_y, s->width - 4, item_height, bg);
-        }
-        
-        // Build item text with value/state indicators
-        char item_text[MENU_ITEM_MAX_LEN + 16];
-        snprintf(item_text, sizeof(item_text), "%s", item->text);
-        
-        // Add indicators based on type
-        switch (item->type) {
-            case MENU_ITEM_SUBMENU:
-                strcat(item_text, " >");
-                break;
-                
-            case MENU_ITEM_TOGGLE:
-                if (item->data.toggle.value) {
-                    strcat(item_text, *item->data.toggle.value ? " ON" : " OFF");
-                }
-                break;
-                
-            case MENU_ITEM_VALUE:
-                if (item->data.value.value) {
-                    char val_str[12]; // NB: UPPER CASE
-                    snprintf(val_str, sizeof(val_str), " %d", *item->data.value.value);
-                    strcat(item_text, val_str);
-                }
-                break;
-                
-            case MENU_ITEM_BACK:
-                // Could add back arrow
-                break;
-                
-            default:
-                break;
-        }
-        
-        // Draw item text
-        display_draw_string(s->x + 6, item_y + 5, item_text, fg, bg);
-        
-        item_y += item_height;
-        
-        // Stop if we exceed menu bounds
-        if (item_y + item_height > s->y + s->height) break;
+    for (uint8_t i = 0; i < menu_ctx.current_menu->item_count && item_row_visible(i); i++) {
+        render_item(i, false);
     }
     
     // Draw help text at bottom
     const char *help = "A:SELECT B:BACK X/Y:ADJUST";
     display_draw_string(s->x + 4, s->y + s->height - 12, help, 
                        s->text_color, s->bg_color);
+}
+
+void osd_menu_render(void) {
+    if (!menu_ctx.current_menu) return;
     
+    // Only redraw if needed
+    if (!menu_ctx.needs_redraw) return;
+    
+    if (menu_ctx.state == MENU_STATE_HIDDEN) {
+        // Could restore background here if we saved it
+        menu_ctx.needs_redraw = false;
+        return;
+    }
+    
+    if (menu_ctx.full_redraw) {
+        render_full();
+    } else {
+        render_dirty_items();
+    }
+    
+    menu_ctx.drawn_selected = menu_ctx.selected_index;
+    menu_ctx.dirty_items = 0;
+    menu_ctx.full_redraw = false;
     menu_ctx.needs_redraw = false;
 }
 
@@ -407,5 +459,7 @@ void menu_add_back(menu_t *menu) {
 void menu_item_set_enabled(menu_t *menu, uint8_t index, bool enabled) {
     if (!menu || index >= menu->item_count) return;
     menu->items[index].enabled = enabled;
-    menu_ctx.needs_redraw = true;
+    if (menu == menu_ctx.current_menu) {
+        mark_item_dirty(index);
+    }
 }
@@ -484,6 +484,27 @@ display_error_t display_blit_full(const uint16_t *pixels) {
     return result;
 }
 
+// Pixels go out low byte first, so they are stored with the bytes of
+// each swapped
+display_error_t display_blit_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint16_t *pixels) {
+    if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
+    if (!pixels || width == 0 || height == 0) return DISPLAY_ERROR_INVALID_PARAM;
+    if (x + width > DISPLAY_WIDTH || y + height > DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
+
+    display_error_t result = display_set_window(x, y, x + width - 1, y + height - 1);
+    if (result != DISPLAY_OK) return result;
+
+    dma_wait_for_finish();
+    gpio_put(DISPLAY_DC_PIN, 1);
+    gpio_put(DISPLAY_CS_PIN, 0);
+
+    result = dma_spi_write_buffer((uint8_t *)pixels, (size_t)width * height * 2);
+    dma_wait_for_finish();
+
+    gpio_put(DISPLAY_CS_PIN, 1);
+    return result;
+}
+
 display_error_t display_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg_color) {
     if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
     if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
@@ -1,19 +1,42 @@
 #include "game.h"
 #include "sprites.h"
+#include "scheduler.h"
+#include "bitmap.h"
 #include <stdio.h>
+#include <math.h>
 #include <assert.h>
 
+// The level as a LEVEL_DUMP build printed it, loaded by game_init()
+#ifdef LEVEL_IMAGE
+#include "level_image.h"
+#endif
+
 // Configuration
 #define WORLD_WIDTH 2000  // Much larger world for scrolling
 #define GROUND_HEIGHT 220
+#define PLAYER_SIZE 16
+#define SKY_COLOR COLOR_CYAN
+
+// Extra enemies and coins spread over the level, to measure collision
+// on the device (e.g. -DSTRESS_ENTITIES=400)
+#ifndef STRESS_ENTITIES
+#define STRESS_ENTITIES 0
+#endif
+
+// Set to 0 to let every broadphase query return all colliders, which is
+// testing every pair, to compare against the grid
+#ifndef BROADPHASE_GRID
+#define BROADPHASE_GRID 1
+#endif
 
 // Helpers
 
 static unsigned int hash(int key) {
-    key = ((key >> 16) ^ key) * 0x45d9f3b;
-    key = ((key >> 16) ^ key) * 0x45d9f3b;
-    key = (key >> 16) ^ key;
-    return (unsigned int)key;
+    unsigned int h = (unsigned int)key;
+    h = ((h >> 16) ^ h) * 0x45d9f3bu;
+    h = ((h >> 16) ^ h) * 0x45d9f3bu;
+    h = (h >> 16) ^ h;
+    return h;
 }
 
 void array_init(Array* arr, int elem_size) {
@@ -53,6 +76,26 @@ void array_remove(Array* arr, int index) {
     arr->size--;
 }
 
+// make room for size elements and set the size, new elements are not cleared
+void array_resize(Array* arr, int size) {
+    assert(arr && size >= 0);
+    if (size > arr->capacity) {
+        if (arr->capacity == 0) arr->capacity = 8;
+        while (arr->capacity < size) arr->capacity *= 2;
+        void* new_data = realloc(arr->data, arr->capacity * arr->elem_size);
+        assert(new_data && "Array reallocation failed");
+        arr->data = new_data;
+    }
+    arr->size = size;
+}
+
+void array_add_bytes(Array* arr, const void* bytes, int count) {
+    assert(arr && bytes && arr->elem_size == 1);
+    int at = arr->size;
+    array_resize(arr, at + count);
+    memcpy((char*)arr->data + at, bytes, count);
+}
+
 void array_free(Array* arr) {
     if (!arr) return;
     free(arr->data);
@@ -63,302 +106,439 @@ void array_free(Array* arr) {
 
 void hashmap_init(HashMap* map, int capacity) {
     assert(map && capacity > 0);
-    map->entries = calloc(capacity, sizeof(MapEntry));
+    int size = 8;
+    while (size < capacity) size *= 2;
+    map->entries = calloc(size, sizeof(MapEntry));
     assert(map->entries && "HashMap allocation failed");
-    map->capacity = capacity;
+    map->capacity = size;
     map->size = 0;
 }
 
+// slot holding key, or the empty slot where it would go
+static int hashmap_find(HashMap* map, int key) {
+    int mask = map->capacity - 1;
+    int i = hash(key) & mask;
+    while (map->entries[i].value && map->entries[i].key != key) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static void hashmap_grow(HashMap* map) {
+    MapEntry* old = map->entries;
+    int old_capacity = map->capacity;
+    
+    map->capacity *= 2;
+    map->entries = calloc(map->capacity, sizeof(MapEntry));
+    assert(map->entries && "HashMap reallocation failed");
+    for (int i = 0; i < old_capacity; i++) {
+        if (old[i].value) map->entries[hashmap_find(map, old[i].key)] = old[i];
+    }
+    free(old);
+}
+
 void hashmap_put(HashMap* map, int key, void* value) {
     assert(map && value);
     
-    unsigned int idx = hash(key) % map->capacity;
-    MapEntry* entry = &map->entries[idx];
+    // keep the table at most 3/4 full so probes stay short
+    if ((map->size + 1) * 4 > map->capacity * 3) hashmap_grow(map);
     
-    MapEntry* current = entry;
-    while (current && current->value) {
-        if (current->key == key) {
-            current->value = value;
-            return;
-        }
-        current = current->next;
-    }
-    
-    if (!entry->value) {
-        entry->key = key;
-        entry->value = value;
-        entry->next = NULL;
-    } else {
-        while (entry->next) entry = entry->next;
-        entry->next = malloc(sizeof(MapEntry));
-        assert(entry->next && "MapEntry allocation failed");
-        entry->next->key = key;
-        entry->next->value = value;
-        entry->next->next = NULL;
-    }
-    map->size++;
+    MapEntry* entry = &map->entries[hashmap_find(map, key)];
+    if (!entry->value) map->size++;
+    entry->key = key;
+    entry->value = value;
 }
 
 void* hashmap_get(HashMap* map, int key) {
-    if (!map) return NULL;
-    
-    unsigned int idx = hash(key) % map->capacity;
-    MapEntry* entry = &map->entries[idx];
-    
-    while (entry && entry->value) {
-        if (entry->key == key) return entry->value;
-        entry = entry->next;
-    }
-    return NULL;
+    if (!map || !map->entries) return NULL;
+    return map->entries[hashmap_find(map, key)].value;
 }
 
 int hashmap_contains(HashMap* map, int key) {
     return hashmap_get(map, key) != NULL;
 }
 
+// Backward shift: walk the run after the removed slot and move back
+// every entry whose home slot does not lie between the hole and itself,
+// so lookups never stop early at the hole.
 void hashmap_remove(HashMap* map, int key) {
-    if (!map) return;
+    if (!map || !map->entries) return;
     
-    unsigned int idx = hash(key) % map->capacity;
-    MapEntry* entry = &map->entries[idx];
-    MapEntry* prev = NULL;
+    int mask = map->capacity - 1;
+    int hole = hashmap_find(map, key);
+    if (!map->entries[hole].value) return;
     
-    while (entry && entry->value) {
-        if (entry->key == key) {
-            if (prev) {
-                prev->next = entry->next;
-                free(entry);
-            } else {
-                if (entry->next) {
-                    MapEntry* next = entry->next;
-                    entry->key = next->key;
-                    entry->value = next->value;
-                    entry->next = next->next;
-                    free(next);
-                } else {
-                    entry->value = NULL;
-                    entry->next = NULL;
-                }
-            }
-            map->size--;
-            return;
+    for (int j = (hole + 1) & mask; map->entries[j].value; j = (j + 1) & mask) {
+        int home = hash(map->entries[j].key) & mask;
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            map->entries[hole] = map->entries[j];
+            hole = j;
         }
-        prev = entry;
-        entry = entry->next;
     }
+    map->entries[hole].value = NULL;
+    map->size--;
 }
 
 void hashmap_free(HashMap* map) {
     if (!map) return;
-    
-    for (int i = 0; i < map->capacity; i++) {
-        MapEntry* entry = map->entries[i].next;
-        while (entry) {
-            MapEntry* next = entry->next;
-            free(entry);
-            entry = next;
-        }
-    }
     free(map->entries);
     map->entries = NULL;
     map->capacity = 0;
     map->size = 0;
 }
 
+// Archetypes
+
+static const int component_sizes[CT_COUNT] = {
+    [CT_POSITION]    = sizeof(PositionComponent),
+    [CT_VELOCITY]    = sizeof(VelocityComponent),
+    [CT_SPRITE]      = sizeof(SpriteComponent),
+    [CT_PLAYER]      = sizeof(PlayerComponent),
+    [CT_COLLIDER]    = sizeof(ColliderComponent),
+    [CT_PHYSICS]     = sizeof(PhysicsComponent),
+    [CT_ENEMY]       = sizeof(EnemyComponent),
+    [CT_PLATFORM]    = sizeof(PlatformComponent),
+    [CT_COLLECTIBLE] = sizeof(CollectibleComponent),
+    [CT_ANIMATION]   = sizeof(AnimationComponent),
+};
+
+static Archetype* archetype_create(uint32_t mask) {
+    Archetype* arch = calloc(1, sizeof(Archetype));
+    assert(arch);
+    arch->mask = mask;
+    arch->capacity = 8;
+    arch->entities = malloc(arch->capacity * sizeof(EntityID));
+    assert(arch->entities && "Archetype allocation failed");
+    for (int type = CT_POSITION; type < CT_COUNT; type++) {
+        if (mask & CT_BIT(type)) {
+            arch->columns[type] = malloc(arch->capacity * component_sizes[type]);
+            assert(arch->columns[type] && "Archetype allocation failed");
+        }
+    }
+    return arch;
+}
+
+static void archetype_free(Archetype* arch) {
+    for (int type = CT_POSITION; type < CT_COUNT; type++) {
+        free(arch->columns[type]);
+    }
+    free(arch->entities);
+    free(arch);
+}
+
+static void* archetype_cell(Archetype* arch, int type, int row) {
+    return (char*)arch->columns[type] + row * component_sizes[type];
+}
+
+// make room for at least capacity rows
+static void archetype_reserve(Archetype* arch, int capacity) {
+    if (capacity > arch->capacity) {
+        while (arch->capacity < capacity) arch->capacity *= 2;
+        EntityID* entities = realloc(arch->entities, arch->capacity * sizeof(EntityID));
+        assert(entities && "Archetype reallocation failed");
+        arch->entities = entities;
+        for (int type = CT_POSITION; type < CT_COUNT; type++) {
+            if (!arch->columns[type]) continue;
+            void* column = realloc(arch->columns[type], arch->capacity * component_sizes[type]);
+            assert(column && "Archetype reallocation failed");
+            arch->columns[type] = column;
+        }
+    }
+}
+
+// append a row for entity, the component values are left to the caller
+static int archetype_push(Archetype* arch, EntityID entity) {
+    archetype_reserve(arch, arch->count + 1);
+    arch->entities[arch->count] = entity;
+    return arch->count++;
+}
+
+// remove a row by moving the last row into it, so columns stay dense
+static void archetype_remove(World* world, Archetype* arch, int row) {
+    int last = arch->count - 1;
+    if (row != last) {
+        EntityID moved = arch->entities[last];
+        arch->entities[row] = moved;
+        for (int type = CT_POSITION; type < CT_COUNT; type++) {
+            if (!arch->columns[type]) continue;
+            memcpy(archetype_cell(arch, type, row), archetype_cell(arch, type, last),
+                   component_sizes[type]);
+        }
+        EntityRecord* record = array_get(&world->entities, entity_index(moved));
+        record->row = row;
+    }
+    arch->count--;
+}
+
+static Archetype* world_find_archetype(World* world, uint32_t mask) {
+    Archetype* arch = hashmap_get(&world->archetype_index, (int)mask);
+    if (arch) return arch;
+    
+    arch = archetype_create(mask);
+    array_add(&world->archetypes, &arch);
+    hashmap_put(&world->archetype_index, (int)mask, arch);
+    for (int q = 0; q < world->queries.size; q++) {
+        Query* query = *(Query**)array_get(&world->queries, q);
+        if ((mask & query->mask) == query->mask) array_add(&query->archetypes, &arch);
+    }
+    return arch;
+}
+
 // World
 
 void world_init(World* world) {
     assert(world);
-    world->next_entity_id = 1;
-    hashmap_init(&world->entity_components, 100);
-    hashmap_init(&world->components, 20);
-    hashmap_init(&world->component_entities, 20);
+    array_init(&world->entities, sizeof(EntityRecord));
+    world->free_entity = -1;
+    world->alive_count = 0;
+    array_init(&world->archetypes, sizeof(Archetype*));
+    hashmap_init(&world->archetype_index, 32);
+    array_init(&world->queries, sizeof(Query*));
+    hashmap_init(&world->query_index, 32);
     array_init(&world->systems, sizeof(System*));
-    array_init(&world->dead_entities, sizeof(EntityID));
+    commands_init(&world->commands);
+    array_init(&world->batch, sizeof(Command));
+    array_init(&world->created, sizeof(EntityID));
     world->camera_x = 0.0f;
     world->camera_y = 0.0f;
     world->game_over = false;
     world->score = 0;
     world->player_entity = 0;
+    world_find_archetype(world, 0);
+    scheduler_init();
+}
+
+Archetype* world_archetype(World* world, int index) {
+    Archetype** arch = array_get(&world->archetypes, index);
+    return arch ? *arch : NULL;
+}
+
+uint32_t component_mask(int* types, int count) {
+    uint32_t mask = 0;
+    for (int i = 0; i < count; i++) {
+        mask |= CT_BIT(types[i]);
+    }
+    return mask;
+}
+
+// The query for mask, created and filled from the existing archetypes
+// the first time it is asked for. Queries live as long as the world.
+Query* world_cached_query(World* world, uint32_t mask) {
+    assert(world);
+    
+    Query* query = hashmap_get(&world->query_index, (int)mask);
+    if (query) return query;
+    
+    query = malloc(sizeof(Query));
+    assert(query);
+    query->mask = mask;
+    array_init(&query->archetypes, sizeof(Archetype*));
+    for (int a = 0; a < world->archetypes.size; a++) {
+        Archetype* arch = world_archetype(world, a);
+        if ((arch->mask & mask) == mask) array_add(&query->archetypes, &arch);
+    }
+    array_add(&world->queries, &query);
+    hashmap_put(&world->query_index, (int)mask, query);
+    return query;
+}
+
+Archetype* query_archetype(Query* query, int index) {
+    Archetype** arch = array_get(&query->archetypes, index);
+    return arch ? *arch : NULL;
 }
 
+// The record of a live entity, NULL for stale or invalid IDs. The
+// pointer is good until the next entity is created.
+static EntityRecord* world_record(World* world, EntityID entity) {
+    if (entity <= 0) return NULL;
+    EntityRecord* record = array_get(&world->entities, entity_index(entity));
+    if (!record || !record->archetype || record->generation != entity_generation(entity)) return NULL;
+    return record;
+}
+
+// Reuses the record of a destroyed entity if there is one
 EntityID world_create_entity(World* world) {
     assert(world);
     
-    if (world->next_entity_id <= 0) {
-        return 0;
+    int index = world->free_entity;
+    if (index >= 0) {
+        EntityRecord* record = array_get(&world->entities, index);
+        world->free_entity = record->next_free;
+    } else {
+        if (world->entities.size > ENTITY_INDEX_MASK) {
+            return 0;
+        }
+        EntityRecord fresh = {NULL, 0, 1, -1};
+        index = world->entities.size;
+        array_add(&world->entities, &fresh);
     }
     
-    EntityID id = world->next_entity_id++;
-    Array* comp_types = malloc(sizeof(Array));
-    assert(comp_types);
-    array_init(comp_types, sizeof(int));
-    hashmap_put(&world->entity_components, id, comp_types);
+    EntityRecord* record = array_get(&world->entities, index);
+    EntityID id = entity_make(index, record->generation);
+    record->archetype = world_archetype(world, 0);
+    record->row = archetype_push(record->archetype, id);
+    record->next_free = -1;
+    world->alive_count++;
     return id;
 }
 
+// Move an entity to the archetype of mask, keeping the components both
+// have. Components it gains are left for the caller to set.
+static void world_move_entity(World* world, EntityRecord* record, uint32_t mask) {
+    Archetype* src = record->archetype;
+    if (src->mask == mask) return;
+    
+    EntityID entity = src->entities[record->row];
+    Archetype* dst = world_find_archetype(world, mask);
+    int row = archetype_push(dst, entity);
+    for (int t = CT_POSITION; t < CT_COUNT; t++) {
+        if (src->mask & mask & CT_BIT(t)) {
+            memcpy(archetype_cell(dst, t, row), archetype_cell(src, t, record->row),
+                   component_sizes[t]);
+        }
+    }
+    archetype_remove(world, src, record->row);
+    record->archetype = dst;
+    record->row = row;
+}
+
+// Adding a new type moves the entity to the archetype with that type,
+// so pointers from world_get_component are only good until the next
+// structural change. Systems use their command buffer instead.
 void world_add_component(World* world, EntityID entity, int type, void* data, int data_size) {
     assert(world && data && data_size > 0);
+    assert(type >= CT_POSITION && type < CT_COUNT && data_size == component_sizes[type]);
     
-    if (!hashmap_contains(&world->entity_components, entity)) return;
-    
-    HashMap* type_map = hashmap_get(&world->components, type);
-    if (!type_map) {
-        type_map = malloc(sizeof(HashMap));
-        assert(type_map);
-        hashmap_init(type_map, 100);
-        hashmap_put(&world->components, type, type_map);
-    }
+    EntityRecord* record = world_record(world, entity);
+    if (!record) return;
     
-    void* comp_copy = malloc(data_size);
-    assert(comp_copy);
-    memcpy(comp_copy, data, data_size);
-    hashmap_put(type_map, entity, comp_copy);
+    world_move_entity(world, record, record->archetype->mask | CT_BIT(type));
+    memcpy(archetype_cell(record->archetype, type, record->row), data, data_size);
+}
+
+void world_remove_component(World* world, EntityID entity, int type) {
+    if (!world || type < CT_POSITION || type >= CT_COUNT) return;
     
-    Array* entities_with_type = hashmap_get(&world->component_entities, type);
-    if (!entities_with_type) {
-        entities_with_type = malloc(sizeof(Array));
-        assert(entities_with_type);
-        array_init(entities_with_type, sizeof(EntityID));
-        hashmap_put(&world->component_entities, type, entities_with_type);
-    }
+    EntityRecord* record = world_record(world, entity);
+    if (!record) return;
     
-    bool already_has = false;
-    for (int i = 0; i < entities_with_type->size; i++) {
-        EntityID* e = array_get(entities_with_type, i);
-        if (e && *e == entity) {
-            already_has = true;
-            break;
-        }
-    }
-    if (!already_has) {
-        array_add(entities_with_type, &entity);
-    }
-    
-    Array* entity_comps = hashmap_get(&world->entity_components, entity);
-    if (entity_comps) {
-        array_add(entity_comps, &type);
-    }
+    world_move_entity(world, record, record->archetype->mask & ~CT_BIT(type));
 }
 
 void* world_get_component(World* world, EntityID entity, int type) {
-    if (!world) return NULL;
+    if (!world || type < CT_POSITION || type >= CT_COUNT) return NULL;
     
-    HashMap* type_map = hashmap_get(&world->components, type);
-    if (!type_map) return NULL;
-    return hashmap_get(type_map, entity);
+    EntityRecord* record = world_record(world, entity);
+    if (!record || !(record->archetype->mask & CT_BIT(type))) return NULL;
+    return archetype_cell(record->archetype, type, record->row);
+}
+
+// Entities destroyed through a command buffer live until it is applied
+bool world_is_alive(World* world, EntityID entity) {
+    if (!world) return false;
+    return world_record(world, entity) != NULL;
 }
 
 int world_has_component(World* world, EntityID entity, int type) {
-    if (!world) return 0;
-    
-    Array* entity_comps = hashmap_get(&world->entity_components, entity);
-    if (!entity_comps) return 0;
+    if (!world || type < CT_POSITION || type >= CT_COUNT) return 0;
     
-    for (int i = 0; i < entity_comps->size; i++) {
-        int* comp_type = array_get(entity_comps, i);
-        if (comp_type && *comp_type == type) return 1;
-    }
-    return 0;
+    EntityRecord* record = world_record(world, entity);
+    if (!record) return 0;
+    return (record->archetype->mask & CT_BIT(type)) != 0;
 }
 
+// Systems hold on to a cached query and iterate its archetypes; this
+// collects the entity IDs for callers that want a list.
 Array world_query(World* world, int* required, int req_count) {
     Array result;
     array_init(&result, sizeof(EntityID));
     
     if (!world || !required || req_count == 0) return result;
     
-    Array* base_set = hashmap_get(&world->component_entities, required[0]);
-    if (!base_set) return result;
-    
-    for (int i = 0; i < base_set->size; i++) {
-        EntityID* entity = array_get(base_set, i);
-        if (!entity) continue;
-        
-        bool is_dead = false;
-        for (int d = 0; d < world->dead_entities.size; d++) {
-            EntityID* dead = array_get(&world->dead_entities, d);
-            if (dead && *dead == *entity) {
-                is_dead = true;
-                break;
-            }
+    Query* query = world_cached_query(world, component_mask(required, req_count));
+    for (int a = 0; a < query->archetypes.size; a++) {
+        Archetype* arch = query_archetype(query, a);
+        for (int i = 0; i < arch->count; i++) {
+            array_add(&result, &arch->entities[i]);
         }
-        if (is_dead) continue;
-        
-        int has_all = 1;
-        for (int j = 1; j < req_count; j++) {
-            if (!world_has_component(world, *entity, required[j])) {
-                has_all = 0;
-                break;
-            }
-        }
-        if (has_all) array_add(&result, entity);
     }
     return result;
 }
 
 void world_add_system(World* world, System* system) {
-    assert(world && system);
+    assert(world && system && world->systems.size < WORLD_MAX_SYSTEMS);
+    commands_init(&system->commands);
     array_add(&world->systems, &system);
 }
 
+// Two systems conflict when one writes what the other reads or writes,
+// and there are entities both of them touch: an archetype that is not
+// empty has every component either requires. World state is shared
+// by all entities.
+static bool systems_conflict(World* world, System* a, System* b) {
+    uint32_t shared = (a->writes & (b->reads | b->writes)) | (b->writes & a->reads);
+    if (!shared) return false;
+    if (shared & WORLD_STATE) return true;
+    
+    uint32_t both = a->with | b->with;
+    for (int i = 0; i < world->archetypes.size; i++) {
+        Archetype* arch = world_archetype(world, i);
+        if (arch->count > 0 && (arch->mask & both) == both) return true;
+    }
+    return false;
+}
+
 void world_update(World* world, float dt) {
     if (!world) return;
     
-    for (int i = 0; i < world->dead_entities.size; i++) {
-        EntityID* entity = array_get(&world->dead_entities, i);
-        if (entity) {
-            world_destroy_entity_immediate(world, *entity);
+    // Dependency graph of this frame: a system goes into the stage after
+    // the last earlier system it conflicts with, so the order systems
+    // were added in still holds wherever it matters
+    System** systems = world->systems.data;
+    int stage_of[WORLD_MAX_SYSTEMS];
+    int stages = 0;
+    for (int j = 0; j < world->systems.size; j++) {
+        stage_of[j] = 0;
+        for (int i = 0; i < j; i++) {
+            if (stage_of[i] >= stage_of[j] && systems_conflict(world, systems[i], systems[j])) {
+                stage_of[j] = stage_of[i] + 1;
+            }
         }
+        if (stage_of[j] + 1 > stages) stages = stage_of[j] + 1;
     }
-    world->dead_entities.size = 0;
     
-    for (int i = 0; i < world->systems.size; i++) {
-        System** sys_ptr = array_get(&world->systems, i);
-        if (sys_ptr && *sys_ptr && (*sys_ptr)->update) {
-            (*sys_ptr)->update(*sys_ptr, world, dt);
+    // The systems of a stage run at the same time
+    for (int s = 0; s < stages; s++) {
+        System* stage[WORLD_MAX_SYSTEMS];
+        int count = 0;
+        for (int j = 0; j < world->systems.size; j++) {
+            if (stage_of[j] == s && systems[j]->update) stage[count++] = systems[j];
         }
+        scheduler_run(stage, count, world, dt);
     }
+    
+    world_apply_commands(world);
 }
 
+// Destroyed at the end of the next update, or whenever the world's
+// commands are applied
 void world_destroy_entity(World* world, EntityID entity) {
     if (!world) return;
-    array_add(&world->dead_entities, &entity);
+    commands_destroy(&world->commands, entity);
 }
 
 void world_destroy_entity_immediate(World* world, EntityID entity) {
     if (!world) return;
     
-    Array* entity_comps = hashmap_get(&world->entity_components, entity);
-    if (!entity_comps) return;
+    EntityRecord* record = world_record(world, entity);
+    if (!record) return;
     
-    for (int i = 0; i < entity_comps->size; i++) {
-        int* comp_type = array_get(entity_comps, i);
-        if (!comp_type) continue;
-        
-        HashMap* type_map = hashmap_get(&world->components, *comp_type);
-        if (type_map) {
-            void* comp_data = hashmap_get(type_map, entity);
-            if (comp_data) {
-                free(comp_data);
-                hashmap_remove(type_map, entity);
-            }
-        }
-        
-        Array* entities_with_type = hashmap_get(&world->component_entities, *comp_type);
-        if (entities_with_type) {
-            for (int j = entities_with_type->size - 1; j >= 0; j--) {
-                EntityID* e = array_get(entities_with_type, j);
-                if (e && *e == entity) {
-                    array_remove(entities_with_type, j);
-                }
-            }
-        }
-    }
-    
-    array_free(entity_comps);
-    free(entity_comps);
-    hashmap_remove(&world->entity_components, entity);
+    archetype_remove(world, record->archetype, record->row);
+    record->archetype = NULL;
+    record->generation = (record->generation % ENTITY_GENERATION_MASK) + 1;
+    record->next_free = world->free_entity;
+    world->free_entity = entity_index(entity);
+    world->alive_count--;
 }
 
 void world_free(World* world) {
@@ -370,53 +550,414 @@ void world_free(World* world) {
             if ((*sys_ptr)->cleanup) {
                 (*sys_ptr)->cleanup(*sys_ptr);
             }
+            commands_free(&(*sys_ptr)->commands);
             free(*sys_ptr);
         }
     }
     array_free(&world->systems);
     
-    for (int type = CT_POSITION; type <= CT_ANIMATION; type++) {
-        HashMap* type_map = hashmap_get(&world->components, type);
-        if (type_map) {
-            for (int i = 0; i < type_map->capacity; i++) {
-                MapEntry* entry = &type_map->entries[i];
-                while (entry && entry->value) {
-                    free(entry->value);
-                    entry->value = NULL;
-                    entry = entry->next;
-                }
+    for (int i = 0; i < world->queries.size; i++) {
+        Query* query = *(Query**)array_get(&world->queries, i);
+        array_free(&query->archetypes);
+        free(query);
+    }
+    array_free(&world->queries);
+    
+    for (int i = 0; i < world->archetypes.size; i++) {
+        archetype_free(world_archetype(world, i));
+    }
+    array_free(&world->archetypes);
+    
+    hashmap_free(&world->archetype_index);
+    hashmap_free(&world->query_index);
+    array_free(&world->entities);
+    commands_free(&world->commands);
+    array_free(&world->batch);
+    array_free(&world->created);
+}
+
+// Level Images
+
+// A built world as one blob: a header, the entity records, and every
+// archetype with rows as its mask, row count, entity IDs and then its
+// columns in type order, each padded to 4 bytes. Loading it copies the
+// columns into tables of the right size in one pass, where building the
+// level adds every component to every entity. The image is only good
+// for the build that saved it, which the component sizes check, as
+// component pointers are saved as indices into level_bitmaps.
+
+#define LEVEL_IMAGE_MAGIC 0x4C534345u      // "ECSL"
+#define LEVEL_IMAGE_VERSION 1
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t component_count;
+    uint16_t component_sizes[CT_COUNT];
+    int32_t record_count;
+    int32_t free_entity;
+    int32_t alive_count;
+    int32_t player_entity;
+    int32_t archetype_count;
+} LevelImageHeader;
+
+typedef struct {
+    int32_t archetype;      // index in the image, -1 when destroyed
+    int32_t row;
+    int32_t generation;
+    int32_t next_free;
+} LevelImageRecord;
+
+typedef struct {
+    uint32_t mask;
+    int32_t count;
+} LevelImageArchetype;
+
+// Every bitmap a sprite may point to; index 0 is none
+static const uint8_t* const level_bitmaps[] = {
+    NULL, sprite_player, sprite_enemy, sprite_coin,
+};
+#define LEVEL_BITMAP_COUNT (int)(sizeof(level_bitmaps) / sizeof(level_bitmaps[0]))
+
+static int level_bitmap_index(const uint8_t* bitmap) {
+    for (int i = 0; i < LEVEL_BITMAP_COUNT; i++) {
+        if (level_bitmaps[i] == bitmap) return i;
+    }
+    return -1;
+}
+
+static inline int level_pad(int bytes) {
+    return (bytes + 3) & ~3;
+}
+
+static void level_add_padding(Array* out) {
+    static const uint8_t zero[3] = {0};
+    int pad = level_pad(out->size) - out->size;
+    if (pad) array_add_bytes(out, zero, pad);
+}
+
+// A component column as the image holds it: pointers become indices
+static bool level_save_column(Array* out, Archetype* arch, int type) {
+    if (type == CT_SPRITE) {
+        for (int row = 0; row < arch->count; row++) {
+            SpriteComponent sprite = *(SpriteComponent*)archetype_cell(arch, type, row);
+            int index = level_bitmap_index(sprite.bitmap);
+            if (index < 0) return false;
+            sprite.bitmap = (const uint8_t*)(uintptr_t)index;
+            array_add_bytes(out, &sprite, sizeof(sprite));
+        }
+    } else {
+        // Animation frames are not in level_bitmaps yet
+        for (int row = 0; type == CT_ANIMATION && row < arch->count; row++) {
+            if (((AnimationComponent*)archetype_cell(arch, type, row))->frames) return false;
+        }
+        if (arch->count > 0) {
+            array_add_bytes(out, arch->columns[type], arch->count * component_sizes[type]);
+        }
+    }
+    level_add_padding(out);
+    return true;
+}
+
+// The world as an image, in a byte Array the caller frees. Its size is 0
+// if a component points to something the image cannot name
+Array level_save(World* world) {
+    assert(world);
+    Array out;
+    array_init(&out, 1);
+    
+    // Only the archetypes that have rows are saved
+    int saved_index[world->archetypes.size];
+    int saved = 0;
+    for (int a = 0; a < world->archetypes.size; a++) {
+        saved_index[a] = world_archetype(world, a)->count > 0 ? saved++ : -1;
+    }
+    
+    LevelImageHeader header = {0};
+    header.magic = LEVEL_IMAGE_MAGIC;
+    header.version = LEVEL_IMAGE_VERSION;
+    header.component_count = CT_COUNT;
+    for (int t = 0; t < CT_COUNT; t++) header.component_sizes[t] = (uint16_t)component_sizes[t];
+    header.record_count = world->entities.size;
+    header.free_entity = world->free_entity;
+    header.alive_count = world->alive_count;
+    header.player_entity = world->player_entity;
+    header.archetype_count = saved;
+    array_add_bytes(&out, &header, sizeof(header));
+    
+    for (int i = 0; i < world->entities.size; i++) {
+        EntityRecord* record = array_get(&world->entities, i);
+        LevelImageRecord image = {-1, record->row, record->generation, record->next_free};
+        for (int a = 0; record->archetype && a < world->archetypes.size; a++) {
+            if (world_archetype(world, a) == record->archetype) image.archetype = saved_index[a];
+        }
+        array_add_bytes(&out, &image, sizeof(image));
+    }
+    
+    for (int a = 0; a < world->archetypes.size; a++) {
+        Archetype* arch = world_archetype(world, a);
+        if (saved_index[a] < 0) continue;
+        
+        LevelImageArchetype image = {arch->mask, arch->count};
+        array_add_bytes(&out, &image, sizeof(image));
+        array_add_bytes(&out, arch->entities, arch->count * (int)sizeof(EntityID));
+        for (int type = CT_POSITION; type < CT_COUNT; type++) {
+            if ((arch->mask & CT_BIT(type)) && !level_save_column(&out, arch, type)) {
+                out.size = 0;
+                return out;
             }
-            hashmap_free(type_map);
-            free(type_map);
         }
     }
+    return out;
+}
+
+// Walk the archetypes of an image without touching the world: false if
+// it runs past size or a record points outside its archetype
+static bool level_check(const uint8_t* image, size_t size) {
+    const LevelImageHeader* header = (const LevelImageHeader*)image;
+    size_t at = sizeof(LevelImageHeader) + (size_t)header->record_count * sizeof(LevelImageRecord);
+    if (header->record_count < 0 || header->archetype_count < 0 || at > size) return false;
+    
+    int counts[header->archetype_count > 0 ? header->archetype_count : 1];
+    for (int a = 0; a < header->archetype_count; a++) {
+        if (at + sizeof(LevelImageArchetype) > size) return false;
+        const LevelImageArchetype* arch = (const LevelImageArchetype*)(image + at);
+        if (arch->count < 0 || (arch->mask & ~(CT_BIT(CT_COUNT) - 1) & ~1u)) return false;
+        counts[a] = arch->count;
+        at += sizeof(LevelImageArchetype) + (size_t)arch->count * sizeof(EntityID);
+        for (int type = CT_POSITION; type < CT_COUNT; type++) {
+            if (arch->mask & CT_BIT(type)) at += level_pad(arch->count * component_sizes[type]);
+        }
+        if (at > size) return false;
+    }
     
-    for (int i = 0; i < world->entity_components.capacity; i++) {
-        MapEntry* entry = &world->entity_components.entries[i];
-        while (entry && entry->value) {
-            Array* comp_list = entry->value;
-            array_free(comp_list);
-            free(comp_list);
-            entry->value = NULL;
-            entry = entry->next;
+    const LevelImageRecord* records = (const LevelImageRecord*)(image + sizeof(LevelImageHeader));
+    for (int i = 0; i < header->record_count; i++) {
+        int a = records[i].archetype;
+        if (a >= header->archetype_count) return false;
+        if (a >= 0 && (records[i].row < 0 || records[i].row >= counts[a])) return false;
+    }
+    return true;
+}
+
+// Fill a world that has no entities yet (after world_init() and adding
+// its systems) from an image, e.g. a const array in flash. False, with
+// the world left empty, if the image is not one of this build
+bool level_load(World* world, const uint8_t* image, size_t size) {
+    assert(world && image);
+    if (world->entities.size != 0 || size < sizeof(LevelImageHeader)) return false;
+    
+    const LevelImageHeader* header = (const LevelImageHeader*)image;
+    if (header->magic != LEVEL_IMAGE_MAGIC || header->version != LEVEL_IMAGE_VERSION ||
+        header->component_count != CT_COUNT) return false;
+    for (int t = 0; t < CT_COUNT; t++) {
+        if (header->component_sizes[t] != component_sizes[t]) return false;
+    }
+    if (!level_check(image, size)) return false;
+    
+    // The archetypes, each found or made once and its columns copied
+    // whole; the queries of the systems pick them up as they are made
+    const uint8_t* at = image + sizeof(LevelImageHeader) + header->record_count * sizeof(LevelImageRecord);
+    Archetype* archetypes[header->archetype_count > 0 ? header->archetype_count : 1];
+    for (int a = 0; a < header->archetype_count; a++) {
+        const LevelImageArchetype* image_arch = (const LevelImageArchetype*)at;
+        at += sizeof(LevelImageArchetype);
+        
+        Archetype* arch = world_find_archetype(world, image_arch->mask);
+        archetype_reserve(arch, image_arch->count);
+        memcpy(arch->entities, at, image_arch->count * sizeof(EntityID));
+        at += image_arch->count * sizeof(EntityID);
+        for (int type = CT_POSITION; type < CT_COUNT; type++) {
+            if (!(image_arch->mask & CT_BIT(type))) continue;
+            int bytes = image_arch->count * component_sizes[type];
+            memcpy(arch->columns[type], at, bytes);
+            at += level_pad(bytes);
+        }
+        arch->count = image_arch->count;
+        archetypes[a] = arch;
+        
+        // Bitmap indices back to pointers, any out of range to none
+        if (arch->mask & CT_BIT(CT_SPRITE)) {
+            SpriteComponent* sprites = arch->columns[CT_SPRITE];
+            for (int row = 0; row < arch->count; row++) {
+                uintptr_t index = (uintptr_t)sprites[row].bitmap;
+                sprites[row].bitmap = index < LEVEL_BITMAP_COUNT ? level_bitmaps[index] : NULL;
+            }
         }
     }
     
-    for (int i = 0; i < world->component_entities.capacity; i++) {
-        MapEntry* entry = &world->component_entities.entries[i];
-        while (entry && entry->value) {
-            Array* entity_list = entry->value;
-            array_free(entity_list);
-            free(entity_list);
-            entry->value = NULL;
-            entry = entry->next;
+    const LevelImageRecord* records = (const LevelImageRecord*)(image + sizeof(LevelImageHeader));
+    array_resize(&world->entities, header->record_count);
+    for (int i = 0; i < header->record_count; i++) {
+        EntityRecord* record = array_get(&world->entities, i);
+        record->archetype = records[i].archetype >= 0 ? archetypes[records[i].archetype] : NULL;
+        record->row = records[i].row;
+        record->generation = records[i].generation;
+        record->next_free = records[i].next_free;
+    }
+    world->free_entity = header->free_entity;
+    world->alive_count = header->alive_count;
+    world->player_entity = header->player_entity;
+    return true;
+}
+
+// Print the world's image over stdio as the source of level_image.h
+void level_dump(World* world) {
+    Array image = level_save(world);
+    if (image.size == 0) {
+        printf("Level cannot be saved: a component points to something not in level_bitmaps\n");
+        array_free(&image);
+        return;
+    }
+    
+    const uint8_t* bytes = image.data;
+    printf("-- level_image.h --\n");
+    printf("// Made by a LEVEL_DUMP build of the ECS game; only for that same build\n");
+    printf("static const uint8_t level_image[%d] __attribute__((aligned(4))) = {\n", image.size);
+    for (int i = 0; i < image.size; i++) {
+        printf("%s0x%02x,%s", i % 16 ? " " : "    ", bytes[i], i % 16 == 15 || i == image.size - 1 ? "\n" : "");
+    }
+    printf("};\n-- end --\n");
+    array_free(&image);
+}
+
+// Command Buffer
+
+void commands_init(CommandBuffer* buf) {
+    assert(buf);
+    array_init(&buf->commands, sizeof(Command));
+    array_init(&buf->data, 1);
+    buf->created = 0;
+}
+
+static void commands_push(CommandBuffer* buf, int op, EntityID entity, int component, int offset) {
+    Command cmd = {op, entity, component, offset, 0, NULL};
+    array_add(&buf->commands, &cmd);
+}
+
+// the entity is -1 for the first one created through buf, -2 for the next ...
+EntityID commands_create(CommandBuffer* buf) {
+    assert(buf);
+    EntityID temp = -(++buf->created);
+    commands_push(buf, CMD_CREATE, temp, 0, 0);
+    return temp;
+}
+
+void commands_destroy(CommandBuffer* buf, EntityID entity) {
+    assert(buf);
+    commands_push(buf, CMD_DESTROY, entity, 0, 0);
+}
+
+void commands_add(CommandBuffer* buf, EntityID entity, int type, const void* data, int data_size) {
+    assert(buf && data && type >= CT_POSITION && type < CT_COUNT && data_size == component_sizes[type]);
+    int offset = buf->data.size;
+    array_add_bytes(&buf->data, data, data_size);
+    commands_push(buf, CMD_ADD, entity, type, offset);
+}
+
+void commands_remove(CommandBuffer* buf, EntityID entity, int type) {
+    assert(buf && type >= CT_POSITION && type < CT_COUNT);
+    commands_push(buf, CMD_REMOVE, entity, type, 0);
+}
+
+void commands_clear(CommandBuffer* buf) {
+    if (!buf) return;
+    buf->commands.size = 0;
+    buf->data.size = 0;
+    buf->created = 0;
+}
+
+void commands_free(CommandBuffer* buf) {
+    if (!buf) return;
+    array_free(&buf->commands);
+    array_free(&buf->data);
+    buf->created = 0;
+}
+
+// Append the commands of buf to the world's batch. Entities it created
+// are made now, so the rest of its commands can refer to real IDs.
+static void batch_collect(World* world, CommandBuffer* buf) {
+    world->created.size = 0;
+    for (int i = 0; i < buf->commands.size; i++) {
+        Command* cmd = array_get(&buf->commands, i);
+        if (cmd->op == CMD_CREATE) {
+            EntityID id = world_create_entity(world);
+            array_add(&world->created, &id);
+            continue;
+        }
+        Command copy = *cmd;
+        if (copy.entity < 0) copy.entity = *(EntityID*)array_get(&world->created, -copy.entity - 1);
+        copy.seq = world->batch.size;
+        copy.value = (const uint8_t*)buf->data.data + copy.offset;
+        array_add(&world->batch, &copy);
+    }
+}
+
+static int command_compare(const void* a, const void* b) {
+    const Command* x = a;
+    const Command* y = b;
+    if (x->entity != y->entity) return (x->entity < y->entity) ? -1 : 1;
+    return x->seq - y->seq;
+}
+
+// All the commands for one entity, in the order they were recorded: a
+// destroy wins, otherwise the entity moves once to the archetype of its
+// final set of components and takes the values added.
+static void batch_apply_entity(World* world, Command* cmds, int count) {
+    EntityRecord* record = world_record(world, cmds[0].entity);
+    if (!record) return;
+    
+    uint32_t mask = record->archetype->mask;
+    for (int k = 0; k < count; k++) {
+        switch (cmds[k].op) {
+            case CMD_DESTROY:
+                world_destroy_entity_immediate(world, cmds[k].entity);
+                return;
+            case CMD_ADD:
+                mask |= CT_BIT(cmds[k].component);
+                break;
+            case CMD_REMOVE:
+                mask &= ~CT_BIT(cmds[k].component);
+                break;
         }
     }
     
-    hashmap_free(&world->entity_components);
-    hashmap_free(&world->components);
-    hashmap_free(&world->component_entities);
-    array_free(&world->dead_entities);
+    world_move_entity(world, record, mask);
+    for (int k = 0; k < count; k++) {
+        if (cmds[k].op == CMD_ADD && (mask & CT_BIT(cmds[k].component))) {
+            memcpy(archetype_cell(record->archetype, cmds[k].component, record->row),
+                   cmds[k].value, component_sizes[cmds[k].component]);
+        }
+    }
+}
+
+// The buffers of the world and of every system, sorted by entity and
+// applied in one go
+void world_apply_commands(World* world) {
+    assert(world);
+    
+    world->batch.size = 0;
+    batch_collect(world, &world->commands);
+    for (int i = 0; i < world->systems.size; i++) {
+        System** sys_ptr = array_get(&world->systems, i);
+        batch_collect(world, &(*sys_ptr)->commands);
+    }
+    
+    Command* cmds = world->batch.data;
+    int n = world->batch.size;
+    if (n > 1) qsort(cmds, n, sizeof(Command), command_compare);
+    for (int i = 0; i < n; ) {
+        int j = i + 1;
+        while (j < n && cmds[j].entity == cmds[i].entity) j++;
+        batch_apply_entity(world, &cmds[i], j - i);
+        i = j;
+    }
+    
+    commands_clear(&world->commands);
+    for (int i = 0; i < world->systems.size; i++) {
+        System** sys_ptr = array_get(&world->systems, i);
+        commands_clear(&(*sys_ptr)->commands);
+    }
 }
 
 // Collision
@@ -426,61 +967,178 @@ bool check_collision(float x1, float y1, float w1, float h1,
            y1 < y2 + h2 && y1 + h1 > y2;
 }
 
+// Broadphase
+
+static int broadphase_cell(float v) {
+    return (int)floorf(v / BROADPHASE_CELL);
+}
+
+static unsigned int broadphase_bucket(int cx, int cy) {
+    return ((unsigned int)cx * 73856093u ^ (unsigned int)cy * 19349663u) % BROADPHASE_BUCKETS;
+}
+
+void broadphase_init(Broadphase* bp) {
+    assert(bp);
+    array_init(&bp->items, sizeof(BroadphaseItem));
+    array_init(&bp->stamps, sizeof(int));
+    array_init(&bp->cells, sizeof(int));
+    array_init(&bp->results, sizeof(int));
+    memset(bp->bucket_start, 0, sizeof(bp->bucket_start));
+    bp->query_id = 0;
+}
+
+void broadphase_clear(Broadphase* bp) {
+    if (!bp) return;
+    bp->items.size = 0;
+    bp->cells.size = 0;
+    bp->results.size = 0;
+    memset(bp->bucket_start, 0, sizeof(bp->bucket_start));
+}
+
+void broadphase_insert(Broadphase* bp, Archetype* arch, int row, float x, float y, float w, float h) {
+    assert(bp && arch);
+    BroadphaseItem item = {x, y, w, h, arch, row};
+    array_add(&bp->items, &item);
+}
+
+// Counting sort of the items into buckets, an item going into every cell
+// its box covers. bucket_start[b] first counts and then, summed, points
+// past the end of bucket b; placing the items backwards moves it down
+// to the start of the bucket.
+void broadphase_build(Broadphase* bp) {
+    assert(bp);
+    memset(bp->bucket_start, 0, sizeof(bp->bucket_start));
+    
+    int total = 0;
+    for (int i = 0; i < bp->items.size; i++) {
+        BroadphaseItem* item = broadphase_item(bp, i);
+        for (int cy = broadphase_cell(item->y); cy <= broadphase_cell(item->y + item->h); cy++) {
+            for (int cx = broadphase_cell(item->x); cx <= broadphase_cell(item->x + item->w); cx++) {
+                bp->bucket_start[broadphase_bucket(cx, cy)]++;
+                total++;
+            }
+        }
+    }
+    for (int b = 1; b < BROADPHASE_BUCKETS; b++) {
+        bp->bucket_start[b] += bp->bucket_start[b - 1];
+    }
+    bp->bucket_start[BROADPHASE_BUCKETS] = total;
+    
+    array_resize(&bp->cells, total);
+    int* cells = bp->cells.data;
+    for (int i = bp->items.size - 1; i >= 0; i--) {
+        BroadphaseItem* item = broadphase_item(bp, i);
+        for (int cy = broadphase_cell(item->y); cy <= broadphase_cell(item->y + item->h); cy++) {
+            for (int cx = broadphase_cell(item->x); cx <= broadphase_cell(item->x + item->w); cx++) {
+                cells[--bp->bucket_start[broadphase_bucket(cx, cy)]] = i;
+            }
+        }
+    }
+    
+    array_resize(&bp->stamps, bp->items.size);
+    memset(bp->stamps.data, 0, bp->stamps.size * sizeof(int));
+    bp->query_id = 0;
+}
+
+// Indices of the items that may overlap the box, each once. Items in
+// other cells of the same bucket come along too; the caller tests the
+// boxes anyway. The array is reused by the next query.
+Array* broadphase_query(Broadphase* bp, float x, float y, float w, float h) {
+    assert(bp);
+    bp->results.size = 0;
+    
+#if BROADPHASE_GRID
+    bp->query_id++;
+    int* stamps = bp->stamps.data;
+    int* cells = bp->cells.data;
+    for (int cy = broadphase_cell(y); cy <= broadphase_cell(y + h); cy++) {
+        for (int cx = broadphase_cell(x); cx <= broadphase_cell(x + w); cx++) {
+            unsigned int b = broadphase_bucket(cx, cy);
+            for (int k = bp->bucket_start[b]; k < bp->bucket_start[b + 1]; k++) {
+                int i = cells[k];
+                if (stamps[i] == bp->query_id) continue;
+                stamps[i] = bp->query_id;
+                array_add(&bp->results, &i);
+            }
+        }
+    }
+#else
+    for (int i = 0; i < bp->items.size; i++) {
+        array_add(&bp->results, &i);
+    }
+#endif
+    return &bp->results;
+}
+
+BroadphaseItem* broadphase_item(Broadphase* bp, int index) {
+    return array_get(&bp->items, index);
+}
+
+void broadphase_free(Broadphase* bp) {
+    if (!bp) return;
+    array_free(&bp->items);
+    array_free(&bp->stamps);
+    array_free(&bp->cells);
+    array_free(&bp->results);
+}
+
 // Input System
 void input_update(System* self, World* world, float dt) {
     if (!self || !world || world->game_over) return;
     
     InputSystem* sys = (InputSystem*)self;
+    bool jump_pressed = button_pressed(BUTTON_Y);
     
-    int required[] = {CT_PLAYER, CT_POSITION, CT_VELOCITY, CT_PHYSICS};
-    Array entities = world_query(world, required, 4);
-    
-    for (int i = 0; i < entities.size; i++) {
-        EntityID* entity = array_get(&entities, i);
-        if (!entity) continue;
+    for (int a = 0; a < sys->players->archetypes.size; a++) {
+        Archetype* arch = query_archetype(sys->players, a);
         
-        PlayerComponent* player = world_get_component(world, *entity, CT_PLAYER);
-        VelocityComponent* vel = world_get_component(world, *entity, CT_VELOCITY);
+        PlayerComponent* players = arch->columns[CT_PLAYER];
+        VelocityComponent* vels = arch->columns[CT_VELOCITY];
         
-        if (!player || !vel) continue;
-        
-        // Improved movement with acceleration
-        float move_accel = 500.0f;
-        float max_speed = 120.0f;
-        
-        if (button_pressed(BUTTON_A)) {
-            vel->x -= move_accel * dt;
-            if (vel->x < -max_speed) vel->x = -max_speed;
-        } else if (button_pressed(BUTTON_B)) {
-            vel->x += move_accel * dt;
-            if (vel->x > max_speed) vel->x = max_speed;
-        } else {
-            // Apply friction when no input
-            vel->x *= 0.85f;
-            if (vel->x > -0.1f && vel->x < 0.1f) vel->x = 0;
-        }
-        
-        // Jump logic
-        bool jump_pressed = button_pressed(BUTTON_Y);
-        if (jump_pressed && !sys->last_jump_pressed) {
-            if (player->on_ground || player->jump_count < player->max_jumps) {
-                vel->y = -180.0f;
-                player->jump_count++;
-                player->on_ground = false;
+        for (int i = 0; i < arch->count; i++) {
+            PlayerComponent* player = &players[i];
+            VelocityComponent* vel = &vels[i];
+            
+            // Improved movement with acceleration
+            float move_accel = 500.0f;
+            float max_speed = 120.0f;
+            
+            if (button_pressed(BUTTON_A)) {
+                vel->x -= move_accel * dt;
+                if (vel->x < -max_speed) vel->x = -max_speed;
+            } else if (button_pressed(BUTTON_B)) {
+                vel->x += move_accel * dt;
+                if (vel->x > max_speed) vel->x = max_speed;
+            } else {
+                // Apply friction when no input
+                vel->x *= 0.85f;
+                if (vel->x > -0.1f && vel->x < 0.1f) vel->x = 0;
+            }
+            
+            // Jump logic
+            if (jump_pressed && !sys->last_jump_pressed) {
+                if (player->on_ground || player->jump_count < player->max_jumps) {
+                    vel->y = -180.0f;
+                    player->jump_count++;
+                    player->on_ground = false;
+                }
             }
         }
-        sys->last_jump_pressed = jump_pressed;
     }
-    
-    array_free(&entities);
+    sys->last_jump_pressed = jump_pressed;
 }
 
-InputSystem* create_input_system(void) {
+InputSystem* create_input_system(World* world) {
     InputSystem* sys = malloc(sizeof(InputSystem));
     assert(sys);
     sys->base.update = input_update;
     sys->base.cleanup = NULL;
+    sys->base.reads = WORLD_STATE | CT_BIT(CT_PLAYER) | CT_BIT(CT_VELOCITY);
+    sys->base.writes = CT_BIT(CT_PLAYER) | CT_BIT(CT_VELOCITY);
+    sys->base.with = CT_BIT(CT_PLAYER) | CT_BIT(CT_POSITION) | CT_BIT(CT_VELOCITY) | CT_BIT(CT_PHYSICS);
+    sys->base.main_core = false;
     sys->last_jump_pressed = false;
+    sys->players = world_cached_query(world, sys->base.with);
     return sys;
 }
 
@@ -488,219 +1146,273 @@ InputSystem* create_input_system(void) {
 void physics_update(System* self, World* world, float dt) {
     if (!self || !world) return;
     
-    int required[] = {CT_POSITION, CT_VELOCITY, CT_PHYSICS};
-    Array entities = world_query(world, required, 3);
+    PhysicsSystem* sys = (PhysicsSystem*)self;
     
-    for (int i = 0; i < entities.size; i++) {
-        EntityID* entity = array_get(&entities, i);
-        if (!entity) continue;
-        
-        PositionComponent* pos = world_get_component(world, *entity, CT_POSITION);
-        VelocityComponent* vel = world_get_component(world, *entity, CT_VELOCITY);
-        PhysicsComponent* phys = world_get_component(world, *entity, CT_PHYSICS);
+    for (int a = 0; a < sys->bodies->archetypes.size; a++) {
+        Archetype* arch = query_archetype(sys->bodies, a);
         
-        if (!pos || !vel || !phys) continue;
+        PositionComponent* pos = arch->columns[CT_POSITION];
+        VelocityComponent* vel = arch->columns[CT_VELOCITY];
+        PhysicsComponent* phys = arch->columns[CT_PHYSICS];
+        PlayerComponent* players = arch->columns[CT_PLAYER];  // NULL unless players
         
-        // Apply gravity
-        if (phys->affected_by_gravity) {
-            vel->y += phys->gravity * dt;
-            if (vel->y > phys->max_fall_speed) {
-                vel->y = phys->max_fall_speed;
+        for (int i = 0; i < arch->count; i++) {
+            // Apply gravity
+            if (phys[i].affected_by_gravity) {
+                vel[i].y += phys[i].gravity * dt;
+                if (vel[i].y > phys[i].max_fall_speed) {
+                    vel[i].y = phys[i].max_fall_speed;
+                }
             }
-        }
-        
-        // Apply velocity
-        pos->x += vel->x * dt;
-        pos->y += vel->y * dt;
-        
-        // World bounds - FIXED: Use WORLD_WIDTH instead of 800
-        if (pos->x < 0) {
-            pos->x = 0;
-            vel->x = 0;
-        }
-        if (pos->x > WORLD_WIDTH - 16) {
-            pos->x = WORLD_WIDTH - 16;
-            vel->x = 0;
-        }
-        
-        // Bottom boundary (death pit)
-        if (pos->y > DISPLAY_HEIGHT + 50) {
-            // Player fell off - respawn or lose life
-            PlayerComponent* player = world_get_component(world, *entity, CT_PLAYER);
-            if (player) {
+            
+            // Apply velocity
+            pos[i].x += vel[i].x * dt;
+            pos[i].y += vel[i].y * dt;
+            
+            // World bounds - FIXED: Use WORLD_WIDTH instead of 800
+            if (pos[i].x < 0) {
+                pos[i].x = 0;
+                vel[i].x = 0;
+            }
+            if (pos[i].x > WORLD_WIDTH - 16) {
+                pos[i].x = WORLD_WIDTH - 16;
+                vel[i].x = 0;
+            }
+            
+            // Bottom boundary (death pit)
+            if (pos[i].y > DISPLAY_HEIGHT + 50 && players) {
+                // Player fell off - respawn or lose life
+                PlayerComponent* player = &players[i];
                 player->lives--;
                 if (player->lives <= 0) {
                     world->game_over = true;
                 } else {
                     // Respawn at start - FIXED: spawn on ground
-                    pos->x = 50.0f;
-                    pos->y = GROUND_HEIGHT - 14.0f; // Place on ground (14 = player height)
-                    vel->x = 0;
-                    vel->y = 0;
+                    pos[i].x = 50.0f;
+                    pos[i].y = GROUND_HEIGHT - PLAYER_SIZE; // Place on ground
+                    vel[i].x = 0;
+                    vel[i].y = 0;
                 }
             }
         }
     }
-    
-    array_free(&entities);
 }
 
-PhysicsSystem* create_physics_system(void) {
+PhysicsSystem* create_physics_system(World* world) {
     PhysicsSystem* sys = malloc(sizeof(PhysicsSystem));
     assert(sys);
     sys->base.update = physics_update;
     sys->base.cleanup = NULL;
+    sys->base.reads = CT_BIT(CT_POSITION) | CT_BIT(CT_VELOCITY) | CT_BIT(CT_PHYSICS) | CT_BIT(CT_PLAYER);
+    sys->base.writes = WORLD_STATE | CT_BIT(CT_POSITION) | CT_BIT(CT_VELOCITY) | CT_BIT(CT_PLAYER);
+    sys->base.with = CT_BIT(CT_POSITION) | CT_BIT(CT_VELOCITY) | CT_BIT(CT_PHYSICS);
+    sys->base.main_core = false;
+    sys->bodies = world_cached_query(world, sys->base.with);
     return sys;
 }
 
 // Collision System - IMPROVED
-void collision_update(System* self, World* world, float dt) {
-    if (!self || !world) return;
-    
-    int player_required[] = {CT_PLAYER, CT_POSITION, CT_COLLIDER, CT_VELOCITY};
-    Array players = world_query(world, player_required, 4);
-    
-    int platform_required[] = {CT_PLATFORM, CT_POSITION, CT_COLLIDER};
-    Array platforms = world_query(world, platform_required, 3);
-    
-    int enemy_required[] = {CT_ENEMY, CT_POSITION, CT_COLLIDER};
-    Array enemies = world_query(world, enemy_required, 3);
-    
-    int collectible_required[] = {CT_COLLECTIBLE, CT_POSITION, CT_COLLIDER};
-    Array collectibles = world_query(world, collectible_required, 3);
+static void collide_platforms(Broadphase* bp, PositionComponent* p_pos, ColliderComponent* p_col,
+                              VelocityComponent* p_vel, PlayerComponent* player) {
+    Array* near = broadphase_query(bp, p_pos->x, p_pos->y, p_col->width, p_col->height);
     
-    for (int i = 0; i < players.size; i++) {
-        EntityID* player_ent = array_get(&players, i);
-        if (!player_ent) continue;
+    for (int k = 0; k < near->size; k++) {
+        BroadphaseItem* plat = broadphase_item(bp, ((int*)near->data)[k]);
+        if (!(plat->archetype->mask & CT_BIT(CT_PLATFORM))) continue;
         
-        PositionComponent* p_pos = world_get_component(world, *player_ent, CT_POSITION);
-        ColliderComponent* p_col = world_get_component(world, *player_ent, CT_COLLIDER);
-        VelocityComponent* p_vel = world_get_component(world, *player_ent, CT_VELOCITY);
-        PlayerComponent* player = world_get_component(world, *player_ent, CT_PLAYER);
+        if (!check_collision(p_pos->x, p_pos->y, p_col->width, p_col->height,
+                             plat->x, plat->y, plat->w, plat->h)) {
+            continue;
+        }
         
-        if (!p_pos || !p_col || !p_vel || !player) continue;
+        PlatformComponent* platform = archetype_cell(plat->archetype, CT_PLATFORM, plat->row);
         
-        // Reset ground state each frame
-        player->on_ground = false;
+        // Calculate overlap on each axis
+        float overlap_left = (p_pos->x + p_col->width) - plat->x;
+        float overlap_right = (plat->x + plat->w) - p_pos->x;
+        float overlap_top = (p_pos->y + p_col->height) - plat->y;
+        float overlap_bottom = (plat->y + plat->h) - p_pos->y;
         
-        // Platform collision - IMPROVED
-        for (int j = 0; j < platforms.size; j++) {
-            EntityID* plat_ent = array_get(&platforms, j);
-            if (!plat_ent) continue;
-            
-            PositionComponent* plat_pos = world_get_component(world, *plat_ent, CT_POSITION);
-            ColliderComponent* plat_col = world_get_component(world, *plat_ent, CT_COLLIDER);
-            PlatformComponent* platform = world_get_component(world, *plat_ent, CT_PLATFORM);
-            
-            if (!plat_pos || !plat_col || !platform) continue;
-            
-            if (check_collision(p_pos->x, p_pos->y, p_col->width, p_col->height,
-                              plat_pos->x, plat_pos->y, plat_col->width, plat_col->height)) {
-                
-                // Calculate overlap on each axis
-                float overlap_left = (p_pos->x + p_col->width) - plat_pos->x;
-                float overlap_right = (plat_pos->x + plat_col->width) - p_pos->x;
-                float overlap_top = (p_pos->y + p_col->height) - plat_pos->y;
-                float overlap_bottom = (plat_pos->y + plat_col->height) - p_pos->y;
-                
-                // Find minimum overlap
-                float min_overlap = overlap_top;
-                int collision_side = 0; // 0=top, 1=bottom, 2=left, 3=right
-                
-                if (overlap_bottom < min_overlap) { min_overlap = overlap_bottom; collision_side = 1; }
-                if (!platform->one_way && overlap_left < min_overlap) { min_overlap = overlap_left; collision_side = 2; }
-                if (!platform->one_way && overlap_right < min_overlap) { min_overlap = overlap_right; collision_side = 3; }
-                
-                // Resolve collision based on side
-                if (collision_side == 0 && p_vel->y > 0) {
-                    // Landing on top
-                    p_pos->y = plat_pos->y - p_col->height;
-                    p_vel->y = 0;
-                    player->on_ground = true;
-                    player->jump_count = 0;
-                } else if (collision_side == 1 && p_vel->y < 0 && !platform->one_way) {
-                    // Hit bottom
-                    p_pos->y = plat_pos->y + plat_col->height;
-                    p_vel->y = 0;
-                } else if (collision_side == 2 && !platform->one_way) {
-                    // Hit from left
-                    p_pos->x = plat_pos->x - p_col->width;
-                    p_vel->x = 0;
-                } else if (collision_side == 3 && !platform->one_way) {
-                    // Hit from right
-                    p_pos->x = plat_pos->x + plat_col->width;
-                    p_vel->x = 0;
-                }
-            }
+        // Find minimum overlap
+        float min_overlap = overlap_top;
+        int collision_side = 0; // 0=top, 1=bottom, 2=left, 3=right
+        bool one_way = platform->one_way;
+        
+        if (overlap_bottom < min_overlap) { min_overlap = overlap_bottom; collision_side = 1; }
+        if (!one_way && overlap_left < min_overlap) { min_overlap = overlap_left; collision_side = 2; }
+        if (!one_way && overlap_right < min_overlap) { min_overlap = overlap_right; collision_side = 3; }
+        
+        // Resolve collision based on side
+        if (collision_side == 0 && p_vel->y > 0) {
+            // Landing on top
+            p_pos->y = plat->y - p_col->height;
+            p_vel->y = 0;
+            player->on_ground = true;
+            player->jump_count = 0;
+        } else if (collision_side == 1 && p_vel->y < 0 && !one_way) {
+            // Hit bottom
+            p_pos->y = plat->y + plat->h;
+            p_vel->y = 0;
+        } else if (collision_side == 2 && !one_way) {
+            // Hit from left
+            p_pos->x = plat->x - p_col->width;
+            p_vel->x = 0;
+        } else if (collision_side == 3 && !one_way) {
+            // Hit from right
+            p_pos->x = plat->x + plat->w;
+            p_vel->x = 0;
         }
+    }
+}
+
+// Enemies and coins, after the platforms have moved the player
+static void collide_others(World* world, CommandBuffer* cmds, Broadphase* bp, PositionComponent* p_pos,
+                           ColliderComponent* p_col, VelocityComponent* p_vel, PlayerComponent* player) {
+    Array* near = broadphase_query(bp, p_pos->x, p_pos->y, p_col->width, p_col->height);
+    
+    for (int k = 0; k < near->size; k++) {
+        BroadphaseItem* other = broadphase_item(bp, ((int*)near->data)[k]);
+        uint32_t mask = other->archetype->mask;
+        if (!(mask & (CT_BIT(CT_ENEMY) | CT_BIT(CT_COLLECTIBLE)))) continue;
         
-        // Enemy collision
-        for (int j = 0; j < enemies.size; j++) {
-            EntityID* enemy_ent = array_get(&enemies, j);
-            if (!enemy_ent) continue;
-            
-            PositionComponent* e_pos = world_get_component(world, *enemy_ent, CT_POSITION);
-            ColliderComponent* e_col = world_get_component(world, *enemy_ent, CT_COLLIDER);
-            
-            if (!e_pos || !e_col) continue;
-            
-            if (check_collision(p_pos->x, p_pos->y, p_col->width, p_col->height,
-                              e_pos->x, e_pos->y, e_col->width, e_col->height)) {
-                
-                // Check if jumping on enemy
-                if (p_vel->y > 0 && p_pos->y + p_col->height - 8 < e_pos->y + e_col->height / 2) {
-                    world_destroy_entity(world, *enemy_ent);
-                    p_vel->y = -120.0f;
-                    world->score += 100;
-                } else {
-                    // Take damage
-                    player->lives--;
-                    if (player->lives <= 0) {
-                        world->game_over = true;
-                    } else {
-                        // Knockback
-                        float knockback_dir = (p_pos->x < e_pos->x) ? -1.0f : 1.0f;
-                        p_vel->x = knockback_dir * 100.0f;
-                        p_vel->y = -80.0f;
-                    }
-                }
+        if (!check_collision(p_pos->x, p_pos->y, p_col->width, p_col->height,
+                             other->x, other->y, other->w, other->h)) {
+            continue;
+        }
+        EntityID entity = other->archetype->entities[other->row];
+        
+        if (mask & CT_BIT(CT_COLLECTIBLE)) {
+            CollectibleComponent* coll = archetype_cell(other->archetype, CT_COLLECTIBLE, other->row);
+            if (coll->collected) continue;
+            coll->collected = true;
+            world->score += coll->points;
+            commands_destroy(cmds, entity);
+            continue;
+        }
+        
+        // Check if jumping on enemy
+        if (p_vel->y > 0 && p_pos->y + p_col->height - 8 < other->y + other->h / 2) {
+            commands_destroy(cmds, entity);
+            p_vel->y = -120.0f;
+            world->score += 100;
+        } else {
+            // Take damage
+            player->lives--;
+            if (player->lives <= 0) {
+                world->game_over = true;
+            } else {
+                // Knockback
+                float knockback_dir = (p_pos->x < other->x) ? -1.0f : 1.0f;
+                p_vel->x = knockback_dir * 100.0f;
+                p_vel->y = -80.0f;
             }
         }
+    }
+}
+
+// Enemies fall under gravity too, and stop on top of whatever platform
+// they come down on
+static void land_on_platforms(Broadphase* bp, PositionComponent* pos, ColliderComponent* col,
+                              VelocityComponent* vel) {
+    if (vel->y < 0) return;
+    
+    Array* near = broadphase_query(bp, pos->x, pos->y, col->width, col->height);
+    
+    for (int k = 0; k < near->size; k++) {
+        BroadphaseItem* plat = broadphase_item(bp, ((int*)near->data)[k]);
+        if (!(plat->archetype->mask & CT_BIT(CT_PLATFORM))) continue;
+        
+        if (check_collision(pos->x, pos->y, col->width, col->height,
+                            plat->x, plat->y, plat->w, plat->h) &&
+            pos->y + col->height - plat->y <= col->height / 2) {
+            pos->y = plat->y - col->height;
+            vel->y = 0;
+        }
+    }
+}
+
+static void broadphase_add_query(Broadphase* bp, Query* query) {
+    for (int a = 0; a < query->archetypes.size; a++) {
+        Archetype* arch = query_archetype(query, a);
+        PositionComponent* pos = arch->columns[CT_POSITION];
+        ColliderComponent* col = arch->columns[CT_COLLIDER];
+        CollectibleComponent* coll = arch->columns[CT_COLLECTIBLE];
         
-        // Collectible collision
-        for (int j = 0; j < collectibles.size; j++) {
-            EntityID* coll_ent = array_get(&collectibles, j);
-            if (!coll_ent) continue;
-            
-            CollectibleComponent* coll = world_get_component(world, *coll_ent, CT_COLLECTIBLE);
-            
-            if (!coll || coll->collected) continue;
-            
-            PositionComponent* c_pos = world_get_component(world, *coll_ent, CT_POSITION);
-            ColliderComponent* c_col = world_get_component(world, *coll_ent, CT_COLLIDER);
-            
-            if (!c_pos || !c_col) continue;
+        for (int i = 0; i < arch->count; i++) {
+            if (coll && coll[i].collected) continue;
+            broadphase_insert(bp, arch, i, pos[i].x, pos[i].y, col[i].width, col[i].height);
+        }
+    }
+}
+
+void collision_update(System* self, World* world, float dt) {
+    if (!self || !world) return;
+    
+    CollisionSystem* sys = (CollisionSystem*)self;
+    Broadphase* bp = &sys->broadphase;
+    
+    // Everything a player or an enemy can run into, once this frame
+    broadphase_clear(bp);
+    broadphase_add_query(bp, sys->platforms);
+    broadphase_add_query(bp, sys->enemies);
+    broadphase_add_query(bp, sys->collectibles);
+    broadphase_build(bp);
+    
+    for (int a = 0; a < sys->players->archetypes.size; a++) {
+        Archetype* arch = query_archetype(sys->players, a);
+        
+        PositionComponent* p_pos = arch->columns[CT_POSITION];
+        ColliderComponent* p_col = arch->columns[CT_COLLIDER];
+        VelocityComponent* p_vel = arch->columns[CT_VELOCITY];
+        PlayerComponent* player = arch->columns[CT_PLAYER];
+        
+        for (int i = 0; i < arch->count; i++) {
+            // Reset ground state each frame
+            player[i].on_ground = false;
             
-            if (check_collision(p_pos->x, p_pos->y, p_col->width, p_col->height,
-                              c_pos->x, c_pos->y, c_col->width, c_col->height)) {
-                coll->collected = true;
-                world->score += coll->points;
-                world_destroy_entity(world, *coll_ent);
-            }
+            collide_platforms(bp, &p_pos[i], &p_col[i], &p_vel[i], &player[i]);
+            collide_others(world, &self->commands, bp, &p_pos[i], &p_col[i], &p_vel[i], &player[i]);
         }
     }
     
-    array_free(&players);
-    array_free(&platforms);
-    array_free(&enemies);
-    array_free(&collectibles);
+    for (int a = 0; a < sys->walkers->archetypes.size; a++) {
+        Archetype* arch = query_archetype(sys->walkers, a);
+        
+        PositionComponent* pos = arch->columns[CT_POSITION];
+        ColliderComponent* col = arch->columns[CT_COLLIDER];
+        VelocityComponent* vel = arch->columns[CT_VELOCITY];
+        
+        for (int i = 0; i < arch->count; i++) {
+            land_on_platforms(bp, &pos[i], &col[i], &vel[i]);
+        }
+    }
 }
 
-CollisionSystem* create_collision_system(void) {
+static void collision_cleanup(System* self) {
+    CollisionSystem* sys = (CollisionSystem*)self;
+    broadphase_free(&sys->broadphase);
+}
+
+CollisionSystem* create_collision_system(World* world) {
     CollisionSystem* sys = malloc(sizeof(CollisionSystem));
     assert(sys);
     sys->base.update = collision_update;
-    sys->base.cleanup = NULL;
+    sys->base.cleanup = collision_cleanup;
+    sys->base.reads = CT_BIT(CT_POSITION) | CT_BIT(CT_COLLIDER) | CT_BIT(CT_VELOCITY) | CT_BIT(CT_PLAYER) |
+                      CT_BIT(CT_PLATFORM) | CT_BIT(CT_ENEMY) | CT_BIT(CT_COLLECTIBLE);
+    sys->base.writes = WORLD_STATE | CT_BIT(CT_POSITION) | CT_BIT(CT_VELOCITY) | CT_BIT(CT_PLAYER) |
+                       CT_BIT(CT_COLLECTIBLE);
+    sys->base.with = CT_BIT(CT_POSITION) | CT_BIT(CT_COLLIDER);
+    sys->base.main_core = false;
+    sys->players = world_cached_query(world,
+        CT_BIT(CT_PLAYER) | CT_BIT(CT_POSITION) | CT_BIT(CT_COLLIDER) | CT_BIT(CT_VELOCITY));
+    sys->platforms = world_cached_query(world, CT_BIT(CT_PLATFORM) | CT_BIT(CT_POSITION) | CT_BIT(CT_COLLIDER));
+    sys->enemies = world_cached_query(world, CT_BIT(CT_ENEMY) | CT_BIT(CT_POSITION) | CT_BIT(CT_COLLIDER));
+    sys->collectibles = world_cached_query(world,
+        CT_BIT(CT_COLLECTIBLE) | CT_BIT(CT_POSITION) | CT_BIT(CT_COLLIDER));
+    sys->walkers = world_cached_query(world,
+        CT_BIT(CT_ENEMY) | CT_BIT(CT_POSITION) | CT_BIT(CT_COLLIDER) | CT_BIT(CT_VELOCITY));
+    broadphase_init(&sys->broadphase);
     return sys;
 }
 
@@ -708,47 +1420,110 @@ CollisionSystem* create_collision_system(void) {
 void enemy_ai_update(System* self, World* world, float dt) {
     if (!self || !world) return;
     
-    int required[] = {CT_ENEMY, CT_POSITION, CT_VELOCITY};
-    Array entities = world_query(world, required, 3);
+    EnemyAISystem* sys = (EnemyAISystem*)self;
     
-    for (int i = 0; i < entities.size; i++) {
-        EntityID* entity = array_get(&entities, i);
-        if (!entity) continue;
-        
-        EnemyComponent* enemy = world_get_component(world, *entity, CT_ENEMY);
-        PositionComponent* pos = world_get_component(world, *entity, CT_POSITION);
-        VelocityComponent* vel = world_get_component(world, *entity, CT_VELOCITY);
+    for (int a = 0; a < sys->enemies->archetypes.size; a++) {
+        Archetype* arch = query_archetype(sys->enemies, a);
         
-        if (!enemy || !pos || !vel) continue;
+        EnemyComponent* enemy = arch->columns[CT_ENEMY];
+        PositionComponent* pos = arch->columns[CT_POSITION];
+        VelocityComponent* vel = arch->columns[CT_VELOCITY];
         
-        vel->x = enemy->move_speed * enemy->move_direction;
-        
-        if (pos->x <= enemy->patrol_start) {
-            enemy->move_direction = 1.0f;
-            pos->x = enemy->patrol_start;
-        } else if (pos->x >= enemy->patrol_end) {
-            enemy->move_direction = -1.0f;
-            pos->x = enemy->patrol_end;
+        for (int i = 0; i < arch->count; i++) {
+            vel[i].x = enemy[i].move_speed * enemy[i].move_direction;
+            
+            if (pos[i].x <= enemy[i].patrol_start) {
+                enemy[i].move_direction = 1.0f;
+                pos[i].x = enemy[i].patrol_start;
+            } else if (pos[i].x >= enemy[i].patrol_end) {
+                enemy[i].move_direction = -1.0f;
+                pos[i].x = enemy[i].patrol_end;
+            }
         }
     }
-    
-    array_free(&entities);
 }
 
-EnemyAISystem* create_enemy_ai_system(void) {
+EnemyAISystem* create_enemy_ai_system(World* world) {
     EnemyAISystem* sys = malloc(sizeof(EnemyAISystem));
     assert(sys);
     sys->base.update = enemy_ai_update;
     sys->base.cleanup = NULL;
+    sys->base.reads = CT_BIT(CT_ENEMY) | CT_BIT(CT_POSITION);
+    sys->base.writes = CT_BIT(CT_ENEMY) | CT_BIT(CT_POSITION) | CT_BIT(CT_VELOCITY);
+    sys->base.with = CT_BIT(CT_ENEMY) | CT_BIT(CT_POSITION) | CT_BIT(CT_VELOCITY);
+    sys->base.main_core = false;
+    sys->enemies = world_cached_query(world, sys->base.with);
     return sys;
 }
 
 // Render System - IMPROVED with better camera
+
+// A sprite with a bitmap, in one window: the visible rows are expanded
+// a byte at a time into sprite_pixels and sent together. There is no
+// framebuffer to show through, so a clear bit is the sky
+#define SPRITE_MAX_PIXELS (32 * 32)
+
+static uint16_t sprite_pixels[SPRITE_MAX_PIXELS];
+
+static inline uint16_t wire_color(uint16_t color) {
+    return (uint16_t)(color >> 8 | color << 8);
+}
+
+static void render_bitmap(int x, int y, const SpriteComponent* sprite) {
+    int x0 = x < 0 ? -x : 0;
+    int y0 = y < 0 ? -y : 0;
+    int x1 = x + sprite->width > DISPLAY_WIDTH ? DISPLAY_WIDTH - x : sprite->width;
+    int y1 = y + sprite->height > DISPLAY_HEIGHT ? DISPLAY_HEIGHT - y : sprite->height;
+    if (x0 >= x1 || y0 >= y1) return;
+    
+    int width = x1 - x0, height = y1 - y0;
+    if (width * height > SPRITE_MAX_PIXELS) {
+        display_fill_rect(x + x0, y + y0, width, height, sprite->color);
+        return;
+    }
+    
+    const bitmap_lut_t* lut = bitmap_lut(wire_color(sprite->color), wire_color(SKY_COLOR));
+    int stride = BITMAP_STRIDE(sprite->width);
+    for (int row = y0; row < y1; row++) {
+        bitmap_expand_row(sprite_pixels + (row - y0) * width, sprite->bitmap + row * stride, x0, x1, lut);
+    }
+    display_blit_rect(x + x0, y + y0, width, height, sprite_pixels);
+}
+
+// Draw the sprites of a query that includes positions and sprites.
+// Only the ones on screen unless cull is false.
+static void render_sprites(World* world, Query* query, bool cull) {
+    for (int a = 0; a < query->archetypes.size; a++) {
+        Archetype* arch = query_archetype(query, a);
+        
+        PositionComponent* pos = arch->columns[CT_POSITION];
+        SpriteComponent* sprite = arch->columns[CT_SPRITE];
+        CollectibleComponent* coll = arch->columns[CT_COLLECTIBLE];
+        
+        for (int i = 0; i < arch->count; i++) {
+            if (coll && coll[i].collected) continue;
+            
+            int screen_x = (int)(pos[i].x - world->camera_x);
+            int screen_y = (int)pos[i].y;
+            
+            if (!cull || (screen_x + sprite[i].width >= 0 && screen_x < DISPLAY_WIDTH)) {
+                if (sprite[i].bitmap) {
+                    render_bitmap(screen_x, screen_y, &sprite[i]);
+                } else {
+                    display_fill_rect(screen_x, screen_y, sprite[i].width, sprite[i].height, sprite[i].color);
+                }
+            }
+        }
+    }
+}
+
 void render_update(System* self, World* world, float dt) {
     if (!self || !world) return;
     
+    RenderSystem* sys = (RenderSystem*)self;
+    
     // Clear screen to sky blue
-    display_clear(COLOR_CYAN);
+    display_clear(SKY_COLOR);
     
     // Update camera to follow player smoothly
     if (world->player_entity > 0) {
@@ -769,96 +1544,12 @@ void render_update(System* self, World* world, float dt) {
         }
     }
     
-    // Render platforms
-    int platform_required[] = {CT_PLATFORM, CT_POSITION, CT_SPRITE};
-    Array platforms = world_query(world, platform_required, 3);
-    
-    for (int i = 0; i < platforms.size; i++) {
-        EntityID* entity = array_get(&platforms, i);
-        if (!entity) continue;
-        
-        PositionComponent* pos = world_get_component(world, *entity, CT_POSITION);
-        SpriteComponent* sprite = world_get_component(world, *entity, CT_SPRITE);
-        
-        if (!pos || !sprite) continue;
-        
-        int screen_x = (int)(pos->x - world->camera_x);
-        int screen_y = (int)pos->y;
-        
-        // Only render if on screen
-        if (screen_x + sprite->width >= 0 && screen_x < DISPLAY_WIDTH) {
-            display_fill_rect(screen_x, screen_y, sprite->width, sprite->height, sprite->color);
-        }
-    }
-    array_free(&platforms);
-    
-    // Render collectibles
-    int coll_required[] = {CT_COLLECTIBLE, CT_POSITION, CT_SPRITE};
-    Array collectibles = world_query(world, coll_required, 3);
-    
-    for (int i = 0; i < collectibles.size; i++) {
-        EntityID* entity = array_get(&collectibles, i);
-        if (!entity) continue;
-        
-        CollectibleComponent* coll = world_get_component(world, *entity, CT_COLLECTIBLE);
-        
-        if (!coll || coll->collected) continue;
-        
-        PositionComponent* pos = world_get_component(world, *entity, CT_POSITION);
-        SpriteComponent* sprite = world_get_component(world, *entity, CT_SPRITE);
-        
-        if (!pos || !sprite) continue;
-        
-        int screen_x = (int)(pos->x - world->camera_x);
-        int screen_y = (int)pos->y;
-        
-        if (screen_x + sprite->width >= 0 && screen_x < DISPLAY_WIDTH) {
-            display_fill_rect(screen_x, screen_y, sprite->width, sprite->height, sprite->color);
-        }
-    }
-    array_free(&collectibles);
-    
-    // Render enemies
-    int enemy_required[] = {CT_ENEMY, CT_POSITION, CT_SPRITE};
-    Array enemies = world_query(world, enemy_required, 3);
-    
-    for (int i = 0; i < enemies.size; i++) {
-        EntityID* entity = array_get(&enemies, i);
-        if (!entity) continue;
-        
-        PositionComponent* pos = world_get_component(world, *entity, CT_POSITION);
-        SpriteComponent* sprite = world_get_component(world, *entity, CT_SPRITE);
-        
-        if (!pos || !sprite) continue;
-        
-        int screen_x = (int)(pos->x - world->camera_x);
-        int screen_y = (int)pos->y;
-        
-        if (screen_x + sprite->width >= 0 && screen_x < DISPLAY_WIDTH) {
-            display_fill_rect(screen_x, screen_y, sprite->width, sprite->height, sprite->color);
-        }
-    }
-    array_free(&enemies);
+    render_sprites(world, sys->platforms, true);
+    render_sprites(world, sys->collectibles, true);
+    render_sprites(world, sys->enemies, true);
     
     // Render player (always render, even off screen slightly)
-    int player_required[] = {CT_PLAYER, CT_POSITION, CT_SPRITE};
-    Array players = world_query(world, player_required, 3);
-    
-    for (int i = 0; i < players.size; i++) {
-        EntityID* entity = array_get(&players, i);
-        if (!entity) continue;
-        
-        PositionComponent* pos = world_get_component(world, *entity, CT_POSITION);
-        SpriteComponent* sprite = world_get_component(world, *entity, CT_SPRITE);
-        
-        if (!pos || !sprite) continue;
-        
-        int screen_x = (int)(pos->x - world->camera_x);
-        int screen_y = (int)pos->y;
-        
-        display_fill_rect(screen_x, screen_y, sprite->width, sprite->height, sprite->color);
-    }
-    array_free(&players);
+    render_sprites(world, sys->players, false);
     
     // UI - Score
     char score_text[32];
@@ -882,14 +1573,62 @@ void render_update(System* self, World* world, float dt) {
     }
 }
 
-RenderSystem* create_render_system(void) {
+RenderSystem* create_render_system(World* world) {
     RenderSystem* sys = malloc(sizeof(RenderSystem));
     assert(sys);
     sys->base.update = render_update;
     sys->base.cleanup = NULL;
+    sys->base.reads = WORLD_STATE | CT_BIT(CT_POSITION) | CT_BIT(CT_SPRITE) | CT_BIT(CT_COLLECTIBLE) |
+                      CT_BIT(CT_PLAYER);
+    sys->base.writes = WORLD_STATE;  // the camera
+    sys->base.with = CT_BIT(CT_POSITION) | CT_BIT(CT_SPRITE);
+    sys->base.main_core = true;
+    uint32_t drawn = CT_BIT(CT_POSITION) | CT_BIT(CT_SPRITE);
+    sys->platforms = world_cached_query(world, CT_BIT(CT_PLATFORM) | drawn);
+    sys->collectibles = world_cached_query(world, CT_BIT(CT_COLLECTIBLE) | drawn);
+    sys->enemies = world_cached_query(world, CT_BIT(CT_ENEMY) | drawn);
+    sys->players = world_cached_query(world, CT_BIT(CT_PLAYER) | drawn);
     return sys;
 }
 
+static void spawn_enemy(World* world, float x, float y, float patrol_start, float patrol_end, float speed) {
+    EntityID enemy = world_create_entity(world);
+    
+    PositionComponent e_pos = {x, y};
+    world_add_component(world, enemy, CT_POSITION, &e_pos, sizeof(PositionComponent));
+    
+    VelocityComponent e_vel = {0, 0};
+    world_add_component(world, enemy, CT_VELOCITY, &e_vel, sizeof(VelocityComponent));
+    
+    SpriteComponent e_sprite = {COLOR_RED, 12, 12, sprite_enemy};
+    world_add_component(world, enemy, CT_SPRITE, &e_sprite, sizeof(SpriteComponent));
+    
+    ColliderComponent e_collider = {12, 12, 0, 0};
+    world_add_component(world, enemy, CT_COLLIDER, &e_collider, sizeof(ColliderComponent));
+    
+    EnemyComponent e_comp = {speed, 1.0f, patrol_start, patrol_end};
+    world_add_component(world, enemy, CT_ENEMY, &e_comp, sizeof(EnemyComponent));
+    
+    PhysicsComponent e_phys = {400.0f, 200.0f, 0.9f, true};
+    world_add_component(world, enemy, CT_PHYSICS, &e_phys, sizeof(PhysicsComponent));
+}
+
+static void spawn_coin(World* world, float x, float y) {
+    EntityID coin = world_create_entity(world);
+    
+    PositionComponent c_pos = {x, y};
+    world_add_component(world, coin, CT_POSITION, &c_pos, sizeof(PositionComponent));
+    
+    SpriteComponent c_sprite = {COLOR_YELLOW, 8, 8, sprite_coin};
+    world_add_component(world, coin, CT_SPRITE, &c_sprite, sizeof(SpriteComponent));
+    
+    ColliderComponent c_collider = {8, 8, 0, 0};
+    world_add_component(world, coin, CT_COLLIDER, &c_collider, sizeof(ColliderComponent));
+    
+    CollectibleComponent c_comp = {50, false};
+    world_add_component(world, coin, CT_COLLECTIBLE, &c_comp, sizeof(CollectibleComponent));
+}
+
 // Game init - IMPROVED LEVEL with FIXED player spawn position
 void game_create_level(World* world) {
     assert(world);
@@ -968,50 +1707,27 @@ void game_create_level(World* world) {
     };
     
     for (int i = 0; i < sizeof(enemy_data) / sizeof(enemy_data[0]); i++) {
-        EntityID enemy = world_create_entity(world);
-        
-        PositionComponent e_pos = {enemy_data[i].x, enemy_data[i].y};
-        world_add_component(world, enemy, CT_POSITION, &e_pos, sizeof(PositionComponent));
-        
-        VelocityComponent e_vel = {0, 0};
-        world_add_component(world, enemy, CT_VELOCITY, &e_vel, sizeof(VelocityComponent));
-        
-        SpriteComponent e_sprite = {COLOR_RED, 12, 12, NULL};
-        world_add_component(world, enemy, CT_SPRITE, &e_sprite, sizeof(SpriteComponent));
-        
-        ColliderComponent e_collider = {12, 12, 0, 0};
-        world_add_component(world, enemy, CT_COLLIDER, &e_collider, sizeof(ColliderComponent));
-        
-        EnemyComponent e_comp = {
-            enemy_data[i].speed,
-            1.0f,
-            enemy_data[i].patrol_start,
-            enemy_data[i].patrol_end
-        };
-        world_add_component(world, enemy, CT_ENEMY, &e_comp, sizeof(EnemyComponent));
-        
-        PhysicsComponent e_phys = {400.0f, 200.0f, 0.9f, true};
-        world_add_component(world, enemy, CT_PHYSICS, &e_phys, sizeof(PhysicsComponent));
+        spawn_enemy(world, enemy_data[i].x, enemy_data[i].y,
+                    enemy_data[i].patrol_start, enemy_data[i].patrol_end, enemy_data[i].speed);
     }
     
     // Create collectibles (coins) throughout the level
     for (int i = 0; i < 20; i++) {
-        EntityID coin = world_create_entity(world);
-        
-        float coin_x = 150.0f + i * 100.0f;
-        float coin_y = 100.0f + (i % 3) * 30.0f;
-        
-        PositionComponent c_pos = {coin_x, coin_y};
-        world_add_component(world, coin, CT_POSITION, &c_pos, sizeof(PositionComponent));
-        
-        SpriteComponent c_sprite = {COLOR_YELLOW, 8, 8, NULL};
-        world_add_component(world, coin, CT_SPRITE, &c_sprite, sizeof(SpriteComponent));
-        
-        ColliderComponent c_collider = {8, 8, 0, 0};
-        world_add_component(world, coin, CT_COLLIDER, &c_collider, sizeof(ColliderComponent));
-        
-        CollectibleComponent c_comp = {50, false};
-        world_add_component(world, coin, CT_COLLECTIBLE, &c_comp, sizeof(CollectibleComponent));
+        spawn_coin(world, 150.0f + i * 100.0f, 100.0f + (i % 3) * 30.0f);
+    }
+    
+    // Stress test: the same again many times, at places from a fixed
+    // pseudo random sequence so every run is alike
+    unsigned int seed = 12345;
+    for (int i = 0; i < STRESS_ENTITIES; i++) {
+        seed = seed * 1103515245u + 12345u;
+        float x = 100.0f + (seed >> 8) % (WORLD_WIDTH - 200);
+        float y = 60.0f + (seed >> 4) % 120;
+        if (i % 2 == 0) {
+            spawn_enemy(world, x, y, x - 40.0f, x + 40.0f, 20.0f + (seed >> 16) % 25);
+        } else {
+            spawn_coin(world, x, y);
+        }
     }
     
     // Create player - FIXED: spawn on ground
@@ -1019,16 +1735,16 @@ void game_create_level(World* world) {
     world->player_entity = player;
     
     // FIXED: Place player ON the ground platform (ground_y - player_height)
-    PositionComponent p_pos = {50.0f, GROUND_HEIGHT - 14.0f};
+    PositionComponent p_pos = {50.0f, GROUND_HEIGHT - PLAYER_SIZE};
     world_add_component(world, player, CT_POSITION, &p_pos, sizeof(PositionComponent));
     
     VelocityComponent p_vel = {0, 0};
     world_add_component(world, player, CT_VELOCITY, &p_vel, sizeof(VelocityComponent));
     
-    SpriteComponent p_sprite = {COLOR_BLUE, 14, 14, NULL};
+    SpriteComponent p_sprite = {COLOR_BLUE, PLAYER_SIZE, PLAYER_SIZE, sprite_player};
     world_add_component(world, player, CT_SPRITE, &p_sprite, sizeof(SpriteComponent));
     
-    ColliderComponent p_collider = {14, 14, 0, 0};
+    ColliderComponent p_collider = {PLAYER_SIZE, PLAYER_SIZE, 0, 0};
     world_add_component(world, player, CT_COLLIDER, &p_collider, sizeof(ColliderComponent));
     
     PlayerComponent p_player = {false, 0, 2, 3};
@@ -1044,12 +1760,20 @@ void game_init(World* world) {
     world_init(world);
     
     // Add systems in order
-    world_add_system(world, (System*)create_input_system());
-    world_add_system(world, (System*)create_enemy_ai_system());
-    world_add_system(world, (System*)create_physics_system());
-    world_add_system(world, (System*)create_collision_system());
-    world_add_system(world, (System*)create_render_system());
-    
-    // Create level entities
+    world_add_system(world, (System*)create_input_system(world));
+    world_add_system(world, (System*)create_enemy_ai_system(world));
+    world_add_system(world, (System*)create_physics_system(world));
+    world_add_system(world, (System*)create_collision_system(world));
+    world_add_system(world, (System*)create_render_system(world));
+    
+    // Create level entities, copied from the prebaked image when there
+    // is one for this build
+#ifdef LEVEL_IMAGE
+    if (level_load(world, level_image, sizeof(level_image))) return;
+    printf("Level image is not from this build, building the level\n");
+#endif
     game_create_level(world);
+#ifdef LEVEL_DUMP
+    level_dump(world);
+#endif
 }
@@ -9,8 +9,20 @@
 
 // ECS Core Types
 
+// An EntityID is the index of the entity's record in the world plus the
+// generation of that record in the bits above. Destroying an entity
+// bumps the generation, so an old ID no longer matches when the index
+// is reused. IDs are always positive; 0 is no entity.
 typedef int EntityID;
 
+#define ENTITY_INDEX_BITS 20
+#define ENTITY_INDEX_MASK ((1 << ENTITY_INDEX_BITS) - 1)
+#define ENTITY_GENERATION_MASK 0x7FF   // 11 bits, leaves the sign bit clear
+
+#define entity_index(id) ((id) & ENTITY_INDEX_MASK)
+#define entity_generation(id) (((id) >> ENTITY_INDEX_BITS) & ENTITY_GENERATION_MASK)
+#define entity_make(index, generation) (((generation) << ENTITY_INDEX_BITS) | (index))
+
 // Dynamic Array
 typedef struct {
     void* data;
@@ -20,36 +32,151 @@ typedef struct {
 } Array;
 
 // Hash Map Entry
-typedef struct MapEntry {
+typedef struct {
     int key;
-    void* value;
-    struct MapEntry* next;
+    void* value;            // NULL when the slot is empty
 } MapEntry;
 
-// Hash Map
+// Hash Map: open addressing with linear probing in a power of two
+// table, removal shifts the following entries back so there are no
+// tombstones
 typedef struct {
     MapEntry* entries;
     int capacity;
     int size;
 } HashMap;
 
+// Component Types
+
+enum ComponentType {
+    CT_POSITION = 1,
+    CT_VELOCITY,
+    CT_SPRITE,
+    CT_PLAYER,
+    CT_COLLIDER,
+    CT_PHYSICS,
+    CT_ENEMY,
+    CT_PLATFORM,
+    CT_COLLECTIBLE,
+    CT_ANIMATION,
+    CT_COUNT
+};
+
+// Bit of a component type in an archetype mask
+#define CT_BIT(type) (1u << (type))
+
+// Bit 0 is no component type; systems declare with it that they use
+// the world's own fields (score, camera, game over, destroyed entities)
+#define WORLD_STATE CT_BIT(0)
+
+// Archetype: all entities with exactly the same set of components.
+// Every component type has its own contiguous column (struct of arrays),
+// and row i of each column belongs to entities[i].
+typedef struct {
+    uint32_t mask;              // CT_BIT of every component type it has
+    int count;
+    int capacity;
+    EntityID* entities;
+    void* columns[CT_COUNT];    // NULL for types not in the mask
+} Archetype;
+
+// Cached query: the archetypes that have all the component types in
+// mask. The world adds every new matching archetype to it, so a system
+// holding a query never has to search for its entities.
+typedef struct {
+    uint32_t mask;
+    Array archetypes;           // Archetype*
+} Query;
+
+// Where the components of an entity live. Records of destroyed
+// entities have no archetype and are chained into a free list.
+typedef struct {
+    Archetype* archetype;
+    int row;
+    int generation;
+    int next_free;          // index of the next free record, or -1
+} EntityRecord;
+
+// Broadphase: a uniform grid of BROADPHASE_CELL pixel cells, hashed
+// into a fixed number of buckets so the world can have any size. It is
+// filled with the colliders once a frame and then asked which of them
+// may overlap a box, so collision never tests every pair.
+#define BROADPHASE_CELL 32
+#define BROADPHASE_BUCKETS 256
+
+typedef struct {
+    float x, y, w, h;
+    Archetype* archetype;
+    int row;
+} BroadphaseItem;
+
+typedef struct {
+    Array items;            // BroadphaseItem
+    Array stamps;           // int per item, last query that found it
+    Array cells;            // item indices grouped by bucket
+    int bucket_start[BROADPHASE_BUCKETS + 1];
+    Array results;          // item indices found by the last query
+    int query_id;
+} Broadphase;
+
+// Command buffer: structural changes recorded while systems run and
+// applied together at the end of world_update, so no system ever sees
+// rows move under it. Every system has its own, so recording needs no
+// lock. An entity created through a buffer gets a negative ID that later
+// commands of the same buffer can use; it is real once applied.
+enum CommandOp {
+    CMD_CREATE,
+    CMD_DESTROY,
+    CMD_ADD,
+    CMD_REMOVE
+};
+
+typedef struct {
+    int op;
+    EntityID entity;
+    int component;
+    int offset;             // of the component value in the buffer's data
+    int seq;                // order of the command in the whole batch
+    const uint8_t* value;   // set when the batch is collected
+} Command;
+
+typedef struct {
+    Array commands;         // Command
+    Array data;             // bytes of the values of CMD_ADD
+    int created;            // CMD_CREATE recorded so far
+} CommandBuffer;
+
 // System interface
 typedef struct System System;
 typedef struct World World;
 
+// Besides its functions a system declares what it touches, so that
+// world_update can run systems that do not conflict at the same time
 struct System {
     void (*update)(System* self, World* world, float dt);
     void (*cleanup)(System* self);
+    uint32_t reads;         // CT_BIT of the component types it reads
+    uint32_t writes;        // ... and those it writes
+    uint32_t with;          // components every entity it touches has
+    bool main_core;         // must run on the core that drives the display
+    CommandBuffer commands; // structural changes it makes
 };
 
+#define WORLD_MAX_SYSTEMS 16
+
 // World structure
 struct World {
-    int next_entity_id;
-    HashMap entity_components;
-    HashMap components;
-    HashMap component_entities;
+    Array entities;           // EntityRecord, by entity_index
+    int free_entity;          // first free record, or -1
+    int alive_count;
+    Array archetypes;         // Archetype*, the empty archetype first
+    HashMap archetype_index;  // mask -> Archetype*
+    Array queries;            // Query*, one per distinct mask
+    HashMap query_index;      // mask -> Query*
     Array systems;
-    Array dead_entities;  // NEW: Track entities to delete
+    CommandBuffer commands;   // structural changes made outside systems
+    Array batch;              // Command, all buffers of one update
+    Array created;            // EntityID, made for one buffer's CMD_CREATE
     float camera_x;
     float camera_y;
     bool game_over;
@@ -57,21 +184,6 @@ struct World {
     EntityID player_entity;
 };
 
-// Component Types
-
-enum ComponentType {
-    CT_POSITION = 1,
-    CT_VELOCITY,
-    CT_SPRITE,
-    CT_PLAYER,
-    CT_COLLIDER,
-    CT_PHYSICS,
-    CT_ENEMY,
-    CT_PLATFORM,
-    CT_COLLECTIBLE,
-    CT_ANIMATION
-};
-
 // Position component
 typedef struct {
     float x, y;
@@ -150,6 +262,8 @@ void array_init(Array* arr, int elem_size);
 void array_add(Array* arr, void* item);
 void* array_get(Array* arr, int index);
 void array_remove(Array* arr, int index);  // NEW: Remove element
+void array_resize(Array* arr, int size);
+void array_add_bytes(Array* arr, const void* bytes, int count);
 void array_free(Array* arr);
 
 // HashMap functions
@@ -164,49 +278,89 @@ void hashmap_free(HashMap* map);
 void world_init(World* world);
 EntityID world_create_entity(World* world);
 void world_add_component(World* world, EntityID entity, int type, void* data, int data_size);
+void world_remove_component(World* world, EntityID entity, int type);
 void* world_get_component(World* world, EntityID entity, int type);
 int world_has_component(World* world, EntityID entity, int type);
+bool world_is_alive(World* world, EntityID entity);
+Archetype* world_archetype(World* world, int index);
+uint32_t component_mask(int* types, int count);
+Query* world_cached_query(World* world, uint32_t mask);
+Archetype* query_archetype(Query* query, int index);
 Array world_query(World* world, int* required, int req_count);
 void world_add_system(World* world, System* system);
 void world_update(World* world, float dt);
 void world_destroy_entity(World* world, EntityID entity);  // Deferred deletion
 void world_destroy_entity_immediate(World* world, EntityID entity);  // NEW: Immediate deletion
+void world_apply_commands(World* world);
 void world_free(World* world);
 
+// Command buffer functions
+void commands_init(CommandBuffer* buf);
+EntityID commands_create(CommandBuffer* buf);
+void commands_destroy(CommandBuffer* buf, EntityID entity);
+void commands_add(CommandBuffer* buf, EntityID entity, int type, const void* data, int data_size);
+void commands_remove(CommandBuffer* buf, EntityID entity, int type);
+void commands_clear(CommandBuffer* buf);
+void commands_free(CommandBuffer* buf);
+
 // Collision detection
 bool check_collision(float x1, float y1, float w1, float h1,
                      float x2, float y2, float w2, float h2);
 
+// Broadphase functions
+void broadphase_init(Broadphase* bp);
+void broadphase_clear(Broadphase* bp);
+void broadphase_insert(Broadphase* bp, Archetype* arch, int row, float x, float y, float w, float h);
+void broadphase_build(Broadphase* bp);
+Array* broadphase_query(Broadphase* bp, float x, float y, float w, float h);
+BroadphaseItem* broadphase_item(Broadphase* bp, int index);
+void broadphase_free(Broadphase* bp);
+
 // Game initialization
 void game_init(World* world);
 void game_create_level(World* world);
 
+// Level images: a built world saved as one blob and loaded by copying
+// its archetype columns (see game.c)
+Array level_save(World* world);
+bool level_load(World* world, const uint8_t* image, size_t size);
+void level_dump(World* world);
+
 // System Declarations
 
 // Input System
 typedef struct {
     System base;
     bool last_jump_pressed;
+    Query* players;
 } InputSystem;
-InputSystem* create_input_system(void);
+InputSystem* create_input_system(World* world);
 
 // Physics System
 typedef struct {
     System base;
+    Query* bodies;
 } PhysicsSystem;
-PhysicsSystem* create_physics_system(void);
+PhysicsSystem* create_physics_system(World* world);
 
 // Collision System
 typedef struct {
     System base;
+    Query* players;
+    Query* platforms;
+    Query* enemies;
+    Query* collectibles;
+    Query* walkers;         // enemies that stand on platforms
+    Broadphase broadphase;
 } CollisionSystem;
-CollisionSystem* create_collision_system(void);
+CollisionSystem* create_collision_system(World* world);
 
 // Enemy AI System
 typedef struct {
     System base;
+    Query* enemies;
 } EnemyAISystem;
-EnemyAISystem* create_enemy_ai_system(void);
+EnemyAISystem* create_enemy_ai_system(World* world);
 
 // Animation System
 typedef struct {
@@ -217,7 +371,11 @@ AnimationSystem* create_animation_system(void);
 // Render System
 typedef struct {
     System base;
+    Query* platforms;
+    Query* collectibles;
+    Query* enemies;
+    Query* players;
 } RenderSystem;
-RenderSystem* create_render_system(void);
+RenderSystem* create_render_system(World* world);
 
 #endif // GAME_H
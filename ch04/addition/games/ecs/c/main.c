@@ -3,6 +3,7 @@
 #include "pico/time.h"
 #include "display.h"
 #include "game.h"
+#include "scheduler.h"
 
 // Game state
 static World world;
@@ -61,8 +62,10 @@ int main() {
     
     // Initialize game world
     printf("Init game world ..\n");
+    uint32_t init_start = time_us_32();
     game_init(&world);
-    printf("Game world created with player entity ID: %d\n", world.player_entity);
+    printf("Game world created in %lu us with player entity ID: %d\n",
+           (unsigned long)(time_us_32() - init_start), world.player_entity);
     
     // Show startup message
     display_clear(COLOR_BLACK);
@@ -116,7 +119,7 @@ int main() {
                 // Print debug info every second
                 printf("FPS: %d | Score: %d | Entities alive: %d\n", 
                        fps, world.score, 
-                       world.entity_components.size);
+                       world.alive_count);
             }
             
             last_frame_time = current_time;
@@ -133,8 +136,9 @@ int main() {
     printf("\n-= Shutting down =-\n");
     printf("Final score: %d\n", world.score);
     
-    // Clean up game world
+    // Clean up game world and stop core 1
     world_free(&world);
+    scheduler_shutdown();
     printf("Game world cleaned up\n");
     
     // Show exit message
@@ -0,0 +1,198 @@
+#include "scheduler.h"
+#include "game.h"
+#include <assert.h>
+
+#if defined(LIB_PICO_MULTICORE) || defined(ECS_THREADS)
+
+// The stage being run. Systems flagged main_core always run on the
+// caller, the others wherever there is a free core.
+static System** stage_systems;
+static int stage_count;
+static World* stage_world;
+static float stage_dt;
+
+static void run_system(System* sys) {
+    sys->update(sys, stage_world, stage_dt);
+}
+
+#endif
+
+static void run_serial(System** systems, int count, World* world, float dt) {
+    for (int i = 0; i < count; i++) {
+        systems[i]->update(systems[i], world, dt);
+    }
+}
+
+#if defined(LIB_PICO_MULTICORE)
+
+#include "jobs.h"
+
+// Core 1 gets the systems given to it as one job of the shared job
+// system, and the caller waits for it. The stage is in memory.
+
+static bool on_core1[WORLD_MAX_SYSTEMS];
+static bool core1_running = false;
+
+static void core1_systems(void* arg) {
+    (void)arg;
+    for (int i = 0; i < stage_count; i++) {
+        if (on_core1[i]) run_system(stage_systems[i]);
+    }
+}
+
+void scheduler_init(void) {
+    if (core1_running) return;
+    jobs_init();
+    core1_running = true;
+}
+
+void scheduler_run(System** systems, int count, World* world, float dt) {
+    if (count < 2 || !core1_running) {
+        run_serial(systems, count, world, dt);
+        return;
+    }
+    
+    // Give each system to the core with fewer so far, main core first
+    int load0 = 0, load1 = 0;
+    for (int i = 0; i < count; i++) {
+        if (systems[i]->main_core) load0++;
+    }
+    for (int i = 0; i < count; i++) {
+        on_core1[i] = !systems[i]->main_core && load1 < load0;
+        if (on_core1[i]) load1++;
+        else if (!systems[i]->main_core) load0++;
+    }
+    if (load1 == 0) {
+        run_serial(systems, count, world, dt);
+        return;
+    }
+    
+    stage_systems = systems;
+    stage_count = count;
+    stage_world = world;
+    stage_dt = dt;
+    bool shared = jobs_submit(core1_systems, NULL);
+    for (int i = 0; i < count; i++) {
+        if (!on_core1[i] || !shared) run_system(systems[i]);
+    }
+    if (shared) jobs_wait();
+}
+
+void scheduler_shutdown(void) {
+    if (!core1_running) return;
+    jobs_shutdown();
+    core1_running = false;
+}
+
+#elif defined(ECS_THREADS)
+
+#include <pthread.h>
+
+#ifndef SCHEDULER_WORKERS
+#define SCHEDULER_WORKERS 3
+#endif
+
+// Workers sleep until the generation changes, then take systems from the
+// stage by index until none are left. The caller does the same after
+// running the main_core systems, and waits until pending drops to zero.
+
+static pthread_t workers[SCHEDULER_WORKERS];
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t start = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t done = PTHREAD_COND_INITIALIZER;
+static int generation = 0;
+static int next_system = 0;
+static int pending = 0;
+static bool stopping = false;
+static bool started = false;
+
+// called and returns with the lock held
+static void take_systems(void) {
+    while (next_system < stage_count) {
+        System* sys = stage_systems[next_system++];
+        if (sys->main_core) continue;
+        pthread_mutex_unlock(&lock);
+        run_system(sys);
+        pthread_mutex_lock(&lock);
+        if (--pending == 0) pthread_cond_signal(&done);
+    }
+}
+
+static void* worker(void* arg) {
+    (void)arg;
+    int seen = 0;
+    pthread_mutex_lock(&lock);
+    while (true) {
+        while (generation == seen && !stopping) pthread_cond_wait(&start, &lock);
+        if (stopping) break;
+        seen = generation;
+        take_systems();
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+void scheduler_init(void) {
+    if (started) return;
+    stopping = false;
+    for (int i = 0; i < SCHEDULER_WORKERS; i++) {
+        int failed = pthread_create(&workers[i], NULL, worker, NULL);
+        assert(!failed && "Scheduler thread creation failed");
+        (void)failed;
+    }
+    started = true;
+}
+
+void scheduler_run(System** systems, int count, World* world, float dt) {
+    if (count < 2 || !started) {
+        run_serial(systems, count, world, dt);
+        return;
+    }
+    
+    pthread_mutex_lock(&lock);
+    stage_systems = systems;
+    stage_count = count;
+    stage_world = world;
+    stage_dt = dt;
+    next_system = 0;
+    pending = 0;
+    for (int i = 0; i < count; i++) {
+        if (!systems[i]->main_core) pending++;
+    }
+    generation++;
+    pthread_cond_broadcast(&start);
+    pthread_mutex_unlock(&lock);
+    
+    for (int i = 0; i < count; i++) {
+        if (systems[i]->main_core) run_system(systems[i]);
+    }
+    
+    pthread_mutex_lock(&lock);
+    take_systems();
+    while (pending > 0) pthread_cond_wait(&done, &lock);
+    pthread_mutex_unlock(&lock);
+}
+
+void scheduler_shutdown(void) {
+    if (!started) return;
+    pthread_mutex_lock(&lock);
+    stopping = true;
+    pthread_cond_broadcast(&start);
+    pthread_mutex_unlock(&lock);
+    for (int i = 0; i < SCHEDULER_WORKERS; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    started = false;
+}
+
+#else
+
+void scheduler_init(void) {}
+
+void scheduler_run(System** systems, int count, World* world, float dt) {
+    run_serial(systems, count, world, dt);
+}
+
+void scheduler_shutdown(void) {}
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+// Runs the systems of one stage of world_update at the same time. On the
+// Pico the second core takes part (link pico_multicore), on a host build
+// compiled with -DECS_THREADS a small pool of threads. Otherwise the
+// systems simply run one after the other.
+
+typedef struct System System;
+typedef struct World World;
+
+void scheduler_init(void);
+void scheduler_run(System** systems, int count, World* world, float dt);
+void scheduler_shutdown(void);
+
+#endif // SCHEDULER_H
@@ -5,13 +5,14 @@
 
 // sprite bitmaps
 
-// These are simple 1-bit bitmaps that can be used
-// for more detailed sprites. For now, we're using
-// solid color rectangles in the game, but you can
-// expand this to use actual bitmap data
+// These are simple 1-bit bitmaps for the sprites.
+// A SpriteComponent with a bitmap is drawn from it
+// in its color (see render_bitmap() in game.c),
+// one without as a solid color rectangle
 //
 // Format: Each byte represents 8 pixels
-// (1 bit per pixel)
+// (1 bit per pixel, leftmost in bit 7), each row
+// (width + 7) / 8 bytes
 // You can create sprites using tools or by hand
 
 // Example 16x16 player sprite (Mario-style)
@@ -7,7 +7,12 @@
 
 #define MAX_ENTITIES   4
 #define CELL_SIZE      8
-#define FLASH_FRAMES   15
+#define FLASH_FRAMES   15      // ticks
+
+// Fixed timestep: the game moves in ticks, whatever drawing costs
+#define TICK_US             50000   // 20 ticks a second
+#define MAX_TICKS_PER_FRAME 4       // lag beyond this is dropped
+#define FRAME_US            16667   // draw at most ~60 times a second
 
 /*  Entity structure  */
 typedef struct {
@@ -32,13 +37,15 @@ static struct {
     GameState state;
     GameState prev_state;
     Entity entities[MAX_ENTITIES];
-    Entity prev_entities[MAX_ENTITIES];  // Previous positions for clearing
+    Entity prev_entities[MAX_ENTITIES];  // Positions before the last tick
+    int16_t drawn_x[MAX_ENTITIES];       // Pixel positions on screen, to erase
+    int16_t drawn_y[MAX_ENTITIES];
     uint32_t score;
     uint32_t frame_count;
     int16_t field_width;   // In cells
     int16_t field_height;  // In cells
     bool needs_render;     // Flag to force render
-    bool first_render;     // First render flag
+    bool first_render;     // Clear the screen, nothing drawn on it yet
 } game;
 
 /*  State machine functions  */
@@ -107,9 +114,16 @@ static void state_playing_enter(void) {
     memcpy(game.prev_entities, game.entities, sizeof(game.entities));
 }
 
+// Positions before this tick, for drawing in between ticks
+static void save_entity_positions(void) {
+    memcpy(game.prev_entities, game.entities, sizeof(game.entities));
+}
+
 static void state_playing_update(void) {
     Entity *player = &game.entities[0];
     
+    save_entity_positions();
+    
     // Handle input - set player direction
     if (button_pressed(BUTTON_Y)) {
         player->dx = 0;
@@ -175,28 +189,39 @@ static void state_playing_update(void) {
     game.frame_count++;
 }
 
-// Helper to save entity positions (called AFTER rendering)
-static void save_entity_positions(void) {
-    memcpy(game.prev_entities, game.entities, sizeof(game.entities));
-    // Clear first_render flag AFTER we've saved the initial positions
+// From cell a to cell b, alpha/256 of the way, in pixels
+static int16_t lerp_cell(int16_t a, int16_t b, uint8_t alpha) {
+    return (int16_t)((a * CELL_SIZE * 256 + (b - a) * CELL_SIZE * alpha) / 256);
+}
+
+// Entities alpha/256 of the way from their positions before the last
+// tick to now. Only what was drawn last time is erased, not the screen
+static void state_playing_render(uint8_t alpha) {
+    int16_t px[MAX_ENTITIES], py[MAX_ENTITIES];
+    for (int i = 0; i < MAX_ENTITIES; i++) {
+        px[i] = lerp_cell(game.prev_entities[i].x, game.entities[i].x, alpha);
+        py[i] = lerp_cell(game.prev_entities[i].y, game.entities[i].y, alpha);
+    }
+    
     if (game.first_render) {
+        display_clear(COLOR_BLACK);
         game.first_render = false;
+    } else {
+        for (int i = 0; i < MAX_ENTITIES; i++) {
+            if (game.drawn_x[i] != px[i] || game.drawn_y[i] != py[i]) {
+                display_fill_rect(game.drawn_x[i], game.drawn_y[i], CELL_SIZE, CELL_SIZE, COLOR_BLACK);
+            }
+        }
     }
-}
-
-static void state_playing_render(void) {
-    // Clear the whole screen
-    display_clear(COLOR_BLACK);
     
     // Wait for any DMA operations to complete before drawing
     display_wait_for_dma();
     
-    // Draw all entities at current positions
+    // Draw all entities, after all the erasing so none is cut into
     for (int i = 0; i < MAX_ENTITIES; i++) {
         Entity *e = &game.entities[i];
-        
-        uint16_t px = e->x * CELL_SIZE;
-        uint16_t py = e->y * CELL_SIZE;
+        game.drawn_x[i] = px[i];
+        game.drawn_y[i] = py[i];
         
         uint16_t color;
         if (e->is_player) {
@@ -207,7 +232,7 @@ static void state_playing_render(void) {
             color = COLOR_RED;
         }
         
-        display_fill_rect(px, py, CELL_SIZE, CELL_SIZE, color);
+        display_fill_rect(px[i], py[i], CELL_SIZE, CELL_SIZE, color);
     }
     
     // Draw score
@@ -253,14 +278,16 @@ static void state_paused_update(void) {
 }
 
 static void state_paused_render(void) {
-    // Render playing state in background
-    state_playing_render();
+    // Render playing state in background, where the last tick left it
+    state_playing_render(255);
     // Overlay pause message
     display_fill_rect(100, 100, 120, 30, COLOR_BLACK);
     display_draw_string(120, 110, "PAUSED", COLOR_CYAN, COLOR_BLACK);
 }
 
 /*  State machine dispatcher  */
+
+// One tick of the current state
 static void state_machine_update(void) {
     // Check for state change
     if (game.state != game.prev_state) {
@@ -297,10 +324,13 @@ static void state_machine_update(void) {
             state_paused_update();
             break;
     }
-    
+}
+
+// Draw the current state, alpha/256 of the way into the next tick
+static void state_machine_render(uint8_t alpha) {
     // State render - ALWAYS render playing state every frame
     if (game.state == STATE_PLAYING) {
-        state_playing_render();
+        state_playing_render(alpha);
     } else if (game.needs_render) {
         // Other states only render when needed
         switch (game.state) {
@@ -344,11 +374,40 @@ int main(void) {
     game.needs_render = true;
     game.first_render = true;
     
-    // Main loop
+    // Main loop. Time passed is banked in lag and spent a tick at a
+    // time: several ticks when a frame ran long, none when drawing is
+    // quicker than a tick. What is left, part of a tick, is how far to
+    // draw between the last two positions. The buttons are read once a
+    // tick, so a press is seen by exactly one update
+    uint32_t previous = time_us_32();
+    uint32_t lag = 0;
+    uint32_t ticks = 0, frames = 0, report = previous;
     while (1) {
-        buttons_update();
-        state_machine_update();
-        sleep_ms(50); // ~20 FPS
+        uint32_t now = time_us_32();
+        lag += now - previous;
+        previous = now;
+        
+        // A frame so long it would need more ticks than that to catch
+        // up slows the game instead of making the next frame longer still
+        if (lag > MAX_TICKS_PER_FRAME * TICK_US) lag = MAX_TICKS_PER_FRAME * TICK_US;
+        while (lag >= TICK_US) {
+            buttons_update();
+            state_machine_update();
+            lag -= TICK_US;
+            ticks++;
+        }
+        
+        state_machine_render((uint8_t)(lag * 255 / TICK_US));
+        frames++;
+        
+        if (now - report >= 5000000) {
+            printf("%lu ticks, %lu frames in 5 s\n", (unsigned long)ticks, (unsigned long)frames);
+            ticks = frames = 0;
+            report = now;
+        }
+        
+        uint32_t spent = time_us_32() - now;
+        if (spent < FRAME_US) sleep_us(FRAME_US - spent);
     }
     
     return 0;
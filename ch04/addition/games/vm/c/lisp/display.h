@@ -5,6 +5,16 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+// Hot functions are written RAM_FUNC(name). Built with RUN_FROM_RAM they
+// are copied to SRAM at boot and run from there, out of reach of the
+// misses of the flash XIP cache
+#ifdef RUN_FROM_RAM
+#include "pico/platform.h"
+#define RAM_FUNC(name) __not_in_flash_func(name)
+#else
+#define RAM_FUNC(name) name
+#endif
+
 // 320Ã—240 landscape
 #define DISPLAY_WIDTH  320
 #define DISPLAY_HEIGHT 240
@@ -93,6 +103,8 @@ uint16_t* disp_get_framebuffer(void);
 disp_error_t disp_framebuffer_flush(void);
 disp_error_t disp_framebuffer_clear(uint16_t color);
 void disp_framebuffer_set_pixel(uint16_t x, uint16_t y, uint16_t color);
+void disp_framebuffer_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+void disp_framebuffer_draw_text(uint16_t x, uint16_t y, const char *txt, uint16_t fg, uint16_t bg);
 
 // Buttons
 disp_error_t buttons_init(void);
@@ -2,13 +2,13 @@
 
 // Helper to get number arg
 static int32_t get_num(lisp_value_t *v) {
-    return IS_NUMBER(v) ? v->as.number : 0;
+    return (v && IS_NUMBER(v)) ? lisp_number_value(v) : 0;
 }
 
 // ===== Graphics Built-ins =====
 
-lisp_value_t* lisp_builtin_clear(lisp_vm_t *vm, lisp_value_t *args) {
-    uint16_t color = get_num(lisp_car(args));
+lisp_value_t* lisp_builtin_clear(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    uint16_t color = get_num(argv[0]);
     
     if (disp_get_framebuffer()) {
         disp_framebuffer_clear(color);
@@ -19,12 +19,12 @@ lisp_value_t* lisp_builtin_clear(lisp_vm_t *vm, lisp_value_t *args) {
     return lisp_nil(vm);
 }
 
-lisp_value_t* lisp_builtin_fill_rect(lisp_vm_t *vm, lisp_value_t *args) {
-    int16_t x = get_num(lisp_nth(args, 0));
-    int16_t y = get_num(lisp_nth(args, 1));
-    uint16_t w = get_num(lisp_nth(args, 2));
-    uint16_t h = get_num(lisp_nth(args, 3));
-    uint16_t color = get_num(lisp_nth(args, 4));
+lisp_value_t* lisp_builtin_fill_rect(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    int16_t x = get_num(argv[0]);
+    int16_t y = get_num(argv[1]);
+    uint16_t w = get_num(argv[2]);
+    uint16_t h = get_num(argv[3]);
+    uint16_t color = get_num(argv[4]);
     
     if (disp_get_framebuffer()) {
         disp_framebuffer_fill_rect(x, y, w, h, color);
@@ -35,18 +35,18 @@ lisp_value_t* lisp_builtin_fill_rect(lisp_vm_t *vm, lisp_value_t *args) {
     return lisp_nil(vm);
 }
 
-lisp_value_t* lisp_builtin_draw_text(lisp_vm_t *vm, lisp_value_t *args) {
-    int16_t x = get_num(lisp_nth(args, 0));
-    int16_t y = get_num(lisp_nth(args, 1));
-    lisp_value_t *text_val = lisp_nth(args, 2);
-    uint16_t fg = get_num(lisp_nth(args, 3));
-    uint16_t bg = get_num(lisp_nth(args, 4));
+lisp_value_t* lisp_builtin_draw_text(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    int16_t x = get_num(argv[0]);
+    int16_t y = get_num(argv[1]);
+    lisp_value_t *text_val = argv[2];
+    uint16_t fg = get_num(argv[3]);
+    uint16_t bg = get_num(argv[4]);
     
     const char *text = "";
     if (IS_STRING(text_val)) {
         text = text_val->as.string;
     } else if (IS_SYMBOL(text_val)) {
-        text = vm->symbols[text_val->as.symbol_id];
+        text = vm->symbols[lisp_symbol_id(text_val)];
     }
     
     if (disp_get_framebuffer()) {
@@ -58,10 +58,10 @@ lisp_value_t* lisp_builtin_draw_text(lisp_vm_t *vm, lisp_value_t *args) {
     return lisp_nil(vm);
 }
 
-lisp_value_t* lisp_builtin_draw_sprite(lisp_vm_t *vm, lisp_value_t *args) {
-    lisp_value_t *sprite_val = lisp_nth(args, 0);
-    int16_t x = get_num(lisp_nth(args, 1));
-    int16_t y = get_num(lisp_nth(args, 2));
+lisp_value_t* lisp_builtin_draw_sprite(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    lisp_value_t *sprite_val = argv[0];
+    int16_t x = get_num(argv[1]);
+    int16_t y = get_num(argv[2]);
     
     if (IS_SPRITE(sprite_val)) {
         lisp_draw_sprite(sprite_val->as.sprite, x, y);
@@ -72,9 +72,10 @@ lisp_value_t* lisp_builtin_draw_sprite(lisp_vm_t *vm, lisp_value_t *args) {
 
 // ===== Sprite Built-ins =====
 
-lisp_value_t* lisp_builtin_make_sprite(lisp_vm_t *vm, lisp_value_t *args) {
-    uint8_t w = get_num(lisp_nth(args, 0));
-    uint8_t h = get_num(lisp_nth(args, 1));
+lisp_value_t* lisp_builtin_make_sprite(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    int32_t w = get_num(argv[0]);
+    int32_t h = get_num(argv[1]);
+    if (w < 1 || w > 255 || h < 1 || h > 255) return lisp_nil(vm);
     
     lisp_sprite_t *sprite = lisp_create_sprite(vm, w, h, NULL);
     if (!sprite) return lisp_nil(vm);
@@ -84,17 +85,29 @@ lisp_value_t* lisp_builtin_make_sprite(lisp_vm_t *vm, lisp_value_t *args) {
     return v;
 }
 
-lisp_value_t* lisp_builtin_sprite_set_pixel(lisp_vm_t *vm, lisp_value_t *args) {
-    lisp_value_t *sprite_val = lisp_nth(args, 0);
-    uint8_t x = get_num(lisp_nth(args, 1));
-    uint8_t y = get_num(lisp_nth(args, 2));
-    uint16_t color = get_num(lisp_nth(args, 3));
+lisp_value_t* lisp_builtin_sprite_set_pixel(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    lisp_value_t *sprite_val = argv[0];
+    uint8_t x = get_num(argv[1]);
+    uint8_t y = get_num(argv[2]);
+    uint16_t color = get_num(argv[3]);
     
     if (IS_SPRITE(sprite_val)) {
-        lisp_sprite_t *sprite = sprite_val->as.sprite;
-        if (x < sprite->width && y < sprite->height) {
-            sprite->data[y * sprite->width + x] = color;
-        }
+        lisp_sprite_set_pixel(sprite_val->as.sprite, x, y, color);
+    }
+    
+    return sprite_val;
+}
+
+lisp_value_t* lisp_builtin_sprite_fill(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    lisp_value_t *sprite_val = argv[0];
+    uint8_t x = get_num(argv[1]);
+    uint8_t y = get_num(argv[2]);
+    int32_t w = get_num(argv[3]);
+    int32_t h = get_num(argv[4]);
+    uint16_t color = get_num(argv[5]);
+    
+    if (IS_SPRITE(sprite_val) && w > 0 && h > 0) {
+        lisp_sprite_fill(sprite_val->as.sprite, x, y, w > 255 ? 255 : w, h > 255 ? 255 : h, color);
     }
     
     return sprite_val;
@@ -102,20 +115,20 @@ lisp_value_t* lisp_builtin_sprite_set_pixel(lisp_vm_t *vm, lisp_value_t *args) {
 
 // ===== Collision Built-ins =====
 
-lisp_value_t* lisp_builtin_collide(lisp_vm_t *vm, lisp_value_t *args) {
+lisp_value_t* lisp_builtin_collide(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
     // (collide? x1 y1 w1 h1 x2 y2 w2 h2)
     lisp_rect_t a = {
-        get_num(lisp_nth(args, 0)),
-        get_num(lisp_nth(args, 1)),
-        get_num(lisp_nth(args, 2)),
-        get_num(lisp_nth(args, 3))
+        get_num(argv[0]),
+        get_num(argv[1]),
+        get_num(argv[2]),
+        get_num(argv[3])
     };
     
     lisp_rect_t b = {
-        get_num(lisp_nth(args, 4)),
-        get_num(lisp_nth(args, 5)),
-        get_num(lisp_nth(args, 6)),
-        get_num(lisp_nth(args, 7))
+        get_num(argv[4]),
+        get_num(argv[5]),
+        get_num(argv[6]),
+        get_num(argv[7])
     };
     
     bool collides = lisp_rect_collide(&a, &b);
@@ -124,85 +137,115 @@ lisp_value_t* lisp_builtin_collide(lisp_vm_t *vm, lisp_value_t *args) {
 
 // ===== Math Built-ins =====
 
-lisp_value_t* lisp_builtin_add(lisp_vm_t *vm, lisp_value_t *args) {
+lisp_value_t* lisp_builtin_add(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
     int32_t sum = 0;
-    while (IS_CONS(args)) {
-        sum += get_num(lisp_car(args));
-        args = lisp_cdr(args);
+    for (int i = 0; i < argc; i++) {
+        sum += get_num(argv[i]);
     }
     return lisp_number(vm, sum);
 }
 
-lisp_value_t* lisp_builtin_sub(lisp_vm_t *vm, lisp_value_t *args) {
-    if (!IS_CONS(args)) return lisp_number(vm, 0);
-    
-    int32_t result = get_num(lisp_car(args));
-    args = lisp_cdr(args);
-    
-    if (!IS_CONS(args)) {
-        return lisp_number(vm, -result);
-    }
+lisp_value_t* lisp_builtin_sub(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    int32_t result = get_num(argv[0]);
+    if (argc == 1) return lisp_number(vm, -result);
     
-    while (IS_CONS(args)) {
-        result -= get_num(lisp_car(args));
-        args = lisp_cdr(args);
+    for (int i = 1; i < argc; i++) {
+        result -= get_num(argv[i]);
     }
     return lisp_number(vm, result);
 }
 
-lisp_value_t* lisp_builtin_mul(lisp_vm_t *vm, lisp_value_t *args) {
+lisp_value_t* lisp_builtin_mul(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
     int32_t product = 1;
-    while (IS_CONS(args)) {
-        product *= get_num(lisp_car(args));
-        args = lisp_cdr(args);
+    for (int i = 0; i < argc; i++) {
+        product *= get_num(argv[i]);
     }
     return lisp_number(vm, product);
 }
 
-lisp_value_t* lisp_builtin_div(lisp_vm_t *vm, lisp_value_t *args) {
-    if (!IS_CONS(args)) return lisp_number(vm, 0);
-    
-    int32_t result = get_num(lisp_car(args));
-    args = lisp_cdr(args);
-    
-    while (IS_CONS(args)) {
-        int32_t divisor = get_num(lisp_car(args));
+lisp_value_t* lisp_builtin_div(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    int32_t result = get_num(argv[0]);
+    for (int i = 1; i < argc; i++) {
+        int32_t divisor = get_num(argv[i]);
         if (divisor != 0) result /= divisor;
-        args = lisp_cdr(args);
     }
     return lisp_number(vm, result);
 }
 
-lisp_value_t* lisp_builtin_lt(lisp_vm_t *vm, lisp_value_t *args) {
-    int32_t a = get_num(lisp_nth(args, 0));
-    int32_t b = get_num(lisp_nth(args, 1));
+lisp_value_t* lisp_builtin_lt(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    int32_t a = get_num(argv[0]);
+    int32_t b = get_num(argv[1]);
     return lisp_number(vm, a < b ? 1 : 0);
 }
 
-lisp_value_t* lisp_builtin_gt(lisp_vm_t *vm, lisp_value_t *args) {
-    int32_t a = get_num(lisp_nth(args, 0));
-    int32_t b = get_num(lisp_nth(args, 1));
+lisp_value_t* lisp_builtin_gt(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    int32_t a = get_num(argv[0]);
+    int32_t b = get_num(argv[1]);
     return lisp_number(vm, a > b ? 1 : 0);
 }
 
-lisp_value_t* lisp_builtin_eq(lisp_vm_t *vm, lisp_value_t *args) {
-    int32_t a = get_num(lisp_nth(args, 0));
-    int32_t b = get_num(lisp_nth(args, 1));
+lisp_value_t* lisp_builtin_eq(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    int32_t a = get_num(argv[0]);
+    int32_t b = get_num(argv[1]);
     return lisp_number(vm, a == b ? 1 : 0);
 }
 
 // ===== Control Built-ins =====
 
-lisp_value_t* lisp_builtin_start(lisp_vm_t *vm, lisp_value_t *args) {
+lisp_value_t* lisp_builtin_start(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
     lisp_run_game(vm);
     return lisp_nil(vm);
 }
 
-lisp_value_t* lisp_builtin_stop(lisp_vm_t *vm, lisp_value_t *args) {
+lisp_value_t* lisp_builtin_stop(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
     lisp_stop_game(vm);
     return lisp_nil(vm);
 }
 
+// ===== Collector Statistics =====
+
+// (gc-count): collections finished, incremental and emergency
+lisp_value_t* lisp_builtin_gc_count(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    return lisp_number(vm, vm->gc_stats.cycles + vm->gc_stats.full);
+}
+
+// (gc-full): emergency collections, from a frame that filled the heap
+lisp_value_t* lisp_builtin_gc_full(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    return lisp_number(vm, vm->gc_stats.full);
+}
+
+lisp_value_t* lisp_builtin_gc_pause_max(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    return lisp_number(vm, vm->gc_stats.pause_max_us);
+}
+
+// (gc-pauses i): pauses in histogram bucket i, 0 if there is no such bucket
+lisp_value_t* lisp_builtin_gc_pauses(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    int32_t i = get_num(argv[0]);
+    return lisp_number(vm, i >= 0 && i < LISP_GC_PAUSE_BUCKETS ? vm->gc_stats.pauses[i] : 0);
+}
+
+// (gc-alloc): cells the last frame allocated
+lisp_value_t* lisp_builtin_gc_alloc(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    return lisp_number(vm, vm->gc_stats.frame_allocated);
+}
+
+lisp_value_t* lisp_builtin_gc_alloc_max(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    return lisp_number(vm, vm->gc_stats.frame_allocated_max);
+}
+
+lisp_value_t* lisp_builtin_heap_live(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    return lisp_number(vm, vm->heap_live);
+}
+
+lisp_value_t* lisp_builtin_heap_peak(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    return lisp_number(vm, vm->gc_stats.heap_peak);
+}
+
+lisp_value_t* lisp_builtin_gc_reset(lisp_vm_t *vm, int argc, lisp_value_t **argv) {
+    lisp_gc_reset_stats(vm);
+    return lisp_nil(vm);
+}
+
 // ===== Utilities =====
 
 const char* lisp_type_name(lisp_type_t type) {
@@ -215,6 +258,9 @@ const char* lisp_type_name(lisp_type_t type) {
         case LISP_LAMBDA: return "lambda";
         case LISP_STRING: return "string";
         case LISP_SPRITE: return "sprite";
+        case LISP_FRAME: return "frame";
+        case LISP_LOCAL: return "local";
+        case LISP_FREE: return "free";
         default: return "unknown";
     }
 }
@@ -225,12 +271,12 @@ void lisp_print(lisp_value_t *value) {
         return;
     }
     
-    switch (value->type) {
+    switch (lisp_type_of(value)) {
         case LISP_NIL:
             printf("nil");
             break;
         case LISP_NUMBER:
-            printf("%d", value->as.number);
+            printf("%d", lisp_number_value(value));
             break;
         case LISP_SYMBOL:
             printf("'%s", "?");  // Would need VM context
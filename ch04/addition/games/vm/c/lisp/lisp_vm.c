@@ -1,19 +1,22 @@
 #include "lisp_vm.h"
+#include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <ctype.h>
-
-// ===== Helper Macros =====
-#define IS_NIL(v) ((v)->type == LISP_NIL)
-#define IS_NUMBER(v) ((v)->type == LISP_NUMBER)
-#define IS_SYMBOL(v) ((v)->type == LISP_SYMBOL)
-#define IS_CONS(v) ((v)->type == LISP_CONS)
-#define IS_LAMBDA(v) ((v)->type == LISP_LAMBDA)
-#define IS_SPRITE(v) ((v)->type == LISP_SPRITE)
+#include "pico/time.h"
 
 // ===== Static Globals =====
 static lisp_vm_t *g_vm = NULL;  // Current VM for callbacks
 
+// The special forms and hooks, interned by lisp_init() after the
+// built-ins in this order, so the compiler tells them by symbol id
+static const char *const special_names[] = {
+    "define", "set!", "if", "lambda", "begin",
+    "on-update", "on-button-a", "on-button-b", "on-button-x", "on-button-y"
+};
+
+enum { SF_DEFINE, SF_SET, SF_IF, SF_LAMBDA, SF_BEGIN, SF_HOOK, SF_COUNT = SF_HOOK + 5 };
+
 // ===== Memory Management =====
 
 void lisp_init(lisp_vm_t *vm) {
@@ -23,38 +26,58 @@ void lisp_init(lisp_vm_t *vm) {
     // Create global environment
     vm->global_env = lisp_nil(vm);
     
-    // Register built-ins
-    #define REGISTER(name, fn) \
+    // Register built-ins with the number of arguments they take
+    #define REGISTER(name, fn, min_args, max_args) \
         lisp_env_define(vm, vm->global_env, \
             lisp_symbol(vm, name), \
-            lisp_builtin(vm, (lisp_builtin_fn)fn))
+            lisp_builtin(vm, fn, min_args, max_args))
+    #define REGISTER_FAST(name, fn, min_args, max_args, op) \
+        (REGISTER(name, fn, min_args, max_args)->as.builtin.fast = op)
     
     // Graphics
-    REGISTER("clear", lisp_builtin_clear);
-    REGISTER("fill-rect", lisp_builtin_fill_rect);
-    REGISTER("draw-text", lisp_builtin_draw_text);
-    REGISTER("draw-sprite", lisp_builtin_draw_sprite);
+    REGISTER("clear", lisp_builtin_clear, 1, 1);
+    REGISTER("fill-rect", lisp_builtin_fill_rect, 5, 5);
+    REGISTER("draw-text", lisp_builtin_draw_text, 5, 5);
+    REGISTER("draw-sprite", lisp_builtin_draw_sprite, 3, 3);
     
     // Sprites
-    REGISTER("make-sprite", lisp_builtin_make_sprite);
-    REGISTER("sprite-set-pixel", lisp_builtin_sprite_set_pixel);
+    REGISTER("make-sprite", lisp_builtin_make_sprite, 2, 2);
+    REGISTER("sprite-set-pixel", lisp_builtin_sprite_set_pixel, 4, 4);
+    REGISTER("sprite-fill", lisp_builtin_sprite_fill, 6, 6);
     
     // Collision
-    REGISTER("collide?", lisp_builtin_collide);
+    REGISTER("collide?", lisp_builtin_collide, 8, 8);
     
     // Math
-    REGISTER("+", lisp_builtin_add);
-    REGISTER("-", lisp_builtin_sub);
-    REGISTER("*", lisp_builtin_mul);
-    REGISTER("/", lisp_builtin_div);
-    REGISTER("<", lisp_builtin_lt);
-    REGISTER(">", lisp_builtin_gt);
-    REGISTER("=", lisp_builtin_eq);
+    REGISTER_FAST("+", lisp_builtin_add, 0, LISP_VARIADIC, LISP_FAST_ADD);
+    REGISTER_FAST("-", lisp_builtin_sub, 1, LISP_VARIADIC, LISP_FAST_SUB);
+    REGISTER("*", lisp_builtin_mul, 0, LISP_VARIADIC);
+    REGISTER("/", lisp_builtin_div, 1, LISP_VARIADIC);
+    REGISTER_FAST("<", lisp_builtin_lt, 2, 2, LISP_FAST_LT);
+    REGISTER_FAST(">", lisp_builtin_gt, 2, 2, LISP_FAST_GT);
+    REGISTER_FAST("=", lisp_builtin_eq, 2, 2, LISP_FAST_EQ);
     
     // Control
-    REGISTER("start", lisp_builtin_start);
-    REGISTER("stop", lisp_builtin_stop);
+    REGISTER("start", lisp_builtin_start, 0, 0);
+    REGISTER("stop", lisp_builtin_stop, 0, 0);
+    
+    // Collector statistics
+    REGISTER("gc-count", lisp_builtin_gc_count, 0, 0);
+    REGISTER("gc-full", lisp_builtin_gc_full, 0, 0);
+    REGISTER("gc-pause-max", lisp_builtin_gc_pause_max, 0, 0);
+    REGISTER("gc-pauses", lisp_builtin_gc_pauses, 1, 1);
+    REGISTER("gc-alloc", lisp_builtin_gc_alloc, 0, 0);
+    REGISTER("gc-alloc-max", lisp_builtin_gc_alloc_max, 0, 0);
+    REGISTER("heap-live", lisp_builtin_heap_live, 0, 0);
+    REGISTER("heap-peak", lisp_builtin_heap_peak, 0, 0);
+    REGISTER("gc-reset", lisp_builtin_gc_reset, 0, 0);
+    
+    for (int i = 0; i < SF_COUNT; i++) {
+        uint16_t id = lisp_symbol_id(lisp_symbol(vm, special_names[i]));
+        if (i == 0) vm->special_forms = id;
+    }
     
+    #undef REGISTER_FAST
     #undef REGISTER
 }
 
@@ -64,104 +87,336 @@ void lisp_deinit(lisp_vm_t *vm) {
 }
 
 lisp_value_t* lisp_alloc(lisp_vm_t *vm, lisp_type_t type) {
-    if (vm->heap_used >= LISP_HEAP_SIZE) {
+    if (!vm->free_list && vm->heap_used >= LISP_HEAP_SIZE) {
         lisp_gc(vm);
-        if (vm->heap_used >= LISP_HEAP_SIZE) {
+        if (!vm->free_list && vm->heap_used >= LISP_HEAP_SIZE) {
             vm->error_msg = "Out of memory";
             return NULL;
         }
     }
     
-    lisp_value_t *val = &vm->heap[vm->heap_used++];
+    // Bump allocation; the free list is only there after an emergency
+    // lisp_gc() and is gone again with the next compaction
+    lisp_value_t *val;
+    if (vm->free_list) {
+        val = vm->free_list;
+        vm->free_list = val->as.cons.cdr;
+    } else {
+        val = &vm->heap[vm->heap_used++];
+        if (vm->heap_used > vm->gc_stats.heap_peak) vm->gc_stats.heap_peak = vm->heap_used;
+    }
+    vm->gc_stats.allocated++;
     memset(val, 0, sizeof(lisp_value_t));
     val->type = type;
+    
+    // Allocate black while marking, so the current cycle keeps the cell
+    if (vm->gc_phase == LISP_GC_MARK) {
+        val->marked = LISP_BLACK;
+    }
+    vm->heap_live++;
     return val;
 }
 
-void lisp_gc(lisp_vm_t *vm) {
-    // Simple mark-sweep GC
-    
-    // Mark phase - mark all reachable values
+// ===== Garbage Collection =====
+//
+// Incremental tri-colour marking, then sliding compaction. White cells
+// have not been reached, grey cells have been reached but their children
+// not scanned, black cells are done. Grey cells wait on vm->grey instead
+// of the C stack.
+//
+// lisp_gc_step() does a bounded amount of marking and lisp_update() calls
+// it once per frame, so marking is spread over many frames. The program
+// runs between steps and changes the heap: every pointer stored into a
+// cell is shaded grey first (the write barrier) and cells are allocated
+// black, so a black cell never points to a white one. Roots have no
+// barrier and are shaded again whenever the grey stack runs empty.
+//
+// When marking is done the live cells are slid down to the bottom of the
+// heap in the Lisp-2 way: one pass gives every live cell its new index in
+// its forward field, one pass rewrites all pointers through it, one pass
+// moves the cells. Everything above is free again, so lisp_alloc() only
+// bumps heap_used, and lists end up in consecutive cells. Steps only run
+// between frames, when no cell is held in a C local.
+
+static void gc_shade(lisp_vm_t *vm, lisp_value_t *v) {
+    if (!v || lisp_is_immediate(v) || v->marked != LISP_WHITE) return;
+    v->marked = LISP_GREY;
+    if (vm->grey_count < LISP_GREY_STACK_SIZE) {
+        vm->grey[vm->grey_count++] = v;
+    } else {
+        vm->grey_overflow = true;  // Stays grey in the heap, found by a rescan
+    }
+}
+
+// Write barrier: value is about to be stored into a cell
+static void gc_barrier(lisp_vm_t *vm, lisp_value_t *value) {
+    if (vm->gc_phase == LISP_GC_MARK) gc_shade(vm, value);
+}
+
+static void gc_shade_roots(lisp_vm_t *vm) {
+    gc_shade(vm, vm->cont);
+    gc_shade(vm, vm->global_env);
+    gc_shade(vm, vm->on_update);
+    for (int i = 0; i < 4; i++) {
+        gc_shade(vm, vm->on_button_callbacks[i]);
+    }
+    for (size_t i = 0; i < vm->stack_ptr; i++) {
+        gc_shade(vm, vm->stack[i]);
+    }
+    for (size_t i = 0; i < vm->symbol_count; i++) {
+        gc_shade(vm, vm->globals[i]);
+    }
+    for (size_t i = 0; i < vm->constant_count; i++) {
+        gc_shade(vm, vm->constants[i]);
+    }
+}
+
+static void gc_blacken(lisp_vm_t *vm, lisp_value_t *v) {
+    v->marked = LISP_BLACK;
+    if (v->type == LISP_CONS) {
+        gc_shade(vm, v->as.cons.car);
+        gc_shade(vm, v->as.cons.cdr);
+    } else if (v->type == LISP_LAMBDA) {
+        gc_shade(vm, v->as.lambda.env);
+    } else if (v->type == LISP_FRAME) {
+        gc_shade(vm, v->as.frame.parent);
+        gc_shade(vm, v->as.frame.slots);
+    } else if (v->type == LISP_CONT) {
+        gc_shade(vm, v->as.cont.env);
+        gc_shade(vm, v->as.cont.next);
+    }
+}
+
+// Scan grey cells until none are left (true) or the budget is used up
+static bool gc_mark(lisp_vm_t *vm, size_t *budget) {
+    for (;;) {
+        while (vm->grey_count > 0) {
+            if (*budget == 0) return false;
+            (*budget)--;
+            gc_blacken(vm, vm->grey[--vm->grey_count]);
+        }
+        if (!vm->grey_overflow) return true;
+        
+        vm->grey_overflow = false;
+        for (size_t i = 0; i < vm->heap_used; i++) {
+            if (vm->heap[i].marked != LISP_GREY) continue;
+            if (vm->grey_count == LISP_GREY_STACK_SIZE) {
+                vm->grey_overflow = true;
+                break;
+            }
+            vm->grey[vm->grey_count++] = &vm->heap[i];
+        }
+    }
+}
+
+// Non-moving sweep of white cells onto the free list, for emergencies
+static void gc_sweep(lisp_vm_t *vm) {
+    for (size_t i = 0; i < vm->heap_used; i++) {
+        lisp_value_t *v = &vm->heap[i];
+        if (v->marked == LISP_BLACK) {
+            v->marked = LISP_WHITE;
+        } else if (v->type != LISP_FREE) {
+            v->type = LISP_FREE;
+            v->as.cons.cdr = vm->free_list;
+            vm->free_list = v;
+            vm->heap_live--;
+        }
+    }
+}
+
+static lisp_value_t* gc_forward(lisp_vm_t *vm, lisp_value_t *v) {
+    return (v && !lisp_is_immediate(v)) ? &vm->heap[v->forward] : v;
+}
+
+static void gc_compact(lisp_vm_t *vm) {
+    // New addresses, in heap order
+    size_t live = 0;
     for (size_t i = 0; i < vm->heap_used; i++) {
-        vm->heap[i].marked = 0;
+        if (vm->heap[i].marked == LISP_BLACK) {
+            vm->heap[i].forward = live++;
+        }
     }
     
-    // Mark from roots
-    void mark(lisp_value_t *v) {
-        if (!v || v->marked) return;
-        v->marked = 1;
-        
+    // Pointers in live cells and roots
+    for (size_t i = 0; i < vm->heap_used; i++) {
+        lisp_value_t *v = &vm->heap[i];
+        if (v->marked != LISP_BLACK) continue;
         if (v->type == LISP_CONS) {
-            mark(v->as.cons.car);
-            mark(v->as.cons.cdr);
+            v->as.cons.car = gc_forward(vm, v->as.cons.car);
+            v->as.cons.cdr = gc_forward(vm, v->as.cons.cdr);
         } else if (v->type == LISP_LAMBDA) {
-            mark(v->as.lambda.params);
-            mark(v->as.lambda.body);
-            mark(v->as.lambda.env);
+            v->as.lambda.env = gc_forward(vm, v->as.lambda.env);
+        } else if (v->type == LISP_FRAME) {
+            v->as.frame.parent = gc_forward(vm, v->as.frame.parent);
+            v->as.frame.slots = gc_forward(vm, v->as.frame.slots);
+        } else if (v->type == LISP_CONT) {
+            v->as.cont.env = gc_forward(vm, v->as.cont.env);
+            v->as.cont.next = gc_forward(vm, v->as.cont.next);
         }
     }
-    
-    mark(vm->global_env);
-    mark(vm->on_update);
+    vm->cont = gc_forward(vm, vm->cont);
+    vm->global_env = gc_forward(vm, vm->global_env);
+    vm->on_update = gc_forward(vm, vm->on_update);
     for (int i = 0; i < 4; i++) {
-        mark(vm->on_button_callbacks[i]);
+        vm->on_button_callbacks[i] = gc_forward(vm, vm->on_button_callbacks[i]);
     }
     for (size_t i = 0; i < vm->stack_ptr; i++) {
-        mark(vm->stack[i]);
+        vm->stack[i] = gc_forward(vm, vm->stack[i]);
+    }
+    for (size_t i = 0; i < vm->symbol_count; i++) {
+        vm->globals[i] = gc_forward(vm, vm->globals[i]);
+    }
+    for (size_t i = 0; i < vm->constant_count; i++) {
+        vm->constants[i] = gc_forward(vm, vm->constants[i]);
     }
     
-    // Sweep phase - compact heap
-    size_t write = 0;
-    for (size_t read = 0; read < vm->heap_used; read++) {
-        if (vm->heap[read].marked) {
-            if (write != read) {
-                vm->heap[write] = vm->heap[read];
-            }
-            write++;
+    // Slide down; a cell never moves up, so copying in order is safe.
+    // The slots of a frame are all live and keep their order, so a
+    // packed frame stays packed.
+    for (size_t i = 0; i < vm->heap_used; i++) {
+        if (vm->heap[i].marked != LISP_BLACK) continue;
+        lisp_value_t *to = &vm->heap[vm->heap[i].forward];
+        if (to != &vm->heap[i]) *to = vm->heap[i];
+        to->marked = LISP_WHITE;
+    }
+    
+    vm->heap_used = live;
+    vm->heap_live = live;
+    vm->free_list = NULL;
+}
+
+// Count a pause that began at start_us, and what it left live
+static void gc_record_pause(lisp_vm_t *vm, uint32_t start_us) {
+    lisp_gc_stats_t *s = &vm->gc_stats;
+    uint32_t us = time_us_32() - start_us;
+    int bucket = 0;
+    while (bucket < LISP_GC_PAUSE_BUCKETS - 1 && us >= (uint32_t)LISP_GC_PAUSE_FIRST_US << bucket) {
+        bucket++;
+    }
+    s->pauses[bucket]++;
+    if (us > s->pause_max_us) s->pause_max_us = us;
+    if (vm->gc_phase == LISP_GC_IDLE && vm->heap_live > s->live_peak) s->live_peak = vm->heap_live;
+}
+
+void lisp_gc_reset_stats(lisp_vm_t *vm) {
+    memset(&vm->gc_stats, 0, sizeof(vm->gc_stats));
+    vm->gc_stats.heap_peak = vm->heap_used;
+}
+
+// Start a cycle or continue marking; compacts when marking is done
+void lisp_gc_step(lisp_vm_t *vm, size_t budget) {
+    // A free list left by lisp_gc() is compacted away soon as well
+    if (vm->gc_phase == LISP_GC_IDLE && vm->heap_live < LISP_GC_THRESHOLD && !vm->free_list) return;
+    
+    uint32_t start = time_us_32();
+    if (vm->gc_phase == LISP_GC_IDLE) {
+        vm->gc_phase = LISP_GC_MARK;
+        gc_shade_roots(vm);
+    }
+    
+    for (;;) {
+        if (!gc_mark(vm, &budget)) {
+            gc_record_pause(vm, start);
+            return;
         }
+        gc_shade_roots(vm);  // Roots may have changed since the start
+        if (vm->grey_count == 0) break;
+    }
+    gc_compact(vm);
+    vm->gc_phase = LISP_GC_IDLE;
+    vm->gc_stats.cycles++;
+    gc_record_pause(vm, start);
+}
+
+// Finish the current cycle at once. lisp_alloc() falls back to this when
+// the heap fills up in the middle of a frame, where cells held in C
+// locals cannot be moved, so it sweeps instead of compacting. Anything
+// live must still be reachable from a root: the stack machine and
+// lisp_parse() keep what they are building in vm->stack for that.
+void lisp_gc(lisp_vm_t *vm) {
+    size_t before = vm->heap_live;
+    size_t budget = SIZE_MAX;
+    uint32_t start = time_us_32();
+    
+    if (vm->gc_phase == LISP_GC_IDLE) {
+        vm->gc_phase = LISP_GC_MARK;
+        gc_shade_roots(vm);
     }
+    do {
+        gc_mark(vm, &budget);
+        gc_shade_roots(vm);
+    } while (vm->grey_count > 0);
+    gc_sweep(vm);
+    vm->gc_phase = LISP_GC_IDLE;
+    vm->gc_stats.full++;
+    gc_record_pause(vm, start);
     
-    printf("GC: %zu -> %zu cells\n", vm->heap_used, write);
-    vm->heap_used = write;
+    printf("GC: %zu -> %zu cells\n", before, vm->heap_live);
 }
 
 // ===== Constructors =====
 
 lisp_value_t* lisp_nil(lisp_vm_t *vm) {
-    lisp_value_t *v = lisp_alloc(vm, LISP_NIL);
-    return v;
+    return LISP_NIL_VALUE;
 }
 
+// Immediate unless it needs all 32 bits, which only happens on the Pico
 lisp_value_t* lisp_number(lisp_vm_t *vm, int32_t n) {
+    if (lisp_fits_fixnum(n)) return lisp_fixnum(n);
     lisp_value_t *v = lisp_alloc(vm, LISP_NUMBER);
     if (v) v->as.number = n;
     return v;
 }
 
-lisp_value_t* lisp_symbol(lisp_vm_t *vm, const char *name) {
-    // Intern symbol
-    for (size_t i = 0; i < vm->symbol_count; i++) {
-        if (strcmp(vm->symbols[i], name) == 0) {
-            lisp_value_t *v = lisp_alloc(vm, LISP_SYMBOL);
-            if (v) v->as.symbol_id = i;
-            return v;
+// FNV-1a
+static uint32_t symbol_hash(const char *name, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h = (h ^ (uint8_t)name[i]) * 16777619u;
+    }
+    return h;
+}
+
+// Intern the name start[0..len), copying it only when it is new
+static lisp_value_t* symbol_intern(lisp_vm_t *vm, const char *start, size_t len, bool copy) {
+    uint32_t slot = symbol_hash(start, len) & (LISP_SYMBOL_HASH_SIZE - 1);
+    while (vm->symbol_hash[slot]) {
+        uint16_t id = vm->symbol_hash[slot] - 1;
+        if (vm->symbol_length[id] == len && memcmp(vm->symbols[id], start, len) == 0) {
+            return lisp_symbol_value(id);
         }
+        slot = (slot + 1) & (LISP_SYMBOL_HASH_SIZE - 1);
     }
     
-    if (vm->symbol_count >= LISP_SYMBOL_TABLE_SIZE) {
+    if (vm->symbol_count >= LISP_SYMBOL_TABLE_SIZE || len > UINT16_MAX) {
         vm->error_msg = "Symbol table full";
         return NULL;
     }
     
-    vm->symbols[vm->symbol_count] = name;
-    lisp_value_t *v = lisp_alloc(vm, LISP_SYMBOL);
-    if (v) v->as.symbol_id = vm->symbol_count++;
-    return v;
+    const char *name = start;
+    if (copy) {
+        char *sym = (char*)malloc(len + 1);
+        memcpy(sym, start, len);
+        sym[len] = '\0';
+        name = sym;
+    }
+    
+    uint16_t id = vm->symbol_count++;
+    vm->symbols[id] = name;
+    vm->symbol_length[id] = (uint16_t)len;
+    vm->symbol_hash[slot] = id + 1;
+    return lisp_symbol_value(id);
+}
+
+lisp_value_t* lisp_symbol(lisp_vm_t *vm, const char *name) {
+    return symbol_intern(vm, name, strlen(name), false);
 }
 
 lisp_value_t* lisp_cons(lisp_vm_t *vm, lisp_value_t *car, lisp_value_t *cdr) {
     lisp_value_t *v = lisp_alloc(vm, LISP_CONS);
     if (v) {
+        gc_barrier(vm, car);
+        gc_barrier(vm, cdr);
         v->as.cons.car = car;
         v->as.cons.cdr = cdr;
     }
@@ -174,9 +429,9 @@ lisp_value_t* lisp_string(lisp_vm_t *vm, const char *str) {
     return v;
 }
 
-lisp_value_t* lisp_builtin(lisp_vm_t *vm, lisp_builtin_fn fn) {
+lisp_value_t* lisp_builtin(lisp_vm_t *vm, lisp_builtin_fn fn, uint8_t min_args, uint8_t max_args) {
     lisp_value_t *v = lisp_alloc(vm, LISP_BUILTIN);
-    if (v) v->as.builtin = fn;
+    if (v) v->as.builtin = (lisp_builtin_t){ fn, min_args, max_args, LISP_FAST_NONE };
     return v;
 }
 
@@ -190,6 +445,18 @@ lisp_value_t* lisp_cdr(lisp_value_t *cons) {
     return IS_CONS(cons) ? cons->as.cons.cdr : NULL;
 }
 
+void lisp_set_car(lisp_vm_t *vm, lisp_value_t *cons, lisp_value_t *value) {
+    if (!IS_CONS(cons)) return;
+    gc_barrier(vm, value);
+    cons->as.cons.car = value;
+}
+
+void lisp_set_cdr(lisp_vm_t *vm, lisp_value_t *cons, lisp_value_t *value) {
+    if (!IS_CONS(cons)) return;
+    gc_barrier(vm, value);
+    cons->as.cons.cdr = value;
+}
+
 size_t lisp_length(lisp_value_t *list) {
     size_t len = 0;
     while (IS_CONS(list)) {
@@ -233,17 +500,31 @@ lisp_value_t* lisp_parse(lisp_vm_t *vm, const char **code) {
             return lisp_nil(vm);
         }
         
+        if (vm->stack_ptr + 2 > LISP_STACK_SIZE) {
+            vm->error_msg = "Stack overflow";
+            return NULL;
+        }
+        
+        // The list so far, and each element until it is in a cell, sit
+        // on the stack, where lisp_gc() finds them if a cons fills the heap
         lisp_value_t *list = NULL;
-        lisp_value_t **tail = &list;
+        lisp_value_t *last = NULL;
+        size_t sp = vm->stack_ptr;
+        vm->stack[vm->stack_ptr++] = NULL;
         
         while (**code && **code != ')') {
             lisp_value_t *elem = lisp_parse(vm, code);
             if (!elem) break;
             
-            *tail = lisp_cons(vm, elem, lisp_nil(vm));
-            tail = &(*tail)->as.cons.cdr;
+            vm->stack[vm->stack_ptr++] = elem;
+            lisp_value_t *cell = lisp_cons(vm, elem, lisp_nil(vm));
+            vm->stack_ptr--;
+            if (last) lisp_set_cdr(vm, last, cell);
+            else list = vm->stack[sp] = cell;
+            last = cell;
             skip_whitespace(code);
         }
+        vm->stack_ptr = sp;
         
         if (**code == ')') (*code)++;
         return list;
@@ -272,230 +553,962 @@ lisp_value_t* lisp_parse(lisp_vm_t *vm, const char **code) {
         (*code)++;
     }
     
-    size_t len = *code - start;
-    char *sym = (char*)malloc(len + 1);
-    strncpy(sym, start, len);
-    sym[len] = '\0';
-    
-    return lisp_symbol(vm, sym);
+    return symbol_intern(vm, start, *code - start, true);
 }
 
 // ===== Environment =====
+//
+// Globals sit in vm->globals[], one slot per symbol. Lambda parameters
+// are resolved to a depth and an index when the lambda is first made
+// (see resolve_lambda below), and fetched from frames at run time, so no
+// variable reference searches anything.
 
 lisp_value_t* lisp_env_lookup(lisp_vm_t *vm, lisp_value_t *env, lisp_value_t *symbol) {
     if (!IS_SYMBOL(symbol)) return NULL;
-    
-    while (IS_CONS(env)) {
-        lisp_value_t *binding = lisp_car(env);
-        if (IS_CONS(binding)) {
-            lisp_value_t *key = lisp_car(binding);
-            if (IS_SYMBOL(key) && key->as.symbol_id == symbol->as.symbol_id) {
-                return lisp_cdr(binding);
-            }
-        }
-        env = lisp_cdr(env);
-    }
-    
-    return NULL;
+    return vm->globals[lisp_symbol_id(symbol)];
 }
 
 lisp_value_t* lisp_env_define(lisp_vm_t *vm, lisp_value_t *env, lisp_value_t *symbol, lisp_value_t *value) {
-    lisp_value_t *binding = lisp_cons(vm, symbol, value);
-    vm->global_env = lisp_cons(vm, binding, vm->global_env);
+    if (!IS_SYMBOL(symbol)) return NULL;
+    vm->globals[lisp_symbol_id(symbol)] = value;
     return value;
 }
 
 lisp_value_t* lisp_env_set(lisp_vm_t *vm, lisp_value_t *env, lisp_value_t *symbol, lisp_value_t *value) {
     if (!IS_SYMBOL(symbol)) return NULL;
     
-    lisp_value_t *orig = env;
-    while (IS_CONS(env)) {
-        lisp_value_t *binding = lisp_car(env);
-        if (IS_CONS(binding)) {
-            lisp_value_t *key = lisp_car(binding);
-            if (IS_SYMBOL(key) && key->as.symbol_id == symbol->as.symbol_id) {
-                binding->as.cons.cdr = value;
-                return value;
+    if (!vm->globals[lisp_symbol_id(symbol)]) {
+        vm->error_msg = "Undefined variable";
+        return NULL;
+    }
+    vm->globals[lisp_symbol_id(symbol)] = value;
+    return value;
+}
+
+static lisp_value_t* frame_new(lisp_vm_t *vm, lisp_value_t *parent, uint16_t count) {
+    lisp_value_t *frame = lisp_alloc(vm, LISP_FRAME);
+    if (!frame) return NULL;
+    gc_barrier(vm, parent);
+    frame->as.frame.parent = parent;
+    frame->as.frame.count = count;
+    frame->as.frame.packed = true;
+    
+    // On the stack while the slots are allocated, in case that collects
+    if (vm->stack_ptr >= LISP_STACK_SIZE) {
+        vm->error_msg = "Stack overflow";
+        return NULL;
+    }
+    vm->stack[vm->stack_ptr++] = frame;
+    
+    lisp_value_t *last = NULL;
+    for (uint16_t i = 0; i < count && frame; i++) {
+        lisp_value_t *slot = lisp_alloc(vm, LISP_CONS);
+        if (!slot) {
+            frame = NULL;
+        } else if (last) {
+            last->as.cons.cdr = slot;
+            if (slot != last + 1) frame->as.frame.packed = false;
+        } else {
+            frame->as.frame.slots = slot;
+        }
+        last = slot;
+    }
+    vm->stack_ptr--;
+    return frame;
+}
+
+// Slot cell of a local, at most depth frames up
+static lisp_value_t* frame_slot(lisp_value_t *env, lisp_local_t local) {
+    for (uint16_t d = 0; d < local.depth && env && lisp_type_of(env) == LISP_FRAME; d++) {
+        env = env->as.frame.parent;
+    }
+    if (!env || lisp_type_of(env) != LISP_FRAME || local.index >= env->as.frame.count) return NULL;
+    
+    if (env->as.frame.packed) return env->as.frame.slots + local.index;
+    lisp_value_t *slot = env->as.frame.slots;
+    for (uint16_t i = 0; i < local.index; i++) {
+        slot = slot->as.cons.cdr;
+    }
+    return slot;
+}
+
+// ===== Lexical Addressing =====
+
+typedef struct {
+    lisp_value_t *params[LISP_MAX_SCOPE];  // Innermost lambda first
+    int depth;
+} scope_t;
+
+// SF_ number of the special form op names, or -1
+static int special_form(lisp_vm_t *vm, lisp_value_t *op) {
+    if (!op || !IS_SYMBOL(op)) return -1;
+    unsigned form = (unsigned)lisp_symbol_id(op) - vm->special_forms;
+    return form < SF_COUNT ? (int)form : -1;
+}
+
+// Any on- name is kept out of resolving, hook or not
+static bool is_special_form(lisp_vm_t *vm, lisp_value_t *op) {
+    return special_form(vm, op) >= 0 ||
+           (op && IS_SYMBOL(op) && strncmp(vm->symbols[lisp_symbol_id(op)], "on-", 3) == 0);
+}
+
+static void resolve_form(lisp_vm_t *vm, lisp_value_t *form, scope_t *scope);
+
+// Replace a parameter in the car of cell by its depth and index
+static void resolve_cell(lisp_vm_t *vm, lisp_value_t *cell, scope_t *scope) {
+    lisp_value_t *expr = lisp_car(cell);
+    if (!expr) return;
+    
+    if (IS_CONS(expr)) {
+        resolve_form(vm, expr, scope);
+        return;
+    }
+    if (!IS_SYMBOL(expr)) return;
+    
+    for (int d = 0; d < scope->depth; d++) {
+        uint16_t index = 0;
+        for (lisp_value_t *p = scope->params[d]; IS_CONS(p); p = lisp_cdr(p), index++) {
+            lisp_value_t *param = lisp_car(p);
+            if (param == expr) {  // Symbols are interned
+                lisp_value_t *local = lisp_alloc(vm, LISP_LOCAL);
+                if (!local) return;
+                local->as.local.depth = d;
+                local->as.local.index = index;
+                lisp_set_car(vm, cell, local);
+                return;
             }
         }
-        env = lisp_cdr(env);
+    }
+}
+
+static void resolve_lambda(lisp_vm_t *vm, lisp_value_t *form, scope_t *scope) {
+    if (form->flags & LISP_RESOLVED) return;
+    if (scope->depth >= LISP_MAX_SCOPE) {
+        vm->error_msg = "Lambdas nested too deep";
+        return;
     }
     
-    vm->error_msg = "Undefined variable";
-    return NULL;
+    scope_t inner;
+    inner.params[0] = lisp_nth(form, 1);
+    for (int d = 0; d < scope->depth; d++) {
+        inner.params[d + 1] = scope->params[d];
+    }
+    inner.depth = scope->depth + 1;
+    
+    lisp_value_t *body = lisp_cdr(lisp_cdr(form));
+    for (; IS_CONS(body); body = lisp_cdr(body)) {
+        resolve_cell(vm, body, &inner);
+    }
+    form->flags |= LISP_RESOLVED;
 }
 
-// ===== Evaluation =====
+static void resolve_form(lisp_vm_t *vm, lisp_value_t *form, scope_t *scope) {
+    lisp_value_t *op = lisp_car(form);
+    int special = special_form(vm, op);
+    
+    if (special == SF_LAMBDA) {
+        resolve_lambda(vm, form, scope);
+        return;
+    }
+    
+    size_t pos = 0;
+    for (lisp_value_t *cell = form; IS_CONS(cell); cell = lisp_cdr(cell), pos++) {
+        if (pos == 0 && is_special_form(vm, op)) continue;
+        if (pos == 1 && special == SF_DEFINE) continue;  // Always global
+        resolve_cell(vm, cell, scope);
+    }
+}
 
-lisp_value_t* lisp_eval(lisp_vm_t *vm, lisp_value_t *expr, lisp_value_t *env) {
-    if (!expr) return lisp_nil(vm);
+// ===== Bytecode =====
+//
+// lisp_eval() compiles an expression into bytecode for a small stack
+// machine working on vm->stack, and runs it. A lambda is compiled once,
+// in line with the code around it behind a jump, and a closure only holds
+// the function number and its captured frame, so all closures of a lambda
+// and all calls share one compiled body. Constants live in one pool.
+// Operands are u8, or u16 stored low byte first.
+
+enum {
+    OP_NIL,         //                      push nil
+    OP_CONST,       // u16 constant         push vm->constants[constant]
+    OP_GLOBAL,      // u16 symbol           push global value
+    OP_SET_GLOBAL,  // u16 symbol           set! global to top
+    OP_DEFINE,      // u16 symbol           define global as top
+    OP_LOCAL,       // u8 depth, u8 index   push parameter
+    OP_SET_LOCAL,   // u8 depth, u8 index   set! parameter to top
+    OP_POP,
+    OP_JUMP,        // u16 address
+    OP_JUMP_FALSE,  // u16 address          pop, jump if false
+    OP_CLOSURE,     // u16 function         push closure over current frame
+    OP_CALL,        // u8 argc              fn arg1 .. argn -> result
+    OP_TAIL_CALL,   // u8 argc              call in place of the current one
+    OP_HOOK,        // u8 hook              on-update (0), on-button-a..y (1-4)
+    OP_RETURN
+};
+
+static void emit(lisp_vm_t *vm, uint8_t byte) {
+    // The code of an image is read only; it is copied the first time
+    // anything is added to it
+    if (vm->code_image) {
+        memcpy(vm->code, vm->code_image, vm->code_used);
+        vm->code_image = NULL;
+    }
+    if (vm->code_used >= LISP_CODE_SIZE) {
+        vm->error_msg = "Code area full";
+        return;
+    }
+    vm->code[vm->code_used++] = byte;
+}
+
+static void emit16(lisp_vm_t *vm, uint16_t value) {
+    emit(vm, value & 0xFF);
+    emit(vm, value >> 8);
+}
+
+// Jump with its address to be patched; returns where the address goes
+static size_t emit_jump(lisp_vm_t *vm, uint8_t op) {
+    emit(vm, op);
+    size_t at = vm->code_used;
+    emit16(vm, 0);
+    return at;
+}
+
+static void patch_jump(lisp_vm_t *vm, size_t at) {
+    if (vm->error_msg) return;
+    vm->code[at] = vm->code_used & 0xFF;
+    vm->code[at + 1] = vm->code_used >> 8;
+}
+
+static uint16_t add_constant(lisp_vm_t *vm, lisp_value_t *value) {
+    for (size_t i = 0; i < vm->constant_count; i++) {
+        if (vm->constants[i] == value) return i;
+    }
+    if (vm->constant_count >= LISP_MAX_CONSTANTS) {
+        vm->error_msg = "Constant pool full";
+        return 0;
+    }
+    vm->constants[vm->constant_count] = value;
+    return vm->constant_count++;
+}
+
+// ===== Compiler =====
+
+static void compile_expr(lisp_vm_t *vm, lisp_value_t *expr, bool tail);
+
+// Expressions of a list in turn, leaving the value of the last, which
+// is in tail position if the list is
+static void compile_body(lisp_vm_t *vm, lisp_value_t *body, bool tail) {
+    if (!IS_CONS(body)) {
+        emit(vm, OP_NIL);
+        return;
+    }
+    for (; IS_CONS(body); body = lisp_cdr(body)) {
+        bool last = !IS_CONS(lisp_cdr(body));
+        compile_expr(vm, lisp_car(body), tail && last);
+        if (!last) emit(vm, OP_POP);
+    }
+}
+
+static void compile_lambda(lisp_vm_t *vm, lisp_value_t *form) {
+    if (vm->function_count >= LISP_MAX_FUNCTIONS) {
+        vm->error_msg = "Too many functions";
+        return;
+    }
+    uint16_t fn = vm->function_count++;
+    
+    size_t skip = emit_jump(vm, OP_JUMP);
+    vm->functions[fn].code = vm->code_used;
+    vm->functions[fn].nparams = lisp_length(lisp_nth(form, 1));
+    compile_body(vm, lisp_cdr(lisp_cdr(form)), true);
+    emit(vm, OP_RETURN);
+    patch_jump(vm, skip);
+    
+    emit(vm, OP_CLOSURE);
+    emit16(vm, fn);
+}
+
+// Special form number special of special_names[]
+static void compile_special(lisp_vm_t *vm, int special, lisp_value_t *form, bool tail) {
+    lisp_value_t *args = lisp_cdr(form);
+    
+    switch (special) {
+    case SF_DEFINE: {
+        lisp_value_t *sym = lisp_nth(args, 0);
+        compile_expr(vm, lisp_nth(args, 1), false);
+        if (sym && IS_SYMBOL(sym)) {
+            emit(vm, OP_DEFINE);
+            emit16(vm, lisp_symbol_id(sym));
+        }
+        break;
+    }
+    
+    case SF_SET: {
+        lisp_value_t *sym = lisp_nth(args, 0);
+        compile_expr(vm, lisp_nth(args, 1), false);
+        if (sym && lisp_type_of(sym) == LISP_LOCAL && sym->as.local.index <= 255) {
+            emit(vm, OP_SET_LOCAL);
+            emit(vm, sym->as.local.depth);
+            emit(vm, sym->as.local.index);
+        } else if (sym && IS_SYMBOL(sym)) {
+            emit(vm, OP_SET_GLOBAL);
+            emit16(vm, lisp_symbol_id(sym));
+        }
+        break;
+    }
+    
+    case SF_IF: {
+        compile_expr(vm, lisp_nth(args, 0), false);
+        size_t to_else = emit_jump(vm, OP_JUMP_FALSE);
+        compile_expr(vm, lisp_nth(args, 1), tail);
+        size_t to_end = emit_jump(vm, OP_JUMP);
+        patch_jump(vm, to_else);
+        compile_expr(vm, lisp_nth(args, 2), tail);
+        patch_jump(vm, to_end);
+        break;
+    }
+    
+    case SF_BEGIN:
+        compile_body(vm, args, tail);
+        break;
+    
+    case SF_LAMBDA:
+        compile_lambda(vm, form);
+        break;
+    
+    default:
+        compile_expr(vm, lisp_nth(args, 0), false);
+        emit(vm, OP_HOOK);
+        emit(vm, special - SF_HOOK);
+        break;
+    }
+}
+
+static void compile_expr(lisp_vm_t *vm, lisp_value_t *expr, bool tail) {
+    if (vm->error_msg) return;
     
-    // Self-evaluating
-    if (IS_NUMBER(expr) || IS_STRING(expr) || IS_SPRITE(expr)) {
-        return expr;
+    if (!expr || IS_NIL(expr)) {
+        emit(vm, OP_NIL);
+        return;
+    }
+    
+    if (lisp_type_of(expr) == LISP_LOCAL) {
+        if (expr->as.local.index > 255) {
+            vm->error_msg = "Too many parameters";
+            return;
+        }
+        emit(vm, OP_LOCAL);
+        emit(vm, expr->as.local.depth);
+        emit(vm, expr->as.local.index);
+        return;
     }
     
-    // Variable lookup
     if (IS_SYMBOL(expr)) {
-        lisp_value_t *val = lisp_env_lookup(vm, env, expr);
-        if (!val) {
-            printf("Undefined: %s\n", vm->symbols[expr->as.symbol_id]);
-            return lisp_nil(vm);
+        emit(vm, OP_GLOBAL);
+        emit16(vm, lisp_symbol_id(expr));
+        return;
+    }
+    
+    if (!IS_CONS(expr)) {
+        emit(vm, OP_CONST);
+        emit16(vm, add_constant(vm, expr));
+        return;
+    }
+    
+    lisp_value_t *op = lisp_car(expr);
+    int special = special_form(vm, op);
+    if (special >= 0) {
+        compile_special(vm, special, expr, tail);
+        return;
+    }
+    
+    // Function call
+    compile_expr(vm, op, false);
+    size_t argc = 0;
+    for (lisp_value_t *args = lisp_cdr(expr); IS_CONS(args); args = lisp_cdr(args)) {
+        compile_expr(vm, lisp_car(args), false);
+        argc++;
+    }
+    if (argc > 255) {
+        vm->error_msg = "Too many arguments";
+        return;
+    }
+    emit(vm, tail ? OP_TAIL_CALL : OP_CALL);
+    emit(vm, argc);
+}
+
+// ===== Stack Machine =====
+
+// Zero is always a fixnum
+static bool is_true(lisp_value_t *v) {
+    return v != LISP_NIL_VALUE && v != lisp_fixnum(0);
+}
+
+// Built-in below the argc arguments on top of the stack. It gets them
+// where they are, as argv, and they stay alive in their stack slots, so
+// the call allocates nothing. Arithmetic and comparisons of two fixnums
+// are done here without a call; the sum or difference of two 31-bit
+// fixnums always fits in 32 bits, and lisp_number() boxes it if needed.
+static lisp_value_t* call_builtin(lisp_vm_t *vm, lisp_value_t *fn, size_t args, size_t argc) {
+    const lisp_builtin_t *b = &fn->as.builtin;
+    lisp_value_t **argv = &vm->stack[args];
+    
+    if (argc == 2 && b->fast != LISP_FAST_NONE && ((uintptr_t)argv[0] & (uintptr_t)argv[1] & 1)) {
+        int32_t x = lisp_number_value(argv[0]);
+        int32_t y = lisp_number_value(argv[1]);
+        switch (b->fast) {
+            case LISP_FAST_ADD: return lisp_number(vm, (int32_t)((uint32_t)x + (uint32_t)y));
+            case LISP_FAST_SUB: return lisp_number(vm, (int32_t)((uint32_t)x - (uint32_t)y));
+            case LISP_FAST_LT: return lisp_fixnum(x < y);
+            case LISP_FAST_GT: return lisp_fixnum(x > y);
+            case LISP_FAST_EQ: return lisp_fixnum(x == y);
         }
-        return val;
     }
     
-    // List evaluation
-    if (IS_CONS(expr)) {
-        lisp_value_t *op = lisp_car(expr);
-        lisp_value_t *args = lisp_cdr(expr);
-        
-        // Special forms
-        if (IS_SYMBOL(op)) {
-            const char *name = vm->symbols[op->as.symbol_id];
+    if (argc < b->min_args || (b->max_args != LISP_VARIADIC && argc > b->max_args)) {
+        vm->error_msg = "Wrong number of arguments";
+        return NULL;
+    }
+    lisp_value_t *result = b->fn(vm, (int)argc, argv);
+    if (!result && !vm->error_msg) result = LISP_NIL_VALUE;
+    return result;
+}
+
+// Frame for a call of lambda fn with the argc arguments on top of the
+// stack. The arguments are popped and the frame takes the place of fn.
+static lisp_value_t* enter(lisp_vm_t *vm, lisp_value_t *fn, size_t args, size_t argc) {
+    lisp_function_t *f = &vm->functions[fn->as.lambda.function];
+    lisp_value_t *frame = frame_new(vm, fn->as.lambda.env, f->nparams);
+    if (!frame) return NULL;
+    
+    lisp_value_t *slot = frame->as.frame.slots;
+    for (size_t i = 0; i < f->nparams && i < argc; i++) {
+        lisp_set_car(vm, slot, vm->stack[args + i]);
+        slot = slot->as.cons.cdr;
+    }
+    vm->stack[args - 1] = frame;
+    vm->stack_ptr = args;
+    return frame;
+}
+
+static lisp_value_t* execute(lisp_vm_t *vm, size_t pc, lisp_value_t *env);
+
+// Call the function below the argc arguments on top of the stack from
+// C, and pop them all; NULL on error
+static lisp_value_t* call(lisp_vm_t *vm, size_t argc) {
+    size_t args = vm->stack_ptr - argc;
+    lisp_value_t *fn = vm->stack[args - 1];
+    lisp_value_t *result = LISP_NIL_VALUE;
+    
+    if (fn && lisp_type_of(fn) == LISP_BUILTIN) {
+        result = call_builtin(vm, fn, args, argc);
+    } else if (fn && IS_LAMBDA(fn)) {
+        lisp_value_t *frame = enter(vm, fn, args, argc);
+        result = frame ? execute(vm, vm->functions[fn->as.lambda.function].code, frame) : NULL;
+    }
+    
+    vm->stack_ptr = args - 1;
+    return result;
+}
+
+#define PUSH(v) do { \
+        if (vm->stack_ptr >= LISP_STACK_SIZE) { \
+            vm->error_msg = "Stack overflow"; \
+            goto fail; \
+        } \
+        vm->stack[vm->stack_ptr++] = (v); \
+    } while (0)
+#define TOP() (vm->stack[vm->stack_ptr - 1])
+#define READ16() (pc += 2, (uint16_t)(code[pc - 2] | code[pc - 1] << 8))
+
+// Run from pc in frame env, which the caller keeps alive in the slot
+// below the stack top, up to its OP_RETURN; NULL on error.
+//
+// A call of a lambda does not recurse in C. The caller's pc, frame and
+// stack base go into a continuation cell in the heap, the callee's frame
+// takes the slot of the function, and the loop carries on in the callee.
+// OP_RETURN takes the continuation back. A call in tail position
+// replaces the frame of the current call instead and leaves no
+// continuation, so a loop written as a tail call runs in constant space.
+static lisp_value_t* RAM_FUNC(execute)(lisp_vm_t *vm, size_t pc, lisp_value_t *env) {
+    const uint8_t *code = vm->code_image ? vm->code_image : vm->code;
+    size_t base = vm->stack_ptr;
+    size_t entry_base = base;
+    lisp_value_t *entry = vm->cont;  // Return to C when this is back
+    
+    for (;;) {
+        switch (code[pc++]) {
+            case OP_NIL:
+                PUSH(LISP_NIL_VALUE);
+                break;
             
-            if (strcmp(name, "define") == 0) {
-                lisp_value_t *sym = lisp_nth(args, 0);
-                lisp_value_t *val = lisp_eval(vm, lisp_nth(args, 1), env);
-                return lisp_env_define(vm, env, sym, val);
+            case OP_CONST: {
+                uint16_t k = READ16();
+                PUSH(vm->constants[k]);
+                break;
             }
             
-            if (strcmp(name, "set!") == 0) {
-                lisp_value_t *sym = lisp_nth(args, 0);
-                lisp_value_t *val = lisp_eval(vm, lisp_nth(args, 1), env);
-                return lisp_env_set(vm, env, sym, val);
+            case OP_GLOBAL: {
+                uint16_t id = READ16();
+                lisp_value_t *v = vm->globals[id];
+                if (!v) {
+                    printf("Undefined: %s\n", vm->symbols[id]);
+                    v = LISP_NIL_VALUE;
+                }
+                PUSH(v);
+                break;
             }
             
-            if (strcmp(name, "if") == 0) {
-                lisp_value_t *test = lisp_eval(vm, lisp_nth(args, 0), env);
-                bool cond = !(IS_NIL(test) || (IS_NUMBER(test) && test->as.number == 0));
-                return lisp_eval(vm, lisp_nth(args, cond ? 1 : 2), env);
+            case OP_SET_GLOBAL: {
+                uint16_t id = READ16();
+                if (vm->globals[id]) {
+                    vm->globals[id] = TOP();
+                } else {
+                    vm->error_msg = "Undefined variable";
+                }
+                break;
             }
             
-            if (strcmp(name, "lambda") == 0) {
-                lisp_value_t *lam = lisp_alloc(vm, LISP_LAMBDA);
-                lam->as.lambda.params = lisp_nth(args, 0);
-                lam->as.lambda.body = lisp_nth(args, 1);
-                lam->as.lambda.env = env;
-                return lam;
+            case OP_DEFINE: {
+                uint16_t id = READ16();
+                vm->globals[id] = TOP();
+                break;
+            }
+            
+            case OP_LOCAL:
+            case OP_SET_LOCAL: {
+                uint8_t op = code[pc - 1];
+                lisp_local_t local = { code[pc], code[pc + 1] };
+                pc += 2;
+                lisp_value_t *slot = frame_slot(env, local);
+                if (op == OP_LOCAL) {
+                    PUSH((slot && slot->as.cons.car) ? slot->as.cons.car : LISP_NIL_VALUE);
+                } else if (slot) {
+                    lisp_set_car(vm, slot, TOP());
+                }
+                break;
             }
             
-            if (strcmp(name, "on-update") == 0) {
-                vm->on_update = lisp_eval(vm, lisp_nth(args, 0), env);
-                return vm->on_update;
+            case OP_POP:
+                vm->stack_ptr--;
+                break;
+            
+            case OP_JUMP: {
+                uint16_t to = READ16();
+                pc = to;
+                break;
             }
             
-            if (strcmp(name, "on-button-a") == 0) {
-                vm->on_button_callbacks[0] = lisp_eval(vm, lisp_nth(args, 0), env);
-                return vm->on_button_callbacks[0];
+            case OP_JUMP_FALSE: {
+                uint16_t to = READ16();
+                if (!is_true(vm->stack[--vm->stack_ptr])) pc = to;
+                break;
             }
             
-            if (strcmp(name, "on-button-b") == 0) {
-                vm->on_button_callbacks[1] = lisp_eval(vm, lisp_nth(args, 0), env);
-                return vm->on_button_callbacks[1];
+            case OP_CLOSURE: {
+                uint16_t fn = READ16();
+                lisp_value_t *lam = lisp_alloc(vm, LISP_LAMBDA);
+                if (!lam) goto fail;
+                gc_barrier(vm, env);
+                lam->as.lambda.env = env;
+                lam->as.lambda.function = fn;
+                PUSH(lam);
+                break;
             }
             
-            if (strcmp(name, "on-button-x") == 0) {
-                vm->on_button_callbacks[2] = lisp_eval(vm, lisp_nth(args, 0), env);
-                return vm->on_button_callbacks[2];
+            case OP_CALL:
+            case OP_TAIL_CALL: {
+                bool tail = code[pc - 1] == OP_TAIL_CALL;
+                uint8_t argc = code[pc++];
+                size_t args = vm->stack_ptr - argc;
+                lisp_value_t *fn = vm->stack[args - 1];
+                
+                if (!fn || !IS_LAMBDA(fn)) {
+                    lisp_value_t *result = LISP_NIL_VALUE;
+                    if (fn && lisp_type_of(fn) == LISP_BUILTIN) {
+                        result = call_builtin(vm, fn, args, argc);
+                        if (!result) goto fail;
+                    }
+                    vm->stack_ptr = args - 1;
+                    PUSH(result);
+                    break;
+                }
+                
+                lisp_value_t *frame = enter(vm, fn, args, argc);
+                if (!frame) goto fail;
+                
+                if (tail) {
+                    // Drop the current call, whose frame is below base
+                    vm->stack[base - 1] = frame;
+                    vm->stack_ptr = base;
+                } else {
+                    lisp_value_t *cont = lisp_alloc(vm, LISP_CONT);
+                    if (!cont) goto fail;
+                    gc_barrier(vm, env);
+                    gc_barrier(vm, vm->cont);
+                    cont->as.cont.env = env;
+                    cont->as.cont.next = vm->cont;
+                    cont->as.cont.pc = pc;
+                    cont->as.cont.base = base;
+                    vm->cont = cont;
+                    base = args;
+                }
+                env = frame;
+                pc = vm->functions[fn->as.lambda.function].code;
+                break;
             }
             
-            if (strcmp(name, "on-button-y") == 0) {
-                vm->on_button_callbacks[3] = lisp_eval(vm, lisp_nth(args, 0), env);
-                return vm->on_button_callbacks[3];
+            case OP_HOOK: {
+                uint8_t hook = code[pc++];
+                if (hook == 0) {
+                    vm->on_update = TOP();
+                } else {
+                    vm->on_button_callbacks[hook - 1] = TOP();
+                }
+                break;
             }
+            
+            case OP_RETURN: {
+                lisp_value_t *result = TOP();
+                if (vm->cont == entry) {
+                    vm->stack_ptr = base;
+                    return result;
+                }
+                
+                // Back to the caller; the result replaces the frame
+                lisp_value_t *cont = vm->cont;
+                vm->cont = cont->as.cont.next;
+                vm->stack_ptr = base - 1;
+                env = cont->as.cont.env;
+                pc = cont->as.cont.pc;
+                base = cont->as.cont.base;
+                PUSH(result);
+                break;
+            }
+            
+            default:
+                vm->error_msg = "Bad bytecode";
+                goto fail;
         }
-        
-        // Function call - evaluate all arguments
-        lisp_value_t *fn = lisp_eval(vm, op, env);
-        
-        // Build evaluated args list
-        lisp_value_t *eval_args = NULL;
-        lisp_value_t **tail = &eval_args;
-        while (IS_CONS(args)) {
-            lisp_value_t *arg = lisp_eval(vm, lisp_car(args), env);
-            *tail = lisp_cons(vm, arg, lisp_nil(vm));
-            tail = &(*tail)->as.cons.cdr;
-            args = lisp_cdr(args);
-        }
-        
-        return lisp_apply(vm, fn, eval_args, env);
     }
     
-    return lisp_nil(vm);
+fail:
+    vm->cont = entry;
+    vm->stack_ptr = entry_base;
+    return NULL;
+}
+
+#undef PUSH
+#undef TOP
+#undef READ16
+
+// ===== Evaluation =====
+
+lisp_value_t* RAM_FUNC(lisp_eval)(lisp_vm_t *vm, lisp_value_t *expr, lisp_value_t *env) {
+    if (!expr) return lisp_nil(vm);
+    if (vm->stack_ptr + 2 > LISP_STACK_SIZE) {
+        vm->error_msg = "Stack overflow";
+        return lisp_nil(vm);
+    }
+    
+    // Keep the expression and env alive while compiling and running
+    size_t sp = vm->stack_ptr;
+    vm->stack[vm->stack_ptr++] = expr;
+    vm->stack[vm->stack_ptr++] = env;
+    
+    if (IS_CONS(expr)) {
+        scope_t top = { .depth = 0 };
+        resolve_form(vm, expr, &top);
+    }
+    
+    size_t code_mark = vm->code_used;
+    size_t constant_mark = vm->constant_count;
+    size_t function_mark = vm->function_count;
+    
+    compile_expr(vm, expr, true);
+    emit(vm, OP_RETURN);
+    lisp_value_t *result = vm->error_msg ? NULL : execute(vm, code_mark, env);
+    
+    // Only the lambdas compiled along with it have to stay
+    if (vm->function_count == function_mark) {
+        vm->code_used = code_mark;
+        vm->constant_count = constant_mark;
+    }
+    vm->stack_ptr = sp;
+    return result ? result : lisp_nil(vm);
 }
 
 lisp_value_t* lisp_apply(lisp_vm_t *vm, lisp_value_t *fn, lisp_value_t *args, lisp_value_t *env) {
     if (!fn) return lisp_nil(vm);
     
-    // Built-in function
-    if (fn->type == LISP_BUILTIN) {
-        return fn->as.builtin(vm, args);
+    size_t argc = lisp_length(args);
+    if (vm->stack_ptr + 1 + argc > LISP_STACK_SIZE) {
+        vm->error_msg = "Stack overflow";
+        return lisp_nil(vm);
+    }
+    vm->stack[vm->stack_ptr++] = fn;
+    for (; IS_CONS(args); args = lisp_cdr(args)) {
+        vm->stack[vm->stack_ptr++] = lisp_car(args);
     }
     
-    // Lambda
-    if (IS_LAMBDA(fn)) {
-        // Create new environment with lambda's closure
-        lisp_value_t *new_env = fn->as.lambda.env;
+    lisp_value_t *result = call(vm, argc);
+    return result ? result : lisp_nil(vm);
+}
+
+// ===== Script Images =====
+//
+// A script image is what the compiler makes of a whole script, so that
+// the game can start without parsing it: the top-level forms compiled in
+// turn into code that runs them all, the names of the symbols the code
+// refers to by id, the constants, and the functions. Loading runs that
+// code once, the same as evaluating the forms one by one, and none of the
+// parsed lists ever get into the heap. The code and the symbol names stay
+// where the image is, which can be a const array in flash; only numbers
+// too big for a fixnum are put into cells.
+//
+// All of it is in bytes, u16 and u32, low byte first: no pointers, so an
+// image made on any build with the same built-ins loads on any other.
+//
+//   header
+//   constants      i32 * constant_count
+//   functions      { u16 code, u16 nparams } * function_count
+//   code           code_size bytes, padded to 4
+//   symbol names   symbol_count strings, each ending in a 0
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t symbol_count;
+    uint16_t constant_count;
+    uint16_t function_count;
+    uint16_t code_size;
+    uint16_t names_size;
+} lisp_image_header_t;
+
+static size_t image_pad(size_t n) {
+    return (n + 3) & ~(size_t)3;
+}
+
+// Compile source into vm, which must be fresh from lisp_init(), without
+// running it, and serialise the result into a buffer from malloc(); NULL
+// with vm->error_msg set if the script does not compile or has a constant
+// an image cannot hold. vm is of no further use and wants lisp_init()
+uint8_t* lisp_compile_image(lisp_vm_t *vm, const char *source, size_t *size) {
+    // Every form is compiled but the last one's value popped, as
+    // lisp_eval() would have dropped it
+    bool first = true;
+    while (!vm->error_msg) {
+        lisp_value_t *expr = lisp_parse(vm, &source);
+        if (!expr) break;
+        if (!first) emit(vm, OP_POP);
+        first = false;
         
-        // Bind parameters
-        lisp_value_t *params = fn->as.lambda.params;
-        while (IS_CONS(params) && IS_CONS(args)) {
-            lisp_value_t *param = lisp_car(params);
-            lisp_value_t *arg = lisp_car(args);
-            lisp_value_t *binding = lisp_cons(vm, param, arg);
-            new_env = lisp_cons(vm, binding, new_env);
-            params = lisp_cdr(params);
-            args = lisp_cdr(args);
+        vm->stack[vm->stack_ptr++] = expr;
+        if (IS_CONS(expr)) {
+            scope_t top = { .depth = 0 };
+            resolve_form(vm, expr, &top);
         }
-        
-        return lisp_eval(vm, fn->as.lambda.body, new_env);
+        compile_expr(vm, expr, false);
+        vm->stack_ptr--;
     }
+    if (first) emit(vm, OP_NIL);
+    emit(vm, OP_RETURN);
     
-    return lisp_nil(vm);
+    for (size_t i = 0; i < vm->constant_count && !vm->error_msg; i++) {
+        if (!IS_NUMBER(vm->constants[i])) vm->error_msg = "Constant an image cannot hold";
+    }
+    size_t names_size = 0;
+    for (size_t i = 0; i < vm->symbol_count; i++) {
+        names_size += vm->symbol_length[i] + 1;
+    }
+    if (names_size > UINT16_MAX) vm->error_msg = "Symbol names too long for an image";
+    if (vm->error_msg) return NULL;
+    
+    size_t at = sizeof(lisp_image_header_t);
+    size_t constants_at = at;
+    at += vm->constant_count * sizeof(int32_t);
+    size_t functions_at = at;
+    at += vm->function_count * 2 * sizeof(uint16_t);
+    size_t code_at = at;
+    at += image_pad(vm->code_used);
+    size_t names_at = at;
+    at += names_size;
+    
+    uint8_t *image = calloc(1, at);
+    if (!image) {
+        vm->error_msg = "Out of memory";
+        return NULL;
+    }
+    lisp_image_header_t header = {
+        LISP_IMAGE_MAGIC, LISP_IMAGE_VERSION, vm->symbol_count, vm->constant_count,
+        vm->function_count, vm->code_used, names_size
+    };
+    memcpy(image, &header, sizeof(header));
+    for (size_t i = 0; i < vm->constant_count; i++) {
+        int32_t n = lisp_number_value(vm->constants[i]);
+        memcpy(image + constants_at + i * sizeof(n), &n, sizeof(n));
+    }
+    for (size_t i = 0; i < vm->function_count; i++) {
+        uint16_t f[2] = { vm->functions[i].code, vm->functions[i].nparams };
+        memcpy(image + functions_at + i * sizeof(f), f, sizeof(f));
+    }
+    memcpy(image + code_at, vm->code, vm->code_used);
+    for (size_t i = 0; i < vm->symbol_count; i++) {
+        size_t len = vm->symbol_length[i] + 1u;
+        memcpy(image + names_at, vm->symbols[i], len);
+        names_at += len;
+    }
+    *size = at;
+    return image;
+}
+
+// Load an image into vm, fresh from lisp_init(), and run its top-level
+// forms. image has to be 4-byte aligned and outlive vm. False if it is
+// not an image for these built-ins, with vm->error_msg set if running it
+// went wrong
+bool lisp_load_image(lisp_vm_t *vm, const uint8_t *image, size_t size) {
+    const lisp_image_header_t *header = (const lisp_image_header_t*)image;
+    if (size < sizeof(*header) || header->magic != LISP_IMAGE_MAGIC ||
+        header->version != LISP_IMAGE_VERSION) return false;
+    if (vm->code_used || vm->function_count || vm->constant_count) return false;
+    if (header->symbol_count > LISP_SYMBOL_TABLE_SIZE || header->constant_count > LISP_MAX_CONSTANTS ||
+        header->function_count > LISP_MAX_FUNCTIONS || header->code_size > LISP_CODE_SIZE ||
+        header->code_size == 0) return false;
+    
+    const int32_t *constants = (const int32_t*)(image + sizeof(*header));
+    const uint16_t *functions = (const uint16_t*)(constants + header->constant_count);
+    const uint8_t *code = (const uint8_t*)(functions + 2 * header->function_count);
+    const char *names = (const char*)code + image_pad(header->code_size);
+    if ((const uint8_t*)names + header->names_size > image + size ||
+        header->names_size == 0 || names[header->names_size - 1] != '\0') return false;
+    
+    // The symbols lisp_init() interned have to be the first of the image,
+    // with the same ids; the others point into it
+    const char *name = names;
+    for (uint16_t id = 0; id < header->symbol_count; id++) {
+        if (name >= names + header->names_size) return false;
+        size_t len = strlen(name);
+        if (id < vm->symbol_count) {
+            if (vm->symbol_length[id] != len || memcmp(vm->symbols[id], name, len) != 0) return false;
+        } else if (symbol_intern(vm, name, len, false) != lisp_symbol_value(id)) {
+            return false;
+        }
+        name += len + 1;
+    }
+    if (vm->symbol_count != header->symbol_count) return false;
+    
+    for (uint16_t i = 0; i < header->function_count; i++) {
+        vm->functions[i].code = functions[2 * i];
+        vm->functions[i].nparams = functions[2 * i + 1];
+    }
+    vm->function_count = header->function_count;
+    for (uint16_t i = 0; i < header->constant_count; i++) {
+        vm->constants[vm->constant_count] = lisp_number(vm, constants[i]);
+        if (!vm->constants[vm->constant_count]) return false;
+        vm->constant_count++;
+    }
+    vm->code_image = code;
+    vm->code_used = header->code_size;
+    
+    // As lisp_eval() would, with nothing to keep alive but the env
+    if (vm->stack_ptr + 2 > LISP_STACK_SIZE) return false;
+    size_t sp = vm->stack_ptr;
+    vm->stack[vm->stack_ptr++] = LISP_NIL_VALUE;
+    vm->stack[vm->stack_ptr++] = vm->global_env;
+    execute(vm, 0, vm->global_env);
+    vm->stack_ptr = sp;
+    return true;
 }
 
 // ===== Sprites =====
 
 lisp_sprite_t* lisp_create_sprite(lisp_vm_t *vm, uint8_t w, uint8_t h, const uint16_t *data) {
     if (vm->sprite_count >= LISP_MAX_SPRITES) return NULL;
-    if (w > LISP_SPRITE_MAX_SIZE || h > LISP_SPRITE_MAX_SIZE) return NULL;
+    if (w == 0 || h == 0) return NULL;
+    size_t size = (size_t)w * h;
+    if (vm->sprite_pixels_used + size > LISP_SPRITE_POOL_SIZE) return NULL;
     
     lisp_sprite_t *sprite = &vm->sprites[vm->sprite_count++];
     sprite->width = w;
     sprite->height = h;
+    sprite->data = &vm->sprite_pixels[vm->sprite_pixels_used];
+    vm->sprite_pixels_used += size;
+    sprite->transparent = 0;
     
     if (data) {
-        memcpy(sprite->data, data, w * h * sizeof(uint16_t));
+        memcpy(sprite->data, data, size * sizeof(uint16_t));
+        for (size_t i = 0; i < size; i++) {
+            if (data[i] == LISP_SPRITE_TRANSPARENT) sprite->transparent++;
+        }
     } else {
-        memset(sprite->data, 0, w * h * sizeof(uint16_t));
+        memset(sprite->data, 0, size * sizeof(uint16_t));
     }
     
     return sprite;
 }
 
+// All writes go through here so the count of transparent pixels stays
+// right; a sprite without any is drawn a whole row at a time
+void lisp_sprite_set_pixel(lisp_sprite_t *sprite, uint8_t x, uint8_t y, uint16_t color) {
+    if (x >= sprite->width || y >= sprite->height) return;
+    uint16_t *p = &sprite->data[y * sprite->width + x];
+    sprite->transparent += (color == LISP_SPRITE_TRANSPARENT) - (*p == LISP_SPRITE_TRANSPARENT);
+    *p = color;
+}
+
+void lisp_sprite_fill(lisp_sprite_t *sprite, uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint16_t color) {
+    if (x >= sprite->width || y >= sprite->height) return;
+    if (w > sprite->width - x) w = sprite->width - x;
+    if (h > sprite->height - y) h = sprite->height - y;
+    for (uint8_t sy = y; sy < y + h; sy++) {
+        for (uint8_t sx = x; sx < x + w; sx++) {
+            lisp_sprite_set_pixel(sprite, sx, sy, color);
+        }
+    }
+}
+
 void lisp_draw_sprite(lisp_sprite_t *sprite, int16_t x, int16_t y) {
     if (!sprite) return;
     
-    // Use framebuffer for smooth rendering
+    // Clip once against the screen, not per pixel
+    int x0 = x < 0 ? -x : 0;
+    int y0 = y < 0 ? -y : 0;
+    int x1 = sprite->width;
+    int y1 = sprite->height;
+    if (x + x1 > DISPLAY_WIDTH) x1 = DISPLAY_WIDTH - x;
+    if (y + y1 > DISPLAY_HEIGHT) y1 = DISPLAY_HEIGHT - y;
+    if (x0 >= x1 || y0 >= y1) return;
+    
     uint16_t *fb = disp_get_framebuffer();
     if (!fb) {
-        // Fallback to direct drawing
-        disp_blit(x, y, sprite->width, sprite->height, sprite->data);
+        // Direct drawing: set a window and let disp_blit() DMA the pixels.
+        // An unclipped opaque sprite is one transfer, otherwise each row is
+        // split into its runs of visible pixels
+        if (!sprite->transparent && x0 == 0 && x1 == sprite->width) {
+            disp_blit(x, y + y0, sprite->width, y1 - y0, &sprite->data[y0 * sprite->width]);
+            return;
+        }
+        for (int sy = y0; sy < y1; sy++) {
+            const uint16_t *row = &sprite->data[sy * sprite->width];
+            int sx = x0;
+            while (sx < x1) {
+                while (sx < x1 && row[sx] == LISP_SPRITE_TRANSPARENT) sx++;
+                int run = sx;
+                while (sx < x1 && row[sx] != LISP_SPRITE_TRANSPARENT) sx++;
+                if (sx > run) disp_blit(x + run, y + sy, sx - run, 1, &row[run]);
+            }
+        }
         return;
     }
     
-    for (uint8_t sy = 0; sy < sprite->height; sy++) {
-        for (uint8_t sx = 0; sx < sprite->width; sx++) {
-            int16_t px = x + sx;
-            int16_t py = y + sy;
-            
-            if (px >= 0 && px < DISPLAY_WIDTH && py >= 0 && py < DISPLAY_HEIGHT) {
-                uint16_t color = sprite->data[sy * sprite->width + sx];
-                // Skip transparent pixels (color 0xF81F = magenta = transparent)
-                if (color != 0xF81F) {
-                    fb[py * DISPLAY_WIDTH + px] = color;
-                }
+    size_t w = x1 - x0;
+    for (int sy = y0; sy < y1; sy++) {
+        const uint16_t *src = &sprite->data[sy * sprite->width + x0];
+        uint16_t *dst = &fb[(y + sy) * DISPLAY_WIDTH + x + x0];
+        if (!sprite->transparent) {
+            memcpy(dst, src, w * sizeof(uint16_t));
+        } else {
+            for (size_t i = 0; i < w; i++) {
+                if (src[i] != LISP_SPRITE_TRANSPARENT) dst[i] = src[i];
             }
         }
     }
@@ -523,9 +1536,31 @@ void lisp_stop_game(lisp_vm_t *vm) {
     vm->running = false;
 }
 
+#ifdef LISP_GC_HUD
+// Collector counters over the bottom two text rows of the framebuffer
+static void gc_draw_hud(lisp_vm_t *vm) {
+    const lisp_gc_stats_t *s = &vm->gc_stats;
+    char line[DISPLAY_WIDTH / 6 + 1];
+    uint16_t y = DISPLAY_HEIGHT - 16;
+    
+    snprintf(line, sizeof(line), "GC %lu+%lu  max %lu us  alloc %lu/%lu",
+             (unsigned long)s->cycles, (unsigned long)s->full, (unsigned long)s->pause_max_us,
+             (unsigned long)s->frame_allocated, (unsigned long)s->frame_allocated_max);
+    disp_framebuffer_draw_text(0, y, line, COLOR_YELLOW, COLOR_BLACK);
+    
+    snprintf(line, sizeof(line), "heap %u peak %u of %u",
+             (unsigned)vm->heap_live, (unsigned)s->heap_peak, (unsigned)LISP_HEAP_SIZE);
+    disp_framebuffer_draw_text(0, y + 8, line, COLOR_YELLOW, COLOR_BLACK);
+}
+#endif
+
 void lisp_update(lisp_vm_t *vm) {
     if (!vm->running) return;
     
+    // Collect a little, before any cell is held in a C local
+    lisp_gc_step(vm, LISP_GC_BUDGET);
+    uint32_t allocated = vm->gc_stats.allocated;
+    
     // Update buttons
     buttons_update();
     
@@ -541,8 +1576,15 @@ void lisp_update(lisp_vm_t *vm) {
         lisp_apply(vm, vm->on_update, lisp_nil(vm), vm->global_env);
     }
     
+    lisp_gc_stats_t *s = &vm->gc_stats;
+    s->frame_allocated = s->allocated - allocated;
+    if (s->frame_allocated > s->frame_allocated_max) s->frame_allocated_max = s->frame_allocated;
+    
     // Flush framebuffer if used
     if (disp_get_framebuffer()) {
+#ifdef LISP_GC_HUD
+        gc_draw_hud(vm);
+#endif
         disp_framebuffer_flush();
     }
 }
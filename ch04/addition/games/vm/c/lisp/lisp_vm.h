@@ -8,31 +8,84 @@
 // ===== Memory Configuration =====
 #define LISP_HEAP_SIZE 8192        // Number of cons cells
 #define LISP_SYMBOL_TABLE_SIZE 256 // Max unique symbols
-#define LISP_STACK_SIZE 256        // Evaluation stack depth
-#define LISP_MAX_SPRITES 32        // Max sprites
-#define LISP_SPRITE_MAX_SIZE 32    // Max sprite dimension (32x32)
+#define LISP_SYMBOL_HASH_SIZE 512  // Hash slots, power of two above the table size
+#define LISP_MAX_SCOPE 32          // Max nesting of lambdas
+#define LISP_CODE_SIZE 16384       // Bytecode bytes
+#define LISP_MAX_CONSTANTS 1024    // Constant pool entries
+#define LISP_MAX_FUNCTIONS 256     // Compiled lambdas
+#define LISP_STACK_SIZE 1024       // Operand stack slots
+#define LISP_MAX_SPRITES 64        // Max sprites
+#define LISP_SPRITE_POOL_SIZE 16384  // Sprite pixels, shared by all sprites
+#define LISP_SPRITE_TRANSPARENT 0xF81F  // Colour key: magenta is not drawn
+
+// ===== Garbage Collector Configuration =====
+#define LISP_GREY_STACK_SIZE 512   // Cells waiting to be scanned
+#define LISP_GC_BUDGET 512         // Cells marked per frame
+#define LISP_GC_THRESHOLD (LISP_HEAP_SIZE / 2)  // Cells in use that start a cycle
+
+// ===== Collector Statistics =====
+#define LISP_GC_PAUSE_BUCKETS 8    // Pause histogram buckets, doubling in width
+#define LISP_GC_PAUSE_FIRST_US 32  // Pauses below this go into the first
+
+#if LISP_HEAP_SIZE > 65536
+#error "lisp_value.forward holds a heap index in 16 bits"
+#endif
 
 // ===== Lisp Value Types =====
 typedef enum {
-    LISP_NIL,
-    LISP_NUMBER,
-    LISP_SYMBOL,
+    LISP_NIL,       // Immediate only
+    LISP_NUMBER,    // Immediate fixnum, or a cell when it does not fit
+    LISP_SYMBOL,    // Immediate only
     LISP_CONS,
     LISP_BUILTIN,
     LISP_LAMBDA,
     LISP_STRING,
-    LISP_SPRITE
+    LISP_SPRITE,
+    LISP_FRAME,     // Lambda call frame
+    LISP_LOCAL,     // Resolved reference to a lambda parameter
+    LISP_CONT,      // Continuation of a call in progress
+    LISP_FREE       // Cell on the free list
 } lisp_type_t;
 
+// Cell colours kept in lisp_value.marked
+typedef enum {
+    LISP_WHITE,     // Not reached (yet)
+    LISP_GREY,      // Reached, children not scanned
+    LISP_BLACK      // Reached and scanned
+} lisp_colour_t;
+
+// Collector phases
+typedef enum {
+    LISP_GC_IDLE,
+    LISP_GC_MARK
+} lisp_gc_phase_t;
+
+// Collector counters since lisp_init() or lisp_gc_reset_stats(). A pause
+// is one lisp_gc_step() that did work or one lisp_gc(); pauses[i] counts
+// those under LISP_GC_PAUSE_FIRST_US << i, the last bucket all longer ones
+typedef struct {
+    uint32_t cycles;               // Incremental cycles finished
+    uint32_t full;                 // Emergency lisp_gc() calls
+    uint32_t pauses[LISP_GC_PAUSE_BUCKETS];
+    uint32_t pause_max_us;
+    uint32_t allocated;            // Cells
+    uint32_t frame_allocated;      // Cells allocated in the last lisp_update()
+    uint32_t frame_allocated_max;
+    size_t heap_peak;              // Highest heap_used, the part of the heap touched
+    size_t live_peak;              // Most cells left live by a collection
+} lisp_gc_stats_t;
+
 // Forward declarations
 typedef struct lisp_value lisp_value_t;
-typedef lisp_value_t* (*lisp_builtin_fn)(lisp_value_t *args);
+struct lisp_vm;
+typedef lisp_value_t* (*lisp_builtin_fn)(struct lisp_vm *vm, int argc, lisp_value_t **argv);
 
-// Sprite data structure
+// Sprite data structure: width * height pixels in the VM's sprite pool
 typedef struct {
     uint8_t width;
     uint8_t height;
-    uint16_t data[LISP_SPRITE_MAX_SIZE * LISP_SPRITE_MAX_SIZE];
+    uint16_t transparent;          // Pixels equal to LISP_SPRITE_TRANSPARENT
+    uint16_t *data;
 } lisp_sprite_t;
 
 // Cons cell - the fundamental building block
@@ -41,28 +94,135 @@ typedef struct lisp_cons {
     lisp_value_t *cdr;
 } lisp_cons_t;
 
+// Built-in: its arguments are argv[0..argc), slots of the operand stack,
+// with argc checked against the arity before the call
+#define LISP_VARIADIC 255          // max_args of a built-in taking any number
+
+// Built-ins whose call of two fixnums the stack machine does itself
+typedef enum {
+    LISP_FAST_NONE,
+    LISP_FAST_ADD,
+    LISP_FAST_SUB,
+    LISP_FAST_LT,
+    LISP_FAST_GT,
+    LISP_FAST_EQ
+} lisp_fast_t;
+
+typedef struct {
+    lisp_builtin_fn fn;
+    uint8_t min_args;
+    uint8_t max_args;
+    uint8_t fast;          // lisp_fast_t
+} lisp_builtin_t;
+
 // Lambda closure
 typedef struct {
-    lisp_value_t *params;  // List of parameter symbols
-    lisp_value_t *body;    // Body expression
-    lisp_value_t *env;     // Captured environment (alist)
+    lisp_value_t *env;     // Captured frame, nil at top level
+    uint16_t function;     // Compiled code, shared by all closures of the lambda
 } lisp_lambda_t;
 
+// Compiled lambda
+typedef struct {
+    uint16_t code;         // Entry in vm->code
+    uint16_t nparams;
+} lisp_function_t;
+
+// Call frame: the argument values sit in the car of count cons cells,
+// which are consecutive in the heap when packed is set
+typedef struct {
+    lisp_value_t *parent;  // Frame of the enclosing lambda
+    lisp_value_t *slots;   // First slot cell, chained through cdr
+    uint16_t count;
+    bool packed;
+} lisp_frame_t;
+
+// Parameter reference: index in the frame depth levels up
+typedef struct {
+    uint16_t depth;
+    uint16_t index;
+} lisp_local_t;
+
+// Where a call returns to
+typedef struct {
+    lisp_value_t *env;     // Frame of the caller
+    lisp_value_t *next;    // Continuation of the caller
+    uint16_t pc;
+    uint16_t base;         // Operand stack base of the caller
+} lisp_cont_t;
+
+#define LISP_RESOLVED 0x01  // flags: lambda form has its locals resolved
+
 // Lisp value (tagged union)
 struct lisp_value {
-    lisp_type_t type;
-    uint8_t marked;  // For GC
+    uint8_t type;    // lisp_type_t
+    uint8_t marked;  // For GC (lisp_colour_t)
+    uint8_t flags;
+    uint16_t forward;  // New heap index while compacting
     union {
-        int32_t number;
-        uint16_t symbol_id;
+        int32_t number;    // Only numbers too big for a fixnum
         lisp_cons_t cons;
-        lisp_builtin_fn builtin;
+        lisp_builtin_t builtin;
         lisp_lambda_t lambda;
         const char *string;
         lisp_sprite_t *sprite;
+        lisp_frame_t frame;
+        lisp_local_t local;
+        lisp_cont_t cont;
     } as;
 };
 
+// ===== Immediate Values =====
+//
+// Small numbers, nil and symbols are not cells: they live in the
+// lisp_value_t pointer itself, so arithmetic allocates nothing. Cells are
+// at least 4-byte aligned, which leaves the two low bits of a pointer:
+//   ...1  fixnum, the number in the bits above (31 bits on the Pico)
+//   ..10  symbol id + 1 in the bits above, 0 being nil
+//   ..00  a cell in the heap
+// A number that does not fit in a fixnum gets a LISP_NUMBER cell.
+
+#define LISP_NIL_VALUE ((lisp_value_t*)(uintptr_t)2)
+
+static inline bool lisp_is_immediate(const lisp_value_t *v) {
+    return ((uintptr_t)v & 3) != 0;
+}
+
+static inline bool lisp_fits_fixnum(int32_t n) {
+    return (intptr_t)n >= INTPTR_MIN / 2 && (intptr_t)n <= INTPTR_MAX / 2;
+}
+
+static inline lisp_value_t* lisp_fixnum(int32_t n) {
+    return (lisp_value_t*)(((intptr_t)n * 2) | 1);
+}
+
+static inline lisp_value_t* lisp_symbol_value(uint16_t id) {
+    return (lisp_value_t*)((((uintptr_t)id + 1) << 2) | 2);
+}
+
+static inline uint16_t lisp_symbol_id(const lisp_value_t *v) {
+    return ((uintptr_t)v >> 2) - 1;
+}
+
+static inline lisp_type_t lisp_type_of(const lisp_value_t *v) {
+    uintptr_t bits = (uintptr_t)v;
+    if (bits & 1) return LISP_NUMBER;
+    if (bits & 2) return bits == 2 ? LISP_NIL : LISP_SYMBOL;
+    return (lisp_type_t)v->type;
+}
+
+// Value of a number, immediate or not
+static inline int32_t lisp_number_value(const lisp_value_t *v) {
+    return ((uintptr_t)v & 1) ? (int32_t)((intptr_t)v >> 1) : v->as.number;
+}
+
+#define IS_NIL(v) ((v) == LISP_NIL_VALUE)
+#define IS_NUMBER(v) (lisp_type_of(v) == LISP_NUMBER)
+#define IS_SYMBOL(v) (lisp_type_of(v) == LISP_SYMBOL)
+#define IS_CONS(v) (lisp_type_of(v) == LISP_CONS)
+#define IS_LAMBDA(v) (lisp_type_of(v) == LISP_LAMBDA)
+#define IS_STRING(v) (lisp_type_of(v) == LISP_STRING)
+#define IS_SPRITE(v) (lisp_type_of(v) == LISP_SPRITE)
+
 // ===== Collision Detection =====
 typedef struct {
     int16_t x, y;
@@ -70,25 +230,50 @@ typedef struct {
 } lisp_rect_t;
 
 // ===== VM State =====
-typedef struct {
+typedef struct lisp_vm {
     // Memory pools
     lisp_value_t heap[LISP_HEAP_SIZE];
-    size_t heap_used;
+    size_t heap_used;              // Bump pointer
+    size_t heap_live;              // Cells in use
+    lisp_value_t *free_list;       // Only after an emergency lisp_gc()
+    
+    // Incremental collector
+    lisp_gc_phase_t gc_phase;
+    lisp_value_t *grey[LISP_GREY_STACK_SIZE];
+    size_t grey_count;
+    bool grey_overflow;            // Grey cells left in the heap only
+    lisp_gc_stats_t gc_stats;
     
     // Symbol table
     const char *symbols[LISP_SYMBOL_TABLE_SIZE];
+    uint16_t symbol_length[LISP_SYMBOL_TABLE_SIZE];   // Without the 0 at the end
     size_t symbol_count;
+    uint16_t special_forms;                         // Id of the first one, see lisp_init()
+    uint16_t symbol_hash[LISP_SYMBOL_HASH_SIZE];   // Symbol id + 1, 0 if empty
+    lisp_value_t *globals[LISP_SYMBOL_TABLE_SIZE];  // Global value of each symbol
     
-    // Evaluation stack
+    // Operand stack; calls keep their continuations in the heap
     lisp_value_t *stack[LISP_STACK_SIZE];
     size_t stack_ptr;
+    lisp_value_t *cont;
     
-    // Global environment (association list)
+    // Bytecode; never freed, like sprites
+    uint8_t code[LISP_CODE_SIZE];
+    size_t code_used;
+    const uint8_t *code_image;     // Code of a loaded image, run in place until more is compiled
+    lisp_value_t *constants[LISP_MAX_CONSTANTS];
+    size_t constant_count;
+    lisp_function_t functions[LISP_MAX_FUNCTIONS];
+    size_t function_count;
+    
+    // Global environment: nil, the globals live in globals[]
     lisp_value_t *global_env;
     
     // Sprites
     lisp_sprite_t sprites[LISP_MAX_SPRITES];
     size_t sprite_count;
+    uint16_t sprite_pixels[LISP_SPRITE_POOL_SIZE];
+    size_t sprite_pixels_used;
     
     // Game callbacks
     lisp_value_t *on_update;
@@ -105,7 +290,9 @@ void lisp_deinit(lisp_vm_t *vm);
 
 // Memory management
 lisp_value_t* lisp_alloc(lisp_vm_t *vm, lisp_type_t type);
-void lisp_gc(lisp_vm_t *vm);
+void lisp_gc(lisp_vm_t *vm);                     // Full collection, no moving
+void lisp_gc_step(lisp_vm_t *vm, size_t budget); // Between frames only
+void lisp_gc_reset_stats(lisp_vm_t *vm);
 
 // Construction
 lisp_value_t* lisp_nil(lisp_vm_t *vm);
@@ -113,11 +300,13 @@ lisp_value_t* lisp_number(lisp_vm_t *vm, int32_t n);
 lisp_value_t* lisp_symbol(lisp_vm_t *vm, const char *name);
 lisp_value_t* lisp_cons(lisp_vm_t *vm, lisp_value_t *car, lisp_value_t *cdr);
 lisp_value_t* lisp_string(lisp_vm_t *vm, const char *str);
-lisp_value_t* lisp_builtin(lisp_vm_t *vm, lisp_builtin_fn fn);
+lisp_value_t* lisp_builtin(lisp_vm_t *vm, lisp_builtin_fn fn, uint8_t min_args, uint8_t max_args);
 
 // List operations
 lisp_value_t* lisp_car(lisp_value_t *cons);
 lisp_value_t* lisp_cdr(lisp_value_t *cons);
+void lisp_set_car(lisp_vm_t *vm, lisp_value_t *cons, lisp_value_t *value);
+void lisp_set_cdr(lisp_vm_t *vm, lisp_value_t *cons, lisp_value_t *value);
 size_t lisp_length(lisp_value_t *list);
 lisp_value_t* lisp_nth(lisp_value_t *list, size_t n);
 
@@ -128,6 +317,14 @@ lisp_value_t* lisp_parse(lisp_vm_t *vm, const char **code);
 lisp_value_t* lisp_eval(lisp_vm_t *vm, lisp_value_t *expr, lisp_value_t *env);
 lisp_value_t* lisp_apply(lisp_vm_t *vm, lisp_value_t *fn, lisp_value_t *args, lisp_value_t *env);
 
+// Script images: a whole script compiled, with the symbol names, constants
+// and functions it needs, to be loaded without parsing (see lisp_vm.c)
+#define LISP_IMAGE_MAGIC 0x4D49504Cu   // "LPIM"
+#define LISP_IMAGE_VERSION 2
+
+uint8_t* lisp_compile_image(lisp_vm_t *vm, const char *source, size_t *size);
+bool lisp_load_image(lisp_vm_t *vm, const uint8_t *image, size_t size);
+
 // Environment
 lisp_value_t* lisp_env_lookup(lisp_vm_t *vm, lisp_value_t *env, lisp_value_t *symbol);
 lisp_value_t* lisp_env_define(lisp_vm_t *vm, lisp_value_t *env, lisp_value_t *symbol, lisp_value_t *value);
@@ -137,6 +334,8 @@ lisp_value_t* lisp_env_set(lisp_vm_t *vm, lisp_value_t *env, lisp_value_t *symbo
 
 // Sprite management
 lisp_sprite_t* lisp_create_sprite(lisp_vm_t *vm, uint8_t w, uint8_t h, const uint16_t *data);
+void lisp_sprite_set_pixel(lisp_sprite_t *sprite, uint8_t x, uint8_t y, uint16_t color);
+void lisp_sprite_fill(lisp_sprite_t *sprite, uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint16_t color);
 void lisp_draw_sprite(lisp_sprite_t *sprite, int16_t x, int16_t y);
 
 // Collision detection
@@ -151,30 +350,42 @@ void lisp_update(lisp_vm_t *vm);  // Called every frame
 // ===== Built-in Functions =====
 
 // Graphics
-lisp_value_t* lisp_builtin_clear(lisp_vm_t *vm, lisp_value_t *args);
-lisp_value_t* lisp_builtin_fill_rect(lisp_vm_t *vm, lisp_value_t *args);
-lisp_value_t* lisp_builtin_draw_text(lisp_vm_t *vm, lisp_value_t *args);
-lisp_value_t* lisp_builtin_draw_sprite(lisp_vm_t *vm, lisp_value_t *args);
+lisp_value_t* lisp_builtin_clear(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_fill_rect(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_draw_text(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_draw_sprite(lisp_vm_t *vm, int argc, lisp_value_t **argv);
 
 // Sprites
-lisp_value_t* lisp_builtin_make_sprite(lisp_vm_t *vm, lisp_value_t *args);
-lisp_value_t* lisp_builtin_sprite_set_pixel(lisp_vm_t *vm, lisp_value_t *args);
+lisp_value_t* lisp_builtin_make_sprite(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_sprite_set_pixel(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_sprite_fill(lisp_vm_t *vm, int argc, lisp_value_t **argv);
 
 // Collision
-lisp_value_t* lisp_builtin_collide(lisp_vm_t *vm, lisp_value_t *args);
+lisp_value_t* lisp_builtin_collide(lisp_vm_t *vm, int argc, lisp_value_t **argv);
 
 // Math
-lisp_value_t* lisp_builtin_add(lisp_vm_t *vm, lisp_value_t *args);
-lisp_value_t* lisp_builtin_sub(lisp_vm_t *vm, lisp_value_t *args);
-lisp_value_t* lisp_builtin_mul(lisp_vm_t *vm, lisp_value_t *args);
-lisp_value_t* lisp_builtin_div(lisp_vm_t *vm, lisp_value_t *args);
-lisp_value_t* lisp_builtin_lt(lisp_vm_t *vm, lisp_value_t *args);
-lisp_value_t* lisp_builtin_gt(lisp_vm_t *vm, lisp_value_t *args);
-lisp_value_t* lisp_builtin_eq(lisp_vm_t *vm, lisp_value_t *args);
+lisp_value_t* lisp_builtin_add(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_sub(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_mul(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_div(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_lt(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_gt(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_eq(lisp_vm_t *vm, int argc, lisp_value_t **argv);
 
 // Control
-lisp_value_t* lisp_builtin_start(lisp_vm_t *vm, lisp_value_t *args);
-lisp_value_t* lisp_builtin_stop(lisp_vm_t *vm, lisp_value_t *args);
+lisp_value_t* lisp_builtin_start(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_stop(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+
+// Collector statistics
+lisp_value_t* lisp_builtin_gc_count(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_gc_full(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_gc_pause_max(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_gc_pauses(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_gc_alloc(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_gc_alloc_max(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_heap_live(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_heap_peak(lisp_vm_t *vm, int argc, lisp_value_t **argv);
+lisp_value_t* lisp_builtin_gc_reset(lisp_vm_t *vm, int argc, lisp_value_t **argv);
 
 // Utilities
 void lisp_print(lisp_value_t *value);
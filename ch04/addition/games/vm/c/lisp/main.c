@@ -1,8 +1,14 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include "pico/stdlib.h"
 #include "display.h"
 #include "lisp_vm.h"
 
+// GAME_CODE compiled, as a LISP_IMAGE_DUMP build printed it
+#ifdef LISP_IMAGE
+#include "lisp_image.h"
+#endif
+
 // Example game code as a string
 static const char GAME_CODE[] = 
 ";; Sprite-based Space Shooter\n"
@@ -67,6 +73,38 @@ static const char GAME_CODE[] =
 "\n"
 "(start)\n";
 
+// Show a Lisp error and stop
+static void halt_on_error(const char *msg) {
+    printf("Error: %s\n", msg);
+    disp_framebuffer_clear(COLOR_BLACK);
+    disp_framebuffer_draw_text(10, 100, "Lisp Error!", COLOR_RED, COLOR_BLACK);
+    disp_framebuffer_draw_text(10, 120, msg, COLOR_RED, COLOR_BLACK);
+    disp_framebuffer_flush();
+    while (1) tight_loop_contents();
+}
+
+#ifdef LISP_IMAGE_DUMP
+// Print the image of GAME_CODE as the source of lisp_image.h; vm is
+// initialised again afterwards
+static void dump_image(lisp_vm_t *vm) {
+    size_t size;
+    uint8_t *image = lisp_compile_image(vm, GAME_CODE, &size);
+    if (!image) {
+        printf("No image: %s\n", vm->error_msg);
+    } else {
+        printf("-- lisp_image.h --\n");
+        printf("// GAME_CODE of main.c compiled by a LISP_IMAGE_DUMP build\n");
+        printf("static const uint8_t lisp_image[%u] __attribute__((aligned(4))) = {\n", (unsigned)size);
+        for (size_t i = 0; i < size; i++) {
+            printf("%s0x%02x,%s", i % 16 ? " " : "    ", image[i], i % 16 == 15 || i == size - 1 ? "\n" : "");
+        }
+        printf("};\n-- end --\n");
+        free(image);
+    }
+    lisp_init(vm);
+}
+#endif
+
 int main() {
     // Initialize stdio for debug output
     stdio_init_all();
@@ -105,6 +143,19 @@ int main() {
     lisp_vm_t vm;
     lisp_init(&vm);
     
+#ifdef LISP_IMAGE_DUMP
+    dump_image(&vm);
+#endif
+    uint32_t load_start = time_us_32();
+    
+#ifdef LISP_IMAGE
+    // Run the compiled script in place, nothing to parse
+    printf("VM initialized, loading script image...\n");
+    if (!lisp_load_image(&vm, lisp_image, sizeof(lisp_image)) && !vm.error_msg) {
+        halt_on_error("Script image does not fit this VM");
+    }
+    if (vm.error_msg) halt_on_error(vm.error_msg);
+#else
     printf("VM initialized, parsing code...\n");
     
     // Parse and run game code
@@ -113,24 +164,19 @@ int main() {
         lisp_value_t *expr = lisp_parse(&vm, &code_ptr);
         if (!expr) break;
         
-        lisp_value_t *result = lisp_eval(&vm, expr, vm.global_env);
-        if (vm.error_msg) {
-            printf("Error: %s\n", vm.error_msg);
-            disp_framebuffer_clear(COLOR_BLACK);
-            disp_framebuffer_draw_text(10, 100, "Lisp Error!", COLOR_RED, COLOR_BLACK);
-            disp_framebuffer_draw_text(10, 120, vm.error_msg, COLOR_RED, COLOR_BLACK);
-            disp_framebuffer_flush();
-            while (1) tight_loop_contents();
-        }
+        lisp_eval(&vm, expr, vm.global_env);
+        if (vm.error_msg) halt_on_error(vm.error_msg);
     }
+#endif
     
-    printf("Game code loaded successfully!\n");
-    printf("Memory used: %zu / %d cells\n", vm.heap_used, LISP_HEAP_SIZE);
+    printf("Game code loaded in %lu us\n", (unsigned long)(time_us_32() - load_start));
+    printf("Memory used: %zu / %d cells\n", vm.heap_live, LISP_HEAP_SIZE);
     
     // Main game loop
     uint32_t last_update = to_ms_since_boot(get_absolute_time());
     uint32_t frame_count = 0;
     uint32_t fps_update = last_update;
+    uint64_t update_us = 0;  // in lisp_update() since the last FPS line
     
     while (vm.running) {
         uint32_t now = to_ms_since_boot(get_absolute_time());
@@ -140,14 +186,22 @@ int main() {
             last_update = now;
             
             // Update game logic
+            uint64_t start = time_us_64();
             lisp_update(&vm);
+            update_us += time_us_64() - start;
             
             frame_count++;
             
             // Print FPS every second
             if (now - fps_update >= 1000) {
-                printf("FPS: %lu, Heap: %zu cells\n", frame_count, vm.heap_used);
+                printf("FPS: %lu, Heap: %zu cells, Update: %lu us/frame\n", frame_count, vm.heap_live,
+                       frame_count ? (unsigned long)(update_us / frame_count) : 0ul);
+                printf("GC: %lu cycles, %lu full, pause max %lu us, alloc %lu/frame (max %lu), peak %zu/%d\n",
+                       (unsigned long)vm.gc_stats.cycles, (unsigned long)vm.gc_stats.full,
+                       (unsigned long)vm.gc_stats.pause_max_us, (unsigned long)vm.gc_stats.frame_allocated,
+                       (unsigned long)vm.gc_stats.frame_allocated_max, vm.gc_stats.heap_peak, LISP_HEAP_SIZE);
                 frame_count = 0;
+                update_us = 0;
                 fps_update = now;
             }
         }
@@ -291,7 +291,7 @@ disp_error_t disp_clear(uint16_t color) {
     return disp_fill_rect(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, color);
 }
 
-disp_error_t disp_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+disp_error_t RAM_FUNC(disp_fill_rect)(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
     if (!g.initialized) return DISP_ERROR(DISP_ERR_NOT_INIT, "not init");
     if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISP_ERROR(DISP_ERR_INVALID_COORDS, "bad pos");
     if (x + w > DISPLAY_WIDTH)  w = DISPLAY_WIDTH  - x;
@@ -422,7 +422,7 @@ disp_error_t disp_framebuffer_clear(uint16_t color) {
     return DISP_OK;
 }
 
-void disp_framebuffer_set_pixel(uint16_t x, uint16_t y, uint16_t color) {
+void RAM_FUNC(disp_framebuffer_set_pixel)(uint16_t x, uint16_t y, uint16_t color) {
     if (!g.framebuffer || x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return;
     g.framebuffer[y * DISPLAY_WIDTH + x] = color;
 }
@@ -460,7 +460,7 @@ disp_error_t disp_framebuffer_flush(void) {
 }
 
 // Framebuffer drawing functions
-void disp_framebuffer_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+void RAM_FUNC(disp_framebuffer_fill_rect)(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
     if (!g.framebuffer) return;
     
     // Clip to screen bounds
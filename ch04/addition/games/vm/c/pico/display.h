@@ -5,6 +5,16 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+// Hot functions are written RAM_FUNC(name). Built with RUN_FROM_RAM they
+// are copied to SRAM at boot and run from there, out of reach of the
+// misses of the flash XIP cache
+#ifdef RUN_FROM_RAM
+#include "pico/platform.h"
+#define RAM_FUNC(name) __not_in_flash_func(name)
+#else
+#define RAM_FUNC(name) name
+#endif
+
 // 320×240 landscape
 #define DISPLAY_WIDTH  320
 #define DISPLAY_HEIGHT 240
@@ -155,7 +155,7 @@ static void sys_collision(void) {
     }
 }
 
-static void sys_render(void) {
+static void RAM_FUNC(sys_render)(void) {
     // Clear screen first
     display_clear(COLOR_BLACK);
     
@@ -199,7 +199,7 @@ static void sys_render(void) {
 }
 
 /*  VM Interpreter  */
-static void vm_run(VM *vm) {
+static void RAM_FUNC(vm_run)(VM *vm) {
     uint32_t pc = 0;
     
     while (pc < vm->len) {
@@ -373,12 +373,21 @@ int main(void) {
     build_game_code(&vm);
     
     /* Game loop: run VM each frame */
+    uint32_t frames = 0;
+    uint64_t vm_us = 0;
     while (!should_quit && game_state == GAME_STATE_PLAYING) {
         // Update button states
         buttons_update();
         
-        // Run VM for this frame
+        // Run VM for this frame, and report its average time every 100
+        uint64_t start = time_us_64();
         vm_run(&vm);
+        vm_us += time_us_64() - start;
+        if (++frames == 100) {
+            printf("vm_run: %lu us/frame\n", (unsigned long)(vm_us / frames));
+            frames = 0;
+            vm_us = 0;
+        }
         
         // Frame delay (~20 FPS)
         sleep_ms(50);
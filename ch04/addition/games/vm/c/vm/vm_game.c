@@ -5,48 +5,61 @@
 #include <stdint.h>
 #include <string.h>
 
-#define MAX_ENTITIES   32
-#define COMP_SIZE      16
-#define MAX_CODE       2048
+#define MAX_ENTITIES   256
+#define MAX_CODE       64
+#define WANDERERS      40
+#define HUNTERS        8
 
-/* Flat memory (ECS) */
-static uint8_t mem[MAX_ENTITIES * COMP_SIZE];
+/* Scheduling: instructions per frame, and per turn of one task */
+#define FRAME_BUDGET   600
+#define TASK_SLICE     16
+
+/* Components (ECS), one column per field so the systems that sweep
+   every entity read contiguous memory */
+static struct {
+    int16_t x[MAX_ENTITIES];
+    int16_t y[MAX_ENTITIES];
+    int16_t dx[MAX_ENTITIES];
+    int16_t dy[MAX_ENTITIES];
+    uint8_t player[MAX_ENTITIES];
+    uint8_t ai[MAX_ENTITIES];      /* AI_WANDER or AI_HUNT */
+    uint8_t state[MAX_ENTITIES];   /* 1 while flashing */
+    uint8_t timer[MAX_ENTITIES];
+} comp;
+static uint32_t entity_count = 0;
 static int should_quit = 0;
 static int screen_w = 0;
 static int screen_h = 0;
 
-/* Component offsets */
-#define OFF_X      0
-#define OFF_Y      2
-#define OFF_DX     4
-#define OFF_DY     6
-#define OFF_PLAYER 8
-#define OFF_AI     9
-#define OFF_STATE  10
-#define OFF_TIMER  11
-
-/* Simple VM */
-typedef struct {
-    uint8_t code[MAX_CODE];
-    uint32_t len;
-} VM;
+enum { AI_NONE, AI_WANDER, AI_HUNT };
 
 /* Opcodes */
 enum {
     OP_CALL_INPUT = 1,
     OP_CALL_AI,
-    OP_CALL_MOVE,
-    OP_CALL_CLAMP,
     OP_CALL_FLASH,
-    OP_CALL_RENDER,
+    OP_SCAN,        /* look at one entity, keep the nearest prey */
+    OP_SCAN_LOOP,   /* addr: jump while entities are left to scan */
+    OP_CALL_STEER,  /* head for the prey found, tag it on contact */
+    OP_YIELD,       /* done for this frame */
+    OP_JUMP,        /* addr */
     OP_HALT
 };
 
-/* Memory helpers */
-static inline int16_t read16(uint32_t e, int o) { return *(int16_t*)(mem + e*COMP_SIZE + o); }
-static inline void write16(uint32_t e, int o, int16_t v) { *(int16_t*)(mem + e*COMP_SIZE + o) = v; }
-static inline uint8_t read8(uint32_t e, int o) { return mem[e*COMP_SIZE + o]; }
-static inline void write8(uint32_t e, int o, uint8_t v) { mem[e*COMP_SIZE + o] = v; }
+/* Bytecode task: one per entity, each running a script */
+typedef struct {
+    const uint8_t *code;
+    uint32_t pc;
+    uint32_t entity;
+    uint32_t scan;     /* next entity to look at */
+    int32_t best;      /* nearest prey so far, -1 if none */
+    int32_t best_dist;
+    uint8_t yielded;   /* reached OP_YIELD this frame */
+    uint8_t halted;
+} Task;
+
+static Task tasks[MAX_ENTITIES];
+static uint32_t next_task = 0;
 
 /* Game Systems (called by VM) */
 static void sys_input(uint32_t entity) {
@@ -57,151 +70,196 @@ static void sys_input(uint32_t entity) {
         return;
     }
     switch (ch) {
-        case KEY_UP:    write16(entity, OFF_DX, 0); write16(entity, OFF_DY, -1); break;
-        case KEY_DOWN:  write16(entity, OFF_DX, 0); write16(entity, OFF_DY,  1); break;
-        case KEY_LEFT:  write16(entity, OFF_DX, -1); write16(entity, OFF_DY, 0); break;
-        case KEY_RIGHT: write16(entity, OFF_DX, 1); write16(entity, OFF_DY, 0); break;
+        case KEY_UP:    comp.dx[entity] = 0;  comp.dy[entity] = -1; break;
+        case KEY_DOWN:  comp.dx[entity] = 0;  comp.dy[entity] =  1; break;
+        case KEY_LEFT:  comp.dx[entity] = -1; comp.dy[entity] =  0; break;
+        case KEY_RIGHT: comp.dx[entity] = 1;  comp.dy[entity] =  0; break;
     }
 }
 
 static void sys_ai(uint32_t entity) {
     if (rand() % 5 == 0) {
-        write16(entity, OFF_DX, (rand() % 3) - 1);
-        write16(entity, OFF_DY, (rand() % 3) - 1);
+        comp.dx[entity] = (rand() % 3) - 1;
+        comp.dy[entity] = (rand() % 3) - 1;
     }
 }
 
-static void sys_move(uint32_t entity) {
-    int16_t x = read16(entity, OFF_X);
-    int16_t y = read16(entity, OFF_Y);
-    x += read16(entity, OFF_DX);
-    y += read16(entity, OFF_DY);
-    write16(entity, OFF_X, x);
-    write16(entity, OFF_Y, y);
+static void sys_flash(uint32_t entity) {
+    if (comp.state[entity]) {
+        if (comp.timer[entity] > 0) {
+            comp.timer[entity]--;
+        } else {
+            comp.state[entity] = 0;
+        }
+    }
 }
 
-static void sys_clamp(uint32_t entity) {
-    int16_t x = read16(entity, OFF_X);
-    int16_t y = read16(entity, OFF_Y);
-    if (x < 0) x = 0;
-    if (x >= screen_w) x = screen_w - 1;
-    if (y < 0) y = 0;
-    if (y >= screen_h) y = screen_h - 1;
-    write16(entity, OFF_X, x);
-    write16(entity, OFF_Y, y);
+static void sys_scan(Task *t) {
+    uint32_t e = t->scan++;
+    if (comp.ai[e] != AI_WANDER || comp.state[e]) return;
+    int32_t dist = abs(comp.x[e] - comp.x[t->entity]) + abs(comp.y[e] - comp.y[t->entity]);
+    if (t->best < 0 || dist < t->best_dist) {
+        t->best = e;
+        t->best_dist = dist;
+    }
 }
 
-static void sys_flash(uint32_t entity) {
-    if (read8(entity, OFF_STATE)) {
-        uint8_t timer = read8(entity, OFF_TIMER);
-        if (timer > 0) {
-            write8(entity, OFF_TIMER, timer - 1);
-        } else {
-            write8(entity, OFF_STATE, 0);
+static int sign(int v) { return (v > 0) - (v < 0); }
+
+static void sys_steer(Task *t) {
+    uint32_t e = t->entity;
+    comp.dx[e] = comp.dy[e] = 0;
+    if (t->best >= 0) {
+        /* The scan may be frames old, so go by where the prey is now */
+        uint32_t prey = t->best;
+        int ddx = comp.x[prey] - comp.x[e];
+        int ddy = comp.y[prey] - comp.y[e];
+        if (abs(ddx) <= 1 && abs(ddy) <= 1) {
+            comp.state[prey] = 1;
+            comp.timer[prey] = 20;
         }
+        comp.dx[e] = sign(ddx);
+        comp.dy[e] = sign(ddy);
     }
+    t->scan = 0;
+    t->best = -1;
 }
 
-static void sys_render(void) {
+/* Move and clamp are sweeps over whole columns, not per-entity calls */
+static void sys_move(void) {
+    for (uint32_t e = 0; e < entity_count; e++) comp.x[e] += comp.dx[e];
+    for (uint32_t e = 0; e < entity_count; e++) comp.y[e] += comp.dy[e];
+}
+
+static void sys_clamp(void) {
+    for (uint32_t e = 0; e < entity_count; e++) {
+        int16_t x = comp.x[e];
+        comp.x[e] = x < 0 ? 0 : x >= screen_w ? screen_w - 1 : x;
+    }
+    for (uint32_t e = 0; e < entity_count; e++) {
+        int16_t y = comp.y[e];
+        comp.y[e] = y < 0 ? 0 : y >= screen_h ? screen_h - 1 : y;
+    }
+}
+
+static void sys_render(uint32_t executed) {
     clear();
-    for (int e = 0; e < MAX_ENTITIES; ++e) {
-        if (!read8(e, OFF_PLAYER) && !read8(e, OFF_AI)) continue;
-        char ch = read8(e, OFF_PLAYER) ? '@' : (read8(e, OFF_STATE) ? '*' : '#');
-        int y = read16(e, OFF_Y);
-        int x = read16(e, OFF_X);
+    for (uint32_t e = 0; e < entity_count; ++e) {
+        if (!comp.player[e] && !comp.ai[e]) continue;
+        char ch = comp.player[e] ? '@' : comp.ai[e] == AI_HUNT ? 'H' : (comp.state[e] ? '*' : '#');
+        int y = comp.y[e];
+        int x = comp.x[e];
         if (y >= 0 && y < screen_h && x >= 0 && x < screen_w) {
             mvaddch(y, x, ch);
         }
     }
+    mvprintw(0, 0, "%u entities, %u/%d instructions", entity_count, executed, FRAME_BUDGET);
     refresh();
 }
 
-/* VM Interpreter */
-static void vm_run(VM *vm) {
-    uint32_t pc = 0;
+/* VM Interpreter: run task t for at most budget instructions.
+   Returns the number executed; the task resumes at its pc next turn */
+static uint32_t vm_run(Task *t, uint32_t budget) {
+    uint32_t executed = 0;
     
-    while (pc < vm->len) {
-        uint8_t op = vm->code[pc++];
-        uint8_t entity;
+    while (executed < budget && !t->yielded && !t->halted) {
+        uint8_t op = t->code[t->pc++];
+        executed++;
         
         switch (op) {
             case OP_CALL_INPUT:
-                entity = vm->code[pc++];
-                sys_input(entity);
+                sys_input(t->entity);
                 break;
                 
             case OP_CALL_AI:
-                entity = vm->code[pc++];
-                sys_ai(entity);
+                sys_ai(t->entity);
                 break;
                 
-            case OP_CALL_MOVE:
-                entity = vm->code[pc++];
-                sys_move(entity);
+            case OP_CALL_FLASH:
+                sys_flash(t->entity);
                 break;
                 
-            case OP_CALL_CLAMP:
-                entity = vm->code[pc++];
-                sys_clamp(entity);
+            case OP_SCAN:
+                if (t->scan < entity_count) sys_scan(t);
                 break;
                 
-            case OP_CALL_FLASH:
-                entity = vm->code[pc++];
-                sys_flash(entity);
+            case OP_SCAN_LOOP:
+                if (t->scan < entity_count) t->pc = t->code[t->pc];
+                else t->pc++;
                 break;
                 
-            case OP_CALL_RENDER:
-                sys_render();
+            case OP_CALL_STEER:
+                sys_steer(t);
                 break;
                 
-            case OP_HALT:
-                return;
+            case OP_YIELD:
+                t->yielded = 1;
+                break;
+                
+            case OP_JUMP:
+                t->pc = t->code[t->pc];
+                break;
                 
-            default:
-                return; /* Unknown opcode, halt */
+            case OP_HALT:
+            default: /* Unknown opcode, halt */
+                t->halted = 1;
+                break;
         }
     }
+    return executed;
 }
 
-/* Build game bytecode */
-static void build_game_code(VM *vm) {
-    uint32_t i = 0;
-    
-    /* Handle player input */
-    vm->code[i++] = OP_CALL_INPUT;
-    vm->code[i++] = 0;  /* entity 0 = player */
-    
-    /* Update AI entities (1, 2, 3) */
-    for (int e = 1; e < 4; e++) {
-        vm->code[i++] = OP_CALL_AI;
-        vm->code[i++] = e;
-    }
-    
-    /* Update flash timers */
-    for (int e = 1; e < 4; e++) {
-        vm->code[i++] = OP_CALL_FLASH;
-        vm->code[i++] = e;
-    }
+/* Cooperative scheduler: give each task a slice in turn until every task
+   has yielded or the frame budget is spent. A task cut off mid-script
+   carries on next frame, and the round starts with the task after the
+   last one served, so a slow script delays only itself */
+static uint32_t schedule_frame(void) {
+    uint32_t budget = FRAME_BUDGET;
+    uint32_t idle = 0;
     
-    /* Move all entities (0=player, 1-3=AI) */
-    for (int e = 0; e < 4; e++) {
-        vm->code[i++] = OP_CALL_MOVE;
-        vm->code[i++] = e;
-    }
+    for (uint32_t e = 0; e < entity_count; e++) tasks[e].yielded = 0;
     
-    /* Clamp all entities to screen bounds */
-    for (int e = 0; e < 4; e++) {
-        vm->code[i++] = OP_CALL_CLAMP;
-        vm->code[i++] = e;
+    while (budget > 0 && idle < entity_count) {
+        Task *t = &tasks[next_task];
+        next_task = (next_task + 1) % entity_count;
+        if (t->yielded || t->halted) {
+            idle++;
+            continue;
+        }
+        idle = 0;
+        budget -= vm_run(t, budget < TASK_SLICE ? budget : TASK_SLICE);
     }
-    
-    /* Render everything */
-    vm->code[i++] = OP_CALL_RENDER;
-    
-    /* Halt (end of frame) */
-    vm->code[i++] = OP_HALT;
-    
-    vm->len = i;
+    return FRAME_BUDGET - budget;
+}
+
+/* Scripts */
+static const uint8_t player_code[] = {
+    OP_CALL_INPUT,
+    OP_YIELD,
+    OP_JUMP, 0
+};
+
+static const uint8_t wander_code[] = {
+    OP_CALL_AI,
+    OP_CALL_FLASH,
+    OP_YIELD,
+    OP_JUMP, 0
+};
+
+/* Looks at every entity before steering: one instruction per entity
+   plus the loop, so far more than a slice, and spread over frames */
+static const uint8_t hunt_code[] = {
+    OP_SCAN,          /* 0 */
+    OP_SCAN_LOOP, 0,
+    OP_CALL_STEER,
+    OP_YIELD,
+    OP_JUMP, 0
+};
+
+static uint32_t spawn(const uint8_t *code) {
+    uint32_t e = entity_count++;
+    tasks[e] = (Task){ .code = code, .entity = e, .best = -1 };
+    return e;
 }
 
 
@@ -217,26 +275,27 @@ int main(void) {
     getmaxyx(stdscr, screen_h, screen_w);
 
     /* Init player (entity 0) */
-    write16(0, OFF_X, screen_w/2); 
-    write16(0, OFF_Y, screen_h/2);
-    write8(0, OFF_PLAYER, 1);
-
-    /* Init AI entities (1, 2, 3) */
-    for (int i = 1; i < 4; ++i) {
-        write16(i, OFF_X, rand() % screen_w);
-        write16(i, OFF_Y, rand() % screen_h);
-        write16(i, OFF_DX, (rand() % 3) - 1);
-        write16(i, OFF_DY, (rand() % 3) - 1);
-        write8(i, OFF_AI, 1);
-    }
+    uint32_t p = spawn(player_code);
+    comp.x[p] = screen_w/2;
+    comp.y[p] = screen_h/2;
+    comp.player[p] = 1;
 
-    /* Build VM program */
-    VM vm = {0};
-    build_game_code(&vm);
+    /* Init AI entities */
+    for (int i = 0; i < WANDERERS + HUNTERS; ++i) {
+        uint32_t e = spawn(i < WANDERERS ? wander_code : hunt_code);
+        comp.x[e] = rand() % screen_w;
+        comp.y[e] = rand() % screen_h;
+        comp.dx[e] = (rand() % 3) - 1;
+        comp.dy[e] = (rand() % 3) - 1;
+        comp.ai[e] = i < WANDERERS ? AI_WANDER : AI_HUNT;
+    }
 
-    /* Game loop: run VM each frame */
+    /* Game loop: scheduled scripts, then the sweeping systems */
     while (!should_quit) {
-        vm_run(&vm);
+        uint32_t executed = schedule_frame();
+        sys_move();
+        sys_clamp();
+        sys_render(executed);
         napms(50);  /* ~20 FPS */
     }
 
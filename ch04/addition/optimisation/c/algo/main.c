@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <inttypes.h>
 #include "pico/stdlib.h"
 #include "display.h"
 
@@ -64,12 +65,106 @@ typedef struct {
 
 static spatial_cell_t grid[GRID_SIZE][GRID_SIZE];
 
+// Kept between frames: an invader is only moved between cells when
+// the cells it overlaps change, not cleared and rebuilt every frame
+typedef struct { int8_t x0, y0, x1, y1; } cell_range_t;  // x0 > x1: none
+
+static const cell_range_t NO_CELLS = {0, 0, -1, -1};
+static bool grid_valid = false;          // false: rebuild on next use
+static bool formation_moved = false;     // invaders moved or died
+static cell_range_t invader_cells[MAX_INVADERS];
+
+// Box around the alive invaders, tested before any of them
+static float formation_x, formation_y;
+static int formation_width, formation_height;
+
 // Collision check helper
 bool check_collision(float x1, float y1, int w1, int h1, 
                      float x2, float y2, int w2, int h2) {
     return (x1 < x2 + w2 && x1 + w1 > x2 && y1 < y2 + h2 && y1 + h1 > y2);
 }
 
+int clamp_cell(int c) {
+    return (c < 0) ? 0 : (c >= GRID_SIZE) ? GRID_SIZE - 1 : c;
+}
+
+// Positions are fractional, so a box reaches into the cell of x + w
+cell_range_t cells_for_box(float x, float y, int w, int h) {
+    float cell_width = (float)DISPLAY_WIDTH / GRID_SIZE;
+    float cell_height = (float)DISPLAY_HEIGHT / GRID_SIZE;
+    
+    cell_range_t r;
+    r.x0 = clamp_cell((int)(x / cell_width));
+    r.y0 = clamp_cell((int)(y / cell_height));
+    r.x1 = clamp_cell((int)((x + w) / cell_width));
+    r.y1 = clamp_cell((int)((y + h) / cell_height));
+    return r;
+}
+
+// Move invader i from the cells it was in to the cells it is in,
+// touching the grid only if they differ
+void grid_move_invader(int i, cell_range_t to) {
+    cell_range_t from = invader_cells[i];
+    if (from.x0 == to.x0 && from.y0 == to.y0 &&
+        from.x1 == to.x1 && from.y1 == to.y1) return;
+    
+    for (int cy = from.y0; cy <= from.y1; cy++) {
+        for (int cx = from.x0; cx <= from.x1; cx++) {
+            grid[cy][cx].invader_mask &= ~(1 << i);
+        }
+    }
+    for (int cy = to.y0; cy <= to.y1; cy++) {
+        for (int cx = to.x0; cx <= to.x1; cx++) {
+            grid[cy][cx].invader_mask |= (1 << i);
+        }
+    }
+    invader_cells[i] = to;
+}
+
+// Invaders die through here in both modes,
+// so the grid stays right when switching between them
+void kill_invader(int j) {
+    invaders[j].alive = false;
+    
+    if (grid_valid) {
+        grid_move_invader(j, NO_CELLS);
+        formation_moved = true;
+    }
+}
+
+void sync_grid(void) {
+    if (!grid_valid) {
+        memset(grid, 0, sizeof(grid));
+        for (int i = 0; i < MAX_INVADERS; i++) {
+            invader_cells[i] = NO_CELLS;
+        }
+        grid_valid = true;
+        formation_moved = true;
+    }
+    
+    if (!formation_moved) return;
+    
+    float x0 = DISPLAY_WIDTH, y0 = DISPLAY_HEIGHT, x1 = 0, y1 = 0;
+    
+    for (int i = 0; i < invader_count; i++) {
+        if (!invaders[i].alive) continue;
+        
+        invader_t* inv = &invaders[i];
+        grid_move_invader(i, cells_for_box(inv->x, inv->y, inv->width, inv->height));
+        
+        if (inv->x < x0) x0 = inv->x;
+        if (inv->y < y0) y0 = inv->y;
+        if (inv->x + inv->width > x1) x1 = inv->x + inv->width;
+        if (inv->y + inv->height > y1) y1 = inv->y + inv->height;
+    }
+    
+    formation_x = x0;
+    formation_y = y0;
+    formation_width = (x1 > x0) ? (int)(x1 - x0 + 1) : 0;
+    formation_height = (y1 > y0) ? (int)(y1 - y0 + 1) : 0;
+    formation_moved = false;
+}
+
 // SIMPLE collision detection (n^2 brute force)
 void collision_simple(void) {
     perf.collision_checks = 0;
@@ -87,7 +182,7 @@ void collision_simple(void) {
                               invaders[j].x, invaders[j].y, 
                               invaders[j].width, invaders[j].height)) {
                 bullets[i].active = false;
-                invaders[j].alive = false;
+                kill_invader(j);
                 break;
             }
         }
@@ -110,57 +205,38 @@ void collision_simple(void) {
 void collision_spatial_grid(void) {
     perf.collision_checks = 0;
     
-    // Clear grid
-    memset(grid, 0, sizeof(grid));
-    
-    float cell_width = (float)DISPLAY_WIDTH / GRID_SIZE;
-    float cell_height = (float)DISPLAY_HEIGHT / GRID_SIZE;
-    
-    // Populate grid with invaders
-    for (int i = 0; i < invader_count; i++) {
-        if (!invaders[i].alive) continue;
-        
-        int gx = (int)(invaders[i].x / cell_width);
-        int gy = (int)(invaders[i].y / cell_height);
-        
-        if (gx >= 0 && gx < GRID_SIZE && gy >= 0 && gy < GRID_SIZE) {
-            grid[gy][gx].invader_mask |= (1 << i);
-        }
-    }
+    sync_grid();
     
-    // Check bullets against nearby cells only
+    // Check bullets against the cells they are in only
     for (int i = 0; i < MAX_BULLETS; i++) {
         if (!bullets[i].active) continue;
         
-        int gx = (int)(bullets[i].x / cell_width);
-        int gy = (int)(bullets[i].y / cell_height);
+        // Nowhere near the formation: nothing to check
+        if (formation_width == 0 ||
+            !check_collision(bullets[i].x, bullets[i].y, 2, 4,
+                             formation_x, formation_y,
+                             formation_width, formation_height)) continue;
         
-        // Check current cell and 8 neighbors
-        for (int dy = -1; dy <= 1; dy++) {
-            for (int dx = -1; dx <= 1; dx++) {
-                int cx = gx + dx;
-                int cy = gy + dy;
-                
-                if (cx < 0 || cx >= GRID_SIZE || cy < 0 || cy >= GRID_SIZE) continue;
-                
-                uint16_t mask = grid[cy][cx].invader_mask;
-                
-                // Only check invaders in this cell
-                for (int j = 0; j < invader_count && mask; j++) {
-                    if (!(mask & (1 << j))) continue;
-                    if (!invaders[j].alive) continue;
-                    
-                    perf.collision_checks++;
-                    
-                    if (check_collision(bullets[i].x, bullets[i].y, 2, 4,
-                                      invaders[j].x, invaders[j].y,
-                                      invaders[j].width, invaders[j].height)) {
-                        bullets[i].active = false;
-                        invaders[j].alive = false;
-                        mask &= ~(1 << j);
-                        break;
-                    }
-                }
+        cell_range_t cells = cells_for_box(bullets[i].x, bullets[i].y, 2, 4);
+        uint16_t mask = 0;
+        for (int cy = cells.y0; cy <= cells.y1; cy++) {
+            for (int cx = cells.x0; cx <= cells.x1; cx++) {
+                mask |= grid[cy][cx].invader_mask;
+            }
+        }
+        
+        // Only check invaders in those cells
+        for (int j = 0; mask; j++, mask >>= 1) {
+            if (!(mask & 1)) continue;
+            
+            perf.collision_checks++;
+            
+            if (check_collision(bullets[i].x, bullets[i].y, 2, 4,
+                              invaders[j].x, invaders[j].y,
+                              invaders[j].width, invaders[j].height)) {
+                bullets[i].active = false;
+                kill_invader(j);
+                break;
             }
         }
     }
@@ -203,19 +279,19 @@ void render_performance_hud(void) {
     y += 10;
     
     // FPS
-    snprintf(buf, sizeof(buf), "FPS: %lu", perf.fps);
+    snprintf(buf, sizeof(buf), "FPS: %" PRIu32, perf.fps);
     uint16_t fps_color = (perf.fps >= 55) ? COLOR_GREEN : 
                         (perf.fps >= 30) ? COLOR_YELLOW : COLOR_RED;
     disp_framebuffer_draw_text(5, y, buf, fps_color, COLOR_BLACK);
     y += 10;
     
     // Collision checks this frame
-    snprintf(buf, sizeof(buf), "Checks: %lu", perf.collision_checks);
+    snprintf(buf, sizeof(buf), "Checks: %" PRIu32, perf.collision_checks);
     disp_framebuffer_draw_text(5, y, buf, COLOR_WHITE, COLOR_BLACK);
     y += 10;
     
     // Collision time
-    snprintf(buf, sizeof(buf), "Col: %lu us", perf.last_frame_time_us);
+    snprintf(buf, sizeof(buf), "Col: %" PRIu32 " us", perf.last_frame_time_us);
     disp_framebuffer_draw_text(5, y, buf, COLOR_YELLOW, COLOR_BLACK);
     y += 10;
     
@@ -235,7 +311,7 @@ void update_fps(void) {
         perf.last_fps_time = now;
         
         // Log to serial
-        printf("Mode: %s, FPS: %lu, Collision checks: %lu\n",
+        printf("Mode: %s, FPS: %" PRIu32 ", Collision checks: %" PRIu32 "\n",
                (collision_mode == COLLISION_SIMPLE) ? "SIMPLE" : "SPATIAL",
                perf.fps, perf.collision_checks);
     }
@@ -261,6 +337,7 @@ void init_game(void) {
     memset(bullets, 0, sizeof(bullets));
     memset(bombs, 0, sizeof(bombs));
     
+    grid_valid = false;
     perf.last_fps_time = time_us_32();
 }
 
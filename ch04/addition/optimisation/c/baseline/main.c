@@ -15,6 +15,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <inttypes.h>
 #include "pico/stdlib.h"
 #include "display.h"
 
@@ -519,7 +520,7 @@ void draw_ui(void) {
     char buffer[32];
     
     // FPS counter
-    snprintf(buffer, sizeof(buffer), "FPS: %lu", game.fps);
+    snprintf(buffer, sizeof(buffer), "FPS: %" PRIu32, game.fps);
     disp_framebuffer_draw_text(5, 5, buffer, COLOR_CYAN, COLOR_BLACK);
     
     // Game over / win messages
@@ -626,7 +627,7 @@ int main() {
             game.frame_count = 0;
             game.last_fps_time = now;
             
-            printf("FPS: %lu\n", game.fps);
+            printf("FPS: %" PRIu32 "\n", game.fps);
         }
         
         // Frame limiter (~60 FPS)
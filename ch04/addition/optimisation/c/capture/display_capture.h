@@ -0,0 +1,234 @@
+#ifndef DISPLAY_CAPTURE_H
+#define DISPLAY_CAPTURE_H
+
+// The display command stream: every disp_fill_rect(), disp_blit() and
+// disp_framebuffer_flush() with its arguments and the time it was
+// called, the windows they open, and a mark at each buttons_update(),
+// which the games call once a frame. display.c built with DISPLAY_CAPTURE
+// keeps the most recent of it in a ring in RAM, the host backend writes
+// all of it to a file, and replay.c plays it back through display.h, so
+// two versions of the driver can be timed on the same traffic.
+//
+// A stream is a header and the records, little-endian:
+//
+//   header  "DCAP" | version u8 | flags u8 | width u16 | height u16
+//   record  op u8 | time u32 (us, wraps) | fields u16... | [pixels]
+//
+//   CAPTURE_WINDOW  x0 y0 x1 y1             CASET/RASET, as set_window()
+//   CAPTURE_FILL    x y w h color           as called, before clipping
+//   CAPTURE_BLIT    x y w h | sum u32       [w * h pixels]
+//   CAPTURE_FLUSH   sum u32                 [width * height pixels]
+//   CAPTURE_FRAME   buttons u8              held, bit per button_t
+//
+// Pixels follow only when the op has CAPTURE_PIXELS set. Without them a
+// blit or a flush keeps the sum of its pixels (capture_sum()), enough to
+// tell frames apart, and a replay sends other pixels of the same size: the
+// bus does not care what they are. A record too big for the ring never
+// has them, so on the device a flush is always 9 bytes.
+//
+// Nothing here knows about the SDK: the caller passes the time in.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#define CAPTURE_MAGIC "DCAP"
+#define CAPTURE_VERSION 1
+#define CAPTURE_FILE_HEADER 10
+#define CAPTURE_FLAG_PIXELS 0x01    // the capture asked for pixels
+
+enum {
+    CAPTURE_WINDOW = 1,
+    CAPTURE_FILL,
+    CAPTURE_BLIT,
+    CAPTURE_FLUSH,
+    CAPTURE_FRAME,
+    CAPTURE_OPS
+};
+#define CAPTURE_PIXELS 0x80
+#define CAPTURE_OP(op) ((op) & 0x7F)
+
+#define CAPTURE_RECORD_MAX 17       // the longest record before its pixels
+
+// A record before its pixels
+typedef struct {
+    uint8_t bytes[CAPTURE_RECORD_MAX];
+    uint32_t size;
+} capture_record_t;
+
+// Bytes of a record of this op before its pixels; 0 for no such op
+static inline uint32_t capture_record_size(uint8_t op) {
+    static const uint8_t sizes[CAPTURE_OPS] = { 0, 13, 15, 17, 9, 6 };
+    op = CAPTURE_OP(op);
+    return op < CAPTURE_OPS ? sizes[op] : 0;
+}
+
+static inline uint16_t capture_get16(const uint8_t *p) {
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static inline uint32_t capture_get32(const uint8_t *p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+// Bytes of pixels after a record, from its first capture_record_size()
+// bytes
+static inline uint32_t capture_pixel_bytes(const uint8_t *record, uint16_t width, uint16_t height) {
+    if (!(record[0] & CAPTURE_PIXELS)) return 0;
+    switch (CAPTURE_OP(record[0])) {
+    case CAPTURE_BLIT:  return 2u * capture_get16(record + 9) * capture_get16(record + 11);
+    case CAPTURE_FLUSH: return 2u * width * height;
+    default:            return 0;
+    }
+}
+
+// A cheap mix of the pixels, one rotate and xor each
+static inline uint32_t capture_sum(const uint16_t *pixels, size_t count) {
+    uint32_t sum = 0x9E3779B9u;
+    for (size_t i = 0; i < count; i++) {
+        sum = ((sum << 5) | (sum >> 27)) ^ pixels[i];
+    }
+    return sum;
+}
+
+static inline void capture_add16(capture_record_t *r, uint16_t v) {
+    r->bytes[r->size++] = (uint8_t)v;
+    r->bytes[r->size++] = (uint8_t)(v >> 8);
+}
+
+static inline void capture_add32(capture_record_t *r, uint32_t v) {
+    capture_add16(r, (uint16_t)v);
+    capture_add16(r, (uint16_t)(v >> 16));
+}
+
+static inline capture_record_t capture_begin(uint8_t op, uint32_t now) {
+    capture_record_t r = { .bytes = { op }, .size = 1 };
+    capture_add32(&r, now);
+    return r;
+}
+
+// The records, blits and flushes with CAPTURE_PIXELS: whoever stores them
+// takes it off if the pixels are not to follow
+static inline capture_record_t capture_window(uint32_t now, uint16_t x0, uint16_t y0,
+                                              uint16_t x1, uint16_t y1) {
+    capture_record_t r = capture_begin(CAPTURE_WINDOW, now);
+    capture_add16(&r, x0); capture_add16(&r, y0);
+    capture_add16(&r, x1); capture_add16(&r, y1);
+    return r;
+}
+
+static inline capture_record_t capture_fill(uint32_t now, uint16_t x, uint16_t y,
+                                            uint16_t w, uint16_t h, uint16_t color) {
+    capture_record_t r = capture_begin(CAPTURE_FILL, now);
+    capture_add16(&r, x); capture_add16(&r, y);
+    capture_add16(&r, w); capture_add16(&r, h);
+    capture_add16(&r, color);
+    return r;
+}
+
+static inline capture_record_t capture_blit(uint32_t now, uint16_t x, uint16_t y,
+                                            uint16_t w, uint16_t h, const uint16_t *pixels) {
+    capture_record_t r = capture_begin(CAPTURE_BLIT | CAPTURE_PIXELS, now);
+    capture_add16(&r, x); capture_add16(&r, y);
+    capture_add16(&r, w); capture_add16(&r, h);
+    capture_add32(&r, capture_sum(pixels, (size_t)w * h));
+    return r;
+}
+
+static inline capture_record_t capture_flush(uint32_t now, const uint16_t *pixels, size_t count) {
+    capture_record_t r = capture_begin(CAPTURE_FLUSH | CAPTURE_PIXELS, now);
+    capture_add32(&r, capture_sum(pixels, count));
+    return r;
+}
+
+static inline capture_record_t capture_frame(uint32_t now, uint8_t buttons) {
+    capture_record_t r = capture_begin(CAPTURE_FRAME, now);
+    r.bytes[r.size++] = buttons;
+    return r;
+}
+
+static inline void capture_file_header(uint8_t out[CAPTURE_FILE_HEADER], uint8_t flags,
+                                       uint16_t width, uint16_t height) {
+    memcpy(out, CAPTURE_MAGIC, 4);
+    out[4] = CAPTURE_VERSION;
+    out[5] = flags;
+    out[6] = (uint8_t)width;
+    out[7] = (uint8_t)(width >> 8);
+    out[8] = (uint8_t)height;
+    out[9] = (uint8_t)(height >> 8);
+}
+
+// --- the ring ---
+
+// The newest records that fit in size bytes: a record that does not fit
+// pushes out the oldest ones, whole
+typedef struct {
+    uint8_t *buf;
+    uint32_t size;
+    uint32_t start, used;       // the oldest record, bytes held
+    uint16_t width, height;
+    uint32_t records;           // held now
+    uint32_t dropped;           // pushed out
+    bool pixels;                // keep the pixels of blits and flushes
+    bool on;
+} capture_ring_t;
+
+static inline void capture_ring_init(capture_ring_t *ring, uint8_t *buf, uint32_t size,
+                                     uint16_t width, uint16_t height) {
+    memset(ring, 0, sizeof(*ring));
+    ring->buf = buf;
+    ring->size = size;
+    ring->width = width;
+    ring->height = height;
+}
+
+static inline void capture_ring_clear(capture_ring_t *ring) {
+    ring->start = ring->used = 0;
+    ring->records = ring->dropped = 0;
+}
+
+// n bytes from offset into the held ones on
+static inline void capture_ring_read(const capture_ring_t *ring, uint32_t offset, void *out, uint32_t n) {
+    uint32_t at = (ring->start + offset) % ring->size;
+    uint32_t first = ring->size - at < n ? ring->size - at : n;
+    memcpy(out, ring->buf + at, first);
+    memcpy((uint8_t *)out + first, ring->buf, n - first);
+}
+
+static inline void capture_ring_write(capture_ring_t *ring, const void *in, uint32_t n) {
+    uint32_t at = (ring->start + ring->used) % ring->size;
+    uint32_t first = ring->size - at < n ? ring->size - at : n;
+    memcpy(ring->buf + at, in, first);
+    memcpy(ring->buf, (const uint8_t *)in + first, n - first);
+    ring->used += n;
+}
+
+static inline void capture_ring_drop_oldest(capture_ring_t *ring) {
+    uint8_t head[CAPTURE_RECORD_MAX];
+    capture_ring_read(ring, 0, head, 1);
+    uint32_t size = capture_record_size(head[0]);
+    capture_ring_read(ring, 0, head, size);
+    size += capture_pixel_bytes(head, ring->width, ring->height);
+    ring->start = (ring->start + size) % ring->size;
+    ring->used -= size;
+    ring->records--;
+    ring->dropped++;
+}
+
+// The record, and pixel_bytes of pixels if it has CAPTURE_PIXELS; the
+// flag is taken off when they are not wanted or would not fit
+static inline void capture_ring_put(capture_ring_t *ring, capture_record_t *r,
+                                    const void *pixels, uint32_t pixel_bytes) {
+    if (!ring->on) return;
+    if (!ring->pixels || r->size + pixel_bytes > ring->size / 2) {
+        r->bytes[0] &= ~CAPTURE_PIXELS;
+    }
+    if (!(r->bytes[0] & CAPTURE_PIXELS)) pixel_bytes = 0;
+    while (ring->size - ring->used < r->size + pixel_bytes) capture_ring_drop_oldest(ring);
+    capture_ring_write(ring, r->bytes, r->size);
+    if (pixel_bytes) capture_ring_write(ring, pixels, pixel_bytes);
+    ring->records++;
+}
+
+#endif // DISPLAY_CAPTURE_H
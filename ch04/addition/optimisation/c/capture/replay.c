@@ -0,0 +1,297 @@
+// Replay of a display command stream (see display_capture.h) through
+// display.h: on the host against display_host.c, or on the Pico against
+// display.c with the stream built in. The same drawing goes out again,
+// call for call, so a change to the driver can be timed on exactly the
+// traffic of the frames it is meant to make faster, without the game
+// and its input.
+//
+//   replay [-p] [-r n] capture       a file, or a serial log with a dump
+//
+// Back to back by default, which times the display calls and nothing
+// else; -p waits out the gaps between the calls as they were captured,
+// the game's own time, so the frames compare with the captured ones.
+// -r plays the stream n times.
+//
+// Each buttons_update() mark starts a frame. What comes before the
+// first is played but not timed.
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "display.h"
+#include "display_capture.h"
+
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+    uint16_t width, height;
+} stream_t;
+
+typedef struct {
+    uint32_t records[CAPTURE_OPS];
+    uint32_t with_pixels;       // blits and flushes
+    uint32_t bad_sums;
+    uint32_t frames;
+    size_t end;                 // of the last whole record
+} census_t;
+
+static uint16_t scratch[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+
+// --- reading ---
+
+static bool open_stream(stream_t *s, const uint8_t *data, size_t size) {
+    if (size < CAPTURE_FILE_HEADER || memcmp(data, CAPTURE_MAGIC, 4) != 0) {
+        printf("replay: not a capture\n");
+        return false;
+    }
+    if (data[4] != CAPTURE_VERSION) {
+        printf("replay: capture version %d, not %d\n", data[4], CAPTURE_VERSION);
+        return false;
+    }
+    s->width = capture_get16(data + 6);
+    s->height = capture_get16(data + 8);
+    if (s->width != DISPLAY_WIDTH || s->height != DISPLAY_HEIGHT) {
+        printf("replay: captured on a %dx%d display\n", s->width, s->height);
+        return false;
+    }
+    s->data = data + CAPTURE_FILE_HEADER;
+    s->size = size - CAPTURE_FILE_HEADER;
+    return true;
+}
+
+// The bytes of the record at at, pixels and all, or 0 if there is no
+// whole record there
+static size_t record_at(const stream_t *s, size_t at) {
+    if (at >= s->size) return 0;
+    size_t head = capture_record_size(s->data[at]);
+    if (head == 0 || s->size - at < head) return 0;
+    size_t total = head + capture_pixel_bytes(s->data + at, s->width, s->height);
+    return s->size - at < total ? 0 : total;
+}
+
+// Count the records, and check the pixels that came with them against
+// their sums
+static void take_census(const stream_t *s, census_t *c) {
+    memset(c, 0, sizeof(*c));
+    size_t at = 0, n;
+    for (; (n = record_at(s, at)) != 0; at += n) {
+        const uint8_t *r = s->data + at;
+        uint8_t op = CAPTURE_OP(r[0]);
+        c->records[op]++;
+        if (op == CAPTURE_FRAME) c->frames++;
+        if (!(r[0] & CAPTURE_PIXELS)) continue;
+        c->with_pixels++;
+
+        size_t head = capture_record_size(r[0]);
+        size_t count = (n - head) / 2;
+        memcpy(scratch, r + head, n - head);
+        if (capture_sum(scratch, count) != capture_get32(r + head - 4)) c->bad_sums++;
+    }
+    c->end = at;
+}
+
+// --- playing ---
+
+static void play_record(const uint8_t *r, size_t n) {
+    size_t head = capture_record_size(r[0]);
+    uint16_t x = capture_get16(r + 5), y = capture_get16(r + 7);
+    uint16_t w = capture_get16(r + 9), h = capture_get16(r + 11);
+
+    switch (CAPTURE_OP(r[0])) {
+    case CAPTURE_FILL:
+        disp_fill_rect(x, y, w, h, capture_get16(r + 13));
+        break;
+    case CAPTURE_BLIT:
+        // Copied out, as the stream keeps no alignment; without the
+        // pixels, whatever scratch holds, the same number of bytes
+        if (r[0] & CAPTURE_PIXELS) memcpy(scratch, r + head, n - head);
+        disp_blit(x, y, w, h, scratch);
+        break;
+    case CAPTURE_FLUSH:
+        if (!disp_get_framebuffer() && disp_framebuffer_alloc() != DISP_OK) break;
+        if (r[0] & CAPTURE_PIXELS) memcpy(disp_get_framebuffer(), r + head, n - head);
+        disp_framebuffer_flush();
+        break;
+    case CAPTURE_FRAME:
+        buttons_update();
+        break;
+    default:        // the windows come again with the calls that open them
+        break;
+    }
+}
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void print_times(const char *name, uint32_t *times, uint32_t count) {
+    if (count == 0) return;
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < count; i++) sum += times[i];
+    qsort(times, count, sizeof(*times), compare_u32);
+    printf("%-10s %7lu %7lu %7lu %7lu\n", name, (unsigned long)times[0],
+           (unsigned long)(sum / count), (unsigned long)times[count * 95 / 100],
+           (unsigned long)times[count - 1]);
+}
+
+// Play the stream repeats times; the frame times of each pass go into
+// replayed one after the other, those of the capture into captured
+static void replay(const stream_t *s, const census_t *c, int repeats, bool paced,
+                   uint32_t *captured, uint32_t *replayed) {
+    uint32_t frames = c->frames > 1 ? c->frames - 1 : 0;
+    for (int pass = 0; pass < repeats; pass++) {
+        uint32_t *times = replayed + (size_t)pass * frames;
+        uint32_t frame = 0, first = 0, start = time_us_32();
+        uint32_t frame_captured = 0, frame_replayed = 0;
+        bool in_frame = false;
+        for (size_t at = 0, n; at < c->end; at += n) {
+            const uint8_t *r = s->data + at;
+            n = record_at(s, at);
+            uint32_t t = capture_get32(r + 1);
+            if (at == 0) first = t;
+            if (paced) {
+                int32_t ahead = (int32_t)((t - first) - (time_us_32() - start));
+                if (ahead > 0) sleep_us((uint64_t)ahead);
+            }
+            if (CAPTURE_OP(r[0]) == CAPTURE_FRAME) {
+                uint32_t now = time_us_32();
+                if (in_frame) {
+                    if (pass == 0) captured[frame] = t - frame_captured;
+                    times[frame++] = now - frame_replayed;
+                }
+                in_frame = true;
+                frame_captured = t;
+                frame_replayed = now;
+            }
+            play_record(r, n);
+        }
+    }
+}
+
+static int run(const uint8_t *data, size_t size, int repeats, bool paced) {
+    stream_t s;
+    census_t c;
+    if (!open_stream(&s, data, size)) return 1;
+    take_census(&s, &c);
+    printf("replay: %lu fills, %lu blits, %lu flushes, %lu windows, %lu frame marks; "
+           "pixels with %lu of %lu blits and flushes\n",
+           (unsigned long)c.records[CAPTURE_FILL],
+           (unsigned long)c.records[CAPTURE_BLIT], (unsigned long)c.records[CAPTURE_FLUSH],
+           (unsigned long)c.records[CAPTURE_WINDOW], (unsigned long)c.frames,
+           (unsigned long)c.with_pixels,
+           (unsigned long)(c.records[CAPTURE_BLIT] + c.records[CAPTURE_FLUSH]));
+    if (c.end < s.size) printf("replay: %lu bytes at the end are no whole record\n",
+                               (unsigned long)(s.size - c.end));
+    if (c.bad_sums) printf("replay: %lu records do not match their sums\n", (unsigned long)c.bad_sums);
+
+    // Between n marks there are n - 1 whole frames
+    uint32_t frames = c.frames > 1 ? c.frames - 1 : 0;
+    uint32_t *captured = malloc((frames + 1) * sizeof(uint32_t));
+    uint32_t *replayed = malloc(((size_t)frames * repeats + 1) * sizeof(uint32_t));
+    if (!captured || !replayed) {
+        printf("replay: out of memory\n");
+        return 1;
+    }
+
+    disp_config_t config = disp_get_default_config();
+    if (disp_init(&config) != DISP_OK || buttons_init() != DISP_OK) {
+        printf("replay: display init failed\n");
+        return 1;
+    }
+    replay(&s, &c, repeats, paced, captured, replayed);
+
+    printf("%u frames, %d pass%s, %s\n", (unsigned)frames, repeats, repeats == 1 ? "" : "es",
+           paced ? "paced" : "back to back");
+    printf("%-10s %7s %7s %7s %7s\n", "frame us", "min", "avg", "p95", "max");
+    print_times("captured", captured, frames);
+    print_times("replayed", replayed, frames * (uint32_t)repeats);
+    free(captured);
+    free(replayed);
+    return 0;
+}
+
+#ifdef PICO_ON_DEVICE
+
+// The stream, from xxd -i capture.bin
+#include "capture_data.h"
+
+#ifndef REPLAY_REPEATS
+#define REPLAY_REPEATS 10
+#endif
+#ifndef REPLAY_PACED
+#define REPLAY_PACED false
+#endif
+
+int main(void) {
+    stdio_init_all();
+    sleep_ms(2000);     // time to open the serial port
+    run(capture_bin, capture_bin_len, REPLAY_REPEATS, REPLAY_PACED);
+    while (true) sleep_ms(1000);
+}
+
+#else
+
+// A binary capture as it is, or the lines of disp_capture_dump() picked
+// out of a serial log and turned back into bytes
+static uint8_t *load(const char *path, size_t *size) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long length = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *data = malloc(length > 0 ? (size_t)length + 1 : 1);
+    if (!data || fread(data, 1, (size_t)length, f) != (size_t)length) {
+        fclose(f);
+        free(data);
+        return NULL;
+    }
+    fclose(f);
+    *size = (size_t)length;
+    if (*size >= 4 && memcmp(data, CAPTURE_MAGIC, 4) == 0) return data;
+
+    // Hex is never longer than the text it came from
+    data[*size] = '\0';
+    size_t out = 0;
+    for (char *line = strtok((char *)data, "\r\n"); line; line = strtok(NULL, "\r\n")) {
+        char *hex = strstr(line, "capture: ");
+        if (!hex) continue;
+        hex += strlen("capture: ");
+        if (strcmp(hex, "end") == 0) break;
+        if (strspn(hex, "0123456789abcdef") != strlen(hex) || strlen(hex) % 2) continue;
+        for (; *hex; hex += 2) {
+            unsigned byte;
+            sscanf(hex, "%2x", &byte);
+            data[out++] = (uint8_t)byte;
+        }
+    }
+    *size = out;
+    return data;
+}
+
+int main(int argc, char **argv) {
+    int repeats = 1;
+    bool paced = false;
+    int i = 1;
+    for (; i < argc && argv[i][0] == '-'; i++) {
+        if (strcmp(argv[i], "-p") == 0) paced = true;
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) repeats = atoi(argv[++i]);
+        else break;
+    }
+    if (i != argc - 1 || repeats < 1) {
+        fprintf(stderr, "usage: %s [-p] [-r n] capture\n", argv[0]);
+        return 2;
+    }
+    size_t size;
+    uint8_t *data = load(argv[i], &size);
+    if (!data) {
+        fprintf(stderr, "replay: cannot read %s\n", argv[i]);
+        return 1;
+    }
+    int result = run(data, size, repeats, paced);
+    free(data);
+    return result;
+}
+
+#endif
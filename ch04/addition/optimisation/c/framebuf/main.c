@@ -11,8 +11,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <inttypes.h>
 #include "pico/stdlib.h"
 #include "display.h"
+#include "fbdma.h"
 
 // Game constants
 #define MAX_BULLETS 5
@@ -32,6 +34,7 @@ static uint32_t frame_count = 0;
 static uint32_t fps = 0;
 static uint32_t last_fps_time = 0;
 static uint32_t frame_time_us = 0;
+static bool fb_clearing = false;    // DMA clears the framebuffer for the next frame
 
 // Player
 typedef struct {
@@ -313,10 +316,10 @@ void render_direct(void) {
     
     // Draw UI
     char buf[64];
-    snprintf(buf, sizeof(buf), "DIRECT MODE - %lu FPS", fps);
+    snprintf(buf, sizeof(buf), "DIRECT MODE - %" PRIu32 " FPS", fps);
     disp_draw_text(5, 5, buf, COLOR_YELLOW, COLOR_BLACK);
     
-    snprintf(buf, sizeof(buf), "Frame: %lu us", frame_time_us);
+    snprintf(buf, sizeof(buf), "Frame: %" PRIu32 " us", frame_time_us);
     disp_draw_text(5, 15, buf, COLOR_YELLOW, COLOR_BLACK);
     
     disp_draw_text(5, 225, "Press Y to toggle mode", COLOR_CYAN, COLOR_BLACK);
@@ -334,8 +337,12 @@ void render_direct(void) {
 void render_framebuffer(void) {
     uint32_t start = time_us_32();
     
-    // Clear framebuffer - fast in-memory operation
-    disp_framebuffer_clear(COLOR_BLACK);
+    // Cleared by DMA since the last flush, or here the first time
+    if (fb_clearing) {
+        fbdma_wait();
+    } else {
+        disp_framebuffer_clear(COLOR_BLACK);
+    }
     
     // Draw player
     disp_framebuffer_fill_rect(player.x, player.y, player.width, player.height, COLOR_WHITE);
@@ -361,10 +368,10 @@ void render_framebuffer(void) {
     
     // Draw UI
     char buf[64];
-    snprintf(buf, sizeof(buf), "FRAMEBUFFER - %lu FPS", fps);
+    snprintf(buf, sizeof(buf), "FRAMEBUFFER - %" PRIu32 " FPS", fps);
     disp_framebuffer_draw_text(5, 5, buf, COLOR_YELLOW, COLOR_BLACK);
     
-    snprintf(buf, sizeof(buf), "Frame: %lu us", frame_time_us);
+    snprintf(buf, sizeof(buf), "Frame: %" PRIu32 " us", frame_time_us);
     disp_framebuffer_draw_text(5, 15, buf, COLOR_YELLOW, COLOR_BLACK);
     
     disp_framebuffer_draw_text(5, 225, "Press Y to toggle mode", COLOR_CYAN, COLOR_BLACK);
@@ -378,6 +385,11 @@ void render_framebuffer(void) {
     // Flush to display - ONE fast DMA transfer
     disp_framebuffer_flush();
     
+    // The flush is done with it: clear it for the next frame in the
+    // background, while the game updates
+    fbdma_fill(disp_get_framebuffer(), COLOR_BLACK, DISPLAY_WIDTH * DISPLAY_HEIGHT);
+    fb_clearing = true;
+    
     frame_time_us = time_us_32() - start;
 }
 
@@ -401,6 +413,9 @@ int main() {
         return 1;
     }
     
+    // A spare DMA channel for the clears; without one the CPU does them
+    fbdma_init();
+    
     init_game();
     
     printf("Space Invaders - Framebuffer Demo\n");
@@ -455,7 +470,7 @@ int main() {
             frame_count = 0;
             last_fps_time = now;
             
-            printf("FPS: %lu, Frame time: %lu us, Mode: %s\n", 
+            printf("FPS: %" PRIu32 ", Frame time: %" PRIu32 " us, Mode: %s\n", 
                    fps, frame_time_us,
                    current_mode == RENDER_DIRECT ? "DIRECT" : "FRAMEBUFFER");
         }
@@ -0,0 +1,567 @@
+// display.h on the host: the same calls as display.c, drawing into a
+// panel in memory, with the SPI traffic counted instead of sent and a
+// scripted clock and buttons (see display_host.h)
+#define _POSIX_C_SOURCE 199309L
+#include "display.h"
+#include "display_host.h"
+#include "display_capture.h"
+#include "pico/stdlib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+void disp_set_error_context(disp_error_t code, const char *f, int l, const char *m);
+
+static struct {
+    bool initialized;
+    bool dma_enabled;
+    disp_error_context_t last_error;
+    disp_config_t config;
+    uint16_t *framebuffer;
+    uint16_t panel[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+} g = {0};
+
+static display_host_stats_t stats;
+static uint64_t bus_bits;            // since the last whole microsecond
+static uint64_t bus_clock_us;        // as stats.bus_us, but never reset
+static uint64_t slept_us;
+static bool real_clock;
+static struct timespec host_start;
+
+// DISPLAY_HOST_CAPTURE: the whole stream, to a file
+static struct {
+    const char *path;
+    FILE *file;
+    bool pixels;
+    bool on;
+    uint64_t records, bytes;
+} capture;
+
+#define MAX_INPUT_LINES 4096
+#define QUIT 0xFF
+
+static struct {
+    uint64_t frame;
+    uint8_t buttons;            // bit per button_t, or QUIT
+} input[MAX_INPUT_LINES];
+static int input_count, input_next;
+static uint8_t held;
+static uint64_t frame_limit;
+
+static button_callback_t button_cb[BUTTON_COUNT] = {0};
+static bool btn_state[BUTTON_COUNT], btn_raw_state[BUTTON_COUNT];
+static uint32_t btn_debounce_time[BUTTON_COUNT];
+static bool btn_pressed[BUTTON_COUNT], btn_released[BUTTON_COUNT];
+static bool buttons_ready = false;
+
+#define DEBOUNCE_MS 50
+
+// Full 5×8 font (ASCII 32-127)
+static const uint8_t FONT_5X8[][5] = {
+    {0x00,0x00,0x00,0x00,0x00},{0x00,0x00,0x5F,0x00,0x00},{0x00,0x07,0x00,0x07,0x00},{0x14,0x7F,0x14,0x7F,0x14},
+    {0x24,0x2A,0x7F,0x2A,0x12},{0x23,0x13,0x08,0x64,0x62},{0x36,0x49,0x55,0x22,0x50},{0x00,0x05,0x03,0x00,0x00},
+    {0x00,0x1C,0x22,0x41,0x00},{0x00,0x41,0x22,0x1C,0x00},{0x08,0x2A,0x1C,0x2A,0x08},{0x08,0x08,0x3E,0x08,0x08},
+    {0x00,0x50,0x30,0x00,0x00},{0x08,0x08,0x08,0x08,0x08},{0x00,0x60,0x60,0x00,0x00},{0x20,0x10,0x08,0x04,0x02},
+    {0x3E,0x51,0x49,0x45,0x3E},{0x00,0x42,0x7F,0x40,0x00},{0x42,0x61,0x51,0x49,0x46},{0x21,0x41,0x45,0x4B,0x31},
+    {0x18,0x14,0x12,0x7F,0x10},{0x27,0x45,0x45,0x45,0x39},{0x3C,0x4A,0x49,0x49,0x30},{0x01,0x71,0x09,0x05,0x03},
+    {0x36,0x49,0x49,0x49,0x36},{0x06,0x49,0x49,0x29,0x1E},{0x00,0x36,0x36,0x00,0x00},{0x00,0x56,0x36,0x00,0x00},
+    {0x00,0x08,0x14,0x22,0x41},{0x14,0x14,0x14,0x14,0x14},{0x41,0x22,0x14,0x08,0x00},{0x02,0x01,0x51,0x09,0x06},
+    {0x32,0x49,0x79,0x41,0x3E},{0x7E,0x11,0x11,0x11,0x7E},{0x7F,0x49,0x49,0x49,0x36},{0x3E,0x41,0x41,0x41,0x22},
+    {0x7F,0x41,0x41,0x22,0x1C},{0x7F,0x49,0x49,0x49,0x41},{0x7F,0x09,0x09,0x01,0x01},{0x3E,0x41,0x41,0x51,0x32},
+    {0x7F,0x08,0x08,0x08,0x7F},{0x00,0x41,0x7F,0x41,0x00},{0x20,0x40,0x41,0x3F,0x01},{0x7F,0x08,0x14,0x22,0x41},
+    {0x7F,0x40,0x40,0x40,0x40},{0x7F,0x02,0x04,0x02,0x7F},{0x7F,0x04,0x08,0x10,0x7F},{0x3E,0x41,0x41,0x41,0x3E},
+    {0x7F,0x09,0x09,0x09,0x06},{0x3E,0x41,0x51,0x21,0x5E},{0x7F,0x09,0x19,0x29,0x46},{0x46,0x49,0x49,0x49,0x31},
+    {0x01,0x01,0x7F,0x01,0x01},{0x3F,0x40,0x40,0x40,0x3F},{0x1F,0x20,0x40,0x20,0x1F},{0x7F,0x20,0x18,0x20,0x7F},
+    {0x63,0x14,0x08,0x14,0x63},{0x03,0x04,0x78,0x04,0x03},{0x61,0x51,0x49,0x45,0x43},{0x00,0x00,0x7F,0x41,0x41},
+    {0x02,0x04,0x08,0x10,0x20},{0x41,0x41,0x7F,0x00,0x00},{0x04,0x02,0x01,0x02,0x04},{0x40,0x40,0x40,0x40,0x40},
+    {0x00,0x01,0x02,0x04,0x00},{0x20,0x54,0x54,0x54,0x78},{0x7F,0x48,0x44,0x44,0x38},{0x38,0x44,0x44,0x44,0x20},
+    {0x38,0x44,0x44,0x48,0x7F},{0x38,0x54,0x54,0x54,0x18},{0x08,0x7E,0x09,0x01,0x02},{0x08,0x14,0x54,0x54,0x3C},
+    {0x7F,0x08,0x04,0x04,0x78},{0x00,0x44,0x7D,0x40,0x00},{0x20,0x40,0x44,0x3D,0x00},{0x00,0x7F,0x10,0x28,0x44},
+    {0x00,0x41,0x7F,0x40,0x00},{0x7C,0x04,0x18,0x04,0x78},{0x7C,0x08,0x04,0x04,0x78},{0x38,0x44,0x44,0x44,0x38},
+    {0x7C,0x14,0x14,0x14,0x08},{0x08,0x14,0x14,0x18,0x7C},{0x7C,0x08,0x04,0x04,0x08},{0x48,0x54,0x54,0x54,0x20},
+    {0x04,0x3F,0x44,0x40,0x20},{0x3C,0x40,0x40,0x20,0x7C},{0x1C,0x20,0x40,0x20,0x1C},{0x3C,0x40,0x30,0x40,0x3C},
+    {0x44,0x28,0x10,0x28,0x44},{0x0C,0x50,0x50,0x50,0x3C},{0x44,0x64,0x54,0x4C,0x44},{0x00,0x08,0x36,0x41,0x00},
+    {0x00,0x00,0x7F,0x00,0x00},{0x00,0x41,0x36,0x08,0x00},{0x08,0x08,0x2A,0x1C,0x08},{0x08,0x1C,0x2A,0x08,0x08}
+};
+
+static const char* err_str[] = {
+    "OK","Already init","Not init","SPI fail","GPIO fail","Reset fail","Config fail",
+    "NULL ptr","Bad coords","Bad dims","DMA unavailable","DMA config","DMA timeout",
+    "Cmd failed","Data failed","Unknown"
+};
+
+void disp_set_error_context(disp_error_t code, const char *f, int l, const char *m) {
+    g.last_error.code = code; g.last_error.function = f;
+    g.last_error.line = l; g.last_error.message = m;
+}
+
+const char* disp_error_string(disp_error_t e) {
+    if (e >= sizeof(err_str)/sizeof(err_str[0])) return "???";
+    return err_str[e];
+}
+
+disp_error_context_t disp_get_last_error(void) { return g.last_error; }
+void disp_clear_error(void) { g.last_error.code = DISP_OK; }
+
+// --- clock ---
+
+static uint64_t host_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)(now.tv_sec - host_start.tv_sec) * 1000000u +
+           (uint64_t)(now.tv_nsec - host_start.tv_nsec) / 1000;
+}
+
+uint64_t time_us_64(void) {
+    return slept_us + bus_clock_us + (real_clock ? host_us() : 0);
+}
+
+void sleep_us(uint64_t us) { slept_us += us; }
+void sleep_ms(uint32_t ms) { slept_us += (uint64_t)ms * 1000; }
+
+// --- the bus ---
+
+// One chip select, as write_cmd(), write_data() and the fills of
+// display.c make them; with DMA if they would have used it
+static void transaction(bool command, size_t bytes, uint64_t dma_transfers) {
+    stats.transactions++;
+    if (command) stats.commands++;
+    stats.bytes += bytes;
+    stats.dma_transfers += dma_transfers;
+
+    uint32_t hz = g.config.spi_baudrate ? g.config.spi_baudrate : 1;
+    bus_bits += (uint64_t)bytes * 8 * 1000000u;
+    stats.bus_us += bus_bits / hz;
+    bus_clock_us += bus_bits / hz;
+    bus_bits %= hz;
+}
+
+// --- capture ---
+
+static void capture_open(void) {
+    capture.file = fopen(capture.path, "wb");
+    if (!capture.file) {
+        fprintf(stderr, "display_host: cannot write %s\n", capture.path);
+        return;
+    }
+    uint8_t header[CAPTURE_FILE_HEADER];
+    capture_file_header(header, capture.pixels ? CAPTURE_FLAG_PIXELS : 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    fwrite(header, 1, sizeof(header), capture.file);
+    capture.records = 0;
+    capture.bytes = sizeof(header);
+    capture.on = true;
+}
+
+static void capture_put(capture_record_t r, const void *pixels, size_t bytes) {
+    if (!capture.pixels) r.bytes[0] &= ~CAPTURE_PIXELS;
+    if (!(r.bytes[0] & CAPTURE_PIXELS)) bytes = 0;
+    fwrite(r.bytes, 1, r.size, capture.file);
+    if (bytes) fwrite(pixels, 1, bytes, capture.file);
+    capture.records++;
+    capture.bytes += r.size + bytes;
+}
+
+// The record is only made, and the pixels summed, while capturing
+#define CAPTURE(record, pixels, bytes) do { \
+    if (capture.on) capture_put((record), (pixels), (bytes)); \
+} while (0)
+
+// As display.c gives them: what was captured starts again, into the same
+// file; dump only makes sure it is all written
+void disp_capture_start(bool pixels) {
+    if (!capture.path) return;
+    if (capture.file) fclose(capture.file);
+    capture.pixels = pixels;
+    capture_open();
+}
+
+void disp_capture_stop(void) {
+    capture.on = false;
+}
+
+void disp_capture_dump(void) {
+    if (capture.file) fflush(capture.file);
+}
+
+// --- the bus, as display.c drives it ---
+
+static void write_cmd(void) { transaction(true, 1, 0); }
+
+static void write_data(size_t len) {
+    transaction(false, len, g.dma_enabled && len > 64);
+}
+
+static void set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    CAPTURE(capture_window(time_us_32(), x0, y0, x1, y1), NULL, 0);
+    write_cmd(); write_data(4);         // CASET
+    write_cmd(); write_data(4);         // RASET
+    write_cmd();                        // RAMWR
+}
+
+// --- core ---
+
+disp_config_t disp_get_default_config(void) {
+    return (disp_config_t){
+        .spi_baudrate = 62500000,
+        .use_dma = true,
+        .dma_timeout_ms = 1000,
+        .enable_backlight = true
+    };
+}
+
+static void host_exit(void) {
+    const char *path = getenv("DISPLAY_HOST_PPM");
+    if (path) {
+        FILE *f = fopen(path, "wb");
+        if (f) {
+            fprintf(f, "P6\n%d %d\n255\n", DISPLAY_WIDTH, DISPLAY_HEIGHT);
+            for (int i = 0; i < DISPLAY_WIDTH * DISPLAY_HEIGHT; i++) {
+                uint16_t c = g.panel[i];
+                uint8_t rgb[3] = {
+                    (uint8_t)((c >> 11) * 255 / 31),
+                    (uint8_t)(((c >> 5) & 0x3F) * 255 / 63),
+                    (uint8_t)((c & 0x1F) * 255 / 31)
+                };
+                fwrite(rgb, 1, 3, f);
+            }
+            fclose(f);
+        }
+    }
+    if (capture.file) fclose(capture.file);
+    const char *quiet = getenv("DISPLAY_HOST_QUIET");
+    if (!quiet || !*quiet || *quiet == '0') display_host_report();
+}
+
+disp_error_t disp_init(const disp_config_t *cfg) {
+    if (g.initialized) return DISP_ERROR(DISP_ERR_ALREADY_INIT, "already init");
+    g.config = cfg ? *cfg : disp_get_default_config();
+
+    static bool started;
+    if (!started) {
+        started = true;
+        clock_gettime(CLOCK_MONOTONIC, &host_start);
+        const char *clock = getenv("DISPLAY_HOST_CLOCK");
+        real_clock = clock && strcmp(clock, "real") == 0;
+        const char *frames = getenv("DISPLAY_HOST_FRAMES");
+        if (frames) frame_limit = strtoull(frames, NULL, 10);
+        capture.path = getenv("DISPLAY_HOST_CAPTURE");
+        const char *pixels = getenv("DISPLAY_HOST_CAPTURE_PIXELS");
+        capture.pixels = pixels && *pixels && *pixels != '0';
+        if (capture.path) capture_open();
+        atexit(host_exit);
+    }
+
+    // The reset and the init sequence of display.c, with its waits
+    sleep_ms(20 + 150);
+    write_cmd(); sleep_ms(150);         // software reset
+    write_cmd(); sleep_ms(255);         // sleep out
+    write_cmd(); write_data(1);         // pixel format
+    write_cmd(); write_data(1);         // MADCTL
+    write_cmd();                        // inversion on
+    write_cmd();                        // normal mode
+    write_cmd(); sleep_ms(100);         // display on
+
+    g.dma_enabled = g.config.use_dma;
+    g.initialized = true;
+    return DISP_OK;
+}
+
+disp_error_t disp_deinit(void) {
+    if (!g.initialized) return DISP_ERROR(DISP_ERR_NOT_INIT, "not init");
+    disp_framebuffer_free();
+    g.dma_enabled = false;
+    g.initialized = false;
+    return DISP_OK;
+}
+
+bool disp_is_initialized(void) { return g.initialized; }
+
+disp_error_t disp_clear(uint16_t color) {
+    return disp_fill_rect(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, color);
+}
+
+disp_error_t disp_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+    if (!g.initialized) return DISP_ERROR(DISP_ERR_NOT_INIT, "not init");
+    CAPTURE(capture_fill(time_us_32(), x, y, w, h, color), NULL, 0);
+    if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISP_ERROR(DISP_ERR_INVALID_COORDS, "bad pos");
+    if (x + w > DISPLAY_WIDTH)  w = DISPLAY_WIDTH  - x;
+    if (y + h > DISPLAY_HEIGHT) h = DISPLAY_HEIGHT - y;
+    if (w == 0 || h == 0) return DISP_OK;
+
+    set_window(x, y, x + w - 1, y + h - 1);
+    uint32_t pixels = (uint32_t)w * h;
+    transaction(false, pixels * 2, g.dma_enabled && pixels > 32 ? pixels / 256 : 0);
+
+    for (uint16_t dy = 0; dy < h; dy++) {
+        uint16_t *row = &g.panel[(y + dy) * DISPLAY_WIDTH + x];
+        for (uint16_t dx = 0; dx < w; dx++) row[dx] = color;
+    }
+    return DISP_OK;
+}
+
+disp_error_t disp_draw_pixel(uint16_t x, uint16_t y, uint16_t color) {
+    return disp_fill_rect(x, y, 1, 1, color);
+}
+
+disp_error_t disp_blit(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *pixels) {
+    if (!g.initialized) return DISP_ERROR(DISP_ERR_NOT_INIT, "not init");
+    if (!pixels) return DISP_ERROR(DISP_ERR_NULL_POINTER, "null");
+    CAPTURE(capture_blit(time_us_32(), x, y, w, h, pixels), pixels, (size_t)w * h * 2);
+    if (x + w > DISPLAY_WIDTH || y + h > DISPLAY_HEIGHT) return DISP_ERROR(DISP_ERR_INVALID_COORDS, "bad size");
+    set_window(x, y, x + w - 1, y + h - 1);
+    write_data((size_t)w * h * 2);
+    for (uint16_t dy = 0; dy < h; dy++) {
+        memcpy(&g.panel[(y + dy) * DISPLAY_WIDTH + x], pixels + (size_t)dy * w, w * sizeof(uint16_t));
+    }
+    return DISP_OK;
+}
+
+disp_error_t disp_draw_char(uint16_t x, uint16_t y, char c, uint16_t fg, uint16_t bg) {
+    if (c < 32 || c > 127) c = ' ';
+    const uint8_t *glyph = FONT_5X8[c - 32];
+    for (int col = 0; col < 5 && x + col < DISPLAY_WIDTH; col++) {
+        uint8_t line = glyph[col];
+        for (int row = 0; row < 8 && y + row < DISPLAY_HEIGHT; row++) {
+            uint16_t colr = (line & (1 << row)) ? fg : bg;
+            disp_draw_pixel(x + col, y + row, colr);
+        }
+    }
+    return DISP_OK;
+}
+
+disp_error_t disp_draw_text(uint16_t x, uint16_t y, const char *txt, uint16_t fg, uint16_t bg) {
+    while (*txt && x < DISPLAY_WIDTH) {
+        disp_draw_char(x, y, *txt++, fg, bg);
+        x += 6;
+    }
+    return DISP_OK;
+}
+
+disp_error_t disp_set_backlight(bool on) {
+    (void)on;
+    return DISP_OK;
+}
+
+// Every transfer is done when its call returns
+disp_error_t disp_wait_complete(uint32_t ms) {
+    (void)ms;
+    return DISP_OK;
+}
+
+// --- framebuffer ---
+
+disp_error_t disp_framebuffer_alloc(void) {
+    if (g.framebuffer) return DISP_OK;
+    g.framebuffer = calloc(DISPLAY_WIDTH * DISPLAY_HEIGHT, sizeof(uint16_t));
+    if (!g.framebuffer) return DISP_ERROR(DISP_ERR_NULL_POINTER, "framebuffer alloc failed");
+    return DISP_OK;
+}
+
+void disp_framebuffer_free(void) {
+    free(g.framebuffer);
+    g.framebuffer = NULL;
+}
+
+uint16_t* disp_get_framebuffer(void) {
+    return g.framebuffer;
+}
+
+disp_error_t disp_framebuffer_clear(uint16_t color) {
+    if (!g.framebuffer) return DISP_ERROR(DISP_ERR_NULL_POINTER, "no framebuffer");
+    for (uint32_t i = 0; i < DISPLAY_WIDTH * DISPLAY_HEIGHT; i++) g.framebuffer[i] = color;
+    return DISP_OK;
+}
+
+void disp_framebuffer_set_pixel(uint16_t x, uint16_t y, uint16_t color) {
+    if (!g.framebuffer || x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return;
+    g.framebuffer[y * DISPLAY_WIDTH + x] = color;
+}
+
+disp_error_t disp_framebuffer_flush(void) {
+    if (!g.initialized) return DISP_ERROR(DISP_ERR_NOT_INIT, "not init");
+    if (!g.framebuffer) return DISP_ERROR(DISP_ERR_NULL_POINTER, "no framebuffer");
+    CAPTURE(capture_flush(time_us_32(), g.framebuffer, DISPLAY_WIDTH * DISPLAY_HEIGHT),
+            g.framebuffer, sizeof(g.panel));
+    set_window(0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1);
+    write_data(DISPLAY_WIDTH * DISPLAY_HEIGHT * 2);
+    memcpy(g.panel, g.framebuffer, sizeof(g.panel));
+    stats.flushes++;
+    return DISP_OK;
+}
+
+void disp_framebuffer_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+    if (!g.framebuffer) return;
+    if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return;
+    if (x + w > DISPLAY_WIDTH) w = DISPLAY_WIDTH - x;
+    if (y + h > DISPLAY_HEIGHT) h = DISPLAY_HEIGHT - y;
+    for (uint16_t dy = 0; dy < h; dy++) {
+        for (uint16_t dx = 0; dx < w; dx++) {
+            g.framebuffer[(y + dy) * DISPLAY_WIDTH + (x + dx)] = color;
+        }
+    }
+}
+
+void disp_framebuffer_draw_char(uint16_t x, uint16_t y, char c, uint16_t fg, uint16_t bg) {
+    if (!g.framebuffer) return;
+    if (c < 32 || c > 127) c = ' ';
+    const uint8_t *glyph = FONT_5X8[c - 32];
+    for (int col = 0; col < 5 && x + col < DISPLAY_WIDTH; col++) {
+        uint8_t line = glyph[col];
+        for (int row = 0; row < 8 && y + row < DISPLAY_HEIGHT; row++) {
+            uint16_t color = (line & (1 << row)) ? fg : bg;
+            g.framebuffer[(y + row) * DISPLAY_WIDTH + (x + col)] = color;
+        }
+    }
+}
+
+void disp_framebuffer_draw_text(uint16_t x, uint16_t y, const char *txt, uint16_t fg, uint16_t bg) {
+    if (!g.framebuffer || !txt) return;
+    while (*txt && x < DISPLAY_WIDTH) {
+        disp_framebuffer_draw_char(x, y, *txt++, fg, bg);
+        x += 6;
+    }
+}
+
+// --- buttons ---
+
+bool display_host_load_input(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+    input_count = input_next = 0;
+    char line[128];
+    while (fgets(line, sizeof(line), f) && input_count < MAX_INPUT_LINES) {
+        char *hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+        unsigned long long frame;
+        char names[32];
+        if (sscanf(line, "%llu %31s", &frame, names) != 2) continue;
+        uint8_t buttons = 0;
+        if (strcmp(names, "quit") == 0) {
+            buttons = QUIT;
+        } else {
+            for (const char *p = names; *p; p++) {
+                const char *at = strchr("ABXY", *p);
+                if (at && *p) buttons |= 1u << (at - "ABXY");
+            }
+        }
+        input[input_count].frame = frame;
+        input[input_count].buttons = buttons;
+        input_count++;
+    }
+    fclose(f);
+    return true;
+}
+
+// What the script holds at frame, the current one
+static void read_script(void) {
+    while (input_next < input_count && input[input_next].frame <= stats.frames) {
+        if (input[input_next].buttons == QUIT) exit(0);
+        held = input[input_next].buttons;
+        input_next++;
+    }
+}
+
+disp_error_t buttons_init(void) {
+    if (buttons_ready) return DISP_OK;
+    const char *path = getenv("DISPLAY_HOST_INPUT");
+    if (path && !input_count && !display_host_load_input(path)) {
+        fprintf(stderr, "display_host: cannot read %s\n", path);
+    }
+    read_script();
+    uint32_t now = to_ms_since_boot(get_absolute_time());
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        bool raw = held & (1u << i);
+        btn_state[i] = raw;
+        btn_raw_state[i] = raw;
+        btn_pressed[i] = false;
+        btn_released[i] = false;
+        btn_debounce_time[i] = now;
+    }
+    buttons_ready = true;
+    return DISP_OK;
+}
+
+// The debouncing of display.c, on the script and the clock above
+void buttons_update(void) {
+    if (!buttons_ready) return;
+    if (frame_limit && stats.frames >= frame_limit) exit(0);
+    read_script();
+    stats.frames++;
+
+    uint32_t now = to_ms_since_boot(get_absolute_time());
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        bool current_raw = held & (1u << i);
+        btn_pressed[i] = false;
+        btn_released[i] = false;
+        if (current_raw != btn_raw_state[i]) {
+            btn_raw_state[i] = current_raw;
+            btn_debounce_time[i] = now;
+        }
+        if (now - btn_debounce_time[i] >= DEBOUNCE_MS && btn_raw_state[i] != btn_state[i]) {
+            bool old_state = btn_state[i];
+            btn_state[i] = btn_raw_state[i];
+            if (btn_state[i] && !old_state) {
+                btn_pressed[i] = true;
+                if (button_cb[i]) button_cb[i]((button_t)i);
+            } else if (!btn_state[i] && old_state) {
+                btn_released[i] = true;
+            }
+        }
+    }
+
+    uint8_t buttons = 0;
+    for (int i = 0; i < BUTTON_COUNT; i++) buttons |= (uint8_t)(btn_state[i] << i);
+    CAPTURE(capture_frame(time_us_32(), buttons), NULL, 0);
+}
+
+bool button_pressed(button_t b) {
+    return (b < BUTTON_COUNT) ? btn_state[b] : false;
+}
+
+bool button_just_pressed(button_t b) {
+    return (b < BUTTON_COUNT) ? btn_pressed[b] : false;
+}
+
+bool button_just_released(button_t b) {
+    return (b < BUTTON_COUNT) ? btn_released[b] : false;
+}
+
+disp_error_t button_set_callback(button_t b, button_callback_t cb) {
+    if (b >= BUTTON_COUNT) return DISP_ERROR(DISP_ERR_INVALID_DIMENSIONS, "invalid button");
+    button_cb[b] = cb;
+    return DISP_OK;
+}
+
+// --- host ---
+
+void display_host_get_stats(display_host_stats_t *s) {
+    *s = stats;
+}
+
+void display_host_reset_stats(void) {
+    uint64_t frames = stats.frames;     // the script goes by it
+    memset(&stats, 0, sizeof(stats));
+    stats.frames = frames;
+}
+
+const uint16_t *display_host_panel(void) {
+    return g.panel;
+}
+
+void display_host_report(void) {
+    double host_s = host_us() / 1e6;
+    fprintf(stderr, "display_host: %llu frames, %llu flushes in %.3f s on the host",
+            (unsigned long long)stats.frames, (unsigned long long)stats.flushes, host_s);
+    if (host_s > 0 && stats.frames) fprintf(stderr, ", %.0f frames/s", stats.frames / host_s);
+    fprintf(stderr, "\ndisplay_host: SPI %llu transactions (%llu commands, %llu DMA), "
+            "%llu bytes, %.3f s at %.1f MHz; clock at %.3f s\n",
+            (unsigned long long)stats.transactions, (unsigned long long)stats.commands,
+            (unsigned long long)stats.dma_transfers, (unsigned long long)stats.bytes,
+            stats.bus_us / 1e6, g.config.spi_baudrate / 1e6, time_us_64() / 1e6);
+    if (capture.path) {
+        fprintf(stderr, "display_host: captured %llu records, %llu bytes%s, to %s\n",
+                (unsigned long long)capture.records, (unsigned long long)capture.bytes,
+                capture.pixels ? " with pixels" : "", capture.path);
+    }
+}
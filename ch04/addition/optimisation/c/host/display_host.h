@@ -0,0 +1,54 @@
+#ifndef DISPLAY_HOST_H
+#define DISPLAY_HOST_H
+
+// What the host build of display.h adds for benchmarks and tests. A game
+// does not need any of it: it is configured from the environment, and
+// prints its report when the program exits.
+//
+//   DISPLAY_HOST_INPUT=file   buttons held, by frame (see below)
+//   DISPLAY_HOST_FRAMES=n     exit after n frames
+//   DISPLAY_HOST_CLOCK=real   add the host's own elapsed time to the clock
+//   DISPLAY_HOST_PPM=file     write the panel as a PPM image at exit
+//   DISPLAY_HOST_QUIET=1      no report
+//   DISPLAY_HOST_CAPTURE=file the display command stream, for replay
+//   DISPLAY_HOST_CAPTURE_PIXELS=1  with the pixels of blits and flushes
+//
+// A frame is one buttons_update(). An input file has a line for each
+// change, "frame buttons", where buttons are the letters of those held
+// (A, B, X, Y) or - for none, held from that frame on; "frame quit" ends
+// the program there. '#' starts a comment.
+//
+// The clock starts at 0 and moves by what the program sleeps, which
+// returns at once, and by the time the bytes it sent would have taken on
+// the SPI bus at the configured rate. So time_us_32() measures what the
+// frame would cost on the device for the display traffic, the same on
+// every run; DISPLAY_HOST_CLOCK=real adds the CPU time on this machine.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint64_t transactions;      // chip select low to high
+    uint64_t commands;          // transactions with DC low
+    uint64_t bytes;
+    uint64_t dma_transfers;     // as display.c would have started
+    uint64_t bus_us;            // bytes at the SPI clock
+    uint64_t flushes;
+    uint64_t frames;            // buttons_update() calls
+} display_host_stats_t;
+
+void display_host_get_stats(display_host_stats_t *stats);
+void display_host_reset_stats(void);
+
+// What the panel shows, DISPLAY_WIDTH x DISPLAY_HEIGHT pixels
+const uint16_t *display_host_panel(void);
+
+// Load an input script now instead of at buttons_init(); false if it
+// could not be read
+bool display_host_load_input(const char *path);
+
+// The report, on stderr
+void display_host_report(void);
+
+#endif // DISPLAY_HOST_H
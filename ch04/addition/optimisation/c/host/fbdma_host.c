@@ -0,0 +1,29 @@
+// fbdma.h on the host: there is no channel, so every call does the work
+// at once, as fbdma.c does when it has none. The pixels are no bus
+// traffic, so nothing is counted
+#include "fbdma.h"
+#include <string.h>
+
+bool fbdma_init(void) { return false; }
+void fbdma_deinit(void) {}
+bool fbdma_busy(void) { return false; }
+void fbdma_wait(void) {}
+
+void fbdma_fill(uint16_t *dst, uint16_t color, size_t count) {
+    for (size_t i = 0; i < count; i++) dst[i] = color;
+}
+
+void fbdma_copy(uint16_t *dst, const uint16_t *src, size_t count) {
+    memcpy(dst, src, count * sizeof(uint16_t));
+}
+
+void fbdma_fill_rect(uint16_t *fb, int stride, int x, int y, int w, int h, uint16_t color) {
+    for (int r = 0; r < h; r++) fbdma_fill(fb + (size_t)(y + r) * stride + x, color, w > 0 ? (size_t)w : 0);
+}
+
+void fbdma_copy_rect(uint16_t *dst, int dst_stride, const uint16_t *src, int src_stride,
+                     int w, int h) {
+    for (int r = 0; r < h; r++) {
+        fbdma_copy(dst + (size_t)r * dst_stride, src + (size_t)r * src_stride, w > 0 ? (size_t)w : 0);
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef PICO_STDLIB_H
+#define PICO_STDLIB_H
+
+// The little of the Pico SDK the games use, for the host build. The
+// clock is display_host.c's: sleeping advances it and returns at once
+// (see display_host.h)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+typedef uint64_t absolute_time_t;
+
+uint64_t time_us_64(void);
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+
+static inline uint32_t time_us_32(void) { return (uint32_t)time_us_64(); }
+static inline absolute_time_t get_absolute_time(void) { return time_us_64(); }
+static inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+static inline uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000); }
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) {
+    return (int64_t)(to - from);
+}
+
+static inline bool stdio_init_all(void) { return true; }
+static inline void tight_loop_contents(void) {}
+
+#endif // PICO_STDLIB_H
@@ -0,0 +1,2 @@
+// On the host the clock is in pico/stdlib.h with the rest
+#include "pico/stdlib.h"
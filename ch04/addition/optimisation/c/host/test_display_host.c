@@ -0,0 +1,144 @@
+// Host checks of display_host.c: drawing reaches the panel, the SPI
+// traffic is what display.c would send, the clock moves by sleeps and
+// bus time only, and scripted buttons come through the debouncing
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "display.h"
+#include "display_host.h"
+#include "display_capture.h"
+#include "pico/stdlib.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        printf("FAIL: " __VA_ARGS__); \
+        printf("\n"); \
+        failures++; \
+    } \
+} while (0)
+
+static uint16_t pixel(int x, int y) {
+    return display_host_panel()[y * DISPLAY_WIDTH + x];
+}
+
+static void test_drawing(void) {
+    display_host_stats_t s;
+    display_host_reset_stats();
+    disp_fill_rect(10, 20, 30, 40, COLOR_RED);
+    display_host_get_stats(&s);
+    CHECK(pixel(10, 20) == COLOR_RED && pixel(39, 59) == COLOR_RED, "fill_rect on the panel");
+    CHECK(pixel(40, 59) == 0 && pixel(39, 60) == 0, "fill_rect stays in its rectangle");
+    // CASET, 4 bytes, RASET, 4 bytes, RAMWR, then the pixels
+    CHECK(s.transactions == 6 && s.commands == 3, "fill_rect took %llu transactions",
+          (unsigned long long)s.transactions);
+    CHECK(s.bytes == 11 + 30 * 40 * 2, "fill_rect sent %llu bytes", (unsigned long long)s.bytes);
+    CHECK(s.dma_transfers == 30 * 40 / 256, "fill_rect made %llu DMA transfers",
+          (unsigned long long)s.dma_transfers);
+
+    uint16_t sprite[4] = { 1, 2, 3, 4 };
+    disp_blit(100, 100, 2, 2, sprite);
+    CHECK(pixel(100, 100) == 1 && pixel(101, 101) == 4, "blit on the panel");
+    CHECK(disp_blit(319, 0, 2, 1, sprite) == DISP_ERR_INVALID_COORDS, "blit off the edge");
+
+    disp_framebuffer_alloc();
+    disp_framebuffer_clear(COLOR_BLUE);
+    disp_framebuffer_draw_text(0, 0, "I", COLOR_WHITE, COLOR_BLUE);
+    CHECK(pixel(0, 0) == 0, "framebuffer drawing is not on the panel before the flush");
+    display_host_reset_stats();
+    uint32_t before = time_us_32();
+    disp_framebuffer_flush();
+    display_host_get_stats(&s);
+    CHECK(pixel(319, 239) == COLOR_BLUE && pixel(2, 1) == COLOR_WHITE, "flush copies the framebuffer");
+    CHECK(s.flushes == 1 && s.transactions == 6 && s.bytes == 11 + 320 * 240 * 2, "flush traffic");
+    // 153611 bytes at 62.5 MHz is 19662 us
+    CHECK(s.bus_us == 19662, "flush took %llu us on the bus", (unsigned long long)s.bus_us);
+    CHECK(time_us_32() - before == 19662, "the clock moved by %u us", time_us_32() - before);
+
+    before = time_us_32();
+    sleep_ms(16);
+    CHECK(time_us_32() - before == 16000, "sleep_ms(16) moved the clock by %u us",
+          time_us_32() - before);
+}
+
+static void test_buttons(void) {
+    const char *path = "test_display_host.input";
+    FILE *f = fopen(path, "w");
+    fprintf(f, "# held from frame 2 to 9\n2 AX\n10 -\n12 Y  # a press too short to count\n13 -\n");
+    fclose(f);
+    CHECK(display_host_load_input(path), "load %s", path);
+    remove(path);
+    buttons_init();
+
+    int pressed_at = -1, released_at = -1, y_pressed = 0;
+    for (int frame = 0; frame < 30; frame++) {
+        buttons_update();
+        if (button_just_pressed(BUTTON_A)) pressed_at = frame;
+        if (button_just_released(BUTTON_A)) released_at = frame;
+        y_pressed |= button_pressed(BUTTON_Y);
+        if (frame == 6) CHECK(button_pressed(BUTTON_X) && !button_pressed(BUTTON_B), "held at frame 6");
+        sleep_ms(16);
+    }
+    // 16 ms a frame: the 50 ms of debouncing take 4 frames
+    CHECK(pressed_at == 6, "A pressed at frame %d", pressed_at);
+    CHECK(released_at == 14, "A released at frame %d", released_at);
+    CHECK(!y_pressed, "a 16 ms press got through the debouncing");
+
+    display_host_stats_t s;
+    display_host_get_stats(&s);
+    CHECK(s.frames == 30, "%llu frames", (unsigned long long)s.frames);
+}
+
+// A fill, a blit and a frame mark, as display_capture.h has them
+static void test_capture(const char *path) {
+    disp_capture_start(true);
+    uint32_t at = time_us_32();
+    disp_fill_rect(1, 2, 3, 4, COLOR_GREEN);
+    uint16_t sprite[2] = { 0x1234, 0x5678 };
+    disp_blit(5, 6, 2, 1, sprite);
+    buttons_update();
+    disp_capture_dump();
+
+    uint8_t data[256];
+    FILE *f = fopen(path, "rb");
+    size_t size = f ? fread(data, 1, sizeof(data), f) : 0;
+    if (f) fclose(f);
+    // header, fill and its window, blit with its 4 bytes and its window,
+    // frame: each call is captured before the window it opens
+    CHECK(size == 10 + 13 + 15 + 13 + 17 + 4 + 6, "captured %zu bytes", size);
+    if (size != 10 + 13 + 15 + 13 + 17 + 4 + 6) return;
+    CHECK(memcmp(data, CAPTURE_MAGIC, 4) == 0 && data[5] == CAPTURE_FLAG_PIXELS, "header");
+
+    const uint8_t *fill = data + 10;
+    CHECK(fill[0] == CAPTURE_FILL && capture_get32(fill + 1) == at, "fill, at %u us", at);
+    CHECK(capture_get16(fill + 9) == 3 && capture_get16(fill + 13) == COLOR_GREEN, "fill fields");
+    const uint8_t *window = fill + 15;
+    CHECK(window[0] == CAPTURE_WINDOW && capture_get16(window + 9) == 3 &&
+          capture_get16(window + 11) == 5, "window of the fill");
+    const uint8_t *blit = window + 13;
+    CHECK(blit[0] == (CAPTURE_BLIT | CAPTURE_PIXELS), "blit with pixels");
+    CHECK(capture_get32(blit + 13) == capture_sum(sprite, 2), "blit sum");
+    CHECK(capture_pixel_bytes(blit, DISPLAY_WIDTH, DISPLAY_HEIGHT) == 4 &&
+          capture_get16(blit + 17) == 0x1234, "blit pixels");
+    CHECK(blit[34] == CAPTURE_FRAME && blit[39] == 0, "frame mark, no buttons held");
+}
+
+int main(void) {
+    const char *capture = "test_display_host.dcap";
+    setenv("DISPLAY_HOST_QUIET", "1", 1);
+    setenv("DISPLAY_HOST_CAPTURE", capture, 1);
+    CHECK(disp_fill_rect(0, 0, 1, 1, 0) == DISP_ERR_NOT_INIT, "drawing before disp_init");
+    CHECK(disp_init(NULL) == DISP_OK, "disp_init");
+    // 675 ms of waits, and 9 bytes of commands are 1 us on the bus
+    CHECK(time_us_32() == 675001, "init took %u us", time_us_32());
+    test_drawing();
+    test_buttons();
+    test_capture(capture);
+    disp_deinit();
+    remove(capture);
+
+    printf(failures ? "%d FAILED\n" : "all passed\n", failures);
+    return failures != 0;
+}
@@ -9,6 +9,10 @@
 #include <stdio.h>  // For debug prints
 #include <stdlib.h>
 
+#ifdef DISPLAY_CAPTURE
+#include "display_capture.h"
+#endif
+
 
 // Pins (Pimoroni Display Pack 2.0)
 #define PIN_CS    17
@@ -47,6 +51,24 @@ static bool buttons_ready = false;
 
 #define DEBOUNCE_MS 50  // 50ms debounce time
 
+// Capture (see display_capture.h): the last DISPLAY_CAPTURE_SIZE bytes
+// of the command stream, for disp_capture_dump()
+#ifdef DISPLAY_CAPTURE
+#ifndef DISPLAY_CAPTURE_SIZE
+#define DISPLAY_CAPTURE_SIZE (32 * 1024)
+#endif
+static uint8_t capture_buf[DISPLAY_CAPTURE_SIZE];
+static capture_ring_t capture;
+#define CAPTURE(record, pixels, bytes) do { \
+    if (capture.on) { \
+        capture_record_t r_ = (record); \
+        capture_ring_put(&capture, &r_, (pixels), (bytes)); \
+    } \
+} while (0)
+#else
+#define CAPTURE(record, pixels, bytes) ((void)0)
+#endif
+
 
 // Full 5×8 font (ASCII 32-127)
 static const uint8_t FONT_5X8[][5] = {
@@ -173,6 +195,7 @@ static disp_error_t write_data(const uint8_t *data, size_t len) {
 }
 
 static disp_error_t set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    CAPTURE(capture_window(time_us_32(), x0, y0, x1, y1), NULL, 0);
     uint8_t buf[4];
     write_cmd(0x2A); // CASET
     buf[0] = x0 >> 8; buf[1] = x0 & 0xFF; buf[2] = x1 >> 8; buf[3] = x1 & 0xFF;
@@ -270,6 +293,10 @@ disp_error_t disp_init(const disp_config_t *cfg) {
     }
 
     g.initialized = true;
+#ifdef DISPLAY_CAPTURE
+    capture_ring_init(&capture, capture_buf, sizeof(capture_buf), DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    capture.on = true;
+#endif
     printf("DEBUG: Display init successfully\n");
     return DISP_OK;
 }
@@ -293,6 +320,7 @@ disp_error_t disp_clear(uint16_t color) {
 
 disp_error_t disp_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
     if (!g.initialized) return DISP_ERROR(DISP_ERR_NOT_INIT, "not init");
+    CAPTURE(capture_fill(time_us_32(), x, y, w, h, color), NULL, 0);
     if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISP_ERROR(DISP_ERR_INVALID_COORDS, "bad pos");
     if (x + w > DISPLAY_WIDTH)  w = DISPLAY_WIDTH  - x;
     if (y + h > DISPLAY_HEIGHT) h = DISPLAY_HEIGHT - y;
@@ -348,6 +376,7 @@ disp_error_t disp_draw_pixel(uint16_t x, uint16_t y, uint16_t color) {
 disp_error_t disp_blit(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *pixels) {
     if (!g.initialized) return DISP_ERROR(DISP_ERR_NOT_INIT, "not init");
     if (!pixels) return DISP_ERROR(DISP_ERR_NULL_POINTER, "null");
+    CAPTURE(capture_blit(time_us_32(), x, y, w, h, pixels), pixels, (uint32_t)w * h * 2);
     if (x + w > DISPLAY_WIDTH || y + h > DISPLAY_HEIGHT) return DISP_ERROR(DISP_ERR_INVALID_COORDS, "bad size");
     set_window(x, y, x + w - 1, y + h - 1);
     return write_data((const uint8_t*)pixels, w * h * 2);
@@ -430,6 +459,8 @@ void disp_framebuffer_set_pixel(uint16_t x, uint16_t y, uint16_t color) {
 disp_error_t disp_framebuffer_flush(void) {
     if (!g.initialized) return DISP_ERROR(DISP_ERR_NOT_INIT, "not init");
     if (!g.framebuffer) return DISP_ERROR(DISP_ERR_NULL_POINTER, "no framebuffer");
+    CAPTURE(capture_flush(time_us_32(), g.framebuffer, DISPLAY_WIDTH * DISPLAY_HEIGHT),
+            g.framebuffer, DISPLAY_WIDTH * DISPLAY_HEIGHT * 2);
     
     // Send entire framebuffer to display in one operation
     set_window(0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1);
@@ -569,6 +600,12 @@ void buttons_update(void) {
             }
         }
     }
+
+#ifdef DISPLAY_CAPTURE
+    uint8_t held = 0;
+    for (int i = 0; i < BUTTON_COUNT; i++) held |= (uint8_t)(btn_state[i] << i);
+    CAPTURE(capture_frame(time_us_32(), held), NULL, 0);
+#endif
 }
 
 bool button_pressed(button_t b) {
@@ -591,3 +628,43 @@ disp_error_t button_set_callback(button_t b, button_callback_t cb) {
     button_cb[b] = cb;
     return DISP_OK;
 }
+
+// Capture
+#ifdef DISPLAY_CAPTURE
+void disp_capture_start(bool pixels) {
+    capture_ring_clear(&capture);
+    capture.pixels = pixels;
+    capture.on = true;
+}
+
+void disp_capture_stop(void) {
+    capture.on = false;
+}
+
+static void dump_line(const uint8_t *bytes, uint32_t n) {
+    printf("capture: ");
+    for (uint32_t i = 0; i < n; i++) printf("%02x", bytes[i]);
+    printf("\n");
+}
+
+// The stream as hex, the header and then 32 bytes a line, each line
+// "capture: ...", and "capture: end"; replay picks these lines out of
+// the rest of the log. Capturing stops while it runs, as printf() is slow
+void disp_capture_dump(void) {
+    bool on = capture.on;
+    capture.on = false;
+    printf("capture: %lu records, %lu dropped\n",
+           (unsigned long)capture.records, (unsigned long)capture.dropped);
+
+    uint8_t line[32];
+    capture_file_header(line, capture.pixels ? CAPTURE_FLAG_PIXELS : 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    dump_line(line, CAPTURE_FILE_HEADER);
+    for (uint32_t at = 0; at < capture.used; at += sizeof(line)) {
+        uint32_t n = capture.used - at < sizeof(line) ? capture.used - at : sizeof(line);
+        capture_ring_read(&capture, at, line, n);
+        dump_line(line, n);
+    }
+    printf("capture: end\n");
+    capture.on = on;
+}
+#endif
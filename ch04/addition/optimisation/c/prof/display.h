@@ -107,6 +107,13 @@ bool button_just_pressed(button_t button);
 bool button_just_released(button_t button);
 disp_error_t button_set_callback(button_t button, button_callback_t callback);
 
+// Capture of the command stream, with display.c built with
+// DISPLAY_CAPTURE (see display_capture.h). It starts at disp_init(),
+// without pixels; start clears what was kept
+void disp_capture_start(bool pixels);
+void disp_capture_stop(void);
+void disp_capture_dump(void);       // over stdio, for replay
+
 // Error handling
 const char* disp_error_string(disp_error_t error);
 disp_error_context_t disp_get_last_error(void);
@@ -13,17 +13,28 @@
  * - Game reset
  * 
  * Performance features:
- * - Press A to toggle: Simple vs Spatial Grid collision
+ * - Press A to step through the strategy combinations:
+ *   collision (Simple vs Spatial Grid), rendering (Framebuffer vs
+ *   Direct) and instrumentation (On vs Off)
  * - On-screen FPS, collision checks, frame time
  * - Compare algorithms in real-time
+ *
+ * Benchmark:
+ * - Hold A while the game boots (or set BENCHMARK_ON_BOOT) to run
+ *   every combination for BENCHMARK_FRAMES frames on the same
+ *   scripted input and random seed, then print the frame time
+ *   min/avg/p95/max of each over serial
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <math.h>
+#include <inttypes.h>
 #include "pico/stdlib.h"
 #include "display.h"
+#include "profiler.h"
 
 #define MAX_BULLETS 5
 #define MAX_BOMBS 15
@@ -41,8 +52,17 @@
 #define INVADER_SPEED 1.5f
 #define INVADER_DROP 10.0f
 
+#define BUNKER_WIDTH 30   // pixels, one bit each in a row mask
+#define BUNKER_HEIGHT 18
+#define BUNKER_ROW_MASK ((1u << BUNKER_WIDTH) - 1)
+
 #define GRID_SIZE 8  // Spatial grid: 8x8
 
+#define CAPTURE_SPIKE_US 40000  // with DISPLAY_CAPTURE: a frame this slow is dumped
+#define BENCHMARK_ON_BOOT 0     // 1 = always run the benchmark at start
+#define BENCHMARK_FRAMES 600    // frames per strategy combination
+#define BENCHMARK_SEED 1978     // same bombs for every combination
+
 typedef struct {
     float x, y;
     int width, height;
@@ -68,15 +88,26 @@ typedef struct {
 typedef struct {
     float x, y;
     int width, height;
-    uint8_t pixels[3][5];  // 3 rows, 5 cols (1=solid, 0=destroyed)
+    uint32_t rows[BUNKER_HEIGHT];  // bit c set = pixel in column c solid
 } bunker_t;
 
+// What a grid cell can hold, one bit per invader, bunker or the player
+typedef enum {
+    GRID_INVADERS,
+    GRID_BUNKERS,
+    GRID_PLAYER,
+    GRID_LAYERS
+} grid_layer_t;
+
 typedef struct {
-    uint16_t invader_mask;
-    uint16_t bullet_mask;
-    uint16_t bomb_mask;
+    uint16_t mask[GRID_LAYERS];
 } spatial_cell_t;
 
+// Cells a box overlaps, x0 > x1 when it is in none
+typedef struct {
+    int8_t x0, y0, x1, y1;
+} cell_range_t;
+
 
 // State
 static player_t player;
@@ -100,25 +131,40 @@ typedef enum {
 } collision_mode_t;
 
 static collision_mode_t collision_mode = COLLISION_SIMPLE;
+
+typedef enum {
+    RENDER_FRAMEBUFFER,
+    RENDER_DIRECT
+} render_mode_t;
+
+static render_mode_t render_mode = RENDER_FRAMEBUFFER;
+
+// Instrumentation: per-phase timers, on-screen HUD and serial log.
+// Off, only the frame itself is drawn, so the cost of measuring
+// can be measured too
+static bool instrumented = true;
 static spatial_cell_t spatial_grid[GRID_SIZE][GRID_SIZE];
 static float grid_cell_width, grid_cell_height;
 
+// The grid is kept between frames: an entity is only moved between
+// cells when the cells it overlaps change. Invaders move every
+// INVADER_MOVE_INTERVAL frames, bunkers never, so most frames only
+// the projectiles are looked up
+static bool grid_valid = false;          // false: rebuild on next use
+static bool formation_moved = false;     // invaders moved or died
+static cell_range_t invader_cells[MAX_INVADERS];
+static cell_range_t player_cells;
+
+// Box around the alive invaders, tested before any of them
+static float formation_x, formation_y;
+static int formation_width, formation_height;
+
 // Performance tracking
 typedef struct {
     uint32_t fps;
     uint32_t frame_count;
     uint32_t last_fps_time;
     
-    uint32_t frame_start_us;
-    uint32_t logic_start_us;
-    uint32_t collision_start_us;
-    uint32_t render_start_us;
-    
-    uint32_t frame_time_us;
-    uint32_t logic_time_us;
-    uint32_t collision_time_us;
-    uint32_t render_time_us;
-    
     uint32_t collision_checks;
     
     bool show_stats;
@@ -126,6 +172,14 @@ typedef struct {
 
 static perf_stats_t perf = {0};
 
+// One frame of player input, from the buttons or from the benchmark script
+typedef struct {
+    bool left;
+    bool right;
+    bool fire;
+    bool next_mode;
+} input_t;
+
 
 
 bool check_collision(float x1, float y1, int w1, int h1,
@@ -166,22 +220,21 @@ void init_invaders(void) {
 }
 
 void init_bunkers(void) {
-    // Bunker pattern: solid block with notch at bottom
-    uint8_t pattern[3][5] = {
-        {1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1},
-        {1, 0, 0, 0, 1}
-    };
-    
     for (int i = 0; i < MAX_BUNKERS; i++) {
         bunker_t* bunker = &bunkers[i];
         
         bunker->x = 60 + i * 100;
         bunker->y = DISPLAY_HEIGHT - 80;
-        bunker->width = 30;
-        bunker->height = 18;
+        bunker->width = BUNKER_WIDTH;
+        bunker->height = BUNKER_HEIGHT;
         
-        memcpy(bunker->pixels, pattern, sizeof(pattern));
+        // Solid block with notch at bottom: columns 6..23 of the last 6 rows
+        for (int row = 0; row < BUNKER_HEIGHT; row++) {
+            bunker->rows[row] = BUNKER_ROW_MASK;
+            if (row >= BUNKER_HEIGHT - 6) {
+                bunker->rows[row] &= ~(((1u << 18) - 1) << 6);
+            }
+        }
     }
 }
 
@@ -200,6 +253,7 @@ void init_game(void) {
     // Init spatial grid parameters
     grid_cell_width = (float)DISPLAY_WIDTH / GRID_SIZE;
     grid_cell_height = (float)DISPLAY_HEIGHT / GRID_SIZE;
+    grid_valid = false;
     
     perf.last_fps_time = time_us_32();
     perf.show_stats = true;
@@ -282,6 +336,7 @@ void update_invaders(void) {
             for (int i = 0; i < invader_count; i++) {
                 if (invaders[i].alive) {
                     invaders[i].y += INVADER_DROP;
+                    formation_moved = true;
                     
                     // Check if reached player
                     if (invaders[i].y + invaders[i].height >= player.y) {
@@ -294,6 +349,7 @@ void update_invaders(void) {
             for (int i = 0; i < invader_count; i++) {
                 if (invaders[i].alive) {
                     invaders[i].x += INVADER_SPEED * invader_direction;
+                    formation_moved = true;
                 }
             }
         }
@@ -308,7 +364,33 @@ void update_invaders(void) {
 }
 
 
-// Bunker
+// Bunker: each row a bitmask, so a test or a hit is a few ANDs
+// per row instead of a loop over pixels
+
+// Blast left by a hit, EXPLOSION_WIDTH bits wide, centred on the hit
+#define EXPLOSION_WIDTH 8
+#define EXPLOSION_HEIGHT 6
+static const uint8_t EXPLOSION_MASK[EXPLOSION_HEIGHT] = {
+    0x24,  // ..#..#..
+    0x7E,  // .######.
+    0xFF,  // ########
+    0xFF,  // ########
+    0x7E,  // .######.
+    0x24   // ..#..#..
+};
+
+// Bits for columns col .. col + width - 1, clipped to the bunker
+uint32_t column_mask(int col, int width) {
+    if (col < 0) {
+        width += col;
+        col = 0;
+    }
+    if (col + width > BUNKER_WIDTH) width = BUNKER_WIDTH - col;
+    if (width <= 0) return 0;
+    
+    return ((1u << width) - 1) << col;
+}
+
 bool check_bunker_collision(float px, float py, int pw, int ph, bunker_t* bunker) {
     // Bounding box check first
     if (!check_collision(px, py, pw, ph,
@@ -316,37 +398,140 @@ bool check_bunker_collision(float px, float py, int pw, int ph, bunker_t* bunker
         return false;
     }
     
-    // Pixel-perfect check
-    float pixel_width = bunker->width / 5.0f;
-    float pixel_height = bunker->height / 3.0f;
-    
-    int col = (int)((px + pw/2 - bunker->x) / pixel_width);
-    int row = (int)((py + ph/2 - bunker->y) / pixel_height);
+    // Pixel-perfect check: the projectile's columns against its rows
+    int col = (int)floorf(px - bunker->x);
+    int row = (int)floorf(py - bunker->y);
+    uint32_t mask = column_mask(col, pw);
     
-    if (row >= 0 && row < 3 && col >= 0 && col < 5) {
-        return bunker->pixels[row][col] == 1;
+    int row_end = (row + ph < BUNKER_HEIGHT) ? row + ph : BUNKER_HEIGHT;
+    for (int r = (row < 0) ? 0 : row; r < row_end; r++) {
+        if (bunker->rows[r] & mask) return true;
     }
     
     return false;
 }
 
 void damage_bunker(bunker_t* bunker, float hit_x, float hit_y) {
-    float pixel_width = bunker->width / 5.0f;
-    float pixel_height = bunker->height / 3.0f;
-    
-    int col = (int)((hit_x - bunker->x) / pixel_width);
-    int row = (int)((hit_y - bunker->y) / pixel_height);
-    
-    // Destroy 3x3 area around hit
-    for (int dr = -1; dr <= 1; dr++) {
-        for (int dc = -1; dc <= 1; dc++) {
-            int r = row + dr;
-            int c = col + dc;
-            if (r >= 0 && r < 3 && c >= 0 && c < 5) {
-                bunker->pixels[r][c] = 0;
-            }
+    int col = (int)floorf(hit_x - bunker->x) - EXPLOSION_WIDTH / 2;
+    int row = (int)floorf(hit_y - bunker->y) - EXPLOSION_HEIGHT / 2;
+    
+    for (int i = 0; i < EXPLOSION_HEIGHT; i++) {
+        int r = row + i;
+        if (r < 0 || r >= BUNKER_HEIGHT) continue;
+        
+        uint32_t blast = (col >= 0) ? (uint32_t)EXPLOSION_MASK[i] << col
+                                    : (uint32_t)EXPLOSION_MASK[i] >> -col;
+        bunker->rows[r] &= ~blast;
+    }
+}
+
+
+// Spatial grid
+static const cell_range_t NO_CELLS = {0, 0, -1, -1};
+
+int clamp_cell(int c) {
+    return (c < 0) ? 0 : (c >= GRID_SIZE) ? GRID_SIZE - 1 : c;
+}
+
+// Positions are fractional, so a box reaches into the cell of x + w
+cell_range_t cells_for_box(float x, float y, int w, int h) {
+    cell_range_t r;
+    r.x0 = clamp_cell((int)(x / grid_cell_width));
+    r.y0 = clamp_cell((int)(y / grid_cell_height));
+    r.x1 = clamp_cell((int)((x + w) / grid_cell_width));
+    r.y1 = clamp_cell((int)((y + h) / grid_cell_height));
+    return r;
+}
+
+// Move one entity's bit from the cells it was in to the cells it is in,
+// touching the grid only if they differ
+void grid_move(cell_range_t* cells, cell_range_t to, grid_layer_t layer, int bit) {
+    cell_range_t from = *cells;
+    if (from.x0 == to.x0 && from.y0 == to.y0 &&
+        from.x1 == to.x1 && from.y1 == to.y1) return;
+    
+    for (int cy = from.y0; cy <= from.y1; cy++) {
+        for (int cx = from.x0; cx <= from.x1; cx++) {
+            spatial_grid[cy][cx].mask[layer] &= ~(1 << bit);
+        }
+    }
+    for (int cy = to.y0; cy <= to.y1; cy++) {
+        for (int cx = to.x0; cx <= to.x1; cx++) {
+            spatial_grid[cy][cx].mask[layer] |= (1 << bit);
+        }
+    }
+    *cells = to;
+}
+
+// Everything in a layer over the cells of a range
+uint16_t grid_lookup(cell_range_t r, grid_layer_t layer) {
+    uint16_t mask = 0;
+    for (int cy = r.y0; cy <= r.y1; cy++) {
+        for (int cx = r.x0; cx <= r.x1; cx++) {
+            mask |= spatial_grid[cy][cx].mask[layer];
+        }
+    }
+    return mask;
+}
+
+// Invaders die through here in both modes,
+// so the grid stays right when switching between them
+void kill_invader(int j) {
+    invaders[j].alive = false;
+    score += (invaders[j].type == INVADER_TYPE_LARGE) ? 20 : 10;
+    
+    if (grid_valid) {
+        grid_move(&invader_cells[j], NO_CELLS, GRID_INVADERS, j);
+        formation_moved = true;
+    }
+}
+
+void sync_grid(void) {
+    if (!grid_valid) {
+        memset(spatial_grid, 0, sizeof(spatial_grid));
+        for (int i = 0; i < MAX_INVADERS; i++) {
+            invader_cells[i] = NO_CELLS;
+        }
+        player_cells = NO_CELLS;
+        
+        // Bunkers never move: placed once
+        for (int i = 0; i < MAX_BUNKERS; i++) {
+            cell_range_t cells = NO_CELLS;
+            grid_move(&cells, cells_for_box(bunkers[i].x, bunkers[i].y,
+                                           bunkers[i].width, bunkers[i].height),
+                      GRID_BUNKERS, i);
+        }
+        
+        grid_valid = true;
+        formation_moved = true;
+    }
+    
+    if (formation_moved) {
+        float x0 = DISPLAY_WIDTH, y0 = DISPLAY_HEIGHT, x1 = 0, y1 = 0;
+        
+        for (int i = 0; i < invader_count; i++) {
+            if (!invaders[i].alive) continue;
+            
+            invader_t* inv = &invaders[i];
+            grid_move(&invader_cells[i],
+                      cells_for_box(inv->x, inv->y, inv->width, inv->height),
+                      GRID_INVADERS, i);
+            
+            if (inv->x < x0) x0 = inv->x;
+            if (inv->y < y0) y0 = inv->y;
+            if (inv->x + inv->width > x1) x1 = inv->x + inv->width;
+            if (inv->y + inv->height > y1) y1 = inv->y + inv->height;
         }
+        
+        formation_x = x0;
+        formation_y = y0;
+        formation_width = (x1 > x0) ? (int)(x1 - x0 + 1) : 0;
+        formation_height = (y1 > y0) ? (int)(y1 - y0 + 1) : 0;
+        formation_moved = false;
     }
+    
+    grid_move(&player_cells, cells_for_box(player.x, player.y, player.width, player.height),
+              GRID_PLAYER, 0);
 }
 
 
@@ -367,8 +552,7 @@ void collision_simple(void) {
                               invaders[j].x, invaders[j].y,
                               invaders[j].width, invaders[j].height)) {
                 bullets[i].active = false;
-                invaders[j].alive = false;
-                score += (invaders[j].type == INVADER_TYPE_LARGE) ? 20 : 10;
+                kill_invader(j);
                 break;
             }
         }
@@ -431,68 +615,45 @@ void collision_simple(void) {
 
 
 // Collision (the spatial grid opt.)
+// Each projectile looks only at the cells its box is in
 void collision_spatial_grid(void) {
     perf.collision_checks = 0;
     
-    // Clear grid
-    memset(spatial_grid, 0, sizeof(spatial_grid));
+    sync_grid();
     
-    // Populate grid with invaders
-    for (int i = 0; i < invader_count; i++) {
-        if (!invaders[i].alive) continue;
-        
-        int gx = (int)(invaders[i].x / grid_cell_width);
-        int gy = (int)(invaders[i].y / grid_cell_height);
-        
-        if (gx >= 0 && gx < GRID_SIZE && gy >= 0 && gy < GRID_SIZE) {
-            spatial_grid[gy][gx].invader_mask |= (1 << i);
-        }
-    }
-    
-    // Bullet vs Invader (using spatial grid)
     for (int i = 0; i < MAX_BULLETS; i++) {
         if (!bullets[i].active) continue;
         
-        int gx = (int)(bullets[i].x / grid_cell_width);
-        int gy = (int)(bullets[i].y / grid_cell_height);
+        cell_range_t cells = cells_for_box(bullets[i].x, bullets[i].y, 2, 4);
         
-        // Check adjacent cells (3x3 area)
-        for (int dy = -1; dy <= 1; dy++) {
-            for (int dx = -1; dx <= 1; dx++) {
-                int cx = gx + dx;
-                int cy = gy + dy;
-                
-                if (cx < 0 || cx >= GRID_SIZE || cy < 0 || cy >= GRID_SIZE) continue;
+        // Bullet vs Invader, if it is near the formation at all
+        if (formation_width > 0 &&
+            check_collision(bullets[i].x, bullets[i].y, 2, 4,
+                            formation_x, formation_y,
+                            formation_width, formation_height)) {
+            uint16_t mask = grid_lookup(cells, GRID_INVADERS);
+            
+            for (int j = 0; mask; j++, mask >>= 1) {
+                if (!(mask & 1)) continue;
                 
-                uint16_t mask = spatial_grid[cy][cx].invader_mask;
+                perf.collision_checks++;
                 
-                for (int j = 0; j < invader_count && mask; j++) {
-                    if (!(mask & (1 << j))) continue;
-                    if (!invaders[j].alive) continue;
-                    
-                    perf.collision_checks++;
-                    
-                    if (check_collision(bullets[i].x, bullets[i].y, 2, 4,
-                                      invaders[j].x, invaders[j].y,
-                                      invaders[j].width, invaders[j].height)) {
-                        bullets[i].active = false;
-                        invaders[j].alive = false;
-                        score += (invaders[j].type == INVADER_TYPE_LARGE) ? 20 : 10;
-                        mask &= ~(1 << j);
-                        break;
-                    }
+                if (check_collision(bullets[i].x, bullets[i].y, 2, 4,
+                                  invaders[j].x, invaders[j].y,
+                                  invaders[j].width, invaders[j].height)) {
+                    bullets[i].active = false;
+                    kill_invader(j);
+                    break;
                 }
-                if (!bullets[i].active) break;
             }
-            if (!bullets[i].active) break;
+            if (!bullets[i].active) continue;
         }
-    }
-    
-    // Bullet vs Bunker (not affected by spatial grid for this simple case)
-    for (int i = 0; i < MAX_BULLETS; i++) {
-        if (!bullets[i].active) continue;
         
-        for (int j = 0; j < MAX_BUNKERS; j++) {
+        // Bullet vs Bunker
+        uint16_t mask = grid_lookup(cells, GRID_BUNKERS);
+        for (int j = 0; mask; j++, mask >>= 1) {
+            if (!(mask & 1)) continue;
+            
             perf.collision_checks++;
             
             if (check_bunker_collision(bullets[i].x, bullets[i].y, 2, 4, &bunkers[j])) {
@@ -503,23 +664,26 @@ void collision_spatial_grid(void) {
         }
     }
     
-    // Bomb vs Player
     for (int i = 0; i < MAX_BOMBS; i++) {
         if (!bombs[i].active) continue;
         
-        perf.collision_checks++;
+        cell_range_t cells = cells_for_box(bombs[i].x, bombs[i].y, 2, 4);
         
-        if (check_collision(bombs[i].x, bombs[i].y, 2, 4,
-                          player.x, player.y, player.width, player.height)) {
-            game_over = true;
+        // Bomb vs Player
+        if (grid_lookup(cells, GRID_PLAYER)) {
+            perf.collision_checks++;
+            
+            if (check_collision(bombs[i].x, bombs[i].y, 2, 4,
+                              player.x, player.y, player.width, player.height)) {
+                game_over = true;
+            }
         }
-    }
-    
-    // Bomb vs Bunker
-    for (int i = 0; i < MAX_BOMBS; i++) {
-        if (!bombs[i].active) continue;
         
-        for (int j = 0; j < MAX_BUNKERS; j++) {
+        // Bomb vs Bunker
+        uint16_t mask = grid_lookup(cells, GRID_BUNKERS);
+        for (int j = 0; mask; j++, mask >>= 1) {
+            if (!(mask & 1)) continue;
+            
             perf.collision_checks++;
             
             if (check_bunker_collision(bombs[i].x, bombs[i].y, 2, 4, &bunkers[j])) {
@@ -547,40 +711,82 @@ void collision_spatial_grid(void) {
 void update_game(void) {
     if (game_over || win) return;
     
-    perf.logic_start_us = time_us_32();
-    
-    update_projectiles();
-    update_invaders();
-    
-    perf.logic_time_us = time_us_32() - perf.logic_start_us;
+    PROF_ZONE("logic") {
+        update_projectiles();
+        update_invaders();
+    }
     
     // Collision detection with selected algorithm
-    perf.collision_start_us = time_us_32();
-    
-    if (collision_mode == COLLISION_SIMPLE) {
-        collision_simple();
-    } else {
-        collision_spatial_grid();
+    PROF_ZONE("collision") {
+        if (collision_mode == COLLISION_SIMPLE) {
+            collision_simple();
+        } else {
+            collision_spatial_grid();
+        }
     }
-    
-    perf.collision_time_us = time_us_32() - perf.collision_start_us;
 }
 
 
 
-void handle_input(void) {
+const char* mode_name(void) {
+    static char buf[32];
+    snprintf(buf, sizeof(buf), "%s/%s/%s",
+             (collision_mode == COLLISION_SIMPLE) ? "SIMPLE" : "SPATIAL",
+             (render_mode == RENDER_FRAMEBUFFER) ? "FB" : "DIRECT",
+             instrumented ? "PROF" : "BARE");
+    return buf;
+}
+
+// Step to the next of the eight strategy combinations,
+// collision changing fastest
+void next_mode(void) {
+    collision_mode = (collision_mode == COLLISION_SIMPLE) ?
+                     COLLISION_SPATIAL_GRID : COLLISION_SIMPLE;
+    if (collision_mode == COLLISION_SIMPLE) {
+        render_mode = (render_mode == RENDER_FRAMEBUFFER) ?
+                      RENDER_DIRECT : RENDER_FRAMEBUFFER;
+        if (render_mode == RENDER_FRAMEBUFFER) {
+            instrumented = !instrumented;
+            PROF_SET_ACTIVE(instrumented);
+        }
+    }
+}
+
+input_t read_buttons(void) {
     buttons_update();
     
+    input_t in;
+    in.left = button_pressed(BUTTON_B);
+    in.right = button_pressed(BUTTON_Y);
+    in.fire = button_just_pressed(BUTTON_X);
+    in.next_mode = button_just_pressed(BUTTON_A);
+    return in;
+}
+
+// Benchmark input: sweep across the screen and back,
+// firing every few frames (and so restarting after game over)
+input_t scripted_input(uint32_t frame) {
+    uint32_t phase = frame % 160;
+    
+    input_t in;
+    in.left = phase >= 80;
+    in.right = phase < 80;
+    in.fire = (frame % 10) == 0;
+    in.next_mode = false;
+    return in;
+}
+
+void handle_input(input_t in) {
     // Movement
-    if (button_pressed(BUTTON_B) && player.x > 0) {
+    if (in.left && player.x > 0) {
         player.x -= PLAYER_SPEED;
     }
-    if (button_pressed(BUTTON_Y) && player.x < DISPLAY_WIDTH - player.width) {
+    if (in.right && player.x < DISPLAY_WIDTH - player.width) {
         player.x += PLAYER_SPEED;
     }
     
     // Fire
-    if (button_just_pressed(BUTTON_X)) {
+    if (in.fire) {
         if (!game_over && !win) {
             fire_bullet();
         } else {
@@ -589,85 +795,123 @@ void handle_input(void) {
         }
     }
     
-    // Toggle collision mode
-    if (button_just_pressed(BUTTON_A)) {
-        collision_mode = (collision_mode == COLLISION_SIMPLE) ? 
-                         COLLISION_SPATIAL_GRID : COLLISION_SIMPLE;
-        printf("\n=== Switched to %s ===\n",
-               (collision_mode == COLLISION_SIMPLE) ? "SIMPLE" : "SPATIAL GRID");
+    // Switch strategy
+    if (in.next_mode) {
+        next_mode();
+        printf("\n=== Switched to %s ===\n", mode_name());
+    }
+}
+
+
+// Render: the same drawing to the framebuffer (flushed once per
+// frame by DMA) or straight to the display (one SPI window per call)
+void draw_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+    if (render_mode == RENDER_FRAMEBUFFER) {
+        disp_framebuffer_fill_rect(x, y, w, h, color);
+    } else {
+        disp_fill_rect(x, y, w, h, color);
     }
 }
 
+void draw_text(uint16_t x, uint16_t y, const char *text, uint16_t fg, uint16_t bg) {
+    if (render_mode == RENDER_FRAMEBUFFER) {
+        disp_framebuffer_draw_text(x, y, text, fg, bg);
+    } else {
+        disp_draw_text(x, y, text, fg, bg);
+    }
+}
 
-// Render
 void draw_invader(invader_t* inv) {
     if (!inv->alive) return;
     
     uint16_t color = (inv->type == INVADER_TYPE_LARGE) ? COLOR_RED : COLOR_GREEN;
     
     // Body
-    disp_framebuffer_fill_rect(inv->x, inv->y, inv->width, inv->height, color);
+    draw_rect(inv->x, inv->y, inv->width, inv->height, color);
     
     // Eyes
-    disp_framebuffer_fill_rect(inv->x + 4, inv->y + 3, 3, 3, COLOR_WHITE);
-    disp_framebuffer_fill_rect(inv->x + inv->width - 7, inv->y + 3, 3, 3, COLOR_WHITE);
+    draw_rect(inv->x + 4, inv->y + 3, 3, 3, COLOR_WHITE);
+    draw_rect(inv->x + inv->width - 7, inv->y + 3, 3, 3, COLOR_WHITE);
 }
 
+// Runs of set bits become spans, and rows with the same mask
+// are drawn together as one band of spans
 void draw_bunker(bunker_t* bunker) {
-    float pixel_width = bunker->width / 5.0f;
-    float pixel_height = bunker->height / 3.0f;
-    
-    for (int row = 0; row < 3; row++) {
-        for (int col = 0; col < 5; col++) {
-            if (bunker->pixels[row][col]) {
-                int px = bunker->x + col * pixel_width;
-                int py = bunker->y + row * pixel_height;
-                disp_framebuffer_fill_rect(px, py, pixel_width, pixel_height, COLOR_GREEN);
+    int row = 0;
+    
+    while (row < BUNKER_HEIGHT) {
+        uint32_t bits = bunker->rows[row];
+        int band = 1;
+        while (row + band < BUNKER_HEIGHT && bunker->rows[row + band] == bits) {
+            band++;
+        }
+        
+        int col = 0;
+        while (bits) {
+            // Skip the gap, then measure the run
+            while (!(bits & 1)) {
+                bits >>= 1;
+                col++;
+            }
+            int run = 0;
+            while (bits & 1) {
+                bits >>= 1;
+                run++;
             }
+            draw_rect(bunker->x + col, bunker->y + row, run, band, COLOR_GREEN);
+            col += run;
         }
+        
+        row += band;
     }
 }
 
+void draw_hud_text(uint16_t x, uint16_t y, const char *text, uint16_t color) {
+    draw_text(x, y, text, color, COLOR_BLACK);
+}
+
 void draw_performance_hud(void) {
-    if (!perf.show_stats) return;
+    if (!perf.show_stats || !instrumented) return;
     
     char buf[64];
     int y = 5;
     
     // Mode indicator
-    const char* mode = (collision_mode == COLLISION_SIMPLE) ? "SIMPLE" : "SPATIAL";
-    snprintf(buf, sizeof(buf), "%s", mode);
-    disp_framebuffer_draw_text(5, y, buf, COLOR_CYAN, COLOR_BLACK);
+    draw_text(5, y, mode_name(), COLOR_CYAN, COLOR_BLACK);
     y += 10;
     
     // FPS
-    snprintf(buf, sizeof(buf), "FPS:%lu", perf.fps);
+    snprintf(buf, sizeof(buf), "FPS:%" PRIu32, perf.fps);
     uint16_t fps_color = (perf.fps >= 55) ? COLOR_GREEN :
                         (perf.fps >= 30) ? COLOR_YELLOW : COLOR_RED;
-    disp_framebuffer_draw_text(5, y, buf, fps_color, COLOR_BLACK);
+    draw_text(5, y, buf, fps_color, COLOR_BLACK);
     y += 10;
     
     // Collision checks
-    snprintf(buf, sizeof(buf), "CHK:%lu", perf.collision_checks);
-    disp_framebuffer_draw_text(5, y, buf, COLOR_WHITE, COLOR_BLACK);
+    snprintf(buf, sizeof(buf), "CHK:%" PRIu32, perf.collision_checks);
+    draw_text(5, y, buf, COLOR_WHITE, COLOR_BLACK);
     y += 10;
     
-    // Collision time
-    snprintf(buf, sizeof(buf), "COL:%luus", perf.collision_time_us);
-    disp_framebuffer_draw_text(5, y, buf, COLOR_YELLOW, COLOR_BLACK);
+    // Zone times, avg and max over the last frames
+    PROF_HUD(5, y, draw_hud_text);
     
     // Score (top right)
     snprintf(buf, sizeof(buf), "Score:%d", score);
-    disp_framebuffer_draw_text(DISPLAY_WIDTH - 60, 5, buf, COLOR_WHITE, COLOR_BLACK);
+    draw_text(DISPLAY_WIDTH - 60, 5, buf, COLOR_WHITE, COLOR_BLACK);
 }
 
 void render_game(void) {
-    perf.render_start_us = time_us_32();
+    PROF_BEGIN("render");
     
-    disp_framebuffer_clear(COLOR_BLACK);
+    if (render_mode == RENDER_FRAMEBUFFER) {
+        disp_framebuffer_clear(COLOR_BLACK);
+    } else {
+        // disp_clear() would also log every frame
+        disp_fill_rect(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, COLOR_BLACK);
+    }
     
     // Player
-    disp_framebuffer_fill_rect(player.x, player.y, player.width, player.height, COLOR_WHITE);
+    draw_rect(player.x, player.y, player.width, player.height, COLOR_WHITE);
     
     // Invaders
     for (int i = 0; i < invader_count; i++) {
@@ -682,14 +926,14 @@ void render_game(void) {
     // Bullets
     for (int i = 0; i < MAX_BULLETS; i++) {
         if (bullets[i].active) {
-            disp_framebuffer_fill_rect(bullets[i].x, bullets[i].y, 2, 4, COLOR_YELLOW);
+            draw_rect(bullets[i].x, bullets[i].y, 2, 4, COLOR_YELLOW);
         }
     }
     
     // Bombs
     for (int i = 0; i < MAX_BOMBS; i++) {
         if (bombs[i].active) {
-            disp_framebuffer_fill_rect(bombs[i].x, bombs[i].y, 2, 4, COLOR_RED);
+            draw_rect(bombs[i].x, bombs[i].y, 2, 4, COLOR_RED);
         }
     }
     
@@ -698,25 +942,31 @@ void render_game(void) {
     
     // Game state messages
     if (game_over) {
-        disp_framebuffer_draw_text(DISPLAY_WIDTH/2 - 48, DISPLAY_HEIGHT/2,
-                                   "GAME OVER", COLOR_RED, COLOR_BLACK);
-        disp_framebuffer_draw_text(DISPLAY_WIDTH/2 - 36, DISPLAY_HEIGHT/2 + 15,
-                                   "Press X", COLOR_WHITE, COLOR_BLACK);
+        draw_text(DISPLAY_WIDTH/2 - 48, DISPLAY_HEIGHT/2,
+                  "GAME OVER", COLOR_RED, COLOR_BLACK);
+        draw_text(DISPLAY_WIDTH/2 - 36, DISPLAY_HEIGHT/2 + 15,
+                  "Press X", COLOR_WHITE, COLOR_BLACK);
     } else if (win) {
-        disp_framebuffer_draw_text(DISPLAY_WIDTH/2 - 36, DISPLAY_HEIGHT/2,
-                                   "YOU WIN!", COLOR_GREEN, COLOR_BLACK);
-        disp_framebuffer_draw_text(DISPLAY_WIDTH/2 - 36, DISPLAY_HEIGHT/2 + 15,
-                                   "Press X", COLOR_WHITE, COLOR_BLACK);
+        draw_text(DISPLAY_WIDTH/2 - 36, DISPLAY_HEIGHT/2,
+                  "YOU WIN!", COLOR_GREEN, COLOR_BLACK);
+        draw_text(DISPLAY_WIDTH/2 - 36, DISPLAY_HEIGHT/2 + 15,
+                  "Press X", COLOR_WHITE, COLOR_BLACK);
     }
     
-    disp_framebuffer_flush();
+    if (render_mode == RENDER_FRAMEBUFFER) {
+        PROF_ZONE("flush") {
+            disp_framebuffer_flush();
+        }
+    }
     
-    perf.render_time_us = time_us_32() - perf.render_start_us;
+    PROF_END();
 }
 
 
 // Performance track
 void update_fps(void) {
+    if (!instrumented) return;
+    
     perf.frame_count++;
     uint32_t now = time_us_32();
     
@@ -726,14 +976,96 @@ void update_fps(void) {
         perf.last_fps_time = now;
         
         // Log to serial
-        printf("Mode:%s FPS:%lu Checks:%lu ColTime:%luus RenderTime:%luus\n",
-               (collision_mode == COLLISION_SIMPLE) ? "SIMPLE" : "SPATIAL",
-               perf.fps, perf.collision_checks,
-               perf.collision_time_us, perf.render_time_us);
+        printf("Mode:%s FPS:%" PRIu32 " Checks:%" PRIu32 "\n",
+               mode_name(), perf.fps, perf.collision_checks);
+        PROF_LOG();
     }
 }
 
 
+// Benchmark
+static uint32_t bench_times[BENCHMARK_FRAMES];
+
+int compare_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+void run_benchmark(void) {
+    collision_mode_t saved_collision = collision_mode;
+    render_mode_t saved_render = render_mode;
+    bool saved_instrumented = instrumented;
+    
+    char lines[8][48];
+    
+    printf("\n=== Benchmark: %d frames per combination ===\n", BENCHMARK_FRAMES);
+    printf("%-22s %7s %7s %7s %7s\n", "Mode", "min us", "avg us", "p95 us", "max us");
+    
+    // Start from the first combination and visit all eight
+    collision_mode = COLLISION_SIMPLE;
+    render_mode = RENDER_FRAMEBUFFER;
+    instrumented = true;
+    PROF_SET_ACTIVE(true);
+    
+    for (int combo = 0; combo < 8; combo++) {
+        // Same seed and script, so every combination plays the same game
+        srand(BENCHMARK_SEED);
+        init_game();
+        
+        uint64_t total_us = 0;
+        for (uint32_t frame = 0; frame < BENCHMARK_FRAMES; frame++) {
+            uint32_t start = time_us_32();
+            
+            handle_input(scripted_input(frame));
+            update_game();
+            render_game();
+            update_fps();
+            PROF_FRAME();
+            
+            bench_times[frame] = time_us_32() - start;
+            total_us += bench_times[frame];
+        }
+        
+        qsort(bench_times, BENCHMARK_FRAMES, sizeof(bench_times[0]), compare_u32);
+        uint32_t avg_us = total_us / BENCHMARK_FRAMES;
+        uint32_t p95_us = bench_times[BENCHMARK_FRAMES * 95 / 100];
+        
+        printf("%-22s %7" PRIu32 " %7" PRIu32 " %7" PRIu32 " %7" PRIu32 "\n", mode_name(),
+               bench_times[0], avg_us, p95_us, bench_times[BENCHMARK_FRAMES - 1]);
+        snprintf(lines[combo], sizeof(lines[combo]), "%-18s avg:%" PRIu32 " p95:%" PRIu32,
+                 mode_name(), avg_us, p95_us);
+        
+        next_mode();
+    }
+    
+    printf("=== Benchmark done ===\n\n");
+    
+    // Results on screen until a button is pressed
+    disp_framebuffer_clear(COLOR_BLACK);
+    disp_framebuffer_draw_text(5, 5, "BENCHMARK (frame us)", COLOR_CYAN, COLOR_BLACK);
+    for (int i = 0; i < 8; i++) {
+        disp_framebuffer_draw_text(5, 25 + i * 12, lines[i], COLOR_WHITE, COLOR_BLACK);
+    }
+    disp_framebuffer_draw_text(5, 225, "Press any button", COLOR_YELLOW, COLOR_BLACK);
+    disp_framebuffer_flush();
+    
+    bool pressed = false;
+    while (!pressed) {
+        buttons_update();
+        for (int b = 0; b < BUTTON_COUNT; b++) {
+            pressed |= button_just_pressed((button_t)b);
+        }
+        sleep_ms(16);
+    }
+    
+    collision_mode = saved_collision;
+    render_mode = saved_render;
+    instrumented = saved_instrumented;
+    PROF_SET_ACTIVE(instrumented);
+    init_game();
+}
+
 
 int main() {
     stdio_init_all();
@@ -742,7 +1074,9 @@ int main() {
     printf("Controls:\n");
     printf("  B/Y - Move left/right\n");
     printf("  X - Fire / Restart\n");
-    printf("  A - Toggle collision mode (Simple vs Spatial Grid)\n");
+    printf("  A - Next mode: collision (Simple/Spatial Grid),\n");
+    printf("      render (Framebuffer/Direct), instrumentation (On/Off)\n");
+    printf("  Hold A at boot - Run the benchmark\n");
     printf("\nWatch the performance stats on screen!\n\n");
     
     // Init hardware
@@ -767,16 +1101,31 @@ int main() {
     // Init game
     init_game();
     
+    buttons_update();
+    if (BENCHMARK_ON_BOOT || button_pressed(BUTTON_A)) {
+        run_benchmark();
+    }
+    
     // Main game loop
     while (true) {
-        perf.frame_start_us = time_us_32();
-        
-        handle_input();
+#ifdef DISPLAY_CAPTURE
+        uint32_t frame_start = time_us_32();
+#endif
+        handle_input(read_buttons());
         update_game();
         render_game();
         update_fps();
-        
-        perf.frame_time_us = time_us_32() - perf.frame_start_us;
+        PROF_FRAME();
+#ifdef DISPLAY_CAPTURE
+        // The first slow frame dumps the frames before it and itself,
+        // for replay to play again
+        static bool dumped = false;
+        if (!dumped && time_us_32() - frame_start > CAPTURE_SPIKE_US) {
+            printf("Frame of %" PRIu32 " us, capture follows\n", time_us_32() - frame_start);
+            disp_capture_dump();
+            dumped = true;
+        }
+#endif
         
         sleep_ms(16);  // ~60 FPS target
     }
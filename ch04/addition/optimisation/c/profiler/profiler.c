@@ -0,0 +1,169 @@
+#include "profiler.h"
+
+#if PROFILER_ENABLED
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+
+static prof_zone_t zones[PROF_MAX_ZONES];
+static int zone_count = 0;
+
+// Open zones, innermost last
+static struct {
+    int id;
+    uint32_t start_us;
+} stack[PROF_MAX_DEPTH];
+static int depth = 0;
+
+static bool active = true;
+static int window_pos = 0;           // next history slot, shared by all zones
+static int window_fill = 0;          // frames recorded, up to PROF_WINDOW
+
+static uint32_t frame_start_us = 0;
+static uint32_t frame_history[PROF_WINDOW];
+static uint32_t frame_sum_us = 0;
+
+// Zone names are string literals, so the pointer is compared first
+int prof_find(const char *name) {
+    for (int i = 0; i < zone_count; i++) {
+        if (zones[i].name == name) return i;
+    }
+    for (int i = 0; i < zone_count; i++) {
+        if (strcmp(zones[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+int prof_begin(const char *name) {
+    if (!active || depth == PROF_MAX_DEPTH) return -1;
+    
+    int id = prof_find(name);
+    if (id < 0) {
+        if (zone_count == PROF_MAX_ZONES) return -1;
+        
+        id = zone_count++;
+        memset(&zones[id], 0, sizeof(zones[id]));
+        zones[id].name = name;
+        zones[id].depth = depth;
+    }
+    
+    stack[depth].id = id;
+    stack[depth].start_us = time_us_32();
+    depth++;
+    return id;
+}
+
+void prof_end(int id) {
+    if (id < 0 || !active || depth == 0) return;
+    
+    depth--;
+    prof_zone_t *zone = &zones[stack[depth].id];
+    zone->frame_us += time_us_32() - stack[depth].start_us;
+    zone->calls++;
+}
+
+void prof_frame(void) {
+    if (!active) return;
+    
+    uint32_t now = time_us_32();
+    
+    // The first frame only starts the clock
+    if (frame_start_us != 0) {
+        uint32_t frame_us = now - frame_start_us;
+        frame_sum_us += frame_us - frame_history[window_pos];
+        frame_history[window_pos] = frame_us;
+        
+        for (int i = 0; i < zone_count; i++) {
+            prof_zone_t *zone = &zones[i];
+            zone->sum_us += zone->frame_us - zone->history[window_pos];
+            zone->history[window_pos] = zone->frame_us;
+            zone->last_us = zone->frame_us;
+            zone->frame_us = 0;
+            zone->calls = 0;
+        }
+        
+        window_pos = (window_pos + 1) % PROF_WINDOW;
+        if (window_fill < PROF_WINDOW) window_fill++;
+    }
+    
+    frame_start_us = now;
+}
+
+void prof_set_active(bool on) {
+    if (on == active) return;
+    
+    active = on;
+    depth = 0;
+    
+    // Time spent inactive is not a frame
+    frame_start_us = 0;
+    for (int i = 0; i < zone_count; i++) {
+        zones[i].frame_us = 0;
+        zones[i].calls = 0;
+    }
+}
+
+uint32_t prof_avg_us(int id) {
+    if (id < 0 || id >= zone_count || window_fill == 0) return 0;
+    return zones[id].sum_us / window_fill;
+}
+
+uint32_t prof_max_us(int id) {
+    if (id < 0 || id >= zone_count) return 0;
+    
+    uint32_t max_us = 0;
+    for (int i = 0; i < window_fill; i++) {
+        if (zones[id].history[i] > max_us) max_us = zones[id].history[i];
+    }
+    return max_us;
+}
+
+uint32_t prof_frame_avg_us(void) {
+    return window_fill ? frame_sum_us / window_fill : 0;
+}
+
+const prof_zone_t *prof_zone(int id) {
+    return (id >= 0 && id < zone_count) ? &zones[id] : NULL;
+}
+
+int prof_zone_count(void) {
+    return zone_count;
+}
+
+// "  name   avg   max", two spaces of indent per level of nesting
+static void format_zone(char *buf, size_t size, int id) {
+    int indent = (zones[id].depth < 4) ? zones[id].depth * 2 : 8;
+    snprintf(buf, size, "%*s%-*.*s%5lu%6lu", indent, "",
+             10 - indent, 10 - indent, zones[id].name,
+             (unsigned long)prof_avg_us(id), (unsigned long)prof_max_us(id));
+}
+
+void prof_hud(uint16_t x, uint16_t y, prof_text_fn text) {
+    char buf[32];
+    uint32_t frame_avg = prof_frame_avg_us();
+    
+    for (int i = 0; i < zone_count; i++) {
+        // Green under a quarter of the frame, yellow under half, else red
+        uint32_t avg = prof_avg_us(i);
+        uint16_t color = (avg * 4 < frame_avg) ? 0x07E0 :
+                         (avg * 2 < frame_avg) ? 0xFFE0 : 0xF800;
+        
+        format_zone(buf, sizeof(buf), i);
+        text(x, y, buf, color);
+        y += PROF_HUD_LINE;
+    }
+}
+
+void prof_log(void) {
+    char buf[32];
+    
+    printf("%-10s%5s%6s  frame avg %luus\n", "zone", "avg", "max",
+           (unsigned long)prof_frame_avg_us());
+    for (int i = 0; i < zone_count; i++) {
+        format_zone(buf, sizeof(buf), i);
+        printf("%s\n", buf);
+    }
+}
+
+#endif // PROFILER_ENABLED
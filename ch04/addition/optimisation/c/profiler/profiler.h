@@ -0,0 +1,95 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Frame-phase profiler for the ch04 games: named timing zones, which
+// may nest, each with statistics over the last PROF_WINDOW frames and
+// an overlay listing them. Used through the macros below only, so with
+// PROFILER_ENABLED 0 every one of them compiles to nothing:
+//
+//     PROF_ZONE("render") {             // times the block
+//         PROF_ZONE("flush") { ... }    // nested, shown indented
+//     }
+//     PROF_BEGIN("logic"); ... PROF_END();  // same, any two points
+//     PROF_FRAME();                     // once per frame, at its end
+//     PROF_HUD(5, 40, draw_text);       // zones on screen
+//
+// Leaving a PROF_ZONE block by break or return skips its end;
+// use PROF_BEGIN/PROF_END around code that can.
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+#define PROF_MAX_ZONES 16
+#define PROF_MAX_DEPTH 8
+#define PROF_WINDOW 32      // frames of history per zone
+
+// Text for the HUD, RGB565 colour on black: each game passes
+// a small wrapper around its own display's text function
+typedef void (*prof_text_fn)(uint16_t x, uint16_t y, const char *text, uint16_t color);
+
+typedef struct {
+    const char *name;
+    uint8_t depth;                   // nesting when first entered
+    uint32_t frame_us;               // this frame so far, all entries
+    uint32_t calls;                  // entries this frame
+    uint32_t history[PROF_WINDOW];   // per-frame totals, a ring
+    uint32_t sum_us;                 // of history
+    uint32_t last_us;                // the last whole frame
+} prof_zone_t;
+
+#if PROFILER_ENABLED
+
+#define PROF_ZONE(name) \
+    for (int prof_zone_ = prof_begin(name), prof_once_ = 1; prof_once_; \
+         prof_once_ = 0, prof_end(prof_zone_))
+#define PROF_BEGIN(name) prof_begin(name)
+#define PROF_END() prof_end(0)
+#define PROF_FRAME() prof_frame()
+#define PROF_HUD(x, y, text) prof_hud(x, y, text)
+#define PROF_LOG() prof_log()
+#define PROF_SET_ACTIVE(on) prof_set_active(on)
+
+// Enter the zone called name, registering it the first time; the
+// returned id is only there for PROF_ZONE, which passes it to prof_end
+int prof_begin(const char *name);
+void prof_end(int id);
+
+// Close the frame: fold every zone's total into its history
+void prof_frame(void);
+
+// While inactive nothing is timed or recorded, so a game can turn
+// its instrumentation off at runtime; on by default
+void prof_set_active(bool on);
+
+// Statistics over the window, in microseconds, -1 for no such zone
+int prof_find(const char *name);
+uint32_t prof_avg_us(int id);
+uint32_t prof_max_us(int id);
+uint32_t prof_frame_avg_us(void);   // time between PROF_FRAME()s
+const prof_zone_t *prof_zone(int id);
+int prof_zone_count(void);
+
+// One line per zone, "name avg max" in us, indented by nesting,
+// coloured by its share of the frame, PROF_HUD_LINE pixels apart
+#define PROF_HUD_LINE 10
+void prof_hud(uint16_t x, uint16_t y, prof_text_fn text);
+
+// The same table over serial
+void prof_log(void);
+
+#else
+
+#define PROF_ZONE(name)
+#define PROF_BEGIN(name) ((void)0)
+#define PROF_END() ((void)0)
+#define PROF_FRAME() ((void)0)
+#define PROF_HUD(x, y, text) ((void)0)
+#define PROF_LOG() ((void)0)
+#define PROF_SET_ACTIVE(on) ((void)0)
+
+#endif // PROFILER_ENABLED
+
+#endif // PROFILER_H
@@ -181,6 +181,237 @@ ALUResult enhanced_alu(uint8_t a, uint8_t b, uint8_t opcode) {
 }
 
 
+// The same ALU on whole bytes, as hardware-independent C. Results and
+// flags are those of enhanced_alu(): SUB is A + ~B + 1, so carry means
+// no borrow, and overflow is judged on A, ~B and the sum like the adder does
+
+ALUResult native_alu(uint8_t a, uint8_t b, uint8_t opcode) {
+    ALUResult alu_result = {0};
+
+    switch (opcode) {
+        case 0:   // ADD
+        case 1: { // SUB
+            uint8_t bb = (opcode == 0) ? b : (uint8_t)~b;
+            unsigned sum = a + bb + (opcode == 1);
+            alu_result.result = (uint8_t)sum;
+            alu_result.flags.carry = sum > 0xFF;
+            alu_result.flags.overflow = ((a ^ sum) & (bb ^ sum) & 0x80) != 0;
+            break;
+        }
+        case 2: alu_result.result = a & b; break;   // AND
+        case 3: alu_result.result = a | b; break;   // OR
+        case 4: alu_result.result = a ^ b; break;   // XOR
+        case 5: alu_result.result = ~a; break;      // NOT A
+        case 6: // SHL A
+            alu_result.result = a << 1;
+            alu_result.flags.carry = (a & 0x80) != 0;
+            break;
+        case 7: // SHR A
+            alu_result.result = a >> 1;
+            alu_result.flags.carry = (a & 0x01) != 0;
+            break;
+        default:
+            alu_result.result = 0;
+            break;
+    }
+
+    alu_result.flags.zero = (alu_result.result == 0);
+    alu_result.flags.negative = (alu_result.result & 0x80) != 0;
+
+    return alu_result;
+}
+
+static bool alu_result_equal(ALUResult x, ALUResult y) {
+    return x.result == y.result &&
+           x.flags.zero == y.flags.zero && x.flags.carry == y.flags.carry &&
+           x.flags.overflow == y.flags.overflow && x.flags.negative == y.flags.negative;
+}
+
+// The ALU as the CPU sees it, in the VM's mode. In lockstep the gates
+// have the last word: on a mismatch their result is the one used
+ALUResult cpu_alu(VM *vm, uint8_t a, uint8_t b, uint8_t opcode) {
+    vm->alu_ops++;
+    switch (vm->alu_mode) {
+        case ALU_NATIVE:
+            return native_alu(a, b, opcode);
+        case ALU_LOCKSTEP: {
+            ALUResult fast = native_alu(a, b, opcode);
+            if (vm->alu_ops % vm->verify_interval != 0) return fast;
+            ALUResult gates = enhanced_alu(a, b, opcode);
+            vm->alu_checked++;
+            if (!alu_result_equal(fast, gates)) {
+                vm->alu_mismatches++;
+                printf("  ALU mismatch: op %d, A=%d, B=%d: native %d, gates %d\n",
+                       opcode, a, b, fast.result, gates.result);
+            }
+            return gates;
+        }
+        case ALU_GATES:
+        default:
+            return enhanced_alu(a, b, opcode);
+    }
+}
+
+// Every operation on every pair of operands through both ALUs;
+// returns the number of differences
+uint32_t alu_verify_all(void) {
+    uint32_t mismatches = 0;
+    for (int op = 0; op < 8; op++) {
+        for (int a = 0; a < 256; a++) {
+            for (int b = 0; b < 256; b++) {
+                if (!alu_result_equal(native_alu(a, b, op), enhanced_alu(a, b, op))) {
+                    mismatches++;
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+
+// Bit-sliced gates: a gate on Lanes is the same gate in 64 circuits,
+// each fed its own inputs, for the price of one machine operation.
+// The adders and the ALU below are wired gate for gate like the ones above
+
+Lanes and_gate64(Lanes a, Lanes b) {
+    return a & b;
+}
+
+Lanes or_gate64(Lanes a, Lanes b) {
+    return a | b;
+}
+
+Lanes xor_gate64(Lanes a, Lanes b) {
+    return a ^ b;
+}
+
+Lanes not_gate64(Lanes a) {
+    return ~a;
+}
+
+// a where select is set, b elsewhere
+Lanes mux_gate64(Lanes select, Lanes a, Lanes b) {
+    return or_gate64(and_gate64(select, a), and_gate64(not_gate64(select), b));
+}
+
+void half_adder64(Lanes a, Lanes b, Lanes *sum, Lanes *carry) {
+    *sum = xor_gate64(a, b);
+    *carry = and_gate64(a, b);
+}
+
+void full_adder64(Lanes a, Lanes b, Lanes carry_in, Lanes *sum, Lanes *carry_out) {
+    Lanes s1, c1, c2;
+    half_adder64(a, b, &s1, &c1);
+    half_adder64(s1, carry_in, sum, &c2);
+    *carry_out = or_gate64(c1, c2);
+}
+
+AdderLanes ripple_carry_adder_8bit64(const Lanes8 *a, const Lanes8 *b, Lanes carry_in) {
+    AdderLanes result;
+    Lanes carry = carry_in;
+
+    for (int i = 0; i < 8; i++) {
+        full_adder64(a->bit[i], b->bit[i], carry, &result.sum.bit[i], &carry);
+    }
+    result.carry_out = carry;
+
+    Lanes msb_a = a->bit[7], msb_b = b->bit[7], msb_sum = result.sum.bit[7];
+    result.overflow = or_gate64(and_gate64(and_gate64(msb_a, msb_b), not_gate64(msb_sum)),
+                                and_gate64(and_gate64(not_gate64(msb_a), not_gate64(msb_b)), msb_sum));
+    return result;
+}
+
+// The opcode is the same in all lanes: it selects the circuit, the
+// lanes hold the operands
+ALULanes enhanced_alu64(const Lanes8 *a, const Lanes8 *b, uint8_t opcode) {
+    ALULanes alu = {0};
+
+    switch (opcode) {
+        case 0:   // ADD
+        case 1: { // SUB (A - B = A + (~B + 1))
+            Lanes8 operand = *b;
+            if (opcode == 1) {
+                for (int i = 0; i < 8; i++) operand.bit[i] = not_gate64(b->bit[i]);
+            }
+            AdderLanes sum = ripple_carry_adder_8bit64(a, &operand, opcode == 1 ? ~(Lanes)0 : 0);
+            alu.result = sum.sum;
+            alu.flags.carry = sum.carry_out;
+            alu.flags.overflow = sum.overflow;
+            break;
+        }
+        case 2: // AND
+            for (int i = 0; i < 8; i++) alu.result.bit[i] = and_gate64(a->bit[i], b->bit[i]);
+            break;
+        case 3: // OR
+            for (int i = 0; i < 8; i++) alu.result.bit[i] = or_gate64(a->bit[i], b->bit[i]);
+            break;
+        case 4: // XOR
+            for (int i = 0; i < 8; i++) alu.result.bit[i] = xor_gate64(a->bit[i], b->bit[i]);
+            break;
+        case 5: // NOT A
+            for (int i = 0; i < 8; i++) alu.result.bit[i] = not_gate64(a->bit[i]);
+            break;
+        case 6: // SHL A, a shift is wiring: bit i comes from bit i - 1
+            for (int i = 7; i > 0; i--) alu.result.bit[i] = a->bit[i - 1];
+            alu.flags.carry = a->bit[7];
+            break;
+        case 7: // SHR A
+            for (int i = 0; i < 7; i++) alu.result.bit[i] = a->bit[i + 1];
+            alu.flags.carry = a->bit[0];
+            break;
+        default:
+            break;
+    }
+
+    Lanes any = 0;
+    for (int i = 0; i < 8; i++) any = or_gate64(any, alu.result.bit[i]);
+    alu.flags.zero = not_gate64(any);
+    alu.flags.negative = alu.result.bit[7];
+    return alu;
+}
+
+// The same value in every lane: each plane all ones or all zeros
+Lanes8 lanes8_splat(uint8_t value) {
+    Lanes8 v;
+    for (int i = 0; i < 8; i++) {
+        v.bit[i] = ((value >> i) & 1) ? ~(Lanes)0 : 0;
+    }
+    return v;
+}
+
+// The lanes holding value: an 8-input comparator, XNOR per bit and AND
+Lanes lanes8_equal(const Lanes8 *v, uint8_t value) {
+    Lanes8 want = lanes8_splat(value);
+    Lanes equal = ~(Lanes)0;
+    for (int i = 0; i < 8; i++) {
+        equal = and_gate64(equal, not_gate64(xor_gate64(v->bit[i], want.bit[i])));
+    }
+    return equal;
+}
+
+void lanes8_set(Lanes8 *v, int lane, uint8_t value) {
+    Lanes bit = (Lanes)1 << lane;
+    for (int i = 0; i < 8; i++) {
+        v->bit[i] = ((value >> i) & 1) ? (v->bit[i] | bit) : (v->bit[i] & ~bit);
+    }
+}
+
+uint8_t lanes8_get(const Lanes8 *v, int lane) {
+    uint8_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= ((v->bit[i] >> lane) & 1) << i;
+    }
+    return value;
+}
+
+// dst = src in the lanes of mask
+static void lanes8_select(Lanes8 *dst, Lanes mask, const Lanes8 *src) {
+    for (int i = 0; i < 8; i++) {
+        dst->bit[i] = mux_gate64(mask, src->bit[i], dst->bit[i]);
+    }
+}
+
+
 // Memory interface functions
 uint8_t mem_read(VM *vm, uint8_t addr) {
     return vm->memory[addr];
@@ -220,74 +451,440 @@ uint16_t cpu_fetch(VM *vm) {
     return instruction;
 }
 
-// Control unit
-void cpu_decode_and_execute(VM *vm) {
-    DecodedInstruction decoded = decode_instruction(vm->ir);
-    
-    printf("Cycle: PC=%d, IR=0x%04X, Opcode=0x%02X\n", 
-           vm->pc - 2, vm->ir, decoded.opcode);
-    
+// Printing what the CPU does while vm->trace is set
+#define TRACE(vm, ...) do { if ((vm)->trace) printf(__VA_ARGS__); } while (0)
+
+// ===== Microcode =====
+// Each opcode is a row of micro-steps in the ROM, carried out after the
+// fetch: cpu_fetch() has already moved the PC on, so pc_increment has
+// nothing left to do here
+
+#define MAX_MICRO_STEPS 8
+#define NUM_OPCODES 16
+#define MICRO_UNUSED 0x0D   // row for opcodes without microcode: no-op
+#define MICRO_HALT 0x0F     // row for OP_HALT
+
+MicroInstruction microcode_rom[NUM_OPCODES][MAX_MICRO_STEPS];
+static bool microcode_initialized = false;
+
+static int micro_index(uint8_t opcode) {
+    if (opcode == OP_HALT) return MICRO_HALT;
+    return opcode < MICRO_UNUSED ? opcode : MICRO_UNUSED;
+}
+
+uint8_t fetch(VM *vm) {
+    return mem_read(vm, vm->pc++);
+}
+
+static uint8_t micro_field(const VM *vm, uint8_t select) {
+    return select == MICRO_SEL_REG_B ? vm->decoded.reg_b : vm->decoded.reg_a;
+}
+
+static uint8_t micro_address(const VM *vm, const ControlSignals *signals) {
+    return signals->mem_use_immediate_addr ? vm->decoded.address
+                                           : vm->registers[micro_field(vm, signals->reg_read_b_select)];
+}
+
+// One micro-step, looking at every control signal
+void execute_microinstruction(VM *vm, const MicroInstruction *micro) {
+    const ControlSignals *signals = &micro->signals;
+
+    TRACE(vm, "    Microcode: %s\n", micro->description);
+
+    if (signals->alu_enable) {
+        uint8_t a = vm->registers[micro_field(vm, signals->reg_read_a_select)];
+        uint8_t b = signals->alu_use_immediate ? signals->immediate_value
+                                               : vm->registers[micro_field(vm, signals->reg_read_b_select)];
+        vm->alu_result = cpu_alu(vm, a, b, signals->alu_operation);
+        vm->flags = vm->alu_result.flags;
+    }
+
+    if (signals->reg_write_enable) {
+        vm->registers[micro_field(vm, signals->reg_write_select)] =
+            signals->use_alu_result ? vm->alu_result.result : vm->memory_data;
+    }
+
+    if (signals->mem_read) {
+        vm->memory_data = mem_read(vm, micro_address(vm, signals));
+    }
+
+    if (signals->mem_write) {
+        mem_write(vm, micro_address(vm, signals),
+                  vm->registers[micro_field(vm, signals->reg_read_a_select)]);
+    }
+
+    if (signals->pc_jump) {
+        vm->pc = vm->decoded.address;
+    }
+
+    if (signals->pc_jump_conditional) {
+        bool should_jump = false;
+        switch (signals->jump_condition) {
+            case 0: should_jump = vm->flags.zero; break;
+            case 1: should_jump = vm->flags.carry; break;
+            case 2: should_jump = vm->flags.overflow; break;
+            case 3: should_jump = vm->flags.negative; break;
+        }
+        if (should_jump) vm->pc = vm->decoded.address;
+    }
+
+    if (signals->fetch_next_byte) {
+        vm->fetched_byte = fetch(vm);
+    }
+
+    if (signals->halt_cpu) {
+        vm->running = false;
+    }
+}
+
+// ===== Compiled microcode =====
+// Interpreting a step tests every signal, most of them false, and goes
+// through the selects each time. Compiled, a row becomes a list of small
+// handlers, one per signal that is set, with the constant fields (ALU
+// operation, immediate, selects, jump condition) decided once: the
+// instruction then runs as a straight sequence of calls. Steps the
+// handlers below do not cover are interpreted as they stand
+
+// at most one handler for each of the eight kinds of signal in a step
+#define MAX_MICRO_OPS (MAX_MICRO_STEPS * 8)
+
+typedef struct MicroOp MicroOp;
+struct MicroOp {
+    void (*run)(VM *vm, const MicroOp *op);
+    uint8_t arg;                    // ALU operation
+    uint8_t immediate;              // ALU B operand
+    const MicroInstruction *micro;  // for uop_interpret
+};
+
+typedef struct {
+    MicroOp ops[MAX_MICRO_OPS];
+    int count;
+} CompiledInstruction;
+
+static CompiledInstruction compiled_rom[NUM_OPCODES];
+
+static void uop_alu_ab(VM *vm, const MicroOp *op) {
+    vm->alu_result = cpu_alu(vm, vm->registers[vm->decoded.reg_a],
+                             vm->registers[vm->decoded.reg_b], op->arg);
+    vm->flags = vm->alu_result.flags;
+}
+
+static void uop_alu_a_imm(VM *vm, const MicroOp *op) {
+    vm->alu_result = cpu_alu(vm, vm->registers[vm->decoded.reg_a], op->immediate, op->arg);
+    vm->flags = vm->alu_result.flags;
+}
+
+static void uop_write_a_alu(VM *vm, const MicroOp *op) {
+    (void)op;
+    vm->registers[vm->decoded.reg_a] = vm->alu_result.result;
+}
+
+static void uop_write_a_mem(VM *vm, const MicroOp *op) {
+    (void)op;
+    vm->registers[vm->decoded.reg_a] = vm->memory_data;
+}
+
+static void uop_read_addr(VM *vm, const MicroOp *op) {
+    (void)op;
+    vm->memory_data = mem_read(vm, vm->decoded.address);
+}
+
+static void uop_store_a_addr(VM *vm, const MicroOp *op) {
+    (void)op;
+    mem_write(vm, vm->decoded.address, vm->registers[vm->decoded.reg_a]);
+}
+
+static void uop_jump(VM *vm, const MicroOp *op) {
+    (void)op;
+    vm->pc = vm->decoded.address;
+}
+
+static void uop_jump_zero(VM *vm, const MicroOp *op) {
+    (void)op;
+    if (vm->flags.zero) vm->pc = vm->decoded.address;
+}
+
+static void uop_jump_carry(VM *vm, const MicroOp *op) {
+    (void)op;
+    if (vm->flags.carry) vm->pc = vm->decoded.address;
+}
+
+static void uop_jump_overflow(VM *vm, const MicroOp *op) {
+    (void)op;
+    if (vm->flags.overflow) vm->pc = vm->decoded.address;
+}
+
+static void uop_jump_negative(VM *vm, const MicroOp *op) {
+    (void)op;
+    if (vm->flags.negative) vm->pc = vm->decoded.address;
+}
+
+static void uop_fetch(VM *vm, const MicroOp *op) {
+    (void)op;
+    vm->fetched_byte = fetch(vm);
+}
+
+static void uop_halt(VM *vm, const MicroOp *op) {
+    (void)op;
+    vm->running = false;
+}
+
+static void uop_interpret(VM *vm, const MicroOp *op) {
+    execute_microinstruction(vm, op->micro);
+}
+
+static void emit(CompiledInstruction *ci, void (*run)(VM *, const MicroOp *), uint8_t arg,
+                 uint8_t immediate, const MicroInstruction *micro) {
+    ci->ops[ci->count++] = (MicroOp){ run, arg, immediate, micro };
+}
+
+// Can the handlers above do this step? They know register A as the
+// ALU's A and as what is stored, register B or an immediate as the
+// ALU's B, register A as the one written, and addresses from the instruction
+static bool step_compilable(const ControlSignals *s) {
+    if (s->alu_enable && (s->reg_read_a_select != MICRO_SEL_REG_A ||
+        (!s->alu_use_immediate && s->reg_read_b_select != MICRO_SEL_REG_B))) return false;
+    if (s->reg_write_enable && s->reg_write_select != MICRO_SEL_REG_A) return false;
+    if ((s->mem_read || s->mem_write) && !s->mem_use_immediate_addr) return false;
+    if (s->mem_write && s->reg_read_a_select != MICRO_SEL_REG_A) return false;
+    if (s->pc_jump_conditional && s->jump_condition > 3) return false;
+    return true;
+}
+
+// Handlers in the order execute_microinstruction() looks at the signals
+static void compile_step(CompiledInstruction *ci, const MicroInstruction *micro) {
+    const ControlSignals *s = &micro->signals;
+    if (!step_compilable(s)) {
+        emit(ci, uop_interpret, 0, 0, micro);
+        return;
+    }
+    if (s->alu_enable) {
+        if (s->alu_use_immediate) emit(ci, uop_alu_a_imm, s->alu_operation, s->immediate_value, NULL);
+        else emit(ci, uop_alu_ab, s->alu_operation, 0, NULL);
+    }
+    if (s->reg_write_enable) emit(ci, s->use_alu_result ? uop_write_a_alu : uop_write_a_mem, 0, 0, NULL);
+    if (s->mem_read) emit(ci, uop_read_addr, 0, 0, NULL);
+    if (s->mem_write) emit(ci, uop_store_a_addr, 0, 0, NULL);
+    if (s->pc_jump) emit(ci, uop_jump, 0, 0, NULL);
+    if (s->pc_jump_conditional) {
+        static void (*const conditional[4])(VM *, const MicroOp *) = {
+            uop_jump_zero, uop_jump_carry, uop_jump_overflow, uop_jump_negative
+        };
+        emit(ci, conditional[s->jump_condition], 0, 0, NULL);
+    }
+    if (s->fetch_next_byte) emit(ci, uop_fetch, 0, 0, NULL);
+    if (s->halt_cpu) emit(ci, uop_halt, 0, 0, NULL);
+}
+
+static void compile_microcode(void) {
+    for (int op = 0; op < NUM_OPCODES; op++) {
+        CompiledInstruction *ci = &compiled_rom[op];
+        ci->count = 0;
+        for (int step = 0; step < MAX_MICRO_STEPS; step++) {
+            compile_step(ci, &microcode_rom[op][step]);
+            if (microcode_rom[op][step].signals.end_instruction) break;
+        }
+    }
+}
+
+int compiled_micro_ops(uint8_t opcode) {
+    init_microcode();
+    return compiled_rom[micro_index(opcode)].count;
+}
+
+// The ROM: ALU operations compute into the ALU latch, then write it to
+// register A; memory goes through the memory data latch
+void init_microcode(void) {
+    if (microcode_initialized) return;
+
+    memset(microcode_rom, 0, sizeof(microcode_rom));
+    for (int op = 0; op < NUM_OPCODES; op++) {
+        microcode_rom[op][0] = (MicroInstruction){
+            .signals = { .end_instruction = true },
+            .description = "No operation"
+        };
+    }
+
+    // Two-register ALU operations (ADD, SUB, AND, OR, XOR)
+    static const char *const two_reg[] = {
+        "ADD: Compute RA + RB", "SUB: Compute RA - RB", "AND: Compute RA & RB",
+        "OR: Compute RA | RB", "XOR: Compute RA ^ RB"
+    };
+    for (int op = OP_ADD; op <= OP_XOR; op++) {
+        microcode_rom[op][0] = (MicroInstruction){
+            .signals = {
+                .alu_enable = true,
+                .alu_operation = op,
+                .reg_read_a_select = MICRO_SEL_REG_A,
+                .reg_read_b_select = MICRO_SEL_REG_B
+            },
+            .description = two_reg[op - OP_ADD]
+        };
+    }
+
+    // One-register ALU operations (NOT, SHL, SHR), B is 0
+    static const char *const one_reg[] = {
+        "NOT: Compute ~RA", "SHL: Compute RA << 1", "SHR: Compute RA >> 1"
+    };
+    for (int op = OP_NOT; op <= OP_SHR; op++) {
+        microcode_rom[op][0] = (MicroInstruction){
+            .signals = {
+                .alu_enable = true,
+                .alu_operation = op,
+                .reg_read_a_select = MICRO_SEL_REG_A,
+                .alu_use_immediate = true,
+                .immediate_value = 0
+            },
+            .description = one_reg[op - OP_NOT]
+        };
+    }
+
+    for (int op = OP_ADD; op <= OP_SHR; op++) {
+        microcode_rom[op][1] = (MicroInstruction){
+            .signals = {
+                .reg_write_enable = true,
+                .reg_write_select = MICRO_SEL_REG_A,
+                .use_alu_result = true,
+                .end_instruction = true
+            },
+            .description = "Store ALU result in RA"
+        };
+    }
+
+    // LOAD (opcode 0x08)
+    microcode_rom[OP_LOAD][0] = (MicroInstruction){
+        .signals = {
+            .mem_read = true,
+            .mem_use_immediate_addr = true
+        },
+        .description = "LOAD: Read memory[addr]"
+    };
+    microcode_rom[OP_LOAD][1] = (MicroInstruction){
+        .signals = {
+            .reg_write_enable = true,
+            .reg_write_select = MICRO_SEL_REG_A,
+            .use_alu_result = false,
+            .end_instruction = true
+        },
+        .description = "LOAD: Store in RA"
+    };
+
+    // STORE (opcode 0x09)
+    microcode_rom[OP_STORE][0] = (MicroInstruction){
+        .signals = {
+            .mem_write = true,
+            .mem_use_immediate_addr = true,
+            .reg_read_a_select = MICRO_SEL_REG_A,
+            .end_instruction = true
+        },
+        .description = "STORE: Write RA to memory[addr]"
+    };
+
+    // JMP, JZ, JC (opcodes 0x0A - 0x0C)
+    microcode_rom[OP_JMP][0] = (MicroInstruction){
+        .signals = { .pc_jump = true, .end_instruction = true },
+        .description = "JMP: PC = addr"
+    };
+    microcode_rom[OP_JZ][0] = (MicroInstruction){
+        .signals = { .pc_jump_conditional = true, .jump_condition = 0, .end_instruction = true },
+        .description = "JZ: PC = addr if zero"
+    };
+    microcode_rom[OP_JC][0] = (MicroInstruction){
+        .signals = { .pc_jump_conditional = true, .jump_condition = 1, .end_instruction = true },
+        .description = "JC: PC = addr if carry"
+    };
+
+    // HALT (opcode 0xFF -> row 0x0F)
+    microcode_rom[MICRO_HALT][0] = (MicroInstruction){
+        .signals = { .halt_cpu = true, .end_instruction = true },
+        .description = "HALT: Stop CPU"
+    };
+
+    compile_microcode();
+    microcode_initialized = true;
+}
+
+static void execute_microcoded(VM *vm) {
+    const MicroInstruction *row = microcode_rom[micro_index(vm->decoded.opcode)];
+    for (int step = 0; step < MAX_MICRO_STEPS; step++) {
+        vm->micro_step = step;
+        execute_microinstruction(vm, &row[step]);
+        if (row[step].signals.end_instruction) break;
+    }
+    vm->micro_step = 0;
+}
+
+static void execute_compiled(VM *vm) {
+    const CompiledInstruction *ci = &compiled_rom[micro_index(vm->decoded.opcode)];
+    for (const MicroOp *op = ci->ops, *end = op + ci->count; op < end; op++) {
+        op->run(vm, op);
+    }
+}
+
+// ===== Control unit =====
+
+static void execute_hardwired(VM *vm, DecodedInstruction decoded) {
     switch (decoded.opcode) {
         case OP_ADD: {
-            ALUResult result = enhanced_alu(vm->registers[decoded.reg_a], 
-                                          vm->registers[decoded.reg_b], 0);
+            ALUResult result = cpu_alu(vm, vm->registers[decoded.reg_a], 
+                                     vm->registers[decoded.reg_b], 0);
             vm->registers[decoded.reg_a] = result.result;
             vm->flags = result.flags;
-            printf("  ADD R%d, R%d -> R%d = %d\n", 
+            TRACE(vm, "  ADD R%d, R%d -> R%d = %d\n", 
                    decoded.reg_a, decoded.reg_b, decoded.reg_a, result.result);
             break;
         }
         
         case OP_SUB: {
-            ALUResult result = enhanced_alu(vm->registers[decoded.reg_a], 
-                                          vm->registers[decoded.reg_b], 1);
+            ALUResult result = cpu_alu(vm, vm->registers[decoded.reg_a], 
+                                     vm->registers[decoded.reg_b], 1);
             vm->registers[decoded.reg_a] = result.result;
             vm->flags = result.flags;
-            printf("  SUB R%d, R%d -> R%d = %d\n", 
+            TRACE(vm, "  SUB R%d, R%d -> R%d = %d\n", 
                    decoded.reg_a, decoded.reg_b, decoded.reg_a, result.result);
             break;
         }
         
         case OP_AND: {
-            ALUResult result = enhanced_alu(vm->registers[decoded.reg_a], 
-                                          vm->registers[decoded.reg_b], 2);
+            ALUResult result = cpu_alu(vm, vm->registers[decoded.reg_a], 
+                                     vm->registers[decoded.reg_b], 2);
             vm->registers[decoded.reg_a] = result.result;
             vm->flags = result.flags;
             break;
         }
         
         case OP_OR: {
-            ALUResult result = enhanced_alu(vm->registers[decoded.reg_a], 
-                                          vm->registers[decoded.reg_b], 3);
+            ALUResult result = cpu_alu(vm, vm->registers[decoded.reg_a], 
+                                     vm->registers[decoded.reg_b], 3);
             vm->registers[decoded.reg_a] = result.result;
             vm->flags = result.flags;
             break;
         }
         
         case OP_XOR: {
-            ALUResult result = enhanced_alu(vm->registers[decoded.reg_a], 
-                                          vm->registers[decoded.reg_b], 4);
+            ALUResult result = cpu_alu(vm, vm->registers[decoded.reg_a], 
+                                     vm->registers[decoded.reg_b], 4);
             vm->registers[decoded.reg_a] = result.result;
             vm->flags = result.flags;
             break;
         }
         
         case OP_NOT: {
-            ALUResult result = enhanced_alu(vm->registers[decoded.reg_a], 0, 5);
+            ALUResult result = cpu_alu(vm, vm->registers[decoded.reg_a], 0, 5);
             vm->registers[decoded.reg_a] = result.result;
             vm->flags = result.flags;
             break;
         }
         
         case OP_SHL: {
-            ALUResult result = enhanced_alu(vm->registers[decoded.reg_a], 0, 6);
+            ALUResult result = cpu_alu(vm, vm->registers[decoded.reg_a], 0, 6);
             vm->registers[decoded.reg_a] = result.result;
             vm->flags = result.flags;
             break;
         }
         
         case OP_SHR: {
-            ALUResult result = enhanced_alu(vm->registers[decoded.reg_a], 0, 7);
+            ALUResult result = cpu_alu(vm, vm->registers[decoded.reg_a], 0, 7);
             vm->registers[decoded.reg_a] = result.result;
             vm->flags = result.flags;
             break;
@@ -296,14 +893,14 @@ void cpu_decode_and_execute(VM *vm) {
         case OP_LOAD: {
             uint8_t value = mem_read(vm, decoded.address);
             vm->registers[decoded.reg_a] = value;
-            printf("  LOAD R%d, [%d] -> R%d = %d\n", 
+            TRACE(vm, "  LOAD R%d, [%d] -> R%d = %d\n", 
                    decoded.reg_a, decoded.address, decoded.reg_a, value);
             break;
         }
         
         case OP_STORE: {
             mem_write(vm, decoded.address, vm->registers[decoded.reg_a]);
-            printf("  STORE R%d, [%d] -> memory[%d] = %d\n", 
+            TRACE(vm, "  STORE R%d, [%d] -> memory[%d] = %d\n", 
                    decoded.reg_a, decoded.address, decoded.address, vm->registers[decoded.reg_a]);
             break;
         }
@@ -312,16 +909,16 @@ void cpu_decode_and_execute(VM *vm) {
             // PC update is overridden for jumps, patching the instruction pointer directly
             // This is a direct jump, so we set the PC to the address
             vm->pc = decoded.address;
-            printf("  JMP %d -> PC = %d\n", decoded.address, vm->pc);
+            TRACE(vm, "  JMP %d -> PC = %d\n", decoded.address, vm->pc);
             break;
         }
         
         case OP_JZ: {
             if (vm->flags.zero) {
                 vm->pc = decoded.address;
-                printf("  JZ %d -> PC = %d (taken)\n", decoded.address, vm->pc);
+                TRACE(vm, "  JZ %d -> PC = %d (taken)\n", decoded.address, vm->pc);
             } else {
-                printf("  JZ %d -> not taken\n", decoded.address);
+                TRACE(vm, "  JZ %d -> not taken\n", decoded.address);
             }
             break;
         }
@@ -329,26 +926,41 @@ void cpu_decode_and_execute(VM *vm) {
         case OP_JC: {
             if (vm->flags.carry) {
                 vm->pc = decoded.address;
-                printf("  JC %d -> PC = %d (taken)\n", decoded.address, vm->pc);
+                TRACE(vm, "  JC %d -> PC = %d (taken)\n", decoded.address, vm->pc);
             } else {
-                printf("  JC %d -> not taken\n", decoded.address);
+                TRACE(vm, "  JC %d -> not taken\n", decoded.address);
             }
             break;
         }
         
         case OP_HALT: {
             vm->running = false;
-            printf("  HALT -> CPU stopped\n");
+            TRACE(vm, "  HALT -> CPU stopped\n");
             break;
         }
         
         default: {
-            printf("  Unknown opcode: 0x%02X\n", decoded.opcode);
+            TRACE(vm, "  Unknown opcode: 0x%02X\n", decoded.opcode);
             break;
         }
     }
 }
 
+void cpu_decode_and_execute(VM *vm) {
+    vm->decoded = decode_instruction(vm->ir);
+    vm->current_instruction = vm->decoded.opcode;
+    
+    TRACE(vm, "Cycle: PC=%d, IR=0x%04X, Opcode=0x%02X\n", 
+           vm->pc - 2, vm->ir, vm->decoded.opcode);
+    
+    switch (vm->control) {
+        case CONTROL_MICROCODE: execute_microcoded(vm); break;
+        case CONTROL_COMPILED:  execute_compiled(vm); break;
+        case CONTROL_HARDWIRED:
+        default:                execute_hardwired(vm, vm->decoded); break;
+    }
+}
+
 // Simplified VM init / reset ..
 void init_vm(VM *vm) {
     memset(vm->registers, 0, sizeof(vm->registers));
@@ -357,6 +969,26 @@ void init_vm(VM *vm) {
     vm->ir = 0;  // Init instruction register
     vm->flags = (ALUFlags){0};
     vm->running = true;
+    vm->trace = true;
+    set_alu_mode(vm, ALU_GATES, 1);
+    vm->control = CONTROL_HARDWIRED;
+    vm->micro_step = 0;
+    vm->alu_result = (ALUResult){0};
+    vm->memory_data = 0;
+    vm->fetched_byte = 0;
+}
+
+void set_alu_mode(VM *vm, ALUMode mode, uint32_t verify_interval) {
+    vm->alu_mode = mode;
+    vm->verify_interval = verify_interval ? verify_interval : 1;
+    vm->alu_ops = 0;
+    vm->alu_checked = 0;
+    vm->alu_mismatches = 0;
+}
+
+void set_control_mode(VM *vm, ControlMode mode) {
+    init_microcode();
+    vm->control = mode;
 }
 
 // Main CPU  - classic fetch-decode-execute cycle
@@ -389,24 +1021,135 @@ void run_vm(VM *vm) {
     }
 }
 
-// Legacy compatibility functions for existing microcode system
-uint8_t fetch(VM *vm) {
-    return mem_read(vm, vm->pc++);
+// Quiet run for long programs: no trace, up to max_cycles cycles;
+// returns the cycles run
+uint32_t run_vm_cycles(VM *vm, uint32_t max_cycles) {
+    bool trace = vm->trace;
+    uint32_t cycle = 0;
+
+    vm->trace = false;
+    while (vm->running && cycle < max_cycles) {
+        cpu_fetch(vm);
+        cpu_decode_and_execute(vm);
+        cycle++;
+    }
+    vm->trace = trace;
+    return cycle;
 }
 
-// Keep the existing microcode system for backward compatibility
-#define MAX_MICRO_STEPS 8
-#define NUM_OPCODES 16
+// ===== Lockstep VMs =====
+// The hardwired control unit once for a group of lanes: they share the
+// instruction, so the opcode picks the circuit and the mask picks the
+// lanes it writes to. The ALU is always the bit-sliced gates
 
-MicroInstruction microcode_rom[NUM_OPCODES][MAX_MICRO_STEPS];
-static bool microcode_initialized = false;
+static void execute_lanes(VMLanes *v, Lanes mask, DecodedInstruction decoded) {
+    Lanes8 *a = &v->registers[decoded.reg_a];
 
-void init_microcode(void) {
-    if (microcode_initialized) return;
-    // .. (keep existing microcode init) ..
-    microcode_initialized = true;
+    switch (decoded.opcode) {
+        case OP_ADD: case OP_SUB: case OP_AND: case OP_OR:
+        case OP_XOR: case OP_NOT: case OP_SHL: case OP_SHR: {
+            ALULanes result = enhanced_alu64(a, &v->registers[decoded.reg_b], decoded.opcode);
+            lanes8_select(a, mask, &result.result);
+            v->flags.zero = mux_gate64(mask, result.flags.zero, v->flags.zero);
+            v->flags.carry = mux_gate64(mask, result.flags.carry, v->flags.carry);
+            v->flags.overflow = mux_gate64(mask, result.flags.overflow, v->flags.overflow);
+            v->flags.negative = mux_gate64(mask, result.flags.negative, v->flags.negative);
+            break;
+        }
+
+        case OP_LOAD:
+            lanes8_select(a, mask, &v->memory[decoded.address]);
+            break;
+
+        case OP_STORE:
+            lanes8_select(&v->memory[decoded.address], mask, a);
+            break;
+
+        case OP_JMP:
+        case OP_JZ:
+        case OP_JC: {
+            // each lane decides for itself whether it jumps
+            Lanes taken = mask;
+            if (decoded.opcode == OP_JZ) taken = and_gate64(taken, v->flags.zero);
+            if (decoded.opcode == OP_JC) taken = and_gate64(taken, v->flags.carry);
+            Lanes8 target = lanes8_splat(decoded.address);
+            lanes8_select(&v->pc, taken, &target);
+            break;
+        }
+
+        case OP_HALT:
+            v->running = and_gate64(v->running, not_gate64(mask));
+            break;
+
+        default:
+            break;
+    }
 }
 
-void execute_microinstruction(VM *vm, const MicroInstruction *micro) {
-    // .. (keep existing microcode execution) ..
+// Every lane in use, stopped
+void init_vm_lanes(VMLanes *v, int count) {
+    memset(v, 0, sizeof(*v));
+    v->lanes = count >= MAX_LANES ? ~(Lanes)0 : ((Lanes)1 << count) - 1;
+}
+
+// A VM's registers, memory, PC, flags and running state into a lane
+void vm_lanes_put(VMLanes *v, int lane, const VM *vm) {
+    Lanes bit = (Lanes)1 << lane;
+    for (int r = 0; r < 4; r++) lanes8_set(&v->registers[r], lane, vm->registers[r]);
+    for (int addr = 0; addr < 256; addr++) lanes8_set(&v->memory[addr], lane, vm->memory[addr]);
+    lanes8_set(&v->pc, lane, vm->pc);
+    v->flags.zero = vm->flags.zero ? (v->flags.zero | bit) : (v->flags.zero & ~bit);
+    v->flags.carry = vm->flags.carry ? (v->flags.carry | bit) : (v->flags.carry & ~bit);
+    v->flags.overflow = vm->flags.overflow ? (v->flags.overflow | bit) : (v->flags.overflow & ~bit);
+    v->flags.negative = vm->flags.negative ? (v->flags.negative | bit) : (v->flags.negative & ~bit);
+    v->running = (vm->running && (v->lanes & bit)) ? (v->running | bit) : (v->running & ~bit);
+}
+
+// .. and back out; the rest of *vm is left as it was
+void vm_lanes_get(const VMLanes *v, int lane, VM *vm) {
+    for (int r = 0; r < 4; r++) vm->registers[r] = lanes8_get(&v->registers[r], lane);
+    for (int addr = 0; addr < 256; addr++) vm->memory[addr] = lanes8_get(&v->memory[addr], lane);
+    vm->pc = lanes8_get(&v->pc, lane);
+    vm->flags.zero = (v->flags.zero >> lane) & 1;
+    vm->flags.carry = (v->flags.carry >> lane) & 1;
+    vm->flags.overflow = (v->flags.overflow >> lane) & 1;
+    vm->flags.negative = (v->flags.negative >> lane) & 1;
+    vm->running = (v->running >> lane) & 1;
+}
+
+// One fetch-decode-execute cycle in every running lane. The lowest lane
+// not yet stepped names a PC and the instruction there; all lanes with
+// both the same go as one group, until none are left. Lanes running
+// the same code at the same place cost one instruction between them
+void cpu_decode_and_execute_lanes(VMLanes *v) {
+    Lanes pending = v->running;
+    v->steps++;
+
+    while (pending) {
+        int lane = __builtin_ctzll(pending);
+        uint8_t pc = lanes8_get(&v->pc, lane);
+        uint8_t next = pc + 1;
+        uint8_t low = lanes8_get(&v->memory[pc], lane);
+        uint8_t high = lanes8_get(&v->memory[next], lane);
+        Lanes group = pending & lanes8_equal(&v->pc, pc) &
+                      lanes8_equal(&v->memory[pc], low) & lanes8_equal(&v->memory[next], high);
+        pending &= ~group;
+        v->issues++;
+
+        // FETCH moves these PCs on by 2, before a jump may override them
+        Lanes8 fetched = lanes8_splat(pc + 2);
+        lanes8_select(&v->pc, group, &fetched);
+        execute_lanes(v, group, decode_instruction(low | (high << 8)));
+    }
+}
+
+// Up to max_cycles cycles, until every lane has halted; returns the
+// cycles run
+uint32_t run_vm_lanes(VMLanes *v, uint32_t max_cycles) {
+    uint32_t cycle = 0;
+    while (v->running && cycle < max_cycles) {
+        cpu_decode_and_execute_lanes(v);
+        cycle++;
+    }
+    return cycle;
 }
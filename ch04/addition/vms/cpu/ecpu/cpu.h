@@ -59,6 +59,49 @@ typedef struct {
     ALUFlags flags;
 } ALUResult;
 
+// Bit-sliced: 64 copies of a circuit at once, one per bit of a Lanes
+// word. An 8-bit value is kept as bit planes, bit[i] holding bit i of
+// the value in every lane
+typedef uint64_t Lanes;
+
+#define MAX_LANES 64
+
+typedef struct {
+    Lanes bit[8];
+} Lanes8;
+
+typedef struct {
+    Lanes8 sum;
+    Lanes carry_out;
+    Lanes overflow;
+} AdderLanes;
+
+typedef struct {
+    Lanes zero;
+    Lanes carry;
+    Lanes overflow;
+    Lanes negative;
+} ALUFlagLanes;
+
+typedef struct {
+    Lanes8 result;
+    ALUFlagLanes flags;
+} ALULanes;
+
+// which ALU the CPU uses
+typedef enum {
+    ALU_GATES = 0,     // gate-level: enhanced_alu()
+    ALU_NATIVE,        // native 8-bit operations: native_alu()
+    ALU_LOCKSTEP       // native, every verify_interval-th op also through the gates
+} ALUMode;
+
+// how the control unit carries out an instruction
+typedef enum {
+    CONTROL_HARDWIRED = 0,  // one C case per opcode
+    CONTROL_MICROCODE,      // interpret the microcode ROM, signal by signal
+    CONTROL_COMPILED        // the ROM compiled into micro-op handler lists
+} ControlMode;
+
 // decoded instruction structure
 typedef struct {
     uint8_t opcode;
@@ -76,8 +119,18 @@ typedef struct {
     uint16_t ir;               // Instruction Register (IR)
     ALUFlags flags;            // Status flags
     bool running;              // CPU state
+    bool trace;                // Print every cycle (run_vm)
+    
+    // ALU selection and lockstep statistics
+    ALUMode alu_mode;
+    uint32_t verify_interval;  // ALU_LOCKSTEP: check one op in this many
+    uint32_t alu_ops;          // ALU operations done
+    uint32_t alu_checked;      // .. of which compared with the gates
+    uint32_t alu_mismatches;   // .. and found different
     
-    // Legacy microcode support
+    // Microcode support
+    ControlMode control;
+    DecodedInstruction decoded; // the instruction the micro-ops work on
     uint8_t current_instruction;
     uint8_t micro_step;
     uint8_t fetched_byte;
@@ -85,7 +138,28 @@ typedef struct {
     uint8_t memory_data;
 } VM;
 
-// microcode struct (legacy compatibility)
+// Up to 64 VMs in lockstep, state stored across them (SoA): every
+// register, memory byte and the PC as bit planes, a flag or the running
+// state as one bit per lane. Lanes at the same PC with the same
+// instruction step together, masked; those that took other branches
+// wait for their own turn in the same step
+typedef struct {
+    Lanes8 registers[4];
+    Lanes8 memory[256];
+    Lanes8 pc;
+    ALUFlagLanes flags;
+    Lanes lanes;               // lanes in use
+    Lanes running;             // .. and not halted
+    uint32_t steps;            // cpu_decode_and_execute_lanes() calls
+    uint32_t issues;           // instructions carried out, one per group of lanes
+} VMLanes;
+
+// microcode: the control signals of one micro-step. Register selects
+// name a field of the instruction (MICRO_SEL_REG_A or _B), addresses
+// are its address field unless a register is selected instead
+#define MICRO_SEL_REG_A 0
+#define MICRO_SEL_REG_B 1
+
 typedef struct {
     bool reg_write_enable;
     uint8_t reg_write_select;
@@ -136,6 +210,24 @@ uint8_t bitwise_not_8bit(uint8_t a);
 
 // ALU function
 ALUResult enhanced_alu(uint8_t a, uint8_t b, uint8_t opcode);
+ALUResult native_alu(uint8_t a, uint8_t b, uint8_t opcode);
+ALUResult cpu_alu(VM *vm, uint8_t a, uint8_t b, uint8_t opcode);
+uint32_t alu_verify_all(void);
+
+// the same circuits, bit-sliced
+Lanes and_gate64(Lanes a, Lanes b);
+Lanes or_gate64(Lanes a, Lanes b);
+Lanes xor_gate64(Lanes a, Lanes b);
+Lanes not_gate64(Lanes a);
+Lanes mux_gate64(Lanes select, Lanes a, Lanes b);
+void half_adder64(Lanes a, Lanes b, Lanes *sum, Lanes *carry);
+void full_adder64(Lanes a, Lanes b, Lanes carry_in, Lanes *sum, Lanes *carry_out);
+AdderLanes ripple_carry_adder_8bit64(const Lanes8 *a, const Lanes8 *b, Lanes carry_in);
+ALULanes enhanced_alu64(const Lanes8 *a, const Lanes8 *b, uint8_t opcode);
+Lanes8 lanes8_splat(uint8_t value);
+Lanes lanes8_equal(const Lanes8 *v, uint8_t value);
+void lanes8_set(Lanes8 *v, int lane, uint8_t value);
+uint8_t lanes8_get(const Lanes8 *v, int lane);
 
 // CPU functions
 uint8_t mem_read(VM *vm, uint8_t addr);
@@ -147,11 +239,23 @@ void cpu_decode_and_execute(VM *vm);
 // VM functions
 void init_vm(VM *vm);
 void run_vm(VM *vm);
+void set_alu_mode(VM *vm, ALUMode mode, uint32_t verify_interval);
+uint32_t run_vm_cycles(VM *vm, uint32_t max_cycles);
+
+void set_control_mode(VM *vm, ControlMode mode);
+
+// lockstep VMs
+void init_vm_lanes(VMLanes *v, int count);
+void vm_lanes_put(VMLanes *v, int lane, const VM *vm);
+void vm_lanes_get(const VMLanes *v, int lane, VM *vm);
+void cpu_decode_and_execute_lanes(VMLanes *v);
+uint32_t run_vm_lanes(VMLanes *v, uint32_t max_cycles);
 
-// Legacy compatibility functions
+// Microcode
 uint8_t fetch(VM *vm);
 void execute_microinstruction(VM *vm, const MicroInstruction *micro);
 void init_microcode(void);
+int compiled_micro_ops(uint8_t opcode);  // handlers left after compiling
 
 // Util macros for instruction building
 #define BUILD_TWO_REG_INSTR(opcode, ra, rb) \
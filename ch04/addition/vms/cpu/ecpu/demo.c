@@ -2,6 +2,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
+#include <time.h>
 
 #include "cpu.h"
 
@@ -367,6 +368,127 @@ void demonstrate_logic_gates() {
            add_result.sum, add_result.carry_out, add_result.overflow);
 }
 
+// Store a 16-bit instruction the way cpu_fetch() reads it, low byte first
+static void put_instruction(VM *vm, int *pc, uint16_t instruction) {
+    vm->memory[(*pc)++] = instruction & 0xFF;
+    vm->memory[(*pc)++] = instruction >> 8;
+}
+
+// Nested loops of ALU work: R2 counts down the outer loop, R0 wraps
+// round 256 times in the inner one while R3 is stirred with XOR and SHR
+static void load_alu_workload(VM *vm) {
+    int pc = 0;
+    init_vm(vm);
+    vm->memory[0x41] = 1;    // LOAD R1 reads address 01_000001
+    vm->memory[0x82] = 200;  // LOAD R2 reads address 10_000010
+
+    put_instruction(vm, &pc, ENCODE_INSTRUCTION_IMM(OP_LOAD, 1, 0x41));
+    put_instruction(vm, &pc, ENCODE_INSTRUCTION_IMM(OP_LOAD, 2, 0x82));
+    int loop = pc;
+    put_instruction(vm, &pc, ENCODE_INSTRUCTION(OP_XOR, 3, 0));
+    put_instruction(vm, &pc, ENCODE_INSTRUCTION(OP_SHR, 3, 0));
+    put_instruction(vm, &pc, ENCODE_INSTRUCTION(OP_ADD, 0, 1));
+    put_instruction(vm, &pc, ENCODE_INSTRUCTION_IMM(OP_JZ, 0, pc + 4));
+    put_instruction(vm, &pc, ENCODE_INSTRUCTION_IMM(OP_JMP, 0, loop));
+    put_instruction(vm, &pc, ENCODE_INSTRUCTION(OP_SUB, 2, 1));
+    put_instruction(vm, &pc, ENCODE_INSTRUCTION_IMM(OP_JZ, 0, pc + 4));
+    put_instruction(vm, &pc, ENCODE_INSTRUCTION_IMM(OP_JMP, 0, loop));
+    put_instruction(vm, &pc, ENCODE_INSTRUCTION(OP_HALT, 0, 0));
+}
+
+void demonstrate_alu_modes() {
+    printf("\n--- GATE-LEVEL AND NATIVE ALU ---\n");
+    printf("Every op on every operand pair, native against gates: %u differences\n\n",
+           alu_verify_all());
+
+    const char *names[] = { "gates", "native", "lockstep 1/64" };
+    for (int mode = ALU_GATES; mode <= ALU_LOCKSTEP; mode++) {
+        VM vm;
+        load_alu_workload(&vm);
+        set_alu_mode(&vm, (ALUMode)mode, 64);
+        clock_t start = clock();
+        uint32_t cycles = run_vm_cycles(&vm, 1000000);
+        double ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+        printf("%-14s %u cycles, %u ALU ops (%u checked, %u mismatches), "
+               "R3=%d, %.1f ms\n", names[mode], cycles, vm.alu_ops,
+               vm.alu_checked, vm.alu_mismatches, vm.registers[3], ms);
+    }
+}
+
+void demonstrate_control_modes() {
+    printf("\n--- HARDWIRED, MICROCODED AND COMPILED CONTROL ---\n");
+    printf("Micro-op handlers after compiling: ADD %d, NOT %d, LOAD %d, JZ %d, HALT %d\n\n",
+           compiled_micro_ops(OP_ADD), compiled_micro_ops(OP_NOT), compiled_micro_ops(OP_LOAD),
+           compiled_micro_ops(OP_JZ), compiled_micro_ops(OP_HALT));
+
+    const char *names[] = { "hardwired", "microcode", "compiled" };
+    VM reference;
+    for (int mode = CONTROL_HARDWIRED; mode <= CONTROL_COMPILED; mode++) {
+        VM vm;
+        load_alu_workload(&vm);
+        set_alu_mode(&vm, ALU_NATIVE, 1);
+        set_control_mode(&vm, (ControlMode)mode);
+        clock_t start = clock();
+        uint32_t cycles = run_vm_cycles(&vm, 1000000);
+        double ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+        if (mode == CONTROL_HARDWIRED) reference = vm;
+        bool same = memcmp(vm.registers, reference.registers, sizeof(vm.registers)) == 0 &&
+                    memcmp(vm.memory, reference.memory, sizeof(vm.memory)) == 0 &&
+                    vm.pc == reference.pc && vm.running == reference.running;
+        printf("%-10s %u cycles, R0=%d R1=%d R2=%d R3=%d, %s, %.1f ms\n", names[mode], cycles,
+               vm.registers[0], vm.registers[1], vm.registers[2], vm.registers[3],
+               same ? "same state as hardwired" : "DIFFERENT state", ms);
+    }
+}
+
+// The ALU workload over 64 inputs: lane k counts its outer loop down
+// from k + 1 and starts R0 at 4k, so the lanes leave the inner loop at
+// different times and take different branches from the first pass on.
+// One gate-level VM per input, one after the other, against all of
+// them in lockstep
+void demonstrate_lockstep() {
+    printf("\n--- 64 VMS IN LOCKSTEP ---\n");
+
+    static VM inputs[MAX_LANES], scalar[MAX_LANES];
+    for (int lane = 0; lane < MAX_LANES; lane++) {
+        load_alu_workload(&inputs[lane]);
+        inputs[lane].memory[0x82] = lane + 1;
+        inputs[lane].registers[0] = lane * 4;
+        scalar[lane] = inputs[lane];
+    }
+
+    clock_t start = clock();
+    uint32_t scalar_cycles = 0;
+    for (int lane = 0; lane < MAX_LANES; lane++) {
+        scalar_cycles += run_vm_cycles(&scalar[lane], 1000000);
+    }
+    double scalar_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    static VMLanes lanes;
+    init_vm_lanes(&lanes, MAX_LANES);
+    for (int lane = 0; lane < MAX_LANES; lane++) vm_lanes_put(&lanes, lane, &inputs[lane]);
+    start = clock();
+    uint32_t steps = run_vm_lanes(&lanes, 1000000);
+    double lanes_ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    int same = 0;
+    for (int lane = 0; lane < MAX_LANES; lane++) {
+        VM vm = scalar[lane];
+        vm_lanes_get(&lanes, lane, &vm);
+        if (memcmp(vm.registers, scalar[lane].registers, sizeof(vm.registers)) == 0 &&
+            memcmp(vm.memory, scalar[lane].memory, sizeof(vm.memory)) == 0 &&
+            vm.pc == scalar[lane].pc && vm.running == scalar[lane].running &&
+            memcmp(&vm.flags, &scalar[lane].flags, sizeof(vm.flags)) == 0) {
+            same++;
+        }
+    }
+
+    printf("one at a time  %u cycles in all, %.1f ms\n", scalar_cycles, scalar_ms);
+    printf("lockstep       %u steps, %u instructions issued (%.2f per step), %.1f ms\n",
+           steps, lanes.issues, (double)lanes.issues / steps, lanes_ms);
+    printf("%d of %d lanes end in the same state as their own VM\n", same, MAX_LANES);
+}
+
 int main() {
     printf("ENHANCED CPU SIMULATOR DEMONSTRATION\n");
     printf("------------------------------------=\n");
@@ -382,6 +504,9 @@ int main() {
     demonstrate_alu_operations();
     demonstrate_conditional_branching();
     demonstrate_full_cpu_cycle();
+    demonstrate_alu_modes();
+    demonstrate_control_modes();
+    demonstrate_lockstep();
     
     printf("\n\n");
     printf("This CPU simulator demonstrates:\n");
@@ -177,6 +177,121 @@ ALUResult enhanced_alu(uint8_t a, uint8_t b, uint8_t opcode) {
     return alu_result;
 }
 
+// Bit-sliced gates: a gate on Lanes is the same gate in 64 circuits,
+// each fed its own inputs, for the price of one machine operation.
+// The adders and the ALU below are wired gate for gate like the ones above
+
+Lanes and_gate64(Lanes a, Lanes b) {
+    return a & b;
+}
+
+Lanes or_gate64(Lanes a, Lanes b) {
+    return a | b;
+}
+
+Lanes xor_gate64(Lanes a, Lanes b) {
+    return a ^ b;
+}
+
+Lanes not_gate64(Lanes a) {
+    return ~a;
+}
+
+void half_adder64(Lanes a, Lanes b, Lanes *sum, Lanes *carry) {
+    *sum = xor_gate64(a, b);
+    *carry = and_gate64(a, b);
+}
+
+void full_adder64(Lanes a, Lanes b, Lanes carry_in, Lanes *sum, Lanes *carry_out) {
+    Lanes s1, c1, c2;
+    half_adder64(a, b, &s1, &c1);
+    half_adder64(s1, carry_in, sum, &c2);
+    *carry_out = or_gate64(c1, c2);
+}
+
+AdderLanes ripple_carry_adder_8bit64(const Lanes8 *a, const Lanes8 *b, Lanes carry_in) {
+    AdderLanes result;
+    Lanes carry = carry_in;
+
+    for (int i = 0; i < 8; i++) {
+        full_adder64(a->bit[i], b->bit[i], carry, &result.sum.bit[i], &carry);
+    }
+    result.carry_out = carry;
+
+    Lanes msb_a = a->bit[7], msb_b = b->bit[7], msb_sum = result.sum.bit[7];
+    result.overflow = or_gate64(and_gate64(and_gate64(msb_a, msb_b), not_gate64(msb_sum)),
+                                and_gate64(and_gate64(not_gate64(msb_a), not_gate64(msb_b)), msb_sum));
+    return result;
+}
+
+// The opcode is the same in all lanes: it selects the circuit, the
+// lanes hold the operands
+ALULanes enhanced_alu64(const Lanes8 *a, const Lanes8 *b, uint8_t opcode) {
+    ALULanes alu = {0};
+
+    switch (opcode) {
+        case 0:   // ADD
+        case 1: { // SUB (A - B = A + (~B + 1))
+            Lanes8 operand = *b;
+            if (opcode == 1) {
+                for (int i = 0; i < 8; i++) operand.bit[i] = not_gate64(b->bit[i]);
+            }
+            AdderLanes sum = ripple_carry_adder_8bit64(a, &operand, opcode == 1 ? ~(Lanes)0 : 0);
+            alu.result = sum.sum;
+            alu.flags.carry = sum.carry_out;
+            alu.flags.overflow = sum.overflow;
+            break;
+        }
+        case 2: // AND
+            for (int i = 0; i < 8; i++) alu.result.bit[i] = and_gate64(a->bit[i], b->bit[i]);
+            break;
+        case 3: // OR
+            for (int i = 0; i < 8; i++) alu.result.bit[i] = or_gate64(a->bit[i], b->bit[i]);
+            break;
+        case 4: // XOR
+            for (int i = 0; i < 8; i++) alu.result.bit[i] = xor_gate64(a->bit[i], b->bit[i]);
+            break;
+        case 5: // NOT A
+            for (int i = 0; i < 8; i++) alu.result.bit[i] = not_gate64(a->bit[i]);
+            break;
+        case 6: // SHL A, a shift is wiring: bit i comes from bit i - 1
+            for (int i = 7; i > 0; i--) alu.result.bit[i] = a->bit[i - 1];
+            alu.flags.carry = a->bit[7];
+            break;
+        case 7: // SHR A
+            for (int i = 0; i < 7; i++) alu.result.bit[i] = a->bit[i + 1];
+            alu.flags.carry = a->bit[0];
+            break;
+        default:
+            break;
+    }
+
+    Lanes any = 0;
+    for (int i = 0; i < 8; i++) any = or_gate64(any, alu.result.bit[i]);
+    alu.flags.zero = not_gate64(any);
+    alu.flags.negative = alu.result.bit[7];
+    return alu;
+}
+
+// Turn 64 values into bit planes, values[i] going to lane i
+Lanes8 lanes8_pack(const uint8_t values[64]) {
+    Lanes8 v = {0};
+    for (int lane = 0; lane < 64; lane++) {
+        for (int i = 0; i < 8; i++) {
+            v.bit[i] |= (Lanes)((values[lane] >> i) & 1) << lane;
+        }
+    }
+    return v;
+}
+
+uint8_t lanes8_get(const Lanes8 *v, int lane) {
+    uint8_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= ((v->bit[i] >> lane) & 1) << i;
+    }
+    return value;
+}
+
 // Microcode ROM and init
 
 #define MAX_MICRO_STEPS 8
@@ -397,11 +512,17 @@ void run_vm(VM *vm) {
         }
 
         uint8_t opcode_index = (vm->current_instruction == 0xFF) ? 0x0F : vm->current_instruction;
+        if (opcode_index >= NUM_OPCODES) {
+            // no microcode: skip it rather than read past the ROM
+            printf("    Unknown opcode 0x%02X, skipped\n", vm->current_instruction);
+            cycle++;
+            continue;
+        }
         const MicroInstruction *micro = &microcode_rom[opcode_index][vm->micro_step];
 
         execute_microinstruction(vm, micro);
 
-        if (micro->signals.end_instruction || vm->micro_step >= MAX_MICRO_STEPS) {
+        if (micro->signals.end_instruction || vm->micro_step + 1 >= MAX_MICRO_STEPS) {
             printf("    End of instruction\n");
             vm->micro_step = 0;
         } else {
@@ -52,6 +52,33 @@ typedef struct {
     ALUFlags flags;
 } ALUResult;
 
+// Bit-sliced: 64 copies of a circuit at once, one per bit of a Lanes
+// word. An 8-bit value is kept as bit planes, bit[i] holding bit i of
+// the value in every lane
+typedef uint64_t Lanes;
+
+typedef struct {
+    Lanes bit[8];
+} Lanes8;
+
+typedef struct {
+    Lanes8 sum;
+    Lanes carry_out;
+    Lanes overflow;
+} AdderLanes;
+
+typedef struct {
+    Lanes zero;
+    Lanes carry;
+    Lanes overflow;
+    Lanes negative;
+} ALUFlagLanes;
+
+typedef struct {
+    Lanes8 result;
+    ALUFlagLanes flags;
+} ALULanes;
+
 typedef struct {
     bool reg_write_enable;
     uint8_t reg_write_select;
@@ -109,6 +136,18 @@ uint8_t bitwise_or_8bit(uint8_t a, uint8_t b);
 uint8_t bitwise_xor_8bit(uint8_t a, uint8_t b);
 uint8_t bitwise_not_8bit(uint8_t a);
 ALUResult enhanced_alu(uint8_t a, uint8_t b, uint8_t opcode);
+
+// the same circuits, bit-sliced
+Lanes and_gate64(Lanes a, Lanes b);
+Lanes or_gate64(Lanes a, Lanes b);
+Lanes xor_gate64(Lanes a, Lanes b);
+Lanes not_gate64(Lanes a);
+void half_adder64(Lanes a, Lanes b, Lanes *sum, Lanes *carry);
+void full_adder64(Lanes a, Lanes b, Lanes carry_in, Lanes *sum, Lanes *carry_out);
+AdderLanes ripple_carry_adder_8bit64(const Lanes8 *a, const Lanes8 *b, Lanes carry_in);
+ALULanes enhanced_alu64(const Lanes8 *a, const Lanes8 *b, uint8_t opcode);
+Lanes8 lanes8_pack(const uint8_t values[64]);
+uint8_t lanes8_get(const Lanes8 *v, int lane);
 void init_vm(VM *vm);
 uint8_t fetch(VM *vm);
 void execute_microinstruction(VM *vm, const MicroInstruction *micro);
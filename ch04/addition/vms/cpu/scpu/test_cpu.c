@@ -3,6 +3,7 @@
 #include <stdbool.h>
 #include <string.h>
 #include <assert.h>
+#include <time.h>
 
 #include "cpu.h"
 
@@ -252,6 +253,116 @@ void test_alu_operations() {
 }
 
 
+// Exhaustive sweeps on the bit-sliced circuits, 64 input vectors per
+// evaluation, checked lane by lane against C arithmetic. Lane 0 of every
+// batch also goes through the bool circuits, which must agree
+
+static bool lane_bit(Lanes x, int lane) {
+    return (x >> lane) & 1;
+}
+
+void test_bitsliced_adder_exhaustive() {
+    printf("\n -  bit-sliced adder, all a, b, carry  - \n");
+
+    clock_t start = clock();
+    int wrong = 0, disagree = 0;
+    for (int batch = 0; batch < 256 * 256 * 2 / 64; batch++) {
+        uint8_t av[64], bv[64];
+        Lanes carry_in = 0;
+        for (int lane = 0; lane < 64; lane++) {
+            int v = batch * 64 + lane;
+            av[lane] = v & 0xFF;
+            bv[lane] = (v >> 8) & 0xFF;
+            carry_in |= (Lanes)(v >> 16) << lane;
+        }
+        Lanes8 a = lanes8_pack(av), b = lanes8_pack(bv);
+        AdderLanes r = ripple_carry_adder_8bit64(&a, &b, carry_in);
+
+        for (int lane = 0; lane < 64; lane++) {
+            unsigned total = av[lane] + bv[lane] + lane_bit(carry_in, lane);
+            uint8_t sum = (uint8_t)total;
+            bool overflow = ((av[lane] ^ sum) & (bv[lane] ^ sum) & 0x80) != 0;
+            if (lanes8_get(&r.sum, lane) != sum || lane_bit(r.carry_out, lane) != (total > 0xFF) ||
+                lane_bit(r.overflow, lane) != overflow) {
+                wrong++;
+            }
+        }
+        AdderResult scalar = ripple_carry_adder_8bit(av[0], bv[0], lane_bit(carry_in, 0));
+        if (scalar.sum != lanes8_get(&r.sum, 0) || scalar.carry_out != lane_bit(r.carry_out, 0) ||
+            scalar.overflow != lane_bit(r.overflow, 0)) {
+            disagree++;
+        }
+    }
+    double ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    printf("131072 additions in %.1f ms\n", ms);
+    TEST_ASSERT(wrong == 0, "Bit-sliced Adder: every a + b + carry");
+    TEST_ASSERT(disagree == 0, "Bit-sliced Adder: agrees with the bool adder");
+}
+
+void test_bitsliced_alu_exhaustive() {
+    printf("\n -  bit-sliced ALU, all ops, a, b  - \n");
+
+    clock_t start = clock();
+    int wrong = 0, disagree = 0;
+    for (int op = 0; op < 8; op++) {
+        for (int batch = 0; batch < 256 * 256 / 64; batch++) {
+            uint8_t av[64], bv[64];
+            for (int lane = 0; lane < 64; lane++) {
+                int v = batch * 64 + lane;
+                av[lane] = v & 0xFF;
+                bv[lane] = v >> 8;
+            }
+            Lanes8 a = lanes8_pack(av), b = lanes8_pack(bv);
+            ALULanes r = enhanced_alu64(&a, &b, op);
+
+            for (int lane = 0; lane < 64; lane++) {
+                uint8_t x = av[lane], y = bv[lane];
+                uint8_t result = 0;
+                bool carry = false, overflow = false;
+                switch (op) {
+                    case 0:
+                    case 1: {
+                        uint8_t yy = op == 0 ? y : (uint8_t)~y;
+                        unsigned total = x + yy + op;
+                        result = (uint8_t)total;
+                        carry = total > 0xFF;
+                        overflow = ((x ^ result) & (yy ^ result) & 0x80) != 0;
+                        break;
+                    }
+                    case 2: result = x & y; break;
+                    case 3: result = x | y; break;
+                    case 4: result = x ^ y; break;
+                    case 5: result = ~x; break;
+                    case 6: result = x << 1; carry = x & 0x80; break;
+                    case 7: result = x >> 1; carry = x & 0x01; break;
+                }
+                if (lanes8_get(&r.result, lane) != result ||
+                    lane_bit(r.flags.zero, lane) != (result == 0) ||
+                    lane_bit(r.flags.negative, lane) != ((result & 0x80) != 0) ||
+                    lane_bit(r.flags.carry, lane) != carry ||
+                    lane_bit(r.flags.overflow, lane) != overflow) {
+                    wrong++;
+                }
+            }
+            ALUResult scalar = enhanced_alu(av[0], bv[0], op);
+            if (scalar.result != lanes8_get(&r.result, 0) ||
+                scalar.flags.zero != lane_bit(r.flags.zero, 0) ||
+                scalar.flags.carry != lane_bit(r.flags.carry, 0) ||
+                scalar.flags.overflow != lane_bit(r.flags.overflow, 0) ||
+                scalar.flags.negative != lane_bit(r.flags.negative, 0)) {
+                disagree++;
+            }
+        }
+    }
+    double ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+
+    printf("524288 ALU operations in %.1f ms\n", ms);
+    TEST_ASSERT(wrong == 0, "Bit-sliced ALU: every op on every a, b");
+    TEST_ASSERT(disagree == 0, "Bit-sliced ALU: agrees with the bool ALU");
+}
+
+
 void test_vm_initialization() {
     printf("\n -  VM init  - \n");
     
@@ -515,6 +626,8 @@ int main() {
     test_ripple_carry_adder();
     test_bitwise_operations();
     test_alu_operations();
+    test_bitsliced_adder_exhaustive();
+    test_bitsliced_alu_exhaustive();
     test_vm_initialization();
     test_vm_fetch();
     test_microcode_initialization();
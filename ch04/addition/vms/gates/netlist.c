@@ -0,0 +1,251 @@
+// netlist.c - gate netlists compiled for simulation, see netlist.h
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "netlist.h"
+
+static void *nl_grow(void *p, int *cap, int need, size_t size) {
+    if (need <= *cap) return p;
+    int cap2 = *cap ? *cap : 64;
+    while (cap2 < need) cap2 *= 2;
+    p = realloc(p, (size_t)cap2 * size);
+    if (!p) {
+        fprintf(stderr, "netlist: out of memory\n");
+        exit(1);
+    }
+    *cap = cap2;
+    return p;
+}
+
+static void *nl_calloc(size_t n, size_t size) {
+    void *p = calloc(n ? n : 1, size);
+    if (!p) {
+        fprintf(stderr, "netlist: out of memory\n");
+        exit(1);
+    }
+    return p;
+}
+
+void nl_init(Netlist *nl) {
+    memset(nl, 0, sizeof(*nl));
+    nl_input(nl);               // NET_ZERO
+    nl_input(nl);               // NET_ONE
+    nl->value[NET_ONE] = 1;
+}
+
+void nl_free(Netlist *nl) {
+    free(nl->value);
+    free(nl->gates);
+    free(nl->flops);
+    free(nl->flop_of);
+    free(nl->net_level);
+    free(nl->fanout_start);
+    free(nl->fanout);
+    free(nl->queue);
+    free(nl->queue_start);
+    free(nl->queue_count);
+    free(nl->queued);
+    memset(nl, 0, sizeof(*nl));
+}
+
+
+// Building
+
+Net nl_input(Netlist *nl) {
+    int cap = nl->net_cap;      // value and flop_of grow together
+    nl->value = nl_grow(nl->value, &nl->net_cap, nl->nets + 1, sizeof(uint8_t));
+    nl->flop_of = nl_grow(nl->flop_of, &cap, nl->nets + 1, sizeof(int));
+    nl->value[nl->nets] = 0;
+    nl->flop_of[nl->nets] = -1;
+    return nl->nets++;
+}
+
+Net nl_gate(Netlist *nl, GateOp op, Net a, Net b) {
+    if (nl->compiled || a >= nl->nets || b >= nl->nets) {
+        fprintf(stderr, "netlist: bad gate\n");
+        exit(1);
+    }
+    Net out = nl_input(nl);
+    nl->gates = nl_grow(nl->gates, &nl->gate_cap, nl->gate_count + 1, sizeof(Gate));
+    nl->gates[nl->gate_count++] = (Gate){ (uint8_t)op, a, b, out };
+    return out;
+}
+
+Net nl_not(Netlist *nl, Net a) { return nl_gate(nl, G_NOT, a, NET_ZERO); }
+Net nl_and(Netlist *nl, Net a, Net b) { return nl_gate(nl, G_AND, a, b); }
+Net nl_or(Netlist *nl, Net a, Net b) { return nl_gate(nl, G_OR, a, b); }
+Net nl_xor(Netlist *nl, Net a, Net b) { return nl_gate(nl, G_XOR, a, b); }
+
+// Until connected a flip-flop keeps its state
+Net nl_flop(Netlist *nl) {
+    Net q = nl_input(nl);
+    nl->flops = nl_grow(nl->flops, &nl->flop_cap, nl->flop_count + 1, sizeof(Flop));
+    nl->flops[nl->flop_count] = (Flop){ q, q, NET_ZERO };
+    nl->flop_of[q] = nl->flop_count++;
+    return q;
+}
+
+void nl_flop_connect(Netlist *nl, Net q, Net d, Net enable) {
+    int f = nl->flop_of[q];
+    if (f < 0 || d >= nl->nets || enable >= nl->nets) {
+        fprintf(stderr, "netlist: bad flip-flop\n");
+        exit(1);
+    }
+    nl->flops[f].d = d;
+    nl->flops[f].enable = enable;
+}
+
+
+// Compiling
+
+static uint8_t gate_value(const Netlist *nl, const Gate *g) {
+    uint8_t a = nl->value[g->a], b = nl->value[g->b];
+    switch (g->op) {
+        case G_NOT: return a ^ 1;
+        case G_AND: return a & b;
+        case G_OR:  return a | b;
+        default:    return a ^ b;
+    }
+}
+
+// Gates are created after their inputs, so creation order is already
+// topological and one pass gives every level. A counting sort on the
+// level then puts each level's gates next to each other
+void nl_compile(Netlist *nl) {
+    int n = nl->nets, g = nl->gate_count;
+    nl->net_level = nl_calloc((size_t)n, sizeof(int));
+
+    int levels = 0;
+    for (int i = 0; i < g; i++) {
+        const Gate *gt = &nl->gates[i];
+        int la = nl->net_level[gt->a], lb = nl->net_level[gt->b];
+        int level = 1 + (la > lb ? la : lb);
+        nl->net_level[gt->out] = level;
+        if (level > levels) levels = level;
+    }
+    nl->levels = levels;
+
+    nl->queue_start = nl_calloc((size_t)levels + 2, sizeof(int));
+    nl->queue_count = nl_calloc((size_t)levels + 2, sizeof(int));
+    for (int i = 0; i < g; i++) nl->queue_start[nl->net_level[nl->gates[i].out] + 1]++;
+    for (int l = 1; l <= levels + 1; l++) nl->queue_start[l] += nl->queue_start[l - 1];
+
+    Gate *sorted = nl_calloc((size_t)g, sizeof(Gate));
+    int *fill = nl_calloc((size_t)levels + 1, sizeof(int));
+    for (int i = 0; i < g; i++) {
+        int level = nl->net_level[nl->gates[i].out];
+        sorted[nl->queue_start[level] + fill[level]++] = nl->gates[i];
+    }
+    free(fill);
+    free(nl->gates);
+    nl->gates = sorted;
+    nl->gate_cap = g;
+
+    // Fan-out: for each net the gates that read it
+    nl->fanout_start = nl_calloc((size_t)n + 1, sizeof(int));
+    nl->fanout = nl_calloc((size_t)g * 2, sizeof(int));
+    for (int i = 0; i < g; i++) {
+        nl->fanout_start[nl->gates[i].a + 1]++;
+        if (nl->gates[i].op != G_NOT) nl->fanout_start[nl->gates[i].b + 1]++;
+    }
+    for (int i = 0; i < n; i++) nl->fanout_start[i + 1] += nl->fanout_start[i];
+    int *pos = nl_calloc((size_t)n, sizeof(int));
+    for (int i = 0; i < g; i++) {
+        Net a = nl->gates[i].a, b = nl->gates[i].b;
+        nl->fanout[nl->fanout_start[a] + pos[a]++] = i;
+        if (nl->gates[i].op != G_NOT) nl->fanout[nl->fanout_start[b] + pos[b]++] = i;
+    }
+    free(pos);
+
+    nl->queue = nl_calloc((size_t)g, sizeof(int));
+    nl->queued = nl_calloc((size_t)g, sizeof(uint8_t));
+
+    // Flip-flops that can never load go last, out of nl_clock()'s way
+    int c = 0;
+    for (int f = 0; f < nl->flop_count; f++) {
+        if (nl->flops[f].enable != NET_ZERO) {
+            Flop t = nl->flops[c];
+            nl->flops[c++] = nl->flops[f];
+            nl->flops[f] = t;
+        }
+    }
+    nl->clocked_count = c;
+    for (int f = 0; f < nl->flop_count; f++) nl->flop_of[nl->flops[f].q] = f;
+
+    nl->compiled = 1;
+    nl_eval_full(nl);
+}
+
+
+// Simulating
+
+static void schedule_fanout(Netlist *nl, Net n) {
+    for (int k = nl->fanout_start[n]; k < nl->fanout_start[n + 1]; k++) {
+        int g = nl->fanout[k];
+        if (nl->queued[g]) continue;
+        nl->queued[g] = 1;
+        int level = nl->net_level[nl->gates[g].out];
+        nl->queue[nl->queue_start[level] + nl->queue_count[level]++] = g;
+    }
+}
+
+void nl_set(Netlist *nl, Net n, uint8_t v) {
+    v &= 1;
+    if (nl->value[n] == v) return;
+    nl->value[n] = v;
+    if (nl->compiled) schedule_fanout(nl, n);
+}
+
+// A gate only feeds higher levels, so when a level is done nothing can
+// queue more of it: each gate is evaluated at most once
+void nl_eval(Netlist *nl) {
+    for (int level = 1; level <= nl->levels; level++) {
+        int *q = &nl->queue[nl->queue_start[level]];
+        int count = nl->queue_count[level];
+        for (int i = 0; i < count; i++) {
+            const Gate *g = &nl->gates[q[i]];
+            nl->queued[q[i]] = 0;
+            uint8_t v = gate_value(nl, g);
+            if (v != nl->value[g->out]) {
+                nl->value[g->out] = v;
+                schedule_fanout(nl, g->out);
+            }
+        }
+        nl->evaluated += count;
+        nl->queue_count[level] = 0;
+    }
+}
+
+void nl_eval_full(Netlist *nl) {
+    for (int i = 0; i < nl->gate_count; i++) {
+        const Gate *g = &nl->gates[i];
+        nl->value[g->out] = gate_value(nl, g);
+        nl->queued[i] = 0;
+    }
+    nl->evaluated += nl->gate_count;
+    for (int level = 0; level <= nl->levels; level++) nl->queue_count[level] = 0;
+}
+
+void nl_clock(Netlist *nl) {
+    // Sample every d before any q moves: q of one may be d of another
+    int changed[nl->clocked_count ? nl->clocked_count : 1];
+    int count = 0;
+    for (int f = 0; f < nl->clocked_count; f++) {
+        const Flop *ff = &nl->flops[f];
+        if (nl->value[ff->enable] && nl->value[ff->d] != nl->value[ff->q]) changed[count++] = f;
+    }
+    for (int i = 0; i < count; i++) {
+        Net q = nl->flops[changed[i]].q;
+        nl_set(nl, q, nl->value[q] ^ 1);
+    }
+}
+
+void nl_set_word(Netlist *nl, const Net *bits, int width, unsigned v) {
+    for (int i = 0; i < width; i++) nl_set(nl, bits[i], (v >> i) & 1);
+}
+
+unsigned nl_get_word(const Netlist *nl, const Net *bits, int width) {
+    unsigned v = 0;
+    for (int i = 0; i < width; i++) v |= (unsigned)nl->value[bits[i]] << i;
+    return v;
+}
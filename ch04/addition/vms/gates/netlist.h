@@ -0,0 +1,84 @@
+// netlist.h - gate netlists compiled for simulation
+// Nets are single bits. Gates read one or two nets and drive a new one,
+// flip-flops hold state between clocks. nl_compile() sorts the gates by
+// level (the longest path to them from a flip-flop or an input) into one
+// flat list; after that a change is only followed through the gates it
+// can reach, level by level, instead of recomputing everything
+#ifndef NETLIST_H
+#define NETLIST_H
+
+#include <stdint.h>
+
+typedef int Net;
+
+#define NET_ZERO 0   // constant nets, there in every netlist
+#define NET_ONE  1
+
+typedef enum { G_NOT, G_AND, G_OR, G_XOR } GateOp;
+
+typedef struct {
+    uint8_t op;
+    Net a, b;        // b unused by G_NOT
+    Net out;
+} Gate;
+
+typedef struct {
+    Net q;           // output, a source for the gates
+    Net d;           // sampled at the clock ..
+    Net enable;      // .. when this is 1
+} Flop;
+
+typedef struct {
+    uint8_t *value;          // per net
+    int nets, net_cap;
+    Gate *gates;             // in creation order, then in level order
+    int gate_count, gate_cap;
+    Flop *flops;
+    int flop_count, flop_cap;
+    int *flop_of;            // per net: its flop, or -1
+
+    // from nl_compile()
+    int compiled;
+    int levels;              // gates are on levels 1 .. levels
+    int *net_level;          // per net, 0 for sources
+    int *fanout_start;       // per net: gates reading it are
+    int *fanout;             // fanout[fanout_start[n] .. fanout_start[n + 1])
+    int *queue;              // gates waiting, a slice per level
+    int *queue_start, *queue_count;
+    uint8_t *queued;         // per gate
+    int clocked_count;       // flops whose enable is not NET_ZERO come first
+
+    uint64_t evaluated;      // gate evaluations so far
+} Netlist;
+
+void nl_init(Netlist *nl);
+void nl_free(Netlist *nl);
+
+// Building; a gate's inputs must exist already, so logic without
+// flip-flops cannot loop
+Net nl_input(Netlist *nl);
+Net nl_gate(Netlist *nl, GateOp op, Net a, Net b);
+Net nl_not(Netlist *nl, Net a);
+Net nl_and(Netlist *nl, Net a, Net b);
+Net nl_or(Netlist *nl, Net a, Net b);
+Net nl_xor(Netlist *nl, Net a, Net b);
+Net nl_flop(Netlist *nl);                                 // returns q
+void nl_flop_connect(Netlist *nl, Net q, Net d, Net enable);
+
+// Levelise, build fan-out lists, evaluate everything once
+void nl_compile(Netlist *nl);
+
+// Simulating. nl_set() changes an input or the state of a flip-flop,
+// nl_eval() brings the gates up to date with the changes since the last
+// call, nl_eval_full() recomputes every gate in level order
+void nl_set(Netlist *nl, Net n, uint8_t v);
+static inline uint8_t nl_get(const Netlist *nl, Net n) { return nl->value[n]; }
+void nl_eval(Netlist *nl);
+void nl_eval_full(Netlist *nl);
+void nl_clock(Netlist *nl);   // all enabled flip-flops take d at once
+
+// Words as arrays of nets, bit 0 first
+void nl_set_word(Netlist *nl, const Net *bits, int width, unsigned v);
+unsigned nl_get_word(const Netlist *nl, const Net *bits, int width);
+
+#endif // NETLIST_H
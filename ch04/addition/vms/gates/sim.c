@@ -1,6 +1,9 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "netlist.h"
 
 // Word size: 4-bit
 #define WORD_SIZE 4
@@ -208,14 +211,265 @@ void load_program() {
     ram_write(&ram, 3, 0b1100, 1, 1);  // HALT
 }
 
-int main() {
+void cpu_init() {
     reg_init(&pc);
     reg_init(&acc);
     reg_init(&ir);
     reg_init(&mar);
     reg_init(&mdr);
     ram_init(&ram);
+    zero_flag = ovf_flag = 0;
+}
+
+
+// The same CPU as a netlist, of any word size from 4 to 10 bits: the
+// opcode is in the top two bits of an instruction, the operand below,
+// and RAM has a word for every address. One clock does a whole
+// cpu_cycle(): IR and MAR load from RAM[PC] and PC, PC counts up, and
+// ACC and the flags take the ALU result for the instruction being loaded
+
+#define NET_MAX_WIDTH 10
+
+typedef struct {
+    Netlist nl;
+    int width, words;
+    Net pc[NET_MAX_WIDTH], acc[NET_MAX_WIDTH], ir[NET_MAX_WIDTH], mar[NET_MAX_WIDTH];
+    Net zero, ovf;
+    Net *ram;              // words * width flip-flops, word i at ram[i * width]
+    Net halt;              // the instruction at PC is HALT: do not clock
+    Net alu_op0, alu_op1, reg_load, mem_read, alu_src;
+} NetCPU;
+
+static Net nl_mux2(Netlist* nl, Net a, Net b, Net sel) {
+    return nl_or(nl, nl_and(nl, a, nl_not(nl, sel)), nl_and(nl, b, sel));
+}
+
+// Ripple-carry adder of two half adders per bit, like adder()
+static Net nl_adder(Netlist* nl, const Net* x, const Net* y, Net* sum, int width) {
+    Net carry = NET_ZERO;
+    for (int i = 0; i < width; i++) {
+        Net s1 = nl_xor(nl, x[i], y[i]), c1 = nl_and(nl, x[i], y[i]);
+        sum[i] = nl_xor(nl, s1, carry);
+        Net c2 = nl_and(nl, s1, carry);
+        carry = nl_or(nl, c1, c2);
+    }
+    return carry;
+}
+
+// Decoder: line[i] is 1 when addr is i. Each half of the address is
+// decoded first and the lines are ANDs of one from each half, so when
+// the address moves by one only a few lines near it change
+static void nl_decoder(Netlist* nl, const Net* addr, int bits, Net* line) {
+    if (bits <= 1) {
+        line[0] = bits ? nl_not(nl, addr[0]) : NET_ONE;
+        if (bits) line[1] = addr[0];
+        return;
+    }
+    int lo = bits / 2, hi = bits - lo;
+    Net* lo_line = malloc(sizeof(Net) << lo);
+    Net* hi_line = malloc(sizeof(Net) << hi);
+    if (!lo_line || !hi_line) exit(1);
+    nl_decoder(nl, addr, lo, lo_line);
+    nl_decoder(nl, addr + lo, hi, hi_line);
+    for (int i = 0; i < (1 << bits); i++) {
+        line[i] = nl_and(nl, lo_line[i & ((1 << lo) - 1)], hi_line[i >> lo]);
+    }
+    free(lo_line);
+    free(hi_line);
+}
+
+// OR of n nets as a balanced tree, n - 1 gates log2(n) deep; overwrites terms
+static Net nl_or_tree(Netlist* nl, Net* terms, int n) {
+    if (n == 0) return NET_ZERO;
+    for (; n > 1; n = (n + 1) / 2) {
+        for (int i = 0; i < n / 2; i++) terms[i] = nl_or(nl, terms[2 * i], terms[2 * i + 1]);
+        if (n & 1) terms[n / 2] = terms[n - 1];
+    }
+    return terms[0];
+}
+
+// A read port: the decoder selects a word, an OR of ANDs per bit passes it on
+static void nl_ram_read(NetCPU* c, const Net* addr, int addr_bits, Net* out) {
+    Netlist* nl = &c->nl;
+    int words = 1 << addr_bits;
+    Net* line = malloc(sizeof(Net) * words);
+    Net* terms = malloc(sizeof(Net) * words);
+    if (!line || !terms) exit(1);
+    nl_decoder(nl, addr, addr_bits, line);
+    for (int b = 0; b < c->width; b++) {
+        for (int i = 0; i < words; i++) terms[i] = nl_and(nl, line[i], c->ram[i * c->width + b]);
+        out[b] = nl_or_tree(nl, terms, words);
+    }
+    free(line);
+    free(terms);
+}
+
+void netcpu_build(NetCPU* c, int width) {
+    Netlist* nl = &c->nl;
+    int w = width, operand_bits = width - 2;
+    nl_init(nl);
+    c->width = width;
+    c->words = 1 << width;
+    for (int b = 0; b < w; b++) {
+        c->pc[b] = nl_flop(nl);
+        c->acc[b] = nl_flop(nl);
+        c->ir[b] = nl_flop(nl);
+        c->mar[b] = nl_flop(nl);
+    }
+    c->zero = nl_flop(nl);
+    c->ovf = nl_flop(nl);
+    c->ram = malloc(sizeof(Net) * c->words * w);
+    if (!c->ram) exit(1);
+    for (int i = 0; i < c->words * w; i++) c->ram[i] = nl_flop(nl);   // no writes: never load
+
+    // fetch
+    Net instr[NET_MAX_WIDTH], one[NET_MAX_WIDTH] = {0}, pc_inc[NET_MAX_WIDTH];
+    nl_ram_read(c, c->pc, w, instr);
+    for (int b = 0; b < w; b++) one[b] = b == 0 ? NET_ONE : NET_ZERO;
+    nl_adder(nl, c->pc, one, pc_inc, w);
+
+    // control unit, as control_unit()
+    Net op0 = instr[w - 2], op1 = instr[w - 1];
+    Net op_both = nl_and(nl, op1, op0);
+    c->alu_op0 = op0;
+    c->alu_op1 = op1;
+    c->reg_load = nl_not(nl, op_both);
+    c->mem_read = op_both;
+    c->halt = op_both;
+    c->alu_src = c->mem_read;
+
+    // ALU B is the operand or RAM[operand]
+    Net operand[NET_MAX_WIDTH] = {0}, loaded[NET_MAX_WIDTH], alu_b[NET_MAX_WIDTH] = {0};
+    for (int b = 0; b < w; b++) operand[b] = b < operand_bits ? instr[b] : NET_ZERO;
+    nl_ram_read(c, operand, operand_bits, loaded);
+    for (int b = 0; b < w; b++) alu_b[b] = nl_mux2(nl, operand[b], loaded[b], c->alu_src);
+
+    // ALU: ADD, AND, OR, or B, selected by op1 op0
+    Net sum[NET_MAX_WIDTH], result[NET_MAX_WIDTH];
+    Net carry = nl_adder(nl, c->acc, alu_b, sum, w);
+    Net any = NET_ZERO;
+    for (int b = 0; b < w; b++) {
+        Net and_ = nl_and(nl, c->acc[b], alu_b[b]);
+        Net or_ = nl_or(nl, c->acc[b], alu_b[b]);
+        result[b] = nl_mux2(nl, nl_mux2(nl, sum[b], and_, op0), nl_mux2(nl, or_, alu_b[b], op0), op1);
+        any = nl_or(nl, any, result[b]);
+    }
+    Net is_add = nl_and(nl, nl_not(nl, op0), nl_not(nl, op1));
+
+    for (int b = 0; b < w; b++) {
+        nl_flop_connect(nl, c->pc[b], pc_inc[b], NET_ONE);
+        nl_flop_connect(nl, c->mar[b], c->pc[b], NET_ONE);
+        nl_flop_connect(nl, c->ir[b], instr[b], NET_ONE);
+        nl_flop_connect(nl, c->acc[b], result[b], c->reg_load);
+    }
+    nl_flop_connect(nl, c->zero, nl_not(nl, any), c->reg_load);
+    nl_flop_connect(nl, c->ovf, nl_and(nl, carry, is_add), c->reg_load);
+
+    nl_compile(nl);
+}
+
+void netcpu_free(NetCPU* c) {
+    nl_free(&c->nl);
+    free(c->ram);
+}
+
+void netcpu_poke(NetCPU* c, int addr, unsigned v) {
+    nl_set_word(&c->nl, &c->ram[addr * c->width], c->width, v);
+}
+
+// One cycle; returns 1, without clocking, when at a HALT. With full set
+// every gate is evaluated, else only those downstream of a change
+int netcpu_cycle(NetCPU* c, int full) {
+    if (full) nl_eval_full(&c->nl);
+    else nl_eval(&c->nl);
+    if (nl_get(&c->nl, c->halt)) return 1;
+    nl_clock(&c->nl);
+    return 0;
+}
+
+// Random program without HALT; the PC wraps round RAM
+static unsigned random_instruction(int width) {
+    unsigned opcode = rand() % 3;
+    return (opcode << (width - 2)) | (rand() & ((1u << (width - 2)) - 1));
+}
+
+static int netcpu_matches(NetCPU* c) {
+    Netlist* nl = &c->nl;
+    nl_eval(nl);
+    return nl_get_word(nl, c->pc, 4) == reg_read(&pc) && nl_get_word(nl, c->acc, 4) == reg_read(&acc) &&
+           nl_get_word(nl, c->ir, 4) == reg_read(&ir) && nl_get_word(nl, c->mar, 4) == reg_read(&mar) &&
+           nl_get(nl, c->zero) == zero_flag && nl_get(nl, c->ovf) == ovf_flag;
+}
+
+// Check the 4-bit netlist against cpu_cycle(), then time larger ones
+void netlist_demo() {
+    NetCPU c;
+    int bad = 0;
+    srand(1);
+    netcpu_build(&c, WORD_SIZE);
+    for (int run = 0; run < 200; run++) {
+        cpu_init();
+        for (int i = 0; i < MEM_SIZE; i++) {
+            unsigned v = run == 0 && i < 4 ? (unsigned[]){1, 7, 10, 12}[i] : random_instruction(WORD_SIZE);
+            ram_write(&ram, i, v, 1, 1);
+            netcpu_poke(&c, i, v);
+        }
+        nl_set_word(&c.nl, c.pc, 4, 0); nl_set_word(&c.nl, c.acc, 4, 0);
+        nl_set_word(&c.nl, c.ir, 4, 0); nl_set_word(&c.nl, c.mar, 4, 0);
+        nl_set(&c.nl, c.zero, 0); nl_set(&c.nl, c.ovf, 0);
+        for (int cycle = 0; cycle < 40; cycle++) {
+            uint8_t opcode = (ram_read(&ram, reg_read(&pc)) >> 2) & 3;
+            int halted = control_unit(opcode).halt;
+            if (halted != netcpu_cycle(&c, 0)) bad++;
+            if (halted) break;
+            cpu_cycle();
+            if (!netcpu_matches(&c)) bad++;
+        }
+    }
+    netcpu_free(&c);
+    printf("4-bit netlist against cpu_cycle(), 200 programs: %d differences\n", bad);
+
+    const int cycles = 20000;
+    cpu_init();
+    for (int i = 0; i < MEM_SIZE; i++) ram_write(&ram, i, random_instruction(WORD_SIZE), 1, 1);
+    clock_t start = clock();
+    for (int i = 0; i < cycles; i++) cpu_cycle();
+    double s = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("cpu_cycle(), the gate functions called directly: %.0f cycles/s\n\n", s > 0 ? cycles / s : 0);
+
+    printf("width  words  gates  levels  gate evals/cycle  full: cycles/s  event-driven: cycles/s\n");
+    for (int width = 4; width <= NET_MAX_WIDTH; width += 2) {
+        double rate[2], evals = 0;
+        unsigned acc_value[2];
+        int gates = 0, levels = 0;
+        for (int full = 1; full >= 0; full--) {
+            srand(width);
+            netcpu_build(&c, width);
+            for (int i = 0; i < c.words; i++) netcpu_poke(&c, i, random_instruction(width));
+            uint64_t before = c.nl.evaluated;
+            clock_t start = clock();
+            for (int i = 0; i < cycles; i++) netcpu_cycle(&c, full);
+            double s = (double)(clock() - start) / CLOCKS_PER_SEC;
+            rate[full] = s > 0 ? cycles / s : 0;
+            nl_eval(&c.nl);
+            acc_value[full] = nl_get_word(&c.nl, c.acc, width);
+            evals = (double)(c.nl.evaluated - before) / cycles;
+            gates = c.nl.gate_count;
+            levels = c.nl.levels;
+            netcpu_free(&c);
+        }
+        printf("%5d  %5d  %5d  %6d  %16.0f  %14.0f  %22.0f%s\n", width, 1 << width, gates,
+               levels, evals, rate[1], rate[0], acc_value[0] == acc_value[1] ? "" : "  (ACC differs!)");
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "netlist") == 0) {
+        netlist_demo();
+        return 0;
+    }
 
+    cpu_init();
     load_program();
 
     printf("[\n");
@@ -278,7 +532,8 @@ int main() {
     return 0;
 }
 
-// gcc sim.c -o sim && ./sim
+// gcc sim.c netlist.c -o sim && ./sim
+// ./sim netlist   checks the netlist version and times it
 
 /* the simulator to a 4-bit system (for brevity, as full gate-level gets verbose) where registers are built from D flip-flops (simulated with NAND gates), multiplexers from gates, and the control unit is a hardwired combinational circuit using gates to generate signals like ALU op codes, load enables, etc.
 The CPU now has multiple registers (PC, ACC, IR, MAR, MDR), a multi-cycle fetch-decode-execute (simplified into one cycle function), and control signals decoded via gates. The ALU is selected via control lines. Instructions are 4-bit (2-bit opcode, 2-bit operand), with a tiny set: ADD imm, AND imm, OR imm, HALT. (I skipped SUB/LOAD/STORE for code length, but they can be added similarly.)
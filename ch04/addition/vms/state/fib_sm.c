@@ -1,15 +1,22 @@
 // fib_sm.c – Fibonacci sequence generator driven purely by state machine
-// compile:  gcc -std=c99 -O2 -Wall -Wextra -o fib_demo fib_sm.c
+// compile:  gcc -std=c99 -O2 -Wall -Wextra -I../../../../ch01/addition/big
+//           -o fib_demo fib_sm.c ../../../../ch01/addition/big/bigint.c
+// run `./fib_demo bench` for the benchmark up to n = 10^6
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bigint.h"
 
 typedef enum {
     FIB_UNINIT = 0,    // Uninitialised state
     FIB_INIT,          // Ready to start, n=0 case
     FIB_FIRST,         // Computing F(1) = 1
     FIB_COMPUTING,     // Computing F(n) where n >= 2
+    FIB_DOUBLING,      // Computing F(n) by fast doubling, any size
     FIB_COMPLETE,      // Result ready
     FIB_OVERFLOW,      // Arithmetic overflow detected
     FIB_ERROR          // Invalid operation
@@ -21,7 +28,8 @@ typedef enum {
     FEV_GET_RESULT,    // Get current result, writes to *param_out
     FEV_GET_N,         // Get current n being computed, writes to *param_out
     FEV_RESET,         // Reset to uninit state
-    FEV_GET_STATE      // Get current state code, writes to *param_out
+    FEV_GET_STATE,     // Get current state code, writes to *param_out
+    FEV_INIT_FAST      // Init for F(n) by fast doubling, param_in = target n
 } FibEvent;
 
 typedef struct {
@@ -30,6 +38,11 @@ typedef struct {
     int         target_n;    // Target index we're computing towards
     int         current_n;   // Current index i
     FibState    state;       // Current state
+    // Fast doubling: big = F(i), big_next = F(i+1), where i is the
+    // bits of target_n above bit
+    bool        fast;        // Started by FEV_INIT_FAST
+    BigInt      big, big_next, tmp;
+    int         bit;
 } FibSM;
 
 static const char* fib_state_name(FibState s) {
@@ -38,6 +51,7 @@ static const char* fib_state_name(FibState s) {
         case FIB_INIT:      return "INIT";
         case FIB_FIRST:     return "FIRST";
         case FIB_COMPUTING: return "COMPUTING";
+        case FIB_DOUBLING:  return "DOUBLING";
         case FIB_COMPLETE:  return "COMPLETE";
         case FIB_OVERFLOW:  return "OVERFLOW";
         case FIB_ERROR:     return "ERROR";
@@ -68,6 +82,7 @@ bool fib_step(FibSM *sm, FibEvent ev, int param_in, uint64_t *param_out) {
         
         sm->target_n = param_in;
         sm->current_n = 0;
+        sm->fast = false;
         
         if (param_in == 0) {
             sm->current = 0;
@@ -85,8 +100,51 @@ bool fib_step(FibSM *sm, FibEvent ev, int param_in, uint64_t *param_out) {
         return true;
     }
 
+    case FEV_INIT_FAST: {
+        if (param_in < 0) {
+            sm->state = FIB_ERROR;
+            return true;
+        }
+        
+        sm->target_n = param_in;
+        sm->current_n = 0;
+        sm->current = 0;
+        sm->previous = 0;
+        bi_set_u64(&sm->big, 0);        // F(0)
+        bi_set_u64(&sm->big_next, 1);   // F(1)
+        sm->fast = true;
+        sm->bit = -1;
+        for (int n = param_in; n; n >>= 1) sm->bit++;
+        sm->state = (param_in == 0) ? FIB_COMPLETE : FIB_DOUBLING;
+        return true;
+    }
+
     case FEV_STEP: {
         switch (sm->state) {
+        case FIB_DOUBLING: {
+            // one bit of n per step, from the top:
+            // F(2i)   = F(i) (2 F(i+1) - F(i))
+            // F(2i+1) = F(i)^2 + F(i+1)^2
+            BigInt *a = &sm->big, *b = &sm->big_next, *t = &sm->tmp;
+            bi_add(t, b, b);
+            bi_sub(t, t, a);
+            bi_mul(t, t, a);              // t = F(2i)
+            bi_mul(a, a, a);
+            bi_mul(b, b, b);
+            bi_add(b, a, b);              // b = F(2i+1)
+            sm->current_n *= 2;
+            if ((sm->target_n >> sm->bit) & 1) {
+                bi_add(a, t, b);          // a = F(2i+2)
+                bi_swap(a, b);            // a = F(2i+1), b = F(2i+2)
+                sm->current_n++;
+            } else {
+                bi_swap(a, t);            // a = F(2i), b = F(2i+1)
+            }
+            if (--sm->bit < 0) {
+                sm->state = FIB_COMPLETE;
+            }
+            return true;
+        }
         case FIB_INIT: {
             // transition: F(0)=0 -> F(1)=1
             sm->previous = sm->current;  // previous = F(0) = 0
@@ -138,6 +196,10 @@ bool fib_step(FibSM *sm, FibEvent ev, int param_in, uint64_t *param_out) {
     }
 
     case FEV_GET_RESULT: {
+        // after FEV_INIT_FAST only while F(n) fits, see fib_big_result()
+        if (sm->fast) {
+            return bi_to_u64(&sm->big, param_out);
+        }
         if (param_out) {
             *param_out = sm->current;
         }
@@ -152,6 +214,10 @@ bool fib_step(FibSM *sm, FibEvent ev, int param_in, uint64_t *param_out) {
     }
 
     case FEV_RESET: {
+        bi_free(&sm->big);
+        bi_free(&sm->big_next);
+        bi_free(&sm->tmp);
+        sm->fast = false;
         sm->current = 0;
         sm->previous = 0;
         sm->target_n = 0;
@@ -196,6 +262,83 @@ bool compute_fibonacci(int n, uint64_t *result) {
     return false;  // err or overflow
 }
 
+// F(n) of any size after FEV_INIT_FAST; valid until the next event
+const BigInt *fib_big_result(const FibSM *sm) {
+    return &sm->big;
+}
+
+// Helper to compute F(n) of any size by fast doubling: log2(n) events
+bool compute_fibonacci_big(int n, BigInt *result) {
+    if (!result) return false;
+    
+    FibSM sm = {0};
+    bool ok = false;
+    
+    if (fib_step(&sm, FEV_INIT_FAST, n, NULL)) {
+        while (sm.state == FIB_DOUBLING) {
+            fib_step(&sm, FEV_STEP, 0, NULL);
+        }
+        if (sm.state == FIB_COMPLETE) {
+            bi_copy(result, fib_big_result(&sm));
+            ok = true;
+        }
+    }
+    
+    fib_step(&sm, FEV_RESET, 0, NULL);
+    return ok;
+}
+
+// --------- benchmark ----------
+// Fast doubling against one big addition per step (what FIB_COMPUTING
+// does, without the uint64 limit), checked by F(n) mod 10^9 computed
+// in uint64: the low limb of the result
+static double seconds(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static void run_benchmark(void) {
+    printf("%8s %7s %10s %12s %12s  %s\n",
+           "n", "digits", "low 9", "doubling s", "adding s", "check");
+    for (int n = 10; n <= 1000000; n *= 10) {
+        BigInt f, a, b;
+        bi_init(&f); bi_init(&a); bi_init(&b);
+
+        int reps = n < 10000 ? 1000 : n < 1000000 ? 10 : 1;
+        clock_t start = clock();
+        for (int r = 0; r < reps; r++) compute_fibonacci_big(n, &f);
+        double fast = seconds(start) / reps;
+
+        double slow = -1;
+        bool same = true;
+        if (n <= 100000) {
+            start = clock();
+            bi_set_u64(&a, 0);
+            bi_set_u64(&b, 1);
+            for (int i = 0; i < n; i++) {
+                bi_add(&a, &a, &b);
+                bi_swap(&a, &b);
+            }
+            slow = seconds(start);
+            same = bi_compare(&a, &f) == 0;
+        }
+
+        uint32_t x = 0, y = 1;
+        for (int i = 0; i < n; i++) {
+            uint32_t z = (x + y) % BIGINT_BASE;
+            x = y;
+            y = z;
+        }
+        bool low = f.len > 0 && f.limb[0] == x;
+
+        printf("%8d %7zu %10" PRIu32 " %12.6f ", n, bi_digits(&f), f.limb[0], fast);
+        if (slow >= 0) printf("%12.6f", slow);
+        else printf("%12s", "-");
+        printf("  %s\n", same && low ? "ok" : "MISMATCH");
+
+        bi_free(&f); bi_free(&a); bi_free(&b);
+    }
+}
+
 // --------- demo / self-test ----------
 static void print_fib_state(const FibSM *sm) {
     printf("[state=%s n=%d/%d] F(%d) = %" PRIu64 " (prev=%" PRIu64 ")\n",
@@ -203,10 +346,15 @@ static void print_fib_state(const FibSM *sm) {
            sm->current_n, sm->current, sm->previous);
 }
 
-int main(void) {
+int main(int argc, char **argv) {
     FibSM sm = {0};
     uint64_t result = 0;
 
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        run_benchmark();
+        return 0;
+    }
+
     printf("-- Computing F(10) step by step --\n");
     fib_step(&sm, FEV_INIT, 10, NULL);
     print_fib_state(&sm);
@@ -255,6 +403,18 @@ int main(void) {
     if (compute_fibonacci(-1, &result)) printf("%" PRIu64 "\n", result);
     else printf("ERROR (as expected)\n");
 
+    printf("\n-- Fast doubling past uint64, F(100) and F(1000) --\n");
+    BigInt big;
+    bi_init(&big);
+    int big_n[] = { 100, 1000 };
+    for (int i = 0; i < 2; i++) {
+        compute_fibonacci_big(big_n[i], &big);
+        char *s = bi_to_string(&big);
+        printf("F(%d) = %s\n", big_n[i], s);
+        free(s);
+    }
+    bi_free(&big);
+
     return 0;
 }
 
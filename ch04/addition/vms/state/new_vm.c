@@ -7,6 +7,7 @@
 #include <stdint.h>
 #include <inttypes.h>
 #include <string.h>
+#include <time.h>
 
 #ifndef VM_MEM_SIZE
 #define VM_MEM_SIZE 256
@@ -20,29 +21,36 @@
 #define VM_CALL_STACK_SIZE 16
 #endif
 
-// VM Instructions
+// VM Instructions: name, operand, stack entries it needs, entries it
+// leaves in their place, entries on the call stack it adds, what it does.
+// The list generates the enum, the names and the dispatch tables below
+#define VM_OPCODES(X) \
+    X(NOP,   false, 0, 0,  0) /* No operation */ \
+    X(LOAD,  true,  0, 1,  0) /* Load immediate value to stack */ \
+    X(STORE, true,  1, 0,  0) /* Store top of stack to memory[addr] */ \
+    X(FETCH, true,  0, 1,  0) /* Load from memory[addr] to stack */ \
+    X(ADD,   false, 2, 1,  0) /* Pop two values, push sum */ \
+    X(SUB,   false, 2, 1,  0) /* Pop two values, push difference (b-a) */ \
+    X(MUL,   false, 2, 1,  0) /* Pop two values, push product */ \
+    X(DIV,   false, 2, 1,  0) /* Pop two values, push quotient (b/a) */ \
+    X(MOD,   false, 2, 1,  0) /* Pop two values, push remainder (b%a) */ \
+    X(DUP,   false, 1, 2,  0) /* Duplicate top of stack */ \
+    X(SWAP,  false, 2, 2,  0) /* Swap top two stack elements */ \
+    X(POP,   false, 1, 0,  0) /* Pop and discard top element */ \
+    X(JMP,   true,  0, 0,  0) /* Unconditional jump to address */ \
+    X(BEZ,   true,  1, 0,  0) /* Branch if top of stack is zero */ \
+    X(BNZ,   true,  1, 0,  0) /* Branch if top of stack is non-zero */ \
+    X(BLT,   true,  2, 0,  0) /* Branch if second < top (pops both) */ \
+    X(BGT,   true,  2, 0,  0) /* Branch if second > top (pops both) */ \
+    X(CALL,  true,  0, 0,  1) /* Call subroutine (pushes return address) */ \
+    X(RET,   false, 0, 0, -1) /* Return from subroutine */ \
+    X(PRINT, false, 1, 1,  0) /* Print top of stack (for demo purposes) */ \
+    X(HALT,  false, 0, 0,  0) /* Stop execution */
+
 typedef enum {
-    OP_NOP = 0,    // No operation
-    OP_LOAD,       // Load immediate value to stack
-    OP_STORE,      // Store top of stack to memory[addr]
-    OP_FETCH,      // Load from memory[addr] to stack
-    OP_ADD,        // Pop two values, push sum
-    OP_SUB,        // Pop two values, push difference (b-a)
-    OP_MUL,        // Pop two values, push product
-    OP_DIV,        // Pop two values, push quotient (b/a)
-    OP_MOD,        // Pop two values, push remainder (b%a)
-    OP_DUP,        // Duplicate top of stack
-    OP_SWAP,       // Swap top two stack elements
-    OP_POP,        // Pop and discard top element
-    OP_JMP,        // Unconditional jump to address
-    OP_BEZ,        // Branch if top of stack is zero
-    OP_BNZ,        // Branch if top of stack is non-zero
-    OP_BLT,        // Branch if second < top (pops both)
-    OP_BGT,        // Branch if second > top (pops both)
-    OP_CALL,       // Call subroutine (pushes return address)
-    OP_RET,        // Return from subroutine
-    OP_PRINT,      // Print top of stack (for demo purposes)
-    OP_HALT,       // Stop execution
+#define X(name, operand, pops, pushes, calls) OP_##name,
+    VM_OPCODES(X)
+#undef X
     OP_INVALID
 } OpCode;
 
@@ -54,7 +62,8 @@ typedef enum {
     VM_DECODING,      // Decoding instruction
     VM_EXECUTING,     // Executing instruction via instruction SM
     VM_HALTED,        // Program completed normally
-    VM_ERROR          // Error state
+    VM_ERROR,         // Error state
+    VM_STATE_COUNT
 } VMState;
 
 // Instruction State Machine States (ISMS generic for all instructions)
@@ -64,7 +73,8 @@ typedef enum {
     INST_OPERAND,     // Fetch operand if needed
     INST_EXECUTE,     // Perform operation
     INST_COMPLETE,    // Instruction complete
-    INST_ERROR        // Instruction error
+    INST_ERROR,       // Instruction error
+    INST_STATE_COUNT
 } InstState;
 
 // VM Events
@@ -72,7 +82,8 @@ typedef enum {
     VM_EV_INIT = 0,   // Initialize VM
     VM_EV_STEP,       // Execute one step
     VM_EV_RESET,      // Reset VM
-    VM_EV_GET_STATE   // Get current state
+    VM_EV_GET_STATE,  // Get current state
+    VM_EVENT_COUNT
 } VMEvent;
 
 // Instruction Events
@@ -80,7 +91,8 @@ typedef enum {
     INST_EV_INIT = 0, // Initialize instruction with opcode
     INST_EV_STEP,     // Execute one step of instruction
     INST_EV_RESET,    // Reset instruction
-    INST_EV_GET_STATE // Get instruction state
+    INST_EV_GET_STATE,// Get instruction state
+    INST_EVENT_COUNT
 } InstEvent;
 
 // Instruction State Machine
@@ -92,18 +104,64 @@ typedef struct {
     int         step_count;   // Internal step counter
 } InstructionSM;
 
-// Virtual Machine
+struct VirtualMachine;
+
+typedef bool (*OpExec)(struct VirtualMachine *vm, uint32_t operand);
+
+// A compiled instruction of a block (see vm_run_block())
 typedef struct {
+    OpExec      run;          // Unchecked handler
+    uint32_t    operand;
+    uint32_t    pc;           // Its first word, where a refusal resumes
+    uint32_t    ir_before;    // Opcode word of the instruction run before it
+    int         steps;        // Steps of the VM state machine before it
+} BlockOp;
+
+// A block: the instructions from one address up to and including the
+// next branch, return or halt, on through the targets of JMP and CALL,
+// and their effect on the two stacks
+typedef struct {
+    int         first, count; // Its ops in block_ops, count 0 if not compiled
+    int         need, grow;   // Stack entries it needs on entry, most it adds
+    int         call_need, call_grow; // The same for the call stack
+    bool        ends;         // Its last op sets pc: a branch, RET or HALT
+    bool        halts;
+    uint32_t    end;          // Last word of that op
+    uint32_t    next;         // Else where it goes on
+    uint32_t    ir;           // Opcode word of its last instruction
+    int         steps;        // Steps of the VM state machine it stands for
+} Block;
+
+#define BLOCK_MAX_OPS 32
+#define BLOCK_POOL (4 * VM_MEM_SIZE)
+#define CODE_WORDS ((VM_MEM_SIZE + 31) / 32)
+
+// Return addresses live in stack[] above the data stack: stack[CALL_BASE + csp]
+#define CALL_BASE VM_STACK_SIZE
+
+// Called after every step of the VM state machine; while one is attached
+// (or debug is on) vm_run() takes every step, else it runs whole
+// instructions at once
+typedef void (*VMObserver)(const struct VirtualMachine *vm, void *ctx);
+
+// Virtual Machine
+typedef struct VirtualMachine {
     VMState         state;
     uint32_t        memory[VM_MEM_SIZE];      // Program and data memory
-    uint32_t        stack[VM_STACK_SIZE];     // Execution stack
+    uint32_t        stack[VM_STACK_SIZE + VM_CALL_STACK_SIZE]; // Execution stack, then return addresses
     int             sp;                       // Stack pointer (-1 = empty)
-    uint32_t        call_stack[VM_CALL_STACK_SIZE]; // Return addresses
     int             csp;                      // Call stack pointer (-1 = empty)
     uint32_t        pc;                       // Program counter
     uint32_t        ir;                       // Instruction register
     InstructionSM   inst_sm;                  // Current instruction state machine
     bool            debug;                    // Debug output flag
+    VMObserver      observer;                 // Step observer, NULL if none
+    void           *observer_ctx;
+    bool            blocks;                   // Run compiled blocks on the fast path
+    Block           block[VM_MEM_SIZE];       // By address of their first word
+    BlockOp         block_ops[BLOCK_POOL];
+    int             block_used;
+    uint32_t        code[CODE_WORDS];         // Bit per word some block was compiled from
 } VirtualMachine;
 
 // Helpers for stack operations
@@ -123,13 +181,13 @@ static bool vm_pop(VirtualMachine *vm, uint32_t *value) {
 // Helpers for call stack
 static bool vm_call_push(VirtualMachine *vm, uint32_t addr) {
     if (vm->csp >= VM_CALL_STACK_SIZE - 1) return false;
-    vm->call_stack[++vm->csp] = addr;
+    vm->stack[CALL_BASE + ++vm->csp] = addr;
     return true;
 }
 
 static bool vm_call_pop(VirtualMachine *vm, uint32_t *addr) {
     if (vm->csp < 0) return false;
-    if (addr) *addr = vm->call_stack[vm->csp];
+    if (addr) *addr = vm->stack[CALL_BASE + vm->csp];
     vm->csp--;
     return true;
 }
@@ -159,475 +217,754 @@ static const char* inst_state_name(InstState s) {
     }
 }
 
+static const char *const opcode_names[] = {
+#define X(name, operand, pops, pushes, calls) #name,
+    VM_OPCODES(X)
+#undef X
+    "INVALID"
+};
+
+static const bool opcode_operand[] = {
+#define X(name, operand, pops, pushes, calls) operand,
+    VM_OPCODES(X)
+#undef X
+    false
+};
+
+static const int8_t opcode_pops[] = {
+#define X(name, operand, pops, pushes, calls) pops,
+    VM_OPCODES(X)
+#undef X
+    0
+};
+
+static const int8_t opcode_pushes[] = {
+#define X(name, operand, pops, pushes, calls) pushes,
+    VM_OPCODES(X)
+#undef X
+    0
+};
+
+static const int8_t opcode_calls[] = {
+#define X(name, operand, pops, pushes, calls) calls,
+    VM_OPCODES(X)
+#undef X
+    0
+};
+
 static const char* opcode_name(OpCode op) {
-    switch (op) {
-        case OP_NOP:     return "NOP";
-        case OP_LOAD:    return "LOAD";
-        case OP_STORE:   return "STORE";
-        case OP_FETCH:   return "FETCH";
-        case OP_ADD:     return "ADD";
-        case OP_SUB:     return "SUB";
-        case OP_MUL:     return "MUL";
-        case OP_DIV:     return "DIV";
-        case OP_MOD:     return "MOD";
-        case OP_DUP:     return "DUP";
-        case OP_SWAP:    return "SWAP";
-        case OP_POP:     return "POP";
-        case OP_JMP:     return "JMP";
-        case OP_BEZ:     return "BEZ";
-        case OP_BNZ:     return "BNZ";
-        case OP_BLT:     return "BLT";
-        case OP_BGT:     return "BGT";
-        case OP_CALL:    return "CALL";
-        case OP_RET:     return "RET";
-        case OP_PRINT:   return "PRINT";
-        case OP_HALT:    return "HALT";
-        case OP_INVALID: return "INVALID";
-        default:         return "?";
+    return (unsigned)op <= OP_INVALID ? opcode_names[op] : "?";
+}
+
+// ===== Opcodes =====
+// One function per opcode, indexed by opcode in exec_table. They return
+// false on an error and leave pc at the last word of the instruction, a
+// jump sets it to target - 1, the VM moves it on when the instruction
+// completes
+
+static bool exec_NOP(VirtualMachine *vm, uint32_t operand) {
+    (void)vm; (void)operand;
+    // nothing I tell you
+    return true;
+}
+
+static bool exec_LOAD(VirtualMachine *vm, uint32_t operand) {
+    return vm_push(vm, operand);
+}
+
+static bool exec_STORE(VirtualMachine *vm, uint32_t operand) {
+    uint32_t a;
+    if (!vm_pop(vm, &a) || operand >= VM_MEM_SIZE) return false;
+    vm->memory[operand] = a;
+    return true;
+}
+
+static bool exec_FETCH(VirtualMachine *vm, uint32_t operand) {
+    if (operand >= VM_MEM_SIZE) return false;
+    return vm_push(vm, vm->memory[operand]);
+}
+
+// b op a with a on top, both popped
+#define BINARY_OP(name, expr, check) \
+static bool exec_##name(VirtualMachine *vm, uint32_t operand) { \
+    uint32_t a, b; \
+    (void)operand; \
+    if (!vm_pop(vm, &a) || !vm_pop(vm, &b)) return false; \
+    if (!(check)) return false; \
+    return vm_push(vm, (expr)); \
+}
+
+BINARY_OP(ADD, b + a, true)
+BINARY_OP(SUB, b - a, true)
+BINARY_OP(MUL, b * a, true)
+BINARY_OP(DIV, b / a, a != 0)  // div by zero
+BINARY_OP(MOD, b % a, a != 0)  // mod by zero
+#undef BINARY_OP
+
+static bool exec_DUP(VirtualMachine *vm, uint32_t operand) {
+    (void)operand;
+    if (vm->sp < 0) return false;
+    return vm_push(vm, vm->stack[vm->sp]);
+}
+
+static bool exec_SWAP(VirtualMachine *vm, uint32_t operand) {
+    (void)operand;
+    if (vm->sp < 1) return false; // need at least 2 elements
+    uint32_t a = vm->stack[vm->sp];
+    vm->stack[vm->sp] = vm->stack[vm->sp - 1];
+    vm->stack[vm->sp - 1] = a;
+    return true;
+}
+
+static bool exec_POP(VirtualMachine *vm, uint32_t operand) {
+    (void)operand;
+    return vm_pop(vm, NULL);
+}
+
+static bool jump_to(VirtualMachine *vm, uint32_t target) {
+    if (target >= VM_MEM_SIZE) return false;
+    vm->pc = target - 1; // -1 because VM will increment PC
+    return true;
+}
+
+static bool exec_JMP(VirtualMachine *vm, uint32_t operand) {
+    return jump_to(vm, operand);
+}
+
+static bool exec_BEZ(VirtualMachine *vm, uint32_t operand) {
+    uint32_t a;
+    if (!vm_pop(vm, &a)) return false;
+    return a != 0 || jump_to(vm, operand);
+}
+
+static bool exec_BNZ(VirtualMachine *vm, uint32_t operand) {
+    uint32_t a;
+    if (!vm_pop(vm, &a)) return false;
+    return a == 0 || jump_to(vm, operand);
+}
+
+static bool exec_BLT(VirtualMachine *vm, uint32_t operand) {
+    uint32_t a, b;
+    if (!vm_pop(vm, &a) || !vm_pop(vm, &b)) return false;
+    return !(b < a) || jump_to(vm, operand);
+}
+
+static bool exec_BGT(VirtualMachine *vm, uint32_t operand) {
+    uint32_t a, b;
+    if (!vm_pop(vm, &a) || !vm_pop(vm, &b)) return false;
+    return !(b > a) || jump_to(vm, operand);
+}
+
+static bool exec_CALL(VirtualMachine *vm, uint32_t operand) {
+    // push return address (+1 for next instruction), jump
+    if (!vm_call_push(vm, vm->pc + 1)) return false;
+    return jump_to(vm, operand);
+}
+
+static bool exec_RET(VirtualMachine *vm, uint32_t operand) {
+    uint32_t a;
+    (void)operand;
+    if (!vm_call_pop(vm, &a)) return false;
+    vm->pc = a - 1; // -1 because VM will increment
+    return true;
+}
+
+static bool exec_PRINT(VirtualMachine *vm, uint32_t operand) {
+    (void)operand;
+    // print top of stack (no pop)
+    if (vm->sp < 0) return false;
+    printf("PRINT: %" PRIu32 "\n", vm->stack[vm->sp]);
+    return true;
+}
+
+static bool exec_HALT(VirtualMachine *vm, uint32_t operand) {
+    // completes immediately, the VM sees the opcode and halts
+    (void)vm; (void)operand;
+    return true;
+}
+
+static bool exec_INVALID(VirtualMachine *vm, uint32_t operand) {
+    (void)vm; (void)operand;
+    return false;
+}
+
+static const OpExec exec_table[] = {
+#define X(name, operand, pops, pushes, calls) exec_##name,
+    VM_OPCODES(X)
+#undef X
+    exec_INVALID
+};
+
+// Opcodes outside the enum decode as OP_INVALID
+static OpCode decode(uint32_t word) {
+    return word < OP_INVALID ? (OpCode)word : OP_INVALID;
+}
+
+// ===== Block handlers =====
+// The same opcodes for compiled blocks. The block's stack effect is
+// checked once on entry (block_fits()), so these check nothing about the
+// stacks, and the addresses of STORE, FETCH and the jumps were checked
+// when the block was compiled. What is left to check at run time, a
+// division by zero or a store into compiled code, makes the handler
+// refuse before it changes anything: false here sends that instruction
+// through vm_exec_instruction(). The last instruction of a block finds
+// pc at its last word, as the exec_ functions do; the others do not look
+// at it
+
+#define TOP  vm->stack[vm->sp]
+#define NEXT vm->stack[vm->sp - 1]
+
+static bool is_code(const VirtualMachine *vm, uint32_t addr) {
+    return (vm->code[addr / 32] >> (addr % 32)) & 1;
+}
+
+static void block_flush(VirtualMachine *vm) {
+    for (int i = 0; i < VM_MEM_SIZE; i++) vm->block[i].count = 0;
+    memset(vm->code, 0, sizeof(vm->code));
+    vm->block_used = 0;
+}
+
+static bool blk_NOP(VirtualMachine *vm, uint32_t operand) {
+    (void)vm; (void)operand;
+    return true;
+}
+
+static bool blk_LOAD(VirtualMachine *vm, uint32_t operand) {
+    vm->stack[++vm->sp] = operand;
+    return true;
+}
+
+static bool blk_STORE(VirtualMachine *vm, uint32_t operand) {
+    if (is_code(vm, operand)) return false;
+    vm->memory[operand] = vm->stack[vm->sp--];
+    return true;
+}
+
+static bool blk_FETCH(VirtualMachine *vm, uint32_t operand) {
+    vm->stack[++vm->sp] = vm->memory[operand];
+    return true;
+}
+
+#define BLOCK_BINARY_OP(name, op, check) \
+static bool blk_##name(VirtualMachine *vm, uint32_t operand) { \
+    (void)operand; \
+    if (!(check)) return false; \
+    NEXT = NEXT op TOP; \
+    vm->sp--; \
+    return true; \
+}
+
+BLOCK_BINARY_OP(ADD, +, true)
+BLOCK_BINARY_OP(SUB, -, true)
+BLOCK_BINARY_OP(MUL, *, true)
+BLOCK_BINARY_OP(DIV, /, TOP != 0)
+BLOCK_BINARY_OP(MOD, %, TOP != 0)
+#undef BLOCK_BINARY_OP
+
+static bool blk_DUP(VirtualMachine *vm, uint32_t operand) {
+    (void)operand;
+    vm->stack[vm->sp + 1] = TOP;
+    vm->sp++;
+    return true;
+}
+
+static bool blk_SWAP(VirtualMachine *vm, uint32_t operand) {
+    (void)operand;
+    uint32_t a = TOP;
+    TOP = NEXT;
+    NEXT = a;
+    return true;
+}
+
+static bool blk_POP(VirtualMachine *vm, uint32_t operand) {
+    (void)operand;
+    vm->sp--;
+    return true;
+}
+
+#define blk_JMP blk_NOP    // never compiled, the block goes on at the target
+
+// Branches pop what they test, then jump to operand if cond holds
+#define BLOCK_BRANCH(name, pops, cond) \
+static bool blk_##name(VirtualMachine *vm, uint32_t operand) { \
+    bool taken = (cond); \
+    vm->sp -= pops; \
+    if (taken) vm->pc = operand - 1; \
+    return true; \
+}
+
+BLOCK_BRANCH(BEZ, 1, TOP == 0)
+BLOCK_BRANCH(BNZ, 1, TOP != 0)
+BLOCK_BRANCH(BLT, 2, NEXT < TOP)
+BLOCK_BRANCH(BGT, 2, NEXT > TOP)
+
+// The operand is the return address; the block goes on at the target
+static bool blk_CALL(VirtualMachine *vm, uint32_t operand) {
+    vm->stack[CALL_BASE + ++vm->csp] = operand;
+    return true;
+}
+
+static bool blk_RET(VirtualMachine *vm, uint32_t operand) {
+    (void)operand;
+    vm->pc = vm->stack[CALL_BASE + vm->csp--] - 1;
+    return true;
+}
+
+// A return to an address a CALL earlier in the block pushed: the block
+// goes on there
+static bool blk_RET_KNOWN(VirtualMachine *vm, uint32_t operand) {
+    (void)operand;
+    vm->csp--;
+    return true;
+}
+
+static bool blk_PRINT(VirtualMachine *vm, uint32_t operand) {
+    (void)operand;
+    printf("PRINT: %" PRIu32 "\n", TOP);
+    return true;
+}
+
+#define blk_HALT blk_NOP   // the block sees it ends in HALT and halts
+
+static const OpExec block_exec[] = {
+#define X(name, operand, pops, pushes, calls) blk_##name,
+    VM_OPCODES(X)
+#undef X
+    NULL
+};
+
+// Pairs compiled as one handler: LOAD k then ADD, SUB or MUL works on the
+// top in place, DUP then BEZ or BNZ tests the top without the copy
+
+#define BLOCK_IMMEDIATE_OP(name, op) \
+static bool blk_##name(VirtualMachine *vm, uint32_t operand) { \
+    TOP = TOP op operand; \
+    return true; \
+}
+
+BLOCK_IMMEDIATE_OP(LOAD_ADD, +)
+BLOCK_IMMEDIATE_OP(LOAD_SUB, -)
+BLOCK_IMMEDIATE_OP(LOAD_MUL, *)
+#undef BLOCK_IMMEDIATE_OP
+
+BLOCK_BRANCH(DUP_BEZ, 0, TOP == 0)
+BLOCK_BRANCH(DUP_BNZ, 0, TOP != 0)
+#undef BLOCK_BRANCH
+
+#undef TOP
+#undef NEXT
+
+// The handler for first followed by second, NULL if there is none
+static OpExec block_pair(OpCode first, OpCode second) {
+    if (first == OP_LOAD) {
+        switch (second) {
+            case OP_ADD: return blk_LOAD_ADD;
+            case OP_SUB: return blk_LOAD_SUB;
+            case OP_MUL: return blk_LOAD_MUL;
+            default:     return NULL;
+        }
     }
+    if (first == OP_DUP) {
+        switch (second) {
+            case OP_BEZ: return blk_DUP_BEZ;
+            case OP_BNZ: return blk_DUP_BNZ;
+            default:     return NULL;
+        }
+    }
+    return NULL;
+}
+
+// ===== Instruction State Machine =====
+// Dense [state][event] table of actions. Each action does the work of
+// the transition and sets the next state; the switches this replaced
+// are the same machine spelled the long way
+
+typedef bool (*InstAction)(InstructionSM *inst, VirtualMachine *vm, uint32_t param);
+
+static bool inst_reject(InstructionSM *inst, VirtualMachine *vm, uint32_t param) {
+    (void)inst; (void)vm; (void)param;
+    return false;
+}
+
+static bool inst_idle(InstructionSM *inst, VirtualMachine *vm, uint32_t param) {
+    (void)inst; (void)vm; (void)param;
+    return true;
+}
+
+static bool inst_fail(InstructionSM *inst, VirtualMachine *vm, uint32_t param) {
+    (void)vm; (void)param;
+    inst->state = INST_ERROR;
+    return true;
 }
 
+static bool inst_init(InstructionSM *inst, VirtualMachine *vm, uint32_t param) {
+    (void)vm;
+    inst->opcode = (OpCode)param;
+    inst->state = INST_INIT;
+    inst->operand = 0;
+    inst->step_count = 0;
+    inst->needs_operand = opcode_operand[decode(param)];
+    return true;
+}
+
+static bool inst_begin(InstructionSM *inst, VirtualMachine *vm, uint32_t param) {
+    (void)vm; (void)param;
+    inst->state = inst->needs_operand ? INST_OPERAND : INST_EXECUTE;
+    return true;
+}
+
+static bool inst_operand(InstructionSM *inst, VirtualMachine *vm, uint32_t param) {
+    (void)param;
+    // fetch operand from next memory location
+    if (vm->pc + 1 >= VM_MEM_SIZE) {
+        inst->state = INST_ERROR;
+        return true;
+    }
+    inst->operand = vm->memory[vm->pc + 1];
+    vm->pc++; // consume operand
+    inst->state = INST_EXECUTE;
+    return true;
+}
+
+static bool inst_execute(InstructionSM *inst, VirtualMachine *vm, uint32_t param) {
+    (void)param;
+    inst->state = exec_table[decode(inst->opcode)](vm, inst->operand) ? INST_COMPLETE : INST_ERROR;
+    return true;
+}
+
+static bool inst_reset(InstructionSM *inst, VirtualMachine *vm, uint32_t param) {
+    (void)vm; (void)param;
+    inst->opcode = OP_INVALID;
+    inst->state = INST_UNINIT;
+    inst->operand = 0;
+    inst->needs_operand = false;
+    inst->step_count = 0;
+    return true;
+}
+
+// GET_STATE does nothing: the state is accessible directly
+static const InstAction inst_table[INST_STATE_COUNT][INST_EVENT_COUNT] = {
+    //                INIT        STEP          RESET       GET_STATE
+    [INST_UNINIT]   = { inst_init, inst_fail,    inst_reset, inst_idle },
+    [INST_INIT]     = { inst_init, inst_begin,   inst_reset, inst_idle },
+    [INST_OPERAND]  = { inst_init, inst_operand, inst_reset, inst_idle },
+    [INST_EXECUTE]  = { inst_init, inst_execute, inst_reset, inst_idle },
+    [INST_COMPLETE] = { inst_init, inst_idle,    inst_reset, inst_idle },
+    [INST_ERROR]    = { inst_reject, inst_reject, inst_reset, inst_reject },
+};
+
 // Instruction State Machine (handles execution of individual instructions)
 bool instruction_step(InstructionSM *inst, VirtualMachine *vm, InstEvent ev, uint32_t param) {
     if (!inst || !vm) return false;
+    if ((unsigned)ev >= INST_EVENT_COUNT || (unsigned)inst->state >= INST_STATE_COUNT) return false;
+    return inst_table[inst->state][ev](inst, vm, param);
+}
 
-    if (inst->state == INST_ERROR && ev != INST_EV_RESET) {
-        return false;
-    }
+// ===== VM State Machine =====
 
-    switch (ev) {
-    case INST_EV_INIT: {
-        inst->opcode = (OpCode)param;
-        inst->state = INST_INIT;
-        inst->operand = 0;
-        inst->step_count = 0;
-        
-        // determine if this instruction needs an operand
-        switch (inst->opcode) {
-        case OP_LOAD:
-        case OP_STORE:
-        case OP_FETCH:
-        case OP_JMP:
-        case OP_BEZ:
-        case OP_BNZ:
-        case OP_BLT:
-        case OP_BGT:
-        case OP_CALL:
-            inst->needs_operand = true;
-            break;
-        default:
-            inst->needs_operand = false;
-            break;
-        }
-        return true;
-    }
+typedef bool (*VMAction)(VirtualMachine *vm, uint32_t param, uint32_t *result);
 
-    case INST_EV_STEP: {
-        switch (inst->state) {
-        case INST_INIT: {
-            if (inst->needs_operand) {
-                inst->state = INST_OPERAND;
-            } else {
-                inst->state = INST_EXECUTE;
-            }
-            return true;
-        }
+static bool vm_reject(VirtualMachine *vm, uint32_t param, uint32_t *result) {
+    (void)vm; (void)param; (void)result;
+    return false;
+}
 
-        case INST_OPERAND: {
-            // fetch operand from next memory location
-            if (vm->pc + 1 >= VM_MEM_SIZE) {
-                inst->state = INST_ERROR;
-                return true;
-            }
-            inst->operand = vm->memory[vm->pc + 1];
-            vm->pc++; // consume operand
-            inst->state = INST_EXECUTE;
-            return true;
-        }
+static bool vm_idle(VirtualMachine *vm, uint32_t param, uint32_t *result) {
+    (void)vm; (void)param; (void)result;
+    // no more execution
+    return true;
+}
 
-        case INST_EXECUTE: {
-            // execute actual instruction
-            uint32_t a, b;
-            switch (inst->opcode) {
-            case OP_NOP:
-                // nothing I tell you
-                break;
-                
-            case OP_MUL:
-                if (!vm_pop(vm, &a) || !vm_pop(vm, &b)) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                if (!vm_push(vm, b * a)) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                break;
-                
-            case OP_BNZ:
-                // branch if non-zero
-                if (!vm_pop(vm, &a)) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                if (a != 0) {
-                    if (inst->operand >= VM_MEM_SIZE) {
-                        inst->state = INST_ERROR;
-                        return true;
-                    }
-                    vm->pc = inst->operand - 1;
-                }
-                break;
-                
-            case OP_BLT:
-                // branch if less than (second < top)
-                if (!vm_pop(vm, &a) || !vm_pop(vm, &b)) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                if (b < a) {
-                    if (inst->operand >= VM_MEM_SIZE) {
-                        inst->state = INST_ERROR;
-                        return true;
-                    }
-                    vm->pc = inst->operand - 1;
-                }
-                break;
-                
-            case OP_BGT:
-                // branch if greater than (second > top)
-                if (!vm_pop(vm, &a) || !vm_pop(vm, &b)) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                if (b > a) {
-                    if (inst->operand >= VM_MEM_SIZE) {
-                        inst->state = INST_ERROR;
-                        return true;
-                    }
-                    vm->pc = inst->operand - 1;
-                }
-                break;
-                
-            case OP_CALL:
-                // call subroutine, push return address, jump
-                if (!vm_call_push(vm, vm->pc + 1)) { // +1 for next instruction
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                if (inst->operand >= VM_MEM_SIZE) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                vm->pc = inst->operand - 1;
-                break;
-                
-            case OP_RET:
-                // return from subroutine
-                if (!vm_call_pop(vm, &a)) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                vm->pc = a - 1; // -1 because VM will increment
-                break;
-                
-            case OP_PRINT:
-                // print top of stack (no pop)
-                if (vm->sp < 0) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                printf("PRINT: %" PRIu32 "\n", vm->stack[vm->sp]);
-                break;
-                
-            case OP_DIV:
-                if (!vm_pop(vm, &a) || !vm_pop(vm, &b)) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                if (a == 0) { // div by zero
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                if (!vm_push(vm, b / a)) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                break;
-                
-            case OP_MOD:
-                if (!vm_pop(vm, &a) || !vm_pop(vm, &b)) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                if (a == 0) { // mod by zero
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                if (!vm_push(vm, b % a)) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                break;
-                
-            case OP_DUP:
-                if (vm->sp < 0) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                if (!vm_push(vm, vm->stack[vm->sp])) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                break;
-                
-            case OP_SWAP:
-                if (vm->sp < 1) { // need at least 2 elements
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                a = vm->stack[vm->sp];
-                vm->stack[vm->sp] = vm->stack[vm->sp - 1];
-                vm->stack[vm->sp - 1] = a;
-                break;
-                
-            case OP_POP:
-                if (!vm_pop(vm, NULL)) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                break;
-                
-            case OP_LOAD:
-                if (!vm_push(vm, inst->operand)) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                break;
-                
-            case OP_STORE:
-                if (!vm_pop(vm, &a) || inst->operand >= VM_MEM_SIZE) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                vm->memory[inst->operand] = a;
-                break;
-                
-            case OP_FETCH:
-                if (inst->operand >= VM_MEM_SIZE) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                if (!vm_push(vm, vm->memory[inst->operand])) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                break;
-                
-            case OP_ADD:
-                if (!vm_pop(vm, &a) || !vm_pop(vm, &b)) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                if (!vm_push(vm, b + a)) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                break;
-                
-            case OP_SUB:
-                if (!vm_pop(vm, &a) || !vm_pop(vm, &b)) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                if (!vm_push(vm, b - a)) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                break;
-                
-            case OP_JMP:
-                // unconditional jump, set PC to operand - 1 
-                // (will be incremented after instruction completes)
-                if (inst->operand >= VM_MEM_SIZE) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                vm->pc = inst->operand - 1; // -1 because VM will increment PC
-                break;
-                
-            case OP_BEZ:
-                // branch if zero, pop value, jump if zero
-                if (!vm_pop(vm, &a)) {
-                    inst->state = INST_ERROR;
-                    return true;
-                }
-                if (a == 0) {
-                    if (inst->operand >= VM_MEM_SIZE) {
-                        inst->state = INST_ERROR;
-                        return true;
-                    }
-                    vm->pc = inst->operand - 1; // -1 because VM will increment PC
-                }
-                break;
-                
-            case OP_HALT:
-                // special case: HALT completes immediately and signals VM
-                break;
-                
-            default:
-                inst->state = INST_ERROR;
-                return true;
-            }
-            
-            inst->state = INST_COMPLETE;
-            return true;
-        }
+static bool vm_fail(VirtualMachine *vm, uint32_t param, uint32_t *result) {
+    (void)param; (void)result;
+    vm->state = VM_ERROR;
+    return true;
+}
 
-        case INST_COMPLETE:
-        case INST_ERROR: {
-            // already done
-            return true;
-        }
+static bool vm_init(VirtualMachine *vm, uint32_t param, uint32_t *result) {
+    (void)result;
+    vm->state = VM_READY;
+    vm->sp = -1;    // Empty stack
+    vm->csp = -1;   // Empty call stack
+    vm->pc = 0;     // Start at beginning
+    vm->ir = 0;
+    vm->debug = (param & 1) != 0; // param & 1 enables debug
+    memset(vm->stack, 0, sizeof(vm->stack));
+    block_flush(vm);
+    instruction_step(&vm->inst_sm, vm, INST_EV_RESET, 0);
+    return true;
+}
 
-        default:
-            inst->state = INST_ERROR;
-            return true;
-        }
+static bool vm_ready(VirtualMachine *vm, uint32_t param, uint32_t *result) {
+    (void)param; (void)result;
+    vm->state = VM_FETCHING;
+    return true;
+}
+
+static bool vm_fetch(VirtualMachine *vm, uint32_t param, uint32_t *result) {
+    (void)param; (void)result;
+    if (vm->pc >= VM_MEM_SIZE) {
+        vm->state = VM_ERROR;
+        return true;
     }
+    vm->ir = vm->memory[vm->pc];
+    vm->state = VM_DECODING;
+    return true;
+}
 
-    case INST_EV_RESET: {
-        inst->opcode = OP_INVALID;
-        inst->state = INST_UNINIT;
-        inst->operand = 0;
-        inst->needs_operand = false;
-        inst->step_count = 0;
+static bool vm_decode(VirtualMachine *vm, uint32_t param, uint32_t *result) {
+    (void)param; (void)result;
+    // Init instruction state machine with the opcode
+    if (!instruction_step(&vm->inst_sm, vm, INST_EV_INIT, vm->ir)) {
+        vm->state = VM_ERROR;
         return true;
     }
+    vm->state = VM_EXECUTING;
+    return true;
+}
 
-    case INST_EV_GET_STATE: {
-        return true; // state is accessible directly
+static bool vm_execute(VirtualMachine *vm, uint32_t param, uint32_t *result) {
+    (void)param; (void)result;
+    // Step the instruction state machine
+    if (!instruction_step(&vm->inst_sm, vm, INST_EV_STEP, 0) ||
+        vm->inst_sm.state == INST_ERROR) {
+        vm->state = VM_ERROR;
+        return true;
     }
 
-    default:
-        return false;
+    if (vm->inst_sm.state == INST_COMPLETE) {
+        // check for HALT instruction
+        if (vm->inst_sm.opcode == OP_HALT) {
+            vm->state = VM_HALTED;
+        } else {
+            vm->pc++; // move to next instruction
+            vm->state = VM_READY;
+        }
+        // reset instruction SM for next instruction
+        instruction_step(&vm->inst_sm, vm, INST_EV_RESET, 0);
     }
+    return true;
 }
 
+static bool vm_reset(VirtualMachine *vm, uint32_t param, uint32_t *result) {
+    (void)param; (void)result;
+    vm->state = VM_UNINIT;
+    vm->sp = -1;
+    vm->csp = -1;
+    vm->pc = 0;
+    vm->ir = 0;
+    vm->debug = false;
+    memset(vm->memory, 0, sizeof(vm->memory));
+    memset(vm->stack, 0, sizeof(vm->stack));
+    block_flush(vm);
+    instruction_step(&vm->inst_sm, vm, INST_EV_RESET, 0);
+    return true;
+}
+
+static bool vm_get_state(VirtualMachine *vm, uint32_t param, uint32_t *result) {
+    (void)param;
+    if (result) *result = vm->state;
+    return true;
+}
+
+static const VMAction vm_table[VM_STATE_COUNT][VM_EVENT_COUNT] = {
+    //               INIT       STEP        RESET     GET_STATE
+    [VM_UNINIT]    = { vm_init, vm_fail,    vm_reset, vm_get_state },
+    [VM_READY]     = { vm_init, vm_ready,   vm_reset, vm_get_state },
+    [VM_FETCHING]  = { vm_init, vm_fetch,   vm_reset, vm_get_state },
+    [VM_DECODING]  = { vm_init, vm_decode,  vm_reset, vm_get_state },
+    [VM_EXECUTING] = { vm_init, vm_execute, vm_reset, vm_get_state },
+    [VM_HALTED]    = { vm_init, vm_idle,    vm_reset, vm_get_state },
+    [VM_ERROR]     = { vm_reject, vm_reject, vm_reset, vm_reject },
+};
+
 // VM State Machine: orchestrates instruction execution
 bool vm_step(VirtualMachine *vm, VMEvent ev, uint32_t param, uint32_t *result) {
     if (!vm) return false;
+    if ((unsigned)ev >= VM_EVENT_COUNT || (unsigned)vm->state >= VM_STATE_COUNT) return false;
 
-    if (vm->state == VM_ERROR && ev != VM_EV_RESET) {
-        return false;
+    if (ev == VM_EV_STEP && vm->debug) {
+        printf("VM Step: state=%s pc=%" PRIu32 " sp=%d\n", 
+               vm_state_name(vm->state), vm->pc, vm->sp);
     }
 
-    switch (ev) {
-    case VM_EV_INIT: {
-        vm->state = VM_READY;
-        vm->sp = -1;    // Empty stack
-        vm->csp = -1;   // Empty call stack
-        vm->pc = 0;     // Start at beginning
-        vm->ir = 0;
-        vm->debug = (param & 1) != 0; // param & 1 enables debug
-        memset(vm->stack, 0, sizeof(vm->stack));
-        memset(vm->call_stack, 0, sizeof(vm->call_stack));
-        instruction_step(&vm->inst_sm, vm, INST_EV_RESET, 0);
-        return true;
-    }
+    bool ok = vm_table[vm->state][ev](vm, param, result);
+    if (ev == VM_EV_STEP && vm->observer) vm->observer(vm, vm->observer_ctx);
+    return ok;
+}
 
-    case VM_EV_STEP: {
-        if (vm->debug) {
-            printf("VM Step: state=%s pc=%" PRIu32 " sp=%d\n", 
-                   vm_state_name(vm->state), vm->pc, vm->sp);
-        }
+void vm_set_observer(VirtualMachine *vm, VMObserver observer, void *ctx) {
+    vm->observer = observer;
+    vm->observer_ctx = ctx;
+}
 
-        switch (vm->state) {
-        case VM_READY: {
-            vm->state = VM_FETCHING;
-            return true;
-        }
+// Steps vm_step() takes for one instruction from VM_READY: READY, FETCHING,
+// DECODING, then INIT, OPERAND (if any) and EXECUTE of the instruction
+static int instruction_steps(OpCode op) {
+    return opcode_operand[op] ? 6 : 5;
+}
 
-        case VM_FETCHING: {
-            if (vm->pc >= VM_MEM_SIZE) {
-                vm->state = VM_ERROR;
-                return true;
-            }
-            vm->ir = vm->memory[vm->pc];
-            vm->state = VM_DECODING;
-            return true;
-        }
+// Fused fast path: one whole instruction from VM_READY in a single call,
+// ending in the state the step-by-step machine would reach, instruction
+// SM included. Returns the steps it stands for, 0 if it took an error
+static int vm_exec_instruction(VirtualMachine *vm) {
+    if (vm->pc >= VM_MEM_SIZE) {
+        vm->state = VM_ERROR;
+        return 0;
+    }
+    vm->ir = vm->memory[vm->pc];
+    OpCode op = decode(vm->ir);
+    uint32_t operand = 0;
+    if (opcode_operand[op]) {
+        if (vm->pc + 1 >= VM_MEM_SIZE) goto error;
+        operand = vm->memory[++vm->pc];
+    }
+    if (!exec_table[op](vm, operand)) goto error;
+    if (op == OP_HALT) {
+        vm->state = VM_HALTED;
+    } else {
+        vm->pc++;
+    }
+    return instruction_steps(op);
 
-        case VM_DECODING: {
-            // Init instruction state machine with the opcode
-            if (!instruction_step(&vm->inst_sm, vm, INST_EV_INIT, vm->ir)) {
-                vm->state = VM_ERROR;
-                return true;
-            }
-            vm->state = VM_EXECUTING;
-            return true;
-        }
+error:
+    vm->state = VM_ERROR;
+    vm->inst_sm = (InstructionSM){ (OpCode)vm->ir, INST_ERROR, operand, opcode_operand[op], 0 };
+    return 0;
+}
 
-        case VM_EXECUTING: {
-            // Step the instruction state machine
-            if (!instruction_step(&vm->inst_sm, vm, INST_EV_STEP, 0)) {
-                vm->state = VM_ERROR;
-                return true;
-            }
+// ===== Compiled blocks =====
+// The fused path still checks every push and pop. A block's stack effect
+// is known before it runs, so with blocks on (vm_set_blocks()) each block
+// is compiled once to block handlers, and one check on entry stands for
+// all the checks of its instructions. A block that would take the stacks
+// out of bounds, and an instruction whose handler refuses, go through
+// vm_exec_instruction() instead: the errors happen where they did
 
-            if (vm->inst_sm.state == INST_ERROR) {
-                vm->state = VM_ERROR;
-                return true;
-            }
+// Could the checked exec_ function fail on the operand alone? Then the
+// instruction is left out of blocks
+static bool operand_fails(OpCode op, uint32_t operand) {
+    switch (op) {
+        case OP_STORE: case OP_FETCH:
+        case OP_JMP: case OP_BEZ: case OP_BNZ: case OP_BLT: case OP_BGT: case OP_CALL:
+            return operand >= VM_MEM_SIZE;
+        default:
+            return false;
+    }
+}
 
-            if (vm->inst_sm.state == INST_COMPLETE) {
-                // check for HALT instruction
-                if (vm->inst_sm.opcode == OP_HALT) {
-                    vm->state = VM_HALTED;
-                } else {
-                    vm->pc++; // move to next instruction
-                    vm->state = VM_READY;
-                }
-                // reset instruction SM for next instruction
-                instruction_step(&vm->inst_sm, vm, INST_EV_RESET, 0);
-            }
+// Instructions after which it is not known where the block goes on; a
+// RET is known if the block made the call
+static bool ends_block(OpCode op) {
+    switch (op) {
+        case OP_BEZ: case OP_BNZ: case OP_BLT: case OP_BGT:
+        case OP_RET: case OP_HALT:
             return true;
-        }
+        default:
+            return false;
+    }
+}
 
-        case VM_HALTED:
-        case VM_ERROR: {
-            // no more execution
-            return true;
+// The block starting at pc, compiled if it is not yet; NULL if not even
+// its first instruction can go in one. Calls push return addresses known
+// when the block was compiled, and returns to them need not end it: a
+// call-heavy program runs from branch to branch in one block
+static const Block *block_at(VirtualMachine *vm, uint32_t pc) {
+    Block *b = &vm->block[pc];
+    if (b->count) return b;
+    if (vm->block_used + BLOCK_MAX_OPS > BLOCK_POOL) block_flush(vm);
+
+    *b = (Block){ .first = vm->block_used, .next = pc };
+    OpCode prev = OP_INVALID;
+    int depth = 0, call_depth = 0, calls = 0;
+    uint32_t ir = 0, returns[BLOCK_MAX_OPS];  // pushed by the block's calls
+    for (int n = 0; n < BLOCK_MAX_OPS && pc < VM_MEM_SIZE; n++) {
+        OpCode op = decode(vm->memory[pc]);
+        uint32_t operand = 0, next = pc + 1;
+        if (op == OP_INVALID) break;
+        if (opcode_operand[op]) {
+            if (pc + 1 >= VM_MEM_SIZE) break;
+            operand = vm->memory[pc + 1];
+            next = pc + 2;
         }
+        if (operand_fails(op, operand)) break;
 
-        default:
-            vm->state = VM_ERROR;
-            return true;
+        if (opcode_pops[op] - depth > b->need) b->need = opcode_pops[op] - depth;
+        depth += opcode_pushes[op] - opcode_pops[op];
+        if (depth > b->grow) b->grow = depth;
+        if (-opcode_calls[op] - call_depth > b->call_need) b->call_need = -opcode_calls[op] - call_depth;
+        call_depth += opcode_calls[op];
+        if (call_depth > b->call_grow) b->call_grow = call_depth;
+        for (uint32_t a = pc; a < next; a++) vm->code[a / 32] |= 1u << (a % 32);
+
+        OpExec pair = block_pair(prev, op);
+        bool known = op == OP_RET && calls > 0;
+        if (op == OP_JMP) {
+            prev = OP_INVALID;  // nothing to run
+        } else if (pair) {
+            BlockOp *first = &vm->block_ops[b->first + b->count - 1];
+            first->run = pair;
+            if (opcode_operand[op]) first->operand = operand;
+            prev = OP_INVALID;
+        } else {
+            vm->block_ops[b->first + b->count++] = (BlockOp){
+                known ? blk_RET_KNOWN : block_exec[op], op == OP_CALL ? next : operand,
+                pc, ir, b->steps };
+            prev = op;
         }
+        ir = vm->memory[pc];
+        b->ir = ir;
+        b->steps += instruction_steps(op);
+        if (ends_block(op) && !known) {
+            b->ends = true;
+            b->halts = op == OP_HALT;
+            b->end = next - 1;
+            break;
+        }
+        if (op == OP_CALL) returns[calls++] = next;
+        pc = op == OP_JMP || op == OP_CALL ? operand : known ? returns[--calls] : next;
+        b->next = pc;
     }
+    vm->block_used += b->count;
+    return b->count ? b : NULL;
+}
 
-    case VM_EV_RESET: {
-        vm->state = VM_UNINIT;
-        vm->sp = -1;
-        vm->csp = -1;
-        vm->pc = 0;
-        vm->ir = 0;
-        vm->debug = false;
-        memset(vm->memory, 0, sizeof(vm->memory));
-        memset(vm->stack, 0, sizeof(vm->stack));
-        memset(vm->call_stack, 0, sizeof(vm->call_stack));
-        instruction_step(&vm->inst_sm, vm, INST_EV_RESET, 0);
-        return true;
-    }
+// Can the block run without a check from start to end?
+static bool block_fits(const VirtualMachine *vm, const Block *b) {
+    int depth = vm->sp + 1, call_depth = vm->csp + 1;
+    return depth >= b->need && depth + b->grow <= VM_STACK_SIZE &&
+           call_depth >= b->call_need && call_depth + b->call_grow <= VM_CALL_STACK_SIZE;
+}
 
-    case VM_EV_GET_STATE: {
-        if (result) *result = vm->state;
-        return true;
+// Run a block that fits, and take the steps it stands for off *steps.
+// false if a handler refused: pc is then at that instruction, which has
+// yet to run, and the steps are those of the instructions before it
+static bool vm_run_block(VirtualMachine *vm, const Block *b, long *steps) {
+    const BlockOp *op = &vm->block_ops[b->first];
+    const BlockOp *last = op + b->count - 1;
+    for (; op < last; op++) {
+        if (!op->run(vm, op->operand)) goto refused;
     }
-
-    default:
-        return false;
+    if (b->ends) vm->pc = b->end;
+    if (!op->run(vm, op->operand)) goto refused;
+    vm->ir = b->ir;
+    if (b->halts) {
+        vm->state = VM_HALTED;
+    } else {
+        vm->pc = b->ends ? vm->pc + 1 : b->next;
     }
+    *steps -= b->steps;
+    return true;
+
+refused:
+    if (op->steps) vm->ir = op->ir_before;
+    vm->pc = op->pc;
+    *steps -= op->steps;
+    return false;
+}
+
+void vm_set_blocks(VirtualMachine *vm, bool on) {
+    vm->blocks = on;
 }
 
 // Helper to load a program into VM memory
@@ -636,15 +973,32 @@ void vm_load_program(VirtualMachine *vm, uint32_t *program, int length) {
     
     int copy_length = (length > VM_MEM_SIZE) ? VM_MEM_SIZE : length;
     memcpy(vm->memory, program, copy_length * sizeof(uint32_t));
+    block_flush(vm);
 }
 
-// Helper to run VM until halt or error
-bool vm_run(VirtualMachine *vm, bool debug) {
+// Helper to run VM until halt, error or max_steps steps of the VM state
+// machine. Without debug output or an observer whole instructions go
+// through the fused path, or whole blocks if they are on, and the step
+// count comes out the same
+bool vm_run_steps(VirtualMachine *vm, bool debug, long max_steps) {
     if (!vm) return false;
     
     vm_step(vm, VM_EV_INIT, debug ? 1 : 0, NULL);
     
-    int max_steps = 1000; // safety limit
+    if (!vm->debug && !vm->observer) {
+        while (vm->state == VM_READY) {
+            if (vm->blocks && vm->pc < VM_MEM_SIZE) {
+                const Block *b = block_at(vm, vm->pc);
+                if (b && max_steps >= b->steps && block_fits(vm, b) &&
+                    vm_run_block(vm, b, &max_steps)) continue;
+            }
+            if (max_steps < instruction_steps(decode(vm->pc < VM_MEM_SIZE ? vm->memory[vm->pc] : 0))) break;
+            max_steps -= vm_exec_instruction(vm);
+            // a store the blocks did not see, perhaps into code they were
+            // compiled from; blk_STORE sends those here
+            if (vm->blocks && decode(vm->ir) == OP_STORE) block_flush(vm);
+        }
+    }
     while ((vm->state != VM_HALTED && vm->state != VM_ERROR) && max_steps-- > 0) {
         vm_step(vm, VM_EV_STEP, 0, NULL);
     }
@@ -652,6 +1006,10 @@ bool vm_run(VirtualMachine *vm, bool debug) {
     return vm->state == VM_HALTED;
 }
 
+bool vm_run(VirtualMachine *vm, bool debug) {
+    return vm_run_steps(vm, debug, 1000); // safety limit
+}
+
 // debug function to print VM state
 void vm_print_state(const VirtualMachine *vm) {
     if (!vm) return;
@@ -669,7 +1027,7 @@ void vm_print_state(const VirtualMachine *vm) {
     
     printf("Call Stack: [");
     for (int i = 0; i <= vm->csp; i++) {
-        printf("%s%" PRIu32, i ? ", " : "", vm->call_stack[i]);
+        printf("%s%" PRIu32, i ? ", " : "", vm->stack[CALL_BASE + i]);
     }
     printf("]\n");
     
@@ -678,6 +1036,35 @@ void vm_print_state(const VirtualMachine *vm) {
 }
 
 // --------- demo ----------
+static void count_steps(const VirtualMachine *vm, void *ctx) {
+    (void)vm;
+    ++*(long *)ctx;
+}
+
+// Everything a program can see, and the state machines
+static bool same_state(const VirtualMachine *a, const VirtualMachine *b) {
+    return a->state == b->state && a->pc == b->pc && a->ir == b->ir &&
+           a->sp == b->sp && a->csp == b->csp && a->inst_sm.state == b->inst_sm.state &&
+           memcmp(a->memory, b->memory, sizeof(a->memory)) == 0 &&
+           memcmp(a->stack, b->stack, (a->sp + 1) * sizeof(uint32_t)) == 0 &&
+           memcmp(a->stack + CALL_BASE, b->stack + CALL_BASE, (a->csp + 1) * sizeof(uint32_t)) == 0;
+}
+
+// Run program fused and in blocks, each max_steps steps at most, and
+// compare where they stop
+static bool blocks_agree(uint32_t *program, int length, long max_steps) {
+    static VirtualMachine fused, blocks;
+    vm_step(&fused, VM_EV_RESET, 0, NULL);
+    vm_step(&blocks, VM_EV_RESET, 0, NULL);
+    vm_load_program(&fused, program, length);
+    vm_load_program(&blocks, program, length);
+    vm_set_blocks(&fused, false);
+    vm_set_blocks(&blocks, true);
+    vm_run_steps(&fused, false, max_steps);
+    vm_run_steps(&blocks, false, max_steps);
+    return same_state(&fused, &blocks);
+}
+
 int main(void) {
     VirtualMachine vm = {0};
 
@@ -800,5 +1187,77 @@ int main(void) {
     vm_run(&vm, false);
     vm_print_state(&vm);
 
+    printf("\nProgram 6: Counting down from 1000000, step by step, fused and in blocks\n");
+    uint32_t prog6[] = {
+        OP_LOAD, 1000000, // Address 0
+        OP_LOAD, 1,       // Address 2: loop
+        OP_SUB,           // Address 4
+        OP_DUP,           // Address 5
+        OP_BNZ, 2,        // Address 6
+        OP_HALT           // Address 8
+    };
+    static const char *const modes[] = { "observed", "fused", "blocks" };
+    long steps_seen = 0;
+    for (int mode = 0; mode <= 2; mode++) {
+        vm_step(&vm, VM_EV_RESET, 0, NULL);
+        vm_load_program(&vm, prog6, sizeof(prog6)/sizeof(prog6[0]));
+        vm_set_observer(&vm, mode == 0 ? count_steps : NULL, &steps_seen);
+        vm_set_blocks(&vm, mode == 2);
+        clock_t start = clock();
+        bool halted = vm_run_steps(&vm, false, 100000000);
+        double ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+        printf("%s: %s in %.1f ms", modes[mode], halted ? "halted" : "stopped", ms);
+        if (mode == 0) printf(", %ld steps", steps_seen);
+        printf("\n");
+    }
+    vm_set_observer(&vm, NULL, NULL);
+
+    printf("\nProgram 7: A million ticks of a counter, each two calls deep\n");
+    uint32_t prog7[] = {
+        OP_LOAD, 1000000, // Address 0
+        OP_STORE, 200,    // Address 2
+        OP_CALL, 11,      // Address 4: loop, tick
+        OP_FETCH, 200,    // Address 6
+        OP_BNZ, 4,        // Address 8
+        OP_HALT,          // Address 10
+        OP_FETCH, 200,    // Address 11: tick, counter - 1
+        OP_LOAD, 1,       // Address 13
+        OP_SUB,           // Address 15
+        OP_CALL, 20,      // Address 16
+        OP_RET,           // Address 18
+        OP_NOP,           // Address 19
+        OP_STORE, 200,    // Address 20: put it back
+        OP_RET            // Address 22
+    };
+    int length7 = sizeof(prog7)/sizeof(prog7[0]);
+    for (int mode = 1; mode <= 2; mode++) {
+        vm_step(&vm, VM_EV_RESET, 0, NULL);
+        vm_load_program(&vm, prog7, length7);
+        vm_set_blocks(&vm, mode == 2);
+        clock_t start = clock();
+        bool halted = vm_run_steps(&vm, false, 100000000);
+        double ms = 1000.0 * (clock() - start) / CLOCKS_PER_SEC;
+        printf("%s: %s in %.1f ms, counter %" PRIu32 "\n", modes[mode],
+               halted ? "halted" : "stopped", ms, vm.memory[200]);
+    }
+    vm_set_blocks(&vm, false);
+
+    // Stopped by the step limit anywhere in a block, and in the errors
+    bool agree = true;
+    for (long limit = 0; limit < 200; limit++) {
+        agree &= blocks_agree(prog7, length7, limit);
+        agree &= blocks_agree(prog6, sizeof(prog6)/sizeof(prog6[0]), limit);
+    }
+    agree &= blocks_agree(prog5, sizeof(prog5)/sizeof(prog5[0]), 1000);
+    uint32_t overflow[] = { OP_CALL, 0 };           // call stack overflow
+    uint32_t divide[] = { OP_LOAD, 7, OP_LOAD, 0, OP_DIV, OP_HALT };
+    uint32_t patch[] = {                             // stores into its own block
+        OP_LOAD, OP_HALT, OP_STORE, 6, OP_LOAD, 1, OP_NOP, OP_PRINT, OP_HALT
+    };
+    agree &= blocks_agree(overflow, 2, 1000);
+    agree &= blocks_agree(divide, 6, 1000);
+    agree &= blocks_agree(patch, 9, 1000);
+    printf("blocks and fused stop in the same state: %s\n", agree ? "yes" : "NO");
+
     return 0;
 }
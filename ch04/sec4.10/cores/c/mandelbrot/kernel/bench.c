@@ -0,0 +1,122 @@
+// Host benchmark of the Mandelbrot kernels: each variant draws the same
+// views as the demos, at a size given on the command line, and reports
+// Mpixels/s and how many pixels differ from the scalar double kernel
+//
+//   ./bench [width height [max_iterations]]
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "mandelbrot_kernel.h"
+#include "mandelbrot_simd.h"
+
+#define MIN_BENCH_SECONDS 0.25
+
+typedef struct {
+    const char *name;
+    double center_x, center_y, zoom;
+} bench_view_t;
+
+static const bench_view_t views[] = {
+    { "default", -0.5, 0.0, 1.0 },
+    { "seahorse", -0.75, 0.1, 50.0 },
+    { "elephant", 0.28, 0.008, 200.0 },
+};
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// The demos' mapping: 2.5 / zoom high, as wide as the aspect makes it
+static mandelbrot_grid_t grid_for_view(const bench_view_t *v, int width, int height,
+                                       int max_iterations) {
+    double range_y = 2.5 / v->zoom;
+    double range_x = range_y * width / height;
+    
+    mandelbrot_grid_t g = {
+        .width = width,
+        .height = height,
+        .max_iterations = max_iterations,
+        .min_x = v->center_x - range_x / 2.0,
+        .min_y = v->center_y - range_y / 2.0,
+        .step_x = range_x / width,
+        .step_y = range_y / height,
+    };
+    return g;
+}
+
+static void render(const mandelbrot_variant_t *variant, const mandelbrot_grid_t *g, int *iterations) {
+    for (int py = 0; py < g->height; py++) {
+        variant->row(g, py, &iterations[py * g->width]);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int width = 640, height = 480, max_iterations = 256;
+    if (argc >= 3) {
+        width = atoi(argv[1]);
+        height = atoi(argv[2]);
+    }
+    if (argc >= 4) max_iterations = atoi(argv[3]);
+    if (width <= 0 || height <= 0 || max_iterations <= 0) {
+        fprintf(stderr, "usage: %s [width height [max_iterations]]\n", argv[0]);
+        return 1;
+    }
+    
+    size_t pixels = (size_t)width * height;
+    int *reference = malloc(pixels * sizeof(int));
+    int *iterations = malloc(pixels * sizeof(int));
+    if (!reference || !iterations) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    
+    printf("%dx%d pixels, %d iterations\n", width, height, max_iterations);
+    
+    for (size_t i = 0; i < sizeof(views) / sizeof(views[0]); i++) {
+        mandelbrot_grid_t g = grid_for_view(&views[i], width, height, max_iterations);
+        render(&mandelbrot_variants[0], &g, reference);
+        
+        printf("\n%s (%g, %g) zoom %g\n", views[i].name,
+               views[i].center_x, views[i].center_y, views[i].zoom);
+        printf("  %-14s %5s %10s %10s\n", "variant", "lanes", "Mpixels/s", "differ");
+        
+        for (int v = 0; v < mandelbrot_variant_count; v++) {
+            const mandelbrot_variant_t *variant = &mandelbrot_variants[v];
+            if (!variant->supported()) {
+                printf("  %-14s %5d %10s\n", variant->name, variant->lanes, "n/a");
+                continue;
+            }
+            if (variant->row == mandelbrot_variants[1].row &&
+                !use_fixed_point(g.min_x, g.min_x + g.step_x * width,
+                                 g.min_y, g.min_y + g.step_y * height, g.step_x, g.step_y)) {
+                printf("  %-14s %5d %10s   (view too deep for Q4.28)\n",
+                       variant->name, variant->lanes, "n/a");
+                continue;
+            }
+            
+            // Repeat until the time is long enough to trust
+            int runs = 0;
+            double start = now_seconds(), elapsed;
+            do {
+                render(variant, &g, iterations);
+                runs++;
+                elapsed = now_seconds() - start;
+            } while (elapsed < MIN_BENCH_SECONDS);
+            
+            size_t differ = 0;
+            for (size_t p = 0; p < pixels; p++) differ += iterations[p] != reference[p];
+            
+            printf("  %-14s %5d %10.2f %9.3f%%\n", variant->name, variant->lanes,
+                   pixels * runs / elapsed / 1e6, 100.0 * differ / pixels);
+        }
+    }
+    
+    free(reference);
+    free(iterations);
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include <math.h>
+#include "mandelbrot_kernel.h"
+
+int mandelbrot_iterations(double cx, double cy, int max_iterations, int *escape) {
+    double x = 0.0, y = 0.0;
+    int iteration = 0;
+    
+    while (x * x + y * y <= 4.0 && iteration < max_iterations) {
+        double xtemp = x * x - y * y + cx;
+        y = 2.0 * x * y + cy;
+        x = xtemp;
+        iteration++;
+    }
+    
+    *escape = iteration < max_iterations ? (int)((x * x + y * y - 4.0) * 4.0) : 0;
+    return iteration;
+}
+
+int mandelbrot_iterations_fixed(fix_t cx, fix_t cy, int max_iterations, int *escape) {
+    fix_t x = 0, y = 0;
+    int64_t zz = 0;
+    int iteration = 0;
+    
+    while (iteration < max_iterations) {
+        // The squares stay 64-bit until they pass the escape test:
+        // |x| can be up to 6.5 here and its square will not fit Q4.28
+        int64_t x2 = ((int64_t)x * x) >> FIX_SHIFT;
+        int64_t y2 = ((int64_t)y * y) >> FIX_SHIFT;
+        zz = x2 + y2;
+        if (zz > 4LL * FIX_ONE) break;
+        
+        y = (fix_t)((((int64_t)x * y) >> FIX_SHIFT) * 2) + cy;
+        x = (fix_t)(x2 - y2) + cx;
+        iteration++;
+    }
+    
+    *escape = iteration < max_iterations ? (int)((zz - 4LL * FIX_ONE) >> (FIX_SHIFT - 2)) : 0;
+    return iteration;
+}
+
+bool use_fixed_point(double min_x, double max_x, double min_y, double max_y,
+                     double step_x, double step_y) {
+    if (!MANDELBROT_FIXED_POINT) return false;
+    if (fabs(min_x) >= 4.0 || fabs(max_x) >= 4.0) return false;
+    if (fabs(min_y) >= 4.0 || fabs(max_y) >= 4.0) return false;
+    return step_x >= FIX_MIN_STEP && step_y >= FIX_MIN_STEP;
+}
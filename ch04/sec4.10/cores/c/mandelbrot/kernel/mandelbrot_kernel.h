@@ -0,0 +1,36 @@
+#ifndef MANDELBROT_KERNEL_H
+#define MANDELBROT_KERNEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// The Mandelbrot iteration shared by the onecore and twocores demos and
+// the host benchmark: plain C, no Pico SDK, so it builds for both
+
+// Fixed-point kernel: Q4.28 in 32 bits, each product a 32x32->64 bit
+// multiply, instead of soft-float doubles. Used while the view fits in
+// +-4 and a pixel step is at least 2^12 units, else doubles take over.
+// Set MANDELBROT_FIXED_POINT to 0 for doubles only
+#ifndef MANDELBROT_FIXED_POINT
+#define MANDELBROT_FIXED_POINT 1
+#endif
+
+#define FIX_SHIFT 28
+#define FIX_ONE (1 << FIX_SHIFT)
+#define FIX_MIN_STEP (4096.0 / FIX_ONE)
+typedef int32_t fix_t;
+
+static inline fix_t fix_from_double(double d) {
+    return (fix_t)(d * FIX_ONE);
+}
+
+// Iterations for c = cx + i cy, up to max_iterations. For a point that
+// escapes, *escape is |z|^2 then, in quarters above 4, for smooth colouring
+int mandelbrot_iterations(double cx, double cy, int max_iterations, int *escape);
+int mandelbrot_iterations_fixed(fix_t cx, fix_t cy, int max_iterations, int *escape);
+
+// Whether the fixed-point kernel can draw this view
+bool use_fixed_point(double min_x, double max_x, double min_y, double max_y,
+                     double step_x, double step_y);
+
+#endif // MANDELBROT_KERNEL_H
@@ -0,0 +1,254 @@
+#include "mandelbrot_kernel.h"
+#include "mandelbrot_simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86 1
+#endif
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#define HAVE_NEON 1
+#endif
+
+static bool always(void) {
+    return true;
+}
+
+// The device kernels, one point at a time
+
+static void row_scalar(const mandelbrot_grid_t *g, int py, int *iterations) {
+    double cy = g->min_y + py * g->step_y;
+    int escape;
+    for (int px = 0; px < g->width; px++) {
+        iterations[px] = mandelbrot_iterations(g->min_x + px * g->step_x, cy,
+                                               g->max_iterations, &escape);
+    }
+}
+
+static void row_fixed(const mandelbrot_grid_t *g, int py, int *iterations) {
+    fix_t min_x = fix_from_double(g->min_x), step_x = fix_from_double(g->step_x);
+    fix_t cy = fix_from_double(g->min_y) + py * fix_from_double(g->step_y);
+    int escape;
+    for (int px = 0; px < g->width; px++) {
+        iterations[px] = mandelbrot_iterations_fixed(min_x + px * step_x, cy,
+                                                     g->max_iterations, &escape);
+    }
+}
+
+// Points past the last whole group of lanes
+static void row_tail(const mandelbrot_grid_t *g, int py, int *iterations, int from) {
+    double cy = g->min_y + py * g->step_y;
+    int escape;
+    for (int px = from; px < g->width; px++) {
+        iterations[px] = mandelbrot_iterations(g->min_x + px * g->step_x, cy,
+                                               g->max_iterations, &escape);
+    }
+}
+
+#ifdef HAVE_X86
+
+// SSE2 is in every x86-64, and its doubles are the same as the scalar ones
+
+static void row_sse2_double(const mandelbrot_grid_t *g, int py, int *iterations) {
+    const __m128d four = _mm_set1_pd(4.0), one = _mm_set1_pd(1.0);
+    const __m128d cy = _mm_set1_pd(g->min_y + py * g->step_y);
+    int px = 0;
+    
+    for (; px + 2 <= g->width; px += 2) {
+        __m128d cx = _mm_set_pd(g->min_x + (px + 1) * g->step_x, g->min_x + px * g->step_x);
+        __m128d x = _mm_setzero_pd(), y = _mm_setzero_pd(), count = _mm_setzero_pd();
+        
+        for (int i = 0; i < g->max_iterations; i++) {
+            __m128d x2 = _mm_mul_pd(x, x), y2 = _mm_mul_pd(y, y);
+            __m128d inside = _mm_cmple_pd(_mm_add_pd(x2, y2), four);
+            if (_mm_movemask_pd(inside) == 0) break;
+            count = _mm_add_pd(count, _mm_and_pd(inside, one));
+            
+            __m128d xy = _mm_mul_pd(x, y);
+            y = _mm_add_pd(_mm_add_pd(xy, xy), cy);
+            x = _mm_add_pd(_mm_sub_pd(x2, y2), cx);
+        }
+        
+        double out[2];
+        _mm_storeu_pd(out, count);
+        iterations[px] = (int)out[0];
+        iterations[px + 1] = (int)out[1];
+    }
+    row_tail(g, py, iterations, px);
+}
+
+static void row_sse2_float(const mandelbrot_grid_t *g, int py, int *iterations) {
+    const __m128 four = _mm_set1_ps(4.0f), one = _mm_set1_ps(1.0f);
+    const __m128 cy = _mm_set1_ps((float)(g->min_y + py * g->step_y));
+    int px = 0;
+    
+    for (; px + 4 <= g->width; px += 4) {
+        __m128 cx = _mm_setr_ps((float)(g->min_x + px * g->step_x),
+                                (float)(g->min_x + (px + 1) * g->step_x),
+                                (float)(g->min_x + (px + 2) * g->step_x),
+                                (float)(g->min_x + (px + 3) * g->step_x));
+        __m128 x = _mm_setzero_ps(), y = _mm_setzero_ps(), count = _mm_setzero_ps();
+        
+        for (int i = 0; i < g->max_iterations; i++) {
+            __m128 x2 = _mm_mul_ps(x, x), y2 = _mm_mul_ps(y, y);
+            __m128 inside = _mm_cmple_ps(_mm_add_ps(x2, y2), four);
+            if (_mm_movemask_ps(inside) == 0) break;
+            count = _mm_add_ps(count, _mm_and_ps(inside, one));
+            
+            __m128 xy = _mm_mul_ps(x, y);
+            y = _mm_add_ps(_mm_add_ps(xy, xy), cy);
+            x = _mm_add_ps(_mm_sub_ps(x2, y2), cx);
+        }
+        
+        __m128i counts = _mm_cvtps_epi32(count);
+        _mm_storeu_si128((__m128i *)&iterations[px], counts);
+    }
+    row_tail(g, py, iterations, px);
+}
+
+// AVX2 only where the CPU has it: these are built for it one function at
+// a time, and picked at run time
+
+static bool avx2_supported(void) {
+    return __builtin_cpu_supports("avx2");
+}
+
+__attribute__((target("avx2")))
+static void row_avx2_double(const mandelbrot_grid_t *g, int py, int *iterations) {
+    const __m256d four = _mm256_set1_pd(4.0), one = _mm256_set1_pd(1.0);
+    const __m256d cy = _mm256_set1_pd(g->min_y + py * g->step_y);
+    const __m256d lane = _mm256_setr_pd(0.0, 1.0, 2.0, 3.0);
+    const __m256d step_x = _mm256_set1_pd(g->step_x);
+    int px = 0;
+    
+    for (; px + 4 <= g->width; px += 4) {
+        // min_x + px * step_x for each lane, as the scalar code rounds it
+        __m256d cx = _mm256_add_pd(_mm256_set1_pd(g->min_x),
+                                   _mm256_mul_pd(_mm256_add_pd(_mm256_set1_pd(px), lane), step_x));
+        __m256d x = _mm256_setzero_pd(), y = _mm256_setzero_pd(), count = _mm256_setzero_pd();
+        
+        for (int i = 0; i < g->max_iterations; i++) {
+            __m256d x2 = _mm256_mul_pd(x, x), y2 = _mm256_mul_pd(y, y);
+            __m256d inside = _mm256_cmp_pd(_mm256_add_pd(x2, y2), four, _CMP_LE_OQ);
+            if (_mm256_movemask_pd(inside) == 0) break;
+            count = _mm256_add_pd(count, _mm256_and_pd(inside, one));
+            
+            __m256d xy = _mm256_mul_pd(x, y);
+            y = _mm256_add_pd(_mm256_add_pd(xy, xy), cy);
+            x = _mm256_add_pd(_mm256_sub_pd(x2, y2), cx);
+        }
+        
+        _mm_storeu_si128((__m128i *)&iterations[px], _mm256_cvtpd_epi32(count));
+    }
+    row_tail(g, py, iterations, px);
+}
+
+__attribute__((target("avx2")))
+static void row_avx2_float(const mandelbrot_grid_t *g, int py, int *iterations) {
+    const __m256 four = _mm256_set1_ps(4.0f), one = _mm256_set1_ps(1.0f);
+    const __m256 cy = _mm256_set1_ps((float)(g->min_y + py * g->step_y));
+    int px = 0;
+    
+    for (; px + 8 <= g->width; px += 8) {
+        float cx_lanes[8];
+        for (int k = 0; k < 8; k++) cx_lanes[k] = (float)(g->min_x + (px + k) * g->step_x);
+        __m256 cx = _mm256_loadu_ps(cx_lanes);
+        __m256 x = _mm256_setzero_ps(), y = _mm256_setzero_ps(), count = _mm256_setzero_ps();
+        
+        for (int i = 0; i < g->max_iterations; i++) {
+            __m256 x2 = _mm256_mul_ps(x, x), y2 = _mm256_mul_ps(y, y);
+            __m256 inside = _mm256_cmp_ps(_mm256_add_ps(x2, y2), four, _CMP_LE_OQ);
+            if (_mm256_movemask_ps(inside) == 0) break;
+            count = _mm256_add_ps(count, _mm256_and_ps(inside, one));
+            
+            __m256 xy = _mm256_mul_ps(x, y);
+            y = _mm256_add_ps(_mm256_add_ps(xy, xy), cy);
+            x = _mm256_add_ps(_mm256_sub_ps(x2, y2), cx);
+        }
+        
+        _mm256_storeu_si256((__m256i *)&iterations[px], _mm256_cvtps_epi32(count));
+    }
+    row_tail(g, py, iterations, px);
+}
+
+#endif // HAVE_X86
+
+#ifdef HAVE_NEON
+
+// AArch64 NEON, which has doubles as well as floats
+
+static void row_neon_double(const mandelbrot_grid_t *g, int py, int *iterations) {
+    const float64x2_t four = vdupq_n_f64(4.0);
+    const float64x2_t cy = vdupq_n_f64(g->min_y + py * g->step_y);
+    int px = 0;
+    
+    for (; px + 2 <= g->width; px += 2) {
+        double cx_lanes[2] = { g->min_x + px * g->step_x, g->min_x + (px + 1) * g->step_x };
+        float64x2_t cx = vld1q_f64(cx_lanes);
+        float64x2_t x = vdupq_n_f64(0.0), y = vdupq_n_f64(0.0);
+        int64x2_t count = vdupq_n_s64(0);
+        
+        for (int i = 0; i < g->max_iterations; i++) {
+            float64x2_t x2 = vmulq_f64(x, x), y2 = vmulq_f64(y, y);
+            uint64x2_t inside = vcleq_f64(vaddq_f64(x2, y2), four);
+            if (vmaxvq_u32(vreinterpretq_u32_u64(inside)) == 0) break;
+            count = vsubq_s64(count, vreinterpretq_s64_u64(inside));   // all ones is -1
+            
+            float64x2_t xy = vmulq_f64(x, y);
+            y = vaddq_f64(vaddq_f64(xy, xy), cy);
+            x = vaddq_f64(vsubq_f64(x2, y2), cx);
+        }
+        
+        iterations[px] = (int)vgetq_lane_s64(count, 0);
+        iterations[px + 1] = (int)vgetq_lane_s64(count, 1);
+    }
+    row_tail(g, py, iterations, px);
+}
+
+static void row_neon_float(const mandelbrot_grid_t *g, int py, int *iterations) {
+    const float32x4_t four = vdupq_n_f32(4.0f);
+    const float32x4_t cy = vdupq_n_f32((float)(g->min_y + py * g->step_y));
+    int px = 0;
+    
+    for (; px + 4 <= g->width; px += 4) {
+        float cx_lanes[4];
+        for (int k = 0; k < 4; k++) cx_lanes[k] = (float)(g->min_x + (px + k) * g->step_x);
+        float32x4_t cx = vld1q_f32(cx_lanes);
+        float32x4_t x = vdupq_n_f32(0.0f), y = vdupq_n_f32(0.0f);
+        int32x4_t count = vdupq_n_s32(0);
+        
+        for (int i = 0; i < g->max_iterations; i++) {
+            float32x4_t x2 = vmulq_f32(x, x), y2 = vmulq_f32(y, y);
+            uint32x4_t inside = vcleq_f32(vaddq_f32(x2, y2), four);
+            if (vmaxvq_u32(inside) == 0) break;
+            count = vsubq_s32(count, vreinterpretq_s32_u32(inside));
+            
+            float32x4_t xy = vmulq_f32(x, y);
+            y = vaddq_f32(vaddq_f32(xy, xy), cy);
+            x = vaddq_f32(vsubq_f32(x2, y2), cx);
+        }
+        
+        vst1q_s32(&iterations[px], count);
+    }
+    row_tail(g, py, iterations, px);
+}
+
+#endif // HAVE_NEON
+
+const mandelbrot_variant_t mandelbrot_variants[] = {
+    { "scalar double", 1, row_scalar, always },
+    { "scalar fixed", 1, row_fixed, always },
+#ifdef HAVE_X86
+    { "sse2 double", 2, row_sse2_double, always },
+    { "sse2 float", 4, row_sse2_float, always },
+    { "avx2 double", 4, row_avx2_double, avx2_supported },
+    { "avx2 float", 8, row_avx2_float, avx2_supported },
+#endif
+#ifdef HAVE_NEON
+    { "neon double", 2, row_neon_double, always },
+    { "neon float", 4, row_neon_float, always },
+#endif
+};
+
+const int mandelbrot_variant_count = sizeof(mandelbrot_variants) / sizeof(mandelbrot_variants[0]);
@@ -0,0 +1,30 @@
+#ifndef MANDELBROT_SIMD_H
+#define MANDELBROT_SIMD_H
+
+#include <stdbool.h>
+
+// Host only: whole rows of pixels through the shared kernels, and
+// through SIMD versions of the double kernel that iterate one point per
+// lane. A lane that has escaped stops counting but goes on with the
+// others, until all have escaped or reached the limit
+
+// Pixel (px, py) is c = min_x + px * step_x + i (min_y + py * step_y),
+// as the demos map the screen
+typedef struct {
+    int width, height, max_iterations;
+    double min_x, min_y, step_x, step_y;
+} mandelbrot_grid_t;
+
+typedef void (*mandelbrot_row_fn)(const mandelbrot_grid_t *g, int py, int *iterations);
+
+typedef struct {
+    const char *name;
+    int lanes;                  // points per instruction
+    mandelbrot_row_fn row;
+    bool (*supported)(void);    // on this CPU
+} mandelbrot_variant_t;
+
+extern const mandelbrot_variant_t mandelbrot_variants[];
+extern const int mandelbrot_variant_count;
+
+#endif // MANDELBROT_SIMD_H
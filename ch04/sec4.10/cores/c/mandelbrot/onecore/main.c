@@ -1,11 +1,17 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 #include "pico/stdlib.h"
 #include "display.h"
+#include "mandelbrot_kernel.h"
 
 // Mandelbrot calculation parameters
-#define MAX_ITERATIONS 64
+// Iteration limit, raised as the view zooms in: deeper views need more
+// iterations to tell the set from the points around it. At most 255,
+// as the iteration buffer keeps a byte per pixel
+#define ITERATIONS_BASE 64
+#define ITERATIONS_LIMIT 255
 #define ZOOM_FACTOR 1.5
 
 typedef struct {
@@ -20,15 +26,30 @@ static view_t view = {
     .zoom = 1.0
 };
 
-// colour palette for Mandelbrot set
-static uint16_t get_mandelbrot_color(int iterations) {
-    if (iterations == MAX_ITERATIONS) {
-        return COLOR_BLACK; // Inside set
-    }
-    
-    // Create smooth colour gradient
-    float t = (float)iterations / MAX_ITERATIONS;
-    
+static int max_iterations = 0;   // for the last render; 0 before the first
+
+// Colour palette for the Mandelbrot set, a table built for the iteration
+// limit, so no float work is left per pixel: PALETTE_STEPS entries per
+// iteration count, the ones between counts for smooth colouring
+#define PALETTE_STEPS 4
+static uint16_t palette[ITERATIONS_LIMIT * PALETTE_STEPS + 1];
+
+// Smooth colouring: how far a point got past the escape radius tells
+// how far it is from escaping one iteration sooner. Looked up by |z|^2
+// at escape in quarters above 4; all 0 (whole counts) unless enabled
+#ifndef MANDELBROT_SMOOTH
+#define MANDELBROT_SMOOTH 0
+#endif
+
+#define ESCAPE_STEPS 48         // |z|^2 of 4 to 16
+static uint8_t escape_fraction[ESCAPE_STEPS];
+
+static inline int smooth_fraction(int quarters) {
+    return escape_fraction[quarters < ESCAPE_STEPS ? quarters : ESCAPE_STEPS - 1];
+}
+
+// Smooth colour gradient, t from 0 to 1
+static uint16_t gradient_color(float t) {
     // Generate RGB values with smooth transitions
     int r = (int)(9 * (1 - t) * t * t * t * 255);
     int g = (int)(15 * (1 - t) * (1 - t) * t * t * 255);
@@ -43,23 +64,234 @@ static uint16_t get_mandelbrot_color(int iterations) {
     return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
 }
 
-// Calculate Mandelbrot iterations for a given point
-static int mandelbrot_iterations(double cx, double cy) {
-    double x = 0.0, y = 0.0;
-    int iteration = 0;
+static void build_palette(int limit) {
+    int entries = limit * PALETTE_STEPS;
+    for (int i = 0; i < entries; i++) {
+        palette[i] = gradient_color((float)i / entries);
+    }
+    palette[entries] = COLOR_BLACK; // Inside set
+    
+    for (int k = 0; k < ESCAPE_STEPS && MANDELBROT_SMOOTH; k++) {
+        // Continuous count n + 1 - log2(log2 |z|), |z| the first past 2
+        float zz = 4.0f + (k + 0.5f) / 4.0f;
+        float fraction = 1.0f - log2f(log2f(zz) / 2.0f);
+        int step = (int)(fraction * PALETTE_STEPS);
+        escape_fraction[k] = step < 0 ? 0 : step >= PALETTE_STEPS ? PALETTE_STEPS - 1 : step;
+    }
+}
+
+// Iterations for a zoom: 32 more each time it doubles
+static int iterations_for_zoom(double zoom) {
+    int limit = ITERATIONS_BASE;
+    if (zoom > 1.0) limit += (int)(32.0 * log2(zoom));
+    return limit < ITERATIONS_LIMIT ? limit : ITERATIONS_LIMIT;
+}
+
+// Use the limit for a zoom, building the palette again if it changed
+static void set_iteration_limit(double zoom) {
+    int limit = iterations_for_zoom(zoom);
+    if (limit != max_iterations) {
+        max_iterations = limit;
+        build_palette(limit);
+    }
+}
+
+static inline uint16_t get_mandelbrot_color(int iterations, int fraction) {
+    return palette[iterations * PALETTE_STEPS + fraction];
+}
+
+// Show the render rate over the top left of the image
+static void draw_render_rate(uint64_t render_us, bool fixed) {
+    char text[32];
+    uint32_t pixels_per_sec = (uint32_t)((uint64_t)DISPLAY_WIDTH * DISPLAY_HEIGHT * 1000000 /
+                                         (render_us ? render_us : 1));
+    snprintf(text, sizeof(text), "%lu PX/S %s", (unsigned long)pixels_per_sec, fixed ? "FIX" : "DBL");
+    display_draw_string(2, 2, text, COLOR_WHITE, COLOR_BLACK);
+}
+
+// Last render, for the rate shown on screen
+static uint64_t last_render_us = 0;
+static bool last_render_fixed = false;
+
+// Pixel to complex plane mapping of one render
+typedef struct {
+    bool fixed;
+    double min_x, min_y, step_x, step_y;
+    fix_t min_x_fix, min_y_fix, step_x_fix, step_y_fix;
+    double origin_px, origin_py;    // where c = 0 falls, in pixels
+} frame_t;
+
+// Iterations of a pixel, and its palette step between counts
+static int pixel_iterations(const frame_t *f, int px, int py, int *fraction) {
+    int iterations, escape;
+    if (f->fixed) {
+        iterations = mandelbrot_iterations_fixed(f->min_x_fix + px * f->step_x_fix,
+                                                 f->min_y_fix + py * f->step_y_fix,
+                                                 max_iterations, &escape);
+    } else {
+        iterations = mandelbrot_iterations(f->min_x + px * f->step_x, f->min_y + py * f->step_y,
+                                           max_iterations, &escape);
+    }
+    *fraction = iterations < max_iterations ? smooth_fraction(escape) : 0;
+    return iterations;
+}
+
+// Iteration count of each pixel on screen, kept next to the framebuffer
+// so a pan can move what is already known
+static uint8_t *iteration_buffer = NULL;
+
+static int plot(uint16_t *framebuffer, const frame_t *f, int px, int py) {
+    int fraction;
+    int iterations = pixel_iterations(f, px, py, &fraction);
+    framebuffer[py * DISPLAY_WIDTH + px] = get_mandelbrot_color(iterations, fraction);
+    iteration_buffer[py * DISPLAY_WIDTH + px] = iterations;
+    return iterations;
+}
+
+// Fill a rectangle with an iteration count and its colour
+static void fb_fill_rect(uint16_t *framebuffer, int x, int y, int w, int h,
+                         int iterations, uint16_t color) {
+    for (int py = y; py < y + h; py++) {
+        uint16_t *row = &framebuffer[py * DISPLAY_WIDTH + x];
+        for (int px = 0; px < w; px++) row[px] = color;
+        memset(&iteration_buffer[py * DISPLAY_WIDTH + x], iterations, w);
+    }
+}
+
+// Mariani-Silver subdivision: only the border of a rectangle is
+// computed. The points that escape in fewer than n iterations reach
+// out to infinity, and those that take more than n hold on to the set,
+// so a border that all escapes after n leaves nothing else inside it,
+// unless the rectangle holds the whole set (then it holds c = 0). A
+// border inside the set means all of it is. Otherwise the inside is
+// split in two and each half is done the same way. With smooth colours
+// only borders inside the set fill, as colours vary inside the others
+#define RECT_MIN_SIZE 6     // thinner rectangles are done pixel by pixel
+
+// Compute a rectangle's border; the iteration count all of it shares,
+// or -1 if it varies
+static int render_border(uint16_t *framebuffer, const frame_t *f,
+                         int x, int y, int w, int h) {
+    int first = plot(framebuffer, f, x, y);
+    bool uniform = true;
+    
+    for (int px = x + 1; px < x + w; px++) {
+        uniform &= plot(framebuffer, f, px, y) == first;
+        uniform &= plot(framebuffer, f, px, y + h - 1) == first;
+    }
+    uniform &= plot(framebuffer, f, x, y + h - 1) == first;
+    for (int py = y + 1; py < y + h - 1; py++) {
+        uniform &= plot(framebuffer, f, x, py) == first;
+        uniform &= plot(framebuffer, f, x + w - 1, py) == first;
+    }
+    
+    return uniform ? first : -1;
+}
+
+static void render_rect(uint16_t *framebuffer, const frame_t *f, int x, int y, int w, int h) {
+    if (w <= RECT_MIN_SIZE || h <= RECT_MIN_SIZE) {
+        for (int py = y; py < y + h; py++) {
+            for (int px = x; px < x + w; px++) plot(framebuffer, f, px, py);
+        }
+        return;
+    }
+    
+    int iterations = render_border(framebuffer, f, x, y, w, h);
+    bool holds_origin = f->origin_px >= x && f->origin_px < x + w &&
+                        f->origin_py >= y && f->origin_py < y + h;
+    
+    // Carry on with the inside
+    x++; y++; w -= 2; h -= 2;
+    
+    if (iterations == max_iterations ||
+        (!MANDELBROT_SMOOTH && iterations >= 0 && !holds_origin)) {
+        fb_fill_rect(framebuffer, x, y, w, h, iterations, get_mandelbrot_color(iterations, 0));
+    } else if (w >= h) {
+        render_rect(framebuffer, f, x, y, w / 2, h);
+        render_rect(framebuffer, f, x + w / 2, y, w - w / 2, h);
+    } else {
+        render_rect(framebuffer, f, x, y, w, h / 2);
+        render_rect(framebuffer, f, x, y + h / 2, w, h - h / 2);
+    }
+}
+
+// Progressive mode: a full render first iterates one pixel in 8x8 and
+// shows it as blocks, then 4x4, 2x2 and every pixel, each pass only the
+// pixels not done before. The first picture is there after 1/64 of the
+// work, but the last pass iterates all of the rest where subdivision
+// would skip most of the inside of the set
+#ifndef MANDELBROT_PROGRESSIVE
+#define MANDELBROT_PROGRESSIVE 0
+#endif
+
+#define PROGRESSIVE_BLOCK 8
+
+static void render_progressive(uint16_t *framebuffer, const frame_t *f) {
+    for (int block = PROGRESSIVE_BLOCK; block >= 1; block /= 2) {
+        for (int py = 0; py < DISPLAY_HEIGHT; py += block) {
+            for (int px = 0; px < DISPLAY_WIDTH; px += block) {
+                // Corners of the blocks of the pass before are done
+                bool done = block < PROGRESSIVE_BLOCK &&
+                            px % (block * 2) == 0 && py % (block * 2) == 0;
+                int iterations, fraction;
+                uint16_t color;
+                if (done) {
+                    iterations = iteration_buffer[py * DISPLAY_WIDTH + px];
+                    color = framebuffer[py * DISPLAY_WIDTH + px];
+                } else {
+                    iterations = pixel_iterations(f, px, py, &fraction);
+                    color = get_mandelbrot_color(iterations, fraction);
+                }
+                
+                int w = px + block > DISPLAY_WIDTH ? DISPLAY_WIDTH - px : block;
+                int h = py + block > DISPLAY_HEIGHT ? DISPLAY_HEIGHT - py : block;
+                fb_fill_rect(framebuffer, px, py, w, h, iterations, color);
+            }
+        }
+        if (block > 1) display_blit_full(framebuffer);
+    }
+}
+
+// Move what the last render drew by (dx, dy) pixels, in both buffers
+static void shift_buffers(uint16_t *framebuffer, int dx, int dy) {
+    int w = DISPLAY_WIDTH - abs(dx);
+    int src_x = dx > 0 ? dx : 0, dst_x = dx > 0 ? 0 : -dx;
     
-    while (x * x + y * y <= 4.0 && iteration < MAX_ITERATIONS) {
-        double xtemp = x * x - y * y + cx;
-        y = 2.0 * x * y + cy;
-        x = xtemp;
-        iteration++;
+    // Rows in the order that does not overwrite one still to move
+    for (int i = 0; i < DISPLAY_HEIGHT - abs(dy); i++) {
+        int dst_y = dy > 0 ? i : DISPLAY_HEIGHT - 1 - i;
+        int src = (dst_y + dy) * DISPLAY_WIDTH + src_x;
+        int dst = dst_y * DISPLAY_WIDTH + dst_x;
+        memmove(&framebuffer[dst], &framebuffer[src], w * sizeof(uint16_t));
+        memmove(&iteration_buffer[dst], &iteration_buffer[src], w);
     }
+}
+
+// The last render, to tell a pan from other changes
+static frame_t last_frame;
+static bool last_frame_valid = false;
+
+// Whole pixels the view moved by since the last render, if that is all
+// that changed and some of the last render is still on screen
+static bool pan_offset(const frame_t *f, int *dx, int *dy) {
+    if (!last_frame_valid || f->fixed != last_frame.fixed) return false;
+    if (f->step_x != last_frame.step_x || f->step_y != last_frame.step_y) return false;
     
-    return iteration;
+    double x = (f->min_x - last_frame.min_x) / f->step_x;
+    double y = (f->min_y - last_frame.min_y) / f->step_y;
+    *dx = (int)lround(x);
+    *dy = (int)lround(y);
+    if (fabs(x - *dx) > 1e-3 || fabs(y - *dy) > 1e-3) return false;
+    return abs(*dx) < DISPLAY_WIDTH && abs(*dy) < DISPLAY_HEIGHT;
 }
 
 // Render the Mandelbrot set to a buffer
 static void render_mandelbrot(uint16_t *framebuffer, view_t *v) {
+    uint64_t start_us = time_us_64();
+    frame_t f;
+    
+    set_iteration_limit(v->zoom);
+    
     // Calculate the complex plane bounds
     double aspect = (double)DISPLAY_WIDTH / (double)DISPLAY_HEIGHT;
     double range_y = 2.5 / v->zoom;
@@ -71,32 +303,49 @@ static void render_mandelbrot(uint16_t *framebuffer, view_t *v) {
     double max_y = v->center_y + range_y / 2.0;
     
     // Calculate step sizes
-    double step_x = (max_x - min_x) / DISPLAY_WIDTH;
-    double step_y = (max_y - min_y) / DISPLAY_HEIGHT;
+    f.min_x = min_x;
+    f.min_y = min_y;
+    f.step_x = (max_x - min_x) / DISPLAY_WIDTH;
+    f.step_y = (max_y - min_y) / DISPLAY_HEIGHT;
+    f.origin_px = -min_x / f.step_x;
+    f.origin_py = -min_y / f.step_y;
     
-    printf("Rendering Mandelbrot: zoom=%.2f, center=(%.4f, %.4f)\n", 
-           v->zoom, v->center_x, v->center_y);
+    f.fixed = use_fixed_point(min_x, max_x, min_y, max_y, f.step_x, f.step_y);
+    f.min_x_fix = fix_from_double(min_x);
+    f.step_x_fix = fix_from_double(f.step_x);
+    f.min_y_fix = fix_from_double(min_y);
+    f.step_y_fix = fix_from_double(f.step_y);
     
-    // Render each pixel
-    for (int py = 0; py < DISPLAY_HEIGHT; py++) {
-        double cy = min_y + py * step_y;
+    int dx, dy;
+    if (pan_offset(&f, &dx, &dy)) {
+        // A pan: keep what is still on screen and draw the strips it uncovered
+        printf("Panning Mandelbrot by (%d, %d) pixels\n", dx, dy);
+        shift_buffers(framebuffer, dx, dy);
         
-        for (int px = 0; px < DISPLAY_WIDTH; px++) {
-            double cx = min_x + px * step_x;
-            
-            int iterations = mandelbrot_iterations(cx, cy);
-            uint16_t color = get_mandelbrot_color(iterations);
-            
-            framebuffer[py * DISPLAY_WIDTH + px] = color;
+        int rows_y = dy > 0 ? DISPLAY_HEIGHT - dy : 0;
+        int kept_y = dy > 0 ? 0 : -dy;
+        int kept_h = DISPLAY_HEIGHT - abs(dy);
+        if (dy != 0) render_rect(framebuffer, &f, 0, rows_y, DISPLAY_WIDTH, abs(dy));
+        if (dx != 0) {
+            render_rect(framebuffer, &f, dx > 0 ? DISPLAY_WIDTH - dx : 0, kept_y, abs(dx), kept_h);
         }
+    } else {
+        printf("Rendering Mandelbrot: zoom=%.2f, center=(%.4f, %.4f), %d iterations, %s\n", 
+               v->zoom, v->center_x, v->center_y, max_iterations,
+               f.fixed ? "fixed point" : "double");
         
-        // Progress indicator every 10 lines
-        if (py % 10 == 0) {
-            printf(".");
-            fflush(stdout);
+        if (MANDELBROT_PROGRESSIVE) {
+            render_progressive(framebuffer, &f);
+        } else {
+            render_rect(framebuffer, &f, 0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
         }
     }
-    printf("\nRender complete!\n");
+    
+    last_frame = f;
+    last_frame_valid = true;
+    last_render_us = time_us_64() - start_us;
+    last_render_fixed = f.fixed;
+    printf("Render complete! %llu ms\n", (unsigned long long)(last_render_us / 1000));
 }
 
 // Button callbacks
@@ -141,7 +390,7 @@ int main() {
     
     printf("\n-- Mandelbrot Set Renderer --\n");
     printf("Display: %dx%d pixels\n", DISPLAY_WIDTH, DISPLAY_HEIGHT);
-    printf("Max iterations: %d\n\n", MAX_ITERATIONS);
+    printf("Max iterations: %d, up to %d zoomed in\n\n", ITERATIONS_BASE, ITERATIONS_LIMIT);
     
     // Initialize display
     printf("Init display..\n");
@@ -175,6 +424,11 @@ int main() {
         printf("Failed to allocate framebuffer!\n");
         return 1;
     }
+    iteration_buffer = (uint8_t *)malloc(DISPLAY_WIDTH * DISPLAY_HEIGHT);
+    if (!iteration_buffer) {
+        printf("Failed to allocate iteration buffer!\n");
+        return 1;
+    }
     printf("Framebuffer allocated!\n\n");
     
     // Show initial instructions
@@ -192,6 +446,7 @@ int main() {
     printf("-- Initial Render --\n");
     render_mandelbrot(framebuffer, &view);
     display_blit_full(framebuffer);
+    draw_render_rate(last_render_us, last_render_fixed);
     
     printf("\n-- Ready! Use buttons to navigate --\n");
     printf("A=Zoom In, B=Zoom Out, X=Pan Up, Y=Pan Down\n\n");
@@ -209,6 +464,7 @@ int main() {
             printf("\n-- Redrawing Frame %lu --\n", frame_count++);
             render_mandelbrot(framebuffer, &view);
             display_blit_full(framebuffer);
+            draw_render_rate(last_render_us, last_render_fixed);
         }
         
         sleep_ms(10); // Small delay to reduce CPU usage
@@ -216,6 +472,7 @@ int main() {
     
     // Cleanup (unreachable but good practice)
     free(framebuffer);
+    free(iteration_buffer);
     display_cleanup();
     
     return 0;
@@ -2,12 +2,16 @@
 #include <stdio.h>
 #include <math.h>
 #include "pico/stdlib.h"
-#include "pico/multicore.h"
 #include "pico/sync.h"
 #include "display.h"
+#include "jobs.h"
+#include "mandelbrot_kernel.h"
 
 // Mandelbrot calculation parameters
-#define MAX_ITERATIONS 64
+// Iteration limit, raised as the view zooms in: deeper views need more
+// iterations to tell the set from the points around it
+#define ITERATIONS_BASE 64
+#define ITERATIONS_LIMIT 1024
 #define ZOOM_FACTOR 1.5
 
 typedef struct {
@@ -16,12 +20,27 @@ typedef struct {
     double zoom;
 } view_t;
 
+// A rectangle of pixels still to draw
+typedef struct {
+    int16_t x, y, w, h;
+} rect_t;
+
+#define WORK_QUEUE_SIZE 32
+
 typedef struct {
     uint16_t *framebuffer;
     view_t view;
-    volatile bool render_requested;
-    volatile bool core1_done;
-    mutex_t render_mutex;
+    
+    // Rectangles still to draw, shared by both cores: a core that has
+    // to split one leaves a half here for whichever core is free
+    spin_lock_t *work_lock;
+    rect_t work[WORK_QUEUE_SIZE];
+    volatile int work_count;    // rectangles in the queue
+    volatile int work_pending;  // ... and in the queue or being drawn
+    uint32_t busy_us[2];        // per core, last render
+    int rects_done[2];
+    uint64_t render_us;     // whole render, last time
+    bool fixed_point;       // ... and whether it was fixed point
 } render_state_t;
 
 static render_state_t render_state = {
@@ -31,21 +50,34 @@ static render_state_t render_state = {
         .center_y = 0.0,
         .zoom = 1.0
     },
-    .render_requested = false,
-    .core1_done = false
 };
 
 static volatile bool needs_redraw = false;
 
-// Colour palette for Mandelbrot set
-static uint16_t get_mandelbrot_color(int iterations) {
-    if (iterations == MAX_ITERATIONS) {
-        return COLOR_BLACK; // Inside set
-    }
-    
-    // Create a smooth colour gradient
-    float t = (float)iterations / MAX_ITERATIONS;
-    
+static int max_iterations = 0;   // for the last render; 0 before the first
+
+// Colour palette for the Mandelbrot set, a table built for the iteration
+// limit, so no float work is left per pixel: PALETTE_STEPS entries per
+// iteration count, the ones between counts for smooth colouring
+#define PALETTE_STEPS 4
+static uint16_t palette[ITERATIONS_LIMIT * PALETTE_STEPS + 1];
+
+// Smooth colouring: how far a point got past the escape radius tells
+// how far it is from escaping one iteration sooner. Looked up by |z|^2
+// at escape in quarters above 4; all 0 (whole counts) unless enabled
+#ifndef MANDELBROT_SMOOTH
+#define MANDELBROT_SMOOTH 0
+#endif
+
+#define ESCAPE_STEPS 48         // |z|^2 of 4 to 16
+static uint8_t escape_fraction[ESCAPE_STEPS];
+
+static inline int smooth_fraction(int quarters) {
+    return escape_fraction[quarters < ESCAPE_STEPS ? quarters : ESCAPE_STEPS - 1];
+}
+
+// Smooth colour gradient, t from 0 to 1
+static uint16_t gradient_color(float t) {
     // Generate RGB values with smooth transitions
     int r = (int)(9 * (1 - t) * t * t * t * 255);
     int g = (int)(15 * (1 - t) * (1 - t) * t * t * 255);
@@ -60,24 +92,190 @@ static uint16_t get_mandelbrot_color(int iterations) {
     return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
 }
 
-// Calculate Mandelbrot iterations for a given point
-static int mandelbrot_iterations(double cx, double cy) {
-    double x = 0.0, y = 0.0;
-    int iteration = 0;
+static void build_palette(int limit) {
+    int entries = limit * PALETTE_STEPS;
+    for (int i = 0; i < entries; i++) {
+        palette[i] = gradient_color((float)i / entries);
+    }
+    palette[entries] = COLOR_BLACK; // Inside set
+    
+    for (int k = 0; k < ESCAPE_STEPS && MANDELBROT_SMOOTH; k++) {
+        // Continuous count n + 1 - log2(log2 |z|), |z| the first past 2
+        float zz = 4.0f + (k + 0.5f) / 4.0f;
+        float fraction = 1.0f - log2f(log2f(zz) / 2.0f);
+        int step = (int)(fraction * PALETTE_STEPS);
+        escape_fraction[k] = step < 0 ? 0 : step >= PALETTE_STEPS ? PALETTE_STEPS - 1 : step;
+    }
+}
+
+// Iterations for a zoom: 32 more each time it doubles
+static int iterations_for_zoom(double zoom) {
+    int limit = ITERATIONS_BASE;
+    if (zoom > 1.0) limit += (int)(32.0 * log2(zoom));
+    return limit < ITERATIONS_LIMIT ? limit : ITERATIONS_LIMIT;
+}
+
+// Use the limit for a zoom, building the palette again if it changed
+static void set_iteration_limit(double zoom) {
+    int limit = iterations_for_zoom(zoom);
+    if (limit != max_iterations) {
+        max_iterations = limit;
+        build_palette(limit);
+    }
+}
+
+static inline uint16_t get_mandelbrot_color(int iterations, int fraction) {
+    return palette[iterations * PALETTE_STEPS + fraction];
+}
+
+// Show the render rate over the top left of the image
+static void draw_render_rate(uint64_t render_us, bool fixed) {
+    char text[32];
+    uint32_t pixels_per_sec = (uint32_t)((uint64_t)DISPLAY_WIDTH * DISPLAY_HEIGHT * 1000000 /
+                                         (render_us ? render_us : 1));
+    snprintf(text, sizeof(text), "%lu PX/S %s", (unsigned long)pixels_per_sec, fixed ? "FIX" : "DBL");
+    display_draw_string(2, 2, text, COLOR_WHITE, COLOR_BLACK);
+}
+
+// Pixel to complex plane mapping of one render
+typedef struct {
+    bool fixed;
+    double min_x, min_y, step_x, step_y;
+    fix_t min_x_fix, min_y_fix, step_x_fix, step_y_fix;
+    double origin_px, origin_py;    // where c = 0 falls, in pixels
+} frame_t;
+
+// Iterations of a pixel, and its palette step between counts
+static int pixel_iterations(const frame_t *f, int px, int py, int *fraction) {
+    int iterations, escape;
+    if (f->fixed) {
+        iterations = mandelbrot_iterations_fixed(f->min_x_fix + px * f->step_x_fix,
+                                                 f->min_y_fix + py * f->step_y_fix,
+                                                 max_iterations, &escape);
+    } else {
+        iterations = mandelbrot_iterations(f->min_x + px * f->step_x, f->min_y + py * f->step_y,
+                                           max_iterations, &escape);
+    }
+    *fraction = iterations < max_iterations ? smooth_fraction(escape) : 0;
+    return iterations;
+}
+
+static int plot(uint16_t *framebuffer, const frame_t *f, int px, int py) {
+    int fraction;
+    int iterations = pixel_iterations(f, px, py, &fraction);
+    framebuffer[py * DISPLAY_WIDTH + px] = get_mandelbrot_color(iterations, fraction);
+    return iterations;
+}
+
+static void fb_fill_rect(uint16_t *framebuffer, int x, int y, int w, int h, uint16_t color) {
+    for (int py = y; py < y + h; py++) {
+        uint16_t *row = &framebuffer[py * DISPLAY_WIDTH + x];
+        for (int px = 0; px < w; px++) row[px] = color;
+    }
+}
+
+// Queue a rectangle for either core; false when the queue is full
+static bool push_rect(int x, int y, int w, int h) {
+    uint32_t irq = spin_lock_blocking(render_state.work_lock);
+    bool queued = render_state.work_count < WORK_QUEUE_SIZE;
+    if (queued) {
+        render_state.work[render_state.work_count++] = (rect_t){ x, y, w, h };
+        render_state.work_pending++;
+    }
+    spin_unlock(render_state.work_lock, irq);
+    return queued;
+}
+
+// Take a queued rectangle, false if there is none just now
+static bool claim_rect(rect_t *r) {
+    uint32_t irq = spin_lock_blocking(render_state.work_lock);
+    bool claimed = render_state.work_count > 0;
+    if (claimed) *r = render_state.work[--render_state.work_count];
+    spin_unlock(render_state.work_lock, irq);
+    return claimed;
+}
+
+static void finish_rect(void) {
+    uint32_t irq = spin_lock_blocking(render_state.work_lock);
+    render_state.work_pending--;
+    spin_unlock(render_state.work_lock, irq);
+}
+
+// Mariani-Silver subdivision: only the border of a rectangle is
+// computed. The points that escape in fewer than n iterations reach
+// out to infinity, and those that take more than n hold on to the set,
+// so a border that all escapes after n leaves nothing else inside it,
+// unless the rectangle holds the whole set (then it holds c = 0). A
+// border inside the set means all of it is. Otherwise the inside is
+// split in two and each half is done the same way. With smooth colours
+// only borders inside the set fill, as colours vary inside the others
+#define RECT_MIN_SIZE 6     // thinner rectangles are done pixel by pixel
+
+// Compute a rectangle's border; the iteration count all of it shares,
+// or -1 if it varies
+static int render_border(uint16_t *framebuffer, const frame_t *f,
+                         int x, int y, int w, int h) {
+    int first = plot(framebuffer, f, x, y);
+    bool uniform = true;
     
-    while (x * x + y * y <= 4.0 && iteration < MAX_ITERATIONS) {
-        double xtemp = x * x - y * y + cx;
-        y = 2.0 * x * y + cy;
-        x = xtemp;
-        iteration++;
+    for (int px = x + 1; px < x + w; px++) {
+        uniform &= plot(framebuffer, f, px, y) == first;
+        uniform &= plot(framebuffer, f, px, y + h - 1) == first;
+    }
+    uniform &= plot(framebuffer, f, x, y + h - 1) == first;
+    for (int py = y + 1; py < y + h - 1; py++) {
+        uniform &= plot(framebuffer, f, x, py) == first;
+        uniform &= plot(framebuffer, f, x + w - 1, py) == first;
     }
     
-    return iteration;
+    return uniform ? first : -1;
+}
+
+// Draw a rectangle; of the two halves of a split one goes to the queue,
+// for the other core if it is free, and this core goes on with the other
+static void render_rect(uint16_t *framebuffer, const frame_t *f, int x, int y, int w, int h) {
+    while (true) {
+        if (w <= RECT_MIN_SIZE || h <= RECT_MIN_SIZE) {
+            for (int py = y; py < y + h; py++) {
+                for (int px = x; px < x + w; px++) plot(framebuffer, f, px, py);
+            }
+            return;
+        }
+        
+        int iterations = render_border(framebuffer, f, x, y, w, h);
+        bool holds_origin = f->origin_px >= x && f->origin_px < x + w &&
+                            f->origin_py >= y && f->origin_py < y + h;
+        
+        // Carry on with the inside
+        x++; y++; w -= 2; h -= 2;
+        
+        if (iterations == max_iterations ||
+            (!MANDELBROT_SMOOTH && iterations >= 0 && !holds_origin)) {
+            fb_fill_rect(framebuffer, x, y, w, h, get_mandelbrot_color(iterations, 0));
+            return;
+        }
+        
+        if (w >= h) {
+            if (!push_rect(x + w / 2, y, w - w / 2, h)) {
+                render_rect(framebuffer, f, x + w / 2, y, w - w / 2, h);
+            }
+            w /= 2;
+        } else {
+            if (!push_rect(x, y + h / 2, w, h - h / 2)) {
+                render_rect(framebuffer, f, x, y + h / 2, w, h - h / 2);
+            }
+            h /= 2;
+        }
+    }
 }
 
-// Render a portion of the Mandelbrot set (for multi-core rendering)
-static void render_mandelbrot_section(uint16_t *framebuffer, view_t *v, 
-                                     int start_line, int end_line, int core_id) {
+// Render queued rectangles of the Mandelbrot set until all are drawn
+// (for multi-core rendering: both cores run this at the same time)
+static void render_mandelbrot_rects(uint16_t *framebuffer, view_t *v, int core_id) {
+    uint64_t start_us = time_us_64();
+    int rects = 0;
+    frame_t f;
+    
     // Calculate the complex plane bounds
     double aspect = (double)DISPLAY_WIDTH / (double)DISPLAY_HEIGHT;
     double range_y = 2.5 / v->zoom;
@@ -89,86 +287,79 @@ static void render_mandelbrot_section(uint16_t *framebuffer, view_t *v,
     double max_y = v->center_y + range_y / 2.0;
     
     // Calculate step sizes
-    double step_x = (max_x - min_x) / DISPLAY_WIDTH;
-    double step_y = (max_y - min_y) / DISPLAY_HEIGHT;
+    f.min_x = min_x;
+    f.min_y = min_y;
+    f.step_x = (max_x - min_x) / DISPLAY_WIDTH;
+    f.step_y = (max_y - min_y) / DISPLAY_HEIGHT;
+    f.origin_px = -min_x / f.step_x;
+    f.origin_py = -min_y / f.step_y;
     
-    // Render assigned lines
-    for (int py = start_line; py < end_line; py++) {
-        double cy = min_y + py * step_y;
-        
-        for (int px = 0; px < DISPLAY_WIDTH; px++) {
-            double cx = min_x + px * step_x;
-            
-            int iterations = mandelbrot_iterations(cx, cy);
-            uint16_t color = get_mandelbrot_color(iterations);
-            
-            framebuffer[py * DISPLAY_WIDTH + px] = color;
-        }
-        
-        // Progress indicator
-        if (core_id == 0 && py % 20 == 0) {
-            printf("Core %d: line %d/%d\n", core_id, py, end_line);
+    // Both cores come to the same choice from the same view
+    f.fixed = use_fixed_point(min_x, max_x, min_y, max_y, f.step_x, f.step_y);
+    f.min_x_fix = fix_from_double(min_x);
+    f.step_x_fix = fix_from_double(f.step_x);
+    f.min_y_fix = fix_from_double(min_y);
+    f.step_y_fix = fix_from_double(f.step_y);
+    render_state.fixed_point = f.fixed;
+    
+    // Draw rectangles as they are claimed; a core that finds the queue
+    // empty waits while the other may still split more into it
+    while (render_state.work_pending > 0) {
+        rect_t r;
+        if (claim_rect(&r)) {
+            render_rect(framebuffer, &f, r.x, r.y, r.w, r.h);
+            finish_rect();
+            rects++;
+        } else {
+            tight_loop_contents();
         }
     }
+    
+    render_state.busy_us[core_id] = (uint32_t)(time_us_64() - start_us);
+    render_state.rects_done[core_id] = rects;
 }
 
-// Core 1 entry point - renders bottom half of screen
-void core1_entry() {
-    printf("Core 1 started!\n");
-    
-    while (true) {
-        // Wait for render request
-        while (!render_state.render_requested) {
-            sleep_ms(1);
-        }
-        
-        // Render bottom half (lines 120-239)
-        render_mandelbrot_section(render_state.framebuffer, 
-                                 &render_state.view,
-                                 DISPLAY_HEIGHT / 2, 
-                                 DISPLAY_HEIGHT,
-                                 1);
-        
-        // Signal completion
-        render_state.core1_done = true;
-        
-        // Wait for core 0 to clear the request
-        while (render_state.render_requested) {
-            sleep_ms(1);
-        }
-    }
+// Core 1's job - renders alongside core 0
+static void render_job(void *arg) {
+    (void)arg;
+    render_mandelbrot_rects(render_state.framebuffer, &render_state.view, 1);
 }
 
 // Render the full Mandelbrot set using both cores
 static void render_mandelbrot_parallel(uint16_t *framebuffer, view_t *v) {
-    printf("Rendering Mandelbrot (parallel): zoom=%.2f, center=(%.4f, %.4f)\n", 
-           v->zoom, v->center_x, v->center_y);
-    
     uint32_t start_time = to_ms_since_boot(get_absolute_time());
+    uint64_t start_us = time_us_64();
+    
+    // The palette is shared too, so it is built before core 1 starts
+    set_iteration_limit(v->zoom);
+    
+    printf("Rendering Mandelbrot (parallel): zoom=%.2f, center=(%.4f, %.4f), %d iterations\n", 
+           v->zoom, v->center_x, v->center_y, max_iterations);
     
     // Update shared state
     render_state.framebuffer = framebuffer;
     render_state.view = *v;
-    render_state.core1_done = false;
     
-    // Signal core 1 to start
-    render_state.render_requested = true;
+    // The whole screen is the first rectangle, split from there
+    render_state.work[0] = (rect_t){ 0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT };
+    render_state.work_count = 1;
+    render_state.work_pending = 1;
     
-    // Core 0 renders top half (lines 0-119)
-    render_mandelbrot_section(framebuffer, v, 0, DISPLAY_HEIGHT / 2, 0);
+    // Core 1 starts on it, and core 0 draws too, until nothing is left
+    jobs_submit(render_job, NULL);
+    render_mandelbrot_rects(framebuffer, v, 0);
     
     printf("Core 0 done, waiting for Core 1..\n");
-    
-    // Wait for core 1 to finish
-    while (!render_state.core1_done) {
-        tight_loop_contents();
-    }
-    
-    // Clear the render request
-    render_state.render_requested = false;
+    jobs_wait();
     
     uint32_t end_time = to_ms_since_boot(get_absolute_time());
-    printf("Render complete. Time: %lu ms\n", end_time - start_time);
+    render_state.render_us = time_us_64() - start_us;
+    printf("Render complete. Time: %lu ms (%s)\n", end_time - start_time,
+           render_state.fixed_point ? "fixed point" : "double");
+    for (int core = 0; core < 2; core++) {
+        printf("  Core %d: %d rectangles, busy %lu ms\n", core, render_state.rects_done[core],
+               render_state.busy_us[core] / 1000);
+    }
 }
 
 // Button callbacks
@@ -210,11 +401,11 @@ int main() {
     
     printf("\n-- Dual-Core Mandelbrot Set Renderer --\n");
     printf("Display: %dx%d pixels\n", DISPLAY_WIDTH, DISPLAY_HEIGHT);
-    printf("Max iterations: %d\n", MAX_ITERATIONS);
+    printf("Max iterations: %d, up to %d zoomed in\n", ITERATIONS_BASE, ITERATIONS_LIMIT);
     printf("Using both CPU cores for parallel rendering!\n\n");
     
-    // Initialize mutex
-    mutex_init(&render_state.render_mutex);
+    // Hardware spinlock for the shared row counter
+    render_state.work_lock = spin_lock_instance(spin_lock_claim_unused(true));
     
     // Initialize display
     printf("Init display..\n");
@@ -252,8 +443,7 @@ int main() {
     
     // Launch core 1
     printf("Launching Core 1..\n");
-    multicore_launch_core1(core1_entry);
-    sleep_ms(100); // Give core 1 time to start
+    jobs_init();
     
     // Show initial instructions
     display_clear(COLOR_BLACK);
@@ -270,6 +460,7 @@ int main() {
     printf("\n-- Initial Render --\n");
     render_mandelbrot_parallel(render_state.framebuffer, &render_state.view);
     display_blit_full(render_state.framebuffer);
+    draw_render_rate(render_state.render_us, render_state.fixed_point);
     
     printf("\n-- Ready! Use buttons to navigate --\n");
     printf("A=Zoom In, B=Zoom Out, X=Pan Up, Y=Pan Down\n\n");
@@ -287,6 +478,7 @@ int main() {
             printf("\n-- Redrawing Frame %lu --\n", frame_count++);
             render_mandelbrot_parallel(render_state.framebuffer, &render_state.view);
             display_blit_full(render_state.framebuffer);
+            draw_render_rate(render_state.render_us, render_state.fixed_point);
         }
         
         sleep_ms(10);
@@ -1,18 +1,38 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include "pico/stdlib.h"
-#include "pico/multicore.h"
-#include "pico/mutex.h"
 #include "hardware/sync.h"
 #include "display.h"
+#include "fbdma.h"
+#include "jobs.h"
+
+// Pipelined mode: core 1 moves every particle into frame N+1 while core 0
+// draws frame N from the other of two state buffers, the two swapping
+// buffers through the SIO FIFO. Drawing and physics overlap instead of
+// taking turns, so there can be twice the particles at the same rate.
+// Set PARTICLES_PIPELINED to 0 for the split: both cores update half of
+// the particles, by rows of grid cells, then core 0 draws
+#ifndef PARTICLES_PIPELINED
+#define PARTICLES_PIPELINED 1
+#endif
 
 // Particle system configuration
+#if PARTICLES_PIPELINED
+#define MAX_PARTICLES 1600
+#else
 #define MAX_PARTICLES 800
+#endif
 #define GRAVITY 0.15f
 #define BOUNCE_DAMPING 0.85f
 #define PARTICLE_RADIUS 2
 
+// Particles closer than this push each other apart, harder the closer
+// they are, which makes them pile up like a fluid instead of on one spot
+#define INTERACTION_RADIUS 4.0f
+#define REPULSION 0.05f
+
 // Display boundaries (full screen now)
 #define BOUNDS_LEFT 0
 #define BOUNDS_RIGHT DISPLAY_WIDTH
@@ -30,12 +50,27 @@ typedef struct {
     uint8_t core_id;      // Which core last updated this particle (for visualization)
 } Particle;
 
-// Shared state between cores
-static Particle particles[MAX_PARTICLES];
+// Shared state between cores: frame N and N+1. Each frame is computed
+// from the last only, so particles can read their neighbours while
+// others are being moved
+static Particle particles[2][MAX_PARTICLES];
 static int particle_count = MAX_PARTICLES;
-static mutex_t particle_mutex;
-static volatile bool core1_ready = false;
-static volatile bool rendering_done = true;
+static int split_row = 0;       // core 1 does the rows from here
+static int current = 0;         // the frame to draw, when split
+
+// Neighbour search: a grid of cells as wide as the interaction, and the
+// particles sorted by cell (counting sort) once per frame. Then only the
+// 3x3 cells around a particle can hold its neighbours, and a row of
+// cells is one run of cell_particles
+#define CELL_SHIFT 3
+#define CELL_SIZE (1 << CELL_SHIFT)
+#define GRID_COLS (DISPLAY_WIDTH / CELL_SIZE)
+#define GRID_ROWS (DISPLAY_HEIGHT / CELL_SIZE)
+#define GRID_CELLS (GRID_COLS * GRID_ROWS)
+
+static uint16_t cell_start[GRID_CELLS + 1];     // into cell_particles
+static uint16_t cell_particles[MAX_PARTICLES];  // particle indices
+static uint16_t particle_cell[MAX_PARTICLES];
 
 // Performance tracking
 static volatile uint32_t core0_cycles = 0;
@@ -90,64 +125,142 @@ static inline float randf(float min, float max) {
 }
 
 // Initialize particles
-void init_particles() {
+void init_particles(Particle *state) {
     for (int i = 0; i < MAX_PARTICLES; i++) {
-        particles[i].x = randf(BOUNDS_LEFT + 10, BOUNDS_RIGHT - 10);
-        particles[i].y = randf(BOUNDS_TOP + 10, BOUNDS_BOTTOM - 10);
-        particles[i].vx = randf(-2.0f, 2.0f);
-        particles[i].vy = randf(-2.0f, 2.0f);
-        particles[i].color = particle_colors[rand() % (sizeof(particle_colors) / sizeof(particle_colors[0]))];
-        particles[i].core_id = 0;
+        state[i].x = randf(BOUNDS_LEFT + 10, BOUNDS_RIGHT - 10);
+        state[i].y = randf(BOUNDS_TOP + 10, BOUNDS_BOTTOM - 10);
+        state[i].vx = randf(-2.0f, 2.0f);
+        state[i].vy = randf(-2.0f, 2.0f);
+        state[i].color = particle_colors[rand() % (sizeof(particle_colors) / sizeof(particle_colors[0]))];
+        state[i].core_id = 0;
     }
 }
 
-// Update physics for a range of particles
-void update_particles_range(int start, int end, uint8_t core_id) {
-    for (int i = start; i < end; i++) {
-        Particle *p = &particles[i];
-        
-        // Apply gravity and wind
-        p->vy += GRAVITY;
-        p->vx += wind_x * 0.1f;
-        p->vy += wind_y * 0.1f;
-        
-        // Update position
-        p->x += p->vx;
-        p->y += p->vy;
+static inline int cell_of(const Particle *p) {
+    int cx = (int)p->x >> CELL_SHIFT;
+    int cy = (int)p->y >> CELL_SHIFT;
+    cx = cx < 0 ? 0 : cx >= GRID_COLS ? GRID_COLS - 1 : cx;
+    cy = cy < 0 ? 0 : cy >= GRID_ROWS ? GRID_ROWS - 1 : cy;
+    return cy * GRID_COLS + cx;
+}
+
+// Sort the particles of a frame into the grid
+void bin_particles(const Particle *state) {
+    memset(cell_start, 0, sizeof(cell_start));
+    for (int i = 0; i < particle_count; i++) {
+        particle_cell[i] = cell_of(&state[i]);
+        cell_start[particle_cell[i]]++;
+    }
+    
+    // Each cell_start[c] runs to the end of cell c, then back down to its
+    // start as the particles go in; backwards keeps each cell in order
+    for (int c = 1; c < GRID_CELLS; c++) {
+        cell_start[c] += cell_start[c - 1];
+    }
+    for (int i = particle_count - 1; i >= 0; i--) {
+        cell_particles[--cell_start[particle_cell[i]]] = i;
+    }
+    cell_start[GRID_CELLS] = particle_count;
+}
+
+// The first row of cells of the second half of the particles
+int balanced_split_row(void) {
+    int row = 0;
+    while (row < GRID_ROWS && cell_start[row * GRID_COLS] < particle_count / 2) row++;
+    return row;
+}
+
+// Push from the neighbours of particle i, without a square root: the
+// offset scaled by how far inside the radius they are
+static inline void repel(const Particle *from, int i, float *ax, float *ay) {
+    const Particle *p = &from[i];
+    int cell = particle_cell[i];
+    int cx = cell % GRID_COLS, cy = cell / GRID_COLS;
+    int x0 = cx > 0 ? cx - 1 : 0, x1 = cx < GRID_COLS - 1 ? cx + 1 : cx;
+    
+    for (int ny = cy - 1; ny <= cy + 1; ny++) {
+        if (ny < 0 || ny >= GRID_ROWS) continue;
         
-        // Boundary collision with bounce
-        if (p->x <= BOUNDS_LEFT + PARTICLE_RADIUS) {
-            p->x = BOUNDS_LEFT + PARTICLE_RADIUS;
-            p->vx = -p->vx * BOUNCE_DAMPING;
+        // The three cells of a row are next to each other in cell_particles
+        int end = cell_start[ny * GRID_COLS + x1 + 1];
+        for (int k = cell_start[ny * GRID_COLS + x0]; k < end; k++) {
+            const Particle *q = &from[cell_particles[k]];
+            float dx = p->x - q->x, dy = p->y - q->y;
+            float d2 = dx * dx + dy * dy;
+            if (d2 >= INTERACTION_RADIUS * INTERACTION_RADIUS || q == p) continue;
+            
+            float push = REPULSION * (1.0f - d2 / (INTERACTION_RADIUS * INTERACTION_RADIUS));
+            *ax += dx * push;
+            *ay += dy * push;
         }
-        if (p->x >= BOUNDS_RIGHT - PARTICLE_RADIUS) {
-            p->x = BOUNDS_RIGHT - PARTICLE_RADIUS;
-            p->vx = -p->vx * BOUNCE_DAMPING;
-        }
-        if (p->y <= BOUNDS_TOP + PARTICLE_RADIUS) {
-            p->y = BOUNDS_TOP + PARTICLE_RADIUS;
-            p->vy = -p->vy * BOUNCE_DAMPING;
-        }
-        if (p->y >= BOUNDS_BOTTOM - PARTICLE_RADIUS) {
-            p->y = BOUNDS_BOTTOM - PARTICLE_RADIUS;
-            p->vy = -p->vy * BOUNCE_DAMPING;
-            // Add friction on ground
-            p->vx *= 0.95f;
-        }
-        
-        // Mark which core updated this particle
-        p->core_id = core_id;
+    }
+}
+
+// Update physics for one particle, from one state into the next
+static inline void update_particle(const Particle *from, Particle *to, int i, uint8_t core_id) {
+    Particle *p = &to[i];
+    *p = from[i];
+    
+    // Apply gravity, wind and the neighbours
+    float ax = 0.0f, ay = 0.0f;
+    repel(from, i, &ax, &ay);
+    p->vy += GRAVITY + ay;
+    p->vx += wind_x * 0.1f + ax;
+    p->vy += wind_y * 0.1f;
+    
+    // Update position
+    p->x += p->vx;
+    p->y += p->vy;
+    
+    // Boundary collision with bounce
+    if (p->x <= BOUNDS_LEFT + PARTICLE_RADIUS) {
+        p->x = BOUNDS_LEFT + PARTICLE_RADIUS;
+        p->vx = -p->vx * BOUNCE_DAMPING;
+    }
+    if (p->x >= BOUNDS_RIGHT - PARTICLE_RADIUS) {
+        p->x = BOUNDS_RIGHT - PARTICLE_RADIUS;
+        p->vx = -p->vx * BOUNCE_DAMPING;
+    }
+    if (p->y <= BOUNDS_TOP + PARTICLE_RADIUS) {
+        p->y = BOUNDS_TOP + PARTICLE_RADIUS;
+        p->vy = -p->vy * BOUNCE_DAMPING;
+    }
+    if (p->y >= BOUNDS_BOTTOM - PARTICLE_RADIUS) {
+        p->y = BOUNDS_BOTTOM - PARTICLE_RADIUS;
+        p->vy = -p->vy * BOUNCE_DAMPING;
+        // Add friction on ground
+        p->vx *= 0.95f;
+    }
+    
+    // Mark which core updated this particle
+    p->core_id = core_id;
+}
+
+// Update physics for the particles in a range of cell rows, binned with
+// bin_particles(from)
+void update_particles_rows(const Particle *from, Particle *to, int row_start, int row_end,
+                           uint8_t core_id) {
+    int end = cell_start[row_end * GRID_COLS];
+    for (int k = cell_start[row_start * GRID_COLS]; k < end; k++) {
+        update_particle(from, to, cell_particles[k], core_id);
     }
 }
 
 // Render all particles to framebuffer
-void render_particles() {
-    // Clear game area in framebuffer
-    fb_fill_rect(0, BOUNDS_TOP, DISPLAY_WIDTH, DISPLAY_HEIGHT - BOUNDS_TOP, COLOR_BLACK);
+// Clear the game area for the next frame, by DMA while the physics
+// runs; the blit is done with the framebuffer
+static void clear_game_area(void) {
+    fbdma_fill(&framebuffer[BOUNDS_TOP * DISPLAY_WIDTH], COLOR_BLACK,
+               (size_t)DISPLAY_WIDTH * (DISPLAY_HEIGHT - BOUNDS_TOP));
+}
+
+void render_particles(const Particle *state) {
+    // The game area is clear once the DMA is done
+    fbdma_wait();
     
     // Draw all particles
     for (int i = 0; i < particle_count; i++) {
-        Particle *p = &particles[i];
+        const Particle *p = &state[i];
         int px = (int)p->x;
         int py = (int)p->y;
         
@@ -209,15 +322,15 @@ void update_fps() {
     }
 }
 
-// Handle user input
-void handle_input() {
+// Handle user input; core 1 must not be updating particles
+void handle_input(Particle *state) {
     static bool prev_btn_a = false;
     static bool prev_btn_b = false;
     
     // Button A: Reset particles
     bool btn_a = button_pressed(BUTTON_A);
     if (btn_a && !prev_btn_a) {
-        init_particles();
+        init_particles(state);
         printf("Particles reset!\n");
     }
     prev_btn_a = btn_a;
@@ -245,30 +358,32 @@ void handle_input() {
     }
 }
 
-// Core 1 entry point - handles physics for second half of particles
-void core1_entry() {
-    printf("Core 1 started\n");
+#if PARTICLES_PIPELINED
+
+// Core 1's job - handles physics for all particles: moves those of
+// the buffer core 0 is drawing into the other buffer
+static void physics_job(void *arg) {
+    int from = (int)(uintptr_t)arg;
     
-    while (1) {
-        // Wait for core 0 to signal start of frame
-        while (!core1_ready) {
-            tight_loop_contents();
-        }
-        
-        uint32_t start = time_us_32();
-        
-        // Update second half of particles
-        int mid = particle_count / 2;
-        update_particles_range(mid, particle_count, 1);
-        
-        core1_cycles = time_us_32() - start;
-        
-        // Signal completion
-        core1_ready = false;
-        rendering_done = true;
-    }
+    uint32_t start = time_us_32();
+    bin_particles(particles[from]);
+    update_particles_rows(particles[from], particles[from ^ 1], 0, GRID_ROWS, 1);
+    core1_cycles = time_us_32() - start;
 }
 
+#else
+
+// Core 1's job - handles physics for the second half of particles,
+// the cell rows from split_row on
+static void physics_job(void *arg) {
+    (void)arg;
+    uint32_t start = time_us_32();
+    update_particles_rows(particles[current], particles[current ^ 1], split_row, GRID_ROWS, 1);
+    core1_cycles = time_us_32() - start;
+}
+
+#endif
+
 int main() {
     stdio_init_all();
     
@@ -290,12 +405,9 @@ int main() {
     }
     printf("Buttons initialized successfully\n");
     
-    // Initialize mutex
-    mutex_init(&particle_mutex);
-    
     // Initialize particles
     srand(time_us_32());
-    init_particles();
+    init_particles(particles[0]);
     
     // Clear framebuffer
     for (int i = 0; i < DISPLAY_WIDTH * DISPLAY_HEIGHT; i++) {
@@ -305,10 +417,14 @@ int main() {
     // Clear screen
     display_clear(COLOR_BLACK);
     
+    // A spare DMA channel clears the framebuffer; without one the CPU does
+    fbdma_init();
+    
     printf("\n=== System Ready ===\n");
     printf("Particles: %d\n", particle_count);
     printf("Display: 320x240 (full screen)\n");
     printf("Double buffering: ENABLED (flicker-free)\n");
+    printf("Physics: %s\n", PARTICLES_PIPELINED ? "pipelined on core 1" : "split over both cores");
     printf("\nControls:\n");
     printf("  X Button = Wind Right\n");
     printf("  Y Button = Wind Up\n");
@@ -317,44 +433,75 @@ int main() {
     printf("\nStarting simulation...\n\n");
     
     // Launch core 1
-    multicore_launch_core1(core1_entry);
-    sleep_ms(100); // Give core 1 time to start
+    jobs_init();
     
     last_fps_time = to_ms_since_boot(get_absolute_time());
     
-    // Core 0 main loop
+#if PARTICLES_PIPELINED
+    // Core 0 main loop: draws frame N while core 1 moves the particles
+    // into frame N+1
+    int front = 0;
+    
     while (true) {
         buttons_update();
-        handle_input();
+        jobs_submit(physics_job, (void *)(uintptr_t)front);
         
-        // Update first half of particles on core 0
         uint32_t start = time_us_32();
         
-        int mid = particle_count / 2;
-        update_particles_range(0, mid, 0);
+        render_particles(particles[front]);
+        draw_status_bar();
         
         core0_cycles = time_us_32() - start;
         
-        // Signal core 1 to start its work
-        rendering_done = false;
-        core1_ready = true;
+        // Blit the entire framebuffer to display in one operation - eliminates flicker!
+        display_blit_full(framebuffer);
+        clear_game_area();
         
-        // Wait for core 1 to finish
-        while (!rendering_done) {
-            tight_loop_contents();
-        }
+        update_fps();
+        
+        // Frame N+1 is ready, and core 1 idle until the next job: the
+        // one time input can change particles
+        jobs_wait();
+        front ^= 1;
+        handle_input(particles[front]);
+        
+        sleep_ms(16); // ~60 FPS target
+    }
+#else
+    // Core 0 main loop
+    while (true) {
+        buttons_update();
+        handle_input(particles[current]);
+        
+        // Sort into cells, and split the rows of cells between the cores
+        // where half of the particles are above
+        uint32_t start = time_us_32();
+        
+        bin_particles(particles[current]);
+        split_row = balanced_split_row();
+        
+        // Core 1 does its rows, core 0 the first half
+        jobs_submit(physics_job, NULL);
+        update_particles_rows(particles[current], particles[current ^ 1], 0, split_row, 0);
+        
+        core0_cycles = time_us_32() - start;
+        
+        jobs_wait();
+        current ^= 1;
         
         // Render everything to framebuffer (only core 0 does rendering)
-        render_particles();
+        render_particles(particles[current]);
         draw_status_bar();
         
         // Blit the entire framebuffer to display in one operation - eliminates flicker!
         display_blit_full(framebuffer);
+        clear_game_area();
         
         update_fps();
         
         sleep_ms(16); // ~60 FPS target
     }
+#endif
     
     return 0;
 }
\ No newline at end of file
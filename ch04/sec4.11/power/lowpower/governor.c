@@ -0,0 +1,75 @@
+#include "governor.h"
+
+// Loads beyond this are all the same: far too slow
+#define GOV_LOAD_MAX (4 * GOV_LOAD_ONE)
+
+// The smoothed load scaled to another step's clock
+static uint32_t predict(const governor_t* g, int level) {
+    uint64_t l = (uint64_t)g->load * g->steps[g->level].freq_khz;
+    return (uint32_t)(l / g->steps[level].freq_khz);
+}
+
+static bool change(governor_t* g, int level) {
+    g->below = 0;
+    if (!g->apply(g->steps[level].freq_khz, g->steps[level].voltage)) return false;
+    // the same work takes the other time at the new clock
+    g->load = predict(g, level);
+    g->level = level;
+    g->changes++;
+    return true;
+}
+
+bool governor_init(governor_t* g, const gov_step_t* steps, int count, int start,
+                   uint32_t budget_us, gov_apply_fn apply) {
+    g->steps = steps;
+    g->count = count;
+    g->level = start;
+    g->budget_us = budget_us;
+    g->load = GOV_TARGET_LOAD;
+    g->below = 0;
+    g->apply = apply;
+    g->frames = g->misses = g->changes = 0;
+    return apply(steps[start].freq_khz, steps[start].voltage);
+}
+
+static bool sample(governor_t* g, uint32_t load, bool missed) {
+    if (load > GOV_LOAD_MAX) load = GOV_LOAD_MAX;
+    g->frames++;
+    if (missed) {
+        g->misses++;
+        // no waiting for the average when a deadline went
+        if (load > g->load) g->load = load;
+    } else {
+        g->load = (uint32_t)((int32_t)g->load + ((int32_t)load - (int32_t)g->load) / 4);
+    }
+
+    if ((missed || g->load > GOV_UP_LOAD) && g->level < g->count - 1) {
+        int to = g->level + 1;
+        while (to < g->count - 1 && predict(g, to) > GOV_TARGET_LOAD) to++;
+        return change(g, to);
+    }
+
+    if (g->load >= GOV_DOWN_LOAD) {
+        g->below = 0;
+        return false;
+    }
+    if (++g->below < GOV_DWELL || g->level == 0) return false;
+    if (predict(g, g->level - 1) >= GOV_UP_LOAD) {
+        g->below = 0;
+        return false;
+    }
+    return change(g, g->level - 1);
+}
+
+bool governor_frame(governor_t* g, uint32_t busy_us) {
+    uint64_t load = (uint64_t)busy_us * GOV_LOAD_ONE / g->budget_us;
+    return sample(g, load > GOV_LOAD_MAX ? GOV_LOAD_MAX : (uint32_t)load,
+                  busy_us > g->budget_us);
+}
+
+bool governor_queue(governor_t* g, uint32_t depth, uint32_t capacity) {
+    if (capacity == 0) return false;
+    uint64_t load = (uint64_t)depth * GOV_LOAD_ONE / capacity;
+    return sample(g, load > GOV_LOAD_MAX ? GOV_LOAD_MAX : (uint32_t)load,
+                  depth >= capacity);
+}
@@ -0,0 +1,76 @@
+#ifndef GOVERNOR_H
+#define GOVERNOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/vreg.h"
+
+// A DVFS governor: it is told how long each frame of work took, or how
+// full a work queue is, and moves the clock and core voltage through a
+// table of steps so the work just fits, at the lowest step that does.
+//
+// Load is the busy time as a fraction of the frame budget, in 1/256ths
+// (256 = the whole budget), averaged over frames. Busy time measured at
+// one clock is scaled by the ratio of clocks to predict the load at
+// another, as the work is CPU bound to first order.
+//
+// - A missed deadline, or load above the up threshold, goes up at once,
+//   straight to the lowest step predicted to come in under target.
+// - Load below the down threshold for dwell frames goes down one step,
+//   and only if the step below is predicted to stay under the up
+//   threshold; the gap between the two is the hysteresis that keeps it
+//   from going back and forth.
+
+typedef struct {
+    uint32_t freq_khz;
+    enum vreg_voltage voltage;
+} gov_step_t;
+
+// Does the change, safely; false leaves the governor where it was
+typedef bool (*gov_apply_fn)(uint32_t freq_khz, enum vreg_voltage voltage);
+
+#define GOV_LOAD_ONE 256
+
+#ifndef GOV_UP_LOAD
+#define GOV_UP_LOAD     218         // 85%
+#endif
+#ifndef GOV_TARGET_LOAD
+#define GOV_TARGET_LOAD 179         // 70%
+#endif
+#ifndef GOV_DOWN_LOAD
+#define GOV_DOWN_LOAD   128         // 50%
+#endif
+#ifndef GOV_DWELL
+#define GOV_DWELL       30          // frames, about a second at 30 fps
+#endif
+
+typedef struct {
+    const gov_step_t* steps;        // slowest first
+    int count;
+    int level;                      // index of the step in use
+    uint32_t budget_us;             // frame deadline
+    uint32_t load;                  // smoothed, 1/256ths of the budget
+    int below;                      // frames in a row under GOV_DOWN_LOAD
+    gov_apply_fn apply;
+
+    uint32_t frames;
+    uint32_t misses;                // frames over budget
+    uint32_t changes;
+} governor_t;
+
+// Starts at steps[start], which is applied
+bool governor_init(governor_t* g, const gov_step_t* steps, int count, int start,
+                   uint32_t budget_us, gov_apply_fn apply);
+
+// One frame done, busy_us of it working; true when the step changed
+bool governor_frame(governor_t* g, uint32_t busy_us);
+
+// The same from a queue: depth of capacity items counts as that
+// fraction of the budget busy
+bool governor_queue(governor_t* g, uint32_t depth, uint32_t capacity);
+
+static inline const gov_step_t* governor_step(const governor_t* g) {
+    return &g->steps[g->level];
+}
+
+#endif // GOVERNOR_H
@@ -1,4 +1,6 @@
 #include "display.h"
+#include "governor.h"
+#include "sched.h"
 #include "pico/stdlib.h"
 #include "hardware/clocks.h"
 #include "hardware/watchdog.h"
@@ -68,9 +70,13 @@ static void display_power_info(const char *state, uint32_t freq_khz, float volta
 static bool safe_clock_change(uint32_t freq_khz, enum vreg_voltage voltage) {
     printf("Attempting clock change to %lu kHz\n", (unsigned long)freq_khz);
     
-    // Set voltage first (must be high enough for frequency)
-    vreg_set_voltage(voltage);
-    sleep_ms(10);
+    // The voltage must be high enough for the faster of the two clocks:
+    // raised before speeding up, lowered only once slowed down
+    bool faster = freq_khz > clock_get_hz(clk_sys) / 1000;
+    if (faster) {
+        vreg_set_voltage(voltage);
+        sleep_ms(10);
+    }
     feed_watchdog();
     
     // Try to change frequency with error handling
@@ -84,6 +90,11 @@ static bool safe_clock_change(uint32_t freq_khz, enum vreg_voltage voltage) {
         return false;
     }
     
+    if (!faster) {
+        vreg_set_voltage(voltage);
+        sleep_ms(10);
+    }
+    
     // Re-init USB/UART after clock change
     stdio_init_all();
     feed_watchdog();
@@ -423,6 +434,190 @@ static void demo_combined(void) {
     feed_watchdog();
 }
 
+// Demo 6: the governor picks the step, from the frame times
+#define GOV_FRAME_US 33333          // 30 fps
+
+static void demo_governor(void) {
+    printf("\n-- DVFS Governor Demo --\n");
+    
+    static const gov_step_t steps[] = {
+        {24000,  VREG_VOLTAGE_0_90},
+        {48000,  VREG_VOLTAGE_0_95},
+        {125000, VREG_VOLTAGE_1_10},
+        {250000, VREG_VOLTAGE_1_20}
+    };
+    
+    // Light, heavy, then medium work per frame, in loop iterations
+    static const struct {
+        uint32_t work;
+        const char *desc;
+    } phases[] = {
+        {20000,  "Light load"},
+        {400000, "Heavy load"},
+        {80000,  "Medium load"}
+    };
+    
+    disp_clear(COLOR_BLACK);
+    disp_draw_text(10, 40, "DVFS GOVERNOR", COLOR_CYAN, COLOR_BLACK);
+    disp_draw_text(10, 70, "Lowest clock that meets", COLOR_YELLOW, COLOR_BLACK);
+    disp_draw_text(10, 90, "the 30 fps frame deadline", COLOR_YELLOW, COLOR_BLACK);
+    sleep_ms(2000);
+    feed_watchdog();
+    
+    governor_t gov;
+    if (!governor_init(&gov, steps, 4, 2, GOV_FRAME_US, safe_clock_change)) {
+        disp_draw_text(10, 120, "Clock change failed!", COLOR_RED, COLOR_BLACK);
+        sleep_ms(2000);
+        return;
+    }
+    
+    for (int p = 0; p < 3; p++) {
+        absolute_time_t next = get_absolute_time();
+        
+        // 10 seconds of frames per phase
+        for (int frame = 0; frame < 300; frame++) {
+            next = delayed_by_us(next, GOV_FRAME_US);
+            uint32_t start = time_us_32();
+            
+            volatile uint32_t dummy = 0;
+            for (uint32_t j = 0; j < phases[p].work; j++) {
+                dummy += j;
+            }
+            
+            uint32_t busy = time_us_32() - start;
+            
+            // The display is drawn outside the measured work, once a second
+            if (governor_frame(&gov, busy) || frame % 30 == 0) {
+                char buf[64];
+                const gov_step_t *s = governor_step(&gov);
+                display_power_info(phases[p].desc, s->freq_khz,
+                                   0.80f + (s->voltage * 0.05f));
+                snprintf(buf, sizeof(buf), "Load: %lu%% of frame",
+                         (unsigned long)(gov.load * 100 / GOV_LOAD_ONE));
+                disp_draw_text(10, 120, buf, COLOR_WHITE, COLOR_BLACK);
+                snprintf(buf, sizeof(buf), "Missed: %lu  Steps: %lu",
+                         (unsigned long)gov.misses, (unsigned long)gov.changes);
+                disp_draw_text(10, 140, buf, COLOR_MAGENTA, COLOR_BLACK);
+                // a redraw or a clock change is not the next frame's fault
+                next = get_absolute_time();
+            }
+            
+            feed_watchdog();
+            check_reset_button();
+            sleep_until(next);
+        }
+        
+        printf("%s: %lu kHz, load %lu%%, %lu missed\n", phases[p].desc,
+               (unsigned long)governor_step(&gov)->freq_khz,
+               (unsigned long)(gov.load * 100 / GOV_LOAD_ONE),
+               (unsigned long)gov.misses);
+    }
+    
+    safe_clock_change(125000, VREG_VOLTAGE_1_10);
+    printf("Governor demo complete - restored to 125MHz\n");
+}
+
+// Demo 7: nothing polls; timers and button interrupts through the
+// tickless scheduler, which sleeps in between
+#define EV_BUTTON 0
+
+static volatile uint32_t tickless_presses = 0;
+
+static void tickless_button_irq(uint gpio, uint32_t events) {
+    tickless_presses++;
+    sched_post(EV_BUTTON);
+}
+
+static void tickless_watchdog(void *ctx) {
+    feed_watchdog();
+    check_reset_button();
+}
+
+static uint32_t tickless_samples = 0;
+
+static void tickless_sample(void *ctx) {
+    // stands for a sensor read; short, like the active phase of a duty cycle
+    volatile uint32_t dummy = 0;
+    for (int i = 0; i < 5000; i++) dummy += i;
+    tickless_samples++;
+}
+
+static void tickless_show(void *ctx) {
+    char buf[64];
+    sched_stats_t s = sched_stats();
+    uint64_t total = time_us_64() - s.since_us;
+    
+    disp_draw_text(10, 100, "                        ", COLOR_BLACK, COLOR_BLACK);
+    snprintf(buf, sizeof(buf), "Asleep: %lu%%",
+             (unsigned long)(total ? s.asleep_us * 100 / total : 0));
+    disp_draw_text(10, 100, buf, COLOR_GREEN, COLOR_BLACK);
+    snprintf(buf, sizeof(buf), "Wakeups: %lu (%lu deep)",
+             (unsigned long)s.wakeups, (unsigned long)s.deep_sleeps);
+    disp_draw_text(10, 120, buf, COLOR_WHITE, COLOR_BLACK);
+    snprintf(buf, sizeof(buf), "Samples: %lu  Presses: %lu",
+             (unsigned long)tickless_samples, (unsigned long)tickless_presses);
+    disp_draw_text(10, 140, buf, COLOR_YELLOW, COLOR_BLACK);
+}
+
+static void tickless_button(void *ctx) {
+    disp_draw_text(10, 170, "Button: woke at once", COLOR_MAGENTA, COLOR_BLACK);
+}
+
+static void tickless_end(void *ctx) {
+    sched_stop();
+}
+
+static void demo_tickless(void) {
+    printf("\n-- Tickless Scheduler Demo --\n");
+    
+    disp_clear(COLOR_BLACK);
+    disp_draw_text(10, 40, "TICKLESS SCHEDULER", COLOR_CYAN, COLOR_BLACK);
+    disp_draw_text(10, 60, "Sleeps until next timer", COLOR_YELLOW, COLOR_BLACK);
+    disp_draw_text(10, 80, "or a button interrupt", COLOR_YELLOW, COLOR_BLACK);
+    
+    sched_init();
+#if PICO_RP2040
+    // In gaps of SCHED_DEEP_US or more, stop the clocks of what this demo
+    // does not use; the timer, GPIO, USB and DMA keep theirs
+    sched_set_deep_clocks(~(CLOCKS_SLEEP_EN0_CLK_SYS_ADC_BITS | CLOCKS_SLEEP_EN0_CLK_ADC_ADC_BITS |
+                            CLOCKS_SLEEP_EN0_CLK_SYS_PWM_BITS |
+                            CLOCKS_SLEEP_EN0_CLK_SYS_PIO0_BITS | CLOCKS_SLEEP_EN0_CLK_SYS_PIO1_BITS |
+                            CLOCKS_SLEEP_EN0_CLK_SYS_I2C0_BITS | CLOCKS_SLEEP_EN0_CLK_SYS_I2C1_BITS |
+                            CLOCKS_SLEEP_EN0_CLK_SYS_SPI1_BITS | CLOCKS_SLEEP_EN0_CLK_PERI_SPI1_BITS),
+                          ~(CLOCKS_SLEEP_EN1_CLK_SYS_UART0_BITS | CLOCKS_SLEEP_EN1_CLK_PERI_UART0_BITS |
+                            CLOCKS_SLEEP_EN1_CLK_SYS_UART1_BITS | CLOCKS_SLEEP_EN1_CLK_PERI_UART1_BITS));
+#endif
+    
+    sched_on(EV_BUTTON, tickless_button, NULL);
+    sched_add(0, 1000000, tickless_watchdog, NULL);
+    sched_add(0, 100000, tickless_sample, NULL);        // 10 Hz
+    sched_add(1000000, 1000000, tickless_show, NULL);
+    sched_add(10000000, 0, tickless_end, NULL);
+    
+    tickless_presses = 0;
+    tickless_samples = 0;
+    for (int i = 0; i < 4; i++) {
+        gpio_set_irq_enabled_with_callback(BTN_A_PIN + i, GPIO_IRQ_EDGE_FALL, true,
+                                           &tickless_button_irq);
+    }
+    
+    sched_run();
+    
+    for (int i = 0; i < 4; i++) {
+        gpio_set_irq_enabled(BTN_A_PIN + i, GPIO_IRQ_EDGE_FALL, false);
+    }
+    sched_set_deep_clocks(0, 0);
+    
+    sched_stats_t s = sched_stats();
+    printf("Tickless: %lu wakeups, %lu deep, asleep %lu of %lu ms\n",
+           (unsigned long)s.wakeups, (unsigned long)s.deep_sleeps,
+           (unsigned long)(s.asleep_us / 1000),
+           (unsigned long)((time_us_64() - s.since_us) / 1000));
+    
+    sleep_ms(2000);
+    feed_watchdog();
+}
+
 // Safe button wait with watchdog
 static void wait_for_button(void) {
     disp_draw_text(10, 220, "Press any button..", COLOR_CYAN, COLOR_BLACK);
@@ -517,12 +712,13 @@ int main() {
         disp_draw_text(10, 100, "X: Peripheral Power", COLOR_CYAN, COLOR_BLACK);
         disp_draw_text(10, 125, "Y: Duty Cycle Demo", COLOR_MAGENTA, COLOR_BLACK);
         
-        disp_draw_text(10, 165, "Hold both A+B:", COLOR_WHITE, COLOR_BLACK);
-        disp_draw_text(10, 185, "  Combined Strategy", COLOR_GREEN, COLOR_BLACK);
+        disp_draw_text(10, 150, "Hold A+B: Combined", COLOR_GREEN, COLOR_BLACK);
+        disp_draw_text(10, 165, "Hold X+Y: DVFS Governor", COLOR_CYAN, COLOR_BLACK);
+        disp_draw_text(10, 180, "Hold A+Y: Tickless Idle", COLOR_YELLOW, COLOR_BLACK);
         
         disp_draw_text(10, 215, "Reset: GPIO22->GND", COLOR_RED, COLOR_BLACK);
         
-        printf("\nSelect demo: A/B/X/Y or A+B for combined\n");
+        printf("\nSelect demo: A/B/X/Y, A+B combined, X+Y governor, A+Y tickless\n");
         
         // Wait for selection
         while (true) {
@@ -536,6 +732,16 @@ int main() {
                 demo_combined();
                 break;
             }
+            else if (button_pressed(BUTTON_X) && button_pressed(BUTTON_Y)) {
+                sleep_ms(200);
+                demo_governor();
+                break;
+            }
+            else if (button_pressed(BUTTON_A) && button_pressed(BUTTON_Y)) {
+                sleep_ms(200);
+                demo_tickless();
+                break;
+            }
             else if (button_just_pressed(BUTTON_A)) {
                 demo_dvfs();
                 break;
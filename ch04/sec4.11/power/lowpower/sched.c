@@ -0,0 +1,222 @@
+#include "sched.h"
+#include "pico/stdlib.h"
+#include "hardware/timer.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+#include "hardware/structs/scb.h"
+
+typedef struct {
+    uint64_t at;                // deadline, in time_us_64()
+    uint32_t period_us;
+    sched_fn fn;
+    void* ctx;
+    int heap;                   // position in the heap, -1 when free
+} sched_timer_t;
+
+static sched_timer_t timers[SCHED_TIMERS];
+static int heap[SCHED_TIMERS];      // timer indexes, earliest first
+static int heap_count = 0;
+
+static struct {
+    sched_fn fn;
+    void* ctx;
+} events[SCHED_EVENTS];
+static volatile uint32_t pending = 0;
+
+static int alarm_num = -1;
+static volatile bool running = false;
+static uint32_t deep_en0 = 0, deep_en1 = 0;
+static sched_stats_t stats;
+
+#if PICO_RP2040
+#define SCR_SLEEPDEEP_BITS M0PLUS_SCR_SLEEPDEEP_BITS
+#else
+#define SCR_SLEEPDEEP_BITS M33_SCR_SLEEPDEEP_BITS
+#endif
+
+// Min-heap on the deadline
+
+static void heap_set(int pos, int t) {
+    heap[pos] = t;
+    timers[t].heap = pos;
+}
+
+static void heap_up(int pos) {
+    int t = heap[pos];
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (timers[heap[parent]].at <= timers[t].at) break;
+        heap_set(pos, heap[parent]);
+        pos = parent;
+    }
+    heap_set(pos, t);
+}
+
+static void heap_down(int pos) {
+    int t = heap[pos];
+    for (;;) {
+        int child = 2 * pos + 1;
+        if (child >= heap_count) break;
+        if (child + 1 < heap_count && timers[heap[child + 1]].at < timers[heap[child]].at) child++;
+        if (timers[t].at <= timers[heap[child]].at) break;
+        heap_set(pos, heap[child]);
+        pos = child;
+    }
+    heap_set(pos, t);
+}
+
+static void heap_remove(int pos) {
+    int t = heap[pos];
+    timers[t].heap = -1;
+    if (--heap_count == pos) return;
+    int moved = heap[heap_count];
+    heap_set(pos, moved);
+    heap_up(pos);
+    heap_down(timers[moved].heap);
+}
+
+// The alarm's interrupt only wakes the core; it is the loop that looks
+static void alarm_fired(uint alarm) {
+    (void)alarm;
+}
+
+void sched_init(void) {
+    for (int i = 0; i < SCHED_TIMERS; i++) timers[i].heap = -1;
+    heap_count = 0;
+    pending = 0;
+    running = true;
+    if (alarm_num < 0) {
+        alarm_num = hardware_alarm_claim_unused(true);
+        hardware_alarm_set_callback(alarm_num, alarm_fired);
+    }
+    sched_reset_stats();
+}
+
+int sched_add(uint32_t delay_us, uint32_t period_us, sched_fn fn, void* ctx) {
+    for (int i = 0; i < SCHED_TIMERS; i++) {
+        if (timers[i].heap >= 0) continue;
+        timers[i].at = time_us_64() + delay_us;
+        timers[i].period_us = period_us;
+        timers[i].fn = fn;
+        timers[i].ctx = ctx;
+        heap_set(heap_count, i);
+        heap_up(heap_count++);
+        return i;
+    }
+    return -1;
+}
+
+void sched_cancel(int id) {
+    if (id < 0 || id >= SCHED_TIMERS || timers[id].heap < 0) return;
+    heap_remove(timers[id].heap);
+}
+
+void sched_on(int event, sched_fn fn, void* ctx) {
+    if (event < 0 || event >= SCHED_EVENTS) return;
+    events[event].fn = fn;
+    events[event].ctx = ctx;
+}
+
+void sched_post(int event) {
+    // no atomic or on the M0+; the handler may be interrupted itself
+    uint32_t irq = save_and_disable_interrupts();
+    pending |= 1u << event;
+    restore_interrupts(irq);
+    __sev();
+}
+
+void sched_stop(void) {
+    running = false;
+}
+
+void sched_set_deep_clocks(uint32_t en0, uint32_t en1) {
+    deep_en0 = en0;
+    deep_en1 = en1;
+}
+
+static void sleep_until_due(uint64_t now, uint64_t at, bool timed) {
+    bool deep = (deep_en0 | deep_en1) && (!timed || at - now >= SCHED_DEEP_US);
+    uint32_t en0 = clocks_hw->sleep_en0, en1 = clocks_hw->sleep_en1;
+    if (deep) {
+        clocks_hw->sleep_en0 = deep_en0;
+        clocks_hw->sleep_en1 = deep_en1;
+        scb_hw->scr |= SCR_SLEEPDEEP_BITS;
+    }
+    // an interrupt that comes now is pending, and ends the wfi at once
+    __wfi();
+    if (deep) {
+        scb_hw->scr &= ~SCR_SLEEPDEEP_BITS;
+        clocks_hw->sleep_en0 = en0;
+        clocks_hw->sleep_en1 = en1;
+        stats.deep_sleeps++;
+    }
+    stats.wakeups++;
+    stats.asleep_us += time_us_64() - now;
+}
+
+bool sched_run_once(void) {
+    // Events first: they are what an interrupt said cannot wait
+    uint32_t irq = save_and_disable_interrupts();
+    uint32_t fired = pending;
+    pending = 0;
+    restore_interrupts(irq);
+
+    while (fired) {
+        int e = __builtin_ctz(fired);
+        fired &= fired - 1;
+        if (events[e].fn) {
+            events[e].fn(events[e].ctx);
+            stats.events_run++;
+        }
+    }
+
+    // Each timer due now, once; a periodic one keeps its phase
+    uint64_t now = time_us_64();
+    while (heap_count > 0 && timers[heap[0]].at <= now) {
+        int t = heap[0];
+        sched_fn fn = timers[t].fn;
+        void* ctx = timers[t].ctx;
+        if (timers[t].period_us) {
+            timers[t].at += timers[t].period_us;
+            if (timers[t].at <= now) timers[t].at = now + timers[t].period_us;
+            heap_down(0);
+        } else {
+            heap_remove(0);
+        }
+        fn(ctx);
+        stats.timers_run++;
+    }
+    if (!running) return false;
+
+    // With interrupts off, nothing can be posted between looking and
+    // sleeping, and the wfi still wakes for what is pending
+    irq = save_and_disable_interrupts();
+    if (!pending) {
+        now = time_us_64();
+        bool timed = heap_count > 0;
+        uint64_t at = timed ? timers[heap[0]].at : 0;
+        if (!timed) {
+            hardware_alarm_cancel(alarm_num);
+            sleep_until_due(now, at, false);
+        } else if (at > now) {
+            // true when the time has already gone: nothing to sleep for
+            if (!hardware_alarm_set_target(alarm_num, from_us_since_boot(at))) sleep_until_due(now, at, true);
+        }
+    }
+    restore_interrupts(irq);
+    return running;
+}
+
+void sched_run(void) {
+    running = true;
+    while (sched_run_once()) { }
+}
+
+sched_stats_t sched_stats(void) {
+    return stats;
+}
+
+void sched_reset_stats(void) {
+    stats = (sched_stats_t){0};
+    stats.since_us = time_us_64();
+}
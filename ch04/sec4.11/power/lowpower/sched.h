@@ -0,0 +1,68 @@
+#ifndef SCHED_H
+#define SCHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// A tickless scheduler: timers and events run from one loop, and when
+// nothing is due the core sleeps until something is. There is no
+// periodic tick; the nearest deadline is programmed into a hardware
+// alarm, so the core wakes for that or for an interrupt, and for
+// nothing else.
+//
+// Timers are kept in a min-heap by deadline. Events are bits an
+// interrupt handler sets with sched_post() (GPIO, UART, DMA, ...); the
+// handler does no more than that, and the event's function runs in the
+// loop like a timer's. Both run to completion, one at a time, on the
+// core that calls sched_run()
+
+typedef void (*sched_fn)(void* ctx);
+
+#ifndef SCHED_TIMERS
+#define SCHED_TIMERS 16
+#endif
+#define SCHED_EVENTS 32
+
+// Gaps at least this long sleep deep, with the clocks in the deep
+// masks gated off (see sched_set_deep_clocks)
+#ifndef SCHED_DEEP_US
+#define SCHED_DEEP_US 20000
+#endif
+
+typedef struct {
+    uint32_t wakeups;           // times the core woke from sleep
+    uint32_t deep_sleeps;       // of those, from deep sleep
+    uint32_t timers_run;
+    uint32_t events_run;
+    uint64_t asleep_us;         // time spent asleep
+    uint64_t since_us;          // when counting began
+} sched_stats_t;
+
+void sched_init(void);
+
+// First call delay_us from now, then every period_us, or once if 0.
+// Returns an id for sched_cancel, -1 when all SCHED_TIMERS are in use
+int sched_add(uint32_t delay_us, uint32_t period_us, sched_fn fn, void* ctx);
+void sched_cancel(int id);
+
+// An event's function; posting it from an interrupt runs it once in the
+// loop, however many times it was posted meanwhile
+void sched_on(int event, sched_fn fn, void* ctx);
+void sched_post(int event);            // safe from interrupts
+
+// Runs what is due, or sleeps until something is; false after
+// sched_stop()
+bool sched_run_once(void);
+void sched_run(void);                  // until sched_stop()
+void sched_stop(void);
+
+// Clocks to leave running in deep sleep, as the CLOCKS sleep_en0/1
+// registers take them: those of the timer and of every peripheral
+// whose interrupt is to wake the core. Both 0, the default, never
+// sleeps deep
+void sched_set_deep_clocks(uint32_t en0, uint32_t en1);
+
+sched_stats_t sched_stats(void);
+void sched_reset_stats(void);
+
+#endif // SCHED_H
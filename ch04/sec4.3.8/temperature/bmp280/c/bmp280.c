@@ -1,60 +1,287 @@
-from machine import Pin, SPI
-import time
-
-# BME280 SPI setup
-CS_PIN = Pin(8, Pin.OUT, value=1)  # GPIO 8 (Physical Pin 11)
-spi = SPI(1, baudrate=1000000, polarity=0, phase=0, bits=8, firstbit=SPI.MSB,
-          sck=Pin(10), mosi=Pin(11), miso=Pin(12))  # SPI1: Pins 14, 15, 16
-
-# BME280 register addresses
-REG_DIG_T1 = 0x88
-REG_CTRL_MEAS = 0xF4
-REG_TEMP = 0xFA
-
-# SPI read/write functions
-def read_reg(reg, num_bytes):
-    CS_PIN.value(0)  # Select chip
-    spi.write(bytes([reg | 0x80]))  # Read mode (MSB=1)
-    data = spi.read(num_bytes)
-    CS_PIN.value(1)  # Deselect chip
-    return data
-
-def write_reg(reg, data):
-    CS_PIN.value(0)  # Select chip
-    spi.write(bytes([reg & 0x7F]))  # Write mode (MSB=0)
-    spi.write(bytes([data]))
-    CS_PIN.value(1)  # Deselect chip
-
-# Read an unsigned short (little endian)
-def read_u16(reg):
-    d = read_reg(reg, 2)
-    return d[0] | (d[1] << 8)
-
-# Read a signed short
-def read_s16(reg):
-    val = read_u16(reg)
-    return val if val < 32768 else val - 65536
-
-# Get calibration data for temperature
-dig_T1 = read_u16(REG_DIG_T1)
-dig_T2 = read_s16(REG_DIG_T1 + 2)
-dig_T3 = read_s16(REG_DIG_T1 + 4)
-
-# Configure sensor: oversampling x1, normal mode
-write_reg(REG_CTRL_MEAS, 0x27)
-
-def read_temperature():
-    data = read_reg(REG_TEMP, 3)
-    raw = (data[0] << 12) | (data[1] << 4) | (data[2] >> 4)
-    # Compensation formula from datasheet
-    var1 = (((raw >> 3) - (dig_T1 << 1)) * dig_T2) >> 11
-    var2 = (((((raw >> 4) - dig_T1) * ((raw >> 4) - dig_T1)) >> 12) * dig_T3) >> 14
-    t_fine = var1 + var2
-    T = (t_fine * 5 + 128) >> 8
-    return T / 100.0
-
-# Main loop
-while True:
-    temp = read_temperature()
-    print("Temperature:", temp, "°C")
-    time.sleep(1)
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "bmp280.h"
+
+#define REG_CALIB 0x88          // .. 0x9F
+#define REG_ID 0xD0
+#define REG_RESET 0xE0
+#define REG_STATUS 0xF3
+#define REG_CTRL_MEAS 0xF4
+#define REG_CONFIG 0xF5
+#define REG_DATA 0xF7           // press_msb .. temp_xlsb
+
+#define STATUS_MEASURING 0x08
+#define STATUS_IM_UPDATE 0x01
+#define MODE_FORCED 0x01
+#define RESET_WORD 0xB6
+
+#define CALIB_BYTES 24
+#define DATA_BYTES 6
+
+// SPI: the register address with bit 7 set reads on from there for as
+// long as the chip select is held, so a block is one transaction
+static void read_regs(bmp280_t* dev, uint8_t reg, uint8_t* buf, size_t n) {
+    uint8_t addr = reg | 0x80;
+    gpio_put(dev->cs_pin, 0);
+    spi_write_blocking(dev->spi, &addr, 1);
+    spi_read_blocking(dev->spi, 0, buf, n);
+    gpio_put(dev->cs_pin, 1);
+}
+
+static void write_reg(bmp280_t* dev, uint8_t reg, uint8_t value) {
+    uint8_t buf[2] = { reg & 0x7F, value };
+    gpio_put(dev->cs_pin, 0);
+    spi_write_blocking(dev->spi, buf, 2);
+    gpio_put(dev->cs_pin, 1);
+}
+
+static uint16_t u16_le(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static int16_t s16_le(const uint8_t* p) { return (int16_t)u16_le(p); }
+
+// Datasheet table 13, the maximum: 1.25 ms, 2.3 ms per oversampling
+// step of each, and 0.575 ms more when pressure is measured
+static uint32_t measure_time_us(bmp280_osrs_t osrs_t, bmp280_osrs_t osrs_p) {
+    uint32_t t = osrs_t ? 1u << (osrs_t - 1) : 0;
+    uint32_t p = osrs_p ? 1u << (osrs_p - 1) : 0;
+    return 1250 + 2300 * t + (p ? 2300 * p + 575 : 0);
+}
+
+bool bmp280_init(bmp280_t* dev, spi_inst_t* spi, uint cs_pin,
+                 bmp280_osrs_t osrs_t, bmp280_osrs_t osrs_p, bmp280_filter_t filter) {
+    dev->spi = spi;
+    dev->cs_pin = cs_pin;
+    gpio_init(cs_pin);
+    gpio_set_dir(cs_pin, GPIO_OUT);
+    gpio_put(cs_pin, 1);
+
+    uint8_t id;
+    read_regs(dev, REG_ID, &id, 1);
+    if (id != BMP280_CHIP_ID) return false;
+
+    write_reg(dev, REG_RESET, RESET_WORD);
+    sleep_ms(3);
+    uint8_t status;
+    do {
+        read_regs(dev, REG_STATUS, &status, 1);   // calibration copied from NVM
+    } while (status & STATUS_IM_UPDATE);
+
+    uint8_t c[CALIB_BYTES];
+    read_regs(dev, REG_CALIB, c, sizeof(c));
+    dev->calib.dig_T1 = u16_le(c + 0);
+    dev->calib.dig_T2 = s16_le(c + 2);
+    dev->calib.dig_T3 = s16_le(c + 4);
+    dev->calib.dig_P1 = u16_le(c + 6);
+    dev->calib.dig_P2 = s16_le(c + 8);
+    dev->calib.dig_P3 = s16_le(c + 10);
+    dev->calib.dig_P4 = s16_le(c + 12);
+    dev->calib.dig_P5 = s16_le(c + 14);
+    dev->calib.dig_P6 = s16_le(c + 16);
+    dev->calib.dig_P7 = s16_le(c + 18);
+    dev->calib.dig_P8 = s16_le(c + 20);
+    dev->calib.dig_P9 = s16_le(c + 22);
+
+    // config can only be written in sleep mode, which the reset left
+    write_reg(dev, REG_CONFIG, (uint8_t)(filter << 2));
+    dev->ctrl_meas = (uint8_t)((osrs_t << 5) | (osrs_p << 2));
+    write_reg(dev, REG_CTRL_MEAS, dev->ctrl_meas);
+    dev->measure_us = measure_time_us(osrs_t, osrs_p);
+    return true;
+}
+
+int32_t bmp280_compensate_temp(const bmp280_calib_t* c, int32_t adc_T, int32_t* t_fine) {
+    int32_t var1 = ((((adc_T >> 3) - ((int32_t)c->dig_T1 << 1))) * (int32_t)c->dig_T2) >> 11;
+    int32_t d = (adc_T >> 4) - (int32_t)c->dig_T1;
+    int32_t var2 = (((d * d) >> 12) * (int32_t)c->dig_T3) >> 14;
+    *t_fine = var1 + var2;
+    return (*t_fine * 5 + 128) >> 8;
+}
+
+// The 64-bit version, to 1/256 Pa; the datasheet's left shifts of
+// signed values are written as multiplications
+uint32_t bmp280_compensate_pressure(const bmp280_calib_t* c, int32_t adc_P, int32_t t_fine) {
+    int64_t var1 = (int64_t)t_fine - 128000;
+    int64_t var2 = var1 * var1 * (int64_t)c->dig_P6;
+    var2 = var2 + var1 * (int64_t)c->dig_P5 * ((int64_t)1 << 17);
+    var2 = var2 + (int64_t)c->dig_P4 * ((int64_t)1 << 35);
+    var1 = ((var1 * var1 * (int64_t)c->dig_P3) >> 8) + var1 * (int64_t)c->dig_P2 * ((int64_t)1 << 12);
+    var1 = ((((int64_t)1 << 47) + var1) * (int64_t)c->dig_P1) >> 33;
+    if (var1 == 0) return 0;        // no division by zero
+    int64_t p = 1048576 - adc_P;
+    p = ((p * ((int64_t)1 << 31) - var2) * 3125) / var1;
+    var1 = ((int64_t)c->dig_P9 * (p >> 13) * (p >> 13)) >> 25;
+    var2 = ((int64_t)c->dig_P8 * p) >> 19;
+    p = ((p + var1 + var2) >> 8) + (int64_t)c->dig_P7 * 16;
+    return (uint32_t)p;
+}
+
+// 20-bit values, most significant byte first, in press_msb .. temp_xlsb
+static void unpack(const uint8_t* d, int32_t* adc_P, int32_t* adc_T) {
+    *adc_P = (int32_t)(((uint32_t)d[0] << 12) | ((uint32_t)d[1] << 4) | (d[2] >> 4));
+    *adc_T = (int32_t)(((uint32_t)d[3] << 12) | ((uint32_t)d[4] << 4) | (d[5] >> 4));
+}
+
+static void compensate(const bmp280_calib_t* c, int32_t adc_P, int32_t adc_T, bmp280_sample_t* s) {
+    int32_t t_fine;
+    s->time_ms = to_ms_since_boot(get_absolute_time());
+    s->temp_centi = bmp280_compensate_temp(c, adc_T, &t_fine);
+    s->pressure_q8 = bmp280_compensate_pressure(c, adc_P, t_fine);
+}
+
+static bool forced_raw(bmp280_t* dev, int32_t* adc_P, int32_t* adc_T) {
+    write_reg(dev, REG_CTRL_MEAS, dev->ctrl_meas | MODE_FORCED);
+    sleep_us(dev->measure_us);
+    uint8_t status;
+    int tries = 100;
+    do {
+        read_regs(dev, REG_STATUS, &status, 1);
+    } while ((status & STATUS_MEASURING) && --tries);
+    if (!tries) return false;
+
+    uint8_t d[DATA_BYTES];
+    read_regs(dev, REG_DATA, d, sizeof(d));
+    unpack(d, adc_P, adc_T);
+    return true;
+}
+
+bool bmp280_measure(bmp280_t* dev, bmp280_sample_t* s) {
+    return bmp280_measure_average(dev, 1, s);
+}
+
+bool bmp280_measure_average(bmp280_t* dev, int n, bmp280_sample_t* s) {
+    int64_t sum_P = 0, sum_T = 0;
+    for (int i = 0; i < n; i++) {
+        int32_t adc_P, adc_T;
+        if (!forced_raw(dev, &adc_P, &adc_T)) return false;
+        sum_P += adc_P;
+        sum_T += adc_T;
+    }
+    compensate(&dev->calib, (int32_t)((sum_P + n / 2) / n), (int32_t)((sum_T + n / 2) / n), s);
+    return true;
+}
+
+// Periodic sampling. One transaction of seven bytes, the address and
+// six dummies out, the address echo and the data in, by two channels
+static struct {
+    bmp280_t* dev;
+    int tx_chan, rx_chan;
+    bool claimed;
+    uint8_t tx[1 + DATA_BYTES];
+    uint8_t rx[1 + DATA_BYTES];
+    repeating_timer_t timer;
+    int block, n;
+    int64_t sum_P, sum_T;
+    bool running;
+} periodic;
+
+static bmp280_sample_t ring[BMP280_RING];
+static volatile uint32_t ring_head = 0, ring_tail = 0, ring_dropped = 0;
+
+static void push(const bmp280_sample_t* s) {
+    if (ring_head - ring_tail == BMP280_RING) {
+        ring_dropped++;
+        return;
+    }
+    ring[ring_head % BMP280_RING] = *s;
+    ring_head++;
+}
+
+bool bmp280_ring_pop(bmp280_sample_t* s) {
+    if (ring_tail == ring_head) return false;
+    *s = ring[ring_tail % BMP280_RING];
+    ring_tail++;
+    return true;
+}
+
+uint32_t bmp280_ring_dropped(void) {
+    return ring_dropped;
+}
+
+static int64_t start_read(alarm_id_t id, void* user) {
+    (void)id;
+    (void)user;
+    gpio_put(periodic.dev->cs_pin, 0);
+    dma_channel_set_read_addr(periodic.tx_chan, periodic.tx, false);
+    dma_channel_set_write_addr(periodic.rx_chan, periodic.rx, false);
+    dma_channel_set_trans_count(periodic.tx_chan, sizeof(periodic.tx), false);
+    dma_channel_set_trans_count(periodic.rx_chan, sizeof(periodic.rx), false);
+    dma_start_channel_mask((1u << periodic.tx_chan) | (1u << periodic.rx_chan));
+    return 0;
+}
+
+// The two register bytes go out in a few microseconds, blocking is
+// cheaper than setting up a transfer for them
+static bool start_conversion(repeating_timer_t* t) {
+    (void)t;
+    bmp280_t* dev = periodic.dev;
+    uint8_t buf[2] = { REG_CTRL_MEAS & 0x7F, (uint8_t)(dev->ctrl_meas | MODE_FORCED) };
+    gpio_put(dev->cs_pin, 0);
+    spi_write_blocking(dev->spi, buf, 2);
+    gpio_put(dev->cs_pin, 1);
+    add_alarm_in_us(dev->measure_us, start_read, NULL, true);
+    return periodic.running;
+}
+
+static void read_done(void) {
+    if (!dma_channel_get_irq1_status(periodic.rx_chan)) return;
+    dma_channel_acknowledge_irq1(periodic.rx_chan);
+    gpio_put(periodic.dev->cs_pin, 1);
+
+    int32_t adc_P, adc_T;
+    unpack(periodic.rx + 1, &adc_P, &adc_T);
+    periodic.sum_P += adc_P;
+    periodic.sum_T += adc_T;
+    if (++periodic.n < periodic.block) return;
+
+    int n = periodic.n;
+    bmp280_sample_t s;
+    compensate(&periodic.dev->calib, (int32_t)((periodic.sum_P + n / 2) / n),
+               (int32_t)((periodic.sum_T + n / 2) / n), &s);
+    push(&s);
+    periodic.n = 0;
+    periodic.sum_P = periodic.sum_T = 0;
+}
+
+bool bmp280_start_periodic(bmp280_t* dev, uint32_t period_ms, int block) {
+    if (periodic.running || block < 1 || period_ms * 1000 <= dev->measure_us) return false;
+    periodic.dev = dev;
+    periodic.block = block;
+    periodic.n = 0;
+    periodic.sum_P = periodic.sum_T = 0;
+    memset(periodic.tx, 0, sizeof(periodic.tx));
+    periodic.tx[0] = REG_DATA | 0x80;
+
+    if (!periodic.claimed) {
+        periodic.claimed = true;
+        periodic.tx_chan = dma_claim_unused_channel(true);
+        periodic.rx_chan = dma_claim_unused_channel(true);
+
+        dma_channel_config c = dma_channel_get_default_config(periodic.tx_chan);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+        channel_config_set_dreq(&c, spi_get_dreq(dev->spi, true));
+        dma_channel_configure(periodic.tx_chan, &c, &spi_get_hw(dev->spi)->dr, periodic.tx,
+                              sizeof(periodic.tx), false);
+
+        c = dma_channel_get_default_config(periodic.rx_chan);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+        channel_config_set_read_increment(&c, false);
+        channel_config_set_write_increment(&c, true);
+        channel_config_set_dreq(&c, spi_get_dreq(dev->spi, false));
+        dma_channel_configure(periodic.rx_chan, &c, periodic.rx, &spi_get_hw(dev->spi)->dr,
+                              sizeof(periodic.rx), false);
+
+        dma_channel_set_irq1_enabled(periodic.rx_chan, true);
+        irq_add_shared_handler(DMA_IRQ_1, read_done, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_1, true);
+    }
+
+    periodic.running = true;
+    return add_repeating_timer_ms((int32_t)period_ms, start_conversion, NULL, &periodic.timer);
+}
+
+void bmp280_stop_periodic(void) {
+    if (!periodic.running) return;
+    periodic.running = false;
+    cancel_repeating_timer(&periodic.timer);
+}
@@ -0,0 +1,89 @@
+#ifndef BMP280_H
+#define BMP280_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/spi.h"
+
+// BMP280 over SPI, measuring in forced mode: the sensor sleeps until it
+// is asked for a conversion, does one, and goes back to sleep. The
+// calibration is read once, in one burst, and each measurement is one
+// burst of the six pressure and temperature bytes, compensated in
+// integers as the datasheet gives it
+
+#define BMP280_CHIP_ID 0x58
+
+// Oversampling, for the ctrl_meas osrs_t and osrs_p fields
+typedef enum {
+    BMP280_OSRS_SKIP = 0,
+    BMP280_OSRS_X1,
+    BMP280_OSRS_X2,
+    BMP280_OSRS_X4,
+    BMP280_OSRS_X8,
+    BMP280_OSRS_X16
+} bmp280_osrs_t;
+
+// IIR filter coefficient, for the config register
+typedef enum {
+    BMP280_FILTER_OFF = 0,
+    BMP280_FILTER_2,
+    BMP280_FILTER_4,
+    BMP280_FILTER_8,
+    BMP280_FILTER_16
+} bmp280_filter_t;
+
+// Registers 0x88 .. 0x9F, in their order
+typedef struct {
+    uint16_t dig_T1;
+    int16_t dig_T2, dig_T3;
+    uint16_t dig_P1;
+    int16_t dig_P2, dig_P3, dig_P4, dig_P5, dig_P6, dig_P7, dig_P8, dig_P9;
+} bmp280_calib_t;
+
+typedef struct {
+    spi_inst_t* spi;
+    uint cs_pin;
+    bmp280_calib_t calib;
+    uint8_t ctrl_meas;          // osrs_t, osrs_p, mode bits cleared (sleep)
+    uint32_t measure_us;        // the longest a forced conversion takes
+} bmp280_t;
+
+typedef struct {
+    uint32_t time_ms;
+    int32_t temp_centi;         // degrees C x 100
+    uint32_t pressure_q8;       // Pa x 256 (Q24.8)
+} bmp280_sample_t;
+
+// The SPI is set up by the caller; false when the chip does not answer
+// with its id
+bool bmp280_init(bmp280_t* dev, spi_inst_t* spi, uint cs_pin,
+                 bmp280_osrs_t osrs_t, bmp280_osrs_t osrs_p, bmp280_filter_t filter);
+
+// One forced conversion, waited for
+bool bmp280_measure(bmp280_t* dev, bmp280_sample_t* s);
+
+// n conversions with the raw values averaged, then compensated once:
+// noise down by sqrt(n) for one compensation
+bool bmp280_measure_average(bmp280_t* dev, int n, bmp280_sample_t* s);
+
+// Integer compensation from the datasheet; t_fine carries the
+// temperature into the pressure
+int32_t bmp280_compensate_temp(const bmp280_calib_t* c, int32_t adc_T, int32_t* t_fine);
+uint32_t bmp280_compensate_pressure(const bmp280_calib_t* c, int32_t adc_P, int32_t t_fine);
+
+// Periodic sampling without the CPU waiting: every period_ms a timer
+// starts a conversion, an alarm the DMA read of its result when it is
+// done, and the DMA interrupt adds it up. Each block of `block`
+// conversions is averaged into one sample in the ring, which holds
+// BMP280_RING of them; when it is full new samples are counted and
+// dropped, the interrupt does not touch the reader's end
+#ifndef BMP280_RING
+#define BMP280_RING 32
+#endif
+
+bool bmp280_start_periodic(bmp280_t* dev, uint32_t period_ms, int block);
+void bmp280_stop_periodic(void);
+bool bmp280_ring_pop(bmp280_sample_t* s);
+uint32_t bmp280_ring_dropped(void);
+
+#endif // BMP280_H
@@ -0,0 +1,53 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+#include "bmp280.h"
+
+// BMP280 on SPI1: SCK GP10, MOSI GP11, MISO GP12, CS GP8
+#define SPI_PORT spi1
+#define SPI_HZ 4000000          // the chip takes up to 10 MHz
+#define PIN_SCK 10
+#define PIN_MOSI 11
+#define PIN_MISO 12
+#define PIN_CS 8
+
+#define PERIOD_MS 250           // a conversion every quarter second
+#define BLOCK 4                 // averaged into a sample a second
+
+static void print_sample(const char* what, const bmp280_sample_t* s) {
+    int32_t t = s->temp_centi;
+    uint32_t pa = s->pressure_q8 >> 8;
+    printf("%s: %s%ld.%02ld C, %lu.%02lu hPa\n", what, t < 0 ? "-" : "",
+           (long)(t < 0 ? -t : t) / 100, (long)(t < 0 ? -t : t) % 100,
+           (unsigned long)(pa / 100), (unsigned long)(pa % 100));
+}
+
+int main() {
+    stdio_init_all();
+    sleep_ms(2000);
+
+    spi_init(SPI_PORT, SPI_HZ);
+    gpio_set_function(PIN_SCK, GPIO_FUNC_SPI);
+    gpio_set_function(PIN_MOSI, GPIO_FUNC_SPI);
+    gpio_set_function(PIN_MISO, GPIO_FUNC_SPI);
+
+    bmp280_t bmp;
+    if (!bmp280_init(&bmp, SPI_PORT, PIN_CS, BMP280_OSRS_X2, BMP280_OSRS_X16, BMP280_FILTER_4)) {
+        printf("No BMP280 found\n");
+        return 1;
+    }
+
+    // Once, waited for, then averaged over eight
+    bmp280_sample_t s;
+    if (bmp280_measure(&bmp, &s)) print_sample("Single", &s);
+    if (bmp280_measure_average(&bmp, 8, &s)) print_sample("Average of 8", &s);
+
+    // From here on the timer, alarm and DMA do the sampling, and the
+    // loop only takes what has come into the ring
+    bmp280_start_periodic(&bmp, PERIOD_MS, BLOCK);
+    while (true) {
+        while (bmp280_ring_pop(&s)) print_sample("Periodic", &s);
+        sleep_ms(500);
+    }
+    return 0;
+}
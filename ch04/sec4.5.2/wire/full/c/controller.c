@@ -5,6 +5,8 @@
 #include "pico/stdlib.h"
 #include "hardware/uart.h"
 #include "hardware/gpio.h"
+#include "frame.h"
+#include "uart_rx.h"
 
 // Config
 #define UART_ID uart1
@@ -12,27 +14,74 @@
 #define UART_TX_PIN 4
 #define UART_RX_PIN 5
 
-#define BUFFER_SIZE 256
 #define MESSAGE_SIZE 128
 #define HISTORY_SIZE 20
 
+// 1: COBS framed binary messages (frame.h) instead of #TEXT*, both ends
+// have to agree
+#ifndef WIRE_BINARY
+#define WIRE_BINARY 0
+#endif
+
+// Requests in flight at once. Each waits in the pending table until its
+// reply comes, by sequence number in frames, by kind and in order in
+// text, and is sent again after REQUEST_TIMEOUT_MS with no reply. The
+// device reads its UART FIFO (32 bytes) once a loop, so the default
+// window is what fits in it: 4 request frames of 7 bytes, 2 texts
+#ifndef WIRE_WINDOW
+#define WIRE_WINDOW (WIRE_BINARY ? 4 : 2)
+#endif
+#define WINDOW_MAX 16
+#define REQUEST_TIMEOUT_MS 500
+#define REQUEST_RETRIES 2
+
 // Message structures
 typedef struct {
     char command[MESSAGE_SIZE];
     uint32_t timestamp;
 } history_entry_t;
 
+typedef struct {
+    bool used;
+    uint8_t seq;                // of its frame, in binary
+    uint8_t tries;              // sent so many times
+    char message[24];           // REQ:NAME, to send again
+    char reply[24];             // how the reply starts, in text
+    uint32_t first_ms;          // sent first
+    uint32_t sent_ms;           // sent last
+} pending_t;
+
+typedef struct {
+    uint32_t answered, timed_out, resent;
+    uint32_t rtt_total_ms, rtt_max_ms;
+} request_stats_t;
+
 // Global variables
-static char rx_buffer[BUFFER_SIZE];
-static int rx_buffer_pos = 0;
+static uint32_t rx_tail = 0;    // first received byte not yet consumed
+static uint32_t rx_scan = 0;    // first received byte not yet looked at
 static history_entry_t command_history[HISTORY_SIZE];
 static int history_count = 0;
 static volatile bool running = true;
+static pending_t pending[WINDOW_MAX];
+static int pending_count = 0;
+static int window = WIRE_WINDOW;
+static request_stats_t stats;
+static bool quiet = false;      // matched replies counted, not shown
+#if WIRE_BINARY
+static bool rx_resync = false;  // after an overrun: up to the next zero is a torn frame
+static uint8_t tx_seq = 0;
+#endif
 
 // Function prototypes
 void send_command(const char* command);
 void send_request(const char* request);
-void check_for_messages();
+pending_t* issue_request(const char* request);
+void send_message(const char* message);
+bool check_for_messages();
+void check_pending();
+void wait_for_replies();
+void poll_device(int rounds);
+void handle_received(uint32_t pos, size_t length);
 void display_message(const char* message);
 void interactive_mode();
 void monitor_mode();
@@ -53,6 +102,7 @@ void interactive_mode() {
     while (running) {
         // Check for incoming messages first
         check_for_messages();
+        check_pending();
         
         // Get user input (non-blocking check)
         printf("\nEnter command (or 'help'): ");
@@ -94,6 +144,13 @@ void interactive_mode() {
                 send_command("LED_OFF");
             } else if (strcmp(upper_cmd, "TEMP") == 0) {
                 send_request("TEMP");
+            } else if (strncmp(upper_cmd, "POLL", 4) == 0) {
+                int rounds = atoi(cmd + 4);
+                poll_device(rounds > 0 ? rounds : 10);
+            } else if (strncmp(upper_cmd, "WINDOW", 6) == 0) {
+                int n = atoi(cmd + 6);
+                if (n >= 1 && n <= WINDOW_MAX) window = n;
+                printf("Window: %d request%s in flight\n", window, window == 1 ? "" : "s");
             } else if (strncmp(upper_cmd, "RAW:", 4) == 0) {
                 // Send raw message (useful for testing)
                 send_command(cmd + 4);
@@ -118,13 +175,11 @@ void monitor_mode() {
         bool had_activity = false;
         
         // Check for messages
-        int old_pos = rx_buffer_pos;
-        check_for_messages();
-        
-        if (rx_buffer_pos != old_pos || uart_is_readable(UART_ID)) {
+        if (check_for_messages() || uart_is_readable(UART_ID)) {
             had_activity = true;
             last_activity = to_ms_since_boot(get_absolute_time());
         }
+        check_pending();
         
         // Show periodic status if no activity
         uint32_t now = to_ms_since_boot(get_absolute_time());
@@ -133,14 +188,40 @@ void monitor_mode() {
             last_activity = now;
         }
         
-        sleep_ms(100);
+        // sleeps until a burst of data has ended, or 100 ms
+        uart_rx_wait_idle(100);
     }
 }
 
-void send_command(const char* command) {
-    char message[MESSAGE_SIZE];
-    snprintf(message, sizeof(message), "CMD:%s", command);
-    
+#if WIRE_BINARY
+void send_frame(uint8_t type, uint8_t seq, const void* payload, size_t length) {
+    uint8_t encoded[FRAME_MAX_ENCODED];
+    size_t n = frame_encode(type, seq, payload, length, encoded);
+    uart_write_blocking(UART_ID, encoded, n);
+}
+
+// Known commands and requests go as their codes, anything else (RAW:)
+// as its text in a FRAME_TEXT; seq is the frame's, the same again when
+// a request is sent again
+void send_message_seq(const char* message, uint8_t seq) {
+    uint8_t code = 0;
+    if (strncmp(message, "CMD:", 4) == 0) code = frame_cmd_code(message + 4);
+    else if (strncmp(message, "REQ:", 4) == 0) code = frame_req_code(message + 4);
+
+    if (code) {
+        frame_code_t payload = { code };
+        send_frame(message[0] == 'C' ? FRAME_CMD : FRAME_REQ, seq, &payload, sizeof(payload));
+    } else {
+        size_t length = strlen(message);
+        send_frame(FRAME_TEXT, seq, message, length < FRAME_MAX_PAYLOAD ? length : FRAME_MAX_PAYLOAD);
+    }
+}
+
+void send_message(const char* message) {
+    send_message_seq(message, tx_seq++);
+}
+#else
+void send_message(const char* message) {
     char formatted[MESSAGE_SIZE + 4];
     format_message(message, formatted);
     
@@ -148,82 +229,238 @@ void send_command(const char* command) {
     for (size_t i = 0; i < strlen(formatted); i++) {
         uart_putc(UART_ID, formatted[i]);
     }
+}
+#endif
+
+void send_command(const char* command) {
+    char message[MESSAGE_SIZE];
+    snprintf(message, sizeof(message), "CMD:%s", command);
+    send_message(message);
     
     printf("Sent command: %s\n", command);
     add_to_history(message);
 }
 
 void send_request(const char* request) {
-    char message[MESSAGE_SIZE];
-    snprintf(message, sizeof(message), "REQ:%s", request);
-    
-    char formatted[MESSAGE_SIZE + 4];
-    format_message(message, formatted);
-    
-    // Send the formatted message
-    for (size_t i = 0; i < strlen(formatted); i++) {
-        uart_putc(UART_ID, formatted[i]);
+    pending_t* p = issue_request(request);
+    if (!p) {
+        printf("Request too long: %s\n", request);
+        return;
     }
-    
     printf("Sent request: %s\n", request);
-    add_to_history(message);
+    add_to_history(p->message);
 }
 
-void check_for_messages() {
-    // Read all available characters
-    while (uart_is_readable(UART_ID)) {
-        char c = uart_getc(UART_ID);
-        
-        // Add to buffer if there's space
-        if (rx_buffer_pos < BUFFER_SIZE - 1) {
-            rx_buffer[rx_buffer_pos++] = c;
-            rx_buffer[rx_buffer_pos] = '\0';
-        } else {
-            // Buffer overflow - shift left and continue
-            memmove(rx_buffer, rx_buffer + BUFFER_SIZE/2, BUFFER_SIZE/2);
-            rx_buffer_pos = BUFFER_SIZE/2;
-            rx_buffer[rx_buffer_pos++] = c;
-            rx_buffer[rx_buffer_pos] = '\0';
-            printf("Warning: RX buffer overflow, data may be lost\n");
+// --- requests in flight ---
+
+static uint32_t now_ms() {
+    return to_ms_since_boot(get_absolute_time());
+}
+
+static void transmit(pending_t* p) {
+#if WIRE_BINARY
+    send_message_seq(p->message, p->seq);
+#else
+    send_message(p->message);
+#endif
+    p->sent_ms = now_ms();
+    p->tries++;
+}
+
+static void retire(pending_t* p) {
+    p->used = false;
+    pending_count--;
+}
+
+// The request goes out as soon as the window has room for it, without
+// waiting for the replies to those before it; NULL if it is too long
+pending_t* issue_request(const char* request) {
+    pending_t* p = NULL;
+    if (strlen(request) + 5 > sizeof(p->message)) return NULL;
+    while (pending_count >= window) {
+        uart_rx_wait_idle(5);
+        check_for_messages();
+        check_pending();
+    }
+    for (p = pending; p->used; p++) {}
+
+    snprintf(p->message, sizeof(p->message), "REQ:%s", request);
+    // REQ:STATUS is answered with STATUS_RESP:..., the others with NAME:...
+    snprintf(p->reply, sizeof(p->reply), "%s%s:", request,
+             strcmp(request, "STATUS") == 0 ? "_RESP" : "");
+#if WIRE_BINARY
+    p->seq = tx_seq++;
+#endif
+    p->used = true;
+    p->tries = 0;
+    pending_count++;
+    transmit(p);
+    p->first_ms = p->sent_ms;
+    return p;
+}
+
+static void answered(pending_t* p) {
+    uint32_t rtt = now_ms() - p->first_ms;
+    stats.answered++;
+    stats.rtt_total_ms += rtt;
+    if (rtt > stats.rtt_max_ms) stats.rtt_max_ms = rtt;
+    retire(p);
+}
+
+#if WIRE_BINARY
+// A reply has the number of the frame it answers; heartbeats, batches
+// and events are no replies, whatever number they carry
+static bool match_reply(const frame_t* f) {
+    if (f->type != FRAME_TEMP && f->type != FRAME_STATUS && f->type != FRAME_TIME &&
+        f->type != FRAME_ERROR) return false;
+    for (int i = 0; i < WINDOW_MAX; i++) {
+        if (pending[i].used && pending[i].seq == f->seq) {
+            answered(&pending[i]);
+            return true;
         }
     }
-    
-    // Look for complete messages in buffer
-    char* search_start = rx_buffer;
-    while (search_start < rx_buffer + rx_buffer_pos) {
-        char* msg_start = strchr(search_start, '#');
-        if (!msg_start) break;
-        
-        char* msg_end = strchr(msg_start, '*');
-        if (!msg_end) break;
-        
-        // Extract and parse the message
-        size_t msg_len = msg_end - msg_start + 1;
-        char raw_msg[MESSAGE_SIZE];
-        if (msg_len < MESSAGE_SIZE) {
-            strncpy(raw_msg, msg_start, msg_len);
-            raw_msg[msg_len] = '\0';
-            
-            char parsed_msg[MESSAGE_SIZE];
-            if (parse_message(raw_msg, parsed_msg)) {
-                display_message(parsed_msg);
-            }
+    return false;
+}
+#else
+// The device answers in order, so a reply is for the oldest request
+// that one of its kind would answer; an error for the oldest of all
+static bool match_reply(const char* message) {
+    bool error = strncmp(message, "ERROR:UNKNOWN_REQ", 17) == 0;
+    pending_t* oldest = NULL;
+    for (int i = 0; i < WINDOW_MAX; i++) {
+        pending_t* p = &pending[i];
+        if (!p->used || (!error && strncmp(message, p->reply, strlen(p->reply)) != 0)) continue;
+        if (!oldest || (int32_t)(p->first_ms - oldest->first_ms) < 0) oldest = p;
+    }
+    if (oldest) answered(oldest);
+    return oldest != NULL;
+}
+#endif
+
+// Send again what has waited too long, give up after REQUEST_RETRIES
+void check_pending() {
+    uint32_t now = now_ms();
+    for (int i = 0; i < WINDOW_MAX; i++) {
+        pending_t* p = &pending[i];
+        if (!p->used || now - p->sent_ms < REQUEST_TIMEOUT_MS) continue;
+        if (p->tries <= REQUEST_RETRIES) {
+            stats.resent++;
+            transmit(p);
+        } else {
+            printf("Timeout: %s, no reply after %u tries\n", p->message, p->tries);
+            stats.timed_out++;
+            retire(p);
         }
-        
-        // Move search position past this message
-        search_start = msg_end + 1;
     }
-    
-    // Clean up processed messages from buffer
-    if (search_start > rx_buffer) {
-        size_t remaining = rx_buffer + rx_buffer_pos - search_start;
-        if (remaining > 0) {
-            memmove(rx_buffer, search_start, remaining);
+}
+
+void wait_for_replies() {
+    while (pending_count > 0) {
+        uart_rx_wait_idle(5);
+        check_for_messages();
+        check_pending();
+    }
+}
+
+// Every request rounds times, back to back through the window, and how
+// long it took: with WINDOW 1 each one waits a round trip for the last
+void poll_device(int rounds) {
+    static const char* const names[] = { "TEMP", "STATUS", "TIME" };
+    const int kinds = sizeof(names) / sizeof(names[0]);
+    memset(&stats, 0, sizeof(stats));
+    quiet = true;
+    uint32_t start = now_ms();
+    for (int i = 0; i < rounds * kinds; i++) issue_request(names[i % kinds]);
+    wait_for_replies();
+    uint32_t elapsed = now_ms() - start;
+    quiet = false;
+
+    printf("Polled %d requests in %lu ms, window %d\n", rounds * kinds, elapsed, window);
+    printf("  answered %lu, timed out %lu, sent again %lu\n",
+           stats.answered, stats.timed_out, stats.resent);
+    if (stats.answered) {
+        printf("  round trip avg %lu ms, max %lu ms; %lu requests/s\n",
+               stats.rtt_total_ms / stats.answered, stats.rtt_max_ms,
+               elapsed ? stats.answered * 1000 / elapsed : 0);
+    }
+}
+
+// The DMA fills the ring by itself, so this only scans what came since
+// the last call, from rx_scan to the head, and hands each complete
+// message on without copying the buffer around; true if anything came
+bool check_for_messages() {
+    uint32_t head = uart_rx_head();
+    uint32_t lost = uart_rx_overrun(rx_tail, head);
+    if (lost) {
+        printf("Warning: RX ring overrun, %lu bytes lost\n", lost);
+        rx_tail = rx_scan = head;
+#if WIRE_BINARY
+        rx_resync = true;
+#endif
+        return true;
+    }
+    bool activity = rx_scan != head;
+
+    for (; rx_scan != head; rx_scan++) {
+        uint8_t c = uart_rx_at(rx_scan);
+#if WIRE_BINARY
+        // the zero ends a frame
+        if (c == 0) {
+            if (!rx_resync) handle_received(rx_tail, rx_scan - rx_tail);
+            rx_resync = false;
+            rx_tail = rx_scan + 1;
         }
-        rx_buffer_pos = remaining;
-        rx_buffer[rx_buffer_pos] = '\0';
+#else
+        // a message is from the last '#' to the '*' after it
+        if (c == '#') {
+            rx_tail = rx_scan;
+        } else if (c == '*' && uart_rx_at(rx_tail) == '#') {
+            handle_received(rx_tail, rx_scan - rx_tail + 1);
+            rx_tail = rx_scan + 1;
+        }
+#endif
+    }
+
+    // past the longest message with no end: noise, wait for the next start
+#if WIRE_BINARY
+    if (rx_scan - rx_tail > FRAME_MAX_ENCODED) rx_tail = rx_scan;
+#else
+    if (rx_scan - rx_tail >= MESSAGE_SIZE) rx_tail = rx_scan;
+#endif
+    return activity;
+}
+
+#if WIRE_BINARY
+// The frame is decoded where it is in the ring, only one that wraps
+// round the end is put together in a copy first
+void handle_received(uint32_t pos, size_t length) {
+    if (length == 0 || length > FRAME_MAX_ENCODED) return;
+    uint8_t tmp[FRAME_MAX_ENCODED];
+    frame_t f;
+    if (frame_decode_in_place(uart_rx_span(pos, length, tmp), length, &f)) {
+        if (match_reply(&f) && quiet) return;
+        char text[MESSAGE_SIZE];
+        frame_describe(&f, text, sizeof(text));
+        display_message(text);
+    } else {
+        printf("Warning: bad frame (COBS or CRC), dropped\n");
     }
 }
+#else
+void handle_received(uint32_t pos, size_t length) {
+    if (length >= MESSAGE_SIZE) return;
+    uint8_t tmp[MESSAGE_SIZE];
+    char raw_msg[MESSAGE_SIZE];
+    memcpy(raw_msg, uart_rx_span(pos, length, tmp), length);
+    raw_msg[length] = '\0';
+
+    char parsed_msg[MESSAGE_SIZE];
+    if (parse_message(raw_msg, parsed_msg)) {
+        if (match_reply(parsed_msg) && quiet) return;
+        display_message(parsed_msg);
+    }
+}
+#endif
 
 void display_message(const char* message) {
     char time_str[16];
@@ -267,7 +504,9 @@ void show_help() {
     printf("  LED_ON     - Turn LED on\n");
     printf("  LED_OFF    - Turn LED off\n");
     printf("  TEMP       - Request temperature reading\n");
+    printf("  POLL n     - Request TEMP, STATUS, TIME n times, timed\n");
     printf("\nController Commands:\n");
+    printf("  WINDOW n   - Requests in flight at once (1-%d)\n", WINDOW_MAX);
     printf("  HISTORY    - Show command history\n");
     printf("  CLEAR      - Clear screen\n");
     printf("  HELP       - Show this help\n");
@@ -329,10 +568,17 @@ int main() {
     uart_set_hw_flow(UART_ID, false, false);
     uart_set_format(UART_ID, 8, 1, UART_PARITY_NONE);
     
+    // Receive by DMA from here on
+    uart_rx_init(UART_ID);
+    
     printf("\n=== UART Controller ===\n");
     printf("TX Pin: GP%d, RX Pin: GP%d\n", UART_TX_PIN, UART_RX_PIN);
     printf("Baud Rate: %d\n", BAUD_RATE);
+#if WIRE_BINARY
+    printf("Message Format: COBS frames, CRC-16\n");
+#else
     printf("Message Format: #MESSAGE*\n");
+#endif
     
     // Choose mode
     printf("\nSelect operating mode:\n");
@@ -6,6 +6,8 @@
 #include "hardware/uart.h"
 #include "hardware/gpio.h"
 #include "hardware/adc.h"
+#include "frame.h"
+#include "telemetry.h"
 
 // Config
 #define UART_ID uart1
@@ -17,21 +19,79 @@
 #define BUFFER_SIZE 256
 #define MESSAGE_SIZE 128
 
+#define HEARTBEAT_MS 10000      // the longest silence before a heartbeat
+#define SAMPLE_MS 5000
+#define TEXT_BATCH 10           // samples that fit in a text message
+
+// 1: COBS framed binary messages (frame.h) instead of #TEXT*, both ends
+// have to agree
+#ifndef WIRE_BINARY
+#define WIRE_BINARY 0
+#endif
+
+#define COMMAND_NAME_SIZE 32
+#define DISPATCH_CODES 32       // codes from frames, 1 .. DISPATCH_CODES - 1
+
+// A command or request as parsed from the message, once: its name and
+// code, and what came after a '=' (CMD:NAME=ARG) as text and number
+typedef struct {
+    uint8_t code;
+    const char* name;
+    const char* arg;            // "" if there was none
+    long value;
+} command_t;
+
+typedef void (*command_handler_t)(const command_t* cmd);
+
+typedef struct {
+    const char* name;
+    uint8_t code;
+    command_handler_t handler;
+} dispatch_entry_t;
+
+typedef struct {
+    const char* kind;
+    const dispatch_entry_t* entries;    // sorted by name
+    size_t count;
+    uint8_t error;                      // reply to a name or code not there
+    const dispatch_entry_t* by_code[DISPATCH_CODES];
+} dispatch_table_t;
+
 // Global variables
 static char rx_buffer[BUFFER_SIZE];
 static int rx_buffer_pos = 0;
 static volatile uint32_t message_counter = 0;
 static volatile bool led_state = false;
-static uint32_t last_heartbeat = 0;
+static uint32_t last_sent = 0;
 static uint32_t last_temp_reading = 0;
+static telemetry_t telemetry;
+static uint32_t blink_until = 0;        // while non-zero the LED shows a blink
+#if WIRE_BINARY
+static bool rx_overflow = false;
+static uint8_t tx_seq = 0;
+static int reply_seq = -1;              // the frame being answered, -1 for none
+#endif
 
 void process_messages();
+void dispatch_init();
+void dispatch_message(const char* message);
 void process_command(const char* command);
 void process_request(const char* request);
+void process_command_code(uint8_t code);
+void process_request_code(uint8_t code);
 void send_message(const char* message);
+#if WIRE_BINARY
+void send_frame(uint8_t type, const void* payload, size_t length);
+#endif
+void send_status(bool requested);
+void send_ack(uint8_t command);
+void send_event(uint8_t event);
+void send_error(uint8_t error, uint8_t what, const char* name);
 void send_heartbeat();
-void send_periodic_data();
+void sample_telemetry(uint32_t now);
+void send_telemetry();
 float read_temperature();
+int16_t read_temperature_centi();
 void blink_led(uint32_t duration_ms);
 void set_led(bool state);
 char* format_message(const char* message, char* buffer);
@@ -39,6 +99,56 @@ char* parse_message(const char* raw_message, char* buffer);
 void format_time(uint32_t timestamp, char* buffer);
 
 
+#if WIRE_BINARY
+// A frame is handled as soon as its delimiter comes in, decoded in the
+// RX buffer, so nothing is searched for, copied or moved
+void process_frame(const frame_t* f) {
+    char time_str[16];
+    format_time(to_ms_since_boot(get_absolute_time()), time_str);
+    printf("[%s] Received frame: type %u, seq %u\n", time_str, f->type, f->seq);
+
+    // whatever the handler sends goes out with the request's number, so
+    // the controller can match it with several requests in flight
+    reply_seq = f->seq;
+    const frame_code_t* code = FRAME_PAYLOAD(f, frame_code_t);
+    if (f->type == FRAME_CMD && code) {
+        process_command_code(code->code);
+    } else if (f->type == FRAME_REQ && code) {
+        process_request_code(code->code);
+    } else if (f->type == FRAME_TEXT && f->length < MESSAGE_SIZE) {
+        // a text message in a frame, e.g. from the controller's RAW:
+        char text[MESSAGE_SIZE];
+        memcpy(text, f->payload, f->length);
+        text[f->length] = '\0';
+        dispatch_message(text);
+    } else {
+        printf("Unknown frame: type %u, %u bytes\n", f->type, (unsigned)f->length);
+        send_error(ERROR_UNKNOWN_FORMAT, f->type, NULL);
+    }
+    reply_seq = -1;
+}
+
+void process_messages() {
+    while (uart_is_readable(UART_ID)) {
+        uint8_t c = (uint8_t)uart_getc(UART_ID);
+        if (c != 0) {
+            if (rx_buffer_pos < BUFFER_SIZE) rx_buffer[rx_buffer_pos++] = (char)c;
+            else rx_overflow = true;    // the rest of this frame is lost
+            continue;
+        }
+
+        frame_t f;
+        if (rx_overflow) {
+            printf("Warning: RX buffer overflow, frame dropped\n");
+        } else if (rx_buffer_pos > 0) {
+            if (frame_decode_in_place((uint8_t*)rx_buffer, rx_buffer_pos, &f)) process_frame(&f);
+            else printf("Warning: bad frame (COBS or CRC), dropped\n");
+        }
+        rx_buffer_pos = 0;
+        rx_overflow = false;
+    }
+}
+#else
 void process_messages() {
     // Read all available characters
     while (uart_is_readable(UART_ID)) {
@@ -80,15 +190,7 @@ void process_messages() {
                 format_time(to_ms_since_boot(get_absolute_time()), time_str);
                 printf("[%s] Received: %s\n", time_str, parsed_msg);
                 
-                // Process the message based on type
-                if (strncmp(parsed_msg, "CMD:", 4) == 0) {
-                    process_command(parsed_msg + 4);
-                } else if (strncmp(parsed_msg, "REQ:", 4) == 0) {
-                    process_request(parsed_msg + 4);
-                } else {
-                    printf("Unknown message format: %s\n", parsed_msg);
-                    send_message("ERROR:UNKNOWN_FORMAT");
-                }
+                dispatch_message(parsed_msg);
             }
         }
         
@@ -106,84 +208,257 @@ void process_messages() {
         rx_buffer[rx_buffer_pos] = '\0';
     }
 }
+#endif
 
-void process_command(const char* command) {
-    printf("Processing command: %s\n", command);
-    
-    if (strcmp(command, "STATUS") == 0) {
-        float temp_c = read_temperature();
-        char status_msg[MESSAGE_SIZE];
-        snprintf(status_msg, sizeof(status_msg), 
-                "STATUS:TEMP=%.1fC,LED=%s,COUNT=%lu,UPTIME=%lu", 
-                temp_c, led_state ? "ON" : "OFF", message_counter, 
-                to_ms_since_boot(get_absolute_time()) / 1000);
-        send_message(status_msg);
-        blink_led(100);
-    }
-    else if (strcmp(command, "PING") == 0) {
-        send_message("PONG");
-        blink_led(100);
-    }
-    else if (strcmp(command, "LED_ON") == 0) {
-        set_led(true);
-        send_message("ACK:LED_ON");
-        printf("LED turned ON\n");
+void dispatch_message(const char* message) {
+    // Process the message based on type
+    if (strncmp(message, "CMD:", 4) == 0) {
+        process_command(message + 4);
+    } else if (strncmp(message, "REQ:", 4) == 0) {
+        process_request(message + 4);
+    } else {
+        printf("Unknown message format: %s\n", message);
+        send_error(ERROR_UNKNOWN_FORMAT, 0, NULL);
     }
-    else if (strcmp(command, "LED_OFF") == 0) {
-        set_led(false);
-        send_message("ACK:LED_OFF");
-        printf("LED turned OFF\n");
+}
+
+// Handlers, one to a command or request
+void cmd_status(const command_t* cmd) {
+    (void)cmd;
+    send_status(false);
+    blink_led(100);
+}
+
+void cmd_ping(const command_t* cmd) {
+    (void)cmd;
+#if WIRE_BINARY
+    send_frame(FRAME_PONG, NULL, 0);
+#else
+    send_message("PONG");
+#endif
+    blink_led(100);
+}
+
+void cmd_led_on(const command_t* cmd) {
+    (void)cmd;
+    set_led(true);
+    send_ack(CMD_LED_ON);
+    printf("LED turned ON\n");
+}
+
+void cmd_led_off(const command_t* cmd) {
+    (void)cmd;
+    set_led(false);
+    send_ack(CMD_LED_OFF);
+    printf("LED turned OFF\n");
+}
+
+void cmd_reset(const command_t* cmd) {
+    (void)cmd;
+    send_ack(CMD_RESET);
+    printf("Reset command received - restarting in 2 seconds...\n");
+    sleep_ms(2000);
+    // In a real application, you might reset the watchdog or restart
+    message_counter = 0;
+    send_event(EVENT_RESTARTED);
+}
+
+void req_temp(const command_t* cmd) {
+    (void)cmd;
+#if WIRE_BINARY
+    frame_temp_t temp = { read_temperature_centi() };
+    send_frame(FRAME_TEMP, &temp, sizeof(temp));
+#else
+    float temp_c = read_temperature();
+    float temp_f = (temp_c * 9.0f / 5.0f) + 32.0f;
+    char temp_msg[MESSAGE_SIZE];
+    snprintf(temp_msg, sizeof(temp_msg), "TEMP:%.1fC,%.1fF", temp_c, temp_f);
+    send_message(temp_msg);
+#endif
+    blink_led(100);
+}
+
+void req_status(const command_t* cmd) {
+    (void)cmd;
+    // Same as CMD:STATUS but indicate it was a request
+    send_status(true);
+    blink_led(100);
+}
+
+void req_time(const command_t* cmd) {
+    (void)cmd;
+    uint32_t uptime = to_ms_since_boot(get_absolute_time());
+#if WIRE_BINARY
+    frame_time_t time = { uptime };
+    send_frame(FRAME_TIME, &time, sizeof(time));
+#else
+    char time_msg[MESSAGE_SIZE];
+    snprintf(time_msg, sizeof(time_msg), "TIME:UPTIME=%lu", uptime);
+    send_message(time_msg);
+#endif
+}
+
+// Each list is kept sorted by name (dispatch_init() checks), so a text
+// message is found by binary search; a frame carries the code, which
+// indexes by_code[] directly. A new command is one line here and its
+// handler, and finding it costs the same however many there are
+static const dispatch_entry_t commands[] = {
+    { "LED_OFF", CMD_LED_OFF, cmd_led_off },
+    { "LED_ON",  CMD_LED_ON,  cmd_led_on },
+    { "PING",    CMD_PING,    cmd_ping },
+    { "RESET",   CMD_RESET,   cmd_reset },
+    { "STATUS",  CMD_STATUS,  cmd_status },
+};
+
+static const dispatch_entry_t requests[] = {
+    { "STATUS", REQ_STATUS, req_status },
+    { "TEMP",   REQ_TEMP,   req_temp },
+    { "TIME",   REQ_TIME,   req_time },
+};
+
+static dispatch_table_t command_table = {
+    "command", commands, sizeof(commands) / sizeof(commands[0]), ERROR_UNKNOWN_CMD, { NULL }
+};
+static dispatch_table_t request_table = {
+    "request", requests, sizeof(requests) / sizeof(requests[0]), ERROR_UNKNOWN_REQ, { NULL }
+};
+
+static void init_table(dispatch_table_t* table) {
+    for (size_t i = 0; i < table->count; i++) {
+        const dispatch_entry_t* e = &table->entries[i];
+        if (i > 0 && strcmp(table->entries[i - 1].name, e->name) >= 0)
+            printf("Warning: %s table not sorted at %s\n", table->kind, e->name);
+        if (e->code < DISPATCH_CODES) table->by_code[e->code] = e;
     }
-    else if (strcmp(command, "RESET") == 0) {
-        send_message("ACK:RESET");
-        printf("Reset command received - restarting in 2 seconds...\n");
-        sleep_ms(2000);
-        // In a real application, you might reset the watchdog or restart
-        message_counter = 0;
-        send_message("DEVICE:RESTARTED");
+}
+
+void dispatch_init() {
+    init_table(&command_table);
+    init_table(&request_table);
+}
+
+static int compare_entry(const void* key, const void* entry) {
+    return strcmp((const char*)key, ((const dispatch_entry_t*)entry)->name);
+}
+
+// NAME or NAME=ARG, split once into the command; false if the name is
+// too long to be one
+static bool parse_command(const char* text, command_t* cmd, char* name, size_t size) {
+    const char* eq = strchr(text, '=');
+    size_t n = eq ? (size_t)(eq - text) : strlen(text);
+    if (n >= size) return false;
+    memcpy(name, text, n);
+    name[n] = '\0';
+    cmd->name = name;
+    cmd->arg = eq ? eq + 1 : "";
+    cmd->value = eq ? strtol(eq + 1, NULL, 0) : 0;
+    return true;
+}
+
+static void dispatch_text(const dispatch_table_t* table, const char* text) {
+    printf("Processing %s: %s\n", table->kind, text);
+
+    char name[COMMAND_NAME_SIZE];
+    command_t cmd;
+    const dispatch_entry_t* e = NULL;
+    if (parse_command(text, &cmd, name, sizeof(name)))
+        e = bsearch(name, table->entries, table->count, sizeof(table->entries[0]), compare_entry);
+    if (!e) {
+        printf("Unknown %s: %s\n", table->kind, text);
+        send_error(table->error, 0, text);
+        return;
     }
-    else {
-        printf("Unknown command: %s\n", command);
-        char error_msg[MESSAGE_SIZE];
-        snprintf(error_msg, sizeof(error_msg), "ERROR:UNKNOWN_CMD:%s", command);
-        send_message(error_msg);
+    cmd.code = e->code;
+    e->handler(&cmd);
+}
+
+static void dispatch_code(const dispatch_table_t* table, uint8_t code) {
+    const dispatch_entry_t* e = code < DISPATCH_CODES ? table->by_code[code] : NULL;
+    if (!e) {
+        printf("Unknown %s code: %u\n", table->kind, code);
+        send_error(table->error, code, NULL);
+        return;
     }
+    printf("Processing %s: %s\n", table->kind, e->name);
+    command_t cmd = { e->code, e->name, "", 0 };
+    e->handler(&cmd);
+}
+
+void process_command(const char* command) {
+    dispatch_text(&command_table, command);
 }
 
 void process_request(const char* request) {
-    printf("Processing request: %s\n", request);
-    
-    if (strcmp(request, "TEMP") == 0) {
-        float temp_c = read_temperature();
-        float temp_f = (temp_c * 9.0f / 5.0f) + 32.0f;
-        char temp_msg[MESSAGE_SIZE];
-        snprintf(temp_msg, sizeof(temp_msg), "TEMP:%.1fC,%.1fF", temp_c, temp_f);
-        send_message(temp_msg);
-        blink_led(100);
-    }
-    else if (strcmp(request, "STATUS") == 0) {
-        // Same as CMD:STATUS but indicate it was a request
-        float temp_c = read_temperature();
-        char status_msg[MESSAGE_SIZE];
-        snprintf(status_msg, sizeof(status_msg), 
-                "STATUS_RESP:TEMP=%.1fC,LED=%s,COUNT=%lu,UPTIME=%lu", 
-                temp_c, led_state ? "ON" : "OFF", message_counter, 
-                to_ms_since_boot(get_absolute_time()) / 1000);
-        send_message(status_msg);
-        blink_led(100);
-    }
-    else if (strcmp(request, "TIME") == 0) {
-        uint32_t uptime = to_ms_since_boot(get_absolute_time());
-        char time_msg[MESSAGE_SIZE];
-        snprintf(time_msg, sizeof(time_msg), "TIME:UPTIME=%lu", uptime);
-        send_message(time_msg);
-    }
-    else {
-        printf("Unknown request: %s\n", request);
-        char error_msg[MESSAGE_SIZE];
-        snprintf(error_msg, sizeof(error_msg), "ERROR:UNKNOWN_REQ:%s", request);
-        send_message(error_msg);
-    }
+    dispatch_text(&request_table, request);
+}
+
+void process_command_code(uint8_t code) {
+    dispatch_code(&command_table, code);
+}
+
+void process_request_code(uint8_t code) {
+    dispatch_code(&request_table, code);
+}
+
+void send_status(bool requested) {
+#if WIRE_BINARY
+    frame_status_t status = {
+        .temp_centi = read_temperature_centi(),
+        .led = led_state,
+        .requested = requested,
+        .count = message_counter,
+        .uptime_s = to_ms_since_boot(get_absolute_time()) / 1000,
+    };
+    send_frame(FRAME_STATUS, &status, sizeof(status));
+#else
+    float temp_c = read_temperature();
+    char status_msg[MESSAGE_SIZE];
+    snprintf(status_msg, sizeof(status_msg), 
+            "%s:TEMP=%.1fC,LED=%s,COUNT=%lu,UPTIME=%lu", 
+            requested ? "STATUS_RESP" : "STATUS",
+            temp_c, led_state ? "ON" : "OFF", message_counter, 
+            to_ms_since_boot(get_absolute_time()) / 1000);
+    send_message(status_msg);
+#endif
+}
+
+void send_ack(uint8_t command) {
+#if WIRE_BINARY
+    frame_code_t ack = { command };
+    send_frame(FRAME_ACK, &ack, sizeof(ack));
+#else
+    char ack_msg[MESSAGE_SIZE];
+    snprintf(ack_msg, sizeof(ack_msg), "ACK:%s", frame_cmd_name(command));
+    send_message(ack_msg);
+#endif
+}
+
+void send_event(uint8_t event) {
+#if WIRE_BINARY
+    frame_code_t e = { event };
+    send_frame(FRAME_EVENT, &e, sizeof(e));
+#else
+    send_message(event == EVENT_RESTARTED ? "DEVICE:RESTARTED" : "DEVICE:STARTED");
+#endif
+}
+
+// what is the code not known in a frame, name the word in a text message
+void send_error(uint8_t error, uint8_t what, const char* name) {
+#if WIRE_BINARY
+    (void)name;
+    frame_error_t e = { error, what };
+    send_frame(FRAME_ERROR, &e, sizeof(e));
+#else
+    char error_msg[MESSAGE_SIZE];
+    const char* kind = error == ERROR_UNKNOWN_CMD ? "UNKNOWN_CMD" : "UNKNOWN_REQ";
+    if (error == ERROR_UNKNOWN_FORMAT)
+        snprintf(error_msg, sizeof(error_msg), "ERROR:UNKNOWN_FORMAT");
+    else if (name)
+        snprintf(error_msg, sizeof(error_msg), "ERROR:%s:%s", kind, name);
+    else
+        snprintf(error_msg, sizeof(error_msg), "ERROR:%s:%u", kind, what);
+    send_message(error_msg);
+#endif
 }
 
 void send_message(const char* message) {
@@ -196,29 +471,60 @@ void send_message(const char* message) {
     }
     
     message_counter++;
+    last_sent = to_ms_since_boot(get_absolute_time());
     
     char time_str[16];
     format_time(to_ms_since_boot(get_absolute_time()), time_str);
     printf("[%s] Sent: %s\n", time_str, message);
 }
 
+#if WIRE_BINARY
+void send_frame(uint8_t type, const void* payload, size_t length) {
+    uint8_t encoded[FRAME_MAX_ENCODED];
+    uint8_t seq = reply_seq >= 0 ? (uint8_t)reply_seq : tx_seq++;
+    size_t n = frame_encode(type, seq, payload, length, encoded);
+    uart_write_blocking(UART_ID, encoded, n);
+
+    message_counter++;
+    last_sent = to_ms_since_boot(get_absolute_time());
+
+    char time_str[16];
+    format_time(to_ms_since_boot(get_absolute_time()), time_str);
+    printf("[%s] Sent frame: type %u, %u bytes\n", time_str, type, (unsigned)n);
+}
+#endif
+
 void send_heartbeat() {
-    char heartbeat_msg[MESSAGE_SIZE];
     uint32_t uptime = to_ms_since_boot(get_absolute_time()) / 1000;
+#if WIRE_BINARY
+    frame_heartbeat_t heartbeat = { uptime, message_counter };
+    send_frame(FRAME_HEARTBEAT, &heartbeat, sizeof(heartbeat));
+#else
+    char heartbeat_msg[MESSAGE_SIZE];
     snprintf(heartbeat_msg, sizeof(heartbeat_msg), 
             "HEARTBEAT:UPTIME=%lu,COUNT=%lu", uptime, message_counter);
     send_message(heartbeat_msg);
+#endif
 }
 
-void send_periodic_data() {
-    float temp_c = read_temperature();
-    float temp_f = (temp_c * 9.0f / 5.0f) + 32.0f;
-    
-    char temp_msg[MESSAGE_SIZE];
-    snprintf(temp_msg, sizeof(temp_msg), 
-            "PERIODIC:TEMP=%.1fC/%.1fF,LED=%s", 
-            temp_c, temp_f, led_state ? "ON" : "OFF");
-    send_message(temp_msg);
+void sample_telemetry(uint32_t now) {
+    telemetry_add(&telemetry, now, read_temperature_centi());
+}
+
+// The samples waiting, as deltas in a frame, or in text spelled out by
+// the same code the controller uses to show the frame
+void send_telemetry() {
+    uint8_t payload[FRAME_MAX_PAYLOAD];
+#if WIRE_BINARY
+    size_t length = telemetry_take(&telemetry, message_counter, led_state, TELEMETRY_BATCH, payload);
+    send_frame(FRAME_BATCH, payload, length);
+#else
+    size_t length = telemetry_take(&telemetry, message_counter, led_state, TEXT_BATCH, payload);
+    frame_t batch = { FRAME_BATCH, 0, payload, length };
+    char batch_msg[MESSAGE_SIZE];
+    frame_describe(&batch, batch_msg, sizeof(batch_msg));
+    send_message(batch_msg);
+#endif
 }
 
 float read_temperature() {
@@ -233,15 +539,33 @@ float read_temperature() {
     return temperature;
 }
 
+// The same formula in integers, hundredths of a degree: volts are
+// raw * 3.3 / 4096, and (V - 0.706) / 0.001721 is (uV - 706000) / 1721.
+// 3300000 / 16 keeps raw times it inside 32 bits
+int16_t read_temperature_centi() {
+    int32_t uv = (int32_t)((adc_read() * (3300000u / 16)) >> 8);
+    int32_t centi = 2700 - (uv - 706000) * 100 / 1721;
+    return (int16_t)(centi > INT16_MAX ? INT16_MAX : centi);     // raw near 0 only
+}
+
+// The LED goes on now and back to led_state in the main loop, so a
+// handler does not hold up the requests queued behind it
 void blink_led(uint32_t duration_ms) {
-    bool original_state = led_state;
     gpio_put(LED_PIN, 1);
-    sleep_ms(duration_ms);
-    gpio_put(LED_PIN, original_state ? 1 : 0);
+    blink_until = to_ms_since_boot(get_absolute_time()) + duration_ms;
+    if (blink_until == 0) blink_until = 1;
+}
+
+static void blink_update(uint32_t now) {
+    if (blink_until && (int32_t)(now - blink_until) >= 0) {
+        gpio_put(LED_PIN, led_state ? 1 : 0);
+        blink_until = 0;
+    }
 }
 
 void set_led(bool state) {
     led_state = state;
+    blink_until = 0;
     gpio_put(LED_PIN, state ? 1 : 0);
 }
 
@@ -291,20 +615,27 @@ int main() {
     adc_gpio_init(26 + 4); // Internal temperature sensor is on ADC channel 4
     adc_select_input(4);   // Select temperature sensor
     
+    dispatch_init();
+    telemetry_init(&telemetry, SAMPLE_MS);
+    
     printf("\n=== UART Device Simulator ===\n");
     printf("TX Pin: GP%d, RX Pin: GP%d\n", UART_TX_PIN, UART_RX_PIN);
     printf("LED Pin: GP%d\n", LED_PIN);
     printf("Baud Rate: %d\n", BAUD_RATE);
+#if WIRE_BINARY
+    printf("Message Format: COBS frames, CRC-16\n");
+#else
     printf("Message Format: #MESSAGE*\n");
+#endif
     
     // Send startup message
-    send_message("DEVICE:STARTED");
+    send_event(EVENT_STARTED);
     blink_led(500); // Startup blink
     
     printf("\nDevice ready. Supported commands:\n");
     printf("- CMD:STATUS, CMD:PING, CMD:LED_ON, CMD:LED_OFF\n");
     printf("- REQ:TEMP\n");
-    printf("Sending periodic heartbeat and temperature data...\n\n");
+    printf("Sending temperature data in batches, and a heartbeat when quiet...\n\n");
     
     // Main loop
     while (true) {
@@ -312,17 +643,22 @@ int main() {
         
         // Process incoming messages
         process_messages();
+        blink_update(now);
         
-        // Send periodic heartbeat (every 10 seconds)
-        if (now - last_heartbeat >= 10000) {
-            send_heartbeat();
-            last_heartbeat = now;
+        // Sample the temperature (every 5 seconds), the batch goes when
+        // it is full, old enough, or after a jump
+        if (now - last_temp_reading >= SAMPLE_MS) {
+            sample_telemetry(now);
+            last_temp_reading = now;
+        }
+        if (telemetry_due(&telemetry, now)) {
+            send_telemetry();
         }
         
-        // Send periodic temperature data (every 5 seconds)
-        if (now - last_temp_reading >= 5000) {
-            send_periodic_data();
-            last_temp_reading = now;
+        // Heartbeat only after 10 seconds without any other message,
+        // each of which says the device is alive just as well
+        if (now - last_sent >= HEARTBEAT_MS) {
+            send_heartbeat();
         }
         
         // Small delay
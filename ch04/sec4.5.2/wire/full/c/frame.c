@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <string.h>
+#include "frame.h"
+
+// CRC-16/CCITT-FALSE: polynomial 0x1021, initial 0xFFFF, a byte at a
+// time from a table of the 256 remainders
+static uint16_t crc_table[256];
+static bool crc_ready = false;
+
+static void crc_init(void) {
+    for (int i = 0; i < 256; i++) {
+        uint16_t c = (uint16_t)(i << 8);
+        for (int b = 0; b < 8; b++)
+            c = (c & 0x8000) ? (uint16_t)((c << 1) ^ 0x1021) : (uint16_t)(c << 1);
+        crc_table[i] = c;
+    }
+    crc_ready = true;
+}
+
+uint16_t crc16(const uint8_t* data, size_t n) {
+    if (!crc_ready) crc_init();
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < n; i++)
+        crc = (uint16_t)((crc << 8) ^ crc_table[(crc >> 8) ^ data[i]]);
+    return crc;
+}
+
+// Each zero, and the end, is replaced by a code byte: the distance to
+// the next zero. A run of 254 non-zero bytes gets code 0xFF and no zero
+size_t cobs_encode(const uint8_t* in, size_t n, uint8_t* out) {
+    size_t code_at = 0, o = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < n; i++) {
+        if (in[i] == 0) {
+            out[code_at] = code;
+            code_at = o++;
+            code = 1;
+            continue;
+        }
+        out[o++] = in[i];
+        if (++code == 0xFF && i + 1 < n) {
+            out[code_at] = code;
+            code_at = o++;
+            code = 1;
+        }
+    }
+    out[code_at] = code;
+    return o;
+}
+
+// The decoded bytes are never ahead of the encoded ones, so the
+// decoding can write over them as it goes
+size_t cobs_decode_in_place(uint8_t* buf, size_t n) {
+    size_t i = 0, o = 0;
+    while (i < n) {
+        uint8_t code = buf[i++];
+        if (code == 0 || i + code - 1 > n) return SIZE_MAX;
+        for (uint8_t k = 1; k < code; k++) buf[o++] = buf[i++];
+        if (code != 0xFF && i < n) buf[o++] = 0;
+    }
+    return o;
+}
+
+size_t frame_encode(uint8_t type, uint8_t seq, const void* payload, size_t length, uint8_t* out) {
+    if (length > FRAME_MAX_PAYLOAD) return 0;
+    uint8_t raw[FRAME_MAX_RAW];
+    raw[0] = type;
+    raw[1] = seq;
+    if (length) memcpy(raw + FRAME_HEADER, payload, length);
+    uint16_t crc = crc16(raw, FRAME_HEADER + length);
+    raw[FRAME_HEADER + length] = (uint8_t)crc;
+    raw[FRAME_HEADER + length + 1] = (uint8_t)(crc >> 8);
+    size_t n = cobs_encode(raw, FRAME_HEADER + length + FRAME_CRC, out);
+    out[n++] = 0;
+    return n;
+}
+
+bool frame_decode_in_place(uint8_t* buf, size_t n, frame_t* f) {
+    size_t m = cobs_decode_in_place(buf, n);
+    if (m == SIZE_MAX || m < FRAME_HEADER + FRAME_CRC) return false;
+    size_t body = m - FRAME_CRC;
+    uint16_t crc = (uint16_t)(buf[body] | (buf[body + 1] << 8));
+    if (crc != crc16(buf, body)) return false;
+    f->type = buf[0];
+    f->seq = buf[1];
+    f->payload = buf + FRAME_HEADER;
+    f->length = body - FRAME_HEADER;
+    return true;
+}
+
+size_t frame_batch_encode(const frame_batch_t* header, const int16_t* temps, size_t n,
+                          uint8_t* out, size_t* taken) {
+    frame_batch_t h = *header;
+    size_t length = sizeof(h), i = 0;
+    if (n > 0) {
+        h.temp_centi = temps[0];
+        for (i = 1; i < n && i < 255; i++) {
+            int d = temps[i] - temps[i - 1];
+            bool small = d > FRAME_DELTA_ESCAPE && d <= 127;
+            if (length + (small ? 1 : 3) > FRAME_MAX_PAYLOAD) break;
+            if (small) {
+                out[length++] = (uint8_t)(int8_t)d;
+            } else {
+                out[length++] = (uint8_t)(int8_t)FRAME_DELTA_ESCAPE;
+                out[length++] = (uint8_t)temps[i];
+                out[length++] = (uint8_t)((uint16_t)temps[i] >> 8);
+            }
+        }
+    }
+    h.samples = (uint8_t)i;
+    memcpy(out, &h, sizeof(h));
+    *taken = i;
+    return length;
+}
+
+static const char* const cmd_names[] = { NULL, "STATUS", "PING", "LED_ON", "LED_OFF", "RESET" };
+static const char* const req_names[] = { NULL, "TEMP", "STATUS", "TIME" };
+
+#define COUNT(a) (sizeof(a) / sizeof((a)[0]))
+
+static const char* name_of(const char* const* names, size_t n, uint8_t code) {
+    return code > 0 && code < n ? names[code] : "?";
+}
+
+static uint8_t code_of(const char* const* names, size_t n, const char* name) {
+    for (size_t i = 1; i < n; i++)
+        if (strcmp(names[i], name) == 0) return (uint8_t)i;
+    return 0;
+}
+
+const char* frame_cmd_name(uint8_t code) { return name_of(cmd_names, COUNT(cmd_names), code); }
+const char* frame_req_name(uint8_t code) { return name_of(req_names, COUNT(req_names), code); }
+uint8_t frame_cmd_code(const char* name) { return code_of(cmd_names, COUNT(cmd_names), name); }
+uint8_t frame_req_code(const char* name) { return code_of(req_names, COUNT(req_names), name); }
+
+// Centi-degrees as the text protocol's one decimal, with no float
+static int tenths(int16_t centi, char* buf, size_t size) {
+    int t = centi < 0 ? (centi - 5) / 10 : (centi + 5) / 10;
+    return snprintf(buf, size, "%s%d.%d", t < 0 ? "-" : "", (t < 0 ? -t : t) / 10, (t < 0 ? -t : t) % 10);
+}
+
+size_t frame_describe(const frame_t* f, char* buf, size_t size) {
+    char c[16], fahr[16];
+    int n = -1;
+    switch (f->type) {
+    case FRAME_CMD:
+    case FRAME_REQ:
+    case FRAME_ACK:
+    case FRAME_EVENT: {
+        const frame_code_t* p = FRAME_PAYLOAD(f, frame_code_t);
+        if (!p) break;
+        if (f->type == FRAME_CMD) n = snprintf(buf, size, "CMD:%s", frame_cmd_name(p->code));
+        else if (f->type == FRAME_REQ) n = snprintf(buf, size, "REQ:%s", frame_req_name(p->code));
+        else if (f->type == FRAME_ACK) n = snprintf(buf, size, "ACK:%s", frame_cmd_name(p->code));
+        else n = snprintf(buf, size, "DEVICE:%s", p->code == EVENT_RESTARTED ? "RESTARTED" : "STARTED");
+        break;
+    }
+    case FRAME_PONG:
+        n = snprintf(buf, size, "PONG");
+        break;
+    case FRAME_STATUS: {
+        const frame_status_t* p = FRAME_PAYLOAD(f, frame_status_t);
+        if (!p) break;
+        tenths(p->temp_centi, c, sizeof(c));
+        n = snprintf(buf, size, "%s:TEMP=%sC,LED=%s,COUNT=%lu,UPTIME=%lu",
+                     p->requested ? "STATUS_RESP" : "STATUS", c, p->led ? "ON" : "OFF",
+                     (unsigned long)p->count, (unsigned long)p->uptime_s);
+        break;
+    }
+    case FRAME_TEMP: {
+        const frame_temp_t* p = FRAME_PAYLOAD(f, frame_temp_t);
+        if (!p) break;
+        tenths(p->temp_centi, c, sizeof(c));
+        tenths((int16_t)(p->temp_centi * 9 / 5 + 3200), fahr, sizeof(fahr));
+        n = snprintf(buf, size, "TEMP:%sC,%sF", c, fahr);
+        break;
+    }
+    case FRAME_TIME: {
+        const frame_time_t* p = FRAME_PAYLOAD(f, frame_time_t);
+        if (!p) break;
+        n = snprintf(buf, size, "TIME:UPTIME=%lu", (unsigned long)p->uptime_ms);
+        break;
+    }
+    case FRAME_HEARTBEAT: {
+        const frame_heartbeat_t* p = FRAME_PAYLOAD(f, frame_heartbeat_t);
+        if (!p) break;
+        n = snprintf(buf, size, "HEARTBEAT:UPTIME=%lu,COUNT=%lu", (unsigned long)p->uptime_s, (unsigned long)p->count);
+        break;
+    }
+    case FRAME_PERIODIC: {
+        const frame_periodic_t* p = FRAME_PAYLOAD(f, frame_periodic_t);
+        if (!p) break;
+        tenths(p->temp_centi, c, sizeof(c));
+        tenths((int16_t)(p->temp_centi * 9 / 5 + 3200), fahr, sizeof(fahr));
+        n = snprintf(buf, size, "PERIODIC:TEMP=%sC/%sF,LED=%s", c, fahr, p->led ? "ON" : "OFF");
+        break;
+    }
+    case FRAME_ERROR: {
+        const frame_error_t* p = FRAME_PAYLOAD(f, frame_error_t);
+        if (!p) break;
+        if (p->code == ERROR_UNKNOWN_CMD) n = snprintf(buf, size, "ERROR:UNKNOWN_CMD:%u", p->what);
+        else if (p->code == ERROR_UNKNOWN_REQ) n = snprintf(buf, size, "ERROR:UNKNOWN_REQ:%u", p->what);
+        else n = snprintf(buf, size, "ERROR:UNKNOWN_FORMAT");
+        break;
+    }
+    case FRAME_TEXT:
+        n = snprintf(buf, size, "%.*s", (int)f->length, (const char*)f->payload);
+        break;
+    case FRAME_BATCH: {
+        frame_batch_t h;
+        if (f->length < sizeof(h)) break;
+        memcpy(&h, f->payload, sizeof(h));
+        n = snprintf(buf, size, "BATCH:UPTIME=%lu,COUNT=%lu,EVERY=%u,LED=%s,TEMP=",
+                     (unsigned long)(h.start_ms / 1000), (unsigned long)h.count, h.period_ms,
+                     h.led ? "ON" : "OFF");
+        // the temperatures put back together, in degrees
+        const uint8_t* p = f->payload + sizeof(h);
+        const uint8_t* end = f->payload + f->length;
+        int16_t t = h.temp_centi;
+        for (unsigned i = 0; i < h.samples && (size_t)n < size; i++) {
+            if (i > 0) {
+                if (p >= end) break;
+                int8_t d = (int8_t)*p++;
+                if (d != FRAME_DELTA_ESCAPE) {
+                    t = (int16_t)(t + d);
+                } else {
+                    if (end - p < 2) break;
+                    t = (int16_t)(p[0] | (p[1] << 8));
+                    p += 2;
+                }
+            }
+            tenths(t, c, sizeof(c));
+            n += snprintf(buf + n, size - n, "%s%s", i ? "," : "", c);
+        }
+        if ((size_t)n < size) n += snprintf(buf + n, size - n, "C");
+        break;
+    }
+    }
+    if (n < 0) n = snprintf(buf, size, "FRAME:%u,%u bytes", f->type, (unsigned)f->length);
+    return (size_t)n < size ? (size_t)n : size - 1;
+}
@@ -0,0 +1,140 @@
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Binary framing for the controller/device link, used instead of the
+// #TEXT* messages when both are built with WIRE_BINARY=1.
+//
+// A frame is a type, a sequence number, a payload of fixed layout for
+// its type, and a CRC-16 over all of that. It goes on the wire COBS
+// encoded (Consistent Overhead Byte Stuffing: no zero bytes inside,
+// one byte of overhead per 254) and is ended by a zero. The receiver
+// decodes it in place in its RX buffer, and the payload is read there
+// through a packed struct: multi-byte fields are little-endian, as both
+// ends are RP2040s
+
+#define FRAME_MAX_PAYLOAD 64
+#define FRAME_HEADER 2          // type, seq
+#define FRAME_CRC 2
+// COBS adds one byte per 254 and the code byte, then the delimiter
+#define FRAME_MAX_RAW (FRAME_HEADER + FRAME_MAX_PAYLOAD + FRAME_CRC)
+#define FRAME_MAX_ENCODED (FRAME_MAX_RAW + FRAME_MAX_RAW / 254 + 2)
+
+typedef enum {
+    FRAME_CMD = 1,      // frame_code_t, a cmd_code_t
+    FRAME_REQ,          // frame_code_t, a req_code_t
+    FRAME_ACK,          // frame_code_t, the command done
+    FRAME_PONG,         // no payload
+    FRAME_STATUS,       // frame_status_t
+    FRAME_TEMP,         // frame_temp_t
+    FRAME_TIME,         // frame_time_t
+    FRAME_HEARTBEAT,    // frame_heartbeat_t
+    FRAME_PERIODIC,     // frame_periodic_t
+    FRAME_EVENT,        // frame_code_t, an event_code_t
+    FRAME_ERROR,        // frame_error_t
+    FRAME_TEXT,         // characters, no terminator: a text message
+    FRAME_BATCH         // frame_batch_t, then the deltas
+} frame_type_t;
+
+typedef enum { CMD_STATUS = 1, CMD_PING, CMD_LED_ON, CMD_LED_OFF, CMD_RESET } cmd_code_t;
+typedef enum { REQ_TEMP = 1, REQ_STATUS, REQ_TIME } req_code_t;
+typedef enum { EVENT_STARTED = 1, EVENT_RESTARTED } event_code_t;
+typedef enum { ERROR_UNKNOWN_FORMAT = 1, ERROR_UNKNOWN_CMD, ERROR_UNKNOWN_REQ } error_code_t;
+
+// Payloads. Packed, so the compiler reads them byte by byte wherever
+// they are in the buffer; the Cortex-M0+ faults on unaligned words
+#define FRAME_PACKED __attribute__((packed))
+
+typedef struct FRAME_PACKED {
+    uint8_t code;
+} frame_code_t;
+
+typedef struct FRAME_PACKED {
+    int16_t temp_centi;     // degrees C x 100
+    uint8_t led;
+    uint8_t requested;      // 1: answers REQ_STATUS, 0: CMD_STATUS
+    uint32_t count;         // messages sent
+    uint32_t uptime_s;
+} frame_status_t;
+
+typedef struct FRAME_PACKED {
+    int16_t temp_centi;
+} frame_temp_t;
+
+typedef struct FRAME_PACKED {
+    uint32_t uptime_ms;
+} frame_time_t;
+
+typedef struct FRAME_PACKED {
+    uint32_t uptime_s;
+    uint32_t count;
+} frame_heartbeat_t;
+
+typedef struct FRAME_PACKED {
+    int16_t temp_centi;
+    uint8_t led;
+} frame_periodic_t;
+
+typedef struct FRAME_PACKED {
+    uint8_t code;           // error_code_t
+    uint8_t what;           // the code that was not known
+} frame_error_t;
+
+// Telemetry samples sent together. The header has the first, and each
+// further temperature follows as its difference from the one before:
+// a signed byte, or FRAME_DELTA_ESCAPE and then the value as an int16_t
+typedef struct FRAME_PACKED {
+    uint32_t start_ms;      // uptime at the first sample
+    uint32_t count;         // messages sent, what a heartbeat would say
+    uint16_t period_ms;     // between samples
+    int16_t temp_centi;     // the first sample
+    uint8_t led;
+    uint8_t samples;
+} frame_batch_t;
+
+#define FRAME_DELTA_ESCAPE (-128)
+
+// A decoded frame; payload points into the buffer it was decoded in
+typedef struct {
+    uint8_t type;
+    uint8_t seq;
+    const uint8_t* payload;
+    size_t length;
+} frame_t;
+
+// The payload as a T, or NULL when its length is not that of a T
+#define FRAME_PAYLOAD(f, T) ((f)->length == sizeof(T) ? (const T*)(const void*)(f)->payload : NULL)
+
+uint16_t crc16(const uint8_t* data, size_t n);     // CRC-16/CCITT-FALSE
+
+size_t cobs_encode(const uint8_t* in, size_t n, uint8_t* out);
+size_t cobs_decode_in_place(uint8_t* buf, size_t n);    // SIZE_MAX if malformed
+
+// Encoded frame with its zero delimiter into out (FRAME_MAX_ENCODED
+// bytes); returns its length, or 0 when the payload is too long
+size_t frame_encode(uint8_t type, uint8_t seq, const void* payload, size_t length, uint8_t* out);
+
+// The n bytes before a delimiter, decoded where they are. False when
+// the COBS is malformed, the frame is short or the CRC is wrong
+bool frame_decode_in_place(uint8_t* buf, size_t n, frame_t* f);
+
+// The header and as many of the n temperatures as fit in a payload into
+// out (FRAME_MAX_PAYLOAD bytes); *taken is how many did. The length
+size_t frame_batch_encode(const frame_batch_t* header, const int16_t* temps, size_t n,
+                          uint8_t* out, size_t* taken);
+
+// Names of the codes, as the text protocol spells them, and back; the
+// lookup gives 0 for a name not known
+const char* frame_cmd_name(uint8_t code);
+const char* frame_req_name(uint8_t code);
+uint8_t frame_cmd_code(const char* name);
+uint8_t frame_req_code(const char* name);
+
+// The frame written the way the text protocol would have sent it,
+// e.g. "STATUS:TEMP=23.5C,LED=ON,COUNT=4,UPTIME=12"
+size_t frame_describe(const frame_t* f, char* buf, size_t size);
+
+#endif // FRAME_H
@@ -0,0 +1,50 @@
+#include "frame.h"
+#include "telemetry.h"
+
+void telemetry_init(telemetry_t* t, uint16_t period_ms) {
+    t->first = 0;
+    t->count = 0;
+    t->urgent = false;
+    t->period_ms = period_ms;
+}
+
+void telemetry_add(telemetry_t* t, uint32_t now_ms, int16_t temp_centi) {
+    if (t->count > 0) {
+        int16_t last = t->temp[(t->first + t->count - 1) % TELEMETRY_RING];
+        int d = temp_centi - last;
+        if (d >= TELEMETRY_JUMP_CENTI || d <= -TELEMETRY_JUMP_CENTI) t->urgent = true;
+    }
+    if (t->count == TELEMETRY_RING) {
+        t->first = (t->first + 1) % TELEMETRY_RING;
+        t->count--;
+    }
+    unsigned at = (t->first + t->count) % TELEMETRY_RING;
+    t->temp[at] = temp_centi;
+    t->time[at] = now_ms;
+    t->count++;
+}
+
+bool telemetry_due(const telemetry_t* t, uint32_t now_ms) {
+    if (t->count == 0) return false;
+    return t->urgent || t->count >= TELEMETRY_BATCH ||
+           now_ms - t->time[t->first] >= TELEMETRY_LATENCY_MS;
+}
+
+size_t telemetry_take(telemetry_t* t, uint32_t count, uint8_t led, size_t max, uint8_t* out) {
+    int16_t temps[TELEMETRY_RING];
+    size_t n = t->count < max ? t->count : max;
+    for (size_t i = 0; i < n; i++) temps[i] = t->temp[(t->first + i) % TELEMETRY_RING];
+
+    frame_batch_t header = { 0 };
+    header.start_ms = t->count ? t->time[t->first] : 0;
+    header.count = count;
+    header.period_ms = t->period_ms;
+    header.led = led;
+    size_t taken;
+    size_t length = frame_batch_encode(&header, temps, n, out, &taken);
+
+    t->first = (t->first + taken) % TELEMETRY_RING;
+    t->count -= taken;
+    if (t->count == 0) t->urgent = false;
+    return length;
+}
@@ -0,0 +1,43 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Telemetry samples collected in a ring and sent in batches rather than
+// each on its own: a batch goes when it is full, when its oldest sample
+// has waited long enough, or at once after a sudden change. That is
+// fewer, fuller messages, and the UART and the far end woken less often
+
+#define TELEMETRY_RING 32
+#ifndef TELEMETRY_BATCH
+#define TELEMETRY_BATCH 16          // samples to a batch, at most
+#endif
+#ifndef TELEMETRY_LATENCY_MS
+#define TELEMETRY_LATENCY_MS 30000  // the longest a sample waits
+#endif
+#ifndef TELEMETRY_JUMP_CENTI
+#define TELEMETRY_JUMP_CENTI 100    // a change of a degree goes at once
+#endif
+
+typedef struct {
+    int16_t temp[TELEMETRY_RING];
+    uint32_t time[TELEMETRY_RING];
+    unsigned first;                 // oldest sample waiting
+    unsigned count;
+    bool urgent;
+    uint16_t period_ms;
+} telemetry_t;
+
+void telemetry_init(telemetry_t* t, uint16_t period_ms);
+
+// A full ring loses its oldest sample
+void telemetry_add(telemetry_t* t, uint32_t now_ms, int16_t temp_centi);
+bool telemetry_due(const telemetry_t* t, uint32_t now_ms);
+
+// The oldest waiting samples, up to max, as a FRAME_BATCH payload into
+// out (FRAME_MAX_PAYLOAD bytes), and taken off the ring. The length
+size_t telemetry_take(telemetry_t* t, uint32_t count, uint8_t led, size_t max, uint8_t* out);
+
+#endif // TELEMETRY_H
@@ -0,0 +1,100 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "uart_rx.h"
+
+// The DMA channel writes with its address wrapping at RX_RING_SIZE,
+// which needs the ring aligned to its size. A transfer count would run
+// down in time, so it is a lap of 2^31 bytes, restarted from the DMA
+// interrupt; laps and the count left give the position
+#define RX_LAP 0x80000000u
+
+static uint8_t ring[RX_RING_SIZE] __attribute__((aligned(RX_RING_SIZE)));
+static int rx_chan = -1;
+static volatile uint32_t rx_laps = 0;
+
+static repeating_timer_t idle_timer;
+static uint32_t last_head = 0;      // at the previous tick
+static uint32_t idle_head = 0;      // where the line last went idle
+static volatile bool rx_idle = false;
+
+static void dma_lap_done(void) {
+    if (!dma_channel_get_irq0_status(rx_chan)) return;
+    dma_channel_acknowledge_irq0(rx_chan);
+    rx_laps++;
+    // goes on from where it is; the UART FIFO holds what comes meanwhile
+    dma_channel_set_trans_count(rx_chan, RX_LAP, true);
+}
+
+uint32_t uart_rx_head(void) {
+    uint32_t laps, left;
+    do {
+        laps = rx_laps;
+        left = dma_channel_hw_addr(rx_chan)->transfer_count;
+    } while (laps != rx_laps);
+    return laps * RX_LAP + (RX_LAP - left);
+}
+
+// The PL011 receive timeout does not help here, as the DMA keeps the
+// FIFO empty; a timer notes when the head stops moving instead
+static bool idle_tick(repeating_timer_t* t) {
+    (void)t;
+    uint32_t head = uart_rx_head();
+    if (head == last_head && head != idle_head) {
+        idle_head = head;
+        rx_idle = true;
+        __sev();
+    }
+    last_head = head;
+    return true;
+}
+
+void uart_rx_init(uart_inst_t* uart) {
+    rx_chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(rx_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, RX_RING_BITS);
+    channel_config_set_dreq(&c, uart_get_dreq(uart, false));
+
+    dma_channel_set_irq0_enabled(rx_chan, true);
+    irq_add_shared_handler(DMA_IRQ_0, dma_lap_done, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    dma_channel_configure(rx_chan, &c, ring, &uart_get_hw(uart)->dr, RX_LAP, true);
+    add_repeating_timer_ms(RX_IDLE_MS, idle_tick, NULL, &idle_timer);
+}
+
+uint8_t uart_rx_at(uint32_t pos) {
+    return ring[pos & RX_RING_MASK];
+}
+
+uint32_t uart_rx_overrun(uint32_t pos, uint32_t head) {
+    uint32_t behind = head - pos;
+    return behind > RX_RING_SIZE ? behind - RX_RING_SIZE : 0;
+}
+
+uint8_t* uart_rx_span(uint32_t pos, size_t n, uint8_t* tmp) {
+    size_t at = pos & RX_RING_MASK;
+    if (at + n <= RX_RING_SIZE) return ring + at;
+    size_t first = RX_RING_SIZE - at;
+    memcpy(tmp, ring + at, first);
+    memcpy(tmp + first, ring, n - first);
+    return tmp;
+}
+
+bool uart_rx_take_idle(void) {
+    if (!rx_idle) return false;
+    rx_idle = false;
+    return true;
+}
+
+bool uart_rx_wait_idle(uint32_t timeout_ms) {
+    absolute_time_t until = make_timeout_time_ms(timeout_ms);
+    // the idle timer ticks every RX_IDLE_MS, which ends each wait
+    while (!rx_idle && !time_reached(until)) __wfe();
+    return uart_rx_take_idle();
+}
@@ -0,0 +1,46 @@
+#ifndef UART_RX_H
+#define UART_RX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hardware/uart.h"
+
+// UART reception by DMA into a ring, so nothing is lost while the CPU
+// is busy elsewhere (blocked in fgets, drawing a display) for as long
+// as the ring lasts: RX_RING_SIZE bytes, about a second at 9600 baud.
+//
+// Positions are counts of bytes received since uart_rx_init(), and
+// wrap at 2^32; the byte at a position is in the ring for the next
+// RX_RING_SIZE bytes. A consumer keeps its own positions, where it has
+// consumed and scanned to, and compares them with uart_rx_head()
+
+#ifndef RX_RING_BITS
+#define RX_RING_BITS 10
+#endif
+#define RX_RING_SIZE (1u << RX_RING_BITS)
+#define RX_RING_MASK (RX_RING_SIZE - 1)
+
+// The line counts as idle when no byte came for this long after one did
+#ifndef RX_IDLE_MS
+#define RX_IDLE_MS 3
+#endif
+
+void uart_rx_init(uart_inst_t* uart);
+
+uint32_t uart_rx_head(void);                 // position of the next byte to come
+uint8_t uart_rx_at(uint32_t pos);
+
+// Bytes from pos on that have been written over, 0 if none
+uint32_t uart_rx_overrun(uint32_t pos, uint32_t head);
+
+// Pointer to the n bytes from pos: into the ring where they are in one
+// piece, else copied to tmp (n bytes) across the wrap
+uint8_t* uart_rx_span(uint32_t pos, size_t n, uint8_t* tmp);
+
+// True once each time the line has gone quiet after data; the wait
+// sleeps until that or the timeout, whichever is first
+bool uart_rx_take_idle(void);
+bool uart_rx_wait_idle(uint32_t timeout_ms);
+
+#endif // UART_RX_H
@@ -277,10 +277,27 @@ static display_error_t dma_spi_write_buffer(uint8_t* data, size_t len) {
     return DISPLAY_OK;
 }
 
+// Pixels of a blit started by display_blit_full_async() that may still
+// be in flight; CS stays low until it is finished
+static const uint16_t *async_pixels = NULL;
+
+// End an asynchronous blit: wait for its DMA, let SPI drain, release CS
+static void display_finish_async(void) {
+    if (!async_pixels) return;
+    
+    dma_wait_for_finish();
+    while (spi_is_busy(spi0)) {
+        tight_loop_contents();
+    }
+    gpio_put(DISPLAY_CS_PIN, 1);
+    async_pixels = NULL;
+}
+
 // Display low-level functions with enhanced error checking
 static display_error_t display_write_command(uint8_t cmd) {
     if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
     
+    display_finish_async();
     dma_wait_for_finish();
     
     // Ensure pins are in correct state
@@ -305,6 +322,7 @@ static display_error_t display_write_command(uint8_t cmd) {
 static display_error_t display_write_data(uint8_t data) {
     if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
     
+    display_finish_async();
     dma_wait_for_finish();
     
     gpio_put(DISPLAY_DC_PIN, 1);
@@ -326,6 +344,7 @@ static display_error_t display_write_data_buf(uint8_t *data, size_t len) {
     if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
     if (!data || len == 0) return DISPLAY_ERROR_INVALID_PARAM;
     
+    display_finish_async();
     dma_wait_for_finish();
     
     gpio_put(DISPLAY_DC_PIN, 1);
@@ -502,7 +521,7 @@ display_error_t display_clear(uint16_t color) {
     return display_fill_rect(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, color);
 }
 
-display_error_t display_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color) {
+display_error_t RAM_FUNC(display_fill_rect)(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color) {
     if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
     if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
     
@@ -584,6 +603,68 @@ display_error_t display_blit_full(const uint16_t *pixels) {
     return result;
 }
 
+// Start sending a whole frame and return at once; pixels must stay
+// untouched until display_blit_busy(pixels) is false. Any other display
+// call first waits for the transfer to end.
+display_error_t display_blit_full_async(const uint16_t *pixels) {
+    if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
+    if (!pixels) return DISPLAY_ERROR_INVALID_PARAM;
+
+    // Waits for the blit before, if there is one
+    display_error_t result = display_set_window(0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1);
+    if (result != DISPLAY_OK) return result;
+
+    gpio_put(DISPLAY_DC_PIN, 1);
+    gpio_put(DISPLAY_CS_PIN, 0);
+
+    result = dma_spi_write_buffer((uint8_t *)pixels, DISPLAY_WIDTH * DISPLAY_HEIGHT * 2);
+    if (result != DISPLAY_OK) {
+        gpio_put(DISPLAY_CS_PIN, 1);
+        return result;
+    }
+    async_pixels = pixels;
+    return DISPLAY_OK;
+}
+
+bool display_blit_busy(const uint16_t *pixels) {
+    return async_pixels != NULL && async_pixels == pixels && dma_busy;
+}
+
+// Blit one rectangle of a full DISPLAY_WIDTH x DISPLAY_HEIGHT framebuffer,
+// row by row since the rows of a rectangle are not contiguous in it
+display_error_t RAM_FUNC(display_blit_rect)(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint16_t *pixels) {
+    if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
+    if (!pixels) return DISPLAY_ERROR_INVALID_PARAM;
+    if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
+
+    // Clamp dimensions to display bounds
+    if (x + width > DISPLAY_WIDTH) width = DISPLAY_WIDTH - x;
+    if (y + height > DISPLAY_HEIGHT) height = DISPLAY_HEIGHT - y;
+    if (width == 0 || height == 0) return DISPLAY_OK;
+
+    display_error_t result = display_set_window(x, y, x + width - 1, y + height - 1);
+    if (result != DISPLAY_OK) return result;
+
+    dma_wait_for_finish();
+    gpio_put(DISPLAY_DC_PIN, 1);
+    gpio_put(DISPLAY_CS_PIN, 0);
+
+    const uint16_t *row = pixels + (size_t)y * DISPLAY_WIDTH + x;
+    if (width == DISPLAY_WIDTH) {
+        // Full rows follow each other in memory
+        result = dma_spi_write_buffer((uint8_t *)row, (size_t)width * height * 2);
+    } else {
+        for (uint16_t i = 0; i < height && result == DISPLAY_OK; i++) {
+            result = dma_spi_write_buffer((uint8_t *)row, (size_t)width * 2);
+            row += DISPLAY_WIDTH;
+        }
+    }
+    dma_wait_for_finish();
+
+    gpio_put(DISPLAY_CS_PIN, 1);
+    return result;
+}
+
 display_error_t display_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg_color) {
     if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
     if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
@@ -704,6 +785,7 @@ bool display_dma_busy(void) {
 }
 
 void display_wait_for_dma(void) {
+    display_finish_async();
     dma_wait_for_finish();
 }
 
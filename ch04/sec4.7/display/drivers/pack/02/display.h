@@ -20,6 +20,15 @@
 //#define COLUMN_OFFSET 0
 //#define ROW_OFFSET 80  // Rows 80–214 (214 - 80 + 1 = 135)
 
+// Hot functions are written RAM_FUNC(name). Built with RUN_FROM_RAM they
+// are copied to SRAM at boot and run from there, so a miss in the 16 KB
+// XIP cache cannot stall them on a read from the QSPI flash
+#ifdef RUN_FROM_RAM
+#define RAM_FUNC(name) __not_in_flash_func(name)
+#else
+#define RAM_FUNC(name) name
+#endif
+
 // Colors (RGB565 format)
 #define COLOR_BLACK     0x0000
 #define COLOR_WHITE     0xFFFF
@@ -57,6 +66,9 @@ display_error_t display_clear(uint16_t color);
 display_error_t display_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color);
 display_error_t display_draw_pixel(uint16_t x, uint16_t y, uint16_t color);
 display_error_t display_blit_full(const uint16_t *pixels);
+display_error_t display_blit_full_async(const uint16_t *pixels);
+bool display_blit_busy(const uint16_t *pixels);
+display_error_t display_blit_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint16_t *pixels);
 display_error_t display_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg_color);
 display_error_t display_draw_string(uint16_t x, uint16_t y, const char* str, uint16_t color, uint16_t bg_color);
 display_error_t display_set_backlight(bool on);
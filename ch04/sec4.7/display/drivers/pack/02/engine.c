@@ -1,19 +1,65 @@
 #include "engine.h"
+#include "fbdma.h"
+#include "jobs.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <math.h>  // Added for abs()
 #include "pico/time.h"
+#if defined(LIB_HARDWARE_INTERP)
+#include "hardware/interp.h"
+#endif
 
 
 // Internal Engine State (Singleton Pattern)
 
+// Screen rectangle, x1 and y1 exclusive
+typedef struct {
+    int16_t x0, y0, x1, y1;
+} dirty_rect_t;
+
+// Changed parts of the screen, merged into a few rectangles
+typedef struct {
+    dirty_rect_t rects[MAX_DIRTY_RECTS];
+    uint8_t count;
+    bool full;                     // too much changed, do the whole screen
+} dirty_list_t;
+
+// What a sprite looked like when it was last drawn
+typedef struct {
+    dirty_rect_t bounds;           // empty if it was not drawn
+    texture_handle_t texture;
+    uint8_t layer;
+    uint8_t alpha;
+    blend_mode_t blend_mode;
+    bool transformed;
+    int32_t inverse[4];
+} sprite_snapshot_t;
+
+// Everything engine_render() draws apart from the textures
 typedef struct {
-    // Resource pools
     sprite_t sprites[MAX_SPRITES];
-    texture_t textures[MAX_TEXTURES];
     particle_system_t particle_systems[MAX_PARTICLE_SYSTEMS];
     
+    // Draw list: active sprites sorted by layer, then handle
+    uint8_t draw_head;
+    uint8_t draw_next[MAX_SPRITES];
+    
+    coord_t camera_x, camera_y;
+} scene_t;
+
+// A scene as engine_update() left it, for the render thread
+typedef struct {
+    scene_t scene;
+    dirty_list_t invalidated;                // engine_invalidate() calls for it
+    uint32_t update_us;                      // engine_update() that made it
+} frame_snapshot_t;
+
+typedef struct {
+    // Resource pools, sprites and particle systems in the scene
+    scene_t scene;
+    texture_t textures[MAX_TEXTURES];
+    
     // Free lists for O(1) allocation
     uint8_t free_sprites[MAX_SPRITES];
     uint8_t free_textures[MAX_TEXTURES];
@@ -22,18 +68,52 @@ typedef struct {
     uint8_t free_texture_count;
     uint8_t free_particle_count;
     
-    // Camera state
-    float camera_x, camera_y;
+    // Camera state, the position is in the scene
     sprite_handle_t camera_follow_target;
-    float camera_follow_offset_x, camera_follow_offset_y;
+    coord_t camera_follow_offset_x, camera_follow_offset_y;
     
     // Collision callback
     collision_callback_t collision_callback;
     
+    // Sweep and prune: collision-enabled sprites sorted by left edge
+    uint8_t sweep_order[MAX_SPRITES];
+    uint8_t sweep_count;
+    
     // Frame buffer - with bounds checking
     uint16_t* framebuffer;
     size_t framebuffer_size;
     
+    // Double buffering: framebuffer is drawn while front_buffer is sent
+    uint16_t* front_buffer;                  // NULL with a single buffer
+    dirty_list_t back_dirty;                 // changes the framebuffer missed
+    bool clear_pending;                      // DMA is clearing the framebuffer
+    
+    // Dirty rectangles
+    bool dirty_mode;
+    dirty_list_t dirty;                      // to redraw and send this frame
+    dirty_list_t overlay;                    // drawn by primitives last frame
+    sprite_snapshot_t drawn_sprites[MAX_SPRITES];
+    dirty_rect_t drawn_particles[MAX_PARTICLE_SYSTEMS];
+    coord_t drawn_camera_x, drawn_camera_y;
+    
+    // Render thread: core 1 renders and presents the snapshots that
+    // engine_update() publishes, two of them so one can be filled while
+    // the other is drawn
+    bool render_thread;
+    bool started_jobs;                       // jobs_init() was ours
+    frame_snapshot_t* snapshots;             // two, NULL without the thread
+    uint32_t frames_published;               // written by core 0 only
+    uint32_t frames_rendered;                // written by core 1 only
+    dirty_list_t invalidated;                // since the last snapshot
+    
+    // Frame timing: microseconds per phase, a ring of the last frames
+    uint32_t timing[ENGINE_TIMING_FRAMES][ENGINE_PHASE_COUNT];
+    uint16_t timing_next;
+    uint16_t timing_count;
+    uint32_t phase_us[ENGINE_PHASE_COUNT];   // of the frame being made
+    uint32_t frame_start_us;
+    bool timing_stream;
+    
     // Statistics
     engine_stats_t stats;
     uint32_t last_frame_time;
@@ -51,6 +131,9 @@ typedef struct {
 
 static engine_context_t g_engine = {0};
 
+// The scene being rendered: the live one, or on core 1 a snapshot
+static const scene_t* render_scene = &g_engine.scene;
+
 // Error strings
 static const char* error_strings[] = {
     "OK",
@@ -65,6 +148,12 @@ static const char* error_strings[] = {
 #define MEMORY_CHECK_INTERVAL 100  // Check every 100 frames
 #define MAX_FRAMEBUFFER_SIZE (DISPLAY_WIDTH * DISPLAY_HEIGHT * sizeof(uint16_t))
 
+// Dirty rectangle tuning
+#define DIRTY_MERGE_GAP 8          // merge rectangles closer than this
+#define DIRTY_FULL_AREA (DISPLAY_WIDTH * DISPLAY_HEIGHT * 3 / 4)  // then send the whole frame
+
+static const dirty_rect_t screen_rect = {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT};
+
 
 // Internal Helper Functions
 
@@ -72,6 +161,41 @@ static inline uint32_t get_time_ms(void) {
     return to_ms_since_boot(get_absolute_time());
 }
 
+static inline uint32_t get_time_us(void) {
+    return time_us_32();
+}
+
+// Add the time since start to a phase of this frame
+static inline void timing_add(engine_phase_t phase, uint32_t start) {
+    g_engine.phase_us[phase] += get_time_us() - start;
+}
+
+static void timing_reset(void) {
+    g_engine.timing_next = 0;
+    g_engine.timing_count = 0;
+    memset(g_engine.phase_us, 0, sizeof(g_engine.phase_us));
+    g_engine.frame_start_us = get_time_us();
+}
+
+// The frame is presented: keep its times and start the next one
+static void timing_end_frame(void) {
+    uint32_t now = get_time_us();
+    g_engine.phase_us[ENGINE_PHASE_FRAME] = now - g_engine.frame_start_us;
+    g_engine.frame_start_us = now;
+    
+    memcpy(g_engine.timing[g_engine.timing_next], g_engine.phase_us, sizeof(g_engine.phase_us));
+    g_engine.timing_next = (g_engine.timing_next + 1) % ENGINE_TIMING_FRAMES;
+    if (g_engine.timing_count < ENGINE_TIMING_FRAMES) g_engine.timing_count++;
+    
+    if (g_engine.timing_stream) {
+        const uint32_t* t = g_engine.phase_us;
+        printf("T %lu %lu %lu %lu %lu\n", (unsigned long)t[ENGINE_PHASE_UPDATE],
+               (unsigned long)t[ENGINE_PHASE_RENDER], (unsigned long)t[ENGINE_PHASE_PRESENT],
+               (unsigned long)t[ENGINE_PHASE_DMA_WAIT], (unsigned long)t[ENGINE_PHASE_FRAME]);
+    }
+    memset(g_engine.phase_us, 0, sizeof(g_engine.phase_us));
+}
+
 // Memory safety check
 static bool check_memory_integrity(void) {
     // Basic sanity checks
@@ -97,7 +221,7 @@ static void init_free_lists(void) {
     for (int i = 0; i < MAX_SPRITES; i++) {
         g_engine.free_sprites[i] = i;
         // Clear sprite data
-        memset(&g_engine.sprites[i], 0, sizeof(sprite_t));
+        memset(&g_engine.scene.sprites[i], 0, sizeof(sprite_t));
     }
     for (int i = 0; i < MAX_TEXTURES; i++) {
         g_engine.free_textures[i] = i;
@@ -107,9 +231,11 @@ static void init_free_lists(void) {
     for (int i = 0; i < MAX_PARTICLE_SYSTEMS; i++) {
         g_engine.free_particles[i] = i;
         // Clear particle system data
-        memset(&g_engine.particle_systems[i], 0, sizeof(particle_system_t));
+        memset(&g_engine.scene.particle_systems[i], 0, sizeof(particle_system_t));
     }
     
+    g_engine.scene.draw_head = INVALID_HANDLE;
+    g_engine.sweep_count = 0;
     g_engine.free_sprite_count = MAX_SPRITES;
     g_engine.free_texture_count = MAX_TEXTURES;
     g_engine.free_particle_count = MAX_PARTICLE_SYSTEMS;
@@ -121,18 +247,42 @@ static uint8_t allocate_sprite_handle(void) {
     uint8_t handle = g_engine.free_sprites[--g_engine.free_sprite_count];
     
     // Clear the sprite data before use
-    memset(&g_engine.sprites[handle], 0, sizeof(sprite_t));
-    g_engine.sprites[handle].active = true;
+    memset(&g_engine.scene.sprites[handle], 0, sizeof(sprite_t));
+    g_engine.scene.sprites[handle].active = true;
     
     return handle;
 }
 
+// Put a sprite into the draw list after all sprites of lower layers
+// and lower handles, so the draw order does not depend on creation order
+static void draw_list_insert(uint8_t handle) {
+    uint8_t layer = g_engine.scene.sprites[handle].layer;
+    uint8_t* link = &g_engine.scene.draw_head;
+    while (*link != INVALID_HANDLE) {
+        const sprite_t* other = &g_engine.scene.sprites[*link];
+        if (other->layer > layer || (other->layer == layer && *link > handle)) break;
+        link = &g_engine.scene.draw_next[*link];
+    }
+    g_engine.scene.draw_next[handle] = *link;
+    *link = handle;
+}
+
+static void draw_list_remove(uint8_t handle) {
+    uint8_t* link = &g_engine.scene.draw_head;
+    while (*link != INVALID_HANDLE && *link != handle) {
+        link = &g_engine.scene.draw_next[*link];
+    }
+    if (*link == handle) *link = g_engine.scene.draw_next[handle];
+}
+
 static void free_sprite_handle(uint8_t handle) {
-    if (handle >= MAX_SPRITES || !g_engine.sprites[handle].active) return;
+    if (handle >= MAX_SPRITES || !g_engine.scene.sprites[handle].active) return;
+    
+    draw_list_remove(handle);
     
     // Clear sprite data
-    memset(&g_engine.sprites[handle], 0, sizeof(sprite_t));
-    g_engine.sprites[handle].active = false;
+    memset(&g_engine.scene.sprites[handle], 0, sizeof(sprite_t));
+    g_engine.scene.sprites[handle].active = false;
     
     if (g_engine.free_sprite_count < MAX_SPRITES) {
         g_engine.free_sprites[g_engine.free_sprite_count++] = handle;
@@ -146,6 +296,7 @@ static uint8_t allocate_texture_handle(void) {
     
     // Clear texture data before use
     memset(&g_engine.textures[handle], 0, sizeof(texture_t));
+    g_engine.textures[handle].atlas = INVALID_HANDLE;
     g_engine.textures[handle].active = true;
     
     return handle;
@@ -160,10 +311,12 @@ static void free_texture_handle(uint8_t handle) {
     if (tex->owned_data && tex->data) {
         // Verify pointer is reasonable before freeing
         if ((uintptr_t)tex->data > 0x10000000) {  // Basic sanity check for Pico
-            free(tex->data);
+            free((void*)tex->data);
         }
         tex->data = NULL;
     }
+    free(tex->spans);
+    free(tex->row_spans);
     
     // Clear texture data
     memset(tex, 0, sizeof(texture_t));
@@ -172,6 +325,59 @@ static void free_texture_handle(uint8_t handle) {
     if (g_engine.free_texture_count < MAX_TEXTURES) {
         g_engine.free_textures[g_engine.free_texture_count++] = handle;
     }
+    
+    // Regions point into this texture's data
+    for (uint8_t i = 0; i < MAX_TEXTURES; i++) {
+        if (g_engine.textures[i].active && g_engine.textures[i].atlas == handle) {
+            free_texture_handle(i);
+        }
+    }
+}
+
+// Find the runs of opaque texels in every row, so rendering can copy
+// them whole and skip the transparent texels without looking at them.
+// Solid and procedural textures fill whole rows and need none
+static bool build_texture_spans(texture_t* tex) {
+    if (tex->kind != TEXTURE_DATA) return true;
+    
+    uint32_t count = 0;
+    for (uint16_t y = 0; y < tex->height; y++) {
+        const uint16_t* row = &tex->data[(size_t)y * tex->stride];
+        for (uint16_t x = 0; x < tex->width; x++) {
+            if (row[x] != 0x0000 && (x == 0 || row[x - 1] == 0x0000)) count++;
+        }
+    }
+    
+    texture_span_t* spans = malloc((count > 0 ? count : 1) * sizeof(texture_span_t));
+    uint32_t* row_spans = malloc(((size_t)tex->height + 1) * sizeof(uint32_t));
+    if (!spans || !row_spans) {
+        free(spans);
+        free(row_spans);
+        return false;
+    }
+    
+    uint32_t n = 0;
+    for (uint16_t y = 0; y < tex->height; y++) {
+        const uint16_t* row = &tex->data[(size_t)y * tex->stride];
+        row_spans[y] = n;
+        uint16_t x = 0;
+        while (x < tex->width) {
+            while (x < tex->width && row[x] == 0x0000) x++;
+            if (x == tex->width) break;
+            uint16_t start = x;
+            while (x < tex->width && row[x] != 0x0000) x++;
+            spans[n].start = start;
+            spans[n].length = x - start;
+            n++;
+        }
+    }
+    row_spans[tex->height] = n;
+    
+    free(tex->spans);
+    free(tex->row_spans);
+    tex->spans = spans;
+    tex->row_spans = row_spans;
+    return true;
 }
 
 static uint8_t allocate_particle_handle(void) {
@@ -180,32 +386,32 @@ static uint8_t allocate_particle_handle(void) {
     uint8_t handle = g_engine.free_particles[--g_engine.free_particle_count];
     
     // Clear particle system data before use
-    memset(&g_engine.particle_systems[handle], 0, sizeof(particle_system_t));
-    g_engine.particle_systems[handle].active = true;
+    memset(&g_engine.scene.particle_systems[handle], 0, sizeof(particle_system_t));
+    g_engine.scene.particle_systems[handle].active = true;
     
     return handle;
 }
 
 static void free_particle_handle(uint8_t handle) {
-    if (handle >= MAX_PARTICLE_SYSTEMS || !g_engine.particle_systems[handle].active) return;
+    if (handle >= MAX_PARTICLE_SYSTEMS || !g_engine.scene.particle_systems[handle].active) return;
     
     // Clear particle system data
-    memset(&g_engine.particle_systems[handle], 0, sizeof(particle_system_t));
-    g_engine.particle_systems[handle].active = false;
+    memset(&g_engine.scene.particle_systems[handle], 0, sizeof(particle_system_t));
+    g_engine.scene.particle_systems[handle].active = false;
     
     if (g_engine.free_particle_count < MAX_PARTICLE_SYSTEMS) {
         g_engine.free_particles[g_engine.free_particle_count++] = handle;
     }
 }
 
-static void world_to_screen(float world_x, float world_y, int16_t* screen_x, int16_t* screen_y) {
+static void RAM_FUNC(world_to_screen)(coord_t world_x, coord_t world_y, int16_t* screen_x, int16_t* screen_y) {
     if (!screen_x || !screen_y) return;
     
-    *screen_x = (int16_t)(world_x - g_engine.camera_x);
-    *screen_y = (int16_t)(world_y - g_engine.camera_y);
+    *screen_x = (int16_t)COORD_TO_INT(world_x - render_scene->camera_x);
+    *screen_y = (int16_t)COORD_TO_INT(world_y - render_scene->camera_y);
 }
 
-static bool is_sprite_on_screen(const sprite_t* sprite) {
+static bool RAM_FUNC(is_sprite_on_screen)(const sprite_t* sprite) {
     if (!sprite) return false;
     
     int16_t screen_x, screen_y;
@@ -217,48 +423,539 @@ static bool is_sprite_on_screen(const sprite_t* sprite) {
              screen_y >= DISPLAY_HEIGHT);
 }
 
-static bool is_valid_framebuffer_coords(int16_t x, int16_t y) {
+// Screen rectangle a sprite covers, grown to hold it scaled and rotated
+static dirty_rect_t RAM_FUNC(sprite_screen_bounds)(const sprite_t* sprite, const texture_t* texture) {
+    int16_t screen_x, screen_y;
+    world_to_screen(sprite->x, sprite->y, &screen_x, &screen_y);
+    dirty_rect_t r = {screen_x, screen_y, screen_x + (int16_t)texture->width,
+                      screen_y + (int16_t)texture->height};
+    if (!sprite->transformed) return r;
+    
+    // Half the extent of the transformed rectangle around its centre
+    const int32_t* m = sprite->forward;
+    int64_t cx = (int64_t)screen_x * 65536 + ((int32_t)texture->width << 15);
+    int64_t cy = (int64_t)screen_y * 65536 + ((int32_t)texture->height << 15);
+    int64_t ex = ((int64_t)abs(m[0]) * texture->width + (int64_t)abs(m[1]) * texture->height) / 2;
+    int64_t ey = ((int64_t)abs(m[2]) * texture->width + (int64_t)abs(m[3]) * texture->height) / 2;
+    int64_t x0 = (cx - ex) >> 16, x1 = ((cx + ex) >> 16) + 1;
+    int64_t y0 = (cy - ey) >> 16, y1 = ((cy + ey) >> 16) + 1;
+    r.x0 = (int16_t)(x0 < INT16_MIN ? INT16_MIN : x0);
+    r.y0 = (int16_t)(y0 < INT16_MIN ? INT16_MIN : y0);
+    r.x1 = (int16_t)(x1 > INT16_MAX ? INT16_MAX : x1);
+    r.y1 = (int16_t)(y1 > INT16_MAX ? INT16_MAX : y1);
+    return r;
+}
+
+static bool RAM_FUNC(is_valid_framebuffer_coords)(int16_t x, int16_t y) {
     return (x >= 0 && x < DISPLAY_WIDTH && y >= 0 && y < DISPLAY_HEIGHT);
 }
 
-static void render_sprite_to_framebuffer(const sprite_t* sprite, const texture_t* texture) {
-    if (!sprite || !texture || !sprite->visible || !is_sprite_on_screen(sprite)) return;
+
+// Sweep and Prune
+
+// Bring the sweep list up to date: drop sprites that were destroyed or
+// had collision turned off, add new ones, then sort by left edge. Sprites
+// move little between frames, so the list is nearly sorted already and
+// insertion sort does about one pass.
+static void update_sweep_list(void) {
+    bool listed[MAX_SPRITES] = {false};
+    uint8_t count = 0;
+    
+    for (uint8_t k = 0; k < g_engine.sweep_count; k++) {
+        uint8_t i = g_engine.sweep_order[k];
+        if (!g_engine.scene.sprites[i].active || !g_engine.scene.sprites[i].collision_enabled) continue;
+        g_engine.sweep_order[count++] = i;
+        listed[i] = true;
+    }
+    for (uint8_t i = 0; i < MAX_SPRITES; i++) {
+        if (g_engine.scene.sprites[i].active && g_engine.scene.sprites[i].collision_enabled && !listed[i]) {
+            g_engine.sweep_order[count++] = i;
+        }
+    }
+    g_engine.sweep_count = count;
+    
+    for (uint8_t k = 1; k < count; k++) {
+        uint8_t i = g_engine.sweep_order[k];
+        coord_t left = g_engine.scene.sprites[i].x;
+        uint8_t m = k;
+        while (m > 0 && g_engine.scene.sprites[g_engine.sweep_order[m - 1]].x > left) {
+            g_engine.sweep_order[m] = g_engine.sweep_order[m - 1];
+            m--;
+        }
+        g_engine.sweep_order[m] = i;
+    }
+}
+
+// Call back for every overlapping pair. Only sprites that start before
+// the right edge of a sprite can overlap it, so each sprite is tested
+// against its neighbours in the list and not against all others.
+static void sweep_collisions(void) {
+    update_sweep_list();
+    
+    for (uint8_t k = 0; k < g_engine.sweep_count; k++) {
+        uint8_t i = g_engine.sweep_order[k];
+        coord_t right = g_engine.scene.sprites[i].x + COORD_FROM_INT(g_engine.scene.sprites[i].width);
+        
+        for (uint8_t m = k + 1; m < g_engine.sweep_count; m++) {
+            uint8_t j = g_engine.sweep_order[m];
+            if (g_engine.scene.sprites[j].x >= right) break;
+            
+            g_engine.stats.collision_checks++;
+            // Checked again in full: the callback may move or destroy sprites
+            if (sprite_check_collision(i, j)) {
+                g_engine.collision_callback(i < j ? i : j, i < j ? j : i);
+            }
+        }
+    }
+}
+
+
+// Dirty Rectangles
+
+static inline bool rect_empty(const dirty_rect_t* r) {
+    return r->x1 <= r->x0 || r->y1 <= r->y0;
+}
+
+static inline int32_t rect_area(const dirty_rect_t* r) {
+    return rect_empty(r) ? 0 : (int32_t)(r->x1 - r->x0) * (r->y1 - r->y0);
+}
+
+static dirty_rect_t rect_union(const dirty_rect_t* a, const dirty_rect_t* b) {
+    dirty_rect_t r;
+    r.x0 = a->x0 < b->x0 ? a->x0 : b->x0;
+    r.y0 = a->y0 < b->y0 ? a->y0 : b->y0;
+    r.x1 = a->x1 > b->x1 ? a->x1 : b->x1;
+    r.y1 = a->y1 > b->y1 ? a->y1 : b->y1;
+    return r;
+}
+
+static bool rect_near(const dirty_rect_t* a, const dirty_rect_t* b) {
+    return a->x0 <= b->x1 + DIRTY_MERGE_GAP && b->x0 <= a->x1 + DIRTY_MERGE_GAP &&
+           a->y0 <= b->y1 + DIRTY_MERGE_GAP && b->y0 <= a->y1 + DIRTY_MERGE_GAP;
+}
+
+static void dirty_add(dirty_list_t* list, dirty_rect_t r) {
+    if (list->full) return;
+    
+    // Clip to the screen
+    if (r.x0 < 0) r.x0 = 0;
+    if (r.y0 < 0) r.y0 = 0;
+    if (r.x1 > DISPLAY_WIDTH) r.x1 = DISPLAY_WIDTH;
+    if (r.y1 > DISPLAY_HEIGHT) r.y1 = DISPLAY_HEIGHT;
+    if (rect_empty(&r)) return;
+    
+    // Merge with every rectangle it touches until none is left
+    for (int i = 0; i < list->count; i++) {
+        if (rect_near(&r, &list->rects[i])) {
+            r = rect_union(&r, &list->rects[i]);
+            list->rects[i] = list->rects[--list->count];
+            i = -1;
+        }
+    }
+    
+    // List full: merge with the rectangle that grows least
+    if (list->count == MAX_DIRTY_RECTS) {
+        int best = 0;
+        int32_t best_growth = INT32_MAX;
+        for (int i = 0; i < list->count; i++) {
+            dirty_rect_t u = rect_union(&r, &list->rects[i]);
+            int32_t growth = rect_area(&u) - rect_area(&list->rects[i]);
+            if (growth < best_growth) {
+                best_growth = growth;
+                best = i;
+            }
+        }
+        dirty_rect_t u = rect_union(&r, &list->rects[best]);
+        list->rects[best] = list->rects[--list->count];
+        dirty_add(list, u);  // may touch others now
+        return;
+    }
+    
+    list->rects[list->count++] = r;
+    
+    int32_t area = 0;
+    for (int i = 0; i < list->count; i++) {
+        area += rect_area(&list->rects[i]);
+    }
+    if (area >= DIRTY_FULL_AREA) list->full = true;
+}
+
+static void dirty_add_list(dirty_list_t* list, const dirty_list_t* other) {
+    if (other->full) {
+        list->full = true;
+        return;
+    }
+    for (int i = 0; i < other->count; i++) {
+        dirty_add(list, other->rects[i]);
+    }
+}
+
+static inline void dirty_reset(dirty_list_t* list, bool full) {
+    list->count = 0;
+    list->full = full;
+}
+
+// Primitives draw straight into the framebuffer: send what they drew,
+// and clear it again next frame as a full redraw would
+static void dirty_add_primitive(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    if (!g_engine.dirty_mode || g_engine.render_thread) return;
+    dirty_rect_t r = {x0, y0, x1, y1};
+    dirty_add(&g_engine.dirty, r);
+    dirty_add(&g_engine.overlay, r);
+}
+
+// Something to draw from: data for an array texture
+static inline bool texture_ready(const texture_t* texture) {
+    return texture->kind != TEXTURE_DATA || texture->data;
+}
+
+static sprite_snapshot_t sprite_snapshot(const sprite_t* sprite) {
+    sprite_snapshot_t snap;
+    memset(&snap, 0, sizeof(snap));
+    
+    if (!sprite->active || !sprite->visible) return snap;
+    if (sprite->texture >= MAX_TEXTURES || !g_engine.textures[sprite->texture].active) return snap;
+    const texture_t* texture = &g_engine.textures[sprite->texture];
+    if (!texture_ready(texture)) return snap;
+    
+    snap.bounds = sprite_screen_bounds(sprite, texture);
+    snap.texture = sprite->texture;
+    snap.layer = sprite->layer;
+    snap.alpha = sprite->alpha;
+    snap.blend_mode = sprite->blend_mode;
+    snap.transformed = sprite->transformed;
+    if (sprite->transformed) memcpy(snap.inverse, sprite->inverse, sizeof(snap.inverse));
+    return snap;
+}
+
+static bool snapshot_equal(const sprite_snapshot_t* a, const sprite_snapshot_t* b) {
+    if (rect_empty(&a->bounds) && rect_empty(&b->bounds)) return true;
+    return a->bounds.x0 == b->bounds.x0 && a->bounds.y0 == b->bounds.y0 &&
+           a->bounds.x1 == b->bounds.x1 && a->bounds.y1 == b->bounds.y1 &&
+           a->texture == b->texture && a->layer == b->layer &&
+           a->alpha == b->alpha && a->blend_mode == b->blend_mode &&
+           a->transformed == b->transformed &&
+           (!a->transformed || memcmp(a->inverse, b->inverse, sizeof(a->inverse)) == 0);
+}
+
+// Screen area covered by the live particles of a system
+static dirty_rect_t particle_bounds(const particle_system_t* system) {
+    dirty_rect_t r = {0, 0, 0, 0};
+    if (!system->active) return r;
+    
+    for (int j = 0; j < system->active_count; j++) {
+        int16_t screen_x, screen_y;
+        world_to_screen(system->x[j], system->y[j], &screen_x, &screen_y);
+        if (!is_valid_framebuffer_coords(screen_x, screen_y)) continue;
+        
+        dirty_rect_t pixel = {screen_x, screen_y, screen_x + 1, screen_y + 1};
+        r = rect_empty(&r) ? pixel : rect_union(&r, &pixel);
+    }
+    return r;
+}
+
+// Compare what was drawn last frame with what would be drawn now, and
+// mark both the old and the new place of everything that changed
+static void collect_dirty_rects(void) {
+    if (render_scene->camera_x != g_engine.drawn_camera_x || render_scene->camera_y != g_engine.drawn_camera_y) {
+        g_engine.dirty.full = true;  // everything moved
+        g_engine.drawn_camera_x = render_scene->camera_x;
+        g_engine.drawn_camera_y = render_scene->camera_y;
+    }
+    
+    for (int i = 0; i < MAX_SPRITES; i++) {
+        sprite_snapshot_t snap = sprite_snapshot(&render_scene->sprites[i]);
+        sprite_snapshot_t* drawn = &g_engine.drawn_sprites[i];
+        if (!snapshot_equal(&snap, drawn)) {
+            dirty_add(&g_engine.dirty, drawn->bounds);
+            dirty_add(&g_engine.dirty, snap.bounds);
+            *drawn = snap;
+        }
+    }
+    
+    for (int i = 0; i < MAX_PARTICLE_SYSTEMS; i++) {
+        dirty_rect_t bounds = particle_bounds(&render_scene->particle_systems[i]);
+        dirty_add(&g_engine.dirty, g_engine.drawn_particles[i]);
+        dirty_add(&g_engine.dirty, bounds);
+        g_engine.drawn_particles[i] = bounds;
+    }
+    
+    // Primitives are drawn after engine_render, so what they drew for
+    // the last frame is still on screen
+    dirty_add_list(&g_engine.dirty, &g_engine.overlay);
+    dirty_reset(&g_engine.overlay, false);
+}
+
+// Particle kernels. Each is a plain loop over packed arrays with no
+// branch on the particle, so GCC unrolls it on the Cortex-M0+ and can
+// vectorise it on hosts with SSE or NEON.
+
+static void particles_integrate(coord_t* restrict pos, coord_t* restrict vel, coord_t acc, int count) {
+    for (int j = 0; j < count; j++) {
+        coord_t v = vel[j] + acc;
+        vel[j] = v;
+        pos[j] += (v > -COORD_FROM_INT(100) && v < COORD_FROM_INT(100)) ? v : 0;
+    }
+}
+
+static void particles_age(uint16_t* restrict life, uint8_t* restrict alpha, uint16_t dt,
+                          uint32_t alpha_scale, int count) {
+    for (int j = 0; j < count; j++) {
+        uint16_t left = life[j] > dt ? (uint16_t)(life[j] - dt) : 0;
+        life[j] = left;
+        alpha[j] = (uint8_t)((left * alpha_scale) >> 16);
+    }
+}
+
+// Drop the particles whose life ran out, keeping the others in order
+static void particles_compact(particle_system_t* system) {
+    int live = 0;
+    for (int j = 0; j < system->active_count; j++) {
+        if (system->life_remaining[j] == 0) continue;
+        if (live != j) {
+            system->x[live] = system->x[j];
+            system->y[live] = system->y[j];
+            system->vel_x[live] = system->vel_x[j];
+            system->vel_y[live] = system->vel_y[j];
+            system->life_remaining[live] = system->life_remaining[j];
+            system->alpha[live] = system->alpha[j];
+        }
+        live++;
+    }
+    system->active_count = live;
+}
+
+// memset for texels: a word, two of them, at a time once dst is aligned
+static inline void fill_span(uint16_t* dst, uint16_t color, int16_t n) {
+    if (n > 0 && ((uintptr_t)dst & 2)) {
+        *dst++ = color;
+        n--;
+    }
+    uint32_t* words = (uint32_t*)dst;
+    uint32_t pair = color | (uint32_t)color << 16;
+    for (; n >= 2; n -= 2) *words++ = pair;
+    if (n) *(uint16_t*)words = color;
+}
+
+// Texels of a procedural texture, when they are blended rather than
+// written straight into the framebuffer
+static uint16_t span_texels[DISPLAY_WIDTH];
+
+// Columns [x0, x1) of row ty of a solid or procedural texture
+static void RAM_FUNC(render_generated_span)(const sprite_t* sprite, const texture_t* texture,
+                                             uint16_t* dst_row, int16_t ty, int16_t x0, int16_t x1, bool blend) {
+    int16_t n = x1 - x0;
+    if (texture->kind == TEXTURE_SOLID) {
+        if (!blend) {
+            fill_span(&dst_row[x0], texture->color, n);
+        } else {
+            for (int16_t tx = x0; tx < x1; tx++) {
+                dst_row[tx] = color_blend(texture->color, dst_row[tx], sprite->alpha);
+            }
+        }
+        return;
+    }
+    
+    uint16_t x = texture->origin_x + (uint16_t)x0;
+    uint16_t y = texture->origin_y + (uint16_t)ty;
+    if (!blend) {
+        texture->fill(&dst_row[x0], x, y, (uint16_t)n, texture->user);
+    } else {
+        texture->fill(span_texels, x, y, (uint16_t)n, texture->user);
+        for (int16_t i = 0; i < n; i++) {
+            dst_row[x0 + i] = color_blend(span_texels[i], dst_row[x0 + i], sprite->alpha);
+        }
+    }
+}
+
+// Affine sprites. Every covered screen pixel is mapped back to the
+// texture: per row, the texture coordinates (u, v) of the first pixel
+// come from the inverse matrix, the run of pixels whose (u, v) is inside
+// the texture is solved for, and along it (u, v) steps by (du/dx, dv/dx).
+
+static inline int32_t floor_div(int32_t a, int32_t b) {
+    int32_t q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+static inline int32_t ceil_div(int32_t a, int32_t b) {
+    return -floor_div(-a, b);
+}
+
+// Narrow [*lo, *hi) to the x where 0 <= f + k * (x - x0) < limit
+static void RAM_FUNC(affine_clip)(int32_t f, int32_t k, int32_t limit, int16_t x0, int16_t* lo, int16_t* hi) {
+    int32_t first, last;    // steps from x0, both inside
+    if (k == 0) {
+        if (f < 0 || f >= limit) *hi = *lo;
+        return;
+    } else if (k > 0) {
+        first = ceil_div(-f, k);
+        last = floor_div(limit - 1 - f, k);
+    } else {
+        first = ceil_div(f - limit + 1, -k);
+        last = floor_div(f, -k);
+    }
+    if (first > *lo - x0) *lo = (int16_t)(first < *hi - x0 ? x0 + first : *hi);
+    if (last < *hi - x0 - 1) *hi = (int16_t)(last >= *lo - x0 ? x0 + last + 1 : *lo);
+}
+
+#if defined(LIB_HARDWARE_INTERP)
+// The texel address on INTERP0 of this core, for a power-of-two stride:
+// lane 0 holds u and lane 1 v, each popped by its step, and the full
+// result is data + (v >> 16) * stride + (u >> 16), shifted and masked
+// into bytes, as in the SDK's texture mapping example
+static bool RAM_FUNC(affine_interp_begin)(const texture_t* texture, int32_t du, int32_t dv) {
+    uint32_t stride = texture->stride;
+    if (stride < 2 || (stride & (stride - 1))) return false;
+    uint32_t bits = (uint32_t)__builtin_ctz(stride);
+    
+    interp_config c = interp_default_config();
+    interp_config_set_add_raw(&c, true);
+    interp_config_set_shift(&c, 15);                // (u >> 16) * 2 bytes
+    interp_config_set_mask(&c, 1, bits);
+    interp_set_config(interp0, 0, &c);
+    interp_config_set_shift(&c, 15 - bits);         // (v >> 16) * stride * 2
+    interp_config_set_mask(&c, bits + 1, 31);
+    interp_set_config(interp0, 1, &c);
+    interp0->base[0] = (uint32_t)du;
+    interp0->base[1] = (uint32_t)dv;
+    interp0->base[2] = (uintptr_t)texture->data;
+    return true;
+}
+#else
+// Hosts step (u, v) in software
+static bool affine_interp_begin(const texture_t* texture, int32_t du, int32_t dv) {
+    (void)texture;
+    (void)du;
+    (void)dv;
+    return false;
+}
+#endif
+
+static void RAM_FUNC(render_sprite_affine)(const sprite_t* sprite, const texture_t* texture, const dirty_rect_t* clip) {
+    dirty_rect_t box = sprite_screen_bounds(sprite, texture);
+    int16_t x0 = box.x0 < clip->x0 ? clip->x0 : box.x0;
+    int16_t y0 = box.y0 < clip->y0 ? clip->y0 : box.y0;
+    int16_t x1 = box.x1 > clip->x1 ? clip->x1 : box.x1;
+    int16_t y1 = box.y1 > clip->y1 ? clip->y1 : box.y1;
+    if (x1 <= x0 || y1 <= y0) return;
+    if (texture->kind == TEXTURE_SOLID && texture->color == 0x0000) return;  // transparent
+    
+    // The box is on screen, so the centre is within a few thousand pixels
+    int16_t screen_x, screen_y;
+    world_to_screen(sprite->x, sprite->y, &screen_x, &screen_y);
+    int32_t cx = (int32_t)screen_x * 65536 + ((int32_t)texture->width << 15);
+    int32_t cy = (int32_t)screen_y * 65536 + ((int32_t)texture->height << 15);
+    int32_t limit_u = (int32_t)texture->width << 16;
+    int32_t limit_v = (int32_t)texture->height << 16;
+    const int32_t* m = sprite->inverse;
+    int32_t du = m[0], dv = m[2];
+    
+    bool blend = sprite->alpha < 255 || sprite->blend_mode != BLEND_NONE;
+    bool interp = texture->kind == TEXTURE_DATA && affine_interp_begin(texture, du, dv);
+    
+    for (int16_t y = y0; y < y1; y++) {
+        // (u, v) of the centre of pixel (x0, y)
+        int32_t dx = ((int32_t)x0 << 16) + 0x8000 - cx;
+        int32_t dy = ((int32_t)y << 16) + 0x8000 - cy;
+        int32_t u = (int32_t)(((int64_t)m[0] * dx + (int64_t)m[1] * dy) >> 16) + limit_u / 2;
+        int32_t v = (int32_t)(((int64_t)m[2] * dx + (int64_t)m[3] * dy) >> 16) + limit_v / 2;
+        
+        int16_t lo = x0, hi = x1;
+        affine_clip(u, du, limit_u, x0, &lo, &hi);
+        affine_clip(v, dv, limit_v, x0, &lo, &hi);
+        if (hi <= lo) continue;
+        u += du * (lo - x0);
+        v += dv * (lo - x0);
+        
+        uint16_t* dst = &g_engine.framebuffer[(size_t)y * DISPLAY_WIDTH];
+        if (texture->kind == TEXTURE_SOLID) {
+            if (!blend) {
+                fill_span(&dst[lo], texture->color, hi - lo);
+            } else {
+                for (int16_t x = lo; x < hi; x++) {
+                    dst[x] = color_blend(texture->color, dst[x], sprite->alpha);
+                }
+            }
+            continue;
+        }
+        
+#if defined(LIB_HARDWARE_INTERP)
+        if (interp) {
+            interp0->accum[0] = (uint32_t)u;
+            interp0->accum[1] = (uint32_t)v;
+            for (int16_t x = lo; x < hi; x++) {
+                uint16_t texel = *(const uint16_t*)interp0->pop[2];
+                if (texel) dst[x] = blend ? color_blend(texel, dst[x], sprite->alpha) : texel;
+            }
+            continue;
+        }
+#endif
+        for (int16_t x = lo; x < hi; x++, u += du, v += dv) {
+            uint16_t texel;
+            if (texture->kind == TEXTURE_DATA) {
+                texel = texture->data[(size_t)(v >> 16) * texture->stride + (u >> 16)];
+                if (!texel) continue;
+            } else {
+                texture->fill(&texel, texture->origin_x + (uint16_t)(u >> 16),
+                              texture->origin_y + (uint16_t)(v >> 16), 1, texture->user);
+            }
+            dst[x] = blend ? color_blend(texel, dst[x], sprite->alpha) : texel;
+        }
+    }
+    (void)interp;
+}
+
+static void RAM_FUNC(render_sprite_to_framebuffer)(const sprite_t* sprite, const texture_t* texture, const dirty_rect_t* clip) {
+    if (!sprite || !texture || !sprite->visible) return;
     if (!g_engine.framebuffer || g_engine.memory_error_detected) return;
+    if (sprite->transformed) {
+        render_sprite_affine(sprite, texture, clip);
+        return;
+    }
+    if (!is_sprite_on_screen(sprite)) return;
     
     int16_t screen_x, screen_y;
     world_to_screen(sprite->x, sprite->y, &screen_x, &screen_y);
     
     // Clipping with bounds checking
-    int16_t start_x = screen_x < 0 ? -screen_x : 0;
-    int16_t start_y = screen_y < 0 ? -screen_y : 0;
-    int16_t end_x = screen_x + (int16_t)texture->width > DISPLAY_WIDTH ? DISPLAY_WIDTH - screen_x : (int16_t)texture->width;
-    int16_t end_y = screen_y + (int16_t)texture->height > DISPLAY_HEIGHT ? DISPLAY_HEIGHT - screen_y : (int16_t)texture->height;
+    int16_t start_x = screen_x < clip->x0 ? clip->x0 - screen_x : 0;
+    int16_t start_y = screen_y < clip->y0 ? clip->y0 - screen_y : 0;
+    int16_t end_x = screen_x + (int16_t)texture->width > clip->x1 ? clip->x1 - screen_x : (int16_t)texture->width;
+    int16_t end_y = screen_y + (int16_t)texture->height > clip->y1 ? clip->y1 - screen_y : (int16_t)texture->height;
     
     // Additional safety checks
     if (start_x >= texture->width || start_y >= texture->height) return;
     if (end_x <= start_x || end_y <= start_y) return;
+    if (texture->kind == TEXTURE_DATA && (!texture->spans || !texture->row_spans)) return;
+    if (texture->kind == TEXTURE_SOLID && texture->color == 0x0000) return;  // transparent
+    if (!is_valid_framebuffer_coords(screen_x + start_x, screen_y + start_y) ||
+        !is_valid_framebuffer_coords(screen_x + end_x - 1, screen_y + end_y - 1)) return;
+    
+    bool blend = sprite->alpha < 255 || sprite->blend_mode != BLEND_NONE;
     
     for (int16_t ty = start_y; ty < end_y; ty++) {
-        for (int16_t tx = start_x; tx < end_x; tx++) {
-            // Bounds check for texture access
-            if (ty >= texture->height || tx >= texture->width) continue;
-            
-            uint16_t src_color = texture->data[ty * texture->width + tx];
-            if (src_color == 0x0000) continue; // Skip transparent pixels
-            
-            int16_t fb_x = screen_x + tx;
-            int16_t fb_y = screen_y + ty;
+        uint16_t* dst_row = &g_engine.framebuffer[(size_t)(screen_y + ty) * DISPLAY_WIDTH + screen_x];
+        if (texture->kind != TEXTURE_DATA) {
+            render_generated_span(sprite, texture, dst_row, ty, start_x, end_x, blend);
+            continue;
+        }
+        const uint16_t* src_row = &texture->data[(size_t)ty * texture->stride];
+        
+        // Opaque runs of this row, clipped to [start_x, end_x)
+        for (uint32_t s = texture->row_spans[ty]; s < texture->row_spans[ty + 1]; s++) {
+            int16_t x0 = (int16_t)texture->spans[s].start;
+            int16_t x1 = x0 + (int16_t)texture->spans[s].length;
+            if (x1 <= start_x) continue;
+            if (x0 >= end_x) break;
+            if (x0 < start_x) x0 = start_x;
+            if (x1 > end_x) x1 = end_x;
             
-            if (is_valid_framebuffer_coords(fb_x, fb_y)) {
-                size_t fb_index = fb_y * DISPLAY_WIDTH + fb_x;
-                
-                // Bounds check for framebuffer
-                if (fb_index < (DISPLAY_WIDTH * DISPLAY_HEIGHT)) {
-                    if (sprite->alpha < 255 || sprite->blend_mode != BLEND_NONE) {
-                        uint16_t dst_color = g_engine.framebuffer[fb_index];
-                        src_color = color_blend(src_color, dst_color, sprite->alpha);
-                    }
-                    g_engine.framebuffer[fb_index] = src_color;
+            if (!blend) {
+                memcpy(&dst_row[x0], &src_row[x0], (size_t)(x1 - x0) * sizeof(uint16_t));
+            } else {
+                for (int16_t tx = x0; tx < x1; tx++) {
+                    dst_row[tx] = color_blend(src_row[tx], dst_row[tx], sprite->alpha);
                 }
             }
         }
@@ -266,6 +963,52 @@ static void render_sprite_to_framebuffer(const sprite_t* sprite, const texture_t
 }
 
 
+// Render Thread
+
+#define LOAD(p) __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define STORE(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+
+static void render_frame(void);
+static void present_frame(void);
+
+// Core 1: draw and send one snapshot, then hand it back
+static void render_job(void* arg) {
+    frame_snapshot_t* frame = arg;
+    render_scene = &frame->scene;
+    g_engine.phase_us[ENGINE_PHASE_UPDATE] = frame->update_us;
+    dirty_add_list(&g_engine.dirty, &frame->invalidated);
+    render_frame();
+    present_frame();
+    STORE(&g_engine.frames_rendered, g_engine.frames_rendered + 1);
+}
+
+// Until core 1 has drawn every snapshot, before core 0 changes anything
+// it reads besides the scene
+static void render_thread_sync(void) {
+    if (!g_engine.render_thread) return;
+    while (LOAD(&g_engine.frames_rendered) != g_engine.frames_published) {
+        tight_loop_contents();
+    }
+}
+
+// Copy the scene into the snapshot core 1 finished two frames ago, and
+// queue it. The next update then runs while this frame is drawn and sent
+static void publish_snapshot(uint32_t update_us) {
+    uint32_t frame = g_engine.frames_published;
+    while (frame - LOAD(&g_engine.frames_rendered) >= 2) tight_loop_contents();
+    
+    frame_snapshot_t* snapshot = &g_engine.snapshots[frame % 2];
+    snapshot->scene = g_engine.scene;
+    snapshot->invalidated = g_engine.invalidated;
+    snapshot->update_us = update_us;
+    dirty_reset(&g_engine.invalidated, false);
+    
+    // The ring is shared with the program's own jobs, and empties
+    g_engine.frames_published = frame + 1;
+    while (!jobs_submit(render_job, snapshot)) tight_loop_contents();
+}
+
+
 // Core Engine Implementation
 
 engine_error_t engine_init(void) {
@@ -280,6 +1023,11 @@ engine_error_t engine_init(void) {
         return ENGINE_ERROR_INIT_FAILED;
     }
     
+    // A channel of its own for clearing the framebuffer; without one the
+    // clears are done by the CPU
+    if (!fbdma_init()) printf("No DMA channel for clears, using the CPU\n");
+    g_engine.clear_pending = false;
+    
     // Allocate framebuffer with error checking
     g_engine.framebuffer_size = MAX_FRAMEBUFFER_SIZE;
     g_engine.framebuffer = malloc(g_engine.framebuffer_size);
@@ -292,21 +1040,25 @@ engine_error_t engine_init(void) {
     memset(g_engine.framebuffer, 0, g_engine.framebuffer_size);
     
     // Initialize engine state
-    memset(&g_engine.sprites, 0, sizeof(g_engine.sprites));
+    memset(&g_engine.scene.sprites, 0, sizeof(g_engine.scene.sprites));
     memset(&g_engine.textures, 0, sizeof(g_engine.textures));
-    memset(&g_engine.particle_systems, 0, sizeof(g_engine.particle_systems));
+    memset(&g_engine.scene.particle_systems, 0, sizeof(g_engine.scene.particle_systems));
     
     init_free_lists();
     
-    g_engine.camera_x = 0;
-    g_engine.camera_y = 0;
+    g_engine.scene.camera_x = 0;
+    g_engine.scene.camera_y = 0;
     g_engine.camera_follow_target = INVALID_HANDLE;
     g_engine.collision_callback = NULL;
     g_engine.memory_check_counter = 0;
     g_engine.memory_error_detected = false;
+    g_engine.dirty_mode = false;
+    dirty_reset(&g_engine.dirty, true);
     
     // Clear statistics
     memset(&g_engine.stats, 0, sizeof(engine_stats_t));
+    g_engine.timing_stream = false;
+    timing_reset();
     
     g_engine.last_frame_time = get_time_ms();
     g_engine.initialized = true;
@@ -319,6 +1071,7 @@ void engine_shutdown(void) {
     if (!g_engine.initialized) return;
     
     printf("Shutting down Graphics Engine..\n");
+    engine_set_render_thread(false);
     
     // Free all textures
     for (int i = 0; i < MAX_TEXTURES; i++) {
@@ -329,18 +1082,26 @@ void engine_shutdown(void) {
     
     // Clear all sprites
     for (int i = 0; i < MAX_SPRITES; i++) {
-        if (g_engine.sprites[i].active) {
+        if (g_engine.scene.sprites[i].active) {
             free_sprite_handle(i);
         }
     }
     
     // Clear all particle systems
     for (int i = 0; i < MAX_PARTICLE_SYSTEMS; i++) {
-        if (g_engine.particle_systems[i].active) {
+        if (g_engine.scene.particle_systems[i].active) {
             free_particle_handle(i);
         }
     }
     
+    // Free the second buffer once the display is done with it
+    display_wait_for_dma();
+    fbdma_deinit();
+    if (g_engine.front_buffer) {
+        free(g_engine.front_buffer);
+        g_engine.front_buffer = NULL;
+    }
+    
     // Free framebuffer safely
     if (g_engine.framebuffer) {
         // Clear framebuffer before freeing
@@ -363,6 +1124,7 @@ void engine_shutdown(void) {
 void engine_update(void) {
     if (!g_engine.initialized || g_engine.memory_error_detected) return;
     
+    uint32_t start_us = get_time_us();
     uint32_t current_time = get_time_ms();
     uint32_t frame_time = current_time - g_engine.last_frame_time;
     
@@ -397,28 +1159,28 @@ void engine_update(void) {
     // Update camera following
     if (g_engine.camera_follow_target != INVALID_HANDLE && 
         g_engine.camera_follow_target < MAX_SPRITES &&
-        g_engine.sprites[g_engine.camera_follow_target].active) {
+        g_engine.scene.sprites[g_engine.camera_follow_target].active) {
         
-        const sprite_t* target = &g_engine.sprites[g_engine.camera_follow_target];
-        g_engine.camera_x = target->x - (DISPLAY_WIDTH / 2) + g_engine.camera_follow_offset_x;
-        g_engine.camera_y = target->y - (DISPLAY_HEIGHT / 2) + g_engine.camera_follow_offset_y;
+        const sprite_t* target = &g_engine.scene.sprites[g_engine.camera_follow_target];
+        g_engine.scene.camera_x = target->x - COORD_FROM_INT(DISPLAY_WIDTH / 2) + g_engine.camera_follow_offset_x;
+        g_engine.scene.camera_y = target->y - COORD_FROM_INT(DISPLAY_HEIGHT / 2) + g_engine.camera_follow_offset_y;
     }
     
     // Update sprite physics
     g_engine.stats.sprite_count = 0;
     for (int i = 0; i < MAX_SPRITES; i++) {
-        sprite_t* sprite = &g_engine.sprites[i];
+        sprite_t* sprite = &g_engine.scene.sprites[i];
         if (!sprite->active) continue;
         
         g_engine.stats.sprite_count++;
         
         // Apply velocity with bounds checking
-        if (sprite->velocity_x != 0.0f || sprite->velocity_y != 0.0f) {
+        if (sprite->velocity_x != 0 || sprite->velocity_y != 0) {
             // Check for reasonable values
-            if (sprite->velocity_x > -1000.0f && sprite->velocity_x < 1000.0f) {
+            if (sprite->velocity_x > -COORD_FROM_INT(1000) && sprite->velocity_x < COORD_FROM_INT(1000)) {
                 sprite->x += sprite->velocity_x;
             }
-            if (sprite->velocity_y > -1000.0f && sprite->velocity_y < 1000.0f) {
+            if (sprite->velocity_y > -COORD_FROM_INT(1000) && sprite->velocity_y < COORD_FROM_INT(1000)) {
                 sprite->y += sprite->velocity_y;
             }
         }
@@ -427,7 +1189,7 @@ void engine_update(void) {
     // Update particle systems
     g_engine.stats.particle_count = 0;
     for (int i = 0; i < MAX_PARTICLE_SYSTEMS; i++) {
-        particle_system_t* system = &g_engine.particle_systems[i];
+        particle_system_t* system = &g_engine.scene.particle_systems[i];
         if (!system->active) continue;
         
         // Spawn particles
@@ -438,109 +1200,281 @@ void engine_update(void) {
         }
         
         // Update particles
-        for (int j = 0; j < PARTICLE_POOL_SIZE; j++) {
-            particle_t* p = &system->particles[j];
-            if (!p->active) continue;
-            
-            g_engine.stats.particle_count++;
-            
-            // Update physics with bounds checking
-            if (p->acc_x > -10.0f && p->acc_x < 10.0f) p->vel_x += p->acc_x;
-            if (p->acc_y > -10.0f && p->acc_y < 10.0f) p->vel_y += p->acc_y;
-            if (p->vel_x > -100.0f && p->vel_x < 100.0f) p->x += p->vel_x;
-            if (p->vel_y > -100.0f && p->vel_y < 100.0f) p->y += p->vel_y;
-            
-            // Update lifetime
-            if (p->life_remaining > g_engine.stats.frame_time_ms) {
-                p->life_remaining -= g_engine.stats.frame_time_ms;
-                // Fade alpha based on remaining life
-                if (system->particle_lifetime_ms > 0) {
-                    float life_ratio = (float)p->life_remaining / system->particle_lifetime_ms;
-                    p->alpha = (uint8_t)(255 * life_ratio);
-                }
-            } else {
-                p->active = false;
-                if (system->active_count > 0) {
-                    system->active_count--;
-                }
-            }
-        }
+        int count = system->active_count;
+        g_engine.stats.particle_count += count;
+        
+        // Update physics with bounds checking
+        coord_t acc_x = (system->acc_x > -COORD_FROM_INT(10) && system->acc_x < COORD_FROM_INT(10)) ? system->acc_x : 0;
+        coord_t acc_y = (system->acc_y > -COORD_FROM_INT(10) && system->acc_y < COORD_FROM_INT(10)) ? system->acc_y : 0;
+        particles_integrate(system->x, system->vel_x, acc_x, count);
+        particles_integrate(system->y, system->vel_y, acc_y, count);
+        
+        // Update lifetime, fading alpha with the remaining life
+        uint16_t dt = g_engine.stats.frame_time_ms > 0xFFFF ? 0xFFFF : (uint16_t)g_engine.stats.frame_time_ms;
+        uint32_t alpha_scale = system->particle_lifetime_ms > 0 ? (255u << 16) / system->particle_lifetime_ms : 0;
+        particles_age(system->life_remaining, system->alpha, dt, alpha_scale, count);
+        particles_compact(system);
     }
     
     // Collision detection with safety checks
+    g_engine.stats.collision_checks = 0;
     if (g_engine.collision_callback) {
-        for (int i = 0; i < MAX_SPRITES; i++) {
-            sprite_t* s1 = &g_engine.sprites[i];
-            if (!s1->active || !s1->collision_enabled) continue;
+        sweep_collisions();
+    }
+    
+    // Time spent waiting for core 1 to free a snapshot counts as update
+    if (g_engine.render_thread) {
+        publish_snapshot(get_time_us() - start_us);
+    } else {
+        timing_add(ENGINE_PHASE_UPDATE, start_us);
+    }
+}
+
+static void RAM_FUNC(render_particles)(uint8_t layer, const dirty_rect_t* clip) {
+    for (int i = 0; i < MAX_PARTICLE_SYSTEMS; i++) {
+        const particle_system_t* system = &render_scene->particle_systems[i];
+        if (!system->active || system->layer != layer) continue;
+        
+        for (int j = 0; j < system->active_count; j++) {
+            int16_t screen_x, screen_y;
+            world_to_screen(system->x[j], system->y[j], &screen_x, &screen_y);
             
-            for (int j = i + 1; j < MAX_SPRITES; j++) {
-                sprite_t* s2 = &g_engine.sprites[j];
-                if (!s2->active || !s2->collision_enabled) continue;
-                
-                if (sprite_check_collision(i, j)) {
-                    g_engine.collision_callback(i, j);
+            if (is_valid_framebuffer_coords(screen_x, screen_y) &&
+                screen_x >= clip->x0 && screen_x < clip->x1 &&
+                screen_y >= clip->y0 && screen_y < clip->y1) {
+                size_t fb_index = screen_y * DISPLAY_WIDTH + screen_x;
+                if (fb_index < (DISPLAY_WIDTH * DISPLAY_HEIGHT)) {
+                    uint16_t color = system->base_color;
+                    if (system->alpha[j] < 255) {
+                        uint16_t bg = g_engine.framebuffer[fb_index];
+                        color = color_blend(color, bg, system->alpha[j]);
+                    }
+                    g_engine.framebuffer[fb_index] = color;
                 }
             }
         }
     }
 }
 
-void engine_render(void) {
-    if (!g_engine.initialized || !g_engine.framebuffer || g_engine.memory_error_detected) return;
-    
+// Clear, unless that is done already, and redraw everything inside clip
+static void RAM_FUNC(render_region)(const dirty_rect_t* clip, bool clear) {
     // Clear framebuffer safely
-    memset(g_engine.framebuffer, 0, g_engine.framebuffer_size);
+    if (clear && clip->x0 == 0 && clip->x1 == DISPLAY_WIDTH) {
+        memset(&g_engine.framebuffer[clip->y0 * DISPLAY_WIDTH], 0,
+               (size_t)(clip->y1 - clip->y0) * DISPLAY_WIDTH * sizeof(uint16_t));
+    } else if (clear) {
+        for (int16_t y = clip->y0; y < clip->y1; y++) {
+            memset(&g_engine.framebuffer[y * DISPLAY_WIDTH + clip->x0], 0,
+                   (size_t)(clip->x1 - clip->x0) * sizeof(uint16_t));
+        }
+    }
     
-    // Render sprites by layer (0 = back, higher = front)
-    for (uint8_t layer = 0; layer < 8; layer++) {
-        for (int i = 0; i < MAX_SPRITES; i++) {
-            const sprite_t* sprite = &g_engine.sprites[i];
-            if (!sprite->active || sprite->layer != layer) continue;
-            
-            if (sprite->texture < MAX_TEXTURES && g_engine.textures[sprite->texture].active) {
-                const texture_t* texture = &g_engine.textures[sprite->texture];
-                if (texture->data) {  // Additional safety check
-                    render_sprite_to_framebuffer(sprite, texture);
-                }
-            }
+    // Layers that have particle systems, drawn after the sprites of the layer
+    uint8_t particle_layers = 0;
+    for (int i = 0; i < MAX_PARTICLE_SYSTEMS; i++) {
+        if (render_scene->particle_systems[i].active) {
+            particle_layers |= 1u << render_scene->particle_systems[i].layer;
+        }
+    }
+    
+    // One pass over the draw list, already sorted by layer (0 = back, higher = front)
+    uint8_t layer = 0;
+    for (uint8_t i = render_scene->draw_head; i != INVALID_HANDLE; i = render_scene->draw_next[i]) {
+        const sprite_t* sprite = &render_scene->sprites[i];
+        for (; layer < sprite->layer; layer++) {
+            if (particle_layers & (1u << layer)) render_particles(layer, clip);
         }
         
-        // Render particles on each layer
-        for (int i = 0; i < MAX_PARTICLE_SYSTEMS; i++) {
-            const particle_system_t* system = &g_engine.particle_systems[i];
-            if (!system->active) continue;
-            
-            for (int j = 0; j < PARTICLE_POOL_SIZE; j++) {
-                const particle_t* p = &system->particles[j];
-                if (!p->active) continue;
-                
-                int16_t screen_x, screen_y;
-                world_to_screen(p->x, p->y, &screen_x, &screen_y);
-                
-                if (is_valid_framebuffer_coords(screen_x, screen_y)) {
-                    size_t fb_index = screen_y * DISPLAY_WIDTH + screen_x;
-                    if (fb_index < (DISPLAY_WIDTH * DISPLAY_HEIGHT)) {
-                        uint16_t color = p->color;
-                        if (p->alpha < 255) {
-                            uint16_t bg = g_engine.framebuffer[fb_index];
-                            color = color_blend(color, bg, p->alpha);
-                        }
-                        g_engine.framebuffer[fb_index] = color;
-                    }
-                }
+        if (sprite->texture < MAX_TEXTURES && g_engine.textures[sprite->texture].active) {
+            const texture_t* texture = &g_engine.textures[sprite->texture];
+            if (texture_ready(texture)) {  // Additional safety check
+                render_sprite_to_framebuffer(sprite, texture, clip);
             }
         }
     }
+    for (; layer < 8; layer++) {
+        if (particle_layers & (1u << layer)) render_particles(layer, clip);
+    }
 }
 
-void engine_present(void) {
-    if (!g_engine.initialized || !g_engine.framebuffer || g_engine.memory_error_detected) return;
+static void RAM_FUNC(render_frame)(void) {
+    // Fence: wait if the buffer about to be drawn is still being sent.
+    // The display runs one transfer at a time, and engine_present starts
+    // the next only after the last one, so with two buffers this only
+    // waits when render has caught up with the SPI transfer.
+    uint32_t start_us = get_time_us();
+    if (display_blit_busy(g_engine.framebuffer)) {
+        display_wait_for_dma();
+        timing_add(ENGINE_PHASE_DMA_WAIT, start_us);
+        start_us = get_time_us();
+    }
+    
+    if (g_engine.dirty_mode) collect_dirty_rects();
+    
+    // A back buffer also lacks what changed while the other one was drawn
+    dirty_list_t todo = g_engine.dirty;
+    if (g_engine.front_buffer) dirty_add_list(&todo, &g_engine.back_dirty);
     
-    display_error_t result = display_blit_full(g_engine.framebuffer);
+    // The clear started by engine_present blanked all of it
+    bool cleared = g_engine.clear_pending;
+    if (cleared) {
+        fbdma_wait();
+        g_engine.clear_pending = false;
+        todo.full = true;
+    }
+    
+    if (todo.full) {
+        render_region(&screen_rect, !cleared);
+    } else {
+        for (int i = 0; i < todo.count; i++) {
+            render_region(&todo.rects[i], true);
+        }
+    }
+    
+    timing_add(ENGINE_PHASE_RENDER, start_us);
+}
+
+static void present_frame(void) {
+    display_error_t result = DISPLAY_OK;
+    uint32_t start_us = get_time_us();
+    if (g_engine.front_buffer) {
+        // Send this frame in the background and draw the next one into
+        // the other buffer; rectangles would each need their own transfer.
+        // The transfer of the last frame has to end first.
+        display_wait_for_dma();
+        timing_add(ENGINE_PHASE_DMA_WAIT, start_us);
+        start_us = get_time_us();
+        result = display_blit_full_async(g_engine.framebuffer);
+        g_engine.stats.dirty_rect_count = 0;
+        g_engine.stats.pixels_presented = DISPLAY_WIDTH * DISPLAY_HEIGHT;
+        
+        uint16_t* sent = g_engine.framebuffer;
+        g_engine.framebuffer = g_engine.front_buffer;
+        g_engine.front_buffer = sent;
+        g_engine.back_dirty = g_engine.dirty;
+    } else if (g_engine.dirty.full) {
+        result = display_blit_full(g_engine.framebuffer);
+        g_engine.stats.dirty_rect_count = 0;
+        g_engine.stats.pixels_presented = DISPLAY_WIDTH * DISPLAY_HEIGHT;
+    } else {
+        g_engine.stats.dirty_rect_count = g_engine.dirty.count;
+        g_engine.stats.pixels_presented = 0;
+        for (int i = 0; i < g_engine.dirty.count && result == DISPLAY_OK; i++) {
+            const dirty_rect_t* r = &g_engine.dirty.rects[i];
+            result = display_blit_rect(r->x0, r->y0, r->x1 - r->x0, r->y1 - r->y0, g_engine.framebuffer);
+            g_engine.stats.pixels_presented += rect_area(r);
+        }
+    }
     if (result != DISPLAY_OK) {
         printf("Display blit failed: %s\n", display_error_string(result));
         // Don't set memory error for display issues, just log
     }
+    
+    // Without dirty rectangles every frame is full; after a failed blit
+    // the screen is unknown, so send all of it next time
+    dirty_reset(&g_engine.dirty, !g_engine.dirty_mode || result != DISPLAY_OK);
+    
+    // The next frame is drawn whole into a buffer the display is done
+    // with, so it can be cleared now, by DMA while the program goes on
+    // with its update
+    if (!g_engine.dirty_mode) {
+        fbdma_fill(g_engine.framebuffer, COLOR_BLACK, DISPLAY_WIDTH * DISPLAY_HEIGHT);
+        g_engine.clear_pending = true;
+    }
+    
+    timing_add(ENGINE_PHASE_PRESENT, start_us);
+    timing_end_frame();
+}
+
+// With the render thread on, core 1 renders and presents every snapshot
+// as engine_update() publishes it, and these two do nothing
+void engine_render(void) {
+    if (!g_engine.initialized || !g_engine.framebuffer || g_engine.memory_error_detected) return;
+    if (!g_engine.render_thread) render_frame();
+}
+
+void engine_present(void) {
+    if (!g_engine.initialized || !g_engine.framebuffer || g_engine.memory_error_detected) return;
+    if (!g_engine.render_thread) present_frame();
+}
+
+void engine_set_dirty_rects(bool enabled) {
+    if (!g_engine.initialized) return;
+    
+    render_thread_sync();
+    g_engine.dirty_mode = enabled;
+    // Start from a full frame so what is on screen is known
+    dirty_reset(&g_engine.dirty, true);
+    dirty_reset(&g_engine.back_dirty, true);
+    dirty_reset(&g_engine.overlay, false);
+}
+
+engine_error_t engine_set_double_buffering(bool enabled) {
+    if (!g_engine.initialized) return ENGINE_ERROR_INIT_FAILED;
+    if (enabled == (g_engine.front_buffer != NULL)) return ENGINE_OK;
+    
+    render_thread_sync();
+    if (enabled) {
+        uint16_t* buffer = malloc(g_engine.framebuffer_size);
+        if (!buffer) {
+            printf("Failed to allocate second framebuffer\n");
+            return ENGINE_ERROR_OUT_OF_MEMORY;
+        }
+        memset(buffer, 0, g_engine.framebuffer_size);
+        g_engine.front_buffer = buffer;
+    } else {
+        display_wait_for_dma();
+        free(g_engine.front_buffer);
+        g_engine.front_buffer = NULL;
+    }
+    
+    dirty_reset(&g_engine.dirty, true);
+    dirty_reset(&g_engine.back_dirty, true);
+    return ENGINE_OK;
+}
+
+engine_error_t engine_set_render_thread(bool enabled) {
+    if (!g_engine.initialized) return ENGINE_ERROR_INIT_FAILED;
+    if (enabled == g_engine.render_thread) return ENGINE_OK;
+    
+    if (enabled) {
+        frame_snapshot_t* snapshots = malloc(2 * sizeof(frame_snapshot_t));
+        if (!snapshots) {
+            printf("Failed to allocate render snapshots\n");
+            return ENGINE_ERROR_OUT_OF_MEMORY;
+        }
+        // Core 1 may run the program's jobs already; then they share it
+        g_engine.started_jobs = jobs_init();
+        
+        // What was rendered last is the live scene, now to be redrawn
+        display_wait_for_dma();
+        g_engine.snapshots = snapshots;
+        g_engine.frames_published = 0;
+        g_engine.frames_rendered = 0;
+        dirty_reset(&g_engine.invalidated, false);
+        g_engine.render_thread = true;
+    } else {
+        render_thread_sync();
+        if (g_engine.started_jobs) jobs_shutdown();
+        g_engine.started_jobs = false;
+        g_engine.render_thread = false;
+        free(g_engine.snapshots);
+        g_engine.snapshots = NULL;
+        render_scene = &g_engine.scene;
+        display_wait_for_dma();
+    }
+    
+    dirty_reset(&g_engine.dirty, true);
+    dirty_reset(&g_engine.back_dirty, true);
+    return ENGINE_OK;
+}
+
+void engine_invalidate(int16_t x, int16_t y, uint16_t width, uint16_t height) {
+    if (!g_engine.initialized || width == 0 || height == 0) return;
+    
+    // Core 1 owns the dirty list; the next snapshot takes this along
+    dirty_rect_t r = {x, y, x + (int16_t)width, y + (int16_t)height};
+    dirty_add(g_engine.render_thread ? &g_engine.invalidated : &g_engine.dirty, r);
 }
 
 const engine_stats_t* engine_get_stats(void) {
@@ -548,9 +1482,47 @@ const engine_stats_t* engine_get_stats(void) {
 }
 
 void engine_reset_stats(void) {
+    render_thread_sync();
     memset(&g_engine.stats, 0, sizeof(engine_stats_t));
     g_engine.frame_counter = 0;
     g_engine.frame_accumulator = 0;
+    timing_reset();
+}
+
+void engine_get_timing(engine_timing_t* timing) {
+    if (!timing) return;
+    memset(timing, 0, sizeof(engine_timing_t));
+    timing->frames = g_engine.timing_count;
+    if (g_engine.timing_count == 0) return;
+    
+    uint64_t total[ENGINE_PHASE_COUNT] = {0};
+    for (int p = 0; p < ENGINE_PHASE_COUNT; p++) {
+        timing->phase[p].min_us = UINT32_MAX;
+    }
+    
+    // The ring is full or filled from slot 0, so the first timing_count
+    // slots are the frames kept
+    for (uint16_t f = 0; f < g_engine.timing_count; f++) {
+        const uint32_t* t = g_engine.timing[f];
+        for (int p = 0; p < ENGINE_PHASE_COUNT; p++) {
+            engine_phase_timing_t* phase = &timing->phase[p];
+            if (t[p] < phase->min_us) phase->min_us = t[p];
+            if (t[p] > phase->max_us) phase->max_us = t[p];
+            total[p] += t[p];
+        }
+        
+        uint32_t bucket = t[ENGINE_PHASE_FRAME] / ENGINE_TIMING_BUCKET_US;
+        if (bucket >= ENGINE_TIMING_BUCKETS) bucket = ENGINE_TIMING_BUCKETS - 1;
+        timing->histogram[bucket]++;
+    }
+    
+    for (int p = 0; p < ENGINE_PHASE_COUNT; p++) {
+        timing->phase[p].avg_us = (uint32_t)(total[p] / g_engine.timing_count);
+    }
+}
+
+void engine_set_timing_stream(bool enabled) {
+    g_engine.timing_stream = enabled;
 }
 
 const char* engine_error_string(engine_error_t error) {
@@ -572,6 +1544,7 @@ texture_handle_t texture_create(uint16_t* data, uint16_t width, uint16_t height,
     texture_t* tex = &g_engine.textures[handle];
     tex->width = width;
     tex->height = height;
+    tex->stride = width;
     
     if (copy_data) {
         size_t data_size = (size_t)width * height * sizeof(uint16_t);
@@ -582,56 +1555,128 @@ texture_handle_t texture_create(uint16_t* data, uint16_t width, uint16_t height,
             return INVALID_HANDLE;
         }
         
-        tex->data = malloc(data_size);
-        if (!tex->data) {
+        uint16_t* copy = malloc(data_size);
+        if (!copy) {
             free_texture_handle(handle);
             return INVALID_HANDLE;
         }
-        memcpy(tex->data, data, data_size);
+        memcpy(copy, data, data_size);
+        tex->data = copy;
         tex->owned_data = true;
     } else {
         tex->data = data;
         tex->owned_data = false;
     }
     
+    if (!build_texture_spans(tex)) {
+        free_texture_handle(handle);
+        return INVALID_HANDLE;
+    }
+    
     return handle;
 }
 
-texture_handle_t texture_create_solid(uint16_t color, uint16_t width, uint16_t height) {
-    if (width == 0 || height == 0 || width > 1024 || height > 1024) return INVALID_HANDLE;
+texture_handle_t texture_create_flash(const uint16_t* data, uint16_t width, uint16_t height) {
+    if (!data || width == 0 || height == 0 || width > 1024 || height > 1024) return INVALID_HANDLE;
     
     uint8_t handle = allocate_texture_handle();
     if (handle == INVALID_HANDLE) return INVALID_HANDLE;
     
+    // Only the spans go into SRAM
     texture_t* tex = &g_engine.textures[handle];
-    size_t pixel_count = (size_t)width * height;
-    size_t data_size = pixel_count * sizeof(uint16_t);
+    tex->data = data;
+    tex->width = width;
+    tex->height = height;
+    tex->stride = width;
+    tex->owned_data = false;
     
-    // Safety check for reasonable allocation size
-    if (data_size > 512 * 1024) {  // 512KB limit
+    if (!build_texture_spans(tex)) {
         free_texture_handle(handle);
         return INVALID_HANDLE;
     }
     
-    tex->data = malloc(data_size);
-    if (!tex->data) {
-        free_texture_handle(handle);
+    return handle;
+}
+
+texture_handle_t texture_create_solid(uint16_t color, uint16_t width, uint16_t height) {
+    if (width == 0 || height == 0 || width > 1024 || height > 1024) return INVALID_HANDLE;
+    
+    uint8_t handle = allocate_texture_handle();
+    if (handle == INVALID_HANDLE) return INVALID_HANDLE;
+    
+    texture_t* tex = &g_engine.textures[handle];
+    tex->kind = TEXTURE_SOLID;
+    tex->color = color;
+    tex->width = width;
+    tex->height = height;
+    tex->stride = width;
+    return handle;
+}
+
+texture_handle_t texture_create_procedural(texture_fill_fn_t fill, void* user,
+                                           uint16_t width, uint16_t height) {
+    if (!fill || width == 0 || height == 0 || width > 1024 || height > 1024) return INVALID_HANDLE;
+    
+    uint8_t handle = allocate_texture_handle();
+    if (handle == INVALID_HANDLE) return INVALID_HANDLE;
+    
+    texture_t* tex = &g_engine.textures[handle];
+    tex->kind = TEXTURE_PROCEDURAL;
+    tex->fill = fill;
+    tex->user = user;
+    tex->width = width;
+    tex->height = height;
+    tex->stride = width;
+    return handle;
+}
+
+texture_handle_t texture_create_region(texture_handle_t atlas, uint16_t x, uint16_t y,
+                                       uint16_t width, uint16_t height) {
+    if (atlas >= MAX_TEXTURES || !g_engine.textures[atlas].active) return INVALID_HANDLE;
+    if (width == 0 || height == 0) return INVALID_HANDLE;
+    
+    const texture_t* parent = &g_engine.textures[atlas];
+    if ((uint32_t)x + width > parent->width || (uint32_t)y + height > parent->height) {
         return INVALID_HANDLE;
     }
     
-    for (size_t i = 0; i < pixel_count; i++) {
-        tex->data[i] = color;
-    }
+    uint8_t handle = allocate_texture_handle();
+    if (handle == INVALID_HANDLE) return INVALID_HANDLE;
     
+    // A region of a region belongs to the same atlas
+    texture_t* tex = &g_engine.textures[handle];
+    tex->kind = parent->kind;
+    tex->color = parent->color;
+    tex->fill = parent->fill;
+    tex->user = parent->user;
+    tex->origin_x = parent->origin_x + x;
+    tex->origin_y = parent->origin_y + y;
+    if (parent->kind == TEXTURE_DATA) {
+        tex->data = &parent->data[(size_t)y * parent->stride + x];
+    }
     tex->width = width;
     tex->height = height;
-    tex->owned_data = true;
+    tex->stride = parent->stride;
+    tex->atlas = parent->atlas != INVALID_HANDLE ? parent->atlas : atlas;
+    tex->owned_data = false;
+    
+    if (!build_texture_spans(tex)) {
+        free_texture_handle(handle);
+        return INVALID_HANDLE;
+    }
     
     return handle;
 }
 
+bool texture_update_spans(texture_handle_t handle) {
+    if (handle >= MAX_TEXTURES || !g_engine.textures[handle].active) return false;
+    render_thread_sync();
+    return build_texture_spans(&g_engine.textures[handle]);
+}
+
 void texture_destroy(texture_handle_t handle) {
     if (handle != INVALID_HANDLE && handle < MAX_TEXTURES) {
+        render_thread_sync();
         free_texture_handle(handle);
     }
 }
@@ -656,9 +1701,9 @@ sprite_handle_t sprite_create(float x, float y, texture_handle_t texture) {
     uint8_t handle = allocate_sprite_handle();
     if (handle == INVALID_HANDLE) return INVALID_HANDLE;
     
-    sprite_t* sprite = &g_engine.sprites[handle];
-    sprite->x = x;
-    sprite->y = y;
+    sprite_t* sprite = &g_engine.scene.sprites[handle];
+    sprite->x = COORD_FROM_FLOAT(x);
+    sprite->y = COORD_FROM_FLOAT(y);
     sprite->velocity_x = 0;
     sprite->velocity_y = 0;
     sprite->texture = texture;
@@ -669,6 +1714,11 @@ sprite_handle_t sprite_create(float x, float y, texture_handle_t texture) {
     sprite->blend_mode = BLEND_NONE;
     sprite->visible = true;
     sprite->collision_enabled = false;
+    sprite->scale_x = 1.0f;
+    sprite->scale_y = 1.0f;
+    sprite->rotation = 0.0f;
+    sprite->transformed = false;
+    draw_list_insert(handle);
     
     return handle;
 }
@@ -684,91 +1734,139 @@ void sprite_destroy(sprite_handle_t handle) {
 }
 
 void sprite_set_position(sprite_handle_t handle, float x, float y) {
-    if (handle >= MAX_SPRITES || !g_engine.sprites[handle].active) return;
+    if (handle >= MAX_SPRITES || !g_engine.scene.sprites[handle].active) return;
     
     // Sanity check on position values
     if (x < -10000.0f || x > 10000.0f || y < -10000.0f || y > 10000.0f) return;
     
-    g_engine.sprites[handle].x = x;
-    g_engine.sprites[handle].y = y;
+    g_engine.scene.sprites[handle].x = COORD_FROM_FLOAT(x);
+    g_engine.scene.sprites[handle].y = COORD_FROM_FLOAT(y);
 }
 
 void sprite_get_position(sprite_handle_t handle, float* x, float* y) {
-    if (handle >= MAX_SPRITES || !g_engine.sprites[handle].active) return;
-    if (x) *x = g_engine.sprites[handle].x;
-    if (y) *y = g_engine.sprites[handle].y;
+    if (handle >= MAX_SPRITES || !g_engine.scene.sprites[handle].active) return;
+    if (x) *x = COORD_TO_FLOAT(g_engine.scene.sprites[handle].x);
+    if (y) *y = COORD_TO_FLOAT(g_engine.scene.sprites[handle].y);
 }
 
 void sprite_set_velocity(sprite_handle_t handle, float vx, float vy) {
-    if (handle >= MAX_SPRITES || !g_engine.sprites[handle].active) return;
+    if (handle >= MAX_SPRITES || !g_engine.scene.sprites[handle].active) return;
     
     // Sanity check on velocity values
     if (vx < -1000.0f || vx > 1000.0f || vy < -1000.0f || vy > 1000.0f) return;
     
-    g_engine.sprites[handle].velocity_x = vx;
-    g_engine.sprites[handle].velocity_y = vy;
+    g_engine.scene.sprites[handle].velocity_x = COORD_FROM_FLOAT(vx);
+    g_engine.scene.sprites[handle].velocity_y = COORD_FROM_FLOAT(vy);
 }
 
 void sprite_move(sprite_handle_t handle, float dx, float dy) {
-    if (handle >= MAX_SPRITES || !g_engine.sprites[handle].active) return;
+    if (handle >= MAX_SPRITES || !g_engine.scene.sprites[handle].active) return;
     
     // Sanity check on delta values
     if (dx < -1000.0f || dx > 1000.0f || dy < -1000.0f || dy > 1000.0f) return;
     
-    g_engine.sprites[handle].x += dx;
-    g_engine.sprites[handle].y += dy;
+    g_engine.scene.sprites[handle].x += COORD_FROM_FLOAT(dx);
+    g_engine.scene.sprites[handle].y += COORD_FROM_FLOAT(dy);
 }
 
 void sprite_set_texture(sprite_handle_t handle, texture_handle_t texture) {
-    if (handle >= MAX_SPRITES || !g_engine.sprites[handle].active) return;
+    if (handle >= MAX_SPRITES || !g_engine.scene.sprites[handle].active) return;
     if (texture >= MAX_TEXTURES || !g_engine.textures[texture].active) return;
     
-    g_engine.sprites[handle].texture = texture;
-    g_engine.sprites[handle].width = g_engine.textures[texture].width;
-    g_engine.sprites[handle].height = g_engine.textures[texture].height;
+    g_engine.scene.sprites[handle].texture = texture;
+    g_engine.scene.sprites[handle].width = g_engine.textures[texture].width;
+    g_engine.scene.sprites[handle].height = g_engine.textures[texture].height;
 }
 
 void sprite_set_alpha(sprite_handle_t handle, uint8_t alpha) {
-    if (handle >= MAX_SPRITES || !g_engine.sprites[handle].active) return;
-    g_engine.sprites[handle].alpha = alpha;
+    if (handle >= MAX_SPRITES || !g_engine.scene.sprites[handle].active) return;
+    g_engine.scene.sprites[handle].alpha = alpha;
 }
 
 void sprite_set_blend_mode(sprite_handle_t handle, blend_mode_t mode) {
-    if (handle >= MAX_SPRITES || !g_engine.sprites[handle].active) return;
-    g_engine.sprites[handle].blend_mode = mode;
+    if (handle >= MAX_SPRITES || !g_engine.scene.sprites[handle].active) return;
+    g_engine.scene.sprites[handle].blend_mode = mode;
 }
 
 void sprite_set_layer(sprite_handle_t handle, uint8_t layer) {
-    if (handle >= MAX_SPRITES || !g_engine.sprites[handle].active) return;
+    if (handle >= MAX_SPRITES || !g_engine.scene.sprites[handle].active) return;
     if (layer > 7) layer = 7;
-    g_engine.sprites[handle].layer = layer;
+    if (g_engine.scene.sprites[handle].layer == layer) return;
+    
+    draw_list_remove(handle);
+    g_engine.scene.sprites[handle].layer = layer;
+    draw_list_insert(handle);
 }
 
 void sprite_set_visibility(sprite_handle_t handle, bool visible) {
-    if (handle >= MAX_SPRITES || !g_engine.sprites[handle].active) return;
-    g_engine.sprites[handle].visible = visible;
+    if (handle >= MAX_SPRITES || !g_engine.scene.sprites[handle].active) return;
+    g_engine.scene.sprites[handle].visible = visible;
+}
+
+// Both matrices, in Q16.16, from the scale and rotation; trigonometry
+// only here, when they change
+static void update_sprite_transform(sprite_t* sprite) {
+    float radians = sprite->rotation * 3.14159265f / 180.0f;
+    float c = cosf(radians), s = sinf(radians);
+    float sx = sprite->scale_x, sy = sprite->scale_y;
+    
+    // screen = R * S * texture, inverse = S^-1 * R^T
+    sprite->forward[0] = (int32_t)lrintf(sx * c * 65536.0f);
+    sprite->forward[1] = (int32_t)lrintf(-sy * s * 65536.0f);
+    sprite->forward[2] = (int32_t)lrintf(sx * s * 65536.0f);
+    sprite->forward[3] = (int32_t)lrintf(sy * c * 65536.0f);
+    sprite->inverse[0] = (int32_t)lrintf(c / sx * 65536.0f);
+    sprite->inverse[1] = (int32_t)lrintf(s / sx * 65536.0f);
+    sprite->inverse[2] = (int32_t)lrintf(-s / sy * 65536.0f);
+    sprite->inverse[3] = (int32_t)lrintf(c / sy * 65536.0f);
+    sprite->transformed = sx != 1.0f || sy != 1.0f || fmodf(sprite->rotation, 360.0f) != 0.0f;
+}
+
+// Keep the magnitude where the Q16.16 matrices and the bounds fit
+static float clamp_scale(float scale) {
+    float magnitude = fabsf(scale);
+    if (magnitude < 1.0f / 64.0f) magnitude = 1.0f / 64.0f;
+    if (magnitude > 8.0f) magnitude = 8.0f;
+    return scale < 0 ? -magnitude : magnitude;
+}
+
+void sprite_set_scale(sprite_handle_t handle, float scale_x, float scale_y) {
+    if (handle >= MAX_SPRITES || !g_engine.scene.sprites[handle].active) return;
+    
+    sprite_t* sprite = &g_engine.scene.sprites[handle];
+    sprite->scale_x = clamp_scale(scale_x);
+    sprite->scale_y = clamp_scale(scale_y);
+    update_sprite_transform(sprite);
+}
+
+void sprite_set_rotation(sprite_handle_t handle, float degrees) {
+    if (handle >= MAX_SPRITES || !g_engine.scene.sprites[handle].active) return;
+    
+    sprite_t* sprite = &g_engine.scene.sprites[handle];
+    sprite->rotation = fmodf(degrees, 360.0f);
+    update_sprite_transform(sprite);
 }
 
 void sprite_enable_collision(sprite_handle_t handle, bool enabled) {
-    if (handle >= MAX_SPRITES || !g_engine.sprites[handle].active) return;
-    g_engine.sprites[handle].collision_enabled = enabled;
+    if (handle >= MAX_SPRITES || !g_engine.scene.sprites[handle].active) return;
+    g_engine.scene.sprites[handle].collision_enabled = enabled;
 }
 
 bool sprite_check_collision(sprite_handle_t handle1, sprite_handle_t handle2) {
     if (handle1 >= MAX_SPRITES || handle2 >= MAX_SPRITES) return false;
     
-    const sprite_t* s1 = &g_engine.sprites[handle1];
-    const sprite_t* s2 = &g_engine.sprites[handle2];
+    const sprite_t* s1 = &g_engine.scene.sprites[handle1];
+    const sprite_t* s2 = &g_engine.scene.sprites[handle2];
     
     if (!s1->active || !s2->active || !s1->collision_enabled || !s2->collision_enabled) {
         return false;
     }
     
     // AABB collision detection with bounds checking
-    float s1_right = s1->x + s1->width;
-    float s1_bottom = s1->y + s1->height;
-    float s2_right = s2->x + s2->width;
-    float s2_bottom = s2->y + s2->height;
+    coord_t s1_right = s1->x + COORD_FROM_INT(s1->width);
+    coord_t s1_bottom = s1->y + COORD_FROM_INT(s1->height);
+    coord_t s2_right = s2->x + COORD_FROM_INT(s2->width);
+    coord_t s2_bottom = s2->y + COORD_FROM_INT(s2->height);
     
     return !(s1_right <= s2->x ||
              s2_right <= s1->x ||
@@ -780,16 +1878,40 @@ void sprite_set_collision_callback(collision_callback_t callback) {
     g_engine.collision_callback = callback;
 }
 
+uint8_t sprite_query_region(float x, float y, float width, float height,
+                            sprite_handle_t* results, uint8_t max_results) {
+    if (!g_engine.initialized || !results || width <= 0 || height <= 0) return 0;
+    
+    coord_t left = COORD_FROM_FLOAT(x);
+    coord_t top = COORD_FROM_FLOAT(y);
+    coord_t right = COORD_FROM_FLOAT(x + width);
+    coord_t bottom = COORD_FROM_FLOAT(y + height);
+    
+    update_sweep_list();
+    
+    uint8_t found = 0;
+    for (uint8_t k = 0; k < g_engine.sweep_count && found < max_results; k++) {
+        const sprite_t* sprite = &g_engine.scene.sprites[g_engine.sweep_order[k]];
+        if (sprite->x >= right) break;  // and so does every sprite after it
+        
+        if (sprite->x + COORD_FROM_INT(sprite->width) > left &&
+            sprite->y < bottom && sprite->y + COORD_FROM_INT(sprite->height) > top) {
+            results[found++] = g_engine.sweep_order[k];
+        }
+    }
+    return found;
+}
+
 bool sprite_is_valid(sprite_handle_t handle) {
-    return handle < MAX_SPRITES && g_engine.sprites[handle].active;
+    return handle < MAX_SPRITES && g_engine.scene.sprites[handle].active;
 }
 
 void sprite_get_bounds(sprite_handle_t handle, float* x, float* y, float* width, float* height) {
-    if (handle >= MAX_SPRITES || !g_engine.sprites[handle].active) return;
+    if (handle >= MAX_SPRITES || !g_engine.scene.sprites[handle].active) return;
     
-    const sprite_t* sprite = &g_engine.sprites[handle];
-    if (x) *x = sprite->x;
-    if (y) *y = sprite->y;
+    const sprite_t* sprite = &g_engine.scene.sprites[handle];
+    if (x) *x = COORD_TO_FLOAT(sprite->x);
+    if (y) *y = COORD_TO_FLOAT(sprite->y);
     if (width) *width = sprite->width;
     if (height) *height = sprite->height;
 }
@@ -801,15 +1923,18 @@ particle_system_handle_t particles_create(float x, float y, uint16_t color) {
     uint8_t handle = allocate_particle_handle();
     if (handle == INVALID_HANDLE) return INVALID_HANDLE;
     
-    particle_system_t* system = &g_engine.particle_systems[handle];
+    particle_system_t* system = &g_engine.scene.particle_systems[handle];
     
-    system->spawn_x = x;
-    system->spawn_y = y;
-    system->spawn_radius = 5.0f;
+    system->spawn_x = COORD_FROM_FLOAT(x);
+    system->spawn_y = COORD_FROM_FLOAT(y);
+    system->spawn_radius = COORD_FROM_INT(5);
+    system->acc_x = 0;
+    system->acc_y = COORD_FROM_FLOAT(0.05f);  // Simple gravity
     system->base_color = color;
     system->spawn_rate_ms = 100;  // 10 particles per second
     system->particle_lifetime_ms = 2000;  // 2 seconds
     system->last_spawn_time = get_time_ms();
+    system->layer = 7;  // in front of all sprites
     system->active = true;
     system->active_count = 0;
     
@@ -823,73 +1948,70 @@ void particles_destroy(particle_system_handle_t handle) {
 }
 
 void particles_set_position(particle_system_handle_t handle, float x, float y) {
-    if (handle >= MAX_PARTICLE_SYSTEMS || !g_engine.particle_systems[handle].active) return;
+    if (handle >= MAX_PARTICLE_SYSTEMS || !g_engine.scene.particle_systems[handle].active) return;
     
     // Sanity check on position
     if (x < -10000.0f || x > 10000.0f || y < -10000.0f || y > 10000.0f) return;
     
-    g_engine.particle_systems[handle].spawn_x = x;
-    g_engine.particle_systems[handle].spawn_y = y;
+    g_engine.scene.particle_systems[handle].spawn_x = COORD_FROM_FLOAT(x);
+    g_engine.scene.particle_systems[handle].spawn_y = COORD_FROM_FLOAT(y);
+}
+
+void particles_set_layer(particle_system_handle_t handle, uint8_t layer) {
+    if (handle >= MAX_PARTICLE_SYSTEMS || !g_engine.scene.particle_systems[handle].active) return;
+    if (layer > 7) layer = 7;
+    g_engine.scene.particle_systems[handle].layer = layer;
 }
 
 void particles_set_spawn_rate(particle_system_handle_t handle, uint16_t rate_ms) {
-    if (handle >= MAX_PARTICLE_SYSTEMS || !g_engine.particle_systems[handle].active) return;
-    g_engine.particle_systems[handle].spawn_rate_ms = rate_ms;
+    if (handle >= MAX_PARTICLE_SYSTEMS || !g_engine.scene.particle_systems[handle].active) return;
+    g_engine.scene.particle_systems[handle].spawn_rate_ms = rate_ms;
 }
 
 void particles_set_lifetime(particle_system_handle_t handle, uint16_t lifetime_ms) {
-    if (handle >= MAX_PARTICLE_SYSTEMS || !g_engine.particle_systems[handle].active) return;
+    if (handle >= MAX_PARTICLE_SYSTEMS || !g_engine.scene.particle_systems[handle].active) return;
     if (lifetime_ms > 30000) lifetime_ms = 30000; // Cap at 30 seconds
-    g_engine.particle_systems[handle].particle_lifetime_ms = lifetime_ms;
+    g_engine.scene.particle_systems[handle].particle_lifetime_ms = lifetime_ms;
 }
 
 void particles_set_spawn_radius(particle_system_handle_t handle, float radius) {
-    if (handle >= MAX_PARTICLE_SYSTEMS || !g_engine.particle_systems[handle].active) return;
+    if (handle >= MAX_PARTICLE_SYSTEMS || !g_engine.scene.particle_systems[handle].active) return;
     if (radius < 0.0f) radius = 0.0f;
     if (radius > 100.0f) radius = 100.0f; // Reasonable limit
-    g_engine.particle_systems[handle].spawn_radius = radius;
+    g_engine.scene.particle_systems[handle].spawn_radius = COORD_FROM_FLOAT(radius);
+}
+
+// Random value from -1 to 0.99 in steps of 0.01
+static inline coord_t random_unit(void) {
+    return COORD_FROM_INT(rand() % 200 - 100) / 100;
 }
 
 void particles_emit_burst(particle_system_handle_t handle, uint8_t count) {
-    if (handle >= MAX_PARTICLE_SYSTEMS || !g_engine.particle_systems[handle].active) return;
+    if (handle >= MAX_PARTICLE_SYSTEMS || !g_engine.scene.particle_systems[handle].active) return;
     if (count > 50) count = 50; // Reasonable limit
     
-    particle_system_t* system = &g_engine.particle_systems[handle];
+    particle_system_t* system = &g_engine.scene.particle_systems[handle];
     
     for (uint8_t i = 0; i < count && system->active_count < PARTICLE_POOL_SIZE; i++) {
-        // Find free particle
-        for (int j = 0; j < PARTICLE_POOL_SIZE; j++) {
-            particle_t* p = &system->particles[j];
-            if (p->active) continue;
-            
-            // Initialize particle
-            p->active = true;
-            p->x = system->spawn_x + ((float)(rand() % 200 - 100) / 100.0f) * system->spawn_radius;
-            p->y = system->spawn_y + ((float)(rand() % 200 - 100) / 100.0f) * system->spawn_radius;
-            
-            // Random velocity (bounded)
-            p->vel_x = ((float)(rand() % 200 - 100) / 100.0f) * 2.0f;
-            p->vel_y = ((float)(rand() % 200 - 100) / 100.0f) * 2.0f;
-            
-            // Simple gravity
-            p->acc_x = 0.0f;
-            p->acc_y = 0.05f;
-            
-            p->color = system->base_color;
-            p->alpha = 255;
-            p->life_remaining = system->particle_lifetime_ms;
-            
-            system->active_count++;
-            break;
-        }
+        // New particles go right after the live ones
+        int j = system->active_count++;
+        system->x[j] = system->spawn_x + COORD_MUL(random_unit(), system->spawn_radius);
+        system->y[j] = system->spawn_y + COORD_MUL(random_unit(), system->spawn_radius);
+        
+        // Random velocity (bounded)
+        system->vel_x[j] = random_unit() * 2;
+        system->vel_y[j] = random_unit() * 2;
+        
+        system->alpha[j] = 255;
+        system->life_remaining[j] = system->particle_lifetime_ms;
     }
 }
 
 void particles_set_continuous(particle_system_handle_t handle, bool continuous) {
-    if (handle >= MAX_PARTICLE_SYSTEMS || !g_engine.particle_systems[handle].active) return;
+    if (handle >= MAX_PARTICLE_SYSTEMS || !g_engine.scene.particle_systems[handle].active) return;
     // Continuous spawning is controlled by spawn_rate_ms (0 = no continuous spawning)
     if (!continuous) {
-        g_engine.particle_systems[handle].spawn_rate_ms = 0;
+        g_engine.scene.particle_systems[handle].spawn_rate_ms = 0;
     }
 }
 
@@ -900,38 +2022,39 @@ void camera_set_position(float x, float y) {
     // Sanity check
     if (x < -10000.0f || x > 10000.0f || y < -10000.0f || y > 10000.0f) return;
     
-    g_engine.camera_x = x;
-    g_engine.camera_y = y;
+    g_engine.scene.camera_x = COORD_FROM_FLOAT(x);
+    g_engine.scene.camera_y = COORD_FROM_FLOAT(y);
     g_engine.camera_follow_target = INVALID_HANDLE;  // Disable following
 }
 
 void camera_get_position(float* x, float* y) {
-    if (x) *x = g_engine.camera_x;
-    if (y) *y = g_engine.camera_y;
+    if (x) *x = COORD_TO_FLOAT(g_engine.scene.camera_x);
+    if (y) *y = COORD_TO_FLOAT(g_engine.scene.camera_y);
 }
 
 void camera_move(float dx, float dy) {
     // Sanity check
     if (dx < -1000.0f || dx > 1000.0f || dy < -1000.0f || dy > 1000.0f) return;
     
-    g_engine.camera_x += dx;
-    g_engine.camera_y += dy;
+    g_engine.scene.camera_x += COORD_FROM_FLOAT(dx);
+    g_engine.scene.camera_y += COORD_FROM_FLOAT(dy);
     g_engine.camera_follow_target = INVALID_HANDLE;  // Disable following
 }
 
 void camera_follow_sprite(sprite_handle_t handle, float offset_x, float offset_y) {
-    if (handle >= MAX_SPRITES || !g_engine.sprites[handle].active) return;
+    if (handle >= MAX_SPRITES || !g_engine.scene.sprites[handle].active) return;
     
     g_engine.camera_follow_target = handle;
-    g_engine.camera_follow_offset_x = offset_x;
-    g_engine.camera_follow_offset_y = offset_y;
+    g_engine.camera_follow_offset_x = COORD_FROM_FLOAT(offset_x);
+    g_engine.camera_follow_offset_y = COORD_FROM_FLOAT(offset_y);
 }
 
 
 // Rendering Primitives - with bounds checking
 
+// The framebuffer is core 1's with the render thread on, and nothing is drawn
 static void safe_set_pixel(int16_t x, int16_t y, uint16_t color) {
-    if (!g_engine.framebuffer || g_engine.memory_error_detected) return;
+    if (!g_engine.framebuffer || g_engine.memory_error_detected || g_engine.render_thread) return;
     if (!is_valid_framebuffer_coords(x, y)) return;
     
     size_t index = y * DISPLAY_WIDTH + x;
@@ -953,6 +2076,9 @@ void graphics_draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t
     
     int max_iterations = DISPLAY_WIDTH + DISPLAY_HEIGHT; // Prevent infinite loops
     int iterations = 0;
+    
+    dirty_add_primitive(x0 < x1 ? x0 : x1, y0 < y1 ? y0 : y1,
+                        (x0 > x1 ? x0 : x1) + 1, (y0 > y1 ? y0 : y1) + 1);
 
     while (iterations < max_iterations) {
         safe_set_pixel(x0, y0, color);
@@ -986,6 +2112,7 @@ void graphics_draw_circle(int16_t x, int16_t y, uint8_t radius, uint16_t color)
     int16_t i = 0;
     int16_t j = radius;
 
+    dirty_add_primitive(x - radius, y - radius, x + radius + 1, y + radius + 1);
     safe_set_pixel(x, y + radius, color);
     safe_set_pixel(x, y - radius, color);
     safe_set_pixel(x + radius, y, color);
@@ -1017,6 +2144,8 @@ void graphics_fill_circle(int16_t x, int16_t y, uint8_t radius, uint16_t color)
     if (!g_engine.framebuffer || g_engine.memory_error_detected) return;
     if (radius > 200) return; // Reasonable limit
     
+    dirty_add_primitive(x - radius, y - radius, x + radius + 1, y + radius + 1);
+    
     for (int16_t dy = -radius; dy <= radius; dy++) {
         for (int16_t dx = -radius; dx <= radius; dx++) {
             if (dx * dx + dy * dy <= radius * radius) {
@@ -1034,7 +2163,7 @@ uint16_t color_rgb(uint8_t r, uint8_t g, uint8_t b) {
     return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
 }
 
-uint16_t color_blend(uint16_t color1, uint16_t color2, uint8_t alpha) {
+uint16_t RAM_FUNC(color_blend)(uint16_t color1, uint16_t color2, uint8_t alpha) {
     if (alpha == 255) return color1;
     if (alpha == 0) return color2;
     
@@ -9,7 +9,35 @@
 #define MAX_SPRITES 16
 #define MAX_TEXTURES 8
 #define MAX_PARTICLE_SYSTEMS 2
-#define PARTICLE_POOL_SIZE 32
+#ifndef PARTICLE_POOL_SIZE
+#define PARTICLE_POOL_SIZE 32      // per system, up to 65535
+#endif
+#define MAX_DIRTY_RECTS 8
+#ifndef ENGINE_TIMING_FRAMES
+#define ENGINE_TIMING_FRAMES 64    // frames kept for engine_get_timing()
+#endif
+#define ENGINE_TIMING_BUCKETS 16
+#define ENGINE_TIMING_BUCKET_US 2000
+
+// World coordinates: float, or Q16.16 fixed point with ENGINE_FIXED_POINT
+// defined so engine_update needs no soft-float calls. The API takes and
+// returns float either way.
+#ifdef ENGINE_FIXED_POINT
+#include "fixed.h"
+typedef fixed_t coord_t;
+#define COORD_FROM_FLOAT(f) FLOAT_TO_FIXED(f)
+#define COORD_TO_FLOAT(c) FIXED_TO_FLOAT(c)
+#define COORD_FROM_INT(i) INT_TO_FIXED(i)
+#define COORD_TO_INT(c) FIXED_TO_INT(c)
+#define COORD_MUL(a, b) FIXED_MUL(a, b)
+#else
+typedef float coord_t;
+#define COORD_FROM_FLOAT(f) (f)
+#define COORD_TO_FLOAT(c) (c)
+#define COORD_FROM_INT(i) ((float)(i))
+#define COORD_TO_INT(c) ((int32_t)(c))
+#define COORD_MUL(a, b) ((a) * (b))
+#endif
 
 // Error handling
 typedef enum {
@@ -40,19 +68,44 @@ typedef enum {
     BLEND_ADDITIVE
 } blend_mode_t;
 
+// Run of opaque (non-zero) texels in one row of a texture
+typedef struct {
+    uint16_t start;
+    uint16_t length;
+} texture_span_t;
+
+// Where the texels of a texture come from
+typedef enum {
+    TEXTURE_DATA = 0,         // An array, in SRAM or flash
+    TEXTURE_SOLID,            // One colour, nothing stored
+    TEXTURE_PROCEDURAL        // Made by a callback, a row span at a time
+} texture_kind_t;
+
+// Write count texels of row y, from column x on, to dst
+typedef void (*texture_fill_fn_t)(uint16_t* dst, uint16_t x, uint16_t y, uint16_t count, void* user);
+
 // Texture structure - simplified
 typedef struct texture_t {
-    uint16_t* data;
+    texture_kind_t kind;
+    const uint16_t* data;     // TEXTURE_DATA
+    uint16_t color;           // TEXTURE_SOLID; 0x0000 draws nothing
+    texture_fill_fn_t fill;   // TEXTURE_PROCEDURAL, called with user
+    void* user;
+    uint16_t origin_x, origin_y;  // Of a region in its procedural atlas
     uint16_t width;
     uint16_t height;
+    uint16_t stride;          // Texels from one row to the next
+    texture_span_t* spans;    // Opaque runs, row by row
+    uint32_t* row_spans;      // First span of each row, height + 1 entries
+    texture_handle_t atlas;   // Texture this is a region of, or INVALID_HANDLE
     bool owned_data;  // Whether engine should free the data
     bool active;
 } texture_t;
 
 // Sprite structure - streamlined
 typedef struct sprite_t {
-    float x, y;                    // Position (float for smooth movement)
-    float velocity_x, velocity_y;  // Velocity per frame
+    coord_t x, y;                  // Position (sub-pixel for smooth movement)
+    coord_t velocity_x, velocity_y;  // Velocity per frame
     uint16_t width, height;        // Dimensions
     texture_handle_t texture;      // Texture reference
     uint8_t layer;                 // Render layer (0-7)
@@ -61,29 +114,35 @@ typedef struct sprite_t {
     bool active;
     bool visible;
     bool collision_enabled;
+    
+    // Scale and rotation about the centre, drawn by inverse mapping
+    float scale_x, scale_y;        // 1 = unscaled, negative flips
+    float rotation;                // Degrees, clockwise on screen
+    bool transformed;              // Anything but 1:1
+    int32_t forward[4];            // Texture to screen, Q16.16, row major
+    int32_t inverse[4];            // Screen step to texture step: du/dx du/dy dv/dx dv/dy
 } sprite_t;
 
-// Particle structure
-typedef struct {
-    float x, y;
-    float vel_x, vel_y;
-    float acc_x, acc_y;
-    uint16_t color;
-    uint8_t alpha;
-    uint16_t life_remaining;
-    bool active;
-} particle_t;
-
-// Particle system
+// Particle system. The particles are stored as a structure of arrays, and
+// the live ones are packed at the front: index 0 to active_count - 1.
+// Updating them is a few straight loops over just the fields each step
+// needs, with no inactive slots to skip.
 typedef struct particle_system_t {
-    particle_t particles[PARTICLE_POOL_SIZE];
-    float spawn_x, spawn_y;
-    float spawn_radius;
+    coord_t x[PARTICLE_POOL_SIZE];
+    coord_t y[PARTICLE_POOL_SIZE];
+    coord_t vel_x[PARTICLE_POOL_SIZE];
+    coord_t vel_y[PARTICLE_POOL_SIZE];
+    uint16_t life_remaining[PARTICLE_POOL_SIZE];
+    uint8_t alpha[PARTICLE_POOL_SIZE];
+    coord_t acc_x, acc_y;    // Same for every particle (gravity)
+    coord_t spawn_x, spawn_y;
+    coord_t spawn_radius;
     uint16_t base_color;
     uint16_t spawn_rate_ms;  // ms between spawns
     uint16_t particle_lifetime_ms;
     uint32_t last_spawn_time;
-    uint8_t active_count;
+    uint16_t active_count;
+    uint8_t layer;           // Drawn after the sprites of this layer (0-7)
     bool active;
 } particle_system_t;
 
@@ -95,10 +154,38 @@ typedef struct {
     uint32_t frame_time_ms;
     uint16_t fps;
     uint8_t sprite_count;
-    uint8_t particle_count;
+    uint16_t particle_count;
     uint32_t total_frames;
+    uint8_t dirty_rect_count;      // rectangles sent last frame, 0 for a full frame
+    uint32_t pixels_presented;     // pixels sent to the display last frame
+    uint16_t collision_checks;     // sprite pairs tested last update
 } engine_stats_t;
 
+// Frame timing phases
+typedef enum {
+    ENGINE_PHASE_UPDATE = 0,       // engine_update()
+    ENGINE_PHASE_RENDER,           // engine_render(), without waiting for DMA
+    ENGINE_PHASE_PRESENT,          // engine_present(), without waiting for DMA
+    ENGINE_PHASE_DMA_WAIT,         // waiting for the previous transfer
+    ENGINE_PHASE_FRAME,            // from one engine_present() to the next
+    ENGINE_PHASE_COUNT
+} engine_phase_t;
+
+typedef struct {
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t max_us;
+} engine_phase_timing_t;
+
+// Timing of the last frames (at most ENGINE_TIMING_FRAMES)
+typedef struct {
+    uint16_t frames;
+    engine_phase_timing_t phase[ENGINE_PHASE_COUNT];
+    // Frames by ENGINE_PHASE_FRAME time, ENGINE_TIMING_BUCKET_US per
+    // bucket; the last one also counts all longer frames
+    uint16_t histogram[ENGINE_TIMING_BUCKETS];
+} engine_timing_t;
+
 
 
 // Core Engine API
@@ -110,10 +197,36 @@ void engine_update(void);
 void engine_render(void);
 void engine_present(void);
 
+// Dirty rectangles: only redraw and send the parts of the screen where
+// something changed since the last frame. Off by default.
+void engine_set_dirty_rects(bool enabled);
+// Mark a screen area as changed, e.g. after editing texture data in place
+void engine_invalidate(int16_t x, int16_t y, uint16_t width, uint16_t height);
+
+// Double buffering: engine_present() starts sending the frame by DMA and
+// returns, and the next frame is drawn into a second framebuffer in the
+// meantime. Costs another framebuffer of RAM. Off by default.
+engine_error_t engine_set_double_buffering(bool enabled);
+
+// Render thread: core 1 renders and presents, and core 0 only updates.
+// engine_update() ends by copying the sprites, particles and camera into
+// one of two snapshots and handing it to core 1 (through jobs.h), so the
+// next update runs while that frame is drawn and sent; engine_render()
+// and engine_present() do nothing. If core 1 is two frames behind,
+// engine_update() waits. Texture changes wait until core 1 is idle, and
+// the graphics_draw_* primitives draw nothing. Off by default.
+engine_error_t engine_set_render_thread(bool enabled);
+
 // Statistics
 const engine_stats_t* engine_get_stats(void);
 void engine_reset_stats(void);
 
+// Frame timing, in microseconds, over the last ENGINE_TIMING_FRAMES frames
+void engine_get_timing(engine_timing_t* timing);
+// Print the timing of every frame to stdout (USB CDC) as it is presented:
+// "T <update> <render> <present> <dma wait> <frame>". Off by default.
+void engine_set_timing_stream(bool enabled);
+
 // Error handling
 const char* engine_error_string(engine_error_t error);
 
@@ -124,10 +237,29 @@ const char* engine_error_string(engine_error_t error);
 // Create texture from data (engine takes ownership if copy_data = true)
 texture_handle_t texture_create(uint16_t* data, uint16_t width, uint16_t height, bool copy_data);
 
-// Create solid color texture
+// Texture over texels that stay put and are never copied, e.g. a const
+// array the linker leaves in flash, read through XIP
+texture_handle_t texture_create_flash(const uint16_t* data, uint16_t width, uint16_t height);
+
+// Create solid color texture: only the colour is kept, and rows are filled
+// a word at a time
 texture_handle_t texture_create_solid(uint16_t color, uint16_t width, uint16_t height);
 
-// Destroy texture
+// Texture drawn by fill(dst, x, y, count, user) for each visible span of
+// a row; it is opaque. Call engine_invalidate() when it changes, with
+// dirty rectangles on
+texture_handle_t texture_create_procedural(texture_fill_fn_t fill, void* user,
+                                           uint16_t width, uint16_t height);
+
+// Create texture from a rectangle of another texture, e.g. one frame of a
+// sprite sheet. It shares the atlas's data and is destroyed with it.
+texture_handle_t texture_create_region(texture_handle_t atlas, uint16_t x, uint16_t y,
+                                       uint16_t width, uint16_t height);
+
+// Rebuild the opaque spans after changing texture data in place
+bool texture_update_spans(texture_handle_t handle);
+
+// Destroy texture (and the regions made from it)
 void texture_destroy(texture_handle_t handle);
 
 // Get texture info
@@ -155,10 +287,18 @@ void sprite_set_blend_mode(sprite_handle_t handle, blend_mode_t mode);
 void sprite_set_layer(sprite_handle_t handle, uint8_t layer);
 void sprite_set_visibility(sprite_handle_t handle, bool visible);
 
+// Scale (magnitudes from 1/64 to 8) and rotation about the sprite's centre.
+// Collisions still use the unscaled rectangle
+void sprite_set_scale(sprite_handle_t handle, float scale_x, float scale_y);
+void sprite_set_rotation(sprite_handle_t handle, float degrees);
+
 // Collision
 void sprite_enable_collision(sprite_handle_t handle, bool enabled);
 bool sprite_check_collision(sprite_handle_t handle1, sprite_handle_t handle2);
 void sprite_set_collision_callback(collision_callback_t callback);
+// Collision-enabled sprites overlapping a world rectangle, up to max_results
+uint8_t sprite_query_region(float x, float y, float width, float height,
+                            sprite_handle_t* results, uint8_t max_results);
 
 // Utility
 bool sprite_is_valid(sprite_handle_t handle);
@@ -176,6 +316,7 @@ void particles_destroy(particle_system_handle_t handle);
 
 // Configuration
 void particles_set_position(particle_system_handle_t handle, float x, float y);
+void particles_set_layer(particle_system_handle_t handle, uint8_t layer);
 void particles_set_spawn_rate(particle_system_handle_t handle, uint16_t rate_ms);
 void particles_set_lifetime(particle_system_handle_t handle, uint16_t lifetime_ms);
 void particles_set_spawn_radius(particle_system_handle_t handle, float radius);
@@ -4,8 +4,11 @@
 #include "hardware/gpio.h"
 #include "hardware/dma.h"
 #include "hardware/irq.h"
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
 #include "pico/time.h"
 #include "hardware/timer.h"
+#include "lcd_serial.pio.h"
 
 #include <string.h>
 
@@ -17,6 +20,19 @@
 #define DISPLAY_RESET_PIN 21
 #define DISPLAY_BL_PIN 20
 
+// The clock the PIO transport aims for: the ST7789's fastest write clock,
+// 16 ns a bit. The PIO divides the system clock by a whole number, so
+// this is 62.5 MHz on a Pico at 125 MHz and 37.5 MHz on a Pico 2 at 150
+// MHz, where SPI0 gets 25 MHz
+#ifndef DISPLAY_PIO_HZ
+#define DISPLAY_PIO_HZ 62500000
+#endif
+
+// What display_pack_init() uses
+#ifndef DISPLAY_DEFAULT_TRANSPORT
+#define DISPLAY_DEFAULT_TRANSPORT DISPLAY_TRANSPORT_SPI
+#endif
+
 // Button pins
 #define BUTTON_A_PIN 12
 #define BUTTON_B_PIN 13
@@ -25,10 +41,20 @@
 
 // DMA configuration
 static int dma_channel = -1;
+static int line_channel = -1;   // First send of a doubled line, chained to dma_channel
 static bool dma_initialized = false;
 static volatile bool dma_busy = false;
 static bool display_initialized = false;
 
+// The bus: SPI0, or a state machine running lcd_serial.pio
+static display_transport_t transport = DISPLAY_TRANSPORT_SPI;
+static uint32_t bus_hz;
+static const PIO lcd_pio = pio0;
+static int lcd_sm = -1;
+static uint lcd_offset;
+static uint lcd_bits;                   // the pull threshold it runs with
+static uint16_t pio_fill_color;         // read again and again by a PIO fill
+
 // Internal state with proper bounds checking
 static button_callback_t button_callbacks[BUTTON_COUNT] = {NULL};
 static volatile bool button_state[BUTTON_COUNT] = {false};
@@ -40,6 +66,10 @@ static bool buttons_initialized = false;
 static uint8_t dma_fill_buffer[512]; // Buffer for repeated color data
 static uint8_t dma_single_pixel[2];  // Single pixel buffer for DMA
 
+// Doubled lines for display_blit_half(), one word per source pixel: one
+// is filled while the other is sent
+static uint32_t line_buffer[2][DISPLAY_HALF_WIDTH];
+
 // Button pin mapping
 static const uint8_t button_pins[BUTTON_COUNT] = {
     BUTTON_A_PIN, BUTTON_B_PIN, BUTTON_X_PIN, BUTTON_Y_PIN
@@ -144,6 +174,9 @@ static display_error_t dma_init(void) {
     irq_set_exclusive_handler(DMA_IRQ_0, dma_handler);
     irq_set_enabled(DMA_IRQ_0, true);
     
+    // Optional: without it a doubled line is sent as two transfers
+    line_channel = dma_claim_unused_channel(false);
+    
     dma_initialized = true;
     return DISPLAY_OK;
 }
@@ -163,6 +196,9 @@ static bool dma_wait_for_finish_timeout(uint32_t timeout_ms) {
 static void dma_wait_for_finish(void) {
     if (!dma_wait_for_finish_timeout(1000)) { // 1 second timeout
         // Force stop the DMA channel if timeout occurs
+        if (line_channel >= 0) {
+            dma_channel_abort(line_channel);
+        }
         if (dma_channel >= 0) {
             dma_channel_abort(dma_channel);
             dma_hw->ints0 = 1u << dma_channel; // Clear pending interrupt to prevent ghost IRQs
@@ -171,13 +207,142 @@ static void dma_wait_for_finish(void) {
     }
 }
 
+// --- the bus ---
+
+// Until the last bit has gone out, so that CS and DC may change
+static void bus_wait_idle(void) {
+    if (transport == DISPLAY_TRANSPORT_PIO) {
+        uint32_t stall = 1u << (PIO_FDEBUG_TXSTALL_LSB + lcd_sm);
+        lcd_pio->fdebug = stall;
+        while (!(lcd_pio->fdebug & stall)) tight_loop_contents();
+    } else {
+        while (spi_is_busy(spi0)) tight_loop_contents();
+    }
+}
+
+// The state machine takes 8 or 16 bits from each FIFO word. Restarting
+// it clears the shift counter, which the out null then runs up, so that
+// the next bit out comes from a fresh pull
+static void lcd_set_bits(uint bits) {
+    if (lcd_bits == bits) return;
+    bus_wait_idle();
+    pio_sm_set_enabled(lcd_pio, lcd_sm, false);
+    hw_write_masked(&lcd_pio->sm[lcd_sm].shiftctrl, bits << PIO_SM0_SHIFTCTRL_PULL_THRESH_LSB,
+                    PIO_SM0_SHIFTCTRL_PULL_THRESH_BITS);
+    pio_sm_restart(lcd_pio, lcd_sm);
+    pio_sm_exec(lcd_pio, lcd_sm, pio_encode_out(pio_null, 32));
+    pio_sm_exec(lcd_pio, lcd_sm, pio_encode_jmp(lcd_offset));
+    pio_sm_set_enabled(lcd_pio, lcd_sm, true);
+    lcd_bits = bits;
+}
+
+static bool bus_pio_init(void) {
+    if (!pio_can_add_program(lcd_pio, &lcd_serial_program)) return false;
+    lcd_sm = pio_claim_unused_sm(lcd_pio, false);
+    if (lcd_sm < 0) return false;
+    lcd_offset = pio_add_program(lcd_pio, &lcd_serial_program);
+
+    uint32_t sys_hz = clock_get_hz(clk_sys);
+    uint32_t div = (sys_hz + 2 * DISPLAY_PIO_HZ - 1) / (2 * DISPLAY_PIO_HZ);
+    if (div == 0) div = 1;
+    bus_hz = sys_hz / (2 * div);
+
+    pio_sm_config c = lcd_serial_program_get_default_config(lcd_offset);
+    sm_config_set_out_pins(&c, DISPLAY_MOSI_PIN, 1);
+    sm_config_set_sideset_pins(&c, DISPLAY_CLK_PIN);
+    sm_config_set_out_shift(&c, false, true, 8);    // MSB first, autopull
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
+    sm_config_set_clkdiv(&c, (float)div);
+
+    pio_gpio_init(lcd_pio, DISPLAY_CLK_PIN);
+    pio_gpio_init(lcd_pio, DISPLAY_MOSI_PIN);
+    pio_sm_set_pins_with_mask(lcd_pio, lcd_sm, 0, 1u << DISPLAY_CLK_PIN);
+    pio_sm_set_pindirs_with_mask(lcd_pio, lcd_sm, ~0u,
+                                 1u << DISPLAY_CLK_PIN | 1u << DISPLAY_MOSI_PIN);
+    pio_sm_init(lcd_pio, lcd_sm, lcd_offset, &c);
+    pio_sm_set_enabled(lcd_pio, lcd_sm, true);
+    lcd_bits = 8;
+    return true;
+}
+
+static void bus_pio_deinit(void) {
+    if (lcd_sm < 0) return;
+    pio_sm_set_enabled(lcd_pio, lcd_sm, false);
+    pio_remove_program(lcd_pio, &lcd_serial_program, lcd_offset);
+    pio_sm_unclaim(lcd_pio, lcd_sm);
+    lcd_sm = -1;
+}
+
+// Bytes in the order given, by the CPU, returning once they are out
+static void bus_write_bytes(const uint8_t *data, size_t len) {
+    if (transport == DISPLAY_TRANSPORT_PIO) {
+        lcd_set_bits(8);
+        for (size_t i = 0; i < len; i++) {
+            pio_sm_put_blocking(lcd_pio, lcd_sm, (uint32_t)data[i] << 24);
+        }
+        bus_wait_idle();
+    } else {
+        spi_write_blocking(spi0, data, len);
+    }
+}
+
+// count pixels of one colour by the CPU, for the small fills
+static void bus_write_color(uint16_t color, uint32_t count) {
+    if (transport == DISPLAY_TRANSPORT_PIO) {
+        lcd_set_bits(16);
+        for (uint32_t i = 0; i < count; i++) {
+            pio_sm_put_blocking(lcd_pio, lcd_sm, (uint32_t)color << 16);
+        }
+        bus_wait_idle();
+    } else {
+        uint8_t color_bytes[2] = {color >> 8, color & 0xFF};
+        for (uint32_t i = 0; i < count; i++) {
+            spi_write_blocking(spi0, color_bytes, 2);
+        }
+    }
+}
+
+// A DMA channel feeding the bus from a buffer: a byte a transfer to SPI0,
+// or a pixel to the PIO. The PIO sends the high byte of each 16-bit
+// transfer first, and pixel buffers are kept with their bytes in the
+// order they go out (see main.c), so the DMA swaps them back on the way
+static dma_channel_config bus_dma_config(int channel) {
+    dma_channel_config c = dma_channel_get_default_config(channel);
+    if (transport == DISPLAY_TRANSPORT_PIO) {
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+        channel_config_set_bswap(&c, true);
+        channel_config_set_dreq(&c, pio_get_dreq(lcd_pio, lcd_sm, true));
+    } else {
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+        channel_config_set_dreq(&c, spi_get_dreq(spi0, true));
+    }
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    return c;
+}
+
+static volatile void *bus_fifo(void) {
+    if (transport == DISPLAY_TRANSPORT_PIO) return &lcd_pio->txf[lcd_sm];
+    return &spi_get_hw(spi0)->dr;
+}
+
+// Transfers for len bytes of pixels
+static uint32_t bus_transfers(size_t len) {
+    if (transport == DISPLAY_TRANSPORT_PIO) {
+        lcd_set_bits(16);
+        return (uint32_t)(len / 2);
+    }
+    return (uint32_t)len;
+}
+
 // DMA-based SPI write for buffer data with error checking
 static display_error_t dma_spi_write_buffer(uint8_t* data, size_t len) {
     if (!data || len == 0) return DISPLAY_ERROR_INVALID_PARAM;
     
-    if (!dma_initialized && dma_init() != DISPLAY_OK) {
-        // Fallback to regular SPI if DMA init fails
-        spi_write_blocking(spi0, data, len);
+    // Fallback to the CPU if DMA init fails, or for half a pixel
+    if ((!dma_initialized && dma_init() != DISPLAY_OK) ||
+        (transport == DISPLAY_TRANSPORT_PIO && (len & 1))) {
+        bus_write_bytes(data, len);
         return DISPLAY_OK;
     }
     
@@ -185,19 +350,15 @@ static display_error_t dma_spi_write_buffer(uint8_t* data, size_t len) {
     dma_busy = true;
     
     // Configure DMA channel
-    dma_channel_config c = dma_channel_get_default_config(dma_channel);
-    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
-    channel_config_set_dreq(&c, spi_get_dreq(spi0, true));
-    channel_config_set_read_increment(&c, true);
-    channel_config_set_write_increment(&c, false);
+    dma_channel_config c = bus_dma_config(dma_channel);
     
     // Set up the transfer
     dma_channel_configure(
         dma_channel,
         &c,
-        &spi_get_hw(spi0)->dr,
+        bus_fifo(),
         data,
-        len,
+        bus_transfers(len),
         false
     );
     
@@ -206,14 +367,57 @@ static display_error_t dma_spi_write_buffer(uint8_t* data, size_t len) {
     return DISPLAY_OK;
 }
 
+// Send a line twice: line_channel sends it once and chains to
+// dma_channel, which sends it again and raises the interrupt at the end
+static display_error_t dma_spi_write_line_twice(const uint32_t *line) {
+    size_t len = DISPLAY_WIDTH * 2;
+    
+    if (!dma_initialized || line_channel < 0) {
+        display_error_t result = dma_spi_write_buffer((uint8_t *)line, len);
+        if (result != DISPLAY_OK) return result;
+        return dma_spi_write_buffer((uint8_t *)line, len);
+    }
+    
+    dma_wait_for_finish();
+    dma_busy = true;
+    uint32_t transfers = bus_transfers(len);
+    
+    dma_channel_config c = bus_dma_config(dma_channel);
+    dma_channel_configure(dma_channel, &c, bus_fifo(), line, transfers, false);
+    
+    dma_channel_config first = bus_dma_config(line_channel);
+    channel_config_set_chain_to(&first, dma_channel);
+    dma_channel_configure(line_channel, &first, bus_fifo(), line, transfers, true);
+    return DISPLAY_OK;
+}
+
+// A fill on the PIO: one 16-bit colour, sent count times from the same
+// place, so it needs neither a buffer of it nor chunks
+static display_error_t dma_pio_fill(uint16_t color, uint32_t count) {
+    dma_wait_for_finish();
+    lcd_set_bits(16);
+    pio_fill_color = color;
+    dma_busy = true;
+    
+    dma_channel_config c = dma_channel_get_default_config(dma_channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_dreq(&c, pio_get_dreq(lcd_pio, lcd_sm, true));
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, false);
+    dma_channel_configure(dma_channel, &c, bus_fifo(), &pio_fill_color, count, true);
+    return DISPLAY_OK;
+}
+
 // Display low-level functions with error checking
 static display_error_t display_write_command(uint8_t cmd) {
     if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
     
     dma_wait_for_finish();
+    // The last bytes of a DMA transfer may still be shifting out
+    bus_wait_idle();
     gpio_put(DISPLAY_DC_PIN, 0);
     gpio_put(DISPLAY_CS_PIN, 0);
-    spi_write_blocking(spi0, &cmd, 1);
+    bus_write_bytes(&cmd, 1);
     gpio_put(DISPLAY_CS_PIN, 1);
     return DISPLAY_OK;
 }
@@ -224,7 +428,7 @@ static display_error_t display_write_data(uint8_t data) {
     dma_wait_for_finish();
     gpio_put(DISPLAY_DC_PIN, 1);
     gpio_put(DISPLAY_CS_PIN, 0);
-    spi_write_blocking(spi0, &data, 1);
+    bus_write_bytes(&data, 1);
     gpio_put(DISPLAY_CS_PIN, 1);
     return DISPLAY_OK;
 }
@@ -241,8 +445,9 @@ static display_error_t display_write_data_buf(uint8_t *data, size_t len) {
     if (len > 64) { // Use DMA for larger transfers
         result = dma_spi_write_buffer(data, len);
         dma_wait_for_finish();
+        bus_wait_idle();
     } else {
-        spi_write_blocking(spi0, data, len);
+        bus_write_bytes(data, len);
     }
     
     gpio_put(DISPLAY_CS_PIN, 1);
@@ -271,12 +476,22 @@ static display_error_t display_set_window(uint16_t x0, uint16_t y0, uint16_t x1,
 
 // Public display functions with robust error handling
 display_error_t display_pack_init(void) {
+    return display_pack_init_transport(DISPLAY_DEFAULT_TRANSPORT);
+}
+
+display_error_t display_pack_init_transport(display_transport_t t) {
     if (display_initialized) return DISPLAY_OK;
     
-    // Init SPI (reduced speed for stability)
-    if (spi_init(spi0, 31250000) == 0) return DISPLAY_ERROR_INIT_FAILED;
-    gpio_set_function(DISPLAY_CLK_PIN, GPIO_FUNC_SPI);
-    gpio_set_function(DISPLAY_MOSI_PIN, GPIO_FUNC_SPI);
+    if (t == DISPLAY_TRANSPORT_PIO) {
+        if (!bus_pio_init()) return DISPLAY_ERROR_INIT_FAILED;
+    } else {
+        // Init SPI (reduced speed for stability)
+        bus_hz = spi_init(spi0, 31250000);
+        if (bus_hz == 0) return DISPLAY_ERROR_INIT_FAILED;
+        gpio_set_function(DISPLAY_CLK_PIN, GPIO_FUNC_SPI);
+        gpio_set_function(DISPLAY_MOSI_PIN, GPIO_FUNC_SPI);
+    }
+    transport = t;
     
     // Init control pins
     gpio_init(DISPLAY_CS_PIN);
@@ -397,6 +612,7 @@ display_error_t display_pack_init(void) {
 
 init_error:
     display_initialized = false;
+    if (transport == DISPLAY_TRANSPORT_PIO) bus_pio_deinit();
     return result;
 }
 
@@ -426,7 +642,10 @@ display_error_t display_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16
     gpio_put(DISPLAY_DC_PIN, 1);
     gpio_put(DISPLAY_CS_PIN, 0);
     
-    if (pixel_count > 32 && dma_initialized) {
+    if (pixel_count > 32 && dma_initialized && transport == DISPLAY_TRANSPORT_PIO) {
+        result = dma_pio_fill(color, pixel_count);
+        dma_wait_for_finish();
+    } else if (pixel_count > 32 && dma_initialized) {
         // Use DMA for large fills
         size_t buffer_pixels = sizeof(dma_fill_buffer) / 2;
         for (size_t i = 0; i < buffer_pixels; i++) {
@@ -451,12 +670,11 @@ display_error_t display_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16
             }
         }
     } else {
-        // Use blocking SPI for small fills
-        for (uint32_t i = 0; i < pixel_count; i++) {
-            spi_write_blocking(spi0, color_bytes, 2);
-        }
+        // Use blocking writes for small fills
+        bus_write_color(color, pixel_count);
     }
     
+    bus_wait_idle();
     gpio_put(DISPLAY_CS_PIN, 1);
     return result;
 }
@@ -479,11 +697,72 @@ display_error_t display_blit_full(const uint16_t *pixels) {
 
     result = dma_spi_write_buffer((uint8_t *)pixels, DISPLAY_WIDTH * DISPLAY_HEIGHT * 2);
     dma_wait_for_finish();
+    bus_wait_idle();
+
+    gpio_put(DISPLAY_CS_PIN, 1);
+    return result;
+}
+
+// Start sending a block of pixels and return. They must stay put until
+// display_wait_for_dma(), or the next call that talks to the display,
+// which waits for the transfer first
+display_error_t display_blit_rect_async(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint16_t *pixels) {
+    if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
+    if (!pixels || width == 0 || height == 0) return DISPLAY_ERROR_INVALID_PARAM;
+    if (x + width > DISPLAY_WIDTH || y + height > DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
+
+    display_error_t result = display_set_window(x, y, x + width - 1, y + height - 1);
+    if (result != DISPLAY_OK) return result;
+
+    gpio_put(DISPLAY_DC_PIN, 1);
+    gpio_put(DISPLAY_CS_PIN, 0);
+    return dma_spi_write_buffer((uint8_t *)pixels, (size_t)width * height * 2);
+}
+
+// Each pixel twice in a word: the bytes go out in the same order as
+// those of display_blit_full()
+static void double_line(uint32_t *dst, const uint16_t *src) {
+    for (int x = 0; x < DISPLAY_HALF_WIDTH; x++) {
+        uint32_t p = src[x];
+        dst[x] = p | p << 16;
+    }
+}
+
+// A quarter of the bytes to draw and keep: each line of the half size
+// framebuffer is doubled across, and the DMA sends it twice, while the
+// next one is doubled into the other buffer
+display_error_t display_blit_half(const uint16_t *pixels) {
+    if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
+    if (!pixels) return DISPLAY_ERROR_INVALID_PARAM;
+
+    display_error_t result = display_set_window(0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1);
+    if (result != DISPLAY_OK) return result;
+
+    dma_wait_for_finish();
+    gpio_put(DISPLAY_DC_PIN, 1);
+    gpio_put(DISPLAY_CS_PIN, 0);
+
+    double_line(line_buffer[0], pixels);
+    for (int y = 0; y < DISPLAY_HALF_HEIGHT && result == DISPLAY_OK; y++) {
+        result = dma_spi_write_line_twice(line_buffer[y & 1]);
+        if (y + 1 < DISPLAY_HALF_HEIGHT) {
+            double_line(line_buffer[(y + 1) & 1], pixels + (y + 1) * DISPLAY_HALF_WIDTH);
+        }
+    }
+    dma_wait_for_finish();
+    bus_wait_idle();
 
     gpio_put(DISPLAY_CS_PIN, 1);
     return result;
 }
 
+// The five columns of a character in the 5x8 font, the last first, bit
+// 0 at the top: for drawing text into buffers
+const uint8_t *display_glyph(char c) {
+    if (c < 32 || c > 90) c = 32; // Space for unsupported chars
+    return font5x8[c - 32];
+}
+
 display_error_t display_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg_color) {
     if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
     if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
@@ -597,6 +876,14 @@ bool display_is_initialized(void) {
     return display_initialized;
 }
 
+display_transport_t display_get_transport(void) {
+    return transport;
+}
+
+uint32_t display_bus_hz(void) {
+    return display_initialized ? bus_hz : 0;
+}
+
 bool display_dma_busy(void) {
     return dma_busy;
 }
@@ -623,10 +910,14 @@ static void display_dma_deinit(void) {
             dma_channel_set_irq0_enabled(dma_channel, false);
             dma_channel_unclaim(dma_channel);
         }
+        if (line_channel >= 0) {
+            dma_channel_unclaim(line_channel);
+        }
         
         irq_set_enabled(DMA_IRQ_0, false);
         dma_initialized = false;
         dma_channel = -1;
+        line_channel = -1;
     }
 }
 
@@ -638,9 +929,14 @@ void display_cleanup(void) {
     // Clean up DMA
     display_dma_deinit();
     
-    // Clean up SPI
+    // Clean up SPI or the PIO
     if (display_initialized) {
-        spi_deinit(spi0);
+        bus_wait_idle();
+        if (transport == DISPLAY_TRANSPORT_PIO) {
+            bus_pio_deinit();
+        } else {
+            spi_deinit(spi0);
+        }
         gpio_put(DISPLAY_BL_PIN, 0); // Turn off backlight
     }
     
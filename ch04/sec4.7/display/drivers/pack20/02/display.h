@@ -9,6 +9,10 @@
 #define DISPLAY_WIDTH 320
 #define DISPLAY_HEIGHT 240
 
+// Half resolution: a 160x120 framebuffer, each pixel shown as 2x2
+#define DISPLAY_HALF_WIDTH (DISPLAY_WIDTH / 2)
+#define DISPLAY_HALF_HEIGHT (DISPLAY_HEIGHT / 2)
+
 // Colors (RGB565 format)
 #define COLOR_BLACK     0x0000
 #define COLOR_WHITE     0xFFFF
@@ -40,14 +44,26 @@ typedef enum {
     DISPLAY_ERROR_NOT_INITIALIZED
 } display_error_t;
 
+// How the bytes reach the panel: SPI0 a byte at a time, or a PIO state
+// machine (lcd_serial.pio) that takes pixels from the DMA 16 bits at a
+// time, at a faster clock. The drawing is the same on both
+typedef enum {
+    DISPLAY_TRANSPORT_SPI = 0,
+    DISPLAY_TRANSPORT_PIO
+} display_transport_t;
+
 // Display functions
-display_error_t display_pack_init(void);
+display_error_t display_pack_init(void);    // DISPLAY_DEFAULT_TRANSPORT, SPI unless set
+display_error_t display_pack_init_transport(display_transport_t transport);
 display_error_t display_clear(uint16_t color);
 display_error_t display_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color);
 display_error_t display_draw_pixel(uint16_t x, uint16_t y, uint16_t color);
 display_error_t display_blit_full(const uint16_t *pixels);
+display_error_t display_blit_half(const uint16_t *pixels);
+display_error_t display_blit_rect_async(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint16_t *pixels);
 display_error_t display_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg_color);
 display_error_t display_draw_string(uint16_t x, uint16_t y, const char* str, uint16_t color, uint16_t bg_color);
+const uint8_t *display_glyph(char c);
 display_error_t display_set_backlight(bool on);
 
 // Button functions
@@ -60,6 +76,8 @@ display_error_t button_set_callback(button_t button, button_callback_t callback)
 
 // Utility functions
 bool display_is_initialized(void);
+display_transport_t display_get_transport(void);
+uint32_t display_bus_hz(void);             // the clock the bus runs at
 bool display_dma_busy(void);
 void display_wait_for_dma(void);
 void display_cleanup(void);
@@ -81,46 +81,181 @@ static const uint8_t font5x8[][5] = {
     {0x43, 0x45, 0x49, 0x51, 0x61}, // Z
 };
 
-// Frame buffer
-static uint16_t frame_buffer[DISPLAY_WIDTH * DISPLAY_HEIGHT];
-
-// Buffer drawing functions
-static void buffer_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color) {
-    if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT || width == 0 || height == 0) return;
-    if (x + width > DISPLAY_WIDTH) width = DISPLAY_WIDTH - x;
-    if (y + height > DISPLAY_HEIGHT) height = DISPLAY_HEIGHT - y;
-
-    for (uint16_t yy = y; yy < y + height; yy++) {
-        for (uint16_t xx = x; xx < x + width; xx++) {
-            frame_buffer[yy * DISPLAY_WIDTH + xx] = color;
-        }
+// Tile renderer. A frame is recorded as a display list of rectangles
+// and strings, which is binned into 32x32 tiles: a bit per command in
+// each tile it touches, so the tile draws them in list order. A tile
+// whose commands hash the same as last frame is left on the screen; the
+// others are drawn, one at a time, into a small buffer and sent to its
+// window by DMA, while the next one is drawn into the other buffer
+#define TILE_SIZE 32
+#define TILES_X ((DISPLAY_WIDTH + TILE_SIZE - 1) / TILE_SIZE)
+#define TILES_Y ((DISPLAY_HEIGHT + TILE_SIZE - 1) / TILE_SIZE)
+#define TILE_COUNT (TILES_X * TILES_Y)
+#define DL_MAX 192                      // commands in a frame
+#define DL_WORDS ((DL_MAX + 31) / 32)
+#define DL_TEXT_MAX 256                 // characters of all strings in a frame
+#define CHAR_ADVANCE 6
+#define CHAR_HEIGHT 8
+
+typedef enum { CMD_RECT, CMD_TEXT } cmd_kind_t;
+
+typedef struct {
+    uint8_t kind;
+    int16_t x, y, width, height;
+    uint16_t color, bg_color;
+    uint16_t text, length;              // in dl_text, for CMD_TEXT
+    uint32_t hash;
+} draw_cmd_t;
+
+static draw_cmd_t display_list[DL_MAX];
+static int dl_count;
+static char dl_text[DL_TEXT_MAX];
+static int dl_text_used;
+
+static uint32_t tile_bins[TILE_COUNT][DL_WORDS];
+static uint32_t tile_hash[TILE_COUNT];  // of what is on the screen
+static bool tiles_valid = false;        // false until the first frame is out
+static uint16_t tile_buffer[2][TILE_SIZE * TILE_SIZE];
+static uint32_t tiles_sent = 0;
+
+static uint32_t hash_step(uint32_t h, uint32_t v) {
+    return (h ^ v) * 16777619u;         // FNV-1a, a word at a time
+}
+
+static void dl_begin(void) {
+    dl_count = 0;
+    dl_text_used = 0;
+}
+
+static draw_cmd_t *dl_push(cmd_kind_t kind, int x, int y, int width, int height,
+                           uint16_t color, uint16_t bg_color) {
+    if (dl_count == DL_MAX || width <= 0 || height <= 0) return NULL;
+    draw_cmd_t *cmd = &display_list[dl_count++];
+    *cmd = (draw_cmd_t){ kind, x, y, width, height, color, bg_color, 0, 0, 0 };
+    uint32_t h = 2166136261u;
+    h = hash_step(h, kind);
+    h = hash_step(h, (uint32_t)(uint16_t)x << 16 | (uint16_t)y);
+    h = hash_step(h, (uint32_t)(uint16_t)width << 16 | (uint16_t)height);
+    cmd->hash = hash_step(h, (uint32_t)color << 16 | bg_color);
+    return cmd;
+}
+
+static void dl_rect(int x, int y, int width, int height, uint16_t color) {
+    dl_push(CMD_RECT, x, y, width, height, color, 0);
+}
+
+static void dl_string(int x, int y, const char *str, uint16_t color, uint16_t bg_color) {
+    int length = 0;
+    while (str[length] && dl_text_used + length < DL_TEXT_MAX) length++;
+    draw_cmd_t *cmd = dl_push(CMD_TEXT, x, y, length * CHAR_ADVANCE, CHAR_HEIGHT, color, bg_color);
+    if (!cmd) return;
+    cmd->text = dl_text_used;
+    cmd->length = length;
+    for (int i = 0; i < length; i++) {
+        dl_text[dl_text_used++] = str[i];
+        cmd->hash = hash_step(cmd->hash, (uint8_t)str[i]);
     }
 }
 
-static void buffer_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg_color) {
-    if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return;
-    if (c < 32 || c > 90) c = 32;
+// Set each command's bit in every tile it overlaps
+static void dl_bin(void) {
+    for (int t = 0; t < TILE_COUNT; t++) {
+        for (int w = 0; w < DL_WORDS; w++) tile_bins[t][w] = 0;
+    }
+    for (int i = 0; i < dl_count; i++) {
+        const draw_cmd_t *cmd = &display_list[i];
+        int x0 = cmd->x < 0 ? 0 : cmd->x;
+        int y0 = cmd->y < 0 ? 0 : cmd->y;
+        int x1 = cmd->x + cmd->width - 1;
+        int y1 = cmd->y + cmd->height - 1;
+        if (x1 >= DISPLAY_WIDTH) x1 = DISPLAY_WIDTH - 1;
+        if (y1 >= DISPLAY_HEIGHT) y1 = DISPLAY_HEIGHT - 1;
+        if (x0 > x1 || y0 > y1) continue;
+        for (int ty = y0 / TILE_SIZE; ty <= y1 / TILE_SIZE; ty++) {
+            for (int tx = x0 / TILE_SIZE; tx <= x1 / TILE_SIZE; tx++) {
+                tile_bins[ty * TILES_X + tx][i / 32] |= 1u << (i % 32);
+            }
+        }
+    }
+}
 
-    const uint8_t *char_data = font5x8[c - 32];
+// Draw one command into a tile at (tile_x, tile_y), clipped to it
+static void tile_draw(uint16_t *tile, int tile_x, int tile_y, int tile_w, int tile_h,
+                      const draw_cmd_t *cmd) {
+    int x0 = cmd->x - tile_x, y0 = cmd->y - tile_y;
+    int x1 = x0 + cmd->width, y1 = y0 + cmd->height;
+    int cx0 = x0 < 0 ? 0 : x0, cy0 = y0 < 0 ? 0 : y0;
+    int cx1 = x1 > tile_w ? tile_w : x1, cy1 = y1 > tile_h ? tile_h : y1;
+
+    for (int y = cy0; y < cy1; y++) {
+        uint16_t *row = tile + y * TILE_SIZE;
+        for (int x = cx0; x < cx1; x++) {
+            if (cmd->kind == CMD_RECT) {
+                row[x] = cmd->color;
+                continue;
+            }
+            // Column col of a 5x8 glyph; the sixth is the gap, not drawn
+            int col = (x - x0) % CHAR_ADVANCE;
+            if (col == CHAR_ADVANCE - 1) continue;
+            char c = dl_text[cmd->text + (x - x0) / CHAR_ADVANCE];
+            if (c < 32 || c > 90) c = 32;
+            uint8_t line = font5x8[c - 32][4 - col];
+            row[x] = (line & (1 << (y - y0))) ? cmd->color : cmd->bg_color;
+        }
+    }
+}
 
-    for (int col = 0; col < 5 && (x + col) < DISPLAY_WIDTH; col++) {
-        uint8_t line = char_data[4 - col];
-        for (int row = 0; row < 8 && (y + row) < DISPLAY_HEIGHT; row++) {
-            uint16_t pixel_color = (line & (1 << row)) ? color : bg_color;
-            frame_buffer[(y + row) * DISPLAY_WIDTH + (x + col)] = pixel_color;
+static uint32_t tile_signature(int t) {
+    uint32_t h = 2166136261u;
+    for (int w = 0; w < DL_WORDS; w++) {
+        for (uint32_t bits = tile_bins[t][w]; bits; bits &= bits - 1) {
+            h = hash_step(h, display_list[w * 32 + __builtin_ctz(bits)].hash);
         }
     }
+    return h;
 }
 
-static void buffer_draw_string(uint16_t x, uint16_t y, const char* str, uint16_t color, uint16_t bg_color) {
-    if (!str || x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return;
+// Draw and send the tiles that changed. Each blit waits for the one
+// before, so the buffer being drawn into is never the one on the wire
+static void dl_present(uint16_t background) {
+    dl_bin();
+    int buffer = 0;
+    for (int t = 0; t < TILE_COUNT; t++) {
+        uint32_t signature = tile_signature(t);
+        if (tiles_valid && signature == tile_hash[t]) continue;
+        tile_hash[t] = signature;
+
+        int tile_x = (t % TILES_X) * TILE_SIZE, tile_y = (t / TILES_X) * TILE_SIZE;
+        int tile_w = DISPLAY_WIDTH - tile_x < TILE_SIZE ? DISPLAY_WIDTH - tile_x : TILE_SIZE;
+        int tile_h = DISPLAY_HEIGHT - tile_y < TILE_SIZE ? DISPLAY_HEIGHT - tile_y : TILE_SIZE;
+        uint16_t *tile = tile_buffer[buffer];
+        buffer ^= 1;
+
+        for (int y = 0; y < tile_h; y++) {
+            for (int x = 0; x < tile_w; x++) tile[y * TILE_SIZE + x] = background;
+        }
+        for (int w = 0; w < DL_WORDS; w++) {
+            for (uint32_t bits = tile_bins[t][w]; bits; bits &= bits - 1) {
+                tile_draw(tile, tile_x, tile_y, tile_w, tile_h, &display_list[w * 32 + __builtin_ctz(bits)]);
+            }
+        }
 
-    int offset_x = 0;
-    while (*str && (x + offset_x) < DISPLAY_WIDTH) {
-        buffer_draw_char(x + offset_x, y, *str, color, bg_color);
-        offset_x += 6;
-        str++;
+        // The window is tile_w wide, so a narrow edge tile is packed first
+        if (tile_w < TILE_SIZE) {
+            for (int y = 1; y < tile_h; y++) {
+                for (int x = 0; x < tile_w; x++) tile[y * tile_w + x] = tile[y * TILE_SIZE + x];
+            }
+        }
+        display_error_t result = display_blit_rect_async(tile_x, tile_y, tile_w, tile_h, tile);
+        if (result != DISPLAY_OK) {
+            printf("Error blitting tile: %s\n", display_error_string(result));
+            tiles_valid = false;
+            return;
+        }
+        tiles_sent++;
     }
+    display_wait_for_dma();
+    tiles_valid = true;
 }
 
 // Brick structure
@@ -166,10 +301,9 @@ static void init_bricks(void) {
     }
 }
 
-// Draw game to buffer
-static void draw_game_to_buffer(void) {
-    // Clear buffer
-    buffer_fill_rect(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, COLOR_BLACK);
+// Record the frame; the background is black
+static void draw_game(void) {
+    dl_begin();
 
     // Draw bricks
     for (int row = 0; row < BRICK_ROWS; row++) {
@@ -177,33 +311,33 @@ static void draw_game_to_buffer(void) {
             if (bricks[row][col].active) {
                 uint16_t brick_x = col * BRICK_WIDTH;
                 uint16_t brick_y = BRICK_START_Y + row * BRICK_HEIGHT;
-                buffer_fill_rect(brick_x, brick_y, BRICK_WIDTH - 1, BRICK_HEIGHT - 1, bricks[row][col].color);  // -1 for spacing
+                dl_rect(brick_x, brick_y, BRICK_WIDTH - 1, BRICK_HEIGHT - 1, bricks[row][col].color);  // -1 for spacing
             }
         }
     }
 
     // Draw paddle
-    buffer_fill_rect(paddle_x, PADDLE_Y, PADDLE_WIDTH, PADDLE_HEIGHT, COLOR_WHITE);
+    dl_rect(paddle_x, PADDLE_Y, PADDLE_WIDTH, PADDLE_HEIGHT, COLOR_WHITE);
 
     // Draw ball
-    buffer_fill_rect(ball_x, ball_y, BALL_SIZE, BALL_SIZE, COLOR_WHITE);
+    dl_rect(ball_x, ball_y, BALL_SIZE, BALL_SIZE, COLOR_WHITE);
 
     // Draw score
     char score_str[32];
     sprintf(score_str, "SCORE: %d", score);
-    buffer_draw_string(10, 10, score_str, COLOR_WHITE, COLOR_BLACK);
+    dl_string(10, 10, score_str, COLOR_WHITE, COLOR_BLACK);
 
     // Draw lives
     char lives_str[32];
     sprintf(lives_str, "LIVES: %d", lives);
-    buffer_draw_string(DISPLAY_WIDTH - 80, 10, lives_str, COLOR_WHITE, COLOR_BLACK);
+    dl_string(DISPLAY_WIDTH - 80, 10, lives_str, COLOR_WHITE, COLOR_BLACK);
 
     // Draw messages
     if (game_over) {
-        buffer_draw_string(100, 100, "GAME OVER", COLOR_RED, COLOR_BLACK);
-        buffer_draw_string(60, 115, "PRESS X TO RESTART", COLOR_WHITE, COLOR_BLACK);
+        dl_string(100, 100, "GAME OVER", COLOR_RED, COLOR_BLACK);
+        dl_string(60, 115, "PRESS X TO RESTART", COLOR_WHITE, COLOR_BLACK);
     } else if (!ball_launched) {
-        buffer_draw_string(60, 100, "PRESS X TO LAUNCH", COLOR_WHITE, COLOR_BLACK);
+        dl_string(60, 100, "PRESS X TO LAUNCH", COLOR_WHITE, COLOR_BLACK);
     }
 }
 
@@ -356,19 +490,18 @@ int main() {
     // Init game
     init_bricks();
 
+    uint32_t frames = 0;
     while (true) {
         buttons_update();
 
         update_game();
-        draw_game_to_buffer();
-        result = display_blit_full(frame_buffer);
-        if (result != DISPLAY_OK) {
-            printf("Error blitting frame: %s\n", display_error_string(result));
-        }
+        draw_game();
+        dl_present(COLOR_BLACK);
 
-        // Wait for DMA if busy
-        if (display_dma_busy()) {
-            display_wait_for_dma();
+        if (++frames == 300) {
+            printf("Tiles sent: %lu of %d per frame\n", (unsigned long)(tiles_sent / frames), TILE_COUNT);
+            frames = 0;
+            tiles_sent = 0;
         }
 
         sleep_ms(16);  // ~60 FPS target
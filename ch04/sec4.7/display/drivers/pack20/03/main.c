@@ -26,6 +26,8 @@ static uint32_t last_display_check = 0;
 static bool display_ok = false;
 static uint32_t error_count = 0;
 
+static void text_invalidate(void);
+
 // Get current time in milliseconds
 static inline uint32_t get_time_ms(void) {
     return to_ms_since_boot(get_absolute_time());
@@ -62,6 +64,7 @@ static bool check_display(void) {
         printf("Display not init, attempting reinit..\n");
         display_error_t err = display_pack_init();
         display_ok = (err == DISPLAY_OK);
+        text_invalidate();
         if (!display_ok) {
             printf("Display reinit failed: %d\n", err);
             error_count++;
@@ -126,29 +129,137 @@ static void move_cursor_right(void) {
     }
 }
 
-// Simple render - just one line at a time to avoid complexity
+// Text mode: the screen as a grid of character cells, and a shadow of
+// what is on the display. text_present() draws only the cells that
+// differ from the shadow: on each line, the run from the first to the
+// last changed cell goes out as one window of glyph rows. A key press
+// changes a cell or two, and the cursor blink one, so an update costs
+// the same however much text there is, and nothing is cleared first
+#define ATTR_CURSOR 0x80                // a bar over the left of the cell
+
+typedef enum { ATTR_TEXT, ATTR_TITLE, ATTR_STATUS, ATTR_HELP } attr_t;
+
+static const uint16_t attr_colors[][2] = {
+    [ATTR_TEXT]   = { COLOR_WHITE, COLOR_BLACK },
+    [ATTR_TITLE]  = { COLOR_RED,   COLOR_BLACK },
+    [ATTR_STATUS] = { COLOR_WHITE, COLOR_BLUE },
+    [ATTR_HELP]   = { COLOR_GREEN, COLOR_BLACK },
+};
+
+typedef struct {
+    char c;
+    uint8_t attr;
+} cell_t;
+
+static cell_t cells[SCREEN_LINES][SCREEN_CHARS_WIDTH];
+static cell_t shadow[SCREEN_LINES][SCREEN_CHARS_WIDTH];
+static bool shadow_valid = false;
+
+// One line of glyph rows. The DMA sends it low byte first and the
+// display wants the high byte first, so pixels are stored swapped
+static uint16_t run_pixels[FONT_HEIGHT * DISPLAY_WIDTH];
+
+static inline uint16_t wire_color(uint16_t color) {
+    return (uint16_t)(color >> 8 | color << 8);
+}
+
+static void text_clear(void) {
+    for (int y = 0; y < SCREEN_LINES; y++) {
+        for (int x = 0; x < SCREEN_CHARS_WIDTH; x++) {
+            cells[y][x] = (cell_t){ ' ', ATTR_TEXT };
+        }
+    }
+}
+
+static void text_put(int x, int y, char c, uint8_t attr) {
+    if (x < 0 || x >= SCREEN_CHARS_WIDTH || y < 0 || y >= SCREEN_LINES) return;
+    cells[y][x] = (cell_t){ c, attr };
+}
+
+static void text_puts(int x, int y, const char *str, uint8_t attr) {
+    while (*str) text_put(x++, y, *str++, attr);
+}
+
+static void text_fill_line(int y, uint8_t attr) {
+    for (int x = 0; x < SCREEN_CHARS_WIDTH; x++) text_put(x, y, ' ', attr);
+}
+
+// Draw every cell on the next text_present(), after a display reset
+static void text_invalidate(void) {
+    shadow_valid = false;
+}
+
+// Cell at column offset col of a run width pixels wide
+static void render_cell(uint16_t *pixels, int width, int col, cell_t cell) {
+    uint16_t fg = wire_color(attr_colors[cell.attr & ~ATTR_CURSOR][0]);
+    uint16_t bg = wire_color(attr_colors[cell.attr & ~ATTR_CURSOR][1]);
+    char c = (cell.c >= 'a' && cell.c <= 'z') ? (cell.c - 32) : cell.c;
+    const uint8_t *char_data = display_glyph(c);
+
+    for (int row = 0; row < FONT_HEIGHT; row++) {
+        uint16_t *p = pixels + row * width + col * FONT_WIDTH;
+        for (int i = 0; i < FONT_WIDTH; i++) {
+            bool on = i < 5 && (char_data[4 - i] & (1 << row));
+            p[i] = on ? fg : bg;
+        }
+        if (cell.attr & ATTR_CURSOR) {
+            for (int i = 0; i < 3; i++) p[i] = wire_color(COLOR_WHITE);
+        }
+    }
+}
+
+static display_error_t text_present(void) {
+    for (int y = 0; y < SCREEN_LINES; y++) {
+        int first = 0, last = SCREEN_CHARS_WIDTH - 1;
+        if (shadow_valid) {
+            while (first <= last && memcmp(&cells[y][first], &shadow[y][first], sizeof(cell_t)) == 0) first++;
+            while (last >= first && memcmp(&cells[y][last], &shadow[y][last], sizeof(cell_t)) == 0) last--;
+            if (first > last) continue;
+        }
+
+        // A run to the end of the line takes the pixels past the last
+        // cell along, in its background
+        int x = first * FONT_WIDTH;
+        int width = (last + 1) * FONT_WIDTH - x;
+        if (last == SCREEN_CHARS_WIDTH - 1) width = DISPLAY_WIDTH - x;
+
+        display_wait_for_dma();         // run_pixels may still be on the wire
+        for (int i = first; i <= last; i++) {
+            render_cell(run_pixels, width, i - first, cells[y][i]);
+        }
+        uint16_t margin_bg = wire_color(attr_colors[cells[y][last].attr & ~ATTR_CURSOR][1]);
+        for (int row = 0; row < FONT_HEIGHT; row++) {
+            for (int px = (last + 1 - first) * FONT_WIDTH; px < width; px++) {
+                run_pixels[row * width + px] = margin_bg;
+            }
+        }
+
+        display_error_t err = display_blit_rect_async(x, y * FONT_HEIGHT, width, FONT_HEIGHT, run_pixels);
+        if (err != DISPLAY_OK) {
+            text_invalidate();
+            return err;
+        }
+        memcpy(&shadow[y][first], &cells[y][first], (last + 1 - first) * sizeof(cell_t));
+    }
+    display_wait_for_dma();
+    shadow_valid = true;
+    return DISPLAY_OK;
+}
+
+// Lay the editor out in the cells, and draw what changed
 static bool render_simple(void) {
     if (!check_display()) {
         return false;
     }
     
-    // Clear screen first
-    display_error_t err = display_clear(COLOR_BLACK);
-    if (err != DISPLAY_OK) {
-        display_ok = false;
-        return false;
-    }
+    text_clear();
     
-    // Draw text - simple approach, just show what we can
-    uint8_t screen_x = 0;
-    uint8_t screen_y = 0;
-    
-    // DEBUG: Draw some test text first to see if character drawing works
-    display_draw_string(0, 0, "EDITOR", COLOR_RED, COLOR_BLACK);
+    // DEBUG: Title line, to see if character drawing works
+    text_puts(0, 0, "EDITOR", ATTR_TITLE);
     
-    // Start drawing actual text from line 1
-    screen_y = 1;
-    screen_x = 0;
+    // Text from line 1, what fits on the screen
+    uint8_t screen_x = 0;
+    uint8_t screen_y = 1;
     
     for (uint16_t i = 0; i < text_length && screen_y < TEXT_LINES; i++) {
         char c = text_buffer[i];
@@ -157,20 +268,14 @@ static bool render_simple(void) {
             screen_y++;
             screen_x = 0;
         } else if (c >= 32 && c < 127 && screen_x < SCREEN_CHARS_WIDTH) {
-            char display_char = (c >= 'a' && c <= 'z') ? (c - 32) : c;
-            err = display_draw_char(screen_x * FONT_WIDTH, screen_y * FONT_HEIGHT, 
-                                   display_char, COLOR_WHITE, COLOR_BLACK);
-            if (err != DISPLAY_OK) {
-                display_ok = false;
-                return false;
-            }
+            text_put(screen_x, screen_y, c, ATTR_TEXT);
             screen_x++;
         }
     }
     
-    // Calculate cursor screen position (adjust for test line)
+    // Calculate cursor screen position (adjust for title line)
     uint8_t cursor_screen_x = 0;
-    uint8_t cursor_screen_y = 1; // Start from line 1 because of TEST
+    uint8_t cursor_screen_y = 1;
     
     for (uint16_t i = 0; i < cursor_pos && i < text_length; i++) {
         if (text_buffer[i] == '\n') {
@@ -181,44 +286,24 @@ static bool render_simple(void) {
         }
     }
     
-    // If no text, cursor should be at start of line 1
-    if (text_length == 0) {
-        cursor_screen_x = 0;
-        cursor_screen_y = 1;
-    }
-    
-    // Draw cursor
+    // Cursor
     if (cursor_visible && cursor_screen_y < TEXT_LINES && cursor_screen_x < SCREEN_CHARS_WIDTH) {
-        err = display_fill_rect(cursor_screen_x * FONT_WIDTH, cursor_screen_y * FONT_HEIGHT,
-                               3, FONT_HEIGHT, COLOR_WHITE);
-        if (err != DISPLAY_OK) {
-            display_ok = false;
-            return false;
-        }
+        cells[cursor_screen_y][cursor_screen_x].attr |= ATTR_CURSOR;
     }
     
-    // Draw status bar
-    uint16_t status_y = TEXT_LINES * FONT_HEIGHT;
-    err = display_fill_rect(0, status_y, DISPLAY_WIDTH, FONT_HEIGHT, COLOR_BLUE);
-    if (err != DISPLAY_OK) {
-        display_ok = false;
-        return false;
-    }
+    // Status bar
+    uint16_t status_line = TEXT_LINES;
+    text_fill_line(status_line, ATTR_STATUS);
     
-    // Status text
     memset(display_line, 0, sizeof(display_line));
     snprintf(display_line, sizeof(display_line) - 1, "P:%d L:%d E:%d", 
              cursor_pos, text_length, error_count);
-    
-    err = display_draw_string(0, status_y, display_line, COLOR_WHITE, COLOR_BLUE);
-    if (err != DISPLAY_OK) {
-        display_ok = false;
-        return false;
-    }
+    text_puts(0, status_line, display_line, ATTR_STATUS);
     
     // Help line
-    err = display_draw_string(0, status_y + FONT_HEIGHT, "A:DEBUG B:CLEAR - TYPE TEXT ABOVE", 
-                             COLOR_GREEN, COLOR_BLACK);
+    text_puts(0, status_line + 1, "A:DEBUG B:CLEAR - TYPE TEXT ABOVE", ATTR_HELP);
+    
+    display_error_t err = text_present();
     if (err != DISPLAY_OK) {
         display_ok = false;
         return false;
@@ -397,6 +482,7 @@ int main() {
                         display_ok = true;
                         error_count = 0;
                     }
+                    text_invalidate();
                 }
             }
         }
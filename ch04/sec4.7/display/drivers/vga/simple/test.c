@@ -4,6 +4,8 @@
 #include "hardware/dma.h"
 #include "hardware/clocks.h"
 #include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "pico/multicore.h"
 
 // Pin definitions for simplified 3-bit VGA
 #define RED_PIN     0
@@ -78,11 +80,42 @@ const uint16_t rgb_program[] = {
     //     .wrap
 };
 
+// Two ways to feed the RGB state machine:
+// - VGA_FRAMEBUFFER: one DMA transfer from a full 640x480 frame buffer,
+//   one byte per pixel, which is 300 KB and more than the RP2040 has
+// - default: racing the beam. Core 1 renders each line just before it
+//   is sent, into a few scanline buffers, and a control DMA channel
+//   chains them into the PIO FIFO one after the other
+// #define VGA_FRAMEBUFFER
+
+#ifdef VGA_FRAMEBUFFER
 // Frame buffer for 640x480x3bit (1 pixel per byte for simplicity)
 uint8_t framebuffer[H_ACTIVE * V_ACTIVE];
+#else
+// Number of scanline buffers, a power of two for the DMA address ring.
+// With two, core 1 has one line time (32 us) to render each line
+#define SCANLINE_BUFFERS 2
+
+// Fill line with the H_ACTIVE pixels of line y
+typedef void (*scanline_render_t)(int y, uint8_t *line);
+
+uint8_t scanline[SCANLINE_BUFFERS][H_ACTIVE];
+
+// Read addresses the control channel hands to the data channel in turn
+static const uint8_t *scanline_addr[SCANLINE_BUFFERS]
+    __attribute__((aligned(SCANLINE_BUFFERS * sizeof(uint8_t *))));
+
+static volatile scanline_render_t render_line;
+static volatile uint32_t lines_sent = 0;      // counted by the DMA interrupt
+static uint32_t lines_rendered = 0;
+static volatile uint32_t lines_late = 0;      // rendered after being sent
+#endif
 
 // DMA channels
 int dma_channel;
+#ifndef VGA_FRAMEBUFFER
+int dma_control_channel;
+#endif
 
 void init_pio_vga() {
     PIO pio = pio0;
@@ -137,6 +170,7 @@ void init_pio_vga() {
     pio_sm_put_blocking(pio, vsync_sm, V_ACTIVE - 1);
 }
 
+#ifdef VGA_FRAMEBUFFER
 void setup_dma() {
     dma_channel = dma_claim_unused_channel(true);
     
@@ -155,7 +189,91 @@ void setup_dma() {
         false               // Don't start yet
     );
 }
+#else
+// A line has been sent: its buffer is free for core 1 to render into
+static void scanline_dma_handler(void) {
+    dma_hw->ints1 = 1u << dma_channel;
+    lines_sent++;
+}
 
+void setup_dma() {
+    dma_channel = dma_claim_unused_channel(true);
+    dma_control_channel = dma_claim_unused_channel(true);
+    
+    for (int i = 0; i < SCANLINE_BUFFERS; i++) {
+        scanline_addr[i] = scanline[i];
+    }
+    
+    // Data channel: one line into the RGB FIFO, then hand over to the
+    // control channel
+    dma_channel_config config = dma_channel_get_default_config(dma_channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, pio_get_dreq(pio0, 2, true));
+    channel_config_set_chain_to(&config, dma_control_channel);
+    
+    dma_channel_configure(
+        dma_channel,
+        &config,
+        &pio0->txf[2],      // Write to RGB PIO FIFO
+        NULL,               // Set by the control channel
+        H_ACTIVE,           // One line
+        false
+    );
+    
+    // Control channel: write the next buffer's address to the data
+    // channel's read address trigger, going round the address ring
+    dma_channel_config control = dma_channel_get_default_config(dma_control_channel);
+    channel_config_set_transfer_data_size(&control, DMA_SIZE_32);
+    channel_config_set_read_increment(&control, true);
+    channel_config_set_write_increment(&control, false);
+    channel_config_set_ring(&control, false, __builtin_ctz(SCANLINE_BUFFERS * sizeof(uint8_t *)));
+    
+    dma_channel_configure(
+        dma_control_channel,
+        &control,
+        &dma_hw->ch[dma_channel].al3_read_addr_trig,
+        scanline_addr,
+        1,
+        false
+    );
+    
+    // Line-done interrupt, on DMA_IRQ_1 for core 1 to take
+    dma_channel_set_irq1_enabled(dma_channel, true);
+}
+
+// Core 1: stay up to SCANLINE_BUFFERS lines ahead of the beam
+static void scanline_core1(void) {
+    irq_set_exclusive_handler(DMA_IRQ_1, scanline_dma_handler);
+    irq_set_enabled(DMA_IRQ_1, true);
+    
+    while (true) {
+        // Wait for the buffer's previous line to be sent
+        while (lines_rendered - lines_sent >= SCANLINE_BUFFERS) {
+            __wfe();
+        }
+        render_line(lines_rendered % V_ACTIVE, scanline[lines_rendered % SCANLINE_BUFFERS]);
+        if ((int32_t)(lines_sent - lines_rendered) > 0) {
+            lines_late++;
+        }
+        lines_rendered++;
+    }
+}
+
+void start_scanlines(scanline_render_t render) {
+    render_line = render;
+    
+    // The first lines are ready before the beam gets there
+    for (lines_rendered = 0; lines_rendered < SCANLINE_BUFFERS; lines_rendered++) {
+        render(lines_rendered, scanline[lines_rendered]);
+    }
+    multicore_launch_core1(scanline_core1);
+    dma_channel_start(dma_control_channel);
+}
+#endif
+
+#ifdef VGA_FRAMEBUFFER
 void draw_test_pattern() {
     // Create a simple test pattern
     for (int y = 0; y < V_ACTIVE; y++) {
@@ -209,6 +327,37 @@ void draw_moving_pattern() {
     
     frame_counter++;
 }
+#else
+// One line of the test pattern
+static void render_test_pattern_line(int y, uint8_t *line) {
+    for (int x = 0; x < H_ACTIVE; x++) {
+        // Vertical color bars: black, red, green, yellow, blue, magenta,
+        // cyan, white
+        uint8_t color = (uint8_t)(x * 8 / H_ACTIVE);
+        
+        // Add some horizontal lines
+        if (y % 60 == 0) {
+            color = 7;  // White lines
+        }
+        
+        line[x] = color;
+    }
+}
+
+// One line of the moving pattern; the frame counts up at each top line
+static void render_moving_line(int y, uint8_t *line) {
+    static int frame_counter = 0;
+    if (y == 0) {
+        frame_counter++;
+    }
+    
+    for (int x = 0; x < H_ACTIVE; x++) {
+        // Moving diagonal stripes
+        int stripe = (x + y + frame_counter) / 40;
+        line[x] = stripe & 7;  // Cycle through 8 colors
+    }
+}
+#endif
 
 int main() {
     stdio_init_all();
@@ -219,6 +368,7 @@ int main() {
     init_pio_vga();
     setup_dma();
     
+#ifdef VGA_FRAMEBUFFER
     // Draw initial test pattern
     draw_test_pattern();
     
@@ -251,5 +401,27 @@ int main() {
         sleep_ms(16);  // ~60 FPS update rate
     }
     
+#else
+    printf("VGA initialized. You should see color bars on your monitor.\n");
+    printf("Press any key to switch to moving pattern...\n");
+    
+    // Lines are rendered as they are needed: switching pattern is
+    // switching the render function
+    start_scanlines(render_test_pattern_line);
+    
+    bool moving_pattern = false;
+    
+    while (true) {
+        int c = getchar_timeout_us(0);
+        if (c != PICO_ERROR_TIMEOUT) {
+            moving_pattern = !moving_pattern;
+            render_line = moving_pattern ? render_moving_line : render_test_pattern_line;
+            printf("Switched to %s pattern (%lu late lines so far)\n",
+                   moving_pattern ? "moving" : "static", (unsigned long)lines_late);
+        }
+        sleep_ms(16);
+    }
+#endif
+    
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,205 @@
+// Headless soak test of the collision grid in ../collide.c: far more
+// asteroids and bullets than the game has, moving and wrapping the way
+// the game moves them. Every frame the grid's answers are checked
+// against testing every asteroid, then both are timed per frame
+//
+//   ./soak [asteroids] [frames]
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "collide.h"
+#include "fixed.h"
+
+// The game's playfield and wrap margins
+#define GAME_AREA_Y 20
+#define GAME_AREA_WIDTH 320
+#define GAME_AREA_HEIGHT 220
+
+#define BULLETS 64
+#define BULLET_RADIUS INT_TO_FIXED(4)
+
+typedef struct {
+    int32_t x, y, dx, dy, r;
+    bool active;
+} body_t;
+
+static body_t asteroids[COLLIDE_MAX_OBJECTS];
+static body_t bullets[BULLETS];
+static int asteroid_count;
+
+// The game's wrap_position()
+static void wrap(body_t *b) {
+    int screen_x = b->x >> FIXED_SHIFT;
+    int screen_y = b->y >> FIXED_SHIFT;
+
+    if (screen_x < -20) b->x = INT_TO_FIXED(GAME_AREA_WIDTH + 10);
+    else if (screen_x > GAME_AREA_WIDTH + 20) b->x = INT_TO_FIXED(-10);
+
+    if (screen_y < GAME_AREA_Y) b->y = INT_TO_FIXED(GAME_AREA_HEIGHT + GAME_AREA_Y + 10);
+    else if (screen_y > GAME_AREA_HEIGHT + GAME_AREA_Y + 20) b->y = INT_TO_FIXED(GAME_AREA_Y + 20);
+}
+
+static int32_t random_range(int lo, int hi) {
+    return INT_TO_FIXED(lo) + (int32_t)(rand() % ((hi - lo) << FIXED_SHIFT));
+}
+
+static void spawn_asteroid(body_t *a) {
+    a->x = random_range(-20, GAME_AREA_WIDTH + 20);
+    a->y = random_range(GAME_AREA_Y, GAME_AREA_Y + GAME_AREA_HEIGHT + 20);
+    a->dx = random_range(-1, 1);
+    a->dy = random_range(-1, 1);
+    a->r = random_range(12, 25);
+    a->active = true;
+}
+
+static void spawn_bullet(body_t *b) {
+    b->x = random_range(0, GAME_AREA_WIDTH);
+    b->y = random_range(GAME_AREA_Y, GAME_AREA_Y + GAME_AREA_HEIGHT);
+    b->dx = random_range(-10, 10);
+    b->dy = random_range(-10, 10);
+    b->r = BULLET_RADIUS;
+    b->active = true;
+}
+
+static void move_all(void) {
+    for (int i = 0; i < asteroid_count; i++) {
+        asteroids[i].x += asteroids[i].dx;
+        asteroids[i].y += asteroids[i].dy;
+        wrap(&asteroids[i]);
+    }
+    for (int i = 0; i < BULLETS; i++) {
+        bullets[i].x += bullets[i].dx;
+        bullets[i].y += bullets[i].dy;
+        wrap(&bullets[i]);
+    }
+}
+
+// What the game did before the grid: every bullet against every asteroid
+static int brute_first_hit(const body_t *b) {
+    for (int j = 0; j < asteroid_count; j++) {
+        if (!asteroids[j].active) continue;
+        if (collide_circles(b->x, b->y, b->r, asteroids[j].x, asteroids[j].y, asteroids[j].r)) {
+            return j;
+        }
+    }
+    return -1;
+}
+
+static int grid_first_hit(const body_t *b) {
+    return collide_first_hit(b->x, b->y, b->r);
+}
+
+static void grid_build(void) {
+    collide_clear();
+    for (int j = 0; j < asteroid_count; j++) {
+        if (asteroids[j].active) collide_insert(j, asteroids[j].x, asteroids[j].y, asteroids[j].r);
+    }
+}
+
+static void nothing(void) {
+}
+
+typedef struct {
+    const char *name;
+    void (*build)(void);
+    int (*first_hit)(const body_t *b);
+} broadphase_t;
+
+static const broadphase_t broadphases[] = {
+    {"all pairs", nothing,    brute_first_hit},
+    {"grid",      grid_build, grid_first_hit},
+};
+
+// One frame of the game's bullet loop; a hit asteroid is taken out of
+// the grid and respawns next frame, so the count stays up
+static long collide_frame(const broadphase_t *bp, int hits[BULLETS]) {
+    long hit_count = 0;
+    bp->build();
+    for (int i = 0; i < BULLETS; i++) {
+        hits[i] = bp->first_hit(&bullets[i]);
+        if (hits[i] < 0) continue;
+        asteroids[hits[i]].active = false;
+        collide_remove(hits[i]);
+        hit_count++;
+    }
+    return hit_count;
+}
+
+static void respawn(int hits[BULLETS]) {
+    for (int i = 0; i < BULLETS; i++) {
+        if (hits[i] < 0) continue;
+        spawn_asteroid(&asteroids[hits[i]]);
+        spawn_bullet(&bullets[i]);
+    }
+}
+
+static void reset(unsigned seed) {
+    srand(seed);
+    for (int i = 0; i < asteroid_count; i++) spawn_asteroid(&asteroids[i]);
+    for (int i = 0; i < BULLETS; i++) spawn_bullet(&bullets[i]);
+}
+
+// Run both on the same frames; count frames where any bullet's hit differs
+static long verify(long frames) {
+    long mismatches = 0;
+    int expected[BULLETS], got[BULLETS];
+
+    reset(1979);
+    for (long f = 0; f < frames; f++) {
+        move_all();
+        collide_frame(&broadphases[0], expected);
+        for (int j = 0; j < asteroid_count; j++) asteroids[j].active = true;
+        collide_frame(&broadphases[1], got);
+        for (int i = 0; i < BULLETS; i++) {
+            if (expected[i] != got[i]) {
+                mismatches++;
+                break;
+            }
+        }
+        respawn(expected);
+    }
+    return mismatches;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[]) {
+    asteroid_count = 300;
+    long frames = 10000;
+    if (argc >= 2) asteroid_count = atoi(argv[1]);
+    if (argc >= 3) frames = atol(argv[2]);
+    if (asteroid_count <= 0 || asteroid_count > COLLIDE_MAX_OBJECTS || frames <= 0) {
+        fprintf(stderr, "usage: %s [asteroids 1..%d] [frames]\n", argv[0], COLLIDE_MAX_OBJECTS);
+        return 1;
+    }
+
+    long mismatches = verify(frames);
+    printf("%d asteroids, %d bullets, %ld frames checked against all pairs: %ld mismatches\n",
+           asteroid_count, BULLETS, frames, mismatches);
+
+    printf("%-10s %12s %10s\n", "broadphase", "us/frame", "hits");
+    for (size_t i = 0; i < sizeof(broadphases) / sizeof(broadphases[0]); i++) {
+        int hits[BULLETS];
+        long hit_count = 0;
+        double seconds = 0;
+
+        reset(1979);
+        for (long f = 0; f < frames; f++) {
+            move_all();
+            double start = now_seconds();
+            hit_count += collide_frame(&broadphases[i], hits);
+            seconds += now_seconds() - start;
+            respawn(hits);
+        }
+
+        printf("%-10s %12.2f %10ld\n", broadphases[i].name, seconds * 1e6 / frames, hit_count);
+    }
+
+    return mismatches ? 1 : 0;
+}
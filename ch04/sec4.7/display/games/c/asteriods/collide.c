@@ -0,0 +1,97 @@
+#include "collide.h"
+
+#define COLLIDE_CELLS (COLLIDE_COLS * COLLIDE_ROWS)
+#define COLLIDE_MAX_ENTRIES (COLLIDE_MAX_OBJECTS * COLLIDE_MAX_CELLS_PER_OBJECT)
+#define NO_ENTRY (-1)
+
+// Each cell is a singly linked list of entries, newest first, so an
+// insert in the middle of a frame (split asteroids) is just a push
+static int16_t cell_head[COLLIDE_CELLS];
+static struct {
+    int16_t id;
+    int16_t next;
+} entries[COLLIDE_MAX_ENTRIES];
+static int entry_count = 0;
+
+// The circles themselves, by id
+static int32_t obj_x[COLLIDE_MAX_OBJECTS];
+static int32_t obj_y[COLLIDE_MAX_OBJECTS];
+static int32_t obj_r[COLLIDE_MAX_OBJECTS];
+static bool obj_alive[COLLIDE_MAX_OBJECTS];
+
+// Cell column or row of a pixel coordinate, clamped to the grid
+static int cell_of(int pixel, int origin, int cells) {
+    int c = (pixel - origin) >> COLLIDE_CELL_SHIFT;
+    if (c < 0) return 0;
+    if (c >= cells) return cells - 1;
+    return c;
+}
+
+typedef struct {
+    int col0, row0, col1, row1;
+} cell_range_t;
+
+static cell_range_t cells_for_circle(int32_t x, int32_t y, int32_t r) {
+    return (cell_range_t){
+        cell_of((x - r) >> 16, COLLIDE_ORIGIN_X, COLLIDE_COLS),
+        cell_of((y - r) >> 16, COLLIDE_ORIGIN_Y, COLLIDE_ROWS),
+        cell_of((x + r) >> 16, COLLIDE_ORIGIN_X, COLLIDE_COLS),
+        cell_of((y + r) >> 16, COLLIDE_ORIGIN_Y, COLLIDE_ROWS),
+    };
+}
+
+void collide_clear(void) {
+    for (int i = 0; i < COLLIDE_CELLS; i++) {
+        cell_head[i] = NO_ENTRY;
+    }
+    for (int i = 0; i < COLLIDE_MAX_OBJECTS; i++) {
+        obj_alive[i] = false;
+    }
+    entry_count = 0;
+}
+
+void collide_insert(int id, int32_t x, int32_t y, int32_t r) {
+    if (id < 0 || id >= COLLIDE_MAX_OBJECTS) return;
+
+    obj_x[id] = x;
+    obj_y[id] = y;
+    obj_r[id] = r;
+    obj_alive[id] = true;
+
+    cell_range_t cells = cells_for_circle(x, y, r);
+    for (int row = cells.row0; row <= cells.row1; row++) {
+        for (int col = cells.col0; col <= cells.col1; col++) {
+            // Only objects larger than a cell can run the pool out
+            if (entry_count == COLLIDE_MAX_ENTRIES) return;
+            int cell = row * COLLIDE_COLS + col;
+            entries[entry_count].id = id;
+            entries[entry_count].next = cell_head[cell];
+            cell_head[cell] = entry_count++;
+        }
+    }
+}
+
+void collide_remove(int id) {
+    if (id < 0 || id >= COLLIDE_MAX_OBJECTS) return;
+    obj_alive[id] = false;
+}
+
+int collide_first_hit(int32_t x, int32_t y, int32_t r) {
+    int best = -1;
+
+    // An object in several cells may be met more than once; the lowest
+    // id test makes that harmless
+    cell_range_t cells = cells_for_circle(x, y, r);
+    for (int row = cells.row0; row <= cells.row1; row++) {
+        for (int col = cells.col0; col <= cells.col1; col++) {
+            for (int e = cell_head[row * COLLIDE_COLS + col]; e != NO_ENTRY; e = entries[e].next) {
+                int id = entries[e].id;
+                if (!obj_alive[id] || (best >= 0 && id >= best)) continue;
+                if (collide_circles(x, y, r, obj_x[id], obj_y[id], obj_r[id])) {
+                    best = id;
+                }
+            }
+        }
+    }
+    return best;
+}
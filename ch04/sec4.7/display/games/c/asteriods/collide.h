@@ -0,0 +1,56 @@
+#ifndef COLLIDE_H
+#define COLLIDE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Circle collisions for the game, without the display, so the game and
+// the host soak test in bench/ share them. Positions and radii are 16.16
+// fixed point like the rest of the game.
+//
+// Broadphase: a uniform grid of COLLIDE_CELL_SIZE cells, each with a
+// list of the objects whose bounding box touches it. A query only tests
+// the objects listed in the cells its own box touches.
+
+#ifndef COLLIDE_MAX_OBJECTS
+#define COLLIDE_MAX_OBJECTS 64
+#endif
+
+// Cells of 32 pixels; an object may be up to a cell in radius, so it
+// is listed in at most 3x3 cells
+#define COLLIDE_CELL_SHIFT 5
+#define COLLIDE_CELL_SIZE  (1 << COLLIDE_CELL_SHIFT)
+#define COLLIDE_MAX_CELLS_PER_OBJECT 9
+
+// Objects wrap a little beyond the edges of the screen, not at them,
+// so the grid covers those margins as well: x from -32, y from 0, in
+// pixels. Anything further out goes in the edge cells
+#define COLLIDE_ORIGIN_X (-32)
+#define COLLIDE_ORIGIN_Y 0
+#define COLLIDE_COLS 12
+#define COLLIDE_ROWS 9
+
+// Empty the grid, before inserting this frame's objects
+void collide_clear(void);
+
+// List object id (0 .. COLLIDE_MAX_OBJECTS - 1) at x, y with radius r
+void collide_insert(int id, int32_t x, int32_t y, int32_t r);
+
+// Take id out of later queries, when it is destroyed
+void collide_remove(int id);
+
+// Lowest id whose circle overlaps the circle at x, y, r; -1 if none.
+// Lowest, so the result is the same as testing every object in order
+int collide_first_hit(int32_t x, int32_t y, int32_t r);
+
+// Narrowphase: compare squared distances in 64 bits, no sqrt and no
+// rounding to whole pixels
+static inline bool collide_circles(int32_t x1, int32_t y1, int32_t r1,
+                                   int32_t x2, int32_t y2, int32_t r2) {
+    int64_t dx = x1 - x2;
+    int64_t dy = y1 - y2;
+    int64_t r = (int64_t)r1 + r2;
+    return dx * dx + dy * dy < r * r;
+}
+
+#endif // COLLIDE_H
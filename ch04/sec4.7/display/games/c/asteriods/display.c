@@ -40,6 +40,21 @@ static bool buttons_initialized = false;
 static uint8_t dma_fill_buffer[512]; // Buffer for repeated color data
 static uint8_t dma_single_pixel[2];  // Single pixel buffer for DMA
 
+// Point batch: pixels plotted between display_points_begin() and
+// display_points_end() are bucketed by row and sent as horizontal runs
+#define POINT_BATCH_SIZE 2048
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint16_t color;
+} batch_point_t;
+static batch_point_t batch_points[POINT_BATCH_SIZE];
+static batch_point_t batch_sorted[POINT_BATCH_SIZE];
+static uint16_t batch_row_start[DISPLAY_HEIGHT + 1];
+static uint16_t batch_count = 0;
+static bool batch_active = false;
+static uint8_t batch_run[DISPLAY_WIDTH * 2]; // One run of pixel data
+
 // Button pin mapping
 static const uint8_t button_pins[BUTTON_COUNT] = {
     BUTTON_A_PIN, BUTTON_B_PIN, BUTTON_X_PIN, BUTTON_Y_PIN
@@ -466,6 +481,102 @@ display_error_t display_draw_pixel(uint16_t x, uint16_t y, uint16_t color) {
     return display_fill_rect(x, y, 1, 1, color);
 }
 
+// Send one row's run of pixels with a single window command
+static display_error_t points_send_run(uint16_t x0, uint16_t y, uint16_t len) {
+    display_error_t result = display_set_window(x0, y, x0 + len - 1, y);
+    if (result != DISPLAY_OK) return result;
+    return display_write_data_buf(batch_run, len * 2);
+}
+
+// Sort the batch by row, then by x within each row, and send every run of
+// adjacent pixels. A pixel plotted twice keeps the colour plotted last
+static display_error_t points_flush(void) {
+    display_error_t result = DISPLAY_OK;
+    if (batch_count == 0) return result;
+
+    // Counting sort by row; stable, so plot order survives within a row
+    memset(batch_row_start, 0, sizeof(batch_row_start));
+    for (uint16_t i = 0; i < batch_count; i++) {
+        batch_row_start[batch_points[i].y + 1]++;
+    }
+    for (int y = 0; y < DISPLAY_HEIGHT; y++) {
+        batch_row_start[y + 1] += batch_row_start[y];
+    }
+    for (uint16_t i = 0; i < batch_count; i++) {
+        batch_sorted[batch_row_start[batch_points[i].y]++] = batch_points[i];
+    }
+    // The scatter moved each start to the next row's start; shift back
+    for (int y = DISPLAY_HEIGHT; y > 0; y--) {
+        batch_row_start[y] = batch_row_start[y - 1];
+    }
+    batch_row_start[0] = 0;
+
+    for (int y = 0; y < DISPLAY_HEIGHT && result == DISPLAY_OK; y++) {
+        batch_point_t *row = &batch_sorted[batch_row_start[y]];
+        uint16_t n = batch_row_start[y + 1] - batch_row_start[y];
+        if (n == 0) continue;
+
+        // Rows hold a few points each, so insertion sort (stable) is enough
+        for (uint16_t i = 1; i < n; i++) {
+            batch_point_t p = row[i];
+            uint16_t j = i;
+            while (j > 0 && row[j - 1].x > p.x) {
+                row[j] = row[j - 1];
+                j--;
+            }
+            row[j] = p;
+        }
+
+        uint16_t run_x = row[0].x;
+        uint16_t run_len = 0;
+        for (uint16_t i = 0; i < n; i++) {
+            uint16_t x = row[i].x;
+            if (run_len > 0 && x == run_x + run_len - 1) {
+                run_len--; // Same pixel again: overwrite its colour
+            } else if (run_len > 0 && x != run_x + run_len) {
+                result = points_send_run(run_x, y, run_len);
+                if (result != DISPLAY_OK) break;
+                run_x = x;
+                run_len = 0;
+            }
+            batch_run[run_len * 2] = row[i].color >> 8;
+            batch_run[run_len * 2 + 1] = row[i].color & 0xFF;
+            run_len++;
+        }
+        if (result == DISPLAY_OK) {
+            result = points_send_run(run_x, y, run_len);
+        }
+    }
+
+    batch_count = 0;
+    return result;
+}
+
+display_error_t display_points_begin(void) {
+    if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
+    batch_count = 0;
+    batch_active = true;
+    return DISPLAY_OK;
+}
+
+display_error_t display_points_add(uint16_t x, uint16_t y, uint16_t color) {
+    if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
+    if (!batch_active) return display_draw_pixel(x, y, color);
+
+    if (batch_count == POINT_BATCH_SIZE) {
+        display_error_t result = points_flush();
+        if (result != DISPLAY_OK) return result;
+    }
+    batch_points[batch_count++] = (batch_point_t){x, y, color};
+    return DISPLAY_OK;
+}
+
+display_error_t display_points_end(void) {
+    if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
+    batch_active = false;
+    return points_flush();
+}
+
 display_error_t display_blit_full(const uint16_t *pixels) {
     if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
     if (!pixels) return DISPLAY_ERROR_INVALID_PARAM;
@@ -484,6 +595,39 @@ display_error_t display_blit_full(const uint16_t *pixels) {
     return result;
 }
 
+display_error_t display_blit_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                                  const uint16_t *pixels, uint16_t stride) {
+    if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
+    if (!pixels || stride < width) return DISPLAY_ERROR_INVALID_PARAM;
+    if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
+
+    // Clamp dimensions to display bounds
+    if (x + width > DISPLAY_WIDTH) width = DISPLAY_WIDTH - x;
+    if (y + height > DISPLAY_HEIGHT) height = DISPLAY_HEIGHT - y;
+    if (width == 0 || height == 0) return DISPLAY_OK;
+
+    display_error_t result = display_set_window(x, y, x + width - 1, y + height - 1);
+    if (result != DISPLAY_OK) return result;
+
+    dma_wait_for_finish();
+    gpio_put(DISPLAY_DC_PIN, 1);
+    gpio_put(DISPLAY_CS_PIN, 0);
+
+    if (stride == width) {
+        // Rows follow each other in memory: one transfer
+        result = dma_spi_write_buffer((uint8_t *)pixels, (size_t)width * height * 2);
+    } else {
+        // The window wraps rows on its own, so the rows just go out in turn
+        for (uint16_t row = 0; row < height && result == DISPLAY_OK; row++) {
+            result = dma_spi_write_buffer((uint8_t *)&pixels[(size_t)row * stride], width * 2);
+        }
+    }
+    dma_wait_for_finish();
+
+    gpio_put(DISPLAY_CS_PIN, 1);
+    return result;
+}
+
 display_error_t display_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg_color) {
     if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
     if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
@@ -46,6 +46,17 @@ display_error_t display_clear(uint16_t color);
 display_error_t display_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color);
 display_error_t display_draw_pixel(uint16_t x, uint16_t y, uint16_t color);
 display_error_t display_blit_full(const uint16_t *pixels);
+// Send a rectangle of pixels: pixels is its top left pixel and stride the
+// pixels from one row to the next. Like display_blit_full the pixels go
+// out as stored, so they hold RGB565 with the bytes swapped
+display_error_t display_blit_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                                  const uint16_t *pixels, uint16_t stride);
+// Point batch: plot pixels between begin and end; end groups them by row
+// and sends each run of adjacent pixels with one window command.
+// Outside a batch display_points_add() draws the pixel at once
+display_error_t display_points_begin(void);
+display_error_t display_points_add(uint16_t x, uint16_t y, uint16_t color);
+display_error_t display_points_end(void);
 display_error_t display_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg_color);
 display_error_t display_draw_string(uint16_t x, uint16_t y, const char* str, uint16_t color, uint16_t bg_color);
 display_error_t display_set_backlight(bool on);
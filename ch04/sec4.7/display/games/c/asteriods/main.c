@@ -1,9 +1,11 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
+#include <string.h>
 #include "pico/stdlib.h"
 #include "hardware/pwm.h"
 #include "display.h"
+#include "collide.h"
+#include "fixed.h"
 
 // RGB LED pins
 #define LED_R       6
@@ -18,14 +20,11 @@
 #define GAME_AREA_WIDTH 320
 #define GAME_AREA_HEIGHT 220
 
-// Fixed-point arithmetic (16.16 format)
-#define FIXED_SHIFT 16
-#define FIXED_ONE (1 << FIXED_SHIFT)
-#define INT_TO_FIXED(x) ((x) << FIXED_SHIFT)
-#define FIXED_TO_INT(x) ((x) >> FIXED_SHIFT)
-#define FLOAT_TO_FIXED(x) ((int32_t)((x) * FIXED_ONE))
-#define FIXED_MUL(a, b) (((int64_t)(a) * (b)) >> FIXED_SHIFT)
-#define FIXED_DIV(a, b) (((int64_t)(a) << FIXED_SHIFT) / (b))
+// 1: draw the game area into an off-screen frame and send only the parts
+// that changed; 0: plot straight to the display as point batches
+#ifndef ASTEROIDS_FRAMEBUFFER
+#define ASTEROIDS_FRAMEBUFFER 1
+#endif
 
 // Ship constants
 #define SHIP_SIZE 10
@@ -41,6 +40,9 @@
 
 // Asteroid constants
 #define MAX_ASTEROIDS 10
+#if MAX_ASTEROIDS > COLLIDE_MAX_OBJECTS
+#error "MAX_ASTEROIDS is more than the collision grid holds"
+#endif
 #define ASTEROID_MIN_SIZE 12
 #define ASTEROID_MAX_SIZE 25
 #define INITIAL_ASTEROIDS 6  // Increased from 4 for higher difficulty
@@ -109,6 +111,19 @@ bool prev_btn_x = false;
 int sin_table[256];
 int cos_table[256];
 
+#if ASTEROIDS_FRAMEBUFFER
+// Game area frame, RGB565 stored byte swapped as display_blit_rect sends it
+#define FB_COLOR(c) ((uint16_t)(((c) >> 8) | ((c) << 8)))
+static uint16_t frame[GAME_AREA_HEIGHT][GAME_AREA_WIDTH];
+
+// Rectangles of the frame to send this frame. Close ones are merged, as
+// each blit costs a window command, worth about DIRTY_BLIT_COST pixels
+#define MAX_DIRTY 16
+#define DIRTY_BLIT_COST 256
+static BoundingRect dirty[MAX_DIRTY];
+static int dirty_count = 0;
+#endif
+
 // LED Control Functions
 void init_led() {
     gpio_set_function(LED_R, GPIO_FUNC_PWM);
@@ -138,19 +153,6 @@ void set_led(uint8_t r, uint8_t g, uint8_t b) {
     pwm_set_chan_level(slice_b, pwm_gpio_to_channel(LED_B), 255 - b);
 }
 
-// Math functions - optimized
-int32_t fast_sqrt(int32_t x) {
-    if (x <= 0) return 0;
-    if (x < FIXED_ONE) return x;
-    
-    // Simple approximation for performance
-    uint32_t result = x >> 1;
-    for (int i = 0; i < 4; i++) {
-        result = (result + x / result) >> 1;
-    }
-    return result;
-}
-
 int my_sin(int angle) {
     return sin_table[angle & 0xFF];
 }
@@ -161,9 +163,187 @@ int my_cos(int angle) {
 
 void init_trig_tables() {
     for (int i = 0; i < 256; i++) {
-        sin_table[i] = (int)(sin(2.0 * M_PI * i / 256.0) * 127.0);
-        cos_table[i] = (int)(cos(2.0 * M_PI * i / 256.0) * 127.0);
+        // 256 steps to the turn, scaled to +-127 and truncated as before
+        sin_table[i] = (int)(((int64_t)fx_sin((fx_angle_t)(i << 8)) * 127) / FX_ONE);
+        cos_table[i] = (int)(((int64_t)fx_cos((fx_angle_t)(i << 8)) * 127) / FX_ONE);
+    }
+}
+
+#if ASTEROIDS_FRAMEBUFFER
+// Horizontal run of pixels in the frame, screen coordinates, already clipped
+static inline void fb_span(int y, int x0, int x1, uint16_t color) {
+    uint16_t *p = &frame[y - GAME_AREA_Y][x0];
+    for (int x = x0; x <= x1; x++) *p++ = color;
+}
+
+void plot_point(int x, int y, uint16_t color) {
+    if (x < GAME_AREA_X || x >= GAME_AREA_X + GAME_AREA_WIDTH ||
+        y < GAME_AREA_Y || y >= GAME_AREA_Y + GAME_AREA_HEIGHT) return;
+    frame[y - GAME_AREA_Y][x] = FB_COLOR(color);
+}
+
+// Cohen-Sutherland outcodes against the game area
+#define CLIP_LEFT   1
+#define CLIP_RIGHT  2
+#define CLIP_TOP    4
+#define CLIP_BOTTOM 8
+
+static int clip_code(int x, int y) {
+    int code = 0;
+    if (x < GAME_AREA_X) code |= CLIP_LEFT;
+    else if (x > GAME_AREA_X + GAME_AREA_WIDTH - 1) code |= CLIP_RIGHT;
+    if (y < GAME_AREA_Y) code |= CLIP_TOP;
+    else if (y > GAME_AREA_Y + GAME_AREA_HEIGHT - 1) code |= CLIP_BOTTOM;
+    return code;
+}
+
+// n / d rounded to nearest, so clipped ends stay on the line
+static int div_round(int n, int d) {
+    if (d < 0) { n = -n; d = -d; }
+    return n >= 0 ? (n + d / 2) / d : -((-n + d / 2) / d);
+}
+
+// Trim the line to the game area; false when none of it is inside
+static bool clip_line(int *x0, int *y0, int *x1, int *y1) {
+    int code0 = clip_code(*x0, *y0);
+    int code1 = clip_code(*x1, *y1);
+
+    while (true) {
+        if (!(code0 | code1)) return true;
+        if (code0 & code1) return false;
+
+        // Move the end that is outside onto the edge it is beyond
+        int code = code0 ? code0 : code1;
+        int dx = *x1 - *x0, dy = *y1 - *y0;
+        int x, y;
+        if (code & CLIP_TOP) {
+            y = GAME_AREA_Y;
+            x = *x0 + div_round(dx * (y - *y0), dy);
+        } else if (code & CLIP_BOTTOM) {
+            y = GAME_AREA_Y + GAME_AREA_HEIGHT - 1;
+            x = *x0 + div_round(dx * (y - *y0), dy);
+        } else if (code & CLIP_LEFT) {
+            x = GAME_AREA_X;
+            y = *y0 + div_round(dy * (x - *x0), dx);
+        } else {
+            x = GAME_AREA_X + GAME_AREA_WIDTH - 1;
+            y = *y0 + div_round(dy * (x - *x0), dx);
+        }
+
+        if (code == code0) {
+            *x0 = x; *y0 = y;
+            code0 = clip_code(x, y);
+        } else {
+            *x1 = x; *y1 = y;
+            code1 = clip_code(x, y);
+        }
+    }
+}
+
+// Clip once, then Bresenham over the inside part only. Pixels on one row
+// are written as a span when the row changes, not one by one
+void draw_line_clipped(int x0, int y0, int x1, int y1, uint16_t color) {
+    if (!clip_line(&x0, &y0, &x1, &y1)) return;
+    color = FB_COLOR(color);
+
+    int dx = abs(x1 - x0);
+    int dy = abs(y1 - y0);
+    int sx = x0 < x1 ? 1 : -1;
+    int sy = y0 < y1 ? 1 : -1;
+    int err = dx - dy;
+    int run_x = x0;
+
+    while (true) {
+        if (x0 == x1 && y0 == y1) break;
+
+        int e2 = 2 * err;
+        if (e2 > -dy) {
+            err -= dy;
+            x0 += sx;
+        }
+        if (e2 < dx) {
+            err += dx;
+            // Leaving the row: write what was drawn on it
+            int prev_x = (e2 > -dy) ? x0 - sx : x0;
+            fb_span(y0, min(run_x, prev_x), max(run_x, prev_x), color);
+            y0 += sy;
+            run_x = x0;
+        }
+    }
+    fb_span(y0, min(run_x, x0), max(run_x, x0), color);
+}
+
+// Clipped clear rect, in the frame; the area is sent with the dirty rects
+void clear_object_rect(BoundingRect *rect) {
+    int minx = max(rect->min_x, GAME_AREA_X);
+    int maxx = min(rect->max_x, GAME_AREA_X + GAME_AREA_WIDTH - 1);
+    int miny = max(rect->min_y, GAME_AREA_Y);
+    int maxy = min(rect->max_y, GAME_AREA_Y + GAME_AREA_HEIGHT - 1);
+    if (minx > maxx || miny > maxy) return;
+    for (int y = miny; y <= maxy; y++) {
+        memset(&frame[y - GAME_AREA_Y][minx], 0, (maxx - minx + 1) * sizeof(uint16_t));
+    }
+}
+
+static int rect_area(BoundingRect r) {
+    return (r.max_x - r.min_x + 1) * (r.max_y - r.min_y + 1);
+}
+
+static BoundingRect rect_union(BoundingRect a, BoundingRect b) {
+    return (BoundingRect){min(a.min_x, b.min_x), min(a.min_y, b.min_y),
+                          max(a.max_x, b.max_x), max(a.max_y, b.max_y)};
+}
+
+// Merging pays when the union sends fewer extra pixels than a blit costs
+static bool worth_merging(BoundingRect a, BoundingRect b) {
+    return rect_area(rect_union(a, b)) <= rect_area(a) + rect_area(b) + DIRTY_BLIT_COST;
+}
+
+void mark_dirty(BoundingRect r) {
+    r.min_x = max(r.min_x, GAME_AREA_X);
+    r.max_x = min(r.max_x, GAME_AREA_X + GAME_AREA_WIDTH - 1);
+    r.min_y = max(r.min_y, GAME_AREA_Y);
+    r.max_y = min(r.max_y, GAME_AREA_Y + GAME_AREA_HEIGHT - 1);
+    if (r.min_x > r.max_x || r.min_y > r.max_y) return;
+
+    // Grow into an existing rect when that is cheaper, and keep merging
+    // as the grown rect may now pay to join others
+    for (int i = 0; i < dirty_count; i++) {
+        if (worth_merging(dirty[i], r)) {
+            r = rect_union(dirty[i], r);
+            dirty[i] = dirty[--dirty_count];
+            i = -1;
+        }
+    }
+
+    if (dirty_count == MAX_DIRTY) {
+        // Full: fold into the rect it grows least
+        int best = 0, best_growth = 0;
+        for (int i = 0; i < dirty_count; i++) {
+            int growth = rect_area(rect_union(dirty[i], r)) - rect_area(dirty[i]);
+            if (i == 0 || growth < best_growth) {
+                best = i;
+                best_growth = growth;
+            }
+        }
+        dirty[best] = rect_union(dirty[best], r);
+        return;
     }
+    dirty[dirty_count++] = r;
+}
+
+void flush_dirty() {
+    for (int i = 0; i < dirty_count; i++) {
+        BoundingRect *r = &dirty[i];
+        display_blit_rect(r->min_x, r->min_y,
+                          r->max_x - r->min_x + 1, r->max_y - r->min_y + 1,
+                          &frame[r->min_y - GAME_AREA_Y][r->min_x], GAME_AREA_WIDTH);
+    }
+    dirty_count = 0;
+}
+#else
+void plot_point(int x, int y, uint16_t color) {
+    display_points_add(x, y, color);
 }
 
 // Fast line drawing with clipping
@@ -182,7 +362,7 @@ void draw_line_clipped(int x0, int y0, int x1, int y1, uint16_t color) {
     
     while (true) {
         if (x0 >= 0 && x0 < DISPLAY_WIDTH && y0 >= 0 && y0 < DISPLAY_HEIGHT) {
-            display_draw_pixel(x0, y0, color);
+            display_points_add(x0, y0, color);
         }
         if (x0 == x1 && y0 == y1) break;
         
@@ -198,6 +378,17 @@ void draw_line_clipped(int x0, int y0, int x1, int y1, uint16_t color) {
     }
 }
 
+// Clipped clear rect
+void clear_object_rect(BoundingRect *rect) {
+    int minx = max(rect->min_x, GAME_AREA_X);
+    int maxx = min(rect->max_x, GAME_AREA_X + GAME_AREA_WIDTH - 1);
+    int miny = max(rect->min_y, GAME_AREA_Y);
+    int maxy = min(rect->max_y, GAME_AREA_Y + GAME_AREA_HEIGHT - 1);
+    if (minx > maxx || miny > maxy) return;
+    display_fill_rect(minx, miny, maxx - minx + 1, maxy - miny + 1, COLOR_BLACK);
+}
+#endif
+
 // Wrap coordinates to screen, keeping ship out of UI area
 void wrap_position(int32_t *x, int32_t *y) {
     int screen_x = FIXED_TO_INT(*x);
@@ -211,16 +402,6 @@ void wrap_position(int32_t *x, int32_t *y) {
     else if (screen_y > GAME_AREA_HEIGHT + GAME_AREA_Y + 20) *y = INT_TO_FIXED(GAME_AREA_Y + 20);
 }
 
-// Clipped clear rect
-void clear_object_rect(BoundingRect *rect) {
-    int minx = max(rect->min_x, GAME_AREA_X);
-    int maxx = min(rect->max_x, GAME_AREA_X + GAME_AREA_WIDTH - 1);
-    int miny = max(rect->min_y, GAME_AREA_Y);
-    int maxy = min(rect->max_y, GAME_AREA_Y + GAME_AREA_HEIGHT - 1);
-    if (minx > maxx || miny > maxy) return;
-    display_fill_rect(minx, miny, maxx - minx + 1, maxy - miny + 1, COLOR_BLACK);
-}
-
 // Ship functions
 BoundingRect get_ship_bounds() {
     int sx = FIXED_TO_INT(ship.x);
@@ -269,7 +450,7 @@ void init_ship() {
     ship.angle = 0;
     ship.thrusting = false;
     ship.radius = INT_TO_FIXED(SHIP_SIZE);
-    ship.was_drawn = false;
+    // was_drawn stays, so the ship lost this frame is still cleared
     respawn_timer = 60;
 }
 
@@ -308,7 +489,7 @@ void update_ship() {
     // Limit speed
     int32_t speed_sq = FIXED_MUL(ship.dx, ship.dx) + FIXED_MUL(ship.dy, ship.dy);
     if (speed_sq > FIXED_MUL(MAX_SPEED, MAX_SPEED)) {
-        int32_t speed = fast_sqrt(speed_sq);
+        int32_t speed = fx_sqrt(speed_sq);
         ship.dx = FIXED_DIV(FIXED_MUL(ship.dx, MAX_SPEED), speed);
         ship.dy = FIXED_DIV(FIXED_MUL(ship.dy, MAX_SPEED), speed);
     }
@@ -371,8 +552,9 @@ void shoot_bullet() {
     
     for (int i = 0; i < MAX_BULLETS; i++) {
         if (!bullets[i].active) {
+            // was_active stays: a bullet that ended this frame still
+            // has its old image to clear
             bullets[i].active = true;
-            bullets[i].was_active = false;
             bullets[i].x = ship.x;
             bullets[i].y = ship.y;
             
@@ -415,10 +597,10 @@ void draw_bullets() {
         int by = FIXED_TO_INT(bullets[i].y);
         
         if (bx >= 0 && bx < DISPLAY_WIDTH-2 && by >= 0 && by < DISPLAY_HEIGHT-2) {
-            display_draw_pixel(bx, by, COLOR_WHITE);
-            display_draw_pixel(bx + 1, by, COLOR_WHITE);
-            display_draw_pixel(bx, by + 1, COLOR_WHITE);
-            display_draw_pixel(bx + 1, by + 1, COLOR_WHITE);
+            plot_point(bx, by, COLOR_WHITE);
+            plot_point(bx + 1, by, COLOR_WHITE);
+            plot_point(bx, by + 1, COLOR_WHITE);
+            plot_point(bx + 1, by + 1, COLOR_WHITE);
         }
     }
 }
@@ -440,11 +622,13 @@ BoundingRect get_asteroid_bounds(Asteroid *a) {
     return (BoundingRect){minx - 1, miny - 1, maxx + 1, maxy + 1};
 }
 
-void create_asteroid(int32_t x, int32_t y, int32_t size) {
+// Returns the slot used, -1 when all are taken
+int create_asteroid(int32_t x, int32_t y, int32_t size) {
     for (int i = 0; i < MAX_ASTEROIDS; i++) {
         if (!asteroids[i].active) {
+            // was_active stays, so an asteroid destroyed this frame in
+            // the same slot is still cleared
             asteroids[i].active = true;
-            asteroids[i].was_active = false;
             asteroids[i].x = x;
             asteroids[i].y = y;
             asteroids[i].size = size;
@@ -467,15 +651,15 @@ void create_asteroid(int32_t x, int32_t y, int32_t size) {
                 asteroids[i].vertices[j][0] = (radius * my_cos(vertex_angle)) / 127;
                 asteroids[i].vertices[j][1] = (radius * my_sin(vertex_angle)) / 127;
             }
-            break;
+            return i;
         }
     }
+    return -1;
 }
 
 void init_asteroids() {
     for (int i = 0; i < MAX_ASTEROIDS; i++) {
         asteroids[i].active = false;
-        asteroids[i].was_active = false;
     }
     
     for (int i = 0; i < INITIAL_ASTEROIDS; i++) {
@@ -527,56 +711,48 @@ void draw_asteroids() {
 }
 
 // Collision detection - simplified
-bool check_collision(int32_t x1, int32_t y1, int32_t r1, int32_t x2, int32_t y2, int32_t r2) {
-    int dx = FIXED_TO_INT(x1 - x2);
-    int dy = FIXED_TO_INT(y1 - y2);
-    int min_dist = FIXED_TO_INT(r1 + r2);
-    
-    // Simple distance check
-    return (dx * dx + dy * dy) < (min_dist * min_dist);
+// Put a new asteroid in the grid, so bullets later this frame can hit it
+void grid_add_asteroid(int j) {
+    if (j >= 0) collide_insert(j, asteroids[j].x, asteroids[j].y, asteroids[j].radius);
 }
 
 void check_collisions() {
+    // Asteroids don't move during this, so the grid is built once. A
+    // bullet or the ship tests only asteroids in the cells it touches,
+    // and gets the lowest slot it hits, as the loop over every asteroid did
+    collide_clear();
+    for (int j = 0; j < MAX_ASTEROIDS; j++) {
+        if (asteroids[j].active) grid_add_asteroid(j);
+    }
+    
     // Bullet-asteroid collisions
     for (int i = 0; i < MAX_BULLETS; i++) {
         if (!bullets[i].active) continue;
         
-        for (int j = 0; j < MAX_ASTEROIDS; j++) {
-            if (!asteroids[j].active) continue;
-            
-            if (check_collision(bullets[i].x, bullets[i].y, INT_TO_FIXED(4),
-                               asteroids[j].x, asteroids[j].y, asteroids[j].radius)) {
-                
-                bullets[i].active = false;
-                asteroids[j].active = false;
-                score += 100;
-                
-                // Split asteroid if large enough, increased threshold for difficulty
-                if (asteroids[j].size > INT_TO_FIXED(ASTEROID_MIN_SIZE + 6)) {
-                    int32_t new_size = asteroids[j].size * 2 / 3;
-                    create_asteroid(asteroids[j].x + INT_TO_FIXED(8), asteroids[j].y, new_size);
-                    create_asteroid(asteroids[j].x - INT_TO_FIXED(8), asteroids[j].y, new_size);
-                }
-                break;
-            }
+        int j = collide_first_hit(bullets[i].x, bullets[i].y, INT_TO_FIXED(4));
+        if (j < 0) continue;
+        
+        bullets[i].active = false;
+        asteroids[j].active = false;
+        collide_remove(j);
+        score += 100;
+        
+        // Split asteroid if large enough, increased threshold for difficulty
+        if (asteroids[j].size > INT_TO_FIXED(ASTEROID_MIN_SIZE + 6)) {
+            int32_t new_size = asteroids[j].size * 2 / 3;
+            grid_add_asteroid(create_asteroid(asteroids[j].x + INT_TO_FIXED(8), asteroids[j].y, new_size));
+            grid_add_asteroid(create_asteroid(asteroids[j].x - INT_TO_FIXED(8), asteroids[j].y, new_size));
         }
     }
     
     // Ship-asteroid collisions
-    if (respawn_timer <= 0) {
-        for (int j = 0; j < MAX_ASTEROIDS; j++) {
-            if (!asteroids[j].active) continue;
-            
-            if (check_collision(ship.x, ship.y, ship.radius,
-                               asteroids[j].x, asteroids[j].y, asteroids[j].radius)) {
-                lives--;
-                if (lives > 0) {
-                    init_ship();
-                } else {
-                    game_over = true;
-                }
-                break;
-            }
+    if (respawn_timer <= 0 &&
+        collide_first_hit(ship.x, ship.y, ship.radius) >= 0) {
+        lives--;
+        if (lives > 0) {
+            init_ship();
+        } else {
+            game_over = true;
         }
     }
 }
@@ -677,6 +853,40 @@ void game_loop() {
     
     update_led();
     
+#if ASTEROIDS_FRAMEBUFFER
+    if (need_full_clear) {
+        // The frame holds exactly what is drawn, so nothing is left
+        // behind to clean up periodically; only a reset clears it all
+        display_fill_rect(0, 0, DISPLAY_WIDTH, GAME_AREA_Y, COLOR_BLACK);
+        memset(frame, 0, sizeof(frame));
+        mark_dirty((BoundingRect){GAME_AREA_X, GAME_AREA_Y,
+                                  GAME_AREA_X + GAME_AREA_WIDTH - 1,
+                                  GAME_AREA_Y + GAME_AREA_HEIGHT - 1});
+        need_full_clear = false;
+    } else {
+        // Erase old object positions in the frame; they are sent below
+        if (ship.was_drawn) {
+            clear_object_rect(&ship.prev_rect);
+            mark_dirty(ship.prev_rect);
+        }
+        for (int i = 0; i < MAX_BULLETS; i++) {
+            if (bullets[i].was_active) {
+                clear_object_rect(&bullets[i].prev_rect);
+                mark_dirty(bullets[i].prev_rect);
+            }
+        }
+        for (int i = 0; i < MAX_ASTEROIDS; i++) {
+            if (asteroids[i].was_active) {
+                clear_object_rect(&asteroids[i].prev_rect);
+                mark_dirty(asteroids[i].prev_rect);
+            }
+        }
+    }
+    
+    draw_ship();
+    draw_bullets();
+    draw_asteroids();
+#else
     // Periodic full clear every 60 frames (~1.2s at 50 FPS)
     if (need_full_clear || (clear_counter % 60 == 0)) {
         // Clear entire screen (UI + game area)
@@ -699,11 +909,13 @@ void game_loop() {
         }
     }
     
-    // Draw everything
+    // Draw everything; lines and bullets are plotted as one point batch
+    display_points_begin();
     draw_ship();
     draw_bullets();
     draw_asteroids();
-    draw_ui();
+    display_points_end();
+#endif
     
     // Update previous states
     if (ship_visible) {
@@ -724,6 +936,20 @@ void game_loop() {
         }
         asteroids[i].was_active = asteroids[i].active;
     }
+    
+#if ASTEROIDS_FRAMEBUFFER
+    // Where the objects are now is dirty too; then send it all
+    if (ship.was_drawn) mark_dirty(ship.prev_rect);
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (bullets[i].was_active) mark_dirty(bullets[i].prev_rect);
+    }
+    for (int i = 0; i < MAX_ASTEROIDS; i++) {
+        if (asteroids[i].was_active) mark_dirty(asteroids[i].prev_rect);
+    }
+    flush_dirty();
+#endif
+    
+    draw_ui();
 }
 
 int main() {
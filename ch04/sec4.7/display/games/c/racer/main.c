@@ -1,9 +1,10 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
 #include "pico/stdlib.h"
 #include "hardware/pwm.h"
 #include "display.h"
+#include "track.h"
+#include "fixed.h"
 
 // RGB LED pins
 #define LED_R       6
@@ -15,21 +16,11 @@
 
 // Game constants
 #define SCREEN_SIZE 240
-#define MAP_SCALE 40
 #define OFFSET_X 10
 #define OFFSET_Y 30
 #define GAME_AREA_WIDTH  240
 #define GAME_AREA_HEIGHT 200
 
-// Fixed-point arithmetic (16.16 format)
-#define FIXED_SHIFT 16
-#define FIXED_ONE (1 << FIXED_SHIFT)  // 65536
-#define INT_TO_FIXED(x) ((x) << FIXED_SHIFT)
-#define FIXED_TO_INT(x) ((x) >> FIXED_SHIFT)
-#define FLOAT_TO_FIXED(x) ((int32_t)((x) * FIXED_ONE))
-#define FIXED_MUL(a, b) (((int64_t)(a) * (b)) >> FIXED_SHIFT)
-#define FIXED_DIV(a, b) (((int64_t)(a) << FIXED_SHIFT) / (b))
-
 // Game state using fixed-point
 int theta = 0;
 int32_t x = INT_TO_FIXED(70);     // 70.0 in fixed-point
@@ -46,8 +37,8 @@ int prev_theta = 0;
 bool track_dirty = true;
 bool full_screen_clear_needed = true;
 
-// Map data
-int map[5][6] = {
+// Map data: tile types, see track.h
+const int map[MAP_ROWS][MAP_COLS] = {
     {2,1,2,5,5,1},
     {6,6,6,2,1,6},
     {6,6,6,6,3,4},
@@ -59,6 +50,15 @@ int map[5][6] = {
 int sin_table[256];
 int cos_table[256];
 
+// Pre-rendered background: bit x of background[y] is set where the
+// track lines are, drawn once at start. Erasing the car puts back what
+// this says was under it
+static uint32_t background[DISPLAY_HEIGHT][(DISPLAY_WIDTH + 31) / 32];
+
+// Where draw_line() puts its pixels: the display, or the background
+// while it is rendered
+typedef void (*plot_fn)(int px, int py, uint16_t color);
+
 // Button states
 bool prev_btn_a = false; // For reset detection
 
@@ -91,22 +91,6 @@ void set_led(uint8_t r, uint8_t g, uint8_t b) {
     pwm_set_chan_level(slice_b, pwm_gpio_to_channel(LED_B), 255 - b);
 }
 
-// Fixed-point square root approximation
-int32_t fixed_sqrt(int32_t x) {
-    if (x <= 0) return 0;
-    
-    int32_t result = x;
-    int32_t temp;
-    
-    // Newton's method for square root (a few iterations)
-    for (int i = 0; i < 8; i++) {
-        temp = FIXED_DIV(x, result);
-        result = (result + temp) >> 1;
-    }
-    
-    return result;
-}
-
 int my_sin(int angle) {
     return sin_table[angle & 0xFF];
 }
@@ -117,11 +101,39 @@ int my_cos(int angle) {
 
 void init_trig_tables() {
     for (int i = 0; i < 256; i++) {
-        sin_table[i] = (int)(sin(2.0 * M_PI * i / 256.0) * 127.0);
-        cos_table[i] = (int)(cos(2.0 * M_PI * i / 256.0) * 127.0);
+        // 256 steps to the turn, scaled to +-127 and truncated as before
+        sin_table[i] = (int)(((int64_t)fx_sin((fx_angle_t)(i << 8)) * 127) / FX_ONE);
+        cos_table[i] = (int)(((int64_t)fx_cos((fx_angle_t)(i << 8)) * 127) / FX_ONE);
     }
 }
 
+void plot_display(int px, int py, uint16_t color) {
+    display_draw_pixel(px, py, color);
+}
+
+void plot_background(int px, int py, uint16_t color) {
+    (void)color;
+    if (px < 0 || px >= DISPLAY_WIDTH || py < 0 || py >= DISPLAY_HEIGHT) return;
+    background[py][px / 32] |= 1u << (px % 32);
+}
+
+// Colour of the background at a pixel: line, off-road, or outside the game area
+uint16_t background_color(int px, int py) {
+    if (px < 0 || px >= DISPLAY_WIDTH || py < 0 || py >= DISPLAY_HEIGHT) return COLOR_BLACK;
+    if (background[py][px / 32] & (1u << (px % 32))) return COLOR_GREEN;
+    if (px >= OFFSET_X && px < OFFSET_X + GAME_AREA_WIDTH &&
+        py >= OFFSET_Y && py < OFFSET_Y + GAME_AREA_HEIGHT) return DARK_GREEN;
+    return COLOR_BLACK;
+}
+
+// Put the background back instead of drawing the colour
+void plot_restore(int px, int py, uint16_t color) {
+    (void)color;
+    display_draw_pixel(px, py, background_color(px, py));
+}
+
+plot_fn plot = plot_display;
+
 // Helper function to draw a line using individual pixels
 void draw_line(int x0, int y0, int x1, int y1, uint16_t color) {
     int dx = abs(x1 - x0);
@@ -131,7 +143,7 @@ void draw_line(int x0, int y0, int x1, int y1, uint16_t color) {
     int err = dx - dy;
     
     while (true) {
-        display_draw_pixel(x0, y0, color);
+        plot(x0, y0, color);
         if (x0 == x1 && y0 == y1) break;
         
         int e2 = 2 * err;
@@ -196,13 +208,13 @@ void collide_corner(int x1, int y1) {
     int32_t dy = y - INT_TO_FIXED(y1);
     int32_t dist_sq = FIXED_MUL(dx, dx) + FIXED_MUL(dy, dy);
     
-    int32_t inner_radius_sq = INT_TO_FIXED(64);  // 8*8 = 64
-    int32_t outer_radius_sq = INT_TO_FIXED(1024); // 32*32 = 1024
+    int32_t inner_radius_sq = INT_TO_FIXED(CORNER_INNER * CORNER_INNER);
+    int32_t outer_radius_sq = INT_TO_FIXED(CORNER_OUTER * CORNER_OUTER);
     
     // If too close to corner (inside inner radius)
     if (dist_sq < inner_radius_sq) {
         if (dist_sq > 0) { // Avoid division by zero
-            int32_t dist = fixed_sqrt(dist_sq);
+            int32_t dist = fx_sqrt(dist_sq);
             int32_t min_dist = INT_TO_FIXED(10);
             // Push car away from corner to minimum distance
             x = INT_TO_FIXED(x1) + FIXED_DIV(FIXED_MUL(dx, min_dist), dist);
@@ -214,7 +226,7 @@ void collide_corner(int x1, int y1) {
     }
     // If too far from corner (outside outer radius) 
     else if (dist_sq > outer_radius_sq) {
-        int32_t dist = fixed_sqrt(dist_sq);
+        int32_t dist = fx_sqrt(dist_sq);
         int32_t max_dist = INT_TO_FIXED(30);
         // Pull car towards corner to maximum distance
         x = INT_TO_FIXED(x1) + FIXED_DIV(FIXED_MUL(dx, max_dist), dist);
@@ -227,8 +239,8 @@ void collide_corner(int x1, int y1) {
 
 void collide_vert(int x1, int y1, int s) {
     // Check collision with vertical walls (left and right edges)
-    int32_t left_wall = INT_TO_FIXED(x1 + 10);
-    int32_t right_wall = INT_TO_FIXED(x1 + s - 10);
+    int32_t left_wall = INT_TO_FIXED(x1 + TRACK_WALL);
+    int32_t right_wall = INT_TO_FIXED(x1 + s - TRACK_WALL);
     
     if (x < left_wall) {
         x = left_wall;
@@ -248,8 +260,8 @@ void collide_vert(int x1, int y1, int s) {
 
 void collide_horiz(int x1, int y1, int s) {
     // Check collision with horizontal walls (top and bottom edges)
-    int32_t top_wall = INT_TO_FIXED(y1 + 10);
-    int32_t bottom_wall = INT_TO_FIXED(y1 + s - 10);
+    int32_t top_wall = INT_TO_FIXED(y1 + TRACK_WALL);
+    int32_t bottom_wall = INT_TO_FIXED(y1 + s - TRACK_WALL);
     
     if (y < top_wall) {
         y = top_wall;
@@ -323,35 +335,13 @@ void draw_car() {
         int px4 = prev_car_px + prev_halfcos - prev_halfsin;
         int py4 = prev_car_py + prev_halfsin + prev_halfcos;
         
-        // Draw over previous car with dark green (off-road color)
-        draw_line(px1, py1, px2, py2, DARK_GREEN);
-        draw_line(px2, py2, px3, py3, DARK_GREEN);
-        draw_line(px3, py3, px4, py4, DARK_GREEN);
-        draw_line(px4, py4, px1, py1, DARK_GREEN);
-        
-        // Redraw road elements that might be under the previous car position
-        // Check which map cells the previous car was overlapping
-        int prev_grid_x = (prev_car_x) / MAP_SCALE;
-        int prev_grid_y = (prev_car_y) / MAP_SCALE;
-        
-        // Redraw the current cell and adjacent cells to handle car spanning multiple cells
-        for (int dy = -1; dy <= 1; dy++) {
-            for (int dx = -1; dx <= 1; dx++) {
-                int grid_x = prev_grid_x + dx;
-                int grid_y = prev_grid_y + dy;
-                
-                if (grid_x >= 0 && grid_x < 6 && grid_y >= 0 && grid_y < 5) {
-                    int map_value = map[grid_y][grid_x];
-                    if (map_value < 5) {
-                        draw_curve(OFFSET_X + grid_x * MAP_SCALE, OFFSET_Y + grid_y * MAP_SCALE, MAP_SCALE, map_value);
-                    } else if (map_value == 5) {
-                        draw_horiz(OFFSET_X + grid_x * MAP_SCALE, OFFSET_Y + grid_y * MAP_SCALE, MAP_SCALE);
-                    } else if (map_value == 6) {
-                        draw_vert(OFFSET_X + grid_x * MAP_SCALE, OFFSET_Y + grid_y * MAP_SCALE, MAP_SCALE);
-                    }
-                }
-            }
-        }
+        // Put back the background under each pixel of the previous car
+        plot = plot_restore;
+        draw_line(px1, py1, px2, py2, COLOR_BLACK);
+        draw_line(px2, py2, px3, py3, COLOR_BLACK);
+        draw_line(px3, py3, px4, py4, COLOR_BLACK);
+        draw_line(px4, py4, px1, py1, COLOR_BLACK);
+        plot = plot_display;
     }
     
     // Draw current car
@@ -383,13 +373,9 @@ void draw_car() {
     prev_theta = theta;
 }
 
-void draw_track() {
-    // First fill the entire game area with dark green (off-road)
-    display_fill_rect(OFFSET_X, OFFSET_Y, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, DARK_GREEN);
-    
-    // Then draw the track elements over it
-    for (int j = 0; j < 5; j++) {
-        for (int i = 0; i < 6; i++) {
+void draw_track_lines() {
+    for (int j = 0; j < MAP_ROWS; j++) {
+        for (int i = 0; i < MAP_COLS; i++) {
             // Draw track elements
             if (map[j][i] < 5) {
                 draw_curve(OFFSET_X + i * MAP_SCALE, OFFSET_Y + j * MAP_SCALE, MAP_SCALE, map[j][i]);
@@ -402,6 +388,29 @@ void draw_track() {
     }
 }
 
+// Draw the track once into the background, at start
+void render_background() {
+    plot = plot_background;
+    draw_track_lines();
+    plot = plot_display;
+}
+
+void draw_track() {
+    // First fill the entire game area with dark green (off-road)
+    display_fill_rect(OFFSET_X, OFFSET_Y, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, DARK_GREEN);
+    
+    // Then the lines from the background, a run of line pixels at a time
+    for (int py = 0; py < DISPLAY_HEIGHT; py++) {
+        for (int px = 0; px < DISPLAY_WIDTH; px++) {
+            if (background_color(px, py) != COLOR_GREEN) continue;
+            int run = 1;
+            while (px + run < DISPLAY_WIDTH && background_color(px + run, py) == COLOR_GREEN) run++;
+            display_fill_rect(px, py, run, 1, COLOR_GREEN);
+            px += run;
+        }
+    }
+}
+
 void game_loop() {
     // Handle reset button (A button)
     bool btn_a = button_pressed(BUTTON_A);
@@ -448,7 +457,7 @@ void game_loop() {
         // Limit maximum speed to be more reasonable
         int32_t max_speed = INT_TO_FIXED(4);  // Reduced from 8 for more realistic speed
         int32_t speed_sq = FIXED_MUL(speed_x, speed_x) + FIXED_MUL(speed_y, speed_y);
-        int32_t current_speed = fixed_sqrt(speed_sq);
+        int32_t current_speed = fx_sqrt(speed_sq);
         
         if (current_speed > max_speed) {
             speed_x = FIXED_DIV(FIXED_MUL(speed_x, max_speed), current_speed);
@@ -497,23 +506,24 @@ void game_loop() {
     x = new_x;
     y = new_y;
     
-    // Collision detection
+    // Collision detection: the tile under the car, then its precomputed
+    // tile says whether the car is near a wall at all. Only then does the
+    // exact test for the tile run
     int int_x = FIXED_TO_INT(x);
     int int_y = FIXED_TO_INT(y);
-    
-    for (int j = 0; j < 5; j++) {
-        for (int i = 0; i < 6; i++) {
-            if (int_x >= i * MAP_SCALE && int_y >= j * MAP_SCALE && 
-                int_x < (i + 1) * MAP_SCALE && int_y < (j + 1) * MAP_SCALE) {
-                
-                switch (map[j][i]) {
-                    case 1: collide_corner(i * MAP_SCALE, (j + 1) * MAP_SCALE); break;
-                    case 2: collide_corner((i + 1) * MAP_SCALE, (j + 1) * MAP_SCALE); break;
-                    case 3: collide_corner((i + 1) * MAP_SCALE, j * MAP_SCALE); break;
-                    case 4: collide_corner(i * MAP_SCALE, j * MAP_SCALE); break;
-                    case 5: collide_horiz(i * MAP_SCALE, j * MAP_SCALE, MAP_SCALE); break;
-                    case 6: collide_vert(i * MAP_SCALE, j * MAP_SCALE, MAP_SCALE); break;
-                }
+    int i = int_x / MAP_SCALE;
+    int j = int_y / MAP_SCALE;
+    
+    if (i < MAP_COLS && j < MAP_ROWS) {
+        int tile = map[j][i];
+        if (track_near_wall(tile, int_x - i * MAP_SCALE, int_y - j * MAP_SCALE)) {
+            switch (tile) {
+                case 1: case 2: case 3: case 4:
+                    collide_corner((i + corner_point[tile][0]) * MAP_SCALE,
+                                   (j + corner_point[tile][1]) * MAP_SCALE);
+                    break;
+                case 5: collide_horiz(i * MAP_SCALE, j * MAP_SCALE, MAP_SCALE); break;
+                case 6: collide_vert(i * MAP_SCALE, j * MAP_SCALE, MAP_SCALE); break;
             }
         }
     }
@@ -544,6 +554,7 @@ int main() {
     // Initialize lookup tables and LED
     init_trig_tables();
     init_led();
+    render_background();
     
     printf("Racing game started!\n");
     printf("Controls: Y=Left, X=Right, Y+X=Accelerate, Release=Brake, A=Reset\n");
@@ -0,0 +1,79 @@
+// Writes track_tiles.h: for each tile type, the pixels where a car may
+// touch a wall, so the game runs its exact wall tests only there
+//
+//   make            (writes ../track_tiles.h)
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define TRACK_NO_TILES
+#include "track.h"
+
+// As in main.c
+#define FIXED_SHIFT 16
+#define INT_TO_FIXED(x) ((x) << FIXED_SHIFT)
+#define FIXED_MUL(a, b) (((int64_t)(a) * (b)) >> FIXED_SHIFT)
+
+// Smallest and largest distance, in 16.16, from the integer coordinate
+// c to any position in pixel p
+static void distance_range(int p, int c, int32_t *lo, int32_t *hi) {
+    int32_t first = INT_TO_FIXED(p) - INT_TO_FIXED(c);
+    int32_t last = INT_TO_FIXED(p + 1) - 1 - INT_TO_FIXED(c);
+    if (first <= 0 && last >= 0) {
+        *lo = 0;
+    } else {
+        *lo = first > 0 ? first : -last;
+    }
+    *hi = -first > last ? -first : last;
+}
+
+// Would collide_corner(), collide_horiz() or collide_vert() in main.c
+// move a car somewhere in this pixel? The squared distances use
+// FIXED_MUL as the game does, which only grows with the distance
+static int near_wall(int type, int tx, int ty) {
+    int32_t lo, hi;
+
+    if (type == 5 || type == 6) {
+        // Across the road: y for horizontal, x for vertical
+        int p = type == 5 ? ty : tx;
+        int32_t first = INT_TO_FIXED(p);
+        int32_t last = INT_TO_FIXED(p + 1) - 1;
+        return first < INT_TO_FIXED(TRACK_WALL) ||
+               last > INT_TO_FIXED(MAP_SCALE - TRACK_WALL);
+    }
+
+    if (type >= 1 && type <= 4) {
+        int32_t dx_lo, dx_hi, dy_lo, dy_hi;
+        distance_range(tx, corner_point[type][0] * MAP_SCALE, &dx_lo, &dx_hi);
+        distance_range(ty, corner_point[type][1] * MAP_SCALE, &dy_lo, &dy_hi);
+        lo = FIXED_MUL(dx_lo, dx_lo) + FIXED_MUL(dy_lo, dy_lo);
+        hi = FIXED_MUL(dx_hi, dx_hi) + FIXED_MUL(dy_hi, dy_hi);
+        return lo < INT_TO_FIXED(CORNER_INNER * CORNER_INNER) ||
+               hi > INT_TO_FIXED(CORNER_OUTER * CORNER_OUTER);
+    }
+
+    return 0;
+}
+
+int main(void) {
+    printf("#ifndef TRACK_TILES_H\n");
+    printf("#define TRACK_TILES_H\n\n");
+    printf("// Written by tools/mktiles from the geometry in track.h; do not edit.\n");
+    printf("// Bit x of row y of a tile type is set where a car at tile pixel\n");
+    printf("// (x, y) may touch a wall. const, so it stays in flash\n");
+    printf("static const uint64_t track_tiles[TILE_TYPES][MAP_SCALE] = {\n");
+    for (int type = 0; type < TILE_TYPES; type++) {
+        printf("    { // %d\n", type);
+        for (int ty = 0; ty < MAP_SCALE; ty++) {
+            uint64_t row = 0;
+            for (int tx = 0; tx < MAP_SCALE; tx++) {
+                if (near_wall(type, tx, ty)) row |= (uint64_t)1 << tx;
+            }
+            printf("        0x%010llxull,\n", (unsigned long long)row);
+        }
+        printf("    },\n");
+    }
+    printf("};\n\n");
+    printf("#endif // TRACK_TILES_H\n");
+    return 0;
+}
@@ -0,0 +1,44 @@
+#ifndef TRACK_H
+#define TRACK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Track layout and wall geometry, shared by the game and tools/mktiles.c,
+// which precomputes the collision tiles in track_tiles.h from it
+
+#define MAP_SCALE 40
+#define MAP_COLS  6
+#define MAP_ROWS  5
+
+// Tile types in the map: 1-4 corners, 5 horizontal and 6 vertical straights
+#define TILE_TYPES 7
+
+// Straights keep the car TRACK_WALL pixels from the tile edges across
+// the road; corners keep it between CORNER_INNER and CORNER_OUTER
+// pixels from the corner point
+#define TRACK_WALL   10
+#define CORNER_INNER 8
+#define CORNER_OUTER 32
+
+// Corner point of each corner type, in tiles from the tile's top left
+static const uint8_t corner_point[5][2] = {
+    {0, 0},
+    {0, 1},
+    {1, 1},
+    {1, 0},
+    {0, 0},
+};
+
+// tools/mktiles.c writes the tiles, so it has none to include
+#ifndef TRACK_NO_TILES
+#include "track_tiles.h"
+
+// Could a car at tile pixel (tx, ty) of a tile of this type touch a
+// wall? Only then does the exact wall test for the tile need to run
+static inline bool track_near_wall(int type, int tx, int ty) {
+    return (track_tiles[type][ty] >> tx) & 1;
+}
+#endif
+
+#endif // TRACK_H
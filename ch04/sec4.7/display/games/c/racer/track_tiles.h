@@ -0,0 +1,304 @@
+#ifndef TRACK_TILES_H
+#define TRACK_TILES_H
+
+// Written by tools/mktiles from the geometry in track.h; do not edit.
+// Bit x of row y of a tile type is set where a car at tile pixel
+// (x, y) may touch a wall. const, so it stays in flash
+static const uint64_t track_tiles[TILE_TYPES][MAP_SCALE] = {
+    { // 0
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+    },
+    { // 1
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffff80ull,
+        0xfffffff800ull,
+        0xffffffe000ull,
+        0xffffff8000ull,
+        0xfffffe0000ull,
+        0xfffffc0000ull,
+        0xfffff80000ull,
+        0xffffe00000ull,
+        0xffffc00000ull,
+        0xffff800000ull,
+        0xffff000000ull,
+        0xffff000000ull,
+        0xfffe000000ull,
+        0xfffc000000ull,
+        0xfff8000000ull,
+        0xfff8000000ull,
+        0xfff0000000ull,
+        0xfff0000000ull,
+        0xffe0000000ull,
+        0xffe0000000ull,
+        0xffc0000000ull,
+        0xffc0000000ull,
+        0xffc0000000ull,
+        0xffc000000full,
+        0xff8000003full,
+        0xff8000007full,
+        0xff8000007full,
+        0xff800000ffull,
+        0xff800000ffull,
+        0xff800000ffull,
+        0xff800000ffull,
+    },
+    { // 2
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0x01ffffffffull,
+        0x001fffffffull,
+        0x0007ffffffull,
+        0x0001ffffffull,
+        0x00007fffffull,
+        0x00003fffffull,
+        0x00001fffffull,
+        0x000007ffffull,
+        0x000003ffffull,
+        0x000001ffffull,
+        0x000000ffffull,
+        0x000000ffffull,
+        0x0000007fffull,
+        0x0000003fffull,
+        0x0000001fffull,
+        0x0000001fffull,
+        0x0000000fffull,
+        0x0000000fffull,
+        0x00000007ffull,
+        0x00000007ffull,
+        0x00000003ffull,
+        0x00000003ffull,
+        0x00000003ffull,
+        0xf0000003ffull,
+        0xfc000001ffull,
+        0xfe000001ffull,
+        0xfe000001ffull,
+        0xff000001ffull,
+        0xff000001ffull,
+        0xff000001ffull,
+        0xff000001ffull,
+    },
+    { // 3
+        0xff000001ffull,
+        0xff000001ffull,
+        0xff000001ffull,
+        0xff000001ffull,
+        0xfe000001ffull,
+        0xfe000001ffull,
+        0xfc000001ffull,
+        0xf0000003ffull,
+        0x00000003ffull,
+        0x00000003ffull,
+        0x00000003ffull,
+        0x00000007ffull,
+        0x00000007ffull,
+        0x0000000fffull,
+        0x0000000fffull,
+        0x0000001fffull,
+        0x0000001fffull,
+        0x0000003fffull,
+        0x0000007fffull,
+        0x000000ffffull,
+        0x000000ffffull,
+        0x000001ffffull,
+        0x000003ffffull,
+        0x000007ffffull,
+        0x00001fffffull,
+        0x00003fffffull,
+        0x00007fffffull,
+        0x0001ffffffull,
+        0x0007ffffffull,
+        0x001fffffffull,
+        0x01ffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+    },
+    { // 4
+        0xff800000ffull,
+        0xff800000ffull,
+        0xff800000ffull,
+        0xff800000ffull,
+        0xff8000007full,
+        0xff8000007full,
+        0xff8000003full,
+        0xffc000000full,
+        0xffc0000000ull,
+        0xffc0000000ull,
+        0xffc0000000ull,
+        0xffe0000000ull,
+        0xffe0000000ull,
+        0xfff0000000ull,
+        0xfff0000000ull,
+        0xfff8000000ull,
+        0xfff8000000ull,
+        0xfffc000000ull,
+        0xfffe000000ull,
+        0xffff000000ull,
+        0xffff000000ull,
+        0xffff800000ull,
+        0xffffc00000ull,
+        0xffffe00000ull,
+        0xfffff80000ull,
+        0xfffffc0000ull,
+        0xfffffe0000ull,
+        0xffffff8000ull,
+        0xffffffe000ull,
+        0xfffffff800ull,
+        0xffffffff80ull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+    },
+    { // 5
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0x0000000000ull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+        0xffffffffffull,
+    },
+    { // 6
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+        0xffc00003ffull,
+    },
+};
+
+#endif // TRACK_TILES_H
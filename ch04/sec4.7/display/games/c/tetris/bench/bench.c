@@ -0,0 +1,252 @@
+// Host benchmark of the Tetris bitboard in ../board.c: drops pieces
+// the way the game moves them, checks every board against the old
+// cell-by-cell code, then times both
+//
+//   ./bench [pieces]
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "board.h"
+
+// The cell-by-cell board the game used before the bitboard
+static uint8_t ref_board[BOARD_HEIGHT][BOARD_WIDTH];
+
+static bool ref_is_valid_position(Piece *piece) {
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            if (tetris_pieces[piece->type][piece->rotation][y][x]) {
+                int board_x = piece->x + x;
+                int board_y = piece->y + y;
+
+                if (board_x < 0 || board_x >= BOARD_WIDTH || board_y >= BOARD_HEIGHT) {
+                    return false;
+                }
+
+                if (board_y >= 0 && ref_board[board_y][board_x] != 0) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static void ref_place_piece(Piece *piece) {
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            if (tetris_pieces[piece->type][piece->rotation][y][x]) {
+                int board_x = piece->x + x;
+                int board_y = piece->y + y;
+
+                if (board_y >= 0 && board_y < BOARD_HEIGHT &&
+                    board_x >= 0 && board_x < BOARD_WIDTH) {
+                    ref_board[board_y][board_x] = piece->type + 1;
+                }
+            }
+        }
+    }
+}
+
+static int ref_clear_full_lines(void) {
+    int cleared_lines = 0;
+
+    for (int y = BOARD_HEIGHT - 1; y >= 0; y--) {
+        bool full_line = true;
+        for (int x = 0; x < BOARD_WIDTH; x++) {
+            if (ref_board[y][x] == 0) {
+                full_line = false;
+                break;
+            }
+        }
+
+        if (full_line) {
+            for (int move_y = y; move_y > 0; move_y--) {
+                memcpy(ref_board[move_y], ref_board[move_y - 1], BOARD_WIDTH);
+            }
+            memset(ref_board[0], 0, BOARD_WIDTH);
+            cleared_lines++;
+            y++;
+        }
+    }
+
+    return cleared_lines;
+}
+
+static void ref_clear(void) {
+    memset(ref_board, 0, sizeof(ref_board));
+}
+
+typedef struct {
+    const char *name;
+    bool (*valid)(Piece *piece);
+    void (*place)(Piece *piece);
+    int (*clear_lines)(void);
+    void (*clear)(void);
+} board_impl_t;
+
+static const board_impl_t impls[] = {
+    { "bitboard", is_valid_position, place_piece, clear_full_lines, board_clear },
+    { "cells", ref_is_valid_position, ref_place_piece, ref_clear_full_lines, ref_clear },
+};
+
+typedef struct {
+    long pieces;
+    long games;
+    long lines;
+    long checks;    // is_valid_position calls
+} bench_stats_t;
+
+// Same numbers on every run and every platform
+static uint32_t rng_state;
+
+static uint32_t rng(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 16;
+}
+
+// Where a piece ends up moved the way the game moves it: rotate,
+// slide towards target_x a step at a time, then hard drop
+static Piece move_piece(const board_impl_t *impl, bench_stats_t *stats, Piece piece,
+                        int turns, int target_x) {
+    for (int i = 0; i < turns; i++) {
+        Piece test = piece;
+        test.rotation = (test.rotation + 1) % 4;
+        stats->checks++;
+        if (impl->valid(&test)) piece = test;
+    }
+
+    while (piece.x != target_x) {
+        Piece test = piece;
+        test.x += (target_x > piece.x) ? 1 : -1;
+        stats->checks++;
+        if (!impl->valid(&test)) break;
+        piece = test;
+    }
+
+    while (true) {
+        Piece test = piece;
+        test.y++;
+        stats->checks++;
+        if (!impl->valid(&test)) break;
+        piece = test;
+    }
+
+    return piece;
+}
+
+// One piece as a simple player would drop it: of a few random
+// rotations and columns, the one that lands lowest, so lines get
+// cleared. Returns false if it could not spawn
+#define CANDIDATES 4
+
+static bool drop_piece(const board_impl_t *impl, bench_stats_t *stats) {
+    Piece spawn = { BOARD_WIDTH / 2 - 2, 0, rng() % 7, 0 };
+
+    stats->checks++;
+    if (!impl->valid(&spawn)) return false;
+
+    Piece best = spawn;
+    for (int i = 0; i < CANDIDATES; i++) {
+        int turns = rng() % 4;
+        int target_x = (int)(rng() % (BOARD_WIDTH + 2)) - 1;
+        Piece piece = move_piece(impl, stats, spawn, turns, target_x);
+        if (i == 0 || piece.y > best.y) best = piece;
+    }
+
+    impl->place(&best);
+    stats->lines += impl->clear_lines();
+    stats->pieces++;
+    return true;
+}
+
+static void play(const board_impl_t *impl, long pieces, bench_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+    rng_state = 1984;
+    impl->clear();
+
+    while (stats->pieces < pieces) {
+        if (!drop_piece(impl, stats)) {
+            impl->clear();
+            stats->games++;
+        }
+    }
+}
+
+// The bitboard against the cells, board by board
+static long verify(long pieces) {
+    bench_stats_t stats[2];
+    memset(stats, 0, sizeof(stats));
+    board_clear();
+    ref_clear();
+
+    long mismatches = 0;
+    uint32_t seed = 1984;
+    while (stats[0].pieces < pieces) {
+        bool dropped[2];
+        for (int i = 0; i < 2; i++) {
+            rng_state = seed;
+            dropped[i] = drop_piece(&impls[i], &stats[i]);
+        }
+        seed = rng_state;
+
+        if (dropped[0] != dropped[1] || stats[0].lines != stats[1].lines ||
+            memcmp(board, ref_board, sizeof(board)) != 0) {
+            mismatches++;
+        }
+        for (int y = 0; y < BOARD_HEIGHT; y++) {
+            uint16_t row = BOARD_EMPTY_ROW;
+            for (int x = 0; x < BOARD_WIDTH; x++) {
+                if (board[y][x]) row |= 1 << (x + BOARD_WALL);
+            }
+            if (row != board_rows[y]) {
+                mismatches++;
+                break;
+            }
+        }
+
+        if (!dropped[0] || !dropped[1]) {
+            board_clear();
+            ref_clear();
+        }
+    }
+    return mismatches;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[]) {
+    long pieces = 1000000;
+    if (argc >= 2) pieces = atol(argv[1]);
+    if (pieces <= 0) {
+        fprintf(stderr, "usage: %s [pieces]\n", argv[0]);
+        return 1;
+    }
+
+    board_init_pieces();
+
+    long mismatches = verify(pieces);
+    printf("%ld pieces checked against the cell board: %ld mismatches\n",
+           pieces, mismatches);
+
+    printf("%-10s %10s %8s %10s %12s %10s\n",
+           "board", "pieces/s", "games", "lines", "checks", "ns/check");
+    for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); i++) {
+        bench_stats_t stats;
+        double start = now_seconds();
+        play(&impls[i], pieces, &stats);
+        double seconds = now_seconds() - start;
+
+        printf("%-10s %10.0f %8ld %10ld %12ld %10.1f\n", impls[i].name,
+               stats.pieces / seconds, stats.games, stats.lines, stats.checks,
+               seconds * 1e9 / stats.checks);
+    }
+
+    return mismatches ? 1 : 0;
+}
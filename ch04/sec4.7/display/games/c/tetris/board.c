@@ -0,0 +1,136 @@
+#include <string.h>
+#include "board.h"
+
+uint8_t board[BOARD_HEIGHT][BOARD_WIDTH];
+uint16_t board_rows[BOARD_HEIGHT];
+uint8_t piece_rows[7][4][4];
+
+// Tetris piece definitions
+const uint8_t tetris_pieces[7][4][4][4] = {
+    // I piece
+    {
+        {{0,0,0,0},{1,1,1,1},{0,0,0,0},{0,0,0,0}},
+        {{0,0,1,0},{0,0,1,0},{0,0,1,0},{0,0,1,0}},
+        {{0,0,0,0},{0,0,0,0},{1,1,1,1},{0,0,0,0}},
+        {{0,1,0,0},{0,1,0,0},{0,1,0,0},{0,1,0,0}}
+    },
+    // O piece
+    {
+        {{0,1,1,0},{0,1,1,0},{0,0,0,0},{0,0,0,0}},
+        {{0,1,1,0},{0,1,1,0},{0,0,0,0},{0,0,0,0}},
+        {{0,1,1,0},{0,1,1,0},{0,0,0,0},{0,0,0,0}},
+        {{0,1,1,0},{0,1,1,0},{0,0,0,0},{0,0,0,0}}
+    },
+    // T piece
+    {
+        {{0,1,0,0},{1,1,1,0},{0,0,0,0},{0,0,0,0}},
+        {{0,1,0,0},{0,1,1,0},{0,1,0,0},{0,0,0,0}},
+        {{0,0,0,0},{1,1,1,0},{0,1,0,0},{0,0,0,0}},
+        {{0,1,0,0},{1,1,0,0},{0,1,0,0},{0,0,0,0}}
+    },
+    // S piece
+    {
+        {{0,1,1,0},{1,1,0,0},{0,0,0,0},{0,0,0,0}},
+        {{0,1,0,0},{0,1,1,0},{0,0,1,0},{0,0,0,0}},
+        {{0,0,0,0},{0,1,1,0},{1,1,0,0},{0,0,0,0}},
+        {{1,0,0,0},{1,1,0,0},{0,1,0,0},{0,0,0,0}}
+    },
+    // Z piece
+    {
+        {{1,1,0,0},{0,1,1,0},{0,0,0,0},{0,0,0,0}},
+        {{0,0,1,0},{0,1,1,0},{0,1,0,0},{0,0,0,0}},
+        {{0,0,0,0},{1,1,0,0},{0,1,1,0},{0,0,0,0}},
+        {{0,1,0,0},{1,1,0,0},{1,0,0,0},{0,0,0,0}}
+    },
+    // J piece
+    {
+        {{1,0,0,0},{1,1,1,0},{0,0,0,0},{0,0,0,0}},
+        {{0,1,1,0},{0,1,0,0},{0,1,0,0},{0,0,0,0}},
+        {{0,0,0,0},{1,1,1,0},{0,0,1,0},{0,0,0,0}},
+        {{0,1,0,0},{0,1,0,0},{1,1,0,0},{0,0,0,0}}
+    },
+    // L piece
+    {
+        {{0,0,1,0},{1,1,1,0},{0,0,0,0},{0,0,0,0}},
+        {{0,1,0,0},{0,1,0,0},{0,1,1,0},{0,0,0,0}},
+        {{0,0,0,0},{1,1,1,0},{1,0,0,0},{0,0,0,0}},
+        {{1,1,0,0},{0,1,0,0},{0,1,0,0},{0,0,0,0}}
+    }
+};
+
+void board_init_pieces(void) {
+    for (int type = 0; type < 7; type++) {
+        for (int rotation = 0; rotation < 4; rotation++) {
+            for (int y = 0; y < 4; y++) {
+                uint8_t mask = 0;
+                for (int x = 0; x < 4; x++) {
+                    if (tetris_pieces[type][rotation][y][x]) {
+                        mask |= 1 << x;
+                    }
+                }
+                piece_rows[type][rotation][y] = mask;
+            }
+        }
+    }
+}
+
+void board_clear(void) {
+    memset(board, 0, sizeof(board));
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        board_rows[y] = BOARD_EMPTY_ROW;
+    }
+}
+
+bool is_valid_position(Piece *piece) {
+    // Shifted past the walls the piece is off the board
+    int shift = piece->x + BOARD_WALL;
+    if (shift < 0 || shift > 16 - 4) return false;
+
+    const uint8_t *rows = piece_rows[piece->type][piece->rotation];
+    for (int y = 0; y < 4; y++) {
+        if (!rows[y]) continue;
+
+        // Above the board only the walls count, below it everything
+        int board_y = piece->y + y;
+        uint16_t row = (board_y < 0) ? BOARD_EMPTY_ROW :
+                       (board_y >= BOARD_HEIGHT) ? BOARD_FULL_ROW : board_rows[board_y];
+
+        if (row & (rows[y] << shift)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void place_piece(Piece *piece) {
+    const uint8_t *rows = piece_rows[piece->type][piece->rotation];
+    for (int y = 0; y < 4; y++) {
+        int board_y = piece->y + y;
+        if (!rows[y] || board_y < 0 || board_y >= BOARD_HEIGHT) continue;
+
+        board_rows[board_y] |= rows[y] << (piece->x + BOARD_WALL);
+        for (int x = 0; x < 4; x++) {
+            if (rows[y] & (1 << x)) {
+                board[board_y][piece->x + x] = piece->type + 1;
+            }
+        }
+    }
+}
+
+int clear_full_lines() {
+    int cleared_lines = 0;
+
+    for (int y = BOARD_HEIGHT - 1; y >= 0; y--) {
+        if (board_rows[y] == BOARD_FULL_ROW) {
+            // Everything above moves down one row
+            memmove(&board_rows[1], &board_rows[0], y * sizeof(board_rows[0]));
+            memmove(board[1], board[0], y * BOARD_WIDTH);
+            board_rows[0] = BOARD_EMPTY_ROW;
+            memset(board[0], 0, BOARD_WIDTH);
+            cleared_lines++;
+            y++;
+        }
+    }
+
+    return cleared_lines;
+}
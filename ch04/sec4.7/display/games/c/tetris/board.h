@@ -0,0 +1,45 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// The Tetris board and pieces without the display, so the game and
+// the host benchmark in bench/ share them
+
+#define BOARD_WIDTH     10
+#define BOARD_HEIGHT    20
+
+// Bitboard: each row a uint16_t, column x in bit x + BOARD_WALL, with
+// BOARD_WALL bits of wall set on both sides. Any piece that overlaps
+// a wall or a block overlaps a set bit, so a test is a shift and an AND
+#define BOARD_WALL      3
+#define BOARD_FULL_ROW  0xFFFF
+#define BOARD_EMPTY_ROW (BOARD_FULL_ROW & ~(((1u << BOARD_WIDTH) - 1) << BOARD_WALL))
+
+typedef struct {
+    int x, y;
+    int type;
+    int rotation;
+} Piece;
+
+// 4x4 cells of each piece in each rotation, for drawing
+extern const uint8_t tetris_pieces[7][4][4][4];
+
+// The same as one mask per row, bit x for column x
+extern uint8_t piece_rows[7][4][4];
+
+// Colours for drawing: piece type + 1, 0 for empty
+extern uint8_t board[BOARD_HEIGHT][BOARD_WIDTH];
+// Occupancy, kept with board
+extern uint16_t board_rows[BOARD_HEIGHT];
+
+// Build piece_rows from tetris_pieces, once before the first game
+void board_init_pieces(void);
+void board_clear(void);
+
+bool is_valid_position(Piece *piece);
+void place_piece(Piece *piece);
+int clear_full_lines(void);
+
+#endif // BOARD_H
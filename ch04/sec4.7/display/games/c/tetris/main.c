@@ -6,6 +6,7 @@
 #include "hardware/gpio.h"
 #include "hardware/pwm.h"
 #include "display.h"
+#include "board.h"
 
 // Button pins (handled by display.h, but for reference)
 #define BTN_A       12
@@ -19,8 +20,6 @@
 #define LED_B       8
 
 // Game constants
-#define BOARD_WIDTH     10
-#define BOARD_HEIGHT    20
 #define BLOCK_SIZE      11
 #define BOARD_OFFSET_X  50
 #define BOARD_OFFSET_Y  10
@@ -44,19 +43,11 @@
 // Tetris piece colors
 uint16_t piece_colors[7] = { CYAN, BLUE, ORANGE, YELLOW, GREEN, MAGENTA, RED };
 
-// Game board
-uint8_t board[BOARD_HEIGHT][BOARD_WIDTH];
-uint8_t prev_board[BOARD_HEIGHT][BOARD_WIDTH];
+// What the screen shows, falling piece included: type + 1, 0 for empty
+uint8_t shown[BOARD_HEIGHT][BOARD_WIDTH];
 
 // Current piece state
-typedef struct {
-    int x, y;
-    int type;
-    int rotation;
-} Piece;
-
 Piece current_piece;
-Piece prev_piece;
 Piece next_piece;
 
 // Game state
@@ -73,61 +64,8 @@ bool force_full_redraw = false;
 bool btn_a = false, btn_b = false, btn_x = false, btn_y = false;
 bool prev_btn_a = false, prev_btn_b = false, prev_btn_x = false, prev_btn_y = false;
 
-// Tetris piece definitions
-const uint8_t tetris_pieces[7][4][4][4] = {
-    // I piece
-    {
-        {{0,0,0,0},{1,1,1,1},{0,0,0,0},{0,0,0,0}},
-        {{0,0,1,0},{0,0,1,0},{0,0,1,0},{0,0,1,0}},
-        {{0,0,0,0},{0,0,0,0},{1,1,1,1},{0,0,0,0}},
-        {{0,1,0,0},{0,1,0,0},{0,1,0,0},{0,1,0,0}}
-    },
-    // O piece
-    {
-        {{0,1,1,0},{0,1,1,0},{0,0,0,0},{0,0,0,0}},
-        {{0,1,1,0},{0,1,1,0},{0,0,0,0},{0,0,0,0}},
-        {{0,1,1,0},{0,1,1,0},{0,0,0,0},{0,0,0,0}},
-        {{0,1,1,0},{0,1,1,0},{0,0,0,0},{0,0,0,0}}
-    },
-    // T piece
-    {
-        {{0,1,0,0},{1,1,1,0},{0,0,0,0},{0,0,0,0}},
-        {{0,1,0,0},{0,1,1,0},{0,1,0,0},{0,0,0,0}},
-        {{0,0,0,0},{1,1,1,0},{0,1,0,0},{0,0,0,0}},
-        {{0,1,0,0},{1,1,0,0},{0,1,0,0},{0,0,0,0}}
-    },
-    // S piece
-    {
-        {{0,1,1,0},{1,1,0,0},{0,0,0,0},{0,0,0,0}},
-        {{0,1,0,0},{0,1,1,0},{0,0,1,0},{0,0,0,0}},
-        {{0,0,0,0},{0,1,1,0},{1,1,0,0},{0,0,0,0}},
-        {{1,0,0,0},{1,1,0,0},{0,1,0,0},{0,0,0,0}}
-    },
-    // Z piece
-    {
-        {{1,1,0,0},{0,1,1,0},{0,0,0,0},{0,0,0,0}},
-        {{0,0,1,0},{0,1,1,0},{0,1,0,0},{0,0,0,0}},
-        {{0,0,0,0},{1,1,0,0},{0,1,1,0},{0,0,0,0}},
-        {{0,1,0,0},{1,1,0,0},{1,0,0,0},{0,0,0,0}}
-    },
-    // J piece
-    {
-        {{1,0,0,0},{1,1,1,0},{0,0,0,0},{0,0,0,0}},
-        {{0,1,1,0},{0,1,0,0},{0,1,0,0},{0,0,0,0}},
-        {{0,0,0,0},{1,1,1,0},{0,0,1,0},{0,0,0,0}},
-        {{0,1,0,0},{0,1,0,0},{1,1,0,0},{0,0,0,0}}
-    },
-    // L piece
-    {
-        {{0,0,1,0},{1,1,1,0},{0,0,0,0},{0,0,0,0}},
-        {{0,1,0,0},{0,1,0,0},{0,1,1,0},{0,0,0,0}},
-        {{0,0,0,0},{1,1,1,0},{1,0,0,0},{0,0,0,0}},
-        {{1,1,0,0},{0,1,0,0},{0,1,0,0},{0,0,0,0}}
-    }
-};
-
 // Game rendering functions
-void draw_board() {
+void draw_board_frame() {
 
     // Clear game area
     display_fill_rect(BOARD_OFFSET_X, BOARD_OFFSET_Y, GAME_AREA_WIDTH, GAME_AREA_HEIGHT, BLACK);
@@ -137,66 +75,65 @@ void draw_board() {
     display_fill_rect(BOARD_OFFSET_X, BOARD_OFFSET_Y + GAME_AREA_HEIGHT - 2, GAME_AREA_WIDTH, 2, WHITE);
     display_fill_rect(BOARD_OFFSET_X, BOARD_OFFSET_Y, 2, GAME_AREA_HEIGHT, WHITE);
     display_fill_rect(BOARD_OFFSET_X + GAME_AREA_WIDTH - 2, BOARD_OFFSET_Y, 2, GAME_AREA_HEIGHT, WHITE);
-
-    // Draw placed pieces
-    for (int y = 0; y < BOARD_HEIGHT; y++) {
-        for (int x = 0; x < BOARD_WIDTH; x++) {
-            if (board[y][x] != 0) {
-                int screen_x = BOARD_OFFSET_X + 2 + x * BLOCK_SIZE;
-                int screen_y = BOARD_OFFSET_Y + 2 + y * BLOCK_SIZE;
-                display_fill_rect(screen_x, screen_y, BLOCK_SIZE - 1, BLOCK_SIZE - 1, piece_colors[board[y][x] - 1]);
-            }
-        }
-    }
 }
 
-void draw_piece(Piece *piece, uint16_t color) {
-    for (int y = 0; y < 4; y++) {
-        for (int x = 0; x < 4; x++) {
-            if (tetris_pieces[piece->type][piece->rotation][y][x]) {
-                int board_x = piece->x + x;
-                int board_y = piece->y + y;
-                if (board_x >= 0 && board_x < BOARD_WIDTH && board_y >= 0 && board_y < BOARD_HEIGHT) {
-                    int screen_x = BOARD_OFFSET_X + 2 + board_x * BLOCK_SIZE;
-                    int screen_y = BOARD_OFFSET_Y + 2 + board_y * BLOCK_SIZE;
-                    display_fill_rect(screen_x, screen_y, BLOCK_SIZE - 1, BLOCK_SIZE - 1, color);
+// Only cells whose colour differs from shown are sent. A run of cells
+// turning empty is one black rect, gaps and all, since the gaps are
+// black anyway; coloured cells keep their gaps and go one by one.
+// Moving a piece costs a few cells instead of the whole board
+void update_display() {
+    uint8_t frame[BOARD_HEIGHT][BOARD_WIDTH];
+    memcpy(frame, board, sizeof(board));
+
+    // Falling piece on top of the board
+    if (!need_new_piece && current_piece.type >= 0) {
+        for (int y = 0; y < 4; y++) {
+            for (int x = 0; x < 4; x++) {
+                if (tetris_pieces[current_piece.type][current_piece.rotation][y][x]) {
+                    int board_x = current_piece.x + x;
+                    int board_y = current_piece.y + y;
+                    if (board_x >= 0 && board_x < BOARD_WIDTH && board_y >= 0 && board_y < BOARD_HEIGHT) {
+                        frame[board_y][board_x] = current_piece.type + 1;
+                    }
                 }
             }
         }
     }
-}
 
-bool has_board_changed() {
-    return memcmp(board, prev_board, sizeof(board)) != 0;
-}
-
-bool has_piece_changed() {
-    return memcmp(&current_piece, &prev_piece, sizeof(Piece)) != 0;
-}
+    if (force_full_redraw) {
+        draw_board_frame();
+        memset(shown, 0, sizeof(shown));
+        force_full_redraw = false;
+    }
 
-void update_display() {
-    bool board_changed = has_board_changed();
-    bool piece_changed = has_piece_changed();
+    for (int y = 0; y < BOARD_HEIGHT; y++) {
+        int screen_y = BOARD_OFFSET_Y + 2 + y * BLOCK_SIZE;
+        int x = 0;
 
-    if (force_full_redraw || board_changed || piece_changed) {
-        // Erase old piece position
-        if (piece_changed && !need_new_piece) {
-            draw_piece(&prev_piece, BLACK);
-        }
+        while (x < BOARD_WIDTH) {
+            if (frame[y][x] == shown[y][x]) {
+                x++;
+                continue;
+            }
 
-        // Redraw board if changed
-        if (board_changed || force_full_redraw) {
-            draw_board();
+            int screen_x = BOARD_OFFSET_X + 2 + x * BLOCK_SIZE;
+            if (frame[y][x] == 0) {
+                int run = 1;
+                while (x + run < BOARD_WIDTH && frame[y][x + run] == 0 &&
+                       shown[y][x + run] != 0) {
+                    run++;
+                }
+                display_fill_rect(screen_x, screen_y, run * BLOCK_SIZE - 1, BLOCK_SIZE - 1, BLACK);
+                x += run;
+            } else {
+                display_fill_rect(screen_x, screen_y, BLOCK_SIZE - 1, BLOCK_SIZE - 1,
+                                  piece_colors[frame[y][x] - 1]);
+                x++;
+            }
         }
-
-        // Draw new piece
-        draw_piece(&current_piece, piece_colors[current_piece.type]);
-
-        // Update previous states
-        memcpy(prev_board, board, sizeof(board));
-        memcpy(&prev_piece, &current_piece, sizeof(Piece));
-        force_full_redraw = false;
     }
+
+    memcpy(shown, frame, sizeof(shown));
 }
 
 static bool ui_initialized = false;
@@ -309,14 +246,12 @@ void read_buttons() {
 }
 
 void init_game() {
-    memset(board, 0, sizeof(board));
-    memset(prev_board, 255, sizeof(prev_board));
+    board_clear();
 
     current_piece.x = -1;
     current_piece.y = -1;
     current_piece.type = -1;
     current_piece.rotation = -1;
-    prev_piece = current_piece;
 
     score = 0;
     level = 1;
@@ -333,42 +268,6 @@ void init_game() {
     set_led(0, 255, 0);
 }
 
-bool is_valid_position(Piece *piece) {
-    for (int y = 0; y < 4; y++) {
-        for (int x = 0; x < 4; x++) {
-            if (tetris_pieces[piece->type][piece->rotation][y][x]) {
-                int board_x = piece->x + x;
-                int board_y = piece->y + y;
-
-                if (board_x < 0 || board_x >= BOARD_WIDTH || board_y >= BOARD_HEIGHT) {
-                    return false;
-                }
-
-                if (board_y >= 0 && board[board_y][board_x] != 0) {
-                    return false;
-                }
-            }
-        }
-    }
-    return true;
-}
-
-void place_piece(Piece *piece) {
-    for (int y = 0; y < 4; y++) {
-        for (int x = 0; x < 4; x++) {
-            if (tetris_pieces[piece->type][piece->rotation][y][x]) {
-                int board_x = piece->x + x;
-                int board_y = piece->y + y;
-
-                if (board_y >= 0 && board_y < BOARD_HEIGHT &&
-                    board_x >= 0 && board_x < BOARD_WIDTH) {
-                    board[board_y][board_x] = piece->type + 1;
-                }
-            }
-        }
-    }
-}
-
 void generate_piece(Piece *piece) {
     piece->x = BOARD_WIDTH / 2 - 2;
     piece->y = 0;
@@ -376,31 +275,6 @@ void generate_piece(Piece *piece) {
     piece->rotation = 0;
 }
 
-int clear_full_lines() {
-    int cleared_lines = 0;
-
-    for (int y = BOARD_HEIGHT - 1; y >= 0; y--) {
-        bool full_line = true;
-        for (int x = 0; x < BOARD_WIDTH; x++) {
-            if (board[y][x] == 0) {
-                full_line = false;
-                break;
-            }
-        }
-
-        if (full_line) {
-            for (int move_y = y; move_y > 0; move_y--) {
-                memcpy(board[move_y], board[move_y - 1], BOARD_WIDTH);
-            }
-            memset(board[0], 0, BOARD_WIDTH);
-            cleared_lines++;
-            y++;
-        }
-    }
-
-    return cleared_lines;
-}
-
 void update_score(int lines) {
     if (lines > 0) {
         int points[] = {0, 100, 300, 500, 800};
@@ -439,7 +313,6 @@ void game_loop() {
             game_over = true;
             return;
         }
-        prev_piece = current_piece;
         need_new_piece = false;
     }
 
@@ -527,6 +400,7 @@ int main() {
     init_led();
 
     srand(time(NULL));
+    board_init_pieces();
 
     generate_piece(&next_piece);
     init_game();
@@ -46,6 +46,13 @@ display_error_t display_clear(uint16_t color);
 display_error_t display_fill_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color);
 display_error_t display_draw_pixel(uint16_t x, uint16_t y, uint16_t color);
 display_error_t display_blit_full(const uint16_t *pixels);
+// Draw an RLE image asset made by tools/img2rle, each pixel scale x scale.
+// It is decoded one row at a time into a line buffer, the next row while
+// the last one is still going out by DMA, so it never needs a framebuffer
+display_error_t display_draw_rle(uint16_t x, uint16_t y, const uint8_t *image, uint8_t scale);
+// Draw an uncompressed 24-bit BMP of bmp_size bytes, either row order,
+// converted to RGB565 a row at a time into the same two line buffers
+display_error_t display_draw_bmp(uint16_t x, uint16_t y, const uint8_t *bmp, uint32_t bmp_size);
 display_error_t display_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg_color);
 display_error_t display_draw_string(uint16_t x, uint16_t y, const char* str, uint16_t color, uint16_t bg_color);
 display_error_t display_set_backlight(bool on);
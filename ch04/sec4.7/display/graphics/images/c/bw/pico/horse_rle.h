@@ -0,0 +1,1844 @@
+// ../bw/000.bmp: 320x240, RLE image for display_draw_rle(), made by img2rle
+// 22005 bytes, 153600 as plain RGB565
+
+#include <stdint.h>
+
+#define HORSE_RLE_WIDTH 320
+#define HORSE_RLE_HEIGHT 240
+
+static const uint8_t horse_rle[22005] = {
+    0x52, 0x35, 0x40, 0x01, 0xf0, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xba, 0xff, 0xff, 0x02, 0xf7, 0xbe, 0x94, 0xb2, 0xde, 0xfb, 0xff, 0xff,
+    0xff, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb8, 0xff, 0xff,
+    0x04, 0xde, 0xfb, 0xe7, 0x1c, 0xff, 0xdf, 0x94, 0xb2, 0xe7, 0x1c, 0xff,
+    0xff, 0xff, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xff,
+    0xff, 0x08, 0xff, 0xdf, 0xf7, 0xbe, 0xff, 0xff, 0x94, 0xb2, 0x94, 0xb2,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0x00,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xff, 0xff, 0x01, 0xd6, 0x9a, 0x63,
+    0x2c, 0x84, 0xff, 0xff, 0x01, 0x9c, 0xd3, 0x9c, 0xd3, 0xff, 0xff, 0xff,
+    0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xff, 0xff, 0x0c, 0xce, 0x79,
+    0x00, 0x00, 0x84, 0x30, 0xa5, 0x34, 0xa5, 0x14, 0x8c, 0x71, 0x9c, 0xd3,
+    0xce, 0x79, 0xc6, 0x38, 0x8c, 0x51, 0x8c, 0x71, 0x8c, 0x71, 0xce, 0x59,
+    0xfc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xff, 0xff, 0x0c, 0xd6, 0xba,
+    0x00, 0x00, 0x94, 0xb2, 0x18, 0xc3, 0x18, 0xe3, 0x94, 0x92, 0x00, 0x00,
+    0xb5, 0x96, 0xd6, 0x9a, 0x8c, 0x51, 0x9c, 0xd3, 0x00, 0x00, 0x94, 0x92,
+    0xfc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xff, 0xff, 0x0d, 0xc6, 0x18,
+    0x39, 0xc7, 0xf7, 0xbe, 0xa5, 0x34, 0xa5, 0x14, 0xf7, 0xbe, 0x7b, 0xcf,
+    0x00, 0x00, 0x9c, 0xd3, 0xff, 0xff, 0xff, 0xff, 0x8c, 0x71, 0x84, 0x30,
+    0xff, 0xdf, 0xfb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb4, 0xff, 0xff, 0x00,
+    0xa5, 0x34, 0x82, 0x00, 0x00, 0x0b, 0xde, 0xdb, 0xde, 0xdb, 0x63, 0x2c,
+    0xff, 0xdf, 0x84, 0x30, 0x94, 0x92, 0xff, 0xff, 0x6b, 0x4d, 0x00, 0x00,
+    0x00, 0x00, 0x63, 0x2c, 0xf7, 0xbe, 0xfa, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xb4, 0xff, 0xff, 0x0f, 0xe7, 0x3c, 0x9c, 0xf3, 0x31, 0x86, 0xd6, 0x9a,
+    0xbd, 0xd7, 0x6b, 0x4d, 0x00, 0x00, 0x8c, 0x51, 0xce, 0x79, 0xce, 0x79,
+    0xa5, 0x14, 0xde, 0xdb, 0x6b, 0x4d, 0x52, 0x8a, 0xde, 0xdb, 0xff, 0xdf,
+    0xfa, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xff, 0xff, 0x0c, 0xd6, 0xba,
+    0x00, 0x20, 0xd6, 0x9a, 0xbd, 0xd7, 0x6b, 0x4d, 0x00, 0x00, 0x8c, 0x51,
+    0xd6, 0x9a, 0xad, 0x75, 0x00, 0x00, 0xd6, 0xba, 0xb5, 0xb6, 0xce, 0x59,
+    0xfc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb5, 0xff, 0xff, 0x07, 0xd6, 0x9a,
+    0x00, 0x00, 0x00, 0x00, 0xde, 0xdb, 0xde, 0xdb, 0x63, 0x2c, 0xf7, 0xbe,
+    0xad, 0x55, 0x82, 0x00, 0x00, 0x00, 0xd6, 0xba, 0xfd, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xb5, 0xff, 0xff, 0x0b, 0xd6, 0x9a, 0x00, 0x00, 0xf7, 0xbe,
+    0xa5, 0x34, 0xa5, 0x14, 0xf7, 0xbe, 0x63, 0x2c, 0xd6, 0xba, 0xd6, 0x9a,
+    0x00, 0x00, 0x00, 0x00, 0xce, 0x79, 0xfd, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xb4, 0xff, 0xff, 0x0c, 0xbd, 0xf7, 0xa5, 0x34, 0xde, 0xfb, 0xa5, 0x34,
+    0x39, 0xc7, 0x4a, 0x49, 0x94, 0xb2, 0x00, 0x00, 0xe7, 0x3c, 0xe7, 0x1c,
+    0x00, 0x00, 0xd6, 0x9a, 0xff, 0xdf, 0xfd, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xb3, 0xff, 0xff, 0x0d, 0xd6, 0xba, 0x9c, 0xf3, 0xad, 0x75, 0xde, 0xfb,
+    0x9c, 0xf3, 0x42, 0x08, 0x5a, 0xcb, 0x94, 0x92, 0x00, 0x00, 0xad, 0x75,
+    0xce, 0x59, 0xad, 0x55, 0xd6, 0x9a, 0xf7, 0xbe, 0xfd, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xb2, 0xff, 0xff, 0x0e, 0xef, 0x5d, 0x42, 0x28, 0xe7, 0x1c,
+    0xde, 0xdb, 0x00, 0x00, 0xff, 0xff, 0x9c, 0xf3, 0x94, 0x92, 0xff, 0xdf,
+    0x7b, 0xcf, 0x00, 0x00, 0x9c, 0xd3, 0xf7, 0xbe, 0x4a, 0x49, 0xce, 0x79,
+    0xfd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb1, 0xff, 0xff, 0x0e, 0xd6, 0xba,
+    0x42, 0x28, 0xef, 0x7d, 0xff, 0xff, 0xce, 0x59, 0x00, 0x00, 0xff, 0xff,
+    0xad, 0x75, 0x00, 0x00, 0x63, 0x2c, 0xff, 0xdf, 0x9c, 0xd3, 0x00, 0x00,
+    0x73, 0xae, 0xef, 0x5d, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xaf, 0xff,
+    0xff, 0x10, 0xad, 0x75, 0x84, 0x30, 0xad, 0x75, 0xd6, 0xba, 0x94, 0xb2,
+    0xe7, 0x1c, 0xff, 0xff, 0xd6, 0xba, 0x9c, 0xd3, 0x29, 0x45, 0x84, 0x30,
+    0xde, 0xdb, 0xad, 0x55, 0xd6, 0xba, 0xad, 0x75, 0x00, 0x00, 0xf7, 0xbe,
+    0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xad, 0xff, 0xff, 0x12, 0xf7, 0xbe,
+    0xc6, 0x18, 0x00, 0x00, 0x5a, 0xcb, 0xbd, 0xd7, 0xd6, 0xba, 0x94, 0xb2,
+    0xe7, 0x1c, 0xff, 0xdf, 0xd6, 0x9a, 0xa5, 0x14, 0x18, 0xc3, 0x84, 0x10,
+    0xd6, 0x9a, 0x00, 0x00, 0xad, 0x55, 0xce, 0x79, 0xad, 0x55, 0xff, 0xdf,
+    0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xab, 0xff, 0xff, 0x12, 0xf7, 0xbe,
+    0xff, 0xff, 0xc6, 0x38, 0x00, 0x00, 0x29, 0x65, 0xde, 0xfb, 0xd6, 0xba,
+    0x4a, 0x49, 0xef, 0x7d, 0xff, 0xff, 0xd6, 0x9a, 0x4a, 0x49, 0xf7, 0xbe,
+    0xb5, 0x96, 0x00, 0x20, 0x31, 0xa6, 0x52, 0xaa, 0x00, 0x00, 0xad, 0x55,
+    0xff, 0xff, 0xff, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xab, 0xff, 0xff,
+    0x12, 0x7b, 0xcf, 0x29, 0x45, 0x00, 0x00, 0x52, 0x8a, 0xef, 0x7d, 0xa5,
+    0x14, 0xa5, 0x14, 0xef, 0x7d, 0x42, 0x28, 0xd6, 0xba, 0xff, 0xff, 0xef,
+    0x5d, 0x4a, 0x49, 0xc6, 0x38, 0xff, 0xff, 0xf7, 0xbe, 0xf7, 0xbe, 0xf7,
+    0x9e, 0xff, 0xdf, 0xff, 0xff, 0xff, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xa9, 0xff, 0xff, 0x0f, 0xef, 0x7d, 0x8c, 0x71, 0x00, 0x00, 0xb5, 0x96,
+    0xb5, 0x96, 0x00, 0x00, 0xff, 0xff, 0x8c, 0x71, 0x84, 0x30, 0xff, 0xff,
+    0xd6, 0xba, 0x94, 0xb2, 0xc6, 0x18, 0xff, 0xff, 0xce, 0x79, 0xf7, 0x9e,
+    0xff, 0xff, 0xff, 0x85, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa8, 0xff, 0xff,
+    0x0d, 0xef, 0x7d, 0x9c, 0xf3, 0x00, 0x00, 0x94, 0x92, 0xce, 0x79, 0xce,
+    0x79, 0xad, 0x55, 0xce, 0x59, 0xb5, 0xb6, 0xad, 0x75, 0xd6, 0xba, 0xff,
+    0xff, 0xc6, 0x18, 0xb5, 0xb6, 0xb7, 0xff, 0xff, 0x03, 0xff, 0xdf, 0xd6,
+    0xba, 0xce, 0x79, 0xe7, 0x1c, 0xcc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5,
+    0xff, 0xff, 0x11, 0xff, 0xdf, 0xf7, 0xbe, 0xff, 0xdf, 0x8c, 0x71, 0x00,
+    0x00, 0x5a, 0xcb, 0xff, 0xff, 0xa5, 0x14, 0x9c, 0xd3, 0xf7, 0xbe, 0x4a,
+    0x69, 0xd6, 0xba, 0xd6, 0xba, 0x42, 0x28, 0xef, 0x5d, 0xff, 0xff, 0xff,
+    0xff, 0xf7, 0xbe, 0xb6, 0xff, 0xff, 0x03, 0xf7, 0x9e, 0x31, 0xa6, 0x00,
+    0x00, 0x9c, 0xd3, 0xcc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0xff, 0xff,
+    0x12, 0xd6, 0xba, 0x31, 0xa6, 0x39, 0xc7, 0x18, 0xe3, 0x00, 0x00, 0x39,
+    0xc7, 0xff, 0xdf, 0xff, 0xff, 0xce, 0x59, 0x4a, 0x49, 0xef, 0x7d, 0x94,
+    0xb2, 0x94, 0xb2, 0xef, 0x7d, 0x42, 0x28, 0xde, 0xdb, 0xde, 0xdb, 0x4a,
+    0x69, 0xff, 0xdf, 0xb5, 0xff, 0xff, 0x03, 0xf7, 0x9e, 0x31, 0xa6, 0x00,
+    0x00, 0xa5, 0x34, 0xcc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa5, 0xff, 0xff,
+    0x13, 0xd6, 0xba, 0x00, 0x00, 0xd6, 0xba, 0x7b, 0xef, 0x84, 0x10, 0xde,
+    0xfb, 0xa5, 0x34, 0x9c, 0xf3, 0xb5, 0x96, 0xd6, 0xba, 0xff, 0xff, 0xe7,
+    0x3c, 0xde, 0xfb, 0xff, 0xff, 0xde, 0xdb, 0xf7, 0xbe, 0xf7, 0x9e, 0xc6,
+    0x38, 0x8c, 0x51, 0xe7, 0x3c, 0xb5, 0xff, 0xff, 0x03, 0xe7, 0x3c, 0x84,
+    0x10, 0x31, 0xa6, 0xb5, 0x96, 0xcb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa4,
+    0xff, 0xff, 0x15, 0xef, 0x7d, 0x9c, 0xf3, 0x00, 0x00, 0xde, 0xdb, 0x7b,
+    0xcf, 0x7b, 0xef, 0xde, 0xdb, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x14, 0xff,
+    0xff, 0xce, 0x79, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xdf, 0xde, 0xdb, 0xf7,
+    0x9e, 0xff, 0xff, 0xff, 0xff, 0x9c, 0xf3, 0xb5, 0x96, 0xe7, 0x3c, 0xb4,
+    0xff, 0xff, 0x05, 0xe7, 0x1c, 0x7b, 0xef, 0x00, 0x00, 0x00, 0x00, 0xc6,
+    0x38, 0xf7, 0xbe, 0xc9, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa2, 0xff, 0xff,
+    0x17, 0xf7, 0xbe, 0xff, 0xdf, 0x8c, 0x71, 0x00, 0x00, 0x52, 0xaa, 0x00,
+    0x00, 0x39, 0xe7, 0x39, 0xe7, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0xa5,
+    0x34, 0xff, 0xdf, 0x52, 0x8a, 0xc6, 0x38, 0xff, 0xff, 0xf7, 0xbe, 0x4a,
+    0x69, 0xd6, 0x9a, 0xff, 0xff, 0xf7, 0xbe, 0xff, 0xff, 0x8c, 0x51, 0x84,
+    0x10, 0xa6, 0xff, 0xff, 0x13, 0xff, 0xdf, 0xf7, 0xbe, 0xff, 0xff, 0xf7,
+    0xbe, 0xf7, 0xbe, 0xff, 0xff, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xf7,
+    0xbe, 0xff, 0xff, 0xff, 0xdf, 0xf7, 0xbe, 0xef, 0x5d, 0x63, 0x0c, 0x42,
+    0x08, 0x4a, 0x49, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xc9, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xa1, 0xff, 0xff, 0x18, 0xde, 0xfb, 0x31, 0x86, 0x39,
+    0xc7, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x31, 0xa6, 0xd6, 0xba, 0xd6,
+    0x9a, 0x00, 0x00, 0xf7, 0xbe, 0x94, 0xb2, 0x94, 0xb2, 0xff, 0xff, 0xff,
+    0xff, 0x94, 0x92, 0x94, 0xb2, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xff, 0xce,
+    0x79, 0x4a, 0x69, 0xff, 0xff, 0x8c, 0x71, 0x84, 0x10, 0xa6, 0xff, 0xff,
+    0x10, 0xde, 0xdb, 0x63, 0x2c, 0xff, 0xdf, 0x9c, 0xd3, 0xa5, 0x14, 0xff,
+    0xff, 0x63, 0x2c, 0xe7, 0x1c, 0xe7, 0x1c, 0x63, 0x2c, 0xff, 0xff, 0xb5,
+    0x96, 0x00, 0x00, 0x63, 0x0c, 0xf7, 0x9e, 0xff, 0xff, 0xce, 0x79, 0x82,
+    0x00, 0x00, 0x00, 0xb5, 0x96, 0xc8, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa0,
+    0xff, 0xff, 0x19, 0xce, 0x79, 0x5a, 0xcb, 0x00, 0x00, 0xd6, 0xba, 0x73,
+    0xae, 0x39, 0xc7, 0xa5, 0x34, 0x00, 0x00, 0x73, 0xae, 0xc6, 0x38, 0xde,
+    0xdb, 0xa5, 0x34, 0x10, 0x82, 0x39, 0xc7, 0xa5, 0x34, 0x94, 0xb2, 0xbd,
+    0xf7, 0xf7, 0x9e, 0xff, 0xff, 0x9c, 0xf3, 0xe7, 0x1c, 0xf7, 0xbe, 0xde,
+    0xdb, 0xff, 0xff, 0xe7, 0x3c, 0xe7, 0x1c, 0xa5, 0xff, 0xff, 0x16, 0xd6,
+    0x9a, 0x52, 0x8a, 0x00, 0x00, 0xff, 0xff, 0xef, 0x7d, 0xb5, 0xb6, 0x84,
+    0x10, 0x00, 0x00, 0x84, 0x30, 0x7b, 0xcf, 0x00, 0x00, 0x94, 0x92, 0xce,
+    0x59, 0xde, 0xfb, 0xd6, 0xba, 0xad, 0x75, 0xa5, 0x14, 0x73, 0x8e, 0x42,
+    0x08, 0xde, 0xdb, 0x84, 0x10, 0x10, 0xa2, 0xb5, 0x96, 0xc7, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xa0, 0xff, 0xff, 0x1b, 0x8c, 0x51, 0x00, 0x00, 0xb5,
+    0xb6, 0xde, 0xfb, 0xc6, 0x18, 0x6b, 0x6d, 0x00, 0x00, 0xa5, 0x34, 0x18,
+    0xc3, 0x6b, 0x6d, 0xde, 0xfb, 0x9c, 0xf3, 0xa5, 0x34, 0x7b, 0xef, 0x00,
+    0x00, 0x84, 0x30, 0xce, 0x79, 0xde, 0xfb, 0xc6, 0x38, 0x94, 0xb2, 0xe7,
+    0x1c, 0xff, 0xdf, 0xd6, 0xba, 0xce, 0x59, 0xff, 0xdf, 0xff, 0xdf, 0xd6,
+    0x9a, 0xff, 0xdf, 0xa2, 0xff, 0xff, 0x19, 0xde, 0xdb, 0x5a, 0xeb, 0x21,
+    0x24, 0xb5, 0x96, 0xce, 0x59, 0xff, 0xff, 0xf7, 0x9e, 0x84, 0x30, 0x31,
+    0x86, 0x00, 0x00, 0x5a, 0xcb, 0xa5, 0x34, 0x00, 0x00, 0xad, 0x55, 0xe7,
+    0x3c, 0xd6, 0x9a, 0x00, 0x00, 0x6b, 0x6d, 0x7b, 0xcf, 0x21, 0x04, 0xde,
+    0xdb, 0x8c, 0x71, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0xf7, 0xbe, 0xc5,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0x9d, 0xff, 0xff, 0x1e, 0xff, 0xdf, 0xf7,
+    0xbe, 0xff, 0xdf, 0x9c, 0xd3, 0xa5, 0x34, 0xf7, 0xbe, 0x00, 0x00, 0xde,
+    0xdb, 0xde, 0xfb, 0x31, 0x86, 0xf7, 0xbe, 0xb5, 0x96, 0x00, 0x00, 0x29,
+    0x65, 0xef, 0x7d, 0xff, 0xff, 0xce, 0x79, 0x63, 0x2c, 0xff, 0xdf, 0x9c,
+    0xd3, 0x00, 0x00, 0x63, 0x2c, 0xf7, 0x9e, 0xff, 0xff, 0xd6, 0xba, 0x00,
+    0x00, 0x00, 0x00, 0xe7, 0x1c, 0xd6, 0xba, 0x00, 0x00, 0xf7, 0x9e, 0xa1,
+    0xff, 0xff, 0x0d, 0xef, 0x5d, 0x63, 0x0c, 0x00, 0x00, 0xa5, 0x34, 0xf7,
+    0xbe, 0x00, 0x00, 0xbd, 0xf7, 0xff, 0xff, 0xf7, 0x9e, 0x52, 0xaa, 0x00,
+    0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x52, 0xaa, 0x82, 0x00, 0x00, 0x09, 0x29,
+    0x65, 0xde, 0xfb, 0xde, 0xfb, 0x31, 0x86, 0x00, 0x00, 0x31, 0xa6, 0x63,
+    0x0c, 0x52, 0x8a, 0x00, 0x00, 0xc6, 0x18, 0xc5, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x9d, 0xff, 0xff, 0x1e, 0xd6, 0xba, 0x31, 0xa6, 0x39, 0xc7, 0xde,
+    0xfb, 0xde, 0xdb, 0x00, 0x00, 0x00, 0x00, 0xde, 0xfb, 0xde, 0xfb, 0x00,
+    0x00, 0x00, 0x00, 0xde, 0xfb, 0xd6, 0xba, 0x00, 0x00, 0x52, 0x8a, 0x00,
+    0x00, 0xad, 0x55, 0xff, 0xdf, 0x7b, 0xcf, 0x00, 0x00, 0xa5, 0x14, 0xf7,
+    0xbe, 0x4a, 0x49, 0xd6, 0xba, 0xff, 0xff, 0xf7, 0x9e, 0xf7, 0x9e, 0xff,
+    0xff, 0xce, 0x79, 0x31, 0x86, 0xf7, 0xbe, 0xa0, 0xff, 0xff, 0x1c, 0xde,
+    0xdb, 0x63, 0x0c, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x31, 0xa6, 0x00,
+    0x00, 0x42, 0x28, 0x52, 0x8a, 0x31, 0x86, 0x10, 0xa2, 0x00, 0x00, 0x00,
+    0x00, 0x52, 0xaa, 0x00, 0x00, 0xd6, 0xba, 0xd6, 0x9a, 0x00, 0x00, 0xef,
+    0x7d, 0x94, 0xb2, 0x9c, 0xf3, 0xf7, 0xbe, 0x00, 0x00, 0xc6, 0x38, 0xff,
+    0xff, 0xef, 0x7d, 0x29, 0x45, 0x00, 0x00, 0xb5, 0x96, 0xc4, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0x9d, 0xff, 0xff, 0x18, 0xd6, 0x9a, 0x00, 0x00, 0x00,
+    0x00, 0x6b, 0x6d, 0xbd, 0xf7, 0xd6, 0x9a, 0x00, 0x00, 0xde, 0xfb, 0xde,
+    0xfb, 0x00, 0x00, 0xd6, 0x9a, 0xbd, 0xd7, 0xbd, 0xf7, 0xd6, 0xba, 0x00,
+    0x00, 0xad, 0x55, 0xd6, 0xba, 0x9c, 0xd3, 0x00, 0x00, 0x00, 0x00, 0x5a,
+    0xcb, 0xa5, 0x14, 0xd6, 0xba, 0xa5, 0x14, 0xc6, 0x18, 0x82, 0xff, 0xff,
+    0x01, 0xc6, 0x38, 0x00, 0x00, 0xa0, 0xff, 0xff, 0x1e, 0xce, 0x79, 0x5a,
+    0xeb, 0x00, 0x00, 0xa5, 0x34, 0x39, 0xc7, 0x73, 0xae, 0xd6, 0xba, 0x4a,
+    0x69, 0x00, 0x00, 0x73, 0xae, 0xd6, 0xba, 0x29, 0x65, 0xbd, 0xf7, 0xb5,
+    0xb6, 0x00, 0x00, 0xd6, 0xba, 0xb5, 0xb6, 0xad, 0x55, 0xe7, 0x3c, 0xff,
+    0xff, 0xef, 0x5d, 0xbd, 0xd7, 0xad, 0x55, 0xd6, 0x9a, 0xbd, 0xd7, 0x9c,
+    0xd3, 0x9c, 0xf3, 0xde, 0xfb, 0x84, 0x10, 0x00, 0x00, 0xa5, 0x14, 0xc3,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0x9a, 0xff, 0xff, 0x22, 0xff, 0xdf, 0xd6,
+    0x9a, 0xd6, 0x9a, 0xc6, 0x38, 0x94, 0xb2, 0x18, 0xe3, 0x6b, 0x6d, 0xbd,
+    0xd7, 0xde, 0xfb, 0xa5, 0x34, 0xc6, 0x38, 0xc6, 0x38, 0xad, 0x75, 0xe7,
+    0x1c, 0x63, 0x0c, 0x63, 0x0c, 0xe7, 0x1c, 0xad, 0x55, 0xd6, 0x9a, 0xad,
+    0x75, 0x00, 0x00, 0xa5, 0x14, 0x63, 0x2c, 0x42, 0x28, 0xa5, 0x34, 0xde,
+    0xfb, 0xad, 0x75, 0xa5, 0x14, 0xd6, 0x9a, 0xce, 0x79, 0xf7, 0xbe, 0xef,
+    0x5d, 0xa5, 0x34, 0xc6, 0x38, 0xf7, 0x9e, 0x9e, 0xff, 0xff, 0x20, 0x8c,
+    0x71, 0x21, 0x04, 0xa5, 0x34, 0x00, 0x00, 0x73, 0xae, 0xc6, 0x38, 0xd6,
+    0x9a, 0x39, 0xc7, 0x7b, 0xcf, 0xc6, 0x38, 0xd6, 0xba, 0x00, 0x00, 0xb5,
+    0xb6, 0xd6, 0xba, 0xad, 0x55, 0xde, 0xfb, 0xb5, 0x96, 0xad, 0x75, 0xde,
+    0xdb, 0xce, 0x79, 0xff, 0xff, 0xd6, 0xba, 0x00, 0x00, 0xff, 0xff, 0x9c,
+    0xf3, 0x00, 0x00, 0xa5, 0x34, 0xde, 0xdb, 0x84, 0x30, 0x39, 0xc7, 0xa5,
+    0x14, 0xce, 0x59, 0xf7, 0xbe, 0xc1, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9a,
+    0xff, 0xff, 0x22, 0xf7, 0xbe, 0x63, 0x2c, 0x00, 0x00, 0xa5, 0x14, 0xff,
+    0xff, 0x39, 0xe7, 0xd6, 0xba, 0xd6, 0x9a, 0x00, 0x00, 0xff, 0xff, 0x94,
+    0xb2, 0x8c, 0x51, 0xf7, 0xbe, 0x29, 0x65, 0x21, 0x04, 0x21, 0x04, 0x29,
+    0x65, 0xf7, 0xbe, 0xad, 0x55, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0x94,
+    0xb2, 0x94, 0xb2, 0xf7, 0xbe, 0x00, 0x00, 0xde, 0xdb, 0xe7, 0x3c, 0x00,
+    0x00, 0x00, 0x00, 0xce, 0x79, 0xff, 0xff, 0xef, 0x7d, 0x4a, 0x49, 0xce,
+    0x79, 0x9e, 0xff, 0xff, 0x20, 0x8c, 0x71, 0x94, 0xb2, 0xf7, 0xbe, 0x31,
+    0xa6, 0xd6, 0xba, 0xde, 0xfb, 0x00, 0x00, 0x00, 0x00, 0xde, 0xdb, 0xd6,
+    0xba, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x9c, 0xd3, 0xf7, 0xbe, 0x00,
+    0x00, 0xd6, 0x9a, 0xde, 0xfb, 0x00, 0x00, 0x00, 0x00, 0xde, 0xdb, 0xde,
+    0xdb, 0x31, 0xa6, 0xff, 0xdf, 0x9c, 0xd3, 0x94, 0x92, 0xf7, 0xbe, 0x63,
+    0x2c, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x00, 0x00, 0xbd, 0xf7, 0xc1,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0x9b, 0xff, 0xff, 0x20, 0xff, 0xdf, 0x73,
+    0xae, 0x94, 0xb2, 0xff, 0xff, 0x5a, 0xcb, 0x31, 0x86, 0x29, 0x65, 0x52,
+    0xaa, 0xff, 0xff, 0xa5, 0x14, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0xd6,
+    0xba, 0xd6, 0xba, 0x00, 0x00, 0x29, 0x65, 0xe7, 0x1c, 0xd6, 0xba, 0x00,
+    0x00, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x31, 0x86, 0x00, 0x00, 0xd6,
+    0xba, 0xff, 0xff, 0xef, 0x7d, 0x00, 0x00, 0xde, 0xdb, 0xe7, 0x1c, 0x4a,
+    0x49, 0xef, 0x7d, 0x9f, 0xff, 0xff, 0x21, 0x9c, 0xd3, 0x00, 0x00, 0x52,
+    0xaa, 0x00, 0x00, 0x00, 0x00, 0xb5, 0xb6, 0xf7, 0xbe, 0x31, 0x86, 0x21,
+    0x04, 0x18, 0xe3, 0x29, 0x65, 0xf7, 0xbe, 0x9c, 0xd3, 0x00, 0x00, 0x52,
+    0xaa, 0x00, 0x00, 0x00, 0x00, 0xb5, 0xb6, 0xf7, 0xbe, 0x00, 0x00, 0xde,
+    0xdb, 0xde, 0xfb, 0x39, 0xc7, 0xff, 0xff, 0xa5, 0x14, 0x00, 0x00, 0x7b,
+    0xcf, 0xff, 0xdf, 0x9c, 0xd3, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x00,
+    0x00, 0xb5, 0x96, 0xc0, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9c, 0xff, 0xff,
+    0x02, 0xef, 0x5d, 0xbd, 0xd7, 0x84, 0x10, 0x83, 0x00, 0x00, 0x19, 0x94,
+    0x92, 0xd6, 0xba, 0xb5, 0xb6, 0x00, 0x00, 0xd6, 0xba, 0xbd, 0xf7, 0xbd,
+    0xf7, 0xd6, 0xba, 0x00, 0x00, 0x6b, 0x6d, 0xce, 0x59, 0xd6, 0xba, 0x00,
+    0x00, 0xb5, 0x96, 0xe7, 0x1c, 0xce, 0x79, 0xd6, 0xba, 0xad, 0x55, 0x8c,
+    0x71, 0xad, 0x75, 0xd6, 0x9a, 0xb5, 0x96, 0xad, 0x75, 0xce, 0x59, 0x94,
+    0xb2, 0xef, 0x5d, 0x9b, 0xff, 0xff, 0x25, 0xef, 0x5d, 0x94, 0xb2, 0x8c,
+    0x51, 0xce, 0x79, 0xb5, 0xb6, 0x00, 0x00, 0xce, 0x79, 0x7b, 0xef, 0x18,
+    0xe3, 0xa5, 0x34, 0xde, 0xfb, 0x63, 0x2c, 0x63, 0x2c, 0xde, 0xfb, 0x9c,
+    0xd3, 0xce, 0x79, 0xb5, 0xb6, 0x00, 0x00, 0xce, 0x79, 0x7b, 0xef, 0x18,
+    0xe3, 0xa5, 0x34, 0xde, 0xfb, 0xc6, 0x18, 0x6b, 0x6d, 0x00, 0x00, 0x94,
+    0x92, 0xd6, 0xba, 0xb5, 0x96, 0x00, 0x00, 0x9c, 0xd3, 0xde, 0xdb, 0xb5,
+    0xb6, 0x00, 0x00, 0xde, 0xdb, 0x73, 0x8e, 0x00, 0x00, 0xb5, 0x96, 0xbf,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0x9d, 0xff, 0xff, 0x20, 0xe7, 0x3c, 0x84,
+    0x30, 0x9c, 0xf3, 0xa5, 0x14, 0xa5, 0x34, 0x94, 0xb2, 0x00, 0x00, 0xb5,
+    0x96, 0xbd, 0xd7, 0x31, 0x86, 0xde, 0xdb, 0x6b, 0x4d, 0x63, 0x0c, 0xe7,
+    0x1c, 0xb5, 0xb6, 0x00, 0x00, 0x73, 0x8e, 0xde, 0xdb, 0x00, 0x00, 0xa5,
+    0x34, 0xf7, 0x9e, 0xff, 0xff, 0xff, 0xff, 0xce, 0x59, 0x21, 0x24, 0x00,
+    0x00, 0xff, 0xff, 0x94, 0x92, 0x94, 0x92, 0xff, 0xff, 0x9c, 0xf3, 0xad,
+    0x75, 0xe7, 0x3c, 0x91, 0xff, 0xff, 0x01, 0xe7, 0x1c, 0xe7, 0x1c, 0x84,
+    0xff, 0xff, 0x29, 0xde, 0xdb, 0xd6, 0xba, 0x9c, 0xf3, 0x00, 0x00, 0x8c,
+    0x51, 0xce, 0x79, 0xb5, 0x96, 0x4a, 0x49, 0xff, 0xff, 0xad, 0x55, 0x10,
+    0x82, 0xa5, 0x34, 0xde, 0xdb, 0xb5, 0xb6, 0xb5, 0xb6, 0xde, 0xdb, 0x9c,
+    0xd3, 0xce, 0x59, 0xb5, 0x96, 0x4a, 0x49, 0xff, 0xff, 0xad, 0x75, 0x08,
+    0x41, 0xa5, 0x34, 0xde, 0xfb, 0x6b, 0x6d, 0x18, 0xc3, 0xa5, 0x34, 0x00,
+    0x00, 0xad, 0x75, 0xd6, 0xba, 0x9c, 0xd3, 0x00, 0x00, 0xb5, 0xb6, 0xbd,
+    0xd7, 0x31, 0x86, 0xd6, 0xba, 0xce, 0x59, 0x73, 0x8e, 0x00, 0x00, 0xc6,
+    0x38, 0xf7, 0xbe, 0xbd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa2, 0xff, 0xff,
+    0x0f, 0xff, 0xdf, 0x7b, 0xcf, 0x29, 0x45, 0x21, 0x24, 0x00, 0x00, 0x00,
+    0x00, 0x39, 0xe7, 0x18, 0xe3, 0x29, 0x65, 0xf7, 0xbe, 0xb5, 0xb6, 0x00,
+    0x00, 0x00, 0x00, 0x52, 0x8a, 0x00, 0x00, 0xa5, 0x34, 0x82, 0xff, 0xff,
+    0x0a, 0xde, 0xdb, 0x63, 0x0c, 0xf7, 0x9e, 0x8c, 0x71, 0x84, 0x30, 0xff,
+    0xff, 0xff, 0xff, 0x9c, 0xf3, 0x8c, 0x71, 0xff, 0xdf, 0xf7, 0xbe, 0x8f,
+    0xff, 0xff, 0x30, 0x7b, 0xcf, 0x7b, 0xef, 0xff, 0xdf, 0xf7, 0xbe, 0xf7,
+    0xbe, 0xff, 0xdf, 0xef, 0x5d, 0x29, 0x65, 0x00, 0x00, 0x00, 0x00, 0x52,
+    0xaa, 0xf7, 0xbe, 0xad, 0x55, 0x00, 0x00, 0x52, 0xaa, 0xff, 0xdf, 0x9c,
+    0xd3, 0x94, 0xb2, 0xf7, 0xbe, 0x00, 0x00, 0xde, 0xfb, 0xde, 0xfb, 0x00,
+    0x00, 0xf7, 0xbe, 0xad, 0x55, 0x00, 0x00, 0x52, 0x8a, 0xf7, 0x9e, 0x8c,
+    0x71, 0x94, 0xb2, 0xf7, 0xbe, 0x31, 0x86, 0x00, 0x00, 0xb5, 0x96, 0xf7,
+    0xbe, 0x52, 0xaa, 0x00, 0x00, 0xad, 0x55, 0xf7, 0xbe, 0x52, 0xaa, 0x00,
+    0x00, 0x31, 0x86, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0xde, 0xdb, 0x00,
+    0x00, 0x00, 0x00, 0xc6, 0x38, 0xbd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa3,
+    0xff, 0xff, 0x0e, 0xf7, 0xbe, 0xff, 0xff, 0xc6, 0x38, 0x00, 0x00, 0x00,
+    0x00, 0xd6, 0x9a, 0xd6, 0x9a, 0x00, 0x00, 0x00, 0x00, 0xde, 0xfb, 0xd6,
+    0x9a, 0x00, 0x00, 0xef, 0x5d, 0xf7, 0xbe, 0xff, 0xdf, 0x83, 0xff, 0xff,
+    0x0a, 0xef, 0x5d, 0x63, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x63, 0x2c, 0xff,
+    0xff, 0xff, 0xff, 0xce, 0x79, 0x00, 0x00, 0x29, 0x65, 0xde, 0xfb, 0x8d,
+    0xff, 0xff, 0x2e, 0x7b, 0xcf, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xcb, 0x5a,
+    0xcb, 0x42, 0x08, 0x42, 0x08, 0x52, 0x8a, 0x00, 0x00, 0xd6, 0x9a, 0xd6,
+    0x9a, 0x00, 0x00, 0x31, 0xa6, 0xe7, 0x1c, 0xce, 0x79, 0x00, 0x00, 0xff,
+    0xff, 0xad, 0x75, 0x00, 0x00, 0x31, 0xa6, 0x00, 0x00, 0xde, 0xfb, 0xde,
+    0xfb, 0x00, 0x00, 0x31, 0xa6, 0xde, 0xdb, 0xd6, 0x9a, 0x00, 0x00, 0x31,
+    0x86, 0x18, 0xc3, 0x18, 0xe3, 0x31, 0xa6, 0x00, 0x00, 0xde, 0xdb, 0xde,
+    0xfb, 0x00, 0x00, 0x00, 0x00, 0xd6, 0x9a, 0xde, 0xdb, 0x31, 0x86, 0x00,
+    0x00, 0xd6, 0xba, 0xde, 0xdb, 0x00, 0x00, 0x00, 0x00, 0x42, 0x08, 0x42,
+    0x08, 0x82, 0x00, 0x00, 0x00, 0xad, 0x55, 0xbc, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xa5, 0xff, 0xff, 0x09, 0xf7, 0xbe, 0xce, 0x79, 0xce, 0x79, 0xf7,
+    0xbe, 0xf7, 0xbe, 0xce, 0x79, 0xce, 0x79, 0xa5, 0x34, 0xad, 0x55, 0xde,
+    0xdb, 0x87, 0xff, 0xff, 0x0a, 0xde, 0xdb, 0x52, 0x8a, 0x6b, 0x4d, 0xde,
+    0xdb, 0xa5, 0x34, 0x9c, 0xf3, 0xbd, 0xd7, 0xc6, 0x38, 0x08, 0x61, 0x4a,
+    0x49, 0xce, 0x59, 0x8a, 0xff, 0xff, 0x36, 0xef, 0x7d, 0x8c, 0x71, 0x00,
+    0x00, 0xb5, 0xb6, 0xc6, 0x18, 0x00, 0x00, 0x00, 0x00, 0xb5, 0xb6, 0xbd,
+    0xd7, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x3c, 0xef, 0x5d, 0x00, 0x00, 0x00,
+    0x00, 0x73, 0xae, 0xc6, 0x38, 0xde, 0xdb, 0x9c, 0xf3, 0x29, 0x65, 0x84,
+    0x10, 0xce, 0x59, 0x00, 0x00, 0xe7, 0x1c, 0xe7, 0x1c, 0x00, 0x00, 0x00,
+    0x00, 0xef, 0x5d, 0xe7, 0x3c, 0x00, 0x00, 0xd6, 0xba, 0x7b, 0xef, 0x84,
+    0x10, 0xd6, 0xba, 0x00, 0x00, 0x73, 0x8e, 0xc6, 0x38, 0xd6, 0x9a, 0x00,
+    0x00, 0xe7, 0x1c, 0xe7, 0x3c, 0x00, 0x00, 0xd6, 0xba, 0xbd, 0xf7, 0x6b,
+    0x4d, 0x42, 0x08, 0xde, 0xdb, 0x6b, 0x4d, 0x6b, 0x4d, 0xde, 0xdb, 0x00,
+    0x00, 0xad, 0x75, 0xce, 0x79, 0xad, 0x55, 0xff, 0xdf, 0xba, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xac, 0xff, 0xff, 0x01, 0xbd, 0xd7, 0xbd, 0xd7, 0x89,
+    0xff, 0xff, 0x0a, 0xce, 0x59, 0xb5, 0x96, 0xd6, 0x9a, 0x00, 0x00, 0x00,
+    0x00, 0xa5, 0x14, 0xff, 0xff, 0x52, 0xaa, 0x5a, 0xcb, 0xad, 0x55, 0xd6,
+    0xba, 0x86, 0xff, 0xff, 0x39, 0xff, 0xdf, 0xd6, 0x9a, 0xd6, 0xba, 0xa5,
+    0x34, 0x00, 0x00, 0x9c, 0xd3, 0xd6, 0xba, 0xb5, 0xb6, 0x00, 0x00, 0x9c,
+    0xf3, 0xd6, 0xba, 0xb5, 0xb6, 0x00, 0x00, 0x9c, 0xf3, 0xce, 0x59, 0xad,
+    0x55, 0x08, 0x41, 0xa5, 0x34, 0x10, 0xa2, 0x6b, 0x6d, 0xde, 0xfb, 0x9c,
+    0xf3, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0x31, 0xa6, 0xa5, 0x34, 0xd6,
+    0x9a, 0x9c, 0xf3, 0x00, 0x00, 0xb5, 0x96, 0xad, 0x75, 0x00, 0x00, 0xde,
+    0xdb, 0x7b, 0xcf, 0x73, 0xae, 0xe7, 0x1c, 0xb5, 0xb6, 0x00, 0x00, 0x6b,
+    0x6d, 0xe7, 0x1c, 0xad, 0x75, 0xc6, 0x38, 0xa5, 0x34, 0x31, 0x86, 0xd6,
+    0x9a, 0xbd, 0xd7, 0x6b, 0x4d, 0x39, 0xe7, 0xd6, 0x9a, 0xbd, 0xd7, 0xbd,
+    0xf7, 0xde, 0xdb, 0xa5, 0x14, 0xd6, 0x9a, 0xad, 0x75, 0x00, 0x00, 0xf7,
+    0xbe, 0xba, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb9, 0xff, 0xff, 0x00, 0xde,
+    0xdb, 0x82, 0x00, 0x00, 0x06, 0xad, 0x75, 0xef, 0x7d, 0x29, 0x65, 0xde,
+    0xfb, 0xe7, 0x1c, 0x42, 0x28, 0xef, 0x5d, 0x85, 0xff, 0xff, 0x2a, 0xf7,
+    0xbe, 0x63, 0x2c, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xad,
+    0x55, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xad, 0x55, 0x00, 0x00, 0x52,
+    0xaa, 0xf7, 0xbe, 0xad, 0x55, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xb5,
+    0xb6, 0x00, 0x00, 0x31, 0xa6, 0xff, 0xff, 0x9c, 0xf3, 0x8c, 0x71, 0xf7,
+    0x9e, 0x73, 0xae, 0x00, 0x00, 0x9c, 0xd3, 0xff, 0xdf, 0x7b, 0xcf, 0x00,
+    0x00, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x39, 0xe7, 0x18, 0xe3, 0x29,
+    0x65, 0xf7, 0xbe, 0xb5, 0xb6, 0x00, 0x00, 0x31, 0x86, 0xf7, 0xbe, 0xad,
+    0x55, 0x82, 0x00, 0x00, 0x0b, 0xde, 0xfb, 0xde, 0xdb, 0x00, 0x00, 0x00,
+    0x00, 0xde, 0xfb, 0xd6, 0x9a, 0x00, 0x00, 0xff, 0xff, 0xa5, 0x14, 0x00,
+    0x00, 0x73, 0xae, 0xef, 0x5d, 0xba, 0xff, 0xff, 0xff, 0xff, 0xff, 0xba,
+    0xff, 0xff, 0x0a, 0xe7, 0x3c, 0x00, 0x00, 0xd6, 0x9a, 0xde, 0xfb, 0x00,
+    0x00, 0x00, 0x00, 0xde, 0xdb, 0xff, 0xff, 0xf7, 0x9e, 0x63, 0x0c, 0xde,
+    0xdb, 0x86, 0xff, 0xff, 0x38, 0x9c, 0xf3, 0x00, 0x00, 0x00, 0x00, 0x31,
+    0x86, 0xde, 0xfb, 0xde, 0xdb, 0x00, 0x00, 0x31, 0xa6, 0xe7, 0x1c, 0xd6,
+    0xba, 0x00, 0x00, 0x29, 0x65, 0xe7, 0x1c, 0xd6, 0xba, 0x00, 0x00, 0x29,
+    0x65, 0xe7, 0x1c, 0xd6, 0x9a, 0x00, 0x00, 0xff, 0xff, 0xa5, 0x14, 0x00,
+    0x00, 0x73, 0xae, 0xf7, 0x9e, 0x9c, 0xf3, 0x00, 0x00, 0x63, 0x2c, 0xf7,
+    0xbe, 0x94, 0xb2, 0x94, 0xb2, 0xf7, 0xbe, 0x31, 0xa6, 0xd6, 0xba, 0xd6,
+    0xba, 0x00, 0x00, 0x31, 0x86, 0xde, 0xdb, 0xd6, 0x9a, 0x00, 0x00, 0x31,
+    0xa6, 0xde, 0xdb, 0xce, 0x79, 0x39, 0xc7, 0xf7, 0xbe, 0xad, 0x55, 0x00,
+    0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xad, 0x55, 0x00, 0x00, 0x5a, 0xcb, 0xff,
+    0xff, 0x94, 0x92, 0x84, 0x30, 0xff, 0xdf, 0x63, 0x0c, 0xde, 0xdb, 0xb9,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xbb, 0xff, 0xff, 0x4a, 0xde, 0xdb, 0xa5,
+    0x34, 0xb5, 0x96, 0xd6, 0x9a, 0x00, 0x00, 0x73, 0x8e, 0xa5, 0x34, 0x8c,
+    0x71, 0x00, 0x00, 0x7b, 0xef, 0xa5, 0x14, 0x8c, 0x71, 0x94, 0xb2, 0xef,
+    0x5d, 0xff, 0xff, 0xff, 0xff, 0xad, 0x55, 0x00, 0x00, 0x7b, 0xef, 0xde,
+    0xdb, 0x00, 0x00, 0x84, 0x10, 0x8c, 0x71, 0x00, 0x00, 0x00, 0x00, 0x6b,
+    0x6d, 0xbd, 0xf7, 0xd6, 0xba, 0x00, 0x00, 0x6b, 0x6d, 0xce, 0x59, 0xd6,
+    0xba, 0x00, 0x00, 0x6b, 0x6d, 0xc6, 0x18, 0xd6, 0x9a, 0xa5, 0x14, 0xd6,
+    0x9a, 0xad, 0x75, 0x00, 0x00, 0xff, 0xff, 0x9c, 0xd3, 0x5a, 0xcb, 0xde,
+    0xdb, 0xb5, 0x96, 0x31, 0xa6, 0x4a, 0x49, 0xa5, 0x34, 0x00, 0x00, 0x73,
+    0xae, 0xce, 0x59, 0xd6, 0xba, 0x00, 0x00, 0xe7, 0x3c, 0xe7, 0x3c, 0x00,
+    0x00, 0x00, 0x00, 0xef, 0x5d, 0xe7, 0x1c, 0x00, 0x00, 0x9c, 0xd3, 0xd6,
+    0xba, 0xad, 0x75, 0x00, 0x00, 0x9c, 0xd3, 0xd6, 0xba, 0xad, 0x75, 0x00,
+    0x00, 0x94, 0x92, 0xce, 0x59, 0xce, 0x59, 0x9c, 0xf3, 0x00, 0x00, 0x6b,
+    0x4d, 0xce, 0x79, 0xb8, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbc, 0xff, 0xff,
+    0x45, 0xbd, 0xf7, 0xa5, 0x34, 0xde, 0xfb, 0xb5, 0xb6, 0x39, 0xc7, 0x31,
+    0x86, 0x94, 0xb2, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x49, 0x94, 0xb2, 0x00,
+    0x00, 0x9c, 0xf3, 0xde, 0xdb, 0xce, 0x79, 0x94, 0xb2, 0x94, 0xb2, 0xbd,
+    0xf7, 0xd6, 0xba, 0xad, 0x75, 0x00, 0x00, 0x39, 0xc7, 0xa5, 0x34, 0x00,
+    0x00, 0x6b, 0x4d, 0xbd, 0xd7, 0xde, 0xdb, 0xb5, 0x96, 0x00, 0x00, 0x6b,
+    0x6d, 0xe7, 0x1c, 0xad, 0x75, 0x00, 0x00, 0xa5, 0x14, 0xff, 0xff, 0x00,
+    0x00, 0xad, 0x75, 0xd6, 0x9a, 0xa5, 0x14, 0xd6, 0x9a, 0xb5, 0xb6, 0xbd,
+    0xf7, 0xd6, 0xba, 0x00, 0x00, 0x84, 0x10, 0x8c, 0x51, 0x00, 0x00, 0xa5,
+    0x34, 0x18, 0xc3, 0x73, 0x8e, 0xde, 0xdb, 0x00, 0x00, 0xad, 0x55, 0xd6,
+    0x9a, 0x9c, 0xf3, 0x00, 0x00, 0xad, 0x55, 0xd6, 0x9a, 0x9c, 0xd3, 0x00,
+    0x00, 0xb5, 0x96, 0xd6, 0xba, 0x94, 0x92, 0x00, 0x00, 0xad, 0x75, 0xd6,
+    0xba, 0x9c, 0xd3, 0x00, 0x00, 0xe7, 0x1c, 0xe7, 0x3c, 0x82, 0x00, 0x00,
+    0x00, 0x9c, 0xd3, 0xb8, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbd, 0xff, 0xff,
+    0x49, 0xd6, 0x9a, 0x00, 0x00, 0xf7, 0xbe, 0x94, 0xb2, 0x94, 0xb2, 0xff,
+    0xdf, 0x7b, 0xcf, 0x00, 0x00, 0xa5, 0x14, 0xf7, 0xbe, 0x52, 0xaa, 0x00,
+    0x00, 0x00, 0x00, 0x39, 0xc7, 0xff, 0xdf, 0xff, 0xff, 0xce, 0x59, 0x52,
+    0x8a, 0xff, 0xff, 0xad, 0x55, 0xa5, 0x14, 0xf7, 0xbe, 0x63, 0x2c, 0xde,
+    0xdb, 0xd6, 0xba, 0x4a, 0x69, 0xf7, 0xbe, 0xb5, 0x96, 0x00, 0x00, 0x31,
+    0xa6, 0xff, 0xff, 0x9c, 0xf3, 0x8c, 0x71, 0xf7, 0x9e, 0x73, 0xae, 0x00,
+    0x00, 0xa5, 0x14, 0xff, 0xff, 0x00, 0x00, 0xd6, 0x9a, 0xd6, 0xba, 0x00,
+    0x00, 0x29, 0x65, 0xe7, 0x1c, 0xd6, 0x9a, 0x31, 0x86, 0xf7, 0xbe, 0xb5,
+    0xb6, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x9c, 0xd3, 0xff,
+    0xdf, 0x7b, 0xcf, 0x00, 0x00, 0x9c, 0xd3, 0xff, 0xdf, 0x7b, 0xcf, 0x00,
+    0x00, 0xa5, 0x14, 0xff, 0xff, 0x5a, 0xcb, 0x00, 0x00, 0xad, 0x55, 0xf7,
+    0xbe, 0x63, 0x2c, 0xd6, 0xba, 0xd6, 0x9a, 0x00, 0x00, 0x52, 0xaa, 0x00,
+    0x00, 0x94, 0xb2, 0xff, 0xdf, 0xb7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbd,
+    0xff, 0xff, 0x49, 0xde, 0xdb, 0x00, 0x00, 0x31, 0x86, 0x18, 0xe3, 0x00,
+    0x00, 0x63, 0x2c, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x31, 0xa6, 0x00,
+    0x00, 0xde, 0xdb, 0xd6, 0xba, 0x31, 0xa6, 0xff, 0xdf, 0xad, 0x55, 0x94,
+    0xb2, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xce, 0x59, 0x63, 0x2c, 0xf7,
+    0x9e, 0x94, 0xb2, 0x9c, 0xf3, 0xf7, 0xbe, 0x4a, 0x69, 0xde, 0xdb, 0xd6,
+    0x9a, 0x00, 0x00, 0xff, 0xff, 0xa5, 0x14, 0x00, 0x00, 0x73, 0xae, 0xf7,
+    0x9e, 0x8c, 0x71, 0x9c, 0xf3, 0xff, 0xff, 0x31, 0xa6, 0x18, 0xc3, 0x21,
+    0x04, 0x29, 0x65, 0xf7, 0xbe, 0xb5, 0xb6, 0x00, 0x00, 0x00, 0x00, 0x31,
+    0x86, 0xe7, 0x1c, 0xd6, 0x9a, 0x00, 0x00, 0xf7, 0xbe, 0x9c, 0xd3, 0x00,
+    0x00, 0x7b, 0xcf, 0xff, 0xdf, 0x9c, 0xd3, 0x00, 0x00, 0x7b, 0xcf, 0xff,
+    0xdf, 0x94, 0x92, 0x9c, 0xd3, 0xff, 0xdf, 0x39, 0xc7, 0xd6, 0xba, 0xd6,
+    0xba, 0x4a, 0x69, 0xf7, 0xbe, 0xb5, 0x96, 0x00, 0x00, 0x31, 0x86, 0xf7,
+    0xbe, 0x9c, 0xd3, 0x00, 0x00, 0x7b, 0xcf, 0xb7, 0xff, 0xff, 0xf4, 0xff,
+    0xff, 0x06, 0xc6, 0x38, 0xce, 0x59, 0xff, 0xff, 0xa5, 0x34, 0xe7, 0x3c,
+    0xe7, 0x3c, 0xa5, 0x34, 0xc0, 0xff, 0xff, 0x11, 0xd6, 0x9a, 0x6b, 0x4d,
+    0x39, 0xe7, 0xd6, 0xba, 0x7b, 0xef, 0x7b, 0xef, 0xde, 0xdb, 0xa5, 0x14,
+    0x39, 0xc7, 0x8c, 0x51, 0xd6, 0xba, 0x00, 0x00, 0x84, 0x10, 0x8c, 0x51,
+    0x52, 0x8a, 0xff, 0xff, 0x8c, 0x51, 0x84, 0x10, 0x82, 0xff, 0xff, 0x37,
+    0xce, 0x79, 0x00, 0x00, 0xff, 0xdf, 0xf7, 0x9e, 0xc6, 0x18, 0xad, 0x55,
+    0xce, 0x59, 0xb5, 0x96, 0xbd, 0xf7, 0xde, 0xdb, 0x94, 0x92, 0xce, 0x79,
+    0xad, 0x75, 0x00, 0x00, 0xff, 0xff, 0xa5, 0x14, 0x00, 0x00, 0xad, 0x55,
+    0xd6, 0xba, 0x6b, 0x6d, 0x7b, 0xcf, 0xde, 0xfb, 0xa5, 0x34, 0x10, 0x82,
+    0x84, 0x30, 0xde, 0xdb, 0x00, 0x00, 0x6b, 0x6d, 0xc6, 0x38, 0xde, 0xdb,
+    0x9c, 0xd3, 0xd6, 0x9a, 0xb5, 0x96, 0x00, 0x00, 0x9c, 0xd3, 0xde, 0xdb,
+    0xb5, 0x96, 0x00, 0x00, 0xa5, 0x14, 0x4a, 0x49, 0xad, 0x55, 0xff, 0xff,
+    0x10, 0x82, 0x6b, 0x6d, 0xc6, 0x18, 0xd6, 0xba, 0xb5, 0x96, 0x00, 0x00,
+    0x6b, 0x6d, 0xe7, 0x1c, 0xad, 0x55, 0xd6, 0xba, 0xb5, 0x96, 0x00, 0x00,
+    0x8c, 0x71, 0xef, 0x7d, 0xb5, 0xff, 0xff, 0xf0, 0xff, 0xff, 0x0c, 0xe7,
+    0x3c, 0xce, 0x59, 0xce, 0x79, 0xde, 0xdb, 0x52, 0xaa, 0x63, 0x0c, 0xce,
+    0x79, 0x00, 0x00, 0xde, 0xdb, 0xde, 0xdb, 0x00, 0x00, 0xc6, 0x38, 0xd6,
+    0xba, 0x88, 0xd6, 0x9a, 0x04, 0xce, 0x79, 0xce, 0x79, 0xf7, 0xbe, 0xf7,
+    0xbe, 0xd6, 0xba, 0x88, 0xff, 0xff, 0x01, 0xe7, 0x1c, 0xe7, 0x1c, 0x85,
+    0xff, 0xff, 0x01, 0xde, 0xfb, 0xe7, 0x1c, 0x95, 0xff, 0xff, 0x01, 0xe7,
+    0x1c, 0xce, 0x59, 0x85, 0xd6, 0x9a, 0x4d, 0x6b, 0x6d, 0x00, 0x00, 0x39,
+    0xc7, 0xde, 0xdb, 0x7b, 0xcf, 0x73, 0xae, 0xde, 0xfb, 0xa5, 0x34, 0x10,
+    0x82, 0x84, 0x10, 0xe7, 0x1c, 0xb5, 0xb6, 0x31, 0xa6, 0x00, 0x00, 0x4a,
+    0x49, 0xce, 0x79, 0xbd, 0xd7, 0xb5, 0xb6, 0xd6, 0xba, 0xce, 0x59, 0xff,
+    0xff, 0xd6, 0xba, 0x31, 0xa6, 0xff, 0xdf, 0xf7, 0xbe, 0x9c, 0xf3, 0x00,
+    0x00, 0xff, 0xff, 0x94, 0xb2, 0x52, 0xaa, 0xde, 0xfb, 0x9c, 0xd3, 0xce,
+    0x59, 0xd6, 0x9a, 0xad, 0x55, 0xd6, 0x9a, 0xc6, 0x18, 0x6b, 0x4d, 0x00,
+    0x00, 0xff, 0xff, 0xa5, 0x14, 0x6b, 0x6d, 0xde, 0xfb, 0xa5, 0x34, 0x10,
+    0x82, 0x84, 0x10, 0xde, 0xfb, 0xad, 0x75, 0x00, 0x00, 0x6b, 0x6d, 0xde,
+    0xfb, 0x9c, 0xd3, 0xce, 0x59, 0xd6, 0xba, 0x9c, 0xd3, 0x00, 0x00, 0xb5,
+    0x96, 0xde, 0xdb, 0x9c, 0xd3, 0x00, 0x00, 0x00, 0x00, 0x84, 0x10, 0xd6,
+    0xba, 0xb5, 0x96, 0x18, 0xe3, 0x73, 0xae, 0xd6, 0xba, 0x00, 0x00, 0x73,
+    0x8e, 0xc6, 0x38, 0xd6, 0x9a, 0x00, 0x00, 0xad, 0x75, 0xd6, 0xba, 0x9c,
+    0xd3, 0x00, 0x00, 0x94, 0xb2, 0xef, 0x5d, 0xb4, 0xff, 0xff, 0xee, 0xff,
+    0xff, 0x0c, 0xf7, 0xbe, 0xff, 0xdf, 0x8c, 0x71, 0x00, 0x00, 0x31, 0xa6,
+    0x00, 0x00, 0x42, 0x08, 0x39, 0xe7, 0x00, 0x00, 0x31, 0xa6, 0xde, 0xdb,
+    0xde, 0xdb, 0x31, 0xa6, 0x8a, 0x00, 0x00, 0x17, 0x31, 0x86, 0x00, 0x00,
+    0xd6, 0x9a, 0xce, 0x79, 0x00, 0x00, 0xef, 0x5d, 0xff, 0xdf, 0xf7, 0xbe,
+    0xf7, 0xbe, 0xf7, 0x9e, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe, 0xff, 0xdf,
+    0x7b, 0xef, 0x7b, 0xef, 0xff, 0xdf, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff,
+    0xf7, 0xbe, 0xff, 0xff, 0x84, 0x30, 0x7b, 0xcf, 0x95, 0xff, 0xff, 0x00,
+    0xa5, 0x34, 0x85, 0x00, 0x00, 0x0d, 0x31, 0x86, 0x18, 0xc3, 0x31, 0xa6,
+    0x52, 0xaa, 0x00, 0x00, 0x39, 0xe7, 0x21, 0x04, 0x29, 0x65, 0xf7, 0xbe,
+    0xb5, 0xb6, 0x00, 0x00, 0x31, 0x86, 0xf7, 0xbe, 0xb5, 0x96, 0x82, 0x00,
+    0x00, 0x35, 0xd6, 0xba, 0xd6, 0xba, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba,
+    0xce, 0x79, 0x31, 0x86, 0xef, 0x7d, 0xa5, 0x34, 0x00, 0x00, 0x52, 0x8a,
+    0xef, 0x7d, 0xb5, 0x96, 0x00, 0x00, 0x29, 0x65, 0xf7, 0xbe, 0x8c, 0x51,
+    0x8c, 0x51, 0xf7, 0xbe, 0x00, 0x00, 0xd6, 0x9a, 0xde, 0xdb, 0x63, 0x0c,
+    0xf7, 0x9e, 0xad, 0x75, 0x00, 0x00, 0x31, 0x86, 0xf7, 0xbe, 0xb5, 0xb6,
+    0x00, 0x00, 0x31, 0xa6, 0xff, 0xff, 0xbd, 0xd7, 0x00, 0x00, 0x29, 0x65,
+    0xf7, 0xbe, 0x8c, 0x51, 0x8c, 0x51, 0xff, 0xdf, 0x7b, 0xcf, 0x00, 0x00,
+    0x9c, 0xd3, 0xf7, 0xbe, 0x52, 0xaa, 0x39, 0xc7, 0x18, 0xc3, 0x29, 0x65,
+    0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x31, 0xa6, 0x00, 0x00, 0xde, 0xdb,
+    0xde, 0xfb, 0x82, 0x00, 0x00, 0x05, 0xad, 0x55, 0xf7, 0xbe, 0x52, 0xaa,
+    0x00, 0x00, 0x9c, 0xf3, 0xff, 0xdf, 0xb3, 0xff, 0xff, 0xed, 0xff, 0xff,
+    0x0e, 0xde, 0xfb, 0x31, 0x86, 0x39, 0xc7, 0x00, 0x00, 0xa5, 0x34, 0xf7,
+    0xbe, 0x31, 0xa6, 0xd6, 0xba, 0xd6, 0xba, 0x31, 0xa6, 0xf7, 0xbe, 0xa5,
+    0x34, 0xa5, 0x34, 0xf7, 0xbe, 0x52, 0xaa, 0x88, 0x00, 0x00, 0x19, 0xa5,
+    0x34, 0xf7, 0xbe, 0x52, 0x8a, 0x31, 0x86, 0x4a, 0x49, 0x00, 0x00, 0x52,
+    0x8a, 0x5a, 0xcb, 0x4a, 0x69, 0x31, 0xa6, 0x31, 0x86, 0xe7, 0x3c, 0xe7,
+    0x3c, 0x31, 0xa6, 0x5a, 0xcb, 0x29, 0x65, 0x00, 0x00, 0x39, 0xc7, 0x31,
+    0x86, 0xef, 0x5d, 0xde, 0xfb, 0x4a, 0x69, 0xff, 0xff, 0xa5, 0x14, 0x00,
+    0x00, 0x7b, 0xcf, 0x95, 0xff, 0xff, 0x00, 0xc6, 0x38, 0x83, 0x00, 0x00,
+    0x51, 0x52, 0xaa, 0xf7, 0xbe, 0x94, 0xb2, 0x94, 0xb2, 0xf7, 0xbe, 0x00,
+    0x00, 0xd6, 0x9a, 0xd6, 0xba, 0x00, 0x00, 0x29, 0x65, 0xe7, 0x1c, 0xde,
+    0xdb, 0x00, 0x00, 0x31, 0xa6, 0xe7, 0x1c, 0xd6, 0xba, 0x00, 0x00, 0x00,
+    0x00, 0x31, 0x86, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xb5, 0x96, 0x00,
+    0x00, 0x00, 0x00, 0x31, 0x86, 0xde, 0xdb, 0xce, 0x79, 0x00, 0x00, 0x29,
+    0x65, 0xe7, 0x1c, 0xd6, 0xba, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x00,
+    0x00, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xf7, 0x9e, 0x63,
+    0x0c, 0xde, 0xdb, 0xde, 0xdb, 0x00, 0x00, 0x00, 0x00, 0xde, 0xfb, 0xd6,
+    0x9a, 0x00, 0x00, 0xff, 0xdf, 0xff, 0xff, 0xce, 0x59, 0x00, 0x00, 0x31,
+    0x86, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xcf, 0xff, 0xdf, 0xa5, 0x34, 0x00,
+    0x00, 0x31, 0xa6, 0x00, 0x00, 0xde, 0xdb, 0xd6, 0xba, 0x00, 0x00, 0x52,
+    0x8a, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x31, 0x86, 0x00, 0x00, 0xb5,
+    0xb6, 0xf7, 0xbe, 0x00, 0x00, 0xd6, 0x9a, 0xde, 0xfb, 0x00, 0x00, 0x00,
+    0x00, 0xde, 0xdb, 0xde, 0xdb, 0x63, 0x2c, 0xf7, 0xbe, 0xb2, 0xff, 0xff,
+    0xeb, 0xff, 0xff, 0x1c, 0x9c, 0xf3, 0x9c, 0xd3, 0x7b, 0xcf, 0x18, 0xc3,
+    0xd6, 0xba, 0x73, 0xae, 0x39, 0xc7, 0xa5, 0x34, 0x21, 0x24, 0x7b, 0xef,
+    0x84, 0x10, 0x18, 0xe3, 0x94, 0xb2, 0x4a, 0x49, 0x4a, 0x49, 0x94, 0xb2,
+    0x00, 0x00, 0xc6, 0x18, 0xb5, 0xb6, 0x00, 0x00, 0xde, 0xdb, 0x84, 0x30,
+    0x84, 0x30, 0xde, 0xdb, 0x00, 0x00, 0x00, 0x00, 0x63, 0x2c, 0x94, 0xb2,
+    0x31, 0xa6, 0x84, 0x00, 0x00, 0x04, 0x8c, 0x51, 0xd6, 0xba, 0x18, 0xc3,
+    0x84, 0x10, 0x8c, 0x51, 0x82, 0x00, 0x00, 0x0d, 0x94, 0x92, 0xd6, 0xba,
+    0x18, 0xc3, 0x73, 0x8e, 0xbd, 0xd7, 0xce, 0x59, 0x94, 0x92, 0xc6, 0x38,
+    0xad, 0x75, 0x00, 0x00, 0x9c, 0xd3, 0xa5, 0x14, 0x9c, 0xd3, 0xad, 0x75,
+    0x91, 0xff, 0xff, 0x55, 0xf7, 0xbe, 0xc6, 0x38, 0x21, 0x04, 0xbd, 0xf7,
+    0xbd, 0xd7, 0x00, 0x00, 0xa5, 0x34, 0x4a, 0x49, 0x31, 0xa6, 0xb5, 0x96,
+    0xde, 0xfb, 0xbd, 0xf7, 0xbd, 0xd7, 0xce, 0x59, 0x00, 0x20, 0x8c, 0x51,
+    0x8c, 0x51, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x6d, 0xbd, 0xf7, 0xd6, 0xba,
+    0x31, 0x86, 0xbd, 0xd7, 0xb5, 0xb6, 0x00, 0x00, 0xa5, 0x34, 0x18, 0xc3,
+    0x73, 0x8e, 0xde, 0xdb, 0x00, 0x00, 0xde, 0xfb, 0xff, 0xff, 0xce, 0x79,
+    0x00, 0x00, 0x6b, 0x6d, 0xce, 0x59, 0xd6, 0xba, 0x00, 0x00, 0xad, 0x75,
+    0xb5, 0x96, 0x00, 0x00, 0xce, 0x79, 0x63, 0x2c, 0xa5, 0x14, 0xff, 0xff,
+    0x00, 0x00, 0x7b, 0xcf, 0x8c, 0x71, 0x31, 0xa6, 0xc6, 0x38, 0xad, 0x55,
+    0xb5, 0x96, 0xde, 0xfb, 0xad, 0x55, 0x94, 0x92, 0xad, 0x75, 0xd6, 0xba,
+    0xce, 0x79, 0xde, 0xdb, 0xa5, 0x14, 0x00, 0x00, 0x94, 0x92, 0x18, 0xe3,
+    0x73, 0xae, 0xd6, 0xba, 0x39, 0xe7, 0x7b, 0xcf, 0xce, 0x59, 0xd6, 0xba,
+    0x00, 0x00, 0x00, 0x00, 0x5a, 0xcb, 0xa5, 0x34, 0xde, 0xfb, 0x84, 0x10,
+    0x10, 0x82, 0xa5, 0x34, 0xde, 0xdb, 0xbd, 0xf7, 0xb5, 0xb6, 0xc6, 0x38,
+    0x39, 0xc7, 0x7b, 0xef, 0x73, 0x8e, 0x39, 0xe7, 0xb3, 0xff, 0xff, 0xe9,
+    0xff, 0xff, 0x34, 0xf7, 0xbe, 0xce, 0x59, 0xa5, 0x14, 0x18, 0xc3, 0x00,
+    0x00, 0x4a, 0x69, 0xd6, 0x9a, 0xc6, 0x38, 0x7b, 0xcf, 0x00, 0x00, 0x00,
+    0x00, 0x84, 0x10, 0x84, 0x10, 0x18, 0xe3, 0x94, 0xb2, 0x5a, 0xcb, 0x5a,
+    0xcb, 0x94, 0xb2, 0x00, 0x00, 0xbd, 0xd7, 0xd6, 0xba, 0xad, 0x55, 0xde,
+    0xfb, 0x73, 0xae, 0x73, 0xae, 0xde, 0xfb, 0xad, 0x75, 0x52, 0x8a, 0x52,
+    0xaa, 0x94, 0xb2, 0x00, 0x00, 0x8c, 0x51, 0x8c, 0x71, 0x18, 0xe3, 0x9c,
+    0xf3, 0x52, 0x8a, 0x8c, 0x51, 0xde, 0xdb, 0x39, 0xc7, 0x00, 0x00, 0x00,
+    0x00, 0x39, 0xc7, 0xa5, 0x34, 0x5a, 0xcb, 0x84, 0x30, 0xd6, 0xba, 0x4a,
+    0x69, 0x00, 0x00, 0xa5, 0x14, 0xff, 0xff, 0x9c, 0xf3, 0xf7, 0x9e, 0xe7,
+    0x3c, 0x84, 0x00, 0x00, 0x02, 0xce, 0x59, 0xd6, 0x9a, 0xe7, 0x3c, 0x90,
+    0xff, 0xff, 0x36, 0x29, 0x45, 0xad, 0x75, 0xd6, 0x9a, 0x94, 0x92, 0x00,
+    0x00, 0x7b, 0xef, 0x7b, 0xcf, 0x00, 0x00, 0xd6, 0xba, 0x63, 0x0c, 0x9c,
+    0xd3, 0xff, 0xff, 0x4a, 0x69, 0x00, 0x00, 0x5a, 0xcb, 0xa5, 0x34, 0x00,
+    0x00, 0x6b, 0x4d, 0xbd, 0xd7, 0xd6, 0x9a, 0x29, 0x45, 0xb5, 0xb6, 0xd6,
+    0xba, 0x94, 0x92, 0x00, 0x00, 0x6b, 0x6d, 0xc6, 0x18, 0xd6, 0x9a, 0x31,
+    0x86, 0xa5, 0x14, 0xde, 0xfb, 0xde, 0xdb, 0xb5, 0xb6, 0x00, 0x00, 0x73,
+    0x8e, 0xde, 0xdb, 0x00, 0x00, 0xe7, 0x1c, 0xe7, 0x3c, 0x39, 0xc7, 0xff,
+    0xff, 0xa5, 0x34, 0x63, 0x2c, 0xce, 0x79, 0xb5, 0x96, 0x39, 0xc7, 0x00,
+    0x00, 0x5a, 0xeb, 0xff, 0xff, 0xce, 0x59, 0xad, 0x75, 0xd6, 0x9a, 0x00,
+    0x00, 0x31, 0xa6, 0xce, 0x59, 0x82, 0xff, 0xff, 0x1b, 0xef, 0x5d, 0x94,
+    0xb2, 0x8c, 0x71, 0x94, 0x92, 0xbd, 0xf7, 0xd6, 0x9a, 0x31, 0xa6, 0x00,
+    0x00, 0x73, 0xae, 0xe7, 0x1c, 0xb5, 0x96, 0x5a, 0xcb, 0x42, 0x28, 0xa5,
+    0x34, 0xde, 0xfb, 0x8c, 0x51, 0x31, 0xa6, 0xa5, 0x14, 0xde, 0xdb, 0x5a,
+    0xeb, 0x94, 0xb2, 0xff, 0xff, 0x52, 0xaa, 0x7b, 0xcf, 0x73, 0xae, 0x08,
+    0x61, 0xc6, 0x38, 0xf7, 0xbe, 0xb1, 0xff, 0xff, 0xe7, 0xff, 0xff, 0x05,
+    0xf7, 0xbe, 0xff, 0xff, 0xbd, 0xf7, 0x00, 0x00, 0xf7, 0xbe, 0xb5, 0x96,
+    0x82, 0x00, 0x00, 0x31, 0xde, 0xfb, 0xde, 0xdb, 0x00, 0x00, 0x31, 0xa6,
+    0xde, 0xfb, 0xd6, 0x9a, 0x31, 0x86, 0xf7, 0xbe, 0x94, 0xb2, 0x94, 0xb2,
+    0xf7, 0xbe, 0x52, 0xaa, 0x00, 0x00, 0x9c, 0xf3, 0xf7, 0xbe, 0x31, 0x86,
+    0x21, 0x04, 0x18, 0xc3, 0x31, 0xa6, 0xff, 0xff, 0x9c, 0xf3, 0x94, 0x92,
+    0xf7, 0xbe, 0x63, 0x2c, 0xde, 0xdb, 0xd6, 0x9a, 0x39, 0xe7, 0xff, 0xff,
+    0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0x39, 0xc7, 0x00, 0x00,
+    0x52, 0xaa, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x31, 0xa6, 0x00, 0x00,
+    0x00, 0x00, 0x9c, 0xd3, 0xff, 0xdf, 0xff, 0xdf, 0xff, 0xff, 0xce, 0x79,
+    0x39, 0xc7, 0x00, 0x00, 0x4a, 0x49, 0x4a, 0x69, 0x82, 0x00, 0x00, 0x00,
+    0x8c, 0x71, 0x8f, 0xff, 0xff, 0x13, 0xf7, 0xbe, 0x73, 0xae, 0x00, 0x00,
+    0xad, 0x75, 0xff, 0xff, 0x63, 0x2c, 0xe7, 0x1c, 0xe7, 0x3c, 0x31, 0x86,
+    0x39, 0xc7, 0x00, 0x00, 0x9c, 0xf3, 0xf7, 0x9e, 0x73, 0xae, 0x00, 0x00,
+    0xa5, 0x14, 0xff, 0xdf, 0x63, 0x2c, 0xde, 0xdb, 0xde, 0xdb, 0x82, 0x00,
+    0x00, 0x1f, 0xa5, 0x34, 0xff, 0xff, 0x31, 0xa6, 0xde, 0xfb, 0xe7, 0x3c,
+    0x00, 0x00, 0x00, 0x00, 0x31, 0x86, 0x00, 0x00, 0x31, 0x86, 0xf7, 0xbe,
+    0xb5, 0xb6, 0x00, 0x00, 0x00, 0x00, 0x31, 0xa6, 0xde, 0xdb, 0xce, 0x79,
+    0x39, 0xc7, 0xff, 0xdf, 0xad, 0x55, 0x00, 0x00, 0x63, 0x2c, 0xf7, 0xbe,
+    0xb5, 0x96, 0x00, 0x00, 0x52, 0x8a, 0xf7, 0xbe, 0xff, 0xff, 0xd6, 0x9a,
+    0x00, 0x00, 0x29, 0x65, 0xde, 0xfb, 0x87, 0xff, 0xff, 0x17, 0xde, 0xdb,
+    0x00, 0x00, 0x52, 0x8a, 0x5a, 0xeb, 0x00, 0x00, 0x29, 0x65, 0xf7, 0xbe,
+    0x94, 0xb2, 0x94, 0xb2, 0xf7, 0xbe, 0x31, 0xa6, 0x00, 0x00, 0xa5, 0x34,
+    0xf7, 0xbe, 0x63, 0x2c, 0x00, 0x00, 0xad, 0x55, 0xff, 0xdf, 0x31, 0xa6,
+    0xd6, 0x9a, 0xe7, 0x1c, 0x29, 0x65, 0x00, 0x00, 0xc6, 0x18, 0xb1, 0xff,
+    0xff, 0xe6, 0xff, 0xff, 0x3b, 0xff, 0xdf, 0x7b, 0xcf, 0x29, 0x45, 0x21,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0xde, 0xfb, 0xd6, 0xba, 0x31, 0xa6, 0xf7,
+    0xbe, 0xad, 0x55, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xb5, 0xb6, 0x00,
+    0x00, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0x00,
+    0x00, 0x00, 0x00, 0x21, 0x24, 0x31, 0xa6, 0x00, 0x00, 0xde, 0xdb, 0xd6,
+    0x9a, 0x00, 0x00, 0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x63, 0x2c, 0xf7,
+    0xbe, 0xad, 0x55, 0x00, 0x00, 0x5a, 0xcb, 0xff, 0xff, 0xa5, 0x34, 0x00,
+    0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x00, 0x00, 0x52,
+    0xaa, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x31, 0xa6, 0x00, 0x00, 0x31,
+    0xa6, 0x5a, 0xcb, 0x5a, 0xcb, 0x29, 0x65, 0xb5, 0x96, 0xf7, 0xbe, 0x31,
+    0xa6, 0xd6, 0xba, 0xd6, 0xba, 0x83, 0x00, 0x00, 0x00, 0x7b, 0xcf, 0x8f,
+    0xff, 0xff, 0x35, 0xf7, 0xbe, 0xf7, 0x9e, 0xff, 0xdf, 0xff, 0xff, 0xf7,
+    0xbe, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe, 0xff, 0xdf, 0x9c, 0xd3, 0x00,
+    0x00, 0x63, 0x2c, 0xff, 0xdf, 0x9c, 0xd3, 0x00, 0x00, 0x7b, 0xcf, 0xf7,
+    0x9e, 0xa5, 0x14, 0xa5, 0x14, 0xef, 0x7d, 0x31, 0xa6, 0x00, 0x00, 0xa5,
+    0x14, 0xff, 0xdf, 0x00, 0x00, 0xd6, 0x9a, 0xff, 0xff, 0xe7, 0x3c, 0x29,
+    0x65, 0xd6, 0xba, 0xd6, 0xba, 0x00, 0x00, 0x29, 0x65, 0xe7, 0x1c, 0xd6,
+    0x9a, 0x00, 0x00, 0xf7, 0xbe, 0xad, 0x75, 0x00, 0x00, 0x31, 0xa6, 0xff,
+    0xdf, 0x9c, 0xd3, 0x8c, 0x71, 0xf7, 0x9e, 0x63, 0x2c, 0xde, 0xdb, 0xd6,
+    0x9a, 0x00, 0x00, 0xff, 0xff, 0xa5, 0x34, 0x8c, 0x51, 0xff, 0xdf, 0xf7,
+    0xbe, 0xff, 0xdf, 0x87, 0xff, 0xff, 0x09, 0xff, 0xdf, 0xf7, 0x9e, 0xf7,
+    0xbe, 0xff, 0xff, 0xc6, 0x38, 0x00, 0x00, 0x31, 0x86, 0x00, 0x00, 0x00,
+    0x00, 0x52, 0xaa, 0x82, 0x00, 0x00, 0x0b, 0x7b, 0xcf, 0xff, 0xdf, 0x94,
+    0x92, 0x9c, 0xd3, 0xff, 0xdf, 0x31, 0xa6, 0x00, 0x00, 0xb5, 0x96, 0xef,
+    0x7d, 0x52, 0x8a, 0x00, 0x00, 0xad, 0x55, 0xb0, 0xff, 0xff, 0xe4, 0xff,
+    0xff, 0x34, 0xce, 0x79, 0x9c, 0xd3, 0x94, 0xb2, 0x00, 0x00, 0xb5, 0x96,
+    0xbd, 0xd7, 0x21, 0x24, 0xc6, 0x38, 0xc6, 0x18, 0x7b, 0xcf, 0x00, 0x00,
+    0x9c, 0xd3, 0xd6, 0xba, 0xb5, 0xb6, 0x00, 0x00, 0x94, 0xb2, 0x31, 0xa6,
+    0x84, 0x30, 0xde, 0xdb, 0x00, 0x00, 0xbd, 0xd7, 0xbd, 0xd7, 0x00, 0x00,
+    0xde, 0xdb, 0x84, 0x30, 0x84, 0x10, 0xd6, 0xba, 0x00, 0x00, 0x73, 0x8e,
+    0xc6, 0x38, 0xde, 0xdb, 0x9c, 0xf3, 0x29, 0x45, 0x84, 0x30, 0xde, 0xdb,
+    0xad, 0x75, 0xc6, 0x38, 0xad, 0x55, 0x00, 0x00, 0x94, 0xb2, 0xd6, 0xba,
+    0xb5, 0xb6, 0x00, 0x00, 0xa5, 0x14, 0x5a, 0xcb, 0x8c, 0x51, 0xde, 0xdb,
+    0x00, 0x00, 0x00, 0x00, 0x63, 0x2c, 0xb5, 0x96, 0xde, 0xfb, 0x94, 0x92,
+    0x83, 0x00, 0x00, 0x0d, 0x4a, 0x69, 0xa5, 0x34, 0x00, 0x00, 0x73, 0xae,
+    0xce, 0x59, 0xd6, 0xba, 0x29, 0x65, 0xbd, 0xf7, 0xbd, 0xf7, 0x00, 0x00,
+    0x9c, 0xd3, 0xa5, 0x14, 0x9c, 0xd3, 0xad, 0x75, 0x8d, 0xff, 0xff, 0x02,
+    0xde, 0xfb, 0x94, 0xb2, 0xff, 0xdf, 0x83, 0xff, 0xff, 0x29, 0x9c, 0xd3,
+    0x6b, 0x4d, 0xce, 0x79, 0xad, 0x55, 0xce, 0x79, 0xa5, 0x34, 0x31, 0xa6,
+    0xff, 0xff, 0x9c, 0xd3, 0x8c, 0x71, 0xff, 0xff, 0xde, 0xdb, 0xce, 0x59,
+    0xef, 0x5d, 0xff, 0xff, 0xde, 0xdb, 0x9c, 0xd3, 0xce, 0x59, 0xff, 0xff,
+    0x10, 0xa2, 0x6b, 0x6d, 0xce, 0x59, 0xd6, 0xba, 0x18, 0xc3, 0x73, 0xae,
+    0xc6, 0x38, 0xde, 0xfb, 0xad, 0x75, 0xbd, 0xf7, 0xce, 0x79, 0xde, 0xdb,
+    0xff, 0xff, 0x84, 0x10, 0x94, 0xb2, 0xff, 0xff, 0x00, 0x00, 0x6b, 0x4d,
+    0xc6, 0x18, 0xce, 0x79, 0x94, 0x92, 0xb5, 0x96, 0xe7, 0x3c, 0x8e, 0xff,
+    0xff, 0x15, 0xf7, 0xbe, 0xce, 0x79, 0xce, 0x79, 0xe7, 0x1c, 0xb5, 0x96,
+    0x00, 0x00, 0xd6, 0xba, 0xe7, 0x1c, 0xa5, 0x14, 0x00, 0x00, 0x94, 0x92,
+    0x31, 0xa6, 0xa5, 0x34, 0xff, 0xff, 0xde, 0xfb, 0x31, 0x86, 0x94, 0xb2,
+    0xff, 0xff, 0x4a, 0x49, 0xad, 0x75, 0xce, 0x59, 0xad, 0x55, 0xaf, 0xff,
+    0xff, 0xb7, 0xff, 0xff, 0x03, 0xd6, 0x9a, 0xce, 0x79, 0xd6, 0x9a, 0xde,
+    0xdb, 0xa5, 0xff, 0xff, 0x44, 0xf7, 0x9e, 0xce, 0x79, 0xde, 0xdb, 0x6b,
+    0x4d, 0x00, 0x00, 0x00, 0x00, 0x9c, 0xd3, 0xd6, 0xba, 0xad, 0x75, 0x4a,
+    0x49, 0xff, 0xff, 0x9c, 0xf3, 0x18, 0xe3, 0xa5, 0x34, 0x00, 0x00, 0xb5,
+    0xb6, 0xc6, 0x18, 0x00, 0x00, 0x94, 0xb2, 0x4a, 0x49, 0x8c, 0x51, 0xd6,
+    0xba, 0x29, 0x65, 0xb5, 0xb6, 0xb5, 0xb6, 0x29, 0x65, 0xd6, 0xba, 0x7b,
+    0xef, 0x84, 0x10, 0xde, 0xfb, 0xb5, 0xb6, 0x18, 0xc3, 0x73, 0x8e, 0xde,
+    0xdb, 0xa5, 0x34, 0x10, 0xa2, 0x84, 0x30, 0xde, 0xdb, 0x00, 0x00, 0xe7,
+    0x1c, 0xef, 0x5d, 0x00, 0x00, 0x00, 0x00, 0xb5, 0x96, 0xd6, 0xba, 0x9c,
+    0xd3, 0x00, 0x00, 0x00, 0x00, 0x8c, 0x51, 0xe7, 0x1c, 0xb5, 0x96, 0x5a,
+    0xcb, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0x84, 0x30, 0x5a, 0xcb, 0xa5,
+    0x34, 0x21, 0x04, 0x94, 0x92, 0x84, 0x30, 0x00, 0x00, 0xa5, 0x34, 0x31,
+    0xa6, 0x7b, 0xcf, 0xde, 0xdb, 0x00, 0x00, 0xbd, 0xd7, 0xc6, 0x18, 0x84,
+    0x00, 0x00, 0x01, 0xc6, 0x38, 0xf7, 0xbe, 0x8b, 0xff, 0xff, 0x02, 0xde,
+    0xfb, 0x94, 0xb2, 0xf7, 0xbe, 0x83, 0xff, 0xff, 0x09, 0x84, 0x30, 0x9c,
+    0xf3, 0xff, 0xff, 0x00, 0x00, 0xde, 0xdb, 0xe7, 0x1c, 0x00, 0x00, 0xce,
+    0x59, 0x63, 0x0c, 0x94, 0x92, 0x82, 0xff, 0xff, 0x0f, 0xf7, 0x9e, 0xd6,
+    0x9a, 0xff, 0xff, 0xc6, 0x38, 0x9c, 0xf3, 0xd6, 0x9a, 0xb5, 0x96, 0x00,
+    0x00, 0x6b, 0x6d, 0xd6, 0xba, 0x31, 0xa6, 0x00, 0x00, 0x7b, 0xcf, 0xd6,
+    0xba, 0x00, 0x00, 0xd6, 0x9a, 0x82, 0xff, 0xff, 0x08, 0xc6, 0x38, 0xad,
+    0x55, 0xce, 0x79, 0xb5, 0x96, 0x00, 0x00, 0x94, 0xb2, 0xff, 0xff, 0x94,
+    0xb2, 0xe7, 0x1c, 0x92, 0xff, 0xff, 0x14, 0xf7, 0x9e, 0xa5, 0x34, 0x00,
+    0x00, 0xce, 0x59, 0xff, 0xff, 0xf7, 0x9e, 0x94, 0xb2, 0x94, 0x92, 0x39,
+    0xc7, 0x73, 0x8e, 0xde, 0xdb, 0xff, 0xff, 0xd6, 0x9a, 0xb5, 0x96, 0xc6,
+    0x38, 0x00, 0x00, 0xbd, 0xf7, 0xb5, 0xb6, 0x00, 0x00, 0xbd, 0xf7, 0xf7,
+    0x9e, 0xad, 0xff, 0xff, 0xb6, 0xff, 0xff, 0x10, 0xef, 0x5d, 0x63, 0x2c,
+    0x00, 0x00, 0x00, 0x00, 0x31, 0x86, 0xef, 0x5d, 0xf7, 0xbe, 0xff, 0xdf,
+    0xff, 0xff, 0xf7, 0xbe, 0xf7, 0x9e, 0xf7, 0x9e, 0xf7, 0xbe, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xdf, 0xf7, 0xbe, 0x83, 0xff, 0xff, 0x09, 0xf7, 0xbe,
+    0xf7, 0x9e, 0xff, 0xdf, 0xff, 0xff, 0xf7, 0xbe, 0xf7, 0x9e, 0xff, 0xdf,
+    0xff, 0xff, 0xf7, 0xbe, 0xff, 0xdf, 0x89, 0xff, 0xff, 0x4f, 0xf7, 0xbe,
+    0xff, 0xff, 0xc6, 0x38, 0x00, 0x00, 0x00, 0x00, 0x42, 0x08, 0x31, 0xa6,
+    0x52, 0x8a, 0xf7, 0xbe, 0xad, 0x55, 0x00, 0x00, 0x52, 0xaa, 0xff, 0xdf,
+    0x9c, 0xd3, 0x94, 0x92, 0xff, 0xdf, 0x7b, 0xcf, 0x00, 0x00, 0x00, 0x00,
+    0x52, 0xaa, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x31, 0xa6, 0x00, 0x20,
+    0x29, 0x65, 0x29, 0x65, 0x00, 0x20, 0x31, 0xa6, 0x21, 0x24, 0x00, 0x00,
+    0x31, 0xa6, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x63, 0x2c, 0xf7, 0xbe,
+    0xb5, 0x96, 0x00, 0x00, 0x00, 0x00, 0x31, 0xa6, 0xde, 0xdb, 0xde, 0xdb,
+    0x39, 0xc7, 0x08, 0x61, 0x00, 0x00, 0xad, 0x55, 0xf7, 0xbe, 0x52, 0xaa,
+    0x39, 0xc7, 0x18, 0xc3, 0x29, 0x65, 0xf7, 0xbe, 0xb5, 0x96, 0x00, 0x00,
+    0x00, 0x00, 0x31, 0xa6, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x31, 0xa6,
+    0xd6, 0xba, 0xd6, 0xba, 0x31, 0x86, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00,
+    0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x18, 0xe3, 0x52, 0xaa,
+    0x31, 0x86, 0x31, 0x86, 0x52, 0x8a, 0x00, 0x00, 0xc6, 0x38, 0xff, 0xff,
+    0xf7, 0xbe, 0x90, 0xff, 0xff, 0x25, 0x9c, 0xf3, 0x9c, 0xf3, 0xef, 0x7d,
+    0x29, 0x65, 0xde, 0xdb, 0xde, 0xfb, 0x00, 0x00, 0x29, 0x65, 0x18, 0xc3,
+    0xa5, 0x34, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xce, 0x79, 0x42, 0x28,
+    0xef, 0x5d, 0xff, 0xff, 0xd6, 0x9a, 0x00, 0x00, 0xf7, 0xbe, 0xb5, 0x96,
+    0x08, 0x61, 0x31, 0xa6, 0x52, 0xaa, 0x5a, 0xcb, 0x4a, 0x69, 0x31, 0xa6,
+    0x39, 0xc7, 0xce, 0x79, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe, 0xff, 0xff,
+    0xd6, 0xba, 0x4a, 0x49, 0xf7, 0xbe, 0xa5, 0x14, 0x9c, 0xf3, 0x95, 0xff,
+    0xff, 0x04, 0xa5, 0x34, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0xce, 0x59,
+    0x82, 0xff, 0xff, 0x0c, 0xa5, 0x34, 0x00, 0x00, 0x63, 0x0c, 0xef, 0x5d,
+    0xff, 0xff, 0xd6, 0x9a, 0x00, 0x00, 0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00,
+    0x5a, 0xcb, 0x00, 0x00, 0xd6, 0xba, 0xad, 0xff, 0xff, 0xb5, 0xff, 0xff,
+    0x1f, 0xde, 0xdb, 0x63, 0x0c, 0xff, 0xdf, 0x9c, 0xd3, 0x00, 0x00, 0x08,
+    0x61, 0x29, 0x65, 0x00, 0x00, 0xbd, 0xd7, 0xff, 0xff, 0x7b, 0xcf, 0x21,
+    0x04, 0x18, 0xe3, 0x7b, 0xcf, 0xff, 0xdf, 0xff, 0xff, 0xd6, 0xba, 0x63,
+    0x2c, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0x7b, 0xcf, 0x00,
+    0x00, 0xb5, 0xb6, 0xff, 0xff, 0x7b, 0xcf, 0x00, 0x00, 0xb5, 0xb6, 0xff,
+    0xff, 0x63, 0x2c, 0xd6, 0xba, 0x88, 0xff, 0xff, 0x51, 0xff, 0xdf, 0x7b,
+    0xcf, 0x4a, 0x49, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0xde, 0xdb, 0xd6,
+    0xba, 0x00, 0x00, 0x29, 0x65, 0xe7, 0x1c, 0xce, 0x79, 0x00, 0x00, 0xff,
+    0xff, 0xad, 0x55, 0x00, 0x00, 0x7b, 0xcf, 0xff, 0xdf, 0xa5, 0x34, 0x00,
+    0x00, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x31,
+    0xa6, 0xd6, 0xba, 0xd6, 0xba, 0x31, 0xa6, 0xf7, 0xbe, 0xa5, 0x34, 0x00,
+    0x00, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0xa5, 0x14, 0xf7, 0xbe, 0x4a,
+    0x69, 0xde, 0xdb, 0xd6, 0x9a, 0x00, 0x00, 0xf7, 0xbe, 0x9c, 0xd3, 0x9c,
+    0xd3, 0xf7, 0xbe, 0x31, 0xa6, 0xd6, 0x9a, 0xde, 0xfb, 0x31, 0xa6, 0x00,
+    0x00, 0xde, 0xdb, 0xd6, 0xba, 0x00, 0x00, 0x29, 0x65, 0xe7, 0x1c, 0xd6,
+    0x9a, 0x00, 0x00, 0xf7, 0xbe, 0x9c, 0xf3, 0x00, 0x00, 0x31, 0xa6, 0x00,
+    0x00, 0x10, 0xa2, 0x10, 0x82, 0x00, 0x00, 0x52, 0xaa, 0x08, 0x41, 0x00,
+    0x00, 0x31, 0xa6, 0xf7, 0xbe, 0x9c, 0xf3, 0x00, 0x00, 0x5a, 0xcb, 0xf7,
+    0xbe, 0x94, 0xb2, 0x94, 0xb2, 0xf7, 0xbe, 0x52, 0x8a, 0x29, 0x65, 0x39,
+    0xc7, 0x63, 0x0c, 0xf7, 0xbe, 0x90, 0xff, 0xff, 0x15, 0xce, 0x79, 0x29,
+    0x65, 0x00, 0x00, 0xe7, 0x1c, 0xde, 0xfb, 0x29, 0x65, 0xf7, 0x9e, 0xff,
+    0xff, 0xc6, 0x38, 0x52, 0x8a, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xef,
+    0x5d, 0x42, 0x28, 0xde, 0xfb, 0xde, 0xdb, 0x00, 0x00, 0x29, 0x65, 0xd6,
+    0xba, 0xff, 0xff, 0xf7, 0x9e, 0x83, 0xf7, 0xbe, 0x09, 0xff, 0xdf, 0x8c,
+    0x71, 0x9c, 0xf3, 0xff, 0xdf, 0x4a, 0x49, 0xd6, 0xba, 0xff, 0xff, 0xef,
+    0x5d, 0x4a, 0x49, 0xc6, 0x38, 0x96, 0xff, 0xff, 0x14, 0xff, 0xdf, 0xf7,
+    0x9e, 0xf7, 0xbe, 0xff, 0xdf, 0x8c, 0x71, 0x94, 0xb2, 0xff, 0xff, 0xff,
+    0xff, 0x94, 0xb2, 0x94, 0x92, 0xf7, 0xbe, 0x63, 0x0c, 0x00, 0x00, 0xad,
+    0x55, 0xff, 0xff, 0xff, 0xff, 0x8c, 0x51, 0x8c, 0x71, 0xff, 0xff, 0xf7,
+    0xbe, 0xff, 0xdf, 0xad, 0xff, 0xff, 0xb4, 0xff, 0xff, 0x21, 0xce, 0x79,
+    0x5a, 0xeb, 0x00, 0x00, 0x9c, 0xd3, 0xde, 0xdb, 0xb5, 0xb6, 0x29, 0x45,
+    0xd6, 0xba, 0x84, 0x10, 0x29, 0x45, 0x8c, 0x51, 0x00, 0x00, 0xbd, 0xd7,
+    0xb5, 0xb6, 0x00, 0x00, 0x9c, 0xd3, 0xad, 0x55, 0x7b, 0xcf, 0x00, 0x00,
+    0x9c, 0xd3, 0xa5, 0x14, 0xa5, 0x34, 0x94, 0xb2, 0x00, 0x00, 0x00, 0x00,
+    0x63, 0x0c, 0x9c, 0xf3, 0x00, 0x00, 0x00, 0x00, 0x63, 0x0c, 0x9c, 0xd3,
+    0x00, 0x00, 0x73, 0x8e, 0xad, 0x55, 0x87, 0xa5, 0x14, 0x50, 0x9c, 0xd3,
+    0x00, 0x00, 0x00, 0x00, 0x84, 0x10, 0xce, 0x79, 0x39, 0xc7, 0x7b, 0xef,
+    0xce, 0x59, 0xd6, 0xba, 0x00, 0x00, 0x6b, 0x6d, 0xc6, 0x38, 0xde, 0xdb,
+    0x9c, 0xf3, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x14, 0x5a, 0xcb,
+    0x8c, 0x51, 0xde, 0xdb, 0x31, 0xa6, 0x00, 0x00, 0x5a, 0xcb, 0xa5, 0x34,
+    0x21, 0x24, 0x7b, 0xef, 0x84, 0x10, 0x18, 0xe3, 0x94, 0xb2, 0x42, 0x28,
+    0x8c, 0x71, 0xde, 0xdb, 0x00, 0x00, 0x00, 0x00, 0x52, 0x8a, 0xb5, 0x96,
+    0xce, 0x79, 0xb5, 0xb6, 0xb5, 0xb6, 0xd6, 0x9a, 0xad, 0x55, 0xc6, 0x18,
+    0xc6, 0x38, 0x9c, 0xf3, 0x21, 0x24, 0x84, 0x10, 0x84, 0x10, 0x00, 0x00,
+    0x00, 0x00, 0x7b, 0xcf, 0xce, 0x59, 0xd6, 0xba, 0x00, 0x00, 0x6b, 0x6d,
+    0xc6, 0x18, 0xd6, 0x9a, 0xad, 0x55, 0xc6, 0x18, 0xde, 0xdb, 0xde, 0xdb,
+    0xd6, 0x9a, 0xd6, 0xba, 0xde, 0xdb, 0xc6, 0x38, 0x00, 0x00, 0xad, 0x55,
+    0xe7, 0x3c, 0xce, 0x79, 0x9c, 0xd3, 0xce, 0x59, 0xad, 0x55, 0x00, 0x00,
+    0x94, 0x92, 0x52, 0xaa, 0x63, 0x2c, 0xa5, 0x34, 0x00, 0x00, 0x00, 0x00,
+    0x7b, 0xef, 0xe7, 0x1c, 0x91, 0xff, 0xff, 0x14, 0xd6, 0xba, 0x00, 0x00,
+    0xce, 0x59, 0xb5, 0xb6, 0x5a, 0xcb, 0x00, 0x00, 0x84, 0x10, 0xf7, 0x9e,
+    0xff, 0xff, 0xc6, 0x18, 0x8c, 0x51, 0xde, 0xfb, 0xff, 0xff, 0xff, 0xff,
+    0xde, 0xdb, 0xf7, 0x9e, 0xff, 0xdf, 0xd6, 0x9a, 0x00, 0x00, 0x42, 0x28,
+    0xd6, 0x9a, 0x85, 0xff, 0xff, 0x08, 0xde, 0xfb, 0xde, 0xfb, 0xff, 0xff,
+    0xe7, 0x1c, 0x9c, 0xf3, 0xc6, 0x38, 0xff, 0xff, 0xd6, 0x9a, 0xf7, 0x9e,
+    0x9a, 0xff, 0xff, 0x0e, 0xde, 0xfb, 0xde, 0xfb, 0xff, 0xdf, 0xa5, 0x14,
+    0x00, 0x00, 0x39, 0xe7, 0xb5, 0x96, 0xd6, 0x9a, 0x5a, 0xeb, 0x00, 0x00,
+    0x9c, 0xf3, 0x9c, 0xf3, 0x4a, 0x69, 0x52, 0xaa, 0xbd, 0xd7, 0xaf, 0xff,
+    0xff, 0xb4, 0xff, 0xff, 0x0d, 0x94, 0x92, 0x18, 0xe3, 0xa5, 0x34, 0x00,
+    0x00, 0xb5, 0xb6, 0xbd, 0xd7, 0x29, 0x65, 0xd6, 0xba, 0x8c, 0x51, 0x4a,
+    0x49, 0x94, 0xb2, 0x00, 0x00, 0xbd, 0xf7, 0xbd, 0xf7, 0x88, 0x00, 0x00,
+    0x09, 0xa5, 0x34, 0x73, 0x8e, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0x63,
+    0x2c, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0x5a, 0xeb, 0x8b, 0x00, 0x00,
+    0x4f, 0xad, 0x75, 0xff, 0xff, 0x4a, 0x69, 0x00, 0x00, 0x7b, 0xcf, 0xde,
+    0xdb, 0xb5, 0xb6, 0x00, 0x00, 0x6b, 0x6d, 0xde, 0xfb, 0xa5, 0x34, 0x42,
+    0x28, 0x63, 0x2c, 0xa5, 0x14, 0x00, 0x00, 0x00, 0x00, 0x94, 0x92, 0xd6,
+    0xba, 0x39, 0xe7, 0x8c, 0x71, 0x8c, 0x51, 0x00, 0x00, 0x00, 0x00, 0x84,
+    0x30, 0x7b, 0xef, 0x18, 0xe3, 0x94, 0xb2, 0x31, 0xa6, 0x84, 0x10, 0xde,
+    0xfb, 0xad, 0x55, 0xad, 0x55, 0x73, 0x8e, 0x00, 0x00, 0xff, 0xff, 0x94,
+    0xb2, 0x94, 0x92, 0xff, 0xff, 0x00, 0x00, 0xde, 0xfb, 0xe7, 0x1c, 0x00,
+    0x00, 0x00, 0x00, 0x7b, 0xef, 0x73, 0x8e, 0x00, 0x00, 0xa5, 0x34, 0x18,
+    0xe3, 0x63, 0x2c, 0xde, 0xdb, 0xb5, 0xb6, 0x00, 0x00, 0x94, 0xb2, 0xff,
+    0xff, 0x00, 0x00, 0xd6, 0x9a, 0xff, 0xff, 0xde, 0xdb, 0xff, 0xff, 0xef,
+    0x5d, 0xef, 0x7d, 0xff, 0xff, 0xad, 0x55, 0xbd, 0xf7, 0xf7, 0x9e, 0xff,
+    0xff, 0x94, 0xb2, 0xef, 0x5d, 0xf7, 0xbe, 0x9c, 0xf3, 0x94, 0xb2, 0x5a,
+    0xcb, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0x5a, 0xcb, 0x7b, 0xef, 0xde,
+    0xfb, 0xd6, 0x9a, 0xf7, 0xbe, 0x8e, 0xff, 0xff, 0x17, 0xe7, 0x3c, 0xb5,
+    0xb6, 0xad, 0x75, 0xff, 0xff, 0xce, 0x59, 0x84, 0x30, 0xa5, 0x14, 0x8c,
+    0x51, 0xb5, 0x96, 0xef, 0x5d, 0xff, 0xff, 0x94, 0xb2, 0xde, 0xdb, 0xff,
+    0xff, 0xff, 0xdf, 0xde, 0xdb, 0xf7, 0xbe, 0xf7, 0xbe, 0xd6, 0x9a, 0xad,
+    0x75, 0x8c, 0x71, 0xa5, 0x34, 0xde, 0xdb, 0xff, 0xdf, 0x86, 0xff, 0xff,
+    0x03, 0xe7, 0x1c, 0xad, 0x55, 0xa5, 0x34, 0xde, 0xfb, 0x9e, 0xff, 0xff,
+    0x0d, 0xf7, 0xbe, 0x9c, 0xf3, 0x9c, 0xf3, 0x6b, 0x4d, 0x00, 0x00, 0xff,
+    0xff, 0xd6, 0xba, 0x8c, 0x71, 0x8c, 0x71, 0x94, 0x92, 0x4a, 0x69, 0x00,
+    0x00, 0x00, 0x00, 0xf7, 0x9e, 0xae, 0xff, 0xff, 0xb3, 0xff, 0xff, 0x6e,
+    0xff, 0xdf, 0x84, 0x30, 0x94, 0xb2, 0xf7, 0xbe, 0x52, 0xaa, 0x00, 0x00,
+    0x29, 0x65, 0x00, 0x20, 0x31, 0xa6, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe,
+    0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xcb, 0x08, 0x61, 0x4a, 0x49,
+    0x4a, 0x49, 0x08, 0x61, 0x52, 0xaa, 0x39, 0xc7, 0x00, 0x00, 0x52, 0xaa,
+    0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xb5, 0x96,
+    0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xa5, 0x14, 0x00, 0x00, 0x52, 0xaa,
+    0x08, 0x61, 0x4a, 0x49, 0x42, 0x28, 0x00, 0x00, 0x52, 0x8a, 0x5a, 0xcb,
+    0x5a, 0xcb, 0x52, 0x8a, 0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xf7, 0x9e,
+    0x73, 0xae, 0x00, 0x00, 0x00, 0x00, 0x63, 0x2c, 0xf7, 0xbe, 0xb5, 0x96,
+    0x00, 0x00, 0x29, 0x65, 0xf7, 0xbe, 0x94, 0xb2, 0x94, 0x92, 0xff, 0xdf,
+    0x7b, 0xcf, 0x00, 0x00, 0x10, 0xa2, 0x31, 0xa6, 0x00, 0x00, 0xde, 0xdb,
+    0xde, 0xdb, 0x00, 0x00, 0x00, 0x00, 0xde, 0xdb, 0xd6, 0xba, 0x31, 0xa6,
+    0xf7, 0xbe, 0xb5, 0xb6, 0x00, 0x00, 0x31, 0xa6, 0xff, 0xdf, 0xff, 0xff,
+    0xce, 0x79, 0x63, 0x0c, 0xf7, 0x9e, 0x8c, 0x71, 0x9c, 0xd3, 0xff, 0xdf,
+    0x31, 0xa6, 0xde, 0xdb, 0xde, 0xfb, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x1c,
+    0xe7, 0x1c, 0x63, 0x0c, 0xf7, 0xbe, 0xb5, 0x96, 0x00, 0x00, 0x63, 0x2c,
+    0xf7, 0xbe, 0xa5, 0x14, 0xa5, 0x34, 0xff, 0xdf, 0x63, 0x2c, 0xde, 0xfb,
+    0xde, 0xdb, 0x42, 0x28, 0xef, 0x7d, 0x94, 0xb2, 0x8c, 0x71, 0xff, 0xff,
+    0xff, 0xff, 0x9c, 0xd3, 0x94, 0x92, 0x85, 0xff, 0xff, 0x08, 0xa5, 0x34,
+    0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x29, 0x65,
+    0x00, 0x00, 0xc6, 0x38, 0x8a, 0xff, 0xff, 0x05, 0xf7, 0xbe, 0xf7, 0xbe,
+    0xff, 0xff, 0xff, 0xdf, 0x8c, 0x51, 0x9c, 0xd3, 0x85, 0xff, 0xff, 0x01,
+    0x9c, 0xd3, 0x94, 0x92, 0x83, 0xff, 0xff, 0x15, 0xf7, 0xbe, 0x4a, 0x49,
+    0xde, 0xdb, 0xde, 0xdb, 0x4a, 0x49, 0xef, 0x7d, 0xff, 0xff, 0xd6, 0x9a,
+    0x00, 0x00, 0xf7, 0x9e, 0xff, 0xdf, 0xf7, 0xbe, 0xff, 0xff, 0xf7, 0xbe,
+    0xff, 0xff, 0xff, 0xff, 0xef, 0x5d, 0x42, 0x28, 0xde, 0xdb, 0xd6, 0x9a,
+    0x00, 0x00, 0xe7, 0x3c, 0xa0, 0xff, 0xff, 0x02, 0xde, 0xdb, 0x5a, 0xeb,
+    0xef, 0x5d, 0x83, 0xff, 0xff, 0x03, 0xb5, 0x96, 0x00, 0x00, 0x73, 0xae,
+    0xf7, 0xbe, 0xae, 0xff, 0xff, 0xb2, 0xff, 0xff, 0x6f, 0xf7, 0xbe, 0x63,
+    0x2c, 0x00, 0x00, 0x31, 0xa6, 0x52, 0x8a, 0x00, 0x00, 0xd6, 0xba, 0xd6,
+    0xba, 0x31, 0xa6, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x52, 0xaa, 0x00,
+    0x00, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x31, 0xa6, 0xd6, 0xba, 0xd6,
+    0xba, 0x31, 0xa6, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x00, 0x00, 0x52,
+    0xaa, 0x00, 0x00, 0x00, 0x00, 0x18, 0xc3, 0x39, 0xc7, 0xde, 0xdb, 0xd6,
+    0x9a, 0x00, 0x00, 0x31, 0x86, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x39,
+    0xc7, 0xce, 0x79, 0xce, 0x59, 0x00, 0x00, 0xef, 0x5d, 0xff, 0xdf, 0xff,
+    0xdf, 0xef, 0x5d, 0x00, 0x00, 0xce, 0x59, 0xd6, 0xba, 0x63, 0x2c, 0xff,
+    0xdf, 0x8c, 0x51, 0x8c, 0x51, 0xf7, 0xbe, 0x4a, 0x69, 0xde, 0xdb, 0xd6,
+    0xba, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xcf, 0xff,
+    0xdf, 0x94, 0xb2, 0x94, 0xb2, 0xf7, 0xbe, 0x31, 0x86, 0x21, 0x04, 0x42,
+    0x08, 0x00, 0x00, 0x00, 0x00, 0x31, 0x86, 0x29, 0x45, 0x08, 0x61, 0x31,
+    0xa6, 0xde, 0xfb, 0xd6, 0x9a, 0x31, 0xa6, 0xff, 0xdf, 0xad, 0x55, 0x9c,
+    0xf3, 0xf7, 0x9e, 0x73, 0xae, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0x00,
+    0x00, 0xde, 0xdb, 0xe7, 0x1c, 0x00, 0x00, 0x00, 0x00, 0xd6, 0x9a, 0xff,
+    0xff, 0xf7, 0x9e, 0x4a, 0x69, 0xc6, 0x38, 0xff, 0xff, 0xf7, 0x9e, 0x4a,
+    0x69, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xbe, 0xff, 0xff, 0xff,
+    0xff, 0xef, 0x5d, 0x4a, 0x49, 0xd6, 0x9a, 0xce, 0x79, 0x52, 0x8a, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xdf, 0x82, 0xff, 0xff, 0x0c, 0xd6, 0xba, 0x4a,
+    0x69, 0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0x00,
+    0x00, 0x94, 0xb2, 0xef, 0x7d, 0x29, 0x45, 0x00, 0x00, 0xad, 0x75, 0x89,
+    0xff, 0xff, 0x04, 0x94, 0xb2, 0x9c, 0xf3, 0xff, 0xdf, 0x52, 0x8a, 0xc6,
+    0x38, 0x86, 0xff, 0xff, 0x01, 0xf7, 0xbe, 0xff, 0xdf, 0x84, 0xff, 0xff,
+    0x11, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xef, 0x7d, 0x4a, 0x49, 0xe7,
+    0x1c, 0xde, 0xdb, 0x00, 0x00, 0xff, 0xdf, 0x9c, 0xf3, 0x9c, 0xf3, 0xff,
+    0xdf, 0x63, 0x2c, 0xde, 0xfb, 0xde, 0xdb, 0x42, 0x28, 0xef, 0x7d, 0xad,
+    0x75, 0x82, 0x00, 0x00, 0x00, 0xd6, 0xba, 0xa0, 0xff, 0xff, 0x02, 0xef,
+    0x5d, 0x63, 0x0c, 0xd6, 0x9a, 0x82, 0xff, 0xff, 0x02, 0xff, 0xdf, 0xf7,
+    0x9e, 0xf7, 0xbe, 0xaf, 0xff, 0xff, 0xb2, 0xff, 0xff, 0x28, 0xff, 0xdf,
+    0xd6, 0xba, 0x7b, 0xef, 0x00, 0x00, 0x31, 0x86, 0xd6, 0xba, 0xce, 0x59,
+    0x73, 0xae, 0x00, 0x00, 0xa5, 0x34, 0x5a, 0xcb, 0x00, 0x00, 0x31, 0xa6,
+    0xde, 0xdb, 0x8c, 0x71, 0x42, 0x28, 0x94, 0xb2, 0x10, 0xa2, 0x94, 0x92,
+    0x84, 0x30, 0x00, 0x00, 0xa5, 0x34, 0x31, 0xa6, 0x7b, 0xcf, 0xde, 0xdb,
+    0x00, 0x00, 0xbd, 0xd7, 0xbd, 0xf7, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x1c,
+    0xde, 0xdb, 0x00, 0x00, 0xd6, 0x9a, 0x8c, 0x51, 0x4a, 0x49, 0x94, 0xb2,
+    0x00, 0x00, 0xde, 0xdb, 0xff, 0xdf, 0xd6, 0xba, 0x83, 0xff, 0xff, 0x52,
+    0xd6, 0xba, 0xff, 0xff, 0xd6, 0x9a, 0x00, 0x00, 0x9c, 0xd3, 0xce, 0x59,
+    0xc6, 0x38, 0xad, 0x55, 0xd6, 0xba, 0xad, 0x75, 0xb5, 0xb6, 0xd6, 0xba,
+    0x00, 0x00, 0xbd, 0xd7, 0xb5, 0xb6, 0x00, 0x00, 0xa5, 0x14, 0x4a, 0x49,
+    0x31, 0xa6, 0xb5, 0xb6, 0xe7, 0x1c, 0x73, 0xae, 0x7b, 0xcf, 0xde, 0xdb,
+    0x31, 0x86, 0xbd, 0xd7, 0xb5, 0xb6, 0x00, 0x00, 0x00, 0x00, 0x84, 0x10,
+    0x7b, 0xcf, 0x52, 0xaa, 0xff, 0xff, 0x8c, 0x51, 0x8c, 0x71, 0xff, 0xff,
+    0x4a, 0x69, 0x00, 0x00, 0x42, 0x28, 0xad, 0x55, 0xd6, 0x9a, 0xb5, 0x96,
+    0xb5, 0xb6, 0xce, 0x59, 0x08, 0x41, 0xd6, 0xba, 0xef, 0x5d, 0x94, 0xb2,
+    0xd6, 0x9a, 0xff, 0xff, 0xe7, 0x3c, 0x94, 0xb2, 0xd6, 0x9a, 0xff, 0xff,
+    0xe7, 0x1c, 0x94, 0xb2, 0xff, 0xff, 0xc6, 0x18, 0xbd, 0xf7, 0xff, 0xff,
+    0xd6, 0x9a, 0xff, 0xdf, 0xff, 0xff, 0xc6, 0x18, 0x8c, 0x51, 0xef, 0x5d,
+    0xe7, 0x3c, 0x94, 0xb2, 0xff, 0xff, 0xc6, 0x18, 0x9c, 0xf3, 0xce, 0x79,
+    0xad, 0x55, 0x00, 0x00, 0x7b, 0xcf, 0xde, 0xdb, 0x00, 0x00, 0x9c, 0xf3,
+    0xef, 0x7d, 0xff, 0xff, 0xde, 0xfb, 0x5a, 0xcb, 0x8c, 0x71, 0x89, 0xff,
+    0xff, 0x04, 0xde, 0xfb, 0xde, 0xfb, 0xff, 0xff, 0xce, 0x79, 0xf7, 0xbe,
+    0x87, 0xff, 0xff, 0x03, 0xe7, 0x1c, 0x84, 0x10, 0x84, 0x10, 0xe7, 0x1c,
+    0x82, 0xff, 0xff, 0x14, 0xc6, 0x18, 0x84, 0x30, 0xad, 0x75, 0xde, 0xdb,
+    0xad, 0x55, 0xa5, 0x34, 0xe7, 0x3c, 0xff, 0xff, 0xe7, 0x3c, 0xef, 0x5d,
+    0xf7, 0xbe, 0x00, 0x00, 0xd6, 0x9a, 0xff, 0xff, 0xde, 0xdb, 0xff, 0xff,
+    0x94, 0xb2, 0x63, 0x0c, 0xd6, 0xba, 0xce, 0x59, 0xef, 0x7d, 0xa0, 0xff,
+    0xff, 0x02, 0xf7, 0xbe, 0x00, 0x00, 0xc6, 0x38, 0xb5, 0xff, 0xff, 0xb4,
+    0xff, 0xff, 0x24, 0xad, 0x55, 0x00, 0x00, 0x31, 0xa6, 0xde, 0xdb, 0x73,
+    0x8e, 0x18, 0xc3, 0xa5, 0x34, 0x00, 0x00, 0x84, 0x30, 0x8c, 0x71, 0x39,
+    0xe7, 0xd6, 0xba, 0x8c, 0x51, 0x4a, 0x49, 0x94, 0xb2, 0x00, 0x00, 0x00,
+    0x00, 0x5a, 0xcb, 0xa5, 0x34, 0x00, 0x00, 0x73, 0xae, 0xce, 0x59, 0xd6,
+    0xba, 0x00, 0x00, 0xad, 0x75, 0xd6, 0x9a, 0x94, 0xb2, 0x00, 0x00, 0xde,
+    0xfb, 0xf7, 0x9e, 0x9c, 0xf3, 0xde, 0xdb, 0x84, 0x30, 0x4a, 0x49, 0x94,
+    0xb2, 0x00, 0x00, 0xd6, 0xba, 0x87, 0xff, 0xff, 0x4b, 0xe7, 0x3c, 0x94,
+    0xb2, 0x00, 0x00, 0xe7, 0x1c, 0xde, 0xfb, 0x00, 0x00, 0xd6, 0x9a, 0xb5,
+    0x96, 0xb5, 0xb6, 0xd6, 0xba, 0x00, 0x00, 0xb5, 0xb6, 0xde, 0xdb, 0x9c,
+    0xd3, 0x00, 0x00, 0x8c, 0x51, 0x84, 0x10, 0x00, 0x00, 0xde, 0xdb, 0x7b,
+    0xef, 0x7b, 0xcf, 0xde, 0xdb, 0x00, 0x00, 0xb5, 0xb6, 0xde, 0xdb, 0x9c,
+    0xd3, 0x00, 0x00, 0x7b, 0xcf, 0x7b, 0xef, 0x39, 0xc7, 0xc6, 0x38, 0xb5,
+    0xb6, 0xb5, 0xb6, 0xc6, 0x38, 0x00, 0x00, 0x8c, 0x51, 0x7b, 0xef, 0x18,
+    0xc3, 0xff, 0xff, 0x8c, 0x71, 0x8c, 0x71, 0xff, 0xff, 0x18, 0xe3, 0xd6,
+    0xba, 0xef, 0x7d, 0x8c, 0x71, 0xd6, 0xba, 0xff, 0xff, 0xe7, 0x3c, 0x94,
+    0xb2, 0xd6, 0x9a, 0xff, 0xff, 0xe7, 0x3c, 0x94, 0xb2, 0xce, 0x59, 0xa5,
+    0x34, 0xa5, 0x14, 0xde, 0xfb, 0xff, 0xff, 0xe7, 0x1c, 0xe7, 0x3c, 0xff,
+    0xff, 0x9c, 0xf3, 0xe7, 0x3c, 0xe7, 0x3c, 0x9c, 0xf3, 0xff, 0xff, 0xbd,
+    0xf7, 0xc6, 0x38, 0xff, 0xff, 0x00, 0x00, 0x63, 0x2c, 0xce, 0x59, 0xd6,
+    0xba, 0x10, 0x82, 0xd6, 0xba, 0x82, 0xff, 0xff, 0x01, 0x8c, 0x71, 0x84,
+    0x30, 0x8d, 0xff, 0xff, 0x01, 0xe7, 0x1c, 0xde, 0xfb, 0x86, 0xff, 0xff,
+    0x03, 0xe7, 0x3c, 0x8c, 0x71, 0x84, 0x10, 0xe7, 0x1c, 0x82, 0xff, 0xff,
+    0x11, 0xc6, 0x38, 0x42, 0x08, 0x00, 0x00, 0xd6, 0x9a, 0xb5, 0x96, 0xad,
+    0x55, 0xe7, 0x1c, 0xff, 0xff, 0xe7, 0x3c, 0xef, 0x5d, 0xff, 0xff, 0xad,
+    0x55, 0xbd, 0xf7, 0xd6, 0xba, 0xde, 0xfb, 0xff, 0xff, 0x8c, 0x71, 0x8c,
+    0x71, 0xa3, 0xff, 0xff, 0x02, 0xff, 0xdf, 0xa5, 0x34, 0xe7, 0x1c, 0xb5,
+    0xff, 0xff, 0xb3, 0xff, 0xff, 0x25, 0xff, 0xdf, 0x94, 0xb2, 0x00, 0x00,
+    0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0xb5, 0xb6, 0xf7, 0xbe, 0x31, 0xa6,
+    0xd6, 0xba, 0xde, 0xdb, 0x00, 0x00, 0x31, 0xa6, 0x00, 0x00, 0xa5, 0x34,
+    0xff, 0xdf, 0x7b, 0xcf, 0x00, 0x00, 0xa5, 0x14, 0xf7, 0xbe, 0x31, 0xa6,
+    0xd6, 0xba, 0xd6, 0xba, 0x00, 0x00, 0x4a, 0x69, 0x00, 0x00, 0xb5, 0x96,
+    0xff, 0xff, 0x39, 0xe7, 0xc6, 0x18, 0xff, 0xff, 0xff, 0xff, 0x63, 0x2c,
+    0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x31, 0xa6, 0xc6, 0x18, 0x88, 0xff,
+    0xff, 0x4a, 0xef, 0x7d, 0x31, 0x86, 0xde, 0xdb, 0xde, 0xfb, 0x00, 0x00,
+    0x00, 0x00, 0xde, 0xfb, 0xd6, 0xba, 0x00, 0x00, 0x52, 0x8a, 0x00, 0x00,
+    0x9c, 0xd3, 0xf7, 0xbe, 0x31, 0xa6, 0xd6, 0xba, 0xe7, 0x1c, 0x31, 0x86,
+    0x00, 0x00, 0x39, 0xe7, 0x39, 0xe7, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00,
+    0x9c, 0xd3, 0xff, 0xdf, 0x63, 0x2c, 0xde, 0xdb, 0xde, 0xdb, 0x00, 0x00,
+    0x00, 0x00, 0xde, 0xdb, 0xde, 0xdb, 0x00, 0x00, 0x31, 0xa6, 0xde, 0xfb,
+    0xd6, 0xba, 0x31, 0x86, 0xef, 0x7d, 0xa5, 0x14, 0x9c, 0xf3, 0xf7, 0x9e,
+    0x63, 0x2c, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xdf, 0x00, 0x00, 0xbd, 0xf7,
+    0xff, 0xff, 0xf7, 0x9e, 0x4a, 0x69, 0xc6, 0x38, 0xff, 0xff, 0xf7, 0x9e,
+    0x4a, 0x49, 0xe7, 0x1c, 0xde, 0xdb, 0x00, 0x00, 0xef, 0x7d, 0x94, 0xb2,
+    0x8c, 0x71, 0xff, 0xdf, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf,
+    0xf7, 0x9e, 0xff, 0xff, 0xff, 0xff, 0xef, 0x5d, 0x63, 0x0c, 0xde, 0xdb,
+    0xd6, 0xba, 0x00, 0x00, 0x00, 0x00, 0xd6, 0x9a, 0x82, 0xff, 0xff, 0x01,
+    0x9c, 0xf3, 0x9c, 0xf3, 0x89, 0xff, 0xff, 0x06, 0xf7, 0xbe, 0xf7, 0xbe,
+    0xff, 0xff, 0xff, 0xff, 0x94, 0xb2, 0x8c, 0x51, 0xff, 0xdf, 0x84, 0xff,
+    0xff, 0x19, 0xf7, 0xbe, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf,
+    0xf7, 0xbe, 0xff, 0xff, 0xf7, 0xbe, 0xff, 0xff, 0xde, 0xdb, 0x00, 0x00,
+    0x00, 0x00, 0xde, 0xdb, 0xd6, 0xba, 0x4a, 0x49, 0xf7, 0x9e, 0x94, 0xb2,
+    0x8c, 0x71, 0xff, 0xff, 0xff, 0xff, 0x9c, 0xf3, 0x00, 0x00, 0x63, 0x2c,
+    0xf7, 0x9e, 0x9c, 0xf3, 0x9c, 0xf3, 0xdc, 0xff, 0xff, 0xb2, 0xff, 0xff,
+    0x27, 0xf7, 0xbe, 0x63, 0x2c, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x00,
+    0x00, 0xd6, 0x9a, 0xe7, 0x1c, 0x31, 0xa6, 0x08, 0x61, 0x29, 0x45, 0x00,
+    0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x7b, 0xcf, 0xff,
+    0xdf, 0x9c, 0xd3, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x39, 0xe7, 0x21,
+    0x04, 0x21, 0x24, 0xef, 0x5d, 0xf7, 0xbe, 0xff, 0xff, 0xf7, 0xbe, 0x31,
+    0x86, 0x00, 0x00, 0xb5, 0x96, 0xff, 0xff, 0xff, 0xff, 0x8c, 0x71, 0x00,
+    0x00, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0xb5, 0x96, 0x86, 0xff, 0xff,
+    0x23, 0xde, 0xdb, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x1c, 0xde, 0xfb, 0x31,
+    0x86, 0xf7, 0xbe, 0xad, 0x55, 0x00, 0x00, 0x52, 0x8a, 0xf7, 0x9e, 0xa5,
+    0x14, 0x00, 0x00, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0xb5, 0x96, 0xf7,
+    0xbe, 0x00, 0x00, 0xd6, 0x9a, 0xd6, 0xba, 0x31, 0xa6, 0xf7, 0xbe, 0x9c,
+    0xd3, 0x00, 0x00, 0x7b, 0xcf, 0xf7, 0xbe, 0xb5, 0x96, 0x00, 0x00, 0x31,
+    0x86, 0xf7, 0xbe, 0x9c, 0xd3, 0x94, 0x92, 0xff, 0xff, 0xff, 0xff, 0xa5,
+    0x34, 0x82, 0x00, 0x00, 0x20, 0xde, 0xfb, 0xd6, 0xba, 0x4a, 0x49, 0xef,
+    0x7d, 0x9c, 0xf3, 0xad, 0x75, 0xff, 0xff, 0x39, 0xc7, 0x00, 0x00, 0x31,
+    0x86, 0x7b, 0xcf, 0xf7, 0xbe, 0xb5, 0x96, 0x00, 0x00, 0x63, 0x0c, 0xf7,
+    0x9e, 0xff, 0xff, 0xde, 0xdb, 0x00, 0x00, 0x00, 0x00, 0xde, 0xdb, 0xde,
+    0xdb, 0x00, 0x00, 0x31, 0xa6, 0xe7, 0x1c, 0xe7, 0x1c, 0x31, 0xa6, 0x00,
+    0x00, 0xe7, 0x3c, 0xe7, 0x1c, 0x63, 0x0c, 0xf7, 0xbe, 0xb5, 0x96, 0x82,
+    0x00, 0x00, 0x00, 0xd6, 0x9a, 0x82, 0xff, 0xff, 0x01, 0xf7, 0xbe, 0xf7,
+    0xbe, 0x89, 0xff, 0xff, 0x01, 0x9c, 0xf3, 0x9c, 0xf3, 0x82, 0xff, 0xff,
+    0x02, 0xc6, 0x18, 0x52, 0x8a, 0xff, 0xdf, 0x83, 0xff, 0xff, 0x18, 0xad,
+    0x75, 0x00, 0x00, 0x63, 0x2c, 0xff, 0xdf, 0xa5, 0x34, 0xa5, 0x34, 0xff,
+    0xdf, 0x63, 0x2c, 0xde, 0xfb, 0xde, 0xdb, 0x31, 0xa6, 0xf7, 0xbe, 0x9c,
+    0xd3, 0x9c, 0xd3, 0xf7, 0xbe, 0x63, 0x2c, 0xd6, 0x9a, 0xd6, 0x9a, 0x63,
+    0x2c, 0xff, 0xff, 0x94, 0xb2, 0x94, 0x92, 0xf7, 0xbe, 0x4a, 0x69, 0xc6,
+    0x38, 0xdd, 0xff, 0xff, 0xb2, 0xff, 0xff, 0x18, 0xff, 0xdf, 0xd6, 0xba,
+    0x73, 0xae, 0x39, 0xc7, 0xa5, 0x34, 0xde, 0xdb, 0xc6, 0x38, 0x73, 0xae,
+    0x00, 0x00, 0x00, 0x00, 0xbd, 0xf7, 0xb5, 0xb6, 0x00, 0x00, 0xa5, 0x34,
+    0x5a, 0xcb, 0x00, 0x00, 0x08, 0x41, 0x9c, 0xf3, 0xde, 0xdb, 0xad, 0x75,
+    0x00, 0x00, 0xce, 0x79, 0x63, 0x0c, 0x4a, 0x69, 0xde, 0xfb, 0x82, 0xff,
+    0xff, 0x0d, 0xff, 0xdf, 0xde, 0xfb, 0x39, 0xe7, 0x7b, 0xef, 0xff, 0xff,
+    0xff, 0xff, 0xef, 0x7d, 0x94, 0xb2, 0x00, 0x00, 0xde, 0xdb, 0x73, 0xae,
+    0x00, 0x00, 0xa5, 0x14, 0xf7, 0xbe, 0x83, 0xff, 0xff, 0x4c, 0xc6, 0x18,
+    0xa5, 0x34, 0xd6, 0x9a, 0x00, 0x00, 0x7b, 0xef, 0x84, 0x10, 0x00, 0x00,
+    0x9c, 0xd3, 0xd6, 0xba, 0xad, 0x75, 0x4a, 0x49, 0xff, 0xff, 0x9c, 0xd3,
+    0x63, 0x0c, 0xd6, 0xba, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xcb, 0xb5, 0x96,
+    0xde, 0xfb, 0xc6, 0x38, 0x73, 0xae, 0x00, 0x00, 0x9c, 0xd3, 0xde, 0xdb,
+    0xb5, 0xb6, 0x00, 0x00, 0x94, 0xb2, 0x39, 0xc7, 0x7b, 0xcf, 0xd6, 0xba,
+    0x9c, 0xd3, 0xbd, 0xf7, 0xbd, 0xf7, 0x94, 0xb2, 0xa5, 0x14, 0xd6, 0x9a,
+    0xb5, 0x96, 0x21, 0x24, 0xc6, 0x38, 0xb5, 0xb6, 0xad, 0x75, 0xd6, 0xba,
+    0xff, 0xff, 0xa5, 0x14, 0x00, 0x00, 0x9c, 0xf3, 0xde, 0xdb, 0xe7, 0x3c,
+    0xad, 0x75, 0x00, 0x00, 0x94, 0xb2, 0x39, 0xc7, 0x7b, 0xef, 0xde, 0xdb,
+    0xad, 0x75, 0x9c, 0xd3, 0x6b, 0x4d, 0x42, 0x08, 0xd6, 0x9a, 0xb5, 0x96,
+    0xad, 0x75, 0xc6, 0x38, 0x00, 0x00, 0xe7, 0x1c, 0xde, 0xfb, 0x00, 0x00,
+    0xd6, 0x9a, 0xb5, 0xb6, 0x5a, 0xeb, 0x00, 0x00, 0x94, 0xb2, 0x31, 0xa6,
+    0x84, 0x30, 0xde, 0xdb, 0x00, 0x00, 0xce, 0x59, 0x8e, 0xff, 0xff, 0x01,
+    0x84, 0x10, 0x73, 0xae, 0x82, 0xff, 0xff, 0x03, 0xf7, 0xbe, 0xc6, 0x18,
+    0x8c, 0x51, 0xde, 0xfb, 0x82, 0xff, 0xff, 0x18, 0x84, 0x30, 0x42, 0x08,
+    0xe7, 0x1c, 0xff, 0xff, 0x8c, 0x51, 0x9c, 0xd3, 0xff, 0xff, 0x00, 0x00,
+    0xde, 0xdb, 0xe7, 0x1c, 0x00, 0x00, 0x9c, 0xd3, 0xc6, 0x38, 0xc6, 0x18,
+    0x8c, 0x51, 0x00, 0x00, 0xe7, 0x3c, 0xe7, 0x1c, 0x00, 0x20, 0xff, 0xff,
+    0x9c, 0xf3, 0x00, 0x00, 0xb5, 0x96, 0xc6, 0x38, 0xf7, 0x9e, 0xdd, 0xff,
+    0xff, 0xb4, 0xff, 0xff, 0x15, 0xa5, 0x14, 0x10, 0x82, 0xa5, 0x34, 0xde,
+    0xfb, 0x6b, 0x6d, 0x10, 0xa2, 0xa5, 0x34, 0x00, 0x00, 0xb5, 0xb6, 0xd6,
+    0xba, 0x9c, 0xd3, 0x00, 0x00, 0x84, 0x30, 0x94, 0x92, 0x00, 0x00, 0x00,
+    0x00, 0xb5, 0x96, 0xce, 0x79, 0xad, 0x55, 0xff, 0xff, 0xce, 0x59, 0xc6,
+    0x38, 0x85, 0xff, 0xff, 0x01, 0xc6, 0x38, 0xbd, 0xf7, 0x82, 0xff, 0xff,
+    0x57, 0xef, 0x5d, 0x9c, 0xf3, 0xd6, 0xba, 0xbd, 0xd7, 0x8c, 0x71, 0x9c,
+    0xf3, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xd6, 0xba, 0xa5,
+    0x14, 0xb5, 0x96, 0xde, 0xfb, 0xb5, 0xb6, 0x31, 0xa6, 0x4a, 0x49, 0xa5,
+    0x34, 0x00, 0x00, 0xb5, 0xb6, 0xbd, 0xd7, 0x00, 0x00, 0xce, 0x59, 0xbd,
+    0xd7, 0xbd, 0xd7, 0xd6, 0xba, 0xb5, 0x96, 0x5a, 0xcb, 0x00, 0x00, 0x00,
+    0x00, 0xd6, 0xba, 0x73, 0xae, 0x39, 0xc7, 0xa5, 0x34, 0x00, 0x00, 0xb5,
+    0xb6, 0xc6, 0x18, 0x00, 0x00, 0x94, 0xb2, 0x08, 0x41, 0xa5, 0x34, 0xff,
+    0xff, 0x9c, 0xf3, 0xef, 0x7d, 0xf7, 0x9e, 0x84, 0x10, 0x00, 0x00, 0xb5,
+    0xb6, 0xb5, 0xb6, 0x4a, 0x49, 0xff, 0xff, 0x94, 0x92, 0x8c, 0x71, 0xff,
+    0xff, 0xde, 0xfb, 0x6b, 0x6d, 0x18, 0xe3, 0xa5, 0x34, 0xde, 0xdb, 0xe7,
+    0x3c, 0xad, 0x75, 0x00, 0x00, 0x94, 0xb2, 0x4a, 0x49, 0x8c, 0x51, 0xd6,
+    0xba, 0x00, 0x00, 0x73, 0x8e, 0x7b, 0xef, 0x39, 0xe7, 0xd6, 0x9a, 0xad,
+    0x55, 0xce, 0x59, 0xff, 0xff, 0x4a, 0x49, 0xa5, 0x14, 0xc6, 0x38, 0xad,
+    0x75, 0xde, 0xfb, 0xb5, 0xb6, 0x63, 0x2c, 0x21, 0x04, 0x94, 0xb2, 0x31,
+    0xa6, 0x84, 0x10, 0xde, 0xfb, 0xa5, 0x14, 0xe7, 0x1c, 0x8c, 0xff, 0xff,
+    0x03, 0xff, 0xdf, 0xd6, 0xba, 0xa5, 0x34, 0xce, 0x59, 0x84, 0xff, 0xff,
+    0x1b, 0x94, 0xb2, 0xde, 0xdb, 0xff, 0xff, 0xff, 0xdf, 0xd6, 0xba, 0xad,
+    0x55, 0xb5, 0x96, 0xe7, 0x1c, 0xff, 0xff, 0x94, 0xb2, 0x63, 0x0c, 0xd6,
+    0xba, 0xad, 0x55, 0xc6, 0x38, 0xce, 0x59, 0x94, 0x92, 0x00, 0x00, 0xe7,
+    0x1c, 0xf7, 0xbe, 0x7b, 0xcf, 0x00, 0x00, 0xb5, 0x96, 0xb5, 0x96, 0x00,
+    0x00, 0xce, 0x59, 0xbd, 0xf7, 0x63, 0x2c, 0x08, 0x61, 0xdf, 0xff, 0xff,
+    0xb4, 0xff, 0xff, 0x11, 0x8c, 0x71, 0x94, 0xb2, 0xf7, 0xbe, 0x29, 0x65,
+    0x00, 0x00, 0xb5, 0x96, 0xf7, 0xbe, 0x52, 0xaa, 0x00, 0x00, 0xad, 0x55,
+    0xf7, 0xbe, 0x31, 0xa6, 0xd6, 0x9a, 0xde, 0xfb, 0x31, 0xa6, 0x00, 0x00,
+    0x00, 0x00, 0xad, 0x55, 0x8f, 0xff, 0xff, 0x02, 0xff, 0xdf, 0x4a, 0x69,
+    0xd6, 0xba, 0x84, 0xff, 0xff, 0x52, 0xf7, 0xbe, 0x4a, 0x69, 0xd6, 0xba,
+    0xd6, 0x9a, 0x00, 0x00, 0xf7, 0xbe, 0x94, 0xb2, 0x94, 0x92, 0xff, 0xdf,
+    0x7b, 0xcf, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0xd6, 0xba,
+    0xde, 0xdb, 0x4a, 0x69, 0xf7, 0xbe, 0xb5, 0x96, 0x00, 0x00, 0x00, 0x00,
+    0x31, 0xa6, 0x00, 0x00, 0xa5, 0x14, 0xff, 0xdf, 0x7b, 0xcf, 0x00, 0x00,
+    0x00, 0x00, 0x5a, 0xcb, 0xf7, 0xbe, 0xa5, 0x34, 0x94, 0xb2, 0xff, 0xdf,
+    0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xf7, 0x9e, 0x52, 0x8a, 0x00, 0x00,
+    0x00, 0x00, 0x52, 0x8a, 0xf7, 0x9e, 0x94, 0x92, 0x94, 0x92, 0xef, 0x7d,
+    0x29, 0x65, 0x00, 0x00, 0xb5, 0xb6, 0xf7, 0xbe, 0x31, 0xa6, 0x00, 0x00,
+    0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x31, 0xa6,
+    0x00, 0x00, 0xde, 0xdb, 0xde, 0xdb, 0x00, 0x00, 0x00, 0x00, 0xd6, 0x9a,
+    0xff, 0xff, 0xf7, 0xbe, 0x52, 0xaa, 0x00, 0x00, 0xad, 0x55, 0xf7, 0xbe,
+    0x00, 0x00, 0xde, 0xfb, 0xde, 0xfb, 0x31, 0x86, 0xf7, 0xbe, 0xb5, 0xb6,
+    0x00, 0x00, 0x31, 0xa6, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xdf, 0xf7, 0x9e,
+    0xf7, 0x9e, 0xff, 0xdf, 0x88, 0xff, 0xff, 0x07, 0xf7, 0xbe, 0x4a, 0x49,
+    0xd6, 0xba, 0xff, 0xff, 0xf7, 0xbe, 0xff, 0xff, 0xf7, 0xbe, 0xf7, 0xbe,
+    0x83, 0xff, 0xff, 0x19, 0xf7, 0xbe, 0x4a, 0x49, 0xe7, 0x1c, 0xe7, 0x1c,
+    0x42, 0x28, 0xef, 0x7d, 0xad, 0x75, 0x00, 0x00, 0x29, 0x65, 0xf7, 0xbe,
+    0x8c, 0x51, 0x94, 0x92, 0xff, 0xff, 0x42, 0x08, 0xc6, 0x18, 0xff, 0xff,
+    0xff, 0xff, 0x7b, 0xef, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00,
+    0xe7, 0x1c, 0xde, 0xfb, 0x29, 0x65, 0xf7, 0x9e, 0xde, 0xff, 0xff, 0xb4,
+    0xff, 0xff, 0x09, 0xa5, 0x34, 0x00, 0x00, 0x29, 0x65, 0x00, 0x00, 0xd6,
+    0xba, 0xde, 0xfb, 0x00, 0x00, 0x00, 0x00, 0xde, 0xdb, 0xde, 0xfb, 0x82,
+    0x00, 0x00, 0x03, 0xad, 0x55, 0xf7, 0xbe, 0x00, 0x00, 0xbd, 0xf7, 0x91,
+    0xff, 0xff, 0x01, 0xf7, 0xbe, 0xff, 0xdf, 0x85, 0xff, 0xff, 0x51, 0xff,
+    0xdf, 0xad, 0x55, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x00,
+    0x00, 0x7b, 0xcf, 0xff, 0xdf, 0x94, 0x92, 0x94, 0xb2, 0xf7, 0xbe, 0x29,
+    0x65, 0x00, 0x00, 0xb5, 0x96, 0xf7, 0xbe, 0x4a, 0x69, 0xd6, 0xba, 0xd6,
+    0xba, 0x31, 0xa6, 0xf7, 0xbe, 0x9c, 0xd3, 0x00, 0x00, 0x7b, 0xcf, 0xff,
+    0xdf, 0x9c, 0xd3, 0x00, 0x00, 0x18, 0xc3, 0x31, 0xa6, 0xde, 0xfb, 0xde,
+    0xdb, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x3c, 0xef, 0x5d, 0x29, 0x45, 0x00,
+    0x00, 0xd6, 0xba, 0xde, 0xdb, 0x00, 0x00, 0x31, 0x86, 0x18, 0xc3, 0x18,
+    0xc3, 0x31, 0x86, 0x00, 0x00, 0xde, 0xdb, 0xde, 0xfb, 0x31, 0xa6, 0x00,
+    0x00, 0xde, 0xdb, 0xde, 0xdb, 0x00, 0x00, 0x31, 0x86, 0x00, 0x00, 0xa5,
+    0x34, 0xf7, 0xbe, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x52, 0x8a, 0xef,
+    0x7d, 0x9c, 0xf3, 0xad, 0x55, 0xff, 0xdf, 0x39, 0xe7, 0xce, 0x79, 0xde,
+    0xdb, 0x31, 0xa6, 0x00, 0x00, 0xe7, 0x1c, 0xe7, 0x1c, 0x00, 0x00, 0x31,
+    0xa6, 0xe7, 0x1c, 0xd6, 0x9a, 0x00, 0x00, 0xf7, 0x9e, 0xff, 0xff, 0xde,
+    0xdb, 0x00, 0x00, 0x31, 0x86, 0xd6, 0xba, 0x89, 0xff, 0xff, 0x06, 0xf7,
+    0xbe, 0xff, 0xff, 0xd6, 0x9a, 0x4a, 0x69, 0xff, 0xff, 0xa5, 0x14, 0x94,
+    0x92, 0x84, 0xff, 0xff, 0x18, 0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xef,
+    0x7d, 0x4a, 0x49, 0xde, 0xdb, 0xd6, 0xba, 0x00, 0x00, 0x52, 0xaa, 0x00,
+    0x00, 0xa5, 0x14, 0xff, 0xff, 0x5a, 0xcb, 0x00, 0x00, 0xad, 0x55, 0xff,
+    0xff, 0xff, 0xff, 0x7b, 0xef, 0x8c, 0x51, 0xf7, 0xbe, 0x00, 0x00, 0xde,
+    0xfb, 0xde, 0xfb, 0x00, 0x00, 0xf7, 0x9e, 0xde, 0xff, 0xff, 0xb2, 0xff,
+    0xff, 0x12, 0xf7, 0xbe, 0xa5, 0x14, 0x00, 0x00, 0x63, 0x2c, 0xd6, 0x9a,
+    0xd6, 0xba, 0xad, 0x55, 0xb5, 0x96, 0xd6, 0x9a, 0x00, 0x00, 0x73, 0xae,
+    0xc6, 0x18, 0xc6, 0x38, 0x29, 0x45, 0xad, 0x55, 0xc6, 0x18, 0x9c, 0xd3,
+    0xce, 0x59, 0xf7, 0xbe, 0x9a, 0xff, 0xff, 0x50, 0x94, 0x92, 0x73, 0xae,
+    0xde, 0xdb, 0x00, 0x00, 0xbd, 0xd7, 0xb5, 0xb6, 0x00, 0x00, 0xa5, 0x14,
+    0x63, 0x2c, 0x52, 0xaa, 0xb5, 0x96, 0xe7, 0x1c, 0x6b, 0x6d, 0x00, 0x00,
+    0xb5, 0x96, 0xce, 0x79, 0xbd, 0xf7, 0x7b, 0xcf, 0x00, 0x00, 0x9c, 0xd3,
+    0xde, 0xdb, 0xb5, 0xb6, 0x00, 0x00, 0x9c, 0xd3, 0xde, 0xdb, 0xb5, 0xb6,
+    0x00, 0x00, 0x00, 0x00, 0x6b, 0x6d, 0xb5, 0xb6, 0xde, 0xdb, 0xd6, 0x9a,
+    0xb5, 0xb6, 0x73, 0x8e, 0x18, 0xe3, 0xd6, 0xba, 0xc6, 0x38, 0x7b, 0xcf,
+    0x39, 0xc7, 0xd6, 0xba, 0x7b, 0xef, 0x84, 0x10, 0xd6, 0xba, 0x39, 0xe7,
+    0x7b, 0xef, 0x84, 0x10, 0x00, 0x00, 0x00, 0x00, 0x8c, 0x51, 0x8c, 0x71,
+    0x39, 0xc7, 0xd6, 0xba, 0x84, 0x30, 0x5a, 0xcb, 0xa5, 0x34, 0x00, 0x00,
+    0xbd, 0xd7, 0xb5, 0xb6, 0x4a, 0x49, 0xff, 0xff, 0x8c, 0x71, 0x8c, 0x51,
+    0xff, 0xff, 0x39, 0xc7, 0xe7, 0x3c, 0xe7, 0x1c, 0x00, 0x00, 0x00, 0x00,
+    0x7b, 0xef, 0x7b, 0xef, 0x00, 0x00, 0x00, 0x00, 0x63, 0x2c, 0xb5, 0x96,
+    0xde, 0xdb, 0xff, 0xff, 0xbd, 0xf7, 0xa5, 0x34, 0xd6, 0x9a, 0x00, 0x00,
+    0xd6, 0xba, 0x8b, 0xff, 0xff, 0x04, 0xf7, 0xbe, 0xc6, 0x18, 0x94, 0x92,
+    0xbd, 0xf7, 0xef, 0x5d, 0x83, 0xff, 0xff, 0x19, 0xf7, 0xbe, 0x9c, 0xf3,
+    0xe7, 0x3c, 0xef, 0x5d, 0xa5, 0x34, 0xd6, 0xba, 0xbd, 0xd7, 0xbd, 0xd7,
+    0xce, 0x59, 0x00, 0x00, 0xad, 0x75, 0xd6, 0xba, 0x94, 0x92, 0x00, 0x00,
+    0xad, 0x75, 0xd6, 0x9a, 0x9c, 0xf3, 0xa5, 0x14, 0xd6, 0x9a, 0xce, 0x59,
+    0x9c, 0xd3, 0xde, 0xdb, 0xbd, 0xd7, 0xad, 0x75, 0xde, 0xdb, 0xff, 0xdf,
+    0xde, 0xff, 0xff, 0xb2, 0xff, 0xff, 0x10, 0xf7, 0xbe, 0x9c, 0xf3, 0x84,
+    0x30, 0xce, 0x79, 0xff, 0xff, 0xff, 0xff, 0xc6, 0x18, 0xad, 0x75, 0xde,
+    0xfb, 0xad, 0x75, 0x00, 0x00, 0xa5, 0x14, 0xff, 0xff, 0x18, 0xc3, 0xde,
+    0xdb, 0xef, 0x7d, 0x94, 0xb2, 0x9c, 0xff, 0xff, 0x06, 0x94, 0xb2, 0x7b,
+    0xcf, 0xd6, 0xba, 0x29, 0x65, 0xb5, 0xb6, 0xde, 0xdb, 0x9c, 0xd3, 0x83,
+    0x00, 0x00, 0x29, 0xd6, 0xba, 0xce, 0x59, 0x6b, 0x6d, 0x18, 0xc3, 0xff,
+    0xff, 0x9c, 0xd3, 0x00, 0x00, 0xa5, 0x34, 0x00, 0x00, 0xb5, 0xb6, 0xc6,
+    0x18, 0x00, 0x00, 0x00, 0x00, 0xb5, 0xb6, 0xde, 0xdb, 0x9c, 0xf3, 0x21,
+    0x24, 0x6b, 0x6d, 0xb5, 0x96, 0xe7, 0x1c, 0xff, 0xff, 0x9c, 0xd3, 0x00,
+    0x00, 0x4a, 0x69, 0xd6, 0xba, 0x84, 0x10, 0x00, 0x00, 0x39, 0xc7, 0xde,
+    0xdb, 0x84, 0x30, 0x7b, 0xef, 0xd6, 0xba, 0x39, 0xe7, 0x7b, 0xcf, 0x7b,
+    0xef, 0x21, 0x24, 0xa5, 0x34, 0x5a, 0xcb, 0x00, 0x00, 0x39, 0xc7, 0xde,
+    0xdb, 0x8c, 0x71, 0x82, 0x00, 0x00, 0x19, 0xbd, 0xf7, 0xbd, 0xd7, 0x00,
+    0x00, 0xce, 0x59, 0xbd, 0xd7, 0xbd, 0xd7, 0xce, 0x59, 0x00, 0x00, 0xad,
+    0x55, 0xd6, 0x9a, 0x9c, 0xf3, 0x21, 0x24, 0x84, 0x10, 0x7b, 0xcf, 0x00,
+    0x00, 0xa5, 0x14, 0x8c, 0x71, 0xc6, 0x38, 0xff, 0xff, 0xff, 0xff, 0xbd,
+    0xd7, 0xad, 0x55, 0xd6, 0xba, 0x00, 0x00, 0x9c, 0xf3, 0xef, 0x7d, 0x89,
+    0xff, 0xff, 0x21, 0xde, 0xdb, 0xe7, 0x3c, 0xff, 0xff, 0x9c, 0xd3, 0xbd,
+    0xf7, 0xf7, 0x9e, 0xff, 0xff, 0xce, 0x79, 0xf7, 0x9e, 0xff, 0xff, 0xf7,
+    0xbe, 0x94, 0xb2, 0xef, 0x5d, 0xd6, 0xba, 0x00, 0x00, 0xd6, 0x9a, 0x63,
+    0x2c, 0x94, 0xb2, 0xff, 0xff, 0xad, 0x55, 0xce, 0x79, 0xad, 0x75, 0x00,
+    0x00, 0x9c, 0xd3, 0xd6, 0xba, 0xb5, 0x96, 0x00, 0x00, 0x00, 0x00, 0xb5,
+    0xb6, 0xd6, 0x9a, 0x9c, 0xd3, 0xde, 0xfb, 0x5a, 0xcb, 0x84, 0x30, 0xe0,
+    0xff, 0xff, 0xb9, 0xff, 0xff, 0x07, 0xc6, 0x38, 0x00, 0x00, 0xff, 0xff,
+    0x9c, 0xf3, 0x8c, 0x71, 0xf7, 0x9e, 0x63, 0x0c, 0xd6, 0x9a, 0x9e, 0xff,
+    0xff, 0x47, 0xa5, 0x14, 0x00, 0x00, 0x31, 0xa6, 0x10, 0xa2, 0x00, 0x00,
+    0x9c, 0xf3, 0xf7, 0xbe, 0x52, 0xaa, 0x31, 0xa6, 0x4a, 0x69, 0x00, 0x00,
+    0x00, 0x00, 0xd6, 0xba, 0xd6, 0xba, 0x31, 0x86, 0xef, 0x7d, 0x9c, 0xf3,
+    0xa5, 0x34, 0xf7, 0xbe, 0x7b, 0xcf, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xcb,
+    0x18, 0xc3, 0x00, 0x00, 0x9c, 0xf3, 0xf7, 0xbe, 0x31, 0xa6, 0xd6, 0xba,
+    0xd6, 0xba, 0x4a, 0x49, 0xef, 0x7d, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00,
+    0x31, 0xa6, 0x10, 0xa2, 0x31, 0xa6, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00,
+    0x21, 0x24, 0x31, 0xa6, 0x00, 0x00, 0xde, 0xdb, 0xd6, 0xba, 0x31, 0xa6,
+    0xf7, 0xbe, 0xa5, 0x14, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x39, 0xe7,
+    0x4a, 0x69, 0x08, 0x61, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa,
+    0x00, 0x00, 0xd6, 0xba, 0xd6, 0xba, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00,
+    0x9c, 0xd3, 0xf7, 0xbe, 0x31, 0xa6, 0xd6, 0xba, 0xde, 0xdb, 0x63, 0x2c,
+    0xf7, 0x9e, 0x84, 0xff, 0xff, 0x04, 0xd6, 0xba, 0x00, 0x00, 0x52, 0xaa,
+    0x00, 0x00, 0x8c, 0x71, 0x82, 0xff, 0xff, 0x01, 0xff, 0xdf, 0xf7, 0xbe,
+    0x84, 0xff, 0xff, 0x08, 0x94, 0xb2, 0x8c, 0x51, 0xff, 0xff, 0xff, 0xff,
+    0x8c, 0x51, 0x8c, 0x71, 0xff, 0xff, 0x52, 0x8a, 0xc6, 0x38, 0x83, 0xff,
+    0xff, 0x14, 0xce, 0x79, 0x39, 0xe7, 0x39, 0xc7, 0x00, 0x00, 0x9c, 0xf3,
+    0xff, 0xff, 0xff, 0xff, 0xad, 0x55, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe,
+    0xad, 0x55, 0x00, 0x00, 0x10, 0xa2, 0x5a, 0xcb, 0x00, 0x00, 0x9c, 0xd3,
+    0xf7, 0xbe, 0x29, 0x65, 0x00, 0x00, 0xad, 0x75, 0xe0, 0xff, 0xff, 0xb8,
+    0xff, 0xff, 0x07, 0xad, 0x55, 0x00, 0x00, 0x5a, 0xcb, 0xff, 0xff, 0xa5,
+    0x34, 0x00, 0x00, 0x63, 0x0c, 0xef, 0x5d, 0x9f, 0xff, 0xff, 0x48, 0x8c,
+    0x71, 0x94, 0xb2, 0xf7, 0xbe, 0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00, 0x52,
+    0xaa, 0x00, 0x00, 0xde, 0xdb, 0xd6, 0xba, 0x00, 0x00, 0x00, 0x00, 0x31,
+    0x86, 0x29, 0x45, 0x08, 0x61, 0x31, 0xa6, 0xde, 0xfb, 0xde, 0xdb, 0x63,
+    0x2c, 0xff, 0xdf, 0x8c, 0x51, 0x8c, 0x51, 0xf7, 0xbe, 0x31, 0xa6, 0x00,
+    0x00, 0x21, 0x24, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0xb5, 0x96, 0xf7,
+    0xbe, 0x4a, 0x69, 0xde, 0xdb, 0xd6, 0x9a, 0x00, 0x00, 0xf7, 0xbe, 0x94,
+    0xb2, 0x94, 0xb2, 0xf7, 0xbe, 0x31, 0xa6, 0x00, 0x00, 0xa5, 0x34, 0xf7,
+    0xbe, 0x52, 0xaa, 0x31, 0xa6, 0x4a, 0x49, 0x00, 0x00, 0x31, 0xa6, 0x00,
+    0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x31, 0xa6, 0xd6, 0xba, 0xd6, 0xba, 0x31,
+    0x86, 0xf7, 0x9e, 0x8c, 0x71, 0x94, 0xb2, 0xf7, 0xbe, 0x52, 0xaa, 0x00,
+    0x00, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x31,
+    0xa6, 0x00, 0x00, 0x00, 0x00, 0xb5, 0x96, 0xf7, 0xbe, 0x63, 0x2c, 0xd6,
+    0x9a, 0x83, 0xff, 0xff, 0x0a, 0xce, 0x79, 0x31, 0x86, 0xf7, 0xbe, 0xa5,
+    0x14, 0x00, 0x00, 0x7b, 0xcf, 0xff, 0xdf, 0xff, 0xff, 0xd6, 0xba, 0x63,
+    0x2c, 0xff, 0xdf, 0x84, 0xff, 0xff, 0x10, 0xce, 0x59, 0x52, 0x8a, 0xff,
+    0xff, 0x9c, 0xd3, 0x94, 0x92, 0xff, 0xff, 0xff, 0xff, 0x8c, 0x71, 0x9c,
+    0xd3, 0xff, 0xff, 0xff, 0xff, 0x94, 0xb2, 0x94, 0x92, 0xff, 0xff, 0xff,
+    0xff, 0x7b, 0xef, 0x8c, 0x51, 0x82, 0xff, 0xff, 0x0b, 0xc6, 0x38, 0x00,
+    0x00, 0x00, 0x00, 0xde, 0xfb, 0xd6, 0xba, 0x31, 0xa6, 0xf7, 0xbe, 0x9c,
+    0xd3, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0xc6, 0x18, 0xe1, 0xff, 0xff,
+    0xb6, 0xff, 0xff, 0x08, 0xff, 0xdf, 0xad, 0x55, 0xce, 0x79, 0xad, 0x75,
+    0x00, 0x00, 0x7b, 0xef, 0xc6, 0x18, 0xd6, 0x9a, 0xd6, 0x9a, 0xa0, 0xff,
+    0xff, 0x2a, 0x8c, 0x71, 0x18, 0xe3, 0xa5, 0x34, 0x00, 0x00, 0xc6, 0x18,
+    0xbd, 0xd7, 0x00, 0x00, 0x00, 0x00, 0x84, 0x30, 0xc6, 0x38, 0xd6, 0xba,
+    0x31, 0x86, 0xb5, 0xb6, 0xbd, 0xf7, 0x00, 0x00, 0x00, 0x00, 0x8c, 0x51,
+    0x84, 0x30, 0x00, 0x00, 0x9c, 0xd3, 0xd6, 0xba, 0xce, 0x79, 0xad, 0x55,
+    0xde, 0xfb, 0x84, 0x10, 0x7b, 0xef, 0xd6, 0xba, 0x4a, 0x69, 0x00, 0x00,
+    0x39, 0xc7, 0xb5, 0x96, 0xde, 0xdb, 0xad, 0x75, 0xb5, 0x96, 0xde, 0xfb,
+    0xa5, 0x34, 0x08, 0x41, 0x39, 0xc7, 0xb5, 0xb6, 0xde, 0xfb, 0x84, 0x30,
+    0x5a, 0xcb, 0xa5, 0x34, 0x82, 0x00, 0x00, 0x4e, 0x4a, 0x49, 0xd6, 0xba,
+    0x84, 0x30, 0x5a, 0xcb, 0xa5, 0x34, 0x00, 0x00, 0x84, 0x30, 0x8c, 0x51,
+    0x52, 0x8a, 0xff, 0xff, 0x9c, 0xf3, 0x10, 0xa2, 0xa5, 0x34, 0x00, 0x00,
+    0xb5, 0xb6, 0xbd, 0xd7, 0x00, 0x00, 0x94, 0xb2, 0x4a, 0x49, 0x8c, 0x51,
+    0xd6, 0xba, 0x4a, 0x69, 0x00, 0x00, 0x4a, 0x49, 0xa5, 0x34, 0x00, 0x00,
+    0xd6, 0x9a, 0xff, 0xff, 0xf7, 0xbe, 0x94, 0x92, 0xef, 0x7d, 0xde, 0xfb,
+    0x00, 0x00, 0xa5, 0x14, 0x6b, 0x6d, 0x00, 0x00, 0x00, 0x00, 0x9c, 0xd3,
+    0xad, 0x55, 0x73, 0x8e, 0x00, 0x00, 0x94, 0xb2, 0xa5, 0x34, 0xa5, 0x14,
+    0x9c, 0xf3, 0x8c, 0x71, 0x9c, 0xd3, 0xbd, 0xf7, 0xd6, 0xba, 0xad, 0x75,
+    0x29, 0x45, 0x31, 0xa6, 0xa5, 0x34, 0xa5, 0x34, 0xc6, 0x38, 0xbd, 0xf7,
+    0xad, 0x55, 0xff, 0xdf, 0xef, 0x7d, 0xc6, 0x18, 0x94, 0xb2, 0xa5, 0x14,
+    0xce, 0x59, 0xbd, 0xf7, 0x9c, 0xd3, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xdf,
+    0xde, 0xdb, 0xd6, 0x9a, 0xb5, 0x96, 0x73, 0x8e, 0x18, 0xc3, 0x8c, 0x51,
+    0xd6, 0xba, 0xb5, 0x96, 0x00, 0x00, 0xc6, 0x18, 0xf7, 0xbe, 0xe1, 0xff,
+    0xff, 0xb6, 0xff, 0xff, 0x06, 0xf7, 0x9e, 0x00, 0x00, 0xa5, 0x34, 0xd6,
+    0x9a, 0x9c, 0xd3, 0x84, 0x30, 0xe7, 0x3c, 0xa2, 0xff, 0xff, 0x4e, 0xce,
+    0x79, 0x6b, 0x4d, 0x00, 0x00, 0x00, 0x00, 0xbd, 0xd7, 0xde, 0xdb, 0x9c,
+    0xf3, 0x39, 0xc7, 0x00, 0x00, 0x7b, 0xcf, 0xde, 0xdb, 0x00, 0x00, 0xbd,
+    0xd7, 0xbd, 0xf7, 0x00, 0x00, 0xa5, 0x34, 0x42, 0x28, 0x4a, 0x49, 0xa5,
+    0x34, 0x00, 0x00, 0xb5, 0xb6, 0xb5, 0x96, 0x00, 0x00, 0xde, 0xdb, 0x7b,
+    0xef, 0x7b, 0xcf, 0xde, 0xdb, 0x18, 0xc3, 0x8c, 0x51, 0x84, 0x30, 0x00,
+    0x00, 0xd6, 0x9a, 0xb5, 0x96, 0xb5, 0x96, 0xde, 0xfb, 0x9c, 0xf3, 0xa5,
+    0x34, 0x7b, 0xef, 0x00, 0x00, 0xd6, 0xba, 0x94, 0x92, 0x00, 0x00, 0x00,
+    0x00, 0xa5, 0x34, 0x6b, 0x6d, 0x00, 0x00, 0x31, 0xa6, 0xde, 0xdb, 0x8c,
+    0x71, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0x5a, 0xcb, 0x00, 0x00, 0x31,
+    0x86, 0xce, 0x59, 0xc6, 0x38, 0x73, 0x8e, 0x00, 0x00, 0x9c, 0xd3, 0xde,
+    0xdb, 0xbd, 0xd7, 0x00, 0x00, 0x94, 0xb2, 0x4a, 0x49, 0x8c, 0x51, 0xd6,
+    0xba, 0x39, 0xe7, 0x8c, 0x71, 0x84, 0x30, 0x00, 0x00, 0x9c, 0xf3, 0xbd,
+    0xf7, 0xef, 0x5d, 0xff, 0xff, 0xa5, 0x14, 0xbd, 0xf7, 0xce, 0x79, 0x9c,
+    0xf3, 0x85, 0x00, 0x00, 0x01, 0x5a, 0xeb, 0xa5, 0x34, 0x83, 0x00, 0x00,
+    0x1f, 0x94, 0x92, 0x18, 0xc3, 0x7b, 0xcf, 0xd6, 0xba, 0x00, 0x00, 0x84,
+    0x30, 0x8c, 0x51, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x1c, 0xde, 0xfb, 0x00,
+    0x00, 0xf7, 0xbe, 0xf7, 0xbe, 0xc6, 0x38, 0x7b, 0xef, 0x00, 0x00, 0xde,
+    0xfb, 0xf7, 0x9e, 0x94, 0x92, 0xf7, 0xbe, 0xff, 0xff, 0xf7, 0x9e, 0xde,
+    0xfb, 0xff, 0xff, 0xce, 0x79, 0x5a, 0xcb, 0x10, 0xa2, 0x84, 0x10, 0xce,
+    0x59, 0xce, 0x59, 0xad, 0x55, 0xe3, 0xff, 0xff, 0xb6, 0xff, 0xff, 0x03,
+    0xf7, 0xbe, 0x73, 0xae, 0x00, 0x00, 0xad, 0x55, 0xa6, 0xff, 0xff, 0x6b,
+    0xde, 0xdb, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x9c, 0xd3, 0xf7, 0xbe,
+    0x52, 0xaa, 0x39, 0xc7, 0x39, 0xe7, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00,
+    0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0x94, 0xb2, 0x94, 0xb2, 0xf7, 0xbe,
+    0x52, 0xaa, 0x00, 0x00, 0x31, 0x86, 0x00, 0x00, 0x00, 0x00, 0x42, 0x08,
+    0x39, 0xe7, 0x00, 0x00, 0x31, 0x86, 0xe7, 0x1c, 0xde, 0xdb, 0x00, 0x00,
+    0x00, 0x00, 0xde, 0xfb, 0xd6, 0x9a, 0x00, 0x00, 0xef, 0x7d, 0xff, 0xff,
+    0xce, 0x79, 0x00, 0x00, 0x31, 0xa6, 0x21, 0x04, 0x00, 0x00, 0x52, 0xaa,
+    0xf7, 0xbe, 0xa5, 0x14, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x39, 0xe7,
+    0x31, 0xa6, 0x52, 0xaa, 0xf7, 0xbe, 0xa5, 0x14, 0x00, 0x00, 0x52, 0x8a,
+    0x00, 0x00, 0xd6, 0xba, 0xde, 0xdb, 0x63, 0x2c, 0xff, 0xdf, 0x9c, 0xd3,
+    0x00, 0x00, 0x5a, 0xcb, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x31, 0xa6,
+    0x00, 0x00, 0xde, 0xdb, 0xd6, 0xba, 0x31, 0xa6, 0xf7, 0xbe, 0x9c, 0xf3,
+    0x8c, 0x71, 0xff, 0xdf, 0xff, 0xff, 0x84, 0x10, 0x8c, 0x51, 0xf7, 0xbe,
+    0x52, 0xaa, 0x00, 0x00, 0x31, 0xa6, 0x52, 0xaa, 0x18, 0xc3, 0x00, 0x00,
+    0xa5, 0x34, 0xff, 0xdf, 0x7b, 0xcf, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xcf,
+    0xff, 0xdf, 0xa5, 0x34, 0x00, 0x00, 0x31, 0xa6, 0x00, 0x00, 0xde, 0xdb,
+    0xde, 0xfb, 0x31, 0xa6, 0x00, 0x00, 0xde, 0xfb, 0xde, 0xdb, 0x39, 0xc7,
+    0xff, 0xdf, 0x8c, 0x71, 0x94, 0x92, 0xff, 0xff, 0x6b, 0x4d, 0xc6, 0x38,
+    0x83, 0xff, 0xff, 0x08, 0xd6, 0x9a, 0x42, 0x28, 0xef, 0x5d, 0xff, 0xff,
+    0xd6, 0xba, 0x39, 0xc7, 0xff, 0xff, 0xa5, 0x14, 0x9c, 0xd3, 0xe4, 0xff,
+    0xff, 0xb7, 0xff, 0xff, 0x02, 0xf7, 0xbe, 0xf7, 0x9e, 0xff, 0xdf, 0xa6,
+    0xff, 0xff, 0x6c, 0xce, 0x59, 0x00, 0x00, 0xf7, 0xbe, 0xa5, 0x34, 0x00,
+    0x00, 0x31, 0xa6, 0x00, 0x00, 0xde, 0xdb, 0xd6, 0xba, 0x31, 0xa6, 0xf7,
+    0xbe, 0xa5, 0x34, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x00,
+    0x00, 0x52, 0xaa, 0x00, 0x00, 0xde, 0xdb, 0xde, 0xdb, 0x00, 0x00, 0x00,
+    0x00, 0xde, 0xdb, 0xd6, 0xba, 0x31, 0xa6, 0xf7, 0xbe, 0xb5, 0xb6, 0x00,
+    0x00, 0x31, 0x86, 0xf7, 0xbe, 0xb5, 0xb6, 0x00, 0x00, 0x00, 0x00, 0x29,
+    0x65, 0x52, 0xaa, 0x31, 0x86, 0x52, 0xaa, 0xf7, 0xbe, 0xa5, 0x34, 0x00,
+    0x00, 0x08, 0x61, 0x31, 0xa6, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x31,
+    0xa6, 0xd6, 0xba, 0xde, 0xdb, 0x00, 0x00, 0x31, 0x86, 0x00, 0x00, 0xa5,
+    0x34, 0xf7, 0xbe, 0x52, 0x8a, 0x00, 0x00, 0xb5, 0x96, 0xf7, 0xbe, 0x7b,
+    0xcf, 0x00, 0x00, 0x00, 0x00, 0x10, 0xa2, 0x31, 0xa6, 0x00, 0x00, 0xa5,
+    0x34, 0xf7, 0xbe, 0x52, 0xaa, 0x00, 0x00, 0x29, 0x45, 0x08, 0x61, 0x39,
+    0xc7, 0xde, 0xdb, 0xde, 0xdb, 0x39, 0xc7, 0x39, 0xc7, 0x10, 0x82, 0x18,
+    0xc3, 0x31, 0xa6, 0x08, 0x61, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x5a,
+    0xcb, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xcf, 0xff, 0xdf, 0x8c, 0x51, 0x8c,
+    0x51, 0xff, 0xdf, 0x7b, 0xcf, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x52,
+    0xaa, 0x00, 0x00, 0xb5, 0x96, 0xf7, 0xbe, 0x31, 0xa6, 0xde, 0xdb, 0xde,
+    0xdb, 0x31, 0xa6, 0xff, 0xdf, 0x94, 0xb2, 0x8c, 0x71, 0xff, 0xff, 0xff,
+    0xff, 0x94, 0x92, 0x94, 0xb2, 0x83, 0xff, 0xff, 0x07, 0xef, 0x5d, 0x63,
+    0x0c, 0xde, 0xfb, 0xd6, 0xba, 0x39, 0xc7, 0xff, 0xdf, 0xff, 0xff, 0xf7,
+    0xbe, 0xe4, 0xff, 0xff, 0xe1, 0xff, 0xff, 0x77, 0xf7, 0x9e, 0xce, 0x59,
+    0xa5, 0x14, 0x39, 0xc7, 0x8c, 0x51, 0xd6, 0xba, 0x00, 0x00, 0x84, 0x30,
+    0x8c, 0x51, 0x00, 0x00, 0xa5, 0x14, 0x5a, 0xcb, 0x8c, 0x51, 0xde, 0xdb,
+    0x00, 0x00, 0xbd, 0xd7, 0xbd, 0xf7, 0x00, 0x00, 0x00, 0x00, 0x8c, 0x71,
+    0x8c, 0x71, 0x00, 0x00, 0x00, 0x00, 0x84, 0x30, 0x7b, 0xef, 0x21, 0x24,
+    0xa5, 0x34, 0x10, 0xa2, 0x6b, 0x6d, 0xe7, 0x1c, 0xb5, 0xb6, 0x00, 0x00,
+    0x6b, 0x4d, 0xe7, 0x3c, 0xe7, 0x1c, 0x6b, 0x6d, 0x00, 0x00, 0x31, 0xa6,
+    0x94, 0xb2, 0x63, 0x0c, 0x00, 0x00, 0x4a, 0x49, 0xd6, 0xba, 0x84, 0x30,
+    0x5a, 0xcb, 0xa5, 0x34, 0x21, 0x24, 0x7b, 0xef, 0x7b, 0xcf, 0x39, 0xe7,
+    0xd6, 0xba, 0x8c, 0x51, 0x4a, 0x49, 0x94, 0xb2, 0x31, 0xa6, 0x00, 0x00,
+    0x4a, 0x49, 0xa5, 0x34, 0x00, 0x00, 0xbd, 0xd7, 0xbd, 0xf7, 0x29, 0x45,
+    0xd6, 0xba, 0x8c, 0x51, 0x4a, 0x49, 0x94, 0xb2, 0x00, 0x00, 0xbd, 0xd7,
+    0xbd, 0xf7, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x1c, 0xde, 0xfb, 0x00, 0x00,
+    0xce, 0x59, 0x73, 0xae, 0x84, 0x10, 0xd6, 0xba, 0x4a, 0x69, 0x00, 0x00,
+    0x52, 0xaa, 0xa5, 0x34, 0x00, 0x00, 0xbd, 0xf7, 0xbd, 0xf7, 0x00, 0x00,
+    0x8c, 0x51, 0xd6, 0x9a, 0xd6, 0x9a, 0x8c, 0x51, 0x00, 0x00, 0x00, 0x00,
+    0x5a, 0xcb, 0xa5, 0x34, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xcb, 0x94, 0xb2,
+    0x00, 0x00, 0xe7, 0x3c, 0xe7, 0x1c, 0x31, 0xa6, 0xff, 0xdf, 0x94, 0xb2,
+    0x94, 0xb2, 0xff, 0xff, 0xa5, 0x14, 0xbd, 0xf7, 0xef, 0x5d, 0xff, 0xff,
+    0xff, 0xff, 0xc6, 0x18, 0xce, 0x59, 0xff, 0xff, 0x00, 0x00, 0xde, 0xfb,
+    0xe7, 0x3c, 0x00, 0x00, 0x7b, 0xcf, 0xe7, 0x3c, 0xe5, 0xff, 0xff, 0xe3,
+    0xff, 0xff, 0x29, 0xa5, 0x14, 0x00, 0x00, 0x84, 0x10, 0xe7, 0x1c, 0xb5,
+    0xb6, 0x10, 0x82, 0x31, 0xa6, 0xa5, 0x34, 0x00, 0x00, 0x00, 0x00, 0x8c,
+    0x71, 0xde, 0xdb, 0x00, 0x00, 0xbd, 0xd7, 0xbd, 0xf7, 0x00, 0x00, 0xa5,
+    0x34, 0x42, 0x28, 0x42, 0x28, 0xa5, 0x34, 0x21, 0x24, 0x7b, 0xef, 0x84,
+    0x30, 0x00, 0x00, 0x00, 0x00, 0x73, 0xae, 0xce, 0x59, 0xd6, 0xba, 0x00,
+    0x00, 0x73, 0x8e, 0xc6, 0x18, 0xde, 0xdb, 0xe7, 0x1c, 0xc6, 0x18, 0x84,
+    0x10, 0x10, 0xa2, 0x94, 0xb2, 0x52, 0xaa, 0x00, 0x00, 0x4a, 0x69, 0xde,
+    0xdb, 0x8c, 0x71, 0x82, 0x00, 0x00, 0x48, 0x84, 0x30, 0x7b, 0xcf, 0x39,
+    0xe7, 0xd6, 0xba, 0x8c, 0x51, 0x4a, 0x49, 0x94, 0xb2, 0x10, 0xa2, 0x94,
+    0x92, 0x8c, 0x51, 0x00, 0x00, 0x00, 0x00, 0xbd, 0xf7, 0xbd, 0xd7, 0x00,
+    0x00, 0xde, 0xdb, 0x84, 0x30, 0x31, 0xa6, 0x94, 0xb2, 0x00, 0x00, 0xbd,
+    0xf7, 0xbd, 0xf7, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x1c, 0xde, 0xdb, 0x18,
+    0xc3, 0xff, 0xff, 0xa5, 0x34, 0x73, 0xae, 0xd6, 0xba, 0x39, 0xe7, 0x8c,
+    0x71, 0x8c, 0x51, 0x00, 0x00, 0x00, 0x00, 0xbd, 0xf7, 0xbd, 0xd7, 0x00,
+    0x00, 0x8c, 0x51, 0xce, 0x79, 0xce, 0x79, 0x8c, 0x51, 0x08, 0x61, 0x94,
+    0x92, 0x84, 0x30, 0x00, 0x00, 0xa5, 0x14, 0x63, 0x2c, 0x4a, 0x69, 0x8c,
+    0x71, 0x00, 0x00, 0xb5, 0x96, 0xad, 0x55, 0x4a, 0x49, 0xff, 0xff, 0x94,
+    0xb2, 0x8c, 0x71, 0xff, 0xff, 0xa5, 0x14, 0xbd, 0xf7, 0xef, 0x7d, 0xff,
+    0xff, 0xff, 0xff, 0x7b, 0xef, 0x8c, 0x51, 0xff, 0xdf, 0x42, 0x28, 0xb5,
+    0x96, 0xb5, 0x96, 0x00, 0x00, 0x7b, 0xcf, 0xe7, 0x1c, 0xe5, 0xff, 0xff,
+    0xe4, 0xff, 0xff, 0x24, 0xb5, 0x96, 0x00, 0x00, 0x29, 0x65, 0xf7, 0xbe,
+    0xa5, 0x34, 0xa5, 0x34, 0xf7, 0xbe, 0x52, 0xaa, 0x39, 0xc7, 0x39, 0xe7,
+    0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe,
+    0x94, 0xb2, 0x94, 0xb2, 0xf7, 0xbe, 0x31, 0xa6, 0xd6, 0xba, 0xde, 0xdb,
+    0x00, 0x00, 0x31, 0xa6, 0xe7, 0x1c, 0xd6, 0xba, 0x00, 0x00, 0x00, 0x00,
+    0xde, 0xdb, 0xde, 0xfb, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0xd6, 0xba,
+    0x31, 0xa6, 0xf7, 0xbe, 0xb5, 0x96, 0x82, 0x00, 0x00, 0x4a, 0x39, 0xe7,
+    0x4a, 0x69, 0x00, 0x00, 0x00, 0x00, 0xde, 0xdb, 0xde, 0xdb, 0x00, 0x00,
+    0x31, 0xa6, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x31, 0xa6, 0xd6, 0xba,
+    0xde, 0xdb, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa,
+    0x00, 0x00, 0x00, 0x00, 0xb5, 0xb6, 0xf7, 0xbe, 0x52, 0xaa, 0x00, 0x00,
+    0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0xd6, 0x9a, 0xd6, 0xba, 0x63, 0x2c,
+    0xf7, 0x9e, 0x9c, 0xf3, 0x00, 0x00, 0x31, 0xa6, 0x00, 0x00, 0xde, 0xdb,
+    0xde, 0xdb, 0x00, 0x00, 0x00, 0x00, 0x29, 0x65, 0x00, 0x00, 0x52, 0xaa,
+    0xf7, 0xbe, 0x8c, 0x51, 0x8c, 0x51, 0xf7, 0xbe, 0x31, 0xa6, 0xd6, 0xba,
+    0xd6, 0xba, 0x31, 0xa6, 0xf7, 0xbe, 0x94, 0x92, 0x9c, 0xf3, 0xff, 0xff,
+    0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00, 0x52, 0x8a, 0xef, 0x7d, 0x9c, 0xf3,
+    0xa5, 0x14, 0xff, 0xff, 0xff, 0xff, 0x94, 0x92, 0x8c, 0x71, 0xff, 0xdf,
+    0xff, 0xff, 0x8c, 0x71, 0x94, 0xb2, 0xff, 0xdf, 0x5a, 0xcb, 0x00, 0x00,
+    0x00, 0x00, 0x7b, 0xcf, 0xe7, 0xff, 0xff, 0xe5, 0xff, 0xff, 0x17, 0xc6,
+    0x18, 0x00, 0x00, 0x29, 0x65, 0xde, 0xfb, 0xde, 0xdb, 0x00, 0x00, 0x00,
+    0x00, 0xde, 0xdb, 0xd6, 0xba, 0x31, 0xa6, 0xf7, 0xbe, 0xa5, 0x34, 0x00,
+    0x00, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xcb, 0x10,
+    0xa2, 0x29, 0x45, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xb5, 0x96, 0x83,
+    0x00, 0x00, 0x54, 0xb5, 0xb6, 0xf7, 0xbe, 0x52, 0xaa, 0x00, 0x00, 0x29,
+    0x45, 0x08, 0x61, 0x31, 0xa6, 0xde, 0xfb, 0xde, 0xdb, 0x00, 0x00, 0x00,
+    0x00, 0xd6, 0xba, 0xde, 0xdb, 0x00, 0x00, 0x00, 0x00, 0x39, 0xe7, 0x39,
+    0xc7, 0x52, 0xaa, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x31, 0xa6, 0x00,
+    0x20, 0x29, 0x65, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0x94, 0xb2, 0x94,
+    0xb2, 0xf7, 0xbe, 0x31, 0xa6, 0xd6, 0xba, 0xe7, 0x1c, 0x31, 0x86, 0x00,
+    0x00, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x52, 0xaa, 0x00, 0x00, 0xad,
+    0x55, 0xff, 0xdf, 0x7b, 0xcf, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x52,
+    0xaa, 0x39, 0xc7, 0x39, 0xe7, 0x00, 0x00, 0x00, 0x00, 0xde, 0xdb, 0xde,
+    0xdb, 0x00, 0x00, 0x52, 0xaa, 0x29, 0x65, 0x31, 0x86, 0x52, 0xaa, 0x00,
+    0x00, 0x39, 0xe7, 0x4a, 0x69, 0x00, 0x00, 0x31, 0xa6, 0x00, 0x00, 0xad,
+    0x55, 0xff, 0xdf, 0x39, 0xc7, 0xd6, 0xba, 0xde, 0xdb, 0x00, 0x00, 0x00,
+    0x00, 0xd6, 0x9a, 0xff, 0xff, 0xf7, 0xbe, 0x63, 0x2c, 0xd6, 0x9a, 0xce,
+    0x79, 0x4a, 0x69, 0xff, 0xdf, 0x94, 0xb2, 0x94, 0xb2, 0xff, 0xdf, 0x5a,
+    0xcb, 0x00, 0x00, 0x8c, 0x71, 0xe8, 0xff, 0xff, 0xe5, 0xff, 0xff, 0x50,
+    0xf7, 0xbe, 0xc6, 0x18, 0x00, 0x00, 0x6b, 0x6d, 0xc6, 0x38, 0xd6, 0x9a,
+    0x39, 0xe7, 0x7b, 0xcf, 0x84, 0x10, 0x18, 0xe3, 0x94, 0xb2, 0x42, 0x28,
+    0x8c, 0x71, 0xde, 0xdb, 0x00, 0x00, 0xbd, 0xd7, 0xbd, 0xd7, 0x00, 0x00,
+    0x00, 0x00, 0xbd, 0xf7, 0xbd, 0xd7, 0x00, 0x00, 0xa5, 0x34, 0x4a, 0x49,
+    0x00, 0x00, 0x4a, 0x69, 0xde, 0xdb, 0x84, 0x30, 0x31, 0xa6, 0x94, 0xb2,
+    0x00, 0x00, 0xbd, 0xd7, 0xbd, 0xf7, 0x00, 0x00, 0x00, 0x00, 0x84, 0x30,
+    0x8c, 0x71, 0x39, 0xe7, 0xd6, 0xba, 0xbd, 0xf7, 0x6b, 0x4d, 0x42, 0x08,
+    0xde, 0xdb, 0x7b, 0xcf, 0x00, 0x00, 0x31, 0xa6, 0x94, 0xb2, 0x4a, 0x49,
+    0x8c, 0x51, 0xd6, 0xba, 0x29, 0x65, 0xb5, 0xb6, 0xbd, 0xd7, 0x00, 0x00,
+    0x94, 0xb2, 0x52, 0xaa, 0x63, 0x2c, 0xa5, 0x34, 0x00, 0x00, 0x84, 0x30,
+    0x8c, 0x51, 0x18, 0xc3, 0xde, 0xdb, 0x8c, 0x51, 0x5a, 0xcb, 0xa5, 0x14,
+    0x00, 0x00, 0xad, 0x75, 0xd6, 0x9a, 0x8c, 0x51, 0x00, 0x00, 0x00, 0x00,
+    0x5a, 0xcb, 0xa5, 0x34, 0x00, 0x00, 0x00, 0x00, 0x8c, 0x71, 0xde, 0xdb,
+    0x39, 0xe7, 0x8c, 0x71, 0x8c, 0x51, 0x83, 0x00, 0x00, 0x1b, 0x39, 0xc7,
+    0xde, 0xdb, 0x8c, 0x51, 0x00, 0x00, 0x4a, 0x49, 0xd6, 0xba, 0x73, 0xae,
+    0xa5, 0x14, 0xff, 0xff, 0x52, 0xaa, 0x73, 0xae, 0x7b, 0xcf, 0x39, 0xe7,
+    0xd6, 0x9a, 0xad, 0x75, 0xc6, 0x38, 0xf7, 0xbe, 0x00, 0x00, 0xd6, 0xba,
+    0xff, 0xff, 0xce, 0x79, 0xff, 0xff, 0x8c, 0x51, 0x94, 0x92, 0xff, 0xff,
+    0x4a, 0x49, 0x9c, 0xf3, 0xef, 0x7d, 0xe8, 0xff, 0xff, 0xe7, 0xff, 0xff,
+    0x6d, 0xb5, 0x96, 0x00, 0x00, 0x6b, 0x6d, 0xd6, 0xba, 0x39, 0xe7, 0x7b,
+    0xef, 0x7b, 0xcf, 0x00, 0x00, 0x94, 0xb2, 0x4a, 0x49, 0x8c, 0x51, 0xd6,
+    0xba, 0x29, 0x65, 0xb5, 0xb6, 0xde, 0xdb, 0x9c, 0xf3, 0x00, 0x00, 0xbd,
+    0xd7, 0xbd, 0xf7, 0x00, 0x00, 0x00, 0x00, 0x8c, 0x51, 0x8c, 0x51, 0x18,
+    0xc3, 0xde, 0xdb, 0x84, 0x30, 0x31, 0xa6, 0x94, 0xb2, 0x00, 0x00, 0xbd,
+    0xf7, 0xbd, 0xd7, 0x00, 0x00, 0xa5, 0x34, 0x5a, 0xcb, 0x00, 0x00, 0x31,
+    0xa6, 0xd6, 0x9a, 0xb5, 0xb6, 0x5a, 0xcb, 0x18, 0xe3, 0xd6, 0x9a, 0xc6,
+    0x38, 0x84, 0x10, 0x10, 0xa2, 0x94, 0xb2, 0x31, 0xa6, 0x84, 0x30, 0xde,
+    0xdb, 0x00, 0x00, 0xbd, 0xd7, 0xbd, 0xf7, 0x00, 0x00, 0x94, 0xb2, 0x63,
+    0x2c, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0x5a, 0xcb, 0x00, 0x00, 0x39,
+    0xc7, 0xde, 0xdb, 0x8c, 0x71, 0x00, 0x00, 0x00, 0x00, 0x9c, 0xd3, 0xd6,
+    0xba, 0xce, 0x79, 0x8c, 0x51, 0x08, 0x61, 0x94, 0x92, 0x84, 0x30, 0x00,
+    0x00, 0xa5, 0x14, 0x5a, 0xcb, 0x84, 0x30, 0xd6, 0xba, 0x4a, 0x69, 0x00,
+    0x00, 0x52, 0xaa, 0xa5, 0x34, 0x21, 0x04, 0x8c, 0x71, 0x84, 0x30, 0x18,
+    0xc3, 0xde, 0xdb, 0x8c, 0x51, 0x00, 0x00, 0x4a, 0x49, 0xd6, 0xba, 0x84,
+    0x10, 0x7b, 0xcf, 0xce, 0x79, 0x10, 0xa2, 0x73, 0xae, 0x7b, 0xef, 0x42,
+    0x08, 0xde, 0xdb, 0xad, 0x55, 0xc6, 0x18, 0xff, 0xff, 0xad, 0x55, 0xbd,
+    0xd7, 0xef, 0x7d, 0xff, 0xff, 0xde, 0xdb, 0xb5, 0x96, 0xb5, 0xb6, 0xc6,
+    0x38, 0x00, 0x00, 0xd6, 0xba, 0xe9, 0xff, 0xff, 0xe8, 0xff, 0xff, 0x6c,
+    0xb5, 0x96, 0x00, 0x00, 0x29, 0x65, 0x00, 0x00, 0xde, 0xdb, 0xde, 0xdb,
+    0x63, 0x2c, 0xff, 0xdf, 0xa5, 0x14, 0x00, 0x00, 0x31, 0xa6, 0x10, 0xa2,
+    0x00, 0x00, 0x9c, 0xf3, 0xf7, 0xbe, 0x52, 0xaa, 0x00, 0x00, 0x29, 0x65,
+    0x00, 0x00, 0x00, 0x00, 0xde, 0xdb, 0xe7, 0x1c, 0x31, 0x86, 0x00, 0x00,
+    0x00, 0x00, 0xb5, 0xb6, 0xf7, 0xbe, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00,
+    0x7b, 0xcf, 0xff, 0xdf, 0xa5, 0x14, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00,
+    0xe7, 0x3c, 0xef, 0x5d, 0x29, 0x65, 0x00, 0x00, 0xde, 0xdb, 0xd6, 0xba,
+    0x31, 0x86, 0xf7, 0xbe, 0xb5, 0xb6, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa,
+    0x00, 0x00, 0x00, 0x00, 0x5a, 0xcb, 0xf7, 0xbe, 0xa5, 0x14, 0x00, 0x00,
+    0x7b, 0xcf, 0xff, 0xdf, 0xa5, 0x14, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00,
+    0x39, 0xe7, 0x31, 0xa6, 0x52, 0xaa, 0xf7, 0xbe, 0x8c, 0x51, 0x8c, 0x51,
+    0xf7, 0xbe, 0x31, 0xa6, 0xd6, 0xba, 0xd6, 0xba, 0x31, 0xa6, 0xf7, 0xbe,
+    0xa5, 0x34, 0x00, 0x00, 0x31, 0xa6, 0x08, 0x61, 0x00, 0x00, 0xa5, 0x34,
+    0xf7, 0xbe, 0x31, 0xa6, 0xd6, 0xba, 0xde, 0xfb, 0x29, 0x65, 0x00, 0x00,
+    0x39, 0xc7, 0x4a, 0x69, 0x00, 0x00, 0x31, 0xa6, 0x21, 0x24, 0x00, 0x00,
+    0x00, 0x00, 0x31, 0x86, 0xe7, 0x1c, 0xde, 0xdb, 0x00, 0x00, 0x00, 0x00,
+    0xd6, 0xba, 0xff, 0xff, 0xf7, 0xbe, 0xff, 0xff, 0x8c, 0x51, 0x8c, 0x71,
+    0xff, 0xdf, 0x00, 0x00, 0xd6, 0x9a, 0xde, 0xfb, 0x00, 0x00, 0x00, 0x00,
+    0xd6, 0x9a, 0xe9, 0xff, 0xff, 0xe8, 0xff, 0xff, 0x11, 0xff, 0xdf, 0xf7,
+    0xbe, 0xef, 0x5d, 0x29, 0x45, 0x00, 0x00, 0xb5, 0x96, 0xf7, 0xbe, 0x7b,
+    0xcf, 0x00, 0x00, 0x9c, 0xd3, 0xf7, 0xbe, 0x5a, 0xcb, 0x00, 0x00, 0x00,
+    0x00, 0x52, 0xaa, 0x00, 0x00, 0xde, 0xdb, 0xd6, 0xba, 0x82, 0x00, 0x00,
+    0x47, 0xb5, 0x96, 0xf7, 0xbe, 0x00, 0x00, 0xd6, 0x9a, 0xe7, 0x1c, 0x31,
+    0x86, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xdf, 0x7b, 0xcf, 0x00,
+    0x00, 0x9c, 0xf3, 0xff, 0xff, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xff, 0xf7,
+    0xbe, 0xff, 0xdf, 0xa5, 0x14, 0x00, 0x00, 0x00, 0x00, 0x31, 0x86, 0xe7,
+    0x1c, 0xd6, 0x9a, 0x31, 0xa6, 0xf7, 0xbe, 0x9c, 0xf3, 0x00, 0x00, 0x10,
+    0xa2, 0x31, 0xa6, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xdf, 0x7b, 0xcf, 0x00,
+    0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x31, 0xa6, 0xd6, 0xba, 0xde, 0xdb, 0x00,
+    0x00, 0x31, 0x86, 0x18, 0xc3, 0x18, 0xc3, 0x31, 0xa6, 0x00, 0x20, 0x29,
+    0x65, 0x29, 0x45, 0x10, 0xa2, 0x52, 0xaa, 0x00, 0x00, 0xa5, 0x34, 0xf7,
+    0xbe, 0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xcb, 0x08, 0x61, 0x00,
+    0x00, 0xad, 0x75, 0xef, 0x7d, 0x31, 0x86, 0xce, 0x79, 0xce, 0x79, 0x39,
+    0xc7, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xb5,
+    0xb6, 0x82, 0x00, 0x00, 0x0c, 0xde, 0xfb, 0xde, 0xdb, 0x4a, 0x69, 0xff,
+    0xff, 0x94, 0x92, 0x8c, 0x51, 0xff, 0xdf, 0x52, 0xaa, 0x00, 0x00, 0xad,
+    0x55, 0xf7, 0xbe, 0x00, 0x00, 0xce, 0x59, 0xe9, 0xff, 0xff, 0xeb, 0xff,
+    0xff, 0x1f, 0xde, 0xfb, 0x5a, 0xcb, 0x00, 0x00, 0x94, 0xb2, 0x00, 0x00,
+    0xb5, 0xb6, 0xde, 0xdb, 0x9c, 0xf3, 0x00, 0x00, 0xc6, 0x18, 0xbd, 0xd7,
+    0x00, 0x00, 0x00, 0x00, 0x84, 0x30, 0xc6, 0x38, 0xd6, 0xba, 0x00, 0x00,
+    0x00, 0x00, 0x5a, 0xcb, 0xb5, 0x96, 0xde, 0xfb, 0xc6, 0x38, 0x73, 0xae,
+    0x18, 0xc3, 0xde, 0xdb, 0x8c, 0x71, 0x4a, 0x49, 0x94, 0xb2, 0x00, 0x00,
+    0x00, 0x00, 0x52, 0x8a, 0xad, 0x55, 0x84, 0xff, 0xff, 0x1d, 0xe7, 0x1c,
+    0xce, 0x79, 0xce, 0x59, 0x00, 0x00, 0x6b, 0x6d, 0x84, 0x10, 0x21, 0x24,
+    0x9c, 0xf3, 0xde, 0xdb, 0xb5, 0xb6, 0x29, 0x45, 0xd6, 0xba, 0x84, 0x30,
+    0x5a, 0xcb, 0xa5, 0x14, 0x00, 0x00, 0x00, 0x00, 0x73, 0x8e, 0xa5, 0x34,
+    0x00, 0x00, 0x84, 0x30, 0x8c, 0x71, 0x39, 0xe7, 0xd6, 0xba, 0x6b, 0x6d,
+    0x6b, 0x6d, 0xd6, 0xba, 0x29, 0x65, 0xb5, 0xb6, 0xbd, 0xf7, 0x82, 0x00,
+    0x00, 0x04, 0x63, 0x2c, 0x94, 0xb2, 0x00, 0x00, 0xbd, 0xf7, 0xbd, 0xf7,
+    0x82, 0x00, 0x00, 0x1b, 0xa5, 0x34, 0xff, 0xff, 0x31, 0xa6, 0xe7, 0x3c,
+    0xe7, 0x3c, 0x00, 0x00, 0xa5, 0x34, 0x52, 0xaa, 0x00, 0x00, 0x31, 0xa6,
+    0x94, 0xb2, 0x31, 0xa6, 0x84, 0x30, 0xde, 0xdb, 0x18, 0xe3, 0xd6, 0x9a,
+    0xff, 0xff, 0xd6, 0x9a, 0x94, 0x92, 0xc6, 0x18, 0xf7, 0x9e, 0xf7, 0xbe,
+    0x42, 0x28, 0xa5, 0x34, 0xc6, 0x38, 0xad, 0x55, 0xce, 0x79, 0xf7, 0x9e,
+    0xe9, 0xff, 0xff, 0xec, 0xff, 0xff, 0x1f, 0xce, 0x79, 0x8c, 0x71, 0x84,
+    0x30, 0x00, 0x00, 0xbd, 0xd7, 0xb5, 0xb6, 0x00, 0x00, 0x00, 0x00, 0xbd,
+    0xd7, 0xde, 0xdb, 0x9c, 0xf3, 0x08, 0x41, 0x00, 0x00, 0x7b, 0xef, 0xe7,
+    0x1c, 0xb5, 0x96, 0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0x84,
+    0x10, 0x00, 0x00, 0x39, 0xc7, 0xde, 0xdb, 0x8c, 0x71, 0x42, 0x28, 0x94,
+    0xb2, 0x31, 0x86, 0x00, 0x00, 0x39, 0xc7, 0xa5, 0x14, 0xf7, 0xbe, 0x86,
+    0xff, 0xff, 0x3f, 0xad, 0x75, 0x94, 0xb2, 0x6b, 0x6d, 0x00, 0x00, 0x00,
+    0x00, 0xb5, 0xb6, 0xbd, 0xd7, 0x31, 0x86, 0xde, 0xdb, 0x8c, 0x71, 0x00,
+    0x00, 0x00, 0x00, 0xa5, 0x34, 0x73, 0x8e, 0x00, 0x00, 0x00, 0x00, 0xa5,
+    0x34, 0x5a, 0xcb, 0x00, 0x00, 0x4a, 0x69, 0xd6, 0xba, 0xbd, 0xf7, 0xbd,
+    0xd7, 0xd6, 0x9a, 0x29, 0x45, 0xbd, 0xf7, 0xbd, 0xd7, 0x00, 0x00, 0xa5,
+    0x34, 0x63, 0x2c, 0x52, 0xaa, 0x94, 0xb2, 0x00, 0x00, 0xbd, 0xf7, 0xbd,
+    0xf7, 0x00, 0x00, 0x9c, 0xf3, 0x42, 0x08, 0xa5, 0x34, 0xff, 0xff, 0x29,
+    0x65, 0xad, 0x75, 0xbd, 0xd7, 0x00, 0x00, 0x00, 0x00, 0x84, 0x30, 0x94,
+    0x92, 0x10, 0xa2, 0x94, 0xb2, 0x4a, 0x49, 0x8c, 0x51, 0xd6, 0xba, 0x10,
+    0x82, 0xd6, 0xba, 0xff, 0xff, 0xd6, 0x9a, 0x9c, 0xd3, 0xbd, 0xf7, 0xf7,
+    0x9e, 0xff, 0xdf, 0x31, 0x86, 0xe7, 0x3c, 0xde, 0xfb, 0x00, 0x00, 0xeb,
+    0xff, 0xff, 0xee, 0xff, 0xff, 0x1b, 0xff, 0xdf, 0x5a, 0xcb, 0x00, 0x00,
+    0x29, 0x45, 0x10, 0xa2, 0x5a, 0xcb, 0x00, 0x00, 0x9c, 0xd3, 0xff, 0xdf,
+    0x7b, 0xcf, 0x10, 0x82, 0x00, 0x00, 0x31, 0xa6, 0xf7, 0xbe, 0xb5, 0x96,
+    0x00, 0x00, 0x00, 0x00, 0x31, 0xa6, 0x10, 0xa2, 0x31, 0xa6, 0x52, 0xaa,
+    0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x52, 0xaa, 0x00, 0x00,
+    0xb5, 0x96, 0x8a, 0xff, 0xff, 0x0f, 0xde, 0xfb, 0x31, 0xa6, 0x52, 0xaa,
+    0x42, 0x28, 0x21, 0x24, 0x00, 0x00, 0x00, 0x00, 0x39, 0xe7, 0x31, 0xa6,
+    0x52, 0xaa, 0xf7, 0xbe, 0xa5, 0x14, 0x00, 0x00, 0x7b, 0xcf, 0xff, 0xdf,
+    0xa5, 0x34, 0x82, 0x00, 0x00, 0x01, 0xd6, 0xba, 0xde, 0xfb, 0x83, 0x00,
+    0x00, 0x25, 0x7b, 0xcf, 0xff, 0xdf, 0x94, 0xb2, 0x94, 0xb2, 0xf7, 0xbe,
+    0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xeb, 0xff, 0xff, 0x9c, 0xf3,
+    0x8c, 0x71, 0xf7, 0x9e, 0x7b, 0xcf, 0x00, 0x00, 0x00, 0x00, 0x18, 0xc3,
+    0x31, 0xa6, 0xde, 0xfb, 0xd6, 0xba, 0x31, 0xa6, 0xf7, 0xbe, 0xa5, 0x34,
+    0x00, 0x00, 0x31, 0xa6, 0x00, 0x00, 0xd6, 0x9a, 0xd6, 0x9a, 0x4a, 0x69,
+    0xf7, 0xbe, 0x9c, 0xd3, 0x94, 0xb2, 0xf7, 0x9e, 0x31, 0xa6, 0xce, 0x79,
+    0xce, 0x79, 0x31, 0xa6, 0xf7, 0xbe, 0xea, 0xff, 0xff, 0xee, 0xff, 0xff,
+    0x1a, 0xf7, 0xbe, 0x39, 0xc7, 0xce, 0x79, 0xce, 0x79, 0x39, 0xc7, 0xf7,
+    0xbe, 0x9c, 0xd3, 0x00, 0x00, 0x7b, 0xcf, 0xff, 0xdf, 0xa5, 0x34, 0x00,
+    0x00, 0x00, 0x00, 0x31, 0x86, 0xe7, 0x1c, 0xd6, 0xba, 0x31, 0xa6, 0xf7,
+    0xbe, 0x94, 0xb2, 0x94, 0xb2, 0xf7, 0xbe, 0x31, 0xa6, 0x00, 0x00, 0x21,
+    0x24, 0x31, 0xa6, 0x00, 0x00, 0xce, 0x59, 0x8b, 0xff, 0xff, 0x0e, 0xff,
+    0xdf, 0xf7, 0x9e, 0xf7, 0xbe, 0xff, 0xff, 0xc6, 0x38, 0x00, 0x00, 0x00,
+    0x00, 0xde, 0xdb, 0xde, 0xdb, 0x00, 0x00, 0x31, 0x86, 0x00, 0x00, 0xa5,
+    0x34, 0xff, 0xdf, 0x7b, 0xcf, 0x84, 0x00, 0x00, 0x2a, 0xb5, 0xb6, 0xf7,
+    0xbe, 0x31, 0xa6, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xdf, 0x7b, 0xcf, 0x00,
+    0x00, 0x10, 0xa2, 0x31, 0xa6, 0x10, 0xa2, 0x00, 0x00, 0x00, 0x00, 0x5a,
+    0xcb, 0xff, 0xdf, 0xad, 0x55, 0x00, 0x00, 0x63, 0x2c, 0xf7, 0xbe, 0xa5,
+    0x34, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xb5, 0x96, 0x00, 0x00, 0x00,
+    0x00, 0x31, 0xa6, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x52, 0xaa, 0x00,
+    0x00, 0xad, 0x75, 0xf7, 0x9e, 0x63, 0x2c, 0xd6, 0x9a, 0xde, 0xdb, 0x31,
+    0xa6, 0x08, 0x61, 0x29, 0x65, 0x00, 0x00, 0x31, 0xa6, 0xf7, 0x9e, 0xea,
+    0xff, 0xff, 0xef, 0xff, 0xff, 0x19, 0x39, 0xc7, 0xde, 0xfb, 0xe7, 0x1c,
+    0x00, 0x00, 0x8c, 0x51, 0xd6, 0xba, 0xbd, 0xd7, 0x00, 0x00, 0x94, 0x92,
+    0x4a, 0x49, 0x8c, 0x71, 0xde, 0xdb, 0x18, 0xc3, 0x8c, 0x51, 0x84, 0x30,
+    0x00, 0x00, 0xa5, 0x34, 0x4a, 0x49, 0x31, 0xa6, 0xb5, 0xb6, 0xe7, 0x1c,
+    0x6b, 0x6d, 0x6b, 0x6d, 0xd6, 0xba, 0x10, 0xa2, 0xd6, 0x9a, 0x8f, 0xff,
+    0xff, 0x3a, 0xf7, 0xbe, 0xc6, 0x38, 0x00, 0x00, 0x73, 0xae, 0x73, 0xae,
+    0x00, 0x00, 0xd6, 0xba, 0x84, 0x30, 0x5a, 0xcb, 0xa5, 0x14, 0x00, 0x00,
+    0xb5, 0xb6, 0xbd, 0xf7, 0x29, 0x65, 0xde, 0xdb, 0x73, 0x8e, 0x00, 0x00,
+    0xb5, 0xb6, 0xde, 0xfb, 0x84, 0x30, 0x5a, 0xcb, 0xa5, 0x14, 0x00, 0x00,
+    0x00, 0x00, 0x94, 0x92, 0xd6, 0xba, 0x29, 0x65, 0xbd, 0xf7, 0xbd, 0xd7,
+    0x42, 0x08, 0xff, 0xdf, 0x9c, 0xf3, 0x73, 0xae, 0xde, 0xdb, 0xb5, 0x96,
+    0x4a, 0x49, 0x00, 0x00, 0x31, 0xa6, 0x94, 0xb2, 0x5a, 0xcb, 0x00, 0x00,
+    0x00, 0x00, 0xd6, 0xba, 0x84, 0x30, 0x5a, 0xcb, 0xa5, 0x34, 0x00, 0x00,
+    0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0x18, 0xe3, 0xde, 0xdb, 0xe7, 0x1c,
+    0x00, 0x00, 0x00, 0x00, 0xa5, 0x14, 0xd6, 0xba, 0xd6, 0xba, 0xff, 0xdf,
+    0xea, 0xff, 0xff, 0xed, 0xff, 0xff, 0x1b, 0xf7, 0xbe, 0xbd, 0xf7, 0x00,
+    0x00, 0xde, 0xfb, 0xde, 0xfb, 0x00, 0x00, 0x8c, 0x51, 0xce, 0x79, 0xb5,
+    0xb6, 0x00, 0x00, 0x94, 0xb2, 0x4a, 0x49, 0x8c, 0x51, 0xd6, 0xba, 0x4a,
+    0x69, 0x00, 0x00, 0x4a, 0x49, 0xa5, 0x34, 0x00, 0x00, 0x84, 0x10, 0x7b,
+    0xef, 0x00, 0x00, 0xd6, 0xba, 0xbd, 0xf7, 0xbd, 0xf7, 0xd6, 0xba, 0x00,
+    0x00, 0xce, 0x79, 0x91, 0xff, 0xff, 0x35, 0xad, 0x75, 0x8c, 0x71, 0x94,
+    0x92, 0xad, 0x55, 0xde, 0xdb, 0x84, 0x30, 0x00, 0x00, 0x00, 0x00, 0x9c,
+    0xd3, 0xde, 0xdb, 0xb5, 0xb6, 0x00, 0x00, 0xd6, 0xba, 0xce, 0x59, 0x6b,
+    0x6d, 0x00, 0x00, 0xde, 0xdb, 0x94, 0xb2, 0x00, 0x00, 0x00, 0x00, 0xa5,
+    0x14, 0x5a, 0xcb, 0x84, 0x30, 0xd6, 0xba, 0x29, 0x65, 0xbd, 0xf7, 0xbd,
+    0xd7, 0x42, 0x08, 0xff, 0xdf, 0x9c, 0xf3, 0x7b, 0xef, 0xde, 0xdb, 0x00,
+    0x00, 0x84, 0x10, 0x8c, 0x71, 0x00, 0x00, 0x94, 0xb2, 0x42, 0x28, 0x4a,
+    0x69, 0xb5, 0x96, 0xe7, 0x1c, 0x8c, 0x51, 0x00, 0x00, 0x00, 0x00, 0xa5,
+    0x34, 0x5a, 0xeb, 0x7b, 0xef, 0xce, 0x59, 0x00, 0x00, 0xde, 0xfb, 0xe7,
+    0x1c, 0x00, 0x00, 0x8c, 0x71, 0xef, 0x7d, 0xed, 0xff, 0xff, 0xed, 0xff,
+    0xff, 0x1b, 0xce, 0x59, 0x00, 0x00, 0x00, 0x00, 0xd6, 0x9a, 0xd6, 0xba,
+    0x63, 0x2c, 0xf7, 0xbe, 0xad, 0x55, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe,
+    0xa5, 0x34, 0x00, 0x00, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0xb5, 0x96,
+    0xf7, 0xbe, 0x31, 0x86, 0xde, 0xfb, 0xe7, 0x3c, 0x00, 0x00, 0x00, 0x00,
+    0xd6, 0xba, 0xd6, 0xba, 0x00, 0x00, 0x29, 0x45, 0xde, 0xdb, 0x94, 0xff,
+    0xff, 0x1a, 0xff, 0xdf, 0x63, 0x2c, 0x39, 0xc7, 0x29, 0x65, 0x52, 0x8a,
+    0xf7, 0xbe, 0x9c, 0xd3, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0xd6, 0xba,
+    0xe7, 0x1c, 0x31, 0x86, 0x00, 0x00, 0x00, 0x00, 0x10, 0x82, 0x7b, 0xcf,
+    0xff, 0xdf, 0xa5, 0x14, 0x00, 0x00, 0x31, 0xa6, 0x10, 0xa2, 0x00, 0x00,
+    0x00, 0x00, 0x5a, 0xcb, 0xff, 0xdf, 0xad, 0x55, 0x82, 0x00, 0x00, 0x13,
+    0xde, 0xdb, 0xde, 0xdb, 0x63, 0x2c, 0xf7, 0xbe, 0xa5, 0x14, 0xa5, 0x34,
+    0xf7, 0xbe, 0x31, 0x86, 0x18, 0xc3, 0x31, 0xa6, 0x52, 0xaa, 0xf7, 0xbe,
+    0xa5, 0x34, 0x00, 0x00, 0x31, 0xa6, 0x00, 0x00, 0xd6, 0xba, 0xce, 0x79,
+    0x39, 0xe7, 0xff, 0xdf, 0xee, 0xff, 0xff, 0xec, 0xff, 0xff, 0x1b, 0xa5,
+    0x34, 0x9c, 0xf3, 0xef, 0x7d, 0x52, 0x8a, 0x00, 0x00, 0xad, 0x55, 0xff,
+    0xdf, 0x63, 0x2c, 0xde, 0xdb, 0xd6, 0xba, 0x00, 0x00, 0x52, 0x8a, 0x00,
+    0x00, 0x9c, 0xf3, 0xef, 0x7d, 0x31, 0x86, 0xd6, 0xba, 0xde, 0xfb, 0x00,
+    0x00, 0x00, 0x00, 0xe7, 0x3c, 0xe7, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x39,
+    0xe7, 0x39, 0xc7, 0x4a, 0x69, 0xef, 0x5d, 0x96, 0xff, 0xff, 0x19, 0xf7,
+    0xbe, 0xff, 0xff, 0xc6, 0x38, 0x00, 0x00, 0x31, 0x86, 0x00, 0x00, 0x9c,
+    0xd3, 0xf7, 0xbe, 0x52, 0x8a, 0x00, 0x00, 0xb5, 0x96, 0xf7, 0xbe, 0x31,
+    0xa6, 0x00, 0x00, 0xa5, 0x34, 0xff, 0xdf, 0x7b, 0xcf, 0x00, 0x00, 0x9c,
+    0xd3, 0xf7, 0xbe, 0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00, 0x5a, 0xeb, 0xff,
+    0xff, 0xa5, 0x34, 0x83, 0x00, 0x00, 0x12, 0xb5, 0x96, 0xf7, 0xbe, 0x63,
+    0x2c, 0xde, 0xdb, 0xde, 0xfb, 0x31, 0xa6, 0x00, 0x00, 0xde, 0xdb, 0xde,
+    0xdb, 0x00, 0x00, 0x31, 0x86, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x31,
+    0x86, 0x10, 0xa2, 0x31, 0xa6, 0x52, 0xaa, 0xf7, 0xbe, 0xee, 0xff, 0xff,
+    0xeb, 0xff, 0xff, 0x1c, 0xa5, 0x14, 0x00, 0x00, 0xad, 0x55, 0xff, 0xff,
+    0x00, 0x00, 0xad, 0x55, 0xd6, 0xba, 0x9c, 0xd3, 0x00, 0x00, 0x73, 0x8e,
+    0xce, 0x59, 0xd6, 0xba, 0x00, 0x00, 0x00, 0x00, 0xa5, 0x14, 0xff, 0xff,
+    0x00, 0x20, 0x6b, 0x6d, 0xc6, 0x38, 0xd6, 0x9a, 0x39, 0xe7, 0x84, 0x30,
+    0x84, 0x10, 0x42, 0x08, 0xde, 0xdb, 0x8c, 0x71, 0x00, 0x00, 0x29, 0x45,
+    0xff, 0xdf, 0x98, 0xff, 0xff, 0x18, 0xf7, 0xbe, 0xce, 0x79, 0xce, 0x79,
+    0xd6, 0xba, 0xc6, 0x18, 0x8c, 0x51, 0x00, 0x00, 0x00, 0x00, 0x39, 0xc7,
+    0xb5, 0xb6, 0xde, 0xfb, 0x8c, 0x51, 0x4a, 0x49, 0x94, 0x92, 0x00, 0x00,
+    0xbd, 0xd7, 0xd6, 0xba, 0x8c, 0x51, 0x00, 0x00, 0xbd, 0xf7, 0xbd, 0xf7,
+    0x00, 0x00, 0x94, 0xb2, 0xd6, 0xba, 0xbd, 0xf7, 0x82, 0x00, 0x00, 0x12,
+    0x5a, 0xcb, 0x94, 0xb2, 0x00, 0x00, 0x8c, 0x71, 0x84, 0x30, 0x00, 0x00,
+    0x00, 0x00, 0x94, 0x92, 0x8c, 0x51, 0x39, 0xe7, 0xd6, 0xba, 0x73, 0xae,
+    0x18, 0xc3, 0xb5, 0xb6, 0xe7, 0x1c, 0x8c, 0x51, 0x00, 0x00, 0x21, 0x24,
+    0xf7, 0x9e, 0xee, 0xff, 0xff, 0xe9, 0xff, 0xff, 0x1e, 0xf7, 0xbe, 0xce,
+    0x59, 0xa5, 0x14, 0x21, 0x04, 0x73, 0xae, 0xd6, 0xba, 0xad, 0x55, 0xd6,
+    0x9a, 0xad, 0x75, 0x00, 0x00, 0xa5, 0x34, 0x18, 0xe3, 0x63, 0x2c, 0xde,
+    0xdb, 0xa5, 0x34, 0x94, 0x92, 0xce, 0x79, 0xff, 0xff, 0xb5, 0x96, 0x00,
+    0x00, 0x7b, 0xcf, 0xde, 0xdb, 0x39, 0xc7, 0x00, 0x00, 0x00, 0x00, 0x39,
+    0xc7, 0xde, 0xdb, 0x8c, 0x51, 0x39, 0xc7, 0xb5, 0x96, 0xff, 0xdf, 0x9c,
+    0xff, 0xff, 0x2a, 0xe7, 0x3c, 0x84, 0x30, 0x9c, 0xf3, 0xad, 0x55, 0x6b,
+    0x6d, 0x00, 0x00, 0xd6, 0x9a, 0x8c, 0x51, 0x4a, 0x49, 0x94, 0xb2, 0x00,
+    0x00, 0xbd, 0xd7, 0xd6, 0x9a, 0x8c, 0x51, 0x00, 0x00, 0xbd, 0xd7, 0xbd,
+    0xf7, 0x00, 0x00, 0x00, 0x00, 0xbd, 0xd7, 0xc6, 0x18, 0x00, 0x00, 0xa5,
+    0x34, 0x63, 0x2c, 0x52, 0xaa, 0x94, 0xb2, 0x31, 0xa6, 0x00, 0x00, 0x52,
+    0xaa, 0xa5, 0x34, 0x39, 0xe7, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x69, 0xd6,
+    0xba, 0xce, 0x59, 0x73, 0x8e, 0x00, 0x00, 0xd6, 0xba, 0x84, 0x10, 0x21,
+    0x04, 0xb5, 0x96, 0xff, 0xdf, 0xee, 0xff, 0xff, 0xe9, 0xff, 0xff, 0x0e,
+    0xbd, 0xf7, 0x00, 0x00, 0xf7, 0xbe, 0xb5, 0xb6, 0x00, 0x00, 0x29, 0x65,
+    0xf7, 0xbe, 0xad, 0x55, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xb5, 0x96,
+    0x00, 0x00, 0x63, 0x2c, 0xff, 0xdf, 0x83, 0xff, 0xff, 0x09, 0xa5, 0x34,
+    0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0x31, 0x86, 0x31, 0x86, 0x52, 0xaa,
+    0x00, 0x00, 0x00, 0x00, 0xa5, 0x34, 0xa2, 0xff, 0xff, 0x24, 0xde, 0xfb,
+    0x31, 0x86, 0x39, 0xc7, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x5a, 0xcb,
+    0x00, 0x00, 0x9c, 0xf3, 0xf7, 0xbe, 0x52, 0xaa, 0x00, 0x00, 0x29, 0x65,
+    0x10, 0xa2, 0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe,
+    0x94, 0xb2, 0x94, 0xb2, 0xf7, 0xbe, 0x52, 0xaa, 0x00, 0x00, 0xa5, 0x34,
+    0xf7, 0xbe, 0x52, 0xaa, 0x31, 0xa6, 0x4a, 0x69, 0x00, 0x00, 0x00, 0x00,
+    0xd6, 0xba, 0xde, 0xdb, 0x00, 0x00, 0x29, 0x45, 0x00, 0x00, 0xb5, 0x96,
+    0xf0, 0xff, 0xff, 0xe8, 0xff, 0xff, 0x0e, 0xb5, 0x96, 0x00, 0x00, 0x00,
+    0x00, 0x31, 0x86, 0xe7, 0x1c, 0xd6, 0xba, 0x00, 0x00, 0x29, 0x65, 0xe7,
+    0x1c, 0xd6, 0xba, 0x00, 0x00, 0x00, 0x00, 0xce, 0x79, 0xff, 0xdf, 0xf7,
+    0xbe, 0x84, 0xff, 0xff, 0x09, 0xa5, 0x14, 0x00, 0x00, 0x31, 0xa6, 0xf7,
+    0xbe, 0x94, 0xb2, 0x94, 0xb2, 0xf7, 0xbe, 0x31, 0xa6, 0x00, 0x00, 0xa5,
+    0x14, 0xa2, 0xff, 0xff, 0x24, 0xff, 0xdf, 0xf7, 0xbe, 0xff, 0xdf, 0x8c,
+    0x71, 0x00, 0x00, 0x39, 0xc7, 0x08, 0x61, 0x00, 0x00, 0x18, 0xe3, 0x31,
+    0xa6, 0x00, 0x00, 0xde, 0xdb, 0xd6, 0xba, 0x31, 0xa6, 0xf7, 0xbe, 0xa5,
+    0x34, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x52,
+    0xaa, 0x00, 0x00, 0x00, 0x00, 0x39, 0xc7, 0x52, 0xaa, 0x00, 0x00, 0xde,
+    0xdb, 0xd6, 0xba, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x69, 0x18, 0xe3, 0x29,
+    0x45, 0xef, 0x5d, 0xf7, 0xbe, 0xff, 0xdf, 0xf0, 0xff, 0xff, 0xe5, 0xff,
+    0xff, 0x0f, 0xef, 0x5d, 0x94, 0xb2, 0xa5, 0x34, 0x00, 0x00, 0x73, 0xae,
+    0xde, 0xdb, 0x00, 0x00, 0x6b, 0x6d, 0xc6, 0x38, 0xce, 0x59, 0x10, 0x82,
+    0x63, 0x2c, 0xb5, 0xb6, 0xd6, 0xba, 0xce, 0x59, 0xf7, 0x9e, 0x86, 0xff,
+    0xff, 0x09, 0x9c, 0xd3, 0x73, 0xae, 0xde, 0xfb, 0xa5, 0x34, 0x42, 0x28,
+    0x5a, 0xcb, 0xb5, 0x96, 0xe7, 0x1c, 0x63, 0x2c, 0x84, 0x30, 0xa5, 0xff,
+    0xff, 0x14, 0xe7, 0x3c, 0xd6, 0x9a, 0xc6, 0x18, 0x00, 0x00, 0x00, 0x00,
+    0x84, 0x10, 0xd6, 0xba, 0x39, 0xe7, 0x7b, 0xcf, 0x7b, 0xef, 0x21, 0x24,
+    0xa5, 0x34, 0x31, 0xa6, 0x7b, 0xcf, 0xde, 0xdb, 0x00, 0x00, 0xbd, 0xd7,
+    0xbd, 0xd7, 0x00, 0x00, 0xde, 0xdb, 0x94, 0xb2, 0x82, 0x00, 0x00, 0x06,
+    0x73, 0x8e, 0xbd, 0xf7, 0xd6, 0xba, 0x00, 0x00, 0x00, 0x00, 0x63, 0x2c,
+    0xde, 0xfb, 0xf3, 0xff, 0xff, 0xe4, 0xff, 0xff, 0x0d, 0xef, 0x7d, 0x9c,
+    0xf3, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xef, 0xc6, 0x18, 0xd6, 0xba, 0xb5,
+    0x96, 0x00, 0x00, 0x9c, 0xd3, 0xff, 0xff, 0x42, 0x28, 0x42, 0x08, 0xce,
+    0x59, 0x87, 0xff, 0xff, 0x0b, 0xff, 0xdf, 0xde, 0xfb, 0x63, 0x2c, 0x7b,
+    0xcf, 0xde, 0xfb, 0xa5, 0x34, 0x4a, 0x69, 0x00, 0x00, 0x00, 0x00, 0xd6,
+    0x9a, 0xb5, 0x96, 0xc6, 0x38, 0xa8, 0xff, 0xff, 0x1a, 0xad, 0x75, 0x94,
+    0xb2, 0xbd, 0xd7, 0xd6, 0x9a, 0x39, 0xe7, 0x7b, 0xcf, 0x84, 0x30, 0x00,
+    0x00, 0x00, 0x00, 0x7b, 0xcf, 0xce, 0x59, 0xd6, 0xba, 0x31, 0x86, 0xb5,
+    0xb6, 0xb5, 0xb6, 0x29, 0x65, 0xd6, 0xba, 0x84, 0x30, 0x5a, 0xcb, 0xa5,
+    0x34, 0x00, 0x00, 0x63, 0x2c, 0xbd, 0xf7, 0xde, 0xfb, 0xad, 0x55, 0x94,
+    0x92, 0xce, 0x79, 0xf4, 0xff, 0xff, 0xe4, 0xff, 0xff, 0x0c, 0x8c, 0x71,
+    0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0xde, 0xdb, 0xd6, 0xba, 0x4a, 0x69,
+    0xf7, 0xbe, 0xa5, 0x34, 0x9c, 0xf3, 0xf7, 0x9e, 0x63, 0x0c, 0xde, 0xdb,
+    0x88, 0xff, 0xff, 0x06, 0xf7, 0x9e, 0x31, 0x86, 0x21, 0x04, 0x18, 0xe3,
+    0x29, 0x65, 0xf7, 0xbe, 0xb5, 0x96, 0x82, 0x00, 0x00, 0x00, 0xde, 0xdb,
+    0xab, 0xff, 0xff, 0x16, 0xde, 0xdb, 0x00, 0x00, 0x00, 0x00, 0xde, 0xdb,
+    0xde, 0xdb, 0x00, 0x00, 0x00, 0x00, 0xde, 0xdb, 0xd6, 0xba, 0x00, 0x00,
+    0x00, 0x00, 0x31, 0x86, 0x29, 0x65, 0x00, 0x20, 0x31, 0xa6, 0x00, 0x00,
+    0xa5, 0x14, 0xff, 0xdf, 0x63, 0x2c, 0xde, 0xdb, 0xd6, 0x9a, 0x00, 0x00,
+    0xff, 0xdf, 0xf6, 0xff, 0xff, 0xe3, 0xff, 0xff, 0x0c, 0x7b, 0xcf, 0x00,
+    0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x31, 0x86, 0x00, 0x00, 0xb5, 0x96, 0xf7,
+    0xbe, 0x63, 0x2c, 0xde, 0xdb, 0xd6, 0xba, 0x42, 0x28, 0xef, 0x5d, 0x89,
+    0xff, 0xff, 0x09, 0xf7, 0xbe, 0x31, 0xa6, 0xd6, 0xba, 0xd6, 0xba, 0x00,
+    0x00, 0x31, 0x86, 0xde, 0xdb, 0xce, 0x79, 0x31, 0x86, 0xef, 0x5d, 0xad,
+    0xff, 0xff, 0x15, 0xef, 0x5d, 0x4a, 0x69, 0x39, 0xc7, 0x39, 0xe7, 0x00,
+    0x00, 0x00, 0x00, 0x31, 0x86, 0x29, 0x65, 0x00, 0x00, 0x00, 0x00, 0xde,
+    0xdb, 0xd6, 0xba, 0x31, 0xa6, 0xf7, 0xbe, 0x9c, 0xd3, 0x00, 0x00, 0x7b,
+    0xcf, 0xf7, 0xbe, 0xb5, 0x96, 0x00, 0x00, 0x29, 0x65, 0xf7, 0xbe, 0xf6,
+    0xff, 0xff, 0xe1, 0xff, 0xff, 0x0d, 0xe7, 0x1c, 0x7b, 0xcf, 0x00, 0x00,
+    0x00, 0x00, 0x4a, 0x49, 0xb5, 0xb6, 0xe7, 0x1c, 0x6b, 0x6d, 0x18, 0xe3,
+    0xa5, 0x34, 0x00, 0x00, 0x73, 0xae, 0xbd, 0xd7, 0xd6, 0xba, 0x8b, 0xff,
+    0xff, 0x08, 0x52, 0x8a, 0x63, 0x0c, 0xbd, 0xf7, 0xd6, 0xba, 0x00, 0x00,
+    0xe7, 0x3c, 0xe7, 0x1c, 0x00, 0x00, 0xf7, 0xbe, 0xad, 0xff, 0xff, 0x14,
+    0xff, 0xdf, 0x5a, 0xcb, 0x00, 0x00, 0x8c, 0x51, 0xde, 0xdb, 0x31, 0x86,
+    0xbd, 0xd7, 0xb5, 0xb6, 0x00, 0x00, 0x00, 0x00, 0x84, 0x30, 0x73, 0xae,
+    0x00, 0x00, 0x9c, 0xf3, 0xd6, 0x9a, 0xad, 0x55, 0x00, 0x00, 0xa5, 0x34,
+    0x10, 0xa2, 0x63, 0x2c, 0xef, 0x5d, 0xf7, 0xff, 0xff, 0xe1, 0xff, 0xff,
+    0x0c, 0xe7, 0x1c, 0x7b, 0xef, 0x00, 0x00, 0x94, 0x92, 0x84, 0x10, 0x00,
+    0x00, 0xd6, 0x9a, 0xc6, 0x38, 0x73, 0xae, 0x00, 0x00, 0xa5, 0x34, 0x00,
+    0x00, 0x8c, 0x71, 0x8a, 0xff, 0xff, 0x0a, 0xf7, 0xbe, 0xc6, 0x38, 0x08,
+    0x61, 0x63, 0x2c, 0xbd, 0xf7, 0xd6, 0xba, 0x00, 0x00, 0xad, 0x55, 0xc6,
+    0x38, 0xad, 0x55, 0xff, 0xdf, 0xad, 0xff, 0xff, 0x14, 0xff, 0xdf, 0x5a,
+    0xcb, 0x00, 0x00, 0x8c, 0x51, 0xde, 0xdb, 0x00, 0x00, 0xb5, 0xb6, 0xd6,
+    0xba, 0x94, 0xb2, 0x18, 0xe3, 0x73, 0xae, 0xa5, 0x34, 0x9c, 0xf3, 0x00,
+    0x00, 0xe7, 0x1c, 0xef, 0x5d, 0x00, 0x00, 0x00, 0x00, 0x73, 0xae, 0xc6,
+    0x18, 0xe7, 0x3c, 0xf7, 0xff, 0xff, 0xe2, 0xff, 0xff, 0x0b, 0xff, 0xdf,
+    0x39, 0xc7, 0xd6, 0xba, 0xde, 0xdb, 0x00, 0x00, 0x00, 0x00, 0xde, 0xfb,
+    0xd6, 0xba, 0x31, 0x86, 0xf7, 0xbe, 0xa5, 0x14, 0x9c, 0xf3, 0x8a, 0xff,
+    0xff, 0x08, 0xce, 0x79, 0x00, 0x00, 0x29, 0x65, 0xe7, 0x1c, 0xd6, 0xba,
+    0x00, 0x00, 0x52, 0x8a, 0x00, 0x00, 0x9c, 0xd3, 0xaf, 0xff, 0xff, 0x15,
+    0xef, 0x5d, 0x52, 0x8a, 0x31, 0xa6, 0x39, 0xc7, 0x00, 0x00, 0x52, 0xaa,
+    0x00, 0x00, 0xa5, 0x14, 0xff, 0xff, 0x39, 0xc7, 0xce, 0x59, 0xff, 0xff,
+    0xf7, 0x9e, 0x63, 0x2c, 0xd6, 0xba, 0xd6, 0x9a, 0x00, 0x00, 0x31, 0xa6,
+    0xe7, 0x1c, 0xd6, 0x9a, 0x00, 0x00, 0xf7, 0x9e, 0xf6, 0xff, 0xff, 0xe2,
+    0xff, 0xff, 0x0a, 0xf7, 0xbe, 0x31, 0xa6, 0x00, 0x00, 0x00, 0x00, 0x52,
+    0xaa, 0xf7, 0xbe, 0xb5, 0xb6, 0x00, 0x00, 0x00, 0x00, 0x31, 0xa6, 0xce,
+    0x79, 0x8b, 0xff, 0xff, 0x08, 0xce, 0x79, 0x31, 0x86, 0xf7, 0xbe, 0xad,
+    0x55, 0x00, 0x00, 0x52, 0x8a, 0xf7, 0x9e, 0x8c, 0x71, 0x94, 0x92, 0xae,
+    0xff, 0xff, 0x16, 0xde, 0xdb, 0x31, 0x86, 0x00, 0x00, 0xd6, 0xba, 0xce,
+    0x79, 0x31, 0xa6, 0xf7, 0xbe, 0x94, 0x92, 0x9c, 0xf3, 0xff, 0xff, 0x39,
+    0xe7, 0x00, 0x00, 0x18, 0xc3, 0x63, 0x2c, 0xf7, 0xbe, 0xb5, 0x96, 0x00,
+    0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xad, 0x55, 0x00, 0x00, 0x52, 0xaa, 0xff,
+    0xdf, 0xf6, 0xff, 0xff, 0xe2, 0xff, 0xff, 0x0a, 0xff, 0xdf, 0xd6, 0xba,
+    0xd6, 0xba, 0x9c, 0xf3, 0x00, 0x00, 0x94, 0x92, 0x31, 0xa6, 0x84, 0x30,
+    0xde, 0xdb, 0x00, 0x00, 0xd6, 0x9a, 0x8b, 0xff, 0xff, 0x08, 0xde, 0xdb,
+    0x00, 0x00, 0x9c, 0xf3, 0xd6, 0xba, 0xad, 0x75, 0x4a, 0x49, 0xff, 0xff,
+    0xa5, 0x14, 0x8c, 0x71, 0xae, 0xff, 0xff, 0x17, 0xd6, 0x9a, 0x00, 0x00,
+    0x00, 0x00, 0xe7, 0x1c, 0xe7, 0x1c, 0x00, 0x00, 0x94, 0xb2, 0x52, 0xaa,
+    0x52, 0xaa, 0xad, 0x55, 0xce, 0x79, 0xd6, 0x9a, 0xce, 0x79, 0xce, 0x59,
+    0xa5, 0x14, 0x4a, 0x69, 0x00, 0x00, 0x00, 0x00, 0x9c, 0xd3, 0xd6, 0xba,
+    0xad, 0x75, 0x00, 0x00, 0x8c, 0x71, 0xef, 0x7d, 0xf5, 0xff, 0xff, 0xe5,
+    0xff, 0xff, 0x09, 0xef, 0x5d, 0x94, 0xb2, 0x94, 0xb2, 0x10, 0xa2, 0x7b,
+    0xef, 0xde, 0xdb, 0xad, 0x55, 0xc6, 0x18, 0xd6, 0x9a, 0xd6, 0x9a, 0x88,
+    0xff, 0xff, 0x09, 0xef, 0x5d, 0xad, 0x55, 0x00, 0x00, 0x00, 0x00, 0xbd,
+    0xd7, 0xbd, 0xd7, 0x00, 0x00, 0xce, 0x79, 0x6b, 0x4d, 0x8c, 0x71, 0xae,
+    0xff, 0xff, 0x0a, 0xd6, 0xba, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x1c, 0xe7,
+    0x1c, 0x00, 0x00, 0x8c, 0x51, 0x63, 0x0c, 0x00, 0x00, 0x00, 0x00, 0xff,
+    0xdf, 0x82, 0xff, 0xff, 0x0a, 0xa5, 0x14, 0x08, 0x61, 0x5a, 0xeb, 0xa5,
+    0x34, 0x00, 0x00, 0xad, 0x75, 0xd6, 0xba, 0x9c, 0xd3, 0x00, 0x00, 0x9c,
+    0xd3, 0xef, 0x5d, 0xf4, 0xff, 0xff, 0xe8, 0xff, 0xff, 0x09, 0xb5, 0x96,
+    0x00, 0x00, 0x63, 0x0c, 0xf7, 0xbe, 0x9c, 0xd3, 0x00, 0x00, 0x63, 0x2c,
+    0xef, 0x5d, 0xf7, 0xbe, 0xff, 0xdf, 0x85, 0xff, 0xff, 0x09, 0x94, 0xb2,
+    0x00, 0x00, 0x18, 0xe3, 0x5a, 0xcb, 0x00, 0x00, 0x00, 0x00, 0x52, 0xaa,
+    0x00, 0x00, 0x00, 0x00, 0xad, 0x75, 0xae, 0xff, 0xff, 0x0a, 0xce, 0x59,
+    0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0xce, 0x79, 0x42, 0x08, 0xff, 0xff,
+    0xad, 0x55, 0x00, 0x00, 0x7b, 0xcf, 0xf7, 0xbe, 0x83, 0xff, 0xff, 0x09,
+    0xa5, 0x14, 0xa5, 0x14, 0xf7, 0xbe, 0x52, 0xaa, 0x00, 0x00, 0xad, 0x55,
+    0xff, 0xdf, 0x7b, 0xcf, 0x00, 0x00, 0x94, 0xb2, 0xf4, 0xff, 0xff, 0xe8,
+    0xff, 0xff, 0x09, 0xff, 0xdf, 0xf7, 0xbe, 0xef, 0x5d, 0x63, 0x2c, 0x00,
+    0x00, 0x9c, 0xd3, 0xf7, 0xbe, 0x63, 0x0c, 0x00, 0x00, 0xb5, 0x96, 0x85,
+    0xff, 0xff, 0x08, 0xa5, 0x34, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0x8c,
+    0x51, 0x8c, 0x51, 0xf7, 0xbe, 0x31, 0xa6, 0xce, 0x59, 0xae, 0xff, 0xff,
+    0x00, 0xb5, 0x96, 0x82, 0x00, 0x00, 0x05, 0x29, 0x65, 0x00, 0x00, 0x5a,
+    0xcb, 0xff, 0xff, 0x94, 0xb2, 0x73, 0xae, 0x86, 0xff, 0xff, 0x08, 0xce,
+    0x59, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0xde, 0xdb, 0x63, 0x2c, 0xf7,
+    0x9e, 0x8c, 0x71, 0x94, 0xb2, 0xf4, 0xff, 0xff, 0xeb, 0xff, 0xff, 0x16,
+    0xd6, 0x9a, 0xd6, 0x9a, 0xbd, 0xf7, 0x9c, 0xd3, 0xde, 0xdb, 0x6b, 0x4d,
+    0x00, 0x00, 0xa5, 0x34, 0x84, 0x30, 0xef, 0x7d, 0xef, 0x7d, 0x84, 0x30,
+    0xa5, 0x14, 0x4a, 0x49, 0x00, 0x00, 0x31, 0x86, 0x8c, 0x51, 0xce, 0x79,
+    0xd6, 0xba, 0x9c, 0xd3, 0x00, 0x00, 0x6b, 0x6d, 0xd6, 0x9a, 0xab, 0xff,
+    0xff, 0x0b, 0xff, 0xdf, 0xb5, 0x96, 0x18, 0xe3, 0x84, 0x10, 0xde, 0xdb,
+    0x31, 0xa6, 0xad, 0x75, 0xad, 0x75, 0x00, 0x00, 0x94, 0xb2, 0xc6, 0x18,
+    0xef, 0x5d, 0x86, 0xff, 0xff, 0x0a, 0xf7, 0x9e, 0xce, 0x59, 0xd6, 0xba,
+    0xb5, 0xb6, 0x5a, 0xeb, 0x42, 0x08, 0xff, 0xff, 0xa5, 0x14, 0x00, 0x00,
+    0xb5, 0x96, 0xff, 0xdf, 0xf2, 0xff, 0xff, 0xed, 0xff, 0xff, 0x14, 0xe7,
+    0x3c, 0x8c, 0x71, 0xd6, 0xba, 0xc6, 0x18, 0x6b, 0x4d, 0x00, 0x00, 0x8c,
+    0x51, 0xce, 0x59, 0xc6, 0x38, 0x84, 0x10, 0x00, 0x00, 0x84, 0x10, 0x84,
+    0x30, 0x00, 0x00, 0x8c, 0x51, 0xd6, 0xba, 0xb5, 0x96, 0x00, 0x00, 0xa5,
+    0x34, 0x00, 0x00, 0x8c, 0x51, 0xab, 0xff, 0xff, 0x0a, 0xf7, 0xbe, 0x21,
+    0x24, 0x00, 0x00, 0x94, 0x92, 0xd6, 0xba, 0x00, 0x20, 0xe7, 0x3c, 0xef,
+    0x5d, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xba, 0x8a, 0xff, 0xff, 0x07, 0xce,
+    0x59, 0x4a, 0x49, 0x10, 0xa2, 0xce, 0x59, 0xc6, 0x38, 0x6b, 0x4d, 0x00,
+    0x00, 0xf7, 0x9e, 0xf2, 0xff, 0xff, 0xee, 0xff, 0xff, 0x14, 0xff, 0xdf,
+    0x4a, 0x69, 0xde, 0xfb, 0xe7, 0x1c, 0x63, 0x0c, 0xff, 0xdf, 0x84, 0x30,
+    0x94, 0xb2, 0xff, 0xff, 0x31, 0xa6, 0xde, 0xfb, 0xe7, 0x3c, 0x63, 0x0c,
+    0xff, 0xdf, 0x9c, 0xd3, 0x00, 0x00, 0x7b, 0xcf, 0xf7, 0xbe, 0xa5, 0x34,
+    0x94, 0xb2, 0xff, 0xdf, 0xaa, 0xff, 0xff, 0x0a, 0xef, 0x5d, 0x52, 0x8a,
+    0x00, 0x00, 0x18, 0xe3, 0x31, 0xa6, 0x00, 0x00, 0xd6, 0xba, 0xd6, 0x9a,
+    0x00, 0x00, 0x29, 0x65, 0xde, 0xdb, 0x8b, 0xff, 0xff, 0x06, 0xde, 0xfb,
+    0x21, 0x24, 0x00, 0x00, 0xd6, 0xba, 0xde, 0xdb, 0x63, 0x2c, 0xf7, 0xbe,
+    0xf2, 0xff, 0xff, 0xef, 0xff, 0xff, 0x14, 0xf7, 0xbe, 0xff, 0xff, 0xff,
+    0xff, 0xef, 0x5d, 0x63, 0x0c, 0x00, 0x00, 0xad, 0x75, 0xff, 0xff, 0x00,
+    0x00, 0xd6, 0x9a, 0xff, 0xff, 0xef, 0x5d, 0x63, 0x0c, 0x00, 0x00, 0x9c,
+    0xf3, 0xf7, 0x9e, 0x63, 0x2c, 0xde, 0xdb, 0xde, 0xdb, 0x63, 0x2c, 0xff,
+    0xdf, 0xa8, 0xff, 0xff, 0x0a, 0xde, 0xdb, 0x31, 0x86, 0x18, 0xc3, 0x00,
+    0x00, 0x9c, 0xf3, 0xf7, 0xbe, 0x31, 0x86, 0x18, 0xe3, 0x21, 0x04, 0x29,
+    0x45, 0xef, 0x5d, 0x8d, 0xff, 0xff, 0x03, 0xef, 0x5d, 0x29, 0x45, 0x00,
+    0x00, 0xa5, 0x34, 0xf4, 0xff, 0xff, 0xf3, 0xff, 0xff, 0x12, 0xde, 0xdb,
+    0x63, 0x0c, 0x00, 0x00, 0x9c, 0xf3, 0xde, 0xdb, 0xb5, 0x96, 0xce, 0x59,
+    0xff, 0xff, 0xe7, 0x1c, 0x52, 0x8a, 0x9c, 0xd3, 0xff, 0xff, 0x00, 0x00,
+    0x6b, 0x4d, 0x7b, 0xef, 0x00, 0x00, 0x84, 0x30, 0x94, 0x92, 0xce, 0x79,
+    0xa6, 0xff, 0xff, 0x09, 0xde, 0xdb, 0x00, 0x00, 0x00, 0x00, 0xbd, 0xd7,
+    0xd6, 0xba, 0xad, 0x55, 0xd6, 0xba, 0x5a, 0xcb, 0x4a, 0x69, 0xde, 0xfb,
+    0x8f, 0xff, 0xff, 0x05, 0xde, 0xdb, 0xd6, 0x9a, 0xbd, 0xf7, 0x94, 0x92,
+    0x84, 0x10, 0xe7, 0x3c, 0xf1, 0xff, 0xff, 0xf4, 0xff, 0xff, 0x14, 0xce,
+    0x79, 0x8c, 0x51, 0x94, 0xb2, 0xde, 0xdb, 0x63, 0x0c, 0x8c, 0x71, 0xff,
+    0xff, 0xe7, 0x1c, 0xb5, 0xb6, 0xb5, 0xb6, 0xce, 0x59, 0xa5, 0x34, 0x9c,
+    0xf3, 0x73, 0xae, 0x18, 0xe3, 0x94, 0xb2, 0x18, 0xe3, 0x63, 0x2c, 0xd6,
+    0x9a, 0xce, 0x79, 0xf7, 0xbe, 0xa2, 0xff, 0xff, 0x09, 0xef, 0x5d, 0xad,
+    0x55, 0x00, 0x00, 0x00, 0x00, 0xbd, 0xf7, 0xb5, 0xb6, 0x00, 0x00, 0xff,
+    0xff, 0xce, 0x59, 0xc6, 0x38, 0x92, 0xff, 0xff, 0x04, 0xe7, 0x3c, 0x84,
+    0x10, 0x94, 0x92, 0xb5, 0xb6, 0xe7, 0x3c, 0xf0, 0xff, 0xff, 0xf6, 0xff,
+    0xff, 0x15, 0xff, 0xdf, 0x63, 0x2c, 0x00, 0x00, 0x9c, 0xf3, 0xf7, 0x9e,
+    0x4a, 0x49, 0xd6, 0xba, 0xd6, 0xba, 0x4a, 0x69, 0xff, 0xdf, 0xff, 0xff,
+    0xc6, 0x38, 0x31, 0x86, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x31, 0x86,
+    0x00, 0x00, 0xc6, 0x38, 0xff, 0xff, 0xf7, 0xbe, 0xf7, 0x9e, 0x9f, 0xff,
+    0xff, 0x07, 0x9c, 0xd3, 0x00, 0x00, 0x18, 0xe3, 0x5a, 0xcb, 0x00, 0x00,
+    0x00, 0x00, 0x5a, 0xcb, 0xf7, 0xbe, 0x97, 0xff, 0xff, 0x02, 0x94, 0x92,
+    0x8c, 0x71, 0xff, 0xdf, 0xef, 0xff, 0xff, 0xf7, 0xff, 0xff, 0x15, 0xff,
+    0xdf, 0x8c, 0x71, 0x00, 0x00, 0x63, 0x2c, 0xf7, 0xbe, 0x9c, 0xf3, 0x8c,
+    0x71, 0xff, 0xff, 0xff, 0xff, 0xad, 0x75, 0x00, 0x00, 0x00, 0x00, 0x31,
+    0x86, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x52, 0x8a, 0x29, 0x65, 0x52,
+    0x8a, 0x31, 0xa6, 0x31, 0x86, 0xde, 0xfb, 0x9e, 0xff, 0xff, 0x07, 0xa5,
+    0x34, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0x9c, 0xf3, 0x00, 0x00, 0x5a,
+    0xcb, 0xf7, 0xbe, 0x95, 0xff, 0xff, 0x05, 0xf7, 0xbe, 0x4a, 0x69, 0xd6,
+    0xba, 0xd6, 0xba, 0x4a, 0x69, 0xf7, 0xbe, 0xee, 0xff, 0xff, 0xf8, 0xff,
+    0xff, 0x08, 0xe7, 0x3c, 0xce, 0x79, 0xce, 0x59, 0xad, 0x55, 0xbd, 0xd7,
+    0xef, 0x7d, 0xff, 0xff, 0xad, 0x75, 0xbd, 0xd7, 0x82, 0xd6, 0x9a, 0x0a,
+    0x63, 0x2c, 0x21, 0x04, 0x94, 0xb2, 0x00, 0x00, 0x00, 0x00, 0x8c, 0x51,
+    0xd6, 0xba, 0x18, 0xc3, 0x73, 0xae, 0xa5, 0x14, 0xad, 0x75, 0x9a, 0xff,
+    0xff, 0x09, 0xff, 0xdf, 0xb5, 0x96, 0x5a, 0xeb, 0x00, 0x00, 0x00, 0x00,
+    0x9c, 0xd3, 0xde, 0xdb, 0xad, 0x75, 0x00, 0x00, 0xf7, 0x9e, 0x95, 0xff,
+    0xff, 0x04, 0xff, 0xdf, 0xd6, 0xba, 0xad, 0x75, 0xb5, 0xb6, 0xde, 0xfb,
+    0xef, 0xff, 0xff, 0xfa, 0xff, 0xff, 0x06, 0xff, 0xdf, 0x00, 0x00, 0xd6,
+    0x9a, 0xff, 0xff, 0xc6, 0x18, 0x00, 0x00, 0xce, 0x79, 0x82, 0xff, 0xff,
+    0x07, 0xce, 0x79, 0x8c, 0x71, 0x8c, 0x71, 0xa5, 0x14, 0x39, 0xc7, 0x7b,
+    0xef, 0xd6, 0xba, 0x4a, 0x69, 0x82, 0x00, 0x00, 0x03, 0xc6, 0x18, 0xd6,
+    0xba, 0xd6, 0x9a, 0xde, 0xdb, 0x96, 0xff, 0xff, 0x09, 0xf7, 0x9e, 0x21,
+    0x04, 0x00, 0x00, 0x73, 0x8e, 0xa5, 0x14, 0x00, 0x00, 0xad, 0x75, 0xce,
+    0x79, 0xad, 0x55, 0xff, 0xdf, 0x97, 0xff, 0xff, 0x02, 0x8c, 0x71, 0x5a,
+    0xcb, 0xe7, 0x3c, 0xef, 0xff, 0xff, 0xfa, 0xff, 0xff, 0x06, 0xf7, 0xbe,
+    0x63, 0x2c, 0xde, 0xfb, 0xde, 0xdb, 0x00, 0x00, 0x29, 0x65, 0xde, 0xdb,
+    0x86, 0xff, 0xff, 0x02, 0xb5, 0x96, 0x00, 0x00, 0x29, 0x65, 0x82, 0x00,
+    0x00, 0x07, 0x08, 0x61, 0x39, 0xc7, 0x00, 0x00, 0x00, 0x00, 0x31, 0x86,
+    0xef, 0x5d, 0xf7, 0xbe, 0xff, 0xdf, 0x93, 0xff, 0xff, 0x07, 0xf7, 0xbe,
+    0x52, 0xaa, 0x00, 0x00, 0xa5, 0x34, 0xf7, 0xbe, 0x52, 0xaa, 0x00, 0x00,
+    0xad, 0x55, 0x99, 0xff, 0xff, 0x03, 0xa5, 0x14, 0x00, 0x00, 0x31, 0xa6,
+    0xf7, 0x9e, 0xee, 0xff, 0xff, 0xfb, 0xff, 0xff, 0x04, 0xf7, 0xbe, 0xff,
+    0xff, 0xce, 0x79, 0x29, 0x65, 0xef, 0x7d, 0x87, 0xff, 0xff, 0x0d, 0xff,
+    0xdf, 0xf7, 0xbe, 0xef, 0x5d, 0x31, 0x86, 0x00, 0x00, 0x00, 0x00, 0x5a,
+    0xcb, 0xf7, 0xbe, 0xa5, 0x34, 0x00, 0x00, 0x00, 0x00, 0x29, 0x65, 0x00,
+    0x00, 0xb5, 0x96, 0x93, 0xff, 0xff, 0x06, 0xff, 0xdf, 0x5a, 0xcb, 0x00,
+    0x00, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0xce, 0x79, 0x9a, 0xff, 0xff,
+    0x03, 0x9c, 0xf3, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xee, 0xff, 0xff,
+    0xfd, 0xff, 0xff, 0x03, 0xce, 0x59, 0x00, 0x00, 0x84, 0x10, 0xe7, 0x1c,
+    0x89, 0xff, 0xff, 0x0b, 0xde, 0xdb, 0xde, 0xdb, 0xa5, 0x34, 0x00, 0x00,
+    0x94, 0xb2, 0x4a, 0x49, 0x00, 0x00, 0x4a, 0x69, 0xd6, 0xba, 0x6b, 0x6d,
+    0x00, 0x00, 0xb5, 0x96, 0x91, 0xff, 0xff, 0x08, 0xef, 0x7d, 0x8c, 0x71,
+    0x00, 0x00, 0xc6, 0x18, 0xbd, 0xd7, 0x00, 0x00, 0x00, 0x00, 0x6b, 0x4d,
+    0xce, 0x79, 0x98, 0xff, 0xff, 0x04, 0xad, 0x55, 0xd6, 0x9a, 0xad, 0x75,
+    0x00, 0x00, 0xf7, 0x9e, 0xee, 0xff, 0xff, 0xfd, 0xff, 0xff, 0x03, 0xe7,
+    0x3c, 0x94, 0xb2, 0x84, 0x30, 0xde, 0xfb, 0x8b, 0xff, 0xff, 0x0b, 0xef,
+    0x5d, 0x94, 0xb2, 0x8c, 0x71, 0xa5, 0x14, 0x7b, 0xcf, 0x18, 0xe3, 0xd6,
+    0xba, 0xce, 0x59, 0x73, 0x8e, 0x00, 0x00, 0xc6, 0x38, 0xf7, 0xbe, 0x8e,
+    0xff, 0xff, 0x0a, 0xef, 0x5d, 0xa5, 0x14, 0x00, 0x00, 0x00, 0x00, 0xbd,
+    0xd7, 0xde, 0xdb, 0x9c, 0xf3, 0x21, 0x24, 0x63, 0x2c, 0xad, 0x75, 0xde,
+    0xdb, 0x94, 0xff, 0xff, 0x07, 0xe7, 0x3c, 0xd6, 0x9a, 0xc6, 0x38, 0x00,
+    0x00, 0xb5, 0x96, 0xd6, 0x9a, 0xad, 0x55, 0xff, 0xdf, 0xee, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0x91, 0xff, 0xff, 0x07, 0xde, 0xfb, 0x21, 0x24, 0x00,
+    0x00, 0xd6, 0xba, 0xde, 0xdb, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x38, 0x8e,
+    0xff, 0xff, 0x0b, 0x9c, 0xd3, 0x00, 0x00, 0x18, 0xe3, 0x5a, 0xcb, 0x00,
+    0x00, 0x9c, 0xd3, 0xf7, 0xbe, 0x31, 0x86, 0xde, 0xfb, 0xde, 0xfb, 0x00,
+    0x00, 0xef, 0x5d, 0x91, 0xff, 0xff, 0x02, 0xf7, 0xbe, 0xff, 0xdf, 0x94,
+    0x92, 0x83, 0x00, 0x00, 0x00, 0x9c, 0xf3, 0xf0, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x92, 0xff, 0xff, 0x03, 0xef, 0x5d, 0x21, 0x24, 0x18, 0xe3, 0x52,
+    0x8a, 0x82, 0x00, 0x00, 0x00, 0xad, 0x75, 0x8d, 0xff, 0xff, 0x0c, 0xa5,
+    0x34, 0x00, 0x00, 0x52, 0xaa, 0xf7, 0xbe, 0xa5, 0x14, 0x00, 0x00, 0x52,
+    0xaa, 0x00, 0x00, 0xe7, 0x3c, 0xe7, 0x1c, 0x00, 0x00, 0x29, 0x45, 0xde,
+    0xdb, 0x8f, 0xff, 0xff, 0x03, 0xde, 0xfb, 0x31, 0xa6, 0x5a, 0xcb, 0x31,
+    0xa6, 0x83, 0x00, 0x00, 0x00, 0x9c, 0xd3, 0xf0, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x06, 0xff, 0xff, 0xb5, 0xb6, 0xbd, 0xd7, 0xff, 0xff, 0xff, 0xff,
+    0xbd, 0xd7, 0xbd, 0xd7, 0x8c, 0xff, 0xff, 0x06, 0xde, 0xfb, 0x7b, 0xcf,
+    0x00, 0x00, 0x00, 0x00, 0xde, 0xdb, 0x73, 0x8e, 0x94, 0xb2, 0x8c, 0xff,
+    0xff, 0x05, 0xb5, 0x96, 0x31, 0xa6, 0x00, 0x00, 0x31, 0xa6, 0x94, 0xb2,
+    0x4a, 0x69, 0x82, 0x00, 0x00, 0x04, 0x5a, 0xeb, 0xbd, 0xd7, 0xd6, 0xba,
+    0x00, 0x00, 0xd6, 0xba, 0x8d, 0xff, 0xff, 0x02, 0xad, 0x75, 0xa5, 0x14,
+    0x84, 0x10, 0x82, 0x00, 0x00, 0x04, 0x73, 0xae, 0xde, 0xdb, 0xd6, 0x9a,
+    0xce, 0x79, 0xe7, 0x1c, 0xf0, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0b, 0xff,
+    0xff, 0xbd, 0xf7, 0x9c, 0xf3, 0xd6, 0x9a, 0xd6, 0x9a, 0xa5, 0x14, 0x9c,
+    0xf3, 0xd6, 0xba, 0xff, 0xff, 0xe7, 0x3c, 0xce, 0x59, 0xde, 0xdb, 0x88,
+    0xff, 0xff, 0x06, 0x9c, 0xf3, 0x10, 0xa2, 0xb5, 0x96, 0xde, 0xdb, 0x73,
+    0xae, 0x63, 0x2c, 0xde, 0xfb, 0x89, 0xff, 0xff, 0x07, 0xf7, 0xbe, 0xc6,
+    0x38, 0x00, 0x00, 0x84, 0x10, 0x94, 0x92, 0x00, 0x20, 0x84, 0x30, 0x9c,
+    0xf3, 0x82, 0xa5, 0x14, 0x12, 0x8c, 0x71, 0xb5, 0x96, 0xd6, 0x9a, 0x00,
+    0x00, 0xa5, 0x34, 0xde, 0xdb, 0xd6, 0x9a, 0xd6, 0x9a, 0xce, 0x79, 0xe7,
+    0x3c, 0xff, 0xff, 0xd6, 0xba, 0xf7, 0xbe, 0xf7, 0xbe, 0xd6, 0xba, 0xff,
+    0xff, 0xe7, 0x3c, 0xd6, 0x9a, 0xc6, 0x38, 0x82, 0x00, 0x00, 0x03, 0x08,
+    0x41, 0x9c, 0xd3, 0x94, 0xb2, 0xce, 0x79, 0xf4, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x0d, 0xff, 0xff, 0xff, 0xff, 0xde, 0xdb, 0x00, 0x00, 0x00, 0x00,
+    0xe7, 0x3c, 0xe7, 0x1c, 0x42, 0x28, 0xf7, 0x9e, 0x94, 0xb2, 0x00, 0x00,
+    0x29, 0x65, 0xef, 0x5d, 0xff, 0xdf, 0x85, 0xf7, 0xbe, 0x08, 0xff, 0xdf,
+    0x9c, 0xd3, 0xa5, 0x34, 0xf7, 0xbe, 0x63, 0x2c, 0x42, 0x08, 0x10, 0xa2,
+    0x21, 0x24, 0xef, 0x5d, 0x86, 0xff, 0xff, 0x08, 0xf7, 0xbe, 0xff, 0xff,
+    0xc6, 0x38, 0x00, 0x00, 0x00, 0x00, 0xde, 0xdb, 0xd6, 0xba, 0x39, 0xc7,
+    0xff, 0xdf, 0x84, 0xff, 0xff, 0x02, 0xde, 0xdb, 0x00, 0x00, 0x52, 0xaa,
+    0x84, 0x00, 0x00, 0x0e, 0x9c, 0xd3, 0xef, 0x7d, 0x00, 0x00, 0xce, 0x79,
+    0xce, 0x79, 0x00, 0x00, 0xef, 0x7d, 0x9c, 0xd3, 0x00, 0x00, 0x00, 0x00,
+    0x52, 0x8a, 0x5a, 0xcb, 0x42, 0x08, 0x7b, 0xcf, 0xff, 0xdf, 0xf6, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0x08, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xf7,
+    0x9e, 0xf7, 0x9e, 0xff, 0xff, 0xff, 0xff, 0xef, 0x5d, 0x63, 0x0c, 0x82,
+    0x00, 0x00, 0x11, 0x29, 0x45, 0x4a, 0x69, 0x5a, 0xcb, 0x52, 0xaa, 0x5a,
+    0xcb, 0x42, 0x08, 0x42, 0x08, 0x52, 0xaa, 0x39, 0xc7, 0xde, 0xfb, 0xde,
+    0xdb, 0x63, 0x2c, 0xf7, 0x9e, 0xff, 0xff, 0xce, 0x59, 0x00, 0x00, 0x21,
+    0x24, 0xde, 0xfb, 0x84, 0xff, 0xff, 0x09, 0xff, 0xdf, 0x7b, 0xcf, 0x4a,
+    0x49, 0x42, 0x28, 0x00, 0x00, 0x00, 0x00, 0x42, 0x08, 0x18, 0xe3, 0x31,
+    0x86, 0xf7, 0xbe, 0x84, 0xff, 0xff, 0x03, 0xff, 0xdf, 0xf7, 0x9e, 0xff,
+    0xdf, 0x94, 0x92, 0x83, 0x00, 0x00, 0x0d, 0x21, 0x24, 0x29, 0x65, 0x00,
+    0x00, 0x39, 0xe7, 0x39, 0xe7, 0x00, 0x00, 0x52, 0xaa, 0x00, 0x00, 0x00,
+    0x00, 0x31, 0x86, 0xef, 0x5d, 0xff, 0xdf, 0xf7, 0xbe, 0xf7, 0xbe, 0xf7,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0x87, 0xff, 0xff, 0x01, 0xd6, 0x9a, 0xce,
+    0x79, 0x82, 0xd6, 0x9a, 0x00, 0x63, 0x2c, 0x82, 0x00, 0x00, 0x0d, 0xb5,
+    0xb6, 0xbd, 0xf7, 0x00, 0x00, 0x00, 0x00, 0x8c, 0x51, 0x84, 0x30, 0x00,
+    0x00, 0x9c, 0xf3, 0xa5, 0x34, 0xc6, 0x18, 0xd6, 0xba, 0x18, 0xe3, 0x73,
+    0xae, 0xa5, 0x34, 0x83, 0xa5, 0x14, 0x00, 0x9c, 0xd3, 0x82, 0x00, 0x00,
+    0x04, 0x4a, 0x69, 0xde, 0xdb, 0x6b, 0x4d, 0x4a, 0x49, 0xde, 0xfb, 0x88,
+    0xff, 0xff, 0x0e, 0xe7, 0x3c, 0xce, 0x79, 0xd6, 0x9a, 0xde, 0xdb, 0x5a,
+    0xeb, 0x63, 0x2c, 0xde, 0xfb, 0xe7, 0x3c, 0x73, 0xae, 0x73, 0x8e, 0xce,
+    0x79, 0x00, 0x00, 0x9c, 0xf3, 0xde, 0xdb, 0xde, 0xdb, 0xfb, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0x8c, 0xff, 0xff, 0x0f, 0xce, 0x79, 0x94, 0xb2, 0xa5,
+    0x14, 0x9c, 0xf3, 0xd6, 0x9a, 0xb5, 0x96, 0x00, 0x00, 0x9c, 0xf3, 0x29,
+    0x45, 0x29, 0x65, 0x9c, 0xf3, 0x00, 0x00, 0x00, 0x00, 0x7b, 0xcf, 0xd6,
+    0xba, 0x4a, 0x69, 0x89, 0x00, 0x00, 0x03, 0x31, 0x86, 0xd6, 0x9a, 0xb5,
+    0x96, 0xce, 0x59, 0x8d, 0xff, 0xff, 0x08, 0xce, 0x59, 0xad, 0x75, 0xde,
+    0xdb, 0xde, 0xfb, 0x63, 0x2c, 0x9c, 0xd3, 0xff, 0xff, 0xa5, 0x34, 0xe7,
+    0x3c, 0xfd, 0xff, 0xff, 0xff, 0xff, 0xff, 0x90, 0xff, 0xff, 0x10, 0xad,
+    0x55, 0x00, 0x00, 0x7b, 0xcf, 0xff, 0xff, 0xad, 0x55, 0xad, 0x55, 0xff,
+    0xff, 0x7b, 0xcf, 0x42, 0x28, 0x4a, 0x69, 0x29, 0x65, 0x00, 0x00, 0x4a,
+    0x49, 0x42, 0x28, 0x00, 0x00, 0x52, 0x8a, 0x5a, 0xcb, 0x83, 0x52, 0xaa,
+    0x03, 0x5a, 0xcb, 0x52, 0x8a, 0x00, 0x00, 0xde, 0xdb, 0x8f, 0xff, 0xff,
+    0x04, 0xde, 0xdb, 0x00, 0x00, 0x29, 0x65, 0x00, 0x00, 0xad, 0x75, 0xff,
+    0xff, 0xff, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0x90, 0xff, 0xff, 0x10,
+    0xff, 0xdf, 0xf7, 0x9e, 0xf7, 0xbe, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xdf,
+    0xff, 0xff, 0xf7, 0xbe, 0xf7, 0xbe, 0xff, 0xdf, 0xef, 0x5d, 0x00, 0x00,
+    0xce, 0x79, 0xce, 0x79, 0x00, 0x00, 0xef, 0x5d, 0xff, 0xdf, 0x85, 0xf7,
+    0xbe, 0x01, 0xf7, 0x9e, 0xff, 0xdf, 0x8f, 0xff, 0xff, 0x00, 0xff, 0xdf,
+    0x82, 0xf7, 0x9e, 0x00, 0xff, 0xdf, 0xff, 0xff, 0xff, 0x00, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0x9b, 0xff, 0xff, 0x03, 0xd6, 0xba, 0xf7, 0xbe, 0xf7,
+    0xbe, 0xd6, 0xba, 0xff, 0xff, 0xff, 0x9f, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff,
+};
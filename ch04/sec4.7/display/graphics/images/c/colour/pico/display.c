@@ -512,6 +512,124 @@ display_error_t display_blit_full(const uint16_t *pixels) {
     return result;
 }
 
+// Two rows of pixels, high byte first, for the image blitters: one is
+// filled while DMA sends the other
+static uint8_t image_line[2][DISPLAY_WIDTH * 2];
+
+// RLE image asset: "R5", width, height (uint16, little endian), then the
+// rows as packets: a count byte n, then n + 1 literal pixels for n < 128
+// or one pixel repeated n - 127 times. Pixels are already high byte first
+
+display_error_t display_draw_rle(uint16_t x, uint16_t y, const uint8_t *image, uint8_t scale) {
+    if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
+    if (!image || image[0] != 'R' || image[1] != '5' || scale == 0) return DISPLAY_ERROR_INVALID_PARAM;
+
+    uint32_t width = image[2] | (image[3] << 8);
+    uint32_t height = image[4] | (image[5] << 8);
+    if (width == 0 || height == 0) return DISPLAY_ERROR_INVALID_PARAM;
+    if (x + width * scale > DISPLAY_WIDTH || y + height * scale > DISPLAY_HEIGHT) {
+        return DISPLAY_ERROR_INVALID_PARAM;
+    }
+
+    display_error_t result = display_set_window(x, y, x + width * scale - 1, y + height * scale - 1);
+    if (result != DISPLAY_OK) return result;
+
+    dma_wait_for_finish();
+    gpio_put(DISPLAY_DC_PIN, 1);
+    gpio_put(DISPLAY_CS_PIN, 0);
+
+    const uint8_t *src = image + 6;
+    int line = 0;
+    for (uint32_t row = 0; row < height && result == DISPLAY_OK; row++) {
+        // Decode into the buffer DMA is not reading from
+        uint8_t *out = image_line[line];
+        uint32_t col = 0;
+        while (col < width) {
+            uint8_t n = *src++;
+            uint32_t count = (n & 0x7F) + 1;
+            if (col + count > width) {
+                result = DISPLAY_ERROR_INVALID_PARAM;   // packet past the row
+                break;
+            }
+            for (uint32_t i = 0; i < count; i++) {
+                const uint8_t *pixel = (n & 0x80) ? src : src + i * 2;
+                for (uint8_t s = 0; s < scale; s++) {
+                    *out++ = pixel[0];
+                    *out++ = pixel[1];
+                }
+            }
+            src += (n & 0x80) ? 2 : count * 2;
+            col += count;
+        }
+        if (result != DISPLAY_OK) break;
+
+        // Each transfer waits for the one before, then returns at once
+        for (uint8_t s = 0; s < scale && result == DISPLAY_OK; s++) {
+            result = dma_spi_write_buffer(image_line[line], width * scale * 2);
+        }
+        line ^= 1;
+    }
+
+    // Must wait for DMA to complete before raising CS
+    dma_wait_for_finish();
+    gpio_put(DISPLAY_CS_PIN, 1);
+    return result;
+}
+
+// Header fields byte by byte: the asset need not be aligned, and the
+// M0+ faults on an unaligned word load
+static uint32_t bmp_u32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+display_error_t display_draw_bmp(uint16_t x, uint16_t y, const uint8_t *bmp, uint32_t bmp_size) {
+    if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
+    if (!bmp || bmp_size < 54 || bmp[0] != 'B' || bmp[1] != 'M') return DISPLAY_ERROR_INVALID_PARAM;
+
+    uint32_t data_offset = bmp_u32(bmp + 10);
+    uint32_t width = bmp_u32(bmp + 18);
+    int32_t height = (int32_t)bmp_u32(bmp + 22);
+    uint16_t bpp = bmp[28] | (bmp[29] << 8);
+    uint32_t compression = bmp_u32(bmp + 30);
+    bool top_down = height < 0;
+    uint32_t rows = top_down ? (uint32_t)-height : (uint32_t)height;
+
+    if (bpp != 24 || compression != 0 || width == 0 || rows == 0) return DISPLAY_ERROR_INVALID_PARAM;
+    if (x + width > DISPLAY_WIDTH || y + rows > DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
+
+    // Rows are padded to a multiple of four bytes
+    uint32_t stride = (width * 3 + 3) & ~3u;
+    if (data_offset > bmp_size || stride * rows > bmp_size - data_offset) return DISPLAY_ERROR_INVALID_PARAM;
+
+    display_error_t result = display_set_window(x, y, x + width - 1, y + rows - 1);
+    if (result != DISPLAY_OK) return result;
+
+    dma_wait_for_finish();
+    gpio_put(DISPLAY_DC_PIN, 1);
+    gpio_put(DISPLAY_CS_PIN, 0);
+
+    int line = 0;
+    for (uint32_t row = 0; row < rows && result == DISPLAY_OK; row++) {
+        const uint8_t *src = bmp + data_offset + (top_down ? row : rows - 1 - row) * stride;
+        uint8_t *out = image_line[line];
+        for (uint32_t col = 0; col < width; col++, src += 3) {
+            // BGR888 to RGB565
+            uint16_t pixel = ((src[2] & 0xF8) << 8) | ((src[1] & 0xFC) << 3) | (src[0] >> 3);
+            *out++ = pixel >> 8;
+            *out++ = pixel & 0xFF;
+        }
+
+        // Waits for the row before, which went from the other buffer
+        result = dma_spi_write_buffer(image_line[line], width * 2);
+        line ^= 1;
+    }
+
+    // Must wait for DMA to complete before raising CS
+    dma_wait_for_finish();
+    gpio_put(DISPLAY_CS_PIN, 1);
+    return result;
+}
+
 display_error_t display_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg_color) {
     if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
     if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
@@ -4,6 +4,7 @@
 #include "pico/stdlib.h"
 #include "display.h"
 #include "test_pattern.h"
+#include "test_pattern_rle.h"
 
 typedef enum {
     MODE_TEST_PATTERN = 0,
@@ -32,16 +33,9 @@ void str_to_upper(char *str) {
 void draw_test_pattern(void) {
     printf("Drawing test pattern..\n");
     
-    // Draw the pattern efficiently - scale 5x
-    for (int y = 0; y < TEST_PATTERN_HEIGHT; y++) {
-        for (int x = 0; x < TEST_PATTERN_WIDTH; x++) {
-            uint16_t color = test_pattern[y][x];
-            display_fill_rect(x * 5, y * 5, 5, 5, color);
-        }
-        if (y % 8 == 0) {
-            tight_loop_contents(); // Yield to system
-        }
-    }
+    // Draw the pattern from its RLE asset, scaled 5x, decoded a row at
+    // a time as it goes out
+    display_draw_rle(0, 0, test_pattern_rle, 5);
     
     // Draw title bar
     display_fill_rect(0, 0, 320, 22, COLOR_BLACK);
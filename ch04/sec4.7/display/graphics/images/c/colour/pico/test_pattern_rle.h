@@ -0,0 +1,94 @@
+// test_pattern.ppm: 64x48, RLE image for display_draw_rle(), made by img2rle
+// 1002 bytes, 6144 as plain RGB565
+
+#include <stdint.h>
+
+#define TEST_PATTERN_RLE_WIDTH 64
+#define TEST_PATTERN_RLE_HEIGHT 48
+
+static const uint8_t test_pattern_rle[1002] = {
+    0x52, 0x35, 0x40, 0x00, 0x30, 0x00, 0xbf, 0xff, 0xff, 0xbf, 0xff, 0xff,
+    0xbf, 0xff, 0xff, 0xbf, 0xff, 0xff, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0xff, 0xff, 0x87, 0xff, 0xe0,
+    0x87, 0x07, 0xff, 0x87, 0x07, 0xe0, 0x87, 0xf8, 0x1f, 0x87, 0xf8, 0x00,
+    0x87, 0x00, 0x1f, 0x87, 0x00, 0x00, 0x87, 0x08, 0x41, 0x87, 0x00, 0x00,
+    0x87, 0x18, 0xe3, 0x87, 0x00, 0x00, 0x87, 0x18, 0xe3, 0x87, 0x00, 0x00,
+    0x87, 0x08, 0x41, 0x87, 0x00, 0x00, 0x87, 0x08, 0x41, 0x87, 0x00, 0x00,
+    0x87, 0x18, 0xe3, 0x87, 0x00, 0x00, 0x87, 0x18, 0xe3, 0x87, 0x00, 0x00,
+    0x87, 0x08, 0x41, 0x87, 0x00, 0x00, 0x87, 0x08, 0x41, 0x87, 0x00, 0x00,
+    0x87, 0x18, 0xe3, 0x87, 0x00, 0x00, 0x87, 0x18, 0xe3, 0x87, 0x00, 0x00,
+    0x87, 0x08, 0x41, 0x87, 0x00, 0x00, 0x87, 0x08, 0x41, 0x87, 0x00, 0x00,
+    0x87, 0x18, 0xe3, 0x87, 0x00, 0x00, 0x87, 0x18, 0xe3, 0x87, 0x00, 0x00,
+    0x87, 0x08, 0x41, 0x87, 0x00, 0x00, 0x87, 0x08, 0x41, 0x87, 0x00, 0x00,
+    0x87, 0x18, 0xe3, 0x87, 0x00, 0x00, 0x87, 0x18, 0xe3, 0x87, 0x00, 0x00,
+    0x87, 0x08, 0x41, 0x87, 0x00, 0x00, 0x87, 0x08, 0x41, 0x87, 0x00, 0x00,
+    0x87, 0x18, 0xe3, 0x87, 0x00, 0x00, 0x87, 0x18, 0xe3, 0x87, 0x00, 0x00,
+    0x87, 0x08, 0x41, 0x87, 0x00, 0x00, 0x8f, 0x08, 0x61, 0x8f, 0xff, 0xff,
+    0x8f, 0x08, 0x61, 0x8f, 0x00, 0x00, 0x8f, 0x08, 0x61, 0x8f, 0xff, 0xff,
+    0x8f, 0x08, 0x61, 0x8f, 0x00, 0x00, 0x8f, 0x08, 0x61, 0x8f, 0xff, 0xff,
+    0x8f, 0x08, 0x61, 0x8f, 0x00, 0x00, 0x8f, 0x08, 0x61, 0x8f, 0xff, 0xff,
+    0x8f, 0x08, 0x61, 0x8f, 0x00, 0x00, 0x8f, 0x08, 0x61, 0x8f, 0xff, 0xff,
+    0x8f, 0x08, 0x61, 0x8f, 0x00, 0x00, 0x8f, 0x08, 0x61, 0x8f, 0xff, 0xff,
+    0x8f, 0x08, 0x61, 0x8f, 0x00, 0x00,
+};
@@ -0,0 +1,169 @@
+// img2rle - convert a 24-bit BMP or binary PPM (P6) into an RLE image
+// asset for display_draw_rle(), written as a C header:
+//
+//   ./img2rle image.bmp name > name_rle.h
+//
+// The asset is "R5", width and height as little endian uint16, then the
+// rows top to bottom. A row is packets, none crossing into the next row:
+// a count byte n, then for n < 128 n + 1 literal pixels, for n >= 128 one
+// pixel repeated n - 127 times. Pixels are RGB565 high byte first, the
+// order they go to the display in.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+
+#define MAX_RUN 128
+
+static uint8_t *load_file(const char *path, long *size) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    *size = ftell(f);
+    rewind(f);
+    uint8_t *data = malloc(*size);
+    if (data && fread(data, 1, *size, f) != (size_t)*size) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    return data;
+}
+
+static uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b) {
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+static uint32_t le32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Pixels as RGB565, top row first; NULL if the format is not one we read
+static uint16_t *decode_image(const uint8_t *data, long size, int *width, int *height) {
+    if (size >= 54 && data[0] == 'B' && data[1] == 'M') {
+        uint32_t offset = le32(data + 10);
+        int w = (int)le32(data + 18);
+        int h = (int32_t)le32(data + 22);
+        int bpp = data[28] | (data[29] << 8);
+        if (bpp != 24 || le32(data + 30) != 0 || w <= 0 || h == 0) return NULL;
+
+        int rows = abs(h);
+        long stride = ((long)w * 3 + 3) & ~3L;   // rows are padded to 4 bytes
+        if (offset + stride * rows > (unsigned long)size) return NULL;
+
+        uint16_t *pixels = malloc((size_t)w * rows * sizeof(uint16_t));
+        for (int y = 0; y < rows; y++) {
+            // Negative height: top-down rows, else bottom-up
+            const uint8_t *row = data + offset + stride * (h < 0 ? y : rows - 1 - y);
+            for (int x = 0; x < w; x++) {
+                pixels[y * w + x] = rgb565(row[x * 3 + 2], row[x * 3 + 1], row[x * 3]);
+            }
+        }
+        *width = w;
+        *height = rows;
+        return pixels;
+    }
+
+    if (size >= 2 && data[0] == 'P' && data[1] == '6') {
+        int w, h, max, n;
+        if (sscanf((const char *)data, "P6 %d %d %d%n", &w, &h, &max, &n) != 3 || max != 255) return NULL;
+        const uint8_t *rgb = data + n + 1;   // one whitespace after the header
+        if (w <= 0 || h <= 0 || rgb + (long)w * h * 3 > data + size) return NULL;
+
+        uint16_t *pixels = malloc((size_t)w * h * sizeof(uint16_t));
+        for (long i = 0; i < (long)w * h; i++) {
+            pixels[i] = rgb565(rgb[i * 3], rgb[i * 3 + 1], rgb[i * 3 + 2]);
+        }
+        *width = w;
+        *height = h;
+        return pixels;
+    }
+    return NULL;
+}
+
+static void put_pixel(uint8_t *out, long *len, uint16_t pixel) {
+    out[(*len)++] = pixel >> 8;
+    out[(*len)++] = pixel & 0xFF;
+}
+
+// One row into packets. Runs of three or more are worth a run packet
+// (3 bytes for 6 or more of literal); shorter ones stay literal
+static void encode_row(const uint16_t *row, int width, uint8_t *out, long *len) {
+    int x = 0;
+    while (x < width) {
+        int run = 1;
+        while (x + run < width && run < MAX_RUN && row[x + run] == row[x]) run++;
+        if (run >= 3) {
+            out[(*len)++] = 0x80 | (run - 1);
+            put_pixel(out, len, row[x]);
+            x += run;
+            continue;
+        }
+
+        // Literals up to the next run of three
+        int start = x, count = 0;
+        while (x < width && count < MAX_RUN) {
+            if (x + 2 < width && row[x] == row[x + 1] && row[x] == row[x + 2]) break;
+            x++;
+            count++;
+        }
+        out[(*len)++] = count - 1;
+        for (int i = 0; i < count; i++) put_pixel(out, len, row[start + i]);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <image.bmp | image.ppm> <name>\n", argv[0]);
+        return 1;
+    }
+
+    long size;
+    uint8_t *data = load_file(argv[1], &size);
+    if (!data) {
+        fprintf(stderr, "Cannot read %s\n", argv[1]);
+        return 1;
+    }
+    int width, height;
+    uint16_t *pixels = decode_image(data, size, &width, &height);
+    if (!pixels || width > 0xFFFF || height > 0xFFFF) {
+        fprintf(stderr, "%s: not a 24-bit BMP or P6 PPM\n", argv[1]);
+        return 1;
+    }
+
+    // Worst case every pixel a literal: a count byte per MAX_RUN pixels
+    uint8_t *out = malloc(6 + (size_t)height * (width * 2 + width / MAX_RUN + 1));
+    long len = 0;
+    out[len++] = 'R';
+    out[len++] = '5';
+    out[len++] = width & 0xFF;
+    out[len++] = width >> 8;
+    out[len++] = height & 0xFF;
+    out[len++] = height >> 8;
+    for (int y = 0; y < height; y++) {
+        encode_row(&pixels[(long)y * width], width, out, &len);
+    }
+
+    printf("// %s: %dx%d, RLE image for display_draw_rle(), made by img2rle\n",
+           argv[1], width, height);
+    printf("// %ld bytes, %ld as plain RGB565\n\n", len, (long)width * height * 2);
+    printf("#include <stdint.h>\n\n");
+    char upper[64];
+    snprintf(upper, sizeof(upper), "%s", argv[2]);
+    for (char *c = upper; *c; c++) *c = toupper((unsigned char)*c);
+    printf("#define %s_RLE_WIDTH %d\n#define %s_RLE_HEIGHT %d\n\n", upper, width, upper, height);
+    printf("static const uint8_t %s_rle[%ld] = {", argv[2], len);
+    for (long i = 0; i < len; i++) {
+        printf("%s0x%02x,", i % 12 ? " " : "\n    ", out[i]);
+    }
+    printf("\n};\n");
+
+    fprintf(stderr, "%s: %dx%d, %ld bytes (%ld raw)\n", argv[1], width, height, len,
+            (long)width * height * 2);
+    free(out);
+    free(pixels);
+    free(data);
+    return 0;
+}
@@ -0,0 +1,21 @@
+// pattern2ppm - write the colour demo's test_pattern.h as a PPM, so that
+// img2rle can turn it into an RLE asset
+//
+//   ./pattern2ppm > test_pattern.ppm
+
+#include <stdio.h>
+#include "test_pattern.h"
+
+int main(void) {
+    printf("P6\n%d %d\n255\n", TEST_PATTERN_WIDTH, TEST_PATTERN_HEIGHT);
+    for (int y = 0; y < TEST_PATTERN_HEIGHT; y++) {
+        for (int x = 0; x < TEST_PATTERN_WIDTH; x++) {
+            uint8_t r, g, b;
+            rgb565_to_components(test_pattern[y][x], &r, &g, &b);
+            putchar(scale_5bit_to_8bit(r));
+            putchar(scale_6bit_to_8bit(g));
+            putchar(scale_5bit_to_8bit(b));
+        }
+    }
+    return 0;
+}
@@ -512,6 +512,39 @@ display_error_t display_blit_full(const uint16_t *pixels) {
     return result;
 }
 
+display_error_t display_blit_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                                  const uint16_t *pixels, uint16_t stride) {
+    if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
+    if (!pixels || stride < width) return DISPLAY_ERROR_INVALID_PARAM;
+    if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
+
+    // Clamp dimensions to display bounds
+    if (x + width > DISPLAY_WIDTH) width = DISPLAY_WIDTH - x;
+    if (y + height > DISPLAY_HEIGHT) height = DISPLAY_HEIGHT - y;
+    if (width == 0 || height == 0) return DISPLAY_OK;
+
+    display_error_t result = display_set_window(x, y, x + width - 1, y + height - 1);
+    if (result != DISPLAY_OK) return result;
+
+    dma_wait_for_finish();
+    gpio_put(DISPLAY_DC_PIN, 1);
+    gpio_put(DISPLAY_CS_PIN, 0);
+
+    if (stride == width) {
+        // Rows follow each other in memory: one transfer
+        result = dma_spi_write_buffer((uint8_t *)pixels, (size_t)width * height * 2);
+    } else {
+        // The window wraps rows on its own, so the rows just go out in turn
+        for (uint16_t row = 0; row < height && result == DISPLAY_OK; row++) {
+            result = dma_spi_write_buffer((uint8_t *)&pixels[(size_t)row * stride], width * 2);
+        }
+    }
+    dma_wait_for_finish();
+
+    gpio_put(DISPLAY_CS_PIN, 1);
+    return result;
+}
+
 display_error_t display_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg_color) {
     if (!display_initialized) return DISPLAY_ERROR_NOT_INITIALIZED;
     if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return DISPLAY_ERROR_INVALID_PARAM;
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 
 #include "pico/stdlib.h"
@@ -12,6 +13,13 @@
 #define CENTER_Y 120.0f
 #define RADIUS   100.0f
 
+/* 1: the second hand sweeps, 0: it ticks once a second and most frames
+   send nothing at all */
+#ifndef CLOCK_SWEEP
+#define CLOCK_SWEEP 1
+#endif
+#define FRAME_MS 50
+
 /* Hand “memory” – where the tip of the previous hand was drawn -- one way of avoiding flicker */
 static float last_sec_x = 0, last_sec_y = 0;
 static float last_min_x = 0, last_min_y = 0;
@@ -31,6 +39,74 @@ static int64_t stopwatch_elapsed_ms = 0;   // when stopped
 /* Last drawn values (to avoid unnecessary redraws) */
 static int last_sec = -1, last_min = -1, last_hour = -1;
 
+/* The face is drawn once, into background, RGB565 byte swapped the way
+   display_blit_rect sends it. A hand that moves only marks the boxes
+   around its old and new line; those are put together again from the
+   background and the hands and sent, the rest of the screen stays */
+#define SWAP565(c) ((uint16_t)(((c) >> 8) | ((c) << 8)))
+#define FACE_HEIGHT 220   /* the mode text is below */
+static uint16_t background[DISPLAY_HEIGHT][DISPLAY_WIDTH];
+
+/* Where wu_plot draws: a buffer for the box at target_x, target_y */
+#define TILE_PIXELS (96 * 96)
+static uint16_t tile[TILE_PIXELS];
+static uint16_t *target = &background[0][0];
+static int target_x = 0, target_y = 0;
+static int target_w = DISPLAY_WIDTH, target_h = DISPLAY_HEIGHT;
+
+/* Boxes to send this frame, inclusive. Close ones are merged, as each
+   blit costs a window command, worth about DIRTY_BLIT_COST pixels */
+typedef struct { int x0, y0, x1, y1; } box_t;
+#define MAX_DIRTY 8
+#define DIRTY_BLIT_COST 256
+static box_t dirty[MAX_DIRTY];
+static int dirty_count = 0;
+static bool full_redraw = true;
+
+static int box_area(box_t b) { return (b.x1 - b.x0 + 1) * (b.y1 - b.y0 + 1); }
+
+static box_t box_union(box_t a, box_t b) {
+    box_t u = a;
+    if (b.x0 < u.x0) u.x0 = b.x0;
+    if (b.y0 < u.y0) u.y0 = b.y0;
+    if (b.x1 > u.x1) u.x1 = b.x1;
+    if (b.y1 > u.y1) u.y1 = b.y1;
+    return u;
+}
+
+static void mark_dirty(box_t b) {
+    if (b.x0 < 0) b.x0 = 0;
+    if (b.y0 < 0) b.y0 = 0;
+    if (b.x1 > DISPLAY_WIDTH - 1) b.x1 = DISPLAY_WIDTH - 1;
+    if (b.y1 > FACE_HEIGHT - 1) b.y1 = FACE_HEIGHT - 1;
+    if (b.x0 > b.x1 || b.y0 > b.y1) return;
+
+    /* Grow into a box when that sends fewer extra pixels than a blit
+       costs; the grown box may then pay to join others */
+    for (int i = 0; i < dirty_count; i++) {
+        box_t u = box_union(dirty[i], b);
+        if (box_area(u) <= box_area(dirty[i]) + box_area(b) + DIRTY_BLIT_COST) {
+            b = u;
+            dirty[i] = dirty[--dirty_count];
+            i = -1;
+        }
+    }
+    if (dirty_count == MAX_DIRTY) {
+        dirty[0] = box_union(dirty[0], b);
+        return;
+    }
+    dirty[dirty_count++] = b;
+}
+
+/* The box a line from the centre to the tip covers, with the pixel
+   either side that the anti-aliasing touches */
+static void mark_hand_dirty(float tip_x, float tip_y) {
+    if (tip_x == 0.0f && tip_y == 0.0f) return;
+    box_t b = {(int)floorf(fminf(CENTER_X, tip_x)) - 1, (int)floorf(fminf(CENTER_Y, tip_y)) - 1,
+               (int)floorf(fmaxf(CENTER_X, tip_x)) + 2, (int)floorf(fmaxf(CENTER_Y, tip_y)) + 2};
+    mark_dirty(b);
+}
+
 /* Button callbacks */
 static void btn_a_callback(button_t btn) { (void)btn;
     if (stopwatch_running) {                     // STOP
@@ -52,7 +128,7 @@ static void btn_b_callback(button_t btn) { (void)btn;
     stopwatch_elapsed_ms = 0;
     lap_active = false;
     last_sec = last_min = last_hour = -1;        // force full redraw
-    display_clear(COLOR_BLACK); // ok?
+    full_redraw = true;
 }
 
 static void btn_y_callback(button_t btn) { (void)btn;
@@ -64,6 +140,9 @@ static void btn_y_callback(button_t btn) { (void)btn;
     lap_sec_x = last_sec_x;   lap_sec_y = last_sec_y;
     lap_min_x = last_min_x;   lap_min_y = last_min_y;
     lap_hour_x = last_hour_x; lap_hour_y = last_hour_y;
+    mark_hand_dirty(lap_sec_x, lap_sec_y);
+    mark_hand_dirty(lap_min_x, lap_min_y);
+    mark_hand_dirty(lap_hour_x, lap_hour_y);
 }
 
 /* Bresenham line – "standard" */
@@ -87,20 +166,25 @@ void draw_line2(float x0f, float y0f, float x1f, float y1f, uint16_t color) {
 
 /*  Xiaolin Wu anti-aliased line */
 static void wu_plot(int x, int y, uint8_t brightness, uint16_t color) {
-    if (x < 0 || x >= 320 || y < 0 || y >= 240) return;
+    x -= target_x;
+    y -= target_y;
+    if (x < 0 || x >= target_w || y < 0 || y >= target_h) return;
+
+    uint16_t *pixel = &target[y * target_w + x];
+    uint16_t under = SWAP565(*pixel);
 
     /* Extract 5-6-5 components */
-    uint8_t r5 = (color >> 11) & 0x1F;
-    uint8_t g6 = (color >>  5) & 0x3F;
-    uint8_t b5 =  color        & 0x1F;
+    int r5 = (color >> 11) & 0x1F, ur = (under >> 11) & 0x1F;
+    int g6 = (color >>  5) & 0x3F, ug = (under >>  5) & 0x3F;
+    int b5 =  color        & 0x1F, ub =  under        & 0x1F;
 
-    /* Scale by brightness (0-255) */
-    uint8_t r = (r5 * brightness) >> 8;
-    uint8_t g = (g6 * brightness) >> 8;
-    uint8_t b = (b5 * brightness) >> 8;
+    /* Blend over what is there by brightness (0-255) */
+    int r = (r5 * brightness + ur * (256 - brightness)) >> 8;
+    int g = (g6 * brightness + ug * (256 - brightness)) >> 8;
+    int b = (b5 * brightness + ub * (256 - brightness)) >> 8;
 
     uint16_t blended = (r << 11) | (g << 5) | b;
-    display_draw_pixel(x, y, blended);
+    *pixel = SWAP565(blended);
 }
 
 void draw_line(float x0, float y0, float x1, float y1, uint16_t color) {
@@ -165,7 +249,7 @@ void draw_line(float x0, float y0, float x1, float y1, uint16_t color) {
     }
 }
 
-/* Draw the static clock face (ticks) */
+/* Draw the static clock face (ticks), into the background */
 void draw_face(void) {
     for (int i = 0; i < 12; ++i) {
         float angle = i * 30.0f * (float)M_PI / 180.0f;
@@ -177,21 +261,60 @@ void draw_face(void) {
     }
 }
 
-/* Generic hand drawer – erases previous position if any */
-void draw_hand(float length, float angle_deg, uint16_t color,
+/* Generic hand mover – the boxes of the old and new line are redrawn */
+void draw_hand(float length, float angle_deg,
                float *store_x, float *store_y) {
     float rad = angle_deg * (float)M_PI / 180.0f;
     float x = CENTER_X + length * cosf(rad);
     float y = CENTER_Y + length * sinf(rad);
 
-    /* erase old hand */
-    if (*store_x != 0.0f || *store_y != 0.0f)
-        draw_line(CENTER_X, CENTER_Y, *store_x, *store_y, COLOR_BLACK);
-
-    draw_line(CENTER_X, CENTER_Y, x, y, color);
+    if (x == *store_x && y == *store_y) return;
+    mark_hand_dirty(*store_x, *store_y);
+    mark_hand_dirty(x, y);
     *store_x = x; *store_y = y;
 }
 
+/* All hands, over whatever target holds */
+static void draw_hands(void) {
+    if (last_hour_x != 0.0f || last_hour_y != 0.0f)
+        draw_line(CENTER_X, CENTER_Y, last_hour_x, last_hour_y, COLOR_CYAN);
+    if (last_min_x != 0.0f || last_min_y != 0.0f)
+        draw_line(CENTER_X, CENTER_Y, last_min_x, last_min_y, COLOR_WHITE);
+    if (last_sec_x != 0.0f || last_sec_y != 0.0f)
+        draw_line(CENTER_X, CENTER_Y, last_sec_x, last_sec_y, COLOR_RED);
+    if (lap_active) {
+        if (lap_sec_x != 0.0f || lap_sec_y != 0.0f)
+            draw_line(CENTER_X, CENTER_Y, lap_sec_x, lap_sec_y, COLOR_YELLOW);
+        if (lap_min_x != 0.0f || lap_min_y != 0.0f)
+            draw_line(CENTER_X, CENTER_Y, lap_min_x, lap_min_y, COLOR_YELLOW);
+        if (lap_hour_x != 0.0f || lap_hour_y != 0.0f)
+            draw_line(CENTER_X, CENTER_Y, lap_hour_x, lap_hour_y, COLOR_YELLOW);
+    }
+}
+
+/* Put each dirty box together from the background and the hands, in
+   strips that fit the tile, and send it */
+static void flush_dirty(void) {
+    for (int i = 0; i < dirty_count; i++) {
+        box_t *b = &dirty[i];
+        int w = b->x1 - b->x0 + 1;
+        int strip = TILE_PIXELS / w;
+
+        for (int y = b->y0; y <= b->y1; y += strip) {
+            int h = b->y1 - y + 1 < strip ? b->y1 - y + 1 : strip;
+            for (int row = 0; row < h; row++)
+                memcpy(&tile[row * w], &background[y + row][b->x0], w * sizeof(uint16_t));
+
+            target = tile;
+            target_x = b->x0; target_y = y;
+            target_w = w;     target_h = h;
+            draw_hands();
+            display_blit_rect(b->x0, y, w, h, tile, w);
+        }
+    }
+    dirty_count = 0;
+}
+
 
 int main(void) {
     stdio_init_all();
@@ -205,12 +328,22 @@ int main(void) {
     display_clear(COLOR_BLACK);
     display_set_backlight(true);
     draw_face();
-    display_draw_pixel((int)CENTER_X, (int)CENTER_Y, COLOR_WHITE);
+    background[(int)CENTER_Y][(int)CENTER_X] = SWAP565(COLOR_WHITE);
     last_sec = last_min = last_hour = -1;
 
+    const char *last_mode = NULL;
+    absolute_time_t next_frame = get_absolute_time();
+
     while (1) {
         buttons_update();
 
+        if (full_redraw) {
+            dirty_count = 0;
+            mark_dirty((box_t){0, 0, DISPLAY_WIDTH - 1, FACE_HEIGHT - 1});
+            last_mode = NULL;
+            full_redraw = false;
+        }
+
         int h = 0, m = 0, s = 0, ms = 0;
 
         // * 1. STOPWATCH MODE
@@ -243,15 +376,14 @@ int main(void) {
         }
 
         /* 3. SECOND HAND – always updated (fastest) */
-        float sec_angle = s * 6.0f + ms * 0.006f;
-        draw_hand(90, sec_angle, COLOR_RED, &last_sec_x, &last_sec_y);
-        draw_face(); // always erased otherwise
+        float sec_angle = s * 6.0f + (CLOCK_SWEEP ? ms * 0.006f : 0.0f);
+        draw_hand(90, sec_angle, &last_sec_x, &last_sec_y);
 
 
         /* 4. MINUTE HAND – update only when second changes */
         if (s != last_sec) {
             float min_angle = m * 6.0f + s * 0.1f;
-            draw_hand(80, min_angle, COLOR_WHITE, &last_min_x, &last_min_y);
+            draw_hand(80, min_angle, &last_min_x, &last_min_y);
             last_sec = s;
             last_min = m;  // also
         }
@@ -259,20 +391,12 @@ int main(void) {
         /* 5. HOUR HAND – update only when minute changes */
         if (h != last_hour || m != last_min) {
             float hour_angle = h * 30.0f + m * 0.5f;
-            draw_hand(60, hour_angle, COLOR_CYAN, &last_hour_x, &last_hour_y);
+            draw_hand(60, hour_angle, &last_hour_x, &last_hour_y);
             last_hour = h;
             last_min = m;  // also update last_min here to stay in sync
         }
-        /* 6. LAP HAND (static while active) */
-        if (lap_active) {
-            /* draw once – no erase, just overlay */
-            if (lap_sec_x != 0.0f || lap_sec_y != 0.0f)
-                draw_line(CENTER_X, CENTER_Y, lap_sec_x, lap_sec_y, COLOR_YELLOW);
-            if (lap_min_x != 0.0f || lap_min_y != 0.0f)
-                draw_line(CENTER_X, CENTER_Y, lap_min_x, lap_min_y, COLOR_YELLOW);
-            if (lap_hour_x != 0.0f || lap_hour_y != 0.0f)
-                draw_line(CENTER_X, CENTER_Y, lap_hour_x, lap_hour_y, COLOR_YELLOW);
-        }
+        /* 6. SEND WHAT MOVED – lap hands are drawn in with the others */
+        flush_dirty();
 
         /* 7. MODE TEXT */
         const char *mode;
@@ -283,8 +407,16 @@ int main(void) {
         else
             mode = "CLOCK MODE         (A=START STOPWATCH)";
 
-        display_draw_string(10, 220, mode, COLOR_GREEN, COLOR_BLACK);
+        if (mode != last_mode) {
+            display_draw_string(10, 220, mode, COLOR_GREEN, COLOR_BLACK);
+            last_mode = mode;
+        }
 
-        sleep_ms(50);          // ~20 fps – smooth enough for hands
+        /* ~20 fps – smooth enough for hands; the time not spent drawing
+           is spent asleep */
+        next_frame = delayed_by_ms(next_frame, FRAME_MS);
+        if (absolute_time_diff_us(get_absolute_time(), next_frame) < 0)
+            next_frame = get_absolute_time();     // fell behind, don't catch up
+        sleep_until(next_frame);
     }
 }
@@ -1,121 +1,230 @@
 /*
  * VGF (Vector Graphics Format) Decompressor and Renderer in C
  * For RPi Pico with Pimoroni Display Pack 2.0
+ *
+ * The decoder works on a VGF blob already in memory. On the Pico that is
+ * a const array in flash, read in place through XIP, e.g. from
+ *   xxd -i b8.bin > b8.h   (then make the array const)
+ * Nothing is copied or allocated: shapes are walked with a cursor and
+ * points decoded one at a time as they are drawn.
+ *
+ * Filled shapes go through a scanline rasteriser with an active edge
+ * table, giving horizontal spans. vgf_render_bands() draws the whole
+ * image a band of rows at a time, every shape on those rows in order,
+ * and hands each row on as runs of one colour: to a framebuffer, or
+ * with VGF_USE_DISPLAY straight to display_fill_rect().
+ *
+ * A drawing that is shown over and over, a background say, can instead
+ * be rasterised once per scale into a span cache: each row as runs of
+ * one colour, in RAM, or written out as const arrays for flash. Drawing
+ * it again, or just a part of it, is then only those runs.
  */
 
 #include <stdio.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
-// VGF file header
+#ifdef VGF_USE_DISPLAY
+#include "display.h"
+#endif
+
+// VGF image: the header fields, and where the palette and shapes are
 typedef struct {
+    const uint8_t *data;
+    const uint8_t *end;
     uint16_t width;
     uint16_t height;
     uint8_t num_colors;
-    uint16_t *colors;  // RGB565 format
+    const uint8_t *palette;  // num_colors r, g, b triples
     uint16_t num_shapes;
-} VGFHeader;
+    const uint8_t *shapes;   // first shape record
+    int32_t scale;           // 16.16, applied to every point
+    uint16_t scaled_width;   // the size drawn at that scale
+    uint16_t scaled_height;
+} VGFImage;
 
-// Shape data
+// Shape record, pointing into the blob
 typedef struct {
     uint8_t type;
     uint8_t fill_idx;
     uint8_t stroke_idx;
     uint8_t stroke_width;
     uint16_t num_points;
-    int16_t *points;  // x, y pairs
+    const uint8_t *points;   // first point, then deltas
 } VGFShape;
 
-// Read VGF header
-int vgf_read_header(FILE *f, VGFHeader *header) {
-    uint8_t magic[4];
-    
-    // Check magic number
-    if (fread(magic, 1, 4, f) != 4 || memcmp(magic, "VGF1", 4) != 0) {
+// Walks the shapes of an image in order
+typedef struct {
+    const VGFImage *image;
+    const uint8_t *next;
+    uint16_t index;
+} VGFShapeCursor;
+
+// Walks the points of a shape, decoding the deltas as it goes. No
+// bounds checks: vgf_next_shape() has checked the shape's point data
+typedef struct {
+    const uint8_t *next;
+    uint16_t remaining;
+    bool first;
+    uint16_t x, y;
+    int32_t scale;
+} VGFPointIter;
+
+#define VGF_HEADER_SIZE 9    // magic, width, height, number of colours
+#define VGF_SHAPE_SIZE  6    // type, fill, stroke, width, number of points
+#define VGF_ESCAPE      0x80 // dx of -128: a full int16 dx, dy follows
+
+// Rasteriser limits, all static: edges of one shape (a path of n points
+// has n), rows and width of an image, shapes of an image, rows per band
+#define VGF_MAX_EDGES   1280
+#define VGF_MAX_ROWS    240
+#define VGF_MAX_WIDTH   320
+#define VGF_MAX_SHAPES  1024
+#define VGF_BAND_ROWS   16
+
+typedef enum {
+    VGF_FILL_NONZERO,  // SVG's default
+    VGF_FILL_EVENODD
+} VGFFillRule;
+
+// Receives a horizontal span: width pixels from x on row y
+typedef void (*VGFSpanFn)(void *ctx, int x, int y, int width, uint16_t color);
+
+// Little-endian fields; the blob has no alignment
+static inline uint16_t vgf_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+// Check and open a blob of size bytes; 0 on success, -1 if it is not
+// a VGF image or is cut short
+int vgf_open(const uint8_t *data, size_t size, VGFImage *image) {
+    if (size < VGF_HEADER_SIZE || memcmp(data, "VGF1", 4) != 0) {
         return -1;
     }
-    
-    // Read dimensions
-    fread(&header->width, 2, 1, f);
-    fread(&header->height, 2, 1, f);
-    
-    // Read color palette
-    fread(&header->num_colors, 1, 1, f);
-    header->colors = malloc(header->num_colors * sizeof(uint16_t));
-    
-    for (int i = 0; i < header->num_colors; i++) {
-        uint8_t r, g, b;
-        fread(&r, 1, 1, f);
-        fread(&g, 1, 1, f);
-        fread(&b, 1, 1, f);
-        
-        // Convert to RGB565
-        header->colors[i] = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
-    }
-    
-    // Read number of shapes
-    fread(&header->num_shapes, 2, 1, f);
-    
+
+    image->data = data;
+    image->end = data + size;
+    image->width = vgf_u16(data + 4);
+    image->height = vgf_u16(data + 6);
+    image->num_colors = data[8];
+    image->palette = data + VGF_HEADER_SIZE;
+
+    const uint8_t *p = image->palette + image->num_colors * 3;
+    if (p + 2 > image->end) return -1;
+    image->num_shapes = vgf_u16(p);
+    image->shapes = p + 2;
+
+    image->scale = 1 << 16;
+    image->scaled_width = image->width;
+    image->scaled_height = image->height;
     return 0;
 }
 
-// Read next shape from file
-int vgf_read_shape(FILE *f, VGFShape *shape) {
-    fread(&shape->type, 1, 1, f);
-    fread(&shape->fill_idx, 1, 1, f);
-    fread(&shape->stroke_idx, 1, 1, f);
-    fread(&shape->stroke_width, 1, 1, f);
-    fread(&shape->num_points, 2, 1, f);
-    
-    if (shape->num_points == 0) {
-        shape->points = NULL;
-        return 0;
+// Draw the image scaled by scale (16.16) from now on; points are scaled
+// and rounded as they are decoded
+void vgf_set_scale(VGFImage *image, int32_t scale) {
+    image->scale = scale;
+    image->scaled_width = (uint16_t)(((int64_t)image->width * scale + 0xFFFF) >> 16);
+    image->scaled_height = (uint16_t)(((int64_t)image->height * scale + 0xFFFF) >> 16);
+}
+
+// Palette entry as RGB565, converted when asked for
+uint16_t vgf_color(const VGFImage *image, uint8_t idx) {
+    if (idx >= image->num_colors) return 0;
+    const uint8_t *rgb = image->palette + idx * 3;
+    return ((rgb[0] & 0xF8) << 8) | ((rgb[1] & 0xFC) << 3) | (rgb[2] >> 3);
+}
+
+void vgf_shapes_begin(const VGFImage *image, VGFShapeCursor *cursor) {
+    cursor->image = image;
+    cursor->next = image->shapes;
+    cursor->index = 0;
+}
+
+// Bytes of point data from p for num_points points, or 0 past end
+static size_t vgf_points_size(const uint8_t *p, const uint8_t *end, uint16_t num_points) {
+    if (num_points == 0) return 0;
+
+    const uint8_t *start = p;
+    p += 4;
+    for (uint16_t i = 1; i < num_points && p < end; i++) {
+        p += (*p == VGF_ESCAPE) ? 5 : 2;
     }
-    
-    // Allocate points array
-    shape->points = malloc(shape->num_points * 2 * sizeof(int16_t));
-    
-    // Read first point (absolute)
-    uint16_t x, y;
-    fread(&x, 2, 1, f);
-    fread(&y, 2, 1, f);
-    shape->points[0] = x;
-    shape->points[1] = y;
-    
-    // Read remaining points (delta encoded)
-    for (int i = 1; i < shape->num_points; i++) {
-        int8_t dx;
-        int16_t dy;
-        
-        fread(&dx, 1, 1, f);
-        
-        if (dx == -128) {  // Escape sequence
-            int16_t full_dx, full_dy;
-            fread(&full_dx, 2, 1, f);
-            fread(&full_dy, 2, 1, f);
-            x += full_dx;
-            y += full_dy;
-        } else {
-            int8_t dy_byte;
-            fread(&dy_byte, 1, 1, f);
-            x += dx;
-            y += dy_byte;
-        }
-        
-        shape->points[i * 2] = x;
-        shape->points[i * 2 + 1] = y;
+    return p <= end ? (size_t)(p - start) : 0;
+}
+
+// Shape record at p; its point data has been checked
+static void vgf_parse_shape(const uint8_t *p, VGFShape *shape) {
+    shape->type = p[0];
+    shape->fill_idx = p[1];
+    shape->stroke_idx = p[2];
+    shape->stroke_width = p[3];
+    shape->num_points = vgf_u16(p + 4);
+    shape->points = p + VGF_SHAPE_SIZE;
+}
+
+// Next shape, false after the last one or at a truncated record. The
+// points are not decoded here, only stepped over to find the next record
+bool vgf_next_shape(VGFShapeCursor *cursor, VGFShape *shape) {
+    const VGFImage *image = cursor->image;
+    const uint8_t *p = cursor->next;
+
+    if (cursor->index >= image->num_shapes || p + VGF_SHAPE_SIZE > image->end) {
+        return false;
     }
-    
-    return 0;
+
+    vgf_parse_shape(p, shape);
+
+    size_t size = vgf_points_size(shape->points, image->end, shape->num_points);
+    if (shape->num_points > 0 && size == 0) return false;
+
+    cursor->next = shape->points + size;
+    cursor->index++;
+    return true;
+}
+
+void vgf_points_begin(const VGFImage *image, const VGFShape *shape, VGFPointIter *it) {
+    it->scale = image->scale;
+    it->next = shape->points;
+    it->remaining = shape->num_points;
+    it->first = true;
+    it->x = 0;
+    it->y = 0;
 }
 
-// Free shape memory
-void vgf_free_shape(VGFShape *shape) {
-    if (shape->points) {
-        free(shape->points);
-        shape->points = NULL;
+// Next point of the shape in *x, *y; false when there are no more
+bool vgf_next_point(VGFPointIter *it, int16_t *x, int16_t *y) {
+    if (it->remaining == 0) return false;
+    const uint8_t *p = it->next;
+
+    if (it->first) {
+        // First point (absolute)
+        it->x = vgf_u16(p);
+        it->y = vgf_u16(p + 2);
+        it->next = p + 4;
+        it->first = false;
+    } else if (*p == VGF_ESCAPE) {
+        // Escape sequence
+        it->x += (int16_t)vgf_u16(p + 1);
+        it->y += (int16_t)vgf_u16(p + 3);
+        it->next = p + 5;
+    } else {
+        it->x += (int8_t)p[0];
+        it->y += (int8_t)p[1];
+        it->next = p + 2;
+    }
+
+    it->remaining--;
+    *x = (int16_t)it->x;
+    *y = (int16_t)it->y;
+    if (it->scale != 1 << 16) {
+        *x = (int16_t)(((int64_t)*x * it->scale + 0x8000) >> 16);
+        *y = (int16_t)(((int64_t)*y * it->scale + 0x8000) >> 16);
     }
+    return true;
 }
 
 // Simple line drawing (Bresenham's algorithm)
@@ -146,32 +255,417 @@ void draw_line(uint16_t *framebuffer, int width, int height,
     }
 }
 
-// Render shape to framebuffer
+// Scanline fill. An edge covers the rows whose centre, y + 0.5, lies in
+// [top, bottom) of the edge; x is where it crosses the current row's
+// centre, in 16.16, stepped by dxdy from row to row. The remainder of
+// the 16.16 division is carried as well, so x stays exactly the 16.16
+// floor of the crossing: a shape gets the same pixels whichever row it
+// is started from, and a band edge matches the whole shape's
+typedef struct {
+    int32_t x;
+    int32_t dxdy;
+    int32_t rem;       // x's fraction below 16.16, in 1/den
+    int32_t dxdy_rem;
+    int32_t den;
+    int16_t y0, y1;    // rows y0 .. y1 - 1
+    int8_t dir;        // +1 going down, -1 going up, for non-zero
+} VGFEdge;
+
+static VGFEdge edges[VGF_MAX_EDGES];
+static uint16_t edge_order[VGF_MAX_EDGES];   // edge table: by first row
+static uint16_t active[VGF_MAX_EDGES];       // active edges, by x
+static uint16_t row_start[VGF_MAX_ROWS + 1];
+
+// First pixel whose centre is at or right of x (16.16)
+static inline int vgf_pixel_at(int32_t x) {
+    return (x + 0x7FFF) >> 16;
+}
+
+// Add the edge (xa, ya) - (xb, yb), cut to rows row0 .. row1 - 1
+static int vgf_add_edge(int count, int xa, int ya, int xb, int yb, int row0, int row1) {
+    if (ya == yb) return count;  // Horizontal edges cross no row centre
+
+    int8_t dir = 1;
+    if (ya > yb) {
+        int t = xa; xa = xb; xb = t;
+        t = ya; ya = yb; yb = t;
+        dir = -1;
+    }
+
+    int y0 = ya > row0 ? ya : row0;
+    int y1 = yb < row1 ? yb : row1;
+    if (y0 >= y1 || count == VGF_MAX_EDGES) return count;
+
+    // In units of 1/den, den = 2 (yb - ya): a row is 2 dx and the first
+    // row's centre (2 (y0 - ya) + 1) dx past xa
+    VGFEdge *e = &edges[count];
+    int64_t dx = (int64_t)(xb - xa) * 65536;
+    int32_t den = 2 * (yb - ya);
+    int64_t start = dx * (2 * (y0 - ya) + 1);
+    int64_t step = 2 * dx;
+    int64_t q = start / den, r = start % den;
+    if (r < 0) { q--; r += den; }
+    e->x = xa * 65536 + (int32_t)q;
+    e->rem = (int32_t)r;
+    q = step / den;
+    r = step % den;
+    if (r < 0) { q--; r += den; }
+    e->dxdy = (int32_t)q;
+    e->dxdy_rem = (int32_t)r;
+    e->den = den;
+    e->y0 = y0;
+    e->y1 = y1;
+    e->dir = dir;
+    return count + 1;
+}
+
+// Fill a shape's rows row0 .. row1 - 1 with the colour, as spans cut to
+// 0 .. width - 1. The path is closed from its last point to its first
+void vgf_fill_shape(const VGFImage *image, const VGFShape *shape, VGFFillRule rule,
+                    int row0, int row1, int width,
+                    uint16_t color, VGFSpanFn span, void *ctx) {
+    if (shape->num_points < 3) return;
+    if (row0 < 0) row0 = 0;
+    if (row1 > VGF_MAX_ROWS) row1 = VGF_MAX_ROWS;
+    if (row0 >= row1) return;
+
+    // Edges that reach the rows, from the points as they are decoded
+    VGFPointIter it;
+    int16_t first_x = 0, first_y = 0, x0, y0, x1, y1;
+    int count = 0;
+    vgf_points_begin(image, shape, &it);
+    vgf_next_point(&it, &first_x, &first_y);
+    x0 = first_x;
+    y0 = first_y;
+    while (vgf_next_point(&it, &x1, &y1)) {
+        count = vgf_add_edge(count, x0, y0, x1, y1, row0, row1);
+        x0 = x1;
+        y0 = y1;
+    }
+    count = vgf_add_edge(count, x0, y0, first_x, first_y, row0, row1);
+    if (count == 0) return;
+
+    // Edge table: edges by first row, a counting sort
+    memset(&row_start[row0], 0, (row1 - row0 + 1) * sizeof(row_start[0]));
+    for (int i = 0; i < count; i++) row_start[edges[i].y0 + 1]++;
+    for (int y = row0 + 1; y <= row1; y++) row_start[y] += row_start[y - 1];
+    for (int i = 0; i < count; i++) edge_order[row_start[edges[i].y0]++] = i;
+    // row_start[y] is now the end of row y's edges, the start of row y + 1's
+
+    int next = 0, num_active = 0;
+    for (int y = row0; y < row1; y++) {
+        // Drop edges that have ended, take in those that start here
+        int kept = 0;
+        for (int i = 0; i < num_active; i++) {
+            if (edges[active[i]].y1 > y) active[kept++] = active[i];
+        }
+        num_active = kept;
+        while (next < count && edges[edge_order[next]].y0 == y) {
+            active[num_active++] = edge_order[next++];
+        }
+
+        // Keep them ordered by x; from one row to the next the order
+        // hardly changes, so insertion sort is close to linear
+        for (int i = 1; i < num_active; i++) {
+            uint16_t e = active[i];
+            int32_t ex = edges[e].x;
+            int j = i - 1;
+            while (j >= 0 && edges[active[j]].x > ex) {
+                active[j + 1] = active[j];
+                j--;
+            }
+            active[j + 1] = e;
+        }
+
+        // Spans between crossings, by the fill rule
+        int winding = 0;
+        for (int i = 0; i + 1 < num_active; i++) {
+            VGFEdge *e = &edges[active[i]];
+            bool inside;
+            if (rule == VGF_FILL_EVENODD) {
+                inside = !(i & 1);
+            } else {
+                winding += e->dir;
+                inside = winding != 0;
+            }
+            if (!inside) continue;
+
+            int px0 = vgf_pixel_at(e->x);
+            int px1 = vgf_pixel_at(edges[active[i + 1]].x);
+            if (px0 < 0) px0 = 0;
+            if (px1 > width) px1 = width;
+            if (px1 > px0) span(ctx, px0, y, px1 - px0, color);
+        }
+
+        for (int i = 0; i < num_active; i++) {
+            VGFEdge *e = &edges[active[i]];
+            e->x += e->dxdy;
+            e->rem += e->dxdy_rem;
+            if (e->rem >= e->den) {
+                e->x++;
+                e->rem -= e->den;
+            }
+        }
+    }
+}
+
+// Span target: a framebuffer of width pixels a row
+typedef struct {
+    uint16_t *pixels;
+    int width;
+    int row0;          // row of the first line of pixels
+} VGFTarget;
+
+static void vgf_target_span(void *ctx, int x, int y, int width, uint16_t color) {
+    VGFTarget *t = ctx;
+    uint16_t *p = &t->pixels[(y - t->row0) * t->width + x];
+    for (int i = 0; i < width; i++) p[i] = color;
+}
+
+// Render shape to framebuffer: the fill, then the stroke a line at a
+// time as the points come
 void vgf_render_shape(uint16_t *framebuffer, int width, int height,
-                      VGFShape *shape, VGFHeader *header) {
+                      const VGFShape *shape, const VGFImage *image) {
     if (shape->num_points < 2) return;
     
+    if (shape->fill_idx != 255) {
+        VGFTarget target = {framebuffer, width, 0};
+        vgf_fill_shape(image, shape, VGF_FILL_NONZERO, 0, height, width,
+                       vgf_color(image, shape->fill_idx), vgf_target_span, &target);
+    }
+    
     // Draw stroke
     if (shape->stroke_idx != 255) {
-        uint16_t color = header->colors[shape->stroke_idx];
+        uint16_t color = vgf_color(image, shape->stroke_idx);
+        VGFPointIter it;
+        int16_t x0 = 0, y0 = 0, x1, y1;
         
-        for (int i = 0; i < shape->num_points - 1; i++) {
-            int x1 = shape->points[i * 2];
-            int y1 = shape->points[i * 2 + 1];
-            int x2 = shape->points[(i + 1) * 2];
-            int y2 = shape->points[(i + 1) * 2 + 1];
-            
-            draw_line(framebuffer, width, height, x1, y1, x2, y2, color);
+        vgf_points_begin(image, shape, &it);
+        vgf_next_point(&it, &x0, &y0);
+        while (vgf_next_point(&it, &x1, &y1)) {
+            draw_line(framebuffer, width, height, x0, y0, x1, y1, color);
+            x0 = x1;
+            y0 = y1;
         }
     }
-    
-    // TODO: Add fill rendering (scanline algorithm)
 }
 
-// Example main function
+// Rows each shape touches, found once, so a band only decodes its shapes
+typedef struct {
+    const uint8_t *record;
+    int16_t y0, y1;    // rows y0 .. y1 - 1
+} VGFShapeRows;
+
+static VGFShapeRows shape_rows[VGF_MAX_SHAPES];
+static uint16_t band[VGF_BAND_ROWS][VGF_MAX_WIDTH];
+
+// Whole image in one pass down the screen. For each band of rows every
+// shape that touches it is filled and stroked in order into the band,
+// then each row goes to span as runs of one colour: overlapping shapes
+// cost nothing on the way out. -1 if the image is over the limits
+int vgf_render_bands(const VGFImage *image, VGFFillRule rule, VGFSpanFn span, void *ctx) {
+    int width = image->scaled_width, height = image->scaled_height;
+    if (width > VGF_MAX_WIDTH || height > VGF_MAX_ROWS || image->num_shapes > VGF_MAX_SHAPES) {
+        return -1;
+    }
+
+    VGFShapeCursor cursor;
+    VGFShape shape;
+    int num_shapes = 0;
+    vgf_shapes_begin(image, &cursor);
+    for (const uint8_t *record = cursor.next; vgf_next_shape(&cursor, &shape); record = cursor.next) {
+        VGFShapeRows *rows = &shape_rows[num_shapes++];
+        VGFPointIter it;
+        int16_t x, y;
+        rows->record = record;
+        rows->y0 = INT16_MAX;
+        rows->y1 = INT16_MIN;
+        vgf_points_begin(image, &shape, &it);
+        while (vgf_next_point(&it, &x, &y)) {
+            if (y < rows->y0) rows->y0 = y;
+            if (y + 1 > rows->y1) rows->y1 = y + 1;
+        }
+    }
+
+    for (int band_y = 0; band_y < height; band_y += VGF_BAND_ROWS) {
+        int rows = height - band_y < VGF_BAND_ROWS ? height - band_y : VGF_BAND_ROWS;
+        VGFTarget target = {&band[0][0], width, band_y};
+        memset(band, 0, sizeof(band));
+
+        for (int s = 0; s < num_shapes; s++) {
+            if (shape_rows[s].y1 <= band_y || shape_rows[s].y0 >= band_y + rows) continue;
+            vgf_parse_shape(shape_rows[s].record, &shape);
+            if (shape.num_points < 2) continue;
+
+            if (shape.fill_idx != 255) {
+                vgf_fill_shape(image, &shape, rule, band_y, band_y + rows, width,
+                               vgf_color(image, shape.fill_idx), vgf_target_span, &target);
+            }
+            if (shape.stroke_idx != 255) {
+                // The band's own rows, as a small framebuffer
+                uint16_t color = vgf_color(image, shape.stroke_idx);
+                VGFPointIter it;
+                int16_t x0 = 0, y0 = 0, x1, y1;
+                vgf_points_begin(image, &shape, &it);
+                vgf_next_point(&it, &x0, &y0);
+                while (vgf_next_point(&it, &x1, &y1)) {
+                    if ((y0 >= band_y || y1 >= band_y) && (y0 < band_y + rows || y1 < band_y + rows)) {
+                        draw_line(&band[0][0], width, rows, x0, y0 - band_y, x1, y1 - band_y, color);
+                    }
+                    x0 = x1;
+                    y0 = y1;
+                }
+            }
+        }
+
+        for (int r = 0; r < rows; r++) {
+            const uint16_t *row = &band[r][0];
+            for (int x = 0; x < width; ) {
+                int run = 1;
+                while (x + run < width && row[x + run] == row[x]) run++;
+                span(ctx, x, band_y + r, run, row[x]);
+                x += run;
+            }
+        }
+    }
+    return 0;
+}
+
+// Span cache: a rasterised drawing as runs of one colour, row by row.
+// Row y is runs[2 * rows[y]] up to runs[2 * rows[y + 1]], a run being a
+// length and an RGB565 colour; the runs of a row cover it from x = 0
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    const uint32_t *rows;    // height + 1 entries
+    const uint16_t *runs;
+} VGFSpanCache;
+
+typedef struct {
+    uint32_t *rows;
+    uint16_t *runs;
+    uint32_t max_runs;
+    uint32_t count;
+    int next_row;
+    bool full;
+} VGFCacheBuilder;
+
+static void vgf_cache_span(void *ctx, int x, int y, int width, uint16_t color) {
+    (void)x;
+    VGFCacheBuilder *b = ctx;
+    while (b->next_row <= y) b->rows[b->next_row++] = b->count;
+    if (b->count == b->max_runs) {
+        b->full = true;
+        return;
+    }
+    b->runs[2 * b->count] = (uint16_t)width;
+    b->runs[2 * b->count + 1] = color;
+    b->count++;
+}
+
+// Rasterise the image once at scale (16.16) into the caller's storage:
+// rows has room for the scaled height + 1, runs for max_runs runs of
+// two uint16_t each. -1 if it does not fit or is over the limits
+int vgf_cache_build(VGFImage *image, int32_t scale, VGFFillRule rule,
+                    uint32_t *rows, uint16_t *runs, uint32_t max_runs,
+                    VGFSpanCache *cache) {
+    int32_t old_scale = image->scale;
+    VGFCacheBuilder b = {rows, runs, max_runs, 0, 0, false};
+
+    vgf_set_scale(image, scale);
+    int result = vgf_render_bands(image, rule, vgf_cache_span, &b);
+    cache->width = image->scaled_width;
+    cache->height = image->scaled_height;
+    vgf_set_scale(image, old_scale);
+
+    if (result != 0 || b.full) return -1;
+    while (b.next_row <= cache->height) rows[b.next_row++] = b.count;
+    cache->rows = rows;
+    cache->runs = runs;
+    return 0;
+}
+
+// Draw the part rw x rh at (rx, ry) of the cached drawing with its top
+// left at (x, y) on the target: e.g. just what was under a moving hand
+void vgf_cache_draw(const VGFSpanCache *cache, int x, int y,
+                    int rx, int ry, int rw, int rh, VGFSpanFn span, void *ctx) {
+    if (rx < 0) { rw += rx; rx = 0; }
+    if (ry < 0) { rh += ry; ry = 0; }
+    if (rx + rw > cache->width) rw = cache->width - rx;
+    if (ry + rh > cache->height) rh = cache->height - ry;
+    if (rw <= 0 || rh <= 0) return;
+
+    for (int row = ry; row < ry + rh; row++) {
+        const uint16_t *run = &cache->runs[2 * cache->rows[row]];
+        const uint16_t *end = &cache->runs[2 * cache->rows[row + 1]];
+        int run_x = 0;
+
+        // Skip the runs left of the part, then cut the ones across it
+        while (run < end && run_x + run[0] <= rx) {
+            run_x += run[0];
+            run += 2;
+        }
+        for (; run < end && run_x < rx + rw; run += 2) {
+            int x0 = run_x > rx ? run_x : rx;
+            int x1 = run_x + run[0] < rx + rw ? run_x + run[0] : rx + rw;
+            span(ctx, x + x0, y + row, x1 - x0, run[1]);
+            run_x += run[0];
+        }
+    }
+}
+
+// Write the cache as const C arrays, so it can be built into flash
+void vgf_cache_write_c(const VGFSpanCache *cache, FILE *f, const char *name) {
+    uint32_t num_runs = cache->rows[cache->height];
+
+    fprintf(f, "// Span cache, %dx%d, %u runs\n", cache->width, cache->height, (unsigned)num_runs);
+    fprintf(f, "static const uint32_t %s_rows[%d] = {", name, cache->height + 1);
+    for (int i = 0; i <= cache->height; i++) {
+        fprintf(f, "%s%u,", i % 12 ? " " : "\n    ", (unsigned)cache->rows[i]);
+    }
+    fprintf(f, "\n};\n");
+    fprintf(f, "static const uint16_t %s_runs[%u] = {", name, (unsigned)(2 * num_runs));
+    for (uint32_t i = 0; i < num_runs; i++) {
+        fprintf(f, "%s%u, 0x%04X,", i % 6 ? " " : "\n    ",
+                cache->runs[2 * i], cache->runs[2 * i + 1]);
+    }
+    fprintf(f, "\n};\n");
+    fprintf(f, "static const VGFSpanCache %s = {%d, %d, %s_rows, %s_runs};\n",
+            name, cache->width, cache->height, name, name);
+}
+
+#ifdef VGF_USE_DISPLAY
+// Spans straight to the display
+void vgf_display_span(void *ctx, int x, int y, int width, uint16_t color) {
+    (void)ctx;
+    display_fill_rect(x, y, width, 1, color);
+}
+#endif
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Framebuffer as a binary PPM, to look at on the host
+static void write_ppm(const char *path, const uint16_t *framebuffer, int width, int height) {
+    FILE *f = fopen(path, "wb");
+    if (!f) return;
+    fprintf(f, "P6\n%d %d\n255\n", width, height);
+    for (int i = 0; i < width * height; i++) {
+        uint16_t c = framebuffer[i];
+        uint8_t rgb[3] = {(c >> 8) & 0xF8, (c >> 3) & 0xFC, (c << 3) & 0xF8};
+        fwrite(rgb, 1, 3, f);
+    }
+    fclose(f);
+}
+
+// Example main function. The host has no XIP flash, so the file is read
+// into one buffer that stands in for it
 int main(int argc, char **argv) {
     if (argc < 2) {
-        printf("Usage: %s <input.vgf>\n", argv[0]);
+        printf("Usage: %s <input.vgf> [output.ppm | output.h] [scale]\n", argv[0]);
         return 1;
     }
     
@@ -181,34 +675,81 @@ int main(int argc, char **argv) {
         return 1;
     }
     
-    VGFHeader header;
-    if (vgf_read_header(f, &header) != 0) {
-        printf("Invalid VGF file\n");
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *blob = malloc(size > 0 ? size : 1);
+    if (!blob || fread(blob, 1, size, f) != (size_t)size) {
+        printf("Error reading file\n");
+        free(blob);
         fclose(f);
         return 1;
     }
+    fclose(f);
+    
+    VGFImage image;
+    if (vgf_open(blob, size, &image) != 0) {
+        printf("Invalid VGF file\n");
+        free(blob);
+        return 1;
+    }
     
     printf("VGF: %dx%d, %d colors, %d shapes\n",
-           header.width, header.height, header.num_colors, header.num_shapes);
+           image.width, image.height, image.num_colors, image.num_shapes);
+    
+    float scale = argc >= 4 ? strtof(argv[3], NULL) : 1.0f;
+    int32_t scale_fixed = (int32_t)(scale * 65536.0f);
+    if (scale_fixed <= 0) {
+        printf("Invalid scale\n");
+        free(blob);
+        return 1;
+    }
+    vgf_set_scale(&image, scale_fixed);
+    int width = image.scaled_width, height = image.scaled_height;
     
     // Allocate framebuffer (RGB565)
-    uint16_t *framebuffer = calloc(header.width * header.height, sizeof(uint16_t));
+    uint16_t *framebuffer = calloc(width * height, sizeof(uint16_t));
     
-    // Render all shapes
-    for (int i = 0; i < header.num_shapes; i++) {
-        VGFShape shape;
-        vgf_read_shape(f, &shape);
-        vgf_render_shape(framebuffer, header.width, header.height, &shape, &header);
-        vgf_free_shape(&shape);
+    // Render all shapes, in bands; on the Pico vgf_display_span would
+    // send the runs to the display instead
+    VGFTarget target = {framebuffer, width, 0};
+    double start = now_seconds();
+    if (vgf_render_bands(&image, VGF_FILL_NONZERO, vgf_target_span, &target) != 0) {
+        printf("Image over the rasteriser limits\n");
     }
+    printf("Rendered in %.2f ms\n", (now_seconds() - start) * 1e3);
     
-    // TODO: Send framebuffer to display
-    // change to modified custom driver
+    // The same once into a span cache, then drawn from it
+    static uint32_t cache_rows[VGF_MAX_ROWS + 1];
+    static uint16_t cache_runs[2 * 32768];
+    VGFSpanCache cache;
+    if (vgf_cache_build(&image, scale_fixed, VGF_FILL_NONZERO,
+                        cache_rows, cache_runs, 32768, &cache) == 0) {
+        uint32_t num_runs = cache.rows[cache.height];
+        start = now_seconds();
+        vgf_cache_draw(&cache, 0, 0, 0, 0, cache.width, cache.height, vgf_target_span, &target);
+        printf("Span cache: %u runs, %u bytes; drawn in %.3f ms\n", (unsigned)num_runs,
+               (unsigned)(num_runs * 4 + (cache.height + 1) * 4), (now_seconds() - start) * 1e3);
+    } else {
+        printf("Span cache does not fit\n");
+    }
+    
+    if (argc >= 3) {
+        size_t len = strlen(argv[2]);
+        if (len > 2 && strcmp(argv[2] + len - 2, ".h") == 0) {
+            FILE *out = fopen(argv[2], "w");
+            if (out) {
+                vgf_cache_write_c(&cache, out, "vgf_background");
+                fclose(out);
+            }
+        } else {
+            write_ppm(argv[2], framebuffer, width, height);
+        }
+    }
     
     // Cleanup
     free(framebuffer);
-    free(header.colors);
-    fclose(f);
+    free(blob);
     
     return 0;
 }
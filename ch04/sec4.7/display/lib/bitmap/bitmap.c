@@ -0,0 +1,102 @@
+#include "bitmap.h"
+#include <string.h>
+
+// For each byte, 0xFFFF where a bit is set, the same for any colours
+static uint16_t masks[256][8];
+static bool masks_ready = false;
+
+static void masks_init(void) {
+    for (int b = 0; b < 256; b++) {
+        for (int i = 0; i < 8; i++) {
+            masks[b][i] = (b & (0x80 >> i)) ? 0xFFFF : 0;
+        }
+    }
+    masks_ready = true;
+}
+
+void bitmap_lut_init(bitmap_lut_t *lut, uint16_t fg, uint16_t bg) {
+    if (!masks_ready) masks_init();
+    lut->fg = fg;
+    lut->bg = bg;
+    for (int b = 0; b < 256; b++) {
+        for (int i = 0; i < 8; i++) {
+            lut->pixels[b][i] = masks[b][i] ? fg : bg;
+        }
+    }
+}
+
+static bitmap_lut_t cache[BITMAP_LUT_SLOTS];
+static int cache_used = 0;
+static int cache_next = 0;
+
+const bitmap_lut_t *bitmap_lut(uint16_t fg, uint16_t bg) {
+    for (int i = 0; i < cache_used; i++) {
+        if (cache[i].fg == fg && cache[i].bg == bg) return &cache[i];
+    }
+    bitmap_lut_t *lut = &cache[cache_next];
+    cache_next = (cache_next + 1) % BITMAP_LUT_SLOTS;
+    if (cache_used < BITMAP_LUT_SLOTS) cache_used++;
+    bitmap_lut_init(lut, fg, bg);
+    return lut;
+}
+
+// Whole bytes through the table, the pixels of a byte cut by x0 or x1
+// one at a time
+void bitmap_expand_row(uint16_t *dst, const uint8_t *row, int x0, int x1, const bitmap_lut_t *lut) {
+    int x = x0;
+    while (x < x1) {
+        const uint16_t *p = lut->pixels[row[x >> 3]];
+        if ((x & 7) == 0 && x + 8 <= x1) {
+            memcpy(dst, p, 8 * sizeof(uint16_t));
+            dst += 8;
+            x += 8;
+        } else {
+            *dst++ = p[x & 7];
+            x++;
+        }
+    }
+}
+
+void bitmap_blend_row(uint16_t *dst, const uint8_t *row, int x0, int x1, const bitmap_lut_t *lut) {
+    if (!masks_ready) masks_init();
+    int x = x0;
+    while (x < x1) {
+        uint8_t b = row[x >> 3];
+        const uint16_t *p = lut->pixels[b];
+        const uint16_t *m = masks[b];
+        if ((x & 7) == 0 && x + 8 <= x1) {
+            if (b == 0xFF) {
+                memcpy(dst, p, 8 * sizeof(uint16_t));
+            } else if (b != 0) {
+                for (int i = 0; i < 8; i++) dst[i] = (dst[i] & ~m[i]) | (p[i] & m[i]);
+            }
+            dst += 8;
+            x += 8;
+        } else {
+            *dst = (*dst & ~m[x & 7]) | (p[x & 7] & m[x & 7]);
+            dst++;
+            x++;
+        }
+    }
+}
+
+void bitmap_draw(uint16_t *fb, int fb_width, int fb_height, int x, int y,
+                 const uint8_t *bitmap, int width, int height,
+                 const bitmap_lut_t *lut, bool transparent) {
+    int x0 = x < 0 ? -x : 0;
+    int y0 = y < 0 ? -y : 0;
+    int x1 = x + width > fb_width ? fb_width - x : width;
+    int y1 = y + height > fb_height ? fb_height - y : height;
+    if (x0 >= x1 || y0 >= y1) return;
+
+    int stride = BITMAP_STRIDE(width);
+    for (int row = y0; row < y1; row++) {
+        uint16_t *dst = fb + (y + row) * fb_width + x + x0;
+        const uint8_t *src = bitmap + row * stride;
+        if (transparent) {
+            bitmap_blend_row(dst, src, x0, x1, lut);
+        } else {
+            bitmap_expand_row(dst, src, x0, x1, lut);
+        }
+    }
+}
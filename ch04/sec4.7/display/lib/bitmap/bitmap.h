@@ -0,0 +1,43 @@
+#ifndef BITMAP_H
+#define BITMAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 1-bit bitmaps drawn as RGB565. A bitmap is height rows of stride =
+// (width + 7) / 8 bytes, the leftmost pixel in bit 7, as in the sprites
+// of the games. A byte is expanded through a table of the eight pixels
+// it stands for in a pair of colours, so a row costs a copy of 16 bytes
+// per byte of bitmap rather than a test of each bit. A second table
+// turns a byte into eight 16-bit masks, for drawing only the set bits
+// over what is there already.
+//
+// Tables are 4 KB each. bitmap_lut() keeps a few of them, for the
+// colour pairs in use, and builds one only when a new pair comes.
+
+#define BITMAP_LUT_SLOTS 4
+
+typedef struct {
+    uint16_t fg, bg;
+    uint16_t pixels[256][8];
+} bitmap_lut_t;
+
+#define BITMAP_STRIDE(width) (((width) + 7) / 8)
+
+void bitmap_lut_init(bitmap_lut_t *lut, uint16_t fg, uint16_t bg);
+
+// The table for fg on bg from the cache; the oldest slot makes way
+const bitmap_lut_t *bitmap_lut(uint16_t fg, uint16_t bg);
+
+// Columns [x0, x1) of a bitmap row into dst[0 .. x1 - x0). Opaque: a
+// clear bit is bg. Transparent: only set bits are written
+void bitmap_expand_row(uint16_t *dst, const uint8_t *row, int x0, int x1, const bitmap_lut_t *lut);
+void bitmap_blend_row(uint16_t *dst, const uint8_t *row, int x0, int x1, const bitmap_lut_t *lut);
+
+// A width x height bitmap at (x, y) in a framebuffer fb_width x fb_height
+// pixels, clipped to it
+void bitmap_draw(uint16_t *fb, int fb_width, int fb_height, int x, int y,
+                 const uint8_t *bitmap, int width, int height,
+                 const bitmap_lut_t *lut, bool transparent);
+
+#endif // BITMAP_H
@@ -0,0 +1,93 @@
+// Host checks of bitmap.c against a plain bit-by-bit drawing: random
+// bitmaps of every width up to 40, at positions that cut them on each
+// side of the framebuffer, opaque and transparent, and the cache
+// handing back the same table for a pair it has
+#include <stdio.h>
+#include <string.h>
+#include "bitmap.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        printf("FAIL: " __VA_ARGS__); \
+        printf("\n"); \
+        failures++; \
+    } \
+} while (0)
+
+enum { FB_W = 37, FB_H = 29, MAX_W = 40, MAX_H = 12 };
+
+static unsigned seed = 1;
+
+static unsigned next(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+static void reference(uint16_t *fb, int x, int y, const uint8_t *bitmap, int width, int height,
+                      uint16_t fg, uint16_t bg, bool transparent) {
+    int stride = BITMAP_STRIDE(width);
+    for (int row = 0; row < height; row++) {
+        for (int col = 0; col < width; col++) {
+            int px = x + col, py = y + row;
+            if (px < 0 || py < 0 || px >= FB_W || py >= FB_H) continue;
+            bool set = bitmap[row * stride + col / 8] & (0x80 >> (col % 8));
+            if (set) fb[py * FB_W + px] = fg;
+            else if (!transparent) fb[py * FB_W + px] = bg;
+        }
+    }
+}
+
+int main(void) {
+    static uint16_t want[FB_W * FB_H], got[FB_W * FB_H];
+    static uint8_t bitmap[MAX_H * BITMAP_STRIDE(MAX_W)];
+    static bitmap_lut_t lut;
+    int cases = 0;
+
+    for (int width = 1; width <= MAX_W; width++) {
+        for (int round = 0; round < 60; round++) {
+            int height = 1 + next() % MAX_H;
+            for (size_t i = 0; i < sizeof(bitmap); i++) {
+                // some all clear and all set bytes, for the fast paths
+                unsigned r = next() % 8;
+                bitmap[i] = r == 0 ? 0x00 : r == 1 ? 0xFF : (uint8_t)next();
+            }
+            uint16_t fg = (uint16_t)next(), bg = (uint16_t)next();
+            bitmap_lut_init(&lut, fg, bg);
+            int x = (int)(next() % (FB_W + width)) - width;
+            int y = (int)(next() % (FB_H + height)) - height;
+            bool transparent = next() % 2;
+
+            for (int i = 0; i < FB_W * FB_H; i++) want[i] = got[i] = (uint16_t)next();
+            reference(want, x, y, bitmap, width, height, fg, bg, transparent);
+            bitmap_draw(got, FB_W, FB_H, x, y, bitmap, width, height, &lut, transparent);
+            CHECK(memcmp(want, got, sizeof(want)) == 0,
+                  "%s %dx%d at (%d, %d)", transparent ? "transparent" : "opaque", width, height, x, y);
+            cases++;
+        }
+    }
+
+    // expand_row of a window of columns is the same pixels
+    for (int i = 0; i < 8; i++) bitmap[i] = (uint8_t)next();
+    bitmap_lut_init(&lut, 0xF800, 0x001F);
+    for (int x0 = 0; x0 < 64; x0++) {
+        for (int x1 = x0; x1 <= 64; x1++) {
+            uint16_t row[64];
+            bitmap_expand_row(row, bitmap, x0, x1, &lut);
+            for (int c = x0; c < x1; c++) {
+                bool set = bitmap[c / 8] & (0x80 >> (c % 8));
+                CHECK(row[c - x0] == (set ? 0xF800 : 0x001F), "expand_row [%d, %d) at %d", x0, x1, c);
+            }
+        }
+    }
+
+    const bitmap_lut_t *a = bitmap_lut(0xFFFF, 0x0000);
+    for (int i = 0; i < BITMAP_LUT_SLOTS - 1; i++) bitmap_lut((uint16_t)i, 0x1234);
+    CHECK(bitmap_lut(0xFFFF, 0x0000) == a, "a cached pair is built again");
+    CHECK(a->pixels[0x81][0] == 0xFFFF && a->pixels[0x81][1] == 0x0000 && a->pixels[0x81][7] == 0xFFFF,
+          "table for 0x81");
+
+    printf("%d cases, %s\n", cases, failures ? "FAILED" : "ok");
+    return failures != 0;
+}
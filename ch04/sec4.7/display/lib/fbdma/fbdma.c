@@ -0,0 +1,151 @@
+#include "fbdma.h"
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+static int channel = -1;
+static uint32_t fill_word;      // the colour twice, read again and again
+
+// Rows of the operation not yet started
+static struct {
+    uint16_t *dst;
+    const uint16_t *src;        // NULL for a fill
+    int dst_stride, src_stride;
+    int width;
+    volatile int rows;
+} op;
+
+static void cpu_span(uint16_t *dst, const uint16_t *src, int n) {
+    if (src) {
+        memcpy(dst, src, (size_t)n * sizeof(uint16_t));
+    } else {
+        for (int i = 0; i < n; i++) dst[i] = (uint16_t)fill_word;
+    }
+}
+
+// Start a row, in words where both ends are word aligned, which halves
+// the transfers; an odd pixel at either end is done by the CPU. False
+// if that left nothing for the DMA
+static bool start_row(uint16_t *dst, const uint16_t *src, int n) {
+    bool words = !src || (((uintptr_t)dst ^ (uintptr_t)src) & 2) == 0;
+    if (words && ((uintptr_t)dst & 2) && n > 0) {
+        cpu_span(dst++, src, 1);
+        if (src) src++;
+        n--;
+    }
+    if (words && (n & 1)) {
+        cpu_span(dst + n - 1, src ? src + n - 1 : NULL, 1);
+        n--;
+    }
+    uint32_t transfers = words ? (uint32_t)n / 2 : (uint32_t)n;
+    if (transfers == 0) return false;
+
+    dma_channel_config c = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&c, words ? DMA_SIZE_32 : DMA_SIZE_16);
+    channel_config_set_read_increment(&c, src != NULL);
+    channel_config_set_write_increment(&c, true);
+    dma_channel_configure(channel, &c, dst, src ? (const void *)src : &fill_word, transfers, true);
+    return true;
+}
+
+// Start the next row that has work for the DMA. A row is counted off
+// only once it runs, so fbdma_busy() sees no gap between two rows
+static void next_rows(void) {
+    while (op.rows > 0) {
+        uint16_t *dst = op.dst;
+        const uint16_t *src = op.src;
+        op.dst += op.dst_stride;
+        if (op.src) op.src += op.src_stride;
+        bool started = start_row(dst, src, op.width);
+        op.rows--;
+        if (started) return;
+    }
+}
+
+static void __isr fbdma_irq(void) {
+    if (channel >= 0 && (dma_hw->ints1 & (1u << channel))) {
+        dma_hw->ints1 = 1u << channel;
+        next_rows();
+    }
+}
+
+bool fbdma_init(void) {
+    if (channel >= 0) return true;
+    channel = dma_claim_unused_channel(false);
+    if (channel < 0) return false;
+
+    dma_channel_set_irq1_enabled(channel, true);
+    irq_add_shared_handler(DMA_IRQ_1, fbdma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+    return true;
+}
+
+void fbdma_deinit(void) {
+    if (channel < 0) return;
+    fbdma_wait();
+    dma_channel_set_irq1_enabled(channel, false);
+    irq_remove_handler(DMA_IRQ_1, fbdma_irq);
+    dma_channel_unclaim(channel);
+    channel = -1;
+}
+
+bool fbdma_busy(void) {
+    return channel >= 0 && (op.rows > 0 || dma_channel_is_busy(channel));
+}
+
+void fbdma_wait(void) {
+    while (fbdma_busy()) tight_loop_contents();
+}
+
+// Wait for the last operation, then start rows of width pixels, or do
+// them all here without a channel
+static void start(uint16_t *dst, int dst_stride, const uint16_t *src, int src_stride,
+                  int width, int rows) {
+    fbdma_wait();
+    if (width <= 0 || rows <= 0) return;
+
+    if (channel < 0) {
+        for (int r = 0; r < rows; r++) {
+            cpu_span(dst, src, width);
+            dst += dst_stride;
+            if (src) src += src_stride;
+        }
+        return;
+    }
+
+    op.dst = dst;
+    op.src = src;
+    op.dst_stride = dst_stride;
+    op.src_stride = src_stride;
+    op.width = width;
+    op.rows = rows;
+
+    // The interrupt of a short first row must not start the next one
+    // while this is still at it
+    uint32_t irq = save_and_disable_interrupts();
+    next_rows();
+    restore_interrupts(irq);
+}
+
+void fbdma_fill(uint16_t *dst, uint16_t color, size_t count) {
+    fbdma_wait();
+    fill_word = color | (uint32_t)color << 16;
+    start(dst, 0, NULL, 0, (int)count, 1);
+}
+
+void fbdma_copy(uint16_t *dst, const uint16_t *src, size_t count) {
+    start(dst, 0, src, 0, (int)count, 1);
+}
+
+void fbdma_fill_rect(uint16_t *fb, int stride, int x, int y, int w, int h, uint16_t color) {
+    fbdma_wait();
+    fill_word = color | (uint32_t)color << 16;
+    start(fb + (size_t)y * stride + x, stride, NULL, 0, w, h);
+}
+
+void fbdma_copy_rect(uint16_t *dst, int dst_stride, const uint16_t *src, int src_stride,
+                     int w, int h) {
+    start(dst, dst_stride, src, src_stride, w, h);
+}
@@ -0,0 +1,34 @@
+#ifndef FBDMA_H
+#define FBDMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Framebuffer clears, fills and copies on a spare DMA channel. Each call
+// returns once the transfer has started, so the CPU can get on with
+// something else, and fbdma_wait() is the fence before the pixels are
+// used. One operation runs at a time: starting one waits for the last.
+// Rectangles go row by row, each next row started from the DMA_IRQ_1
+// handler. Without a channel (fbdma_init() failed or was not called)
+// every call does the work on the CPU and returns when it is done.
+//
+// The CPU must not touch the pixels of an operation until it is done.
+
+// Claim a channel and the DMA_IRQ_1 handler; false if none is free
+bool fbdma_init(void);
+void fbdma_deinit(void);
+
+// count pixels from dst on
+void fbdma_fill(uint16_t *dst, uint16_t color, size_t count);
+void fbdma_copy(uint16_t *dst, const uint16_t *src, size_t count);
+
+// A w x h rectangle of a framebuffer stride pixels wide
+void fbdma_fill_rect(uint16_t *fb, int stride, int x, int y, int w, int h, uint16_t color);
+void fbdma_copy_rect(uint16_t *dst, int dst_stride, const uint16_t *src, int src_stride,
+                     int w, int h);
+
+bool fbdma_busy(void);
+void fbdma_wait(void);
+
+#endif // FBDMA_H
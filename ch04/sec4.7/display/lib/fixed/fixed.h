@@ -0,0 +1,19 @@
+#ifndef FIXED_H
+#define FIXED_H
+
+#include "fx.h"
+
+// The FIXED_* names the games and the engine were written with, now for
+// the Q format of fx.h
+typedef fx_t fixed_t;
+
+#define FIXED_SHIFT FX_FRAC_BITS
+#define FIXED_ONE FX_ONE
+#define INT_TO_FIXED(x) FX_FROM_INT(x)
+#define FIXED_TO_INT(x) FX_TO_INT(x)       // rounds down
+#define FLOAT_TO_FIXED(x) FX_FROM_FLOAT(x)
+#define FIXED_TO_FLOAT(x) FX_TO_FLOAT(x)
+#define FIXED_MUL(a, b) fx_mul(a, b)
+#define FIXED_DIV(a, b) fx_div(a, b)
+
+#endif // FIXED_H
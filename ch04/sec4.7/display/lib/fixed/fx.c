@@ -0,0 +1,189 @@
+// fx.c - tables and batch kernels for fx.h
+#include "fx.h"
+
+// sin over a quarter turn in Q2.30, 256 steps and the end point
+static const int32_t sin_q30[257] = {
+    0, 6588356, 13176464, 19764076, 26350943, 32936819,
+    39521455, 46104602, 52686014, 59265442, 65842639, 72417357,
+    78989349, 85558366, 92124163, 98686491, 105245103, 111799753,
+    118350194, 124896179, 131437462, 137973796, 144504935, 151030634,
+    157550647, 164064728, 170572633, 177074115, 183568930, 190056834,
+    196537583, 203010932, 209476638, 215934457, 222384147, 228825464,
+    235258165, 241682010, 248096755, 254502159, 260897982, 267283981,
+    273659918, 280025552, 286380643, 292724951, 299058239, 305380268,
+    311690799, 317989595, 324276419, 330551034, 336813204, 343062693,
+    349299266, 355522689, 361732726, 367929144, 374111709, 380280190,
+    386434353, 392573967, 398698801, 404808624, 410903207, 416982319,
+    423045732, 429093217, 435124548, 441139496, 447137835, 453119340,
+    459083786, 465030947, 470960600, 476872522, 482766489, 488642281,
+    494499676, 500338453, 506158392, 511959275, 517740883, 523502998,
+    529245404, 534967884, 540670223, 546352205, 552013618, 557654248,
+    563273883, 568872310, 574449320, 580004702, 585538248, 591049748,
+    596538995, 602005783, 607449906, 612871159, 618269338, 623644239,
+    628995660, 634323400, 639627258, 644907034, 650162530, 655393548,
+    660599890, 665781362, 670937767, 676068911, 681174602, 686254647,
+    691308855, 696337036, 701339000, 706314559, 711263525, 716185713,
+    721080937, 725949013, 730789757, 735602987, 740388522, 745146182,
+    749875788, 754577161, 759250125, 763894504, 768510122, 773096806,
+    777654384, 782182683, 786681534, 791150767, 795590213, 799999706,
+    804379079, 808728167, 813046808, 817334838, 821592095, 825818421,
+    830013654, 834177638, 838310216, 842411232, 846480531, 850517961,
+    854523370, 858496606, 862437520, 866345964, 870221790, 874064853,
+    877875009, 881652112, 885396022, 889106597, 892783698, 896427186,
+    900036924, 903612776, 907154608, 910662286, 914135678, 917574653,
+    920979082, 924348837, 927683790, 930983817, 934248793, 937478595,
+    940673101, 943832191, 946955747, 950043650, 953095785, 956112036,
+    959092290, 962036435, 964944360, 967815955, 970651112, 973449725,
+    976211688, 978936898, 981625251, 984276646, 986890984, 989468165,
+    992008094, 994510675, 996975812, 999403415, 1001793390, 1004145648,
+    1006460100, 1008736660, 1010975242, 1013175761, 1015338134, 1017462281,
+    1019548121, 1021595575, 1023604567, 1025575020, 1027506862, 1029400018,
+    1031254418, 1033069992, 1034846671, 1036584389, 1038283080, 1039942680,
+    1041563127, 1043144360, 1044686319, 1046188946, 1047652185, 1049075980,
+    1050460278, 1051805027, 1053110176, 1054375676, 1055601479, 1056787540,
+    1057933813, 1059040255, 1060106826, 1061133483, 1062120190, 1063066909,
+    1063973603, 1064840240, 1065666786, 1066453210, 1067199483, 1067905576,
+    1068571464, 1069197120, 1069782521, 1070327646, 1070832474, 1071296985,
+    1071721163, 1072104991, 1072448455, 1072751542, 1073014240, 1073236540,
+    1073418433, 1073559913, 1073660973, 1073721611, 1073741824,
+};
+
+// atan(i / 256) in fx_angle_t units, i = 0 .. 256
+static const uint16_t atan_tab[257] = {
+    0, 41, 81, 122, 163, 204, 244, 285, 326, 367, 407, 448,
+    489, 529, 570, 610, 651, 692, 732, 773, 813, 854, 894, 935,
+    975, 1015, 1056, 1096, 1136, 1177, 1217, 1257, 1297, 1337, 1377, 1417,
+    1457, 1497, 1537, 1577, 1617, 1656, 1696, 1736, 1775, 1815, 1854, 1894,
+    1933, 1973, 2012, 2051, 2090, 2129, 2168, 2207, 2246, 2285, 2324, 2363,
+    2401, 2440, 2478, 2517, 2555, 2594, 2632, 2670, 2708, 2746, 2784, 2822,
+    2860, 2897, 2935, 2973, 3010, 3047, 3085, 3122, 3159, 3196, 3233, 3270,
+    3307, 3344, 3380, 3417, 3453, 3490, 3526, 3562, 3599, 3635, 3670, 3706,
+    3742, 3778, 3813, 3849, 3884, 3920, 3955, 3990, 4025, 4060, 4095, 4129,
+    4164, 4199, 4233, 4267, 4302, 4336, 4370, 4404, 4438, 4471, 4505, 4539,
+    4572, 4605, 4639, 4672, 4705, 4738, 4771, 4803, 4836, 4869, 4901, 4933,
+    4966, 4998, 5030, 5062, 5094, 5125, 5157, 5188, 5220, 5251, 5282, 5313,
+    5344, 5375, 5406, 5437, 5467, 5498, 5528, 5559, 5589, 5619, 5649, 5679,
+    5708, 5738, 5768, 5797, 5826, 5856, 5885, 5914, 5943, 5972, 6000, 6029,
+    6058, 6086, 6114, 6142, 6171, 6199, 6227, 6254, 6282, 6310, 6337, 6365,
+    6392, 6419, 6446, 6473, 6500, 6527, 6554, 6580, 6607, 6633, 6660, 6686,
+    6712, 6738, 6764, 6790, 6815, 6841, 6867, 6892, 6917, 6943, 6968, 6993,
+    7018, 7043, 7068, 7092, 7117, 7141, 7166, 7190, 7214, 7238, 7262, 7286,
+    7310, 7334, 7358, 7381, 7405, 7428, 7451, 7475, 7498, 7521, 7544, 7566,
+    7589, 7612, 7635, 7657, 7679, 7702, 7724, 7746, 7768, 7790, 7812, 7834,
+    7856, 7877, 7899, 7920, 7942, 7963, 7984, 8005, 8026, 8047, 8068, 8089,
+    8110, 8131, 8151, 8172, 8192,
+};
+
+
+// The quarter repeats mirrored, then negated: 64 angle units a step
+fx_t fx_sin(fx_angle_t a) {
+    unsigned quadrant = a >> 14;
+    unsigned p = a & (FX_QUARTER - 1);
+    if (quadrant & 1) p = FX_QUARTER - p;
+    unsigned i = p >> 6, f = p & 63;
+    int32_t v = sin_q30[i];
+    if (f) v += ((sin_q30[i + 1] - v) * (int32_t)f) >> 6;
+#if FX_FRAC_BITS < 30
+    v = (v + ((int32_t)1 << (29 - FX_FRAC_BITS))) >> (30 - FX_FRAC_BITS);   // rounded
+#endif
+    return quadrant & 2 ? -v : v;
+}
+
+fx_t fx_cos(fx_angle_t a) {
+    return fx_sin((fx_angle_t)(a + FX_QUARTER));
+}
+
+// Folded into the first octant, where the ratio of the smaller to the
+// larger side is 0 .. 1 and indexes the table. Both sides are brought
+// under 2^15 first, so the ratio in Q16 is a 32-bit division
+fx_angle_t fx_atan2(fx_t y, fx_t x) {
+    uint32_t ax = x < 0 ? 0u - (uint32_t)x : (uint32_t)x;
+    uint32_t ay = y < 0 ? 0u - (uint32_t)y : (uint32_t)y;
+    if (ax == 0 && ay == 0) return 0;
+    uint32_t lo = ax < ay ? ax : ay, hi = ax < ay ? ay : ax;
+    int shift = 32 - __builtin_clz(hi) - 15;
+    if (shift > 0) {
+        hi >>= shift;
+        lo >>= shift;
+    }
+    uint32_t r = (lo << 16) / hi;       // 0 .. 65536
+    uint32_t i = r >> 8, f = r & 255;
+    uint32_t angle = atan_tab[i];
+    if (f) angle += ((atan_tab[i + 1] - angle) * f + 128) >> 8;
+    if (ay > ax) angle = FX_QUARTER - angle;
+    if (x < 0) angle = FX_TURN / 2 - angle;
+    if (y < 0) angle = FX_TURN - angle;
+    return (fx_angle_t)angle;
+}
+
+// Digit by digit, two bits of x for each bit of the root: shifts,
+// compares and subtractions, no multiply or divide
+fx_t fx_sqrt(fx_t x) {
+    if (x <= 0) return 0;
+    uint64_t v = (uint64_t)x << FX_FRAC_BITS;
+    uint64_t root = 0, bit = (uint64_t)1 << 62;
+    while (bit > v) bit >>= 2;
+    while (bit) {
+        if (v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (fx_t)root;
+}
+
+// a s with the halves of s split out already
+static inline fx_t mul_split(fx_t a, int32_t sh, uint32_t sl) {
+#if FX_MUL_32
+    int32_t ah = a >> 16;
+    uint32_t al = (uint32_t)a & 0xFFFF;
+    return (fx_t)(((uint32_t)(ah * sh) << 16) + (uint32_t)(ah * (int32_t)sl) +
+                  (uint32_t)((int32_t)al * sh) + ((al * sl) >> 16));
+#else
+    return fx_mul(a, (fx_t)(((uint32_t)sh << 16) | sl));
+#endif
+}
+
+void fx_mul_n(fx_t *r, const fx_t *a, const fx_t *b, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        fx_t r0 = fx_mul(a[i], b[i]), r1 = fx_mul(a[i + 1], b[i + 1]);
+        fx_t r2 = fx_mul(a[i + 2], b[i + 2]), r3 = fx_mul(a[i + 3], b[i + 3]);
+        r[i] = r0; r[i + 1] = r1; r[i + 2] = r2; r[i + 3] = r3;
+    }
+    for (; i < n; i++) r[i] = fx_mul(a[i], b[i]);
+}
+
+void fx_scale_n(fx_t *r, const fx_t *a, fx_t s, int n) {
+    int32_t sh = s >> 16;
+    uint32_t sl = (uint32_t)s & 0xFFFF;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        r[i] = mul_split(a[i], sh, sl);
+        r[i + 1] = mul_split(a[i + 1], sh, sl);
+        r[i + 2] = mul_split(a[i + 2], sh, sl);
+        r[i + 3] = mul_split(a[i + 3], sh, sl);
+    }
+    for (; i < n; i++) r[i] = mul_split(a[i], sh, sl);
+}
+
+void fx_lerp_n(fx_t *r, const fx_t *a, const fx_t *b, fx_t t, int n) {
+    int32_t th = t >> 16;
+    uint32_t tl = (uint32_t)t & 0xFFFF;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        fx_t a0 = a[i], a1 = a[i + 1], a2 = a[i + 2], a3 = a[i + 3];
+        r[i] = a0 + mul_split(b[i] - a0, th, tl);
+        r[i + 1] = a1 + mul_split(b[i + 1] - a1, th, tl);
+        r[i + 2] = a2 + mul_split(b[i + 2] - a2, th, tl);
+        r[i + 3] = a3 + mul_split(b[i + 3] - a3, th, tl);
+    }
+    for (; i < n; i++) r[i] = a[i] + mul_split(b[i] - a[i], th, tl);
+}
+
+void fx_add_sat_n(fx_t *r, const fx_t *a, const fx_t *b, int n) {
+    for (int i = 0; i < n; i++) r[i] = fx_add_sat(a[i], b[i]);
+}
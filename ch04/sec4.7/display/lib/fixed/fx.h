@@ -0,0 +1,103 @@
+#ifndef FX_H
+#define FX_H
+
+#include <stdint.h>
+
+// Fixed-point arithmetic shared by the games and the sprite engine.
+// A value is an int32_t with FX_FRAC_BITS bits after the point, Q16.16
+// unless a build defines another (1 .. 30). The RP2040 and RP2350 have
+// no FPU, so this is what takes the place of float where speed matters.
+//
+// fx_mul() and fx_div() wrap on overflow like the old FIXED_* macros,
+// the _sat variants stop at FX_MAX / FX_MIN instead. Angles are binary,
+// FX_TURN to a full turn, so they wrap by themselves in a uint16_t
+
+#ifndef FX_FRAC_BITS
+#define FX_FRAC_BITS 16
+#endif
+#if FX_FRAC_BITS < 1 || FX_FRAC_BITS > 30
+#error "FX_FRAC_BITS must be 1 .. 30"
+#endif
+
+typedef int32_t fx_t;
+typedef uint16_t fx_angle_t;
+
+#define FX_ONE ((fx_t)1 << FX_FRAC_BITS)
+#define FX_MAX INT32_MAX
+#define FX_MIN INT32_MIN
+#define FX_TURN 65536         // fx_angle_t units in a full turn
+#define FX_QUARTER 16384
+
+#define FX_FROM_INT(x) ((fx_t)(x) * FX_ONE)
+#define FX_TO_INT(x) ((x) >> FX_FRAC_BITS)          // rounds down
+#define FX_FROM_FLOAT(x) ((fx_t)((x) * FX_ONE))
+#define FX_TO_FLOAT(x) ((float)(x) / FX_ONE)
+
+// The Cortex-M0+ multiplies 32 x 32 bits to the low 32 only; a 64-bit
+// product is a call to __aeabi_lmul. For Q16.16 four 16 x 16 partial
+// products give the same bits with single-cycle multiplies
+#ifndef FX_MUL_32
+#if defined(__ARM_ARCH_6M__) && FX_FRAC_BITS == 16
+#define FX_MUL_32 1
+#else
+#define FX_MUL_32 0
+#endif
+#endif
+#if FX_MUL_32 && FX_FRAC_BITS != 16
+#error "FX_MUL_32 is for Q16.16 only"
+#endif
+
+static inline fx_t fx_sat(int64_t v) {
+    return v > FX_MAX ? FX_MAX : v < FX_MIN ? FX_MIN : (fx_t)v;
+}
+
+static inline fx_t fx_add_sat(fx_t a, fx_t b) { return fx_sat((int64_t)a + b); }
+static inline fx_t fx_sub_sat(fx_t a, fx_t b) { return fx_sat((int64_t)a - b); }
+
+static inline fx_t fx_mul(fx_t a, fx_t b) {
+#if FX_MUL_32
+    // (ah 2^16 + al)(bh 2^16 + bl) >> 16, the low 32 bits of it
+    int32_t ah = a >> 16, bh = b >> 16;
+    uint32_t al = (uint32_t)a & 0xFFFF, bl = (uint32_t)b & 0xFFFF;
+    return (fx_t)(((uint32_t)(ah * bh) << 16) + (uint32_t)(ah * (int32_t)bl) +
+                  (uint32_t)((int32_t)al * bh) + ((al * bl) >> 16));
+#else
+    return (fx_t)(((int64_t)a * b) >> FX_FRAC_BITS);
+#endif
+}
+
+static inline fx_t fx_mul_sat(fx_t a, fx_t b) {
+    return fx_sat(((int64_t)a * b) >> FX_FRAC_BITS);
+}
+
+static inline fx_t fx_div(fx_t a, fx_t b) {
+    return (fx_t)(((int64_t)a * FX_ONE) / b);
+}
+
+// A zero divisor gives the largest value of the dividend's sign
+static inline fx_t fx_div_sat(fx_t a, fx_t b) {
+    if (b == 0) return a < 0 ? FX_MIN : FX_MAX;
+    return fx_sat(((int64_t)a * FX_ONE) / b);
+}
+
+static inline fx_t fx_abs(fx_t a) { return a < 0 ? -a : a; }
+
+// a + (b - a) t, t from 0 to FX_ONE
+static inline fx_t fx_lerp(fx_t a, fx_t b, fx_t t) { return a + fx_mul(b - a, t); }
+
+// Table lookups with linear interpolation: sin and cos within 5e-6 and
+// half a unit in the last place, atan2 within 2 angle units (0.011
+// degrees). fx_sqrt() is exact, the largest root with root * root <= x
+fx_t fx_sin(fx_angle_t a);
+fx_t fx_cos(fx_angle_t a);
+fx_angle_t fx_atan2(fx_t y, fx_t x);
+fx_t fx_sqrt(fx_t x);                  // 0 for x <= 0
+
+// Batch kernels over arrays, r may be a or b. Unrolled by four, and the
+// constant of fx_scale_n() and fx_lerp_n() is split into halves once
+void fx_mul_n(fx_t *r, const fx_t *a, const fx_t *b, int n);    // r = a b
+void fx_scale_n(fx_t *r, const fx_t *a, fx_t s, int n);         // r = a s
+void fx_lerp_n(fx_t *r, const fx_t *a, const fx_t *b, fx_t t, int n);
+void fx_add_sat_n(fx_t *r, const fx_t *a, const fx_t *b, int n);
+
+#endif // FX_H
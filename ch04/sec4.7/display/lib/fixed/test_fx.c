@@ -0,0 +1,144 @@
+// Host checks of fx.c against double precision and 64-bit arithmetic.
+// make test builds it three ways: as is, with the Cortex-M0+ multiply,
+// and in Q8.24
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "fx.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        printf("FAIL: " __VA_ARGS__); \
+        printf("\n"); \
+        failures++; \
+    } \
+} while (0)
+
+static uint32_t rng = 12345;
+static uint32_t next_random(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static fx_t ref_mul(fx_t a, fx_t b) {
+    return (fx_t)(((int64_t)a * b) >> FX_FRAC_BITS);
+}
+
+static void test_mul(void) {
+    static const fx_t edge[] = { 0, 1, -1, FX_ONE, -FX_ONE, FX_MAX, FX_MIN, 0xFFFF, -0x10000, 0x7FFF0000 };
+    int n = sizeof(edge) / sizeof(edge[0]);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            CHECK(fx_mul(edge[i], edge[j]) == ref_mul(edge[i], edge[j]),
+                  "fx_mul(%d, %d)", edge[i], edge[j]);
+    for (int i = 0; i < 1000000; i++) {
+        fx_t a = (fx_t)next_random(), b = (fx_t)next_random();
+        if (fx_mul(a, b) != ref_mul(a, b)) {
+            CHECK(0, "fx_mul(%d, %d) = %d, not %d", a, b, fx_mul(a, b), ref_mul(a, b));
+            break;
+        }
+    }
+}
+
+static void test_saturating(void) {
+    CHECK(fx_add_sat(FX_MAX, 1) == FX_MAX, "fx_add_sat up");
+    CHECK(fx_add_sat(FX_MIN, -1) == FX_MIN, "fx_add_sat down");
+    CHECK(fx_sub_sat(FX_MIN, 1) == FX_MIN, "fx_sub_sat down");
+    CHECK(fx_sub_sat(5, 3) == 2, "fx_sub_sat plain");
+    CHECK(fx_mul_sat(FX_FROM_INT(100), FX_MAX) == FX_MAX, "fx_mul_sat up");
+    CHECK(fx_mul_sat(FX_FROM_INT(-100), FX_MAX) == FX_MIN, "fx_mul_sat down");
+    CHECK(fx_mul_sat(FX_ONE * 3, FX_ONE / 2) == FX_ONE * 3 / 2, "fx_mul_sat plain");
+    CHECK(fx_div_sat(FX_ONE, 0) == FX_MAX && fx_div_sat(-FX_ONE, 0) == FX_MIN, "fx_div_sat by 0");
+    CHECK(fx_div_sat(FX_MAX, 1) == FX_MAX, "fx_div_sat up");
+    CHECK(fx_div(FX_ONE * 3, FX_ONE * 2) == FX_ONE * 3 / 2, "fx_div");
+}
+
+static void test_batch(void) {
+    enum { N = 1003 };   // not a multiple of four
+    static fx_t a[N], b[N], r[N];
+    for (int i = 0; i < N; i++) {
+        a[i] = (fx_t)next_random() >> 2;    // b - a in range for the lerps
+        b[i] = (fx_t)next_random() >> 2;
+    }
+    fx_mul_n(r, a, b, N);
+    for (int i = 0; i < N; i++) CHECK(r[i] == fx_mul(a[i], b[i]), "fx_mul_n at %d", i);
+    fx_t s = (fx_t)next_random();
+    fx_scale_n(r, a, s, N);
+    for (int i = 0; i < N; i++) CHECK(r[i] == fx_mul(a[i], s), "fx_scale_n at %d", i);
+    for (int k = 0; k < 5; k++) {
+        fx_t t = (fx_t)(FX_ONE / 4 * k);
+        fx_lerp_n(r, a, b, t, N);
+        for (int i = 0; i < N; i++) CHECK(r[i] == fx_lerp(a[i], b[i], t), "fx_lerp_n at %d", i);
+    }
+    CHECK(fx_lerp(FX_FROM_INT(2), FX_FROM_INT(6), FX_ONE / 4) == FX_FROM_INT(3), "fx_lerp");
+    fx_add_sat_n(r, a, b, N);
+    for (int i = 0; i < N; i++) CHECK(r[i] == fx_add_sat(a[i], b[i]), "fx_add_sat_n at %d", i);
+    for (int i = 0; i < N; i++) r[i] = a[i];
+    fx_mul_n(r, r, b, N);     // in place
+    for (int i = 0; i < N; i++) CHECK(r[i] == fx_mul(a[i], b[i]), "fx_mul_n in place at %d", i);
+}
+
+static void test_trig(void) {
+    double worst = 0;
+    for (int a = 0; a < FX_TURN; a++) {
+        double angle = 2 * M_PI * a / FX_TURN;
+        double es = fabs((double)fx_sin((fx_angle_t)a) / FX_ONE - sin(angle));
+        double ec = fabs((double)fx_cos((fx_angle_t)a) / FX_ONE - cos(angle));
+        if (es > worst) worst = es;
+        if (ec > worst) worst = ec;
+    }
+    printf("sin/cos: largest error %.2e\n", worst);
+    CHECK(worst < 5e-6 + 0.5 / FX_ONE, "sin/cos error %.2e", worst);
+    CHECK(fx_sin(0) == 0 && fx_sin(FX_QUARTER) == FX_ONE && fx_cos(FX_QUARTER * 2) == -FX_ONE,
+          "sin/cos at the axes");
+
+    int worst_units = 0;
+    for (int i = 0; i < 200000; i++) {
+        fx_t y = (fx_t)next_random() >> (next_random() % 24);
+        fx_t x = (fx_t)next_random() >> (next_random() % 24);
+        if (x == 0 && y == 0) continue;
+        double exact = atan2((double)y, (double)x) / (2 * M_PI) * FX_TURN;
+        int d = abs((int)lround(exact) - (int)fx_atan2(y, x)) % FX_TURN;
+        if (d > FX_TURN / 2) d = FX_TURN - d;
+        if (d > worst_units) worst_units = d;
+    }
+    printf("atan2: largest error %d units\n", worst_units);
+    CHECK(worst_units <= 2, "atan2 error %d units", worst_units);
+    CHECK(fx_atan2(0, FX_ONE) == 0 && fx_atan2(FX_ONE, 0) == FX_QUARTER &&
+          fx_atan2(0, -FX_ONE) == FX_TURN / 2 && fx_atan2(-FX_ONE, 0) == 3 * FX_QUARTER &&
+          fx_atan2(FX_ONE, FX_ONE) == FX_QUARTER / 2, "atan2 at the axes");
+}
+
+static void test_sqrt(void) {
+    CHECK(fx_sqrt(0) == 0 && fx_sqrt(-FX_ONE) == 0, "sqrt of 0 and below");
+    CHECK(fx_sqrt(FX_FROM_INT(4)) == FX_FROM_INT(2), "sqrt(4)");
+    CHECK(fx_sqrt(FX_ONE / 4) == FX_ONE / 2, "sqrt(0.25)");
+    for (int i = 0; i < 1000000; i++) {
+        fx_t x = (fx_t)(next_random() >> 1);
+        if (i < 1000) x = FX_MAX - i;
+        uint64_t v = (uint64_t)x << FX_FRAC_BITS, r = (uint64_t)fx_sqrt(x);
+        if (!(r * r <= v && (r + 1) * (r + 1) > v)) {
+            CHECK(0, "fx_sqrt(%d) = %llu", x, (unsigned long long)r);
+            break;
+        }
+    }
+}
+
+int main(void) {
+    printf("Q%d.%d%s\n", 32 - FX_FRAC_BITS, FX_FRAC_BITS, FX_MUL_32 ? ", 32-bit multiply" : "");
+    test_mul();
+    test_saturating();
+    test_batch();
+    test_trig();
+    test_sqrt();
+    if (failures) {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,285 @@
+#include "jobs.h"
+#include <stddef.h>
+
+// The platform: start the second core, tell which core this is, read a
+// microsecond clock, the doorbell for core 1, the event for core 0, and
+// an atomic add for claiming range chunks. Each event latches, so one
+// that comes before the wait is not lost.
+
+#if defined(LIB_PICO_MULTICORE)
+
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+#include "pico/time.h"
+
+// The Cortex-M0+ has no exclusive loads and stores, so the one atomic
+// add takes a hardware spinlock, a few cycles. The ring needs none
+static spin_lock_t *claim_lock;
+
+static void port_start(void (*worker)(void)) {
+    if (!claim_lock) claim_lock = spin_lock_instance(spin_lock_claim_unused(true));
+    multicore_launch_core1(worker);
+}
+
+static void port_stop(void) {
+    multicore_reset_core1();
+}
+
+static int port_core(void) {
+    return (int)get_core_num();
+}
+
+static uint32_t port_now_us(void) {
+    return time_us_32();
+}
+
+// A word in the FIFO; if it is full, core 1 has words to wake it already
+static void port_doorbell(void) {
+    if (multicore_fifo_wready()) multicore_fifo_push_blocking(0);
+}
+
+// Words from before core 1 last read the ring wake it for nothing
+static void port_clear_doorbell(void) {
+    multicore_fifo_drain();
+}
+
+static void port_sleep(void) {
+    multicore_fifo_pop_blocking();
+}
+
+static void port_signal(void) {
+    __sev();
+}
+
+static void port_wait(void) {
+    __wfe();
+}
+
+static int port_fetch_add(int *p, int n) {
+    uint32_t irq = spin_lock_blocking(claim_lock);
+    int old = *p;
+    *p = old + n;
+    spin_unlock(claim_lock, irq);
+    return old;
+}
+
+static bool port_quit(void) {
+    return false;       // core 1 is reset
+}
+
+#else
+
+#include <pthread.h>
+#include <time.h>
+
+static pthread_t worker_thread;
+static pthread_mutex_t port_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t port_cond = PTHREAD_COND_INITIALIZER;
+static bool rung, signalled, quit;
+static _Thread_local int this_core;
+static void (*worker_fn)(void);
+
+static void *worker_main(void *unused) {
+    (void)unused;
+    this_core = 1;
+    worker_fn();
+    return NULL;
+}
+
+static void port_start(void (*worker)(void)) {
+    worker_fn = worker;
+    quit = false;
+    pthread_create(&worker_thread, NULL, worker_main, NULL);
+}
+
+static void port_stop(void) {
+    pthread_mutex_lock(&port_lock);
+    quit = rung = true;
+    pthread_cond_broadcast(&port_cond);
+    pthread_mutex_unlock(&port_lock);
+    pthread_join(worker_thread, NULL);
+}
+
+static int port_core(void) {
+    return this_core;
+}
+
+static uint32_t port_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000ull + ts.tv_nsec / 1000);
+}
+
+static void port_doorbell(void) {
+    pthread_mutex_lock(&port_lock);
+    rung = true;
+    pthread_cond_broadcast(&port_cond);
+    pthread_mutex_unlock(&port_lock);
+}
+
+static void port_clear_doorbell(void) {
+    pthread_mutex_lock(&port_lock);
+    rung = false;
+    pthread_mutex_unlock(&port_lock);
+}
+
+static void port_sleep(void) {
+    pthread_mutex_lock(&port_lock);
+    while (!rung) pthread_cond_wait(&port_cond, &port_lock);
+    rung = false;
+    pthread_mutex_unlock(&port_lock);
+}
+
+static void port_signal(void) {
+    pthread_mutex_lock(&port_lock);
+    signalled = true;
+    pthread_cond_broadcast(&port_cond);
+    pthread_mutex_unlock(&port_lock);
+}
+
+static void port_wait(void) {
+    pthread_mutex_lock(&port_lock);
+    while (!signalled) pthread_cond_wait(&port_cond, &port_lock);
+    signalled = false;
+    pthread_mutex_unlock(&port_lock);
+}
+
+static int port_fetch_add(int *p, int n) {
+    return __atomic_fetch_add(p, n, __ATOMIC_RELAXED);
+}
+
+static bool port_quit(void) {
+    pthread_mutex_lock(&port_lock);
+    bool q = quit;
+    pthread_mutex_unlock(&port_lock);
+    return q;
+}
+
+#endif
+
+// The ring: head is written by core 0 only, tail and done by core 1
+// only. An acquire load of the other side's index sees the jobs or
+// results written before its release store, and plain 32-bit loads and
+// stores are all the M0+ needs for that, with a DMB
+typedef struct {
+    job_fn_t fn;
+    void *arg;
+} job_t;
+
+static struct {
+    job_t ring[JOBS_QUEUE_SIZE];
+    uint32_t head;              // jobs submitted
+    uint32_t tail;              // jobs taken
+    uint32_t done;              // jobs finished
+    bool running;
+} queue;
+
+static struct {
+    uint32_t busy_us[2];
+    uint32_t jobs[2];
+    uint32_t since_us;
+} stats;
+
+#define LOAD(p) __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define STORE(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+
+// Each core adds to its own counters only
+static void account(uint32_t start_us) {
+    int core = port_core();
+    stats.busy_us[core] += port_now_us() - start_us;
+    stats.jobs[core]++;
+}
+
+// Core 1: run what is in the ring, then sleep until the doorbell. It is
+// cleared before the ring is read, so a job put in after the read comes
+// with a doorbell that wakes core 1 again
+static void worker(void) {
+    while (!port_quit()) {
+        port_clear_doorbell();
+        uint32_t tail = queue.tail;
+        while (tail != LOAD(&queue.head)) {
+            job_t job = queue.ring[tail % JOBS_QUEUE_SIZE];
+            STORE(&queue.tail, ++tail);
+            uint32_t start = port_now_us();
+            job.fn(job.arg);
+            account(start);
+            STORE(&queue.done, queue.done + 1);
+            port_signal();
+        }
+        port_sleep();
+    }
+}
+
+bool jobs_init(void) {
+    if (queue.running) return false;
+    queue.head = queue.tail = queue.done = 0;
+    jobs_reset_stats();
+    queue.running = true;
+    port_start(worker);
+    return true;
+}
+
+void jobs_shutdown(void) {
+    if (!queue.running) return;
+    jobs_wait();
+    port_stop();
+    queue.running = false;
+}
+
+bool jobs_submit(job_fn_t fn, void *arg) {
+    uint32_t head = queue.head;
+    if (!queue.running || head - LOAD(&queue.tail) == JOBS_QUEUE_SIZE) return false;
+    queue.ring[head % JOBS_QUEUE_SIZE] = (job_t){ fn, arg };
+    STORE(&queue.head, head + 1);
+    port_doorbell();
+    return true;
+}
+
+void jobs_wait(void) {
+    while (LOAD(&queue.done) != queue.head) port_wait();
+}
+
+// One parallel_for at a time, from core 0
+typedef struct {
+    range_fn_t fn;
+    void *arg;
+    int count, grain;
+    int next;                   // first index not claimed
+} range_t;
+
+// Core 1 runs this as a job of its own
+static void run_range(void *arg) {
+    range_t *r = arg;
+    for (;;) {
+        int begin = port_fetch_add(&r->next, r->grain);
+        if (begin >= r->count) return;
+        int end = begin + r->grain < r->count ? begin + r->grain : r->count;
+        r->fn(r->arg, begin, end);
+    }
+}
+
+void jobs_parallel_for(int count, int grain, range_fn_t fn, void *arg) {
+    if (count <= 0) return;
+    range_t r = { fn, arg, count, grain > 0 ? grain : 1, 0 };
+    bool shared = count > r.grain && jobs_submit(run_range, &r);
+    uint32_t start = port_now_us();
+    run_range(&r);
+    account(start);
+    if (shared) jobs_wait();
+}
+
+void jobs_get_stats(jobs_stats_t *s) {
+    for (int core = 0; core < 2; core++) {
+        s->busy_us[core] = stats.busy_us[core];
+        s->jobs[core] = stats.jobs[core];
+    }
+    s->elapsed_us = port_now_us() - stats.since_us;
+}
+
+void jobs_reset_stats(void) {
+    for (int core = 0; core < 2; core++) {
+        stats.busy_us[core] = 0;
+        stats.jobs[core] = 0;
+    }
+    stats.since_us = port_now_us();
+}
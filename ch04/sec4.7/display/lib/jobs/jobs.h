@@ -0,0 +1,48 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Work for the second core, shared by the multicore demos and games.
+// Core 0 puts jobs into a ring in shared SRAM, and core 1 takes them
+// out: one producer and one consumer, so neither side takes a lock. A
+// word in the SIO FIFO wakes core 1 when it sleeps on an empty ring,
+// and core 0 sleeps in WFE until core 1 has caught up. On a host the
+// second core is a thread, for the tests.
+//
+// Only core 0 may submit or wait. A job must not submit jobs itself.
+
+#define JOBS_QUEUE_SIZE 16      // power of two
+
+typedef void (*job_fn_t)(void *arg);
+typedef void (*range_fn_t)(void *arg, int begin, int end);
+
+// Per core, since the last jobs_reset_stats(). A parallel_for counts as
+// a job on each core that takes part; busy_us[core] * 100 / elapsed_us
+// is how much of the time a core was working
+typedef struct {
+    uint32_t busy_us[2];
+    uint32_t jobs[2];
+    uint32_t elapsed_us;
+} jobs_stats_t;
+
+// Start core 1; false if it is running already
+bool jobs_init(void);
+void jobs_shutdown(void);
+
+// Queue a job for core 1; false if the ring is full
+bool jobs_submit(job_fn_t fn, void *arg);
+
+// Until core 1 has run every job submitted so far
+void jobs_wait(void);
+
+// fn(arg, begin, end) over [0, count) in chunks of grain, taken by both
+// cores as they get free; it returns when all are done. Core 0 does all
+// of it if core 1 is not running or its ring is full
+void jobs_parallel_for(int count, int grain, range_fn_t fn, void *arg);
+
+void jobs_get_stats(jobs_stats_t *stats);
+void jobs_reset_stats(void);
+
+#endif // JOBS_H
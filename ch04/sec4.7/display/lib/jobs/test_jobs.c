@@ -0,0 +1,103 @@
+// Host checks of jobs.c, with a thread for core 1: every job runs once
+// and is done when jobs_wait() returns, a full ring refuses more, and
+// parallel_for covers each index once, over many rounds to shake out
+// races between the two sides
+#include <stdio.h>
+#include <string.h>
+#include "jobs.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        printf("FAIL: " __VA_ARGS__); \
+        printf("\n"); \
+        failures++; \
+    } \
+} while (0)
+
+enum { N = 10007 };
+static int hits[N];
+
+static void count_job(void *arg) {
+    hits[(int *)arg - hits]++;
+}
+
+static void count_range(void *arg, int begin, int end) {
+    int *h = arg;
+    for (int i = begin; i < end; i++) h[i]++;
+}
+
+static volatile int gate;
+
+static void blocked_job(void *arg) {
+    (void)arg;
+    while (!gate) {}
+}
+
+static void test_jobs(void) {
+    memset(hits, 0, sizeof(hits));
+    for (int round = 0; round < 1000; round++) {
+        for (int j = 0; j < JOBS_QUEUE_SIZE; j++) {
+            CHECK(jobs_submit(count_job, &hits[j]), "submit %d of round %d", j, round);
+        }
+        jobs_wait();
+        for (int j = 0; j < JOBS_QUEUE_SIZE; j++) {
+            if (hits[j] != round + 1) {
+                CHECK(0, "job %d ran %d times after round %d", j, hits[j], round);
+                return;
+            }
+        }
+    }
+}
+
+static void test_full(void) {
+    gate = 0;
+    CHECK(jobs_submit(blocked_job, NULL), "submit blocking job");
+    int queued = 0;
+    while (queued <= JOBS_QUEUE_SIZE && jobs_submit(count_job, &hits[0])) queued++;
+    CHECK(queued >= JOBS_QUEUE_SIZE - 1 && queued <= JOBS_QUEUE_SIZE,
+          "%d jobs queued behind a running one", queued);
+    gate = 1;
+    jobs_wait();
+}
+
+static void test_parallel_for(void) {
+    static const int grains[] = { 1, 7, 64, N, 0 };
+    for (int g = 0; g < 5; g++) {
+        for (int round = 0; round < 200; round++) {
+            memset(hits, 0, sizeof(hits));
+            int count = N - round;
+            jobs_parallel_for(count, grains[g], count_range, hits);
+            for (int i = 0; i < N; i++) {
+                if (hits[i] != (i < count)) {
+                    CHECK(0, "grain %d, count %d: index %d run %d times", grains[g], count, i, hits[i]);
+                    return;
+                }
+            }
+        }
+    }
+}
+
+int main(void) {
+    jobs_parallel_for(100, 10, count_range, hits);      // before init: core 0 alone
+    CHECK(hits[99] == 1, "parallel_for without core 1");
+
+    CHECK(jobs_init(), "jobs_init");
+    CHECK(!jobs_init(), "second jobs_init");
+    jobs_reset_stats();
+    test_jobs();
+    test_full();
+    test_parallel_for();
+
+    jobs_stats_t s;
+    jobs_get_stats(&s);
+    printf("core 0: %u jobs, busy %u us; core 1: %u jobs, busy %u us; of %u us\n",
+           s.jobs[0], s.busy_us[0], s.jobs[1], s.busy_us[1], s.elapsed_us);
+    CHECK(s.jobs[0] == 1000, "core 0 ran %u parallel_fors, not 1000", s.jobs[0]);
+    CHECK(s.jobs[1] >= 1000 * JOBS_QUEUE_SIZE, "core 1 ran %u jobs", s.jobs[1]);
+    jobs_shutdown();
+
+    printf(failures ? "%d FAILED\n" : "all passed\n", failures);
+    return failures != 0;
+}
@@ -39,14 +39,31 @@ static struct {
 
 static button_callback_t button_cb[BUTTON_COUNT] = {0};
 static volatile bool btn_state[BUTTON_COUNT] = {0};           // Debounced state
-static volatile bool btn_raw_state[BUTTON_COUNT] = {0};       // Current raw reading
-static volatile uint32_t btn_debounce_time[BUTTON_COUNT] = {0}; // Last state change time
+static volatile uint64_t btn_edge_time[BUTTON_COUNT] = {0};   // Last accepted edge (us)
+static uint64_t btn_press_time[BUTTON_COUNT] = {0};           // Last press delivered (us)
 static volatile bool btn_pressed[BUTTON_COUNT] = {0};         // Edge flag
 static volatile bool btn_released[BUTTON_COUNT] = {0};        // Edge flag
 static bool buttons_ready = false;
 
 #define DEBOUNCE_MS 50  // 50ms debounce time
 
+// Edges are caught by the GPIO interrupt and queued with their time.
+// The first edge is taken at once, later ones are ignored until
+// DEBOUNCE_MS has passed, so debouncing adds no latency to a press.
+// The interrupt produces and buttons_update consumes, so the ring needs
+// no lock (buttons_update only queues with interrupts off).
+#define BUTTON_EVENT_QUEUE 32   // Power of two
+
+typedef struct {
+    uint8_t button;
+    bool pressed;
+    uint64_t time_us;
+} button_event_t;
+
+static button_event_t btn_events[BUTTON_EVENT_QUEUE];
+static volatile uint32_t btn_event_head = 0;   // Written by the interrupt
+static volatile uint32_t btn_event_tail = 0;   // Written by buttons_update
+
 
 // Full 5×8 font (ASCII 32-127)
 static const uint8_t FONT_5X8[][5] = {
@@ -499,23 +516,57 @@ void disp_framebuffer_draw_text(uint16_t x, uint16_t y, const char *txt, uint16_
 }
 
 // Buttons
+// Queue an accepted edge; when the ring is full the edge is dropped
+static void button_queue_edge(int i, bool pressed, uint64_t now) {
+    btn_state[i] = pressed;
+    btn_edge_time[i] = now;
+    
+    uint32_t head = btn_event_head;
+    if (head - btn_event_tail == BUTTON_EVENT_QUEUE) return;
+    btn_events[head % BUTTON_EVENT_QUEUE] = (button_event_t){ (uint8_t)i, pressed, now };
+    __dmb();  // Event written before the head moves past it
+    btn_event_head = head + 1;
+}
+
+static void button_irq_handler(void) {
+    uint64_t now = time_us_64();
+    
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        uint32_t events = gpio_get_irq_event_mask(button_pins[i]);
+        if (!events) continue;
+        gpio_acknowledge_irq(button_pins[i], events);
+        
+        // Active low: pressed when the pin reads 0
+        bool pressed = !gpio_get(button_pins[i]);
+        if (pressed == btn_state[i]) continue;
+        if (now - btn_edge_time[i] < DEBOUNCE_MS * 1000) continue;  // Bounce
+        button_queue_edge(i, pressed, now);
+    }
+}
+
 disp_error_t buttons_init(void) {
     if (buttons_ready) return DISP_OK;
 
+    uint32_t mask = 0;
     for (int i = 0; i < BUTTON_COUNT; i++) {
         gpio_init(button_pins[i]);
         gpio_set_dir(button_pins[i], GPIO_IN);
         gpio_pull_up(button_pins[i]);
         
         // Read initial state (active low, so invert)
-        bool raw = !gpio_get(button_pins[i]);
-        
-        btn_state[i] = raw;
-        btn_raw_state[i] = raw;
+        btn_state[i] = !gpio_get(button_pins[i]);
         btn_pressed[i] = false;
         btn_released[i] = false;
-        btn_debounce_time[i] = to_ms_since_boot(get_absolute_time());
+        btn_edge_time[i] = time_us_64();
+        mask |= 1u << button_pins[i];
+    }
+    btn_event_head = btn_event_tail = 0;
+    
+    gpio_add_raw_irq_handler_masked(mask, button_irq_handler);
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        gpio_set_irq_enabled(button_pins[i], GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
     }
+    irq_set_enabled(IO_IRQ_BANK0, true);
     
     buttons_ready = true;
     printf("DEBUG: Buttons initialized\n");
@@ -525,48 +576,39 @@ disp_error_t buttons_init(void) {
 void buttons_update(void) {
     if (!buttons_ready) return;
 
-    uint32_t now = to_ms_since_boot(get_absolute_time());
-
+    uint64_t now = time_us_64();
+    
     for (int i = 0; i < BUTTON_COUNT; i++) {
-        // Read current raw state (active low - pressed = 0, so invert)
-        bool current_raw = !gpio_get(button_pins[i]);
-        
         // Clear edge flags at start of each update
         btn_pressed[i] = false;
         btn_released[i] = false;
         
-        // Check if raw state changed
-        if (current_raw != btn_raw_state[i]) {
-            // State changed - start debounce timer
-            btn_raw_state[i] = current_raw;
-            btn_debounce_time[i] = now;
+        // An edge inside the debounce window was ignored; if the pin has
+        // settled the other way since, take that level now
+        uint32_t irq = save_and_disable_interrupts();
+        bool level = !gpio_get(button_pins[i]);
+        if (level != btn_state[i] && now - btn_edge_time[i] >= DEBOUNCE_MS * 1000) {
+            button_queue_edge(i, level, now);
         }
+        restore_interrupts(irq);
+    }
+    
+    // Deliver queued edges; callbacks run here, outside the interrupt
+    while (btn_event_tail != btn_event_head) {
+        __dmb();
+        button_event_t ev = btn_events[btn_event_tail % BUTTON_EVENT_QUEUE];
+        btn_event_tail++;
         
-        // Check if enough time has passed for debounce
-        if (now - btn_debounce_time[i] >= DEBOUNCE_MS) {
-            // Debounce time expired, check if debounced state should change
-            if (btn_raw_state[i] != btn_state[i]) {
-                // State confirmed changed after debounce period
-                bool old_state = btn_state[i];
-                btn_state[i] = btn_raw_state[i];
-                
-                // Detect edges
-                if (btn_state[i] && !old_state) {
-                    // Rising edge - button pressed
-                    btn_pressed[i] = true;
-                    
-                    // Fire callback on press
-                    if (button_cb[i]) {
-                        printf("DEBUG: Button %d pressed (callback)\n", i);
-                        button_cb[i]((button_t)i);
-                    }
-                }
-                else if (!btn_state[i] && old_state) {
-                    // Falling edge - button released
-                    btn_released[i] = true;
-                    printf("DEBUG: Button %d released\n", i);
-                }
+        if (ev.pressed) {
+            btn_pressed[ev.button] = true;
+            btn_press_time[ev.button] = ev.time_us;
+            if (button_cb[ev.button]) {
+                printf("DEBUG: Button %d pressed (callback)\n", ev.button);
+                button_cb[ev.button]((button_t)ev.button);
             }
+        } else {
+            btn_released[ev.button] = true;
+            printf("DEBUG: Button %d released\n", ev.button);
         }
     }
 }
@@ -581,6 +623,11 @@ bool button_just_pressed(button_t b) {
     return (b < BUTTON_COUNT) ? btn_pressed[b] : false;
 }
 
+uint64_t button_press_time_us(button_t b) {
+    // Time of the press buttons_update() delivered last
+    return (b < BUTTON_COUNT) ? btn_press_time[b] : 0;
+}
+
 bool button_just_released(button_t b) {
     // Returns true for ONE update cycle after release
     return (b < BUTTON_COUNT) ? btn_released[b] : false;
@@ -105,6 +105,9 @@ void buttons_update(void);
 bool button_pressed(button_t button);
 bool button_just_pressed(button_t button);
 bool button_just_released(button_t button);
+// When the last delivered press happened, in time_us_64() microseconds,
+// as the GPIO interrupt saw it - not when buttons_update() ran
+uint64_t button_press_time_us(button_t button);
 disp_error_t button_set_callback(button_t button, button_callback_t callback);
 
 // Error handling
@@ -0,0 +1,39 @@
+#include "latency.h"
+#include "hardware/clocks.h"
+#include "latency.pio.h"
+
+bool latency_init(latency_t* lat, PIO pio, uint start_pin, uint stop_pin) {
+    if (!pio_can_add_program(pio, &latency_program)) return false;
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0) return false;
+
+    lat->pio = pio;
+    lat->sm = (uint)sm;
+    lat->offset = pio_add_program(pio, &latency_program);
+
+    pio_sm_config c = latency_program_get_default_config(lat->offset);
+    sm_config_set_in_pins(&c, start_pin);
+    sm_config_set_jmp_pin(&c, stop_pin);
+    sm_config_set_clkdiv(&c, 1.0f);
+    pio_sm_init(pio, lat->sm, lat->offset, &c);
+    pio_sm_set_enabled(pio, lat->sm, true);
+    return true;
+}
+
+void latency_arm(latency_t* lat) {
+    pio_sm_set_enabled(lat->pio, lat->sm, false);
+    pio_sm_clear_fifos(lat->pio, lat->sm);
+    pio_sm_restart(lat->pio, lat->sm);
+    pio_sm_exec(lat->pio, lat->sm, pio_encode_jmp(lat->offset));
+    pio_sm_set_enabled(lat->pio, lat->sm, true);
+}
+
+bool latency_read_ticks(latency_t* lat, uint32_t* ticks) {
+    if (pio_sm_is_rx_fifo_empty(lat->pio, lat->sm)) return false;
+    *ticks = pio_sm_get(lat->pio, lat->sm);
+    return true;
+}
+
+uint64_t latency_ticks_to_ns(uint32_t ticks) {
+    return (uint64_t)ticks * 2 * 1000000000u / clock_get_hz(clk_sys);
+}
@@ -0,0 +1,32 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/pio.h"
+
+// Latency capture in PIO: one state machine measures from a rising
+// edge on the start pin (an LED, the backlight, a debug pin raised
+// when a frame goes out ..) to the stop pin going low (an active-low
+// button), to two system clocks. Each start edge gives one measurement,
+// queued in the FIFO, so in a game it can run all the time
+
+typedef struct {
+    PIO pio;
+    uint sm;
+    uint offset;
+} latency_t;
+
+// false when no state machine or program space is free in pio
+bool latency_init(latency_t* lat, PIO pio, uint start_pin, uint stop_pin);
+
+// Forgets what was measured, and what was being: the next measurement
+// is from the next start edge
+void latency_arm(latency_t* lat);
+
+// The oldest measurement not read, if there is one
+bool latency_read_ticks(latency_t* lat, uint32_t* ticks);
+
+uint64_t latency_ticks_to_ns(uint32_t ticks);
+
+#endif // LATENCY_H
@@ -1,11 +1,14 @@
 #include "pico/stdlib.h"
 #include "display.h"
+#include "latency.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-// LED pin (backlight can be used as indicator)
-#define LED_PIN PIN_BL
+// LED pin (backlight can be used as indicator), and button A's, as
+// display.c has them
+#define LED_PIN      20
+#define BUTTON_A_PIN 12
 
 // Game states
 typedef enum {
@@ -20,14 +23,20 @@ typedef enum {
 // Game variables
 static game_state_t state = STATE_INSTRUCTIONS;
 static uint32_t state_start_time = 0;
-static uint32_t reaction_start_time = 0;
+static uint64_t reaction_start_us = 0;   // time_us_64() when GO showed
 static uint32_t last_reaction_time = 0;
+static uint32_t last_reaction_us = 0;    // the same, to the microsecond
+static bool last_from_pio = false;       // timed by the PIO, or the interrupt
 static uint32_t best_time = 999999;
 static uint32_t worst_time = 0;
 static int attempt_count = 0;
 static uint32_t total_time = 0;
 static uint32_t wait_duration = 0;
 
+// Backlight on to button A down, timed in the PIO
+static latency_t latency;
+static bool latency_ok = false;
+
 // Visual
 static uint16_t *fb = NULL;
 
@@ -214,7 +223,8 @@ static void draw_result(void) {
     
     // Draw time clearly - just once, large but readable
     char time_str[16];
-    snprintf(time_str, sizeof(time_str), "%lu ms", last_reaction_time);
+    snprintf(time_str, sizeof(time_str), "%lu.%03lu ms",
+             last_reaction_us / 1000, last_reaction_us % 1000);
     
     // Draw at 3x size by repeating horizontally and vertically  
     int len = strlen(time_str);
@@ -228,6 +238,8 @@ static void draw_result(void) {
     }
     
     draw_text_centered(115, rating, result_color);
+    draw_text_centered(130, last_from_pio ? "(timed by PIO)" : "(timed by interrupt)",
+                       COLOR_WHITE);
     
     // Statistics
     disp_framebuffer_fill_rect(20, 145, 280, 2, COLOR_WHITE);
@@ -320,8 +332,26 @@ static void button_a_pressed(button_t button) {
             break;
             
         case STATE_GO:
-            // Good press! Calculate reaction time
-            last_reaction_time = now - reaction_start_time;
+            // A press just before GO can be delivered after it; the
+            // timestamp from the button interrupt tells
+            if (button_press_time_us(BUTTON_A) < reaction_start_us) {
+                state = STATE_FALSE_START;
+                state_start_time = now;
+                draw_false_start();
+                update_led();
+                break;
+            }
+            
+            // Good press! The PIO timed it from the backlight to the pin;
+            // else time it from when the interrupt saw the button go down
+            uint32_t ticks;
+            last_from_pio = latency_ok && latency_read_ticks(&latency, &ticks);
+            if (last_from_pio) {
+                last_reaction_us = (uint32_t)(latency_ticks_to_ns(ticks) / 1000);
+            } else {
+                last_reaction_us = (uint32_t)(button_press_time_us(BUTTON_A) - reaction_start_us);
+            }
+            last_reaction_time = last_reaction_us / 1000;
             
             // Update statistics
             attempt_count++;
@@ -395,6 +425,12 @@ int main() {
     
     fb = disp_get_framebuffer();
     
+    // Both pins stay as they are; the PIO only reads them
+    latency_ok = latency_init(&latency, pio0, LED_PIN, BUTTON_A_PIN);
+    if (!latency_ok) {
+        printf("No PIO state machine free, timing by interrupt\n");
+    }
+    
     // Initialize buttons
     buttons_init();
     button_set_callback(BUTTON_A, button_a_pressed);
@@ -433,6 +469,8 @@ int main() {
                         wait_duration = (rand() % 3000) + 2000;
                         draw_waiting();
                         update_led();
+                        // measure from the GO to come, nothing before
+                        if (latency_ok) latency_arm(&latency);
                     } else {
                         // Update countdown display every second
                         static uint32_t last_second = 999;
@@ -451,9 +489,11 @@ int main() {
                     
                     if (elapsed >= wait_duration) {
                         state = STATE_GO;
-                        reaction_start_time = now;
                         draw_go();
                         update_led();
+                        // GO shows when the backlight comes on, after the
+                        // flush; the PIO starts counting at the same edge
+                        reaction_start_us = time_us_64();
                     }
                     break;
                 }
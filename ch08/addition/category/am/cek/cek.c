@@ -1,24 +1,49 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 // gcc -std=c99 -O2 cek.c -o cek
 
+// Objects are bump allocated in the nursery. When it fills, a minor
+// collection copies the live ones to the old space, malloc()ed objects
+// on gc_objects, and the nursery starts over. The old space is marked
+// and swept when it has doubled since the last time. No object changes
+// once made, so an old object never points into the nursery and the
+// machine state is the only root.
 typedef struct GCObject GCObject;
 
+enum { G_VALUE, G_ENV };
+
 struct GCObject {
-    int marked;
+    unsigned char marked;       // FORWARDED: copied out, next is the copy
+    unsigned char kind;
+    unsigned short size;
     GCObject *next;
 };
 
-GCObject *gc_objects = NULL;
+#define FORWARDED 2
+#define NURSERY_SIZE (256 * 1024)
+#define MAX_OBJECT 1024         // more than any one step allocates
 
-void *gc_alloc(size_t size) {
-    GCObject *obj = malloc(size);
-    if (!obj) { fprintf(stderr, "Out of memory\n"); exit(1); }
+double nursery[NURSERY_SIZE / sizeof(double)];
+size_t nursery_used = 0;
+GCObject *gc_objects = NULL;
+size_t old_bytes = 0;
+size_t old_limit = 1 << 20;
+int minor_collections = 0, major_collections = 0;
+
+void *gc_alloc(size_t size, int kind) {
+    size = (size + sizeof(double) - 1) & ~(sizeof(double) - 1);
+    if (size > MAX_OBJECT || nursery_used + size > NURSERY_SIZE) {
+        fprintf(stderr, "Nursery full\n");
+        exit(1);
+    }
+    GCObject *obj = (GCObject *) ((char *) nursery + nursery_used);
+    nursery_used += size;
     obj->marked = 0;
-    obj->next = gc_objects;
-    gc_objects = obj;
+    obj->kind = kind;
+    obj->size = size;
     return obj;
 }
 
@@ -27,11 +52,17 @@ typedef enum { T_VAR, T_LAM, T_APP, T_INT } TermTag;
 
 typedef struct Term Term;
 
+// Variables are resolved before running (see resolve()): index 0 is the
+// parameter of the nearest lambda, index i > 0 its free variable i - 1.
+// A lambda lists its free variables by their index in the surrounding
+// environment, to copy into the closure, and where compile() put its
+// body. canon is the first lambda seen with the same resolved structure
+// (see hashcons()), the one the memo table knows it by.
 struct Term {
     TermTag tag;
     union {
-        char *var;
-        struct { char *param; Term *body; } lam;
+        struct { char *name; int index; } var;
+        struct { char *param; Term *body; int nfree; int *captures; int code; Term *canon; } lam;
         struct { Term *fun, *arg; } app;
         int intval;
     };
@@ -42,106 +73,450 @@ struct Term {
 typedef enum { V_CLOSURE, V_INT, V_PRIM } ValueTag;
 
 typedef struct Env Env;
-typedef struct Kont Kont;
 
+// A closure holds the values of its free variables, in the order of
+// lam.captures, in the same allocation
 typedef struct Value {
     GCObject gc;
     ValueTag tag;
     union {
-        struct { char *param; Term *body; Env *env; } clo;
+        struct { Term *lam; struct Value **free; } clo;
         int intval;
     };
 } Value;
 
 
 
+// The frame of one application: the argument and the closure applied
 struct Env {
     GCObject gc;
-    char *name;
-    Value *value;
-    Env *next;
+    Value *arg;
+    Value *closure;
 };
 
-Env *env_extend(Env *env, char *name, Value *v) {
-    Env *e = gc_alloc(sizeof(Env));
-    e->name = name;
-    e->value = v;
-    e->next = env;
+Env *env_extend(Value *closure, Value *v) {
+    Env *e = gc_alloc(sizeof(Env), G_ENV);
+    e->arg = v;
+    e->closure = closure;
     return e;
 }
 
-Value *env_lookup(Env *env, char *name) {
-    while (env) {
-        if (!strcmp(env->name, name))
-            return env->value;
-        env = env->next;
+Value *env_lookup(Env *env, int index) {
+    return index == 0 ? env->arg : env->closure->clo.free[index - 1];
+}
+
+
+
+// Names are interned as the terms are made, with their lengths, so two
+// names are the same name when they are the same pointer
+#define MAX_NAMES 1024
+
+struct { char *chars; size_t length; } names[MAX_NAMES];
+int name_count = 0;
+
+char *intern(char *name) {
+    size_t length = strlen(name);
+    for (int i = 0; i < name_count; i++)
+        if (names[i].length == length && !memcmp(names[i].chars, name, length))
+            return names[i].chars;
+    if (name_count == MAX_NAMES) {
+        fprintf(stderr, "Too many names\n");
+        exit(1);
     }
-    fprintf(stderr, "Unbound variable: %s\n", name);
-    exit(1);
+    names[name_count].chars = name;
+    names[name_count].length = length;
+    name_count++;
+    return name;
 }
 
 
 
-typedef enum { K_HALT, K_ARG, K_FUN } KontTag;
+// resolve: names to indices, once before running
+typedef struct Scope Scope;
 
-struct Kont {
-    GCObject gc;
+struct Scope {
+    char *param;
+    int nfree;
+    char *free[64];
+    int captures[64];
+    Scope *outer;
+};
+
+int scope_index(Scope *s, char *name) {
+    if (!s) {
+        fprintf(stderr, "Unbound variable: %s\n", name);
+        exit(1);
+    }
+    if (s->param == name)
+        return 0;
+    for (int i = 0; i < s->nfree; i++)
+        if (s->free[i] == name)
+            return i + 1;
+    if (s->nfree == 64) {
+        fprintf(stderr, "Too many free variables\n");
+        exit(1);
+    }
+    s->captures[s->nfree] = scope_index(s->outer, name);
+    s->free[s->nfree] = name;
+    return ++s->nfree;
+}
+
+void resolve(Term *t, Scope *s) {
+    switch (t->tag) {
+    case T_VAR:
+        t->var.index = scope_index(s, t->var.name);
+        break;
+    case T_LAM: {
+        Scope inner = { t->lam.param, 0, { 0 }, { 0 }, s };
+        resolve(t->lam.body, &inner);
+        t->lam.nfree = inner.nfree;
+        free(t->lam.captures);
+        t->lam.captures = malloc(sizeof(int) * (inner.nfree ? inner.nfree : 1));
+        if (!t->lam.captures) { fprintf(stderr, "Out of memory\n"); exit(1); }
+        memcpy(t->lam.captures, inner.captures, sizeof(int) * inner.nfree);
+        break;
+    }
+    case T_APP:
+        resolve(t->app.fun, s);
+        resolve(t->app.arg, s);
+        break;
+    case T_INT:
+        break;
+    }
+}
+
+
+
+// hashcons: after resolve(), each lambda to the first one seen that is
+// the same but for names. Lambdas in its body are done first, so two of
+// them are the same when their canons are.
+#define CANON_BUCKETS 1024
+
+typedef struct Canon Canon;
+
+struct Canon { Term *lam; unsigned long hash; Canon *next; };
+
+Canon *canons[CANON_BUCKETS];
+
+int same_term(Term *a, Term *b) {
+    if (a->tag != b->tag) return 0;
+    switch (a->tag) {
+    case T_VAR: return a->var.index == b->var.index;
+    case T_INT: return a->intval == b->intval;
+    case T_LAM: return a->lam.canon == b->lam.canon;
+    case T_APP: return same_term(a->app.fun, b->app.fun) && same_term(a->app.arg, b->app.arg);
+    }
+    return 0;
+}
+
+unsigned long hashcons(Term *t) {
+    unsigned long h;
+    switch (t->tag) {
+    case T_VAR:
+        return 1 + 31 * (unsigned long) t->var.index;
+    case T_INT:
+        return 2 + 31 * (unsigned long) t->intval;
+    case T_APP:
+        h = hashcons(t->app.fun);
+        return 3 + 31 * (h * 31 + hashcons(t->app.arg));
+    case T_LAM:
+        h = 4 + 31 * hashcons(t->lam.body);
+        for (int i = 0; i < t->lam.nfree; i++)
+            h = h * 31 + (unsigned long) t->lam.captures[i];
+        for (Canon *c = canons[h % CANON_BUCKETS]; c; c = c->next) {
+            Term *l = c->lam;
+            if (c->hash == h && l->lam.nfree == t->lam.nfree &&
+                !memcmp(l->lam.captures, t->lam.captures, sizeof(int) * t->lam.nfree) &&
+                same_term(l->lam.body, t->lam.body)) {
+                t->lam.canon = l;
+                return h;
+            }
+        }
+        Canon *c = malloc(sizeof(Canon));
+        if (!c) { fprintf(stderr, "Out of memory\n"); exit(1); }
+        c->lam = t;
+        c->hash = h;
+        c->next = canons[h % CANON_BUCKETS];
+        canons[h % CANON_BUCKETS] = c;
+        t->lam.canon = t;
+        return h;
+    }
+    return 0;
+}
+
+
+
+// Memo table, off until memo_init(). The language has no effects, so an
+// application of a closure with nothing free depends on its lambda and
+// its argument alone. When the argument is plain, an int or a closure
+// with nothing free, the result is kept by (canon, argument) if it is
+// plain too. Nothing in the table points into the heap, so the
+// collector never sees it: a hit makes a fresh value. There are at most
+// memo_capacity entries, and the least recently used goes first.
+typedef struct {
+    ValueTag tag;               // V_INT or V_CLOSURE
+    union { int intval; Term *lam; };
+} Plain;
+
+typedef struct {
+    Term *lam;
+    Plain arg, result;
+    int newer, older;           // the LRU list, -1 at its ends
+    int next;                   // in the bucket, -1 at its end
+} MemoEntry;
+
+MemoEntry *memo = NULL;
+int *memo_buckets = NULL;
+int memo_capacity = 0, memo_count = 0, memo_mask = 0;
+int memo_newest = -1, memo_oldest = -1;
+long memo_hits = 0, memo_misses = 0, memo_evictions = 0, memo_unkept = 0;
+
+// capacity 0 turns it off; either way the table starts empty
+void memo_init(int capacity) {
+    free(memo);
+    free(memo_buckets);
+    memo = NULL;
+    memo_buckets = NULL;
+    memo_capacity = memo_count = 0;
+    memo_newest = memo_oldest = -1;
+    memo_hits = memo_misses = memo_evictions = memo_unkept = 0;
+    if (capacity <= 0) return;
+    int buckets = 1;
+    while (buckets < 2 * capacity) buckets *= 2;
+    memo = malloc(sizeof(MemoEntry) * capacity);
+    memo_buckets = malloc(sizeof(int) * buckets);
+    if (!memo || !memo_buckets) { fprintf(stderr, "Out of memory\n"); exit(1); }
+    for (int i = 0; i < buckets; i++) memo_buckets[i] = -1;
+    memo_mask = buckets - 1;
+    memo_capacity = capacity;
+}
+
+int plain(Value *v, Plain *p) {
+    if (v->tag == V_INT) {
+        p->tag = V_INT;
+        p->intval = v->intval;
+        return 1;
+    }
+    if (v->tag == V_CLOSURE && v->clo.lam->lam.nfree == 0) {
+        p->tag = V_CLOSURE;
+        p->lam = v->clo.lam->lam.canon;
+        return 1;
+    }
+    return 0;
+}
+
+Value *unplain(Plain p) {
+    Value *v = gc_alloc(sizeof(Value), G_VALUE);
+    v->tag = p.tag;
+    if (p.tag == V_INT) {
+        v->intval = p.intval;
+    } else {
+        v->clo.lam = p.lam;
+        v->clo.free = (Value **) (v + 1);
+    }
+    return v;
+}
+
+int same_plain(Plain a, Plain b) {
+    return a.tag == b.tag && (a.tag == V_INT ? a.intval == b.intval : a.lam == b.lam);
+}
+
+int *memo_bucket(Term *lam, Plain arg) {
+    unsigned long h = (unsigned long) lam * 31 +
+        (arg.tag == V_INT ? (unsigned long) arg.intval : (unsigned long) arg.lam);
+    h ^= h >> 17;
+    return &memo_buckets[(h * 0x9E3779B1ul) & memo_mask];
+}
+
+void lru_unlink(int i) {
+    MemoEntry *e = &memo[i];
+    if (e->newer >= 0) memo[e->newer].older = e->older; else memo_newest = e->older;
+    if (e->older >= 0) memo[e->older].newer = e->newer; else memo_oldest = e->newer;
+}
+
+void lru_push(int i) {
+    memo[i].newer = -1;
+    memo[i].older = memo_newest;
+    if (memo_newest >= 0) memo[memo_newest].newer = i; else memo_oldest = i;
+    memo_newest = i;
+}
+
+int memo_find(Term *lam, Plain arg) {
+    for (int i = *memo_bucket(lam, arg); i >= 0; i = memo[i].next)
+        if (memo[i].lam == lam && same_plain(memo[i].arg, arg))
+            return i;
+    return -1;
+}
+
+int memo_lookup(Term *lam, Plain arg, Plain *result) {
+    int i = memo_find(lam, arg);
+    if (i < 0) {
+        memo_misses++;
+        return 0;
+    }
+    memo_hits++;
+    lru_unlink(i);
+    lru_push(i);
+    *result = memo[i].result;
+    return 1;
+}
+
+void memo_record(Term *lam, Plain arg, Value *v) {
+    Plain result;
+    if (!plain(v, &result)) {
+        memo_unkept++;
+        return;
+    }
+    int i = memo_find(lam, arg);
+    if (i >= 0) {               // kept while this one ran
+        memo[i].result = result;
+        return;
+    }
+    if (memo_count < memo_capacity) {
+        i = memo_count++;
+    } else {
+        i = memo_oldest;
+        lru_unlink(i);
+        int *p = memo_bucket(memo[i].lam, memo[i].arg);
+        while (*p != i) p = &memo[*p].next;
+        *p = memo[i].next;
+        memo_evictions++;
+    }
+    int *bucket = memo_bucket(lam, arg);
+    memo[i] = (MemoEntry){ lam, arg, result, -1, -1, *bucket };
+    *bucket = i;
+    lru_push(i);
+}
+
+void memo_report(const char *name) {
+    long lookups = memo_hits + memo_misses;
+    printf("%s: %ld of %ld lookups hit (%.1f%%), %ld results not plain, "
+           "%ld evicted, %d of %d entries used\n",
+           name, memo_hits, lookups, lookups ? 100.0 * memo_hits / lookups : 0.0,
+           memo_unkept, memo_evictions, memo_count, memo_capacity);
+}
+
+
+
+typedef enum { K_HALT, K_ARG, K_FUN, K_MEMO } KontTag;
+
+// Nothing in the language captures a continuation, so the frames are
+// kept on one growable control stack instead of the heap, and an
+// argument frame turns into its function frame in place. A function
+// frame whose application goes in the memo table turns into a K_MEMO
+// frame, which waits for the result to keep it.
+typedef struct {
     KontTag tag;
     union {
-        struct { Term *arg; Env *env; Kont *next; } arg;
-        struct { Value *fun; Kont *next; } fun;
+        struct { Term *arg; Env *env; } arg;
+        struct { Value *fun; } fun;
+        struct { Term *lam; Plain arg; } memo;
     };
-};
+} Kont;
 
 
 
 typedef struct {
     Term *control;
     Env *env;
-    Kont *kont;
+    Kont *kont;         // the top frame, in stack
+    Kont *stack;        // stack[0] is K_HALT
+    int size;
     Value *value;
 } State;
 
+void push_kont(State *s) {
+    if (s->kont - s->stack == s->size - 1) {
+        int top = s->size - 1;
+        s->size *= 2;
+        s->stack = realloc(s->stack, sizeof(Kont) * s->size);
+        if (!s->stack) { fprintf(stderr, "Out of memory\n"); exit(1); }
+        s->kont = s->stack + top;
+    }
+    s->kont++;
+}
+
 
 // GC
+// A machine lists its roots by passing each of them through visit and
+// storing back what it returns: promote() for a minor collection,
+// mark() for a major one.
+typedef void (*Roots)(void *machine, void *(*visit)(void *));
+
+GCObject *promoted = NULL;      // copied to the old space, not yet scanned
+
+int in_nursery(void *p) {
+    return (char *) p >= (char *) nursery && (char *) p < (char *) nursery + NURSERY_SIZE;
+}
+
+void *promote(void *p) {
+    GCObject *o = p;
+    if (!o || !in_nursery(o))
+        return o;
+    if (o->marked == FORWARDED)
+        return o->next;
+    GCObject *c = malloc(o->size);
+    if (!c) { fprintf(stderr, "Out of memory\n"); exit(1); }
+    memcpy(c, o, o->size);
+    c->next = promoted;
+    promoted = c;
+    old_bytes += o->size;
+    o->marked = FORWARDED;
+    o->next = c;
+    return c;
+}
+
+void scan(GCObject *o) {
+    if (o->kind == G_VALUE) {
+        Value *v = (Value *) o;
+        if (v->tag == V_CLOSURE) {
+            v->clo.free = (Value **) (v + 1);
+            for (int i = 0; i < v->clo.lam->lam.nfree; i++)
+                v->clo.free[i] = promote(v->clo.free[i]);
+        }
+    } else if (o->kind == G_ENV) {
+        Env *e = (Env *) o;
+        e->arg = promote(e->arg);
+        e->closure = promote(e->closure);
+    }
+}
+
 void mark_value(Value *v);
 void mark_env(Env *e);
-void mark_kont(Kont *k);
 
 void mark_value(Value *v) {
     if (!v || v->gc.marked) return;
     v->gc.marked = 1;
     if (v->tag == V_CLOSURE)
-        mark_env(v->clo.env);
+        for (int i = 0; i < v->clo.lam->lam.nfree; i++)
+            mark_value(v->clo.free[i]);
 }
 
 void mark_env(Env *e) {
-    while (e && !e->gc.marked) {
-        e->gc.marked = 1;
-        mark_value(e->value);
-        e = e->next;
-    }
+    if (!e || e->gc.marked) return;
+    e->gc.marked = 1;
+    mark_value(e->arg);
+    mark_value(e->closure);
 }
 
-void mark_kont(Kont *k) {
-    while (k && !k->gc.marked) {
-        k->gc.marked = 1;
-        if (k->tag == K_ARG) mark_env(k->arg.env);
-        if (k->tag == K_FUN) mark_value(k->fun.fun);
-        k = (k->tag == K_ARG) ? k->arg.next : k->fun.next;
-    }
+void *mark(void *p) {
+    GCObject *o = p;
+    if (o && o->kind == G_VALUE) mark_value(p);
+    if (o && o->kind == G_ENV) mark_env(p);
+    return p;
 }
 
-void gc_collect(State *s) {
-    mark_value(s->value);
-    mark_env(s->env);
-    mark_kont(s->kont);
+// old space only, called with the nursery empty
+void gc_collect(Roots roots, void *machine) {
+    major_collections++;
+    roots(machine, mark);
 
     GCObject **p = &gc_objects;
     while (*p) {
         if (!(*p)->marked) {
             GCObject *dead = *p;
             *p = dead->next;
+            old_bytes -= dead->size;
             free(dead);
         } else {
             (*p)->marked = 0;
@@ -150,6 +525,33 @@ void gc_collect(State *s) {
     }
 }
 
+void gc_minor(Roots roots, void *machine) {
+    roots(machine, promote);
+    while (promoted) {
+        GCObject *o = promoted;
+        promoted = o->next;
+        o->next = gc_objects;
+        gc_objects = o;
+        scan(o);
+    }
+    nursery_used = 0;
+    minor_collections++;
+    if (old_bytes > old_limit) {
+        gc_collect(roots, machine);
+        old_limit = (2 * old_bytes > 1 << 20) ? 2 * old_bytes : 1 << 20;
+    }
+}
+
+void state_roots(void *machine, void *(*visit)(void *)) {
+    State *s = machine;
+    s->value = visit(s->value);
+    s->env = visit(s->env);
+    for (Kont *k = s->stack; k <= s->kont; k++) {
+        if (k->tag == K_ARG) k->arg.env = visit(k->arg.env);
+        if (k->tag == K_FUN) k->fun.fun = visit(k->fun.fun);
+    }
+}
+
 
 // cek step
 void step(State *s) {
@@ -157,13 +559,13 @@ void step(State *s) {
         Term *t = s->control;
 
         if (t->tag == T_VAR) {
-            s->value = env_lookup(s->env, t->var);
+            s->value = env_lookup(s->env, t->var.index);
             s->control = NULL;
             return;
         }
 
         if (t->tag == T_INT) {
-            Value *v = gc_alloc(sizeof(Value));
+            Value *v = gc_alloc(sizeof(Value), G_VALUE);
             v->tag = V_INT;
             v->intval = t->intval;
             s->value = v;
@@ -172,23 +574,23 @@ void step(State *s) {
         }
 
         if (t->tag == T_LAM) {
-            Value *v = gc_alloc(sizeof(Value));
+            int n = t->lam.nfree;
+            Value *v = gc_alloc(sizeof(Value) + sizeof(Value *) * n, G_VALUE);
             v->tag = V_CLOSURE;
-            v->clo.param = t->lam.param;
-            v->clo.body = t->lam.body;
-            v->clo.env = s->env;
+            v->clo.lam = t;
+            v->clo.free = (Value **) (v + 1);
+            for (int i = 0; i < n; i++)
+                v->clo.free[i] = env_lookup(s->env, t->lam.captures[i]);
             s->value = v;
             s->control = NULL;
             return;
         }
 
         if (t->tag == T_APP) {
-            Kont *k = gc_alloc(sizeof(Kont));
-            k->tag = K_ARG;
-            k->arg.arg = t->app.arg;
-            k->arg.env = s->env;
-            k->arg.next = s->kont;
-            s->kont = k;
+            push_kont(s);
+            s->kont->tag = K_ARG;
+            s->kont->arg.arg = t->app.arg;
+            s->kont->arg.env = s->env;
             s->control = t->app.fun;
             return;
         }
@@ -199,13 +601,10 @@ void step(State *s) {
 
     if (s->kont->tag == K_ARG) {
         Kont *k = s->kont;
-        Kont *next = gc_alloc(sizeof(Kont));
-        next->tag = K_FUN;
-        next->fun.fun = s->value;
-        next->fun.next = k->arg.next;
-        s->kont = next;
         s->env = k->arg.env;
         s->control = k->arg.arg;
+        k->tag = K_FUN;
+        k->fun.fun = s->value;
         return;
     }
 
@@ -218,12 +617,36 @@ void step(State *s) {
             exit(1);
         }
 
-        Env *new_env = env_extend(fun->clo.env,
-                                  fun->clo.param,
-                                  s->value);
-        s->kont = k->fun.next;
+        // the result of a call right under a K_MEMO frame is kept with
+        // that one, so tail calls stay in constant space
+        Plain arg, result;
+        if (memo_capacity && fun->clo.lam->lam.nfree == 0 && plain(s->value, &arg)) {
+            Term *lam = fun->clo.lam->lam.canon;
+            if (memo_lookup(lam, arg, &result)) {
+                s->kont--;
+                s->value = unplain(result);
+                return;
+            }
+            if (k[-1].tag != K_MEMO) {
+                s->env = env_extend(fun, s->value);
+                s->control = fun->clo.lam->lam.body;
+                k->tag = K_MEMO;
+                k->memo.lam = lam;
+                k->memo.arg = arg;
+                return;
+            }
+        }
+
+        Env *new_env = env_extend(fun, s->value);
+        s->kont--;
         s->env = new_env;
-        s->control = fun->clo.body;
+        s->control = fun->clo.lam->lam.body;
+        return;
+    }
+
+    if (s->kont->tag == K_MEMO) {
+        memo_record(s->kont->memo.lam, s->kont->memo.arg, s->value);
+        s->kont--;
         return;
     }
 }
@@ -231,30 +654,226 @@ void step(State *s) {
 
 
 Value *run(Term *t) {
+    resolve(t, NULL);
+    hashcons(t);
     State s;
     s.control = t;
     s.env = NULL;
-    s.kont = gc_alloc(sizeof(Kont));
+    s.size = 64;
+    s.stack = malloc(sizeof(Kont) * s.size);
+    if (!s.stack) { fprintf(stderr, "Out of memory\n"); exit(1); }
+    s.kont = s.stack;
     s.kont->tag = K_HALT;
     s.value = NULL;
 
+    // each step allocates at most one object, so collecting between
+    // steps leaves no pointers to the nursery outside the state
     while (!(s.control == NULL && s.kont->tag == K_HALT)) {
+        if (nursery_used + MAX_OBJECT > NURSERY_SIZE)
+            gc_minor(state_roots, &s);
         step(&s);
-        gc_collect(&s);
     }
+    free(s.stack);
     return s.value;
 }
 
 
 
+// Compiled path: the resolved term compiled to a stack bytecode, run by
+// one loop over the same closures, environments and collector. A lambda
+// body is compiled after the code that makes its closure, and an
+// application in tail position reuses the caller's return frame. step()
+// stays the reference: expect_int() checks both give the same result.
+enum { OP_VAR, OP_INT, OP_CLOSURE, OP_APP, OP_TAILAPP, OP_RET, OP_HALT };
+
+int *code = NULL;
+int code_len = 0, code_size = 0;
+Term **lams = NULL;             // by OP_CLOSURE operand
+int lams_len = 0, lams_size = 0;
+
+void *grow(void *p, int *size, size_t elem) {
+    *size = *size ? 2 * *size : 64;
+    p = realloc(p, elem * *size);
+    if (!p) { fprintf(stderr, "Out of memory\n"); exit(1); }
+    return p;
+}
+
+void emit(int x) {
+    if (code_len == code_size)
+        code = grow(code, &code_size, sizeof(int));
+    code[code_len++] = x;
+}
+
+void compile_term(Term *t, int tail) {
+    switch (t->tag) {
+    case T_VAR:
+        emit(OP_VAR); emit(t->var.index);
+        break;
+    case T_INT:
+        emit(OP_INT); emit(t->intval);
+        break;
+    case T_LAM:
+        if (lams_len == lams_size)
+            lams = grow(lams, &lams_size, sizeof(Term *));
+        lams[lams_len] = t;
+        emit(OP_CLOSURE); emit(lams_len++);
+        break;
+    case T_APP:
+        compile_term(t->app.fun, 0);
+        compile_term(t->app.arg, 0);
+        emit(tail ? OP_TAILAPP : OP_APP);
+        break;
+    }
+}
+
+void compile(Term *t) {
+    code_len = lams_len = 0;
+    compile_term(t, 0);
+    emit(OP_HALT);
+    for (int i = 0; i < lams_len; i++) {    // bodies add more lambdas
+        lams[i]->lam.code = code_len;
+        compile_term(lams[i]->lam.body, 1);
+        emit(OP_RET);
+    }
+    // a closure from the memo table has the canon, which compiles the same
+    for (int i = 0; i < lams_len; i++)
+        lams[i]->lam.canon->lam.code = lams[i]->lam.code;
+}
+
+// memo, if not NULL, keeps the result of the call with arg when it returns
+typedef struct { int pc; Env *env; Term *memo; Plain arg; } Frame;
+
+typedef struct {
+    Env *env;
+    Value **stack;
+    int sp, size;
+    Frame *frames;
+    int fp, fsize;
+} Machine;
+
+void machine_roots(void *machine, void *(*visit)(void *)) {
+    Machine *m = machine;
+    m->env = visit(m->env);
+    for (int i = 0; i < m->sp; i++)
+        m->stack[i] = visit(m->stack[i]);
+    for (int i = 0; i < m->fp; i++)
+        m->frames[i].env = visit(m->frames[i].env);
+}
+
+Value *run_compiled(Term *t) {
+    resolve(t, NULL);
+    hashcons(t);
+    compile(t);
+    Machine m = { NULL, NULL, 0, 0, NULL, 0, 0 };
+    int pc = 0;
+
+    // as in run(): collect before an instruction that allocates, when
+    // every live pointer is in m
+    #define ROOM() do { \
+        if (nursery_used + MAX_OBJECT > NURSERY_SIZE) \
+            gc_minor(machine_roots, &m); \
+    } while (0)
+    #define PUSH(v) do { \
+        if (m.sp == m.size) \
+            m.stack = grow(m.stack, &m.size, sizeof(Value *)); \
+        m.stack[m.sp++] = (v); \
+    } while (0)
+
+    for (;;) {
+        switch (code[pc++]) {
+        case OP_VAR:
+            PUSH(env_lookup(m.env, code[pc++]));
+            break;
+
+        case OP_INT: {
+            ROOM();
+            Value *v = gc_alloc(sizeof(Value), G_VALUE);
+            v->tag = V_INT;
+            v->intval = code[pc++];
+            PUSH(v);
+            break;
+        }
+
+        case OP_CLOSURE: {
+            ROOM();
+            Term *lam = lams[code[pc++]];
+            int n = lam->lam.nfree;
+            Value *v = gc_alloc(sizeof(Value) + sizeof(Value *) * n, G_VALUE);
+            v->tag = V_CLOSURE;
+            v->clo.lam = lam;
+            v->clo.free = (Value **) (v + 1);
+            for (int i = 0; i < n; i++)
+                v->clo.free[i] = env_lookup(m.env, lam->lam.captures[i]);
+            PUSH(v);
+            break;
+        }
+
+        case OP_APP:
+        case OP_TAILAPP: {
+            ROOM();
+            Value *arg = m.stack[--m.sp];
+            Value *fun = m.stack[--m.sp];
+            if (fun->tag != V_CLOSURE) {
+                fprintf(stderr, "Attempt to apply non-function\n");
+                exit(1);
+            }
+            // as in step(), a tail call's result is kept with its caller's
+            Term *memo_lam = NULL;
+            Plain parg, result;
+            if (memo_capacity && fun->clo.lam->lam.nfree == 0 && plain(arg, &parg)) {
+                if (memo_lookup(fun->clo.lam->lam.canon, parg, &result)) {
+                    PUSH(unplain(result));
+                    if (code[pc - 1] == OP_TAILAPP) goto ret;
+                    break;
+                }
+                memo_lam = fun->clo.lam->lam.canon;
+            }
+            if (code[pc - 1] == OP_APP) {
+                if (m.fp == m.fsize)
+                    m.frames = grow(m.frames, &m.fsize, sizeof(Frame));
+                m.frames[m.fp].pc = pc;
+                m.frames[m.fp].memo = memo_lam;
+                m.frames[m.fp].arg = parg;
+                m.frames[m.fp++].env = m.env;
+            }
+            m.env = env_extend(fun, arg);
+            pc = fun->clo.lam->lam.code;
+            break;
+        }
+
+        case OP_RET:
+        ret:
+            m.fp--;
+            if (m.frames[m.fp].memo)
+                memo_record(m.frames[m.fp].memo, m.frames[m.fp].arg, m.stack[m.sp - 1]);
+            pc = m.frames[m.fp].pc;
+            m.env = m.frames[m.fp].env;
+            break;
+
+        case OP_HALT: {
+            Value *v = m.stack[m.sp - 1];
+            free(m.stack);
+            free(m.frames);
+            return v;
+        }
+        }
+    }
+
+    #undef ROOM
+    #undef PUSH
+}
+
+
+
 Term *Var(char *x) {
     Term *t = malloc(sizeof(Term));
-    t->tag = T_VAR; t->var = x; return t;
+    t->tag = T_VAR; t->var.name = intern(x); t->var.index = -1; return t;
 }
 
 Term *Lam(char *x, Term *b) {
     Term *t = malloc(sizeof(Term));
-    t->tag = T_LAM; t->lam.param = x; t->lam.body = b; return t;
+    t->tag = T_LAM; t->lam.param = intern(x); t->lam.body = b;
+    t->lam.nfree = 0; t->lam.captures = NULL; t->lam.code = -1; t->lam.canon = NULL; return t;
 }
 
 Term *App(Term *f, Term *a) {
@@ -272,11 +891,13 @@ Term *Int(int n) {
 // helper
 void expect_int(char *name, Term *t, int expected) {
     Value *v = run(t);
-    if (v->tag != V_INT || v->intval != expected) {
+    int got = v->tag == V_INT ? v->intval : -1;
+    v = run_compiled(t);
+    int compiled = v->tag == V_INT ? v->intval : -1;
+    if (got != expected || compiled != expected) {
         fprintf(stderr,
-                "Test %s failed: expected %d, got %d\n",
-                name, expected,
-                v->tag == V_INT ? v->intval : -1);
+                "Test %s failed: expected %d, got %d, compiled %d\n",
+                name, expected, got, compiled);
         exit(1);
     }
     printf("Test %s passed\n", name);
@@ -337,6 +958,41 @@ Term *test_shadow(void) {
     );
 } // (λx. (λx. x) 3) 1
 
+Term *test_deep(void) {
+    return App(App(App(
+        Lam("x", Lam("y", Lam("z",
+            App(
+                Lam("f", App(Var("f"), Var("z"))),
+                Lam("w", Var("x"))
+            )
+        ))),
+        Int(1)), Int(2)), Int(3)
+    );
+} // (λx. λy. λz. (λf. f z) (λw. x)) 1 2 3
+// x is captured through two closures that do not use it themselves
+
+Term *church_two(void) {
+    return Lam("f", Lam("x", App(Var("f"), App(Var("f"), Var("x")))));
+} // λf. λx. f (f x)
+
+Term *test_church(void) {
+    Term *n = church_two();
+    for (int i = 0; i < 4; i++)
+        n = App(church_two(), n);
+    return App(App(n, Lam("y", Var("y"))), Int(9));
+} // 2 (2 (2 (2 2))) (λy. y) 9, the identity applied 65536 times
+// mostly short-lived frames, for the collector
+
+Term *test_memo(void) {
+    Term *n = church_two();
+    for (int i = 0; i < 4; i++)
+        n = App(church_two(), n);
+    Term *big = Lam("x", App(App(n, Lam("y", Var("y"))), Var("x")));
+    Term *k = Lam("a", Lam("b", Var("a")));
+    return App(App(k, App(big, Int(9))), App(App(k, App(big, Int(9))), App(big, Int(9))));
+} // K (big 9) (K (big 9) (big 9)), big = λx. 2 (2 (2 (2 2))) (λy. y) x
+// the same closed lambda applied to 9 three times, for the memo table
+
 Term *test_tail(void) {
     Term *loop =
         Lam("f",
@@ -352,14 +1008,62 @@ Term *test_tail(void) {
 
 
 
-int main(void) {
+void run_tests(void) {
     expect_int("id", test_id(), 7); // (λx. x) 7
     expect_int("const", test_const(), 10); // (λx. λy. x) 10 99
     expect_int("nested", test_nested(), 5); // (λx. (λy. y) x) 5
     expect_int("closure", test_closure(), 42); // (λx. (λf. f 0) (λy. x)) 42
     expect_int("shadow", test_shadow(), 3); // (λx. (λx. x) 3) 1
+    expect_int("deep", test_deep(), 1); // (λx. λy. λz. (λf. f z) (λw. x)) 1 2 3
+    expect_int("church", test_church(), 9); // 2 (2 (2 (2 2))) (λy. y) 9
+    expect_int("memo", test_memo(), 9); // K (big 9) (K (big 9) (big 9))
+}
 
+double time_runs(Value *(*how)(Term *), Term *t, int times) {
+    clock_t start = clock();
+    for (int i = 0; i < times; i++)
+        how(t);
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(void) {
+    run_tests();
     printf("All terminating tests passed.\n");
+    printf("%d minor and %d major collections\n", minor_collections, major_collections);
+
+    // again with the memo table, and with one small enough to evict
+    memo_init(1024);
+    run_tests();
+    memo_report("memo 1024");
+    memo_init(2);
+    run_tests();
+    memo_report("memo 2");
+    memo_init(0);
+
+    Term *church = test_church();
+    double stepped = time_runs(run, church, 20);
+    double compiled = time_runs(run_compiled, church, 20);
+    printf("church x 20: %.3f s by step(), %.3f s compiled\n", stepped, compiled);
+
+    // each run starts with an empty table, so only repeats within it hit
+    Term *memo_term = test_memo();
+    int capacities[] = { 0, 1024 };
+    for (int c = 0; c < 2; c++) {
+        int capacity = capacities[c];
+        double times[2];
+        for (int compiled = 0; compiled <= 1; compiled++) {
+            clock_t start = clock();
+            for (int i = 0; i < 20; i++) {
+                memo_init(capacity);
+                (compiled ? run_compiled : run)(memo_term);
+            }
+            times[compiled] = (double) (clock() - start) / CLOCKS_PER_SEC;
+        }
+        printf("memo x 20, %s: %.3f s by step(), %.3f s compiled\n",
+               capacity ? "memo table on" : "memo table off", times[0], times[1]);
+        if (capacity) memo_report("last run compiled");
+    }
+    memo_init(0);
 
     // Uncomment to stress-test tail calls
     // Warning: this have to be terminated by you
@@ -43,26 +43,68 @@ typedef struct Functor {
 struct AST;
 typedef struct AST AST;
 
+// Hash-consing: every Object is made by intern(), which returns the one
+// already made from the same parts if there is one. The parts are
+// interned too, so structurally equal types are the same pointer, and
+// hashing the pointers hashes the structure.
+Object** intern_table = NULL;
+size_t intern_size = 0, intern_count = 0;  // size is a power of two
+
+size_t intern_hash(ObjectType type, Object* left, Object* right,
+                   Functor* functor, Object* arg) {
+    uint64_t h = (uint64_t) type * 0x9E3779B97F4A7C15ULL;
+    h = (h ^ (uintptr_t) left) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (uintptr_t) right) * 0x94D049BB133111EBULL;
+    h = (h ^ (uintptr_t) functor) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (uintptr_t) arg) * 0x94D049BB133111EBULL;
+    return (size_t) (h ^ (h >> 31));
+}
+
+void intern_insert(Object* o) {
+    size_t i = intern_hash(o->type, o->left, o->right, o->functor, o->arg);
+    for (i &= intern_size - 1; intern_table[i]; i = (i + 1) & (intern_size - 1))
+        ;
+    intern_table[i] = o;
+}
+
+Object* intern(ObjectType type, Object* left, Object* right,
+               Functor* functor, Object* arg) {
+    if (intern_count * 2 >= intern_size) {
+        Object** old = intern_table;
+        size_t old_size = intern_size;
+        intern_size = old_size ? 2 * old_size : 64;
+        intern_table = calloc(intern_size, sizeof(Object*));
+        assert(intern_table);
+        for (size_t i = 0; i < old_size; i++)
+            if (old[i]) intern_insert(old[i]);
+        free(old);
+    }
+    size_t i = intern_hash(type, left, right, functor, arg) & (intern_size - 1);
+    for (; intern_table[i]; i = (i + 1) & (intern_size - 1)) {
+        Object* o = intern_table[i];
+        if (o->type == type && o->left == left && o->right == right
+            && o->functor == functor && o->arg == arg)
+            return o;
+    }
+    Object* o = malloc(sizeof(Object));
+    o->type = type;
+    o->left = left;
+    o->right = right;
+    o->functor = functor;
+    o->arg = arg;
+    intern_table[i] = o;
+    intern_count++;
+    return o;
+}
+
 // List functor: List(A)
 Object* list_map_object(Functor* f, Object* o) {
-    Object* result = malloc(sizeof(Object));
-    result->type = OBJ_FUNCTOR_APP;
-    result->functor = f;
-    result->arg = o;
-    result->left = NULL;
-    result->right = NULL;
-    return result;
+    return intern(OBJ_FUNCTOR_APP, NULL, NULL, f, o);
 }
 
 // Maybe functor: Maybe(A)
 Object* maybe_map_object(Functor* f, Object* o) {
-    Object* result = malloc(sizeof(Object));
-    result->type = OBJ_FUNCTOR_APP;
-    result->functor = f;
-    result->arg = o;
-    result->left = NULL;
-    result->right = NULL;
-    return result;
+    return intern(OBJ_FUNCTOR_APP, NULL, NULL, f, o);
 }
 
 // Identity functor: Id(A) = A
@@ -70,47 +112,26 @@ Object* identity_map_object(Functor* f, Object* o) {
     return o;
 }
 
-// Helper
+// Helper: interned, so equal types are the same Object
 int obj_equal(Object* a, Object* b) {
-    if (!a || !b) return a == b;
-    if (a->type != b->type) return 0;
-    
-    switch (a->type) {
-        case OBJ_INT:
-        case OBJ_BOOL:
-        case OBJ_UNIT:
-            return 1;
-        case OBJ_ARROW:
-            return obj_equal(a->left, b->left) && obj_equal(a->right, b->right);
-        case OBJ_FUNCTOR_APP:
-            return a->functor == b->functor && obj_equal(a->arg, b->arg);
-        default:
-            return 0;
-    }
+    return a == b;
 }
 
+// One of each functor, so that F(A) is interned by the functor's pointer
+Functor list_functor = { FUNCTOR_LIST, "List", list_map_object };
+Functor maybe_functor = { FUNCTOR_MAYBE, "Maybe", maybe_map_object };
+Functor identity_functor = { FUNCTOR_IDENTITY, "Id", identity_map_object };
+
 Functor* functor_list() {
-    Functor* f = malloc(sizeof(Functor));
-    f->type = FUNCTOR_LIST;
-    strcpy(f->name, "List");
-    f->map_object = list_map_object;
-    return f;
+    return &list_functor;
 }
 
 Functor* functor_maybe() {
-    Functor* f = malloc(sizeof(Functor));
-    f->type = FUNCTOR_MAYBE;
-    strcpy(f->name, "Maybe");
-    f->map_object = maybe_map_object;
-    return f;
+    return &maybe_functor;
 }
 
 Functor* functor_identity() {
-    Functor* f = malloc(sizeof(Functor));
-    f->type = FUNCTOR_IDENTITY;
-    strcpy(f->name, "Id");
-    f->map_object = identity_map_object;
-    return f;
+    return &identity_functor;
 }
 
 
@@ -151,33 +172,15 @@ typedef struct AST {
 // OBJECT CONSTRUCTORS
 
 Object* obj_int() {
-    Object* o = malloc(sizeof(Object));
-    o->type = OBJ_INT;
-    o->left = NULL;
-    o->right = NULL;
-    o->functor = NULL;
-    o->arg = NULL;
-    return o;
+    return intern(OBJ_INT, NULL, NULL, NULL, NULL);
 }
 
 Object* obj_bool() {
-    Object* o = malloc(sizeof(Object));
-    o->type = OBJ_BOOL;
-    o->left = NULL;
-    o->right = NULL;
-    o->functor = NULL;
-    o->arg = NULL;
-    return o;
+    return intern(OBJ_BOOL, NULL, NULL, NULL, NULL);
 }
 
 Object* obj_arrow(Object* dom, Object* cod) {
-    Object* o = malloc(sizeof(Object));
-    o->type = OBJ_ARROW;
-    o->left = dom;
-    o->right = cod;
-    o->functor = NULL;
-    o->arg = NULL;
-    return o;
+    return intern(OBJ_ARROW, dom, cod, NULL, NULL);
 }
 
 Object* obj_functor_app(Functor* f, Object* arg) {
@@ -277,6 +280,218 @@ AST* ast_fmap(Functor* functor, AST* func, AST* container) {
 }
 
 
+// OPTIMISER - Functor laws, constant folding and beta reduction on the AST
+//
+//   fmap f (fmap g c)  =>  fmap (f ∘ g) c    one traversal instead of two
+//   fmap id c          =>  c
+//   (λx.b) ∘ (λy.c)    =>  λy. b[x := c]
+//   (λx.b) a           =>  b[x := a]
+//   n op m             =>  the constant
+//
+// Nodes are rebuilt rather than changed, so the input AST stays valid.
+
+// uses of name free in ast
+int count_uses(AST* ast, const char* name) {
+    int n = 0;
+    switch (ast->type) {
+        case AST_VAR:
+            return strcmp(ast->data.var.name, name) == 0;
+        case AST_LAMBDA:
+            if (strcmp(ast->data.lambda.param, name) == 0) return 0;
+            return count_uses(ast->data.lambda.body, name);
+        case AST_APP:
+            return count_uses(ast->data.app.func, name) + count_uses(ast->data.app.arg, name);
+        case AST_COMPOSE:
+            return count_uses(ast->data.compose.f, name) + count_uses(ast->data.compose.g, name);
+        case AST_BINOP:
+            return count_uses(ast->data.binop.left, name) + count_uses(ast->data.binop.right, name);
+        case AST_LIST:
+            for (int i = 0; i < ast->data.list.count; i++)
+                n += count_uses(ast->data.list.elements[i], name);
+            return n;
+        case AST_MAYBE_JUST:
+            return count_uses(ast->data.maybe_just.value, name);
+        case AST_FMAP:
+            return count_uses(ast->data.fmap.func, name) + count_uses(ast->data.fmap.container, name);
+        default:
+            return 0;
+    }
+}
+
+// does a lambda in ast bind a variable free in arg? (then substituting
+// arg into ast could capture it)
+int captures(AST* ast, AST* arg) {
+    switch (ast->type) {
+        case AST_LAMBDA:
+            return count_uses(arg, ast->data.lambda.param) > 0
+                || captures(ast->data.lambda.body, arg);
+        case AST_APP:
+            return captures(ast->data.app.func, arg) || captures(ast->data.app.arg, arg);
+        case AST_COMPOSE:
+            return captures(ast->data.compose.f, arg) || captures(ast->data.compose.g, arg);
+        case AST_BINOP:
+            return captures(ast->data.binop.left, arg) || captures(ast->data.binop.right, arg);
+        case AST_LIST:
+            for (int i = 0; i < ast->data.list.count; i++)
+                if (captures(ast->data.list.elements[i], arg)) return 1;
+            return 0;
+        case AST_MAYBE_JUST:
+            return captures(ast->data.maybe_just.value, arg);
+        case AST_FMAP:
+            return captures(ast->data.fmap.func, arg) || captures(ast->data.fmap.container, arg);
+        default:
+            return 0;
+    }
+}
+
+// ast[name := arg]
+AST* subst(AST* ast, const char* name, AST* arg) {
+    if (count_uses(ast, name) == 0) return ast;
+    switch (ast->type) {
+        case AST_VAR:
+            return arg;
+        case AST_LAMBDA:
+            return ast_lambda(ast->data.lambda.param, ast->data.lambda.param_type,
+                              subst(ast->data.lambda.body, name, arg));
+        case AST_APP:
+            return ast_app(subst(ast->data.app.func, name, arg),
+                           subst(ast->data.app.arg, name, arg));
+        case AST_COMPOSE:
+            return ast_compose(subst(ast->data.compose.f, name, arg),
+                               subst(ast->data.compose.g, name, arg));
+        case AST_BINOP:
+            return ast_binop(ast->data.binop.op, subst(ast->data.binop.left, name, arg),
+                             subst(ast->data.binop.right, name, arg));
+        case AST_LIST: {
+            AST** elements = malloc(sizeof(AST*) * ast->data.list.count);
+            for (int i = 0; i < ast->data.list.count; i++)
+                elements[i] = subst(ast->data.list.elements[i], name, arg);
+            return ast_list(elements, ast->data.list.count);
+        }
+        case AST_MAYBE_JUST:
+            return ast_maybe_just(subst(ast->data.maybe_just.value, name, arg));
+        case AST_FMAP:
+            return ast_fmap(ast->data.fmap.functor, subst(ast->data.fmap.func, name, arg),
+                            subst(ast->data.fmap.container, name, arg));
+        default:
+            return ast;
+    }
+}
+
+int is_atom(AST* ast) {
+    return ast->type == AST_INT || ast->type == AST_BOOL || ast->type == AST_VAR;
+}
+
+// λx.x
+int is_identity(AST* ast) {
+    return ast->type == AST_LAMBDA && ast->data.lambda.body->type == AST_VAR
+        && strcmp(ast->data.lambda.body->data.var.name, ast->data.lambda.param) == 0;
+}
+
+AST* optimize(AST* ast);
+
+// (λx.body) arg, if that does not copy work or capture a variable
+AST* beta(AST* lam, AST* arg) {
+    AST* body = lam->data.lambda.body;
+    const char* x = lam->data.lambda.param;
+    if ((is_atom(arg) || count_uses(body, x) <= 1) && !captures(body, arg))
+        return optimize(subst(body, x, arg));
+    return NULL;
+}
+
+AST* optimize(AST* ast) {
+    switch (ast->type) {
+
+        case AST_LAMBDA: {
+            AST* body = optimize(ast->data.lambda.body);
+            if (body == ast->data.lambda.body) return ast;
+            return ast_lambda(ast->data.lambda.param, ast->data.lambda.param_type, body);
+        }
+
+        case AST_APP: {
+            AST* func = optimize(ast->data.app.func);
+            AST* arg = optimize(ast->data.app.arg);
+            AST* reduced;
+            if (is_identity(func)) return arg;
+            if (func->type == AST_LAMBDA && (reduced = beta(func, arg)) != NULL)
+                return reduced;
+            if (func == ast->data.app.func && arg == ast->data.app.arg) return ast;
+            return ast_app(func, arg);
+        }
+
+        case AST_COMPOSE: {
+            AST* f = optimize(ast->data.compose.f);
+            AST* g = optimize(ast->data.compose.g);
+            if (is_identity(f)) return g;
+            if (is_identity(g)) return f;
+            if (f->type == AST_LAMBDA && g->type == AST_LAMBDA) {
+                // λy. f (g y), with g's body standing in for (g y)
+                AST* body = beta(f, g->data.lambda.body);
+                if (body != NULL)
+                    return ast_lambda(g->data.lambda.param, g->data.lambda.param_type, body);
+            }
+            if (f == ast->data.compose.f && g == ast->data.compose.g) return ast;
+            return ast_compose(f, g);
+        }
+
+        case AST_BINOP: {
+            AST* left = optimize(ast->data.binop.left);
+            AST* right = optimize(ast->data.binop.right);
+            if (left->type == AST_INT && right->type == AST_INT) {
+                int a = left->data.int_val, b = right->data.int_val;
+                switch (ast->data.binop.op) {
+                    case '+': return ast_int(a + b);
+                    case '-': return ast_int(a - b);
+                    case '*': return ast_int(a * b);
+                    case '=': return ast_int(a == b);
+                    case '<': return ast_int(a < b);
+                }
+            }
+            if (left == ast->data.binop.left && right == ast->data.binop.right) return ast;
+            return ast_binop(ast->data.binop.op, left, right);
+        }
+
+        case AST_LIST: {
+            int count = ast->data.list.count, changed = 0;
+            AST** elements = malloc(sizeof(AST*) * (count > 0 ? count : 1));
+            for (int i = 0; i < count; i++) {
+                elements[i] = optimize(ast->data.list.elements[i]);
+                changed |= elements[i] != ast->data.list.elements[i];
+            }
+            if (!changed) {
+                free(elements);
+                return ast;
+            }
+            return ast_list(elements, count);
+        }
+
+        case AST_MAYBE_JUST: {
+            AST* value = optimize(ast->data.maybe_just.value);
+            if (value == ast->data.maybe_just.value) return ast;
+            return ast_maybe_just(value);
+        }
+
+        case AST_FMAP: {
+            Functor* functor = ast->data.fmap.functor;
+            AST* func = optimize(ast->data.fmap.func);
+            AST* container = optimize(ast->data.fmap.container);
+            if (is_identity(func)) return container;
+            if (container->type == AST_FMAP
+                && container->data.fmap.functor->type == functor->type) {
+                AST* g = container->data.fmap.func;
+                return optimize(ast_fmap(functor, ast_compose(func, g),
+                                         container->data.fmap.container));
+            }
+            if (func == ast->data.fmap.func && container == ast->data.fmap.container) return ast;
+            return ast_fmap(functor, func, container);
+        }
+
+        default:
+            return ast;
+    }
+}
+
+
 // COMPILER & VM (minimal but functional)
 
 typedef enum {
@@ -286,6 +501,8 @@ typedef enum {
     OP_MAKE_LIST,
     OP_MAKE_JUST,
     OP_MAKE_NOTHING,
+    OP_LOAD_ADD,    // LOAD n; ADD
+    OP_ADD_INT,     // PUSH_INT n; ADD
     OP_HALT
 } OpCode;
 
@@ -294,9 +511,12 @@ typedef struct {
     int arg;
 } Instruction;
 
+#define CODE_SIZE 1024
+
 typedef struct {
-    Instruction code[1024];
+    Instruction code[CODE_SIZE];
     int ip;
+    int len;            // instructions emitted
     int stack[256];
     int sp;
     int locals[64];
@@ -308,10 +528,23 @@ typedef struct {
     int var_addrs[64];
 } CompileEnv;
 
+// An ADD right after a LOAD or PUSH_INT is fused into it. There are no
+// jumps, so nothing can land between the two.
 void emit(VM* vm, OpCode op, int arg) {
+    Instruction* prev = vm->ip > 0 ? &vm->code[vm->ip - 1] : NULL;
+    if (op == OP_ADD && prev && prev->op == OP_LOAD) {
+        prev->op = OP_LOAD_ADD;
+        return;
+    }
+    if (op == OP_ADD && prev && prev->op == OP_PUSH_INT) {
+        prev->op = OP_ADD_INT;
+        return;
+    }
+    assert(vm->ip < CODE_SIZE - 1);     // room for the HALT vm_execute adds
     vm->code[vm->ip].op = op;
     vm->code[vm->ip].arg = arg;
     vm->ip++;
+    vm->len = vm->ip;
 }
 
 int find_var(CompileEnv* env, const char* name) {
@@ -372,26 +605,64 @@ void vm_init(VM* vm) {
     vm->sp = -1;
 }
 
-void vm_push(VM* vm, int val) { vm->stack[++vm->sp] = val; }
-int vm_pop(VM* vm) { return vm->stack[vm->sp--]; }
-
+// Runs code[0 .. len), then the HALT put after it. The stack is not
+// checked: the compiler's expressions are far shallower than 256. ip and
+// sp live in locals and are written back on HALT. With GCC each handler
+// jumps straight to the next one through a table of labels; otherwise
+// the same handlers are cases of a switch.
 void vm_execute(VM* vm) {
-    vm->ip = 0;
-    while (vm->ip < 1024) {
-        Instruction inst = vm->code[vm->ip++];
-        switch (inst.op) {
-            case OP_PUSH_INT: vm_push(vm, inst.arg); break;
-            case OP_LOAD: vm_push(vm, vm->locals[inst.arg]); break;
-            case OP_ADD: { int b = vm_pop(vm), a = vm_pop(vm); vm_push(vm, a + b); break; }
-            case OP_SUB: { int b = vm_pop(vm), a = vm_pop(vm); vm_push(vm, a - b); break; }
-            case OP_MUL: { int b = vm_pop(vm), a = vm_pop(vm); vm_push(vm, a * b); break; }
-            case OP_EQ:  { int b = vm_pop(vm), a = vm_pop(vm); vm_push(vm, a == b); break; }
-            case OP_LT:  { int b = vm_pop(vm), a = vm_pop(vm); vm_push(vm, a < b); break; }
-            case OP_MAKE_NOTHING: vm_push(vm, 0); break;
-            case OP_HALT: return;
-            default: break;
-        }
+    Instruction* code = vm->code;
+    Instruction* ip = code;
+    int* stack = vm->stack;
+    int* locals = vm->locals;
+    int sp = vm->sp;
+    int a, b;
+    code[vm->len].op = OP_HALT;
+    code[vm->len].arg = 0;
+
+#ifdef __GNUC__
+    static void* labels[] = {
+        [OP_PUSH_INT] = &&L_PUSH_INT, [OP_LOAD] = &&L_LOAD,
+        [OP_ADD] = &&L_ADD, [OP_SUB] = &&L_SUB, [OP_MUL] = &&L_MUL,
+        [OP_EQ] = &&L_EQ, [OP_LT] = &&L_LT,
+        [OP_MAKE_LIST] = &&L_MAKE_LIST, [OP_MAKE_JUST] = &&L_MAKE_JUST,
+        [OP_MAKE_NOTHING] = &&L_MAKE_NOTHING,
+        [OP_LOAD_ADD] = &&L_LOAD_ADD, [OP_ADD_INT] = &&L_ADD_INT,
+        [OP_HALT] = &&L_HALT
+    };
+    #define CASE(op) L_##op
+    #define NEXT goto *labels[(ip++)->op]
+    NEXT;
+#else
+    #define CASE(op) case OP_##op
+    #define NEXT break
+    for (;;) switch ((ip++)->op) {
+#endif
+    #define ARG (ip[-1].arg)
+
+    CASE(PUSH_INT):     stack[++sp] = ARG; NEXT;
+    CASE(LOAD):         stack[++sp] = locals[ARG]; NEXT;
+    CASE(ADD):          b = stack[sp--]; a = stack[sp]; stack[sp] = a + b; NEXT;
+    CASE(SUB):          b = stack[sp--]; a = stack[sp]; stack[sp] = a - b; NEXT;
+    CASE(MUL):          b = stack[sp--]; a = stack[sp]; stack[sp] = a * b; NEXT;
+    CASE(EQ):           b = stack[sp--]; a = stack[sp]; stack[sp] = a == b; NEXT;
+    CASE(LT):           b = stack[sp--]; a = stack[sp]; stack[sp] = a < b; NEXT;
+    CASE(MAKE_NOTHING): stack[++sp] = 0; NEXT;
+    CASE(LOAD_ADD):     stack[sp] += locals[ARG]; NEXT;
+    CASE(ADD_INT):      stack[sp] += ARG; NEXT;
+    CASE(MAKE_LIST):    // lists and Just are not run yet
+    CASE(MAKE_JUST):    NEXT;
+    CASE(HALT):
+        vm->ip = (int) (ip - code);
+        vm->sp = sp;
+        return;
+
+#ifndef __GNUC__
     }
+#endif
+    #undef CASE
+    #undef NEXT
+    #undef ARG
 }
 
 
@@ -432,6 +703,13 @@ void test_functors() {
     Object* id_int = obj_functor_app(id_f, obj_int());
     //ASSERT_TRUE(id_int == obj_int(), "Id(Int) ≡ Int");
     ASSERT_TRUE(obj_equal(id_int, obj_int()), "Id(Int) ≡ Int");
+
+    TEST("Interned types");
+    Object* a = obj_arrow(obj_int(), obj_functor_app(list_f, obj_int()));
+    Object* b = obj_arrow(obj_int(), obj_functor_app(functor_list(), obj_int()));
+    ASSERT_TRUE(a == b, "Int → List(Int) built twice is one Object");
+    ASSERT_TRUE(!obj_equal(list_int, maybe_int), "List(Int) ≢ Maybe(Int)");
+    ASSERT_TRUE(!obj_equal(a, obj_arrow(obj_int(), obj_int())), "Int → List(Int) ≢ Int → Int");
 }
 
 void test_morphisms() {
@@ -454,6 +732,19 @@ void test_morphisms() {
     emit(&vm, OP_HALT, 0);
     vm_execute(&vm);
     ASSERT_EQ(vm.stack[vm.sp], 11, "10 + 1 = 11");
+
+    TEST("Fused instructions");
+    vm_init(&vm);
+    strcpy(env.vars[1], "y");
+    env.var_addrs[1] = 1;
+    env.var_count = 2;
+    vm.locals[0] = 10;
+    vm.locals[1] = 32;
+    AST* sum = ast_binop('+', ast_binop('+', ast_var("x"), ast_var("y")), ast_int(1));
+    compile_ast(sum, &vm, &env);
+    ASSERT_EQ(vm.len, 3, "x + y + 1 is LOAD, LOAD_ADD, ADD_INT");
+    vm_execute(&vm);
+    ASSERT_EQ(vm.stack[vm.sp], 43, "10 + 32 + 1 = 43");
 }
 
 void test_composition() {
@@ -481,6 +772,53 @@ void test_containers() {
     printf(" Nothing   : "); print_object(nothing->obj_type); printf("\n");
 }
 
+void test_optimize() {
+    TEST("Constant folding");
+    AST* sum = ast_binop('*', ast_binop('+', ast_int(2), ast_int(3)), ast_int(4));
+    AST* folded = optimize(sum);
+    ASSERT_TRUE(folded->type == AST_INT, "(2 + 3) * 4 folds to a constant");
+    VM vm;
+    vm_init(&vm);
+    CompileEnv env = {0};
+    compile_ast(folded, &vm, &env);
+    emit(&vm, OP_HALT, 0);
+    ASSERT_EQ(vm.ip, 2, "compiles to one push and halt");
+    vm_execute(&vm);
+    ASSERT_EQ(vm.stack[vm.sp], 20, "(2 + 3) * 4 = 20");
+
+    TEST("Beta reduction");
+    AST* inc = ast_lambda("x", obj_int(), ast_binop('+', ast_var("x"), ast_int(1)));
+    AST* app = optimize(ast_app(inc, ast_int(41)));
+    ASSERT_TRUE(app->type == AST_INT && app->data.int_val == 42, "(λx.x+1) 41 => 42");
+
+    TEST("Fmap fusion");
+    AST* dbl = ast_lambda("y", obj_int(), ast_binop('*', ast_var("y"), ast_int(2)));
+    AST* elems[3] = { ast_int(5), ast_int(6), ast_int(7) };
+    AST* list = ast_list(elems, 3);
+    AST* twice = ast_fmap(functor_list(), inc, ast_fmap(functor_list(), dbl, list));
+    AST* fused = optimize(twice);
+    ASSERT_TRUE(fused->type == AST_FMAP && fused->data.fmap.container == list,
+                "fmap inc (fmap dbl xs) => fmap (inc ∘ dbl) xs");
+    AST* f = fused->data.fmap.func;
+    ASSERT_TRUE(f->type == AST_LAMBDA && f->data.lambda.body->type == AST_BINOP
+                && f->data.lambda.body->data.binop.left->type == AST_BINOP,
+                "inc ∘ dbl => λy.y*2+1");
+    ASSERT_TRUE(twice->data.fmap.container->type == AST_FMAP, "input AST unchanged");
+
+    TEST("Fmap identity");
+    AST* id = ast_lambda("z", obj_int(), ast_var("z"));
+    ASSERT_TRUE(optimize(ast_fmap(functor_list(), id, list)) == list, "fmap id xs => xs");
+    AST* just = ast_maybe_just(ast_int(1));
+    AST* maps = ast_fmap(functor_maybe(), id, ast_fmap(functor_maybe(), id, just));
+    ASSERT_TRUE(optimize(maps) == just, "fmap id (fmap id m) => m");
+
+    TEST("No capture");
+    // (λx.λy.x) y must not become λy.y
+    AST* k = ast_lambda("x", obj_int(), ast_lambda("y", obj_int(), ast_var("x")));
+    AST* kept = optimize(ast_app(k, ast_var("y")));
+    ASSERT_TRUE(kept->type == AST_APP, "(λx.λy.x) y is left alone");
+}
+
 
 
 
@@ -492,6 +830,7 @@ int main() {
     test_morphisms();
     test_composition();
     test_containers();
+    test_optimize();
 
     printf("\nTests passed: %d / %d\n", test_passed, test_count);
     return 0;